@@ -118,11 +118,13 @@ class Badge;
 template<typename T>
 class FixedArray;
 
-template<typename>
+// Callables whose wrapper fits in inline_capacity bytes are stored without a heap allocation. The default is empirically
+// determined to fit most lambdas and functions.
+template<typename, size_t inline_capacity = 4 * sizeof(void*)>
 class Function;
 
-template<typename Out, typename... In>
-class Function<Out(In...)>;
+template<typename Out, typename... In, size_t inline_capacity>
+class Function<Out(In...), inline_capacity>;
 
 template<typename>
 class JsonArraySerializer;
@@ -31,6 +31,7 @@
 #include <AK/Assertions.h>
 #include <AK/Atomic.h>
 #include <AK/BitCast.h>
+#include <AK/Forward.h>
 #include <AK/Noncopyable.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Span.h>
@@ -68,9 +69,6 @@ inline constexpr size_t block_layout_size = 32;
 
 }
 
-template<typename>
-class Function;
-
 template<typename F>
 inline constexpr bool IsFunctionPointer = (IsPointer<F> && IsFunction<RemovePointer<F>>);
 
@@ -78,9 +76,10 @@ inline constexpr bool IsFunctionPointer = (IsPointer<F> && IsFunction<RemovePoin
 template<typename F>
 inline constexpr bool IsFunctionObject = (!IsFunctionPointer<F> && IsRvalueReference<F&&>);
 
-template<typename Out, typename... In>
-class Function<Out(In...)> {
+template<typename Out, typename... In, size_t inline_capacity>
+class Function<Out(In...), inline_capacity> {
     AK_MAKE_NONCOPYABLE(Function);
+    static_assert(inline_capacity >= sizeof(void*), "Function needs room for a pointer to an outline callable");
 
 public:
     using FunctionType = Out(In...);
@@ -376,8 +375,6 @@ private:
     mutable Atomic<u16> m_call_nesting_level { 0 };
 
     static constexpr size_t inline_alignment = max(alignof(CallableWrapperBase), alignof(CallableWrapperBase*));
-    // Empirically determined to fit most lambdas and functions.
-    static constexpr size_t inline_capacity = 4 * sizeof(void*);
 
     alignas(inline_alignment) u8 m_storage[inline_capacity];
 };
@@ -662,13 +662,21 @@ private:
             return nullptr;
 
         size_t bucket_index = hash & m_mask;
+        size_t probe_length = 0;
         for (;;) {
             auto* bucket = &m_buckets[bucket_index];
             if (bucket->state == BucketState::Free)
                 return nullptr;
+            // OPTIMIZATION: Robin hood insertion would have stolen any bucket that sits closer to its ideal index than
+            //               the value we're looking for would, so once we reach one, the value can't be in the table.
+            //               This keeps failed lookups about as short as successful ones, instead of running on to the
+            //               next free bucket.
+            if (bucket->state != BucketState::CalculateLength && probe_length > static_cast<u8>(bucket->state) - 1u)
+                return nullptr;
             if (bucket->hash.check(hash) && predicate(*bucket->slot()))
                 return bucket;
             bucket_index = (bucket_index + 1) & m_mask;
+            ++probe_length;
         }
     }
 
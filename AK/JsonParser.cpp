@@ -44,7 +44,27 @@ ErrorOr<String> JsonParser::consume_and_unescape_string()
 {
     if (!consume_specific('"'))
         return Error::from_string_literal("JsonParser: Expected '\"'");
+
+    // OPTIMIZATION: Most strings, and nearly all object keys, contain no escapes. Scan up to the first special
+    //               character without going through peek(), and if it is the closing quote, create the String from the
+    //               input directly instead of copying it through a StringBuilder.
+    auto remaining_input = m_input.substring_view(m_index);
+    auto const* characters = remaining_input.characters_without_null_termination();
+    size_t literal_length = 0;
+    while (literal_length < remaining_input.length()) {
+        char ch = characters[literal_length];
+        if (ch == '"' || ch == '\\' || is_ascii_c0_control(ch))
+            break;
+        ++literal_length;
+    }
+    if (literal_length < remaining_input.length() && characters[literal_length] == '"') {
+        auto string = TRY(String::from_utf8(remaining_input.substring_view(0, literal_length)));
+        m_index += literal_length + 1;
+        return string;
+    }
+
     StringBuilder final_sb;
+    final_sb.append(consume(literal_length));
 
     for (;;) {
         // OPTIMIZATION: We try to append as many literal characters as possible at a time
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Concepts.h>
+#include <AK/InsertionSort.h>
+#include <AK/Span.h>
+#include <AK/StdLibExtras.h>
+
+namespace AK {
+
+// Least significant digit radix sort of unsigned integers, one byte per pass. All the byte histograms are counted in a
+// single read of the keys, and passes over a byte that is the same in every key are skipped, so keys that only use
+// their low bits cost no more than narrower ones. `scratch` must be at least as long as `keys`; the sorted keys always
+// end up in `keys`.
+template<Unsigned T>
+void radix_sort(Span<T> keys, Span<T> scratch)
+{
+    // Below this, the passes over the histograms cost more than sorting the keys directly.
+    static constexpr size_t insertion_sort_threshold = 64;
+
+    if (keys.size() < insertion_sort_threshold) {
+        insertion_sort(keys, [](T a, T b) { return a < b; });
+        return;
+    }
+
+    VERIFY(scratch.size() >= keys.size());
+
+    Array<Array<size_t, 256>, sizeof(T)> histograms {};
+    for (auto key : keys) {
+        for (size_t byte = 0; byte < sizeof(T); ++byte)
+            ++histograms[byte][(key >> (byte * 8)) & 0xff];
+    }
+
+    auto source = keys;
+    auto destination = scratch.trim(keys.size());
+    for (size_t byte = 0; byte < sizeof(T); ++byte) {
+        auto shift = byte * 8;
+        auto& histogram = histograms[byte];
+        if (histogram[(source[0] >> shift) & 0xff] == source.size())
+            continue;
+
+        size_t offset = 0;
+        for (auto& count : histogram) {
+            auto bucket_size = count;
+            count = offset;
+            offset += bucket_size;
+        }
+        for (auto key : source)
+            destination[histogram[(key >> shift) & 0xff]++] = key;
+        swap(source, destination);
+    }
+
+    if (source.data() != keys.data())
+        source.copy_to(keys);
+}
+
+}
+
+#if USING_AK_GLOBALLY
+using AK::radix_sort;
+#endif
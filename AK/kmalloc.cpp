@@ -71,6 +71,15 @@ void ak_kfree(void* ptr)
     free(ptr);
 }
 
+void ak_kmalloc_release_free_memory()
+{
+}
+
+KmallocPartitionStatistics ak_kmalloc_partition_statistics(HeapPartition)
+{
+    return {};
+}
+
 extern "C" {
 void* ladybird_rust_alloc(size_t size, size_t alignment);
 void* ladybird_rust_alloc_zeroed(size_t size, size_t alignment);
@@ -160,6 +169,30 @@ void ak_kfree(void* ptr)
     mi_free(ptr);
 }
 
+void ak_kmalloc_release_free_memory()
+{
+    // NB: mi_collect() only looks at the default heap, so the other partitions have to be collected on their own.
+    mi_heap_collect(heap_for_partition(HeapPartition::ArrayBuffer), true);
+    mi_collect(true);
+}
+
+KmallocPartitionStatistics ak_kmalloc_partition_statistics(HeapPartition partition)
+{
+    KmallocPartitionStatistics statistics;
+
+    // NB: Without visit_all_blocks, the visitor is called once per heap area, with no block.
+    mi_heap_visit_blocks(
+        heap_for_partition(partition), false, [](mi_heap_t const*, mi_heap_area_t const* area, void*, size_t, void* argument) {
+            auto& statistics = *static_cast<KmallocPartitionStatistics*>(argument);
+            statistics.bytes_in_use += area->used * area->block_size;
+            statistics.bytes_committed += area->committed;
+            return true;
+        },
+        &statistics);
+
+    return statistics;
+}
+
 extern "C" {
 void* ladybird_rust_alloc(size_t size, size_t alignment);
 void* ladybird_rust_alloc_zeroed(size_t size, size_t alignment);
@@ -24,6 +24,19 @@ void ak_kfree(void* ptr);
 [[nodiscard]] void* ak_krealloc(HeapPartition, void* ptr, size_t size);
 [[nodiscard]] size_t ak_kmalloc_good_size(size_t size);
 
+// Returns memory the allocator is holding on to for future allocations back to the system, across all partitions.
+// This is expensive, so it should only be done after freeing a lot of memory at once, e.g. after a full garbage collection.
+void ak_kmalloc_release_free_memory();
+
+struct KmallocPartitionStatistics {
+    size_t bytes_in_use { 0 };
+    size_t bytes_committed { 0 };
+};
+
+// Covers the memory of a partition that was allocated by the calling thread. The system allocator used in sanitizer
+// builds keeps no statistics, so all of them are zero there.
+[[nodiscard]] KmallocPartitionStatistics ak_kmalloc_partition_statistics(HeapPartition);
+
 [[nodiscard]] inline void* kcalloc(size_t count, size_t size)
 {
     return ak_kcalloc(count, size);
@@ -59,6 +72,16 @@ inline void kfree(void* ptr)
     return ak_kmalloc_good_size(size);
 }
 
+inline void kmalloc_release_free_memory()
+{
+    ak_kmalloc_release_free_memory();
+}
+
+[[nodiscard]] inline KmallocPartitionStatistics kmalloc_partition_statistics(HeapPartition partition)
+{
+    return ak_kmalloc_partition_statistics(partition);
+}
+
 using std::nothrow;
 
 inline void* kmalloc_array(AK::Checked<size_t> a, AK::Checked<size_t> b)
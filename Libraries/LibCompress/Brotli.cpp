@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibCompress/Brotli.h>
+
+#include <brotli/decode.h>
+#include <brotli/encode.h>
+#include <string.h>
+
+namespace Compress {
+
+ErrorOr<NonnullOwnPtr<BrotliDecompressor>> BrotliDecompressor::create(MaybeOwned<Stream> stream, ReadonlyBytes dictionary)
+{
+    auto buffer = TRY(AK::FixedArray<u8>::create(16 * 1024));
+    auto dictionary_copy = TRY(ByteBuffer::copy(dictionary));
+
+    auto* state = BrotliDecoderCreateInstance(nullptr, nullptr, nullptr);
+    if (!state)
+        return Error::from_errno(ENOMEM);
+
+    if (!dictionary_copy.is_empty() && !BrotliDecoderAttachDictionary(state, BROTLI_SHARED_DICTIONARY_RAW, dictionary_copy.size(), dictionary_copy.data())) {
+        BrotliDecoderDestroyInstance(state);
+        return Error::from_string_literal("Unable to attach brotli dictionary");
+    }
+
+    auto decompressor = adopt_own_if_nonnull(new (nothrow) BrotliDecompressor(move(buffer), move(stream), state, move(dictionary_copy)));
+    if (!decompressor) {
+        BrotliDecoderDestroyInstance(state);
+        return Error::from_errno(ENOMEM);
+    }
+    return decompressor.release_nonnull();
+}
+
+ErrorOr<ByteBuffer> BrotliDecompressor::decompress_all(ReadonlyBytes bytes, ReadonlyBytes dictionary)
+{
+    auto input_stream = make<AK::FixedMemoryStream>(bytes);
+    auto brotli_stream = TRY(create(MaybeOwned<Stream>(move(input_stream)), dictionary));
+    return TRY(brotli_stream->read_until_eof(16 * 1024));
+}
+
+BrotliDecompressor::BrotliDecompressor(AK::FixedArray<u8> buffer, MaybeOwned<Stream> stream, BrotliDecoderState* state, ByteBuffer dictionary)
+    : m_stream(move(stream))
+    , m_state(state)
+    , m_dictionary(move(dictionary))
+    , m_buffer(move(buffer))
+{
+}
+
+BrotliDecompressor::~BrotliDecompressor()
+{
+    BrotliDecoderDestroyInstance(m_state);
+}
+
+ErrorOr<Bytes> BrotliDecompressor::read_some(Bytes bytes)
+{
+    if (m_eof)
+        return bytes.trim(0);
+
+    if (m_available_in == 0) {
+        auto in = TRY(m_stream->read_some(m_buffer.span()));
+        m_next_in = m_buffer.data();
+        m_available_in = in.size();
+    }
+
+    auto* next_out = bytes.data();
+    auto available_out = bytes.size();
+
+    auto result = BrotliDecoderDecompressStream(m_state, &m_available_in, &m_next_in, &available_out, &next_out, nullptr);
+    switch (result) {
+    case BROTLI_DECODER_RESULT_ERROR: {
+        auto const* message = BrotliDecoderErrorString(BrotliDecoderGetErrorCode(m_state));
+        return Error::from_string_view({ message, strlen(message) });
+    }
+    case BROTLI_DECODER_RESULT_SUCCESS:
+        // Unlike gzip members, brotli streams can't be concatenated, so anything after the end of one is an error.
+        if (m_available_in != 0)
+            return Error::from_string_literal("Unexpected data after the end of the brotli stream");
+        m_eof = true;
+        break;
+    case BROTLI_DECODER_RESULT_NEEDS_MORE_INPUT:
+        // No more input, stream is EOF and no output was produced. There is no way to get out of this loop, error out.
+        if (m_stream->is_eof() && available_out == bytes.size())
+            return Error::from_string_literal("No decompression progress on EOF stream");
+        break;
+    case BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT:
+        break;
+    }
+
+    return bytes.slice(0, bytes.size() - available_out);
+}
+
+ErrorOr<size_t> BrotliDecompressor::write_some(ReadonlyBytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+bool BrotliDecompressor::is_eof() const
+{
+    return m_eof;
+}
+
+bool BrotliDecompressor::is_open() const
+{
+    return m_stream->is_open();
+}
+
+void BrotliDecompressor::close()
+{
+}
+
+static u32 to_brotli_quality(GenericZlibCompressionLevel compression_level)
+{
+    switch (compression_level) {
+    case GenericZlibCompressionLevel::Fastest:
+        return BROTLI_MIN_QUALITY;
+    // NB: This is the quality servers commonly use for dynamic content. Brotli's own default is its maximum quality,
+    //     which costs far too much CPU time to use on data we produce on the fly.
+    case GenericZlibCompressionLevel::Default:
+        return 5;
+    case GenericZlibCompressionLevel::Best:
+        return BROTLI_MAX_QUALITY;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+ErrorOr<NonnullOwnPtr<BrotliCompressor>> BrotliCompressor::create(MaybeOwned<Stream> stream, GenericZlibCompressionLevel compression_level)
+{
+    auto buffer = TRY(AK::FixedArray<u8>::create(16 * 1024));
+
+    auto* state = BrotliEncoderCreateInstance(nullptr, nullptr, nullptr);
+    if (!state)
+        return Error::from_errno(ENOMEM);
+
+    if (!BrotliEncoderSetParameter(state, BROTLI_PARAM_QUALITY, to_brotli_quality(compression_level))) {
+        BrotliEncoderDestroyInstance(state);
+        return Error::from_string_literal("Unable to set brotli quality");
+    }
+
+    auto compressor = adopt_own_if_nonnull(new (nothrow) BrotliCompressor(move(buffer), move(stream), state));
+    if (!compressor) {
+        BrotliEncoderDestroyInstance(state);
+        return Error::from_errno(ENOMEM);
+    }
+    return compressor.release_nonnull();
+}
+
+ErrorOr<ByteBuffer> BrotliCompressor::compress_all(ReadonlyBytes bytes, GenericZlibCompressionLevel compression_level)
+{
+    auto output = TRY(ByteBuffer::create_uninitialized(max(BrotliEncoderMaxCompressedSize(bytes.size()), 64uz)));
+    auto output_size = output.size();
+
+    if (!BrotliEncoderCompress(static_cast<int>(to_brotli_quality(compression_level)), BROTLI_DEFAULT_WINDOW, BROTLI_DEFAULT_MODE, bytes.size(), bytes.data(), &output_size, output.data()))
+        return Error::from_string_literal("Brotli compression failed");
+
+    output.trim(output_size, false);
+    return output;
+}
+
+BrotliCompressor::BrotliCompressor(AK::FixedArray<u8> buffer, MaybeOwned<Stream> stream, BrotliEncoderState* state)
+    : m_stream(move(stream))
+    , m_state(state)
+    , m_buffer(move(buffer))
+{
+}
+
+BrotliCompressor::~BrotliCompressor()
+{
+    BrotliEncoderDestroyInstance(m_state);
+}
+
+ErrorOr<Bytes> BrotliCompressor::read_some(Bytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+ErrorOr<void> BrotliCompressor::compress(ReadonlyBytes bytes, int operation)
+{
+    auto const* next_in = bytes.data();
+    auto available_in = bytes.size();
+
+    // Keep going until the encoder has consumed all of the input, and has no output left over for it.
+    do {
+        auto* next_out = m_buffer.data();
+        auto available_out = m_buffer.size();
+
+        if (!BrotliEncoderCompressStream(m_state, static_cast<BrotliEncoderOperation>(operation), &available_in, &next_in, &available_out, &next_out, nullptr))
+            return Error::from_string_literal("Brotli compression failed");
+
+        auto have = m_buffer.size() - available_out;
+        TRY(m_stream->write_until_depleted(m_buffer.span().slice(0, have)));
+    } while (available_in != 0 || BrotliEncoderHasMoreOutput(m_state) || (operation == BROTLI_OPERATION_FINISH && !BrotliEncoderIsFinished(m_state)));
+
+    return {};
+}
+
+ErrorOr<size_t> BrotliCompressor::write_some(ReadonlyBytes bytes)
+{
+    TRY(compress(bytes, BROTLI_OPERATION_PROCESS));
+    return bytes.size();
+}
+
+bool BrotliCompressor::is_eof() const
+{
+    return false;
+}
+
+bool BrotliCompressor::is_open() const
+{
+    return m_stream->is_open();
+}
+
+void BrotliCompressor::close()
+{
+}
+
+ErrorOr<void> BrotliCompressor::finish()
+{
+    return compress({}, BROTLI_OPERATION_FINISH);
+}
+
+}
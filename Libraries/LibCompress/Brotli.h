@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/FixedArray.h>
+#include <AK/MaybeOwned.h>
+#include <AK/Stream.h>
+#include <LibCompress/GenericZlib.h>
+
+extern "C" {
+typedef struct BrotliDecoderStateStruct BrotliDecoderState;
+typedef struct BrotliEncoderStateStruct BrotliEncoderState;
+}
+
+namespace Compress {
+
+// https://datatracker.ietf.org/doc/html/rfc7932
+class BrotliDecompressor final : public Stream {
+    AK_MAKE_NONCOPYABLE(BrotliDecompressor);
+
+public:
+    // The dictionary, if any, is the raw shared dictionary the stream was compressed against, like the ones
+    // Compression Dictionary Transport uses.
+    static ErrorOr<NonnullOwnPtr<BrotliDecompressor>> create(MaybeOwned<Stream>, ReadonlyBytes dictionary = {});
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes, ReadonlyBytes dictionary = {});
+
+    ~BrotliDecompressor() override;
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+
+private:
+    BrotliDecompressor(AK::FixedArray<u8>, MaybeOwned<Stream>, BrotliDecoderState*, ByteBuffer dictionary);
+
+    MaybeOwned<Stream> m_stream;
+    BrotliDecoderState* m_state { nullptr };
+
+    // NB: The decoder refers to the dictionary rather than copying it, so it has to live as long as the decoder does.
+    ByteBuffer m_dictionary;
+
+    u8 const* m_next_in { nullptr };
+    size_t m_available_in { 0 };
+    bool m_eof { false };
+
+    AK::FixedArray<u8> m_buffer;
+};
+
+class BrotliCompressor final : public Stream {
+    AK_MAKE_NONCOPYABLE(BrotliCompressor);
+
+public:
+    static ErrorOr<NonnullOwnPtr<BrotliCompressor>> create(MaybeOwned<Stream>, GenericZlibCompressionLevel = GenericZlibCompressionLevel::Default);
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes, GenericZlibCompressionLevel = GenericZlibCompressionLevel::Default);
+
+    ~BrotliCompressor() override;
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+    ErrorOr<void> finish();
+
+private:
+    BrotliCompressor(AK::FixedArray<u8>, MaybeOwned<Stream>, BrotliEncoderState*);
+
+    ErrorOr<void> compress(ReadonlyBytes, int operation);
+
+    MaybeOwned<Stream> m_stream;
+    BrotliEncoderState* m_state { nullptr };
+
+    AK::FixedArray<u8> m_buffer;
+};
+
+}
@@ -153,7 +153,7 @@ ErrorOr<NonnullOwnPtr<DeflateDecompressor>> DeflateDecompressor::create(MaybeOwn
 
 ErrorOr<ByteBuffer> DeflateDecompressor::decompress_all(ReadonlyBytes bytes)
 {
-    return ::Compress::decompress_all<DeflateDecompressor>(bytes);
+    return GenericZlibDecompressor::decompress_all(bytes, -MAX_WBITS);
 }
 
 ErrorOr<NonnullOwnPtr<DeflateCompressor>> DeflateCompressor::create(MaybeOwned<Stream> stream, GenericZlibCompressionLevel compression_level)
@@ -165,7 +165,7 @@ ErrorOr<NonnullOwnPtr<DeflateCompressor>> DeflateCompressor::create(MaybeOwned<S
 
 ErrorOr<ByteBuffer> DeflateCompressor::compress_all(ReadonlyBytes bytes, GenericZlibCompressionLevel compression_level)
 {
-    return ::Compress::compress_all<DeflateCompressor>(bytes, compression_level);
+    return GenericZlibCompressor::compress_all(bytes, -MAX_WBITS, compression_level);
 }
 
 }
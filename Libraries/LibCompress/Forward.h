@@ -8,11 +8,15 @@
 
 namespace Compress {
 
+class BrotliCompressor;
+class BrotliDecompressor;
 class DeflateCompressor;
 class DeflateDecompressor;
 class GzipCompressor;
 class GzipDecompressor;
 class ZlibCompressor;
 class ZlibDecompressor;
+class ZstdCompressor;
+class ZstdDecompressor;
 
 }
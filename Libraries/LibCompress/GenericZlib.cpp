@@ -4,12 +4,30 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/NumericLimits.h>
+#include <AK/ScopeGuard.h>
 #include <LibCompress/GenericZlib.h>
+#include <LibSync/ConditionVariable.h>
+#include <LibSync/Mutex.h>
+#include <LibThreading/ThreadPool.h>
 
 #include <zlib.h>
 
 namespace Compress {
 
+// Deflate can't do better than about 1032:1, so a size hint beyond that comes from a corrupt or malicious trailer.
+static constexpr size_t MAXIMUM_COMPRESSION_RATIO = 1032;
+
+// Buffers at least this big are compressed as independent blocks on the thread pool, like pigz does.
+static constexpr size_t PARALLEL_COMPRESSION_THRESHOLD = 1 * MiB;
+static constexpr size_t PARALLEL_COMPRESSION_BLOCK_SIZE = 256 * KiB;
+static constexpr size_t PARALLEL_COMPRESSION_HELPER_COUNT = 3;
+
+// Each block is primed with the end of the block before it, so splitting the input costs almost no compression ratio.
+static constexpr size_t DICTIONARY_SIZE = 32 * KiB;
+
 static Error handle_zlib_error(int ret)
 {
     switch (ret) {
@@ -35,6 +53,26 @@ static Error handle_zlib_error(int ret)
     }
 }
 
+static int to_zlib_level(GenericZlibCompressionLevel compression_level)
+{
+    switch (compression_level) {
+    case GenericZlibCompressionLevel::Fastest:
+        return Z_BEST_SPEED;
+    case GenericZlibCompressionLevel::Default:
+        return Z_DEFAULT_COMPRESSION;
+    case GenericZlibCompressionLevel::Best:
+        return Z_BEST_COMPRESSION;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+// zlib counts sizes in uInt, so buffers bigger than that are fed to it in pieces.
+static uInt clamp_to_uint(size_t size)
+{
+    return static_cast<uInt>(min(size, static_cast<size_t>(NumericLimits<uInt>::max())));
+}
+
 GenericZlibDecompressor::GenericZlibDecompressor(AK::FixedArray<u8> buffer, MaybeOwned<Stream> stream, z_stream* zstream)
     : m_stream(move(stream))
     , m_zstream(zstream)
@@ -61,6 +99,59 @@ ErrorOr<z_stream*> GenericZlibDecompressor::new_z_stream(int window_bits)
     return zstream;
 }
 
+ErrorOr<ByteBuffer> GenericZlibDecompressor::decompress_all(ReadonlyBytes bytes, int window_bits, Optional<size_t> size_hint)
+{
+    z_stream zstream {};
+    if (auto ret = inflateInit2(&zstream, window_bits); ret != Z_OK)
+        return handle_zlib_error(ret);
+    ScopeGuard end_stream = [&] { inflateEnd(&zstream); };
+
+    // NB: Without a hint, assume the usual ratio of text, which is what most of what we decompress is.
+    auto initial_size = min(size_hint.value_or(bytes.size() * 4), bytes.size() * MAXIMUM_COMPRESSION_RATIO);
+    initial_size = max(initial_size, 4 * KiB);
+
+    ByteBuffer output;
+    TRY(output.try_resize(initial_size));
+
+    size_t input_offset = 0;
+    size_t output_offset = 0;
+    while (true) {
+        if (zstream.avail_in == 0) {
+            zstream.next_in = const_cast<u8*>(bytes.offset_pointer(input_offset));
+            zstream.avail_in = clamp_to_uint(bytes.size() - input_offset);
+            input_offset += zstream.avail_in;
+        }
+
+        if (output_offset == output.size())
+            TRY(output.try_resize(output.size() * 2));
+        zstream.next_out = output.offset_pointer(output_offset);
+        zstream.avail_out = clamp_to_uint(output.size() - output_offset);
+
+        auto available_output = zstream.avail_out;
+        auto ret = inflate(&zstream, Z_NO_FLUSH);
+        output_offset += available_output - zstream.avail_out;
+
+        if (ret == Z_STREAM_END) {
+            // Like the streaming decompressor, treat whatever follows the end of the stream as another stream, which is
+            // how gzip files made of several members are laid out.
+            if (zstream.avail_in == 0 && input_offset == bytes.size())
+                break;
+            inflateReset(&zstream);
+            continue;
+        }
+
+        // No progress is possible even though there was room for more output, so the input ended too early.
+        if (ret == Z_BUF_ERROR && zstream.avail_out != 0)
+            return Error::from_string_literal("No decompression progress on EOF stream");
+
+        if (ret != Z_OK && ret != Z_BUF_ERROR)
+            return handle_zlib_error(ret);
+    }
+
+    output.trim(output_offset, false);
+    return output;
+}
+
 GenericZlibDecompressor::~GenericZlibDecompressor()
 {
     inflateEnd(m_zstream);
@@ -97,6 +188,37 @@ ErrorOr<Bytes> GenericZlibDecompressor::read_some(Bytes bytes)
     return bytes.slice(0, bytes.size() - m_zstream->avail_out);
 }
 
+ErrorOr<ByteBuffer> GenericZlibDecompressor::decompress_available()
+{
+    ByteBuffer output;
+
+    while (true) {
+        if (m_zstream->avail_in == 0) {
+            auto in = TRY(m_stream->read_some(m_buffer.span()));
+            m_zstream->avail_in = in.size();
+            m_zstream->next_in = m_buffer.data();
+        }
+
+        auto space = TRY(output.get_bytes_for_writing(m_buffer.size()));
+        m_zstream->avail_out = space.size();
+        m_zstream->next_out = space.data();
+
+        auto ret = inflate(m_zstream, Z_SYNC_FLUSH);
+        output.trim(output.size() - m_zstream->avail_out, false);
+
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR)
+            return handle_zlib_error(ret);
+
+        if (ret == Z_STREAM_END)
+            inflateReset(m_zstream);
+
+        // inflate() only leaves room in the output once it has run out of input, so if there's no more of that
+        // either, we have everything.
+        if (m_zstream->avail_out != 0 && m_zstream->avail_in == 0 && m_stream->is_eof())
+            return output;
+    }
+}
+
 ErrorOr<size_t> GenericZlibDecompressor::write_some(ReadonlyBytes)
 {
     return Error::from_errno(EBADF);
@@ -134,23 +256,259 @@ ErrorOr<z_stream*> GenericZlibCompressor::new_z_stream(int window_bits, GenericZ
     zstream->zfree = nullptr;
     zstream->opaque = nullptr;
 
-    int level = [&] {
-        switch (compression_level) {
-        case GenericZlibCompressionLevel::Fastest:
-            return Z_BEST_SPEED;
-        case GenericZlibCompressionLevel::Default:
-            return Z_DEFAULT_COMPRESSION;
-        case GenericZlibCompressionLevel::Best:
-            return Z_BEST_COMPRESSION;
-        default:
-            VERIFY_NOT_REACHED();
+    if (auto ret = deflateInit2(zstream, to_zlib_level(compression_level), Z_DEFLATED, window_bits, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY); ret != Z_OK)
+        return handle_zlib_error(ret);
+
+    return zstream;
+}
+
+// Deflates all of the input into a new buffer, ending with the given flush mode.
+static ErrorOr<ByteBuffer> deflate_all(z_stream& zstream, ReadonlyBytes input, int flush)
+{
+    ByteBuffer output;
+    TRY(output.try_resize(deflateBound(&zstream, input.size())));
+
+    size_t input_offset = 0;
+    size_t output_offset = 0;
+    while (true) {
+        if (zstream.avail_in == 0) {
+            zstream.next_in = const_cast<u8*>(input.offset_pointer(input_offset));
+            zstream.avail_in = clamp_to_uint(input.size() - input_offset);
+            input_offset += zstream.avail_in;
         }
-    }();
+        auto is_last_input = input_offset == input.size();
+
+        // NB: deflateBound() doesn't account for the empty block a sync flush ends with.
+        if (output_offset == output.size())
+            TRY(output.try_resize(max(output.size() * 2, 64uz)));
+        zstream.next_out = output.offset_pointer(output_offset);
+        zstream.avail_out = clamp_to_uint(output.size() - output_offset);
+
+        auto available_output = zstream.avail_out;
+        auto ret = deflate(&zstream, is_last_input ? flush : Z_NO_FLUSH);
+        output_offset += available_output - zstream.avail_out;
+
+        if (ret == Z_STREAM_END)
+            break;
+        if (ret != Z_OK && ret != Z_BUF_ERROR)
+            return handle_zlib_error(ret);
+
+        // Any other flush is complete once deflate() returns with output space left over.
+        if (flush != Z_FINISH && is_last_input && zstream.avail_in == 0 && zstream.avail_out != 0)
+            break;
+    }
+
+    output.trim(output_offset, false);
+    return output;
+}
 
-    if (auto ret = deflateInit2(zstream, level, Z_DEFLATED, window_bits, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY); ret != Z_OK)
+namespace {
+
+enum class Wrapper : u8 {
+    Raw,
+    Zlib,
+    Gzip,
+};
+
+struct CompressedBlock {
+    ByteBuffer data;
+    u32 checksum { 0 };
+    Optional<Error> error;
+};
+
+class ParallelCompressionJob final : public AtomicRefCounted<ParallelCompressionJob> {
+public:
+    ParallelCompressionJob(ReadonlyBytes input, Wrapper wrapper, int level)
+        : m_input(input)
+        , m_wrapper(wrapper)
+        , m_level(level)
+    {
+        m_blocks.resize(ceil_div(input.size(), PARALLEL_COMPRESSION_BLOCK_SIZE));
+    }
+
+    Vector<CompressedBlock>& blocks() { return m_blocks; }
+
+    // Compresses blocks until there are none left to start. A helper that only gets to run after that touches nothing
+    // but the job it keeps alive.
+    void compress_blocks()
+    {
+        while (true) {
+            auto index = m_next_block.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            if (index >= m_blocks.size())
+                return;
+
+            auto block = compress_block(index);
+
+            Sync::MutexLocker locker(m_mutex);
+            m_blocks[index] = move(block);
+            if (++m_finished_block_count == m_blocks.size())
+                m_condition.signal();
+        }
+    }
+
+    void wait_until_done()
+    {
+        Sync::MutexLocker locker(m_mutex);
+        m_condition.wait_while([this] { return m_finished_block_count < m_blocks.size(); });
+    }
+
+private:
+    CompressedBlock compress_block(size_t index) const
+    {
+        auto start = index * PARALLEL_COMPRESSION_BLOCK_SIZE;
+        auto input = m_input.slice(start, min(PARALLEL_COMPRESSION_BLOCK_SIZE, m_input.size() - start));
+        auto is_last_block = index == m_blocks.size() - 1;
+
+        CompressedBlock block;
+
+        z_stream zstream {};
+        if (auto ret = deflateInit2(&zstream, m_level, Z_DEFLATED, -MAX_WBITS, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY); ret != Z_OK) {
+            block.error = handle_zlib_error(ret);
+            return block;
+        }
+        ScopeGuard end_stream = [&] { deflateEnd(&zstream); };
+
+        if (start > 0) {
+            auto dictionary_size = min(DICTIONARY_SIZE, start);
+            auto dictionary = m_input.slice(start - dictionary_size, dictionary_size);
+            if (auto ret = deflateSetDictionary(&zstream, dictionary.data(), dictionary.size()); ret != Z_OK) {
+                block.error = handle_zlib_error(ret);
+                return block;
+            }
+        }
+
+        // NB: Only the last block may end the deflate stream. The others end with a sync flush instead, which leaves
+        //     them on a byte boundary so the next block can simply be appended.
+        auto data = deflate_all(zstream, input, is_last_block ? Z_FINISH : Z_SYNC_FLUSH);
+        if (data.is_error()) {
+            block.error = data.release_error();
+            return block;
+        }
+        block.data = data.release_value();
+
+        if (m_wrapper == Wrapper::Gzip)
+            block.checksum = static_cast<u32>(crc32(0, input.data(), input.size()));
+        else if (m_wrapper == Wrapper::Zlib)
+            block.checksum = static_cast<u32>(adler32(1, input.data(), input.size()));
+        return block;
+    }
+
+    ReadonlyBytes m_input;
+    Wrapper m_wrapper { Wrapper::Raw };
+    int m_level { Z_DEFAULT_COMPRESSION };
+
+    Vector<CompressedBlock> m_blocks;
+    Atomic<size_t> m_next_block { 0 };
+
+    Sync::Mutex m_mutex;
+    Sync::ConditionVariable m_condition { m_mutex };
+    size_t m_finished_block_count { 0 };
+};
+
+}
+
+static ErrorOr<ByteBuffer> compress_all_in_parallel(ReadonlyBytes bytes, int window_bits, GenericZlibCompressionLevel compression_level)
+{
+    auto wrapper = Wrapper::Zlib;
+    if (window_bits < 0)
+        wrapper = Wrapper::Raw;
+    else if (window_bits > MAX_WBITS)
+        wrapper = Wrapper::Gzip;
+
+    auto job = adopt_ref(*new ParallelCompressionJob(bytes, wrapper, to_zlib_level(compression_level)));
+
+    // The pool may be busy with other work, so helpers join whenever they get to run. The calling thread compresses
+    // blocks along with them, and all of them on its own if none of them get there in time.
+    auto helper_count = min(PARALLEL_COMPRESSION_HELPER_COUNT, job->blocks().size() - 1);
+    for (size_t i = 0; i < helper_count; ++i)
+        Threading::ThreadPool::the().submit([job] { job->compress_blocks(); }, Threading::ThreadPool::Priority::UserBlocking);
+
+    job->compress_blocks();
+    job->wait_until_done();
+
+    auto& blocks = job->blocks();
+    size_t compressed_size = 0;
+    for (auto& block : blocks) {
+        if (block.error.has_value())
+            return block.error.release_value();
+        compressed_size += block.data.size();
+    }
+
+    ByteBuffer output;
+    TRY(output.try_ensure_capacity(compressed_size + 18));
+
+    // https://datatracker.ietf.org/doc/html/rfc1950#section-2.2
+    if (wrapper == Wrapper::Zlib) {
+        u8 compression_method_and_flags = 0x78;
+        u8 compression_level_flag = [&] {
+            switch (compression_level) {
+            case GenericZlibCompressionLevel::Fastest:
+                return 0;
+            case GenericZlibCompressionLevel::Default:
+                return 2;
+            case GenericZlibCompressionLevel::Best:
+                return 3;
+            default:
+                VERIFY_NOT_REACHED();
+            }
+        }();
+        auto flags = static_cast<u8>(compression_level_flag << 6);
+        flags += 31 - ((compression_method_and_flags << 8) | flags) % 31;
+        TRY(output.try_append(compression_method_and_flags));
+        TRY(output.try_append(flags));
+    }
+
+    // https://datatracker.ietf.org/doc/html/rfc1952#section-2.3
+    if (wrapper == Wrapper::Gzip) {
+        u8 extra_flags = 0;
+        if (compression_level == GenericZlibCompressionLevel::Best)
+            extra_flags = 2;
+        else if (compression_level == GenericZlibCompressionLevel::Fastest)
+            extra_flags = 4;
+        u8 const header[] = { 0x1f, 0x8b, Z_DEFLATED, 0, 0, 0, 0, 0, extra_flags, 0xff };
+        TRY(output.try_append(header, sizeof(header)));
+    }
+
+    u32 checksum = blocks[0].checksum;
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        TRY(output.try_append(blocks[i].data));
+        if (i == 0)
+            continue;
+        auto block_size = min(PARALLEL_COMPRESSION_BLOCK_SIZE, bytes.size() - i * PARALLEL_COMPRESSION_BLOCK_SIZE);
+        if (wrapper == Wrapper::Gzip)
+            checksum = static_cast<u32>(crc32_combine(checksum, blocks[i].checksum, block_size));
+        else if (wrapper == Wrapper::Zlib)
+            checksum = static_cast<u32>(adler32_combine(checksum, blocks[i].checksum, block_size));
+    }
+
+    if (wrapper == Wrapper::Zlib) {
+        u8 const trailer[] = { static_cast<u8>(checksum >> 24), static_cast<u8>(checksum >> 16), static_cast<u8>(checksum >> 8), static_cast<u8>(checksum) };
+        TRY(output.try_append(trailer, sizeof(trailer)));
+    }
+
+    if (wrapper == Wrapper::Gzip) {
+        auto size = static_cast<u32>(bytes.size());
+        u8 const trailer[] = {
+            static_cast<u8>(checksum), static_cast<u8>(checksum >> 8), static_cast<u8>(checksum >> 16), static_cast<u8>(checksum >> 24),
+            static_cast<u8>(size), static_cast<u8>(size >> 8), static_cast<u8>(size >> 16), static_cast<u8>(size >> 24)
+        };
+        TRY(output.try_append(trailer, sizeof(trailer)));
+    }
+
+    return output;
+}
+
+ErrorOr<ByteBuffer> GenericZlibCompressor::compress_all(ReadonlyBytes bytes, int window_bits, GenericZlibCompressionLevel compression_level)
+{
+    if (bytes.size() >= PARALLEL_COMPRESSION_THRESHOLD)
+        return compress_all_in_parallel(bytes, window_bits, compression_level);
+
+    z_stream zstream {};
+    if (auto ret = deflateInit2(&zstream, to_zlib_level(compression_level), Z_DEFLATED, window_bits, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY); ret != Z_OK)
         return handle_zlib_error(ret);
+    ScopeGuard end_stream = [&] { deflateEnd(&zstream); };
 
-    return zstream;
+    return deflate_all(zstream, bytes, Z_FINISH);
 }
 
 GenericZlibCompressor::~GenericZlibCompressor()
@@ -201,6 +559,26 @@ void GenericZlibCompressor::close()
 {
 }
 
+ErrorOr<void> GenericZlibCompressor::flush()
+{
+    VERIFY(m_zstream->avail_in == 0);
+
+    // As with Z_FINISH, deflate() has to be called until it leaves some output space unused, as only then is it done.
+    do {
+        m_zstream->avail_out = m_buffer.size();
+        m_zstream->next_out = m_buffer.data();
+
+        auto ret = deflate(m_zstream, Z_SYNC_FLUSH);
+        if (ret != Z_OK && ret != Z_BUF_ERROR)
+            return handle_zlib_error(ret);
+
+        auto have = m_buffer.size() - m_zstream->avail_out;
+        TRY(m_stream->write_until_depleted(m_buffer.span().slice(0, have)));
+    } while (m_zstream->avail_out == 0);
+
+    return {};
+}
+
 ErrorOr<void> GenericZlibCompressor::finish()
 {
     VERIFY(m_zstream->avail_in == 0);
@@ -10,6 +10,7 @@
 #include <AK/FixedArray.h>
 #include <AK/MaybeOwned.h>
 #include <AK/MemoryStream.h>
+#include <AK/Optional.h>
 #include <AK/Stream.h>
 
 extern "C" {
@@ -36,11 +37,19 @@ public:
     virtual bool is_open() const override;
     virtual void close() override;
 
+    // Inflates everything the underlying stream has to offer right now, for formats that keep a single deflate stream
+    // going across messages. Unlike with read_some(), running out of input in the middle of the stream is fine.
+    ErrorOr<ByteBuffer> decompress_available();
+
 protected:
     GenericZlibDecompressor(AK::FixedArray<u8>, MaybeOwned<Stream>, z_stream*);
 
     static ErrorOr<z_stream*> new_z_stream(int window_bits);
 
+    // Inflates a whole buffer straight into the returned one, without going through a stream. The size hint is how
+    // big the output is expected to be, if the format tells.
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes, int window_bits, Optional<size_t> size_hint = {});
+
 private:
     MaybeOwned<Stream> m_stream;
     z_stream* m_zstream;
@@ -63,11 +72,19 @@ public:
     virtual void close() override;
     ErrorOr<void> finish();
 
+    // Writes out everything compressed so far, ending it on a byte boundary with an empty stored block (00 00 FF FF)
+    // so the receiver can decode all of it. The stream continues afterwards, still referring back to earlier data.
+    ErrorOr<void> flush();
+
 protected:
     GenericZlibCompressor(AK::FixedArray<u8>, MaybeOwned<Stream>, z_stream*);
 
     static ErrorOr<z_stream*> new_z_stream(int window_bits, GenericZlibCompressionLevel compression_level);
 
+    // Deflates a whole buffer straight into the returned one, without going through a stream. Large buffers are split
+    // into blocks that are compressed in parallel, and stitched back together into a single stream.
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes, int window_bits, GenericZlibCompressionLevel);
+
 private:
     MaybeOwned<Stream> m_stream;
     z_stream* m_zstream;
@@ -75,27 +92,4 @@ private:
     AK::FixedArray<u8> m_buffer;
 };
 
-template<class T>
-ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes bytes)
-{
-    auto input_stream = make<AK::FixedMemoryStream>(bytes);
-    auto deflate_stream = TRY(T::create(MaybeOwned<Stream>(move(input_stream))));
-    return TRY(deflate_stream->read_until_eof(4096));
-}
-
-template<class T>
-ErrorOr<ByteBuffer> compress_all(ReadonlyBytes bytes, GenericZlibCompressionLevel compression_level)
-{
-    auto output_stream = TRY(try_make<AllocatingMemoryStream>());
-    auto gzip_stream = TRY(T::create(MaybeOwned { *output_stream }, compression_level));
-
-    TRY(gzip_stream->write_until_depleted(bytes));
-    TRY(gzip_stream->finish());
-
-    auto buffer = TRY(ByteBuffer::create_uninitialized(output_stream->used_buffer_size()));
-    TRY(output_stream->read_until_filled(buffer.bytes()));
-
-    return buffer;
-}
-
 }
@@ -21,7 +21,14 @@ ErrorOr<NonnullOwnPtr<GzipDecompressor>> GzipDecompressor::create(MaybeOwned<Str
 
 ErrorOr<ByteBuffer> GzipDecompressor::decompress_all(ReadonlyBytes bytes)
 {
-    return ::Compress::decompress_all<GzipDecompressor>(bytes);
+    // The trailer of a gzip member ends with the size of its uncompressed data, modulo 2^32. That is exactly right for a
+    // response made of a single member, and still a sensible starting point otherwise.
+    Optional<size_t> size_hint;
+    if (bytes.size() >= 18) {
+        auto trailer = bytes.slice(bytes.size() - 4);
+        size_hint = static_cast<size_t>(trailer[0]) | (trailer[1] << 8) | (trailer[2] << 16) | (static_cast<size_t>(trailer[3]) << 24);
+    }
+    return GenericZlibDecompressor::decompress_all(bytes, MAX_WBITS | 16, size_hint);
 }
 
 ErrorOr<NonnullOwnPtr<GzipCompressor>> GzipCompressor::create(MaybeOwned<Stream> stream, GenericZlibCompressionLevel compression_level)
@@ -33,7 +40,7 @@ ErrorOr<NonnullOwnPtr<GzipCompressor>> GzipCompressor::create(MaybeOwned<Stream>
 
 ErrorOr<ByteBuffer> GzipCompressor::compress_all(ReadonlyBytes bytes, GenericZlibCompressionLevel compression_level)
 {
-    return ::Compress::compress_all<GzipCompressor>(bytes, compression_level);
+    return GenericZlibCompressor::compress_all(bytes, MAX_WBITS | 16, compression_level);
 }
 
 }
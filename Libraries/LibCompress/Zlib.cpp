@@ -20,7 +20,7 @@ ErrorOr<NonnullOwnPtr<ZlibDecompressor>> ZlibDecompressor::create(MaybeOwned<Str
 
 ErrorOr<ByteBuffer> ZlibDecompressor::decompress_all(ReadonlyBytes bytes)
 {
-    return ::Compress::decompress_all<ZlibDecompressor>(bytes);
+    return GenericZlibDecompressor::decompress_all(bytes, MAX_WBITS);
 }
 
 ErrorOr<NonnullOwnPtr<ZlibCompressor>> ZlibCompressor::create(MaybeOwned<Stream> stream, GenericZlibCompressionLevel compression_level)
@@ -32,7 +32,7 @@ ErrorOr<NonnullOwnPtr<ZlibCompressor>> ZlibCompressor::create(MaybeOwned<Stream>
 
 ErrorOr<ByteBuffer> ZlibCompressor::compress_all(ReadonlyBytes bytes, GenericZlibCompressionLevel compression_level)
 {
-    return ::Compress::compress_all<ZlibCompressor>(bytes, compression_level);
+    return GenericZlibCompressor::compress_all(bytes, MAX_WBITS, compression_level);
 }
 
 }
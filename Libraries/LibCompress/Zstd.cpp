@@ -0,0 +1,226 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <LibCompress/Zstd.h>
+
+#include <string.h>
+#include <zstd.h>
+
+namespace Compress {
+
+static Error handle_zstd_error(size_t ret)
+{
+    auto const* message = ZSTD_getErrorName(ret);
+    return Error::from_string_view({ message, strlen(message) });
+}
+
+ErrorOr<NonnullOwnPtr<ZstdDecompressor>> ZstdDecompressor::create(MaybeOwned<Stream> stream, ReadonlyBytes dictionary)
+{
+    auto buffer = TRY(AK::FixedArray<u8>::create(ZSTD_DStreamInSize()));
+
+    auto* context = ZSTD_createDCtx();
+    if (!context)
+        return Error::from_errno(ENOMEM);
+
+    // NB: Loading the dictionary makes zstd keep a copy of it, so the caller doesn't have to keep it around.
+    if (!dictionary.is_empty()) {
+        if (auto ret = ZSTD_DCtx_loadDictionary(context, dictionary.data(), dictionary.size()); ZSTD_isError(ret)) {
+            ZSTD_freeDCtx(context);
+            return handle_zstd_error(ret);
+        }
+    }
+
+    auto decompressor = adopt_own_if_nonnull(new (nothrow) ZstdDecompressor(move(buffer), move(stream), context));
+    if (!decompressor) {
+        ZSTD_freeDCtx(context);
+        return Error::from_errno(ENOMEM);
+    }
+    return decompressor.release_nonnull();
+}
+
+ErrorOr<ByteBuffer> ZstdDecompressor::decompress_all(ReadonlyBytes bytes, ReadonlyBytes dictionary)
+{
+    auto input_stream = make<AK::FixedMemoryStream>(bytes);
+    auto zstd_stream = TRY(create(MaybeOwned<Stream>(move(input_stream)), dictionary));
+    return TRY(zstd_stream->read_until_eof(ZSTD_DStreamOutSize()));
+}
+
+ZstdDecompressor::ZstdDecompressor(AK::FixedArray<u8> buffer, MaybeOwned<Stream> stream, ZSTD_DCtx* context)
+    : m_stream(move(stream))
+    , m_context(context)
+    , m_buffer(move(buffer))
+{
+}
+
+ZstdDecompressor::~ZstdDecompressor()
+{
+    ZSTD_freeDCtx(m_context);
+}
+
+ErrorOr<Bytes> ZstdDecompressor::read_some(Bytes bytes)
+{
+    if (m_input.is_empty())
+        m_input = TRY(m_stream->read_some(m_buffer.span()));
+
+    ZSTD_inBuffer input { m_input.data(), m_input.size(), 0 };
+    ZSTD_outBuffer output { bytes.data(), bytes.size(), 0 };
+
+    auto ret = ZSTD_decompressStream(m_context, &output, &input);
+    m_input = m_input.slice(input.pos);
+
+    if (ZSTD_isError(ret))
+        return handle_zstd_error(ret);
+
+    // NB: Like gzip members, frames may be concatenated, so whatever follows the end of a frame is another frame.
+    if (ret == 0) {
+        m_eof = m_input.is_empty() && m_stream->is_eof();
+        return bytes.slice(0, output.pos);
+    }
+    m_eof = false;
+
+    // No more input, stream is EOF and no output was produced. There is no way to get out of this loop, error out.
+    if (m_input.is_empty() && m_stream->is_eof() && output.pos == 0)
+        return Error::from_string_literal("No decompression progress on EOF stream");
+
+    return bytes.slice(0, output.pos);
+}
+
+ErrorOr<size_t> ZstdDecompressor::write_some(ReadonlyBytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+bool ZstdDecompressor::is_eof() const
+{
+    return m_eof;
+}
+
+bool ZstdDecompressor::is_open() const
+{
+    return m_stream->is_open();
+}
+
+void ZstdDecompressor::close()
+{
+}
+
+static int to_zstd_level(GenericZlibCompressionLevel compression_level)
+{
+    switch (compression_level) {
+    case GenericZlibCompressionLevel::Fastest:
+        return 1;
+    case GenericZlibCompressionLevel::Default:
+        return ZSTD_CLEVEL_DEFAULT;
+    // NB: The levels above this one need much more memory for little gain.
+    case GenericZlibCompressionLevel::Best:
+        return 19;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+ErrorOr<NonnullOwnPtr<ZstdCompressor>> ZstdCompressor::create(MaybeOwned<Stream> stream, GenericZlibCompressionLevel compression_level)
+{
+    auto buffer = TRY(AK::FixedArray<u8>::create(ZSTD_CStreamOutSize()));
+
+    auto* context = ZSTD_createCCtx();
+    if (!context)
+        return Error::from_errno(ENOMEM);
+
+    if (auto ret = ZSTD_CCtx_setParameter(context, ZSTD_c_compressionLevel, to_zstd_level(compression_level)); ZSTD_isError(ret)) {
+        ZSTD_freeCCtx(context);
+        return handle_zstd_error(ret);
+    }
+
+    auto compressor = adopt_own_if_nonnull(new (nothrow) ZstdCompressor(move(buffer), move(stream), context));
+    if (!compressor) {
+        ZSTD_freeCCtx(context);
+        return Error::from_errno(ENOMEM);
+    }
+    return compressor.release_nonnull();
+}
+
+ErrorOr<ByteBuffer> ZstdCompressor::compress_all(ReadonlyBytes bytes, GenericZlibCompressionLevel compression_level)
+{
+    auto output = TRY(ByteBuffer::create_uninitialized(ZSTD_compressBound(bytes.size())));
+
+    auto ret = ZSTD_compress(output.data(), output.size(), bytes.data(), bytes.size(), to_zstd_level(compression_level));
+    if (ZSTD_isError(ret))
+        return handle_zstd_error(ret);
+
+    output.trim(ret, false);
+    return output;
+}
+
+ZstdCompressor::ZstdCompressor(AK::FixedArray<u8> buffer, MaybeOwned<Stream> stream, ZSTD_CCtx* context)
+    : m_stream(move(stream))
+    , m_context(context)
+    , m_buffer(move(buffer))
+{
+}
+
+ZstdCompressor::~ZstdCompressor()
+{
+    ZSTD_freeCCtx(m_context);
+}
+
+ErrorOr<Bytes> ZstdCompressor::read_some(Bytes)
+{
+    return Error::from_errno(EBADF);
+}
+
+ErrorOr<size_t> ZstdCompressor::write_some(ReadonlyBytes bytes)
+{
+    ZSTD_inBuffer input { bytes.data(), bytes.size(), 0 };
+
+    // The compressor may hold on to some of the input until it has enough for a block, but it always consumes all of it.
+    do {
+        ZSTD_outBuffer output { m_buffer.data(), m_buffer.size(), 0 };
+
+        auto ret = ZSTD_compressStream2(m_context, &output, &input, ZSTD_e_continue);
+        if (ZSTD_isError(ret))
+            return handle_zstd_error(ret);
+
+        TRY(m_stream->write_until_depleted(m_buffer.span().slice(0, output.pos)));
+    } while (input.pos < input.size);
+
+    return bytes.size();
+}
+
+bool ZstdCompressor::is_eof() const
+{
+    return false;
+}
+
+bool ZstdCompressor::is_open() const
+{
+    return m_stream->is_open();
+}
+
+void ZstdCompressor::close()
+{
+}
+
+ErrorOr<void> ZstdCompressor::finish()
+{
+    ZSTD_inBuffer input { nullptr, 0, 0 };
+
+    // ZSTD_compressStream2() returns how much it still has to flush, so the frame is done once that reaches zero.
+    while (true) {
+        ZSTD_outBuffer output { m_buffer.data(), m_buffer.size(), 0 };
+
+        auto ret = ZSTD_compressStream2(m_context, &output, &input, ZSTD_e_end);
+        if (ZSTD_isError(ret))
+            return handle_zstd_error(ret);
+
+        TRY(m_stream->write_until_depleted(m_buffer.span().slice(0, output.pos)));
+        if (ret == 0)
+            return {};
+    }
+}
+
+}
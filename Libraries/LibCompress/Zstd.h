@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/FixedArray.h>
+#include <AK/MaybeOwned.h>
+#include <AK/Stream.h>
+#include <LibCompress/GenericZlib.h>
+
+extern "C" {
+typedef struct ZSTD_DCtx_s ZSTD_DCtx;
+typedef struct ZSTD_CCtx_s ZSTD_CCtx;
+}
+
+namespace Compress {
+
+// https://datatracker.ietf.org/doc/html/rfc8878
+class ZstdDecompressor final : public Stream {
+    AK_MAKE_NONCOPYABLE(ZstdDecompressor);
+
+public:
+    // The dictionary, if any, is the raw dictionary the frames were compressed against, like the ones Compression
+    // Dictionary Transport uses.
+    static ErrorOr<NonnullOwnPtr<ZstdDecompressor>> create(MaybeOwned<Stream>, ReadonlyBytes dictionary = {});
+    static ErrorOr<ByteBuffer> decompress_all(ReadonlyBytes, ReadonlyBytes dictionary = {});
+
+    ~ZstdDecompressor() override;
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+
+private:
+    ZstdDecompressor(AK::FixedArray<u8>, MaybeOwned<Stream>, ZSTD_DCtx*);
+
+    MaybeOwned<Stream> m_stream;
+    ZSTD_DCtx* m_context { nullptr };
+
+    ReadonlyBytes m_input;
+    bool m_eof { false };
+
+    AK::FixedArray<u8> m_buffer;
+};
+
+class ZstdCompressor final : public Stream {
+    AK_MAKE_NONCOPYABLE(ZstdCompressor);
+
+public:
+    static ErrorOr<NonnullOwnPtr<ZstdCompressor>> create(MaybeOwned<Stream>, GenericZlibCompressionLevel = GenericZlibCompressionLevel::Default);
+    static ErrorOr<ByteBuffer> compress_all(ReadonlyBytes, GenericZlibCompressionLevel = GenericZlibCompressionLevel::Default);
+
+    ~ZstdCompressor() override;
+
+    virtual ErrorOr<Bytes> read_some(Bytes) override;
+    virtual ErrorOr<size_t> write_some(ReadonlyBytes) override;
+    virtual bool is_eof() const override;
+    virtual bool is_open() const override;
+    virtual void close() override;
+    ErrorOr<void> finish();
+
+private:
+    ZstdCompressor(AK::FixedArray<u8>, MaybeOwned<Stream>, ZSTD_CCtx*);
+
+    MaybeOwned<Stream> m_stream;
+    ZSTD_CCtx* m_context { nullptr };
+
+    AK::FixedArray<u8> m_buffer;
+};
+
+}
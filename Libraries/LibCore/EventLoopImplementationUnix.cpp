@@ -25,6 +25,11 @@
 #include <sys/select.h>
 #include <unistd.h>
 
+#if defined(AK_OS_LINUX) && !defined(AK_OS_ANDROID)
+#    define EVENT_LOOP_HAS_EPOLL
+#    include <sys/epoll.h>
+#endif
+
 namespace Core {
 
 namespace {
@@ -77,6 +82,30 @@ bool has_flag(int value, int flag)
     return (value & flag) == flag;
 }
 
+#ifdef EVENT_LOOP_HAS_EPOLL
+// poll() walks every registered descriptor on each wakeup, which shows once a process is watching hundreds of sockets.
+// LADYBIRD_EVENT_LOOP_BACKEND=epoll keeps the interest list in the kernel instead, so a wakeup costs only the number
+// of descriptors that are actually ready.
+static bool should_use_epoll()
+{
+    static bool const use_epoll = [] {
+        auto const* backend = getenv("LADYBIRD_EVENT_LOOP_BACKEND");
+        return backend && StringView { backend, strlen(backend) } == "epoll"sv;
+    }();
+    return use_epoll;
+}
+
+u32 notification_type_to_epoll_events(NotificationType type)
+{
+    u32 events = 0;
+    if (has_flag(type, NotificationType::Read))
+        events |= EPOLLIN;
+    if (has_flag(type, NotificationType::Write))
+        events |= EPOLLOUT;
+    return events;
+}
+#endif
+
 class EventLoopTimeout {
 public:
     static constexpr ssize_t INVALID_INDEX = NumericLimits<ssize_t>::max();
@@ -288,10 +317,19 @@ struct ThreadData {
         // The wake pipe informs us of POSIX signals as well as manual calls to wake()
         poll_fds.append({ .fd = wake_pipe_fds[0], .events = POLLIN, .revents = 0 });
         notifiers.append(nullptr);
+
+#ifdef EVENT_LOOP_HAS_EPOLL
+        if (should_use_epoll())
+            create_epoll_instance();
+#endif
     }
 
     ~ThreadData()
     {
+#ifdef EVENT_LOOP_HAS_EPOLL
+        if (epoll_fd >= 0)
+            close(epoll_fd);
+#endif
         close(wake_pipe_fds[0]);
         close(wake_pipe_fds[1]);
 
@@ -308,6 +346,60 @@ struct ThreadData {
     Vector<Notifier*, 32> notifiers;
     Vector<pollfd, 32> poll_fds;
 
+#ifdef EVENT_LOOP_HAS_EPOLL
+    void create_epoll_instance()
+    {
+        epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+        if (epoll_fd < 0) {
+            warnln("Failed to create epoll instance, falling back to poll(): {}", Error::from_errno(errno));
+            return;
+        }
+
+        epoll_event event {};
+        event.events = EPOLLIN;
+        event.data.fd = wake_pipe_fds[0];
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, wake_pipe_fds[0], &event) < 0) {
+            warnln("Failed to watch the event loop pipe with epoll, falling back to poll(): {}", Error::from_errno(errno));
+            close(epoll_fd);
+            epoll_fd = -1;
+            return;
+        }
+
+        epoll_events.resize(64);
+    }
+
+    void update_epoll_interest(int fd)
+    {
+        auto it = epoll_notifiers.find(fd);
+        if (it == epoll_notifiers.end()) {
+            // The descriptor may already have been closed, which drops it from the interest list by itself.
+            (void)epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+            return;
+        }
+
+        epoll_event event {};
+        for (auto* notifier : it->value)
+            event.events |= notification_type_to_epoll_events(notifier->type());
+        event.data.fd = fd;
+
+        // A descriptor number we still have notifiers for may have been closed and reused since it was added, in
+        // which case the kernel has already forgotten it and it needs adding again (and vice versa).
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event) == 0)
+            return;
+        if (errno == ENOENT && epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0)
+            return;
+        if (errno == EEXIST && epoll_ctl(epoll_fd, EPOLL_CTL_MOD, fd, &event) == 0)
+            return;
+        dbgln("EventLoopImplementationUnix: Unable to watch fd {} with epoll: {}", fd, Error::from_errno(errno));
+    }
+
+    // Only used when epoll_fd is valid. epoll accepts a single registration per descriptor, so notifiers are grouped
+    // by fd and the kernel is told about the union of what they are waiting for.
+    int epoll_fd { -1 };
+    HashMap<int, Vector<Notifier*, 1>> epoll_notifiers;
+    Vector<epoll_event> epoll_events;
+#endif
+
     // The wake pipe is used to notify another event loop that someone has called wake(), or a signal has been received.
     // wake() writes 0i32 into the pipe, signals write the signal number (guaranteed non-zero).
     Array<int, 2> wake_pipe_fds { -1, -1 };
@@ -371,6 +463,36 @@ void EventLoopManagerUnix::wait_for_events(EventLoopImplementation::PumpMode mod
     auto& thread_data = ThreadData::the();
     Sync::MutexLocker locker(thread_data.mutex);
 
+    // Handles signals and calls to wake(). Returns true if the pipe was full of signals only, so that more of them
+    // may be waiting behind those and we should go around again.
+    auto drain_wake_pipe = [&] {
+        int wake_events[8];
+        ssize_t nread;
+        // We might receive another signal while read()ing here. The signal will go to the handle_signal properly,
+        // but we get interrupted. Therefore, just retry while we were interrupted.
+        do {
+            errno = 0;
+            nread = read(thread_data.wake_pipe_fds[0], wake_events, sizeof(wake_events));
+            if (nread == 0)
+                break;
+        } while (nread < 0 && errno == EINTR);
+        if (nread < 0) {
+            perror("EventLoopImplementationUnix::wait_for_events: read from wake pipe");
+            VERIFY_NOT_REACHED();
+        }
+        VERIFY(nread > 0);
+        bool wake_requested = false;
+        int event_count = nread / sizeof(wake_events[0]);
+        for (int i = 0; i < event_count; i++) {
+            if (wake_events[i] != 0)
+                dispatch_signal(wake_events[i]);
+            else
+                wake_requested = true;
+        }
+
+        return !wake_requested && nread == sizeof(wake_events);
+    };
+
 retry:
     bool has_pending_events = ThreadEventQueue::current().has_pending_events();
 
@@ -394,6 +516,57 @@ retry:
         }
     }
 
+#ifdef EVENT_LOOP_HAS_EPOLL
+    if (thread_data.epoll_fd >= 0) {
+        int event_count = 0;
+        do {
+            event_count = epoll_wait(thread_data.epoll_fd, thread_data.epoll_events.data(), static_cast<int>(thread_data.epoll_events.size()), should_wait_forever ? -1 : timeout);
+        } while (event_count < 0 && errno == EINTR);
+        auto time_after_wait = MonotonicTime::now_coarse();
+        if (event_count < 0) {
+            dbgln("EventLoopImplementationUnix::wait_for_events: {}", Error::from_errno(errno));
+            VERIFY_NOT_REACHED();
+        }
+
+        auto events = thread_data.epoll_events.span().trim(event_count);
+
+        // Deal with the wake pipe before any notifier. If we go around again, every descriptor that is still ready is
+        // reported again by the next wait, so nothing must have been posted for it yet.
+        for (auto const& event : events) {
+            if (event.data.fd == thread_data.wake_pipe_fds[0] && drain_wake_pipe())
+                goto retry;
+        }
+
+        for (auto const& event : events) {
+            if (event.data.fd == thread_data.wake_pipe_fds[0])
+                continue;
+
+            // A signal handler run from the wake pipe may have unregistered the notifiers for this descriptor.
+            auto notifiers = thread_data.epoll_notifiers.get(event.data.fd);
+            if (!notifiers.has_value())
+                continue;
+
+            NotificationType type = NotificationType::None;
+            if (has_flag(event.events, EPOLLIN))
+                type |= NotificationType::Read;
+            if (has_flag(event.events, EPOLLOUT))
+                type |= NotificationType::Write;
+            if (has_flag(event.events, EPOLLHUP))
+                type |= NotificationType::Read | NotificationType::Write | NotificationType::HangUp;
+            if (has_flag(event.events, EPOLLERR))
+                type |= NotificationType::Error;
+
+            for (auto* notifier : *notifiers) {
+                if ((type & notifier->type()) != NotificationType::None)
+                    ThreadEventQueue::current().post_event(notifier, Core::Event::Type::NotifierActivation);
+            }
+        }
+
+        thread_data.timeouts.fire_expired(time_after_wait);
+        return;
+    }
+#endif
+
 try_select_again:
     // select() and wait for file system events, calls to wake(), POSIX signals, or timer expirations.
     auto error_or_marked_fd_count = System::poll(thread_data.poll_fds, should_wait_forever ? -1 : timeout);
@@ -409,31 +582,7 @@ try_select_again:
     // We woke up due to a call to wake() or a POSIX signal.
     // Handle signals and see whether we need to handle events as well.
     if (has_flag(thread_data.poll_fds[0].revents, POLLIN)) {
-        int wake_events[8];
-        ssize_t nread;
-        // We might receive another signal while read()ing here. The signal will go to the handle_signal properly,
-        // but we get interrupted. Therefore, just retry while we were interrupted.
-        do {
-            errno = 0;
-            nread = read(thread_data.wake_pipe_fds[0], wake_events, sizeof(wake_events));
-            if (nread == 0)
-                break;
-        } while (nread < 0 && errno == EINTR);
-        if (nread < 0) {
-            perror("EventLoopImplementationUnix::wait_for_events: read from wake pipe");
-            VERIFY_NOT_REACHED();
-        }
-        VERIFY(nread > 0);
-        bool wake_requested = false;
-        int event_count = nread / sizeof(wake_events[0]);
-        for (int i = 0; i < event_count; i++) {
-            if (wake_events[i] != 0)
-                dispatch_signal(wake_events[i]);
-            else
-                wake_requested = true;
-        }
-
-        if (!wake_requested && nread == sizeof(wake_events))
+        if (drain_wake_pipe())
             goto retry;
     }
 
@@ -694,6 +843,15 @@ void EventLoopManagerUnix::register_notifier(Notifier& notifier)
     auto& thread_data = ThreadData::the();
     Sync::MutexLocker locker(thread_data.mutex);
 
+#ifdef EVENT_LOOP_HAS_EPOLL
+    if (thread_data.epoll_fd >= 0) {
+        thread_data.epoll_notifiers.ensure(notifier.fd()).append(&notifier);
+        thread_data.update_epoll_interest(notifier.fd());
+        notifier.set_owner_thread(thread_data.thread_id);
+        return;
+    }
+#endif
+
     thread_data.notifier_to_index.set(&notifier, thread_data.poll_fds.size());
     thread_data.notifiers.append(&notifier);
 
@@ -711,6 +869,18 @@ void EventLoopManagerUnix::unregister_notifier(Notifier& notifier)
         return;
     Sync::MutexLocker thread_data_content_locker(thread_data->mutex);
 
+#ifdef EVENT_LOOP_HAS_EPOLL
+    if (thread_data->epoll_fd >= 0) {
+        auto it = thread_data->epoll_notifiers.find(notifier.fd());
+        VERIFY(it != thread_data->epoll_notifiers.end());
+        it->value.remove_first_matching([&](auto* entry) { return entry == &notifier; });
+        if (it->value.is_empty())
+            thread_data->epoll_notifiers.remove(it);
+        thread_data->update_epoll_interest(notifier.fd());
+        return;
+    }
+#endif
+
     auto notifier_index = thread_data->notifier_to_index.take(&notifier).release_value();
 
     if (notifier_index + 1 < thread_data->poll_fds.size()) {
@@ -29,4 +29,13 @@ struct ProcessStatistics {
 
 CORE_API ErrorOr<void> update_process_statistics(ProcessStatistics&);
 
+struct SystemMemoryStatistics {
+    u64 total_bytes { 0 };
+
+    // Memory that can be handed out without swapping, including caches the system would drop to make room
+    u64 available_bytes { 0 };
+};
+
+CORE_API ErrorOr<SystemMemoryStatistics> system_memory_statistics();
+
 }
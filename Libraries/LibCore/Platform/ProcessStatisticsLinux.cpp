@@ -76,4 +76,31 @@ ErrorOr<void> update_process_statistics(ProcessStatistics& statistics)
     return {};
 }
 
+ErrorOr<SystemMemoryStatistics> system_memory_statistics()
+{
+    static NeverDestroyed<NonnullOwnPtr<Core::File>> proc_meminfo { TRY(Core::File::open("/proc/meminfo"sv, Core::File::OpenMode::Read)) };
+    TRY((*proc_meminfo)->seek(0, SeekMode::SetPosition));
+
+    // MemTotal and MemAvailable are the first and third lines, well within the first read
+    char buf[1024] = {};
+    auto buffer = Bytes { buf, sizeof(buf) - 1 };
+    auto contents = StringView { TRY((*proc_meminfo)->read_some(buffer)) };
+
+    auto value_in_kib = [&](StringView name) -> ErrorOr<u64> {
+        auto start = contents.find(name);
+        if (!start.has_value())
+            return Error::from_string_literal("Failed to parse /proc/meminfo");
+
+        unsigned long long value = 0;
+        if (sscanf(contents.characters_without_null_termination() + *start + name.length(), " %llu kB", &value) != 1)
+            return Error::from_string_literal("Failed to parse /proc/meminfo");
+        return value;
+    };
+
+    SystemMemoryStatistics statistics;
+    statistics.total_bytes = TRY(value_in_kib("MemTotal:"sv)) * KiB;
+    statistics.available_bytes = TRY(value_in_kib("MemAvailable:"sv)) * KiB;
+    return statistics;
+}
+
 }
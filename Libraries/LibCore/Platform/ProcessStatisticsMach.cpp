@@ -73,4 +73,31 @@ ErrorOr<void> update_process_statistics(ProcessStatistics& statistics)
     return {};
 }
 
+ErrorOr<SystemMemoryStatistics> system_memory_statistics()
+{
+    host_basic_info_data_t basic_info {};
+    mach_msg_type_number_t count = HOST_BASIC_INFO_COUNT;
+    auto res = host_info(mach_host_self(), HOST_BASIC_INFO, reinterpret_cast<host_info_t>(&basic_info), &count);
+    if (res != KERN_SUCCESS) {
+        dbgln("Failed to get host basic info: {}", mach_error_string(res));
+        return Core::mach_error_to_error(res);
+    }
+
+    vm_statistics64_data_t vm_info {};
+    count = HOST_VM_INFO64_COUNT;
+    res = host_statistics64(mach_host_self(), HOST_VM_INFO64, reinterpret_cast<host_info64_t>(&vm_info), &count);
+    if (res != KERN_SUCCESS) {
+        dbgln("Failed to get host VM statistics: {}", mach_error_string(res));
+        return Core::mach_error_to_error(res);
+    }
+
+    // Inactive and purgeable pages are given up without swapping when something else needs them
+    u64 available_pages = static_cast<u64>(vm_info.free_count) + vm_info.inactive_count + vm_info.purgeable_count;
+
+    SystemMemoryStatistics statistics;
+    statistics.total_bytes = basic_info.max_mem;
+    statistics.available_bytes = available_pages * vm_page_size;
+    return statistics;
+}
+
 }
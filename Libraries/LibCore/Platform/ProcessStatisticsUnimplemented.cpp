@@ -13,4 +13,9 @@ ErrorOr<void> update_process_statistics(ProcessStatistics&)
     return {};
 }
 
+ErrorOr<SystemMemoryStatistics> system_memory_statistics()
+{
+    return Error::from_string_literal("System memory statistics are not implemented on this platform");
+}
+
 }
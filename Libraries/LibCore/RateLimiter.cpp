@@ -4,62 +4,101 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Checked.h>
 #include <LibCore/RateLimiter.h>
 
 namespace Core {
 
+static constexpr i64 nanoseconds_per_second = 1'000'000'000;
+
 TokenBucketRateLimiter::TokenBucketRateLimiter(size_t capacity, size_t refill_rate_per_second)
-    : m_capacity(capacity)
-    , m_tokens(capacity)
-    , m_refill_rate(refill_rate_per_second)
-    , m_last_refill(UnixDateTime::now())
+    : TokenBucketRateLimiter(capacity, AK::Duration::from_nanoseconds(refill_rate_per_second > 0 ? max<i64>(1, nanoseconds_per_second / static_cast<i64>(refill_rate_per_second)) : 0))
 {
 }
 
-void TokenBucketRateLimiter::refill_tokens_locked()
+TokenBucketRateLimiter::TokenBucketRateLimiter(size_t capacity, AK::Duration refill_interval)
+    : m_capacity(capacity)
+    , m_refill_interval_ns(refill_interval.to_nanoseconds())
+    , m_full_at_ns(now_ns())
 {
-    auto now = UnixDateTime::now();
-    auto elapsed = now - m_last_refill;
+    VERIFY(m_refill_interval_ns > 0);
+    VERIFY(!Checked<i64>::multiplication_would_overflow(m_refill_interval_ns, static_cast<i64>(capacity)));
+    m_capacity_ns = m_refill_interval_ns * static_cast<i64>(capacity);
+}
 
-    if (elapsed.to_seconds() <= 0)
-        return;
+i64 TokenBucketRateLimiter::now_ns()
+{
+    // NB: A coarse clock is good enough here, since refill intervals are at least several milliseconds long in practice,
+    //     and it is much cheaper to read on every request.
+    return MonotonicTime::now_coarse().nanoseconds();
+}
 
-    auto tokens_to_add = static_cast<size_t>(elapsed.to_seconds() * m_refill_rate);
+i64 TokenBucketRateLimiter::debt_ns(i64 full_at_ns, i64 now_ns) const
+{
+    // NB: Threads may read slightly different times from the clock, so another thread may have moved the time at which
+    //     the bucket is full again a little further ahead than our own reading of the clock would allow.
+    return clamp(full_at_ns - now_ns, 0, m_capacity_ns);
+}
 
-    if (tokens_to_add > 0) {
-        m_tokens = min(m_capacity, m_tokens + tokens_to_add);
-        m_last_refill = now;
-    }
+i64 TokenBucketRateLimiter::cost_ns(size_t tokens) const
+{
+    // More tokens than the bucket holds can never be consumed, so there's no need to compute their exact cost.
+    if (tokens > m_capacity)
+        return NumericLimits<i64>::max();
+    return m_refill_interval_ns * static_cast<i64>(tokens);
 }
 
 bool TokenBucketRateLimiter::try_consume(size_t tokens)
 {
-    Sync::MutexLocker locker(m_mutex);
-    refill_tokens_locked();
-    if (m_tokens >= tokens) {
-        m_tokens -= tokens;
-        return true;
+    auto cost = cost_ns(tokens);
+    auto now = now_ns();
+    auto full_at = m_full_at_ns.load(AK::memory_order_relaxed);
+
+    while (true) {
+        auto debt = debt_ns(full_at, now);
+        if (cost > m_capacity_ns - debt) {
+            m_rejected_count.fetch_add(1, AK::memory_order_relaxed);
+            return false;
+        }
+
+        // On failure, this reloads the time another thread stored, so we can try again with it.
+        if (m_full_at_ns.compare_exchange_strong(full_at, now + debt + cost, AK::memory_order_acq_rel))
+            return true;
     }
-    return false;
 }
 
 bool TokenBucketRateLimiter::would_allow(size_t tokens) const
 {
-    Sync::MutexLocker locker(m_mutex);
-    return m_tokens >= tokens;
+    auto debt = debt_ns(m_full_at_ns.load(AK::memory_order_relaxed), now_ns());
+    return cost_ns(tokens) <= m_capacity_ns - debt;
 }
 
 size_t TokenBucketRateLimiter::available_tokens() const
 {
-    Sync::MutexLocker locker(m_mutex);
-    return m_tokens;
+    auto debt = debt_ns(m_full_at_ns.load(AK::memory_order_relaxed), now_ns());
+    return static_cast<size_t>((m_capacity_ns - debt) / m_refill_interval_ns);
+}
+
+AK::Duration TokenBucketRateLimiter::time_until_available(size_t tokens) const
+{
+    if (tokens > m_capacity)
+        return AK::Duration::max();
+
+    auto debt = debt_ns(m_full_at_ns.load(AK::memory_order_relaxed), now_ns());
+    auto wait = debt + cost_ns(tokens) - m_capacity_ns;
+    if (wait <= 0)
+        return AK::Duration::zero();
+    return AK::Duration::from_nanoseconds(wait);
 }
 
 void TokenBucketRateLimiter::reset()
 {
-    Sync::MutexLocker locker(m_mutex);
-    m_tokens = m_capacity;
-    m_last_refill = UnixDateTime::now();
+    m_full_at_ns.store(now_ns(), AK::memory_order_relaxed);
+}
+
+size_t TokenBucketRateLimiter::refill_rate() const
+{
+    return static_cast<size_t>(nanoseconds_per_second / m_refill_interval_ns);
 }
 
 }
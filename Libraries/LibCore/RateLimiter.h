@@ -6,54 +6,76 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
 #include <AK/Time.h>
-#include <LibSync/Mutex.h>
 
 namespace Core {
 
 // Token bucket algorithm for rate limiting
-// Thread-safe implementation using mutex protection
+// Lock-free: the whole bucket is a single timestamp that is updated with compare-and-swap, so it can be consulted on
+// hot paths such as IPC message dispatch from multiple threads without taking a lock.
 class TokenBucketRateLimiter {
+    AK_MAKE_NONCOPYABLE(TokenBucketRateLimiter);
+    AK_MAKE_NONMOVABLE(TokenBucketRateLimiter);
+
 public:
     // Create a rate limiter with capacity and refill rate
     // capacity: Maximum number of tokens in the bucket (burst size)
-    // refill_rate_per_second: How many tokens to add per second
+    // refill_rate_per_second: How many tokens to add per second, must not be zero
     TokenBucketRateLimiter(size_t capacity, size_t refill_rate_per_second);
 
+    // Create a rate limiter with capacity that adds one token every refill_interval, which must not be zero
+    TokenBucketRateLimiter(size_t capacity, AK::Duration refill_interval);
+
     // Try to consume tokens, returns true if allowed
     // tokens: Number of tokens to consume (default 1)
     // Thread-safe: Can be called from multiple threads
-    bool try_consume(size_t tokens = 1);
+    [[nodiscard]] bool try_consume(size_t tokens = 1);
 
     // Check if request would be allowed without consuming tokens
     // tokens: Number of tokens to check (default 1)
     // Thread-safe: Can be called from multiple threads
-    bool would_allow(size_t tokens = 1) const;
+    [[nodiscard]] bool would_allow(size_t tokens = 1) const;
 
     // Get current token count (may be approximate due to refill timing)
     // Thread-safe: Can be called from multiple threads
     size_t available_tokens() const;
 
+    // Get time until the given number of tokens is available, or Duration::max() if it exceeds the capacity
+    // Thread-safe: Can be called from multiple threads
+    AK::Duration time_until_available(size_t tokens = 1) const;
+
     // Reset bucket to full capacity (for testing or admin override)
     // Thread-safe: Can be called from multiple threads
     void reset();
 
+    // Telemetry: Number of requests rejected since creation or the last reset_rejected_count()
+    u64 rejected_count() const { return m_rejected_count.load(AK::memory_order_relaxed); }
+    void reset_rejected_count() { m_rejected_count.store(0, AK::memory_order_relaxed); }
+
     // Get configuration
     size_t capacity() const { return m_capacity; }
-    size_t refill_rate() const { return m_refill_rate; }
+    size_t refill_rate() const;
+    AK::Duration refill_interval() const { return AK::Duration::from_nanoseconds(m_refill_interval_ns); }
 
 private:
-    // Refill tokens based on time elapsed since last refill
-    // Must be called with mutex held
-    void refill_tokens_locked();
+    static i64 now_ns();
+    i64 debt_ns(i64 full_at_ns, i64 now_ns) const;
+    i64 cost_ns(size_t tokens) const;
 
     size_t m_capacity;
-    size_t m_tokens;
-    size_t m_refill_rate;
-    UnixDateTime m_last_refill;
+    i64 m_refill_interval_ns;
+
+    // How long it takes to refill an empty bucket
+    i64 m_capacity_ns;
+
+    // The time on the coarse monotonic clock at which the bucket is full again. Consuming a token moves it one refill
+    // interval into the future, and a request is allowed as long as that doesn't put it more than a whole bucket's
+    // worth of refill intervals ahead of the current time.
+    Atomic<i64> m_full_at_ns;
 
-    // Mutex for thread safety
-    mutable Sync::Mutex m_mutex;
+    Atomic<u64> m_rejected_count { 0 };
 };
 
 }
@@ -536,6 +536,29 @@ ErrorOr<pid_t> LocalSocket::peer_pid() const
 #endif
 }
 
+ErrorOr<uid_t> LocalSocket::peer_uid() const
+{
+#if defined(AK_OS_GNU_HURD)
+    return Error::from_errno(ENOTSUP);
+#elif defined(AK_OS_SOLARIS)
+    ucred_t* creds = NULL;
+    socklen_t creds_size = sizeof(creds);
+    TRY(System::getsockopt(m_helper.fd(), SOL_SOCKET, SO_RECVUCRED, &creds, &creds_size));
+    return ucred_geteuid(creds);
+#elif defined(AK_OS_BSD_GENERIC)
+    uid_t uid;
+    gid_t gid;
+    if (getpeereid(m_helper.fd(), &uid, &gid) < 0)
+        return Error::from_syscall("getpeereid"sv, errno);
+    return uid;
+#else
+    struct ucred creds = {};
+    socklen_t creds_size = sizeof(creds);
+    TRY(System::getsockopt(m_helper.fd(), SOL_SOCKET, SO_PEERCRED, &creds, &creds_size));
+    return creds.uid;
+#endif
+}
+
 ErrorOr<Bytes> LocalSocket::read_without_waiting(Bytes buffer)
 {
     return m_helper.read(buffer, MSG_DONTWAIT);
@@ -37,6 +37,14 @@ static int memfd_create(char const* name, unsigned int flags)
 #    include <sys/sendfile.h>
 #endif
 
+#if defined(AK_OS_FREEBSD)
+#    include <sys/uio.h>
+#endif
+
+#if defined(AK_OS_LINUX) || defined(AK_OS_ANDROID) || defined(AK_OS_FREEBSD) || defined(AK_OS_NETBSD) || defined(AK_OS_OPENBSD)
+#    include <link.h>
+#endif
+
 #if defined(AK_OS_MACOS) || defined(AK_OS_IOS)
 #    include <mach-o/dyld.h>
 #    include <sys/mman.h>
@@ -786,6 +794,28 @@ ErrorOr<ByteString> current_executable_path()
     return ByteString { path, strlen(path) };
 }
 
+ErrorOr<Vector<ByteString>> loaded_library_paths()
+{
+    Vector<ByteString> paths;
+#if defined(AK_OS_LINUX) || defined(AK_OS_ANDROID) || defined(AK_OS_FREEBSD) || defined(AK_OS_NETBSD) || defined(AK_OS_OPENBSD)
+    dl_iterate_phdr([](struct dl_phdr_info* info, size_t, void* data) {
+        // NB: The executable itself is listed without a name.
+        if (info->dlpi_name && *info->dlpi_name)
+            static_cast<Vector<ByteString>*>(data)->append(info->dlpi_name);
+        return 0;
+    },
+        &paths);
+#elif defined(AK_OS_MACOS) || defined(AK_OS_IOS)
+    for (u32 i = 0; i < _dyld_image_count(); ++i) {
+        if (auto const* name = _dyld_get_image_name(i); name && *name)
+            paths.append(name);
+    }
+#else
+    return Error::from_string_literal("loaded_library_paths unknown");
+#endif
+    return paths;
+}
+
 ErrorOr<rlimit> get_resource_limits(int resource)
 {
     rlimit limits;
@@ -855,9 +885,23 @@ ErrorOr<size_t> transfer_file_through_socket(int source_fd, int target_fd, size_
             return Error::from_syscall("sendfile"sv, errno);
     }
     return sent_length;
+#elif defined(AK_OS_FREEBSD)
+    if (source_length == 0)
+        return 0;
+    off_t sent_length = 0;
+    auto result = ::sendfile(source_fd, target_fd, static_cast<off_t>(source_offset), source_length, nullptr, &sent_length, 0);
+    if (result != 0) {
+        if ((errno != EAGAIN && errno != EBUSY && errno != EINTR) || sent_length == 0)
+            return Error::from_syscall("sendfile"sv, errno);
+    }
+    return static_cast<size_t>(sent_length);
 #else
     static auto page_size = PAGE_SIZE;
 
+    // A non-blocking socket only takes as much as fits in its send buffer, so there is no point mapping more than this.
+    static constexpr size_t maximum_mapped_transfer_size = 1 * MiB;
+    source_length = min(source_length, maximum_mapped_transfer_size);
+
     // mmap requires the offset to be page-aligned, so we must handle that here.
     auto aligned_source_offset = (source_offset / page_size) * page_size;
     auto offset_adjustment = source_offset - aligned_source_offset;
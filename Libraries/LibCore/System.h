@@ -153,6 +153,7 @@ CORE_API unsigned hardware_concurrency();
 CORE_API u64 physical_memory_bytes();
 
 CORE_API ErrorOr<ByteString> current_executable_path();
+CORE_API ErrorOr<Vector<ByteString>> loaded_library_paths();
 
 #if !defined(AK_OS_WINDOWS)
 ErrorOr<rlimit> get_resource_limits(int resource);
@@ -370,6 +370,11 @@ ErrorOr<ByteString> current_executable_path()
     return TRY(Process::get_name()).to_byte_string();
 }
 
+ErrorOr<Vector<ByteString>> loaded_library_paths()
+{
+    return Error::from_string_literal("loaded_library_paths unknown");
+}
+
 ErrorOr<void> set_close_on_exec(int handle, bool enabled)
 {
     if (!SetHandleInformation(to_handle(handle), HANDLE_FLAG_INHERIT, enabled ? 0 : HANDLE_FLAG_INHERIT))
@@ -451,6 +456,10 @@ ErrorOr<size_t> transfer_file_through_socket(int source_fd, int target_fd, size_
         return system_info.dwAllocationGranularity;
     }();
 
+    // A non-blocking socket only takes as much as fits in its send buffer, so there is no point mapping more than this.
+    static constexpr size_t maximum_mapped_transfer_size = 1 * MiB;
+    source_length = min(source_length, maximum_mapped_transfer_size);
+
     // MapViewOfFile requires the offset to be aligned to the system allocation granularity, so we must handle that here.
     auto aligned_source_offset = (source_offset / allocation_granularity) * allocation_granularity;
     auto offset_adjustment = source_offset - aligned_source_offset;
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Atomic.h>
+#include <AK/Vector.h>
+#include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
+
+namespace Core {
+
+static constexpr size_t TRACE_EVENT_BUFFER_SIZE = 4 * MiB;
+
+struct TraceEventBufferHeader {
+    u32 enabled;
+    u32 capacity;
+    u64 next_event_index;
+    i32 pid;
+};
+
+struct TraceEventSlot {
+    // Zero while the slot is being written, and the event's index plus one once it has been. The reader uses this to
+    // skip events that were torn by a writer lapping it.
+    u64 sequence;
+    i64 start_time_in_nanoseconds;
+    i64 duration_in_nanoseconds;
+    u64 thread_id;
+    char category[16];
+    char name[80];
+};
+static_assert(sizeof(TraceEventSlot) == 128);
+
+static constexpr size_t TRACE_EVENT_HEADER_SIZE = sizeof(TraceEventSlot);
+static_assert(sizeof(TraceEventBufferHeader) <= TRACE_EVENT_HEADER_SIZE);
+
+static Atomic<TraceEventBufferHeader*> s_trace_event_buffer_header { nullptr };
+
+// NB: Buffers are never unmapped once a process has recorded into them, since another thread might still be mid-way
+//     through writing an event. There's only ever one per tracing session, so this doesn't add up to much.
+static Vector<AnonymousBuffer>& trace_event_buffers()
+{
+    static Vector<AnonymousBuffer> buffers;
+    return buffers;
+}
+
+static TraceEventBufferHeader* header_of(AnonymousBuffer const& buffer)
+{
+    if (!buffer.is_valid() || buffer.size() < TRACE_EVENT_BUFFER_SIZE)
+        return nullptr;
+    return const_cast<TraceEventBufferHeader*>(buffer.data<TraceEventBufferHeader>());
+}
+
+static TraceEventSlot* slots_of(TraceEventBufferHeader* header)
+{
+    return reinterpret_cast<TraceEventSlot*>(reinterpret_cast<u8*>(header) + TRACE_EVENT_HEADER_SIZE);
+}
+
+static u64 current_thread_id()
+{
+    static Atomic<u64> next_thread_id { 1 };
+    thread_local u64 thread_id = next_thread_id.fetch_add(1, AK::memory_order_relaxed);
+    return thread_id;
+}
+
+template<size_t Size>
+static void copy_truncated(char (&destination)[Size], StringView source)
+{
+    auto length = min(source.length(), Size - 1);
+    __builtin_memcpy(destination, source.characters_without_null_termination(), length);
+    destination[length] = '\0';
+}
+
+AnonymousBuffer create_trace_event_buffer()
+{
+    auto buffer = MUST(AnonymousBuffer::create_with_size(TRACE_EVENT_BUFFER_SIZE));
+
+    auto* header = buffer.data<TraceEventBufferHeader>();
+    header->capacity = (TRACE_EVENT_BUFFER_SIZE - TRACE_EVENT_HEADER_SIZE) / sizeof(TraceEventSlot);
+    header->next_event_index = 0;
+    header->pid = 0;
+    AK::atomic_store(&header->enabled, 1u, AK::memory_order_release);
+
+    return buffer;
+}
+
+void set_trace_event_buffer(AnonymousBuffer buffer)
+{
+    auto* header = header_of(buffer);
+    if (!header)
+        return;
+
+    header->pid = System::getpid();
+    trace_event_buffers().append(move(buffer));
+    s_trace_event_buffer_header.store(header, AK::memory_order_release);
+}
+
+void disable_trace_event_buffer(AnonymousBuffer& buffer)
+{
+    if (auto* header = header_of(buffer))
+        AK::atomic_store(&header->enabled, 0u, AK::memory_order_release);
+}
+
+bool is_tracing_enabled()
+{
+    auto* header = s_trace_event_buffer_header.load(AK::memory_order_acquire);
+    return header && AK::atomic_load(&header->enabled, AK::memory_order_relaxed) != 0;
+}
+
+void record_trace_event(StringView category, StringView name, MonotonicTime start_time, MonotonicTime end_time)
+{
+    auto* header = s_trace_event_buffer_header.load(AK::memory_order_acquire);
+    if (!header || AK::atomic_load(&header->enabled, AK::memory_order_relaxed) == 0)
+        return;
+
+    // The buffer is a ring: once it is full, new events overwrite the oldest ones.
+    auto index = AK::atomic_fetch_add(&header->next_event_index, static_cast<u64>(1), AK::memory_order_relaxed);
+    auto& slot = slots_of(header)[index % header->capacity];
+
+    AK::atomic_store(&slot.sequence, static_cast<u64>(0), AK::memory_order_relaxed);
+    AK::atomic_thread_fence(AK::memory_order_release);
+
+    slot.start_time_in_nanoseconds = start_time.nanoseconds();
+    slot.duration_in_nanoseconds = (end_time - start_time).to_nanoseconds();
+    slot.thread_id = current_thread_id();
+    copy_truncated(slot.category, category);
+    copy_truncated(slot.name, name);
+
+    AK::atomic_store(&slot.sequence, index + 1, AK::memory_order_release);
+}
+
+Optional<i32> trace_event_buffer_pid(AnonymousBuffer const& buffer)
+{
+    auto* header = header_of(buffer);
+    if (!header || header->pid == 0)
+        return {};
+    return header->pid;
+}
+
+void for_each_trace_event(AnonymousBuffer const& buffer, Function<void(TraceEvent const&)> const& callback)
+{
+    auto* header = header_of(buffer);
+    if (!header)
+        return;
+
+    auto next_event_index = AK::atomic_load(&header->next_event_index, AK::memory_order_acquire);
+    auto first_event_index = next_event_index > header->capacity ? next_event_index - header->capacity : 0;
+    auto* slots = slots_of(header);
+
+    for (auto index = first_event_index; index < next_event_index; ++index) {
+        auto& slot = slots[index % header->capacity];
+        if (AK::atomic_load(&slot.sequence, AK::memory_order_acquire) != index + 1)
+            continue;
+
+        TraceEventSlot copy;
+        __builtin_memcpy(&copy, &slot, sizeof(copy));
+
+        AK::atomic_thread_fence(AK::memory_order_acquire);
+        if (AK::atomic_load(&slot.sequence, AK::memory_order_relaxed) != index + 1)
+            continue;
+
+        copy.category[sizeof(copy.category) - 1] = '\0';
+        copy.name[sizeof(copy.name) - 1] = '\0';
+
+        callback(TraceEvent {
+            .category = StringView { copy.category, __builtin_strlen(copy.category) },
+            .name = StringView { copy.name, __builtin_strlen(copy.name) },
+            .start_time_in_nanoseconds = copy.start_time_in_nanoseconds,
+            .duration_in_nanoseconds = copy.duration_in_nanoseconds,
+            .thread_id = copy.thread_id,
+        });
+    }
+}
+
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Function.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/StringView.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+#include <LibCore/AnonymousBuffer.h>
+#include <LibCore/Export.h>
+
+namespace Core {
+
+// A span of time spent doing something, as recorded into a process's trace event buffer. Events are fixed size so that
+// recording one is just a copy into shared memory, with names that don't fit being truncated.
+struct TraceEvent {
+    StringView category;
+    StringView name;
+    i64 start_time_in_nanoseconds { 0 };
+    i64 duration_in_nanoseconds { 0 };
+    u64 thread_id { 0 };
+};
+
+// The trace event buffer is shared memory created by the UI process and handed to each process it wants to trace. The
+// process records events into it with no IPC at all, and the UI reads them back out when tracing stops. Timestamps
+// come from the monotonic clock, which is the same across processes, so the UI can line events from every process up
+// on a single timeline.
+[[nodiscard]] CORE_API AnonymousBuffer create_trace_event_buffer();
+CORE_API void set_trace_event_buffer(AnonymousBuffer);
+
+// Stops every process that shares the buffer from recording any more events.
+CORE_API void disable_trace_event_buffer(AnonymousBuffer&);
+
+[[nodiscard]] CORE_API bool is_tracing_enabled();
+CORE_API void record_trace_event(StringView category, StringView name, MonotonicTime start_time, MonotonicTime end_time);
+
+CORE_API Optional<i32> trace_event_buffer_pid(AnonymousBuffer const&);
+CORE_API void for_each_trace_event(AnonymousBuffer const&, Function<void(TraceEvent const&)> const&);
+
+// Records a trace event covering its own lifetime. An empty name records nothing, for spans that turn out not to be
+// worth recording.
+class TraceEventScope {
+    AK_MAKE_NONCOPYABLE(TraceEventScope);
+    AK_MAKE_NONMOVABLE(TraceEventScope);
+
+public:
+    TraceEventScope(StringView category, StringView name)
+    {
+        if (!name.is_empty() && is_tracing_enabled()) {
+            m_category = category;
+            m_name = name;
+            m_start_time = MonotonicTime::now();
+        }
+    }
+
+    ~TraceEventScope()
+    {
+        if (m_start_time.has_value())
+            record_trace_event(m_category, m_name, *m_start_time, MonotonicTime::now());
+    }
+
+private:
+    StringView m_category;
+    StringView m_name;
+    Optional<MonotonicTime> m_start_time;
+};
+
+}
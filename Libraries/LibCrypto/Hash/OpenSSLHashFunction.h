@@ -86,7 +86,13 @@ public:
     {
         auto hasher = create();
         hasher->update(data, length);
-        return hasher->digest();
+
+        // NB: Unlike digest(), don't reset the context for another round, as it's about to be freed anyway.
+        DigestT digest;
+        if (EVP_DigestFinal_ex(hasher->m_context, digest.data, nullptr) != 1) {
+            VERIFY_NOT_REACHED();
+        }
+        return digest;
     }
 
     static DigestT hash(ByteBuffer const& buffer) { return hash(buffer.data(), buffer.size()); }
@@ -5,13 +5,20 @@
  */
 
 #include <LibCrypto/Hash/SHA1.h>
+#include <LibCrypto/OpenSSL.h>
 
 #include <openssl/evp.h>
 
 namespace Crypto::Hash {
 
+static EVP_MD const* sha1_digest()
+{
+    static auto const* digest = fetch_digest("SHA1", EVP_sha1());
+    return digest;
+}
+
 SHA1::SHA1(EVP_MD_CTX* context)
-    : OpenSSLHashFunction(EVP_sha1(), context)
+    : OpenSSLHashFunction(sha1_digest(), context)
 {
 }
 
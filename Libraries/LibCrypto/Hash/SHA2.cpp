@@ -5,23 +5,42 @@
  */
 
 #include <LibCrypto/Hash/SHA2.h>
+#include <LibCrypto/OpenSSL.h>
 
 #include <openssl/evp.h>
 
 namespace Crypto::Hash {
 
+static EVP_MD const* sha256_digest()
+{
+    static auto const* digest = fetch_digest("SHA256", EVP_sha256());
+    return digest;
+}
+
+static EVP_MD const* sha384_digest()
+{
+    static auto const* digest = fetch_digest("SHA384", EVP_sha384());
+    return digest;
+}
+
+static EVP_MD const* sha512_digest()
+{
+    static auto const* digest = fetch_digest("SHA512", EVP_sha512());
+    return digest;
+}
+
 SHA256::SHA256(EVP_MD_CTX* context)
-    : OpenSSLHashFunction(EVP_sha256(), context)
+    : OpenSSLHashFunction(sha256_digest(), context)
 {
 }
 
 SHA384::SHA384(EVP_MD_CTX* context)
-    : OpenSSLHashFunction(EVP_sha384(), context)
+    : OpenSSLHashFunction(sha384_digest(), context)
 {
 }
 
 SHA512::SHA512(EVP_MD_CTX* context)
-    : OpenSSLHashFunction(EVP_sha512(), context)
+    : OpenSSLHashFunction(sha512_digest(), context)
 {
 }
 
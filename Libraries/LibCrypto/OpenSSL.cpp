@@ -67,6 +67,13 @@ ErrorOr<StringView> hash_kind_to_openssl_digest_name(Hash::HashKind hash)
     }
 }
 
+EVP_MD const* fetch_digest(char const* name, EVP_MD const* fallback)
+{
+    if (auto* digest = EVP_MD_fetch(nullptr, name, nullptr))
+        return digest;
+    return fallback;
+}
+
 ErrorOr<ByteBuffer> get_byte_buffer_param_from_key(OpenSSL_PKEY& key, char const* key_name)
 {
     size_t size;
@@ -133,6 +133,11 @@ ErrorOr<UnsignedBigInteger> openssl_bignum_to_unsigned_big_integer(OpenSSL_BN co
 
 ErrorOr<StringView> hash_kind_to_openssl_digest_name(Hash::HashKind hash);
 
+// Fetches a digest implementation up front, falling back to the given one if the provider doesn't have it. Contexts
+// initialised with the EVP_sha256()-style digests look the implementation up again every time, which adds up for
+// hashers that are created (and reset) over and over again. The result is never freed.
+EVP_MD const* fetch_digest(char const* name, EVP_MD const* fallback);
+
 ErrorOr<ByteBuffer> get_byte_buffer_param_from_key(OpenSSL_PKEY& key, char const* key_name);
 
 }
@@ -120,6 +120,41 @@ ErrorOr<size_t> Message::to_raw(ByteBuffer& out) const
     return out.size() - start_size;
 }
 
+ErrorOr<void> Message::pad_to_block_size(size_t block_size)
+{
+    VERIFY(block_size > 0);
+
+    // https://www.rfc-editor.org/rfc/rfc7830#section-3
+    // The option goes in the message's OPT pseudo-RR, which we have to add if there isn't one yet.
+    auto opt_index = additional_records.find_first_index_if([](auto const& record) { return record.type == ResourceType::OPT; });
+    if (!opt_index.has_value()) {
+        additional_records.append(ResourceRecord {
+            .name = DomainName::from_string(""sv),
+            .type = ResourceType::OPT,
+            .class_ = Class::IN,
+            .ttl = 0,
+            .record = Records::OPT {
+                .udp_payload_size = 4096,
+                .extended_rcode_and_flags = 0,
+                .options = {},
+            },
+            .raw = {},
+        });
+        header.additional_count = header.additional_count + 1;
+        opt_index = additional_records.size() - 1;
+    }
+
+    auto& options = additional_records[*opt_index].record.get<Records::OPT>().options;
+    options.append({ .code = Records::OPT::OptionCodePadding, .data = {} });
+
+    // The option's own code and length fields count towards the size, so measure with an empty one in place.
+    ByteBuffer encoded;
+    auto size = TRY(to_raw(encoded));
+    auto padding_size = (block_size - size % block_size) % block_size;
+    options.last().data = TRY(ByteBuffer::create_zeroed(padding_size));
+    return {};
+}
+
 ErrorOr<String> Message::format_for_log() const
 {
     StringBuilder builder;
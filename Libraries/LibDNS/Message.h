@@ -645,6 +645,9 @@ struct OPT {
     static constexpr u32 MaskVersion = 0b00000000111100000000000000000000;
     static constexpr u32 MaskDO = 0b00000000000000001000000000000000;
 
+    // https://www.rfc-editor.org/rfc/rfc7830#section-3
+    static constexpr u16 OptionCodePadding = 12;
+
     static constexpr ResourceType type = ResourceType::OPT;
 
     constexpr u8 extended_rcode() const { return (extended_rcode_and_flags & MaskExtendedRCode) >> 24; }
@@ -728,6 +731,9 @@ struct DNS_API Message {
     static ErrorOr<Message> from_raw(Stream&);
     ErrorOr<size_t> to_raw(ByteBuffer&) const;
 
+    // Adds an EDNS(0) Padding option that makes the encoded message a multiple of block_size octets long.
+    ErrorOr<void> pad_to_block_size(size_t block_size);
+
     ErrorOr<String> format_for_log() const;
 };
 
@@ -70,6 +70,11 @@ class Resolver;
 class LookupResult : public AtomicRefCounted<LookupResult>
     , public Weakable<LookupResult> {
 public:
+    // Records are refreshed in the background once they are this close to expiring, and may be served for this long
+    // after expiring while that refresh is in flight (RFC 8767).
+    static constexpr AK::Duration REFRESH_AHEAD = AK::Duration::from_seconds(10);
+    static constexpr AK::Duration MAXIMUM_STALENESS = AK::Duration::from_seconds(30);
+
     explicit LookupResult(Messages::DomainName name)
         : m_name(move(name))
     {
@@ -100,7 +105,7 @@ public:
         auto now = AK::UnixDateTime::now();
         for (size_t i = 0; i < m_cached_records.size();) {
             auto& record = m_cached_records[i];
-            if (record.expiration.has_value() && record.expiration.value() < now) {
+            if (record.expiration.has_value() && record.expiration.value() + MAXIMUM_STALENESS < now) {
                 dbgln_if(DNS_DEBUG, "DNS: Removing expired record for {}", m_name.to_string());
                 m_cached_records.remove(i);
             } else {
@@ -110,10 +115,37 @@ public:
             }
         }
 
-        if (m_cached_records.is_empty() && m_request_done)
+        if (m_negative_expiration.has_value() && m_negative_expiration.value() < now)
+            m_negative_expiration.clear();
+
+        if (m_cached_records.is_empty() && m_request_done && !m_negative_expiration.has_value())
             m_valid = false;
     }
 
+    // https://www.rfc-editor.org/rfc/rfc2308#section-5
+    // Remembers that the name has no records of the types asked for, until the given time.
+    void set_negative_expiration(AK::UnixDateTime expiration)
+    {
+        m_valid = true;
+        m_negative_expiration = expiration;
+    }
+
+    bool is_stale() const
+    {
+        auto now = AK::UnixDateTime::now();
+        return any_of(m_cached_records, [&](auto const& record) { return record.expiration.has_value() && record.expiration.value() < now; });
+    }
+
+    bool is_due_for_refresh() const
+    {
+        auto refresh_time = AK::UnixDateTime::now() + REFRESH_AHEAD;
+        return any_of(m_cached_records, [&](auto const& record) { return record.expiration.has_value() && record.expiration.value() < refresh_time; });
+    }
+
+    // While a refresh of this name is in flight, lookups are answered from the result it is replacing.
+    RefPtr<LookupResult const> const& previous_result() const { return m_previous_result; }
+    void set_previous_result(RefPtr<LookupResult const> previous_result) { m_previous_result = move(previous_result); }
+
     void add_record(Messages::ResourceRecord record)
     {
         m_valid = true;
@@ -172,7 +204,11 @@ public:
     }
 
     void will_add_record_of_type(Messages::ResourceType type) { m_desired_types.set(type); }
-    void finished_request() { m_request_done = true; }
+    void finished_request()
+    {
+        m_request_done = true;
+        m_previous_result = nullptr;
+    }
 
     void set_id(u16 id) { m_id = id; }
     u16 id() { return m_id; }
@@ -206,6 +242,8 @@ private:
     };
 
     Vector<RecordWithExpiration> m_cached_records;
+    Optional<AK::UnixDateTime> m_negative_expiration;
+    RefPtr<LookupResult const> m_previous_result;
     HashTable<Messages::ResourceType> m_desired_types;
     Vector<Messages::Records::DNSKEY> m_used_dnskeys {};
     HashTable<u16> m_seen_key_tags;
@@ -233,12 +271,25 @@ public:
         bool validate_dnssec_locally { false };
         PendingLookup* repeating_lookup { nullptr };
 
+        // Skips the cache, replacing the cached result once the new one arrives
+        bool refresh { false };
+
         static LookupOptions default_() { return {}; }
     };
 
     struct SocketResult {
         MaybeOwned<Core::Socket> socket;
         ConnectionMode mode;
+        // Queries sent over encrypted transports (DNS-over-TLS) are padded so their size doesn't give the name away.
+        bool is_encrypted { false };
+    };
+
+    struct CacheStatistics {
+        u64 hits { 0 };
+        u64 negative_hits { 0 };
+        u64 stale_hits { 0 };
+        u64 misses { 0 };
+        u64 refreshes { 0 };
     };
 
     Resolver(Function<ErrorOr<SocketResult>()> create_socket)
@@ -292,7 +343,12 @@ public:
             if (it == cache.end())
                 return {};
 
-            auto& result = *it->value;
+            // A refresh of a still-usable result is in flight, so keep answering from that result until it lands.
+            auto const* cached_result = it->value.ptr();
+            if (!cached_result->is_done() && cached_result->previous_result())
+                cached_result = cached_result->previous_result().ptr();
+
+            auto& result = *cached_result;
             // For completed lookups, treat a previously-asked-about type with no records as a hit (negative cache)
             // — getaddrinfo and async DNS often return only A when the host has no AAAA. In-flight lookups must
             // still fall through to the join-pending path, so gate on is_done().
@@ -339,7 +395,71 @@ public:
 
     NonnullRefPtr<Core::Promise<NonnullRefPtr<LookupResult const>>> lookup(ByteString name, Messages::Class class_ = Messages::Class::IN, LookupOptions options = LookupOptions::default_())
     {
-        return lookup(move(name), class_, { Messages::ResourceType::A, Messages::ResourceType::AAAA }, options);
+        return lookup_addresses(move(name), class_, options);
+    }
+
+    // Looks up both the IPv4 and IPv6 addresses of a name. The A and AAAA questions go out as two queries in parallel, as
+    // few servers answer more than one question per message, and the result is handed out as soon as it is usable: right
+    // away once there are IPv6 addresses, or after the Resolution Delay if only the IPv4 ones have arrived.
+    // https://www.rfc-editor.org/rfc/rfc8305#section-3
+    NonnullRefPtr<Core::Promise<NonnullRefPtr<LookupResult const>>> lookup_addresses(ByteString name, Messages::Class class_ = Messages::Class::IN, LookupOptions options = LookupOptions::default_())
+    {
+        Vector<Messages::ResourceType> address_types { Messages::ResourceType::A, Messages::ResourceType::AAAA };
+
+        // NB: Whatever isn't answered by a query on our own connection already handles both types at once: literal
+        //     addresses, loopback names, cache hits, and the system resolver, which races both families by itself.
+        //     Refreshes can't be split either, as the second query would replace the cache entry the first one fills in.
+        auto is_literal_or_loopback = IPv4Address::from_string(name).has_value() || IPv6Address::from_string(name).has_value() || name == "localhost"sv || name.ends_with(".localhost"sv);
+        if (is_literal_or_loopback || options.refresh || options.repeating_lookup || lookup_in_cache(name, class_, address_types) || !has_connection())
+            return lookup(move(name), class_, move(address_types), options);
+
+        auto state = adopt_ref(*new PendingAddressLookup(Core::Promise<NonnullRefPtr<LookupResult const>>::construct()));
+
+        // NB: Both queries fill in the same cache entry, so either side's result carries all of the addresses found so far.
+        auto handle_completion = [state](Messages::ResourceType type, ErrorOr<NonnullRefPtr<LookupResult const>> result_or_error) {
+            (type == Messages::ResourceType::A ? state->a_completed : state->aaaa_completed) = true;
+            if (result_or_error.is_error())
+                state->error = result_or_error.release_error();
+            else
+                state->result = result_or_error.release_value();
+
+            if (state->promise_settled)
+                return;
+
+            if (state->a_completed && state->aaaa_completed) {
+                finalize_pending_address_lookup(*state);
+                return;
+            }
+
+            if (!state->result || !state->result->has_cached_addresses())
+                return;
+
+            // A positive AAAA answer is used right away; a positive A answer waits a little for the AAAA one to catch up.
+            if (type == Messages::ResourceType::AAAA) {
+                finalize_pending_address_lookup(*state);
+                return;
+            }
+
+            if (state->resolution_delay_timer)
+                return;
+            state->resolution_delay_timer = Core::Timer::create_single_shot(RESOLUTION_DELAY_MS, [weak_state = state->make_weak_ptr()] {
+                if (auto state = weak_state.strong_ref())
+                    finalize_pending_address_lookup(*state);
+            });
+            state->resolution_delay_timer->start();
+        };
+
+        for (auto type : { Messages::ResourceType::AAAA, Messages::ResourceType::A }) {
+            lookup(name, class_, Vector { type }, options)
+                ->when_resolved([handle_completion, type](auto& result) {
+                    handle_completion(type, result);
+                })
+                .when_rejected([handle_completion, type](auto& error) {
+                    handle_completion(type, Error::copy(error));
+                });
+        }
+
+        return state->promise;
     }
 
     NonnullRefPtr<Core::Promise<NonnullRefPtr<LookupResult const>>> lookup(ByteString name, Messages::Class class_, Vector<Messages::ResourceType> desired_types, LookupOptions options = LookupOptions::default_())
@@ -413,10 +533,21 @@ public:
             return promise;
         }
 
-        if (auto result = lookup_in_cache(name, class_, desired_types)) {
+        if (auto result = options.refresh ? nullptr : lookup_in_cache(name, class_, desired_types)) {
             dbgln_if(DNS_DEBUG, "DNS: Resolving {} from cache...", name);
             if (!options.validate_dnssec_locally || result->is_dnssec_validated()) {
                 dbgln_if(DNS_DEBUG, "DNS: Resolved {} from cache", name);
+                count_in_cache_statistics(&CacheStatistics::hits);
+                if (result->is_empty())
+                    count_in_cache_statistics(&CacheStatistics::negative_hits);
+                if (result->is_stale())
+                    count_in_cache_statistics(&CacheStatistics::stale_hits);
+
+                // Names that are looked up again close to their expiry are likely to be looked up again after it, so
+                // resolve them ahead of time rather than on the critical path of that later lookup.
+                if (result->is_due_for_refresh())
+                    refresh_in_background(name, class_, desired_types, options.validate_dnssec_locally);
+
                 promise->resolve(result.release_nonnull());
                 lookup_path = "cache-hit"sv;
                 return promise;
@@ -424,6 +555,9 @@ public:
             dbgln_if(DNS_DEBUG, "DNS: Cache entry for {} is not DNSSEC validated (and we expect that), re-resolving", name);
         }
 
+        if (!options.repeating_lookup)
+            count_in_cache_statistics(&CacheStatistics::misses);
+
         auto domain_name = Messages::DomainName::from_string(name);
 
         if (!has_connection()) {
@@ -535,13 +669,22 @@ public:
                 return nullptr;
             }();
 
-            if (existing) {
+            if (existing && !options.refresh) {
                 dbgln_if(DNS_DEBUG, "DNS: Resolved {} from cache", name);
+                // NB: A parallel query for another type of the same name shares this entry, so remember that its type
+                //     was asked about too; otherwise an empty answer for it would never be cached.
+                for (auto const& type : desired_types)
+                    existing->will_add_record_of_type(type);
                 return *existing;
             }
 
             dbgln_if(DNS_DEBUG, "DNS: Adding {} to cache", name);
             auto ptr = make_ref_counted<LookupResult>(domain_name);
+            if (existing) {
+                already_in_cache = false;
+                if (existing->is_done() && !existing->is_empty())
+                    ptr->set_previous_result(existing);
+            }
             if (!ptr->is_dnssec_validated())
                 ptr->set_dnssec_validated(options.validate_dnssec_locally);
             for (auto const& type : desired_types)
@@ -625,6 +768,15 @@ public:
             });
         }
 
+        // https://www.rfc-editor.org/rfc/rfc8467#section-4.1
+        // Clients SHOULD pad queries to the closest multiple of 128 octets.
+        if (m_connection_is_encrypted) {
+            if (auto result = query.pad_to_block_size(128); result.is_error()) {
+                promise->reject(result.release_error());
+                return promise;
+            }
+        }
+
         result->set_id(query.header.id);
 
         auto cached_entry = options.repeating_lookup
@@ -641,7 +793,7 @@ public:
                   p->repeat_timer->set_single_shot(true);
                   p->repeat_timer->set_interval(1000);
                   p->repeat_timer->on_timeout = [=, this] {
-                      (void)lookup(name, class_, desired_types, { .validate_dnssec_locally = options.validate_dnssec_locally, .repeating_lookup = p });
+                      (void)lookup(name, class_, desired_types, { .validate_dnssec_locally = options.validate_dnssec_locally, .repeating_lookup = p, .refresh = options.refresh });
                   };
 
                   return nullptr;
@@ -695,7 +847,61 @@ public:
         return promise;
     }
 
+    CacheStatistics cache_statistics()
+    {
+        return m_cache_statistics.with_read_locked([](auto const& statistics) { return statistics; });
+    }
+
 private:
+    static constexpr u32 MAXIMUM_NEGATIVE_TTL_SECONDS = 300;
+
+    // https://www.rfc-editor.org/rfc/rfc8305#section-3
+    static constexpr int RESOLUTION_DELAY_MS = 50;
+
+    void count_in_cache_statistics(u64 CacheStatistics::* counter)
+    {
+        m_cache_statistics.with_write_locked([&](auto& statistics) { ++(statistics.*counter); });
+    }
+
+    void refresh_in_background(ByteString const& name, Messages::Class class_, Span<Messages::ResourceType const> desired_types, bool validate_dnssec_locally)
+    {
+        auto is_new_refresh = m_names_being_refreshed.with_write_locked([&](auto& names) {
+            return names.set(name) == AK::HashSetResult::InsertedNewEntry;
+        });
+        if (!is_new_refresh)
+            return;
+
+        dbgln_if(DNS_DEBUG, "DNS: Refreshing {} ahead of its expiry", name);
+        count_in_cache_statistics(&CacheStatistics::refreshes);
+
+        auto forget_refresh = [this, name] {
+            m_names_being_refreshed.with_write_locked([&](auto& names) { names.remove(name); });
+        };
+
+        lookup(name, class_, Vector<Messages::ResourceType> { desired_types }, { .validate_dnssec_locally = validate_dnssec_locally, .refresh = true })
+            ->when_resolved([forget_refresh](auto&) { forget_refresh(); })
+            .when_rejected([forget_refresh](auto&) { forget_refresh(); });
+    }
+
+    // https://www.rfc-editor.org/rfc/rfc2308#section-5
+    static Optional<u32> negative_response_ttl(Messages::Message const& message)
+    {
+        auto response_code = message.header.options.response_code();
+        if (response_code != Messages::Options::ResponseCode::NoError && response_code != Messages::Options::ResponseCode::NameError)
+            return {};
+
+        // "The TTL of this record is set from the minimum of the MINIMUM field of the SOA record and the TTL of the SOA
+        // itself, and indicates how long a resolver may cache the negative answer."
+        for (auto const& record : message.authorities) {
+            if (auto const* soa = record.record.get_pointer<Messages::Records::SOA>())
+                return min(min(record.ttl, soa->minimum), MAXIMUM_NEGATIVE_TTL_SECONDS);
+        }
+
+        // "Negative responses without SOA records SHOULD NOT be cached as there is no way to prevent the negative
+        // responses looping forever between a pair of servers even with a short TTL."
+        return {};
+    }
+
     // Per-name state for an in-flight system-resolver lookup. We split the
     // single AF_UNSPEC `getaddrinfo` call into two parallel calls (AF_INET +
     // AF_INET6) so that buggy stub resolvers (notably systemd-resolved under
@@ -734,6 +940,39 @@ private:
         }
     };
 
+    struct PendingAddressLookup
+        : public RefCounted<PendingAddressLookup>
+        , public Weakable<PendingAddressLookup> {
+        NonnullRefPtr<Core::Promise<NonnullRefPtr<LookupResult const>>> promise;
+        RefPtr<LookupResult const> result;
+        Optional<Error> error;
+        bool a_completed { false };
+        bool aaaa_completed { false };
+        bool promise_settled { false };
+        RefPtr<Core::Timer> resolution_delay_timer;
+
+        explicit PendingAddressLookup(NonnullRefPtr<Core::Promise<NonnullRefPtr<LookupResult const>>> p)
+            : promise(move(p))
+        {
+        }
+    };
+
+    // Idempotent, like try_finalize_pending_system_resolution(), as both the completions and the timer may get here.
+    static void finalize_pending_address_lookup(PendingAddressLookup& state)
+    {
+        if (state.promise_settled)
+            return;
+        state.promise_settled = true;
+        if (state.resolution_delay_timer) {
+            state.resolution_delay_timer->stop();
+            state.resolution_delay_timer = nullptr;
+        }
+        if (state.result)
+            state.promise->resolve(*state.result);
+        else
+            state.promise->reject(state.error.has_value() ? state.error.release_value() : Error::from_string_literal("Could not resolve to IPv4 or IPv6 address"));
+    }
+
     // Resolve (or reject) every joined caller's promise from `state` and tear down any pending grace timer.
     // Idempotent — safe to call from both the main completion path and from the grace timer callback.
     static void try_finalize_pending_system_resolution(PendingSystemResolution& state)
@@ -786,6 +1025,11 @@ private:
         bool both_completed = state.a.has_value() && state.aaaa.has_value();
 
         if (both_completed) {
+            // getaddrinfo does not say how long a name is known not to exist, so remember it only briefly.
+            constexpr u32 SYSTEM_RESOLVER_NEGATIVE_TTL_SECONDS = 10;
+            if (state.result->is_empty())
+                state.result->set_negative_expiration(AK::UnixDateTime::now() + AK::Duration::from_seconds(SYSTEM_RESOLVER_NEGATIVE_TTL_SECONDS));
+
             state.result->finished_request();
             m_cache.with_write_locked([&](auto& cache) {
                 cache.set(name, state.result);
@@ -816,7 +1060,6 @@ private:
         // (RFC 8305 Resolution Delay, 50 ms).
         if (state.grace_timer)
             return;
-        constexpr int RESOLUTION_DELAY_MS = 50;
         auto weak_state = state.make_weak_ptr();
         state.grace_timer = Core::Timer::create_single_shot(RESOLUTION_DELAY_MS, [weak_state] {
             if (auto state = weak_state.strong_ref())
@@ -893,6 +1136,11 @@ private:
                 for (auto& record : message.answers)
                     result->add_record(move(record));
 
+                if (result->is_empty()) {
+                    if (auto ttl = negative_response_ttl(message); ttl.has_value() && *ttl > 0)
+                        result->set_negative_expiration(AK::UnixDateTime::now() + AK::Duration::from_seconds(*ttl));
+                }
+
                 result->finished_request();
                 lookup->promise->resolve(*result);
                 lookups->remove(message.header.id);
@@ -1380,17 +1628,18 @@ private:
                 return false;
             }
 
-            auto [socket, mode] = MUST(move(create_result));
-            set_socket(move(socket), mode);
+            auto [socket, mode, is_encrypted] = MUST(move(create_result));
+            set_socket(move(socket), mode, is_encrypted);
             result = true;
         }
 
         return result;
     }
 
-    void set_socket(MaybeOwned<Core::Socket> socket, ConnectionMode mode = ConnectionMode::UDP)
+    void set_socket(MaybeOwned<Core::Socket> socket, ConnectionMode mode = ConnectionMode::UDP, bool is_encrypted = false)
     {
         m_mode = mode;
+        m_connection_is_encrypted = is_encrypted;
         m_socket.with_write_locked([&](auto& s) {
             s = move(socket);
             (*s)->on_ready_to_read = [this] {
@@ -1420,12 +1669,15 @@ private:
     }
 
     Sync::RWLockProtected<HashMap<ByteString, NonnullRefPtr<LookupResult>>> m_cache;
+    Sync::RWLockProtected<HashTable<ByteString>> m_names_being_refreshed;
+    Sync::RWLockProtected<CacheStatistics> m_cache_statistics;
     Sync::RWLockProtected<HashMap<ByteString, NonnullRefPtr<PendingSystemResolution>>> m_pending_system_resolutions;
     Sync::RWLockProtected<NonnullOwnPtr<RedBlackTree<u16, PendingLookup>>> m_pending_lookups;
     Sync::RWLockProtected<Optional<MaybeOwned<Core::Socket>>> m_socket;
     Function<ErrorOr<SocketResult>()> m_create_socket;
     bool m_attempting_restart { false };
     ConnectionMode m_mode { ConnectionMode::UDP };
+    bool m_connection_is_encrypted { false };
     Vector<NonnullRefPtr<Core::Promise<Empty>>> m_socket_ready_promises;
 };
 
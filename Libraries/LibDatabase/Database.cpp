@@ -4,11 +4,17 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
 #include <AK/ByteString.h>
+#include <AK/Debug.h>
+#include <AK/QuickSort.h>
+#include <AK/ScopeGuard.h>
 #include <AK/String.h>
 #include <AK/Time.h>
 #include <LibCore/Directory.h>
 #include <LibDatabase/Database.h>
+#include <LibThreading/ThreadPool.h>
 
 #include <sqlite3.h>
 
@@ -56,33 +62,124 @@ static constexpr StringView sql_error(int error_code)
     __ENUMERATE_TYPE(float)              \
     __ENUMERATE_TYPE(double)
 
-ErrorOr<NonnullRefPtr<Database>> Database::create_memory_backed()
+// The size of the write-ahead log, in pages, at which SQLite would start checkpointing by default.
+static constexpr int WRITE_AHEAD_LOG_CHECKPOINT_PAGE_COUNT = 1000;
+
+// OPTIMIZATION: A checkpoint copies the write-ahead log back into the database file and syncs it to disk, which is the
+//               one part of a write that can stall for a long time. SQLite would run it during whichever commit grows
+//               the log past its limit, i.e. on the thread making the write. We run it on a background thread instead,
+//               using a second connection to the same file.
+class BackgroundCheckpointer : public AtomicRefCounted<BackgroundCheckpointer> {
+public:
+    static RefPtr<BackgroundCheckpointer> create(LexicalPath const& database_path)
+    {
+        sqlite3* connection { nullptr };
+
+        if (auto result = sqlite3_open_v2(database_path.string().characters(), &connection, SQLITE_OPEN_READWRITE, nullptr); result != SQLITE_OK) {
+            dbgln("Unable to open a checkpoint connection to {}: {}", database_path, sql_error(result));
+            sqlite3_close(connection);
+            return nullptr;
+        }
+
+        return adopt_ref(*new BackgroundCheckpointer(connection));
+    }
+
+    ~BackgroundCheckpointer()
+    {
+        sqlite3_close(m_connection);
+    }
+
+    void checkpoint_soon()
+    {
+        if (m_has_pending_checkpoint.exchange(true))
+            return;
+
+        Threading::ThreadPool::the().submit([checkpointer = NonnullRefPtr { *this }]() {
+            // NB: A passive checkpoint never waits on the connection that does the writing, it just copies as much of the
+            //     log as it can. Whatever is left over is picked up by the next checkpoint.
+            if (auto result = sqlite3_wal_checkpoint_v2(checkpointer->m_connection, nullptr, SQLITE_CHECKPOINT_PASSIVE, nullptr, nullptr); result != SQLITE_OK && result != SQLITE_BUSY)
+                dbgln("Unable to checkpoint database: {}", sql_error(result));
+
+            checkpointer->m_has_pending_checkpoint = false;
+        },
+            Threading::ThreadPool::Priority::Background);
+    }
+
+private:
+    explicit BackgroundCheckpointer(sqlite3* connection)
+        : m_connection(connection)
+    {
+    }
+
+    sqlite3* m_connection { nullptr };
+    Atomic<bool> m_has_pending_checkpoint { false };
+};
+
+ErrorOr<NonnullRefPtr<Database>> Database::create_memory_backed(Profile profile)
 {
     sqlite3* sql_database { nullptr };
     SQL_TRY(sqlite3_open(":memory:", &sql_database));
-    return create(sql_database);
+    return create(sql_database, profile);
 }
 
-ErrorOr<NonnullRefPtr<Database>> Database::create(ByteString const& directory, StringView name)
+ErrorOr<NonnullRefPtr<Database>> Database::create(ByteString const& directory, StringView name, Profile profile)
 {
     TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes));
     LexicalPath database_path { ByteString::formatted("{}/{}.db", directory, name) };
     sqlite3* sql_database { nullptr };
     SQL_TRY(sqlite3_open(database_path.string().characters(), &sql_database));
-    return create(sql_database, database_path);
+    return create(sql_database, profile, database_path);
 }
 
-ErrorOr<NonnullRefPtr<Database>> Database::create(sqlite3* sql_database, Optional<LexicalPath> database_path)
+ErrorOr<NonnullRefPtr<Database>> Database::create(sqlite3* sql_database, Profile profile, Optional<LexicalPath> database_path)
 {
     auto database = TRY(adopt_nonnull_ref_or_enomem(new (nothrow) Database(sql_database, move(database_path))));
+    TRY(database->apply_profile(profile));
 
-    // Enable the WAL and set the synchronous pragma to normal by default for performance.
-    TRY(database->set_journal_mode_pragma(JournalMode::WriteAheadLog));
-    TRY(database->set_synchronous_pragma(Synchronous::Normal));
+    if (database->m_database_path.has_value())
+        database->m_background_checkpointer = BackgroundCheckpointer::create(*database->m_database_path);
+
+    // NB: Installing a WAL hook replaces SQLite's own automatic checkpoints.
+    if (database->m_background_checkpointer)
+        sqlite3_wal_hook(database->m_database, did_commit_to_write_ahead_log, database.ptr());
 
     return database;
 }
 
+ErrorOr<void> Database::apply_profile(Profile profile)
+{
+    TRY(set_journal_mode_pragma(JournalMode::WriteAheadLog));
+    TRY(set_temp_store_pragma(TempStore::Memory));
+
+    switch (profile) {
+    case Profile::UserData:
+        TRY(set_synchronous_pragma(Synchronous::Normal));
+        TRY(set_cache_size_pragma(4 * MiB));
+        TRY(set_mmap_size_pragma(32 * MiB));
+        break;
+    case Profile::Cache:
+        TRY(set_synchronous_pragma(Synchronous::Off));
+        TRY(set_cache_size_pragma(8 * MiB));
+        TRY(set_mmap_size_pragma(256 * MiB));
+        break;
+    case Profile::Telemetry:
+        TRY(set_synchronous_pragma(Synchronous::Normal));
+        TRY(set_cache_size_pragma(512 * KiB));
+        TRY(set_mmap_size_pragma(0));
+        break;
+    }
+
+    return {};
+}
+
+int Database::did_commit_to_write_ahead_log(void* database, sqlite3*, char const*, int page_count)
+{
+    if (page_count >= WRITE_AHEAD_LOG_CHECKPOINT_PAGE_COUNT)
+        static_cast<Database*>(database)->m_background_checkpointer->checkpoint_soon();
+
+    return SQLITE_OK;
+}
+
 Database::Database(sqlite3* database, Optional<LexicalPath> database_path)
     : m_database_path(move(database_path))
     , m_database(database)
@@ -95,6 +192,35 @@ Database::~Database()
     for (auto* prepared_statement : m_prepared_statements)
         sqlite3_finalize(prepared_statement);
 
+    if (m_background_checkpointer)
+        sqlite3_wal_hook(m_database, nullptr, nullptr);
+
+    if constexpr (DATABASE_DEBUG) {
+        Vector<StatementID> statement_ids;
+        for (StatementID statement_id = 0; statement_id < m_statement_statistics.size(); ++statement_id) {
+            if (m_statement_statistics[statement_id].execution_count != 0)
+                statement_ids.append(statement_id);
+        }
+
+        quick_sort(statement_ids, [&](auto left, auto right) {
+            return m_statement_statistics[left].total_time > m_statement_statistics[right].total_time;
+        });
+
+        dbgln("[Database] Statement statistics for {}:", m_database_path.has_value() ? m_database_path->string() : "(memory)"sv);
+
+        for (auto statement_id : statement_ids) {
+            auto const& statistics = m_statement_statistics[statement_id];
+            auto const* sql_characters = sqlite3_sql(m_prepared_statements[statement_id]);
+            StringView sql { sql_characters, __builtin_strlen(sql_characters) };
+
+            dbgln("[Database]     {} executions, {}ms total, {}ms longest: {}",
+                statistics.execution_count,
+                statistics.total_time.to_milliseconds(),
+                statistics.longest_time.to_milliseconds(),
+                sql.trim_whitespace());
+        }
+    }
+
     sqlite3_close(m_database);
 }
 
@@ -106,6 +232,9 @@ ErrorOr<StatementID> Database::prepare_statement(StringView statement)
     auto statement_id = m_prepared_statements.size();
     m_prepared_statements.append(prepared_statement);
 
+    if constexpr (DATABASE_DEBUG)
+        m_statement_statistics.append({});
+
     return statement_id;
 }
 
@@ -113,6 +242,22 @@ void Database::execute_statement_internal(StatementID statement_id, OnResult on_
 {
     auto* statement = prepared_statement(statement_id);
 
+    // NB: This includes the time spent in on_result.
+    Optional<MonotonicTime> start_time;
+    if constexpr (DATABASE_DEBUG)
+        start_time = MonotonicTime::now();
+
+    ScopeGuard record_statistics = [&] {
+        if (start_time.has_value()) {
+            auto elapsed_time = MonotonicTime::now() - *start_time;
+
+            auto& statistics = m_statement_statistics[statement_id];
+            ++statistics.execution_count;
+            statistics.total_time += elapsed_time;
+            statistics.longest_time = max(statistics.longest_time, elapsed_time);
+        }
+    };
+
     while (true) {
         auto result = sqlite3_step(statement);
 
@@ -249,4 +394,41 @@ ErrorOr<void> Database::set_synchronous_pragma(Synchronous synchronous)
     return {};
 }
 
+ErrorOr<void> Database::set_cache_size_pragma(u64 size_in_bytes)
+{
+    // NB: A negative cache size is in KiB, a positive one in pages.
+    auto pragma = ByteString::formatted("PRAGMA cache_size=-{};", size_in_bytes / KiB);
+    SQL_TRY(sqlite3_exec(m_database, pragma.characters(), nullptr, nullptr, nullptr));
+
+    return {};
+}
+
+ErrorOr<void> Database::set_mmap_size_pragma(u64 size_in_bytes)
+{
+    auto pragma = ByteString::formatted("PRAGMA mmap_size={};", size_in_bytes);
+    SQL_TRY(sqlite3_exec(m_database, pragma.characters(), nullptr, nullptr, nullptr));
+
+    return {};
+}
+
+ErrorOr<void> Database::set_temp_store_pragma(TempStore temp_store)
+{
+    auto temp_store_string = [&]() {
+        switch (temp_store) {
+        case TempStore::Default:
+            return "DEFAULT"sv;
+        case TempStore::File:
+            return "FILE"sv;
+        case TempStore::Memory:
+            return "MEMORY"sv;
+        }
+        VERIFY_NOT_REACHED();
+    }();
+
+    auto pragma = ByteString::formatted("PRAGMA temp_store={};", temp_store_string);
+    SQL_TRY(sqlite3_exec(m_database, pragma.characters(), nullptr, nullptr, nullptr));
+
+    return {};
+}
+
 }
@@ -12,7 +12,9 @@
 #include <AK/LexicalPath.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
 #include <AK/StringView.h>
+#include <AK/Time.h>
 #include <AK/Vector.h>
 #include <LibDatabase/Forward.h>
 
@@ -21,10 +23,25 @@ struct sqlite3_stmt;
 
 namespace Database {
 
+class BackgroundCheckpointer;
+
+// How a database trades durability for speed. Every profile writes through a write-ahead log.
+enum class Profile : u8 {
+    // Data the user expects to keep, like history, cookies and site storage. A crash of the process never loses a
+    // commit, but a power loss may lose the latest ones.
+    UserData,
+    // Data that can be rebuilt at any time, like the HTTP disk cache index. Writes are never synced to disk, and reads
+    // go through a large memory map.
+    Cache,
+    // Data that is written often in small pieces and rarely read back, like security telemetry. It keeps the page cache
+    // small instead of mapping the file.
+    Telemetry,
+};
+
 class DATABASE_API Database : public RefCounted<Database> {
 public:
-    static ErrorOr<NonnullRefPtr<Database>> create_memory_backed();
-    static ErrorOr<NonnullRefPtr<Database>> create(ByteString const& directory, StringView name);
+    static ErrorOr<NonnullRefPtr<Database>> create_memory_backed(Profile = Profile::UserData);
+    static ErrorOr<NonnullRefPtr<Database>> create(ByteString const& directory, StringView name, Profile = Profile::UserData);
     ~Database();
 
     using OnResult = Function<void(StatementID)>;
@@ -72,12 +89,29 @@ public:
     };
     ErrorOr<void> set_synchronous_pragma(Synchronous);
 
+    // https://www.sqlite.org/pragma.html#pragma_cache_size
+    ErrorOr<void> set_cache_size_pragma(u64 size_in_bytes);
+
+    // https://www.sqlite.org/pragma.html#pragma_mmap_size
+    ErrorOr<void> set_mmap_size_pragma(u64 size_in_bytes);
+
+    // https://www.sqlite.org/pragma.html#pragma_temp_store
+    enum class TempStore {
+        Default,
+        File,
+        Memory,
+    };
+    ErrorOr<void> set_temp_store_pragma(TempStore);
+
 private:
-    static ErrorOr<NonnullRefPtr<Database>> create(sqlite3*, Optional<LexicalPath> database_path = {});
+    static ErrorOr<NonnullRefPtr<Database>> create(sqlite3*, Profile, Optional<LexicalPath> database_path = {});
+    ErrorOr<void> apply_profile(Profile);
     Database(sqlite3*, Optional<LexicalPath> database_path);
 
     void execute_statement_internal(StatementID, OnResult);
 
+    static int did_commit_to_write_ahead_log(void*, sqlite3*, char const*, int page_count);
+
     int bound_parameter_count(StatementID);
 
     template<typename ValueType>
@@ -92,6 +126,15 @@ private:
     Optional<LexicalPath> m_database_path;
     sqlite3* m_database { nullptr };
     Vector<sqlite3_stmt*> m_prepared_statements;
+    RefPtr<BackgroundCheckpointer> m_background_checkpointer;
+
+    // Only collected with DATABASE_DEBUG, and logged once the database is closed.
+    struct StatementStatistics {
+        size_t execution_count { 0 };
+        AK::Duration total_time;
+        AK::Duration longest_time;
+    };
+    Vector<StatementStatistics> m_statement_statistics;
 };
 
 }
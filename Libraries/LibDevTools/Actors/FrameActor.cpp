@@ -65,8 +65,8 @@ FrameActor::FrameActor(DevToolsServer& devtools, String name, WeakPtr<TabActor>
             weak_callback(*this, [](auto& self, DevToolsDelegate::NetworkResponseData data) {
                 self.on_network_response_headers_received(move(data));
             }),
-            weak_callback(*this, [](auto& self, u64 request_id, ByteBuffer data) {
-                self.on_network_response_body_received(request_id, move(data));
+            weak_callback(*this, [](auto& self, u64 request_id, ReadonlyBytes data) {
+                self.on_network_response_body_received(request_id, data);
             }),
             weak_callback(*this, [](auto& self, DevToolsDelegate::NetworkRequestCompleteData data) {
                 self.on_network_request_finished(move(data));
@@ -520,13 +520,13 @@ void FrameActor::on_network_response_headers_received(DevToolsDelegate::NetworkR
     send_message(move(message));
 }
 
-void FrameActor::on_network_response_body_received(u64 request_id, ByteBuffer data)
+void FrameActor::on_network_response_body_received(u64 request_id, ReadonlyBytes data)
 {
     auto it = m_network_events.find(request_id);
     if (it == m_network_events.end())
         return;
 
-    it->value->append_response_body(move(data));
+    it->value->append_response_body(data);
 }
 
 void FrameActor::on_network_request_finished(DevToolsDelegate::NetworkRequestCompleteData data)
@@ -46,7 +46,7 @@ void NetworkEventActor::set_response_headers(Vector<HTTP::Header> response_heade
     m_response_headers = move(response_headers);
 }
 
-void NetworkEventActor::append_response_body(ByteBuffer data)
+void NetworkEventActor::append_response_body(ReadonlyBytes data)
 {
     // Limit response body size to prevent memory issues
     if (m_response_body.size() >= MAX_RESPONSE_BODY_SIZE)
@@ -56,7 +56,7 @@ void NetworkEventActor::append_response_body(ByteBuffer data)
     auto bytes_to_append = min(data.size(), remaining_capacity);
 
     if (bytes_to_append > 0)
-        m_response_body.append(data.bytes().slice(0, bytes_to_append));
+        m_response_body.append(data.slice(0, bytes_to_append));
 }
 
 void NetworkEventActor::set_request_complete(u64 body_size, Requests::RequestTimingInfo timing_info, Optional<Requests::NetworkError> network_error)
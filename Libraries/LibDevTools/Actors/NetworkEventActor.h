@@ -28,7 +28,7 @@ public:
     void set_request_info(String url, String method, UnixDateTime start_time, Vector<HTTP::Header> request_headers, ByteBuffer request_body, Optional<String> initiator_type);
     void set_response_start(u32 status_code, Optional<String> reason_phrase);
     void set_response_headers(Vector<HTTP::Header> response_headers);
-    void append_response_body(ByteBuffer data);
+    void append_response_body(ReadonlyBytes data);
     void set_request_complete(u64 body_size, Requests::RequestTimingInfo timing_info, Optional<Requests::NetworkError> network_error);
 
     JsonObject serialize_initial_event() const;
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <LibDevTools/Actors/PerfActor.h>
+#include <LibDevTools/DevToolsDelegate.h>
+#include <LibDevTools/DevToolsServer.h>
+
+namespace DevTools {
+
+static constexpr auto default_sampling_interval = AK::Duration::from_milliseconds(1);
+
+NonnullRefPtr<PerfActor> PerfActor::create(DevToolsServer& devtools, String name)
+{
+    return adopt_ref(*new PerfActor(devtools, move(name)));
+}
+
+PerfActor::PerfActor(DevToolsServer& devtools, String name)
+    : Actor(devtools, move(name))
+{
+}
+
+PerfActor::~PerfActor()
+{
+    if (!m_is_active)
+        return;
+    for (auto const& tab : devtools().delegate().tab_list())
+        devtools().delegate().stop_js_profiler(tab, [](auto) { });
+}
+
+void PerfActor::handle_message(Message const& message)
+{
+    JsonObject response;
+
+    if (message.type == "isActive"sv) {
+        response.set("value"sv, m_is_active);
+        send_response(message, move(response));
+        return;
+    }
+
+    if (message.type == "isSupportedPlatform"sv) {
+#if defined(AK_OS_WINDOWS)
+        response.set("value"sv, false);
+#else
+        response.set("value"sv, true);
+#endif
+        send_response(message, move(response));
+        return;
+    }
+
+    if (message.type == "isLockedForPrivateBrowsing"sv) {
+        response.set("value"sv, false);
+        send_response(message, move(response));
+        return;
+    }
+
+    if (message.type == "getSupportedFeatures"sv) {
+        JsonArray features;
+        features.must_append("js"sv);
+
+        response.set("value"sv, move(features));
+        send_response(message, move(response));
+        return;
+    }
+
+    if (message.type == "startProfiler"sv) {
+        start_profiler(message);
+        return;
+    }
+
+    if (message.type == "stopProfilerAndDiscardProfile"sv) {
+        stop_profiler({});
+        send_response(message, move(response));
+        return;
+    }
+
+    if (message.type == "getProfileAndStopProfiler"sv) {
+        if (!m_is_active) {
+            response.set("value"sv, JsonValue {});
+            send_response(message, move(response));
+            return;
+        }
+
+        stop_profiler(message);
+        return;
+    }
+
+    send_unrecognized_packet_type_error(message);
+}
+
+void PerfActor::start_profiler(Message const& message)
+{
+    // The panel gives the interval in milliseconds, and may ask for a fraction of one.
+    m_sampling_interval = default_sampling_interval;
+    if (auto options = message.data.get_object("options"sv); options.has_value()) {
+        if (auto interval = options->get_double_with_precision_loss("interval"sv); interval.has_value() && *interval > 0)
+            m_sampling_interval = AK::Duration::from_microseconds(static_cast<i64>(*interval * 1000.0));
+    }
+
+    if (!m_is_active) {
+        m_is_active = true;
+        m_start_time = UnixDateTime::now();
+
+        auto sampling_interval_in_microseconds = static_cast<u32>(m_sampling_interval.to_microseconds());
+        for (auto const& tab : devtools().delegate().tab_list())
+            devtools().delegate().start_js_profiler(tab, sampling_interval_in_microseconds);
+    }
+
+    JsonObject response;
+    response.set("value"sv, true);
+    send_response(message, move(response));
+
+    JsonObject event;
+    event.set("type"sv, "profiler-started"sv);
+    event.set("interval"sv, static_cast<double>(m_sampling_interval.to_microseconds()) / 1000.0);
+    send_message(move(event));
+}
+
+void PerfActor::stop_profiler(Optional<Message const&> message)
+{
+    if (!m_is_active)
+        return;
+    m_is_active = false;
+
+    m_pending_profile_message_id = message.map([](auto const& message) { return message.id; });
+    m_received_profiles.clear();
+
+    auto tabs = devtools().delegate().tab_list();
+    m_pending_profile_count = tabs.size();
+
+    for (auto const& tab : tabs) {
+        devtools().delegate().stop_js_profiler(tab, [weak_self = make_weak_ptr<PerfActor>()](ErrorOr<JsonValue> profile) {
+            if (auto self = weak_self.strong_ref())
+                self->received_profile(profile.is_error() ? JsonValue {} : profile.release_value());
+        });
+    }
+
+    if (tabs.is_empty())
+        received_profile({});
+}
+
+void PerfActor::received_profile(JsonValue profile)
+{
+    // NB: Tabs that share a process share its profile, which only the first of them receives.
+    if (profile.is_object())
+        m_received_profiles.append(move(profile.as_object()));
+
+    if (m_pending_profile_count > 0)
+        --m_pending_profile_count;
+    if (m_pending_profile_count > 0)
+        return;
+
+    JsonObject event;
+    event.set("type"sv, "profiler-stopped"sv);
+    send_message(move(event));
+
+    auto message_id = exchange(m_pending_profile_message_id, {});
+    auto received_profiles = move(m_received_profiles);
+    if (!message_id.has_value())
+        return;
+
+    // Each process becomes a process of a Gecko profile, which lets each keep the time its samples are relative to.
+    // https://github.com/firefox-devtools/profiler/blob/main/docs-developer/gecko-profile-format.md
+    auto make_meta = [&](i64 start_time_in_milliseconds) {
+        JsonArray categories;
+        auto append_category = [&](StringView name, StringView color) {
+            JsonArray subcategories;
+            subcategories.must_append("Other"sv);
+
+            JsonObject category;
+            category.set("name"sv, name);
+            category.set("color"sv, color);
+            category.set("subcategories"sv, move(subcategories));
+            categories.must_append(move(category));
+        };
+
+        // NB: The sampled frames refer to these by index.
+        append_category("Other"sv, "grey"sv);
+        append_category("JavaScript"sv, "yellow"sv);
+
+        JsonObject meta;
+        meta.set("version"sv, 24);
+        meta.set("interval"sv, static_cast<double>(m_sampling_interval.to_microseconds()) / 1000.0);
+        meta.set("startTime"sv, start_time_in_milliseconds);
+        meta.set("processType"sv, 0);
+        meta.set("product"sv, "Ladybird"sv);
+        meta.set("stackwalk"sv, 0);
+        meta.set("debug"sv, false);
+        meta.set("categories"sv, move(categories));
+        meta.set("markerSchema"sv, JsonArray {});
+        return meta;
+    };
+
+    auto make_profile = [&](i64 start_time_in_milliseconds, JsonArray threads, JsonArray processes) {
+        JsonObject profile;
+        profile.set("meta"sv, make_meta(start_time_in_milliseconds));
+        profile.set("libs"sv, JsonArray {});
+        profile.set("threads"sv, move(threads));
+        profile.set("processes"sv, move(processes));
+        profile.set("pausedRanges"sv, JsonArray {});
+        return profile;
+    };
+
+    JsonArray processes;
+    for (auto& received_profile : received_profiles) {
+        auto start_time = received_profile.get_integer<i64>("startTime"sv).value_or(m_start_time.milliseconds_since_epoch());
+        auto thread = received_profile.get_object("thread"sv);
+        if (!thread.has_value())
+            continue;
+
+        JsonArray threads;
+        threads.must_append(move(*thread));
+        processes.must_append(make_profile(start_time, move(threads), {}));
+    }
+
+    auto response = make_profile(m_start_time.milliseconds_since_epoch(), {}, move(processes));
+    send_response({ .id = *message_id }, move(response));
+}
+
+}
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/NonnullRefPtr.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibDevTools/Actor.h>
+#include <LibDevTools/Forward.h>
+
+namespace DevTools {
+
+// Backs the Performance panel, by sampling the JavaScript of every tab.
+// https://github.com/mozilla/gecko-dev/blob/master/devtools/shared/specs/perf.js
+class DEVTOOLS_API PerfActor final : public Actor {
+public:
+    static constexpr auto base_name = "perf"sv;
+
+    static NonnullRefPtr<PerfActor> create(DevToolsServer&, String name);
+    virtual ~PerfActor() override;
+
+private:
+    PerfActor(DevToolsServer&, String name);
+
+    virtual void handle_message(Message const&) override;
+
+    void start_profiler(Message const&);
+    void stop_profiler(Optional<Message const&>);
+    void received_profile(JsonValue);
+
+    bool m_is_active { false };
+    AK::Duration m_sampling_interval;
+    UnixDateTime m_start_time;
+
+    Optional<u64> m_pending_profile_message_id;
+    size_t m_pending_profile_count { 0 };
+    Vector<JsonObject> m_received_profiles;
+};
+
+}
@@ -113,6 +113,10 @@ public:
     virtual void listen_for_console_messages(TabDescription const&, OnConsoleMessage) const { }
     virtual void stop_listening_for_console_messages(TabDescription const&) const { }
 
+    using OnJSProfileReceived = Function<void(ErrorOr<JsonValue>)>;
+    virtual void start_js_profiler(TabDescription const&, u32 sampling_interval_in_microseconds) const { (void)sampling_interval_in_microseconds; }
+    virtual void stop_js_profiler(TabDescription const&, OnJSProfileReceived) const { }
+
     struct NetworkRequestData {
         u64 request_id { 0 };
         String url;
@@ -139,7 +143,7 @@ public:
 
     using OnNetworkRequestStarted = Function<void(NetworkRequestData)>;
     using OnNetworkResponseHeadersReceived = Function<void(NetworkResponseData)>;
-    using OnNetworkResponseBodyReceived = Function<void(u64 request_id, ByteBuffer data)>;
+    using OnNetworkResponseBodyReceived = Function<void(u64 request_id, ReadonlyBytes data)>;
     using OnNetworkRequestFinished = Function<void(NetworkRequestCompleteData)>;
     virtual void listen_for_network_events(TabDescription const&, OnNetworkRequestStarted, OnNetworkResponseHeadersReceived, OnNetworkResponseBodyReceived, OnNetworkRequestFinished) const { }
     virtual void stop_listening_for_network_events(TabDescription const&) const { }
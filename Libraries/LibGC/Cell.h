@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Format.h>
 #include <AK/Forward.h>
 #include <AK/HashMap.h>
@@ -55,6 +56,11 @@ public:
     bool is_marked() const { return m_mark; }
     void set_marked(bool b) { m_mark = b; }
 
+    // For parallel marking, where several threads may race to mark the same cell.
+    bool is_marked_atomically() const { return AK::atomic_load(&m_mark, AK::memory_order_relaxed); }
+    // Returns whether this call is the one that marked the cell.
+    bool try_set_marked_atomically() { return !AK::atomic_exchange(&m_mark, true, AK::memory_order_relaxed); }
+
     enum class State : bool {
         Live,
         Dead,
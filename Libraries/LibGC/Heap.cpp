@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AtomicRefCounted.h>
 #include <AK/Badge.h>
 #include <AK/BinarySearch.h>
 #include <AK/Checked.h>
@@ -17,6 +18,7 @@
 #include <AK/NeverDestroyed.h>
 #include <AK/NumberFormat.h>
 #include <AK/Platform.h>
+#include <AK/Random.h>
 #include <AK/ScopeGuard.h>
 #include <AK/StackInfo.h>
 #include <AK/StackUnwinder.h>
@@ -26,6 +28,7 @@
 #include <LibCore/File.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/Timer.h>
+#include <LibCore/TraceEvent.h>
 #include <LibGC/BlockAllocator.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGC/Heap.h>
@@ -33,6 +36,9 @@
 #include <LibGC/NanBoxedValue.h>
 #include <LibGC/Root.h>
 #include <LibGC/Weak.h>
+#include <LibSync/ConditionVariable.h>
+#include <LibSync/Mutex.h>
+#include <LibThreading/ThreadPool.h>
 #include <setjmp.h>
 
 #ifdef HAS_ADDRESS_SANITIZER
@@ -78,6 +84,22 @@ i32 libgc_log_level()
     return level;
 }
 
+// LIBGC_MARKING_THREADS sets how many thread pool helpers join the main thread in marking live cells. The default of 0
+// marks on the main thread alone, which keeps the order cells are visited in deterministic when debugging.
+size_t read_libgc_marking_threads()
+{
+    char const* env = getenv("LIBGC_MARKING_THREADS");
+    if (!env || !*env)
+        return 0;
+    return static_cast<size_t>(max(atoi(env), 0));
+}
+
+size_t libgc_marking_threads()
+{
+    static size_t const threads = read_libgc_marking_threads();
+    return threads;
+}
+
 // Per-phase timings recorded during a single collect_garbage() call. We keep
 // these at file scope (instead of threading more parameters through the GC's
 // internal helpers) since GC is single-threaded, guarded by m_collecting_garbage.
@@ -254,9 +276,10 @@ void print_incremental_sweep_report(size_t live_cell_bytes, size_t live_external
 
 class ScopedPhaseTimer {
 public:
-    ScopedPhaseTimer(bool enabled, i64& out_microseconds)
+    ScopedPhaseTimer(bool enabled, i64& out_microseconds, StringView trace_event_name = {})
         : m_out_microseconds(out_microseconds)
         , m_enabled(enabled)
+        , m_trace_event("gc"sv, trace_event_name)
     {
         if (m_enabled)
             m_timer.start();
@@ -271,6 +294,7 @@ private:
     Core::ElapsedTimer m_timer { Core::TimerType::Precise };
     i64& m_out_microseconds;
     bool m_enabled;
+    Core::TraceEventScope m_trace_event;
 };
 
 }
@@ -317,6 +341,31 @@ void Heap::will_allocate(size_t size)
         start_idle_gc_timer();
 }
 
+void Heap::set_allocation_sampler(size_t interval_in_bytes, AllocationSampler sampler)
+{
+    VERIFY(interval_in_bytes > 0);
+    m_allocation_sampler = move(sampler);
+    m_allocation_sampling_interval_in_bytes = interval_in_bytes;
+    m_bytes_until_next_allocation_sample = get_random_uniform_64(interval_in_bytes * 2);
+}
+
+void Heap::clear_allocation_sampler()
+{
+    m_allocation_sampler = nullptr;
+    m_allocation_sampling_interval_in_bytes = 0;
+}
+
+void Heap::sample_allocation(Cell& cell, size_t size_in_bytes)
+{
+    m_bytes_until_next_allocation_sample -= static_cast<i64>(size_in_bytes);
+    if (m_bytes_until_next_allocation_sample > 0)
+        return;
+
+    // Spread the gaps between samples uniformly around the interval, so that they still average out to it.
+    m_bytes_until_next_allocation_sample = get_random_uniform_64(m_allocation_sampling_interval_in_bytes * 2);
+    m_allocation_sampler(cell, size_in_bytes);
+}
+
 void Heap::did_allocate_external_memory(size_t size)
 {
     will_allocate(size);
@@ -588,6 +637,7 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
 
     {
         TemporaryChange change(m_collecting_garbage, true);
+        Core::TraceEventScope trace_event { "gc"sv, collection_type == CollectionType::CollectGarbage ? "Collect garbage"sv : "Collect everything"sv };
 
         // The caller can force level 1 by passing print_report=true; LIBGC_LOG_LEVEL=N
         // raises the floor for every collection.
@@ -610,20 +660,20 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
             }
             HashMap<Cell*, HeapRoot> roots;
             {
-                ScopedPhaseTimer timer { report, g_phase_timings.gather_roots_us };
+                ScopedPhaseTimer timer { report, g_phase_timings.gather_roots_us, "Gather roots"sv };
                 gather_roots(roots);
             }
             {
-                ScopedPhaseTimer timer { report, g_phase_timings.mark_live_cells_us };
+                ScopedPhaseTimer timer { report, g_phase_timings.mark_live_cells_us, "Mark live cells"sv };
                 mark_live_cells(roots);
             }
         }
         {
-            ScopedPhaseTimer timer { report, g_phase_timings.finalize_unmarked_cells_us };
+            ScopedPhaseTimer timer { report, g_phase_timings.finalize_unmarked_cells_us, "Finalize unmarked cells"sv };
             finalize_unmarked_cells();
         }
         {
-            ScopedPhaseTimer timer { report, g_phase_timings.sweep_weak_blocks_us };
+            ScopedPhaseTimer timer { report, g_phase_timings.sweep_weak_blocks_us, "Sweep weak blocks"sv };
             sweep_weak_blocks();
         }
 
@@ -631,7 +681,7 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
         // during incremental sweep risks reading cells that have already been
         // freed and ASAN-poisoned.
         {
-            ScopedPhaseTimer timer { report, g_phase_timings.prune_weak_containers_us };
+            ScopedPhaseTimer timer { report, g_phase_timings.prune_weak_containers_us, "Prune weak containers"sv };
             for (auto& weak_container : m_weak_containers) {
                 if (!weak_container.owner_cell({}).is_marked())
                     continue;
@@ -644,7 +694,7 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
         // StaticPropertyLookupCache prune by mark state and must see valid
         // marks before incremental sweep starts freeing cells.
         {
-            ScopedPhaseTimer timer { report, g_phase_timings.sweep_callbacks_us };
+            ScopedPhaseTimer timer { report, g_phase_timings.sweep_callbacks_us, "Sweep callbacks"sv };
             for (auto& callback : m_sweep_callbacks)
                 callback();
         }
@@ -653,7 +703,7 @@ void Heap::collect_garbage(CollectionType collection_type, bool print_report)
         // every cell is collected before the Heap destructor returns. All
         // other collection types defer sweeping to incremental work below.
         if (collection_type == CollectionType::CollectEverything) {
-            ScopedPhaseTimer timer { report, g_phase_timings.sweep_dead_cells_us };
+            ScopedPhaseTimer timer { report, g_phase_timings.sweep_dead_cells_us, "Sweep dead cells"sv };
             sweep_dead_cells(report, collection_measurement_timer);
         }
 
@@ -1076,19 +1126,165 @@ private:
     FlatPtr m_max_block_address;
 };
 
-void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
-{
-    dbgln_if(HEAP_DEBUG, "mark_live_cells:");
+// Parallel markers keep a private stack of cells whose edges still need visiting. Whenever a marker runs dry while
+// others have plenty, they hand it a segment of their stack through this worklist.
+class ParallelMarkingWorklist final : public AtomicRefCounted<ParallelMarkingWorklist> {
+public:
+    static constexpr size_t SEGMENT_SIZE = 256;
 
-    Optional<MarkingVisitor> visitor;
+    // Returns false if marking has already finished, in which case a helper that only now got to run has nothing to do.
+    bool join()
     {
-        ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_initial_visit_us };
-        visitor.emplace(*this, roots);
+        Sync::MutexLocker locker(m_mutex);
+        if (m_finished)
+            return false;
+        ++m_marker_count;
+        return true;
     }
 
+    bool has_waiting_markers() const { return m_waiting_marker_count.load(AK::MemoryOrder::memory_order_relaxed) > 0; }
+
+    void publish(Vector<Ref<Cell>> segment)
     {
-        ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_bfs_us };
-        visitor->mark_all_live_cells();
+        Sync::MutexLocker locker(m_mutex);
+        m_segments.append(move(segment));
+        m_condition.signal();
+    }
+
+    // Waits for a segment to be published. Once every marker is waiting here, there is no work left anywhere and
+    // marking is done, which is signalled by returning nothing.
+    Optional<Vector<Ref<Cell>>> take_segment()
+    {
+        Sync::MutexLocker locker(m_mutex);
+        m_waiting_marker_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+
+        while (m_segments.is_empty() && !m_finished) {
+            if (m_waiting_marker_count.load(AK::MemoryOrder::memory_order_relaxed) == m_marker_count) {
+                m_finished = true;
+                m_condition.broadcast();
+                break;
+            }
+            m_condition.wait();
+        }
+
+        m_waiting_marker_count.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+
+        if (m_finished)
+            return {};
+        return m_segments.take_last();
+    }
+
+private:
+    Sync::Mutex m_mutex;
+    Sync::ConditionVariable m_condition { m_mutex };
+    Vector<Vector<Ref<Cell>>> m_segments;
+    size_t m_marker_count { 0 };
+    Atomic<size_t> m_waiting_marker_count { 0 };
+    bool m_finished { false };
+};
+
+class ParallelMarkingVisitor final : public Cell::Visitor {
+public:
+    ParallelMarkingVisitor(Heap& heap, ParallelMarkingWorklist& worklist)
+        : m_heap(heap)
+        , m_worklist(worklist)
+    {
+        m_heap.find_min_and_max_block_addresses(m_min_block_address, m_max_block_address);
+    }
+
+    virtual void visit_impl(Cell& cell) override
+    {
+        if (cell.is_marked_atomically() || !cell.try_set_marked_atomically())
+            return;
+        dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
+
+        m_work_stack.append(cell);
+    }
+
+    virtual void visit_impl(ReadonlySpan<NanBoxedValue> values) override
+    {
+        m_work_stack.grow_capacity(m_work_stack.size() + values.size());
+
+        for (auto value : values) {
+            if (!value.is_cell())
+                continue;
+            auto& cell = value.as_cell();
+            if (cell.is_marked_atomically() || !cell.try_set_marked_atomically())
+                continue;
+            dbgln_if(HEAP_DEBUG, "  ! {}", &cell);
+
+            m_work_stack.unchecked_append(cell);
+        }
+    }
+
+    virtual void visit_possible_values(ReadonlyBytes bytes) override
+    {
+        HashMap<FlatPtr, HeapRoot> possible_pointers;
+
+        auto* raw_pointer_sized_values = reinterpret_cast<FlatPtr const*>(bytes.data());
+        for (size_t i = 0; i < (bytes.size() / sizeof(FlatPtr)); ++i)
+            add_possible_value(possible_pointers, raw_pointer_sized_values[i], HeapRoot { .type = HeapRoot::Type::HeapFunctionCapturedPointer }, m_min_block_address, m_max_block_address);
+
+        for_each_cell_among_possible_pointers(m_heap.m_live_heap_blocks, possible_pointers, [&](Cell* cell, FlatPtr) {
+            if (cell->state() != Cell::State::Live)
+                return;
+            if (cell->is_marked_atomically() || !cell->try_set_marked_atomically())
+                return;
+            m_work_stack.append(*cell);
+        });
+    }
+
+    void mark_until_done()
+    {
+        for (;;) {
+            while (!m_work_stack.is_empty()) {
+                m_work_stack.take_last()->visit_edges(*this);
+
+                if (m_work_stack.size() > ParallelMarkingWorklist::SEGMENT_SIZE && m_worklist.has_waiting_markers())
+                    share_segment();
+            }
+
+            auto segment = m_worklist.take_segment();
+            if (!segment.has_value())
+                return;
+            m_work_stack = segment.release_value();
+        }
+    }
+
+private:
+    void share_segment()
+    {
+        Vector<Ref<Cell>> segment;
+        segment.ensure_capacity(ParallelMarkingWorklist::SEGMENT_SIZE);
+        for (size_t i = 0; i < ParallelMarkingWorklist::SEGMENT_SIZE; ++i)
+            segment.unchecked_append(m_work_stack.take_last());
+        m_worklist.publish(move(segment));
+    }
+
+    Heap& m_heap;
+    ParallelMarkingWorklist& m_worklist;
+    Vector<Ref<Cell>> m_work_stack;
+    FlatPtr m_min_block_address;
+    FlatPtr m_max_block_address;
+};
+
+void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
+{
+    dbgln_if(HEAP_DEBUG, "mark_live_cells:");
+
+    if (auto helper_count = libgc_marking_threads(); helper_count > 0) {
+        mark_live_cells_in_parallel(roots, helper_count);
+    } else {
+        Optional<MarkingVisitor> visitor;
+        {
+            ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_initial_visit_us };
+            visitor.emplace(*this, roots);
+        }
+
+        {
+            ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_bfs_us };
+            visitor->mark_all_live_cells();
+        }
     }
 
     {
@@ -1100,6 +1296,42 @@ void Heap::mark_live_cells(HashMap<Cell*, HeapRoot> const& roots)
     }
 }
 
+void Heap::mark_live_cells_in_parallel(HashMap<Cell*, HeapRoot> const& roots, size_t helper_count)
+{
+    auto worklist = adopt_ref(*new ParallelMarkingWorklist);
+
+    // The main thread joins before any helper can, so marking cannot be considered done before it has even started.
+    VERIFY(worklist->join());
+
+    Optional<ParallelMarkingVisitor> visitor;
+    {
+        ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_initial_visit_us };
+        visitor.emplace(*this, *worklist);
+        for (auto* root : roots.keys())
+            visitor->visit(root);
+    }
+
+    {
+        ScopedPhaseTimer timer { g_recording_phase_timings, g_phase_timings.mark_bfs_us };
+
+        // The pool may be busy with other work, so helpers join whenever they get to run. The main thread marks along
+        // with them, and on its own if none of them get there in time. A helper that starts after marking finished
+        // touches nothing but the worklist it keeps alive.
+        for (size_t i = 0; i < helper_count; ++i) {
+            Threading::ThreadPool::the().submit(
+                [this, worklist] {
+                    if (!worklist->join())
+                        return;
+                    ParallelMarkingVisitor helper { *this, *worklist };
+                    helper.mark_until_done();
+                },
+                Threading::ThreadPool::Priority::UserBlocking);
+        }
+
+        visitor->mark_until_done();
+    }
+}
+
 void Heap::finalize_unmarked_cells()
 {
     for_each_block([&](auto& block) {
@@ -1381,6 +1613,7 @@ void Heap::sweep_on_timer()
     if (is_gc_deferred())
         return;
 
+    Core::TraceEventScope trace_event { "gc"sv, "Incremental sweep"sv };
     size_t blocks_swept = 0;
     bool finished_sweep = false;
     auto start_time = MonotonicTime::now();
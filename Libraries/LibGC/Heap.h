@@ -64,6 +64,8 @@ public:
             cell->set_marked(true);
             m_cells_allocated_during_sweep.append(cell);
         }
+        if (m_allocation_sampler) [[unlikely]]
+            sample_allocation(*cell, sizeof(T));
         undefer_gc();
         return *cell;
     }
@@ -120,10 +122,17 @@ public:
     void did_allocate_external_memory(size_t);
     void did_free_external_memory(size_t);
 
+    // Tells the sampler about one cell out of roughly every `interval_in_bytes` bytes of cells allocated, for allocation
+    // profiling. Which cell gets sampled is randomized, so that a repeating allocation pattern can't hide from it.
+    using AllocationSampler = AK::Function<void(Cell&, size_t size_in_bytes)>;
+    void set_allocation_sampler(size_t interval_in_bytes, AllocationSampler);
+    void clear_allocation_sampler();
+
 private:
     friend class CellAllocator;
     friend class HeapBlock;
     friend class MarkingVisitor;
+    friend class ParallelMarkingVisitor;
     friend class GraphConstructorVisitor;
     friend class DeferGC;
 
@@ -144,6 +153,7 @@ private:
     }
 
     void will_allocate(size_t);
+    void sample_allocation(Cell&, size_t size_in_bytes);
     void update_gc_bytes_threshold(size_t live_cell_bytes, size_t live_external_bytes);
 
     void find_min_and_max_block_addresses(FlatPtr& min_address, FlatPtr& max_address);
@@ -151,6 +161,7 @@ private:
     void gather_conservative_roots(HashMap<Cell*, HeapRoot>&, Vector<StackFrameInfo>* out_stack_frames = nullptr);
     void gather_asan_fake_stack_roots(HashMap<FlatPtr, HeapRoot>&, FlatPtr, FlatPtr min_block_address, FlatPtr max_block_address, FlatPtr stack_reference, FlatPtr stack_top);
     void mark_live_cells(HashMap<Cell*, HeapRoot> const& live_cells);
+    void mark_live_cells_in_parallel(HashMap<Cell*, HeapRoot> const& live_cells, size_t helper_count);
     void finalize_unmarked_cells();
     void sweep_dead_cells(bool print_report, Core::ElapsedTimer const&);
     void sweep_weak_blocks();
@@ -219,6 +230,10 @@ private:
     RefPtr<Core::Timer> m_idle_gc_timer;
     u64 m_total_allocated_bytes { 0 };
     IdleCollectionPolicy m_idle_collection_policy;
+
+    AllocationSampler m_allocation_sampler;
+    size_t m_allocation_sampling_interval_in_bytes { 0 };
+    i64 m_bytes_until_next_allocation_sample { 0 };
 };
 
 inline void Heap::did_create_root(Badge<RootImpl>, RootImpl& impl)
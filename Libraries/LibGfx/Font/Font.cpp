@@ -138,11 +138,100 @@ SkFont Font::skia_font(float scale) const
     return sk_font;
 }
 
-Font::ShapingCache::~ShapingCache() = default;
+// Shaping caches are destroyed along with their font, which may happen on whichever thread drops the last glyph run.
+static Atomic<u64> s_shaping_cache_hits { 0 };
+static Atomic<u64> s_shaping_cache_misses { 0 };
+static Atomic<u64> s_shaping_cache_evictions { 0 };
+static Atomic<u64> s_shaping_cache_entries { 0 };
+static Atomic<u64> s_shaping_cache_size_in_bytes { 0 };
+
+Font::ShapingCache::Statistics Font::ShapingCache::statistics()
+{
+    return {
+        .hits = s_shaping_cache_hits.load(AK::MemoryOrder::memory_order_relaxed),
+        .misses = s_shaping_cache_misses.load(AK::MemoryOrder::memory_order_relaxed),
+        .evictions = s_shaping_cache_evictions.load(AK::MemoryOrder::memory_order_relaxed),
+        .entries = s_shaping_cache_entries.load(AK::MemoryOrder::memory_order_relaxed),
+        .size_in_bytes = s_shaping_cache_size_in_bytes.load(AK::MemoryOrder::memory_order_relaxed),
+    };
+}
+
+void Font::ShapingCache::reset_statistics()
+{
+    s_shaping_cache_hits.store(0, AK::MemoryOrder::memory_order_relaxed);
+    s_shaping_cache_misses.store(0, AK::MemoryOrder::memory_order_relaxed);
+    s_shaping_cache_evictions.store(0, AK::MemoryOrder::memory_order_relaxed);
+}
+
+void Font::ShapingCache::record_hit()
+{
+    s_shaping_cache_hits.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+}
+
+void Font::ShapingCache::record_miss()
+{
+    s_shaping_cache_misses.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+}
+
+Font::ShapingCache::~ShapingCache()
+{
+    clear();
+}
+
+ShapedGlyphs const* Font::ShapingCache::find(unsigned key_hash, Utf16View const& text, u8 text_type, u32 letter_spacing_bit_pattern)
+{
+    auto it = map.find(key_hash, [&](auto const& candidate) {
+        return candidate.key.text_type == text_type
+            && candidate.key.letter_spacing_bit_pattern == letter_spacing_bit_pattern
+            && candidate.key.text == text;
+    });
+    if (it == map.end())
+        return nullptr;
+
+    auto& entry = *it->value;
+    recently_used.remove(entry);
+    recently_used.append(entry);
+    return entry.shape.ptr();
+}
+
+void Font::ShapingCache::set(ShapingCacheKey key, unsigned key_hash, NonnullOwnPtr<ShapedGlyphs> shape)
+{
+    auto entry_size = sizeof(Entry) + sizeof(ShapedGlyphs)
+        + shape->glyphs.capacity() * sizeof(DrawGlyph)
+        + key.text.length_in_code_units() * sizeof(char16_t);
+
+    while (!recently_used.is_empty() && size_in_bytes + entry_size > memory_limit)
+        evict_least_recently_used();
+
+    auto entry = make<Entry>(move(shape), key_hash, entry_size);
+    recently_used.append(*entry);
+    size_in_bytes += entry_size;
+    s_shaping_cache_entries.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    s_shaping_cache_size_in_bytes.fetch_add(entry_size, AK::MemoryOrder::memory_order_relaxed);
+    map.set(move(key), move(entry));
+}
+
+void Font::ShapingCache::evict_least_recently_used()
+{
+    auto& entry = *recently_used.first();
+    auto it = map.find(entry.key_hash, [&](auto const& candidate) { return candidate.value.ptr() == &entry; });
+    VERIFY(it != map.end());
+
+    recently_used.remove(entry);
+    size_in_bytes -= entry.size_in_bytes;
+    s_shaping_cache_entries.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+    s_shaping_cache_size_in_bytes.fetch_sub(entry.size_in_bytes, AK::MemoryOrder::memory_order_relaxed);
+    s_shaping_cache_evictions.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    map.remove(it);
+}
 
 void Font::ShapingCache::clear()
 {
+    s_shaping_cache_entries.fetch_sub(map.size(), AK::MemoryOrder::memory_order_relaxed);
+    s_shaping_cache_size_in_bytes.fetch_sub(size_in_bytes, AK::MemoryOrder::memory_order_relaxed);
+    recently_used.clear();
     map.clear();
+    size_in_bytes = 0;
     for (auto& slot : single_ascii_character_map)
         slot = nullptr;
 }
@@ -12,6 +12,7 @@
 #include <AK/AtomicRefCounted.h>
 #include <AK/FlyString.h>
 #include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefPtr.h>
 #include <AK/Utf16String.h>
@@ -90,12 +91,55 @@ public:
     FontVariationSettings const& variation_settings() const { return m_font_variation_settings; }
     ShapeFeatures const& features() const { return m_shape_features; }
 
+    // Shapes of recently shaped strings, evicting the least recently used ones once the cache holds more than
+    // memory_limit bytes. Single ASCII characters are kept in a separate table that is never evicted.
     struct ShapingCache {
-        HashMap<ShapingCacheKey, OwnPtr<ShapedGlyphs>> map;
+        static constexpr size_t memory_limit = 512 * KiB;
+
+        struct Entry {
+            Entry(NonnullOwnPtr<ShapedGlyphs> shape, unsigned key_hash, size_t size_in_bytes)
+                : shape(move(shape))
+                , key_hash(key_hash)
+                , size_in_bytes(size_in_bytes)
+            {
+            }
+
+            NonnullOwnPtr<ShapedGlyphs> shape;
+            unsigned key_hash { 0 };
+            size_t size_in_bytes { 0 };
+            IntrusiveListNode<Entry> list_node;
+
+            using List = IntrusiveList<&Entry::list_node>;
+        };
+
+        // Totals over the shaping caches of all fonts.
+        struct Statistics {
+            u64 hits { 0 };
+            u64 misses { 0 };
+            u64 evictions { 0 };
+            u64 entries { 0 };
+            u64 size_in_bytes { 0 };
+        };
+        static Statistics statistics();
+        static void reset_statistics();
+        static void record_hit();
+        static void record_miss();
+
+        ShapedGlyphs const* find(unsigned key_hash, Utf16View const& text, u8 text_type, u32 letter_spacing_bit_pattern);
+        void set(ShapingCacheKey, unsigned key_hash, NonnullOwnPtr<ShapedGlyphs>);
+
+        HashMap<ShapingCacheKey, NonnullOwnPtr<Entry>> map;
+        // Least recently used first.
+        Entry::List recently_used;
+        size_t size_in_bytes { 0 };
+
         OwnPtr<ShapedGlyphs> single_ascii_character_map[128];
 
         ~ShapingCache();
         void clear();
+
+    private:
+        void evict_least_recently_used();
     };
     ShapingCache& shaping_cache() const { return m_shaping_cache; }
 
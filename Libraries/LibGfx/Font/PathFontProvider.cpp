@@ -7,14 +7,31 @@
 #include <AK/ByteReader.h>
 #include <AK/Endian.h>
 #include <AK/Format.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
 #include <AK/LexicalPath.h>
+#include <AK/ScopeGuard.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
 #include <LibCore/Resource.h>
+#include <LibCore/StandardPaths.h>
+#include <LibCore/System.h>
+#include <LibFileSystem/FileSystem.h>
 #include <LibGfx/Font/Font.h>
 #include <LibGfx/Font/PathFontProvider.h>
 #include <LibGfx/Font/WOFF/Loader.h>
 
 namespace Gfx {
 
+// NB: Bump this whenever the index format, or what gets recorded for a face, changes.
+static constexpr i64 font_index_version = 1;
+
+static ByteString font_index_path()
+{
+    return LexicalPath::join(Core::StandardPaths::cache_directory(), "Ladybird"sv, "font-index.json"sv).string();
+}
+
 PathFontProvider::PathFontProvider() = default;
 PathFontProvider::~PathFontProvider() = default;
 
@@ -51,6 +68,8 @@ void PathFontProvider::load_all_fonts_from_uri(StringView uri)
     }
     auto root = root_or_error.release_value();
 
+    load_index_if_needed();
+
     root->for_each_descendant_file([this](Core::Resource const& resource) -> IterationDecision {
         auto uri = resource.uri();
         auto path = LexicalPath(uri.bytes_as_string_view());
@@ -59,31 +78,171 @@ void PathFontProvider::load_all_fonts_from_uri(StringView uri)
         if (!is_truetype && !is_woff)
             return IterationDecision::Continue;
 
-        if (m_loaded_paths.set(resource.filesystem_path(), AK::HashSetExistingEntryBehavior::Keep) != AK::HashSetResult::InsertedNewEntry)
+        auto filesystem_path = resource.filesystem_path();
+        if (m_loaded_paths.set(filesystem_path, AK::HashSetExistingEntryBehavior::Keep) != AK::HashSetResult::InsertedNewEntry)
             return IterationDecision::Continue;
 
-        if (is_truetype) {
-            auto font_count = number_of_fonts_in_ttc(resource.data());
-            for (u32 ttc_index = 0; ttc_index < font_count; ++ttc_index) {
-                if (auto font_or_error = Typeface::try_load_from_resource(resource, ttc_index); !font_or_error.is_error()) {
-                    auto font = font_or_error.release_value();
-                    auto& family = m_typeface_by_family.ensure(font->family(), [] {
-                        return Vector<NonnullRefPtr<Typeface>> {};
-                    });
-                    family.append(font);
-                }
-            }
-        } else {
-            if (auto font_or_error = WOFF::try_load_from_resource(resource); !font_or_error.is_error()) {
-                auto font = font_or_error.release_value();
-                auto& family = m_typeface_by_family.ensure(font->family(), [] {
-                    return Vector<NonnullRefPtr<Typeface>> {};
-                });
-                family.append(font);
-            }
+        auto modified_time = static_cast<i64>(resource.modified_time().value_or(0));
+        auto size = static_cast<u64>(resource.data().size());
+
+        auto& indexed_file = m_index.ensure(filesystem_path, [] { return IndexedFile {}; });
+        if (indexed_file.modified_time != modified_time || indexed_file.size != size) {
+            indexed_file = { modified_time, size, faces_in_file(resource, is_woff) };
+            m_index_is_dirty = true;
+        }
+
+        for (auto const& face : indexed_file.faces) {
+            auto& family = m_typeface_by_family.ensure(face.family, [] {
+                return Vector<TypefaceEntry> {};
+            });
+            family.append({ resource, is_woff, face, {}, false });
         }
         return IterationDecision::Continue;
     });
+
+    if (m_index_is_dirty)
+        save_index();
+}
+
+Vector<PathFontProvider::IndexedFace> PathFontProvider::faces_in_file(Core::Resource const& resource, bool is_woff)
+{
+    auto face_for_typeface = [](Typeface const& typeface, u32 ttc_index) {
+        return IndexedFace { ttc_index, typeface.family(), typeface.weight(), typeface.width(), typeface.slope() };
+    };
+
+    Vector<IndexedFace> faces;
+    if (is_woff) {
+        if (auto font_or_error = WOFF::try_load_from_resource(resource); !font_or_error.is_error())
+            faces.append(face_for_typeface(*font_or_error.value(), 0));
+        return faces;
+    }
+
+    auto font_count = number_of_fonts_in_ttc(resource.data());
+    for (u32 ttc_index = 0; ttc_index < font_count; ++ttc_index) {
+        if (auto font_or_error = Typeface::try_load_from_resource(resource, ttc_index); !font_or_error.is_error())
+            faces.append(face_for_typeface(*font_or_error.value(), ttc_index));
+    }
+    return faces;
+}
+
+Typeface* PathFontProvider::typeface_for_entry(TypefaceEntry& entry)
+{
+    if (entry.typeface || entry.failed_to_load)
+        return entry.typeface.ptr();
+
+    auto font_or_error = entry.is_woff ? WOFF::try_load_from_resource(*entry.resource) : Typeface::try_load_from_resource(*entry.resource, entry.face.ttc_index);
+    if (font_or_error.is_error()) {
+        dbgln("PathFontProvider: Failed to load indexed font '{}': {}", entry.resource->filesystem_path(), font_or_error.error());
+        entry.failed_to_load = true;
+        return nullptr;
+    }
+    entry.typeface = font_or_error.release_value();
+    return entry.typeface.ptr();
+}
+
+void PathFontProvider::load_index_if_needed()
+{
+    if (m_has_loaded_index)
+        return;
+    m_has_loaded_index = true;
+
+    auto file = Core::File::open(font_index_path(), Core::File::OpenMode::Read);
+    if (file.is_error())
+        return;
+    auto contents = file.value()->read_until_eof();
+    if (contents.is_error())
+        return;
+    auto json = JsonValue::from_string(contents.value());
+    if (json.is_error() || !json.value().is_object())
+        return;
+
+    auto const& root = json.value().as_object();
+    if (root.get_integer<i64>("version"sv) != font_index_version)
+        return;
+    auto files = root.get_object("files"sv);
+    if (!files.has_value())
+        return;
+
+    files->for_each_member([&](String const& path, JsonValue const& value) {
+        if (!value.is_object())
+            return;
+        auto const& file = value.as_object();
+        auto modified_time = file.get_integer<i64>("modified_time"sv);
+        auto size = file.get_integer<u64>("size"sv);
+        auto faces = file.get_array("faces"sv);
+        if (!modified_time.has_value() || !size.has_value() || !faces.has_value())
+            return;
+
+        IndexedFile indexed_file { *modified_time, *size, {} };
+        for (auto const& face_value : faces->values()) {
+            if (!face_value.is_object())
+                return;
+            auto const& face = face_value.as_object();
+            auto ttc_index = face.get_integer<u32>("ttc_index"sv);
+            auto family = face.get_string("family"sv);
+            auto weight = face.get_integer<u16>("weight"sv);
+            auto width = face.get_integer<u16>("width"sv);
+            auto slope = face.get_integer<u8>("slope"sv);
+            if (!ttc_index.has_value() || !family.has_value() || !weight.has_value() || !width.has_value() || !slope.has_value())
+                return;
+            indexed_file.faces.append({ *ttc_index, FlyString { *family }, *weight, *width, *slope });
+        }
+        m_index.set(path, move(indexed_file));
+    });
+}
+
+void PathFontProvider::save_index()
+{
+    m_index_is_dirty = false;
+
+    JsonObject files;
+    for (auto const& [path, indexed_file] : m_index) {
+        // NB: Files from other directories stay in the index for other processes, unless they are gone.
+        if (!m_loaded_paths.contains(path) && !FileSystem::exists(path.bytes_as_string_view()))
+            continue;
+
+        JsonArray faces;
+        for (auto const& face : indexed_file.faces) {
+            JsonObject face_object;
+            face_object.set("ttc_index"sv, face.ttc_index);
+            face_object.set("family"sv, face.family.to_string());
+            face_object.set("weight"sv, face.weight);
+            face_object.set("width"sv, face.width);
+            face_object.set("slope"sv, face.slope);
+            faces.must_append(move(face_object));
+        }
+
+        JsonObject file;
+        file.set("modified_time"sv, indexed_file.modified_time);
+        file.set("size"sv, indexed_file.size);
+        file.set("faces"sv, move(faces));
+        files.set(path, move(file));
+    }
+
+    JsonObject root;
+    root.set("version"sv, font_index_version);
+    root.set("files"sv, move(files));
+
+    // NB: Every process that loads fonts may write the index, so it's written to a file of its own and then renamed
+    //     into place, and failing to write it is not an error.
+    auto write_index = [&]() -> ErrorOr<void> {
+        auto path = font_index_path();
+        TRY(Core::Directory::create(LexicalPath(path).parent(), Core::Directory::CreateDirectories::Yes));
+
+        auto temporary_path = ByteString::formatted("{}.{}.tmp", path, Core::System::getpid());
+        ArmedScopeGuard remove_temporary_file = [&] {
+            (void)FileSystem::remove(temporary_path, FileSystem::RecursionMode::Disallowed);
+        };
+        {
+            auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write));
+            TRY(file->write_until_depleted(root.serialized().bytes()));
+        }
+        TRY(Core::System::rename(temporary_path, path));
+        remove_temporary_file.disarm();
+        return {};
+    };
+    if (auto result = write_index(); result.is_error())
+        dbgln("PathFontProvider: Failed to write the font index: {}", result.error());
 }
 
 RefPtr<Gfx::Font> PathFontProvider::get_font(FlyString const& family, float point_size, unsigned weight, unsigned width, unsigned slope, Optional<FontVariationSettings> const& font_variation_settings, Optional<Gfx::ShapeFeatures> const& shape_features)
@@ -141,9 +300,13 @@ RefPtr<Gfx::Font> PathFontProvider::get_font(FlyString const& family, float poin
     auto it = m_typeface_by_family.find(family);
     if (it == m_typeface_by_family.end())
         return nullptr;
-    for (auto const& typeface : it->value) {
-        if (typeface->weight() == weight && typeface->width() == width && typeface->slope() == slope)
-            return typeface->font(point_size, font_variation_settings.value_or_lazy_evaluated([&] { return compute_default_font_variation_settings(weight, width); }), shape_features.value_or_lazy_evaluated([&] { return compute_default_shape_features(); }));
+    for (auto& entry : it->value) {
+        if (entry.face.weight != weight || entry.face.width != width || entry.face.slope != slope)
+            continue;
+        auto* typeface = typeface_for_entry(entry);
+        if (!typeface)
+            continue;
+        return typeface->font(point_size, font_variation_settings.value_or_lazy_evaluated([&] { return compute_default_font_variation_settings(weight, width); }), shape_features.value_or_lazy_evaluated([&] { return compute_default_shape_features(); }));
     }
 
     return nullptr;
@@ -154,8 +317,9 @@ void PathFontProvider::for_each_typeface_with_family_name(FlyString const& famil
     auto it = m_typeface_by_family.find(family_name);
     if (it == m_typeface_by_family.end())
         return;
-    for (auto const& typeface : it->value) {
-        callback(*typeface);
+    for (auto& entry : it->value) {
+        if (auto* typeface = typeface_for_entry(entry))
+            callback(*typeface);
     }
 }
 
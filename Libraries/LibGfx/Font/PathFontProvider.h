@@ -10,6 +10,7 @@
 #include <AK/Function.h>
 #include <AK/HashMap.h>
 #include <AK/HashTable.h>
+#include <LibCore/Resource.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibGfx/Font/Typeface.h>
 
@@ -32,7 +33,44 @@ public:
     virtual StringView name() const LIFETIME_BOUND override { return m_name.bytes_as_string_view(); }
 
 private:
-    HashMap<FlyString, Vector<NonnullRefPtr<Typeface>>, AK::ASCIICaseInsensitiveFlyStringTraits> m_typeface_by_family;
+    // A face in a font file, as recorded in the font index.
+    struct IndexedFace {
+        u32 ttc_index { 0 };
+        FlyString family;
+        u16 weight { 0 };
+        u16 width { 0 };
+        u8 slope { 0 };
+    };
+
+    struct IndexedFile {
+        i64 modified_time { 0 };
+        u64 size { 0 };
+        Vector<IndexedFace> faces;
+    };
+
+    // A face that may not have been loaded yet. Its typeface is only loaded once a lookup matches it.
+    struct TypefaceEntry {
+        NonnullRefPtr<Core::Resource const> resource;
+        bool is_woff { false };
+        IndexedFace face;
+        RefPtr<Typeface> typeface;
+        bool failed_to_load { false };
+    };
+
+    Vector<IndexedFace> faces_in_file(Core::Resource const&, bool is_woff);
+    Typeface* typeface_for_entry(TypefaceEntry&);
+
+    void load_index_if_needed();
+    void save_index();
+
+    HashMap<FlyString, Vector<TypefaceEntry>, AK::ASCIICaseInsensitiveFlyStringTraits> m_typeface_by_family;
+
+    // OPTIMIZATION: Loading a typeface parses its font file, which adds up to a noticeable part of process startup on
+    //               systems with thousands of fonts. The families and styles of every font file are kept in an index on
+    //               disk instead, and a file is only parsed again once its size or modification time changes.
+    HashMap<String, IndexedFile> m_index;
+    bool m_has_loaded_index { false };
+    bool m_index_is_dirty { false };
 
     // Tracks files we've already loaded, to avoid mmap'ing the same .ttf/.otf/.ttc
     // multiple times when overlapping font directories are walked (fontconfig commonly
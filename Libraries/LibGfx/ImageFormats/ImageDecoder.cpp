@@ -79,4 +79,79 @@ ImageDecoder::ImageDecoder(NonnullOwnPtr<ImageDecoderPlugin> plugin)
 {
 }
 
+static ErrorOr<OwnPtr<IncrementalImageDecoderPlugin>> sniff_for_incremental_plugin(ReadonlyBytes bytes)
+{
+    struct IncrementalPluginInitializer {
+        bool (*sniff)(ReadonlyBytes) = nullptr;
+        ErrorOr<NonnullOwnPtr<IncrementalImageDecoderPlugin>> (*create)() = nullptr;
+    };
+
+    static constexpr IncrementalPluginInitializer s_initializers[] = {
+        { JPEGImageDecoderPlugin::sniff, JPEGImageDecoderPlugin::create_incremental },
+        { PNGImageDecoderPlugin::sniff, PNGImageDecoderPlugin::create_incremental },
+    };
+
+    for (auto& plugin : s_initializers) {
+        if (plugin.sniff(bytes))
+            return TRY(plugin.create());
+    }
+    return OwnPtr<IncrementalImageDecoderPlugin> {};
+}
+
+void IncrementalImageDecoder::append_data(ReadonlyBytes bytes)
+{
+    if (m_is_unsupported || bytes.is_empty())
+        return;
+
+    auto give_up = [&](Error const& error) {
+        dbgln("IncrementalImageDecoder: Can't decode partially: {}", error);
+        m_is_unsupported = true;
+        m_plugin = nullptr;
+        m_sniffed_data.clear();
+    };
+
+    if (!m_plugin) {
+        // NB: The longest signature we sniff for is PNG's, at 8 bytes.
+        static constexpr size_t longest_signature_size = 8;
+
+        if (auto result = m_sniffed_data.try_append(bytes.data(), bytes.size()); result.is_error()) {
+            give_up(result.error());
+            return;
+        }
+
+        auto plugin_or_error = sniff_for_incremental_plugin(m_sniffed_data.span());
+        if (plugin_or_error.is_error()) {
+            give_up(plugin_or_error.error());
+            return;
+        }
+        m_plugin = plugin_or_error.release_value();
+        if (!m_plugin) {
+            if (m_sniffed_data.size() >= longest_signature_size)
+                give_up(Error::from_string_literal("Unsupported image format"));
+            return;
+        }
+
+        auto sniffed_data = move(m_sniffed_data);
+        if (auto result = m_plugin->append_data(sniffed_data.span()); result.is_error())
+            give_up(result.error());
+        return;
+    }
+
+    if (auto result = m_plugin->append_data(bytes); result.is_error())
+        give_up(result.error());
+}
+
+ErrorOr<RefPtr<Bitmap>> IncrementalImageDecoder::take_partial_frame()
+{
+    if (!m_plugin || m_plugin->progress() == m_progress_of_last_partial_frame)
+        return RefPtr<Bitmap> {};
+
+    auto frame = m_plugin->partial_frame();
+    if (!frame)
+        return RefPtr<Bitmap> {};
+
+    m_progress_of_last_partial_frame = m_plugin->progress();
+    return TRY(frame->to_bitmap_backed_by_anonymous_buffer());
+}
+
 }
@@ -138,4 +138,47 @@ private:
     NonnullOwnPtr<ImageDecoderPlugin> mutable m_plugin;
 };
 
+// Formats whose codec can render an image before all of its bytes have arrived implement this, and register a
+// create_incremental() function in ImageDecoder.cpp.
+class IncrementalImageDecoderPlugin {
+public:
+    virtual ~IncrementalImageDecoderPlugin() = default;
+
+    // Hands the next chunk of encoded data to the codec, which decodes as much of the image as it can.
+    // After an error the plugin must not be used again.
+    virtual ErrorOr<void> append_data(ReadonlyBytes) = 0;
+
+    // The image decoded so far, or null while the size isn't known yet. Pixels that haven't been decoded yet are
+    // transparent. This must not be backed by an anonymous buffer, so that copying it out doesn't alias it.
+    virtual RefPtr<Bitmap> partial_frame() = 0;
+
+    // Grows whenever more of partial_frame() has been decoded.
+    virtual u64 progress() const = 0;
+
+protected:
+    IncrementalImageDecoderPlugin() = default;
+};
+
+// Produces partial frames while an image is still loading. This is only a preview: the finished image should be
+// decoded from all of its data by ImageDecoder, as that handles animation, metadata and color spaces.
+class IncrementalImageDecoder {
+public:
+    IncrementalImageDecoder() = default;
+
+    void append_data(ReadonlyBytes);
+
+    // False once it is clear that this data can't be decoded partially.
+    bool can_decode_partially() const { return !m_is_unsupported; }
+
+    // Returns a copy of the image decoded so far, backed by an anonymous buffer, or null if nothing more has been
+    // decoded since the last call.
+    ErrorOr<RefPtr<Bitmap>> take_partial_frame();
+
+private:
+    Vector<u8> m_sniffed_data;
+    OwnPtr<IncrementalImageDecoderPlugin> m_plugin;
+    bool m_is_unsupported { false };
+    u64 m_progress_of_last_partial_frame { 0 };
+};
+
 }
@@ -20,6 +20,10 @@ struct JPEGLoadingContext {
 
     State state { State::NotDecoded };
 
+    IntSize natural_size;
+    // The bitmaps were decoded at scale_numerator / 8 of the natural size.
+    unsigned scale_numerator { 8 };
+
     RefPtr<Gfx::Bitmap> rgb_bitmap;
     RefPtr<Gfx::CMYKBitmap> cmyk_bitmap;
 
@@ -31,15 +35,41 @@ struct JPEGLoadingContext {
     {
     }
 
-    ErrorOr<void> decode();
+    ErrorOr<void> decode(Optional<IntSize> ideal_size);
 };
 
+// libjpeg can scale images down by N/8 while decoding them, which costs much less time and memory than decoding at
+// full size. Pick the smallest scale that is still at least as large as the size asked for.
+static unsigned scale_numerator_for_ideal_size(IntSize natural_size, Optional<IntSize> ideal_size)
+{
+    if (!ideal_size.has_value() || ideal_size->is_empty())
+        return 8;
+    for (unsigned numerator = 1; numerator < 8; ++numerator) {
+        auto width = ceil_div(natural_size.width() * static_cast<int>(numerator), 8);
+        auto height = ceil_div(natural_size.height() * static_cast<int>(numerator), 8);
+        if (width >= ideal_size->width() && height >= ideal_size->height())
+            return numerator;
+    }
+    return 8;
+}
+
 struct JPEGErrorManager : jpeg_error_mgr {
     jmp_buf setjmp_buffer {};
 };
 
-ErrorOr<void> JPEGLoadingContext::decode()
+static void exit_on_jpeg_error(j_common_ptr cinfo)
 {
+    char buffer[JMSG_LENGTH_MAX];
+    (*cinfo->err->format_message)(cinfo, buffer);
+    dbgln("JPEG error: {}", buffer);
+    longjmp(static_cast<JPEGErrorManager*>(cinfo->err)->setjmp_buffer, 1);
+}
+
+ErrorOr<void> JPEGLoadingContext::decode(Optional<IntSize> ideal_size)
+{
+    rgb_bitmap = nullptr;
+    cmyk_bitmap = nullptr;
+
     struct jpeg_decompress_struct cinfo;
     ScopeGuard guard { [&]() { jpeg_destroy_decompress(&cinfo); } };
 
@@ -51,12 +81,7 @@ ErrorOr<void> JPEGLoadingContext::decode()
     if (setjmp(jerr.setjmp_buffer))
         return Error::from_string_literal("Failed to decode JPEG");
 
-    jerr.error_exit = [](j_common_ptr cinfo) {
-        char buffer[JMSG_LENGTH_MAX];
-        (*cinfo->err->format_message)(cinfo, buffer);
-        dbgln("JPEG error: {}", buffer);
-        longjmp(static_cast<JPEGErrorManager*>(cinfo->err)->setjmp_buffer, 1);
-    };
+    jerr.error_exit = exit_on_jpeg_error;
 
     jpeg_create_decompress(&cinfo);
 
@@ -81,6 +106,11 @@ ErrorOr<void> JPEGLoadingContext::decode()
     if (jpeg_read_header(&cinfo, TRUE) != JPEG_HEADER_OK)
         return Error::from_string_literal("Failed to read JPEG header");
 
+    natural_size = { static_cast<int>(cinfo.image_width), static_cast<int>(cinfo.image_height) };
+    scale_numerator = scale_numerator_for_ideal_size(natural_size, ideal_size);
+    cinfo.scale_num = scale_numerator;
+    cinfo.scale_denom = 8;
+
     if (cinfo.jpeg_color_space == JCS_CMYK) {
         cinfo.out_color_space = JCS_CMYK;
     } else if (cinfo.jpeg_color_space == JCS_YCCK) {
@@ -201,11 +231,7 @@ IntSize JPEGImageDecoderPlugin::size()
 
     if (m_context->state == JPEGLoadingContext::State::Error)
         return {};
-    if (m_context->rgb_bitmap)
-        return m_context->rgb_bitmap->size();
-    if (m_context->cmyk_bitmap)
-        return m_context->cmyk_bitmap->size();
-    return {};
+    return m_context->natural_size;
 }
 
 bool JPEGImageDecoderPlugin::sniff(ReadonlyBytes data)
@@ -221,7 +247,193 @@ ErrorOr<NonnullOwnPtr<ImageDecoderPlugin>> JPEGImageDecoderPlugin::create(Readon
     return adopt_own(*new JPEGImageDecoderPlugin(make<JPEGLoadingContext>(data)));
 }
 
-ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize>)
+// Decodes with libjpeg's suspending data source, which gives up (and later resumes) wherever the data ends.
+// Progressive and multi-scan images are decoded in buffered-image mode, which reruns the output pass over the
+// coefficients received so far each time another scan starts, so they sharpen as they arrive.
+class JPEGIncrementalDecoder final : public IncrementalImageDecoderPlugin {
+public:
+    static ErrorOr<NonnullOwnPtr<JPEGIncrementalDecoder>> create()
+    {
+        auto decoder = adopt_own(*new JPEGIncrementalDecoder);
+        auto& cinfo = decoder->m_cinfo;
+
+        cinfo.err = jpeg_std_error(&decoder->m_error_manager);
+        decoder->m_error_manager.error_exit = exit_on_jpeg_error;
+        if (setjmp(decoder->m_error_manager.setjmp_buffer))
+            return Error::from_string_literal("Failed to create JPEG decompressor");
+
+        jpeg_create_decompress(&cinfo);
+        decoder->m_is_created = true;
+
+        auto& source = decoder->m_source_manager;
+        source.next_input_byte = nullptr;
+        source.bytes_in_buffer = 0;
+        source.init_source = [](j_decompress_ptr) { };
+        // NB: Returning false suspends the decoder until append_data() brings more data in.
+        source.fill_input_buffer = [](j_decompress_ptr) -> boolean { return false; };
+        source.skip_input_data = [](j_decompress_ptr context, long num_bytes) {
+            if (num_bytes <= 0)
+                return;
+            auto& source = *static_cast<SourceManager*>(context->src);
+            auto bytes_to_skip = static_cast<size_t>(num_bytes);
+            if (bytes_to_skip > source.bytes_in_buffer) {
+                // The rest of the skip runs past the data we have, so it has to come out of later data.
+                source.pending_bytes_to_skip = bytes_to_skip - source.bytes_in_buffer;
+                bytes_to_skip = source.bytes_in_buffer;
+            }
+            source.next_input_byte += bytes_to_skip;
+            source.bytes_in_buffer -= bytes_to_skip;
+        };
+        source.resync_to_restart = jpeg_resync_to_restart;
+        source.term_source = [](j_decompress_ptr) { };
+        cinfo.src = &source;
+
+        return decoder;
+    }
+
+    virtual ~JPEGIncrementalDecoder() override
+    {
+        if (m_is_created)
+            jpeg_destroy_decompress(&m_cinfo);
+    }
+
+    virtual ErrorOr<void> append_data(ReadonlyBytes bytes) override
+    {
+        if (m_state == State::Done)
+            return {};
+
+        // Drop what libjpeg has consumed; it backs up to where it needs to resume before suspending.
+        auto& source = m_source_manager;
+        m_buffer.remove(0, m_buffer.size() - source.bytes_in_buffer);
+
+        auto bytes_to_skip = min(source.pending_bytes_to_skip, bytes.size());
+        source.pending_bytes_to_skip -= bytes_to_skip;
+        TRY(m_buffer.try_append(bytes.data() + bytes_to_skip, bytes.size() - bytes_to_skip));
+
+        source.next_input_byte = m_buffer.data();
+        source.bytes_in_buffer = m_buffer.size();
+
+        if (setjmp(m_error_manager.setjmp_buffer))
+            return Error::from_string_literal("Failed to decode JPEG data incrementally");
+
+        return decode_available_data();
+    }
+
+    virtual RefPtr<Bitmap> partial_frame() override { return m_bitmap; }
+    virtual u64 progress() const override { return m_progress; }
+
+private:
+    enum class State {
+        ReadingHeader,
+        StartingDecompress,
+        ChoosingOutputScan,
+        StartingOutput,
+        ReadingScanlines,
+        FinishingOutput,
+        Done,
+    };
+
+    struct SourceManager : jpeg_source_mgr {
+        size_t pending_bytes_to_skip { 0 };
+    };
+
+    JPEGIncrementalDecoder() = default;
+
+    // Each libjpeg call below returns early if it had to suspend, and is repeated on the next call.
+    ErrorOr<void> decode_available_data()
+    {
+        while (true) {
+            switch (m_state) {
+            case State::ReadingHeader:
+                if (jpeg_read_header(&m_cinfo, TRUE) == JPEG_SUSPENDED)
+                    return {};
+
+                // NB: CMYK images need conversion after the fact, which only the full decoder does.
+                if (m_cinfo.jpeg_color_space == JCS_CMYK || m_cinfo.jpeg_color_space == JCS_YCCK)
+                    return Error::from_string_literal("CMYK JPEGs can't be decoded incrementally");
+
+                m_cinfo.out_color_space = JCS_EXT_BGRA;
+                m_cinfo.buffered_image = jpeg_has_multiple_scans(&m_cinfo);
+                m_state = State::StartingDecompress;
+                break;
+
+            case State::StartingDecompress:
+                if (!jpeg_start_decompress(&m_cinfo))
+                    return {};
+
+                m_bitmap = TRY(Bitmap::create(BitmapFormat::BGRA8888, AlphaType::Premultiplied, { static_cast<int>(m_cinfo.output_width), static_cast<int>(m_cinfo.output_height) }));
+                m_state = m_cinfo.buffered_image ? State::ChoosingOutputScan : State::ReadingScanlines;
+                break;
+
+            case State::ChoosingOutputScan: {
+                int status;
+                do {
+                    status = jpeg_consume_input(&m_cinfo);
+                } while (status != JPEG_SUSPENDED && status != JPEG_REACHED_EOI);
+
+                // NB: This has to be decided before starting the output pass, which may take in more input.
+                m_is_final_pass = jpeg_input_complete(&m_cinfo);
+
+                // Redrawing the image only pays off once another scan has started.
+                if (!m_is_final_pass && m_cinfo.input_scan_number == m_cinfo.output_scan_number)
+                    return {};
+
+                m_output_scan_number = m_cinfo.input_scan_number;
+                m_state = State::StartingOutput;
+                break;
+            }
+
+            case State::StartingOutput:
+                if (!jpeg_start_output(&m_cinfo, m_output_scan_number))
+                    return {};
+                m_state = State::ReadingScanlines;
+                break;
+
+            case State::ReadingScanlines:
+                while (m_cinfo.output_scanline < m_cinfo.output_height) {
+                    auto* row = m_bitmap->scanline_u8(m_cinfo.output_scanline);
+                    if (jpeg_read_scanlines(&m_cinfo, &row, 1) == 0)
+                        return {};
+                    ++m_progress;
+                }
+                m_state = m_cinfo.buffered_image ? State::FinishingOutput : State::Done;
+                break;
+
+            case State::FinishingOutput:
+                if (!jpeg_finish_output(&m_cinfo))
+                    return {};
+                m_state = m_is_final_pass ? State::Done : State::ChoosingOutputScan;
+                break;
+
+            case State::Done:
+                m_buffer.clear();
+                return {};
+            }
+        }
+    }
+
+    State m_state { State::ReadingHeader };
+    jpeg_decompress_struct m_cinfo {};
+    JPEGErrorManager m_error_manager {};
+    SourceManager m_source_manager {};
+    bool m_is_created { false };
+
+    // The data libjpeg hasn't consumed yet; its source manager points into this.
+    Vector<u8> m_buffer;
+
+    bool m_is_final_pass { false };
+    int m_output_scan_number { 0 };
+
+    RefPtr<Bitmap> m_bitmap;
+    u64 m_progress { 0 };
+};
+
+ErrorOr<NonnullOwnPtr<IncrementalImageDecoderPlugin>> JPEGImageDecoderPlugin::create_incremental()
+{
+    return TRY(JPEGIncrementalDecoder::create());
+}
+
+ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Optional<IntSize> ideal_size)
 {
     if (index > 0)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Invalid frame index");
@@ -229,8 +441,12 @@ ErrorOr<ImageFrameDescriptor> JPEGImageDecoderPlugin::frame(size_t index, Option
     if (m_context->state == JPEGLoadingContext::State::Error)
         return Error::from_string_literal("JPEGImageDecoderPlugin: Decoding failed");
 
+    // A frame decoded for a different ideal size has to be decoded again at the scale that size calls for.
+    if (m_context->state == JPEGLoadingContext::State::Decoded && scale_numerator_for_ideal_size(m_context->natural_size, ideal_size) != m_context->scale_numerator)
+        m_context->state = JPEGLoadingContext::State::NotDecoded;
+
     if (m_context->state < JPEGLoadingContext::State::Decoded) {
-        if (auto result = m_context->decode(); result.is_error()) {
+        if (auto result = m_context->decode(ideal_size); result.is_error()) {
             m_context->state = JPEGLoadingContext::State::Error;
             return result.release_error();
         }
@@ -161,6 +161,35 @@ static void log_png_warning(png_structp, char const* warning_message)
     dbgln("libpng warning: {}", warning_message);
 }
 
+// Sets up libpng to turn every color type and bit depth into the BGRA8888 rows our bitmaps are made of.
+static void set_up_transformations(png_structp png_ptr, png_infop info_ptr)
+{
+    int bit_depth = png_get_bit_depth(png_ptr, info_ptr);
+    int color_type = png_get_color_type(png_ptr, info_ptr);
+    int interlace_type = png_get_interlace_type(png_ptr, info_ptr);
+
+    if (color_type == PNG_COLOR_TYPE_PALETTE)
+        png_set_palette_to_rgb(png_ptr);
+
+    if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8)
+        png_set_expand_gray_1_2_4_to_8(png_ptr);
+
+    if (png_get_valid(png_ptr, info_ptr, PNG_INFO_tRNS))
+        png_set_tRNS_to_alpha(png_ptr);
+
+    if (bit_depth == 16)
+        png_set_strip_16(png_ptr);
+
+    if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
+        png_set_gray_to_rgb(png_ptr);
+
+    if (interlace_type != PNG_INTERLACE_NONE)
+        png_set_interlace_handling(png_ptr);
+
+    png_set_filler(png_ptr, 0xFF, PNG_FILLER_AFTER);
+    png_set_bgr(png_ptr);
+}
+
 ErrorOr<void> PNGImageDecoderPlugin::initialize()
 {
     m_context->png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, nullptr, nullptr);
@@ -190,34 +219,11 @@ ErrorOr<void> PNGImageDecoderPlugin::initialize()
 
     png_read_info(m_context->png_ptr, m_context->info_ptr);
 
-    u32 width = 0;
-    u32 height = 0;
-    int bit_depth = 0;
-    int color_type = 0;
-    int interlace_type = 0;
-    png_get_IHDR(m_context->png_ptr, m_context->info_ptr, &width, &height, &bit_depth, &color_type, &interlace_type, nullptr, nullptr);
+    u32 width = png_get_image_width(m_context->png_ptr, m_context->info_ptr);
+    u32 height = png_get_image_height(m_context->png_ptr, m_context->info_ptr);
     m_context->size = { static_cast<int>(width), static_cast<int>(height) };
 
-    if (color_type == PNG_COLOR_TYPE_PALETTE)
-        png_set_palette_to_rgb(m_context->png_ptr);
-
-    if (color_type == PNG_COLOR_TYPE_GRAY && bit_depth < 8)
-        png_set_expand_gray_1_2_4_to_8(m_context->png_ptr);
-
-    if (png_get_valid(m_context->png_ptr, m_context->info_ptr, PNG_INFO_tRNS))
-        png_set_tRNS_to_alpha(m_context->png_ptr);
-
-    if (bit_depth == 16)
-        png_set_strip_16(m_context->png_ptr);
-
-    if (color_type == PNG_COLOR_TYPE_GRAY || color_type == PNG_COLOR_TYPE_GRAY_ALPHA)
-        png_set_gray_to_rgb(m_context->png_ptr);
-
-    if (interlace_type != PNG_INTERLACE_NONE)
-        png_set_interlace_handling(m_context->png_ptr);
-
-    png_set_filler(m_context->png_ptr, 0xFF, PNG_FILLER_AFTER);
-    png_set_bgr(m_context->png_ptr);
+    set_up_transformations(m_context->png_ptr, m_context->info_ptr);
 
     png_byte color_primaries { 0 };
     png_byte transfer_function { 0 };
@@ -393,6 +399,101 @@ ErrorOr<size_t> PNGLoadingContext::read_frames(png_structp png_ptr, png_infop in
 
 PNGImageDecoderPlugin::~PNGImageDecoderPlugin() = default;
 
+// Decodes rows as libpng's progressive reader hands them to us. Interlaced images get each of their passes merged
+// into the rows that earlier passes left, so they sharpen as they arrive.
+class PNGIncrementalDecoder final : public IncrementalImageDecoderPlugin {
+public:
+    static ErrorOr<NonnullOwnPtr<PNGIncrementalDecoder>> create()
+    {
+        auto decoder = adopt_own(*new PNGIncrementalDecoder);
+
+        decoder->m_png_ptr = png_create_read_struct(PNG_LIBPNG_VER_STRING, nullptr, log_png_error, log_png_warning);
+        if (!decoder->m_png_ptr)
+            return Error::from_string_literal("Failed to allocate read struct");
+
+        decoder->m_info_ptr = png_create_info_struct(decoder->m_png_ptr);
+        if (!decoder->m_info_ptr)
+            return Error::from_string_literal("Failed to allocate info struct");
+
+        png_set_progressive_read_fn(decoder->m_png_ptr, decoder.ptr(), did_read_info, did_read_row, nullptr);
+        return decoder;
+    }
+
+    virtual ~PNGIncrementalDecoder() override
+    {
+        png_destroy_read_struct(&m_png_ptr, &m_info_ptr, nullptr);
+    }
+
+    virtual ErrorOr<void> append_data(ReadonlyBytes bytes) override
+    {
+        // NOTE: We need to setjmp() here because libpng uses longjmp() for error handling.
+        if (setjmp(png_jmpbuf(m_png_ptr)))
+            return Error::from_string_literal("Failed to decode PNG data incrementally");
+
+        png_process_data(m_png_ptr, m_info_ptr, const_cast<u8*>(bytes.data()), bytes.size());
+        return {};
+    }
+
+    virtual RefPtr<Bitmap> partial_frame() override { return m_bitmap; }
+    virtual u64 progress() const override { return m_progress; }
+
+private:
+    PNGIncrementalDecoder() = default;
+
+    static void did_read_info(png_structp png_ptr, png_infop info_ptr)
+    {
+        auto& decoder = *static_cast<PNGIncrementalDecoder*>(png_get_progressive_ptr(png_ptr));
+
+        // NB: Animated images show frames composited over each other, and EXIF-oriented images need rotating. Leave
+        //     both to the full decoder, rather than previewing the wrong picture.
+        u32 frame_count = 0;
+        u32 loop_count = 0;
+        u8* exif_data = nullptr;
+        u32 exif_length = 0;
+        if (png_get_acTL(png_ptr, info_ptr, &frame_count, &loop_count) || png_get_eXIf_1(png_ptr, info_ptr, &exif_length, &exif_data) > 0)
+            png_longjmp(png_ptr, 1);
+
+        set_up_transformations(png_ptr, info_ptr);
+        png_read_update_info(png_ptr, info_ptr);
+
+        u32 width = png_get_image_width(png_ptr, info_ptr);
+        u32 height = png_get_image_height(png_ptr, info_ptr);
+        if (png_get_rowbytes(png_ptr, info_ptr) != static_cast<size_t>(width) * sizeof(u32))
+            png_longjmp(png_ptr, 1);
+
+        // NB: Nothing with a destructor may be alive when libpng longjmp()s out of here.
+        {
+            auto bitmap_or_error = Bitmap::create(BitmapFormat::BGRA8888, AlphaType::Unpremultiplied, { static_cast<int>(width), static_cast<int>(height) });
+            if (!bitmap_or_error.is_error())
+                decoder.m_bitmap = bitmap_or_error.release_value();
+        }
+        if (!decoder.m_bitmap)
+            png_longjmp(png_ptr, 1);
+    }
+
+    static void did_read_row(png_structp png_ptr, png_bytep new_row, png_uint_32 row_number, int)
+    {
+        auto& decoder = *static_cast<PNGIncrementalDecoder*>(png_get_progressive_ptr(png_ptr));
+
+        // NB: Interlaced images hand us a null row for rows that the current pass doesn't touch.
+        if (!new_row || row_number >= static_cast<u32>(decoder.m_bitmap->height()))
+            return;
+
+        png_progressive_combine_row(png_ptr, decoder.m_bitmap->scanline_u8(row_number), new_row);
+        ++decoder.m_progress;
+    }
+
+    png_structp m_png_ptr { nullptr };
+    png_infop m_info_ptr { nullptr };
+    RefPtr<Bitmap> m_bitmap;
+    u64 m_progress { 0 };
+};
+
+ErrorOr<NonnullOwnPtr<IncrementalImageDecoderPlugin>> PNGImageDecoderPlugin::create_incremental()
+{
+    return TRY(PNGIncrementalDecoder::create());
+}
+
 bool PNGImageDecoderPlugin::sniff(ReadonlyBytes data)
 {
     auto constexpr png_signature_size_in_bytes = 8;
@@ -54,6 +54,14 @@ ErrorOr<ByteBuffer> PNGWriter::encode(Gfx::Bitmap const& bitmap, Options options
 
     png_set_IHDR(png_ptr, info_ptr, width, height, 8, PNG_COLOR_TYPE_RGBA, PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
 
+    // NB: By default, libpng tries every filter on each row to pick the one that compresses best, and then compresses
+    //     at zlib's default level. Most of the time goes into that, so the fast mode uses a single filter that suits
+    //     rendered content and zlib's fastest level.
+    if (options.compression == Options::Compression::Fast) {
+        png_set_filter(png_ptr, PNG_FILTER_TYPE_BASE, PNG_FILTER_SUB);
+        png_set_compression_level(png_ptr, 1);
+    }
+
     context->row_pointers.resize(height);
     for (int y = 0; y < height; ++y) {
         context->row_pointers[y] = const_cast<u8*>(bitmap.scanline_u8(y));
@@ -15,9 +15,18 @@ namespace Gfx {
 
 // This is not a nested struct to work around https://llvm.org/PR36684
 struct PNGWriterOptions {
+    enum class Compression {
+        Default,
+        // Produces somewhat larger files in a fraction of the time, for images that are encoded often and only kept
+        // briefly, like screenshots.
+        Fast,
+    };
+
     // Data for the iCCP chunk.
     // FIXME: Allow writing cICP, sRGB, or gAMA instead too.
     Optional<ReadonlyBytes> icc_data;
+
+    Compression compression { Compression::Default };
 };
 
 class PNGWriter {
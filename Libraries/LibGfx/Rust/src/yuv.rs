@@ -142,31 +142,22 @@ pub unsafe extern "C" fn yuv_u16_to_rgba(
             (false, false) => yuv::i410_to_rgba(&planar_image, dst_slice, dst_stride, range.into(), matrix.into()),
         }
     } else {
-        // 12-bit 4:4:4 has no 8-bit RGBA output; shift to 10-bit and use I410.
+        // 12-bit 4:4:4 has no 8-bit RGBA output; shift to 10-bit and use I410. Without chroma subsampling every row
+        // converts independently, so this goes through a small strip of rows at a time instead of copying whole planes.
         if !subsampling_x && !subsampling_y {
-            let y_10: Vec<u16> = unsafe { core::slice::from_raw_parts(y_plane, y_len) }
-                .iter()
-                .map(|&v| v >> 2)
-                .collect();
-            let u_10: Vec<u16> = unsafe { core::slice::from_raw_parts(u_plane, uv_len) }
-                .iter()
-                .map(|&v| v >> 2)
-                .collect();
-            let v_10: Vec<u16> = unsafe { core::slice::from_raw_parts(v_plane, uv_len) }
-                .iter()
-                .map(|&v| v >> 2)
-                .collect();
-            let planar_10 = YuvPlanarImage {
-                y_plane: &y_10,
-                y_stride,
-                u_plane: &u_10,
-                u_stride,
-                v_plane: &v_10,
-                v_stride,
+            let y_plane = unsafe { core::slice::from_raw_parts(y_plane, y_len) };
+            let u_plane = unsafe { core::slice::from_raw_parts(u_plane, uv_len) };
+            let v_plane = unsafe { core::slice::from_raw_parts(v_plane, uv_len) };
+            return convert_12_bit_444_in_strips(
+                [y_plane, u_plane, v_plane],
+                [y_stride, u_stride, v_stride],
                 width,
                 height,
-            };
-            return yuv::i410_to_rgba(&planar_10, dst_slice, dst_stride, range.into(), matrix.into()).is_ok();
+                dst_slice,
+                dst_stride,
+                range,
+                matrix,
+            );
         }
         match (subsampling_x, subsampling_y) {
             (true, true) => yuv::i012_to_rgba(&planar_image, dst_slice, dst_stride, range.into(), matrix.into()),
@@ -178,3 +169,59 @@ pub unsafe extern "C" fn yuv_u16_to_rgba(
 
     result.is_ok()
 }
+
+const STRIP_ROW_COUNT: u32 = 16;
+
+#[allow(clippy::too_many_arguments)]
+fn convert_12_bit_444_in_strips(
+    planes: [&[u16]; 3],
+    strides: [u32; 3],
+    width: u32,
+    height: u32,
+    dst: &mut [u8],
+    dst_stride: u32,
+    range: YUVRange,
+    matrix: YUVMatrix,
+) -> bool {
+    let range: YuvRange = range.into();
+    let matrix: YuvStandardMatrix = matrix.into();
+
+    let mut strips: [Vec<u16>; 3] = Default::default();
+    for (strip, stride) in strips.iter_mut().zip(strides) {
+        strip.resize(stride as usize * STRIP_ROW_COUNT as usize, 0);
+    }
+
+    let mut first_row = 0;
+    while first_row < height {
+        let row_count = STRIP_ROW_COUNT.min(height - first_row);
+        for ((strip, plane), stride) in strips.iter_mut().zip(planes).zip(strides) {
+            let start = first_row as usize * stride as usize;
+            let length = row_count as usize * stride as usize;
+            for (shifted, &sample) in strip.iter_mut().zip(&plane[start..start + length]) {
+                *shifted = sample >> 2;
+            }
+        }
+
+        let strip_length = |stride: u32| row_count as usize * stride as usize;
+        let strip_image = YuvPlanarImage {
+            y_plane: &strips[0][..strip_length(strides[0])],
+            y_stride: strides[0],
+            u_plane: &strips[1][..strip_length(strides[1])],
+            u_stride: strides[1],
+            v_plane: &strips[2][..strip_length(strides[2])],
+            v_stride: strides[2],
+            width,
+            height: row_count,
+        };
+
+        let dst_start = first_row as usize * dst_stride as usize;
+        let dst_strip = &mut dst[dst_start..dst_start + strip_length(dst_stride)];
+        if yuv::i410_to_rgba(&strip_image, dst_strip, dst_stride, range, matrix).is_err() {
+            return false;
+        }
+
+        first_row += row_count;
+    }
+
+    true
+}
@@ -50,6 +50,12 @@ NonnullRefPtr<GlyphRun> GlyphRun::slice(size_t start, size_t length) const
     return adopt_ref(*new GlyphRun(move(sliced_glyphs), m_font, m_text_type, width));
 }
 
+NonnullRefPtr<GlyphRun> GlyphRun::clone() const
+{
+    auto glyphs = m_glyphs;
+    return adopt_ref(*new GlyphRun(move(glyphs), m_font, m_text_type, m_width));
+}
+
 void GlyphRun::ensure_text_blob(float scale) const
 {
     if (m_cached_text_blob && m_cached_text_blob->scale == scale)
@@ -264,13 +270,16 @@ NonnullRefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spaci
         return adopt_ref(*new GlyphRun(move(glyphs), font, text_type, shape.width));
     };
 
-    // FIXME: The cache currently grows unbounded. We should have some limit and LRU mechanism.
     if (string.length_in_code_units() == 1 && letter_spacing == 0.f && text_type == GlyphRun::TextType::Common) {
         auto code_unit = string.code_unit_at(0);
         if (code_unit < 128) {
             auto& cache_slot = shaping_cache.single_ascii_character_map[code_unit];
-            if (!cache_slot)
+            if (cache_slot) {
+                Font::ShapingCache::record_hit();
+            } else {
+                Font::ShapingCache::record_miss();
                 cache_slot = build_origin_relative_shape(string, font, text_type, letter_spacing);
+            }
             return build_glyph_run(*cache_slot);
         }
     }
@@ -279,18 +288,15 @@ NonnullRefPtr<GlyphRun> shape_text(FloatPoint baseline_start, float letter_spaci
     auto letter_spacing_bit_pattern = bit_cast<u32>(letter_spacing);
     auto key_hash = pair_int_hash(string.hash(), pair_int_hash(text_type_bits, letter_spacing_bit_pattern));
 
-    if (auto it = shaping_cache.map.find(key_hash, [&](auto const& candidate) {
-            return candidate.key.text_type == text_type_bits
-                && candidate.key.letter_spacing_bit_pattern == letter_spacing_bit_pattern
-                && candidate.key.text == string;
-        });
-        it != shaping_cache.map.end()) {
-        return build_glyph_run(*it->value);
+    if (auto const* shape = shaping_cache.find(key_hash, string, text_type_bits, letter_spacing_bit_pattern)) {
+        Font::ShapingCache::record_hit();
+        return build_glyph_run(*shape);
     }
 
+    Font::ShapingCache::record_miss();
     auto shape = build_origin_relative_shape(string, font, text_type, letter_spacing);
     auto run = build_glyph_run(*shape);
-    shaping_cache.map.set({ Utf16String::from_utf16(string), text_type_bits, letter_spacing_bit_pattern }, move(shape));
+    shaping_cache.set({ Utf16String::from_utf16(string), text_type_bits, letter_spacing_bit_pattern }, key_hash, move(shape));
     return run;
 }
 
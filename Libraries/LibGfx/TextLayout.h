@@ -55,6 +55,7 @@ public:
     [[nodiscard]] float width() const { return m_width; }
 
     [[nodiscard]] NonnullRefPtr<GlyphRun> slice(size_t start, size_t length) const;
+    [[nodiscard]] NonnullRefPtr<GlyphRun> clone() const;
 
     void ensure_text_blob(float scale) const;
 
@@ -29,9 +29,12 @@ struct YUVDataImpl {
     Media::Subsampling subsampling;
     Media::CodingIndependentCodePoints cicp;
 
-    FixedArray<u8> y_buffer;
-    FixedArray<u8> u_buffer;
-    FixedArray<u8> v_buffer;
+    // All three planes live back to back in one shared memory buffer, so the frame can be sent to another process
+    // without copying it.
+    Core::AnonymousBuffer buffer;
+    Bytes y_buffer;
+    Bytes u_buffer;
+    Bytes v_buffer;
 };
 
 }
@@ -75,22 +78,8 @@ ErrorOr<YUVData::PlaneSizes> YUVData::plane_sizes(IntSize size, u8 bit_depth, Me
 ErrorOr<NonnullOwnPtr<YUVData>> YUVData::create(IntSize size, u8 bit_depth, Media::Subsampling subsampling, Media::CodingIndependentCodePoints cicp)
 {
     auto sizes = TRY(plane_sizes(size, bit_depth, subsampling));
-
-    auto y_buffer = TRY(FixedArray<u8>::create(sizes.y));
-    auto u_buffer = TRY(FixedArray<u8>::create(sizes.u));
-    auto v_buffer = TRY(FixedArray<u8>::create(sizes.v));
-
-    auto impl = TRY(try_make<Details::YUVDataImpl>(Details::YUVDataImpl {
-        .size = size,
-        .bit_depth = bit_depth,
-        .subsampling = subsampling,
-        .cicp = cicp,
-        .y_buffer = move(y_buffer),
-        .u_buffer = move(u_buffer),
-        .v_buffer = move(v_buffer),
-    }));
-
-    return adopt_nonnull_own_or_enomem(new (nothrow) YUVData(move(impl)));
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(sizes.total));
+    return create_with_anonymous_buffer(size, bit_depth, subsampling, cicp, move(buffer));
 }
 
 ErrorOr<NonnullOwnPtr<YUVData>> YUVData::create_from_data(IntSize size, u8 bit_depth, Media::Subsampling subsampling, Media::CodingIndependentCodePoints cicp, ReadonlyBytes y_data, ReadonlyBytes u_data, ReadonlyBytes v_data)
@@ -106,6 +95,27 @@ ErrorOr<NonnullOwnPtr<YUVData>> YUVData::create_from_data(IntSize size, u8 bit_d
     return yuv_data;
 }
 
+ErrorOr<NonnullOwnPtr<YUVData>> YUVData::create_with_anonymous_buffer(IntSize size, u8 bit_depth, Media::Subsampling subsampling, Media::CodingIndependentCodePoints cicp, Core::AnonymousBuffer buffer)
+{
+    auto sizes = TRY(plane_sizes(size, bit_depth, subsampling));
+    if (!buffer.is_valid() || buffer.size() != sizes.total)
+        return Error::from_string_literal("YUVData buffer size mismatch");
+
+    auto bytes = Bytes { buffer.data<u8>(), buffer.size() };
+    auto impl = TRY(try_make<Details::YUVDataImpl>(Details::YUVDataImpl {
+        .size = size,
+        .bit_depth = bit_depth,
+        .subsampling = subsampling,
+        .cicp = cicp,
+        .buffer = move(buffer),
+        .y_buffer = bytes.slice(0, sizes.y),
+        .u_buffer = bytes.slice(sizes.y, sizes.u),
+        .v_buffer = bytes.slice(sizes.y + sizes.u, sizes.v),
+    }));
+
+    return adopt_nonnull_own_or_enomem(new (nothrow) YUVData(move(impl)));
+}
+
 YUVData::YUVData(NonnullOwnPtr<Details::YUVDataImpl> impl)
     : m_impl(move(impl))
 {
@@ -133,34 +143,39 @@ Media::CodingIndependentCodePoints const& YUVData::cicp() const
     return m_impl->cicp;
 }
 
+Core::AnonymousBuffer const& YUVData::anonymous_buffer() const
+{
+    return m_impl->buffer;
+}
+
 Bytes YUVData::y_data()
 {
-    return m_impl->y_buffer.span();
+    return m_impl->y_buffer;
 }
 
 Bytes YUVData::u_data()
 {
-    return m_impl->u_buffer.span();
+    return m_impl->u_buffer;
 }
 
 Bytes YUVData::v_data()
 {
-    return m_impl->v_buffer.span();
+    return m_impl->v_buffer;
 }
 
 ReadonlyBytes YUVData::y_data() const
 {
-    return m_impl->y_buffer.span();
+    return m_impl->y_buffer;
 }
 
 ReadonlyBytes YUVData::u_data() const
 {
-    return m_impl->u_buffer.span();
+    return m_impl->u_buffer;
 }
 
 ReadonlyBytes YUVData::v_data() const
 {
-    return m_impl->v_buffer.span();
+    return m_impl->v_buffer;
 }
 
 static FFI::YUVMatrix yuv_matrix_for_cicp(Media::CodingIndependentCodePoints const& cicp)
@@ -333,7 +348,7 @@ static u16 expand_sample_to_full_16_bit_range(u16 sample, u8 bit_depth)
     return static_cast<u16>((sample << shift) | (sample >> inverse_shift));
 }
 
-static void copy_plane_expanded_to_full_16_bit_range(FixedArray<u8> const& source_buffer, SkPixmap const& destination, IntSize plane_size, u8 bit_depth)
+static void copy_plane_expanded_to_full_16_bit_range(ReadonlyBytes source_buffer, SkPixmap const& destination, IntSize plane_size, u8 bit_depth)
 {
     VERIFY(bit_depth > 8);
 
@@ -7,9 +7,9 @@
 #pragma once
 
 #include <AK/Error.h>
-#include <AK/FixedArray.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/NonnullRefPtr.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibGfx/Forward.h>
 #include <LibGfx/Size.h>
 #include <LibMedia/Color/CodingIndependentCodePoints.h>
@@ -26,7 +26,8 @@ struct YUVDataImpl;
 }
 
 // Holds planar YUV data with metadata needed for GPU conversion.
-// Uses FixedArray for deterministic buffer sizing.
+// The planes are stored back to back in a single anonymous buffer, which is shared rather than copied when the data is
+// sent over IPC.
 // Not ref-counted - owned directly by decoded video frame objects via NonnullOwnPtr.
 class YUVData final {
 public:
@@ -40,6 +41,8 @@ public:
     static ErrorOr<PlaneSizes> plane_sizes(IntSize size, u8 bit_depth, Media::Subsampling);
     static ErrorOr<NonnullOwnPtr<YUVData>> create(IntSize size, u8 bit_depth, Media::Subsampling, Media::CodingIndependentCodePoints);
     static ErrorOr<NonnullOwnPtr<YUVData>> create_from_data(IntSize size, u8 bit_depth, Media::Subsampling, Media::CodingIndependentCodePoints, ReadonlyBytes y_data, ReadonlyBytes u_data, ReadonlyBytes v_data);
+    // The buffer must hold the Y, U and V planes back to back, with the sizes given by plane_sizes().
+    static ErrorOr<NonnullOwnPtr<YUVData>> create_with_anonymous_buffer(IntSize size, u8 bit_depth, Media::Subsampling, Media::CodingIndependentCodePoints, Core::AnonymousBuffer);
 
     ~YUVData();
 
@@ -48,6 +51,9 @@ public:
     Media::Subsampling subsampling() const;
     Media::CodingIndependentCodePoints const& cicp() const;
 
+    // Holds all three planes, in the layout create_with_anonymous_buffer() expects.
+    Core::AnonymousBuffer const& anonymous_buffer() const;
+
     // Writable access for decoder to fill buffers after creation
     Bytes y_data();
     Bytes u_data();
@@ -4,9 +4,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ConstrainedStream.h>
 #include <AK/Debug.h>
 #include <AK/HashFunctions.h>
 #include <AK/ScopeGuard.h>
+#include <LibCompress/Deflate.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibHTTP/Cache/CacheEntry.h>
@@ -27,6 +29,9 @@ ErrorOr<CacheHeader> CacheHeader::read_from_stream(Stream& stream)
     header.status_code = TRY(stream.read_value<u32>());
     header.reason_phrase_size = TRY(stream.read_value<u32>());
     header.reason_phrase_hash = TRY(stream.read_value<u32>());
+    header.body_encoding = static_cast<CacheBodyEncoding>(TRY(stream.read_value<u32>()));
+    if (header.body_encoding != CacheBodyEncoding::Identity && header.body_encoding != CacheBodyEncoding::Deflate)
+        return Error::from_string_literal("Unknown body encoding");
     return header;
 }
 
@@ -40,6 +45,7 @@ ErrorOr<void> CacheHeader::write_to_stream(Stream& stream) const
     TRY(stream.write_value(status_code));
     TRY(stream.write_value(reason_phrase_size));
     TRY(stream.write_value(reason_phrase_hash));
+    TRY(stream.write_value(to_underlying(body_encoding)));
     return {};
 }
 
@@ -54,6 +60,7 @@ u32 CacheHeader::hash() const
     hash = pair_int_hash(hash, status_code);
     hash = pair_int_hash(hash, reason_phrase_size);
     hash = pair_int_hash(hash, reason_phrase_hash);
+    hash = pair_int_hash(hash, to_underlying(body_encoding));
     return hash;
 }
 
@@ -116,6 +123,8 @@ CacheEntryWriter::CacheEntryWriter(DiskCache& disk_cache, CacheIndex& index, u64
 {
 }
 
+CacheEntryWriter::~CacheEntryWriter() = default;
+
 ErrorOr<void> CacheEntryWriter::write_status_and_reason(u32 status_code, Optional<String> reason_phrase, HeaderList const& request_headers, HeaderList const& response_headers)
 {
     if (m_marked_for_deletion) {
@@ -148,6 +157,9 @@ ErrorOr<void> CacheEntryWriter::write_status_and_reason(u32 status_code, Optiona
         if (cache_lifetime_status(request_headers, response_headers, freshness_lifetime, current_age) == CacheLifetimeStatus::Expired)
             return Error::from_string_literal("Response has already expired");
 
+        if (m_disk_cache.compresses_text_bodies() && should_compress_body_at_rest(response_headers))
+            m_cache_header.body_encoding = CacheBodyEncoding::Deflate;
+
         (void)FileSystem::remove(m_temporary_path->string(), FileSystem::RecursionMode::Disallowed);
         auto unbuffered_file = TRY(Core::File::open(m_temporary_path->string(), Core::File::OpenMode::Write | Core::File::OpenMode::MustBeNew));
         m_file = TRY(Core::OutputBufferedFile::create(move(unbuffered_file)));
@@ -158,6 +170,10 @@ ErrorOr<void> CacheEntryWriter::write_status_and_reason(u32 status_code, Optiona
             TRY(m_file->write_until_depleted(*reason_phrase));
         m_data_offset = TRY(m_file->tell());
 
+        // Bodies are compressed as they stream in, so they are never held in memory in full.
+        if (is_body_compressed())
+            m_compressor = TRY(Compress::DeflateCompressor::create(MaybeOwned<Stream> { *m_file }, Compress::GenericZlibCompressionLevel::Fastest));
+
         return {};
     }();
 
@@ -181,7 +197,9 @@ ErrorOr<void> CacheEntryWriter::write_data(ReadonlyBytes data)
         return Error::from_string_literal("Cache entry has been deleted");
     }
 
-    if (auto result = m_file->write_until_depleted(data); result.is_error()) {
+    auto result = m_compressor ? m_compressor->write_until_depleted(data) : m_file->write_until_depleted(data);
+
+    if (result.is_error()) {
         dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to write data to cache entry for\033[0m {}: {}", m_url, result.error());
 
         remove_incomplete_temporary_file();
@@ -190,7 +208,9 @@ ErrorOr<void> CacheEntryWriter::write_data(ReadonlyBytes data)
         return result.release_error();
     }
 
-    m_cache_footer.data_size += data.size();
+    // The size of a compressed body is only known once the compressor is finished.
+    if (!m_compressor)
+        m_cache_footer.data_size += data.size();
     return {};
 }
 
@@ -201,6 +221,11 @@ ErrorOr<void> CacheEntryWriter::flush(NonnullRefPtr<HeaderList> request_headers,
 
 ErrorOr<CacheEntryBodyFile> CacheEntryWriter::flush_and_take_body_file(NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers)
 {
+    if (is_body_compressed()) {
+        TRY(flush_impl(move(request_headers), move(response_headers), nullptr));
+        return Error::from_string_literal("Compressed cache bodies cannot be mapped");
+    }
+
     CacheEntryBodyFile body_file;
     TRY(flush_impl(move(request_headers), move(response_headers), &body_file));
     return body_file;
@@ -221,6 +246,20 @@ ErrorOr<void> CacheEntryWriter::flush_impl(NonnullRefPtr<HeaderList> request_hea
         remove_incomplete_temporary_file();
     };
 
+    if (m_compressor) {
+        auto result = [&]() -> ErrorOr<void> {
+            TRY(m_compressor->finish());
+            m_cache_footer.data_size = TRY(m_file->tell()) - m_data_offset;
+            return {};
+        }();
+        m_compressor.clear();
+
+        if (result.is_error()) {
+            dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mUnable to compress cache entry for\033[0m {}: {}", m_url, result.error());
+            return result.release_error();
+        }
+    }
+
     m_cache_footer.header_hash = m_cache_header.hash();
 
     if (auto result = m_file->write_value(m_cache_footer); result.is_error()) {
@@ -338,6 +377,8 @@ CacheEntryReader::CacheEntryReader(DiskCache& disk_cache, CacheIndex& index, u64
 {
 }
 
+CacheEntryReader::~CacheEntryReader() = default;
+
 void CacheEntryReader::revalidation_succeeded(HeaderList const& response_headers)
 {
     dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[34;1mCache revalidation succeeded for\033[0m {}", m_url);
@@ -373,12 +414,36 @@ void CacheEntryReader::send_to(int socket_fd, Function<void(u64)> on_complete, F
     m_socket_write_notifier = Core::Notifier::construct(m_socket_fd, Core::NotificationType::Write);
     m_socket_write_notifier->set_enabled(false);
 
+    if (is_body_compressed()) {
+        auto decompressor = [&]() -> ErrorOr<NonnullOwnPtr<Compress::DeflateDecompressor>> {
+            static constexpr size_t DECOMPRESSED_CHUNK_SIZE = 64 * KiB;
+            m_decompressed_data = TRY(ByteBuffer::create_uninitialized(DECOMPRESSED_CHUNK_SIZE));
+
+            TRY(m_file->seek(m_data_offset, SeekMode::SetPosition));
+            auto compressed_body = TRY(try_make<ConstrainedStream>(MaybeOwned<Stream> { *m_file }, m_data_size));
+            return Compress::DeflateDecompressor::create(move(compressed_body));
+        }();
+
+        if (decompressor.is_error()) {
+            send_error(decompressor.release_error());
+            return;
+        }
+        m_decompressor = decompressor.release_value();
+    }
+
     m_socket_write_notifier->on_activation = [this]() {
         m_socket_write_notifier->set_enabled(false);
-        send_without_blocking();
+
+        if (m_decompressor)
+            send_decompressed_without_blocking();
+        else
+            send_without_blocking();
     };
 
-    send_without_blocking();
+    if (m_decompressor)
+        send_decompressed_without_blocking();
+    else
+        send_without_blocking();
 }
 
 ErrorOr<CacheEntryBodyFile> CacheEntryReader::take_body_file()
@@ -387,6 +452,8 @@ ErrorOr<CacheEntryBodyFile> CacheEntryReader::take_body_file()
 
     if (m_marked_for_deletion)
         return Error::from_string_literal("Cache entry has been deleted");
+    if (is_body_compressed())
+        return Error::from_string_literal("Compressed cache bodies cannot be mapped");
 
     if (auto result = read_and_validate_footer(); result.is_error()) {
         dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mError validating cache entry for\033[0m {}: {}", m_url, result.error());
@@ -432,6 +499,46 @@ void CacheEntryReader::send_without_blocking()
     send_without_blocking();
 }
 
+void CacheEntryReader::send_decompressed_without_blocking()
+{
+    while (true) {
+        if (m_marked_for_deletion) {
+            send_error(Error::from_string_literal("Cache entry has been deleted"));
+            return;
+        }
+
+        if (m_unsent_decompressed_data.is_empty()) {
+            if (m_decompressor->is_eof()) {
+                send_complete();
+                return;
+            }
+
+            auto decompressed = m_decompressor->read_some(m_decompressed_data.bytes());
+            if (decompressed.is_error()) {
+                send_error(decompressed.release_error());
+                return;
+            }
+
+            m_unsent_decompressed_data = decompressed.value();
+            continue;
+        }
+
+        auto result = Core::System::write(m_socket_fd, m_unsent_decompressed_data);
+
+        if (result.is_error()) {
+            if (result.error().code() != EAGAIN && result.error().code() != EWOULDBLOCK)
+                send_error(result.release_error());
+            else
+                m_socket_write_notifier->set_enabled(true);
+
+            return;
+        }
+
+        m_bytes_sent += result.value();
+        m_unsent_decompressed_data = m_unsent_decompressed_data.slice(result.value());
+    }
+}
+
 void CacheEntryReader::send_complete()
 {
     if (auto result = read_and_validate_footer(); result.is_error()) {
@@ -6,12 +6,14 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/Error.h>
 #include <AK/LexicalPath.h>
 #include <AK/Optional.h>
 #include <AK/String.h>
 #include <AK/Time.h>
 #include <AK/Types.h>
+#include <LibCompress/Forward.h>
 #include <LibCore/File.h>
 #include <LibCore/Notifier.h>
 #include <LibHTTP/Cache/Version.h>
@@ -20,6 +22,12 @@
 
 namespace HTTP {
 
+// How a response body is stored on disk. The body handed to clients is always the response body as received.
+enum class CacheBodyEncoding : u32 {
+    Identity,
+    Deflate,
+};
+
 struct CacheHeader {
     static ErrorOr<CacheHeader> read_from_stream(Stream&);
     ErrorOr<void> write_to_stream(Stream&) const;
@@ -39,6 +47,8 @@ struct CacheHeader {
     u32 status_code { 0 };
     u32 reason_phrase_size { 0 };
     u32 reason_phrase_hash { 0 };
+
+    CacheBodyEncoding body_encoding { CacheBodyEncoding::Identity };
 };
 
 struct CacheFooter {
@@ -68,6 +78,9 @@ public:
     u64 vary_key() const { return m_vary_key; }
     u64 body_size() const { return m_cache_footer.data_size; }
 
+    // Compressed bodies can only be streamed to clients, as the bytes on disk are not the response body
+    bool is_body_compressed() const { return m_cache_header.body_encoding != CacheBodyEncoding::Identity; }
+
     void remove();
 
     void mark_for_deletion(Badge<DiskCache>) { m_marked_for_deletion = true; }
@@ -95,7 +108,7 @@ protected:
 class CacheEntryWriter final : public CacheEntry {
 public:
     static ErrorOr<NonnullOwnPtr<CacheEntryWriter>> create(DiskCache&, CacheIndex&, u64 cache_key, String url, UnixDateTime request_time, AK::Duration current_time_offset_for_testing);
-    virtual ~CacheEntryWriter() override = default;
+    virtual ~CacheEntryWriter() override;
 
     ErrorOr<void> write_status_and_reason(u32 status_code, Optional<String> reason_phrase, HeaderList const& request_headers, HeaderList const& response_headers);
     ErrorOr<void> write_data(ReadonlyBytes);
@@ -110,6 +123,7 @@ private:
     void remove_incomplete_temporary_file();
 
     OwnPtr<Core::OutputBufferedFile> m_file;
+    OwnPtr<Compress::DeflateCompressor> m_compressor;
     Optional<LexicalPath> m_temporary_path;
     u64 m_data_offset { 0 };
 
@@ -122,7 +136,7 @@ private:
 class CacheEntryReader final : public CacheEntry {
 public:
     static ErrorOr<NonnullOwnPtr<CacheEntryReader>> create(DiskCache&, CacheIndex&, u64 cache_key, u64 vary_key, NonnullRefPtr<HeaderList>, u64 data_size);
-    virtual ~CacheEntryReader() override = default;
+    virtual ~CacheEntryReader() override;
 
     enum class RevalidationType {
         None,
@@ -132,6 +146,10 @@ public:
     RevalidationType revalidation_type() const { return m_revalidation_type; }
     void set_revalidation_type(RevalidationType revalidation_type) { m_revalidation_type = revalidation_type; }
 
+    // Whether the entry may still be served if its revalidation fails with an error (RFC 5861, stale-if-error)
+    bool may_serve_stale_on_error() const { return m_may_serve_stale_on_error; }
+    void set_may_serve_stale_on_error(bool may_serve_stale_on_error) { m_may_serve_stale_on_error = may_serve_stale_on_error; }
+
     void revalidation_succeeded(HeaderList const&);
     void revalidation_failed();
 
@@ -150,6 +168,7 @@ private:
     CacheEntryReader(DiskCache&, CacheIndex&, u64 cache_key, u64 vary_key, String url, LexicalPath, NonnullOwnPtr<Core::File>, int fd, CacheHeader, Optional<String> reason_phrase, NonnullRefPtr<HeaderList>, u64 data_offset, u64 data_size);
 
     void send_without_blocking();
+    void send_decompressed_without_blocking();
     void send_complete();
     void send_error(Error);
 
@@ -165,10 +184,16 @@ private:
     Function<void(u64)> m_on_send_error;
     u64 m_bytes_sent { 0 };
 
+    // For compressed bodies, the decompressed bytes not yet accepted by the socket
+    OwnPtr<Compress::DeflateDecompressor> m_decompressor;
+    ByteBuffer m_decompressed_data;
+    ReadonlyBytes m_unsent_decompressed_data;
+
     Optional<String> m_reason_phrase;
     NonnullRefPtr<HeaderList> m_response_headers;
 
     RevalidationType m_revalidation_type { RevalidationType::None };
+    bool m_may_serve_stale_on_error { false };
 
     u64 const m_data_offset { 0 };
     u64 const m_data_size { 0 };
@@ -5,9 +5,13 @@
  */
 
 #include <AK/Debug.h>
+#include <AK/HashTable.h>
+#include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/Directory.h>
+#include <LibCore/File.h>
 #include <LibFileSystem/FileSystem.h>
+#include <LibHTTP/Cache/CacheEntry.h>
 #include <LibHTTP/Cache/CacheIndex.h>
 #include <LibHTTP/Cache/Utilities.h>
 #include <LibHTTP/Cache/Version.h>
@@ -15,6 +19,11 @@
 namespace HTTP {
 
 static constexpr u32 CACHE_METADATA_KEY = 12389u;
+static constexpr u32 CLEAN_SHUTDOWN_METADATA_KEY = 12390u;
+
+// Sizes of CacheHeader and CacheFooter as written to disk
+static constexpr u64 SERIALIZED_CACHE_HEADER_SIZE = 9 * sizeof(u32);
+static constexpr u64 SERIALIZED_CACHE_FOOTER_SIZE = sizeof(u64) + sizeof(u32);
 
 static ByteString serialize_headers(HeaderList const& headers)
 {
@@ -109,14 +118,22 @@ ErrorOr<CacheIndex> CacheIndex::create(Database::Database& database, LexicalPath
     )#"sv));
     database.execute_statement(create_cache_metadata_table, {});
 
-    auto read_cache_version = TRY(database.prepare_statement("SELECT version FROM CacheMetadata WHERE metadata_key = ?;"sv));
+    auto read_metadata = TRY(database.prepare_statement("SELECT version FROM CacheMetadata WHERE metadata_key = ?;"sv));
+    auto set_metadata = TRY(database.prepare_statement("INSERT OR REPLACE INTO CacheMetadata VALUES (?, ?);"sv));
     auto cache_version = 0u;
 
     database.execute_statement(
-        read_cache_version,
+        read_metadata,
         [&](auto statement_id) { cache_version = database.result_column<u32>(statement_id, 0); },
         CACHE_METADATA_KEY);
 
+    // An index that has never been opened has nothing to recover.
+    auto closed_cleanly = true;
+    database.execute_statement(
+        read_metadata,
+        [&](auto statement_id) { closed_cleanly = database.result_column<u32>(statement_id, 0) != 0; },
+        CLEAN_SHUTDOWN_METADATA_KEY);
+
     if (cache_version != CACHE_VERSION) {
         if (cache_version != 0)
             dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[31;1mDisk cache version mismatch:\033[0m stored version = {}, new version = {}", cache_version, CACHE_VERSION);
@@ -125,12 +142,13 @@ ErrorOr<CacheIndex> CacheIndex::create(Database::Database& database, LexicalPath
         auto delete_cache_index_table = TRY(database.prepare_statement("DROP TABLE IF EXISTS CacheIndex;"sv));
         database.execute_statement(delete_cache_index_table, {});
 
-        auto set_cache_version = TRY(database.prepare_statement("INSERT OR REPLACE INTO CacheMetadata VALUES (?, ?);"sv));
-        database.execute_statement(set_cache_version, {}, CACHE_METADATA_KEY, CACHE_VERSION);
+        database.execute_statement(set_metadata, {}, CACHE_METADATA_KEY, CACHE_VERSION);
 
         for_each_cache_entry_file(database, [&](LexicalPath const& cache_entry) {
             (void)FileSystem::remove(cache_entry.string(), FileSystem::RecursionMode::Disallowed);
         });
+
+        closed_cleanly = true;
     }
 
     auto create_cache_index_table = TRY(database.prepare_statement(R"#(
@@ -156,50 +174,49 @@ ErrorOr<CacheIndex> CacheIndex::create(Database::Database& database, LexicalPath
 
     Statements statements {};
     statements.insert_entry = TRY(database.prepare_statement("INSERT OR REPLACE INTO CacheIndex VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?);"sv));
-    statements.remove_entry = TRY(database.prepare_statement(R"#(
-        DELETE FROM CacheIndex
-        WHERE cache_key = ? AND vary_key = ?
-        RETURNING data_size + associated_data_size + OCTET_LENGTH(request_headers) + OCTET_LENGTH(response_headers);
-    )#"sv));
-    statements.remove_entries_accessed_since = TRY(database.prepare_statement(R"#(
-        DELETE FROM CacheIndex
-        WHERE last_access_time >= ?
-        RETURNING cache_key, vary_key, data_size + associated_data_size + OCTET_LENGTH(request_headers) + OCTET_LENGTH(response_headers);
-    )#"sv));
-    statements.select_entries = TRY(database.prepare_statement("SELECT * FROM CacheIndex WHERE cache_key = ?;"sv));
-    statements.update_response_headers = TRY(database.prepare_statement("UPDATE CacheIndex SET response_headers = ? WHERE cache_key = ? AND vary_key = ?;"sv));
-    statements.update_associated_data_size = TRY(database.prepare_statement("UPDATE CacheIndex SET associated_data_size = ? WHERE cache_key = ? AND vary_key = ?;"sv));
+    statements.remove_entry = TRY(database.prepare_statement("DELETE FROM CacheIndex WHERE cache_key = ? AND vary_key = ?;"sv));
     statements.update_last_access_time = TRY(database.prepare_statement("UPDATE CacheIndex SET last_access_time = ? WHERE cache_key = ? AND vary_key = ?;"sv));
+    statements.begin_transaction = TRY(database.prepare_statement("BEGIN TRANSACTION;"sv));
+    statements.commit_transaction = TRY(database.prepare_statement("COMMIT;"sv));
+    statements.set_metadata = set_metadata;
 
-    statements.remove_entries_exceeding_cache_limit = TRY(database.prepare_statement(R"#(
-        WITH RankedCacheIndex AS (
-            SELECT
-                cache_key,
-                vary_key,
-                SUM(data_size + associated_data_size + OCTET_LENGTH(request_headers) + OCTET_LENGTH(response_headers))
-                    OVER (ORDER BY last_access_time DESC)
-                    AS cumulative_estimated_size
-            FROM CacheIndex
-        )
-        DELETE FROM CacheIndex
-        WHERE (cache_key, vary_key) IN (
-            SELECT cache_key, vary_key
-            FROM RankedCacheIndex
-            WHERE cumulative_estimated_size > ?
-        )
-        RETURNING cache_key, vary_key, data_size + associated_data_size + OCTET_LENGTH(request_headers) + OCTET_LENGTH(response_headers);
-    )#"sv));
+    auto select_all_entries = TRY(database.prepare_statement("SELECT * FROM CacheIndex;"sv));
 
-    statements.estimate_cache_size_accessed_since = TRY(database.prepare_statement(R"#(
-        SELECT COALESCE(SUM(data_size + associated_data_size + OCTET_LENGTH(request_headers) + OCTET_LENGTH(response_headers)), 0)
-        FROM CacheIndex
-        WHERE last_access_time >= ?;
-    )#"sv));
+    HashMap<u64, Vector<Entry>, IdentityHashTraits<u64>> entries;
 
-    statements.select_total_estimated_size = TRY(database.prepare_statement(R"#(
-        SELECT COALESCE(SUM(data_size + associated_data_size + OCTET_LENGTH(request_headers) + OCTET_LENGTH(response_headers)), 0)
-        FROM CacheIndex;
-    )#"sv));
+    database.execute_statement(
+        select_all_entries,
+        [&](auto statement_id) {
+            int column = 0;
+
+            auto cache_key = database.result_column<u64>(statement_id, column++);
+            auto vary_key = database.result_column<u64>(statement_id, column++);
+            auto url = database.result_column<String>(statement_id, column++);
+            auto request_headers = database.result_column<ByteString>(statement_id, column++);
+            auto response_headers = database.result_column<ByteString>(statement_id, column++);
+            auto data_size = database.result_column<u64>(statement_id, column++);
+            auto associated_data_size = database.result_column<u64>(statement_id, column++);
+            auto request_time = database.result_column<UnixDateTime>(statement_id, column++);
+            auto response_time = database.result_column<UnixDateTime>(statement_id, column++);
+            auto last_access_time = database.result_column<UnixDateTime>(statement_id, column++);
+
+            entries.ensure(cache_key).empend(vary_key, move(url), deserialize_headers(request_headers), deserialize_headers(response_headers), data_size, associated_data_size, request_headers.length(), response_headers.length(), request_time, response_time, last_access_time);
+        });
+
+    // A memory-backed index has no cache files, and does not outlive the process that flushes it.
+    if (!closed_cleanly && database.database_path().has_value()) {
+        dbgln("\033[36m[disk]\033[0m \033[33;1mCache index was not closed cleanly, checking it against the cache files\033[0m");
+        reconcile_with_cache_files(database, statements, entries);
+    }
+
+    // Until the index is closed, a crash leaves the database and the cache files to be reconciled.
+    database.execute_statement(set_metadata, {}, CLEAN_SHUTDOWN_METADATA_KEY, 0u);
+
+    u64 total_estimated_size { 0 };
+    for (auto const& it : entries) {
+        for (auto const& entry : it.value)
+            total_estimated_size += entry.estimated_size();
+    }
 
     auto disk_space = TRY(FileSystem::compute_disk_space(cache_directory));
     auto maximum_disk_cache_size = compute_maximum_disk_cache_size(disk_space.free_bytes);
@@ -210,22 +227,201 @@ ErrorOr<CacheIndex> CacheIndex::create(Database::Database& database, LexicalPath
         .maximum_disk_cache_entry_size = compute_maximum_disk_cache_entry_size(maximum_disk_cache_size),
     };
 
-    u64 total_estimated_size { 0 };
-    database.execute_statement(
-        statements.select_total_estimated_size,
-        [&](auto statement_id) { total_estimated_size = database.result_column<u64>(statement_id, 0); });
+    return CacheIndex { database, statements, limits, move(entries), total_estimated_size };
+}
+
+static ErrorOr<void> validate_cache_file(LexicalPath const& path, u64 cache_key, size_t url_size, u64 data_size)
+{
+    auto file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Read));
+
+    auto header = TRY(file->read_value<CacheHeader>());
+    if (header.magic != CacheHeader::CACHE_MAGIC || header.version != CACHE_VERSION)
+        return Error::from_string_literal("Invalid cache header");
+    if (header.key_hash != u64_hash(cache_key) || header.url_size != url_size)
+        return Error::from_string_literal("Cache header does not match the index");
+
+    auto data_offset = SERIALIZED_CACHE_HEADER_SIZE + header.url_size + header.reason_phrase_size;
+    if (TRY(file->size()) != data_offset + data_size + SERIALIZED_CACHE_FOOTER_SIZE)
+        return Error::from_string_literal("Cache file has the wrong size");
 
-    return CacheIndex { database, statements, limits, total_estimated_size };
+    TRY(file->seek(data_offset + data_size, SeekMode::SetPosition));
+    auto footer = TRY(file->read_value<CacheFooter>());
+    if (footer.data_size != data_size || footer.header_hash != header.hash())
+        return Error::from_string_literal("Invalid cache footer");
+
+    return {};
 }
 
-CacheIndex::CacheIndex(Database::Database& database, Statements statements, Limits limits, u64 total_estimated_size)
+void CacheIndex::reconcile_with_cache_files(Database::Database& database, Statements const& statements, HashMap<u64, Vector<Entry>, IdentityHashTraits<u64>>& entries)
+{
+    struct CacheFile {
+        LexicalPath path;
+        CacheEntryData data;
+    };
+    Vector<CacheFile> cache_files;
+
+    for_each_cache_entry_file(database, [&](LexicalPath const& path) {
+        if (auto data = cache_entry_data_for_file(path); data.has_value())
+            cache_files.append({ path, *data });
+    });
+
+    // An entry survives if its body file is intact and matches its row. Entries without a body (synthetic entries that
+    // only hold associated data) survive as they are.
+    HashTable<EntryKey, EntryKeyTraits> entries_with_valid_files;
+    HashTable<EntryKey, EntryKeyTraits> entries_with_invalid_files;
+
+    for (auto const& cache_file : cache_files) {
+        if (cache_file.data.associated_data.has_value())
+            continue;
+
+        EntryKey key { cache_file.data.cache_key, cache_file.data.vary_key };
+
+        auto entries_for_key = entries.get(key.cache_key);
+        if (!entries_for_key.has_value())
+            continue;
+
+        auto entry = find_value(*entries_for_key, [&](auto const& entry) { return entry.vary_key == key.vary_key; });
+        if (!entry.has_value())
+            continue;
+
+        if (auto result = validate_cache_file(cache_file.path, key.cache_key, entry->url.byte_count(), entry->data_size); result.is_error()) {
+            dbgln("\033[36m[disk]\033[0m \033[31;1mRemoving damaged cache file\033[0m {}: {}", cache_file.path, result.error());
+            entries_with_invalid_files.set(key);
+        } else {
+            entries_with_valid_files.set(key);
+        }
+    }
+
+    database.execute_statement(statements.begin_transaction, {});
+
+    size_t removed_entries = 0;
+    entries.remove_all_matching([&](u64 cache_key, Vector<Entry>& entries_for_key) {
+        entries_for_key.remove_all_matching([&](Entry const& entry) {
+            EntryKey key { cache_key, entry.vary_key };
+
+            if (entries_with_valid_files.contains(key))
+                return false;
+            if (entry.data_size == 0 && !entries_with_invalid_files.contains(key))
+                return false;
+
+            database.execute_statement(statements.remove_entry, {}, cache_key, entry.vary_key);
+            ++removed_entries;
+            return true;
+        });
+
+        return entries_for_key.is_empty();
+    });
+
+    database.execute_statement(statements.commit_transaction, {});
+
+    // Whatever is left without an entry was written after the last flush, or belonged to an entry that was just removed.
+    size_t removed_files = 0;
+    for (auto const& cache_file : cache_files) {
+        auto entries_for_key = entries.get(cache_file.data.cache_key);
+        if (entries_for_key.has_value() && entries_for_key->contains([&](auto const& entry) { return entry.vary_key == cache_file.data.vary_key; }))
+            continue;
+
+        (void)FileSystem::remove(cache_file.path.string(), FileSystem::RecursionMode::Disallowed);
+        ++removed_files;
+    }
+
+    dbgln("\033[36m[disk]\033[0m Cache index recovery removed {} entries and {} files", removed_entries, removed_files);
+}
+
+CacheIndex::CacheIndex(Database::Database& database, Statements statements, Limits limits, HashMap<u64, Vector<Entry>, IdentityHashTraits<u64>> entries, u64 total_estimated_size)
     : m_database(database)
     , m_statements(statements)
+    , m_entries(move(entries))
     , m_limits(limits)
     , m_total_estimated_size(total_estimated_size)
 {
 }
 
+CacheIndex::CacheIndex(CacheIndex&& other)
+    : m_database(other.m_database)
+    , m_statements(other.m_statements)
+    , m_entries(move(other.m_entries))
+    , m_pending_writes(move(other.m_pending_writes))
+    , m_limits(other.m_limits)
+    , m_total_estimated_size(other.m_total_estimated_size)
+    , m_is_open(exchange(other.m_is_open, false))
+{
+}
+
+CacheIndex& CacheIndex::operator=(CacheIndex&& other)
+{
+    if (this != &other) {
+        close();
+
+        m_database = other.m_database;
+        m_statements = other.m_statements;
+        m_entries = move(other.m_entries);
+        m_pending_writes = move(other.m_pending_writes);
+        m_limits = other.m_limits;
+        m_total_estimated_size = other.m_total_estimated_size;
+        m_is_open = exchange(other.m_is_open, false);
+    }
+
+    return *this;
+}
+
+CacheIndex::~CacheIndex()
+{
+    close();
+}
+
+void CacheIndex::close()
+{
+    if (!m_is_open)
+        return;
+
+    flush_pending_writes();
+    m_database->execute_statement(m_statements.set_metadata, {}, CLEAN_SHUTDOWN_METADATA_KEY, 1u);
+    m_is_open = false;
+}
+
+void CacheIndex::mark_pending_write(u64 cache_key, u64 vary_key, PendingWrite pending_write)
+{
+    auto& existing_write = m_pending_writes.ensure({ cache_key, vary_key }, [&] { return pending_write; });
+    if (pending_write == PendingWrite::Row)
+        existing_write = PendingWrite::Row;
+
+    if (m_pending_writes.size() >= MAXIMUM_PENDING_WRITES)
+        flush_pending_writes();
+}
+
+void CacheIndex::flush_pending_writes()
+{
+    if (m_pending_writes.is_empty())
+        return;
+
+    dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[34;1mFlushing cache index\033[0m ({} changes)", m_pending_writes.size());
+
+    m_database->execute_statement(m_statements.begin_transaction, {});
+
+    for (auto const& [key, pending_write] : m_pending_writes) {
+        auto entry = get_entry(key.cache_key, key.vary_key);
+
+        if (!entry.has_value()) {
+            m_database->execute_statement(m_statements.remove_entry, {}, key.cache_key, key.vary_key);
+            continue;
+        }
+
+        if (pending_write == PendingWrite::LastAccessTime) {
+            m_database->execute_statement(m_statements.update_last_access_time, {}, entry->last_access_time, key.cache_key, key.vary_key);
+            continue;
+        }
+
+        auto serialized_request_headers = serialize_headers(entry->request_headers);
+        auto serialized_response_headers = serialize_headers(entry->response_headers);
+
+        m_database->execute_statement(m_statements.insert_entry, {}, key.cache_key, key.vary_key, entry->url, serialized_request_headers, serialized_response_headers, entry->data_size, entry->associated_data_size, entry->request_time, entry->response_time, entry->last_access_time);
+    }
+
+    m_database->execute_statement(m_statements.commit_transaction, {});
+    m_pending_writes.clear();
+}
+
 ErrorOr<void> CacheIndex::create_entry(u64 cache_key, u64 vary_key, String url, NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, u64 data_size, UnixDateTime request_time, UnixDateTime response_time)
 {
     auto now = UnixDateTime::now();
@@ -260,44 +456,53 @@ ErrorOr<void> CacheIndex::create_entry(u64 cache_key, u64 vary_key, String url,
     if (entry_size > m_limits.maximum_disk_cache_entry_size)
         return Error::from_string_literal("Cache entry size exceeds allowed maximum");
 
-    m_database->execute_statement(
-        m_statements.remove_entry,
-        [&](auto statement_id) {
-            auto removed_size = m_database->result_column<u64>(statement_id, 0);
-            m_total_estimated_size -= removed_size;
-        },
-        cache_key,
-        vary_key);
-
     auto& entries = m_entries.ensure(cache_key);
     auto existing_entry_index = entries.find_first_index_if([&](auto const& existing_entry) {
         return existing_entry.vary_key == vary_key;
     });
 
-    m_database->execute_statement(m_statements.insert_entry, {}, cache_key, vary_key, entry.url, serialized_request_headers, serialized_response_headers, entry.data_size, entry.associated_data_size, entry.request_time, entry.response_time, entry.last_access_time);
-
-    if (existing_entry_index.has_value())
+    if (existing_entry_index.has_value()) {
+        m_total_estimated_size -= entries[*existing_entry_index].estimated_size();
         entries[*existing_entry_index] = move(entry);
-    else
+    } else {
         entries.append(move(entry));
+    }
 
     m_total_estimated_size += entry_size;
+    mark_pending_write(cache_key, vary_key, PendingWrite::Row);
 
     return {};
 }
 
 void CacheIndex::remove_entry(u64 cache_key, u64 vary_key)
 {
-    m_database->execute_statement(
-        m_statements.remove_entry,
-        [&](auto statement_id) {
-            auto removed_size = m_database->result_column<u64>(statement_id, 0);
-            m_total_estimated_size -= removed_size;
-        },
-        cache_key,
-        vary_key);
+    auto entry = get_entry(cache_key, vary_key);
+    if (!entry.has_value())
+        return;
 
+    m_total_estimated_size -= entry->estimated_size();
     delete_entry(cache_key, vary_key);
+    mark_pending_write(cache_key, vary_key, PendingWrite::Row);
+}
+
+template<typename Predicate>
+void CacheIndex::remove_entries_matching(Predicate&& predicate, Function<void(u64 cache_key, u64 vary_key)> const& on_entry_removed)
+{
+    Vector<EntryKey> removed_entries;
+
+    for (auto const& it : m_entries) {
+        for (auto const& entry : it.value) {
+            if (predicate(it.key, entry))
+                removed_entries.append({ it.key, entry.vary_key });
+        }
+    }
+
+    for (auto const& [cache_key, vary_key] : removed_entries) {
+        remove_entry(cache_key, vary_key);
+
+        if (on_entry_removed)
+            on_entry_removed(cache_key, vary_key);
+    }
 }
 
 void CacheIndex::remove_entries_exceeding_cache_limit(Function<void(u64 cache_key, u64 vary_key)> on_entry_removed)
@@ -305,36 +510,37 @@ void CacheIndex::remove_entries_exceeding_cache_limit(Function<void(u64 cache_ke
     if (m_total_estimated_size <= m_limits.maximum_disk_cache_size)
         return;
 
-    m_database->execute_statement(
-        m_statements.remove_entries_exceeding_cache_limit,
-        [&](auto statement_id) {
-            auto cache_key = m_database->result_column<u64>(statement_id, 0);
-            auto vary_key = m_database->result_column<u64>(statement_id, 1);
-            auto removed_size = m_database->result_column<u64>(statement_id, 2);
-            m_total_estimated_size -= removed_size;
-            delete_entry(cache_key, vary_key);
-
-            if (on_entry_removed)
-                on_entry_removed(cache_key, vary_key);
-        },
-        m_limits.maximum_disk_cache_size);
+    // Keep the most recently accessed entries that fit in the limit, and remove everything from the first one that
+    // does not fit onwards.
+    struct RankedEntry {
+        UnixDateTime last_access_time;
+        EntryKey key;
+        u64 estimated_size { 0 };
+    };
+    Vector<RankedEntry> ranked_entries;
+
+    for (auto const& it : m_entries) {
+        for (auto const& entry : it.value)
+            ranked_entries.append({ entry.last_access_time, { it.key, entry.vary_key }, entry.estimated_size() });
+    }
+
+    quick_sort(ranked_entries, [](auto const& lhs, auto const& rhs) { return lhs.last_access_time > rhs.last_access_time; });
+
+    HashTable<EntryKey, EntryKeyTraits> entries_to_remove;
+    u64 cumulative_estimated_size = 0;
+
+    for (auto const& ranked_entry : ranked_entries) {
+        cumulative_estimated_size += ranked_entry.estimated_size;
+        if (cumulative_estimated_size > m_limits.maximum_disk_cache_size)
+            entries_to_remove.set(ranked_entry.key);
+    }
+
+    remove_entries_matching([&](u64 cache_key, Entry const& entry) { return entries_to_remove.contains({ cache_key, entry.vary_key }); }, on_entry_removed);
 }
 
 void CacheIndex::remove_entries_accessed_since(UnixDateTime since, Function<void(u64 cache_key, u64 vary_key)> on_entry_removed)
 {
-    m_database->execute_statement(
-        m_statements.remove_entries_accessed_since,
-        [&](auto statement_id) {
-            auto cache_key = m_database->result_column<u64>(statement_id, 0);
-            auto vary_key = m_database->result_column<u64>(statement_id, 1);
-            auto removed_size = m_database->result_column<u64>(statement_id, 2);
-            m_total_estimated_size -= removed_size;
-            delete_entry(cache_key, vary_key);
-
-            if (on_entry_removed)
-                on_entry_removed(cache_key, vary_key);
-        },
-        since);
+    remove_entries_matching([&](u64, Entry const& entry) { return entry.last_access_time >= since; }, on_entry_removed);
 }
 
 void CacheIndex::update_response_headers(u64 cache_key, u64 vary_key, NonnullRefPtr<HeaderList> response_headers)
@@ -343,15 +549,14 @@ void CacheIndex::update_response_headers(u64 cache_key, u64 vary_key, NonnullRef
     if (!entry.has_value())
         return;
 
-    auto serialized_response_headers = serialize_headers(response_headers);
-    auto serialized_response_headers_size = static_cast<u64>(serialized_response_headers.length());
-
-    m_database->execute_statement(m_statements.update_response_headers, {}, serialized_response_headers, cache_key, vary_key);
+    auto serialized_response_headers_size = static_cast<u64>(serialize_headers(response_headers).length());
 
     m_total_estimated_size -= entry->serialized_response_headers_size;
     m_total_estimated_size += serialized_response_headers_size;
     entry->response_headers = move(response_headers);
     entry->serialized_response_headers_size = serialized_response_headers_size;
+
+    mark_pending_write(cache_key, vary_key, PendingWrite::Row);
 }
 
 void CacheIndex::update_associated_data_size(u64 cache_key, u64 vary_key, u64 associated_data_size)
@@ -360,11 +565,11 @@ void CacheIndex::update_associated_data_size(u64 cache_key, u64 vary_key, u64 as
     if (!entry.has_value())
         return;
 
-    m_database->execute_statement(m_statements.update_associated_data_size, {}, associated_data_size, cache_key, vary_key);
-
     m_total_estimated_size -= entry->associated_data_size;
     m_total_estimated_size += associated_data_size;
     entry->associated_data_size = associated_data_size;
+
+    mark_pending_write(cache_key, vary_key, PendingWrite::Row);
 }
 
 void CacheIndex::update_last_access_time(u64 cache_key, u64 vary_key)
@@ -373,40 +578,17 @@ void CacheIndex::update_last_access_time(u64 cache_key, u64 vary_key)
     if (!entry.has_value())
         return;
 
-    auto now = UnixDateTime::now();
-
-    m_database->execute_statement(m_statements.update_last_access_time, {}, now, cache_key, vary_key);
-    entry->last_access_time = now;
+    entry->last_access_time = UnixDateTime::now();
+    mark_pending_write(cache_key, vary_key, PendingWrite::LastAccessTime);
 }
 
 Optional<CacheIndex::Entry const&> CacheIndex::find_entry(u64 cache_key, HeaderList const& request_headers)
 {
-    auto& entries = m_entries.ensure(cache_key, [&]() {
-        Vector<Entry> entries;
-
-        m_database->execute_statement(
-            m_statements.select_entries,
-            [&](auto statement_id) {
-                int column = 1; // Skip the cache_key column.
-
-                auto vary_key = m_database->result_column<u64>(statement_id, column++);
-                auto url = m_database->result_column<String>(statement_id, column++);
-                auto request_headers = m_database->result_column<ByteString>(statement_id, column++);
-                auto response_headers = m_database->result_column<ByteString>(statement_id, column++);
-                auto data_size = m_database->result_column<u64>(statement_id, column++);
-                auto associated_data_size = m_database->result_column<u64>(statement_id, column++);
-                auto request_time = m_database->result_column<UnixDateTime>(statement_id, column++);
-                auto response_time = m_database->result_column<UnixDateTime>(statement_id, column++);
-                auto last_access_time = m_database->result_column<UnixDateTime>(statement_id, column++);
-
-                entries.empend(vary_key, move(url), deserialize_headers(request_headers), deserialize_headers(response_headers), data_size, associated_data_size, request_headers.length(), response_headers.length(), request_time, response_time, last_access_time);
-            },
-            cache_key);
-
-        return entries;
-    });
+    auto entries = m_entries.get(cache_key);
+    if (!entries.has_value())
+        return {};
 
-    return find_value(entries, [&](auto const& entry) {
+    return find_value(*entries, [&](auto const& entry) {
         return create_vary_key(request_headers, entry.response_headers) == entry.vary_key;
     });
 }
@@ -440,16 +622,14 @@ void CacheIndex::delete_entry(u64 cache_key, u64 vary_key)
 Requests::CacheSizes CacheIndex::estimate_cache_size_accessed_since(UnixDateTime since)
 {
     Requests::CacheSizes sizes;
+    sizes.total = m_total_estimated_size;
 
-    m_database->execute_statement(
-        m_statements.estimate_cache_size_accessed_since,
-        [&](auto statement_id) { sizes.since_requested_time = m_database->result_column<u64>(statement_id, 0); },
-        since);
-
-    m_database->execute_statement(
-        m_statements.estimate_cache_size_accessed_since,
-        [&](auto statement_id) { sizes.total = m_database->result_column<u64>(statement_id, 0); },
-        UnixDateTime::earliest());
+    for (auto const& it : m_entries) {
+        for (auto const& entry : it.value) {
+            if (entry.last_access_time >= since)
+                sizes.since_requested_time += entry.estimated_size();
+        }
+    }
 
     return sizes;
 }
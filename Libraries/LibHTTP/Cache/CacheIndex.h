@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Error.h>
+#include <AK/HashFunctions.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullRawPtr.h>
 #include <AK/Time.h>
@@ -19,6 +20,16 @@ namespace HTTP {
 
 // The cache index is a SQL database containing metadata about each cache entry. An entry in the index is created once
 // the entire cache entry has been successfully written to disk.
+//
+// The whole index is loaded into memory when it is created, and the in-memory copy is authoritative: lookups, size
+// estimates and eviction never touch the database. Changes are written behind in batches, with each batch in a single
+// transaction, so a busy cache does not sync the database on every hit. Entries are changed in place, so however often
+// an entry is accessed between flushes, it is written once.
+//
+// If the process dies before a batch is flushed, the database can disagree with the cache files on disk. The next
+// index to open the database notices that it was not closed cleanly and reconciles the two, checking each indexed
+// entry's CacheHeader and CacheFooter against its row. Files without a row cannot be rebuilt, as the headers needed to
+// serve them only live in the index, so they are removed.
 class CacheIndex {
     struct Entry {
         u64 vary_key { 0 };
@@ -42,8 +53,14 @@ class CacheIndex {
     };
 
 public:
+    static constexpr size_t MAXIMUM_PENDING_WRITES = 256;
+
     static ErrorOr<CacheIndex> create(Database::Database&, LexicalPath const& cache_directory);
 
+    CacheIndex(CacheIndex&&);
+    CacheIndex& operator=(CacheIndex&&);
+    ~CacheIndex();
+
     ErrorOr<void> create_entry(u64 cache_key, u64 vary_key, String url, NonnullRefPtr<HeaderList> request_headers, NonnullRefPtr<HeaderList> response_headers, u64 data_size, UnixDateTime request_time, UnixDateTime response_time);
     void remove_entry(u64 cache_key, u64 vary_key);
     void remove_entries_exceeding_cache_limit(Function<void(u64 cache_key, u64 vary_key)> on_entry_removed);
@@ -60,18 +77,34 @@ public:
 
     void set_maximum_disk_cache_size(u64 maximum_disk_cache_size);
 
+    // Writes every change made since the last flush to the database
+    void flush_pending_writes();
+    size_t pending_write_count() const { return m_pending_writes.size(); }
+
 private:
     struct Statements {
         Database::StatementID insert_entry { 0 };
         Database::StatementID remove_entry { 0 };
-        Database::StatementID remove_entries_exceeding_cache_limit { 0 };
-        Database::StatementID remove_entries_accessed_since { 0 };
-        Database::StatementID select_entries { 0 };
-        Database::StatementID update_response_headers { 0 };
-        Database::StatementID update_associated_data_size { 0 };
         Database::StatementID update_last_access_time { 0 };
-        Database::StatementID estimate_cache_size_accessed_since { 0 };
-        Database::StatementID select_total_estimated_size { 0 };
+        Database::StatementID begin_transaction { 0 };
+        Database::StatementID commit_transaction { 0 };
+        Database::StatementID set_metadata { 0 };
+    };
+
+    struct EntryKey {
+        u64 cache_key { 0 };
+        u64 vary_key { 0 };
+
+        bool operator==(EntryKey const&) const = default;
+    };
+
+    struct EntryKeyTraits : public DefaultTraits<EntryKey> {
+        static unsigned hash(EntryKey const& key) { return pair_int_hash(u64_hash(key.cache_key), u64_hash(key.vary_key)); }
+    };
+
+    enum class PendingWrite : u8 {
+        LastAccessTime, // Only the access time changed
+        Row,            // The row is written out in full, or deleted if the entry is gone
     };
 
     struct Limits {
@@ -80,18 +113,30 @@ private:
         u64 maximum_disk_cache_entry_size { 0 };
     };
 
-    CacheIndex(Database::Database&, Statements, Limits, u64 total_estimated_size);
+    CacheIndex(Database::Database&, Statements, Limits, HashMap<u64, Vector<Entry>, IdentityHashTraits<u64>>, u64 total_estimated_size);
 
     Optional<Entry&> get_entry(u64 cache_key, u64 vary_key);
     void delete_entry(u64 cache_key, u64 vary_key);
 
+    void mark_pending_write(u64 cache_key, u64 vary_key, PendingWrite);
+    void close();
+
+    static void reconcile_with_cache_files(Database::Database&, Statements const&, HashMap<u64, Vector<Entry>, IdentityHashTraits<u64>>&);
+
+    template<typename Predicate>
+    void remove_entries_matching(Predicate&&, Function<void(u64 cache_key, u64 vary_key)> const& on_entry_removed);
+
     NonnullRawPtr<Database::Database> m_database;
     Statements m_statements;
 
     HashMap<u64, Vector<Entry>, IdentityHashTraits<u64>> m_entries;
+    HashMap<EntryKey, PendingWrite, EntryKeyTraits> m_pending_writes;
 
     Limits m_limits;
     u64 m_total_estimated_size { 0 };
+
+    // False once moved from, so only one index marks the database as cleanly closed
+    bool m_is_open { true };
 };
 
 }
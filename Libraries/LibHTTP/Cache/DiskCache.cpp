@@ -62,8 +62,8 @@ ErrorOr<DiskCache> DiskCache::create(Mode mode)
     TRY(Core::Directory::create(cache_directory, Core::Directory::CreateDirectories::Yes));
 
     auto database = mode == DiskCache::Mode::Normal
-        ? TRY(Database::Database::create(cache_directory.string(), INDEX_DATABASE))
-        : TRY(Database::Database::create_memory_backed());
+        ? TRY(Database::Database::create(cache_directory.string(), INDEX_DATABASE, Database::Profile::Cache))
+        : TRY(Database::Database::create_memory_backed(Database::Profile::Cache));
 
     auto index = TRY(CacheIndex::create(database, cache_directory));
 
@@ -163,6 +163,10 @@ Variant<Optional<CacheEntryReader&>, DiskCache::CacheHasOpenEntry> DiskCache::op
 
         dbgln_if(HTTP_DISK_CACHE_DEBUG, "\033[36m[disk]\033[0m \033[36;1mMust revalidate cache entry for\033[0m {} (lifetime={}s age={}s)", url, freshness_lifetime.to_seconds(), current_age.to_seconds());
         cache_entry.value()->set_revalidation_type(CacheEntryReader::RevalidationType::MustRevalidate);
+
+        if (calculate_stale_if_error_lifetime(request_headers, response_headers, freshness_lifetime) > current_age)
+            cache_entry.value()->set_may_serve_stale_on_error(true);
+
         return {};
     };
 
@@ -64,9 +64,15 @@ public:
     void remove_entries_exceeding_cache_limit();
     void set_maximum_disk_cache_size(u64 maximum_disk_cache_size);
 
+    bool compresses_text_bodies() const { return m_compress_text_bodies; }
+    void set_compress_text_bodies(bool compress_text_bodies) { m_compress_text_bodies = compress_text_bodies; }
+
     Requests::CacheSizes estimate_cache_size_accessed_since(UnixDateTime since);
     void remove_entries_accessed_since(UnixDateTime since);
 
+    // Writes the index's batched changes to the database. Called periodically, so little is lost if the process dies.
+    void flush_index() { m_index.flush_pending_writes(); }
+
     LexicalPath const& cache_directory() const { return m_cache_directory; }
 
     void cache_entry_closed(Badge<CacheEntry>, CacheEntry const&);
@@ -96,6 +102,8 @@ private:
 
     LexicalPath m_cache_directory;
     CacheIndex m_index;
+
+    bool m_compress_text_bodies { false };
 };
 
 }
@@ -14,6 +14,7 @@ template<>
 ErrorOr<void> encode(Encoder& encoder, HTTP::DiskCacheSettings const& sizes)
 {
     TRY(encoder.encode(sizes.maximum_size));
+    TRY(encoder.encode(sizes.compress_text_bodies));
 
     return {};
 }
@@ -22,8 +23,9 @@ template<>
 ErrorOr<HTTP::DiskCacheSettings> decode(Decoder& decoder)
 {
     auto maximum_size = TRY(decoder.decode<u64>());
+    auto compress_text_bodies = TRY(decoder.decode<bool>());
 
-    return HTTP::DiskCacheSettings { maximum_size };
+    return HTTP::DiskCacheSettings { maximum_size, compress_text_bodies };
 }
 
 }
@@ -15,6 +15,9 @@ namespace HTTP {
 
 struct DiskCacheSettings {
     u64 maximum_size { DEFAULT_MAXIMUM_DISK_CACHE_SIZE };
+
+    // Store text bodies deflated, trading some CPU (and mapping cached bodies directly) for more entries per byte
+    bool compress_text_bodies { false };
 };
 
 }
@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <LibHTTP/Cache/FrequencySketch.h>
+
+namespace HTTP {
+
+// One odd multiplier per row, so a key lands on unrelated columns in each of them
+static constexpr Array<u64, 4> ROW_SEEDS { 0xc3a5c85c97cb3127ULL, 0xb492b66fbe98f273ULL, 0x9ae16a3b2f90404fULL, 0xcbf29ce484222325ULL };
+
+static constexpr size_t MINIMUM_WIDTH = 64;
+
+FrequencySketch::FrequencySketch(size_t capacity)
+{
+    set_capacity(capacity);
+}
+
+void FrequencySketch::set_capacity(size_t capacity)
+{
+    size_t width = MINIMUM_WIDTH;
+    while (width < capacity)
+        width *= 2;
+
+    m_width = width;
+    m_counters.clear();
+    m_counters.resize(DEPTH * m_width);
+    m_additions = 0;
+    m_sample_size = 10 * m_width;
+}
+
+size_t FrequencySketch::index_of(u64 key, size_t row) const
+{
+    auto hash = key * ROW_SEEDS[row];
+    hash ^= hash >> 32;
+    return row * m_width + (hash & (m_width - 1));
+}
+
+void FrequencySketch::increment(u64 key)
+{
+    bool added = false;
+
+    for (size_t row = 0; row < DEPTH; ++row) {
+        auto& counter = m_counters[index_of(key, row)];
+        if (counter < MAXIMUM_FREQUENCY) {
+            ++counter;
+            added = true;
+        }
+    }
+
+    if (added && ++m_additions >= m_sample_size)
+        halve_counters();
+}
+
+u8 FrequencySketch::frequency(u64 key) const
+{
+    u8 frequency = MAXIMUM_FREQUENCY;
+    for (size_t row = 0; row < DEPTH; ++row)
+        frequency = min(frequency, m_counters[index_of(key, row)]);
+    return frequency;
+}
+
+void FrequencySketch::halve_counters()
+{
+    for (auto& counter : m_counters)
+        counter /= 2;
+    m_additions /= 2;
+}
+
+}
@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace HTTP {
+
+// Approximate access counts for the MemoryCache's TinyLFU admission filter, as a count-min sketch: each key bumps one
+// small counter in each of DEPTH rows, and the smallest of those is its estimate. Collisions can only inflate counts.
+//
+// Once the sketch has seen ten accesses per counter in a row, every counter is halved. Popularity from long ago fades
+// that way, so a resource that was hot an hour ago does not keep a place that today's resources should have.
+class FrequencySketch {
+public:
+    static constexpr u8 MAXIMUM_FREQUENCY = 15;
+
+    explicit FrequencySketch(size_t capacity);
+
+    // Resizes the sketch for about this many distinct keys, forgetting all counts
+    void set_capacity(size_t capacity);
+
+    void increment(u64 key);
+    u8 frequency(u64 key) const;
+
+private:
+    static constexpr size_t DEPTH = 4;
+
+    size_t index_of(u64 key, size_t row) const;
+    void halve_counters();
+
+    Vector<u8> m_counters;
+    size_t m_width { 0 };
+    size_t m_additions { 0 };
+    size_t m_sample_size { 0 };
+};
+
+}
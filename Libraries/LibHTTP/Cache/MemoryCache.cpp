@@ -10,9 +10,47 @@
 
 namespace HTTP {
 
-NonnullRefPtr<MemoryCache> MemoryCache::create()
+// The window holds 1% of the budget, and the protected segment up to 80% of what remains, as in Caffeine.
+static constexpr u64 WINDOW_PERCENTAGE = 1;
+static constexpr u64 PROTECTED_PERCENTAGE = 80;
+
+// The sketch is sized for the number of responses the budget holds if they average out at this size
+static constexpr u64 SKETCH_BYTES_PER_ENTRY = 16 * KiB;
+
+NonnullRefPtr<MemoryCache> MemoryCache::create(u64 maximum_size)
+{
+    return adopt_ref(*new MemoryCache(maximum_size));
+}
+
+MemoryCache::MemoryCache(u64 maximum_size)
+    : m_maximum_size(maximum_size)
+    , m_sketch(maximum_size / SKETCH_BYTES_PER_ENTRY)
+{
+}
+
+static u64 estimated_size(HeaderList const& headers)
+{
+    u64 size = 0;
+    for (auto const& header : headers.headers())
+        size += header.name.length() + header.value.length();
+    return size;
+}
+
+static u64 estimated_size(MemoryCache::Entry const& entry)
 {
-    return adopt_ref(*new MemoryCache());
+    u64 size = sizeof(entry) + entry.reason_phrase.length() + entry.response_body.size();
+    size += estimated_size(*entry.request_headers) + estimated_size(*entry.response_headers);
+    if (entry.javascript_bytecode_cache.has_value())
+        size += entry.javascript_bytecode_cache->size();
+    return size;
+}
+
+static u64 estimated_size(Vector<MemoryCache::Entry> const& entries)
+{
+    u64 size = 0;
+    for (auto const& entry : entries)
+        size += estimated_size(entry);
+    return size;
 }
 
 // A stored response satisfies a request only if the request header fields nominated by the response's Vary header
@@ -38,18 +76,24 @@ Optional<MemoryCache::Entry const&> MemoryCache::open_entry(URL::URL const& url,
     auto serialized_url = serialize_url_for_cache_storage(url);
     auto cache_key = create_cache_key(serialized_url, method);
 
+    // Every lookup counts towards the key's popularity, hit or not, so a response that keeps being requested can win
+    // its place in the cache once it is stored.
+    m_sketch.increment(cache_key);
+
     auto cache_entries = m_complete_entries.get(cache_key);
     if (!cache_entries.has_value()) {
         dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[35;1mNo cache entry for\033[0m {}", url);
+        m_statistics.misses++;
         return {};
     }
 
     // - request header fields nominated by the stored response (if any) match those presented (see Section 4.1), and
-    auto cache_entry = find_value(*cache_entries, [&](auto const& entry) {
+    auto cache_entry = find_value((*cache_entries)->entries, [&](auto const& entry) {
         return entry_matches_request(request_headers, entry);
     });
     if (!cache_entry.has_value()) {
         dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[35;1mVary mismatch for\033[0m {}", url);
+        m_statistics.misses++;
         return {};
     }
 
@@ -65,6 +109,8 @@ Optional<MemoryCache::Entry const&> MemoryCache::open_entry(URL::URL const& url,
     switch (cache_lifetime_status(request_headers, cache_entry->response_headers, freshness_lifetime, current_age)) {
     case CacheLifetimeStatus::Fresh:
         dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[32;1mOpened cache entry for\033[0m {} (lifetime={}s age={}s) ({} bytes)", url, freshness_lifetime.to_seconds(), current_age.to_seconds(), cache_entry->response_body.size());
+        m_statistics.hits++;
+        record_access(**cache_entries);
         return cache_entry;
 
     case CacheLifetimeStatus::Expired:
@@ -72,11 +118,14 @@ Optional<MemoryCache::Entry const&> MemoryCache::open_entry(URL::URL const& url,
     case CacheLifetimeStatus::StaleWhileRevalidate:
         if (cache_mode_permits_stale_responses(cache_mode)) {
             dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[32;1mOpened expired cache entry for\033[0m {} (lifetime={}s age={}s) ({} bytes)", url, freshness_lifetime.to_seconds(), current_age.to_seconds(), cache_entry->response_body.size());
+            m_statistics.hits++;
+            record_access(**cache_entries);
             return cache_entry;
         }
 
         dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[33;1mCache entry expired for\033[0m {} (lifetime={}s age={}s)", url, freshness_lifetime.to_seconds(), current_age.to_seconds());
-        m_complete_entries.remove(cache_key);
+        m_statistics.misses++;
+        remove_entries(**cache_entries);
         return {};
     }
 
@@ -145,7 +194,25 @@ void MemoryCache::finalize_entry(URL::URL const& url, StringView method, HeaderL
         if (cache_entries->is_empty())
             m_pending_entries.remove(cache_key);
 
-        m_complete_entries.ensure(cache_key).append(move(cache_entry));
+        // Responses that could never fit in the main cache would only flush everything else out on their way through
+        auto entry_size = estimated_size(cache_entry);
+        if (entry_size > main_limit()) {
+            dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[33;1mResponse too large to cache\033[0m {} ({} bytes)", url, entry_size);
+            m_statistics.rejected_entries++;
+            return;
+        }
+
+        auto& complete_entries = *m_complete_entries.ensure(cache_key, [&] {
+            auto entries = make<CacheEntries>();
+            entries->cache_key = cache_key;
+            entries->last_access_time = UnixDateTime::now();
+            m_window.append(*entries);
+            return entries;
+        });
+
+        complete_entries.entries.append(move(cache_entry));
+        resize_entries(complete_entries, complete_entries.size + entry_size);
+        evict_entries_exceeding_cache_limit();
     }
 }
 
@@ -171,11 +238,187 @@ void MemoryCache::update_javascript_bytecode_cache(URL::URL const& url, StringVi
         }
     };
 
-    if (auto cache_entries = m_complete_entries.get(cache_key); cache_entries.has_value())
-        update_entries(*cache_entries);
+    if (auto cache_entries = m_complete_entries.get(cache_key); cache_entries.has_value()) {
+        auto& complete_entries = **cache_entries;
+        update_entries(complete_entries.entries);
+
+        resize_entries(complete_entries, estimated_size(complete_entries.entries));
+        evict_entries_exceeding_cache_limit();
+    }
 
     if (auto cache_entries = m_pending_entries.get(cache_key); cache_entries.has_value())
         update_entries(*cache_entries);
 }
 
+void MemoryCache::set_maximum_size(u64 maximum_size)
+{
+    if (maximum_size == m_maximum_size)
+        return;
+
+    m_maximum_size = maximum_size;
+    m_sketch.set_capacity(maximum_size / SKETCH_BYTES_PER_ENTRY);
+    evict_entries_exceeding_cache_limit();
+}
+
+Requests::CacheSizes MemoryCache::estimate_cache_size_accessed_since(UnixDateTime since) const
+{
+    Requests::CacheSizes sizes;
+    sizes.total = m_size;
+
+    for (auto const& [_, entries] : m_complete_entries) {
+        if (entries->last_access_time >= since)
+            sizes.since_requested_time += entries->size;
+    }
+
+    return sizes;
+}
+
+u64 MemoryCache::window_limit() const
+{
+    return m_maximum_size * WINDOW_PERCENTAGE / 100;
+}
+
+u64 MemoryCache::main_limit() const
+{
+    return m_maximum_size - window_limit();
+}
+
+u64 MemoryCache::protected_limit() const
+{
+    return main_limit() * PROTECTED_PERCENTAGE / 100;
+}
+
+u64& MemoryCache::segment_size(Segment segment)
+{
+    switch (segment) {
+    case Segment::Window:
+        return m_window_size;
+    case Segment::Probation:
+        return m_probation_size;
+    case Segment::Protected:
+        return m_protected_size;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+MemoryCache::CacheEntries::List& MemoryCache::segment_list(Segment segment)
+{
+    switch (segment) {
+    case Segment::Window:
+        return m_window;
+    case Segment::Probation:
+        return m_probation;
+    case Segment::Protected:
+        return m_protected;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void MemoryCache::record_access(CacheEntries& entries)
+{
+    entries.last_access_time = UnixDateTime::now();
+
+    switch (entries.segment) {
+    case Segment::Window:
+    case Segment::Protected:
+        move_to_segment(entries, entries.segment);
+        break;
+
+    case Segment::Probation:
+        // A second hit in the main cache earns a protected place. Whatever that pushes out of the protected segment
+        // gets another chance on probation rather than being evicted outright.
+        move_to_segment(entries, Segment::Protected);
+
+        while (m_protected_size > protected_limit()) {
+            auto* demoted = m_protected.first();
+            if (demoted == &entries)
+                break;
+            move_to_segment(*demoted, Segment::Probation);
+        }
+        break;
+    }
+}
+
+// Moves the entries to the most recently used end of the segment, which may be the one they are already in
+void MemoryCache::move_to_segment(CacheEntries& entries, Segment segment)
+{
+    segment_size(entries.segment) -= entries.size;
+    segment_size(segment) += entries.size;
+
+    entries.segment = segment;
+    segment_list(segment).append(entries);
+}
+
+void MemoryCache::resize_entries(CacheEntries& entries, u64 size)
+{
+    segment_size(entries.segment) -= entries.size;
+    m_size -= entries.size;
+
+    entries.size = size;
+
+    segment_size(entries.segment) += entries.size;
+    m_size += entries.size;
+}
+
+void MemoryCache::remove_entries(CacheEntries& entries)
+{
+    segment_size(entries.segment) -= entries.size;
+    m_size -= entries.size;
+
+    entries.list_node.remove();
+    m_complete_entries.remove(entries.cache_key);
+}
+
+void MemoryCache::evict_entries(CacheEntries& entries)
+{
+    dbgln_if(HTTP_MEMORY_CACHE_DEBUG, "\033[37m[memory]\033[0m \033[33;1mEvicting cache entry\033[0m {} ({} bytes)", entries.cache_key, entries.size);
+
+    m_statistics.evicted_entries += entries.entries.size();
+    m_statistics.evicted_bytes += entries.size;
+    remove_entries(entries);
+}
+
+void MemoryCache::evict_entries_exceeding_cache_limit()
+{
+    // Entries falling out of the window become candidates for the main cache. They join the probation segment at its
+    // most recently used end, behind the entries they may displace.
+    Vector<CacheEntries*> candidates;
+
+    while (m_window_size > window_limit()) {
+        auto* candidate = m_window.first();
+        move_to_segment(*candidate, Segment::Probation);
+        candidates.append(candidate);
+    }
+
+    size_t next_candidate = 0;
+
+    while (m_probation_size + m_protected_size > main_limit()) {
+        auto* victim = m_probation.first();
+        if (!victim) {
+            move_to_segment(*m_protected.first(), Segment::Probation);
+            continue;
+        }
+
+        // Once only candidates are left on probation, or there were none to begin with, the least recently used entry
+        // simply goes.
+        if (next_candidate < candidates.size() && candidates[next_candidate] == victim)
+            ++next_candidate;
+        if (next_candidate == candidates.size()) {
+            evict_entries(*victim);
+            continue;
+        }
+
+        // Otherwise, the candidate has to be requested more often than the victim to be worth keeping. A large
+        // candidate that needs several victims gone must beat each of them in turn.
+        auto* candidate = candidates[next_candidate];
+        if (m_sketch.frequency(candidate->cache_key) > m_sketch.frequency(victim->cache_key)) {
+            evict_entries(*victim);
+        } else {
+            ++next_candidate;
+            m_statistics.rejected_entries += candidate->entries.size();
+            remove_entries(*candidate);
+        }
+    }
+}
+
 }
@@ -8,18 +8,28 @@
 
 #include <AK/ByteString.h>
 #include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/RefCounted.h>
 #include <AK/Time.h>
 #include <LibCore/ImmutableBytes.h>
 #include <LibHTTP/Cache/CacheMode.h>
+#include <LibHTTP/Cache/FrequencySketch.h>
 #include <LibHTTP/Forward.h>
+#include <LibRequests/CacheSizes.h>
 #include <LibURL/URL.h>
 
 namespace HTTP {
 
+// Complete responses are kept within a byte budget using W-TinyLFU. New responses enter a small LRU window; when they
+// fall out of it, they only take a place in the main cache if a frequency sketch says they are requested more often
+// than the entries they would push out. The main cache is a segmented LRU, so entries hit again while on probation
+// move to a protected segment that one-off responses cannot flush.
 class MemoryCache : public RefCounted<MemoryCache> {
 public:
+    static constexpr u64 DEFAULT_MAXIMUM_SIZE = 64 * MiB;
+
     struct Entry {
         u64 vary_key { 0 };
 
@@ -35,7 +45,15 @@ public:
         UnixDateTime response_time;
     };
 
-    static NonnullRefPtr<MemoryCache> create();
+    struct Statistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 rejected_entries { 0 }; // Lost admission to the main cache, or never fit in the budget
+        u64 evicted_entries { 0 };
+        u64 evicted_bytes { 0 };
+    };
+
+    static NonnullRefPtr<MemoryCache> create(u64 maximum_size = DEFAULT_MAXIMUM_SIZE);
 
     Optional<Entry const&> open_entry(URL::URL const&, StringView method, HeaderList const& request_headers, CacheMode);
 
@@ -43,9 +61,63 @@ public:
     void finalize_entry(URL::URL const&, StringView method, HeaderList const& request_headers, u32 status_code, HeaderList const& response_headers, Core::ImmutableBytes response_body);
     void update_javascript_bytecode_cache(URL::URL const&, StringView method, HeaderList const& request_headers, u64 vary_key, Core::ImmutableBytes javascript_bytecode_cache);
 
+    u64 maximum_size() const { return m_maximum_size; }
+    void set_maximum_size(u64 maximum_size);
+
+    u64 size() const { return m_size; }
+    Statistics const& statistics() const { return m_statistics; }
+
+    Requests::CacheSizes estimate_cache_size_accessed_since(UnixDateTime since) const;
+
 private:
+    explicit MemoryCache(u64 maximum_size);
+
+    enum class Segment : u8 {
+        Window,
+        Probation,
+        Protected,
+    };
+
+    // The complete responses for one cache key, which are admitted and evicted together
+    struct CacheEntries {
+        u64 cache_key { 0 };
+        Vector<Entry> entries;
+        u64 size { 0 };
+        Segment segment { Segment::Window };
+        UnixDateTime last_access_time;
+
+        IntrusiveListNode<CacheEntries> list_node;
+        using List = IntrusiveList<&CacheEntries::list_node>;
+    };
+
+    void record_access(CacheEntries&);
+    void move_to_segment(CacheEntries&, Segment);
+    void resize_entries(CacheEntries&, u64 size);
+    void remove_entries(CacheEntries&);
+    void evict_entries(CacheEntries&);
+    void evict_entries_exceeding_cache_limit();
+
+    u64 window_limit() const;
+    u64 main_limit() const;
+    u64 protected_limit() const;
+    u64& segment_size(Segment);
+    CacheEntries::List& segment_list(Segment);
+
     HashMap<u64, Vector<Entry>, IdentityHashTraits<u64>> m_pending_entries;
-    HashMap<u64, Vector<Entry>, IdentityHashTraits<u64>> m_complete_entries;
+    HashMap<u64, NonnullOwnPtr<CacheEntries>, IdentityHashTraits<u64>> m_complete_entries;
+
+    // Each list runs from least to most recently used
+    CacheEntries::List m_window;
+    CacheEntries::List m_probation;
+    CacheEntries::List m_protected;
+    u64 m_window_size { 0 };
+    u64 m_probation_size { 0 };
+    u64 m_protected_size { 0 };
+
+    u64 m_maximum_size { 0 };
+    u64 m_size { 0 };
+    FrequencySketch m_sketch;
+    Statistics m_statistics;
 };
 
 }
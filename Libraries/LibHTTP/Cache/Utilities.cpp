@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
+#include <AK/Array.h>
 #include <AK/GenericLexer.h>
 #include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
@@ -354,6 +356,34 @@ bool is_header_exempted_from_storage(StringView name)
         TEST_CACHE_REQUEST_TIME_OFFSET);
 }
 
+// Text bodies typically shrink to a third of their size or less. Other bodies are usually stored in compressed formats
+// already (images, media, fonts, archives), so compressing them again would only cost time.
+bool should_compress_body_at_rest(HeaderList const& response_headers)
+{
+    static constexpr Array compressible_mime_types {
+        "application/javascript"sv,
+        "application/json"sv,
+        "application/manifest+json"sv,
+        "application/wasm"sv,
+        "application/x-javascript"sv,
+        "application/xhtml+xml"sv,
+        "application/xml"sv,
+        "image/svg+xml"sv,
+        "text/css"sv,
+        "text/html"sv,
+        "text/javascript"sv,
+        "text/plain"sv,
+        "text/xml"sv,
+    };
+
+    auto content_type = response_headers.get("Content-Type"sv);
+    if (!content_type.has_value())
+        return false;
+
+    auto essence = content_type->view().find_first_split_view(';').trim_whitespace();
+    return any_of(compressible_mime_types, [&](auto mime_type) { return essence.equals_ignoring_ascii_case(mime_type); });
+}
+
 // https://httpwg.org/specs/rfc9111.html#heuristic.freshness
 static AK::Duration calculate_heuristic_freshness_lifetime(HeaderList const& headers, AK::Duration current_time_offset_for_testing)
 {
@@ -480,6 +510,31 @@ AK::Duration calculate_stale_while_revalidate_lifetime(HeaderList const& headers
     return {};
 }
 
+// https://httpwg.org/specs/rfc5861.html#n-the-stale-if-error-cache-control-extension
+AK::Duration calculate_stale_if_error_lifetime(HeaderList const& request_headers, HeaderList const& response_headers, AK::Duration freshness_lifetime)
+{
+    // https://httpwg.org/specs/rfc9111.html#cache-response-directive.must-revalidate
+    // Responses that must not be reused without successful validation cannot be served in place of an error either.
+    if (auto cache_control = response_headers.get("Cache-Control"sv); cache_control.has_value()) {
+        if (contains_cache_control_directive(*cache_control, "must-revalidate"sv) || contains_cache_control_directive(*cache_control, "no-cache"sv))
+            return {};
+    }
+
+    // "When used as a request Cache-Control extension, its scope of application is the request it appears in; when
+    // used as a response Cache-Control extension, its scope is any request applicable to the cached response in which
+    // it occurs."
+    for (auto const* headers : { &request_headers, &response_headers }) {
+        auto cache_control = headers->get("Cache-Control"sv);
+        if (!cache_control.has_value())
+            continue;
+
+        if (auto sie = extract_cache_control_duration_directive(*cache_control, "stale-if-error"sv); sie.has_value())
+            return freshness_lifetime + *sie;
+    }
+
+    return {};
+}
+
 CacheLifetimeStatus cache_lifetime_status(HeaderList const& request_headers, HeaderList const& response_headers, AK::Duration freshness_lifetime, AK::Duration current_age)
 {
     auto revalidation_status = [&](auto revalidation_type) {
@@ -553,6 +608,11 @@ CacheLifetimeStatus cache_lifetime_status(HeaderList const& request_headers, Hea
     if (calculate_stale_while_revalidate_lifetime(response_headers, freshness_lifetime) > current_age)
         return revalidation_status(CacheLifetimeStatus::StaleWhileRevalidate);
 
+    // https://httpwg.org/specs/rfc5861.html#n-the-stale-if-error-cache-control-extension
+    // Responses that may stand in for a failed revalidation are worth revalidating rather than dropping once stale.
+    if (calculate_stale_if_error_lifetime(request_headers, response_headers, freshness_lifetime) > current_age)
+        return revalidation_status(CacheLifetimeStatus::MustRevalidate);
+
     // https://httpwg.org/specs/rfc9111.html#cache-response-directive.must-revalidate
     // The must-revalidate response directive indicates that once the response has become stale, a cache MUST NOT reuse
     // that response to satisfy another request until it has been successfully validated by the origin
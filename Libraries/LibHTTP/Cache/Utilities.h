@@ -52,10 +52,12 @@ Optional<CacheEntryData> cache_entry_data_for_file(LexicalPath const&);
 bool is_cacheable(StringView method, HeaderList const&);
 bool is_cacheable(u32 status_code, HeaderList const&);
 bool is_header_exempted_from_storage(StringView name);
+bool should_compress_body_at_rest(HeaderList const& response_headers);
 
 AK::Duration calculate_freshness_lifetime(u32 status_code, HeaderList const&, AK::Duration current_time_offset_for_testing = {});
 AK::Duration calculate_age(HeaderList const&, UnixDateTime request_time, UnixDateTime response_time, AK::Duration current_time_offset_for_testing = {});
 AK::Duration calculate_stale_while_revalidate_lifetime(HeaderList const&, AK::Duration freshness_lifetime);
+AK::Duration calculate_stale_if_error_lifetime(HeaderList const& request_headers, HeaderList const& response_headers, AK::Duration freshness_lifetime);
 
 enum class CacheLifetimeStatus {
     Fresh,
@@ -7,6 +7,7 @@
  */
 
 #include <AK/Vector.h>
+#include <LibCore/TraceEvent.h>
 #include <LibIPC/Connection.h>
 #include <LibIPC/Message.h>
 #include <LibIPC/Stub.h>
@@ -72,6 +73,7 @@ void ConnectionBase::handle_messages()
         if (!is_open())
             dbgln("Handling message while connection closed: {}", message->message_name());
 
+        Core::TraceEventScope trace_event { "ipc"sv, message->message_name() };
         auto handler_result = m_local_stub.handle(move(message));
         if (handler_result.is_error()) {
             dbgln("IPC::ConnectionBase::handle_messages: {}", handler_result.error());
@@ -98,6 +100,8 @@ ConnectionBase::PeerEOF ConnectionBase::drain_messages_from_peer()
     bool parse_error = false;
     auto schedule_shutdown = m_transport->read_as_many_messages_as_possible_without_blocking([&](auto&& raw_message) {
         if (auto message = try_parse_message(raw_message.bytes, raw_message.attachments)) {
+            // NB: Moving the vector keeps its storage in place, so borrowed views into it stay valid.
+            message->adopt_buffer(move(raw_message.bytes));
             m_unprocessed_messages.append(message.release_nonnull());
         } else {
             dbgln("Failed to parse IPC message {:hex-dump}", raw_message.bytes);
@@ -31,6 +31,26 @@ ErrorOr<size_t> Decoder::decode_size()
     return size;
 }
 
+ErrorOr<ReadonlyBytes> Decoder::decode_borrowed_bytes(ByteBuffer& storage)
+{
+    if (m_memory_stream)
+        return decode_borrowed_bytes();
+
+    auto length = TRY(decode_size());
+    storage = TRY(ByteBuffer::create_uninitialized(length));
+    TRY(decode_into(storage.bytes()));
+    return storage.bytes();
+}
+
+ErrorOr<ReadonlyBytes> Decoder::decode_borrowed_bytes()
+{
+    if (!m_memory_stream)
+        return Error::from_string_literal("IPC decode: Borrowed bytes can only be decoded from the message buffer");
+
+    auto length = TRY(decode_size());
+    return m_memory_stream->read_in_place<u8 const>(length);
+}
+
 template<>
 ErrorOr<String> decode(Decoder& decoder)
 {
@@ -77,8 +97,9 @@ ErrorOr<ByteBuffer> decode(Decoder& decoder)
 template<>
 ErrorOr<JsonValue> decode(Decoder& decoder)
 {
-    auto json = TRY(decoder.decode<ByteString>());
-    return JsonValue::from_string(json);
+    ByteBuffer storage;
+    auto json = TRY(decoder.decode_borrowed_bytes(storage));
+    return JsonValue::from_string(StringView { json });
 }
 
 template<>
@@ -112,8 +133,9 @@ ErrorOr<IPv6Address> decode(Decoder& decoder)
 template<>
 ErrorOr<URL::URL> decode(Decoder& decoder)
 {
-    auto url_string = TRY(decoder.decode<ByteString>());
-    auto url = URL::Parser::basic_parse(url_string);
+    ByteBuffer storage;
+    auto url_string = TRY(decoder.decode_borrowed_bytes(storage));
+    auto url = URL::Parser::basic_parse(StringView { url_string });
     if (!url.has_value())
         return Error::from_string_view("Failed to parse URL in IPC Decode"sv);
 
@@ -10,6 +10,7 @@
 #include <AK/ByteString.h>
 #include <AK/Concepts.h>
 #include <AK/Forward.h>
+#include <AK/MemoryStream.h>
 #include <AK/Queue.h>
 #include <AK/StdLibExtras.h>
 #include <AK/Stream.h>
@@ -43,6 +44,13 @@ public:
     {
     }
 
+    Decoder(FixedMemoryStream& stream, Queue<Attachment>& attachments)
+        : m_stream(stream)
+        , m_memory_stream(&stream)
+        , m_attachments(attachments)
+    {
+    }
+
     template<typename T>
     ErrorOr<T> decode();
 
@@ -61,11 +69,21 @@ public:
 
     ErrorOr<size_t> decode_size();
 
+    // Decodes a size-prefixed run of bytes, as encoded for strings and byte buffers. When decoding straight out of the
+    // message buffer, the returned bytes point into it instead of being copied, so they must not outlive the message.
+    // Otherwise, they are read into `storage`.
+    ErrorOr<ReadonlyBytes> decode_borrowed_bytes(ByteBuffer& storage);
+
+    // As above, for decoders that must not copy, such as those of messages with [Borrowed] parameters. Fails unless
+    // decoding straight out of the message buffer.
+    ErrorOr<ReadonlyBytes> decode_borrowed_bytes();
+
     Stream& stream() { return m_stream; }
     Queue<Attachment>& attachments() { return m_attachments; }
 
 private:
     Stream& m_stream;
+    FixedMemoryStream* m_memory_stream { nullptr };
     Queue<Attachment>& m_attachments;
 };
 
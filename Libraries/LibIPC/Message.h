@@ -63,6 +63,10 @@ public:
     virtual StringView message_name() const = 0;
     virtual ErrorOr<MessageBuffer> encode() const = 0;
 
+    // Messages with [Borrowed] parameters point into the buffer they were decoded from. They are handed that buffer
+    // once decoded, and keep it alive for as long as they exist.
+    virtual void adopt_buffer(Vector<u8>&&) { }
+
 protected:
     Message() = default;
 };
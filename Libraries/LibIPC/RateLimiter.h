@@ -6,8 +6,10 @@
 
 #pragma once
 
+#include <AK/NonnullOwnPtr.h>
 #include <AK/Time.h>
 #include <AK/Types.h>
+#include <LibCore/RateLimiter.h>
 
 namespace IPC {
 
@@ -21,94 +23,16 @@ namespace IPC {
 //   } else {
 //       // Rate limit exceeded - reject or disconnect
 //   }
-class RateLimiter {
-public:
-    // Create rate limiter with maximum tokens and refill interval
-    // Example: RateLimiter(1000, Duration::from_milliseconds(10))
-    //   -> 1000 messages per second (100 tokens refilled every 10ms)
-    RateLimiter(size_t max_tokens, AK::Duration refill_interval)
-        : m_max_tokens(max_tokens)
-        , m_tokens(max_tokens)
-        , m_refill_interval(refill_interval)
-        , m_last_refill(MonotonicTime::now())
-    {
-    }
-
-    // Try to consume tokens; returns true if allowed, false if rate limit exceeded
-    [[nodiscard]] bool try_consume(size_t count = 1)
-    {
-        refill();
-
-        if (m_tokens >= count) {
-            m_tokens -= count;
-            return true;
-        }
-
-        return false;
-    }
-
-    // Get current token count (for monitoring/debugging)
-    [[nodiscard]] size_t tokens() const { return m_tokens; }
-
-    // Get maximum token capacity
-    [[nodiscard]] size_t max_tokens() const { return m_max_tokens; }
-
-    // Reset to full capacity
-    void reset()
-    {
-        m_tokens = m_max_tokens;
-        m_last_refill = MonotonicTime::now();
-    }
-
-    // Check if rate limit would be exceeded without consuming
-    [[nodiscard]] bool would_exceed(size_t count = 1) const
-    {
-        // Note: This doesn't refill, so it's a conservative estimate
-        return m_tokens < count;
-    }
-
-    // Get time until next token refill
-    [[nodiscard]] AK::Duration time_until_refill() const
-    {
-        auto now = MonotonicTime::now();
-        auto elapsed = now - m_last_refill;
-
-        if (elapsed >= m_refill_interval)
-            return AK::Duration::zero();
-
-        return m_refill_interval - elapsed;
-    }
-
-private:
-    void refill()
-    {
-        auto now = MonotonicTime::now();
-        auto elapsed = now - m_last_refill;
-
-        if (elapsed >= m_refill_interval) {
-            // Calculate how many refill intervals have passed
-            auto intervals = elapsed.to_nanoseconds() / m_refill_interval.to_nanoseconds();
-
-            // Refill tokens (capped at max)
-            m_tokens = min(m_tokens + static_cast<size_t>(intervals), m_max_tokens);
-
-            // Update last refill time
-            m_last_refill = now;
-        }
-    }
-
-    size_t m_max_tokens;
-    size_t m_tokens;
-    AK::Duration m_refill_interval;
-    MonotonicTime m_last_refill;
-};
+//
+// The first argument is the burst size, and one token is added back every refill interval.
+using RateLimiter = Core::TokenBucketRateLimiter;
 
 // Adaptive rate limiter that adjusts limits based on behavior
 // Starts permissive but becomes stricter if abuse is detected
 class AdaptiveRateLimiter {
 public:
     AdaptiveRateLimiter(size_t initial_max_tokens, AK::Duration refill_interval)
-        : m_base_limiter(initial_max_tokens, refill_interval)
+        : m_base_limiter(make<RateLimiter>(initial_max_tokens, refill_interval))
         , m_initial_max_tokens(initial_max_tokens)
         , m_consecutive_violations(0)
     {
@@ -116,7 +40,7 @@ public:
 
     [[nodiscard]] bool try_consume(size_t count = 1)
     {
-        if (m_base_limiter.try_consume(count)) {
+        if (m_base_limiter->try_consume(count)) {
             // Success - reset violation counter
             if (m_consecutive_violations > 0) {
                 m_consecutive_violations--;
@@ -132,7 +56,7 @@ public:
             // Reduce to 50% capacity
             auto new_max = m_initial_max_tokens / 2;
             if (new_max > 0) {
-                m_base_limiter = RateLimiter(new_max, AK::Duration::from_milliseconds(10));
+                m_base_limiter = make<RateLimiter>(new_max, AK::Duration::from_milliseconds(10));
             }
         }
 
@@ -141,7 +65,7 @@ public:
 
     void reset()
     {
-        m_base_limiter = RateLimiter(m_initial_max_tokens, AK::Duration::from_milliseconds(10));
+        m_base_limiter = make<RateLimiter>(m_initial_max_tokens, AK::Duration::from_milliseconds(10));
         m_consecutive_violations = 0;
     }
 
@@ -151,7 +75,8 @@ public:
     }
 
 private:
-    RateLimiter m_base_limiter;
+    // NB: Token buckets can't be moved, so a new one takes the place of the old one when the limits change.
+    NonnullOwnPtr<RateLimiter> m_base_limiter;
     size_t m_initial_max_tokens;
     size_t m_consecutive_violations;
 };
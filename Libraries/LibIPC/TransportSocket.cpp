@@ -9,6 +9,7 @@
 #include <AK/NonnullOwnPtr.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Types.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Socket.h>
 #include <LibCore/System.h>
 #include <LibIPC/Attachment.h>
@@ -49,12 +50,14 @@ ErrorOr<TransportSocket::Paired> TransportSocket::create_paired()
     };
 }
 
-void SendQueue::enqueue_message(ReadonlyBytes header, ReadonlyBytes payload, Vector<int>&& fds)
+bool SendQueue::enqueue_message(ReadonlyBytes header, ReadonlyBytes payload, Vector<int>&& fds)
 {
     Sync::MutexLocker locker(m_mutex);
+    bool was_empty = m_stream.used_buffer_size() == 0 && m_fds.is_empty();
     VERIFY(MUST(m_stream.write_some(header)) == header.size());
     VERIFY(MUST(m_stream.write_some(payload)) == payload.size());
     m_fds.append(fds.data(), fds.size());
+    return was_empty;
 }
 
 SendQueue::BytesAndFds SendQueue::peek(size_t max_bytes)
@@ -108,6 +111,9 @@ TransportSocket::TransportSocket(NonnullOwnPtr<Core::LocalSocket> socket)
     m_io_thread->start();
 }
 
+// How much the IO thread writes or reads with a single system call. Messages queued back to back share writes.
+static constexpr size_t MAX_BYTES_PER_TRANSFER = 64 * KiB;
+
 intptr_t TransportSocket::io_thread_loop()
 {
     Array<struct pollfd, 2> pollfds;
@@ -162,7 +168,7 @@ intptr_t TransportSocket::io_thread_loop()
         }
 
         if (pollfds[0].revents & POLLOUT) {
-            auto [bytes, fds] = m_send_queue->peek(4096);
+            auto [bytes, fds] = m_send_queue->peek(MAX_BYTES_PER_TRANSFER);
             if (!bytes.is_empty() || !fds.is_empty()) {
                 ReadonlyBytes remaining = bytes;
                 if (transfer_data(remaining, fds) == TransferState::SocketClosed) {
@@ -262,40 +268,85 @@ static constexpr size_t MAX_UNPROCESSED_BUFFER_SIZE = 128 * MiB;
 // Maximum number of accumulated unprocessed file descriptors before we disconnect the peer
 static constexpr size_t MAX_UNPROCESSED_FDS = 512;
 
+// Payloads at least this large are handed to the peer in shared memory. Streaming them through the socket would copy
+// them into the send queue, through the kernel and into the receive buffer, a chunk at a time.
+static constexpr size_t SHARED_MEMORY_PAYLOAD_THRESHOLD = 64 * KiB;
+
 struct MessageHeader {
     enum class Type : u8 {
         Payload = 0,
         FileDescriptorAcknowledgement = 1,
+        // The payload lives in a shared memory buffer whose file descriptor follows the message's own attachments.
+        SharedMemoryPayload = 2,
     };
     Type type { Type::Payload };
     u32 payload_size { 0 };
     u32 fd_count { 0 };
 };
 
+static Optional<int> copy_payload_into_shared_memory(ReadonlyBytes payload)
+{
+    auto buffer = Core::AnonymousBuffer::create_with_size(payload.size());
+    if (buffer.is_error())
+        return {};
+    memcpy(buffer.value().data<void>(), payload.data(), payload.size());
+
+    // The buffer closes its own file descriptor when it goes away, so the peer gets a duplicate.
+    auto fd = Core::System::dup(buffer.value().fd());
+    if (fd.is_error())
+        return {};
+    return fd.release_value();
+}
+
+static ErrorOr<void> copy_payload_out_of_shared_memory(int fd, u32 payload_size, Vector<u8>& bytes)
+{
+    ArmedScopeGuard close_fd { [&] { (void)Core::System::close(fd); } };
+
+    // Reading past the end of the file would fault, so don't take the peer's word for its size.
+    auto stat = TRY(Core::System::fstat(fd));
+    if (stat.st_size < 0 || static_cast<u64>(stat.st_size) < payload_size)
+        return Error::from_string_literal("Shared memory payload is smaller than its message header claims");
+
+    auto buffer = TRY(Core::AnonymousBuffer::create_from_anon_fd(fd, payload_size));
+    close_fd.disarm();
+    TRY(bytes.try_append(buffer.data<u8>(), payload_size));
+    return {};
+}
+
 void TransportSocket::post_message(Vector<u8> const& bytes_to_write, Vector<Attachment>& attachments)
 {
     auto num_fds_to_transfer = attachments.size();
 
+    Optional<int> shared_memory_payload_fd;
+    if (bytes_to_write.size() >= SHARED_MEMORY_PAYLOAD_THRESHOLD)
+        shared_memory_payload_fd = copy_payload_into_shared_memory(bytes_to_write);
+
     MessageHeader header {
-        .type = MessageHeader::Type::Payload,
+        .type = shared_memory_payload_fd.has_value() ? MessageHeader::Type::SharedMemoryPayload : MessageHeader::Type::Payload,
         .payload_size = static_cast<u32>(bytes_to_write.size()),
-        .fd_count = static_cast<u32>(num_fds_to_transfer),
+        .fd_count = static_cast<u32>(num_fds_to_transfer + (shared_memory_payload_fd.has_value() ? 1 : 0)),
     };
 
     auto raw_fds = Vector<int, 1> {};
-    if (num_fds_to_transfer > 0) {
-        raw_fds.ensure_capacity(num_fds_to_transfer);
+    if (header.fd_count > 0) {
+        raw_fds.ensure_capacity(header.fd_count);
         Sync::MutexLocker locker(m_fds_retained_until_received_by_peer_mutex);
-        for (auto& attachment : attachments) {
-            int fd = attachment.to_fd();
+        auto retain_until_received_by_peer = [&](int fd) {
             auto auto_fd = adopt_ref(*new AutoCloseFileDescriptor(fd));
             raw_fds.unchecked_append(auto_fd->value());
             m_fds_retained_until_received_by_peer.enqueue(move(auto_fd));
-        }
+        };
+        for (auto& attachment : attachments)
+            retain_until_received_by_peer(attachment.to_fd());
+        if (shared_memory_payload_fd.has_value())
+            retain_until_received_by_peer(*shared_memory_payload_fd);
     }
 
-    m_send_queue->enqueue_message({ reinterpret_cast<u8 const*>(&header), sizeof(header) }, bytes_to_write, move(raw_fds));
-    wake_io_thread();
+    ReadonlyBytes payload_to_stream = shared_memory_payload_fd.has_value() ? ReadonlyBytes {} : bytes_to_write.span();
+    // The IO thread keeps writing until the queue is empty, so it only needs waking for the first message queued after
+    // that. Messages posted in a burst then go out together in as few writes as possible.
+    if (m_send_queue->enqueue_message({ reinterpret_cast<u8 const*>(&header), sizeof(header) }, payload_to_stream, move(raw_fds)))
+        wake_io_thread();
 }
 
 ErrorOr<void> TransportSocket::send_message(Core::LocalSocket& socket, ReadonlyBytes& bytes_to_write, Vector<int>& unowned_fds)
@@ -351,9 +402,9 @@ void TransportSocket::read_incoming_messages()
 {
     Vector<NonnullOwnPtr<Message>> batch;
     while (m_socket->is_open()) {
-        u8 buffer[4096];
+        u8 buffer[MAX_BYTES_PER_TRANSFER];
         auto received_fds = Vector<int> {};
-        auto maybe_bytes_read = m_socket->receive_message({ buffer, 4096 }, MSG_DONTWAIT, received_fds);
+        auto maybe_bytes_read = m_socket->receive_message({ buffer, sizeof(buffer) }, MSG_DONTWAIT, received_fds);
         if (maybe_bytes_read.is_error()) {
             auto error = maybe_bytes_read.release_error();
 
@@ -435,6 +486,35 @@ void TransportSocket::read_incoming_messages()
                 break;
             }
             batch.append(move(message));
+        } else if (header.type == MessageHeader::Type::SharedMemoryPayload) {
+            if (header.payload_size > MAX_MESSAGE_PAYLOAD_SIZE) {
+                dbgln("TransportSocket: Rejecting message with payload_size {} exceeding limit {}", header.payload_size, MAX_MESSAGE_PAYLOAD_SIZE);
+                m_peer_eof = true;
+                break;
+            }
+            if (header.fd_count == 0 || header.fd_count > MAX_MESSAGE_FD_COUNT + 1) {
+                dbgln("TransportSocket: Rejecting shared memory message with fd_count {}", header.fd_count);
+                m_peer_eof = true;
+                break;
+            }
+            if (header.fd_count > m_unprocessed_attachments.size())
+                break;
+            auto message = make<Message>();
+            received_fd_count += header.fd_count;
+            if (received_fd_count.has_overflow()) {
+                dbgln("TransportSocket: received_fd_count would overflow");
+                m_peer_eof = true;
+                break;
+            }
+            for (size_t i = 0; i < header.fd_count - 1; ++i)
+                message->attachments.enqueue(m_unprocessed_attachments.dequeue());
+            auto payload_fd = m_unprocessed_attachments.dequeue().to_fd();
+            if (auto result = copy_payload_out_of_shared_memory(payload_fd, header.payload_size, message->bytes); result.is_error()) {
+                dbgln("TransportSocket: Failed to read shared memory payload of size {}: {}", header.payload_size, result.error());
+                m_peer_eof = true;
+                break;
+            }
+            batch.append(move(message));
         } else if (header.type == MessageHeader::Type::FileDescriptorAcknowledgement) {
             if (header.payload_size != 0) {
                 dbgln("TransportSocket: FileDescriptorAcknowledgement with non-zero payload_size {}", header.payload_size);
@@ -453,7 +533,8 @@ void TransportSocket::read_incoming_messages()
             break;
         }
         Checked<size_t> new_index = index;
-        new_index += header.payload_size;
+        if (header.type != MessageHeader::Type::SharedMemoryPayload)
+            new_index += header.payload_size;
         new_index += sizeof(MessageHeader);
         if (new_index.has_overflow()) {
             dbgln("TransportSocket: index would overflow");
@@ -482,8 +563,8 @@ void TransportSocket::read_incoming_messages()
             .payload_size = 0,
             .fd_count = received_fd_count.value(),
         };
-        m_send_queue->enqueue_message({ reinterpret_cast<u8 const*>(&header), sizeof(header) }, {}, {});
-        wake_io_thread();
+        if (m_send_queue->enqueue_message({ reinterpret_cast<u8 const*>(&header), sizeof(header) }, {}, {}))
+            wake_io_thread();
     }
 
     if (index < m_unprocessed_bytes.size()) {
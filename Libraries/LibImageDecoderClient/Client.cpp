@@ -18,6 +18,7 @@ void Client::die()
 {
     verify_event_loop();
     auto pending_promises = move(m_token_promises);
+    m_partial_image_callbacks.clear();
 
     for (auto& promise : pending_promises)
         promise.value->reject(Error::from_string_literal("ImageDecoder disconnected"));
@@ -55,6 +56,58 @@ NonnullRefPtr<Core::Promise<DecodedImage>> Client::decode_image(ReadonlyBytes en
     return promise;
 }
 
+i64 Client::begin_incremental_decode(Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+{
+    verify_event_loop();
+    auto promise = Core::Promise<DecodedImage>::construct();
+    if (on_resolved)
+        promise->on_resolution = move(on_resolved);
+    if (on_rejected)
+        promise->on_rejection = move(on_rejected);
+
+    i64 request_id = m_next_request_id++;
+    m_token_promises.set(request_id, move(promise));
+    if (on_partial_image)
+        m_partial_image_callbacks.set(request_id, move(on_partial_image));
+
+    async_begin_incremental_decode(request_id, ideal_size, mime_type);
+    return request_id;
+}
+
+void Client::append_incremental_decode_data(i64 request_id, ReadonlyBytes data)
+{
+    verify_event_loop();
+    if (data.is_empty() || !m_token_promises.contains(request_id))
+        return;
+    async_append_incremental_decode_data(request_id, data);
+}
+
+void Client::finish_incremental_decode(i64 request_id)
+{
+    verify_event_loop();
+    if (!m_token_promises.contains(request_id))
+        return;
+    async_finish_incremental_decode(request_id);
+}
+
+void Client::cancel_incremental_decode(i64 request_id)
+{
+    verify_event_loop();
+    m_partial_image_callbacks.remove(request_id);
+    if (!m_token_promises.remove(request_id))
+        return;
+    async_cancel_decoding(request_id);
+}
+
+void Client::did_decode_partial_image(i64 request_id, Gfx::ShareableBitmap bitmap)
+{
+    verify_event_loop();
+    auto it = m_partial_image_callbacks.find(request_id);
+    if (it == m_partial_image_callbacks.end() || !bitmap.is_valid())
+        return;
+    it->value(*bitmap.bitmap());
+}
+
 void Client::did_decode_image(i64 request_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::ColorSpace color_space, i64 session_id)
 {
     verify_event_loop();
@@ -62,6 +115,7 @@ void Client::did_decode_image(i64 request_id, bool is_animated, u32 loop_count,
     VERIFY(!bitmaps.is_empty());
 
     Optional<NonnullRefPtr<Core::Promise<DecodedImage>>> maybe_promise = m_token_promises.take(request_id);
+    m_partial_image_callbacks.remove(request_id);
 
     if (!maybe_promise.has_value()) {
         dbgln("ImageDecoderClient: No pending image with request token {}", request_id);
@@ -102,6 +156,7 @@ void Client::did_fail_to_decode_image(i64 request_id, String error_message)
 {
     verify_event_loop();
     Optional<NonnullRefPtr<Core::Promise<DecodedImage>>> maybe_promise = m_token_promises.take(request_id);
+    m_partial_image_callbacks.remove(request_id);
 
     if (!maybe_promise.has_value()) {
         dbgln("ImageDecoderClient: No pending image with request token {}", request_id);
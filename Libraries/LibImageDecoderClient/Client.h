@@ -44,6 +44,14 @@ public:
 
     NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
 
+    // Decodes an image that is handed over in chunks while it loads, calling on_partial_image with what has been decoded
+    // so far along the way. The returned request id is what the calls below take.
+    i64 begin_incremental_decode(Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image, Function<ErrorOr<void>(DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected, Optional<Gfx::IntSize> ideal_size = {}, Optional<ByteString> mime_type = {});
+    void append_incremental_decode_data(i64 request_id, ReadonlyBytes);
+    void finish_incremental_decode(i64 request_id);
+    // Drops the request without calling any of its callbacks.
+    void cancel_incremental_decode(i64 request_id);
+
     void request_animation_frames(i64 session_id, u32 start_frame_index, u32 count);
     void stop_animation_decode(i64 session_id);
 
@@ -57,6 +65,7 @@ private:
 
     virtual void did_decode_image(i64 request_id, bool is_animated, u32 loop_count, Gfx::BitmapSequence bitmap_sequence, Vector<u32> durations, Gfx::FloatPoint scale, Gfx::ColorSpace color_space, i64 session_id) override;
     virtual void did_fail_to_decode_image(i64 request_id, String error_message) override;
+    virtual void did_decode_partial_image(i64 request_id, Gfx::ShareableBitmap bitmap) override;
 
     virtual void did_decode_animation_frames(i64 session_id, Gfx::BitmapSequence bitmaps) override;
     virtual void did_fail_animation_decode(i64 session_id, String error_message) override;
@@ -64,6 +73,7 @@ private:
     Core::EventLoop* m_creation_event_loop { &Core::EventLoop::current() };
     i64 m_next_request_id { 0 };
     HashMap<i64, NonnullRefPtr<Core::Promise<DecodedImage>>> m_token_promises;
+    HashMap<i64, Function<void(NonnullRefPtr<Gfx::Bitmap>)>> m_partial_image_callbacks;
 };
 
 }
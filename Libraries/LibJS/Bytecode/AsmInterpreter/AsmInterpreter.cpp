@@ -23,8 +23,9 @@
 #include <stdlib.h>
 
 // ===== Slow path hit counters (for profiling) =====
-// Define JS_ASMINT_SLOW_PATH_COUNTERS to enable per-opcode slow path
-// counters. They are printed on exit when the asm interpreter is active.
+// Define JS_ASMINT_SLOW_PATH_COUNTERS (or configure with
+// ENABLE_JS_ASMINT_SLOW_PATH_COUNTERS) to enable per-opcode fallback and slow
+// path counters. They are printed on exit when the asm interpreter is active.
 #ifdef JS_ASMINT_SLOW_PATH_COUNTERS
 static struct AsmSlowPathStats {
     u64 fallback_by_type[256] {};
@@ -32,13 +33,8 @@ static struct AsmSlowPathStats {
     bool registered {};
 } s_stats;
 
-static void print_asm_slow_path_stats()
+static void print_asm_slow_path_counts(char const* title, u64 const (&counts)[256])
 {
-    if (getenv("LIBJS_USE_CPP_INTERPRETER"))
-        return;
-
-    fprintf(stderr, "\n=== AsmInterpreter slow path stats ===\n");
-
     static char const* const s_type_names[] = {
 #    define __BYTECODE_OP(op) #op,
         ENUMERATE_BYTECODE_OPS(__BYTECODE_OP)
@@ -49,17 +45,15 @@ static void print_asm_slow_path_stats()
         char const* name;
         u64 count;
     };
-    Entry entries[512];
+    Entry entries[256];
     size_t num_entries = 0;
+    u64 total = 0;
 
     for (size_t i = 0; i < 256; ++i) {
-        if (s_stats.fallback_by_type[i] > 0)
-            entries[num_entries++] = { s_type_names[i], s_stats.fallback_by_type[i] };
-    }
-
-    for (size_t i = 0; i < 256; ++i) {
-        if (s_stats.slow_path_by_type[i] > 0)
-            entries[num_entries++] = { s_type_names[i], s_stats.slow_path_by_type[i] };
+        if (counts[i] > 0) {
+            entries[num_entries++] = { s_type_names[i], counts[i] };
+            total += counts[i];
+        }
     }
 
     // Bubble sort by count descending (small array, no need for qsort)
@@ -71,8 +65,21 @@ static void print_asm_slow_path_stats()
                 entries[j] = tmp;
             }
 
+    fprintf(stderr, "--- %s: %llu total ---\n", title, static_cast<unsigned long long>(total));
     for (size_t i = 0; i < num_entries; ++i)
-        fprintf(stderr, "  %12llu  %s\n", static_cast<unsigned long long>(entries[i].count), entries[i].name);
+        fprintf(stderr, "  %12llu  %5.1f%%  %s\n", static_cast<unsigned long long>(entries[i].count), 100.0 * entries[i].count / total, entries[i].name);
+}
+
+static void print_asm_slow_path_stats()
+{
+    if (getenv("LIBJS_USE_CPP_INTERPRETER"))
+        return;
+
+    fprintf(stderr, "\n=== AsmInterpreter slow path stats ===\n");
+
+    // Fallbacks are opcodes without a DSL handler; slow paths are DSL handlers whose fast path missed.
+    print_asm_slow_path_counts("Fallback (no DSL handler)", s_stats.fallback_by_type);
+    print_asm_slow_path_counts("Slow path (fast path missed)", s_stats.slow_path_by_type);
 
     fprintf(stderr, "===\n\n");
 }
@@ -300,6 +307,21 @@ i64 asm_slow_path_get_private_by_id(VM*, u32 pc);
 i64 asm_slow_path_put_private_by_id(VM*, u32 pc);
 i64 asm_slow_path_instance_of(VM*, u32 pc);
 i64 asm_slow_path_resolve_this_binding(VM*, u32 pc);
+i64 asm_try_get_by_id_with_this_cache(VM*, u32 pc);
+i64 asm_slow_path_typeof(VM*, u32 pc);
+i64 asm_slow_path_new_function(VM*, u32 pc);
+i64 asm_slow_path_create_lexical_environment(VM*, u32 pc);
+i64 asm_slow_path_to_string(VM*, u32 pc);
+i64 asm_slow_path_get_by_id_with_this(VM*, u32 pc);
+i64 asm_slow_path_in(VM*, u32 pc);
+i64 asm_slow_path_concat_string(VM*, u32 pc);
+i64 asm_slow_path_call_with_argument_array(VM*, u32 pc);
+i64 asm_slow_path_get_by_value_with_this(VM*, u32 pc);
+i64 asm_slow_path_put_by_id_with_this(VM*, u32 pc);
+i64 asm_slow_path_get_method(VM*, u32 pc);
+i64 asm_slow_path_get_iterator(VM*, u32 pc);
+i64 asm_slow_path_iterator_next(VM*, u32 pc);
+i64 asm_slow_path_iterator_next_unpack(VM*, u32 pc);
 
 // ===== Fallback handler for opcodes without DSL handlers =====
 // NB: Opcodes with DSL handlers are dispatched directly and never reach here.
@@ -343,8 +365,6 @@ i64 asm_fallback_handler(VM* vm, u32 pc)
         return execute_nonthrowing<Op::Catch>(*vm, pc);
     case Instruction::Type::CreateAsyncFromSyncIterator:
         return execute_nonthrowing<Op::CreateAsyncFromSyncIterator>(*vm, pc);
-    case Instruction::Type::CreateLexicalEnvironment:
-        return execute_nonthrowing<Op::CreateLexicalEnvironment>(*vm, pc);
     case Instruction::Type::CreateVariableEnvironment:
         return execute_nonthrowing<Op::CreateVariableEnvironment>(*vm, pc);
     case Instruction::Type::CreatePrivateEnvironment:
@@ -363,14 +383,10 @@ i64 asm_fallback_handler(VM* vm, u32 pc)
         return execute_nonthrowing<Op::GetSuperConstructor>(*vm, pc);
     case Instruction::Type::GetTemplateObject:
         return execute_nonthrowing<Op::GetTemplateObject>(*vm, pc);
-    case Instruction::Type::IsCallable:
-        return execute_nonthrowing<Op::IsCallable>(*vm, pc);
     case Instruction::Type::IsConstructor:
         return execute_nonthrowing<Op::IsConstructor>(*vm, pc);
     case Instruction::Type::LeavePrivateEnvironment:
         return execute_nonthrowing<Op::LeavePrivateEnvironment>(*vm, pc);
-    case Instruction::Type::NewFunction:
-        return execute_nonthrowing<Op::NewFunction>(*vm, pc);
     case Instruction::Type::NewObjectWithNoPrototype:
         return execute_nonthrowing<Op::NewObjectWithNoPrototype>(*vm, pc);
     case Instruction::Type::NewPrimitiveArray:
@@ -383,16 +399,10 @@ i64 asm_fallback_handler(VM* vm, u32 pc)
         return execute_nonthrowing<Op::NewTypeError>(*vm, pc);
     case Instruction::Type::SetCompletionType:
         return execute_nonthrowing<Op::SetCompletionType>(*vm, pc);
-    case Instruction::Type::ToBoolean:
-        return execute_nonthrowing<Op::ToBoolean>(*vm, pc);
-    case Instruction::Type::Typeof:
-        return execute_nonthrowing<Op::Typeof>(*vm, pc);
 
     // Throwing instructions
     case Instruction::Type::ArrayAppend:
         return execute_throwing<Op::ArrayAppend>(*vm, pc);
-    case Instruction::Type::ToString:
-        return execute_throwing<Op::ToString>(*vm, pc);
     case Instruction::Type::ToPrimitiveWithStringHint:
         return execute_throwing<Op::ToPrimitiveWithStringHint>(*vm, pc);
     case Instruction::Type::CallConstructWithArgumentArray:
@@ -401,10 +411,6 @@ i64 asm_fallback_handler(VM* vm, u32 pc)
         return execute_throwing<Op::CallDirectEval>(*vm, pc);
     case Instruction::Type::CallDirectEvalWithArgumentArray:
         return execute_throwing<Op::CallDirectEvalWithArgumentArray>(*vm, pc);
-    case Instruction::Type::CallWithArgumentArray:
-        return execute_throwing<Op::CallWithArgumentArray>(*vm, pc);
-    case Instruction::Type::ConcatString:
-        return execute_throwing<Op::ConcatString>(*vm, pc);
     case Instruction::Type::CopyObjectExcludingProperties:
         return execute_throwing<Op::CopyObjectExcludingProperties>(*vm, pc);
     case Instruction::Type::CreateDataPropertyOrThrow:
@@ -431,16 +437,8 @@ i64 asm_fallback_handler(VM* vm, u32 pc)
         return execute_throwing<Op::DynamicGetBinding>(*vm, pc);
     case Instruction::Type::DynamicGetInitializedBinding:
         return execute_throwing<Op::DynamicGetInitializedBinding>(*vm, pc);
-    case Instruction::Type::GetByIdWithThis:
-        return execute_throwing<Op::GetByIdWithThis>(*vm, pc);
-    case Instruction::Type::GetByValueWithThis:
-        return execute_throwing<Op::GetByValueWithThis>(*vm, pc);
-    case Instruction::Type::GetIterator:
-        return execute_throwing<Op::GetIterator>(*vm, pc);
     case Instruction::Type::GetLengthWithThis:
         return execute_throwing<Op::GetLengthWithThis>(*vm, pc);
-    case Instruction::Type::GetMethod:
-        return execute_throwing<Op::GetMethod>(*vm, pc);
     case Instruction::Type::GetObjectPropertyIterator:
         return execute_throwing<Op::GetObjectPropertyIterator>(*vm, pc);
     case Instruction::Type::ObjectPropertyIteratorNext:
@@ -449,8 +447,6 @@ i64 asm_fallback_handler(VM* vm, u32 pc)
         return execute_throwing<Op::HasPrivateId>(*vm, pc);
     case Instruction::Type::ImportCall:
         return execute_throwing<Op::ImportCall>(*vm, pc);
-    case Instruction::Type::In:
-        return execute_throwing<Op::In>(*vm, pc);
     case Instruction::Type::DynamicInitializeLexicalBinding:
         return execute_throwing<Op::DynamicInitializeLexicalBinding>(*vm, pc);
     case Instruction::Type::DynamicInitializeVariableBinding:
@@ -459,18 +455,12 @@ i64 asm_fallback_handler(VM* vm, u32 pc)
         return execute_throwing<Op::InitializeVariableBinding>(*vm, pc);
     case Instruction::Type::IteratorClose:
         return execute_throwing<Op::IteratorClose>(*vm, pc);
-    case Instruction::Type::IteratorNext:
-        return execute_throwing<Op::IteratorNext>(*vm, pc);
-    case Instruction::Type::IteratorNextUnpack:
-        return execute_throwing<Op::IteratorNextUnpack>(*vm, pc);
     case Instruction::Type::IteratorToArray:
         return execute_throwing<Op::IteratorToArray>(*vm, pc);
     case Instruction::Type::NewArrayWithLength:
         return execute_throwing<Op::NewArrayWithLength>(*vm, pc);
     case Instruction::Type::NewClass:
         return execute_throwing<Op::NewClass>(*vm, pc);
-    case Instruction::Type::PutByIdWithThis:
-        return execute_throwing<Op::PutByIdWithThis>(*vm, pc);
     case Instruction::Type::PutBySpread:
         return execute_throwing<Op::PutBySpread>(*vm, pc);
     case Instruction::Type::PutByValueWithThis:
@@ -988,10 +978,13 @@ i64 asm_try_put_by_id_cache(VM* vm, u32 pc)
 // Fast cache-only GetById. Tries all cache entries for own-property and prototype
 // chain lookups. On cache hit, writes the result to the dst operand and returns 0.
 // On miss, returns 1 (caller should use full slow path).
-i64 asm_try_get_by_id_cache(VM* vm, u32 pc)
+// NB: Only data properties are served from the cache, so GetByIdWithThis can share
+//     this with GetById: the receiver only matters once a getter gets called.
+template<typename InsnType>
+static i64 try_get_by_id_cache(VM* vm, u32 pc)
 {
     auto* bytecode = vm->current_executable().bytecode.data();
-    auto& insn = *reinterpret_cast<Op::GetById const*>(&bytecode[pc]);
+    auto& insn = *reinterpret_cast<InsnType const*>(&bytecode[pc]);
     auto base = vm->get(insn.base());
     if (!base.is_object()) [[unlikely]]
         return 1;
@@ -1034,6 +1027,16 @@ i64 asm_try_get_by_id_cache(VM* vm, u32 pc)
     return 1;
 }
 
+i64 asm_try_get_by_id_cache(VM* vm, u32 pc)
+{
+    return try_get_by_id_cache<Op::GetById>(vm, pc);
+}
+
+i64 asm_try_get_by_id_with_this_cache(VM* vm, u32 pc)
+{
+    return try_get_by_id_cache<Op::GetByIdWithThis>(vm, pc);
+}
+
 i64 asm_slow_path_get_binding(VM* vm, u32 pc)
 {
     return slow_path_throwing<Op::GetBinding>(*vm, pc);
@@ -1265,6 +1268,76 @@ i64 asm_slow_path_resolve_this_binding(VM* vm, u32 pc)
     return slow_path_throwing<Op::ResolveThisBinding>(*vm, pc);
 }
 
+i64 asm_slow_path_typeof(VM* vm, u32 pc)
+{
+    return slow_path_nonthrowing<Op::Typeof>(*vm, pc);
+}
+
+i64 asm_slow_path_new_function(VM* vm, u32 pc)
+{
+    return slow_path_nonthrowing<Op::NewFunction>(*vm, pc);
+}
+
+i64 asm_slow_path_create_lexical_environment(VM* vm, u32 pc)
+{
+    return slow_path_nonthrowing<Op::CreateLexicalEnvironment>(*vm, pc);
+}
+
+i64 asm_slow_path_to_string(VM* vm, u32 pc)
+{
+    return slow_path_throwing<Op::ToString>(*vm, pc);
+}
+
+i64 asm_slow_path_get_by_id_with_this(VM* vm, u32 pc)
+{
+    return slow_path_throwing<Op::GetByIdWithThis>(*vm, pc);
+}
+
+i64 asm_slow_path_in(VM* vm, u32 pc)
+{
+    return slow_path_throwing<Op::In>(*vm, pc);
+}
+
+i64 asm_slow_path_concat_string(VM* vm, u32 pc)
+{
+    return slow_path_throwing<Op::ConcatString>(*vm, pc);
+}
+
+i64 asm_slow_path_call_with_argument_array(VM* vm, u32 pc)
+{
+    return slow_path_throwing<Op::CallWithArgumentArray>(*vm, pc);
+}
+
+i64 asm_slow_path_get_by_value_with_this(VM* vm, u32 pc)
+{
+    return slow_path_throwing<Op::GetByValueWithThis>(*vm, pc);
+}
+
+i64 asm_slow_path_put_by_id_with_this(VM* vm, u32 pc)
+{
+    return slow_path_throwing<Op::PutByIdWithThis>(*vm, pc);
+}
+
+i64 asm_slow_path_get_method(VM* vm, u32 pc)
+{
+    return slow_path_throwing<Op::GetMethod>(*vm, pc);
+}
+
+i64 asm_slow_path_get_iterator(VM* vm, u32 pc)
+{
+    return slow_path_throwing<Op::GetIterator>(*vm, pc);
+}
+
+i64 asm_slow_path_iterator_next(VM* vm, u32 pc)
+{
+    return slow_path_throwing<Op::IteratorNext>(*vm, pc);
+}
+
+i64 asm_slow_path_iterator_next_unpack(VM* vm, u32 pc)
+{
+    return slow_path_throwing<Op::IteratorNextUnpack>(*vm, pc);
+}
+
 // Direct handler for GetPrivateById: bypasses Reference indirection.
 i64 asm_slow_path_get_private_by_id(VM* vm, u32 pc)
 {
@@ -956,6 +956,116 @@ handler Not
     dispatch_next
 end
 
+handler ToBoolean
+    temp value, tag, nullish_check, truthy, result
+    load_operand value, m_value
+    extract_tag tag, value
+    # Booleans are already in canonical form
+    branch_eq tag, BOOLEAN_TAG, .store_value
+    # Int32 fast path
+    branch_eq tag, INT32_TAG, .is_int32
+    # Undefined/null are falsy
+    mov nullish_check, tag
+    and nullish_check, 0xFFFE
+    branch_eq nullish_check, UNDEFINED_TAG, .store_false
+    # NB: Objects go through the helper to handle [[IsHTMLDDA]]
+    call_helper asm_helper_to_boolean, value, truthy
+    assert_lt_unsigned truthy, 2
+    branch_zero truthy, .store_false
+    jmp .store_true
+.store_value:
+    store_operand m_dst, value
+    dispatch_next
+.is_int32:
+    branch_zero32 value, .store_false
+.store_true:
+    mov result, BOOLEAN_TRUE
+    store_operand m_dst, result
+    dispatch_next
+.store_false:
+    mov result, BOOLEAN_FALSE
+    store_operand m_dst, result
+    dispatch_next
+end
+
+# Only objects can be callable, and whether they are is a flag on the object.
+handler IsCallable
+    temp value, tag, obj, flags, result
+    load_operand value, m_value
+    extract_tag tag, value
+    branch_ne tag, OBJECT_TAG, .store_false
+    unbox_object obj, value
+    load8 flags, [obj, OBJECT_FLAGS]
+    branch_bits_clear flags, OBJECT_FLAG_IS_FUNCTION, .store_false
+    mov result, BOOLEAN_TRUE
+    store_operand m_dst, result
+    dispatch_next
+.store_false:
+    mov result, BOOLEAN_FALSE
+    store_operand m_dst, result
+    dispatch_next
+end
+
+# Primitives map straight to one of the VM's cached type name strings.
+handler Typeof
+    temp value, tag, vm, string, result
+    load_operand value, m_src
+    extract_tag tag, value
+    load_vm vm
+    branch_eq tag, INT32_TAG, .number
+    branch_eq tag, STRING_TAG, .string
+    branch_eq tag, BOOLEAN_TAG, .boolean
+    branch_eq tag, UNDEFINED_TAG, .undefined
+    branch_eq tag, NULL_TAG, .null
+    branch_eq tag, SYMBOL_TAG, .symbol
+    branch_eq tag, BIGINT_TAG, .bigint
+    # NB: Objects go through slow path to handle [[IsHTMLDDA]]
+    check_tag_is_double tag, .slow
+.number:
+    load64 string, [vm, VM_CACHED_STRINGS_NUMBER]
+    jmp .store_string
+.string:
+    load64 string, [vm, VM_CACHED_STRINGS_STRING]
+    jmp .store_string
+.boolean:
+    load64 string, [vm, VM_CACHED_STRINGS_BOOLEAN]
+    jmp .store_string
+.undefined:
+    load64 string, [vm, VM_CACHED_STRINGS_UNDEFINED]
+    jmp .store_string
+.null:
+    load64 string, [vm, VM_CACHED_STRINGS_OBJECT]
+    jmp .store_string
+.symbol:
+    load64 string, [vm, VM_CACHED_STRINGS_SYMBOL]
+    jmp .store_string
+.bigint:
+    load64 string, [vm, VM_CACHED_STRINGS_BIGINT]
+.store_string:
+    assert_nonzero string
+    # Match Value(PrimitiveString*): keep only the low 48 pointer bits before boxing.
+    shl string, 16
+    shr string, 16
+    mov result, STRING_TAG_SHIFTED
+    or result, string
+    store_operand m_dst, result
+    dispatch_next
+.slow:
+    call_slow_path asm_slow_path_typeof
+end
+
+# Strings are their own primitive string; everything else goes through ToPrimitive.
+handler ToString
+    temp value, tag
+    load_operand value, m_value
+    extract_tag tag, value
+    branch_ne tag, STRING_TAG, .slow
+    store_operand m_dst, value
+    dispatch_next
+.slow:
+    call_slow_path asm_slow_path_to_string
+end
+
 # ============================================================================
 # Return / function call
 # ============================================================================
@@ -1798,48 +1908,55 @@ handler PutByValue
 end
 
 # Inline cache fast path for property access (own + prototype chain).
-handler GetById
-    temp base, tag, obj, shape, plc, cache_shape, cache_proto, prop_offset, dict_gen, cur_dict_gen, props, value, result
+# On a hit, stores the property value of m_base into m_dst and dispatches.
+# Jumps to fail on a miss, or if the property is an accessor.
+macro get_by_id_inline_cache(fail)
+    temp base, tag, obj, shape, plc, cache_shape, cache_proto, prop_offset, dict_gen, cur_dict_gen, props, value
     load_operand base, m_base
     extract_tag tag, base
-    branch_ne tag, OBJECT_TAG, .try_cache
+    branch_ne tag, OBJECT_TAG, fail
     unbox_object obj, base
     load64 shape, [obj, OBJECT_SHAPE]
     assert_nonzero shape
-    load_property_lookup_cache plc, .try_cache
+    load_property_lookup_cache plc, fail
     assert_nonzero plc
     load_pair64 cache_shape, cache_proto, [plc, PROPERTY_LOOKUP_CACHE_ENTRY_SHAPE], [plc, PROPERTY_LOOKUP_CACHE_ENTRY_PROTOTYPE]
-    branch_ne cache_shape, shape, .try_cache
+    branch_ne cache_shape, shape, fail
     branch_nonzero cache_proto, .proto
     # Check dictionary generation matches
     load_pair32 prop_offset, dict_gen, [plc, PROPERTY_LOOKUP_CACHE_ENTRY_PROPERTY_OFFSET], [plc, PROPERTY_LOOKUP_CACHE_ENTRY_DICTIONARY_GENERATION]
     load32 cur_dict_gen, [shape, SHAPE_DICTIONARY_GENERATION]
-    branch_ne dict_gen, cur_dict_gen, .try_cache
+    branch_ne dict_gen, cur_dict_gen, fail
     # IC hit! Load property value via get_direct (own property)
     load64 props, [obj, OBJECT_NAMED_PROPERTIES]
     assert_nonzero props
     load64 value, [props, prop_offset, 8]
     # Check value is not an accessor
     extract_tag tag, value
-    branch_eq tag, ACCESSOR_TAG, .try_cache
+    branch_eq tag, ACCESSOR_TAG, fail
     store_operand m_dst, value
     dispatch_next
 .proto:
     # cache_proto = prototype Object*, shape = object's shape, plc = PLC base
     load64 prop_offset, [plc, PROPERTY_LOOKUP_CACHE_ENTRY_PROTOTYPE_CHAIN_VALIDITY]
-    branch_zero prop_offset, .try_cache
+    branch_zero prop_offset, fail
     load8 tag, [prop_offset, PROTOTYPE_CHAIN_VALIDITY_VALID]
-    branch_zero tag, .try_cache
+    branch_zero tag, fail
     load_pair32 prop_offset, dict_gen, [plc, PROPERTY_LOOKUP_CACHE_ENTRY_PROPERTY_OFFSET], [plc, PROPERTY_LOOKUP_CACHE_ENTRY_DICTIONARY_GENERATION]
     load32 cur_dict_gen, [shape, SHAPE_DICTIONARY_GENERATION]
-    branch_ne dict_gen, cur_dict_gen, .try_cache
+    branch_ne dict_gen, cur_dict_gen, fail
     load64 props, [cache_proto, OBJECT_NAMED_PROPERTIES]
     assert_nonzero props
     load64 value, [props, prop_offset, 8]
     extract_tag tag, value
-    branch_eq tag, ACCESSOR_TAG, .try_cache
+    branch_eq tag, ACCESSOR_TAG, fail
     store_operand m_dst, value
     dispatch_next
+end
+
+handler GetById
+    temp result
+    get_by_id_inline_cache .try_cache
 .try_cache:
     # Try all cache entries via C++ helper
     call_interp asm_try_get_by_id_cache, result
@@ -1850,6 +1967,19 @@ handler GetById
     dispatch_next
 end
 
+# NB: Cached data properties don't depend on the receiver, so GetById's cache applies as is.
+handler GetByIdWithThis
+    temp result
+    get_by_id_inline_cache .try_cache
+.try_cache:
+    call_interp asm_try_get_by_id_with_this_cache, result
+    branch_zero result, .done
+.slow:
+    call_slow_path asm_slow_path_get_by_id_with_this
+.done:
+    dispatch_next
+end
+
 # Inline cache fast path for own-property store (ChangeOwnProperty).
 handler PutById
     temp base, tag, obj, shape, plc, cache_shape, cache_proto, prop_offset, dict_gen, cur_dict_gen, props, value, src, result
@@ -3004,6 +3134,50 @@ handler InstanceOf
     call_slow_path asm_slow_path_instance_of
 end
 
+handler In
+    call_slow_path asm_slow_path_in
+end
+
+handler ConcatString
+    call_slow_path asm_slow_path_concat_string
+end
+
+handler NewFunction
+    call_slow_path asm_slow_path_new_function
+end
+
+handler CreateLexicalEnvironment
+    call_slow_path asm_slow_path_create_lexical_environment
+end
+
+handler CallWithArgumentArray
+    call_slow_path asm_slow_path_call_with_argument_array
+end
+
+handler GetByValueWithThis
+    call_slow_path asm_slow_path_get_by_value_with_this
+end
+
+handler PutByIdWithThis
+    call_slow_path asm_slow_path_put_by_id_with_this
+end
+
+handler GetMethod
+    call_slow_path asm_slow_path_get_method
+end
+
+handler GetIterator
+    call_slow_path asm_slow_path_get_iterator
+end
+
+handler IteratorNext
+    call_slow_path asm_slow_path_iterator_next
+end
+
+handler IteratorNextUnpack
+    call_slow_path asm_slow_path_iterator_next_unpack
+end
+
 # Fast path: if this_value register is already cached (non-empty), skip the slow path.
 handler ResolveThisBinding
     temp this_value, empty
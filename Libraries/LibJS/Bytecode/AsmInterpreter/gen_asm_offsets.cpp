@@ -176,6 +176,13 @@ int main()
     EMIT_OFFSET(VM_STACK_INFO, VM, m_stack_info);
     EMIT_OFFSET(VM_EXECUTION_GENERATION, VM, m_execution_generation);
     outln("const VM_INTERPRETER_STACK_TOP = {}", offsetof(VM, m_interpreter_stack) + offsetof(InterpreterStack, m_top));
+    outln("const VM_CACHED_STRINGS_NUMBER = {}", offsetof(VM, cached_strings) + offsetof(decltype(VM::cached_strings), number));
+    outln("const VM_CACHED_STRINGS_UNDEFINED = {}", offsetof(VM, cached_strings) + offsetof(decltype(VM::cached_strings), undefined));
+    outln("const VM_CACHED_STRINGS_OBJECT = {}", offsetof(VM, cached_strings) + offsetof(decltype(VM::cached_strings), object));
+    outln("const VM_CACHED_STRINGS_STRING = {}", offsetof(VM, cached_strings) + offsetof(decltype(VM::cached_strings), string));
+    outln("const VM_CACHED_STRINGS_SYMBOL = {}", offsetof(VM, cached_strings) + offsetof(decltype(VM::cached_strings), symbol));
+    outln("const VM_CACHED_STRINGS_BOOLEAN = {}", offsetof(VM, cached_strings) + offsetof(decltype(VM::cached_strings), boolean));
+    outln("const VM_CACHED_STRINGS_BIGINT = {}", offsetof(VM, cached_strings) + offsetof(decltype(VM::cached_strings), bigint));
 #if defined(HAS_ADDRESS_SANITIZER)
     outln("const VM_STACK_SPACE_LIMIT = {}", 96 * KiB);
 #else
@@ -396,6 +403,7 @@ int main()
     // Shifted value constants
     outln("\n# Shifted value constants");
     outln("const OBJECT_TAG_SHIFTED = 0x{:X}", static_cast<u64>(OBJECT_TAG << GC::TAG_SHIFT));
+    outln("const STRING_TAG_SHIFTED = 0x{:X}", static_cast<u64>(STRING_TAG << GC::TAG_SHIFT));
     outln("const EMPTY_VALUE = 0x{:X}", static_cast<u64>(EMPTY_TAG << GC::TAG_SHIFT));
     outln("const INT32_TAG_SHIFTED = 0x{:X}", static_cast<u64>(INT32_TAG << GC::TAG_SHIFT));
     outln("const BOOLEAN_TRUE = 0x{:X}", static_cast<u64>((BOOLEAN_TAG << GC::TAG_SHIFT) | 1));
@@ -5,6 +5,7 @@
  */
 
 #include <AK/BinarySearch.h>
+#include <AK/Debug.h>
 #include <AK/NeverDestroyed.h>
 #include <AK/NumericLimits.h>
 #include <AK/QuickSort.h>
@@ -20,6 +21,7 @@
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ExternalMemory.h>
 #include <LibJS/Runtime/SharedFunctionInstanceData.h>
+#include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/Value.h>
 #include <LibJS/SourceCode.h>
 
@@ -172,6 +174,12 @@ ReadonlySpan<PropertyLookupCache::Entry> PropertyLookupCache::entries() const
     return {};
 }
 
+bool PropertyLookupCache::is_saturated() const
+{
+    auto const* data = polymorphic_data();
+    return data && data->entries[max_number_of_shapes_to_remember - 1].type != Entry::Type::Empty;
+}
+
 size_t PropertyLookupCache::external_memory_size() const
 {
     if (monomorphic_data())
@@ -674,6 +682,69 @@ void StaticPropertyLookupCache::sweep_all()
     }
 }
 
+MegamorphicPropertyLookupCache& MegamorphicPropertyLookupCache::the()
+{
+    static NeverDestroyed<MegamorphicPropertyLookupCache> cache;
+    return *cache;
+}
+
+size_t MegamorphicPropertyLookupCache::slot_index(Shape const& shape, PropertyKey const& property_key)
+{
+    return pair_int_hash(ptr_hash(&shape), Traits<PropertyKey>::hash(property_key)) & (capacity - 1);
+}
+
+PropertyLookupCache::Entry const* MegamorphicPropertyLookupCache::find(Shape const& shape, PropertyKey const& property_key)
+{
+    auto const& slot = m_slots[slot_index(shape, property_key)];
+
+    auto is_usable = [&] {
+        if (slot.entry.shape.ptr() != &shape || !slot.property_key.has_value() || *slot.property_key != property_key)
+            return false;
+        if (slot.entry.type == PropertyLookupCache::Entry::Type::GetOwnProperty)
+            return true;
+        if (slot.entry.type != PropertyLookupCache::Entry::Type::GetPropertyInPrototypeChain || !slot.entry.prototype)
+            return false;
+        auto const* prototype_chain_validity = slot.entry.prototype_chain_validity.ptr();
+        return prototype_chain_validity && prototype_chain_validity->is_valid();
+    }();
+
+    if constexpr (JS_BYTECODE_DEBUG) {
+        if (is_usable)
+            ++m_hits;
+        else
+            ++m_misses;
+    }
+
+    return is_usable ? &slot.entry : nullptr;
+}
+
+void MegamorphicPropertyLookupCache::insert(Shape const& shape, PropertyKey const& property_key, PropertyLookupCache::Entry const& entry)
+{
+    // Dictionary shapes change in place, so an entry for one would need its generation checked on every probe.
+    if (shape.is_dictionary())
+        return;
+
+    auto& slot = m_slots[slot_index(shape, property_key)];
+    slot.entry = entry;
+    slot.property_key = property_key;
+}
+
+void MegamorphicPropertyLookupCache::remove_dead_cells()
+{
+    for (auto& slot : m_slots) {
+        if (!slot.property_key.has_value())
+            continue;
+
+        clear_cache_entry_if_dead(slot.entry);
+
+        // Symbol keys are compared by address, so one that died must not be matched by a new symbol in its cell.
+        auto key_is_dead = slot.property_key->is_symbol() && cell_is_dead(slot.property_key->as_symbol());
+        auto prototype_is_dead = slot.entry.type == PropertyLookupCache::Entry::Type::GetPropertyInPrototypeChain && !slot.entry.prototype;
+        if (!slot.entry.shape || key_is_dead || prototype_is_dead)
+            slot = {};
+    }
+}
+
 void Executable::remove_dead_cells(Badge<GC::Heap>)
 {
     for (auto& cache : property_lookup_caches) {
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
@@ -100,6 +101,9 @@ struct PropertyLookupCache {
     [[nodiscard]] size_t external_memory_size() const;
     void copy_from(PropertyLookupCache const&);
 
+    // True once every polymorphic slot is in use, i.e. the next new shape will evict one.
+    [[nodiscard]] bool is_saturated() const;
+
     void update(Entry::Type type, auto callback)
     {
         Entry new_entry;
@@ -164,6 +168,37 @@ struct StaticPropertyLookupCache : public PropertyLookupCache {
     static void sweep_all();
 };
 
+// A global, direct-mapped cache keyed by (shape, property key), consulted by get-by-id sites whose own cache is
+// saturated, in the spirit of V8's stub cache. A collision simply overwrites the older entry, and entries are validated
+// the same way a site's own entries are, so a stale one only ever costs a miss.
+class MegamorphicPropertyLookupCache {
+public:
+    static constexpr size_t capacity = 2048;
+
+    static MegamorphicPropertyLookupCache& the();
+
+    [[nodiscard]] PropertyLookupCache::Entry const* find(Shape const&, PropertyKey const&);
+    void insert(Shape const&, PropertyKey const&, PropertyLookupCache::Entry const&);
+    void remove_dead_cells();
+
+    [[nodiscard]] u64 hits() const { return m_hits; }
+    [[nodiscard]] u64 misses() const { return m_misses; }
+
+private:
+    struct Slot {
+        PropertyLookupCache::Entry entry;
+        Optional<PropertyKey> property_key;
+    };
+
+    static size_t slot_index(Shape const&, PropertyKey const&);
+
+    Array<Slot, capacity> m_slots;
+
+    // Only counted in JS_BYTECODE_DEBUG builds.
+    u64 m_hits { 0 };
+    u64 m_misses { 0 };
+};
+
 struct GlobalVariableCache {
     PropertyLookupCache::Entry* first_entry()
     {
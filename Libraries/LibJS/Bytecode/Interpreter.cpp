@@ -877,6 +877,12 @@ ThrowCompletionOr<Value> VM::run_executable(ExecutionContext& context, Executabl
     run_bytecode(entry_point);
 
     dbgln_if(JS_BYTECODE_DEBUG, "VM did run bytecode unit {}", context.executable);
+    if constexpr (JS_BYTECODE_DEBUG) {
+        if (is_outermost_bytecode_execution) {
+            auto const& megamorphic_cache = MegamorphicPropertyLookupCache::the();
+            dbgln("Megamorphic property cache: {} hits, {} misses", megamorphic_cache.hits(), megamorphic_cache.misses());
+        }
+    }
 
     if constexpr (JS_BYTECODE_DEBUG) {
         auto* values = context.registers_and_constants_and_locals_and_arguments();
@@ -14,6 +14,7 @@
 #include <LibJS/Runtime/Completion.h>
 #include <LibJS/Runtime/ECMAScriptFunctionObject.h>
 #include <LibJS/Runtime/FunctionObject.h>
+#include <LibJS/Runtime/NativeFunction.h>
 #include <LibJS/Runtime/PrimitiveString.h>
 #include <LibJS/Runtime/Shape.h>
 #include <LibJS/Runtime/VM.h>
@@ -38,6 +39,16 @@ ALWAYS_INLINE ThrowCompletionOr<Value> get_cached_property_value(VM& vm, Value v
     auto* getter = value.as_accessor().getter();
     if (!getter)
         return js_undefined();
+
+    // OPTIMIZATION: Getters with a fast entry point (e.g. generated DOM attribute getters) don't need an execution
+    //               context of their own, as long as they would run in the realm that is already current.
+    if (auto* native_getter = as_if<RawNativeFunction>(*getter); native_getter && native_getter->fast_getter()) {
+        if (native_getter->realm() == vm.current_realm()) [[likely]] {
+            if (auto result = TRY(native_getter->fast_getter()(vm, this_value)); result.has_value())
+                return result.release_value();
+        }
+    }
+
     return TRY(call(vm, *getter, this_value));
 }
 
@@ -157,6 +168,17 @@ ALWAYS_INLINE ThrowCompletionOr<Value> get_by_id(VM& vm, GetBaseIdentifier get_b
             }
         }
     }
+
+    // OPTIMIZATION: This site has seen more shapes than it can remember, so try the shared megamorphic cache.
+    auto site_is_megamorphic = cache.is_saturated();
+    if (site_is_megamorphic && !shape.is_dictionary()) {
+        if (auto const* cache_entry = MegamorphicPropertyLookupCache::the().find(shape, property_name)) {
+            auto* holder = cache_entry->prototype ? cache_entry->prototype.ptr() : base_obj.ptr();
+            auto value = holder->get_direct(cache_entry->property_offset);
+            return TRY(get_cached_property_value(vm, value, this_value));
+        }
+    }
+
     GC::Ptr<PrototypeChainValidity> prototype_chain_validity;
     if (shape.prototype())
         prototype_chain_validity = shape.prototype()->shape().prototype_chain_validity();
@@ -189,6 +211,9 @@ ALWAYS_INLINE ThrowCompletionOr<Value> get_by_id(VM& vm, GetBaseIdentifier get_b
                 }
             });
         }
+
+        if (site_is_megamorphic && cacheable_metadata.type != CacheableGetPropertyMetadata::Type::NotCacheable)
+            MegamorphicPropertyLookupCache::the().insert(shape, property_name, *cache.first_entry());
     }
 
     return value;
@@ -164,6 +164,7 @@ enum class ThisBindingStatus : u8 {
 
 class Accessor;
 class Agent;
+class AsyncFunctionDriverWrapper;
 struct AsyncGeneratorRequest;
 class BigInt;
 class BoundFunction;
@@ -207,6 +208,8 @@ class PropertyDescriptor;
 class PropertyKey;
 class Realm;
 class Reference;
+struct SampledFrame;
+class SamplingProfiler;
 class Script;
 class Shape;
 class SharedFunctionInstanceData;
@@ -312,6 +315,7 @@ template<typename T>
 requires(!IsLvalueReference<T>)
 class ThrowCompletionOr;
 using NativeFunctionPointer = ThrowCompletionOr<Value> (*)(VM&);
+using NativeFastGetterPointer = ThrowCompletionOr<Optional<Value>> (*)(VM&, Value this_value);
 
 namespace Bytecode {
 
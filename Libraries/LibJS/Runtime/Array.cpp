@@ -6,6 +6,8 @@
  */
 
 #include <AK/Function.h>
+#include <AK/RadixSort.h>
+#include <AK/StringBuilder.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayPrototype.h>
@@ -13,6 +15,8 @@
 #include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/NativeFunction.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/TimSort.h>
 #include <LibJS/Runtime/ValueInlines.h>
 
 namespace JS {
@@ -168,8 +172,153 @@ ThrowCompletionOr<bool> Array::set_length(PropertyDescriptor const& property_des
     return true;
 }
 
+// Keys that order Int32 values the way the default comparator orders their decimal strings. Bit 40 is set for
+// non-negative values, since "-" sorts before every digit. Below it, each digit of the magnitude takes a nibble, most
+// significant first and stored as digit + 1, and the nibbles past the last digit stay 0, so that a string sorts before
+// the longer strings it is a prefix of.
+static constexpr u64 int32_sort_key_non_negative_bit = 1ull << 40;
+static constexpr int int32_sort_key_first_digit_shift = 36;
+
+static u64 int32_sort_key(i32 value)
+{
+    auto magnitude = static_cast<u64>(value < 0 ? -static_cast<i64>(value) : value);
+
+    AK::Array<u8, 10> digits;
+    size_t digit_count = 0;
+    do {
+        digits[digit_count++] = magnitude % 10;
+        magnitude /= 10;
+    } while (magnitude > 0);
+
+    u64 key = value < 0 ? 0 : int32_sort_key_non_negative_bit;
+    auto shift = int32_sort_key_first_digit_shift;
+    for (size_t i = digit_count; i > 0; --i, shift -= 4)
+        key |= static_cast<u64>(digits[i - 1] + 1) << shift;
+    return key;
+}
+
+static i32 int32_from_sort_key(u64 key)
+{
+    i64 magnitude = 0;
+    for (auto shift = int32_sort_key_first_digit_shift; shift >= 0; shift -= 4) {
+        auto nibble = (key >> shift) & 0xf;
+        if (nibble == 0)
+            break;
+        magnitude = magnitude * 10 + static_cast<i64>(nibble - 1);
+    }
+    return static_cast<i32>((key & int32_sort_key_non_negative_bit) ? magnitude : -magnitude);
+}
+
+struct NumberSortKey {
+    // Long enough for any Number::toString(10) result, e.g. "-0.0000012345678901234567".
+    static constexpr size_t max_length = 25;
+
+    StringView string() const { return StringView { characters.span().trim(length) }; }
+
+    Value value;
+    AK::Array<u8, max_length> characters {};
+    u8 length { 0 };
+};
+
+struct StringSortKey {
+    Value value;
+    Utf16View string;
+};
+
+// OPTIMIZATION: The default SortCompare orders everything but undefined by ToString(x), which for arrays of only
+//               numbers or only strings can be computed once per element up front instead of twice per comparison.
+//               Int32s are encoded as integer keys and radix sorted, as equal keys mean identical values and the order
+//               among them can't be observed. Other numbers still need a stable sort, as e.g. -0 and +0 both become
+//               "0". Returns false, leaving items untouched, if they're not all numbers or all strings.
+static bool sort_with_default_sort_compare(GC::RootVector<Value>& items)
+{
+    bool all_int32 = true;
+    bool all_numbers = true;
+    bool all_strings = true;
+    size_t undefined_count = 0;
+    for (auto value : items) {
+        if (value.is_undefined()) {
+            ++undefined_count;
+            continue;
+        }
+        all_int32 = all_int32 && value.is_int32();
+        all_numbers = all_numbers && value.is_number();
+        all_strings = all_strings && value.is_string();
+        if (!all_numbers && !all_strings)
+            return false;
+    }
+
+    // CompareArrayElements sorts undefined after everything else, and all undefineds are alike.
+    if (undefined_count > 0) {
+        size_t defined_count = 0;
+        for (size_t i = 0; i < items.size(); ++i) {
+            if (!items[i].is_undefined())
+                items[defined_count++] = items[i];
+        }
+        for (size_t i = defined_count; i < items.size(); ++i)
+            items[i] = js_undefined();
+    }
+
+    auto values = items.span().trim(items.size() - undefined_count);
+    if (values.size() < 2)
+        return true;
+
+    if (all_int32) {
+        Vector<u64> keys;
+        keys.ensure_capacity(values.size());
+        for (auto value : values)
+            keys.unchecked_append(int32_sort_key(value.as_i32()));
+
+        Vector<u64> scratch;
+        scratch.resize(keys.size());
+        radix_sort(keys.span(), scratch.span());
+
+        for (size_t i = 0; i < keys.size(); ++i)
+            values[i] = Value(int32_from_sort_key(keys[i]));
+        return true;
+    }
+
+    auto sort_by_key = [&]<typename Key>(Vector<Key>& keys, auto const& less_than) {
+        Vector<Key> scratch;
+        scratch.resize(keys.size() / 2);
+        MUST(tim_sort(keys.span(), scratch.span(), less_than));
+
+        for (size_t i = 0; i < keys.size(); ++i)
+            values[i] = keys[i].value;
+    };
+
+    if (all_numbers) {
+        Vector<NumberSortKey> keys;
+        keys.ensure_capacity(values.size());
+        StringBuilder builder;
+        for (auto value : values) {
+            builder.clear();
+            number_to_string(builder, value.as_double());
+            auto string = builder.string_view();
+            VERIFY(string.length() <= NumberSortKey::max_length);
+
+            NumberSortKey key { .value = value, .length = static_cast<u8>(string.length()) };
+            string.bytes().copy_to(key.characters.span());
+            keys.unchecked_append(key);
+        }
+        sort_by_key(keys, [](NumberSortKey const& a, NumberSortKey const& b) -> ThrowCompletionOr<bool> {
+            return a.string() < b.string();
+        });
+        return true;
+    }
+
+    Vector<StringSortKey> keys;
+    keys.ensure_capacity(values.size());
+    for (auto value : values)
+        keys.unchecked_append({ value, value.as_string().utf16_string_view() });
+    sort_by_key(keys, [](StringSortKey const& a, StringSortKey const& b) -> ThrowCompletionOr<bool> {
+        return (a.string <=> b.string) < 0;
+    });
+    return true;
+}
+
 // 23.1.3.30.1 SortIndexedProperties ( obj, len, SortCompare, holes ), https://tc39.es/ecma262/#sec-sortindexedproperties
-ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM& vm, Object const& object, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes)
+ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM& vm, Object const& object, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes, SortCompareIsDefault sort_compare_is_default)
 {
     // 1. Let items be a new empty List.
     GC::RootVector<Value> items;
@@ -209,12 +358,11 @@ ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM& vm, Object
     }
 
     // 4. Sort items using an implementation-defined sequence of calls to SortCompare. If any such call returns an abrupt completion, stop before performing any further calls to SortCompare or steps in this algorithm and return that Completion Record.
+    if (sort_compare_is_default == SortCompareIsDefault::Yes && sort_with_default_sort_compare(items))
+        return items;
 
-    // Perform sorting by merge sort. This isn't as efficient compared to quick sort, but
-    // quicksort can't be used in all cases because the spec requires Array.prototype.sort()
-    // to be stable. FIXME: when initially scanning through the array, maintain a flag
-    // for if an unstable sort would be indistinguishable from a stable sort (such as just
-    // just strings or numbers), and in that case use quick sort instead for better performance.
+    // Sort by TimSort, a merge sort that takes advantage of runs already in the input, as the spec requires
+    // Array.prototype.sort() to be stable.
     TRY(array_merge_sort(vm, sort_compare, items));
 
     // 5. Return items.
@@ -94,7 +94,13 @@ enum class Holes {
     ReadThroughHoles,
 };
 
-ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes);
+// Whether SortCompare is CompareArrayElements without a comparefn, which lets SortIndexedProperties skip calling it.
+enum class SortCompareIsDefault {
+    No,
+    Yes,
+};
+
+ThrowCompletionOr<GC::RootVector<Value>> sort_indexed_properties(VM&, Object const&, size_t length, Function<ThrowCompletionOr<double>(Value, Value)> const& sort_compare, Holes holes, SortCompareIsDefault = SortCompareIsDefault::No);
 ThrowCompletionOr<double> compare_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
 
 }
@@ -7,9 +7,9 @@
 #include <AK/TypeCasts.h>
 #include <LibJS/Runtime/AsyncFunctionDriverWrapper.h>
 #include <LibJS/Runtime/GlobalObject.h>
-#include <LibJS/Runtime/NativeFunction.h>
 #include <LibJS/Runtime/PromiseCapability.h>
 #include <LibJS/Runtime/PromiseConstructor.h>
+#include <LibJS/Runtime/PromiseReaction.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Runtime/ValueInlines.h>
 
@@ -82,49 +82,22 @@ ThrowCompletionOr<void> AsyncFunctionDriverWrapper::await(JS::Value value)
 
     // 3. Let fulfilledClosure be a new Abstract Closure with parameters (v) that captures asyncContext and performs the
     //    following steps when called:
+    // 4. Let onFulfilled be CreateBuiltinFunction(fulfilledClosure, 1, "", « »).
     // 5. Let rejectedClosure be a new Abstract Closure with parameters (reason) that captures asyncContext and performs the
     //    following steps when called:
-    // OPTIMIZATION: onRejected and onFulfilled are identical other than the resumption value passed to continue_async_execution.
-    //               To avoid allocated two GC functions down this path, we combine both callbacks into one function.
-    auto settled_closure = [this](VM& vm) -> ThrowCompletionOr<Value> {
-        auto reason = vm.argument(0);
-
-        // The currently awaited promise is settled when this reaction runs, so we can use
-        // its state to decide whether to resume with a normal or throw completion.
-        VERIFY(m_current_promise);
-        auto is_successful = m_current_promise->state() == Promise::State::Fulfilled;
-        VERIFY(is_successful || m_current_promise->state() == Promise::State::Rejected);
-
-        // a. Let prevContext be the running execution context.
-        auto& prev_context = vm.running_execution_context();
-
-        // b. Suspend prevContext.
-        // c. Push asyncContext onto the execution context stack; asyncContext is now the running execution context.
-        TRY(vm.push_execution_context(*m_suspended_execution_context, {}));
-
-        // 3.d. Resume the suspended evaluation of asyncContext using NormalCompletion(v) as the result of the operation that
-        //      suspended it.
-        // 5.d. Resume the suspended evaluation of asyncContext using ThrowCompletion(reason) as the result of the operation that
-        //      suspended it.
-        continue_async_execution(vm, reason, is_successful);
-        vm.pop_execution_context();
-
-        // e. Assert: When we reach this step, asyncContext has already been removed from the execution context stack and
-        //    prevContext is the currently running execution context.
-        VERIFY(&vm.running_execution_context() == &prev_context);
-
-        // f. Return undefined.
-        return js_undefined();
-    };
-
-    // 4. Let onFulfilled be CreateBuiltinFunction(fulfilledClosure, 1, "", « »).
     // 6. Let onRejected be CreateBuiltinFunction(rejectedClosure, 1, "", « »).
-    if (!m_on_settled)
-        m_on_settled = NativeFunction::create(realm, move(settled_closure), 1);
+    // OPTIMIZATION: onFulfilled and onRejected are never observable, and only resume this async function with a normal or
+    //               throw completion. Instead of creating them, the reactions refer to this async function directly, so
+    //               that their jobs can resume it without calling anything. They carry no state of their own, so they
+    //               are created once and added to every promise this async function awaits. See schedule_resume() for
+    //               the steps of the closures.
+    if (!m_fulfill_reaction) {
+        m_fulfill_reaction = PromiseReaction::create_for_await(vm, PromiseReaction::Type::Fulfill, *this);
+        m_reject_reaction = PromiseReaction::create_for_await(vm, PromiseReaction::Type::Reject, *this);
+    }
 
     // 7. Perform PerformPromiseThen(promise, onFulfilled, onRejected).
-    m_current_promise = as<Promise>(promise_object);
-    m_current_promise->perform_then(m_on_settled, m_on_settled, {});
+    as<Promise>(*promise_object).perform_then_with_reactions(*m_fulfill_reaction, *m_reject_reaction);
 
     // NOTE: None of these are necessary. 8-12 are handled by step d of the above lambdas.
     // 8. Remove asyncContext from the execution context stack and restore the execution context that is at the top of the
@@ -139,14 +112,43 @@ ThrowCompletionOr<void> AsyncFunctionDriverWrapper::await(JS::Value value)
 void AsyncFunctionDriverWrapper::schedule_resume(Value value, bool is_fulfilled)
 {
     auto& vm = this->vm();
-    vm.host_enqueue_promise_job(
-        GC::create_function(vm.heap(), [this, value, is_fulfilled, &vm]() -> ThrowCompletionOr<Value> {
+
+    // OPTIMIZATION: An async function is suspended at no more than one await at a time, so a single job that resumes it
+    //               with the completion it was last scheduled with serves every await.
+    VERIFY(!m_has_scheduled_resume);
+    m_has_scheduled_resume = true;
+    m_resume_value = value;
+    m_resume_is_fulfilled = is_fulfilled;
+
+    if (!m_resume_job) {
+        m_resume_job = GC::create_function(vm.heap(), [this, &vm]() -> ThrowCompletionOr<Value> {
+            m_has_scheduled_resume = false;
+            auto value = exchange(m_resume_value, js_undefined());
+
+            // a. Let prevContext be the running execution context.
+            auto& prev_context = vm.running_execution_context();
+
+            // b. Suspend prevContext.
+            // c. Push asyncContext onto the execution context stack; asyncContext is now the running execution context.
             TRY(vm.push_execution_context(*m_suspended_execution_context, {}));
-            continue_async_execution(vm, value, is_fulfilled);
+
+            // 3.d. Resume the suspended evaluation of asyncContext using NormalCompletion(v) as the result of the operation
+            //      that suspended it.
+            // 5.d. Resume the suspended evaluation of asyncContext using ThrowCompletion(reason) as the result of the
+            //      operation that suspended it.
+            continue_async_execution(vm, value, m_resume_is_fulfilled);
             vm.pop_execution_context();
+
+            // e. Assert: When we reach this step, asyncContext has already been removed from the execution context stack
+            //    and prevContext is the currently running execution context.
+            VERIFY(&vm.running_execution_context() == &prev_context);
+
+            // f. Return undefined.
             return js_undefined();
-        }),
-        vm.current_realm());
+        });
+    }
+
+    vm.host_enqueue_promise_job(*m_resume_job, &shape().realm());
 }
 
 void AsyncFunctionDriverWrapper::continue_async_execution(VM& vm, Value value, bool is_successful)
@@ -222,11 +224,12 @@ void AsyncFunctionDriverWrapper::visit_edges(Cell::Visitor& visitor)
     Base::visit_edges(visitor);
     visitor.visit(m_generator_object);
     visitor.visit(m_top_level_promise);
-    if (m_current_promise)
-        visitor.visit(m_current_promise);
     if (m_suspended_execution_context)
         m_suspended_execution_context->visit_edges(visitor);
-    visitor.visit(m_on_settled);
+    visitor.visit(m_fulfill_reaction);
+    visitor.visit(m_reject_reaction);
+    visitor.visit(m_resume_job);
+    visitor.visit(m_resume_value);
 }
 
 }
@@ -33,10 +33,18 @@ private:
 
     GC::Ref<GeneratorObject> m_generator_object;
     GC::Ref<Promise> m_top_level_promise;
-    GC::Ptr<Promise> m_current_promise { nullptr };
     OwnPtr<ExecutionContext> m_suspended_execution_context;
 
-    GC::Ptr<NativeFunction> m_on_settled;
+    // The reactions that every await on a pending promise adds to it.
+    GC::Ptr<PromiseReaction> m_fulfill_reaction;
+    GC::Ptr<PromiseReaction> m_reject_reaction;
+
+    // The job that resumes this async function, and the completion it resumes it with.
+    GC::Ptr<GC::Function<ThrowCompletionOr<Value>()>> m_resume_job;
+    Value m_resume_value;
+    bool m_resume_is_fulfilled { false };
+    bool m_has_scheduled_resume { false };
+
     bool m_is_initial_execution { true };
 };
 
@@ -90,10 +90,13 @@ JS_DEFINE_NATIVE_FUNCTION(BigIntPrototype::to_locale_string)
     auto bigint = TRY(this_bigint_value(vm, vm.this_value()));
 
     // 2. Let numberFormat be ? Construct(%NumberFormat%, « locales, options »).
-    auto* number_format = static_cast<Intl::NumberFormat*>(TRY(construct(vm, realm.intrinsics().intl_number_format_constructor(), locales, options)).ptr());
+    // OPTIMIZATION: Reuse the NumberFormat from an earlier call with the same locales if there are no options.
+    auto number_format = TRY(realm.intrinsics().cached_intl_object(Intrinsics::IntlObjectKind::NumberFormat, locales, options, [&]() -> ThrowCompletionOr<GC::Ref<Object>> {
+        return construct(vm, realm.intrinsics().intl_number_format_constructor(), locales, options);
+    }));
 
     // 3. Return ? FormatNumeric(numberFormat, x).
-    auto formatted = Intl::format_numeric(*number_format, Value(bigint));
+    auto formatted = Intl::format_numeric(static_cast<Intl::NumberFormat&>(*number_format), Value(bigint));
     return PrimitiveString::create(vm, move(formatted));
 }
 
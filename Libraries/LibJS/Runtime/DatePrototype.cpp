@@ -1004,10 +1004,13 @@ JS_DEFINE_NATIVE_FUNCTION(DatePrototype::to_locale_date_string)
         return PrimitiveString::create(vm, "Invalid Date"_string);
 
     // 3. Let dateFormat be ? CreateDateTimeFormat(%DateTimeFormat%, locales, options, "date", "date").
-    auto date_format = TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Date, Intl::OptionDefaults::Date));
+    // OPTIMIZATION: Reuse the DateTimeFormat from an earlier call with the same locales if there are no options.
+    auto date_format = TRY(realm.intrinsics().cached_intl_object(Intrinsics::IntlObjectKind::DateFormat, locales, options, [&]() -> ThrowCompletionOr<GC::Ref<Object>> {
+        return TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Date, Intl::OptionDefaults::Date));
+    }));
 
     // 4. Return ? FormatDateTime(dateFormat, x).
-    auto formatted = TRY(Intl::format_date_time(vm, date_format, time));
+    auto formatted = TRY(Intl::format_date_time(vm, static_cast<Intl::DateTimeFormat&>(*date_format), time));
     return PrimitiveString::create(vm, move(formatted));
 }
 
@@ -1028,10 +1031,13 @@ JS_DEFINE_NATIVE_FUNCTION(DatePrototype::to_locale_string)
         return PrimitiveString::create(vm, "Invalid Date"_string);
 
     // 3. Let dateFormat be ? CreateDateTimeFormat(%DateTimeFormat%, locales, options, "any", "all").
-    auto date_format = TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Any, Intl::OptionDefaults::All));
+    // OPTIMIZATION: Reuse the DateTimeFormat from an earlier call with the same locales if there are no options.
+    auto date_format = TRY(realm.intrinsics().cached_intl_object(Intrinsics::IntlObjectKind::DateTimeFormat, locales, options, [&]() -> ThrowCompletionOr<GC::Ref<Object>> {
+        return TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Any, Intl::OptionDefaults::All));
+    }));
 
     // 4. Return ? FormatDateTime(dateFormat, x).
-    auto formatted = TRY(Intl::format_date_time(vm, date_format, time));
+    auto formatted = TRY(Intl::format_date_time(vm, static_cast<Intl::DateTimeFormat&>(*date_format), time));
     return PrimitiveString::create(vm, move(formatted));
 }
 
@@ -1052,10 +1058,13 @@ JS_DEFINE_NATIVE_FUNCTION(DatePrototype::to_locale_time_string)
         return PrimitiveString::create(vm, "Invalid Date"_string);
 
     // 3. Let timeFormat be ? CreateDateTimeFormat(%DateTimeFormat%, locales, options, "time", "time").
-    auto time_format = TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Time, Intl::OptionDefaults::Time));
+    // OPTIMIZATION: Reuse the DateTimeFormat from an earlier call with the same locales if there are no options.
+    auto time_format = TRY(realm.intrinsics().cached_intl_object(Intrinsics::IntlObjectKind::TimeFormat, locales, options, [&]() -> ThrowCompletionOr<GC::Ref<Object>> {
+        return TRY(Intl::create_date_time_format(vm, realm.intrinsics().intl_date_time_format_constructor(), locales, options, Intl::OptionRequired::Time, Intl::OptionDefaults::Time));
+    }));
 
     // 4. Return ? FormatDateTime(timeFormat, x).
-    auto formatted = TRY(Intl::format_date_time(vm, time_format, time));
+    auto formatted = TRY(Intl::format_date_time(vm, static_cast<Intl::DateTimeFormat&>(*time_format), time));
     return PrimitiveString::create(vm, move(formatted));
 }
 
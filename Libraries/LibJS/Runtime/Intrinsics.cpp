@@ -31,6 +31,7 @@
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/DataViewConstructor.h>
 #include <LibJS/Runtime/DataViewPrototype.h>
+#include <LibJS/Runtime/Date.h>
 #include <LibJS/Runtime/DateConstructor.h>
 #include <LibJS/Runtime/DatePrototype.h>
 #include <LibJS/Runtime/DisposableStackConstructor.h>
@@ -203,11 +204,20 @@ GC::Ref<Intrinsics> Intrinsics::create(Realm& realm)
     return *intrinsics;
 }
 
-static Vector<GC::Root<SharedFunctionInstanceData>> parse_builtin_file(unsigned char const* script_text, VM& vm)
+// Each builtin file defines several functions, which are looked up one at a time as realms first need them. Compiling
+// the file once per VM rather than once per lookup keeps that from being repeated for every function in every realm.
+static Vector<GC::Ref<SharedFunctionInstanceData>> const& parse_builtin_file(unsigned char const* script_text, VM& vm)
 {
-    auto rust_compilation = RustIntegration::compile_builtin_file(script_text, vm);
-    VERIFY(rust_compilation.has_value());
-    return move(rust_compilation.value());
+    return vm.compiled_builtin_files().ensure(script_text, [&] {
+        auto rust_compilation = RustIntegration::compile_builtin_file(script_text, vm);
+        VERIFY(rust_compilation.has_value());
+
+        Vector<GC::Ref<SharedFunctionInstanceData>> shared_data_list;
+        shared_data_list.ensure_capacity(rust_compilation->size());
+        for (auto const& shared_data : *rust_compilation)
+            shared_data_list.unchecked_append(*shared_data);
+        return shared_data_list;
+    });
 }
 
 void Intrinsics::initialize_intrinsics(Realm& realm)
@@ -524,7 +534,8 @@ void Intrinsics::visit_edges(Visitor& visitor)
     JS_ENUMERATE_ITERATOR_PROTOTYPES
 #undef __JS_ENUMERATE
 
-    visitor.visit(m_default_collator);
+    for (auto& entry : m_intl_object_cache)
+        visitor.visit(entry.object);
 
 #define __JS_ENUMERATE(snake_name, functionName, length) \
     visitor.visit(m_##snake_name##_abstract_operation_function);
@@ -537,19 +548,52 @@ void Intrinsics::visit_edges(Visitor& visitor)
 #undef __JS_ENUMERATE
 }
 
-GC::Ref<Intl::Collator> Intrinsics::default_collator()
+ThrowCompletionOr<GC::Ref<Object>> Intrinsics::cached_intl_object(IntlObjectKind kind, Value locales, Value options, Function<ThrowCompletionOr<GC::Ref<Object>>()> const& create)
 {
-    if (!m_default_collator) {
-        m_default_collator = as<Intl::Collator>(*MUST(construct(this->vm(), intl_collator_constructor(), js_undefined(), js_undefined())));
+    if (!options.is_undefined() || !(locales.is_undefined() || locales.is_string()))
+        return create();
+
+    Optional<String> locales_key;
+    if (locales.is_string())
+        locales_key = locales.as_string().utf8_string();
+
+    // Date and time formats resolve the system time zone when they are created, which may have changed since.
+    Optional<String> time_zone;
+    if (kind == IntlObjectKind::DateTimeFormat || kind == IntlObjectKind::DateFormat || kind == IntlObjectKind::TimeFormat)
+        time_zone = system_time_zone_identifier();
+
+    for (size_t i = 0; i < m_intl_object_cache.size(); ++i) {
+        auto& entry = m_intl_object_cache[i];
+        if (entry.kind != kind || entry.locales != locales_key)
+            continue;
+
+        if (entry.time_zone != time_zone) {
+            m_intl_object_cache.remove(i);
+            break;
+        }
+
+        auto object = entry.object;
+        if (i != m_intl_object_cache.size() - 1) {
+            auto hit = m_intl_object_cache.take(i);
+            m_intl_object_cache.append(move(hit));
+        }
+        return object;
     }
-    return *m_default_collator;
+
+    auto object = TRY(create());
+
+    if (m_intl_object_cache.size() == intl_object_cache_capacity)
+        m_intl_object_cache.remove(0);
+    m_intl_object_cache.append({ kind, move(locales_key), move(time_zone), object });
+
+    return object;
 }
 
 #define __JS_ENUMERATE(snake_name, functionName, length)                                                                                                                                                        \
     GC::Ref<NativeJavaScriptBackedFunction> Intrinsics::snake_name##_abstract_operation_function()                                                                                                              \
     {                                                                                                                                                                                                           \
         if (!m_##snake_name##_abstract_operation_function) {                                                                                                                                                    \
-            auto shared_data_list = parse_builtin_file(ABSTRACT_OPERATIONS, m_realm->vm());                                                                                                                     \
+            auto const& shared_data_list = parse_builtin_file(ABSTRACT_OPERATIONS, m_realm->vm());                                                                                                              \
             auto it = shared_data_list.find_if([](auto const& shared_data) {                                                                                                                                    \
                 return shared_data->m_name == #functionName##sv;                                                                                                                                                \
             });                                                                                                                                                                                                 \
@@ -565,7 +609,7 @@ JS_ENUMERATE_NATIVE_JAVASCRIPT_BACKED_ABSTRACT_OPERATIONS
     GC::Ref<NativeJavaScriptBackedFunction> Intrinsics::snake_name##_array_constructor_function()                                                                                                              \
     {                                                                                                                                                                                                          \
         if (!m_##snake_name##_array_constructor_function) {                                                                                                                                                    \
-            auto shared_data_list = parse_builtin_file(ARRAY_CONSTRUCTOR, m_realm->vm());                                                                                                                      \
+            auto const& shared_data_list = parse_builtin_file(ARRAY_CONSTRUCTOR, m_realm->vm());                                                                                                               \
             auto it = shared_data_list.find_if([](auto const& shared_data) {                                                                                                                                   \
                 return shared_data->m_name == #functionName##sv;                                                                                                                                               \
             });                                                                                                                                                                                                \
@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include <AK/String.h>
+#include <AK/Vector.h>
 #include <LibGC/CellAllocator.h>
+#include <LibGC/Ptr.h>
 #include <LibJS/Export.h>
 #include <LibJS/Forward.h>
 #include <LibJS/Heap/Cell.h>
@@ -141,7 +144,19 @@ public:
     JS_ENUMERATE_ITERATOR_PROTOTYPES
 #undef __JS_ENUMERATE
 
-    [[nodiscard]] GC::Ref<Intl::Collator> default_collator();
+    // The Intl objects that String.prototype.localeCompare() and the toLocaleString() family construct on every call.
+    enum class IntlObjectKind : u8 {
+        Collator,
+        NumberFormat,
+        DateTimeFormat,
+        DateFormat,
+        TimeFormat,
+    };
+
+    // Calls `create` to construct an Intl object from `locales` and `options`, or returns one created earlier by a call
+    // with the same arguments. Only calls without options whose locales are undefined or a string are cached, as reading
+    // an options object or a list of locales is observable.
+    ThrowCompletionOr<GC::Ref<Object>> cached_intl_object(IntlObjectKind, Value locales, Value options, Function<ThrowCompletionOr<GC::Ref<Object>>()> const& create);
 
 #define __JS_ENUMERATE(snake_name, functionName, length) \
     GC::Ref<NativeJavaScriptBackedFunction> snake_name##_abstract_operation_function();
@@ -289,7 +304,17 @@ private:
     JS_ENUMERATE_NATIVE_JAVASCRIPT_BACKED_ARRAY_CONSTRUCTOR_FUNCTIONS
 #undef __JS_ENUMERATE
 
-    GC::Ptr<Intl::Collator> m_default_collator;
+    struct CachedIntlObject {
+        IntlObjectKind kind;
+        Optional<String> locales;
+        // The system time zone that a date and time format was created in, as it isn't part of the key.
+        Optional<String> time_zone;
+        GC::Ref<Object> object;
+    };
+    static constexpr size_t intl_object_cache_capacity = 16;
+
+    // Least recently used first.
+    Vector<CachedIntlObject> m_intl_object_cache;
 };
 
 void add_restricted_function_properties(FunctionObject&, Realm&);
@@ -25,29 +25,36 @@ Map::Map(Object& prototype)
 void Map::map_clear()
 {
     auto old_external_memory_size = external_memory_size();
-    m_keys.clear();
+
+    // Iterators carry on from the start of whatever gets added next.
+    if (m_next_compaction && m_next_compaction->ref_count() > 1) {
+        m_next_compaction->removed_all_below = m_entries.size();
+        m_next_compaction->next = adopt_ref(*new MapCompaction);
+        m_next_compaction = m_next_compaction->next;
+    }
+
     m_entries.clear();
+    m_buckets.clear();
+    m_size = 0;
     account_external_memory_change(old_external_memory_size);
 }
 
 // 24.1.3.3 Map.prototype.delete ( key ), https://tc39.es/ecma262/#sec-map.prototype.delete
 bool Map::map_remove(Value const& key)
 {
-    Optional<size_t> index;
-
-    for (auto it = m_keys.begin(); !it.is_end(); ++it) {
-        if (ValueTraits::equals(*it, key)) {
-            index = it.key();
-            break;
-        }
-    }
-
-    if (!index.has_value())
+    auto position = find_entry(key);
+    if (!position.has_value())
         return false;
 
     auto old_external_memory_size = external_memory_size();
-    m_keys.remove(*index);
-    m_entries.remove(key);
+
+    // NB: The bucket keeps pointing at the removed entry, which stands in for a tombstone until the next compaction.
+    m_entries[*position] = { js_special_empty_value(), js_special_empty_value() };
+    --m_size;
+
+    if (m_buckets.size() > minimum_bucket_count && m_size < m_buckets.size() / 8)
+        compact(m_buckets.size() / 2);
+
     account_external_memory_change(old_external_memory_size);
     return true;
 }
@@ -55,50 +62,150 @@ bool Map::map_remove(Value const& key)
 // 24.1.3.6 Map.prototype.get ( key ), https://tc39.es/ecma262/#sec-map.prototype.get
 Optional<Value> Map::map_get(Value const& key) const
 {
-    if (auto it = m_entries.find(key); it != m_entries.end())
-        return it->value;
+    if (auto position = find_entry(key); position.has_value())
+        return m_entries[*position].value;
     return {};
 }
 
 // 24.1.3.7 Map.prototype.has ( key ), https://tc39.es/ecma262/#sec-map.prototype.has
 bool Map::map_has(Value const& key) const
 {
-    return m_entries.contains(key);
+    return find_entry(key).has_value();
 }
 
 // 24.1.3.9 Map.prototype.set ( key, value ), https://tc39.es/ecma262/#sec-map.prototype.set
 void Map::map_set(Value const& key, Value value)
 {
-    auto it = m_entries.find(key);
-    if (it != m_entries.end()) {
-        it->value = value;
-    } else {
-        auto old_external_memory_size = external_memory_size();
-        auto index = m_next_insertion_id++;
-        m_keys.insert(index, key);
-        m_entries.set(key, value);
-        account_external_memory_change(old_external_memory_size);
+    if (auto position = find_entry(key); position.has_value()) {
+        m_entries[*position].value = value;
+        return;
     }
+
+    auto old_external_memory_size = external_memory_size();
+
+    if (m_buckets.is_empty()) {
+        compact(minimum_bucket_count);
+    } else if (m_entries.size() >= m_buckets.size() / 2) {
+        // Compacting in place is enough if at least half of the entries have been removed, which also means that a
+        // compaction only ever happens after as many insertions or removals as there are entries.
+        auto bucket_count = m_buckets.size();
+        if (m_size >= m_entries.size() / 2)
+            bucket_count *= 2;
+        compact(bucket_count);
+    }
+
+    VERIFY(m_entries.size() < empty_bucket);
+    m_entries.unchecked_append({ key, value });
+    insert_into_bucket(m_entries.size() - 1);
+    ++m_size;
+
+    account_external_memory_change(old_external_memory_size);
 }
 
 size_t Map::map_size() const
 {
-    return m_keys.size();
+    return m_size;
+}
+
+void Map::map_copy_entries_from(Map const& other)
+{
+    VERIFY(m_entries.is_empty());
+
+    auto old_external_memory_size = external_memory_size();
+
+    // NB: The buckets point at positions in the entries, so both are copied as they are, removed entries included.
+    m_entries = other.m_entries;
+    m_buckets = other.m_buckets;
+    m_size = other.m_size;
+    if (!m_buckets.is_empty())
+        m_entries.ensure_capacity(m_buckets.size() / 2);
+
+    account_external_memory_change(old_external_memory_size);
+}
+
+Optional<size_t> Map::find_entry(Value const& key) const
+{
+    if (m_buckets.is_empty())
+        return {};
+
+    auto mask = m_buckets.size() - 1;
+    for (size_t bucket = ValueTraits::hash(key) & mask;; bucket = (bucket + 1) & mask) {
+        auto position = m_buckets[bucket];
+        if (position == empty_bucket)
+            return {};
+        // NB: A removed entry has an empty key, which is never the same value as a key.
+        if (ValueTraits::equals(m_entries[position].key, key))
+            return position;
+    }
+}
+
+void Map::insert_into_bucket(size_t entry_position)
+{
+    auto mask = m_buckets.size() - 1;
+    auto bucket = ValueTraits::hash(m_entries[entry_position].key) & mask;
+
+    // A bucket pointing at a removed entry can be reused, as the key was looked up and not found before getting here.
+    while (m_buckets[bucket] != empty_bucket && !m_entries[m_buckets[bucket]].key.is_special_empty_value())
+        bucket = (bucket + 1) & mask;
+
+    m_buckets[bucket] = entry_position;
+}
+
+// Drops the removed entries and rebuilds the buckets, with room for half as many entries as there are buckets.
+void Map::compact(size_t bucket_count)
+{
+    VERIFY(is_power_of_two(bucket_count));
+
+    if (m_size != m_entries.size()) {
+        // Only iterators created since the last compaction refer to this one, and there's nothing to record if there
+        // are none.
+        auto record_removed_positions = m_next_compaction && m_next_compaction->ref_count() > 1;
+
+        size_t live_count = 0;
+        for (size_t position = 0; position < m_entries.size(); ++position) {
+            if (m_entries[position].key.is_special_empty_value()) {
+                if (record_removed_positions)
+                    m_next_compaction->removed_positions.append(position);
+                continue;
+            }
+            m_entries[live_count++] = m_entries[position];
+        }
+        m_entries.shrink(live_count, true);
+
+        if (record_removed_positions) {
+            m_next_compaction->next = adopt_ref(*new MapCompaction);
+            m_next_compaction = m_next_compaction->next;
+        }
+    }
+
+    auto maximum_entry_count = bucket_count / 2;
+    if (m_entries.capacity() > maximum_entry_count) {
+        Vector<Entry> entries;
+        entries.ensure_capacity(maximum_entry_count);
+        entries.extend(move(m_entries));
+        m_entries = move(entries);
+    } else {
+        m_entries.ensure_capacity(maximum_entry_count);
+    }
+
+    m_buckets.clear();
+    m_buckets.resize_with_default_value(bucket_count, empty_bucket);
+    for (size_t position = 0; position < m_entries.size(); ++position)
+        insert_into_bucket(position);
 }
 
-static size_t map_key_tree_external_memory_size(RedBlackTree<size_t, Value> const& keys)
+NonnullRefPtr<MapCompaction> Map::next_compaction() const
 {
-    constexpr auto approximate_node_size = sizeof(AK::BaseRedBlackTree<size_t>::Node) + sizeof(Value);
-    if (keys.size() > NumericLimits<size_t>::max() / approximate_node_size)
-        return NumericLimits<size_t>::max();
-    return keys.size() * approximate_node_size;
+    if (!m_next_compaction)
+        m_next_compaction = adopt_ref(*new MapCompaction);
+    return *m_next_compaction;
 }
 
 size_t Map::external_memory_size() const
 {
     auto size = Object::external_memory_size();
-    size = saturating_add_external_memory_size(size, map_key_tree_external_memory_size(m_keys));
-    size = saturating_add_external_memory_size(size, hash_map_external_memory_size(m_entries));
+    size = saturating_add_external_memory_size(size, vector_external_memory_size(m_entries));
+    size = saturating_add_external_memory_size(size, vector_external_memory_size(m_buckets));
     return size;
 }
 
@@ -114,12 +221,10 @@ void Map::account_external_memory_change(size_t old_external_memory_size)
 void Map::visit_edges(Cell::Visitor& visitor)
 {
     Base::visit_edges(visitor);
-    for (auto& value : m_entries) {
-        visitor.visit(value.key);
-        visitor.visit(value.value);
+    for (auto& entry : m_entries) {
+        visitor.visit(entry.key);
+        visitor.visit(entry.value);
     }
-    // NOTE: The entries in m_keys are already visited by the walk over m_entries above.
-    visitor.ignore(m_keys);
 }
 
 }
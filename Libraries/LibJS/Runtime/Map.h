@@ -6,8 +6,9 @@
 
 #pragma once
 
-#include <AK/HashMap.h>
-#include <AK/RedBlackTree.h>
+#include <AK/RefCounted.h>
+#include <AK/RefPtr.h>
+#include <AK/Vector.h>
 #include <LibJS/Export.h>
 #include <LibJS/Runtime/GlobalObject.h>
 #include <LibJS/Runtime/Object.h>
@@ -16,6 +17,36 @@
 
 namespace JS {
 
+// Compacting a Map's entries moves each entry down past the removed entries before it. An iterator holds on to the
+// compaction that was going to happen next when it last looked at the map, so it can work out where its position moved
+// to once that compaction has happened.
+struct MapCompaction : public RefCounted<MapCompaction> {
+    bool has_happened() const { return !next.is_null(); }
+
+    size_t position_after(size_t position) const
+    {
+        auto removed_count = min(position, removed_all_below);
+
+        // The number of removed positions below `position`.
+        size_t low = 0;
+        size_t high = removed_positions.size();
+        while (low < high) {
+            auto middle = low + (high - low) / 2;
+            if (removed_positions[middle] < position)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+        return position - removed_count - low;
+    }
+
+    RefPtr<MapCompaction> next;
+
+    // Sorted entry positions that were removed, or with all of the positions below `removed_all_below` removed at once.
+    Vector<u32> removed_positions;
+    size_t removed_all_below { 0 };
+};
+
 class JS_API Map : public Object {
     JS_OBJECT(Map, Object);
     GC_DECLARE_ALLOCATOR(Map);
@@ -34,8 +65,16 @@ public:
     void map_set(Value const&, Value);
     size_t map_size() const;
 
+    // Replaces the entries of this (empty) map with those of another, in the same order.
+    void map_copy_entries_from(Map const&);
+
     virtual size_t external_memory_size() const override;
 
+    struct Entry {
+        Value key;
+        Value value;
+    };
+
     struct EndIterator {
     };
 
@@ -43,8 +82,8 @@ public:
     struct IteratorImpl {
         bool is_end() const
         {
-            return m_map->m_keys.begin_from(m_index).is_end()
-                && m_map->m_keys.find_smallest_not_below_iterator(m_index).is_end();
+            ensure_next_element();
+            return m_index >= m_map->m_entries.size();
         }
 
         IteratorImpl& operator++()
@@ -56,13 +95,13 @@ public:
         decltype(auto) operator*()
         {
             ensure_next_element();
-            return *m_map->m_entries.find(*m_map->m_keys.begin_from(m_index));
+            return m_map->m_entries[m_index];
         }
 
         decltype(auto) operator*() const
         {
             ensure_next_element();
-            return *m_map->m_entries.find(*m_map->m_keys.begin_from(m_index));
+            return m_map->m_entries[m_index];
         }
 
         bool operator==(IteratorImpl const& other) const { return m_index == other.m_index && &m_map == &other.m_map; }
@@ -78,34 +117,31 @@ public:
         IteratorImpl(Map const& map)
         requires(IsConst)
             : m_map(map)
+            , m_compaction(map.next_compaction())
         {
-            ensure_index();
         }
 
         IteratorImpl(Map& map)
         requires(!IsConst)
             : m_map(map)
+            , m_compaction(map.next_compaction())
         {
-            ensure_index();
-        }
-
-        void ensure_index() const
-        {
-            if (m_map->m_keys.is_empty())
-                m_index = m_map->m_next_insertion_id;
-            else
-                m_index = m_map->m_keys.begin().key();
         }
 
         void ensure_next_element() const
         {
-            if (auto it = m_map->m_keys.find_smallest_not_below_iterator(m_index); it.is_end())
-                m_index = m_map->m_next_insertion_id;
-            else
-                m_index = it.key();
+            while (m_compaction->has_happened()) {
+                m_index = m_compaction->position_after(m_index);
+                m_compaction = *m_compaction->next;
+            }
+
+            auto const& entries = m_map->m_entries;
+            while (m_index < entries.size() && entries[m_index].key.is_special_empty_value())
+                ++m_index;
         }
 
         Conditional<IsConst, GC::Ref<Map const>, GC::Ref<Map>> m_map;
+        mutable NonnullRefPtr<MapCompaction> m_compaction;
         mutable size_t m_index { 0 };
     };
 
@@ -120,11 +156,25 @@ private:
     explicit Map(Object& prototype);
     virtual void visit_edges(Visitor& visitor) override;
 
+    static constexpr u32 empty_bucket = NumericLimits<u32>::max();
+    static constexpr size_t minimum_bucket_count = 8;
+
+    Optional<size_t> find_entry(Value const&) const;
+    void insert_into_bucket(size_t entry_position);
+    void compact(size_t bucket_count);
+    NonnullRefPtr<MapCompaction> next_compaction() const;
+
     void account_external_memory_change(size_t old_external_memory_size);
 
-    size_t m_next_insertion_id { 0 };
-    RedBlackTree<size_t, Value> m_keys;
-    HashMap<Value, Value, ValueTraits> m_entries;
+    // The entries in insertion order, as a deterministic hash table: removed entries keep their place (with an empty
+    // key) until the next compaction, so iteration is a walk along the vector.
+    Vector<Entry> m_entries;
+    // Open addressed with linear probing, holding positions in m_entries. There are always at least twice as many
+    // buckets as entries, and a bucket pointing at a removed entry simply never matches.
+    Vector<u32> m_buckets;
+    size_t m_size { 0 };
+
+    mutable RefPtr<MapCompaction> m_next_compaction;
 };
 
 template<>
@@ -80,11 +80,18 @@ public:
 
     NativeFunctionPointer native_function() const { return m_native_function; }
 
+    // An optional second entry point for getters, which is given the this value directly. Cached property accesses call
+    // it without setting up an execution context. It returns an empty Optional for a this value it can't handle, which
+    // leaves the access to the regular call.
+    NativeFastGetterPointer fast_getter() const { return m_fast_getter; }
+    void set_fast_getter(NativeFastGetterPointer fast_getter) { m_fast_getter = fast_getter; }
+
 private:
     RawNativeFunction(NativeFunctionPointer, Object* prototype, Realm& realm, Optional<Bytecode::Builtin> builtin);
     RawNativeFunction(Utf16FlyString name, NativeFunctionPointer, Object& prototype);
 
     NativeFunctionPointer m_native_function { nullptr };
+    NativeFastGetterPointer m_fast_getter { nullptr };
 };
 
 template<>
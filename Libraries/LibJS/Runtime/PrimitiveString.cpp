@@ -323,9 +323,40 @@ size_t PrimitiveString::length_in_utf16_code_units() const
 {
     if (m_deferred_kind == DeferredKind::Substring)
         return static_cast<Substring const&>(*this).m_code_unit_length;
+    if (m_deferred_kind == DeferredKind::Rope) {
+        if (auto length = static_cast<RopeString const&>(*this).m_length_in_utf16_code_units; length.has_value())
+            return *length;
+    }
     return utf16_string_view().length_in_code_units();
 }
 
+Optional<size_t> PrimitiveString::length_in_utf16_code_units_if_cheaply_known() const
+{
+    // Counting the code units of a UTF-8 string means reading all of it, which is only worth doing for short strings.
+    static constexpr size_t maximum_utf8_length_to_count = 64;
+
+    if (has_utf16_string())
+        return m_utf16_string->length_in_code_units();
+
+    switch (m_deferred_kind) {
+    case DeferredKind::Rope:
+        return static_cast<RopeString const&>(*this).m_length_in_utf16_code_units;
+    case DeferredKind::Substring:
+        return static_cast<Substring const&>(*this).m_code_unit_length;
+    case DeferredKind::None:
+        break;
+    }
+
+    auto string = m_utf8_string->bytes_as_string_view();
+    if (string.length() > maximum_utf8_length_to_count)
+        return {};
+
+    size_t length = 0;
+    for (auto code_point : Utf8View { string })
+        length += code_point > 0xffff ? 2 : 1;
+    return length;
+}
+
 bool PrimitiveString::operator==(PrimitiveString const& other) const
 {
     if (this == &other)
@@ -400,10 +431,10 @@ void RopeString::resolve(EncodingPreference preference) const
             continue;
         }
 
-        if (current->has_utf8_string())
-            approximate_length += current->utf8_string_view().length();
         if (preference == EncodingPreference::UTF16)
             length_in_utf16_code_units += current->length_in_utf16_code_units();
+        else
+            approximate_length += current->utf8_string_view().length();
         pieces.append(current);
     }
 
@@ -499,6 +530,10 @@ RopeString::RopeString(GC::Ref<PrimitiveString> lhs, GC::Ref<PrimitiveString> rh
     , m_lhs(lhs)
     , m_rhs(rhs)
 {
+    auto lhs_length = lhs->length_in_utf16_code_units_if_cheaply_known();
+    auto rhs_length = rhs->length_in_utf16_code_units_if_cheaply_known();
+    if (lhs_length.has_value() && rhs_length.has_value())
+        m_length_in_utf16_code_units = *lhs_length + *rhs_length;
 }
 
 RopeString::~RopeString() = default;
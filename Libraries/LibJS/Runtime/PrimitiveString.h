@@ -97,6 +97,7 @@ private:
     explicit PrimitiveString(String);
 
     void resolve_if_needed(EncodingPreference) const;
+    Optional<size_t> length_in_utf16_code_units_if_cheaply_known() const;
     Optional<StringView> short_flat_string_storage_view() const;
     static GC::Ptr<PrimitiveString> try_create_short_flat_concatenated_string(VM&, PrimitiveString const& lhs, PrimitiveString const& rhs);
 };
@@ -119,6 +120,10 @@ private:
 
     mutable GC::Ptr<PrimitiveString> m_lhs;
     mutable GC::Ptr<PrimitiveString> m_rhs;
+
+    // Known up front when both sides know theirs, so that reading the length of a string being built up with `+=`
+    // doesn't flatten it every time.
+    Optional<size_t> m_length_in_utf16_code_units;
 };
 
 class Substring final : public PrimitiveString {
@@ -8,6 +8,7 @@
 #include <AK/Function.h>
 #include <AK/Optional.h>
 #include <AK/TypeCasts.h>
+#include <LibJS/Runtime/AsyncFunctionDriverWrapper.h>
 #include <LibJS/Runtime/Error.h>
 #include <LibJS/Runtime/ExternalMemory.h>
 #include <LibJS/Runtime/GlobalObject.h>
@@ -269,6 +270,20 @@ void Promise::reject(Value reason)
     // 9. Return unused.
 }
 
+// Performs NewPromiseReactionJob(reaction, argument), followed by HostEnqueuePromiseJob(job.[[Job]], job.[[Realm]]).
+static void enqueue_promise_reaction_job(VM& vm, PromiseReaction& reaction, Value argument)
+{
+    // OPTIMIZATION: The handlers of an await's reactions only resume the awaiting async function with a normal or throw
+    //               completion. Schedule that directly, instead of a job that calls a built-in function to do it.
+    if (auto async_function = reaction.awaiting_async_function()) {
+        async_function->schedule_resume(argument, reaction.type() == PromiseReaction::Type::Fulfill);
+        return;
+    }
+
+    auto [job, realm] = create_promise_reaction_job(vm, reaction, argument);
+    vm.host_enqueue_promise_job(move(job), realm);
+}
+
 // 27.2.1.8 TriggerPromiseReactions ( reactions, argument ), https://tc39.es/ecma262/#sec-triggerpromisereactions
 void Promise::trigger_reactions() const
 {
@@ -281,12 +296,9 @@ void Promise::trigger_reactions() const
     // 1. For each element reaction of reactions, do
     for (auto& reaction : reactions) {
         // a. Let job be NewPromiseReactionJob(reaction, argument).
-        dbgln_if(PROMISE_DEBUG, "[Promise @ {} / trigger_reactions()]: Creating PromiseJob for PromiseReaction @ {} with argument {}", this, &reaction, m_result);
-        auto [job, realm] = create_promise_reaction_job(vm, *reaction, m_result);
-
         // b. Perform HostEnqueuePromiseJob(job.[[Job]], job.[[Realm]]).
-        dbgln_if(PROMISE_DEBUG, "[Promise @ {} / trigger_reactions()]: Enqueuing job @ {} in realm {}", this, &job, realm.ptr());
-        vm.host_enqueue_promise_job(move(job), realm);
+        dbgln_if(PROMISE_DEBUG, "[Promise @ {} / trigger_reactions()]: Enqueuing PromiseJob for PromiseReaction @ {} with argument {}", this, &reaction, m_result);
+        enqueue_promise_reaction_job(vm, *reaction, m_result);
     }
 
     if constexpr (PROMISE_DEBUG) {
@@ -334,6 +346,27 @@ Value Promise::perform_then(Value on_fulfilled, Value on_rejected, GC::Ptr<Promi
     // 8. Let rejectReaction be the PromiseReaction { [[Capability]]: resultCapability, [[Type]]: Reject, [[Handler]]: onRejectedJobCallback }.
     auto reject_reaction = PromiseReaction::create(vm, PromiseReaction::Type::Reject, result_capability, move(on_rejected_job_callback));
 
+    // 9-12. See perform_then_with_reactions().
+    perform_then_with_reactions(fulfill_reaction, reject_reaction);
+
+    // 13. If resultCapability is undefined, then
+    if (result_capability == nullptr) {
+        // a. Return undefined.
+        dbgln_if(PROMISE_DEBUG, "[Promise @ {} / perform_then()]: No result PromiseCapability, returning undefined", this);
+        return js_undefined();
+    }
+
+    // 14. Else,
+    //     a. Return resultCapability.[[Promise]].
+    dbgln_if(PROMISE_DEBUG, "[Promise @ {} / perform_then()]: Returning Promise @ {} from result PromiseCapability @ {}", this, result_capability->promise().ptr(), result_capability.ptr());
+    return result_capability->promise();
+}
+
+// 27.2.5.4.1 PerformPromiseThen ( promise, onFulfilled, onRejected [ , resultCapability ] ), https://tc39.es/ecma262/#sec-performpromisethen
+void Promise::perform_then_with_reactions(GC::Ref<PromiseReaction> fulfill_reaction, GC::Ref<PromiseReaction> reject_reaction)
+{
+    auto& vm = this->vm();
+
     switch (m_state) {
     // 9. If promise.[[PromiseState]] is pending, then
     case Promise::State::Pending:
@@ -351,12 +384,9 @@ Value Promise::perform_then(Value on_fulfilled, Value on_rejected, GC::Ptr<Promi
         auto value = m_result;
 
         // b. Let fulfillJob be NewPromiseReactionJob(fulfillReaction, value).
-        dbgln_if(PROMISE_DEBUG, "[Promise @ {} / perform_then()]: State is State::Fulfilled, creating PromiseJob for PromiseReaction @ {} with argument {}", this, fulfill_reaction.ptr(), value);
-        auto [fulfill_job, realm] = create_promise_reaction_job(vm, fulfill_reaction, value);
-
         // c. Perform HostEnqueuePromiseJob(fulfillJob.[[Job]], fulfillJob.[[Realm]]).
-        dbgln_if(PROMISE_DEBUG, "[Promise @ {} / perform_then()]: Enqueuing job @ {} in realm {}", this, &fulfill_job, realm.ptr());
-        vm.host_enqueue_promise_job(move(fulfill_job), realm);
+        dbgln_if(PROMISE_DEBUG, "[Promise @ {} / perform_then()]: State is State::Fulfilled, enqueuing PromiseJob for PromiseReaction @ {} with argument {}", this, fulfill_reaction.ptr(), value);
+        enqueue_promise_reaction_job(vm, fulfill_reaction, value);
         break;
     }
     // 11. Else,
@@ -371,12 +401,9 @@ Value Promise::perform_then(Value on_fulfilled, Value on_rejected, GC::Ptr<Promi
             vm.host_promise_rejection_tracker(*this, RejectionOperation::Handle);
 
         // d. Let rejectJob be NewPromiseReactionJob(rejectReaction, reason).
-        dbgln_if(PROMISE_DEBUG, "[Promise @ {} / perform_then()]: State is State::Rejected, creating PromiseJob for PromiseReaction @ {} with argument {}", this, reject_reaction.ptr(), reason);
-        auto [reject_job, realm] = create_promise_reaction_job(vm, *reject_reaction, reason);
-
         // e. Perform HostEnqueuePromiseJob(rejectJob.[[Job]], rejectJob.[[Realm]]).
-        dbgln_if(PROMISE_DEBUG, "[Promise @ {} / perform_then()]: Enqueuing job @ {} in realm {}", this, &reject_job, realm.ptr());
-        vm.host_enqueue_promise_job(move(reject_job), realm);
+        dbgln_if(PROMISE_DEBUG, "[Promise @ {} / perform_then()]: State is State::Rejected, enqueuing PromiseJob for PromiseReaction @ {} with argument {}", this, reject_reaction.ptr(), reason);
+        enqueue_promise_reaction_job(vm, reject_reaction, reason);
         break;
     }
     default:
@@ -385,18 +412,6 @@ Value Promise::perform_then(Value on_fulfilled, Value on_rejected, GC::Ptr<Promi
 
     // 12. Set promise.[[PromiseIsHandled]] to true.
     m_is_handled = true;
-
-    // 13. If resultCapability is undefined, then
-    if (result_capability == nullptr) {
-        // a. Return undefined.
-        dbgln_if(PROMISE_DEBUG, "[Promise @ {} / perform_then()]: No result PromiseCapability, returning undefined", this);
-        return js_undefined();
-    }
-
-    // 14. Else,
-    //     a. Return resultCapability.[[Promise]].
-    dbgln_if(PROMISE_DEBUG, "[Promise @ {} / perform_then()]: Returning Promise @ {} from result PromiseCapability @ {}", this, result_capability->promise().ptr(), result_capability.ptr());
-    return result_capability->promise();
 }
 
 void Promise::visit_edges(Cell::Visitor& visitor)
@@ -49,6 +49,9 @@ public:
     void reject(Value reason);
     Value perform_then(Value on_fulfilled, Value on_rejected, GC::Ptr<PromiseCapability> result_capability);
 
+    // Steps 9 through 12 of PerformPromiseThen, for reactions that have already been created.
+    void perform_then_with_reactions(GC::Ref<PromiseReaction> fulfill_reaction, GC::Ref<PromiseReaction> reject_reaction);
+
     bool is_handled() const { return m_is_handled; }
     void set_is_handled() { m_is_handled = true; }
 
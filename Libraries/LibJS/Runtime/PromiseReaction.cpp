@@ -17,10 +17,16 @@ GC::Ref<PromiseReaction> PromiseReaction::create(VM& vm, Type type, GC::Ptr<Prom
     return vm.heap().allocate<PromiseReaction>(type, capability, move(handler));
 }
 
-PromiseReaction::PromiseReaction(Type type, GC::Ptr<PromiseCapability> capability, GC::Ptr<JobCallback> handler)
+GC::Ref<PromiseReaction> PromiseReaction::create_for_await(VM& vm, Type type, AsyncFunctionDriverWrapper& async_function)
+{
+    return vm.heap().allocate<PromiseReaction>(type, nullptr, nullptr, async_function);
+}
+
+PromiseReaction::PromiseReaction(Type type, GC::Ptr<PromiseCapability> capability, GC::Ptr<JobCallback> handler, GC::Ptr<AsyncFunctionDriverWrapper> awaiting_async_function)
     : m_type(type)
     , m_capability(capability)
     , m_handler(move(handler))
+    , m_awaiting_async_function(awaiting_async_function)
 {
 }
 
@@ -29,6 +35,7 @@ void PromiseReaction::visit_edges(Cell::Visitor& visitor)
     Base::visit_edges(visitor);
     visitor.visit(m_capability);
     visitor.visit(m_handler);
+    visitor.visit(m_awaiting_async_function);
 }
 
 }
@@ -26,6 +26,9 @@ public:
 
     static GC::Ref<PromiseReaction> create(VM& vm, Type type, GC::Ptr<PromiseCapability> capability, GC::Ptr<JobCallback> handler);
 
+    // A reaction of an await, which has no capability, and whose handler only resumes the awaiting async function.
+    static GC::Ref<PromiseReaction> create_for_await(VM& vm, Type type, AsyncFunctionDriverWrapper& async_function);
+
     virtual ~PromiseReaction() = default;
 
     Type type() const { return m_type; }
@@ -34,14 +37,17 @@ public:
     GC::Ptr<JobCallback> handler() { return m_handler; }
     GC::Ptr<JobCallback const> handler() const { return m_handler; }
 
+    GC::Ptr<AsyncFunctionDriverWrapper> awaiting_async_function() const { return m_awaiting_async_function; }
+
 private:
-    PromiseReaction(Type type, GC::Ptr<PromiseCapability> capability, GC::Ptr<JobCallback> handler);
+    PromiseReaction(Type type, GC::Ptr<PromiseCapability> capability, GC::Ptr<JobCallback> handler, GC::Ptr<AsyncFunctionDriverWrapper> awaiting_async_function = {});
 
     virtual void visit_edges(Visitor&) override;
 
     Type m_type;
     GC::Ptr<PromiseCapability> m_capability;
     GC::Ptr<JobCallback> m_handler;
+    GC::Ptr<AsyncFunctionDriverWrapper> m_awaiting_async_function;
 };
 
 }
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Runtime/RegExpCache.h>
+
+namespace JS {
+
+RefPtr<CompiledRegExp> RegExpCache::find(Utf16String const& pattern, u8 flag_bits)
+{
+    auto it = m_entries.find(Key { pattern, flag_bits });
+    if (it == m_entries.end()) {
+        ++m_misses;
+        return nullptr;
+    }
+
+    ++m_hits;
+    auto& entry = *it->value;
+    m_recently_used.remove(entry);
+    m_recently_used.append(entry);
+    return entry.compiled;
+}
+
+void RegExpCache::set(Utf16String pattern, u8 flag_bits, NonnullRefPtr<CompiledRegExp> compiled)
+{
+    Key key { move(pattern), flag_bits };
+    if (auto it = m_entries.find(key); it != m_entries.end()) {
+        m_recently_used.remove(*it->value);
+        m_entries.remove(it);
+    }
+
+    while (m_entries.size() >= capacity)
+        evict_least_recently_used();
+
+    auto entry = make<Entry>(key, move(compiled));
+    m_recently_used.append(*entry);
+    m_entries.set(move(key), move(entry));
+}
+
+void RegExpCache::evict_least_recently_used()
+{
+    auto& entry = *m_recently_used.first();
+    m_recently_used.remove(entry);
+    ++m_evictions;
+    m_entries.remove(entry.key);
+}
+
+RegExpCache::Statistics RegExpCache::statistics() const
+{
+    return {
+        .hits = m_hits,
+        .misses = m_misses,
+        .evictions = m_evictions,
+        .entries = m_entries.size(),
+    };
+}
+
+void RegExpCache::reset_statistics()
+{
+    m_hits = 0;
+    m_misses = 0;
+    m_evictions = 0;
+}
+
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/HashMap.h>
+#include <AK/IntrusiveList.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefCounted.h>
+#include <AK/Utf16String.h>
+#include <LibJS/Export.h>
+#include <LibRegex/ECMAScriptRegex.h>
+
+namespace JS {
+
+// A compiled pattern, shared by every RegExp object with the same source and flags. It stays alive for as long as any
+// of them uses it, even once the cache has evicted it.
+class CompiledRegExp final : public RefCounted<CompiledRegExp> {
+public:
+    static NonnullRefPtr<CompiledRegExp> create(regex::ECMAScriptRegex regex)
+    {
+        return adopt_ref(*new CompiledRegExp(move(regex)));
+    }
+
+    regex::ECMAScriptRegex const& regex() const { return m_regex; }
+
+private:
+    explicit CompiledRegExp(regex::ECMAScriptRegex regex)
+        : m_regex(move(regex))
+    {
+    }
+
+    regex::ECMAScriptRegex m_regex;
+};
+
+// The patterns most recently compiled by an agent, keyed by their source and flags, so that code creating the same
+// RegExp over and over only compiles it once.
+class JS_API RegExpCache {
+public:
+    static constexpr size_t capacity = 512;
+
+    struct Statistics {
+        u64 hits { 0 };
+        u64 misses { 0 };
+        u64 evictions { 0 };
+        u64 entries { 0 };
+    };
+
+    RefPtr<CompiledRegExp> find(Utf16String const& pattern, u8 flag_bits);
+    void set(Utf16String pattern, u8 flag_bits, NonnullRefPtr<CompiledRegExp>);
+
+    Statistics statistics() const;
+    void reset_statistics();
+
+private:
+    struct Key {
+        Utf16String pattern;
+        u8 flag_bits { 0 };
+
+        bool operator==(Key const&) const = default;
+    };
+
+    struct KeyTraits : DefaultTraits<Key> {
+        static unsigned hash(Key const& key) { return pair_int_hash(key.pattern.hash(), key.flag_bits); }
+    };
+
+    struct Entry {
+        Entry(Key key, NonnullRefPtr<CompiledRegExp> compiled)
+            : key(move(key))
+            , compiled(move(compiled))
+        {
+        }
+
+        Key key;
+        NonnullRefPtr<CompiledRegExp> compiled;
+        IntrusiveListNode<Entry> list_node;
+
+        using List = IntrusiveList<&Entry::list_node>;
+    };
+
+    void evict_least_recently_used();
+
+    HashMap<Key, NonnullOwnPtr<Entry>, KeyTraits> m_entries;
+    // Least recently used first.
+    Entry::List m_recently_used;
+
+    u64 m_hits { 0 };
+    u64 m_misses { 0 };
+    u64 m_evictions { 0 };
+};
+
+}
@@ -370,11 +370,49 @@ void RegExpObject::initialize(Realm& realm)
     define_direct_property(vm.names.lastIndex, Value(0), Attribute::Writable);
 }
 
+ErrorOr<NonnullRefPtr<CompiledRegExp>, String> compile_regexp(VM& vm, Utf16String const& pattern, RegExpObject::Flags flag_bits)
+{
+    auto& cache = vm.regexp_cache();
+    if (auto compiled_regexp = cache.find(pattern, static_cast<u8>(flag_bits)))
+        return compiled_regexp.release_nonnull();
+
+    bool unicode = has_flag(flag_bits, RegExpObject::Flags::Unicode);
+    bool unicode_sets = has_flag(flag_bits, RegExpObject::Flags::UnicodeSets);
+
+    auto parsed_pattern = String {};
+
+    // Convert UTF-16 pattern to UTF-8 (with escape normalization for non-ASCII).
+    if (!pattern.is_empty()) {
+        auto result = parse_regex_pattern(pattern, unicode, unicode_sets);
+        if (result.is_error())
+            return result.release_error().error;
+        parsed_pattern = result.release_value();
+    }
+
+    regex::ECMAScriptCompileFlags compile_flags {};
+    compile_flags.global = has_flag(flag_bits, RegExpObject::Flags::Global);
+    compile_flags.ignore_case = has_flag(flag_bits, RegExpObject::Flags::IgnoreCase);
+    compile_flags.multiline = has_flag(flag_bits, RegExpObject::Flags::Multiline);
+    compile_flags.dot_all = has_flag(flag_bits, RegExpObject::Flags::DotAll);
+    compile_flags.unicode = unicode;
+    compile_flags.unicode_sets = unicode_sets;
+    compile_flags.sticky = has_flag(flag_bits, RegExpObject::Flags::Sticky);
+    compile_flags.has_indices = has_flag(flag_bits, RegExpObject::Flags::HasIndices);
+
+    auto compiled = regex::ECMAScriptRegex::compile(parsed_pattern.bytes_as_string_view(), compile_flags);
+    if (compiled.is_error())
+        return compiled.release_error();
+
+    auto compiled_regexp = CompiledRegExp::create(compiled.release_value());
+    cache.set(pattern, static_cast<u8>(flag_bits), compiled_regexp);
+    return compiled_regexp;
+}
+
 // 22.2.3.3 RegExpInitialize ( obj, pattern, flags ), https://tc39.es/ecma262/#sec-regexpinitialize
 ThrowCompletionOr<GC::Ref<RegExpObject>> RegExpObject::regexp_initialize(VM& vm, Value pattern_value, Value flags_value)
 {
     // Invalidate the cached compiled regex since the pattern/flags may change.
-    m_cached_regex = nullptr;
+    m_compiled_regexp = nullptr;
 
     // 1. If pattern is undefined, let P be the empty String.
     // 2. Else, let P be ? ToString(pattern).
@@ -398,35 +436,16 @@ ThrowCompletionOr<GC::Ref<RegExpObject>> RegExpObject::regexp_initialize(VM& vm,
     if (validated_flags_or_error.is_error())
         return vm.throw_completion<SyntaxError>(validated_flags_or_error.release_error());
     auto flag_bits = validated_flags_or_error.release_value();
-    bool unicode = has_flag(flag_bits, Flags::Unicode);
-    bool unicode_sets = has_flag(flag_bits, Flags::UnicodeSets);
-
-    auto parsed_pattern = String {};
-
-    // Convert UTF-16 pattern to UTF-8 (with escape normalization for non-ASCII).
-    if (!pattern.is_empty()) {
-        auto result = parse_regex_pattern(pattern, unicode, unicode_sets);
-        if (result.is_error())
-            return vm.throw_completion<SyntaxError>(ErrorType::RegExpCompileError, result.release_error().error);
-        parsed_pattern = result.release_value();
-    }
 
     // 11. If u is true and v is true, throw a SyntaxError exception.
     // NB: Already handled by validate_flags above.
 
-    // Validate by trial-compiling the pattern.
-    regex::ECMAScriptCompileFlags compile_flags {};
-    compile_flags.global = has_flag(flag_bits, Flags::Global);
-    compile_flags.ignore_case = has_flag(flag_bits, Flags::IgnoreCase);
-    compile_flags.multiline = has_flag(flag_bits, Flags::Multiline);
-    compile_flags.dot_all = has_flag(flag_bits, Flags::DotAll);
-    compile_flags.unicode = unicode;
-    compile_flags.unicode_sets = unicode_sets;
-    compile_flags.sticky = has_flag(flag_bits, Flags::Sticky);
-
-    auto compiled = regex::ECMAScriptRegex::compile(parsed_pattern.bytes_as_string_view(), compile_flags);
+    // NB: The pattern is validated by compiling it. The compiled program is kept for this object, and for any later
+    //     RegExp with the same source and flags.
+    auto compiled = compile_regexp(vm, pattern, flag_bits);
     if (compiled.is_error())
         return vm.throw_completion<SyntaxError>(ErrorType::RegExpCompileError, compiled.release_error());
+    m_compiled_regexp = compiled.release_value();
 
     // 16. Set obj.[[OriginalSource]] to P.
     m_pattern = move(pattern);
@@ -12,6 +12,7 @@
 #include <AK/Result.h>
 #include <LibJS/Export.h>
 #include <LibJS/Runtime/Object.h>
+#include <LibJS/Runtime/RegExpCache.h>
 #include <LibRegex/ECMAScriptRegex.h>
 
 namespace JS {
@@ -59,8 +60,8 @@ public:
     void set_legacy_features_enabled(bool legacy_features_enabled) { m_legacy_features_enabled = legacy_features_enabled; }
     void set_realm(Realm& realm) { m_realm = &realm; }
 
-    regex::ECMAScriptRegex const* cached_regex() const { return m_cached_regex; }
-    void set_cached_regex(regex::ECMAScriptRegex const* ptr) const { m_cached_regex = ptr; }
+    RefPtr<CompiledRegExp> compiled_regexp() const { return m_compiled_regexp; }
+    void set_compiled_regexp(NonnullRefPtr<CompiledRegExp> compiled_regexp) const { m_compiled_regexp = move(compiled_regexp); }
 
 private:
     RegExpObject(Object& prototype);
@@ -73,11 +74,14 @@ private:
     Utf16String m_flags;
     Flags m_flag_bits { 0 };
     bool m_legacy_features_enabled { false }; // [[LegacyFeaturesEnabled]]
-    mutable regex::ECMAScriptRegex const* m_cached_regex { nullptr };
+    mutable RefPtr<CompiledRegExp> m_compiled_regexp;
     // Note: This is initialized in RegExpAlloc, but will be non-null afterwards
     GC::Ptr<Realm> m_realm; // [[Realm]]
 };
 
+// Compiles `pattern` with `flags`, or returns the program that the agent's RegExpCache already holds for them.
+ErrorOr<NonnullRefPtr<CompiledRegExp>, String> compile_regexp(VM&, Utf16String const& pattern, RegExpObject::Flags flags);
+
 template<>
 inline bool Object::fast_is<RegExpObject>() const { return is_regexp_object(); }
 
@@ -9,7 +9,6 @@
 #include <AK/CharacterTypes.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
-#include <AK/NeverDestroyed.h>
 #include <AK/Utf16String.h>
 #include <AK/Utf16View.h>
 #include <LibJS/Runtime/AbstractOperations.h>
@@ -76,63 +75,20 @@ static ThrowCompletionOr<void> increment_last_index(VM& vm, Object& regexp_objec
     return {};
 }
 
-// FIXME: Add an eviction policy to bound the size of this cache.
-static auto& regex_cache()
-{
-    static NeverDestroyed<HashMap<String, NonnullOwnPtr<regex::ECMAScriptRegex>>> cache;
-    return *cache;
-}
-
-static regex::ECMAScriptRegex const* get_or_compile_regex(RegExpObject& regexp_object)
+// NB: Callers keep the returned reference while they use the regex, as user code they call may recompile the RegExp
+//     object while the cache has already evicted its previous program.
+static RefPtr<CompiledRegExp> get_or_compile_regex(RegExpObject& regexp_object)
 {
     // Fast path: check the inline cache on the RegExpObject.
-    if (auto* cached = regexp_object.cached_regex())
+    if (auto cached = regexp_object.compiled_regexp())
         return cached;
 
-    auto const& pattern = regexp_object.pattern();
-    auto flag_bits = regexp_object.flag_bits();
-
-    // Build a cache key from pattern + flag bits.
-    StringBuilder key_builder;
-    key_builder.append('/');
-    key_builder.append(pattern.utf16_view());
-    key_builder.append('/');
-    key_builder.append_code_point(static_cast<u8>(flag_bits));
-    auto cache_key = key_builder.to_string_without_validation();
-
-    if (auto it = regex_cache().find(cache_key); it != regex_cache().end()) {
-        auto* ptr = it->value.ptr();
-        regexp_object.set_cached_regex(ptr);
-        return ptr;
-    }
-
-    bool unicode = has_flag(flag_bits, RegExpObject::Flags::Unicode);
-    bool unicode_sets = has_flag(flag_bits, RegExpObject::Flags::UnicodeSets);
-
-    // Parse the pattern from UTF-16 source to UTF-8 with escape normalization.
-    auto parsed_pattern = parse_regex_pattern(pattern.utf16_view(), unicode, unicode_sets);
-    if (parsed_pattern.is_error())
-        return nullptr;
-
-    regex::ECMAScriptCompileFlags flags {};
-    flags.global = has_flag(flag_bits, RegExpObject::Flags::Global);
-    flags.ignore_case = has_flag(flag_bits, RegExpObject::Flags::IgnoreCase);
-    flags.multiline = has_flag(flag_bits, RegExpObject::Flags::Multiline);
-    flags.dot_all = has_flag(flag_bits, RegExpObject::Flags::DotAll);
-    flags.unicode = unicode;
-    flags.unicode_sets = unicode_sets;
-    flags.sticky = has_flag(flag_bits, RegExpObject::Flags::Sticky);
-    flags.has_indices = has_flag(flag_bits, RegExpObject::Flags::HasIndices);
-
-    auto compiled = regex::ECMAScriptRegex::compile(parsed_pattern.release_value(), flags);
-    if (compiled.is_error())
+    auto compiled_regexp = compile_regexp(regexp_object.vm(), regexp_object.pattern(), regexp_object.flag_bits());
+    if (compiled_regexp.is_error())
         return nullptr;
 
-    auto owned = make<regex::ECMAScriptRegex>(compiled.release_value());
-    auto* ptr = owned.ptr();
-    regex_cache().set(cache_key, move(owned));
-    regexp_object.set_cached_regex(ptr);
-    return ptr;
+    regexp_object.set_compiled_regexp(compiled_regexp.value());
+    return compiled_regexp.release_value();
 }
 
 struct ExecWithLastIndexResult {
@@ -216,7 +172,8 @@ static ThrowCompletionOr<Value> regexp_builtin_exec(VM& vm, RegExpObject& regexp
         return js_null();
     }
 
-    auto* compiled_regex = get_or_compile_regex(regexp_object);
+    auto compiled_regexp = get_or_compile_regex(regexp_object);
+    auto const* compiled_regex = compiled_regexp ? &compiled_regexp->regex() : nullptr;
     if (!compiled_regex)
         return js_null();
 
@@ -731,7 +688,8 @@ ThrowCompletionOr<Value> RegExpPrototype::symbol_replace_impl(VM& vm, Object& re
                         fast_path_valid = false;
                 }
 
-                auto* compiled_regex = fast_path_valid ? get_or_compile_regex(*typed_regexp) : nullptr;
+                auto compiled_regexp = fast_path_valid ? get_or_compile_regex(*typed_regexp) : nullptr;
+                auto const* compiled_regex = compiled_regexp ? &compiled_regexp->regex() : nullptr;
                 if (compiled_regex) {
                     auto utf16_view = string->utf16_string_view();
                     auto length_s = utf16_view.length_in_code_units();
@@ -1168,7 +1126,8 @@ ThrowCompletionOr<Value> RegExpPrototype::symbol_split_impl(VM& vm, Object& rege
             && realm.intrinsics().regexp_prototype()->storage_has(vm.names.flags)
             && (limit_value.is_undefined() || limit_value.is_number())) {
 
-            auto* compiled_regex = get_or_compile_regex(*typed_regexp);
+            auto compiled_regexp = get_or_compile_regex(*typed_regexp);
+            auto const* compiled_regex = compiled_regexp ? &compiled_regexp->regex() : nullptr;
             if (compiled_regex) {
                 auto flag_bits = typed_regexp->flag_bits();
                 bool is_unicode = has_flag(flag_bits, RegExpObject::Flags::Unicode);
@@ -1461,7 +1420,8 @@ JS_DEFINE_NATIVE_FUNCTION(RegExpPrototype::test)
 
             // Only use fast path when we don't need to update lastIndex.
             if (!global && !sticky) {
-                auto* compiled_regex = get_or_compile_regex(*typed_regexp);
+                auto compiled_regexp = get_or_compile_regex(*typed_regexp);
+                auto const* compiled_regex = compiled_regexp ? &compiled_regexp->regex() : nullptr;
                 if (compiled_regex) {
                     auto utf16_view = string->utf16_string_view();
 
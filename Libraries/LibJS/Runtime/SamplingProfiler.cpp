@@ -0,0 +1,350 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <LibCore/Timer.h>
+#include <LibGC/Cell.h>
+#include <LibGC/Heap.h>
+#include <LibJS/Bytecode/Executable.h>
+#include <LibJS/Runtime/FunctionObject.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibThreading/Thread.h>
+
+#if !defined(AK_OS_WINDOWS)
+#    include <errno.h>
+#    include <pthread.h>
+#    include <signal.h>
+#    include <unistd.h>
+#endif
+
+namespace JS {
+
+// Often enough that the buffer the signal handler fills rarely runs out of room between two garbage collections.
+static constexpr int drain_interval_ms = 50;
+
+static Atomic<SamplingProfiler*> s_active_profiler;
+
+#if !defined(AK_OS_WINDOWS)
+static pthread_t s_sampled_thread;
+#endif
+
+ErrorOr<NonnullOwnPtr<SamplingProfiler>> SamplingProfiler::create(VM& vm, AK::Duration sampling_interval, size_t allocation_sampling_interval_in_bytes)
+{
+#if defined(AK_OS_WINDOWS)
+    (void)vm;
+    (void)sampling_interval;
+    (void)allocation_sampling_interval_in_bytes;
+    return Error::from_string_literal("Sampling the JavaScript call stack is not supported on this platform");
+#else
+    if (sampling_interval <= AK::Duration::zero())
+        return Error::from_string_literal("The sampling interval must be positive");
+    if (s_active_profiler.load())
+        return Error::from_string_literal("A sampling profiler is already running");
+
+    // NB: The handler stays installed once the first profiler has installed it, since a signal that the sampling
+    //     thread sent just before being stopped may still be pending, and would otherwise end the process.
+    static bool s_signal_handler_installed = false;
+    if (!s_signal_handler_installed) {
+        struct sigaction action {};
+        action.sa_handler = handle_sampling_signal;
+        action.sa_flags = SA_RESTART;
+        sigemptyset(&action.sa_mask);
+        if (sigaction(SIGPROF, &action, nullptr) < 0)
+            return Error::from_errno(errno);
+        s_signal_handler_installed = true;
+    }
+
+    auto profiler = adopt_own(*new SamplingProfiler(vm, sampling_interval));
+    s_sampled_thread = pthread_self();
+    s_active_profiler.store(profiler.ptr());
+
+    if (allocation_sampling_interval_in_bytes > 0) {
+        vm.heap().set_allocation_sampler(allocation_sampling_interval_in_bytes, [profiler = profiler.ptr()](GC::Cell& cell, size_t size_in_bytes) {
+            profiler->record_allocation(cell, size_in_bytes);
+        });
+    }
+
+    profiler->m_drain_timer = Core::Timer::create_repeating(drain_interval_ms, [profiler = profiler.ptr()] {
+        profiler->drain_samples();
+    });
+    profiler->m_drain_timer->start();
+
+    profiler->m_sampling_thread = Threading::Thread::construct("JS Sampler"sv, [profiler = profiler.ptr()]() -> intptr_t {
+        auto interval_in_microseconds = profiler->m_sampling_interval.to_microseconds();
+        while (!profiler->m_should_stop_sampling.load()) {
+            usleep(static_cast<useconds_t>(interval_in_microseconds));
+            if (profiler->m_should_stop_sampling.load())
+                break;
+            pthread_kill(s_sampled_thread, SIGPROF);
+        }
+        return 0;
+    });
+    profiler->m_sampling_thread->start();
+
+    return profiler;
+#endif
+}
+
+SamplingProfiler::SamplingProfiler(VM& vm, AK::Duration sampling_interval)
+    : m_vm(vm)
+    , m_sampling_interval(sampling_interval)
+    , m_start_time(UnixDateTime::now())
+    , m_monotonic_start_time(MonotonicTime::now())
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    stop();
+}
+
+void SamplingProfiler::stop()
+{
+    if (m_is_stopped)
+        return;
+    m_is_stopped = true;
+
+    m_should_stop_sampling.store(true);
+    if (m_sampling_thread)
+        (void)m_sampling_thread->join();
+
+    if (m_drain_timer) {
+        m_drain_timer->on_timeout = {};
+        m_drain_timer->stop();
+    }
+
+    m_vm.heap().clear_allocation_sampler();
+    s_active_profiler.store(nullptr);
+
+    drain_samples();
+    m_frame_indices_by_code.clear();
+}
+
+void SamplingProfiler::handle_sampling_signal(int)
+{
+    auto saved_errno = errno;
+    if (auto* profiler = s_active_profiler.load(AK::MemoryOrder::memory_order_relaxed))
+        profiler->take_sample_in_signal_handler();
+    errno = saved_errno;
+}
+
+// NB: Runs on the VM's thread, in the middle of whatever it was doing, so this must neither allocate nor lock.
+void SamplingProfiler::take_sample_in_signal_handler()
+{
+    auto index = m_raw_sample_count.load(AK::MemoryOrder::memory_order_relaxed);
+    if (index >= raw_sample_capacity) {
+        m_dropped_sample_count.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        return;
+    }
+
+    auto& raw_sample = m_raw_samples[index];
+    raw_sample.time_in_nanoseconds = MonotonicTime::now().nanoseconds();
+    raw_sample.frame_count = m_vm.sample_execution_context_stack(raw_sample.frames.span());
+
+    // Keep the compiler from publishing the sample before it has been written.
+    atomic_signal_fence(AK::MemoryOrder::memory_order_release);
+    m_raw_sample_count.store(index + 1, AK::MemoryOrder::memory_order_relaxed);
+}
+
+void SamplingProfiler::drain_samples()
+{
+    size_t drained_count = 0;
+    while (true) {
+        auto count = m_raw_sample_count.load(AK::MemoryOrder::memory_order_relaxed);
+        atomic_signal_fence(AK::MemoryOrder::memory_order_acquire);
+        for (; drained_count < count; ++drained_count) {
+            auto const& raw_sample = m_raw_samples[drained_count];
+            m_samples.append({
+                .stack_index = intern_stack(raw_sample.frames.span().trim(raw_sample.frame_count)),
+                .time_in_milliseconds = milliseconds_since_start(raw_sample.time_in_nanoseconds),
+            });
+        }
+
+        // The signal handler may have appended samples while the ones before them were being resolved, in which case
+        // those have to be resolved too before the buffer can be handed back to it.
+        if (m_raw_sample_count.compare_exchange_strong(count, 0))
+            break;
+    }
+}
+
+void SamplingProfiler::will_collect_garbage(Badge<VM>)
+{
+    drain_samples();
+    m_frame_indices_by_code.clear();
+}
+
+void SamplingProfiler::record_allocation(GC::Cell& cell, size_t size_in_bytes)
+{
+    Array<SampledFrame, max_sampled_stack_depth> frames;
+    auto frame_count = m_vm.sample_execution_context_stack(frames.span());
+
+    m_allocations.append({
+        .stack_index = intern_stack(frames.span().trim(frame_count)),
+        .time_in_milliseconds = milliseconds_since_start(MonotonicTime::now().nanoseconds()),
+        .class_name_string_index = intern_string(MUST(String::from_utf8(cell.class_name()))),
+        .size_in_bytes = size_in_bytes,
+    });
+}
+
+Optional<size_t> SamplingProfiler::intern_stack(ReadonlySpan<SampledFrame> frames)
+{
+    // The frames are ordered top to bottom, while each stack refers to the one of its caller.
+    Optional<size_t> stack_index;
+    for (size_t i = frames.size(); i-- > 0;) {
+        auto frame_index = intern_frame(frames[i]);
+        if (!frame_index.has_value())
+            continue;
+
+        auto key = (static_cast<u64>(stack_index.has_value() ? *stack_index + 1 : 0) << 32) | *frame_index;
+        if (auto existing_stack_index = m_stack_indices.get(key); existing_stack_index.has_value()) {
+            stack_index = *existing_stack_index;
+            continue;
+        }
+
+        m_stacks.append({ .prefix = stack_index, .frame_index = *frame_index });
+        stack_index = m_stacks.size() - 1;
+        m_stack_indices.set(key, *stack_index);
+    }
+    return stack_index;
+}
+
+Optional<size_t> SamplingProfiler::intern_frame(SampledFrame const& sampled_frame)
+{
+    // NB: Native functions leave no trace in the profile; their time is attributed to the JavaScript that called them.
+    auto* executable = sampled_frame.executable;
+    if (!executable)
+        return {};
+
+    auto& frame_indices = m_frame_indices_by_code.ensure(bit_cast<FlatPtr>(executable));
+    if (auto frame_index = frame_indices.get(sampled_frame.program_counter); frame_index.has_value())
+        return *frame_index;
+
+    auto name = sampled_frame.function ? sampled_frame.function->name_for_call_stack().to_utf8() : MUST(executable->name.view().to_utf8());
+    if (name.is_empty())
+        name = "<unknown>"_string;
+
+    // Frames of one function share a location, so that the profiler groups them, and differ in their line and column.
+    String location;
+    if (auto function_range = executable->source_range_at(0); function_range.has_value())
+        location = MUST(String::formatted("{} ({}:{}:{})", name, function_range->filename(), function_range->start.line, function_range->start.column));
+    else
+        location = move(name);
+
+    Frame frame { .location_string_index = intern_string(move(location)) };
+    if (auto range = executable->source_range_at(sampled_frame.program_counter); range.has_value()) {
+        frame.line = range->start.line;
+        frame.column = range->start.column;
+    }
+
+    m_frames.append(frame);
+    auto frame_index = m_frames.size() - 1;
+    frame_indices.set(sampled_frame.program_counter, frame_index);
+    return frame_index;
+}
+
+size_t SamplingProfiler::intern_string(String string)
+{
+    if (auto index = m_string_indices.get(string); index.has_value())
+        return *index;
+    m_strings.append(string);
+    m_string_indices.set(move(string), m_strings.size() - 1);
+    return m_strings.size() - 1;
+}
+
+double SamplingProfiler::milliseconds_since_start(i64 time_in_nanoseconds) const
+{
+    return static_cast<double>(time_in_nanoseconds - m_monotonic_start_time.nanoseconds()) / 1'000'000.0;
+}
+
+static JsonValue stack_index_to_json(Optional<size_t> stack_index)
+{
+    if (!stack_index.has_value())
+        return {};
+    return *stack_index;
+}
+
+static JsonObject make_table(ReadonlySpan<StringView> columns, JsonArray data)
+{
+    JsonObject schema;
+    for (size_t i = 0; i < columns.size(); ++i)
+        schema.set(columns[i], i);
+
+    JsonObject table;
+    table.set("schema"sv, move(schema));
+    table.set("data"sv, move(data));
+    return table;
+}
+
+JsonObject SamplingProfiler::to_gecko_profile_thread(StringView thread_name, i32 pid) const
+{
+    JsonArray samples;
+    for (auto const& sample : m_samples) {
+        JsonArray row;
+        row.must_append(stack_index_to_json(sample.stack_index));
+        row.must_append(sample.time_in_milliseconds);
+        row.must_append(0);
+        samples.must_append(move(row));
+    }
+
+    JsonArray frames;
+    for (auto const& frame : m_frames) {
+        JsonArray row;
+        row.must_append(frame.location_string_index);
+        row.must_append(false);
+        row.must_append(0);
+        row.must_append(JsonValue {});
+        row.must_append(frame.line);
+        row.must_append(frame.column);
+        row.must_append(1);
+        row.must_append(0);
+        frames.must_append(move(row));
+    }
+
+    JsonArray stacks;
+    for (auto const& stack : m_stacks) {
+        JsonArray row;
+        row.must_append(stack_index_to_json(stack.prefix));
+        row.must_append(stack.frame_index);
+        stacks.must_append(move(row));
+    }
+
+    JsonArray allocations;
+    for (auto const& allocation : m_allocations) {
+        JsonArray row;
+        row.must_append(allocation.time_in_milliseconds);
+        row.must_append(m_strings[allocation.class_name_string_index]);
+        row.must_append("JSObject"sv);
+        row.must_append("Object"sv);
+        // NB: The Firefox Profiler weighs the allocations by their "duration", which is where their size goes.
+        row.must_append(allocation.size_in_bytes);
+        row.must_append(false);
+        row.must_append(stack_index_to_json(allocation.stack_index));
+        allocations.must_append(move(row));
+    }
+
+    JsonArray strings;
+    for (auto const& string : m_strings)
+        strings.must_append(string);
+
+    JsonObject thread;
+    thread.set("name"sv, thread_name);
+    thread.set("processType"sv, "default"sv);
+    thread.set("pid"sv, pid);
+    thread.set("tid"sv, pid);
+    thread.set("registerTime"sv, 0);
+    thread.set("unregisterTime"sv, JsonValue {});
+    thread.set("markers"sv, make_table(Array { "name"sv, "startTime"sv, "endTime"sv, "phase"sv, "category"sv, "data"sv }, {}));
+    thread.set("samples"sv, make_table(Array { "stack"sv, "time"sv, "eventDelay"sv }, move(samples)));
+    thread.set("frameTable"sv, make_table(Array { "location"sv, "relevantForJS"sv, "innerWindowID"sv, "implementation"sv, "line"sv, "column"sv, "category"sv, "subcategory"sv }, move(frames)));
+    thread.set("stackTable"sv, make_table(Array { "prefix"sv, "frame"sv }, move(stacks)));
+    thread.set("jsAllocations"sv, make_table(Array { "time"sv, "className"sv, "typeName"sv, "coarseType"sv, "duration"sv, "inNursery"sv, "stack"sv }, move(allocations)));
+    thread.set("stringTable"sv, move(strings));
+    thread.set("droppedSampleCount"sv, m_dropped_sample_count.load());
+    return thread;
+}
+
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/Badge.h>
+#include <AK/HashMap.h>
+#include <AK/JsonObject.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/Forward.h>
+#include <LibJS/Export.h>
+#include <LibJS/Forward.h>
+#include <LibThreading/Forward.h>
+
+namespace JS {
+
+// A frame of the execution context stack, as copied by VM::sample_execution_context_stack().
+struct SampledFrame {
+    Bytecode::Executable* executable { nullptr };
+    FunctionObject* function { nullptr };
+    u32 program_counter { 0 };
+};
+
+// Samples the JavaScript call stack of a VM at a fixed interval, and the call stacks that allocate GC cells.
+//
+// A thread of its own signals the VM's thread once per interval, and the signal handler copies the frames of the
+// execution context stack into a fixed buffer, without allocating or locking. The VM's thread drains that buffer,
+// resolving the frames into function names and source positions. It has to do so before the next garbage collection,
+// since only until then are the executables it points to known to be alive.
+class JS_API SamplingProfiler {
+    AK_MAKE_NONCOPYABLE(SamplingProfiler);
+    AK_MAKE_NONMOVABLE(SamplingProfiler);
+
+public:
+    static ErrorOr<NonnullOwnPtr<SamplingProfiler>> create(VM&, AK::Duration sampling_interval, size_t allocation_sampling_interval_in_bytes);
+    ~SamplingProfiler();
+
+    // Stops taking samples, and resolves the ones not yet drained. The samples taken so far stay available.
+    void stop();
+
+    void drain_samples();
+    void will_collect_garbage(Badge<VM>);
+
+    // The samples as a thread of a Gecko profile, the format the Firefox Profiler imports.
+    // https://github.com/firefox-devtools/profiler/blob/main/docs-developer/gecko-profile-format.md
+    JsonObject to_gecko_profile_thread(StringView thread_name, i32 pid) const;
+
+    UnixDateTime start_time() const { return m_start_time; }
+    AK::Duration sampling_interval() const { return m_sampling_interval; }
+
+private:
+    SamplingProfiler(VM&, AK::Duration sampling_interval);
+
+    static constexpr size_t max_sampled_stack_depth = 128;
+    static constexpr size_t raw_sample_capacity = 512;
+
+    struct RawSample {
+        i64 time_in_nanoseconds { 0 };
+        size_t frame_count { 0 };
+        Array<SampledFrame, max_sampled_stack_depth> frames;
+    };
+
+    struct Frame {
+        size_t location_string_index { 0 };
+        u32 line { 0 };
+        u32 column { 0 };
+    };
+
+    struct Stack {
+        Optional<size_t> prefix;
+        size_t frame_index { 0 };
+    };
+
+    struct Sample {
+        Optional<size_t> stack_index;
+        double time_in_milliseconds { 0 };
+    };
+
+    struct Allocation {
+        Optional<size_t> stack_index;
+        double time_in_milliseconds { 0 };
+        size_t class_name_string_index { 0 };
+        size_t size_in_bytes { 0 };
+    };
+
+    static void handle_sampling_signal(int);
+    void take_sample_in_signal_handler();
+
+    void record_allocation(GC::Cell&, size_t size_in_bytes);
+
+    Optional<size_t> intern_stack(ReadonlySpan<SampledFrame>);
+    Optional<size_t> intern_frame(SampledFrame const&);
+    size_t intern_string(String);
+    double milliseconds_since_start(i64 time_in_nanoseconds) const;
+
+    VM& m_vm;
+    AK::Duration m_sampling_interval;
+    UnixDateTime m_start_time;
+    MonotonicTime m_monotonic_start_time;
+
+    RefPtr<Threading::Thread> m_sampling_thread;
+    Atomic<bool> m_should_stop_sampling { false };
+    bool m_is_stopped { false };
+    RefPtr<Core::Timer> m_drain_timer;
+
+    // Written only by the signal handler, and read by the VM's thread once the handler has returned.
+    Array<RawSample, raw_sample_capacity> m_raw_samples;
+    Atomic<size_t> m_raw_sample_count { 0 };
+    Atomic<size_t> m_dropped_sample_count { 0 };
+
+    Vector<String> m_strings;
+    HashMap<String, size_t> m_string_indices;
+    Vector<Frame> m_frames;
+    // NB: Keyed by the frame's executable and program counter. The executables are only known to be alive until the
+    //     next garbage collection, when will_collect_garbage() forgets them.
+    HashMap<FlatPtr, HashMap<u32, Optional<size_t>>> m_frame_indices_by_code;
+    Vector<Stack> m_stacks;
+    HashMap<u64, size_t> m_stack_indices;
+    Vector<Sample> m_samples;
+    Vector<Allocation> m_allocations;
+};
+
+}
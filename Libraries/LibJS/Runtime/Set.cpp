@@ -32,11 +32,8 @@ GC::Ref<Set> Set::copy() const
 {
     auto& vm = this->vm();
     auto& realm = *vm.current_realm();
-    // FIXME: This is very inefficient, but there's no better way to do this at the moment, as the underlying Map
-    //  implementation of m_values uses a non-copyable RedBlackTree.
     auto result = Set::create(realm);
-    for (auto const& entry : *this)
-        result->set_add(entry.key);
+    result->m_values->map_copy_entries_from(*m_values);
     return *result;
 }
 
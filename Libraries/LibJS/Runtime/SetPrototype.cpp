@@ -270,7 +270,8 @@ JS_DEFINE_NATIVE_FUNCTION(SetPrototype::intersection)
         // a. Let thisSize be the number of elements in O.[[SetData]].
         // b. Let index be 0.
         // c. Repeat, while index < thisSize,
-        for (auto const& element : *set) {
+        // NB: The element is copied out, as the call to [[Has]] may add to or remove from the set and move its entries.
+        for (auto element : *set) {
             // i. Let e be O.[[SetData]][index].
             // ii. Set index to index + 1.
             // iii. If e is not empty, then
@@ -182,6 +182,32 @@ void Shape::clear_forward_transitions()
     m_forward_transition_storage = ForwardTransitionStorage::Empty;
 }
 
+void Shape::prune_stale_transitions()
+{
+    auto is_stale = [](auto const&, auto const& shape) { return !shape; };
+
+    if (m_forward_transition_storage == ForwardTransitionStorage::Single) {
+        if (!m_single_forward_transition)
+            clear_forward_transitions();
+    } else if (m_forward_transition_storage == ForwardTransitionStorage::Multiple) {
+        m_forward_transitions.map->remove_all_matching(is_stale);
+        if (m_forward_transitions.map->is_empty())
+            clear_forward_transitions();
+    }
+
+    if (m_prototype_transitions) {
+        m_prototype_transitions->remove_all_matching(is_stale);
+        if (m_prototype_transitions->is_empty())
+            m_prototype_transitions = nullptr;
+    }
+
+    if (m_delete_transitions) {
+        m_delete_transitions->remove_all_matching(is_stale);
+        if (m_delete_transitions->is_empty())
+            m_delete_transitions = nullptr;
+    }
+}
+
 GC::Ptr<Shape> Shape::get_or_prune_cached_delete_transition(PropertyKey const& key)
 {
     if (is_prototype_shape())
@@ -315,6 +341,10 @@ void Shape::visit_edges(Cell::Visitor& visitor)
         visitor.visit(m_property_storage.descriptors);
     visitor.visit(m_prototype);
 
+    // Transitions whose target died in an earlier collection are never going to be taken again. Dropping them here
+    // keeps the transition maps from growing with every short-lived shape, and stops their keys from being marked.
+    prune_stale_transitions();
+
     visitor.ignore(m_prototype_transitions);
 
     // Child prototype-shape weak refs need no marking; pruning is lazy.
@@ -143,6 +143,7 @@ private:
     [[nodiscard]] GC::Ptr<Shape> get_or_prune_cached_forward_transition(TransitionKey const&);
     void cache_forward_transition(TransitionKey const&, GC::Ref<Shape>);
     void clear_forward_transitions();
+    void prune_stale_transitions();
     [[nodiscard]] GC::Ptr<Shape> get_or_prune_cached_prototype_transition(Object* prototype);
     [[nodiscard]] GC::Ptr<Shape> get_or_prune_cached_delete_transition(PropertyKey const&);
 
@@ -601,8 +601,6 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::locale_compare)
     auto locales = vm.argument(1);
     auto options = vm.argument(2);
 
-    // OPTIMIZATION: If both locales and options are undefined, we can use a cached default-constructed Collator.
-    GC::Ptr<Object> collator;
     if (locales.is_undefined() && options.is_undefined()) {
         // OPTIMIZATION: Identical strings are equal with the default options.
         if (string == that_value)
@@ -612,11 +610,13 @@ JS_DEFINE_NATIVE_FUNCTION(StringPrototype::locale_compare)
             if (auto maybe_result = try_fast_ascii_string_compare(string.ascii_view(), that_value.ascii_view()); maybe_result.has_value())
                 return Value(*maybe_result);
         }
-        collator = realm.intrinsics().default_collator();
-    } else {
-        collator = TRY(construct(vm, realm.intrinsics().intl_collator_constructor(), locales, options));
     }
 
+    // OPTIMIZATION: Reuse the Collator from an earlier call with the same locales if there are no options.
+    auto collator = TRY(realm.intrinsics().cached_intl_object(Intrinsics::IntlObjectKind::Collator, locales, options, [&]() -> ThrowCompletionOr<GC::Ref<Object>> {
+        return construct(vm, realm.intrinsics().intl_collator_constructor(), locales, options);
+    }));
+
     // 5. Return CompareStrings(collator, S, thatValue).
     return Intl::compare_strings(static_cast<Intl::Collator const&>(*collator), string, that_value);
 }
@@ -0,0 +1,518 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Vector.h>
+#include <LibJS/Runtime/Completion.h>
+
+namespace JS {
+
+// A stable merge sort that finds the runs already present in its input and merges them with galloping, after
+// CPython's listsort. Already sorted, reversed and mostly sorted inputs take close to n comparisons.
+//
+// The comparator returns whether its first argument sorts strictly before its second, and may throw. If it does, or
+// if it isn't a consistent order, the elements end up in an unspecified order, but every element is still in the
+// span exactly once and no access goes out of bounds.
+template<typename T, typename LessThan>
+class TimSort {
+public:
+    // `scratch` must have room for at least half of `elements`.
+    TimSort(Span<T> elements, Span<T> scratch, LessThan const& less_than)
+        : m_elements(elements)
+        , m_scratch(scratch)
+        , m_less_than(less_than)
+    {
+        VERIFY(m_scratch.size() >= m_elements.size() / 2);
+    }
+
+    ThrowCompletionOr<void> sort()
+    {
+        auto remaining = m_elements.size();
+        if (remaining < 2)
+            return {};
+
+        auto min_run = compute_min_run(remaining);
+        size_t low = 0;
+        while (remaining > 0) {
+            auto run_length = TRY(count_run(low, low + remaining));
+            if (run_length < min_run) {
+                auto forced_length = min(min_run, remaining);
+                TRY(binary_insertion_sort(low, low + forced_length, low + run_length));
+                run_length = forced_length;
+            }
+
+            m_runs.append({ low, run_length });
+            TRY(merge_collapse());
+
+            low += run_length;
+            remaining -= run_length;
+        }
+
+        return merge_force_collapse();
+    }
+
+private:
+    // How many wins in a row one run needs before merging switches to galloping.
+    static constexpr size_t initial_min_gallop = 7;
+
+    struct Run {
+        size_t base { 0 };
+        size_t length { 0 };
+    };
+
+    // Picks a run length between 32 and 64 such that n / min_run is a power of two, or slightly less than one, so the
+    // final merges are balanced.
+    static size_t compute_min_run(size_t n)
+    {
+        size_t remainder = 0;
+        while (n >= 64) {
+            remainder |= n & 1;
+            n >>= 1;
+        }
+        return n + remainder;
+    }
+
+    // Returns the length of the run starting at `low`, reversing it in place if it's strictly descending. Descending
+    // runs must be strict so the reversal can't reorder equal elements.
+    ThrowCompletionOr<size_t> count_run(size_t low, size_t high)
+    {
+        if (low + 1 == high)
+            return 1;
+
+        size_t length = 2;
+        if (TRY(m_less_than(m_elements[low + 1], m_elements[low]))) {
+            for (; low + length < high; ++length) {
+                if (!TRY(m_less_than(m_elements[low + length], m_elements[low + length - 1])))
+                    break;
+            }
+            m_elements.slice(low, length).reverse();
+        } else {
+            for (; low + length < high; ++length) {
+                if (TRY(m_less_than(m_elements[low + length], m_elements[low + length - 1])))
+                    break;
+            }
+        }
+        return length;
+    }
+
+    // Sorts [low, high), given that [low, start) is already sorted.
+    ThrowCompletionOr<void> binary_insertion_sort(size_t low, size_t high, size_t start)
+    {
+        for (; start < high; ++start) {
+            auto pivot = m_elements[start];
+
+            // Insert after any equal elements, to stay stable.
+            auto left = low;
+            auto right = start;
+            while (left < right) {
+                auto middle = left + (right - left) / 2;
+                if (TRY(m_less_than(pivot, m_elements[middle])))
+                    right = middle;
+                else
+                    left = middle + 1;
+            }
+
+            for (auto i = start; i > left; --i)
+                m_elements[i] = move(m_elements[i - 1]);
+            m_elements[left] = move(pivot);
+        }
+        return {};
+    }
+
+    // Keeps the lengths of the pending runs growing at least as fast as the Fibonacci numbers from the top of the stack
+    // down, so merges stay balanced and the stack stays shallow. This checks one more run than the original listsort
+    // did, which is needed for the invariant to actually hold for the whole stack.
+    ThrowCompletionOr<void> merge_collapse()
+    {
+        while (m_runs.size() > 1) {
+            auto n = m_runs.size() - 2;
+            if ((n > 0 && m_runs[n - 1].length <= m_runs[n].length + m_runs[n + 1].length)
+                || (n > 1 && m_runs[n - 2].length <= m_runs[n - 1].length + m_runs[n].length)) {
+                if (m_runs[n - 1].length < m_runs[n + 1].length)
+                    --n;
+            } else if (m_runs[n].length > m_runs[n + 1].length) {
+                break;
+            }
+            TRY(merge_at(n));
+        }
+        return {};
+    }
+
+    ThrowCompletionOr<void> merge_force_collapse()
+    {
+        while (m_runs.size() > 1) {
+            auto n = m_runs.size() - 2;
+            if (n > 0 && m_runs[n - 1].length < m_runs[n + 1].length)
+                --n;
+            TRY(merge_at(n));
+        }
+        return {};
+    }
+
+    // Merges the runs at stack indices i and i + 1.
+    ThrowCompletionOr<void> merge_at(size_t i)
+    {
+        auto base_a = m_runs[i].base;
+        auto length_a = m_runs[i].length;
+        auto base_b = m_runs[i + 1].base;
+        auto length_b = m_runs[i + 1].length;
+
+        m_runs[i].length = length_a + length_b;
+        m_runs.remove(i + 1);
+
+        // Elements at the start of A that are already in place, because they don't sort after B's first element, can
+        // be skipped.
+        auto skipped = TRY(gallop_right(m_elements[base_b], m_elements.slice(base_a, length_a), 0));
+        base_a += skipped;
+        length_a -= skipped;
+        if (length_a == 0)
+            return {};
+
+        // Likewise for elements at the end of B that don't sort before A's last element.
+        length_b = TRY(gallop_left(m_elements[base_a + length_a - 1], m_elements.slice(base_b, length_b), length_b - 1));
+        if (length_b == 0)
+            return {};
+
+        if (length_a <= length_b)
+            return merge_low(base_a, length_a, length_b);
+        return merge_high(base_a, length_a, length_b);
+    }
+
+    // Returns the index at which `key` would be inserted into the sorted `run` before any equal elements, searching
+    // outwards from `hint` in exponentially growing steps before doing a binary search.
+    ThrowCompletionOr<size_t> gallop_left(T const& key, Span<T> run, size_t hint)
+    {
+        auto n = static_cast<ssize_t>(run.size());
+        auto start = static_cast<ssize_t>(hint);
+        ssize_t last_offset = 0;
+        ssize_t offset = 1;
+
+        if (TRY(m_less_than(run[start], key))) {
+            // run[hint] < key: gallop right until run[hint + last_offset] < key <= run[hint + offset].
+            auto max_offset = n - start;
+            while (offset < max_offset) {
+                if (!TRY(m_less_than(run[start + offset], key)))
+                    break;
+                last_offset = offset;
+                offset = (offset << 1) + 1;
+            }
+            offset = min(offset, max_offset);
+            last_offset += start;
+            offset += start;
+        } else {
+            // key <= run[hint]: gallop left until run[hint - offset] < key <= run[hint - last_offset].
+            auto max_offset = start + 1;
+            while (offset < max_offset) {
+                if (TRY(m_less_than(run[start - offset], key)))
+                    break;
+                last_offset = offset;
+                offset = (offset << 1) + 1;
+            }
+            offset = min(offset, max_offset);
+            auto previous_last_offset = last_offset;
+            last_offset = start - offset;
+            offset = start - previous_last_offset;
+        }
+
+        // Now run[last_offset] < key <= run[offset], so the answer is in (last_offset, offset].
+        ++last_offset;
+        while (last_offset < offset) {
+            auto middle = last_offset + ((offset - last_offset) >> 1);
+            if (TRY(m_less_than(run[middle], key)))
+                last_offset = middle + 1;
+            else
+                offset = middle;
+        }
+        return static_cast<size_t>(offset);
+    }
+
+    // Like gallop_left(), but returns the index after any elements equal to `key`.
+    ThrowCompletionOr<size_t> gallop_right(T const& key, Span<T> run, size_t hint)
+    {
+        auto n = static_cast<ssize_t>(run.size());
+        auto start = static_cast<ssize_t>(hint);
+        ssize_t last_offset = 0;
+        ssize_t offset = 1;
+
+        if (TRY(m_less_than(key, run[start]))) {
+            // key < run[hint]: gallop left until run[hint - offset] <= key < run[hint - last_offset].
+            auto max_offset = start + 1;
+            while (offset < max_offset) {
+                if (!TRY(m_less_than(key, run[start - offset])))
+                    break;
+                last_offset = offset;
+                offset = (offset << 1) + 1;
+            }
+            offset = min(offset, max_offset);
+            auto previous_last_offset = last_offset;
+            last_offset = start - offset;
+            offset = start - previous_last_offset;
+        } else {
+            // run[hint] <= key: gallop right until run[hint + last_offset] <= key < run[hint + offset].
+            auto max_offset = n - start;
+            while (offset < max_offset) {
+                if (TRY(m_less_than(key, run[start + offset])))
+                    break;
+                last_offset = offset;
+                offset = (offset << 1) + 1;
+            }
+            offset = min(offset, max_offset);
+            last_offset += start;
+            offset += start;
+        }
+
+        // Now run[last_offset] <= key < run[offset], so the answer is in (last_offset, offset].
+        ++last_offset;
+        while (last_offset < offset) {
+            auto middle = last_offset + ((offset - last_offset) >> 1);
+            if (TRY(m_less_than(key, run[middle])))
+                offset = middle;
+            else
+                last_offset = middle + 1;
+        }
+        return static_cast<size_t>(offset);
+    }
+
+    // Merges run A at [base_a, base_a + length_a) with run B right after it, where A is the shorter run. A is moved to
+    // the scratch buffer and the merged output is written from the bottom up; it never overtakes what's left of B.
+    ThrowCompletionOr<void> merge_low(size_t base_a, size_t length_a, size_t length_b)
+    {
+        for (size_t i = 0; i < length_a; ++i)
+            m_scratch[i] = m_elements[base_a + i];
+
+        auto end_b = base_a + length_a + length_b;
+        auto remaining_a = length_a;
+        auto remaining_b = length_b;
+        auto result = merge_low_from_scratch(end_b, length_a, remaining_a, remaining_b);
+
+        // Whatever is left of A belongs right before whatever is left of B. This also puts A back if the comparator
+        // threw.
+        auto destination = end_b - remaining_b - remaining_a;
+        for (size_t i = 0; i < remaining_a; ++i)
+            m_elements[destination + i] = m_scratch[length_a - remaining_a + i];
+        return result;
+    }
+
+    ThrowCompletionOr<void> merge_low_from_scratch(size_t end_b, size_t length_a, size_t& remaining_a, size_t& remaining_b)
+    {
+        auto next_a = [&]() -> T& { return m_scratch[length_a - remaining_a]; };
+        auto next_b = [&]() -> T& { return m_elements[end_b - remaining_b]; };
+        auto take_from_a = [&](size_t count) {
+            auto destination = end_b - remaining_b - remaining_a;
+            for (size_t i = 0; i < count; ++i)
+                m_elements[destination + i] = m_scratch[length_a - remaining_a + i];
+            remaining_a -= count;
+        };
+        auto take_from_b = [&](size_t count) {
+            auto destination = end_b - remaining_b - remaining_a;
+            for (size_t i = 0; i < count; ++i)
+                m_elements[destination + i] = m_elements[end_b - remaining_b + i];
+            remaining_b -= count;
+        };
+
+        // merge_at() made sure B's first element sorts before all of A, and A's last element sorts after all of B.
+        take_from_b(1);
+        if (remaining_b == 0)
+            return {};
+        if (remaining_a == 1) {
+            take_from_b(remaining_b);
+            return {};
+        }
+
+        auto min_gallop = m_min_gallop;
+        while (true) {
+            size_t a_count = 0;
+            size_t b_count = 0;
+
+            // Merge one element at a time until one of the runs keeps winning.
+            while (true) {
+                if (TRY(m_less_than(next_b(), next_a()))) {
+                    take_from_b(1);
+                    ++b_count;
+                    a_count = 0;
+                    if (remaining_b == 0)
+                        return {};
+                    if (b_count >= min_gallop)
+                        break;
+                } else {
+                    take_from_a(1);
+                    ++a_count;
+                    b_count = 0;
+                    if (remaining_a == 1) {
+                        take_from_b(remaining_b);
+                        return {};
+                    }
+                    if (a_count >= min_gallop)
+                        break;
+                }
+            }
+
+            // Then gallop until neither run wins by much anymore, making galloping easier to get back into the longer
+            // it pays off.
+            ++min_gallop;
+            do {
+                min_gallop -= min_gallop > 1;
+                m_min_gallop = min_gallop;
+
+                a_count = TRY(gallop_right(next_b(), m_scratch.slice(length_a - remaining_a, remaining_a), 0));
+                if (a_count > 0) {
+                    take_from_a(a_count);
+                    if (remaining_a == 1) {
+                        take_from_b(remaining_b);
+                        return {};
+                    }
+                    // Only possible if the comparator isn't consistent.
+                    if (remaining_a == 0)
+                        return {};
+                }
+                take_from_b(1);
+                if (remaining_b == 0)
+                    return {};
+
+                b_count = TRY(gallop_left(next_a(), m_elements.slice(end_b - remaining_b, remaining_b), 0));
+                if (b_count > 0) {
+                    take_from_b(b_count);
+                    if (remaining_b == 0)
+                        return {};
+                }
+                take_from_a(1);
+                if (remaining_a == 1) {
+                    take_from_b(remaining_b);
+                    return {};
+                }
+            } while (a_count >= initial_min_gallop || b_count >= initial_min_gallop);
+
+            ++min_gallop;
+            m_min_gallop = min_gallop;
+        }
+    }
+
+    // The mirror image of merge_low(), for when B is the shorter run. B is moved to the scratch buffer and the merged
+    // output is written from the top down.
+    ThrowCompletionOr<void> merge_high(size_t base_a, size_t length_a, size_t length_b)
+    {
+        auto base_b = base_a + length_a;
+        for (size_t i = 0; i < length_b; ++i)
+            m_scratch[i] = m_elements[base_b + i];
+
+        auto remaining_a = length_a;
+        auto remaining_b = length_b;
+        auto result = merge_high_from_scratch(base_a, remaining_a, remaining_b);
+
+        // Whatever is left of B belongs right after whatever is left of A.
+        for (size_t i = 0; i < remaining_b; ++i)
+            m_elements[base_a + remaining_a + i] = m_scratch[i];
+        return result;
+    }
+
+    ThrowCompletionOr<void> merge_high_from_scratch(size_t base_a, size_t& remaining_a, size_t& remaining_b)
+    {
+        auto last_a = [&]() -> T& { return m_elements[base_a + remaining_a - 1]; };
+        auto last_b = [&]() -> T& { return m_scratch[remaining_b - 1]; };
+        auto take_from_a = [&](size_t count) {
+            auto destination = base_a + remaining_a + remaining_b - 1;
+            for (size_t i = 0; i < count; ++i)
+                m_elements[destination - i] = m_elements[base_a + remaining_a - 1 - i];
+            remaining_a -= count;
+        };
+        auto take_from_b = [&](size_t count) {
+            auto destination = base_a + remaining_a + remaining_b - 1;
+            for (size_t i = 0; i < count; ++i)
+                m_elements[destination - i] = m_scratch[remaining_b - 1 - i];
+            remaining_b -= count;
+        };
+
+        take_from_a(1);
+        if (remaining_a == 0)
+            return {};
+        if (remaining_b == 1) {
+            take_from_a(remaining_a);
+            return {};
+        }
+
+        auto min_gallop = m_min_gallop;
+        while (true) {
+            size_t a_count = 0;
+            size_t b_count = 0;
+
+            while (true) {
+                if (TRY(m_less_than(last_b(), last_a()))) {
+                    take_from_a(1);
+                    ++a_count;
+                    b_count = 0;
+                    if (remaining_a == 0)
+                        return {};
+                    if (a_count >= min_gallop)
+                        break;
+                } else {
+                    take_from_b(1);
+                    ++b_count;
+                    a_count = 0;
+                    if (remaining_b == 1) {
+                        take_from_a(remaining_a);
+                        return {};
+                    }
+                    if (b_count >= min_gallop)
+                        break;
+                }
+            }
+
+            ++min_gallop;
+            do {
+                min_gallop -= min_gallop > 1;
+                m_min_gallop = min_gallop;
+
+                a_count = remaining_a - TRY(gallop_right(last_b(), m_elements.slice(base_a, remaining_a), remaining_a - 1));
+                if (a_count > 0) {
+                    take_from_a(a_count);
+                    if (remaining_a == 0)
+                        return {};
+                }
+                take_from_b(1);
+                if (remaining_b == 1) {
+                    take_from_a(remaining_a);
+                    return {};
+                }
+
+                b_count = remaining_b - TRY(gallop_left(last_a(), m_scratch.trim(remaining_b), remaining_b - 1));
+                if (b_count > 0) {
+                    take_from_b(b_count);
+                    if (remaining_b == 1) {
+                        take_from_a(remaining_a);
+                        return {};
+                    }
+                    // Only possible if the comparator isn't consistent.
+                    if (remaining_b == 0)
+                        return {};
+                }
+                take_from_a(1);
+                if (remaining_a == 0)
+                    return {};
+            } while (a_count >= initial_min_gallop || b_count >= initial_min_gallop);
+
+            ++min_gallop;
+            m_min_gallop = min_gallop;
+        }
+    }
+
+    Span<T> m_elements;
+    Span<T> m_scratch;
+    LessThan const& m_less_than;
+    // The fixed merge_collapse() invariant bounds the stack at 85 runs for any input that fits in memory.
+    Vector<Run, 85> m_runs;
+    size_t m_min_gallop { initial_min_gallop };
+};
+
+template<typename T, typename LessThan>
+ThrowCompletionOr<void> tim_sort(Span<T> elements, Span<T> scratch, LessThan const& less_than)
+{
+    return TimSort<T, LessThan>(elements, scratch, less_than).sort();
+}
+
+}
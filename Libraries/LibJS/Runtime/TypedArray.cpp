@@ -136,6 +136,82 @@ ThrowCompletionOr<void> initialize_typed_array_from_array_buffer(VM& vm, TypedAr
     return {};
 }
 
+// The conversion NumericToRawBytes performs for the given element type, for a Number that was read from a typed array.
+template<typename T>
+static ALWAYS_INLINE auto number_to_element(double value)
+{
+    if constexpr (IsSame<T, ClampedU8>) {
+        // ToUint8Clamp ( argument ), https://tc39.es/ecma262/#sec-touint8clamp
+        if (!(value > 0.0))
+            return static_cast<u8>(0);
+        if (value >= 255.0)
+            return static_cast<u8>(255);
+        auto floored = floor(value);
+        if (floored + 0.5 < value)
+            return static_cast<u8>(floored + 1.0);
+        if (value < floored + 0.5)
+            return static_cast<u8>(floored);
+        return static_cast<u8>(fmod(floored, 2.0) == 1.0 ? floored + 1.0 : floored);
+    } else if constexpr (IsOneOf<T, f16, float, double>) {
+        return static_cast<T>(value);
+    } else {
+        // ToInt8 through ToUint32 all take the integral part modulo 2^N, which an integer conversion does for us.
+        if (fabs(value) < 9223372036854775808.0)
+            return static_cast<T>(static_cast<i64>(value));
+        if (!isfinite(value))
+            return static_cast<T>(0);
+        return static_cast<T>(static_cast<i64>(fmod(value, 4294967296.0)));
+    }
+}
+
+// Written as a plain loop over the raw elements, which compilers turn into vector code for most pairs of types.
+template<typename Source, typename Target>
+static void convert_elements(ReadonlyBytes source, Bytes target, size_t element_count)
+{
+    using SourceDataType = Conditional<IsSame<ClampedU8, Source>, u8, Source>;
+    using TargetDataType = Conditional<IsSame<ClampedU8, Target>, u8, Target>;
+
+    auto const* source_elements = reinterpret_cast<SourceDataType const*>(source.data());
+    auto* target_elements = reinterpret_cast<TargetDataType*>(target.data());
+
+    for (size_t i = 0; i < element_count; ++i) {
+        auto value = source_elements[i];
+        if constexpr (IsIntegral<SourceDataType> && IsSame<Target, ClampedU8>)
+            target_elements[i] = static_cast<u8>(clamp<i64>(value, 0, 255));
+        else if constexpr (IsIntegral<SourceDataType> && IsIntegral<TargetDataType>)
+            target_elements[i] = static_cast<TargetDataType>(value);
+        else
+            target_elements[i] = number_to_element<Target>(static_cast<double>(value));
+    }
+}
+
+template<typename Source>
+static void convert_elements_from(ReadonlyBytes source, TypedArrayBase::Kind target_kind, Bytes target, size_t element_count)
+{
+    switch (target_kind) {
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type) \
+    case TypedArrayBase::Kind::ClassName:                                           \
+        convert_elements<Source, Type>(source, target, element_count);              \
+        return;
+        JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void convert_typed_array_elements(TypedArrayBase::Kind source_kind, ReadonlyBytes source, TypedArrayBase::Kind target_kind, Bytes target, size_t element_count)
+{
+    switch (source_kind) {
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type) \
+    case TypedArrayBase::Kind::ClassName:                                           \
+        convert_elements_from<Type>(source, target_kind, target, element_count);    \
+        return;
+        JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+    }
+    VERIFY_NOT_REACHED();
+}
+
 // 23.2.5.1.2 InitializeTypedArrayFromTypedArray ( O, srcArray ), https://tc39.es/ecma262/#sec-initializetypedarrayfromtypedarray
 template<typename T>
 static ThrowCompletionOr<void> initialize_typed_array_from_typed_array(VM& vm, TypedArray<T>& typed_array, TypedArrayBase& source_array)
@@ -200,8 +276,18 @@ static ThrowCompletionOr<void> initialize_typed_array_from_typed_array(VM& vm, T
         u64 target_byte_index = 0;
 
         // e. Let count be elementLength.
+        auto count = element_length;
+
+        // OPTIMIZATION: Unless the source buffer is shared, convert all the elements in one go rather than going
+        //               through a Value for each of them.
+        if (!source_data->is_shared_array_buffer()) {
+            auto source_bytes = source_data->bytes().slice(source_byte_index, count * source_element_size);
+            convert_typed_array_elements(source_array.kind(), source_bytes, typed_array.kind(), data->bytes(), count);
+            count = 0;
+        }
+
         // f. Repeat, while count > 0,
-        for (u32 i = 0; i < element_length; ++i) {
+        for (; count > 0; --count) {
             // i. Let value be GetValueFromBuffer(srcData, srcByteIndex, srcType, true, unordered).
             auto value = source_array.get_value_from_buffer(source_byte_index, ArrayBuffer::Order::Unordered);
 
@@ -558,6 +558,10 @@ ThrowCompletionOr<TypedArrayBase*> typed_array_create_same_type(VM&, TypedArrayB
 ThrowCompletionOr<TypedArrayWithBufferWitness> validate_typed_array(VM&, Object const&, ArrayBuffer::Order);
 ThrowCompletionOr<double> compare_typed_array_elements(VM&, Value x, Value y, FunctionObject* comparefn);
 
+// Converts `element_count` elements of `source_kind` to `target_kind`, with the same result as reading each of them with
+// GetValueFromBuffer and writing it with SetValueInBuffer. Both kinds must have the same content type.
+void convert_typed_array_elements(TypedArrayBase::Kind source_kind, ReadonlyBytes source, TypedArrayBase::Kind target_kind, Bytes target, size_t element_count);
+
 #define JS_DECLARE_TYPED_ARRAY(ClassName, snake_name, PrototypeName, ConstructorName, Type)                  \
     class JS_API ClassName final : public TypedArray<Type> {                                                 \
         JS_OBJECT(ClassName, TypedArray);                                                                    \
@@ -6,6 +6,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BitCast.h>
+#include <AK/RadixSort.h>
 #include <AK/TypeCasts.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Array.h>
@@ -491,14 +493,16 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::every)
 // NOTE: This function assumes that the index is valid within the TypedArray,
 //       and that the TypedArray is not detached.
 template<typename T>
-inline void fast_typed_array_fill(TypedArrayBase& typed_array, u32 begin, u32 end, T value)
+inline void fast_typed_array_fill(VM& vm, TypedArrayBase& typed_array, u32 begin, u32 end, Value value)
 {
+    using UnderlyingBufferDataType = Conditional<IsSame<ClampedU8, T>, u8, T>;
+
     Checked<size_t> computed_begin = begin;
-    computed_begin *= sizeof(T);
+    computed_begin *= sizeof(UnderlyingBufferDataType);
     computed_begin += typed_array.byte_offset();
 
     Checked<size_t> computed_end = end;
-    computed_end *= sizeof(T);
+    computed_end *= sizeof(UnderlyingBufferDataType);
     computed_end += typed_array.byte_offset();
 
     if (computed_begin.has_overflow() || computed_end.has_overflow()) [[unlikely]] {
@@ -510,10 +514,18 @@ inline void fast_typed_array_fill(TypedArrayBase& typed_array, u32 begin, u32 en
         return;
     }
 
+    // The value converts to the same element every time, so convert it once.
+    UnderlyingBufferDataType element;
+    numeric_to_raw_bytes<T>(vm, value, true, { &element, sizeof(element) });
+
     auto& array_buffer = *typed_array.viewed_array_buffer();
-    auto* slot = reinterpret_cast<T*>(array_buffer.data() + computed_begin.value());
-    for (auto i = begin; i < end; ++i)
-        *(slot++) = value;
+    auto* slot = reinterpret_cast<UnderlyingBufferDataType*>(array_buffer.data() + computed_begin.value());
+    if constexpr (sizeof(UnderlyingBufferDataType) == 1) {
+        __builtin_memset(slot, element, end - begin);
+    } else {
+        for (auto i = begin; i < end; ++i)
+            *(slot++) = element;
+    }
 }
 
 // 23.2.3.9 %TypedArray%.prototype.fill ( value [ , start [ , end ] ] ), https://tc39.es/ecma262/#sec-%typedarray%.prototype.fill
@@ -584,32 +596,15 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::fill)
     // 17. Set final to min(final, len).
     final = min(final, length);
 
-    if (value.is_int32()) {
+    // OPTIMIZATION: Unless the buffer is shared, write the converted value straight into the buffer.
+    if (k < final && !typed_array->viewed_array_buffer()->is_shared_array_buffer()) {
         switch (typed_array->kind()) {
-        case TypedArrayBase::Kind::Uint8Array:
-            fast_typed_array_fill<u8>(*typed_array, k, final, static_cast<u8>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Uint16Array:
-            fast_typed_array_fill<u16>(*typed_array, k, final, static_cast<u16>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Uint32Array:
-            fast_typed_array_fill<u32>(*typed_array, k, final, static_cast<u32>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Int8Array:
-            fast_typed_array_fill<i8>(*typed_array, k, final, static_cast<i8>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Int16Array:
-            fast_typed_array_fill<i16>(*typed_array, k, final, static_cast<i16>(value.as_i32()));
-            return typed_array;
-        case TypedArrayBase::Kind::Int32Array:
-            fast_typed_array_fill<i32>(*typed_array, k, final, value.as_i32());
-            return typed_array;
-        case TypedArrayBase::Kind::Uint8ClampedArray:
-            fast_typed_array_fill<u8>(*typed_array, k, final, clamp(value.as_i32(), 0, 255));
-            return typed_array;
-        default:
-            // FIXME: Support more TypedArray kinds.
-            break;
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type) \
+    case TypedArrayBase::Kind::ClassName:                                           \
+        fast_typed_array_fill<Type>(vm, *typed_array, k, final, value);             \
+        return typed_array;
+            JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
         }
     }
 
@@ -885,6 +880,89 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::for_each)
     return js_undefined();
 }
 
+enum class NaNMatchesNaN {
+    No,
+    Yes,
+};
+
+// OPTIMIZATION: A Number can be compared against the raw elements of a typed array with Number elements, rather than
+//               reading each of them into a Value, as long as the buffer isn't shared.
+static bool can_search_elements_directly(TypedArrayBase const& typed_array, Value search_element)
+{
+    return search_element.is_number()
+        && typed_array.content_type() == TypedArrayBase::ContentType::Number
+        && !typed_array.viewed_array_buffer()->is_shared_array_buffer();
+}
+
+// NB: Converting fromIndex may have shrunk or detached the buffer, and elements past its new end are no longer present.
+static u32 current_typed_array_length(TypedArrayBase const& typed_array)
+{
+    auto typed_array_record = make_typed_array_with_buffer_witness_record(typed_array, ArrayBuffer::Order::SeqCst);
+    if (is_typed_array_out_of_bounds(typed_array_record))
+        return 0;
+    return typed_array_length(typed_array_record);
+}
+
+// Returns the index of the first (or last) element in [begin, end) that is equal to search_element. This is
+// IsStrictlyEqual, or SameValueZero if NaN matches NaN.
+template<typename T>
+static Optional<u32> fast_typed_array_index_of(TypedArrayBase const& typed_array, u32 begin, u32 end, double search_element, Direction direction, NaNMatchesNaN nan_matches_nan)
+{
+    using UnderlyingBufferDataType = Conditional<IsSame<ClampedU8, T>, u8, T>;
+
+    if (begin >= end)
+        return {};
+
+    auto const* elements = reinterpret_cast<UnderlyingBufferDataType const*>(typed_array.viewed_array_buffer()->data() + typed_array.byte_offset());
+
+    auto find = [&](auto matches) -> Optional<u32> {
+        if (direction == Direction::Ascending) {
+            for (auto i = begin; i < end; ++i) {
+                if (matches(elements[i]))
+                    return i;
+            }
+        } else {
+            for (auto i = end; i > begin; --i) {
+                if (matches(elements[i - 1]))
+                    return i - 1;
+            }
+        }
+        return {};
+    };
+
+    if constexpr (IsIntegral<UnderlyingBufferDataType>) {
+        // Only an integral Number within the range of the element type can be equal to one of the elements.
+        static constexpr auto minimum = static_cast<double>(NumericLimits<UnderlyingBufferDataType>::min());
+        static constexpr auto maximum = static_cast<double>(NumericLimits<UnderlyingBufferDataType>::max());
+        if (!(search_element >= minimum && search_element <= maximum) || trunc(search_element) != search_element)
+            return {};
+
+        auto needle = static_cast<UnderlyingBufferDataType>(search_element);
+        return find([needle](auto element) { return element == needle; });
+    } else {
+        if (isnan(search_element)) {
+            if (nan_matches_nan == NaNMatchesNaN::No)
+                return {};
+            return find([](auto element) { return isnan(static_cast<double>(element)); });
+        }
+        return find([search_element](auto element) { return static_cast<double>(element) == search_element; });
+    }
+}
+
+static Optional<u32> fast_typed_array_index_of(TypedArrayBase const& typed_array, u32 begin, u32 end, Value search_element, Direction direction, NaNMatchesNaN nan_matches_nan)
+{
+    end = min(end, current_typed_array_length(typed_array));
+
+    switch (typed_array.kind()) {
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type) \
+    case TypedArrayBase::Kind::ClassName:                                           \
+        return fast_typed_array_index_of<Type>(typed_array, begin, end, search_element.as_double(), direction, nan_matches_nan);
+        JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+    }
+    VERIFY_NOT_REACHED();
+}
+
 // 23.2.3.16 %TypedArray%.prototype.includes ( searchElement [ , fromIndex ] ), https://tc39.es/ecma262/#sec-%typedarray%.prototype.includes
 JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::includes)
 {
@@ -937,6 +1015,9 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::includes)
         k = relative_k;
     }
 
+    if (can_search_elements_directly(*typed_array, search_element))
+        return Value { fast_typed_array_index_of(*typed_array, k, length, search_element, Direction::Ascending, NaNMatchesNaN::Yes).has_value() };
+
     // 11. Repeat, while k < len,
     while (k < length) {
         // a. Let elementK be ! Get(O, ! ToString(𝔽(k))).
@@ -1006,6 +1087,11 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::index_of)
         k = relative_k;
     }
 
+    if (can_search_elements_directly(*typed_array, search_element)) {
+        auto index = fast_typed_array_index_of(*typed_array, k, length, search_element, Direction::Ascending, NaNMatchesNaN::No);
+        return index.has_value() ? Value { *index } : Value { -1 };
+    }
+
     // 11. Repeat, while k < len,
     while (k < length) {
         // a. Let kPresent be ! HasProperty(O, ! ToString(𝔽(k))).
@@ -1143,6 +1229,11 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::last_index_of)
         k = relative_k;
     }
 
+    if (can_search_elements_directly(*typed_array, search_element)) {
+        auto index = fast_typed_array_index_of(*typed_array, 0, k + 1, search_element, Direction::Descending, NaNMatchesNaN::No);
+        return index.has_value() ? Value { *index } : Value { -1 };
+    }
+
     // 9. Repeat, while k ≥ 0,
     while (k >= 0) {
         // a. Let kPresent be ! HasProperty(O, ! ToString(𝔽(k))).
@@ -1521,6 +1612,15 @@ static ThrowCompletionOr<void> set_typed_array_from_typed_array(VM& vm, TypedArr
     }
     // 24. Else,
     else {
+        // OPTIMIZATION: Unless either buffer is shared, convert all the elements in one go rather than going through a
+        //               Value for each of them. The source was cloned above if it shares a buffer with the target.
+        if (!source_buffer->is_shared_array_buffer() && !target_buffer->is_shared_array_buffer()) {
+            auto source_bytes = source_buffer->bytes().slice(source_byte_index, source_length * source_element_size);
+            auto target_bytes = target_buffer->bytes().slice(target_byte_index, limit - target_byte_index);
+            convert_typed_array_elements(source.kind(), source_bytes, target.kind(), target_bytes, source_length);
+            return {};
+        }
+
         // a. Repeat, while targetByteIndex < limit,
         while (target_byte_index < limit) {
             // i. Let value be GetValueFromBuffer(srcBuffer, srcByteIndex, srcType, true, Unordered).
@@ -1845,6 +1945,70 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::some)
     return false;
 }
 
+// OPTIMIZATION: Without a comparefn, CompareTypedArrayElements is a numeric comparison that puts -0 before +0 and NaN
+//               last. Elements mapped to unsigned keys that compare the same way can be radix sorted instead, and as
+//               equal keys mean identical elements, the sort being unstable can't be observed. Sorts the elements of
+//               `source` into `destination`, which may be the same array.
+template<typename T>
+static void fast_typed_array_sort(TypedArray<T>& source, TypedArray<T>& destination)
+{
+    using Element = typename TypedArray<T>::UnderlyingBufferDataType;
+    using Key = Conditional<sizeof(Element) == 1, u8, Conditional<sizeof(Element) == 2, u16, Conditional<sizeof(Element) == 4, u32, u64>>>;
+    static constexpr Key sign_bit = static_cast<Key>(1) << (sizeof(Key) * 8 - 1);
+    static constexpr bool is_floating_point = IsFloatingPoint<Element> || IsSame<Element, f16>;
+
+    auto elements = source.data();
+    Vector<Key> keys;
+    keys.ensure_capacity(elements.size());
+    for (auto element : elements) {
+        if constexpr (is_floating_point) {
+            // Flipping every bit of negative numbers and just the sign bit of positive ones orders them numerically.
+            auto bits = bit_cast<Key>(element);
+            if (element != element)
+                keys.unchecked_append(NumericLimits<Key>::max());
+            else
+                keys.unchecked_append((bits & sign_bit) ? static_cast<Key>(~bits) : static_cast<Key>(bits | sign_bit));
+        } else if constexpr (IsSigned<Element>) {
+            keys.unchecked_append(static_cast<Key>(bit_cast<Key>(element) ^ sign_bit));
+        } else {
+            keys.unchecked_append(element);
+        }
+    }
+
+    Vector<Key> scratch;
+    scratch.resize(keys.size());
+    radix_sort(keys.span(), scratch.span());
+
+    auto sorted_elements = destination.data();
+    VERIFY(sorted_elements.size() == keys.size());
+    for (size_t i = 0; i < keys.size(); ++i) {
+        auto key = keys[i];
+        if constexpr (is_floating_point)
+            sorted_elements[i] = bit_cast<Element>((key & sign_bit) ? static_cast<Key>(key ^ sign_bit) : static_cast<Key>(~key));
+        else if constexpr (IsSigned<Element>)
+            sorted_elements[i] = bit_cast<Element>(static_cast<Key>(key ^ sign_bit));
+        else
+            sorted_elements[i] = key;
+    }
+}
+
+static bool fast_typed_array_sort(TypedArrayBase& source, TypedArrayBase& destination)
+{
+    if (source.viewed_array_buffer()->is_shared_array_buffer())
+        return false;
+
+    VERIFY(source.kind() == destination.kind());
+    switch (source.kind()) {
+#define __JS_ENUMERATE(ClassName, snake_name, PrototypeName, ConstructorName, Type)                   \
+    case TypedArrayBase::Kind::ClassName:                                                             \
+        fast_typed_array_sort(static_cast<ClassName&>(source), static_cast<ClassName&>(destination)); \
+        return true;
+        JS_ENUMERATE_TYPED_ARRAYS
+#undef __JS_ENUMERATE
+    }
+    VERIFY_NOT_REACHED();
+}
+
 // 23.2.3.29 %TypedArray%.prototype.sort ( comparefn ), https://tc39.es/ecma262/#sec-%typedarray%.prototype.sort
 JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::sort)
 {
@@ -1870,6 +2034,9 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::sort)
         return TRY(compare_typed_array_elements(vm, x, y, compare_function.is_undefined() ? nullptr : &compare_function.as_function()));
     };
 
+    if (compare_function.is_undefined() && fast_typed_array_sort(*typed_array, *typed_array))
+        return typed_array;
+
     // 7. Let sortedList be ? SortIndexedProperties(obj, len, SortCompare, read-through-holes).
     auto sorted_list = TRY(sort_indexed_properties(vm, *typed_array, length, sort_compare, Holes::ReadThroughHoles));
 
@@ -2113,6 +2280,9 @@ JS_DEFINE_NATIVE_FUNCTION(TypedArrayPrototype::to_sorted)
         return TRY(compare_typed_array_elements(vm, x, y, compare_function.is_undefined() ? nullptr : &compare_function.as_function()));
     };
 
+    if (compare_function.is_undefined() && fast_typed_array_sort(*typed_array, *array))
+        return array;
+
     // 8. Let sortedList be ? SortIndexedProperties(O, len, SortCompare, read-through-holes).
     auto sorted_list = TRY(sort_indexed_properties(vm, *typed_array, length, sort_compare, Holes::ReadThroughHoles));
 
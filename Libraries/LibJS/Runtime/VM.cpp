@@ -30,6 +30,7 @@
 #include <LibJS/Runtime/NativeJavaScriptBackedFunction.h>
 #include <LibJS/Runtime/PromiseCapability.h>
 #include <LibJS/Runtime/Reference.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibJS/Runtime/Symbol.h>
 #include <LibJS/Runtime/Temporal/Instant.h>
 #include <LibJS/Runtime/VM.h>
@@ -82,6 +83,7 @@ VM::VM(ErrorMessages error_messages)
 
     m_heap.register_sweep_callback([] {
         Bytecode::StaticPropertyLookupCache::sweep_all();
+        Bytecode::MegamorphicPropertyLookupCache::the().remove_dead_cells();
     });
 
     m_empty_string = m_heap.allocate<PrimitiveString>(String {});
@@ -286,6 +288,10 @@ struct ExecutionContextRootsCollector : public Cell::Visitor {
 
 void VM::gather_roots(HashMap<GC::Cell*, GC::HeapRoot>& roots)
 {
+    // The samples point at executables that may not survive the collection, so they have to be resolved before it.
+    if (m_sampling_profiler)
+        m_sampling_profiler->will_collect_garbage({});
+
     roots.set(m_empty_string, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
     for (auto string : m_single_ascii_character_strings)
         roots.set(string, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
@@ -318,6 +324,11 @@ void VM::gather_roots(HashMap<GC::Cell*, GC::HeapRoot>& roots)
     for (auto finalization_registry : m_finalization_registry_cleanup_jobs)
         roots.set(finalization_registry, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
 
+    for (auto const& compiled_builtin_file : m_compiled_builtin_files) {
+        for (auto shared_data : compiled_builtin_file.value)
+            roots.set(shared_data, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
+    }
+
     auto gather_roots_from_execution_context_stack = [&roots](Vector<ExecutionContext*> const& stack, Vector<ExecutionContext*> const& previous_running_contexts, ExecutionContext* running_execution_context) {
         for_each_execution_context_top_to_bottom(stack, previous_running_contexts, running_execution_context, [&](ExecutionContext& execution_context) {
             ExecutionContextRootsCollector visitor;
@@ -331,8 +342,9 @@ void VM::gather_roots(HashMap<GC::Cell*, GC::HeapRoot>& roots)
     for (auto const& saved_stack : m_saved_execution_context_stacks)
         gather_roots_from_execution_context_stack(saved_stack.stack, saved_stack.previous_running_contexts, saved_stack.running_execution_context);
 
-    for (auto& job : m_promise_jobs)
+    m_promise_jobs.for_each([&](auto& job) {
         roots.set(job, GC::HeapRoot { .type = GC::HeapRoot::Type::VM });
+    });
 }
 
 // 9.1.2.1 GetIdentifierReference ( env, name, strict ), https://tc39.es/ecma262/#sec-getidentifierreference
@@ -476,7 +488,7 @@ void VM::run_queued_promise_jobs_impl()
     dbgln_if(PROMISE_DEBUG, "Running queued promise jobs");
 
     while (!m_promise_jobs.is_empty()) {
-        auto job = m_promise_jobs.take_first();
+        auto job = m_promise_jobs.dequeue();
         dbgln_if(PROMISE_DEBUG, "Calling promise job function");
 
         [[maybe_unused]] auto result = job->function()();
@@ -491,7 +503,7 @@ void VM::enqueue_promise_job(GC::Ref<GC::Function<ThrowCompletionOr<Value>()>> j
     // - FIXME: Let scriptOrModule be GetActiveScriptOrModule() at the time HostEnqueuePromiseJob is invoked. If realm is not null, each time job is invoked the implementation must perform implementation-defined steps
     //          such that scriptOrModule is the active script or module at the time of job's invocation.
     // - Jobs must run in the same order as the HostEnqueuePromiseJob invocations that scheduled them.
-    m_promise_jobs.append(job);
+    m_promise_jobs.enqueue(job);
 }
 
 void VM::run_queued_finalization_registry_cleanup_jobs()
@@ -545,14 +557,81 @@ void VM::dump_backtrace() const
     });
 }
 
+size_t VM::sample_execution_context_stack(Span<SampledFrame> frames) const
+{
+    // NB: The signal handler calling this may have interrupted a push or pop of the execution context stack, so rather
+    //     than VERIFY that the stack is consistent, give up on a sample that finds it isn't. The stack's buffers may
+    //     also be in the middle of being reallocated or swapped out, in which case they can't be read at all.
+    if (m_execution_context_stack_storage_is_changing.load())
+        return 0;
+
+    auto stack_size = m_execution_context_stack.size();
+    if (stack_size != m_execution_context_stack_previous_running_contexts.size())
+        return 0;
+
+    size_t frame_count = 0;
+    auto sample_frame = [&](ExecutionContext const& execution_context) {
+        frames[frame_count++] = SampledFrame {
+            .executable = execution_context.executable.ptr(),
+            .function = execution_context.function.ptr(),
+            .program_counter = execution_context.program_counter,
+        };
+    };
+
+    if (!m_running_execution_context) {
+        for (size_t i = stack_size; i-- > 0 && frame_count < frames.size();)
+            sample_frame(*m_execution_context_stack[i]);
+        return frame_count;
+    }
+
+    auto stack_index = stack_size;
+    auto* execution_context = m_running_execution_context;
+    while (execution_context && frame_count < frames.size()) {
+        sample_frame(*execution_context);
+        if (stack_index > 0 && execution_context == m_execution_context_stack[stack_index - 1]) {
+            execution_context = m_execution_context_stack_previous_running_contexts[stack_index - 1];
+            --stack_index;
+            continue;
+        }
+        execution_context = execution_context->caller_frame;
+    }
+    return frame_count;
+}
+
+ErrorOr<void> VM::start_sampling_profiler(AK::Duration sampling_interval, size_t allocation_sampling_interval_in_bytes)
+{
+    if (m_sampling_profiler)
+        return Error::from_string_literal("The sampling profiler is already running");
+    m_sampling_profiler = TRY(SamplingProfiler::create(*this, sampling_interval, allocation_sampling_interval_in_bytes));
+    return {};
+}
+
+OwnPtr<SamplingProfiler> VM::stop_sampling_profiler()
+{
+    if (m_sampling_profiler)
+        m_sampling_profiler->stop();
+    return move(m_sampling_profiler);
+}
+
+void VM::grow_execution_context_stack()
+{
+    m_execution_context_stack_storage_is_changing.store(true);
+    auto new_capacity = max<size_t>(16, m_execution_context_stack.size() * 2);
+    m_execution_context_stack.ensure_capacity(new_capacity);
+    m_execution_context_stack_previous_running_contexts.ensure_capacity(new_capacity);
+    m_execution_context_stack_storage_is_changing.store(false);
+}
+
 void VM::save_execution_context_stack()
 {
+    m_execution_context_stack_storage_is_changing.store(true);
     m_saved_execution_context_stacks.append({
         .stack = move(m_execution_context_stack),
         .previous_running_contexts = move(m_execution_context_stack_previous_running_contexts),
         .running_execution_context = m_running_execution_context,
     });
     m_running_execution_context = nullptr;
+    m_execution_context_stack_storage_is_changing.store(false);
 }
 
 void VM::clear_execution_context_stack()
@@ -565,9 +644,11 @@ void VM::clear_execution_context_stack()
 void VM::restore_execution_context_stack()
 {
     auto saved_stack = m_saved_execution_context_stacks.take_last();
+    m_execution_context_stack_storage_is_changing.store(true);
     m_execution_context_stack = move(saved_stack.stack);
     m_execution_context_stack_previous_running_contexts = move(saved_stack.previous_running_contexts);
     m_running_execution_context = saved_stack.running_execution_context;
+    m_execution_context_stack_storage_is_changing.store(false);
 }
 
 ExecutionContext* VM::previous_execution_context() const
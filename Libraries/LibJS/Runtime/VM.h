@@ -9,9 +9,11 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/FlyString.h>
 #include <AK/Function.h>
 #include <AK/HashMap.h>
+#include <AK/Queue.h>
 #include <AK/RefCounted.h>
 #include <AK/StackInfo.h>
 #include <AK/Variant.h>
@@ -34,6 +36,7 @@
 #include <LibJS/Runtime/ExecutionContext.h>
 #include <LibJS/Runtime/InterpreterStack.h>
 #include <LibJS/Runtime/Promise.h>
+#include <LibJS/Runtime/RegExpCache.h>
 #include <LibJS/Runtime/Value.h>
 
 namespace JS {
@@ -179,6 +182,12 @@ public:
 
     auto& numeric_string_cache() { return m_numeric_string_cache; }
 
+    // Builtin JavaScript files compiled by this VM, keyed by their source text. The compiled functions don't belong to
+    // any realm, so every realm created by this VM shares them instead of compiling the file again.
+    HashMap<unsigned char const*, Vector<GC::Ref<SharedFunctionInstanceData>>>& compiled_builtin_files() { return m_compiled_builtin_files; }
+
+    RegExpCache& regexp_cache() { return m_regexp_cache; }
+
     PrimitiveString& empty_string() { return *m_empty_string; }
 
     PrimitiveString& single_ascii_character_string(u8 character)
@@ -221,8 +230,7 @@ public:
         context.caller_return_pc = 0;
         context.caller_dst_raw = 0;
         context.caller_is_construct = false;
-        m_execution_context_stack.append(&context);
-        m_execution_context_stack_previous_running_contexts.append(m_running_execution_context);
+        append_to_execution_context_stack(context);
         m_running_execution_context = &context;
         return {};
     }
@@ -233,8 +241,7 @@ public:
         context.caller_return_pc = 0;
         context.caller_dst_raw = 0;
         context.caller_is_construct = false;
-        m_execution_context_stack.append(&context);
-        m_execution_context_stack_previous_running_contexts.append(m_running_execution_context);
+        append_to_execution_context_stack(context);
         m_running_execution_context = &context;
     }
 
@@ -284,6 +291,10 @@ public:
         for_each_execution_context_top_to_bottom(m_execution_context_stack, m_execution_context_stack_previous_running_contexts, m_running_execution_context, callback);
     }
 
+    // Copies the frames of the execution context stack into the given span, top to bottom, and returns how many fit.
+    // Unlike the above, this may be called from a signal handler that interrupted the VM's thread.
+    size_t sample_execution_context_stack(Span<SampledFrame>) const;
+
     template<typename Callback>
     Optional<ExecutionContext*> last_execution_context_matching(Callback callback)
     {
@@ -422,6 +433,10 @@ public:
     Agent* agent() { return m_agent; }
     Agent const* agent() const { return m_agent; }
 
+    ErrorOr<void> start_sampling_profiler(AK::Duration sampling_interval, size_t allocation_sampling_interval_in_bytes);
+    OwnPtr<SamplingProfiler> stop_sampling_profiler();
+    bool is_sampling_profiler_active() const { return m_sampling_profiler; }
+
     void save_execution_context_stack();
     void clear_execution_context_stack();
     void restore_execution_context_stack();
@@ -466,6 +481,16 @@ private:
 
     explicit VM(ErrorMessages);
 
+    ALWAYS_INLINE void append_to_execution_context_stack(ExecutionContext& context)
+    {
+        if (m_execution_context_stack.size() == m_execution_context_stack.capacity()
+            || m_execution_context_stack_previous_running_contexts.size() == m_execution_context_stack_previous_running_contexts.capacity()) [[unlikely]]
+            grow_execution_context_stack();
+        m_execution_context_stack.unchecked_append(&context);
+        m_execution_context_stack_previous_running_contexts.unchecked_append(m_running_execution_context);
+    }
+    void grow_execution_context_stack();
+
     template<typename Callback>
     static void for_each_execution_context_top_to_bottom(Vector<ExecutionContext*> const& execution_context_stack, Vector<ExecutionContext*> const& execution_context_stack_previous_running_contexts, ExecutionContext* running_execution_context, Callback callback)
     {
@@ -540,6 +565,10 @@ private:
     Vector<ExecutionContext*> m_execution_context_stack_previous_running_contexts;
     ExecutionContext* m_running_execution_context { nullptr };
 
+    // Set while the storage of the execution context stack is reallocated or swapped out, which the sampling
+    // profiler's signal handler must not read from.
+    Atomic<bool> m_execution_context_stack_storage_is_changing { false };
+
     Vector<SavedExecutionContextStack> m_saved_execution_context_stacks;
 
     StackInfo m_stack_info;
@@ -549,7 +578,11 @@ private:
     // GlobalSymbolRegistry, https://tc39.es/ecma262/#table-globalsymbolregistry-record-fields
     HashMap<Utf16String, GC::Ref<Symbol>> m_global_symbol_registry;
 
-    Vector<GC::Ref<GC::Function<ThrowCompletionOr<Value>()>>> m_promise_jobs;
+    HashMap<unsigned char const*, Vector<GC::Ref<SharedFunctionInstanceData>>> m_compiled_builtin_files;
+
+    RegExpCache m_regexp_cache;
+
+    Queue<GC::Ref<GC::Function<ThrowCompletionOr<Value>()>>> m_promise_jobs;
 
     Vector<GC::Ref<FinalizationRegistry>> m_finalization_registry_cleanup_jobs;
 
@@ -577,6 +610,7 @@ private:
     u64 m_module_async_evaluation_count { 0 }; // [[ModuleAsyncEvaluationCount]]
 
     OwnPtr<Agent> m_agent;
+    OwnPtr<SamplingProfiler> m_sampling_profiler;
 
     bool m_dynamic_imports_allowed { false };
 };
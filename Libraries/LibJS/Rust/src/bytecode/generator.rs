@@ -20,6 +20,7 @@ use super::ffi::AbstractOperationKind;
 use super::ffi::WellKnownSymbolKind;
 use super::instruction::Instruction;
 use super::operand::*;
+use super::optimizer;
 use crate::ast::AstArena;
 use crate::ast::FunctionData;
 use crate::ast::FunctionId;
@@ -1606,6 +1607,11 @@ impl Generator {
             }
         }
 
+        // Structural passes over the block graph, opt-in via LIBJS_BYTECODE_OPTIMIZER.
+        // They run before the unterminated-block check below so that removed
+        // blocks do not keep an otherwise unused undefined constant alive.
+        optimizer::optimize_if_enabled(&mut self.basic_blocks);
+
         // If any block is unterminated, ensure the undefined constant exists
         // for the assembly-time End(undefined) fallthrough. This must happen
         // before computing number_of_constants so operand rewriting accounts
@@ -17,6 +17,7 @@
 //! - `basic_block` -- BasicBlock: list of instructions with control flow metadata
 //! - `generator` -- Generator: manages registers, constants, tables, and assembly
 //! - `codegen` -- AST-walking code that emits instructions via the Generator
+//! - `optimizer` -- Opt-in structural passes over the basic blocks before assembly
 //! - `ffi` -- FFI bridge to create C++ Executable and SharedFunctionInstanceData
 
 pub mod basic_block;
@@ -25,4 +26,5 @@ pub mod ffi;
 pub mod generator;
 pub mod instruction;
 pub mod operand;
+pub mod optimizer;
 pub mod validator;
@@ -0,0 +1,412 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+//! Whole-function optimization passes over the generated basic blocks.
+//!
+//! These passes run at the start of `Generator::assemble()`, before operand
+//! rewriting and label linking, so they only ever see block indices and
+//! unrewritten operands. The assembled result is what ends up in the bytecode
+//! cache, so the extra work is paid once per compiled function.
+//!
+//! The pipeline is opt-in via `LIBJS_BYTECODE_OPTIMIZER`:
+//! - unset or `0`: disabled
+//! - `1`: enabled
+//! - `stats`: enabled, with per-executable pass statistics on stderr
+//!
+//! Every pass here is purely structural. Register-level passes (dead store
+//! elimination, copy propagation, register coalescing) need to know which
+//! operands an instruction reads and which it writes, and which registers are
+//! live into exception handlers and generator resumption points; the
+//! instruction metadata generated from Bytecode.def does not describe that yet.
+
+use std::sync::OnceLock;
+
+use super::basic_block::BasicBlock;
+use super::instruction::Instruction;
+use super::operand::Label;
+use crate::u32_from_usize;
+
+#[derive(Clone, Copy, PartialEq, Eq)]
+enum OptimizerMode {
+    Disabled,
+    Enabled,
+    EnabledWithStatistics,
+}
+
+fn optimizer_mode() -> OptimizerMode {
+    static MODE: OnceLock<OptimizerMode> = OnceLock::new();
+    *MODE.get_or_init(|| match std::env::var("LIBJS_BYTECODE_OPTIMIZER").as_deref() {
+        Ok("stats") => OptimizerMode::EnabledWithStatistics,
+        Ok(value) if !value.is_empty() && value != "0" => OptimizerMode::Enabled,
+        _ => OptimizerMode::Disabled,
+    })
+}
+
+pub fn is_enabled() -> bool {
+    optimizer_mode() != OptimizerMode::Disabled
+}
+
+/// What each pass changed in one executable.
+#[derive(Debug, Default, Clone, Copy, PartialEq, Eq)]
+pub struct OptimizationStatistics {
+    /// Labels retargeted past blocks that only contain a `Jump`.
+    pub threaded_labels: usize,
+    /// Blocks appended to their only predecessor.
+    pub merged_blocks: usize,
+    /// Blocks no longer reachable from the entry block or any exception handler.
+    pub removed_blocks: usize,
+    /// `Mov` instructions whose source and destination are the same operand.
+    pub removed_self_moves: usize,
+}
+
+/// Run the pass pipeline if enabled, reporting statistics when asked to.
+pub fn optimize_if_enabled(basic_blocks: &mut Vec<BasicBlock>) {
+    let mode = optimizer_mode();
+    if mode == OptimizerMode::Disabled {
+        return;
+    }
+    let statistics = optimize(basic_blocks);
+    if mode == OptimizerMode::EnabledWithStatistics {
+        eprintln!(
+            "LibJS bytecode optimizer: threaded {} labels, merged {} blocks, removed {} blocks and {} self-moves",
+            statistics.threaded_labels,
+            statistics.merged_blocks,
+            statistics.removed_blocks,
+            statistics.removed_self_moves
+        );
+    }
+}
+
+/// Run every pass once, in an order where each one feeds the next: threading
+/// leaves trampolines unreachable and exposes single-predecessor blocks, and
+/// merging leaves the absorbed blocks unreachable.
+pub fn optimize(basic_blocks: &mut Vec<BasicBlock>) -> OptimizationStatistics {
+    let mut statistics = OptimizationStatistics::default();
+    if basic_blocks.is_empty() {
+        return statistics;
+    }
+    statistics.removed_self_moves = remove_self_moves(basic_blocks);
+    statistics.threaded_labels = thread_jumps(basic_blocks);
+    statistics.merged_blocks = merge_blocks(basic_blocks);
+    statistics.removed_blocks = remove_unreachable_blocks(basic_blocks);
+    statistics
+}
+
+fn remove_self_moves(basic_blocks: &mut [BasicBlock]) -> usize {
+    let mut removed = 0;
+    for block in basic_blocks {
+        let before = block.instructions.len();
+        block
+            .instructions
+            .retain(|(instruction, _, _)| !matches!(instruction, Instruction::Mov { dst, src } if dst == src));
+        removed += before - block.instructions.len();
+    }
+    removed
+}
+
+/// If `block` consists of nothing but an unconditional `Jump`, its target.
+fn trampoline_target(block: &BasicBlock) -> Option<usize> {
+    if !block.terminated || block.instructions.len() != 1 {
+        return None;
+    }
+    match &block.instructions[0].0 {
+        Instruction::Jump { target } => Some(target.basic_block_index()),
+        _ => None,
+    }
+}
+
+/// Follow a chain of trampolines to the first block that does real work.
+/// Bounded by the block count so a cycle of trampolines cannot hang us.
+fn resolve_trampolines(basic_blocks: &[BasicBlock], mut index: usize) -> usize {
+    for _ in 0..basic_blocks.len() {
+        match trampoline_target(&basic_blocks[index]) {
+            Some(target) if target != index => index = target,
+            _ => break,
+        }
+    }
+    index
+}
+
+/// Retarget every control-flow label (jump targets and generator continuations)
+/// that points at a trampoline. Exception handler labels are left alone.
+fn thread_jumps(basic_blocks: &mut [BasicBlock]) -> usize {
+    let resolved: Vec<usize> = (0..basic_blocks.len())
+        .map(|index| resolve_trampolines(basic_blocks, index))
+        .collect();
+
+    let mut threaded = 0;
+    for block in basic_blocks {
+        for (instruction, _, _) in &mut block.instructions {
+            instruction.visit_labels(&mut |label: &mut Label| {
+                let target = resolved[label.basic_block_index()];
+                if target != label.basic_block_index() {
+                    label.0 = u32_from_usize(target);
+                    threaded += 1;
+                }
+            });
+        }
+    }
+    threaded
+}
+
+/// Mark the blocks reachable from the entry block, treating exception handlers
+/// of reachable blocks as reachable too.
+fn compute_reachability(basic_blocks: &mut [BasicBlock]) -> Vec<bool> {
+    let mut reachable = vec![false; basic_blocks.len()];
+    let mut worklist = vec![0usize];
+    reachable[0] = true;
+    while let Some(index) = worklist.pop() {
+        let mut successors = Vec::new();
+        let block = &mut basic_blocks[index];
+        if let Some(handler) = block.handler {
+            successors.push(handler.basic_block_index());
+        }
+        for (instruction, _, _) in &mut block.instructions {
+            instruction.visit_labels(&mut |label: &mut Label| successors.push(label.basic_block_index()));
+        }
+        for successor in successors {
+            if !reachable[successor] {
+                reachable[successor] = true;
+                worklist.push(successor);
+            }
+        }
+    }
+    reachable
+}
+
+/// Append a block to its predecessor when that predecessor ends in a `Jump` to
+/// it, nothing else refers to it, and both are covered by the same handler.
+fn merge_blocks(basic_blocks: &mut [BasicBlock]) -> usize {
+    let reachable = compute_reachability(basic_blocks);
+
+    // References from reachable code only; a dead block jumping somewhere must
+    // not keep that block from being merged.
+    let mut label_references = vec![0usize; basic_blocks.len()];
+    let mut is_handler = vec![false; basic_blocks.len()];
+    for (index, block) in basic_blocks.iter_mut().enumerate() {
+        if !reachable[index] {
+            continue;
+        }
+        if let Some(handler) = block.handler {
+            is_handler[handler.basic_block_index()] = true;
+        }
+        for (instruction, _, _) in &mut block.instructions {
+            instruction.visit_labels(&mut |label: &mut Label| label_references[label.basic_block_index()] += 1);
+        }
+    }
+
+    let mut merged = 0;
+    for index in 0..basic_blocks.len() {
+        if !reachable[index] {
+            continue;
+        }
+        loop {
+            let Some((Instruction::Jump { target }, _, _)) = basic_blocks[index].instructions.last() else {
+                break;
+            };
+            let successor = target.basic_block_index();
+            if successor == index
+                || successor == 0
+                || label_references[successor] != 1
+                || is_handler[successor]
+                || basic_blocks[successor].handler.map(|label| label.0)
+                    != basic_blocks[index].handler.map(|label| label.0)
+            {
+                break;
+            }
+
+            let absorbed = std::mem::take(&mut basic_blocks[successor].instructions);
+            let absorbed_terminated = basic_blocks[successor].terminated;
+            basic_blocks[successor].terminated = false;
+            // The successor's only reference is gone, so nothing reaches it anymore.
+            label_references[successor] = 0;
+
+            let block = &mut basic_blocks[index];
+            block.instructions.pop();
+            block.instructions.extend(absorbed);
+            block.terminated = absorbed_terminated;
+            merged += 1;
+        }
+    }
+    merged
+}
+
+/// Drop blocks that cannot be reached, renumbering the remaining blocks and
+/// every label and handler that refers to them.
+fn remove_unreachable_blocks(basic_blocks: &mut Vec<BasicBlock>) -> usize {
+    let reachable = compute_reachability(basic_blocks);
+    let removed = reachable.iter().filter(|is_reachable| !**is_reachable).count();
+    if removed == 0 {
+        return 0;
+    }
+
+    let mut new_indices = vec![u32::MAX; basic_blocks.len()];
+    let mut next_index = 0u32;
+    for (index, is_reachable) in reachable.iter().enumerate() {
+        if *is_reachable {
+            new_indices[index] = next_index;
+            next_index += 1;
+        }
+    }
+
+    let mut old_index = 0;
+    basic_blocks.retain(|_| {
+        let keep = reachable[old_index];
+        old_index += 1;
+        keep
+    });
+
+    for (index, block) in basic_blocks.iter_mut().enumerate() {
+        block.index = u32_from_usize(index);
+        if let Some(handler) = &mut block.handler {
+            handler.0 = new_indices[handler.basic_block_index()];
+        }
+        for (instruction, _, _) in &mut block.instructions {
+            instruction.visit_labels(&mut |label: &mut Label| {
+                label.0 = new_indices[label.basic_block_index()];
+            });
+        }
+    }
+    removed
+}
+
+#[cfg(test)]
+mod tests {
+    use super::super::basic_block::SourceMapEntry;
+    use super::super::operand::Operand;
+    use super::super::operand::Register;
+    use super::*;
+
+    const NO_SOURCE: SourceMapEntry = SourceMapEntry {
+        bytecode_offset: 0,
+        line: 0,
+        column: 0,
+    };
+
+    fn block(index: u32, instructions: Vec<Instruction>) -> BasicBlock {
+        let mut block = BasicBlock::new(index);
+        for instruction in instructions {
+            block.append(instruction, NO_SOURCE, false);
+        }
+        block
+    }
+
+    fn jump(target: u32) -> Instruction {
+        Instruction::Jump { target: Label(target) }
+    }
+
+    fn end() -> Instruction {
+        Instruction::End {
+            value: Operand::constant(0),
+        }
+    }
+
+    fn jump_target(block: &BasicBlock) -> Option<u32> {
+        match block.instructions.last() {
+            Some((Instruction::Jump { target }, _, _)) => Some(target.0),
+            _ => None,
+        }
+    }
+
+    #[test]
+    fn threads_and_merges_a_chain_of_jumps() {
+        // 0 -> 1 (trampoline) -> 2 (trampoline) -> 3 (End)
+        let mut blocks = vec![
+            block(0, vec![jump(1)]),
+            block(1, vec![jump(2)]),
+            block(2, vec![jump(3)]),
+            block(3, vec![end()]),
+        ];
+        let statistics = optimize(&mut blocks);
+        assert_eq!(statistics.threaded_labels, 2);
+        assert_eq!(statistics.merged_blocks, 1);
+        assert_eq!(statistics.removed_blocks, 3);
+        assert_eq!(blocks.len(), 1);
+        assert!(blocks[0].terminated);
+        assert!(matches!(blocks[0].instructions[0].0, Instruction::End { .. }));
+    }
+
+    #[test]
+    fn does_not_merge_blocks_with_several_predecessors() {
+        let condition = Operand::register(Register::ACCUMULATOR);
+        let mut blocks = vec![
+            block(
+                0,
+                vec![Instruction::JumpIf {
+                    condition,
+                    true_target: Label(1),
+                    false_target: Label(2),
+                }],
+            ),
+            block(
+                1,
+                vec![
+                    Instruction::Mov {
+                        dst: Operand::local(0),
+                        src: condition,
+                    },
+                    jump(3),
+                ],
+            ),
+            block(
+                2,
+                vec![
+                    Instruction::Mov {
+                        dst: Operand::local(1),
+                        src: condition,
+                    },
+                    jump(3),
+                ],
+            ),
+            block(3, vec![end()]),
+        ];
+        let statistics = optimize(&mut blocks);
+        assert_eq!(statistics, OptimizationStatistics::default());
+        assert_eq!(blocks.len(), 4);
+        assert_eq!(jump_target(&blocks[1]), Some(3));
+        assert_eq!(jump_target(&blocks[2]), Some(3));
+    }
+
+    #[test]
+    fn keeps_exception_handlers_and_renumbers_them() {
+        // Block 1 is dead; block 2 is protected by handler block 3.
+        let mut blocks = vec![
+            block(0, vec![jump(2)]),
+            block(1, vec![end()]),
+            block(2, vec![end()]),
+            block(3, vec![end()]),
+        ];
+        blocks[2].handler = Some(Label(3));
+        let statistics = optimize(&mut blocks);
+        assert_eq!(statistics.merged_blocks, 0);
+        assert_eq!(statistics.removed_blocks, 1);
+        assert_eq!(blocks.len(), 3);
+        assert_eq!(jump_target(&blocks[0]), Some(1));
+        assert_eq!(blocks[1].handler.map(|label| label.0), Some(2));
+        assert_eq!(blocks[2].index, 2);
+    }
+
+    #[test]
+    fn removes_self_moves() {
+        let local = Operand::local(0);
+        let mut blocks = vec![block(0, vec![Instruction::Mov { dst: local, src: local }, end()])];
+        let statistics = optimize(&mut blocks);
+        assert_eq!(statistics.removed_self_moves, 1);
+        assert_eq!(blocks[0].instructions.len(), 1);
+    }
+
+    #[test]
+    fn survives_a_cycle_of_trampolines() {
+        let mut blocks = vec![
+            block(0, vec![jump(1)]),
+            block(1, vec![jump(2)]),
+            block(2, vec![jump(1)]),
+        ];
+        optimize(&mut blocks);
+        assert!(!blocks.is_empty());
+        assert!(blocks.iter().all(|block| block.terminated));
+    }
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <LibMedia/Audio/SampleKernels.h>
+
+// NB: These work on raw pointers, since the bounds checks in Span's indexing would keep the loops from being vectorized.
+
+namespace Audio {
+
+void add_samples(Span<float> destination, ReadonlySpan<float> source)
+{
+    using AK::SIMD::f32x4;
+
+    VERIFY(destination.size() == source.size());
+    auto* destination_samples = destination.data();
+    auto const* source_samples = source.data();
+    auto count = destination.size();
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        auto sum = AK::SIMD::load_unaligned<f32x4>(destination_samples + i) + AK::SIMD::load_unaligned<f32x4>(source_samples + i);
+        AK::SIMD::store_unaligned(destination_samples + i, sum);
+    }
+    for (; i < count; i++)
+        destination_samples[i] += source_samples[i];
+}
+
+float dot_product(ReadonlySpan<float> a, ReadonlySpan<float> b)
+{
+    using AK::SIMD::f32x4;
+
+    VERIFY(a.size() == b.size());
+    auto const* a_samples = a.data();
+    auto const* b_samples = b.data();
+    auto count = a.size();
+
+    // NB: A single running sum makes every addition wait for the one before it, since the compiler may not reorder float
+    //     additions. Independent accumulators let the multiply-adds overlap.
+    f32x4 sums[4] {};
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        for (size_t j = 0; j < 4; j++)
+            sums[j] += AK::SIMD::load_unaligned<f32x4>(a_samples + i + (j * 4)) * AK::SIMD::load_unaligned<f32x4>(b_samples + i + (j * 4));
+    }
+    for (; i + 4 <= count; i += 4)
+        sums[0] += AK::SIMD::load_unaligned<f32x4>(a_samples + i) * AK::SIMD::load_unaligned<f32x4>(b_samples + i);
+
+    auto total = (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    auto sum = (total[0] + total[1]) + (total[2] + total[3]);
+    for (; i < count; i++)
+        sum += a_samples[i] * b_samples[i];
+    return sum;
+}
+
+}
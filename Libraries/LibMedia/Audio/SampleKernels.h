@@ -0,0 +1,21 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Span.h>
+
+namespace Audio {
+
+// Kernels for the loops over planar float samples that run for every frame of every stream.
+
+// Adds the source samples onto the destination ones.
+void add_samples(Span<float> destination, ReadonlySpan<float> source);
+
+// Returns the sum of the products of the samples at each index of the two spans, which must be the same length.
+float dot_product(ReadonlySpan<float>, ReadonlySpan<float>);
+
+}
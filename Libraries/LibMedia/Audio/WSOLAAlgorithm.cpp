@@ -196,7 +196,7 @@ void WSOLAAlgorithm::get_optimal_block()
             exclude_interval_high <= 0 ? 0 : static_cast<size_t>(exclude_interval_high),
         };
 
-        optimal_index = static_cast<i64>(WSOLAInternals::optimal_index(m_search_block, m_target_block, exclude_interval));
+        optimal_index = static_cast<i64>(WSOLAInternals::optimal_index(m_search_block, m_target_block, exclude_interval, m_search_buffers));
 
         optimal_index += m_search_block_index;
         peek_audio_with_zero_prepend(optimal_index, m_optimal_block);
@@ -11,6 +11,7 @@
 #include <AK/Vector.h>
 #include <LibMedia/Audio/AudioBuffer.h>
 #include <LibMedia/Audio/SampleSpecification.h>
+#include <LibMedia/Audio/WSOLAInternals.h>
 #include <LibMedia/AudioBlock.h>
 
 namespace Audio {
@@ -80,6 +81,7 @@ private:
     Media::AudioBlock m_optimal_block;
     Media::AudioBlock m_search_block;
     Media::AudioBlock m_target_block;
+    WSOLAInternals::SearchBuffers m_search_buffers;
 };
 
 }
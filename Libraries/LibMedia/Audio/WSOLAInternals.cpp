@@ -8,6 +8,7 @@
 
 #include <AK/Math.h>
 #include <AK/Vector.h>
+#include <LibMedia/Audio/SampleKernels.h>
 #include <LibMedia/Audio/WSOLAInternals.h>
 #include <LibMedia/AudioBlock.h>
 
@@ -48,10 +49,7 @@ void multi_channel_dot_product(Media::AudioBlock const& a, size_t frame_offset_a
     for (size_t channel_index = 0; channel_index < a.channel_count(); channel_index++) {
         auto channel_a = a.channel_data(channel_index).slice(frame_offset_a, num_frames);
         auto channel_b = b.channel_data(channel_index).slice(frame_offset_b, num_frames);
-        auto sum = 0.0f;
-        for (size_t i = 0; i < num_frames; i++)
-            sum += channel_a[i] * channel_b[i];
-        dot_product[channel_index] = sum;
+        dot_product[channel_index] = Audio::dot_product(channel_a, channel_b);
     }
 }
 
@@ -105,7 +103,7 @@ size_t decimated_search(size_t decimation, Interval exclude_interval,
     auto channel_count = static_cast<size_t>(search_segment.channel_count());
     auto block_size = target_block.frame_count();
     auto num_candidate_blocks = search_segment.frame_count() - (block_size - 1);
-    Vector<float> dot_product;
+    Vector<float, 8> dot_product;
     dot_product.resize(channel_count);
     float similarity[3];
 
@@ -173,7 +171,7 @@ size_t full_search(size_t low_limit, size_t high_limit, Interval exclude_interva
 {
     auto channel_count = static_cast<size_t>(search_block.channel_count());
     auto block_size = target_block.frame_count();
-    Vector<float> dot_product;
+    Vector<float, 8> dot_product;
     dot_product.resize(channel_count);
 
     auto best_similarity = -AK::Infinity<float>;
@@ -195,7 +193,7 @@ size_t full_search(size_t low_limit, size_t high_limit, Interval exclude_interva
 }
 
 size_t optimal_index(Media::AudioBlock const& search_block, Media::AudioBlock const& target_block,
-    Interval exclude_interval)
+    Interval exclude_interval, SearchBuffers& buffers)
 {
     VERIFY(search_block.channel_count() == target_block.channel_count());
     auto channel_count = static_cast<size_t>(search_block.channel_count());
@@ -204,9 +202,9 @@ size_t optimal_index(Media::AudioBlock const& search_block, Media::AudioBlock co
 
     constexpr size_t search_decimation = 5;
 
-    Vector<float> energy_target_block;
+    auto& energy_target_block = buffers.energy_target_block;
     energy_target_block.resize(channel_count);
-    Vector<float> energy_candidate_blocks;
+    auto& energy_candidate_blocks = buffers.energy_candidate_blocks;
     energy_candidate_blocks.resize(channel_count * num_candidate_blocks);
 
     multi_channel_moving_block_energies(search_block, target_size, energy_candidate_blocks.span());
@@ -10,6 +10,7 @@
 
 #include <AK/Span.h>
 #include <AK/Types.h>
+#include <AK/Vector.h>
 
 namespace Media {
 
@@ -44,8 +45,14 @@ size_t full_search(size_t low_limit, size_t high_limit, Interval exclude_interva
     ReadonlySpan<float> energy_target_block,
     ReadonlySpan<float> energy_candidate_blocks);
 
+// Scratch space for optimal_index(), kept between calls so that searches don't allocate.
+struct SearchBuffers {
+    Vector<float> energy_target_block;
+    Vector<float> energy_candidate_blocks;
+};
+
 size_t optimal_index(Media::AudioBlock const& search_block, Media::AudioBlock const& target_block,
-    Interval exclude_interval);
+    Interval exclude_interval, SearchBuffers&);
 
 void get_periodic_hanning_window(Span<float> window);
 
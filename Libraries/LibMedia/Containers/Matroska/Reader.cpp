@@ -863,7 +863,7 @@ DecoderErrorOr<SampleIterator> Reader::create_sample_iterator_at_byte_position(N
         for (auto const& [number, track_entry] : m_tracks)
             track_contexts.set(number, TrackBlockContext::from_track_entry(*track_entry));
     }
-    return SampleIterator(cursor, track_number, move(track_contexts), m_segment_information.timestamp_scale(), m_segment_contents_position, cluster_position.value());
+    return SampleIterator(cursor, track_number, move(track_contexts), m_segment_information.timestamp_scale(), m_segment_contents_position, cluster_position.value(), m_discovered_cue_points);
 }
 
 static DecoderErrorOr<CueTrackPosition> parse_cue_track_position(Streamer& streamer)
@@ -1089,6 +1089,12 @@ DecoderErrorOr<SampleIterator> Reader::seek_to_random_access_point(SampleIterato
     if (cue_points.has_value()) {
         TRY(seek_to_cue_for_timestamp(iterator, timestamp, cue_points.value(), seek_target));
         VERIFY(iterator.last_timestamp().has_value());
+    } else if (auto cue_point = m_discovered_cue_points->find_at_or_before(track_number, timestamp); cue_point.has_value()) {
+        // Without cues, jump to the last keyframe we've come across before the target, as long as that beats scanning
+        // from either where the iterator is now or the start of the Segment.
+        auto const& last_timestamp = iterator.last_timestamp();
+        if (!last_timestamp.has_value() || timestamp < last_timestamp.value() || cue_point->timestamp > last_timestamp.value())
+            TRY(iterator.seek_to_cue_point(cue_point.value(), CuePointTarget::Block));
     }
 
     if (!iterator.last_timestamp().has_value() || timestamp < iterator.last_timestamp().value()) {
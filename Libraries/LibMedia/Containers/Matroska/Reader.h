@@ -95,6 +95,7 @@ private:
 
     // The vectors must be sorted by timestamp at all times.
     HashMap<u64, Vector<TrackCuePoint>> m_cues;
+    NonnullRefPtr<DiscoveredCuePoints> m_discovered_cue_points { make_ref_counted<DiscoveredCuePoints>() };
 
     struct BufferedRange {
         size_t start { 0 };
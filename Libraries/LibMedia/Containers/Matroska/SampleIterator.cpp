@@ -5,6 +5,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/BinarySearch.h>
 #include <AK/Debug.h>
 #include <LibMedia/Containers/Matroska/ElementIDs.h>
 #include <LibMedia/Containers/Matroska/Reader.h>
@@ -12,13 +13,56 @@
 
 namespace Media::Matroska {
 
-SampleIterator::SampleIterator(NonnullRefPtr<MediaStreamCursor> const& stream_cursor, Optional<u64> track_number, TrackBlockContexts&& track_contexts, u64 timestamp_scale, size_t segment_contents_position, size_t position)
+// Keyframes closer together than this aren't worth remembering, since seeking to either of them costs about the same.
+// This keeps files with only keyframes, like audio-only ones, from recording every block.
+static constexpr AK::Duration MINIMUM_DISCOVERED_CUE_POINT_SPACING = AK::Duration::from_seconds(1);
+
+// Returns the index of the first cue point at or after the timestamp.
+static size_t lower_bound_cue_point_index(Vector<TrackCuePoint> const& cue_points, AK::Duration timestamp)
+{
+    return lower_bound_index(cue_points, timestamp, [](TrackCuePoint const& cue_point, AK::Duration const& timestamp) {
+        if (cue_point.timestamp < timestamp)
+            return -1;
+        return cue_point.timestamp > timestamp ? 1 : 0;
+    });
+}
+
+void DiscoveredCuePoints::add(TrackCuePoint const& cue_point)
+{
+    Sync::MutexLocker locker { m_mutex };
+    auto& cue_points = m_cue_points.ensure(cue_point.position.track_number());
+
+    auto index = lower_bound_cue_point_index(cue_points, cue_point.timestamp);
+    if (index > 0 && cue_point.timestamp - cue_points[index - 1].timestamp < MINIMUM_DISCOVERED_CUE_POINT_SPACING)
+        return;
+    if (index < cue_points.size() && cue_points[index].timestamp - cue_point.timestamp < MINIMUM_DISCOVERED_CUE_POINT_SPACING)
+        return;
+    cue_points.insert(index, cue_point);
+}
+
+Optional<TrackCuePoint> DiscoveredCuePoints::find_at_or_before(u64 track_number, AK::Duration timestamp) const
+{
+    Sync::MutexLocker locker { m_mutex };
+    auto cue_points = m_cue_points.get(track_number);
+    if (!cue_points.has_value())
+        return {};
+
+    auto index = lower_bound_cue_point_index(*cue_points, timestamp);
+    if (index < cue_points->size() && (*cue_points)[index].timestamp == timestamp)
+        return (*cue_points)[index];
+    if (index == 0)
+        return {};
+    return (*cue_points)[index - 1];
+}
+
+SampleIterator::SampleIterator(NonnullRefPtr<MediaStreamCursor> const& stream_cursor, Optional<u64> track_number, TrackBlockContexts&& track_contexts, u64 timestamp_scale, size_t segment_contents_position, size_t position, NonnullRefPtr<DiscoveredCuePoints> const& discovered_cue_points)
     : m_stream_cursor(stream_cursor)
     , m_track_number(track_number)
     , m_track_block_contexts(move(track_contexts))
     , m_segment_timestamp_scale(timestamp_scale)
     , m_segment_contents_position(segment_contents_position)
     , m_position(position)
+    , m_discovered_cue_points(discovered_cue_points)
 {
 }
 
@@ -32,15 +76,22 @@ DecoderErrorOr<Block> SampleIterator::next_block()
     Optional<Block> block;
 
     while (true) {
-#if MATROSKA_TRACE_DEBUG
         auto element_position = streamer.position();
-#endif
         auto element_id = TRY(streamer.read_element_id());
 #if MATROSKA_TRACE_DEBUG
         dbgln("Iterator found element with ID {:#010x} at offset {} within the segment.", element_id, element_position);
 #endif
 
         auto maybe_set_block = [&](Block&& candidate_block) {
+            // NB: Any track's keyframes are worth remembering, since another iterator may be looking for them later.
+            if (candidate_block.only_keyframes() && candidate_block.timestamp().has_value()) {
+                CueTrackPosition position;
+                position.set_track_number(candidate_block.track_number());
+                position.set_cluster_position(m_current_cluster_position - m_segment_contents_position);
+                position.set_block_offset(element_position - m_current_cluster_contents_position);
+                m_discovered_cue_points->add({ .timestamp = candidate_block.timestamp().value(), .position = position });
+            }
+
             if (m_track_number.has_value() && candidate_block.track_number() != m_track_number)
                 return;
             block = move(candidate_block);
@@ -49,6 +100,8 @@ DecoderErrorOr<Block> SampleIterator::next_block()
         if (element_id == CLUSTER_ELEMENT_ID) {
             dbgln_if(MATROSKA_DEBUG, "  Iterator is parsing new cluster.");
             m_current_cluster = TRY(Reader::parse_cluster_element(streamer, m_segment_timestamp_scale));
+            m_current_cluster_position = element_position;
+            m_current_cluster_contents_position = streamer.position();
         } else if (element_id == SIMPLE_BLOCK_ID) {
             if (!m_current_cluster.has_value()) {
                 dbgln("  Iterator encountered a simple block before parsing a Cluster.");
@@ -165,13 +218,16 @@ DecoderErrorOr<void> SampleIterator::seek_to_cue_point(TrackCuePoint const& cue_
     // This is a private function. The position getter can return optional, but the caller should already know that this track has a position.
     auto const& cue_position = cue_point.position;
     Streamer streamer { m_stream_cursor };
-    TRY(streamer.seek_to_position(m_segment_contents_position + cue_position.cluster_position()));
+    auto cluster_position = m_segment_contents_position + cue_position.cluster_position();
+    TRY(streamer.seek_to_position(cluster_position));
 
     auto element_id = TRY(streamer.read_element_id());
     if (element_id != CLUSTER_ELEMENT_ID)
         return DecoderError::corrupted("Cue point's cluster position didn't point to a cluster"sv);
 
     m_current_cluster = TRY(Reader::parse_cluster_element(streamer, m_segment_timestamp_scale));
+    m_current_cluster_position = cluster_position;
+    m_current_cluster_contents_position = streamer.position();
     dbgln_if(MATROSKA_DEBUG, "SampleIterator set to cue point at timestamp {}ms", m_current_cluster->timestamp().to_milliseconds());
 
     if (target == CuePointTarget::Cluster) {
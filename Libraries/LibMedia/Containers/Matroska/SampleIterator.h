@@ -7,11 +7,15 @@
 
 #pragma once
 
+#include <AK/AtomicRefCounted.h>
+#include <AK/HashMap.h>
 #include <AK/NonnullRefPtr.h>
 #include <AK/Optional.h>
+#include <AK/Vector.h>
 #include <LibMedia/DecoderError.h>
 #include <LibMedia/Export.h>
 #include <LibMedia/Forward.h>
+#include <LibSync/Mutex.h>
 
 #include "Document.h"
 
@@ -29,6 +33,20 @@ enum class CuePointTarget : u8 {
     Block,
 };
 
+// Keyframes that sample iterators have come across, recorded as cue points that target their blocks. Files without
+// cues can then be seeked to anywhere that has already been read without scanning again from the start of the segment.
+// Shared between all the iterators over one segment, which may be in use on different threads.
+class MEDIA_API DiscoveredCuePoints : public AtomicRefCounted<DiscoveredCuePoints> {
+public:
+    void add(TrackCuePoint const&);
+    Optional<TrackCuePoint> find_at_or_before(u64 track_number, AK::Duration timestamp) const;
+
+private:
+    mutable Sync::Mutex m_mutex;
+    // The vectors must be sorted by timestamp at all times.
+    HashMap<u64, Vector<TrackCuePoint>> m_cue_points;
+};
+
 class MEDIA_API SampleIterator {
     AK_MAKE_DEFAULT_MOVABLE(SampleIterator);
     AK_MAKE_DEFAULT_COPYABLE(SampleIterator);
@@ -46,7 +64,7 @@ public:
 private:
     friend class Reader;
 
-    SampleIterator(NonnullRefPtr<MediaStreamCursor> const& stream_cursor, Optional<u64> track_number, TrackBlockContexts&&, u64 timestamp_scale, size_t segment_contents_position, size_t position);
+    SampleIterator(NonnullRefPtr<MediaStreamCursor> const& stream_cursor, Optional<u64> track_number, TrackBlockContexts&&, u64 timestamp_scale, size_t segment_contents_position, size_t position, NonnullRefPtr<DiscoveredCuePoints> const&);
 
     DecoderErrorOr<void> seek_to_cue_point(TrackCuePoint const& cue_point, CuePointTarget);
 
@@ -62,6 +80,11 @@ private:
     Optional<AK::Duration> m_last_timestamp;
 
     Optional<Cluster> m_current_cluster;
+    // The positions of the current cluster's element and of its first child, respectively.
+    size_t m_current_cluster_position { 0 };
+    size_t m_current_cluster_contents_position { 0 };
+
+    NonnullRefPtr<DiscoveredCuePoints> m_discovered_cue_points;
 };
 
 }
@@ -5,6 +5,7 @@
  */
 
 #include <LibCore/EventLoop.h>
+#include <LibMedia/Audio/SampleKernels.h>
 #include <LibMedia/PipelineStatus.h>
 #include <LibMedia/Processors/AudioMixer.h>
 #include <LibMedia/Producers/DecodedAudioProducer.h>
@@ -323,8 +324,7 @@ void AudioMixer::pull(AudioBlock& into)
         for (size_t channel = 0; channel < channel_count; ++channel) {
             auto input_channel = current_block.channel_data(channel).slice(frame_index_in_block, frames_to_write);
             auto output_channel = into.channel_data(channel).slice(frame_index_in_buffer, frames_to_write);
-            for (size_t frame = 0; frame < frames_to_write; ++frame)
-                output_channel[frame] += input_channel[frame];
+            Audio::add_samples(output_channel, input_channel);
         }
 
         input_data.next_frame = next_frame + static_cast<i64>(frames_to_write);
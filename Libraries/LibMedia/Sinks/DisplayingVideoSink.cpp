@@ -149,10 +149,19 @@ DisplayingVideoSinkUpdateResult DisplayingVideoSink::update()
             break;
         if (m_next_frame->timestamp() > current_time)
             break;
+        if (result == DisplayingVideoSinkUpdateResult::NewFrameAvailable)
+            m_frame_counters.dropped_frames++;
         m_current_frame = m_next_frame.release_nonnull();
         result = DisplayingVideoSinkUpdateResult::NewFrameAvailable;
     }
 
+    if (result == DisplayingVideoSinkUpdateResult::NewFrameAvailable) {
+        m_frame_counters.presented_frames++;
+        auto const& duration = m_current_frame->duration();
+        if (duration > AK::Duration::zero() && m_current_frame->timestamp() + duration <= current_time)
+            m_frame_counters.late_frames++;
+    }
+
     // Dispatch the new state with a deferred invoke to avoid reentrancy. This prevents a seek from resolving while
     // an update is being processed.
     Core::deferred_invoke([self = NonnullRefPtr(*this), last_status] {
@@ -24,6 +24,15 @@ enum class [[nodiscard]] DisplayingVideoSinkUpdateResult : u8 {
 
 class MEDIA_API DisplayingVideoSink final : public VideoSink {
 public:
+    struct FrameCounters {
+        // Frames that update() left as the current frame.
+        u64 presented_frames { 0 };
+        // Frames that were due, but were replaced by a later frame in the same update, so they were never displayed.
+        u64 dropped_frames { 0 };
+        // Presented frames whose display interval had already ended by the time they were presented.
+        u64 late_frames { 0 };
+    };
+
     static ErrorOr<NonnullRefPtr<DisplayingVideoSink>> try_create(NonnullRefPtr<MediaTimeProvider> const&, PipelineStateChangeHandler on_state_changed);
 
     DisplayingVideoSink(NonnullRefPtr<MediaTimeProvider> const&, PipelineStateChangeHandler);
@@ -39,6 +48,8 @@ public:
     [[nodiscard]] DisplayingVideoSinkUpdateResult update();
     RefPtr<VideoFrame> current_frame();
 
+    FrameCounters const& frame_counters() const { return m_frame_counters; }
+
 private:
     void consume_moved_position_signals(PipelineStatus&);
 
@@ -57,6 +68,8 @@ private:
     };
     SeekStatus m_seek_status { SeekStatus::None };
 
+    FrameCounters m_frame_counters;
+
     PipelineStateChangeHandler m_on_state_changed;
     PipelineStatus m_last_dispatched_status { PipelineStatus::Pending };
     u32 m_seek_id { 0 };
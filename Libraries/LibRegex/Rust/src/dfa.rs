@@ -0,0 +1,555 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+//! Lazily built DFA that rules out inputs a pattern cannot match.
+//!
+//! The backtracking VM tries the pattern again at every candidate start
+//! position, so an input without a match can cost far more than a single pass
+//! over it. For patterns without backreferences, lookarounds or modifiers, the
+//! matcher can instead be simulated as a set of instruction threads that all
+//! advance together, one code point at a time. Each distinct set of threads is
+//! a DFA state; states and their transitions are built the first time a search
+//! needs them and kept for later searches with the same regex.
+//!
+//! The DFA only answers whether some match exists, and how far into the input
+//! the first one can start: whenever no match attempt is in progress, every
+//! earlier start position has failed. The match itself and its captures still
+//! come from the VM, which can skip those positions. The DFA errs on the side
+//! of matching: counted repetitions only track small counts, so it may report a
+//! match that the VM then fails to find, but it never rules out an input or a
+//! start position that the VM would match at.
+
+use crate::bytecode::*;
+use crate::vm::Input;
+use crate::vm::case_fold_eq;
+use crate::vm::code_point_len;
+use crate::vm::decode_code_point;
+use crate::vm::is_line_terminator;
+use crate::vm::is_word_char_unicode;
+use crate::vm::match_builtin_class;
+use crate::vm::match_char_class;
+use crate::vm::match_unicode_property_all_case_equivalents;
+use crate::vm::match_unicode_property_case_insensitive;
+use crate::vm::match_unicode_property_resolved;
+use std::collections::HashMap;
+
+/// Remaining input shorter than this is left to the VM, which is cheap on it anyway.
+pub(crate) const MIN_INPUT_LENGTH: usize = 32;
+
+/// A pattern that needs more states than this is not a good fit, and the DFA
+/// gives up on it for good.
+const MAX_STATES: usize = 1024;
+
+/// Transitions for code points outside ASCII are cached in a map of this size at most.
+const MAX_NON_ASCII_TRANSITIONS: usize = 8192;
+
+const MAX_INSTRUCTIONS: usize = 1 << 16;
+
+/// A thread is an instruction index, shifted left to make room for the number
+/// of times a simple loop at that instruction has matched. Counts are tracked
+/// exactly up to MAX_TRACKED_LOOP_COUNT; beyond that, any count is possible.
+const LOOP_COUNT_BITS: u32 = 3;
+const MAX_TRACKED_LOOP_COUNT: u32 = 4;
+
+const START_THREAD: u32 = 0;
+
+const ASCII_COUNT: usize = 128;
+const UNKNOWN: u32 = u32::MAX;
+const MATCHED: u32 = u32::MAX - 1;
+
+// What the code unit before a position means for the assertions at that position.
+const AT_INPUT_START: u8 = 1 << 0;
+const AFTER_LINE_TERMINATOR: u8 = 1 << 1;
+const AFTER_WORD_CHARACTER: u8 = 1 << 2;
+
+// Per-state flags, kept apart from the states so the search loop can check them cheaply.
+const STATE_DEAD: u8 = 1 << 0;
+const STATE_IDLE: u8 = 1 << 1;
+
+struct State {
+    /// Sorted threads waiting to consume the next code point.
+    threads: Box<[u32]>,
+    context: u8,
+    matches_at_end: Option<bool>,
+}
+
+pub(crate) enum DfaSearch {
+    NoMatch,
+    /// No match starts before this position.
+    MatchStartsAtOrAfter(usize),
+    /// The pattern needed too many states, and the DFA has given up on it.
+    Unknown,
+}
+
+pub struct LazyDfa {
+    /// Code unit that every match starts with. While the DFA is idle, it skips
+    /// straight to the next occurrence of it.
+    first_code_unit: Option<u16>,
+    /// Only the position the search starts at can start a match.
+    anchored: bool,
+    states: Vec<State>,
+    /// `STATE_*` flags of each state.
+    state_flags: Vec<u8>,
+    /// Maps a state's threads, followed by its context, to its index.
+    state_indices: HashMap<Box<[u32]>, u32>,
+    /// `ASCII_COUNT` entries per state.
+    ascii_transitions: Vec<u32>,
+    non_ascii_transitions: HashMap<(u32, u32), u32>,
+    gave_up: bool,
+
+    // Scratch space for computing transitions.
+    visited: Vec<u32>,
+    generation: u32,
+    stack: Vec<u32>,
+    next_threads: Vec<u32>,
+}
+
+#[inline(always)]
+fn thread_at(pc: u32) -> u32 {
+    pc << LOOP_COUNT_BITS
+}
+
+#[inline(always)]
+fn context_after_code_unit(code_unit: u16, unicode_ignore_case: bool) -> u8 {
+    let mut context = 0;
+    if is_line_terminator(code_unit as u32) {
+        context |= AFTER_LINE_TERMINATOR;
+    }
+    if is_word_char_unicode(code_unit as u32, unicode_ignore_case) {
+        context |= AFTER_WORD_CHARACTER;
+    }
+    context
+}
+
+#[inline(always)]
+fn context_after_code_point(code_point: u32, unicode_ignore_case: bool) -> u8 {
+    // NB: Assertions look at code units, and the last code unit of a surrogate
+    //     pair is a low surrogate.
+    if code_point > 0xFFFF {
+        return 0;
+    }
+    context_after_code_unit(code_point as u16, unicode_ignore_case)
+}
+
+fn is_supported(instruction: &Instruction) -> bool {
+    // NB: A thread that went back to the first instruction would look like a fresh match attempt.
+    let targets_start = match instruction {
+        Instruction::Jump(target) => *target == 0,
+        Instruction::Split { prefer, other } => *prefer == 0 || *other == 0,
+        Instruction::RepeatCheck { body, .. } => *body == 0,
+        _ => false,
+    };
+    !targets_start
+        && !matches!(
+            instruction,
+            Instruction::Backref(_)
+                | Instruction::BackrefNamed(_)
+                | Instruction::LookStart { .. }
+                | Instruction::LookEnd
+                | Instruction::PushModifiers { .. }
+                | Instruction::PopModifiers
+                | Instruction::StringPropertyMatch { .. }
+        )
+}
+
+fn unicode_property_matches(program: &Program, data: &UnicodePropertyData, code_point: u32) -> bool {
+    if program.ignore_case && program.unicode {
+        if data.negated && !program.unicode_sets {
+            return !match_unicode_property_all_case_equivalents(code_point, &data.name, data.value.as_deref());
+        }
+        let matched = match_unicode_property_case_insensitive(code_point, &data.name, data.value.as_deref());
+        return matched != data.negated;
+    }
+    let matched =
+        match_unicode_property_resolved(code_point, &data.name, data.value.as_deref(), data.resolved.as_ref());
+    matched != data.negated
+}
+
+// NB: These mirror the VM's matchers with the pattern's own flags, which are
+//     the only ones in effect without modifiers.
+fn simple_match_matches(program: &Program, matcher: &SimpleMatch, code_point: u32) -> bool {
+    match matcher {
+        SimpleMatch::AnyChar { dot_all } => *dot_all || program.dot_all || !is_line_terminator(code_point),
+        SimpleMatch::Char(c) => {
+            if program.ignore_case {
+                case_fold_eq(code_point, *c, program.unicode)
+            } else {
+                code_point == *c
+            }
+        }
+        SimpleMatch::CharNoCase(lo, _hi) => case_fold_eq(code_point, *lo, program.unicode),
+        SimpleMatch::CharClass { ranges, negated } => {
+            match_char_class(
+                code_point,
+                ranges,
+                program.ignore_case,
+                program.unicode,
+                program.unicode_sets,
+            ) != *negated
+        }
+        SimpleMatch::BuiltinClass(class) => {
+            match_builtin_class(code_point, *class, program.ignore_case && program.unicode)
+        }
+        SimpleMatch::UnicodeProperty(data) => unicode_property_matches(program, data, code_point),
+        SimpleMatch::Union(lhs, rhs) => {
+            simple_match_matches(program, lhs, code_point) || simple_match_matches(program, rhs, code_point)
+        }
+    }
+}
+
+impl LazyDfa {
+    /// Returns `None` if the program uses something the DFA can't simulate.
+    pub(crate) fn new(program: &Program, first_code_unit: Option<u16>, anchored: bool) -> Option<Self> {
+        if program.instructions.len() >= MAX_INSTRUCTIONS || !program.instructions.iter().all(is_supported) {
+            return None;
+        }
+        Some(Self {
+            first_code_unit: if anchored { None } else { first_code_unit },
+            anchored,
+            states: Vec::new(),
+            state_flags: Vec::new(),
+            state_indices: HashMap::new(),
+            ascii_transitions: Vec::new(),
+            non_ascii_transitions: HashMap::new(),
+            gave_up: false,
+            visited: Vec::new(),
+            generation: 0,
+            stack: Vec::new(),
+            next_threads: Vec::new(),
+        })
+    }
+
+    /// Look for the first match that starts at or after `start`.
+    pub(crate) fn search<I: Input>(&mut self, program: &Program, input: I, start: usize) -> DfaSearch {
+        if self.gave_up {
+            return DfaSearch::Unknown;
+        }
+
+        let mut pos = start;
+        let mut earliest_match_start = start;
+        let mut state = self.start_state(program, input, pos);
+        loop {
+            if state == UNKNOWN {
+                return DfaSearch::Unknown;
+            }
+            let flags = self.state_flags[state as usize];
+            if flags & STATE_DEAD != 0 {
+                return DfaSearch::NoMatch;
+            }
+
+            if flags & STATE_IDLE != 0 {
+                earliest_match_start = pos;
+                if let Some(code_unit) = self.first_code_unit {
+                    // NB: A match attempt that starts at the end of the input can't match the first code unit either.
+                    let Some(next_pos) = input.find_code_unit(pos, input.len(), code_unit) else {
+                        return DfaSearch::NoMatch;
+                    };
+                    if next_pos != pos {
+                        pos = next_pos;
+                        state = self.start_state(program, input, pos);
+                        continue;
+                    }
+                }
+            }
+
+            if pos >= input.len() {
+                return if self.matches_at_end(program, state) {
+                    DfaSearch::MatchStartsAtOrAfter(earliest_match_start)
+                } else {
+                    DfaSearch::NoMatch
+                };
+            }
+
+            // OPTIMIZATION: Most steps follow a cached ASCII transition to a state that needs nothing else done, so
+            //               follow those in a tight loop.
+            let stop_flags = if self.first_code_unit.is_some() {
+                STATE_DEAD | STATE_IDLE
+            } else {
+                STATE_DEAD
+            };
+            while pos < input.len() {
+                let code_unit = input.code_unit(pos);
+                if code_unit as usize >= ASCII_COUNT {
+                    break;
+                }
+                let next_state = self.ascii_transitions[state as usize * ASCII_COUNT + code_unit as usize];
+                if next_state >= MATCHED {
+                    break;
+                }
+                let next_flags = self.state_flags[next_state as usize];
+                if next_flags & stop_flags != 0 {
+                    break;
+                }
+                state = next_state;
+                pos += 1;
+                if next_flags & STATE_IDLE != 0 {
+                    earliest_match_start = pos;
+                }
+            }
+            if pos >= input.len() {
+                continue;
+            }
+
+            let code_point = decode_code_point(program.unicode, input, pos);
+            let next_state = if (code_point as usize) < ASCII_COUNT {
+                let index = state as usize * ASCII_COUNT + code_point as usize;
+                match self.ascii_transitions[index] {
+                    UNKNOWN => {
+                        let next_state = self.compute_transition(program, state, code_point);
+                        if next_state == UNKNOWN {
+                            return DfaSearch::Unknown;
+                        }
+                        self.ascii_transitions[index] = next_state;
+                        next_state
+                    }
+                    next_state => next_state,
+                }
+            } else if let Some(next_state) = self.non_ascii_transitions.get(&(state, code_point)) {
+                *next_state
+            } else {
+                let next_state = self.compute_transition(program, state, code_point);
+                if next_state == UNKNOWN {
+                    return DfaSearch::Unknown;
+                }
+                if self.non_ascii_transitions.len() < MAX_NON_ASCII_TRANSITIONS {
+                    self.non_ascii_transitions.insert((state, code_point), next_state);
+                }
+                next_state
+            };
+
+            if next_state == MATCHED {
+                return DfaSearch::MatchStartsAtOrAfter(earliest_match_start);
+            }
+            state = next_state;
+            pos += code_point_len(program.unicode, input, pos);
+        }
+    }
+
+    fn start_state<I: Input>(&mut self, program: &Program, input: I, pos: usize) -> u32 {
+        let context = if pos == 0 {
+            AT_INPUT_START
+        } else {
+            context_after_code_unit(input.code_unit(pos - 1), program.ignore_case && program.unicode)
+        };
+        self.next_threads.clear();
+        self.next_threads.push(START_THREAD);
+        self.intern_next_threads(context)
+    }
+
+    fn matches_at_end(&mut self, program: &Program, state: u32) -> bool {
+        if let Some(matches) = self.states[state as usize].matches_at_end {
+            return matches;
+        }
+        let matches = self.advance(program, state, None);
+        self.states[state as usize].matches_at_end = Some(matches);
+        matches
+    }
+
+    fn compute_transition(&mut self, program: &Program, state: u32, code_point: u32) -> u32 {
+        if self.advance(program, state, Some(code_point)) {
+            return MATCHED;
+        }
+        if !self.anchored {
+            self.next_threads.push(START_THREAD);
+        }
+        self.next_threads.sort_unstable();
+        self.next_threads.dedup();
+        self.intern_next_threads(context_after_code_point(
+            code_point,
+            program.ignore_case && program.unicode,
+        ))
+    }
+
+    /// Follows every thread of `state` through the instructions that don't consume
+    /// input, and collects the threads that consume `next` into `next_threads`.
+    /// Returns true if one of them reaches `Match` first.
+    fn advance(&mut self, program: &Program, state: u32, next: Option<u32>) -> bool {
+        let instructions = &program.instructions;
+        let unicode_ignore_case = program.ignore_case && program.unicode;
+        if self.visited.len() != instructions.len() << LOOP_COUNT_BITS {
+            self.visited = vec![0; instructions.len() << LOOP_COUNT_BITS];
+        }
+        self.generation = self.generation.wrapping_add(1);
+        if self.generation == 0 {
+            self.visited.fill(0);
+            self.generation = 1;
+        }
+
+        let context = self.states[state as usize].context;
+        let at_start = |multiline: bool| {
+            context & AT_INPUT_START != 0 || ((multiline || program.multiline) && context & AFTER_LINE_TERMINATOR != 0)
+        };
+        let at_end = |multiline: bool| {
+            next.is_none_or(|code_point| (multiline || program.multiline) && is_line_terminator(code_point))
+        };
+        let at_word_boundary = || {
+            let before = context & AFTER_WORD_CHARACTER != 0;
+            let after = next.is_some_and(|code_point| {
+                code_point <= 0xFFFF && is_word_char_unicode(code_point, unicode_ignore_case)
+            });
+            before != after
+        };
+        let consumes = |matches: &dyn Fn(u32) -> bool| next.is_some_and(matches);
+
+        self.stack.clear();
+        self.stack.extend_from_slice(&self.states[state as usize].threads);
+        self.next_threads.clear();
+
+        while let Some(thread) = self.stack.pop() {
+            if self.visited[thread as usize] == self.generation {
+                continue;
+            }
+            self.visited[thread as usize] = self.generation;
+
+            let pc = thread >> LOOP_COUNT_BITS;
+            let Some(instruction) = instructions.get(pc as usize) else {
+                continue;
+            };
+            let following = thread_at(pc + 1);
+            match instruction {
+                Instruction::Match => return true,
+                Instruction::Fail => {}
+                Instruction::Jump(target) => self.stack.push(thread_at(*target)),
+                Instruction::Split { prefer, other } => {
+                    self.stack.push(thread_at(*other));
+                    self.stack.push(thread_at(*prefer));
+                }
+                Instruction::Save(_)
+                | Instruction::ClearRegister(_)
+                | Instruction::Nop
+                | Instruction::RepeatStart { .. }
+                | Instruction::ProgressCheck { .. } => self.stack.push(following),
+                // NB: Repetition counters aren't tracked, so both continuing and leaving the loop are always possible.
+                Instruction::RepeatCheck { body, .. } => {
+                    self.stack.push(following);
+                    self.stack.push(thread_at(*body));
+                }
+                Instruction::AssertStart { multiline } => {
+                    if at_start(*multiline) {
+                        self.stack.push(following);
+                    }
+                }
+                Instruction::AssertEnd { multiline } => {
+                    if at_end(*multiline) {
+                        self.stack.push(following);
+                    }
+                }
+                Instruction::AssertWordBoundary => {
+                    if at_word_boundary() {
+                        self.stack.push(following);
+                    }
+                }
+                Instruction::AssertNonWordBoundary => {
+                    if !at_word_boundary() {
+                        self.stack.push(following);
+                    }
+                }
+                Instruction::GreedyLoop { matcher, min, max } | Instruction::LazyLoop { matcher, min, max } => {
+                    let count = thread & ((1 << LOOP_COUNT_BITS) - 1);
+                    if count >= (*min).min(MAX_TRACKED_LOOP_COUNT) {
+                        self.stack.push(following);
+                    }
+                    if max.is_none_or(|max| count < max)
+                        && consumes(&|code_point| simple_match_matches(program, matcher, code_point))
+                    {
+                        let tracked_limit = max.unwrap_or(*min).min(MAX_TRACKED_LOOP_COUNT);
+                        self.next_threads.push(thread_at(pc) | (count + 1).min(tracked_limit));
+                    }
+                }
+                Instruction::Char(c) => {
+                    let matcher = SimpleMatch::Char(*c);
+                    if consumes(&|code_point| simple_match_matches(program, &matcher, code_point)) {
+                        self.next_threads.push(following);
+                    }
+                }
+                Instruction::CharNoCase(lo, _hi) => {
+                    if consumes(&|code_point| case_fold_eq(code_point, *lo, program.unicode)) {
+                        self.next_threads.push(following);
+                    }
+                }
+                Instruction::AnyChar { dot_all } => {
+                    if consumes(&|code_point| *dot_all || program.dot_all || !is_line_terminator(code_point)) {
+                        self.next_threads.push(following);
+                    }
+                }
+                Instruction::CharClass { ranges, negated } => {
+                    if consumes(&|code_point| {
+                        match_char_class(
+                            code_point,
+                            ranges,
+                            program.ignore_case,
+                            program.unicode,
+                            program.unicode_sets,
+                        ) != *negated
+                    }) {
+                        self.next_threads.push(following);
+                    }
+                }
+                Instruction::BuiltinClass(class) => {
+                    if consumes(&|code_point| match_builtin_class(code_point, *class, unicode_ignore_case)) {
+                        self.next_threads.push(following);
+                    }
+                }
+                Instruction::UnicodeProperty(data) => {
+                    if consumes(&|code_point| unicode_property_matches(program, data, code_point)) {
+                        self.next_threads.push(following);
+                    }
+                }
+                Instruction::Backref(_)
+                | Instruction::BackrefNamed(_)
+                | Instruction::LookStart { .. }
+                | Instruction::LookEnd
+                | Instruction::PushModifiers { .. }
+                | Instruction::PopModifiers
+                | Instruction::StringPropertyMatch { .. } => unreachable!("rejected by LazyDfa::new()"),
+            }
+        }
+        false
+    }
+
+    /// Returns the state made of `next_threads` and `context`, creating it if needed.
+    fn intern_next_threads(&mut self, context: u8) -> u32 {
+        // NB: The only thread is a fresh match attempt, so nothing is in progress.
+        let is_idle = !self.anchored && self.next_threads.as_slice() == [START_THREAD];
+        self.next_threads.push(context as u32);
+        if let Some(index) = self.state_indices.get(self.next_threads.as_slice()) {
+            return *index;
+        }
+
+        if self.states.len() >= MAX_STATES {
+            self.give_up();
+            return UNKNOWN;
+        }
+
+        let index = self.states.len() as u32;
+        self.state_indices.insert(self.next_threads.as_slice().into(), index);
+        self.next_threads.pop();
+        self.states.push(State {
+            threads: self.next_threads.as_slice().into(),
+            context,
+            matches_at_end: None,
+        });
+        self.state_flags.push(if self.next_threads.is_empty() {
+            STATE_DEAD
+        } else if is_idle {
+            STATE_IDLE
+        } else {
+            0
+        });
+        self.ascii_transitions.resize(self.states.len() * ASCII_COUNT, UNKNOWN);
+        index
+    }
+
+    fn give_up(&mut self) {
+        self.gave_up = true;
+        self.states = Vec::new();
+        self.state_flags = Vec::new();
+        self.state_indices = HashMap::new();
+        self.ascii_transitions = Vec::new();
+        self.non_ascii_transitions = HashMap::new();
+        self.visited = Vec::new();
+    }
+}
@@ -17,6 +17,7 @@ use crate::bytecode::Instruction;
 use crate::bytecode::NamedGroupEntry;
 use crate::bytecode::append_code_point_wtf16;
 use crate::compiler;
+use crate::dfa;
 use crate::parser;
 use crate::vm;
 use std::cell::RefCell;
@@ -37,6 +38,8 @@ pub struct Regex {
     literal_alt_u16: Option<Vec<Vec<u16>>>,
     /// Cached VM scratch space for reuse across exec calls.
     scratch: RefCell<vm::VmScratch>,
+    /// DFA that rules out inputs without a match, with the states built so far.
+    dfa: RefCell<Option<dfa::LazyDfa>>,
 }
 
 impl Regex {
@@ -51,6 +54,11 @@ impl Regex {
         let literal_u16 = extract_literal_u16(&parsed, flags);
         let word_boundary_literal_u16 = extract_word_boundary_literal_u16(&parsed, flags);
         let literal_alt_u16 = extract_literal_alternatives_u16(&parsed, flags);
+        let dfa = if literal_u16.is_none() && word_boundary_literal_u16.is_none() && literal_alt_u16.is_none() {
+            vm::build_dfa(&program, &hints)
+        } else {
+            None
+        };
 
         Ok(Self {
             program,
@@ -60,6 +68,7 @@ impl Regex {
             word_boundary_literal_u16,
             literal_alt_u16,
             scratch: RefCell::new(vm::VmScratch::new()),
+            dfa: RefCell::new(dfa),
         })
     }
 
@@ -106,7 +115,8 @@ impl Regex {
             };
         }
         let scratch = &mut *self.scratch.borrow_mut();
-        vm::execute_into_with_scratch(&self.program, input, start, &self.hints, out, scratch)
+        let mut dfa = self.dfa.borrow_mut();
+        vm::execute_into_with_scratch(&self.program, input, start, &self.hints, out, scratch, dfa.as_mut())
     }
 
     /// Test whether the regex matches anywhere in the input.
@@ -150,7 +160,16 @@ impl Regex {
         // Reuse cached scratch space for the VM. Only need group 0 for test().
         let mut out = [-1i32; 2];
         let scratch = &mut *self.scratch.borrow_mut();
-        vm::execute_into_with_scratch(&self.program, input, start, &self.hints, &mut out, scratch)
+        let mut dfa = self.dfa.borrow_mut();
+        vm::execute_into_with_scratch(
+            &self.program,
+            input,
+            start,
+            &self.hints,
+            &mut out,
+            scratch,
+            dfa.as_mut(),
+        )
     }
 
     /// Fast literal substring search for whole-pattern literal fast paths.
@@ -549,7 +568,16 @@ impl Regex {
         }
         // Use the VM-internal find_all loop which reuses a single VM across matches.
         let scratch = &mut *self.scratch.borrow_mut();
-        vm::find_all_with_scratch(&self.program, input, start, &self.hints, result_buf, scratch)
+        let mut dfa = self.dfa.borrow_mut();
+        vm::find_all_with_scratch(
+            &self.program,
+            input,
+            start,
+            &self.hints,
+            result_buf,
+            scratch,
+            dfa.as_mut(),
+        )
     }
 }
 
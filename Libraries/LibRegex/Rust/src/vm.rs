@@ -13,6 +13,9 @@
 //! - <https://tc39.es/ecma262/#sec-pattern-semantics>
 //! - <https://tc39.es/ecma262/#sec-regexpbuiltinexec>
 use crate::bytecode::*;
+use crate::dfa;
+use crate::dfa::DfaSearch;
+use crate::dfa::LazyDfa;
 
 /// Maximum number of steps before aborting (prevents ReDoS).
 const MATCH_LIMIT: u64 = 10_000_000;
@@ -51,6 +54,13 @@ pub trait Input: Copy {
         self.find_code_unit(start_pos, self.len(), ch16)
     }
 
+    /// Find the first position in `start..end` holding `first`, with `last` at `distance` code units after it.
+    /// `end + distance` must not exceed the input length.
+    #[inline(always)]
+    fn find_code_unit_pair(self, start: usize, end: usize, first: u16, last: u16, distance: usize) -> Option<usize> {
+        (start..end).find(|&pos| self.code_unit(pos) == first && self.code_unit(pos + distance) == last)
+    }
+
     #[inline(always)]
     fn matches_u16_at(self, pos: usize, needle: &[u16]) -> bool {
         if pos + needle.len() > self.len() {
@@ -86,6 +96,46 @@ pub trait Input: Copy {
     }
 }
 
+// NB: Scanning a fixed-size chunk without stopping early lets the compiler turn the comparisons into vector
+//     instructions. Only the chunk that has a hit is scanned a second time to find where it is.
+const SCAN_CHUNK_SIZE: usize = 64;
+
+#[inline(always)]
+fn find_in_chunks<T: Copy + PartialEq>(haystack: &[T], needle: T) -> Option<usize> {
+    let mut chunks = haystack.chunks_exact(SCAN_CHUNK_SIZE);
+    let mut offset = 0;
+    for chunk in &mut chunks {
+        if chunk.iter().fold(false, |found, &c| found | (c == needle)) {
+            return chunk.iter().position(|&c| c == needle).map(|index| offset + index);
+        }
+        offset += SCAN_CHUNK_SIZE;
+    }
+    let index = chunks.remainder().iter().position(|&c| c == needle)?;
+    Some(offset + index)
+}
+
+/// Find the first index holding `first` with `last` at `distance` after it. Checking both ends of a literal rules
+/// out far more candidates than its first code unit alone.
+#[inline(always)]
+fn find_pair_in_chunks<T: Copy + PartialEq>(haystack: &[T], first: T, last: T, distance: usize) -> Option<usize> {
+    let candidate_count = haystack.len().checked_sub(distance)?;
+    let firsts = haystack[..candidate_count].chunks_exact(SCAN_CHUNK_SIZE);
+    let lasts = haystack[distance..].chunks_exact(SCAN_CHUNK_SIZE);
+    let mut offset = 0;
+    for (first_chunk, last_chunk) in firsts.zip(lasts) {
+        let found = first_chunk
+            .iter()
+            .zip(last_chunk)
+            .fold(false, |found, (&a, &b)| found | ((a == first) & (b == last)));
+        if found {
+            let index = (0..SCAN_CHUNK_SIZE).find(|&i| first_chunk[i] == first && last_chunk[i] == last)?;
+            return Some(offset + index);
+        }
+        offset += SCAN_CHUNK_SIZE;
+    }
+    (offset..candidate_count).find(|&index| haystack[index] == first && haystack[index + distance] == last)
+}
+
 impl Input for &[u16] {
     #[inline(always)]
     fn len(self) -> usize {
@@ -99,7 +149,13 @@ impl Input for &[u16] {
 
     #[inline(always)]
     fn find_code_unit(self, start: usize, end: usize, ch16: u16) -> Option<usize> {
-        let offset = self.get(start..end)?.iter().position(|&c| c == ch16)?;
+        let offset = find_in_chunks(self.get(start..end)?, ch16)?;
+        Some(start + offset)
+    }
+
+    #[inline(always)]
+    fn find_code_unit_pair(self, start: usize, end: usize, first: u16, last: u16, distance: usize) -> Option<usize> {
+        let offset = find_pair_in_chunks(self.get(start..end + distance)?, first, last, distance)?;
         Some(start + offset)
     }
 
@@ -136,7 +192,19 @@ impl Input for &[u8] {
         if byte > 0x7F {
             return None;
         }
-        let offset = self.get(start..end)?.iter().position(|&c| c == byte)?;
+        let offset = find_in_chunks(self.get(start..end)?, byte)?;
+        Some(start + offset)
+    }
+
+    #[inline(always)]
+    fn find_code_unit_pair(self, start: usize, end: usize, first: u16, last: u16, distance: usize) -> Option<usize> {
+        let (Ok(first), Ok(last)) = (u8::try_from(first), u8::try_from(last)) else {
+            return None;
+        };
+        if first > 0x7F || last > 0x7F {
+            return None;
+        }
+        let offset = find_pair_in_chunks(self.get(start..end + distance)?, first, last, distance)?;
         Some(start + offset)
     }
 
@@ -299,8 +367,9 @@ fn contains_u16_from<I: Input>(input: I, start: usize, needle: &[u16]) -> bool {
 
     let mut pos = start;
     let end = input.len() - needle.len() + 1;
+    let last_offset = needle.len() - 1;
     while pos < end {
-        match input.find_code_unit(pos, end, needle[0]) {
+        match input.find_code_unit_pair(pos, end, needle[0], needle[last_offset], last_offset) {
             Some(candidate_pos) => pos = candidate_pos,
             None => return false,
         }
@@ -380,6 +449,28 @@ fn fails_required_literal_hint<I: Input>(input: I, start: usize, hints: &Pattern
     !matched
 }
 
+/// Ask the DFA, if the pattern has one, where the first match at or after `pos` can start. Returns `None` if there is
+/// no such match. Short inputs go straight to the VM, since a pass of the DFA over them saves little.
+#[inline(always)]
+fn dfa_search_start<I: Input>(
+    dfa: &mut Option<&mut LazyDfa>,
+    program: &Program,
+    input: I,
+    pos: usize,
+) -> Option<usize> {
+    let Some(dfa) = dfa else {
+        return Some(pos);
+    };
+    if input.len().saturating_sub(pos) < dfa::MIN_INPUT_LENGTH {
+        return Some(pos);
+    }
+    match dfa.search(program, input, pos) {
+        DfaSearch::NoMatch => None,
+        DfaSearch::MatchStartsAtOrAfter(start) => Some(start),
+        DfaSearch::Unknown => Some(pos),
+    }
+}
+
 // Detect a leading input-start assertion even when it is wrapped in the
 // non-consuming setup instructions emitted for captures or lookahead.
 #[inline(always)]
@@ -494,8 +585,9 @@ pub fn execute_into_with_scratch<I: Input>(
     hints: &PatternHints,
     out: &mut [i32],
     scratch: &mut VmScratch,
+    dfa: Option<&mut LazyDfa>,
 ) -> VmResult {
-    execute_into_impl(program, input, start_pos, hints, out, scratch)
+    execute_into_impl(program, input, start_pos, hints, out, scratch, dfa)
 }
 
 /// Execute the program at exactly `start_pos`.
@@ -534,6 +626,7 @@ pub fn find_all_with_scratch<I: Input>(
     hints: &PatternHints,
     result_buf: &mut [i32],
     scratch: &mut VmScratch,
+    mut dfa: Option<&mut LazyDfa>,
 ) -> i32 {
     if fails_trailing_literal_hint(input, hints) {
         return 0;
@@ -547,10 +640,16 @@ pub fn find_all_with_scratch<I: Input>(
         return find_all_simple_scan(program, input, start_pos, scan, result_buf);
     }
 
+    // NB: The DFA is asked again after every match rather than at every candidate, so that each of its scans ends
+    //     where the VM's next match does at the earliest, and together they cover the input once.
+    let Some(first_candidate_pos) = dfa_search_start(&mut dfa, program, input, start_pos) else {
+        return 0;
+    };
+
     let mut vm = Vm::new(program, input, start_pos, scratch);
     let capacity = result_buf.len();
     let mut count = 0i32;
-    let mut pos = start_pos;
+    let mut pos = first_candidate_pos;
 
     if let Some(ref start_hint) = hints.start_position_hint
         && !program.unicode
@@ -568,7 +667,12 @@ pub fn find_all_with_scratch<I: Input>(
                     result_buf[idx] = match_start;
                     result_buf[idx + 1] = match_end;
                     count += 1;
-                    pos = next_search_position(match_start, match_end);
+                    let Some(next_pos) =
+                        dfa_search_start(&mut dfa, program, input, next_search_position(match_start, match_end))
+                    else {
+                        return count;
+                    };
+                    pos = next_pos;
                 }
                 VmResult::LimitExceeded => return -2,
                 VmResult::NoMatch => {
@@ -615,7 +719,12 @@ pub fn find_all_with_scratch<I: Input>(
                     result_buf[idx] = match_start;
                     result_buf[idx + 1] = match_end;
                     count += 1;
-                    pos = next_search_position(match_start, match_end);
+                    let Some(next_pos) =
+                        dfa_search_start(&mut dfa, program, input, next_search_position(match_start, match_end))
+                    else {
+                        return count;
+                    };
+                    pos = next_pos;
                 }
                 VmResult::LimitExceeded => return -2,
                 VmResult::NoMatch => {
@@ -640,7 +749,12 @@ pub fn find_all_with_scratch<I: Input>(
                 result_buf[idx] = match_start;
                 result_buf[idx + 1] = match_end;
                 count += 1;
-                pos = next_search_position(match_start, match_end);
+                let Some(next_pos) =
+                    dfa_search_start(&mut dfa, program, input, next_search_position(match_start, match_end))
+                else {
+                    return count;
+                };
+                pos = next_pos;
             }
             VmResult::LimitExceeded => return -2,
             VmResult::NoMatch => {
@@ -695,6 +809,7 @@ fn execute_into_impl<I: Input>(
     hints: &PatternHints,
     out: &mut [i32],
     scratch: &mut VmScratch,
+    mut dfa: Option<&mut LazyDfa>,
 ) -> VmResult {
     if fails_trailing_literal_hint(input, hints) {
         return VmResult::NoMatch;
@@ -713,6 +828,10 @@ fn execute_into_impl<I: Input>(
         };
     }
 
+    let Some(start_pos) = dfa_search_start(&mut dfa, program, input, start_pos) else {
+        return VmResult::NoMatch;
+    };
+
     // Reuse a single VM across all starting positions to avoid repeated allocation.
     let mut vm = Vm::new(program, input, start_pos, scratch);
     let mut hit_limit = false;
@@ -1275,6 +1394,23 @@ pub(crate) fn analyze_pattern(
     }
 }
 
+/// Build the DFA for a pattern the VM would otherwise have to try at many start positions.
+pub(crate) fn build_dfa(program: &Program, hints: &PatternHints) -> Option<LazyDfa> {
+    // NB: A pattern that can match the empty string matches at most positions anyway, and the VM finds those quickly.
+    if hints.can_match_empty || hints.simple_scan.is_some() {
+        return None;
+    }
+    let first_code_unit = match hints.first_char {
+        Some((ch, false)) if !program.unicode && ch <= 0xFFFF => Some(ch as u16),
+        _ => None,
+    };
+    LazyDfa::new(
+        program,
+        first_code_unit,
+        hints.starts_with_anchor && !hints.anchor_multiline,
+    )
+}
+
 fn pick_more_selective_required_literal(
     lhs: Option<RequiredLiteralHint>,
     rhs: Option<RequiredLiteralHint>,
@@ -3457,7 +3593,7 @@ fn is_word_char(cp: u32) -> bool {
 /// definition, including the Unicode ignore-case extension when requested.
 /// <https://tc39.es/ecma262/#sec-wordcharacters>
 #[inline(always)]
-fn is_word_char_unicode(cp: u32, unicode_ignore_case: bool) -> bool {
+pub(crate) fn is_word_char_unicode(cp: u32, unicode_ignore_case: bool) -> bool {
     if is_word_char(cp) {
         return true;
     }
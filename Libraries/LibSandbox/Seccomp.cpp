@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/QuickSort.h>
 #include <LibSandbox/Seccomp.h>
 #include <errno.h>
 #include <fcntl.h>
@@ -56,14 +57,9 @@ static constexpr unsigned read_only_open_flags = O_CLOEXEC;
 #define SECCOMP_ALLOW BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ALLOW)
 #define SECCOMP_TRAP BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_TRAP)
 #define SECCOMP_ERRNO(error) BPF_STMT(BPF_RET | BPF_K, SECCOMP_RET_ERRNO | ((error) & SECCOMP_RET_DATA))
-#define SECCOMP_ALLOW_NOTHING BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0)
-#define SECCOMP_APPEND_ALLOW_SYSCALL(policy, name)                               \
-    do {                                                                         \
-        (policy).append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_##name, 0, 1)); \
-        (policy).append(SECCOMP_ALLOW);                                          \
-    } while (0)
+#define SECCOMP_APPEND_ALLOW_SYSCALL(policy, name) (policy).allow_syscall(__NR_##name)
 #define SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(policy, name) \
-    IF_DEFINED_##name(SECCOMP_APPEND_ALLOW_SYSCALL(policy, name), (policy).append(SECCOMP_ALLOW_NOTHING))
+    IF_DEFINED_##name(SECCOMP_APPEND_ALLOW_SYSCALL(policy, name), (void)0)
 
 #define IF_DEFINED_accept(if_defined, if_not_defined) if_defined
 #define IF_DEFINED_accept4(if_defined, if_not_defined) if_defined
@@ -685,74 +681,75 @@ static ErrorOr<void> install_sigsys_handler()
 
 }
 
-SeccompPolicy::SeccompPolicy()
-{
-    append_architecture_check();
-    append_load_syscall_number();
-}
-
-void SeccompPolicy::append(sock_filter filter)
-{
-    MUST(m_filter.try_append(filter));
-}
+SeccompPolicy::SeccompPolicy() = default;
 
-void SeccompPolicy::append_architecture_check()
+void SeccompPolicy::add_rule(u32 syscall_number, ReadonlySpan<sock_filter> rule)
 {
-    append(SECCOMP_LOAD_ARCHITECTURE);
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, audit_architecture, 1, 0));
-    append(SECCOMP_TRAP);
+    auto& rules = m_rules_by_syscall.ensure(syscall_number);
+    MUST(rules.try_append(rule.data(), rule.size()));
 }
 
-void SeccompPolicy::append_load_syscall_number()
+void SeccompPolicy::add_rule(u32 syscall_number, std::initializer_list<sock_filter> rule)
 {
-    append(SECCOMP_LOAD_SYSCALL_NR);
+    add_rule(syscall_number, ReadonlySpan<sock_filter> { rule.begin(), rule.size() });
 }
 
-void SeccompPolicy::append_kill()
+void SeccompPolicy::allow_syscall(u32 syscall_number)
 {
-    append(SECCOMP_TRAP);
+    add_rule(syscall_number, { SECCOMP_ALLOW });
 }
 
 void SeccompPolicy::deny_readonly_filesystem_probes()
 {
 #ifdef __NR_open
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_open, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~read_only_open_flags));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1));
-    append(SECCOMP_ERRNO(EACCES));
-    append(SECCOMP_LOAD_SYSCALL_NR);
+    add_rule(__NR_open, {
+                            SECCOMP_LOAD_ARGUMENT(1),
+                            BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~read_only_open_flags),
+                            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1),
+                            SECCOMP_ERRNO(EACCES),
+                        });
 #endif
 #ifdef __NR_openat
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_openat, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(2));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~read_only_open_flags));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1));
-    append(SECCOMP_ERRNO(EACCES));
-    append(SECCOMP_LOAD_SYSCALL_NR);
+    add_rule(__NR_openat, {
+                              SECCOMP_LOAD_ARGUMENT(2),
+                              BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~read_only_open_flags),
+                              BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1),
+                              SECCOMP_ERRNO(EACCES),
+                          });
 #endif
 }
 
 void SeccompPolicy::allow_readonly_file_opens()
 {
 #ifdef __NR_open
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_open, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~read_only_open_flags));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
+    add_rule(__NR_open, {
+                            SECCOMP_LOAD_ARGUMENT(1),
+                            BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~read_only_open_flags),
+                            BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1),
+                            SECCOMP_ALLOW,
+                        });
 #endif
 #ifdef __NR_openat
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_openat, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(2));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~read_only_open_flags));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
+    add_rule(__NR_openat, {
+                              SECCOMP_LOAD_ARGUMENT(2),
+                              BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~read_only_open_flags),
+                              BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1),
+                              SECCOMP_ALLOW,
+                          });
 #endif
 }
 
+void SeccompPolicy::allow_argument_value(u32 syscall_number, u32 argument_index, u32 value)
+{
+    // NB: Like SECCOMP_LOAD_ARGUMENT(), this loads the low 32 bits of the argument.
+    auto argument_offset = static_cast<u32>(offsetof(seccomp_data, args) + argument_index * sizeof(u64));
+    add_rule(syscall_number, {
+                                 BPF_STMT(BPF_LD | BPF_W | BPF_ABS, argument_offset),
+                                 BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, value, 0, 1),
+                                 SECCOMP_ALLOW,
+                             });
+}
+
 void SeccompPolicy::allow_filesystem_metadata_queries()
 {
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, access);
@@ -781,26 +778,9 @@ void SeccompPolicy::allow_filesystem_writes()
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, fdatasync);
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, flock);
 
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_fcntl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, F_GETLK, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
-
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_fcntl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, F_SETLK, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
-
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_fcntl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, F_SETLKW, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
+    allow_argument_value(__NR_fcntl, 1, F_GETLK);
+    allow_argument_value(__NR_fcntl, 1, F_SETLK);
+    allow_argument_value(__NR_fcntl, 1, F_SETLKW);
 }
 
 void SeccompPolicy::allow_file_descriptor_operations()
@@ -819,99 +799,35 @@ void SeccompPolicy::allow_file_descriptor_operations()
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, sendfile);
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, memfd_create);
 
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_fcntl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, F_GETFD, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
-
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_fcntl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, F_SETFD, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
-
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_fcntl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, F_GETFL, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
-
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_fcntl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, F_SETFL, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
-
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_fcntl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, F_DUPFD_CLOEXEC, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
-
+    allow_argument_value(__NR_fcntl, 1, F_GETFD);
+    allow_argument_value(__NR_fcntl, 1, F_SETFD);
+    allow_argument_value(__NR_fcntl, 1, F_GETFL);
+    allow_argument_value(__NR_fcntl, 1, F_SETFL);
+    allow_argument_value(__NR_fcntl, 1, F_DUPFD_CLOEXEC);
 #ifdef F_DUPFD_QUERY
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_fcntl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, F_DUPFD_QUERY, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
+    allow_argument_value(__NR_fcntl, 1, F_DUPFD_QUERY);
 #endif
-
 #ifdef F_ADD_SEALS
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_fcntl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, F_ADD_SEALS, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
+    allow_argument_value(__NR_fcntl, 1, F_ADD_SEALS);
 #endif
-
 #ifdef F_GET_SEALS
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_fcntl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, F_GET_SEALS, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
-#endif
-
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_ioctl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, FIONBIO, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
-
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_ioctl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, FIONREAD, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
-
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_ioctl, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(1));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, TCGETS, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-    append(BPF_STMT(BPF_ALU | BPF_ADD | BPF_K, 0));
+    allow_argument_value(__NR_fcntl, 1, F_GET_SEALS);
+#endif
+
+    allow_argument_value(__NR_ioctl, 1, FIONBIO);
+    allow_argument_value(__NR_ioctl, 1, FIONREAD);
+    allow_argument_value(__NR_ioctl, 1, TCGETS);
 }
 
 void SeccompPolicy::allow_process_creation()
 {
 #ifdef __NR_clone
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_clone, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(0));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~vfork_clone_flags));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
+    add_rule(__NR_clone, {
+                             SECCOMP_LOAD_ARGUMENT(0),
+                             BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~vfork_clone_flags),
+                             BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1),
+                             SECCOMP_ALLOW,
+                         });
 #endif
 
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, execve);
@@ -934,11 +850,7 @@ void SeccompPolicy::allow_ipc()
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, sendmmsg);
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, socketpair);
 #ifdef __NR_socket
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_socket, 0, 3));
-    append(SECCOMP_LOAD_ARGUMENT(0));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, AF_UNIX, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
+    allow_argument_value(__NR_socket, 0, AF_UNIX);
 #endif
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, connect);
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, getsockopt);
@@ -960,28 +872,18 @@ void SeccompPolicy::allow_network()
 
 void SeccompPolicy::allow_memory_without_executable_mappings()
 {
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_mmap, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(2));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, PROT_EXEC));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
+    static constexpr sock_filter no_executable_protection[] {
+        SECCOMP_LOAD_ARGUMENT(2),
+        BPF_STMT(BPF_ALU | BPF_AND | BPF_K, PROT_EXEC),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1),
+        SECCOMP_ALLOW,
+    };
 
+    add_rule(__NR_mmap, no_executable_protection);
 #ifdef __NR_mmap2
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_mmap2, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(2));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, PROT_EXEC));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
+    add_rule(__NR_mmap2, no_executable_protection);
 #endif
-
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_mprotect, 0, 5));
-    append(SECCOMP_LOAD_ARGUMENT(2));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, PROT_EXEC));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
+    add_rule(__NR_mprotect, no_executable_protection);
 
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, mremap);
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, munmap);
@@ -991,55 +893,39 @@ void SeccompPolicy::allow_memory_without_executable_mappings()
 
 void SeccompPolicy::allow_executable_memory_mappings()
 {
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_mmap, 0, 8));
-    append(SECCOMP_LOAD_ARGUMENT(2));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, PROT_EXEC));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 4, 0));
-    append(SECCOMP_LOAD_ARGUMENT(2));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, PROT_WRITE));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
+    // Executable mappings are fine as long as they aren't writable as well.
+    static constexpr sock_filter executable_but_not_writable_protection[] {
+        SECCOMP_LOAD_ARGUMENT(2),
+        BPF_STMT(BPF_ALU | BPF_AND | BPF_K, PROT_EXEC),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 4, 0),
+        SECCOMP_LOAD_ARGUMENT(2),
+        BPF_STMT(BPF_ALU | BPF_AND | BPF_K, PROT_WRITE),
+        BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1),
+        SECCOMP_ALLOW,
+    };
 
+    add_rule(__NR_mmap, executable_but_not_writable_protection);
 #ifdef __NR_mmap2
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_mmap2, 0, 8));
-    append(SECCOMP_LOAD_ARGUMENT(2));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, PROT_EXEC));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 4, 0));
-    append(SECCOMP_LOAD_ARGUMENT(2));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, PROT_WRITE));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
-#endif
-
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_mprotect, 0, 8));
-    append(SECCOMP_LOAD_ARGUMENT(2));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, PROT_EXEC));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 4, 0));
-    append(SECCOMP_LOAD_ARGUMENT(2));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, PROT_WRITE));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
+    add_rule(__NR_mmap2, executable_but_not_writable_protection);
+#endif
+    add_rule(__NR_mprotect, executable_but_not_writable_protection);
 }
 
 void SeccompPolicy::allow_threads()
 {
 #ifdef __NR_clone
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_clone, 0, 8));
-    append(SECCOMP_LOAD_ARGUMENT(0));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, thread_clone_required_flags));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, thread_clone_required_flags, 0, 4));
-    append(SECCOMP_LOAD_ARGUMENT(0));
-    append(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~thread_clone_allowed_flags));
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1));
-    append(SECCOMP_ALLOW);
-    append(SECCOMP_LOAD_SYSCALL_NR);
+    add_rule(__NR_clone, {
+                             SECCOMP_LOAD_ARGUMENT(0),
+                             BPF_STMT(BPF_ALU | BPF_AND | BPF_K, thread_clone_required_flags),
+                             BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, thread_clone_required_flags, 0, 4),
+                             SECCOMP_LOAD_ARGUMENT(0),
+                             BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~thread_clone_allowed_flags),
+                             BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, 0, 0, 1),
+                             SECCOMP_ALLOW,
+                         });
 #endif
 #ifdef __NR_clone3
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_clone3, 0, 1));
-    append(SECCOMP_ERRNO(ENOSYS));
+    add_rule(__NR_clone3, { SECCOMP_ERRNO(ENOSYS) });
 #endif
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, futex);
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, futex_time64);
@@ -1098,36 +984,28 @@ void SeccompPolicy::allow_process_metadata()
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, umask);
 
 #ifdef __NR_sched_getscheduler
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_sched_getscheduler, 0, 1));
-    append(SECCOMP_ALLOW);
+    allow_syscall(__NR_sched_getscheduler);
 #endif
 #ifdef __NR_sched_get_priority_max
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_sched_get_priority_max, 0, 1));
-    append(SECCOMP_ALLOW);
+    allow_syscall(__NR_sched_get_priority_max);
 #endif
 #ifdef __NR_sched_get_priority_min
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_sched_get_priority_min, 0, 1));
-    append(SECCOMP_ALLOW);
+    allow_syscall(__NR_sched_get_priority_min);
 #endif
 #ifdef __NR_getpriority
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_getpriority, 0, 1));
-    append(SECCOMP_ALLOW);
+    allow_syscall(__NR_getpriority);
 #endif
 #ifdef __NR_setpriority
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_setpriority, 0, 1));
-    append(SECCOMP_ERRNO(EPERM));
+    add_rule(__NR_setpriority, { SECCOMP_ERRNO(EPERM) });
 #endif
 #ifdef __NR_sched_setscheduler
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_sched_setscheduler, 0, 1));
-    append(SECCOMP_ERRNO(EPERM));
+    add_rule(__NR_sched_setscheduler, { SECCOMP_ERRNO(EPERM) });
 #endif
 #ifdef __NR_sched_setparam
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_sched_setparam, 0, 1));
-    append(SECCOMP_ERRNO(EPERM));
+    add_rule(__NR_sched_setparam, { SECCOMP_ERRNO(EPERM) });
 #endif
 #ifdef __NR_sched_setaffinity
-    append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, __NR_sched_setaffinity, 0, 1));
-    append(SECCOMP_ERRNO(EPERM));
+    add_rule(__NR_sched_setaffinity, { SECCOMP_ERRNO(EPERM) });
 #endif
 }
 
@@ -1153,15 +1031,127 @@ void SeccompPolicy::allow_exit()
     SECCOMP_APPEND_ALLOW_SYSCALL_IF_DEFINED(*this, exit_group);
 }
 
+namespace {
+
+// Lays out a filter program, resolving jumps to labels once everything is in place. Those are always unconditional jumps,
+// as their 32-bit offsets reach anywhere in the program, unlike the 8-bit offsets of conditional jumps.
+struct ProgramBuilder {
+    static constexpr size_t trap_label = 0;
+
+    ProgramBuilder()
+    {
+        auto label = create_label();
+        VERIFY(label == trap_label);
+    }
+
+    size_t create_label()
+    {
+        MUST(label_targets.try_append({}));
+        return label_targets.size() - 1;
+    }
+
+    void bind_label(size_t label) { label_targets[label] = instructions.size(); }
+
+    void append(sock_filter instruction) { MUST(instructions.try_append(instruction)); }
+
+    void append_jump_to_label(size_t label)
+    {
+        MUST(pending_jumps.try_append({ .instruction_index = instructions.size(), .label = label }));
+        append(BPF_JUMP(BPF_JMP | BPF_JA, 0, 0, 0));
+    }
+
+    Vector<sock_filter> finish()
+    {
+        for (auto const& jump : pending_jumps)
+            instructions[jump.instruction_index].k = static_cast<u32>(*label_targets[jump.label] - jump.instruction_index - 1);
+        return move(instructions);
+    }
+
+    struct PendingJump {
+        size_t instruction_index { 0 };
+        size_t label { 0 };
+    };
+
+    Vector<sock_filter> instructions;
+    Vector<Optional<size_t>> label_targets;
+    Vector<PendingJump> pending_jumps;
+};
+
+}
+
+// Emits a binary search over the sorted syscall numbers, so that finding a syscall's rules takes a logarithmic number of
+// comparisons rather than one for every syscall that comes before it in the policy.
+static void append_syscall_dispatch(ProgramBuilder& builder, ReadonlySpan<u32> syscall_numbers, ReadonlySpan<size_t> rule_labels)
+{
+    static constexpr size_t maximum_linear_search_size = 4;
+
+    if (syscall_numbers.size() <= maximum_linear_search_size) {
+        for (size_t i = 0; i < syscall_numbers.size(); ++i) {
+            builder.append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, syscall_numbers[i], 0, 1));
+            builder.append_jump_to_label(rule_labels[i]);
+        }
+        builder.append_jump_to_label(ProgramBuilder::trap_label);
+        return;
+    }
+
+    auto middle = syscall_numbers.size() / 2;
+    auto upper_half_label = builder.create_label();
+
+    builder.append(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, syscall_numbers[middle], 0, 1));
+    builder.append_jump_to_label(upper_half_label);
+    append_syscall_dispatch(builder, syscall_numbers.slice(0, middle), rule_labels.slice(0, middle));
+
+    builder.bind_label(upper_half_label);
+    append_syscall_dispatch(builder, syscall_numbers.slice(middle), rule_labels.slice(middle));
+}
+
+Vector<sock_filter> SeccompPolicy::assemble() const
+{
+    ProgramBuilder builder;
+
+    builder.append(SECCOMP_LOAD_ARCHITECTURE);
+    builder.append(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, audit_architecture, 1, 0));
+    builder.append(SECCOMP_TRAP);
+    builder.append(SECCOMP_LOAD_SYSCALL_NR);
+
+    Vector<u32> syscall_numbers;
+    MUST(syscall_numbers.try_ensure_capacity(m_rules_by_syscall.size()));
+    for (auto syscall_number : m_rules_by_syscall.keys())
+        syscall_numbers.unchecked_append(syscall_number);
+    quick_sort(syscall_numbers);
+
+    Vector<size_t> rule_labels;
+    MUST(rule_labels.try_ensure_capacity(syscall_numbers.size()));
+    for (size_t i = 0; i < syscall_numbers.size(); ++i)
+        rule_labels.unchecked_append(builder.create_label());
+
+    append_syscall_dispatch(builder, syscall_numbers, rule_labels);
+
+    // Each syscall's rules run in the order they were added, and anything they let fall through is a violation.
+    for (size_t i = 0; i < syscall_numbers.size(); ++i) {
+        builder.bind_label(rule_labels[i]);
+        for (auto instruction : *m_rules_by_syscall.get(syscall_numbers[i]))
+            builder.append(instruction);
+        builder.append_jump_to_label(ProgramBuilder::trap_label);
+    }
+
+    builder.bind_label(ProgramBuilder::trap_label);
+    builder.append(SECCOMP_TRAP);
+
+    return builder.finish();
+}
+
 ErrorOr<void> SeccompPolicy::install()
 {
     TRY(install_sigsys_handler());
 
-    append_kill();
+    auto filter = assemble();
+    if (filter.size() > BPF_MAXINSNS)
+        return Error::from_string_literal("Seccomp filter has too many instructions");
 
     sock_fprog program {
-        .len = static_cast<unsigned short>(m_filter.size()),
-        .filter = m_filter.data(),
+        .len = static_cast<unsigned short>(filter.size()),
+        .filter = filter.data(),
     };
 
 #ifdef __NR_seccomp
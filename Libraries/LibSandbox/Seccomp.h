@@ -7,6 +7,8 @@
 #pragma once
 
 #include <AK/Error.h>
+#include <AK/HashMap.h>
+#include <AK/Span.h>
 #include <AK/Vector.h>
 #include <linux/filter.h>
 
@@ -38,12 +40,16 @@ public:
     [[nodiscard]] ErrorOr<void> install();
 
 private:
-    void append(sock_filter);
-    void append_architecture_check();
-    void append_load_syscall_number();
-    void append_kill();
+    // A rule is a BPF fragment that runs with the syscall's arguments at hand, and either returns an action or falls
+    // through to the next rule added for the same syscall. Syscalls with no rule left to fall through to are violations.
+    void add_rule(u32 syscall_number, ReadonlySpan<sock_filter>);
+    void add_rule(u32 syscall_number, std::initializer_list<sock_filter>);
+    void allow_syscall(u32 syscall_number);
+    void allow_argument_value(u32 syscall_number, u32 argument_index, u32 value);
 
-    Vector<sock_filter> m_filter;
+    Vector<sock_filter> assemble() const;
+
+    HashMap<u32, Vector<sock_filter>> m_rules_by_syscall;
 };
 
 }
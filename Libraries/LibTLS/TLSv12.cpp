@@ -5,9 +5,12 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/HashMap.h>
+#include <AK/NeverDestroyed.h>
 #include <LibCore/ElapsedTimer.h>
 #include <LibCore/Promise.h>
 #include <LibCrypto/OpenSSL.h>
+#include <LibSync/MutexProtected.h>
 #include <LibTLS/TLSv12.h>
 
 #ifdef AK_OS_WINDOWS
@@ -23,16 +26,138 @@
 
 namespace TLS {
 
+// Resumable sessions from earlier connections, so that reconnecting to a server (say, after a network change, or when
+// the DNS resolver reopens its DoT connection) only needs an abbreviated handshake.
+static constexpr size_t MAX_CACHED_SESSIONS = 256;
+
+static Sync::MutexProtected<OrderedHashMap<ByteString, SSL_SESSION*>>& session_cache()
+{
+    static NeverDestroyed<Sync::MutexProtected<OrderedHashMap<ByteString, SSL_SESSION*>>> cache;
+    return *cache;
+}
+
+static ByteString session_cache_key(ByteString const& host, u16 port, Options const& options)
+{
+    // NB: A session is only good for the protocol it was negotiated for, so connections offering different ALPN
+    //     protocols to the same server don't share sessions.
+    return ByteString::formatted("{}:{}/{}", host, port, ByteString::join(',', options.alpn_protocols));
+}
+
+static SSL_SESSION* find_cached_session(ByteString const& key)
+{
+    return session_cache().with_locked([&](auto& sessions) -> SSL_SESSION* {
+        auto session = sessions.get(key);
+        if (!session.has_value())
+            return nullptr;
+
+        if (!SSL_SESSION_is_resumable(*session)) {
+            SSL_SESSION_free(*session);
+            sessions.remove(key);
+            return nullptr;
+        }
+
+        SSL_SESSION_up_ref(*session);
+        return *session;
+    });
+}
+
+// Called by OpenSSL whenever the server hands us a session, which for TLS 1.3 happens after the handshake, whenever
+// the ticket arrives. Returning 1 takes over OpenSSL's reference to the session.
+static int cache_new_session(SSL* ssl, SSL_SESSION* session)
+{
+    auto const* key = static_cast<ByteString const*>(SSL_get_app_data(ssl));
+    if (!key)
+        return 0;
+
+    session_cache().with_locked([&](auto& sessions) {
+        if (auto previous = sessions.take(*key); previous.has_value())
+            SSL_SESSION_free(*previous);
+
+        // Evict the least recently stored session to make room.
+        if (sessions.size() >= MAX_CACHED_SESSIONS)
+            SSL_SESSION_free(sessions.take_first());
+
+        sessions.set(*key, session);
+    });
+    return 1;
+}
+
+static ErrorOr<SSL_CTX*> create_client_context(Optional<ByteString> const& root_certificates_path)
+{
+    auto* ssl_ctx = OPENSSL_TRY_PTR(SSL_CTX_new(TLS_client_method()));
+    ArmedScopeGuard free_ssl_ctx = [&] { SSL_CTX_free(ssl_ctx); };
+
+    // Configure the client to abort the handshake if certificate verification fails.
+    SSL_CTX_set_verify(ssl_ctx, SSL_VERIFY_PEER, nullptr);
+
+    if (root_certificates_path.has_value()) {
+        SSL_CTX_load_verify_file(ssl_ctx, root_certificates_path->characters());
+    } else {
+        // Use the default trusted certificate store
+#if defined(AK_OS_WINDOWS)
+        // https://stackoverflow.com/questions/9507184/can-openssl-on-windows-use-the-system-certificate-store
+        // https://docs.openssl.org/master/man7/OSSL_STORE-winstore/
+        OPENSSL_TRY(SSL_CTX_load_verify_store(ssl_ctx, "org.openssl.winstore://"));
+#else
+        OPENSSL_TRY(SSL_CTX_set_default_verify_paths(ssl_ctx));
+#endif
+    }
+
+    // Require a minimum TLS version of TLSv1.2.
+    OPENSSL_TRY(SSL_CTX_set_min_proto_version(ssl_ctx, TLS1_2_VERSION));
+
+    // NB: OpenSSL's own session cache only works for servers, so clients have to keep their sessions themselves.
+    SSL_CTX_set_session_cache_mode(ssl_ctx, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+    SSL_CTX_sess_set_new_cb(ssl_ctx, cache_new_session);
+
+    free_ssl_ctx.disarm();
+    return ssl_ctx;
+}
+
+// Loading the trust store is by far the most expensive part of setting up a context, so every connection using the
+// same root certificates shares one. The caller gets its own reference to it.
+static ErrorOr<SSL_CTX*> shared_client_context(Optional<ByteString> const& root_certificates_path)
+{
+    static NeverDestroyed<Sync::MutexProtected<HashMap<ByteString, SSL_CTX*>>> contexts;
+
+    return contexts->with_locked([&](auto& contexts) -> ErrorOr<SSL_CTX*> {
+        auto key = root_certificates_path.value_or({});
+
+        auto ssl_ctx = contexts.get(key);
+        if (!ssl_ctx.has_value()) {
+            ssl_ctx = TRY(create_client_context(root_certificates_path));
+            contexts.set(key, *ssl_ctx);
+        }
+
+        SSL_CTX_up_ref(*ssl_ctx);
+        return *ssl_ctx;
+    });
+}
+
+static ErrorOr<ByteBuffer> alpn_protocol_list(Vector<ByteString> const& protocols)
+{
+    // The protocol list is sent as a sequence of length-prefixed, non-empty strings.
+    ByteBuffer list;
+    for (auto const& protocol : protocols) {
+        if (protocol.is_empty() || protocol.length() > 255)
+            return Error::from_string_literal("Invalid ALPN protocol name");
+
+        TRY(list.try_append(static_cast<u8>(protocol.length())));
+        TRY(list.try_append(protocol.bytes()));
+    }
+    return list;
+}
+
 ErrorOr<NonnullOwnPtr<TLSv12>> TLSv12::connect(ByteString const& host, u16 port, Options options)
 {
     auto tcp_socket = TRY(Core::TCPSocket::connect(host, port));
-    return connect_internal(move(tcp_socket), host, move(options));
+    return connect_internal(move(tcp_socket), host, port, move(options));
 }
 
 ErrorOr<NonnullOwnPtr<TLSv12>> TLSv12::connect(Core::SocketAddress const& address, ByteString const& host, Options options)
 {
     auto tcp_socket = TRY(Core::TCPSocket::connect(address));
-    return connect_internal(move(tcp_socket), host, move(options));
+    return connect_internal(move(tcp_socket), host, address.port(), move(options));
 }
 
 static void wait_for_activity(int sock, bool read)
@@ -173,11 +298,21 @@ ErrorOr<void> TLSv12::set_close_on_exec(bool enabled)
     return m_socket->set_close_on_exec(enabled);
 }
 
-TLSv12::TLSv12(NonnullOwnPtr<Core::TCPSocket> socket, SSL_CTX* ssl_ctx, SSL* ssl)
+bool TLSv12::is_session_reused() const
+{
+    return m_ssl && SSL_session_reused(m_ssl) == 1;
+}
+
+TLSv12::TLSv12(NonnullOwnPtr<Core::TCPSocket> socket, SSL_CTX* ssl_ctx, SSL* ssl, ByteString session_cache_key)
     : m_ssl_ctx(ssl_ctx)
     , m_ssl(ssl)
+    , m_session_cache_key(move(session_cache_key))
     , m_socket(move(socket))
 {
+    // TLS 1.3 servers send their session tickets after the handshake, so keep telling the session cache who we're
+    // talking to for as long as the connection lives.
+    SSL_set_app_data(m_ssl, &m_session_cache_key);
+
     m_socket->on_ready_to_read = [this] {
         // There is something to read on the underlying TCP connection. This doesn't mean there is actual data to read from the SSL connection.
         // For example, we might have received an alert or a connection reset.
@@ -207,35 +342,32 @@ TLSv12::~TLSv12()
     SSL_CTX_free(m_ssl_ctx);
 }
 
-ErrorOr<NonnullOwnPtr<TLSv12>> TLSv12::connect_internal(NonnullOwnPtr<Core::TCPSocket> socket, ByteString const& host, Options options)
+ErrorOr<NonnullOwnPtr<TLSv12>> TLSv12::connect_internal(NonnullOwnPtr<Core::TCPSocket> socket, ByteString const& host, u16 port, Options options)
 {
     TRY(socket->set_blocking(false));
 
-    auto* ssl_ctx = OPENSSL_TRY_PTR(SSL_CTX_new(TLS_client_method()));
+    auto* ssl_ctx = TRY(shared_client_context(options.root_certificates_path));
     ArmedScopeGuard free_ssl_ctx = [&] { SSL_CTX_free(ssl_ctx); };
 
-    // Configure the client to abort the handshake if certificate verification fails.
-    SSL_CTX_set_verify(ssl_ctx, SSL_VERIFY_PEER, nullptr);
+    auto* ssl = OPENSSL_TRY_PTR(SSL_new(ssl_ctx));
+    ArmedScopeGuard free_ssl = [&] { SSL_free(ssl); };
 
-    if (options.root_certificates_path.has_value()) {
-        auto path = options.root_certificates_path.value();
-        SSL_CTX_load_verify_file(ssl_ctx, path.characters());
-    } else {
-        // Use the default trusted certificate store
-#if defined(AK_OS_WINDOWS)
-        // https://stackoverflow.com/questions/9507184/can-openssl-on-windows-use-the-system-certificate-store
-        // https://docs.openssl.org/master/man7/OSSL_STORE-winstore/
-        OPENSSL_TRY(SSL_CTX_load_verify_store(ssl_ctx, "org.openssl.winstore://"));
-#else
-        OPENSSL_TRY(SSL_CTX_set_default_verify_paths(ssl_ctx));
-#endif
+    if (!options.alpn_protocols.is_empty()) {
+        auto protocol_list = TRY(alpn_protocol_list(options.alpn_protocols));
+
+        // NB: Unlike most of OpenSSL, this returns 0 on success.
+        if (SSL_set_alpn_protos(ssl, protocol_list.data(), protocol_list.size()) != 0)
+            return Error::from_string_literal("Failed to set ALPN protocols");
     }
 
-    // Require a minimum TLS version of TLSv1.2.
-    OPENSSL_TRY(SSL_CTX_set_min_proto_version(ssl_ctx, TLS1_2_VERSION));
+    auto cache_key = session_cache_key(host, port, options);
+    SSL_set_app_data(ssl, &cache_key);
 
-    auto* ssl = OPENSSL_TRY_PTR(SSL_new(ssl_ctx));
-    ArmedScopeGuard free_ssl = [&] { SSL_free(ssl); };
+    if (auto* session = find_cached_session(cache_key)) {
+        // NB: SSL_set_session() takes its own reference to the session.
+        SSL_set_session(ssl, session);
+        SSL_SESSION_free(session);
+    }
 
     // Tell the server which hostname we are attempting to connect to in case the server supports multiple hosts.
     OPENSSL_TRY(SSL_set_tlsext_host_name(ssl, host.characters()));
@@ -275,7 +407,7 @@ ErrorOr<NonnullOwnPtr<TLSv12>> TLSv12::connect_internal(NonnullOwnPtr<Core::TCPS
     free_ssl.disarm();
     free_ssl_ctx.disarm();
 
-    return adopt_own(*new TLSv12(move(socket), ssl_ctx, ssl));
+    return adopt_own(*new TLSv12(move(socket), ssl_ctx, ssl, move(cache_key)));
 }
 
 }
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/Vector.h>
 #include <LibCore/Socket.h>
 #include <LibCrypto/Certificate/Certificate.h>
 #include <LibTLS/OpenSSLForward.h>
@@ -15,6 +16,9 @@ namespace TLS {
 
 struct Options {
     Optional<ByteString> root_certificates_path;
+
+    // Protocols offered to the server through ALPN, most preferred first.
+    Vector<ByteString> alpn_protocols;
 };
 
 class TLSv12 final : public Core::Socket {
@@ -40,21 +44,28 @@ public:
     virtual ErrorOr<void> set_blocking(bool block) override;
     virtual ErrorOr<void> set_close_on_exec(bool enabled) override;
 
+    /// Whether the handshake resumed a session from an earlier connection to
+    /// the same server, rather than doing a full one.
+    bool is_session_reused() const;
+
     static ErrorOr<NonnullOwnPtr<TLSv12>> connect(Core::SocketAddress const&, ByteString const& host, Options = {});
     static ErrorOr<NonnullOwnPtr<TLSv12>> connect(ByteString const& host, u16 port, Options = {});
 
     ~TLSv12() override;
 
 private:
-    explicit TLSv12(NonnullOwnPtr<Core::TCPSocket>, SSL_CTX*, SSL*);
+    explicit TLSv12(NonnullOwnPtr<Core::TCPSocket>, SSL_CTX*, SSL*, ByteString session_cache_key);
 
-    static ErrorOr<NonnullOwnPtr<TLSv12>> connect_internal(NonnullOwnPtr<Core::TCPSocket>, ByteString const&, Options);
+    static ErrorOr<NonnullOwnPtr<TLSv12>> connect_internal(NonnullOwnPtr<Core::TCPSocket>, ByteString const& host, u16 port, Options);
 
     void handle_fatal_error();
 
     SSL_CTX* m_ssl_ctx { nullptr };
     SSL* m_ssl { nullptr };
 
+    // The server and protocols new session tickets for this connection are cached under
+    ByteString m_session_cache_key;
+
     // Keep this around or the socket will be closed
     NonnullOwnPtr<Core::TCPSocket> m_socket;
 };
@@ -6,13 +6,26 @@
  */
 
 #include <AK/Function.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
 #include <AK/Time.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
+#include <LibFileSystem/FileSystem.h>
 #include <LibTest/Macros.h>
 #include <LibTest/TestResult.h>
 #include <LibTest/TestSuite.h>
 #include <math.h>
 
+#if defined(AK_OS_LINUX)
+#    include <linux/perf_event.h>
+#    include <sys/ioctl.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+#endif
+
 namespace Test {
 
 TestSuite* TestSuite::s_global = nullptr;
@@ -21,17 +34,168 @@ class TestElapsedTimer {
 public:
     TestElapsedTimer() { restart(); }
 
-    void restart() { m_started = UnixDateTime::now(); }
+    void restart() { m_started = MonotonicTime::now(); }
 
     AK::Duration elapsed() const
     {
-        return UnixDateTime::now() - m_started;
+        return MonotonicTime::now() - m_started;
     }
 
 private:
-    UnixDateTime m_started;
+    MonotonicTime m_started { MonotonicTime::now() };
+};
+
+struct PerfCounterValues {
+    u64 cycles { 0 };
+    u64 instructions { 0 };
+
+    PerfCounterValues& operator+=(PerfCounterValues const& other)
+    {
+        cycles += other.cycles;
+        instructions += other.instructions;
+        return *this;
+    }
 };
 
+// Counts the CPU cycles and instructions retired in user space while a benchmark runs. Only available on Linux, and
+// only where perf_event_paranoid allows unprivileged processes to count their own events.
+class PerfCounters {
+    AK_MAKE_NONCOPYABLE(PerfCounters);
+    AK_MAKE_NONMOVABLE(PerfCounters);
+
+public:
+    static OwnPtr<PerfCounters> try_create()
+    {
+#if defined(AK_OS_LINUX)
+        auto cycles_fd = open_counter(PERF_COUNT_HW_CPU_CYCLES);
+        if (cycles_fd < 0)
+            return nullptr;
+        auto instructions_fd = open_counter(PERF_COUNT_HW_INSTRUCTIONS);
+        if (instructions_fd < 0) {
+            close(cycles_fd);
+            return nullptr;
+        }
+        return adopt_own(*new PerfCounters(cycles_fd, instructions_fd));
+#else
+        return nullptr;
+#endif
+    }
+
+    ~PerfCounters()
+    {
+#if defined(AK_OS_LINUX)
+        close(m_cycles_fd);
+        close(m_instructions_fd);
+#endif
+    }
+
+    void start()
+    {
+#if defined(AK_OS_LINUX)
+        for (auto fd : { m_cycles_fd, m_instructions_fd }) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    PerfCounterValues stop()
+    {
+        PerfCounterValues values;
+#if defined(AK_OS_LINUX)
+        for (auto fd : { m_cycles_fd, m_instructions_fd })
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        values.cycles = read_counter(m_cycles_fd);
+        values.instructions = read_counter(m_instructions_fd);
+#endif
+        return values;
+    }
+
+private:
+#if defined(AK_OS_LINUX)
+    PerfCounters(int cycles_fd, int instructions_fd)
+        : m_cycles_fd(cycles_fd)
+        , m_instructions_fd(instructions_fd)
+    {
+    }
+
+    static int open_counter(u64 config)
+    {
+        perf_event_attr attributes {};
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = config;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        return static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+    }
+
+    static u64 read_counter(int fd)
+    {
+        u64 value = 0;
+        if (read(fd, &value, sizeof(value)) != sizeof(value))
+            return 0;
+        return value;
+    }
+
+    int m_cycles_fd { -1 };
+    int m_instructions_fd { -1 };
+#endif
+};
+
+struct BenchmarkStatistics {
+    size_t iterations { 0 };
+    AK::Duration min;
+    AK::Duration median;
+    AK::Duration p95;
+    AK::Duration max;
+    double mean_in_nanoseconds { 0 };
+    double standard_deviation_in_nanoseconds { 0 };
+};
+
+static BenchmarkStatistics compute_statistics(Vector<AK::Duration> iteration_times)
+{
+    VERIFY(!iteration_times.is_empty());
+    quick_sort(iteration_times);
+
+    BenchmarkStatistics statistics;
+    statistics.iterations = iteration_times.size();
+    statistics.min = iteration_times.first();
+    statistics.max = iteration_times.last();
+
+    auto middle = iteration_times.size() / 2;
+    if (iteration_times.size() % 2 == 0)
+        statistics.median = AK::Duration::from_nanoseconds((iteration_times[middle - 1].to_nanoseconds() + iteration_times[middle].to_nanoseconds()) / 2);
+    else
+        statistics.median = iteration_times[middle];
+
+    // Nearest-rank percentile: the smallest time that at least 95% of the iterations did not exceed.
+    auto p95_rank = static_cast<size_t>(ceil(0.95 * static_cast<double>(iteration_times.size())));
+    statistics.p95 = iteration_times[max(p95_rank, 1uz) - 1];
+
+    double sum = 0;
+    for (auto time : iteration_times)
+        sum += static_cast<double>(time.to_nanoseconds());
+    statistics.mean_in_nanoseconds = sum / static_cast<double>(iteration_times.size());
+
+    if (iteration_times.size() > 1) {
+        double sum_of_squared_deviations = 0;
+        for (auto time : iteration_times) {
+            auto deviation = static_cast<double>(time.to_nanoseconds()) - statistics.mean_in_nanoseconds;
+            sum_of_squared_deviations += deviation * deviation;
+        }
+        statistics.standard_deviation_in_nanoseconds = sqrt(sum_of_squared_deviations / static_cast<double>(iteration_times.size() - 1));
+    }
+
+    return statistics;
+}
+
+static double to_milliseconds(AK::Duration duration)
+{
+    return static_cast<double>(duration.to_nanoseconds()) / 1'000'000.0;
+}
+
 // Declared in Macros.h
 TestResult current_test_result()
 {
@@ -124,6 +288,10 @@ int TestSuite::main(ByteString const& suite_name, Span<StringView> arguments)
     args_parser.add_option(do_tests_only, "Only run tests.", "tests");
     args_parser.add_option(do_benchmarks_only, "Only run benchmarks.", "bench");
     args_parser.add_option(m_benchmark_repetitions, "Number of times to repeat each benchmark (default 1)", "benchmark_repetitions", 0, "N");
+    args_parser.add_option(m_benchmark_warmup_iterations, "Number of untimed runs of each benchmark before measuring it (default 0)", "benchmark_warmup", 0, "N");
+    args_parser.add_option(m_benchmark_min_time_in_milliseconds, "Keep repeating each benchmark until it has run for at least this long (default 0)", "benchmark_min_time", 0, "MS");
+    args_parser.add_option(m_benchmark_perf_counters, "Count CPU cycles and instructions of each benchmark (Linux only)", "benchmark_perf_counters");
+    args_parser.add_option(m_benchmark_json_path, "Write benchmark statistics as JSON to this file, or to <suite>.json in this directory", "benchmark_json", 0, "PATH");
     args_parser.add_option(m_randomized_runs, "Number of times to run each RANDOMIZED_TEST_CASE (default 100)", "randomized_runs", 0, "RUNS");
     args_parser.add_option(do_list_cases, "List available test cases.", "list");
     args_parser.add_positional_argument(search_string, "Only run matching cases.", "pattern", Core::ArgsParser::Required::No);
@@ -177,52 +345,102 @@ int TestSuite::run(Vector<NonnullRefPtr<TestCase>> const& tests)
     size_t benchmark_failed_count = 0;
     TestElapsedTimer global_timer;
 
+    // NB: Adaptive runs stop here even if they haven't reached the minimum time, so that a benchmark that takes
+    //     nanoseconds can't pile up an unbounded number of samples.
+    static constexpr size_t max_adaptive_repetitions = 1'000'000;
+    auto const benchmark_min_time = AK::Duration::from_milliseconds(m_benchmark_min_time_in_milliseconds);
+
+    OwnPtr<PerfCounters> perf_counters;
+    if (m_benchmark_perf_counters) {
+        perf_counters = PerfCounters::try_create();
+        if (!perf_counters)
+            warnln("Performance counters are not available, benchmarks will only be timed.");
+    }
+
+    JsonArray benchmark_results;
+
     for (auto const& t : tests) {
         auto const test_type = t->is_benchmark() ? "benchmark" : "test";
-        auto const repetitions = t->is_benchmark() ? m_benchmark_repetitions : 1;
+        auto const repetitions = t->is_benchmark() ? max(m_benchmark_repetitions, 1) : 1;
+        auto const warmup_iterations = t->is_benchmark() ? m_benchmark_warmup_iterations : 0;
+        auto const min_time = t->is_benchmark() ? benchmark_min_time : AK::Duration {};
+        auto* counters = t->is_benchmark() ? perf_counters.ptr() : nullptr;
 
         warnln("Running {} '{}'.", test_type, t->name());
         m_current_test_result = TestResult::NotRun;
         enable_reporting();
 
-        AK::Duration total_time;
-        u64 sum_of_squared_times = 0;
-        AK::Duration min_time = AK::Duration::max();
-        AK::Duration max_time;
-
-        for (u64 i = 0; i < repetitions; ++i) {
-            TestElapsedTimer timer;
+        auto run_once = [&] {
             t->func()();
-            auto const iteration_time = timer.elapsed();
-            auto const iteration_ms = iteration_time.to_milliseconds();
-            total_time += iteration_time;
-            sum_of_squared_times += iteration_ms * iteration_ms;
-            min_time = min(min_time, iteration_time);
-            max_time = max(max_time, iteration_time);
 
             // Non-randomized tests don't touch the test result when passing.
             if (m_current_test_result == TestResult::NotRun)
                 m_current_test_result = TestResult::Passed;
+        };
+
+        for (u64 i = 0; i < warmup_iterations; ++i)
+            run_once();
+
+        AK::Duration total_time;
+        Vector<AK::Duration> iteration_times;
+        PerfCounterValues total_counter_values;
+
+        while (iteration_times.size() < repetitions || (total_time < min_time && iteration_times.size() < max_adaptive_repetitions)) {
+            if (counters)
+                counters->start();
+            TestElapsedTimer timer;
+            run_once();
+            auto const iteration_time = timer.elapsed();
+            if (counters)
+                total_counter_values += counters->stop();
+
+            total_time += iteration_time;
+            iteration_times.append(iteration_time);
         }
 
         auto const total_time_ms = total_time.to_milliseconds();
+        auto const statistics = compute_statistics(move(iteration_times));
 
-        if (repetitions != 1) {
-            double average = total_time_ms / static_cast<double>(repetitions);
-            double average_squared = average * average;
-            double standard_deviation = sqrt((sum_of_squared_times + repetitions * average_squared - 2 * total_time_ms * average) / (repetitions - 1));
-
-            dbgln("{} {} '{}' on average in {:.1f}±{:.1f}ms (min={}ms, max={}ms, total={}ms)",
+        if (statistics.iterations != 1) {
+            dbgln("{} {} '{}' on average in {:.3f}±{:.3f}ms over {} iterations (min={:.3f}ms, median={:.3f}ms, p95={:.3f}ms, max={:.3f}ms, total={}ms)",
                 test_result_to_string(m_current_test_result), test_type, t->name(),
-                average,
-                standard_deviation,
-                min_time.to_milliseconds(),
-                max_time.to_milliseconds(),
+                statistics.mean_in_nanoseconds / 1'000'000.0,
+                statistics.standard_deviation_in_nanoseconds / 1'000'000.0,
+                statistics.iterations,
+                to_milliseconds(statistics.min),
+                to_milliseconds(statistics.median),
+                to_milliseconds(statistics.p95),
+                to_milliseconds(statistics.max),
                 total_time_ms);
         } else {
             dbgln("{} {} '{}' in {}ms", test_result_to_string(m_current_test_result), test_type, t->name(), total_time_ms);
         }
 
+        if (counters) {
+            auto const cycles = total_counter_values.cycles / statistics.iterations;
+            auto const instructions = total_counter_values.instructions / statistics.iterations;
+            dbgln("    {} cycles and {} instructions per iteration ({:.2f} instructions per cycle)",
+                cycles, instructions, cycles ? static_cast<double>(instructions) / static_cast<double>(cycles) : 0.0);
+        }
+
+        if (t->is_benchmark() && !m_benchmark_json_path.is_empty()) {
+            JsonObject result;
+            result.set("name"sv, t->name().view());
+            result.set("result"sv, test_result_to_string(m_current_test_result).view());
+            result.set("iterations"sv, statistics.iterations);
+            result.set("min_ns"sv, statistics.min.to_nanoseconds());
+            result.set("median_ns"sv, statistics.median.to_nanoseconds());
+            result.set("p95_ns"sv, statistics.p95.to_nanoseconds());
+            result.set("max_ns"sv, statistics.max.to_nanoseconds());
+            result.set("mean_ns"sv, statistics.mean_in_nanoseconds);
+            result.set("stddev_ns"sv, statistics.standard_deviation_in_nanoseconds);
+            if (counters) {
+                result.set("cycles"sv, total_counter_values.cycles / statistics.iterations);
+                result.set("instructions"sv, total_counter_values.instructions / statistics.iterations);
+            }
+            benchmark_results.must_append(move(result));
+        }
+
         if (t->is_benchmark()) {
             m_bench_time += total_time;
             benchmark_count++;
@@ -285,9 +503,35 @@ int TestSuite::run(Vector<NonnullRefPtr<TestCase>> const& tests)
         }
     }
 
+    auto failure_count = test_count - test_passed_count + benchmark_count - benchmark_passed_count;
+
+    if (benchmark_count != 0 && !m_benchmark_json_path.is_empty()) {
+        if (auto result = write_benchmark_results(move(benchmark_results)); result.is_error()) {
+            warnln("Unable to write benchmark results to {}: {}", m_benchmark_json_path, result.error());
+            ++failure_count;
+        }
+    }
+
     // We have multiple TestResults, all except for Passed being "bad".
     // Let's get a count of them:
-    return (int)(test_count - test_passed_count + benchmark_count - benchmark_passed_count);
+    return (int)failure_count;
+}
+
+ErrorOr<void> TestSuite::write_benchmark_results(JsonArray benchmark_results) const
+{
+    auto suite_name = LexicalPath::basename(m_suite_name);
+
+    auto path = m_benchmark_json_path;
+    if (FileSystem::is_directory(path))
+        path = LexicalPath::join(path, ByteString::formatted("{}.json", suite_name)).string();
+
+    JsonObject results;
+    results.set("suite"sv, suite_name);
+    results.set("benchmarks"sv, move(benchmark_results));
+
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    TRY(file->write_until_depleted(results.serialized().bytes()));
+    return {};
 }
 
 } // namespace Test
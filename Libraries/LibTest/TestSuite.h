@@ -9,6 +9,7 @@
 
 #include <AK/ByteString.h>
 #include <AK/Function.h>
+#include <AK/JsonArray.h>
 #include <AK/Time.h>
 #include <AK/Vector.h>
 #include <LibTest/Export.h>
@@ -65,12 +66,18 @@ public:
     u64 randomized_runs() { return m_randomized_runs; }
 
 private:
+    ErrorOr<void> write_benchmark_results(JsonArray) const;
+
     static TestSuite* s_global;
     Vector<NonnullRefPtr<TestCase>> m_cases;
     AK::Duration m_test_time;
     AK::Duration m_bench_time;
     ByteString m_suite_name;
     u64 m_benchmark_repetitions = 1;
+    u64 m_benchmark_warmup_iterations = 0;
+    u64 m_benchmark_min_time_in_milliseconds = 0;
+    bool m_benchmark_perf_counters = false;
+    ByteString m_benchmark_json_path;
     u64 m_randomized_runs = 100;
     Function<void()> m_setup;
     TestResult m_current_test_result = TestResult::NotRun;
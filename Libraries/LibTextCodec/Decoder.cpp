@@ -719,7 +719,7 @@ ErrorOr<String> StreamingDecoder::to_utf8(ReadonlyBytes input)
     }
 
     auto tail_length = m_decoder.incomplete_tail_length(bytes);
-    auto decoded = TRY(m_decoder.to_utf8(StringView(bytes.slice(0, bytes.size() - tail_length))));
+    auto decoded = TRY(decode(bytes.slice(0, bytes.size() - tail_length)));
 
     if (tail_length == 0)
         m_pending_input.clear();
@@ -730,11 +730,18 @@ ErrorOr<String> StreamingDecoder::to_utf8(ReadonlyBytes input)
 
 ErrorOr<String> StreamingDecoder::finish()
 {
-    auto decoded = TRY(m_decoder.to_utf8(StringView(m_pending_input.bytes())));
+    auto decoded = TRY(decode(m_pending_input.bytes()));
     m_pending_input.clear();
     return decoded;
 }
 
+ErrorOr<String> StreamingDecoder::decode(ReadonlyBytes bytes)
+{
+    if (m_invalid_input == InvalidInput::Fail && !m_decoder.validate(StringView(bytes)))
+        return Error::from_string_literal("Input contains improperly-encoded characters");
+    return m_decoder.to_utf8(StringView(bytes));
+}
+
 static ErrorOr<void> process_utf8_with_replacement_character(StringView input, Function<ErrorOr<void>(u32)> on_code_point)
 {
     auto bytes = input.bytes();
@@ -909,6 +916,11 @@ ErrorOr<String> UTF8Decoder::to_utf8(StringView input)
     if (auto bytes = input.bytes(); bytes.starts_with({ { 0xEF, 0xBB, 0xBF } }))
         input = input.substring_view(3);
 
+    // OPTIMIZATION: Almost all input is already valid UTF-8, which is confirmed with SIMD far faster than it can be
+    //               decoded code point by code point, and can then be used as-is.
+    if (Utf8View(input).validate(AllowLonelySurrogates::No))
+        return String::from_utf8_without_validation(input.bytes());
+
     StringBuilder builder(input.length());
     TRY(process_utf8_with_replacement_character(input, [&](auto code_point) {
         return builder.try_append_code_point(code_point);
@@ -1034,6 +1046,18 @@ ErrorOr<void> Latin1Decoder::process(StringView input, Function<ErrorOr<void>(u3
     return {};
 }
 
+ErrorOr<String> Latin1Decoder::to_utf8(StringView input)
+{
+    // OPTIMIZATION: ASCII bytes decode to themselves, so ASCII-only input is its own UTF-8 encoding.
+    if (input.is_ascii())
+        return String::from_utf8_without_validation(input.bytes());
+
+    StringBuilder builder(input.length());
+    for (u8 ch : input)
+        TRY(builder.try_append_code_point(ch));
+    return builder.to_string_without_validation();
+}
+
 ErrorOr<size_t> Latin1Decoder::length_in_utf16_code_units(StringView input)
 {
     return input.length();
@@ -1143,6 +1167,19 @@ ErrorOr<void> SingleByteDecoder<ArrayType>::process(StringView input, Function<E
     return {};
 }
 
+template<Integral ArrayType>
+ErrorOr<String> SingleByteDecoder<ArrayType>::to_utf8(StringView input)
+{
+    // OPTIMIZATION: ASCII bytes decode to themselves, so ASCII-only input is its own UTF-8 encoding.
+    if (input.is_ascii())
+        return String::from_utf8_without_validation(input.bytes());
+
+    StringBuilder builder(input.length());
+    for (u8 const byte : input)
+        TRY(builder.try_append_code_point(byte < 0x80 ? byte : m_translation_table[byte - 0x80]));
+    return builder.to_string_without_validation();
+}
+
 template<Integral ArrayType>
 ErrorOr<size_t> SingleByteDecoder<ArrayType>::length_in_utf16_code_units(StringView input)
 {
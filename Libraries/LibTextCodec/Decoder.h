@@ -74,6 +74,7 @@ public:
     }
 
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
+    virtual ErrorOr<String> to_utf8(StringView) override;
     virtual ErrorOr<size_t> length_in_utf16_code_units(StringView) override;
 
 private:
@@ -84,6 +85,7 @@ class TEXTCODEC_API Latin1Decoder final : public Decoder {
 public:
     virtual ErrorOr<void> process(StringView, Function<ErrorOr<void>(u32)> on_code_point) override;
     virtual bool validate(StringView) override { return true; }
+    virtual ErrorOr<String> to_utf8(StringView) override;
     virtual ErrorOr<size_t> length_in_utf16_code_units(StringView) override;
 };
 
@@ -147,8 +149,14 @@ public:
 // Preserves incomplete trailing decoder tokens when callers provide input in chunks.
 class TEXTCODEC_API StreamingDecoder final {
 public:
-    explicit StreamingDecoder(Decoder& decoder)
+    enum class InvalidInput {
+        Replace,
+        Fail,
+    };
+
+    explicit StreamingDecoder(Decoder& decoder, InvalidInput invalid_input = InvalidInput::Replace)
         : m_decoder(decoder)
+        , m_invalid_input(invalid_input)
     {
     }
 
@@ -156,7 +164,10 @@ public:
     ErrorOr<String> finish();
 
 private:
+    ErrorOr<String> decode(ReadonlyBytes);
+
     Decoder& m_decoder;
+    InvalidInput m_invalid_input { InvalidInput::Replace };
     ByteBuffer m_pending_input;
 };
 
@@ -33,22 +33,40 @@ ThreadPool::ThreadPool()
 intptr_t ThreadPool::worker_thread_func()
 {
     while (true) {
-        Function<void()> work;
+        Work work;
 
         {
             Sync::MutexLocker locker(m_mutex);
-            m_condition.wait_while([this] { return m_work_queue.is_empty(); });
-            work = m_work_queue.dequeue();
+            m_condition.wait_while([this] { return !has_work(); });
+            work = take_most_urgent_work();
         }
 
         work();
     }
 }
 
-void ThreadPool::submit(Function<void()> work)
+bool ThreadPool::has_work() const
+{
+    for (auto const& queue : m_work_queues) {
+        if (!queue.is_empty())
+            return true;
+    }
+    return false;
+}
+
+ThreadPool::Work ThreadPool::take_most_urgent_work()
+{
+    for (auto& queue : m_work_queues) {
+        if (!queue.is_empty())
+            return queue.dequeue();
+    }
+    VERIFY_NOT_REACHED();
+}
+
+void ThreadPool::submit(Work work, Priority priority)
 {
     Sync::MutexLocker locker(m_mutex);
-    m_work_queue.enqueue(move(work));
+    m_work_queues[to_underlying(priority)].enqueue(move(work));
     m_condition.signal();
 }
 
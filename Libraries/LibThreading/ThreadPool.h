@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Function.h>
 #include <AK/Queue.h>
 #include <AK/Vector.h>
@@ -17,18 +18,35 @@ namespace Threading {
 
 class ThreadPool {
 public:
+    // Idle workers always pick up the oldest work of the most urgent priority first.
+    enum class Priority : u8 {
+        // Something is waiting on this right now, like the main thread in the middle of a GC or a paint.
+        UserBlocking,
+        // Work whose result the user will see soon, like decoding images or compiling scripts for the page.
+        UserVisible,
+        // Work nothing is waiting on, like optimizing code that can already run.
+        Background,
+    };
+    static constexpr size_t priority_count = 3;
+
+    // OPTIMIZATION: Submitted lambdas tend to capture a connection, a job, an event loop and a few indices, which would
+    //               overflow Function's default inline storage and cost an allocation per submission.
+    using Work = Function<void(), 8 * sizeof(void*)>;
+
     static ThreadPool& the();
 
-    void submit(Function<void()>);
+    void submit(Work, Priority = Priority::UserVisible);
 
 private:
     ThreadPool();
 
     intptr_t worker_thread_func();
+    bool has_work() const;
+    Work take_most_urgent_work();
 
     Sync::Mutex m_mutex;
     Sync::ConditionVariable m_condition { m_mutex };
-    Queue<Function<void()>> m_work_queue;
+    Array<Queue<Work>, priority_count> m_work_queues;
     Vector<NonnullRefPtr<Thread>> m_threads;
 };
 
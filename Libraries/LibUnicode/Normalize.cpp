@@ -43,6 +43,10 @@ StringView normalization_form_to_string(NormalizationForm form)
 
 String normalize(StringView string, NormalizationForm form)
 {
+    // NB: ASCII text is unchanged by every normalization form.
+    if (string.is_ascii())
+        return String::from_utf8_without_validation(string.bytes());
+
     UErrorCode status = U_ZERO_ERROR;
     icu::Normalizer2 const* normalizer = nullptr;
 
@@ -66,6 +70,11 @@ String normalize(StringView string, NormalizationForm form)
 
     VERIFY(normalizer);
 
+    // OPTIMIZATION: Most text is already normalized, which ICU's quick check can tell us without building a copy.
+    if (normalizer->isNormalizedUTF8(icu_string_piece(string), status) && icu_success(status))
+        return MUST(String::from_utf8(string));
+    status = U_ZERO_ERROR;
+
     StringBuilder builder { string.length() };
     icu::StringByteSink sink { &builder };
 
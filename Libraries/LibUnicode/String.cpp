@@ -37,6 +37,11 @@ static ResolvedLocale resolve_locale(Optional<StringView> const& locale)
 
 ErrorOr<String> String::to_lowercase(Optional<StringView> const& locale) const
 {
+    // NB: Locales may tailor the mapping of ASCII letters (e.g. the dotless i in Turkish), so only the locale-independent
+    //     mapping may skip ICU.
+    if (!locale.has_value() && is_ascii())
+        return to_ascii_lowercase();
+
     UErrorCode status = U_ZERO_ERROR;
 
     StringBuilder builder { bytes_as_string_view().length() };
@@ -53,6 +58,9 @@ ErrorOr<String> String::to_lowercase(Optional<StringView> const& locale) const
 
 ErrorOr<String> String::to_uppercase(Optional<StringView> const& locale) const
 {
+    if (!locale.has_value() && is_ascii())
+        return to_ascii_uppercase();
+
     UErrorCode status = U_ZERO_ERROR;
 
     StringBuilder builder { bytes_as_string_view().length() };
@@ -104,6 +112,13 @@ ErrorOr<String> String::to_fullwidth() const
 
 static ErrorOr<void> build_casefold_string(StringView string, StringBuilder& builder)
 {
+    // NB: Case folding ASCII text is the same as lowercasing it.
+    if (string.is_ascii()) {
+        for (auto byte : string.bytes())
+            builder.append(AK::to_ascii_lowercase(byte));
+        return {};
+    }
+
     UErrorCode status = U_ZERO_ERROR;
 
     icu::StringByteSink sink { &builder };
@@ -117,6 +132,9 @@ static ErrorOr<void> build_casefold_string(StringView string, StringBuilder& bui
 
 ErrorOr<String> String::to_casefold() const
 {
+    if (is_ascii())
+        return to_ascii_lowercase();
+
     StringBuilder builder { bytes_as_string_view().length() };
     TRY(build_casefold_string(*this, builder));
 
@@ -125,6 +143,10 @@ ErrorOr<String> String::to_casefold() const
 
 bool String::equals_ignoring_case(String const& other) const
 {
+    // NB: Both sides have to be ASCII, as some non-ASCII code points (e.g. the Kelvin sign) fold to ASCII letters.
+    if (is_ascii() && other.is_ascii())
+        return equals_ignoring_ascii_case(other);
+
     StringBuilder lhs_builder { bytes_as_string_view().length() };
     if (build_casefold_string(*this, lhs_builder).is_error())
         return false;
@@ -65,6 +65,9 @@ Utf16String Utf16String::to_titlecase(Optional<StringView> const& locale, Traili
 
 Utf16String Utf16String::to_casefold() const
 {
+    if (has_ascii_storage())
+        return to_ascii_lowercase();
+
     auto icu_string = Unicode::icu_string(*this);
     icu_string.foldCase();
 
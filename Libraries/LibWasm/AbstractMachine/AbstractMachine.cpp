@@ -240,6 +240,14 @@ bool MemoryInstance::grow(size_t size_to_grow, GrowType grow_type, InhibitGrowCa
     return true;
 }
 
+bool ModuleInstance::has_guarded_default_memory(Store& store) const
+{
+    if (m_memories.is_empty())
+        return true;
+    auto const* memory = store.unsafe_get(m_memories.first());
+    return !memory || memory->is_guarded();
+}
+
 Vector<CompiledFunctionEntry> const& ModuleInstance::compiled_fn_table(Store& store) const
 {
     if (m_compiled_fn_table_built)
@@ -263,6 +271,8 @@ Vector<CompiledFunctionEntry> const& ModuleInstance::compiled_fn_table(Store& st
             continue;
         if (auto src = wasm_fn->module_ref(); src && !src->has_attempted_cranelift_compilation())
             all_ready = false;
+        if (!wasm_fn->module().has_guarded_default_memory(store))
+            continue;
         auto& ci = wasm_fn->code().func().body().compiled_instructions;
         auto native = cranelift_entry_acquire(ci);
         if (native == 0)
@@ -380,6 +380,9 @@ public:
 
     Vector<CompiledFunctionEntry> const& compiled_fn_table(Store&) const;
 
+    // Whether this module's compiled code may be entered: it accesses memory 0 directly, see MemoryInstance::is_guarded().
+    bool has_guarded_default_memory(Store&) const;
+
 private:
     Vector<TypeSection::Type> m_types;
     Vector<TagType> m_tag_types;
@@ -553,6 +556,10 @@ public:
     auto& data() { return m_data; }
     bool contains_virtual_address(void const* address) const { return m_data.contains_virtual_address(address); }
 
+    // Whether every 32-bit base plus offset lands inside the reservation, so an access past the end faults instead of
+    // touching unrelated memory. Only wasm32 memories whose address space reservation succeeded are guarded.
+    bool is_guarded() const { return m_data.is_virtual(); }
+
     enum class InhibitGrowCallback {
         No,
         Yes,
@@ -400,13 +400,22 @@ static constexpr u64 trace_missing = NumericLimits<u64>::max();
 
 #define LOAD_ADDRESSES() auto addresses = addresses_ptr[short_ip.current_ip_value]
 
+// Cranelift code accesses memory 0 without a bounds check, relying on its guard reservation to fault instead. Without one
+// (memory64, or the reservation failed) we have to stay in the interpreter.
+static bool can_run_compiled_code(Configuration& configuration)
+{
+    auto const* memory = configuration.default_memory();
+    return !memory || memory->is_guarded();
+}
+
 void BytecodeInterpreter::interpret(Configuration& configuration)
 {
     m_trap = Empty {};
     auto& expression = configuration.frame().expression();
-    auto const native_entry = cranelift_entry_acquire(expression.compiled_instructions);
+    bool const can_run_native = can_run_compiled_code(configuration);
+    auto const native_entry = can_run_native ? cranelift_entry_acquire(expression.compiled_instructions) : 0;
     // We may end up running native code either at entry (native_entry != 0) or mid-loop via a tier-up checkpoint, so install fault recovery in either case.
-    bool const may_run_native = native_entry != 0 || expression.compiled_instructions.has_tier_up_checkpoints;
+    bool const may_run_native = can_run_native && (native_entry != 0 || expression.compiled_instructions.has_tier_up_checkpoints);
     CompiledFaultRecoveryContext compiled_fault_recovery;
     bool did_install_compiled_fault_recovery = false;
     if (may_run_native && !s_compiled_fault_recovery) {
@@ -1991,7 +2000,7 @@ HANDLE_INSTRUCTION(synthetic_tier_up)
 {
     LOG_INSN;
     auto& ci = configuration.frame().expression().compiled_instructions;
-    auto const native_entry = cranelift_entry_acquire(ci);
+    auto const native_entry = can_run_compiled_code(configuration) ? cranelift_entry_acquire(ci) : 0;
     if (native_entry != 0) {
         // If we have native code for this block, jump into it.
         // The code is set up such that the target checkpoint is recovered from short_ip and nothing else needs to be passed as the stack is empty and all live state is in the shared locals.
@@ -51,6 +51,16 @@ DEFINE_BINARY_OPERATOR(BitXor, ^);
 
 #undef DEFINE_BINARY_OPERATOR
 
+// Operators that mean the same thing applied to a whole native vector as they do lane by lane, so the v128 ops below
+// can hand them the vectors directly and let the compiler pick the SIMD instruction. Comparisons on vector types yield
+// all-ones or all-zeros lanes, which is exactly Wasm's encoding of a lane-wise boolean.
+template<typename Op>
+constexpr bool is_lanewise_vector_operator = IsOneOf<Op, Equals, NotEquals, GreaterThan, LessThan, LessThanOrEquals, GreaterThanOrEquals, Add, Subtract, Multiply, BitAnd, BitOr, BitXor>;
+
+// Integer arithmetic whose result bits do not depend on signedness; done on unsigned lanes to keep overflow defined.
+template<typename Op>
+constexpr bool is_sign_agnostic_vector_operator = IsOneOf<Op, Add, Subtract, Multiply, BitAnd, BitOr, BitXor>;
+
 struct Identity {
     auto operator()(auto x) const { return x; }
 };
@@ -340,9 +350,13 @@ struct VectorCmpOp {
     auto operator()(u128 c1, u128 c2) const
     {
         using ElementType = NativeIntegralType<128 / VectorSize>;
+        Op op;
+        if constexpr (is_lanewise_vector_operator<Op>) {
+            using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
+            return bit_cast<u128>(op(bit_cast<VectorType>(c1), bit_cast<VectorType>(c2)));
+        }
         auto result = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c1);
         auto other = bit_cast<Native128ByteVectorOf<ElementType, SetSign>>(c2);
-        Op op;
         for (size_t i = 0; i < VectorSize; ++i) {
             SetSign<ElementType> lhs = result[i];
             SetSign<ElementType> rhs = other[i];
@@ -375,8 +389,10 @@ struct VectorFloatCmpOp {
         auto first = bit_cast<NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>>(c1);
         auto other = bit_cast<NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>>(c2);
         using ElementType = NativeIntegralType<128 / VectorSize>;
-        Native128ByteVectorOf<ElementType, MakeUnsigned> result;
         Op op;
+        if constexpr (is_lanewise_vector_operator<Op>)
+            return bit_cast<u128>(op(first, other));
+        Native128ByteVectorOf<ElementType, MakeUnsigned> result;
         for (size_t i = 0; i < VectorSize; ++i)
             result[i] = op(first[i], other[i]) ? static_cast<ElementType>(-1) : 0;
         return bit_cast<u128>(result);
@@ -693,13 +709,16 @@ template<size_t VectorSize, typename Op, template<typename> typename SetSign = M
 struct VectorIntegerBinaryOp {
     auto operator()(u128 lhs, u128 rhs) const
     {
+        Op op;
+        if constexpr (is_sign_agnostic_vector_operator<Op>) {
+            using UnsignedVectorType = NativeVectorType<128 / VectorSize, VectorSize, MakeUnsigned>;
+            return bit_cast<u128>(op(bit_cast<UnsignedVectorType>(lhs), bit_cast<UnsignedVectorType>(rhs)));
+        }
+
         using VectorType = NativeVectorType<128 / VectorSize, VectorSize, SetSign>;
         auto first = bit_cast<VectorType>(lhs);
         auto second = bit_cast<VectorType>(rhs);
         VectorType result;
-        Op op;
-
-        // FIXME: Find a way to not loop here
         for (size_t i = 0; i < VectorSize; ++i) {
             result[i] = op(first[i], second[i]);
         }
@@ -893,8 +912,10 @@ struct VectorFloatBinaryOp {
         using VectorType = NativeFloatingVectorType<128, VectorSize, NativeFloatingType<128 / VectorSize>>;
         auto first = bit_cast<VectorType>(lhs);
         auto second = bit_cast<VectorType>(rhs);
-        VectorType result;
         Op op;
+        if constexpr (is_lanewise_vector_operator<Op>)
+            return bit_cast<u128>(op(first, second));
+        VectorType result;
         for (size_t i = 0; i < VectorSize; ++i) {
             result[i] = op(first[i], second[i]);
         }
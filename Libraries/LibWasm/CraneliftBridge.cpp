@@ -9,6 +9,7 @@
 #include <AK/LexicalPath.h>
 #include <AK/NeverDestroyed.h>
 #include <AK/Platform.h>
+#include <AK/QuickSort.h>
 #include <AK/ScopeGuard.h>
 #include <CraneliftFFI.h>
 #include <LibCore/Process.h>
@@ -281,6 +282,7 @@ static ALWAYS_INLINE i32 wasm_cl_finish_call(BytecodeInterpreter& interpreter, C
 
     if (auto* wasm_function = instance->get_pointer<WasmFunction>(); wasm_function
         && !config.should_limit_instruction_count()
+        && wasm_function->module().has_guarded_default_memory(config.store())
         && cranelift_entry_acquire(wasm_function->code().func().body().compiled_instructions) != 0) {
 
         // Fast compiled-to-compiled call: stack-allocate locals + non-owning frame.
@@ -1133,7 +1135,7 @@ static StringView resolve_cranelift_compiler_path()
     return s_path->view();
 }
 
-static void try_cranelift_compile_batch(Vector<BatchInput>& batch)
+static void try_cranelift_compile_batch(Span<BatchInput> batch)
 {
     if (batch.is_empty())
         return;
@@ -1478,12 +1480,42 @@ bool try_cranelift_compile(CompiledInstructions& compiled, u32 result_arity)
 #endif
 }
 
+// Functions with Tier-Up checkpoints contain loops, and are where the interpreter will spend its time until compiled code
+// arrives; nothing has run yet when a module compiles, so that is the best hint of hotness there is. Those are queued
+// first and, when there are enough of them, compiled as a wave of their own so their entries are published without
+// waiting for the rest of the module.
+static constexpr size_t minimum_hot_wave_size = 8;
+
+static bool is_likely_hot(BatchInput const& input)
+{
+    return input.target->has_tier_up_checkpoints;
+}
+
 void flush_cranelift_batch()
 {
-    if (cranelift_cache_state().pending_batch.is_empty())
+    auto& batch = cranelift_cache_state().pending_batch;
+    if (batch.is_empty())
         return;
-    try_cranelift_compile_batch(cranelift_cache_state().pending_batch);
-    cranelift_cache_state().pending_batch.clear();
+
+    // Hot functions first, and larger ones ahead of smaller ones within each group, so the compiler's workers are not
+    // left waiting on one long function at the end of the queue.
+    quick_sort(batch, [](BatchInput const& a, BatchInput const& b) {
+        if (is_likely_hot(a) != is_likely_hot(b))
+            return is_likely_hot(a);
+        return a.insns.size() > b.insns.size();
+    });
+
+    size_t hot_count = 0;
+    while (hot_count < batch.size() && is_likely_hot(batch[hot_count]))
+        ++hot_count;
+
+    if (hot_count >= minimum_hot_wave_size && hot_count < batch.size()) {
+        try_cranelift_compile_batch(batch.span().slice(0, hot_count));
+        try_cranelift_compile_batch(batch.span().slice(hot_count));
+    } else {
+        try_cranelift_compile_batch(batch.span());
+    }
+    batch.clear();
 }
 
 void discard_cranelift_batch()
@@ -1460,6 +1460,57 @@ ParseResult<SectionId> SectionId::parse(Stream& stream)
     }
 }
 
+static ParseResult<void> parse_section_contents(Module& module, SectionId section_id, ConstrainedStream& section_stream)
+{
+    switch (section_id.kind()) {
+    case SectionId::SectionIdKind::Custom:
+        module.custom_sections().append(TRY(CustomSection::parse(section_stream)));
+        break;
+    case SectionId::SectionIdKind::Type:
+        module.type_section() = TRY(TypeSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Import:
+        module.import_section() = TRY(ImportSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Function:
+        module.function_section() = TRY(FunctionSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Table:
+        module.table_section() = TRY(TableSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Memory:
+        module.memory_section() = TRY(MemorySection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Global:
+        module.global_section() = TRY(GlobalSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Export:
+        module.export_section() = TRY(ExportSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Start:
+        module.start_section() = TRY(StartSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Element:
+        module.element_section() = TRY(ElementSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Code:
+        module.code_section() = TRY(CodeSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Data:
+        module.data_section() = TRY(DataSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::DataCount:
+        module.data_count_section() = TRY(DataCountSection::parse(section_stream));
+        break;
+    case SectionId::SectionIdKind::Tag:
+        module.tag_section() = TRY(TagSection::parse(section_stream));
+        break;
+    default:
+        return ParseError::InvalidIndex;
+    }
+    return {};
+}
+
 ParseResult<NonnullRefPtr<Module>> Module::parse(Stream& stream)
 {
     ScopeLogger<WASM_BINPARSER_DEBUG> logger("Module"sv);
@@ -1491,52 +1542,7 @@ ParseResult<NonnullRefPtr<Module>> Module::parse(Stream& stream)
             seen_section_kinds |= kind_bit;
         }
 
-        switch (section_id.kind()) {
-        case SectionId::SectionIdKind::Custom:
-            module.custom_sections().append(TRY(CustomSection::parse(section_stream)));
-            break;
-        case SectionId::SectionIdKind::Type:
-            module.type_section() = TRY(TypeSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Import:
-            module.import_section() = TRY(ImportSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Function:
-            module.function_section() = TRY(FunctionSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Table:
-            module.table_section() = TRY(TableSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Memory:
-            module.memory_section() = TRY(MemorySection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Global:
-            module.global_section() = TRY(GlobalSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Export:
-            module.export_section() = TRY(ExportSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Start:
-            module.start_section() = TRY(StartSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Element:
-            module.element_section() = TRY(ElementSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Code:
-            module.code_section() = TRY(CodeSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Data:
-            module.data_section() = TRY(DataSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::DataCount:
-            module.data_count_section() = TRY(DataCountSection::parse(section_stream));
-            break;
-        case SectionId::SectionIdKind::Tag:
-            module.tag_section() = TRY(TagSection::parse(section_stream));
-            break;
-        default:
-            return ParseError::InvalidIndex;
-        }
+        TRY(parse_section_contents(module, section_id, section_stream));
         if (!section_id.can_appear_after(last_section_id))
             return ParseError::SectionOutOfOrder;
         // Custom sections don't participate in ordering.
@@ -1555,6 +1561,190 @@ void Module::preprocess()
 {
 }
 
+// Reads the u32 LEB128 number at the start of the given bytes, or returns nothing if they don't hold all of it yet.
+static ParseResult<Optional<u32>> read_complete_u32(ReadonlyBytes bytes, size_t& size_in_bytes, ParseError error)
+{
+    static constexpr size_t max_size_in_bytes = 5;
+
+    size_t size = 0;
+    while (size < max_size_in_bytes) {
+        if (size == bytes.size())
+            return Optional<u32> {};
+        if ((bytes[size++] & 0x80) == 0)
+            break;
+    }
+
+    // NB: An overlong number is left for the LEB128 reader to reject.
+    FixedMemoryStream stream { bytes.trim(size) };
+    auto value = stream.read_value<LEB128<u32>>();
+    if (value.is_error())
+        return error;
+    size_in_bytes = size;
+    return Optional<u32> { value.release_value() };
+}
+
+StreamingModuleParser::StreamingModuleParser()
+    : m_module(make_ref_counted<Module>())
+{
+}
+
+ParseResult<void> StreamingModuleParser::append(ReadonlyBytes bytes)
+{
+    if (m_error.has_value())
+        return *m_error;
+
+    m_received_size += bytes.size();
+    if (m_buffer.try_append(bytes).is_error()) {
+        m_error = ParseError::OutOfMemory;
+        return *m_error;
+    }
+
+    if (auto result = parse_available_bytes(); result.is_error()) {
+        m_error = result.error();
+        return *m_error;
+    }
+
+    // Only keep the incomplete tail of the section or function body at hand around.
+    if (m_offset != 0) {
+        auto remaining = m_buffer.size() - m_offset;
+        __builtin_memmove(m_buffer.data(), m_buffer.data() + m_offset, remaining);
+        m_buffer.trim(remaining, false);
+        m_offset = 0;
+    }
+    return {};
+}
+
+ParseResult<NonnullRefPtr<Module>> StreamingModuleParser::finish()
+{
+    if (m_error.has_value())
+        return *m_error;
+    if (m_state != State::SectionHeader || !m_buffer.is_empty())
+        return ParseError::UnexpectedEof;
+
+    m_module->preprocess();
+    return m_module;
+}
+
+void StreamingModuleParser::consume(size_t size)
+{
+    m_offset += size;
+    if (m_state != State::Preamble && m_state != State::SectionHeader)
+        m_section_remaining -= size;
+}
+
+ParseResult<void> StreamingModuleParser::parse_available_bytes()
+{
+    ScopeLogger<WASM_BINPARSER_DEBUG> logger("StreamingModule"sv);
+
+    while (true) {
+        auto available = m_buffer.bytes().slice(m_offset);
+        auto section_bytes = available.trim(m_section_remaining);
+        auto has_whole_section = available.size() >= m_section_remaining;
+
+        switch (m_state) {
+        case State::Preamble:
+            if (available.size() < 8)
+                return {};
+            if (available.slice(0, 4) != Module::wasm_magic.span())
+                return ParseError::InvalidModuleMagic;
+            if (available.slice(4, 4) != Module::wasm_version.span())
+                return ParseError::InvalidModuleVersion;
+            consume(8);
+            m_state = State::SectionHeader;
+            break;
+
+        case State::SectionHeader: {
+            if (available.is_empty())
+                return {};
+
+            FixedMemoryStream id_stream { available.trim(1) };
+            auto section_id = TRY(SectionId::parse(id_stream));
+
+            size_t size_in_bytes = 0;
+            auto section_size = TRY(read_complete_u32(available.slice(1), size_in_bytes, ParseError::ExpectedSize));
+            if (!section_size.has_value())
+                return {};
+
+            if (section_id.kind() != SectionId::SectionIdKind::Custom) {
+                auto kind_bit = 1u << to_underlying(section_id.kind());
+                if (m_seen_section_kinds & kind_bit)
+                    return ParseError::DuplicateSection;
+                m_seen_section_kinds |= kind_bit;
+            }
+            if (!section_id.can_appear_after(m_last_section_kind))
+                return ParseError::SectionOutOfOrder;
+            // Custom sections don't participate in ordering.
+            if (section_id.kind() != SectionId::SectionIdKind::Custom)
+                m_last_section_kind = section_id.kind();
+
+            consume(1 + size_in_bytes);
+            m_section_id = section_id;
+            m_section_remaining = *section_size;
+            m_state = section_id.kind() == SectionId::SectionIdKind::Code ? State::CodeSectionCount : State::SectionContents;
+            break;
+        }
+
+        case State::SectionContents: {
+            if (!has_whole_section)
+                return {};
+
+            FixedMemoryStream stream { section_bytes };
+            auto section_stream = ConstrainedStream { MaybeOwned<Stream>(stream), section_bytes.size() };
+            TRY(parse_section_contents(*m_module, m_section_id, section_stream));
+            if (section_stream.remaining() != 0)
+                return ParseError::SectionSizeMismatch;
+
+            consume(section_bytes.size());
+            m_state = State::SectionHeader;
+            break;
+        }
+
+        case State::CodeSectionCount: {
+            size_t size_in_bytes = 0;
+            auto count = TRY(read_complete_u32(section_bytes, size_in_bytes, ParseError::ExpectedSize));
+            if (!count.has_value())
+                return has_whole_section ? ParseResult<void> { ParseError::UnexpectedEof } : ParseResult<void> {};
+
+            consume(size_in_bytes);
+            m_remaining_function_count = *count;
+            // NB: Every entry takes up at least one byte, so a count that doesn't fit in the section is bogus anyway.
+            m_functions.ensure_capacity(min<size_t>(*count, m_section_remaining));
+            m_state = State::CodeSectionEntry;
+            break;
+        }
+
+        case State::CodeSectionEntry: {
+            if (m_remaining_function_count == 0) {
+                if (m_section_remaining != 0)
+                    return ParseError::SectionSizeMismatch;
+                m_module->code_section() = CodeSection { move(m_functions) };
+                m_state = State::SectionHeader;
+                break;
+            }
+
+            size_t size_in_bytes = 0;
+            auto body_size = TRY(read_complete_u32(section_bytes, size_in_bytes, ParseError::InvalidSize));
+            if (!body_size.has_value())
+                return has_whole_section ? ParseResult<void> { ParseError::UnexpectedEof } : ParseResult<void> {};
+
+            auto entry_size = size_in_bytes + *body_size;
+            if (entry_size > m_section_remaining)
+                return ParseError::UnexpectedEof;
+            if (available.size() < entry_size)
+                return {};
+
+            FixedMemoryStream stream { available.trim(entry_size) };
+            auto entry_stream = ConstrainedStream { MaybeOwned<Stream>(stream), entry_size };
+            m_functions.append(TRY(CodeSection::Code::parse(entry_stream)));
+
+            consume(entry_size);
+            --m_remaining_function_count;
+            break;
+        }
+        }
+    }
+}
+
 ByteString parse_error_to_byte_string(ParseError error)
 {
     switch (error) {
@@ -15,6 +15,8 @@ use libwasm_cranelift::compile_to_bytes;
 use std::env;
 use std::mem::size_of;
 use std::mem::size_of_val;
+use std::sync::atomic::AtomicUsize;
+use std::sync::atomic::Ordering;
 
 #[cfg(all(unix, not(target_os = "macos")))]
 use std::fs::File;
@@ -258,24 +260,26 @@ fn main() -> Result<(), Box<dyn std::error::Error>> {
         .map(|n| n.get())
         .unwrap_or(1)
         .max(1);
-    let chunk_size = func_count.div_ceil(thread_count.max(1));
     let mapped_ref: &[u8] = mapped;
     let helpers_ref = &helpers;
     let outcome_return = header.outcome_return;
+    let entries_ref = &entries;
 
-    let compiled_chunks: Vec<Vec<(usize, CompiledFunction)>> = std::thread::scope(|scope| {
+    // Workers pull the next function off a shared cursor rather than owning a fixed slice, so one thread stuck on a
+    // huge function does not leave the others idle, and functions are started in the order the parent queued them.
+    let next_function = AtomicUsize::new(0);
+    let next_function_ref = &next_function;
+
+    let mut compiled_functions: Vec<(usize, CompiledFunction)> = std::thread::scope(|scope| {
         let mut handles = Vec::with_capacity(thread_count);
-        for chunk_idx in 0..thread_count {
-            let start = chunk_idx * chunk_size;
-            if start >= func_count {
-                break;
-            }
-            let end = (start + chunk_size).min(func_count);
-            let chunk_entries = &entries[start..end];
+        for _ in 0..thread_count.min(func_count) {
             handles.push(scope.spawn(move || {
-                let mut out: Vec<(usize, CompiledFunction)> = Vec::with_capacity(end - start);
-                for (offset_in_chunk, entry) in chunk_entries.iter().enumerate() {
-                    let i = start + offset_in_chunk;
+                let mut out: Vec<(usize, CompiledFunction)> = Vec::new();
+                loop {
+                    let i = next_function_ref.fetch_add(1, Ordering::Relaxed);
+                    let Some(entry) = entries_ref.get(i) else {
+                        break;
+                    };
                     if entry.insn_count == 0 {
                         continue;
                     }
@@ -301,58 +305,60 @@ fn main() -> Result<(), Box<dyn std::error::Error>> {
                 out
             }));
         }
-        handles.into_iter().map(|h| h.join().unwrap()).collect()
+        handles.into_iter().flat_map(|h| h.join().unwrap()).collect()
     });
 
+    // Lay the output out in queue order, so if the code region runs out it is the least important functions that
+    // are dropped.
+    compiled_functions.sort_unstable_by_key(|(i, _)| *i);
+
     let mut code_cursor = 0usize;
     let mut reloc_cursor = 0usize;
-    for chunk in compiled_chunks {
-        for (i, compiled) in chunk {
-            let code = compiled.code;
-            let relocs = compiled.relocs;
-            let traps = compiled.traps;
-            let aligned = (code.len() + 15) & !15;
-            let reloc_bytes_len = relocs.len() * size_of::<HelperReloc>();
-            let trap_bytes_len = traps.len() * size_of::<CraneliftTrap>();
-            if code_cursor + aligned > code_capacity {
-                continue;
-            }
-            if reloc_cursor + reloc_bytes_len + trap_bytes_len > reloc_capacity {
-                continue;
-            }
-            let code_offset = code_cursor;
-            let code_dst = code_base_offset + code_offset;
-            mapped[code_dst..code_dst + code.len()].copy_from_slice(&code);
-
-            let reloc_offset = reloc_cursor;
-            if !relocs.is_empty() {
-                let reloc_dst = reloc_region_start + reloc_offset;
-                mapped[reloc_dst..reloc_dst + reloc_bytes_len].copy_from_slice(as_bytes_slice(&relocs));
-            }
-
-            let trap_offset = reloc_cursor + reloc_bytes_len;
-            if !traps.is_empty() {
-                let trap_dst = reloc_region_start + trap_offset;
-                mapped[trap_dst..trap_dst + trap_bytes_len].copy_from_slice(as_bytes_slice(&traps));
-            }
-
-            let entry = OutputFunctionEntry {
-                code_offset: u64::try_from(code_offset).map_err(|_| "code offset overflow")?,
-                code_size: u32::try_from(code.len()).map_err(|_| "code size overflow")?,
-                compiled: 1,
-                reloc_offset: u64::try_from(reloc_offset).map_err(|_| "reloc offset overflow")?,
-                reloc_count: u32::try_from(relocs.len()).map_err(|_| "reloc count overflow")?,
-                trap_offset: u64::try_from(trap_offset).map_err(|_| "trap offset overflow")?,
-                trap_count: u32::try_from(traps.len()).map_err(|_| "trap count overflow")?,
-                _pad: 0,
-            };
-            let entry_dst = out_entries_offset + i * size_of::<OutputFunctionEntry>();
-            let entry_bytes = as_bytes_slice(std::slice::from_ref(&entry));
-            mapped[entry_dst..entry_dst + size_of::<OutputFunctionEntry>()].copy_from_slice(entry_bytes);
+    for (i, compiled) in compiled_functions {
+        let code = compiled.code;
+        let relocs = compiled.relocs;
+        let traps = compiled.traps;
+        let aligned = (code.len() + 15) & !15;
+        let reloc_bytes_len = relocs.len() * size_of::<HelperReloc>();
+        let trap_bytes_len = traps.len() * size_of::<CraneliftTrap>();
+        if code_cursor + aligned > code_capacity {
+            continue;
+        }
+        if reloc_cursor + reloc_bytes_len + trap_bytes_len > reloc_capacity {
+            continue;
+        }
+        let code_offset = code_cursor;
+        let code_dst = code_base_offset + code_offset;
+        mapped[code_dst..code_dst + code.len()].copy_from_slice(&code);
+
+        let reloc_offset = reloc_cursor;
+        if !relocs.is_empty() {
+            let reloc_dst = reloc_region_start + reloc_offset;
+            mapped[reloc_dst..reloc_dst + reloc_bytes_len].copy_from_slice(as_bytes_slice(&relocs));
+        }
 
-            code_cursor += aligned;
-            reloc_cursor += reloc_bytes_len + trap_bytes_len;
+        let trap_offset = reloc_cursor + reloc_bytes_len;
+        if !traps.is_empty() {
+            let trap_dst = reloc_region_start + trap_offset;
+            mapped[trap_dst..trap_dst + trap_bytes_len].copy_from_slice(as_bytes_slice(&traps));
         }
+
+        let entry = OutputFunctionEntry {
+            code_offset: u64::try_from(code_offset).map_err(|_| "code offset overflow")?,
+            code_size: u32::try_from(code.len()).map_err(|_| "code size overflow")?,
+            compiled: 1,
+            reloc_offset: u64::try_from(reloc_offset).map_err(|_| "reloc offset overflow")?,
+            reloc_count: u32::try_from(relocs.len()).map_err(|_| "reloc count overflow")?,
+            trap_offset: u64::try_from(trap_offset).map_err(|_| "trap offset overflow")?,
+            trap_count: u32::try_from(traps.len()).map_err(|_| "trap count overflow")?,
+            _pad: 0,
+        };
+        let entry_dst = out_entries_offset + i * size_of::<OutputFunctionEntry>();
+        let entry_bytes = as_bytes_slice(std::slice::from_ref(&entry));
+        mapped[entry_dst..entry_dst + size_of::<OutputFunctionEntry>()].copy_from_slice(entry_bytes);
+
+        code_cursor += aligned;
+        reloc_cursor += reloc_bytes_len + trap_bytes_len;
     }
 
     #[cfg(all(unix, not(target_os = "macos")))]
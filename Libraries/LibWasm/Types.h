@@ -1624,6 +1624,8 @@ public:
     void set_minimum_call_record_allocation_size(size_t size) { m_minimum_call_record_allocation_size = size; }
 
 private:
+    friend class StreamingModuleParser;
+
     void set_validation_status(ValidationStatus status) { m_validation_status = status; }
     void preprocess();
 
@@ -1653,6 +1655,48 @@ private:
     size_t m_minimum_call_record_allocation_size { 0 };
 };
 
+// Parses a module out of bytes that arrive piecemeal, e.g. from the network, so that parsing overlaps with the download.
+// Each section is parsed as soon as all of its bytes are in, and the code section is parsed one function body at a time.
+class WASM_API StreamingModuleParser {
+public:
+    StreamingModuleParser();
+
+    // Appends the next bytes of the module, parsing whatever they complete. Once this fails, the parser is done for.
+    ParseResult<void> append(ReadonlyBytes);
+
+    // Returns the module once all of its bytes have been appended.
+    ParseResult<NonnullRefPtr<Module>> finish();
+
+    size_t received_size() const { return m_received_size; }
+
+private:
+    enum class State : u8 {
+        Preamble,
+        SectionHeader,
+        SectionContents,
+        CodeSectionCount,
+        CodeSectionEntry,
+    };
+
+    ParseResult<void> parse_available_bytes();
+    void consume(size_t);
+
+    State m_state { State::Preamble };
+    ByteBuffer m_buffer;
+    size_t m_offset { 0 };
+    size_t m_received_size { 0 };
+    Optional<ParseError> m_error;
+
+    NonnullRefPtr<Module> m_module;
+    SectionId m_section_id { SectionId::SectionIdKind::Custom };
+    SectionId::SectionIdKind m_last_section_kind { SectionId::SectionIdKind::Custom };
+    u32 m_seen_section_kinds { 0 };
+    size_t m_section_remaining { 0 };
+
+    Vector<CodeSection::Code> m_functions;
+    size_t m_remaining_function_count { 0 };
+};
+
 CompiledInstructions try_compile_instructions(Expression const&, Span<FunctionType const> functions);
 ErrorOr<void, ValidationError> ensure_cranelift_compiled(Module&);
 WASM_API void start_cranelift_compilation(Module&);
@@ -18,6 +18,7 @@
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/HighResolutionTime/Performance.h>
+#include <LibWeb/Painting/ViewportPaintable.h>
 #include <LibWeb/WebIDL/ExceptionOr.h>
 #include <LibWeb/WebIDL/Promise.h>
 
@@ -1583,8 +1584,19 @@ void Animation::invalidate_effect()
     if (!m_effect)
         return;
 
-    if (auto* target = m_effect->target())
-        target->document().set_needs_animated_style_update();
+    auto* target = m_effect->target();
+    if (!target)
+        return;
+
+    auto& document = target->document();
+    document.set_needs_animated_style_update();
+
+    // NB: An animation running on the compositor doesn't necessarily change style when it is paused, seeked or
+    //     cancelled, so hand the compositor a fresh set of animations along with the next frame.
+    if (auto paintable = document.unsafe_paintable(); paintable && paintable->has_async_animations()) {
+        document.set_needs_accumulated_visual_contexts_update(true);
+        target->set_needs_repaint();
+    }
 }
 
 Animation::Animation(JS::Realm& realm)
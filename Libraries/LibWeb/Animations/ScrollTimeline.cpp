@@ -121,11 +121,7 @@ static ComputedScrollAxis computed_scroll_axis(Bindings::ScrollAxis axis, CSS::W
     VERIFY_NOT_REACHED();
 }
 
-struct ScrollOffsetData {
-    double scroll_offset;
-    double max_scroll_offset;
-};
-static Optional<ScrollOffsetData> compute_scroll_offset_data(Variant<GC::Ptr<DOM::Element const>, GC::Ptr<DOM::Document>> propagated_source, Bindings::ScrollAxis axis)
+static Optional<ScrollTimeline::ScrollContainer> compute_scroll_offset_data(Variant<GC::Ptr<DOM::Element const>, GC::Ptr<DOM::Document>> propagated_source, Bindings::ScrollAxis axis)
 {
     if (propagated_source.visit([](auto const& source) { return source == nullptr; }))
         return {};
@@ -148,7 +144,9 @@ static Optional<ScrollOffsetData> compute_scroll_offset_data(Variant<GC::Ptr<DOM
 
     // FIXME: Support the case where the computed scroll axis is reversed
 
-    return ScrollOffsetData {
+    return ScrollTimeline::ScrollContainer {
+        .paintable_box = paintable_box,
+        .is_vertical = computed_axis.is_vertical,
         .scroll_offset = computed_axis.is_vertical
             ? paintable_box->scroll_offset().y().to_double()
             : paintable_box->scroll_offset().x().to_double(),
@@ -158,6 +156,11 @@ static Optional<ScrollOffsetData> compute_scroll_offset_data(Variant<GC::Ptr<DOM
     };
 }
 
+Optional<ScrollTimeline::ScrollContainer> ScrollTimeline::scroll_container() const
+{
+    return compute_scroll_offset_data(get_propagated_source(), m_axis);
+}
+
 bool ScrollTimeline::is_stale() const
 {
     // FIXME: This should probably be a spec bug
@@ -37,6 +37,15 @@ public:
 
     Source source_internal() const { return m_source; }
 
+    // The scroll container whose scroll position drives this timeline, as of the last layout.
+    struct ScrollContainer {
+        RefPtr<Painting::PaintableBox const> paintable_box;
+        bool is_vertical { true };
+        double scroll_offset { 0 };
+        double max_scroll_offset { 0 };
+    };
+    Optional<ScrollContainer> scroll_container() const;
+
     bool is_stale() const;
     virtual void update_current_time(double timestamp) override;
 
@@ -65,6 +65,26 @@ NonnullRefPtr<ComputedProperties> ComputedProperties::create()
     return adopt_ref(*new ComputedProperties);
 }
 
+NonnullRefPtr<ComputedProperties> ComputedProperties::clone() const
+{
+    auto clone = create();
+    clone->m_property_values = m_property_values;
+    clone->m_property_important = m_property_important;
+    clone->m_property_inherited = m_property_inherited;
+    clone->m_animated_property_inherited = m_animated_property_inherited;
+    clone->m_animated_property_result_of_transition = m_animated_property_result_of_transition;
+    clone->m_animated_property_values = m_animated_property_values;
+    clone->m_display_before_box_type_transformation = m_display_before_box_type_transformation;
+    clone->m_depends_on_viewport_metrics = m_depends_on_viewport_metrics;
+    clone->m_font_metrics_depend_on_viewport_metrics = m_font_metrics_depend_on_viewport_metrics;
+    clone->m_cached_computed_font_list = m_cached_computed_font_list;
+    clone->m_cached_first_available_computed_font = m_cached_first_available_computed_font;
+    clone->m_line_height = m_line_height;
+    clone->m_inheritance_dependent_specified_values = m_inheritance_dependent_specified_values;
+    clone->m_raw_cascaded_font_size = m_raw_cascaded_font_size;
+    return clone;
+}
+
 bool ComputedProperties::is_property_important(PropertyID property_id) const
 {
     VERIFY(property_id >= first_longhand_property_id && property_id <= last_longhand_property_id);
@@ -1799,7 +1819,16 @@ GridTemplateAreas ComputedProperties::grid_template_areas() const
 {
     auto const& value = property(PropertyID::GridTemplateAreas);
     auto const& style_value = value.as_grid_template_area();
-    return { style_value.grid_areas(), style_value.row_count(), style_value.column_count() };
+
+    GridTemplateAreas grid_template_areas { style_value.grid_areas(), style_value.row_count(), style_value.column_count(), {} };
+    for (auto const& name : style_value.grid_areas().keys()) {
+        grid_template_areas.implicit_line_names.set(name,
+            {
+                .start = MUST(String::formatted("{}-start", name)),
+                .end = MUST(String::formatted("{}-end", name)),
+            });
+    }
+    return grid_template_areas;
 }
 
 ObjectFit ComputedProperties::object_fit() const
@@ -42,6 +42,7 @@ enum class AnimatedPropertyResultOfTransition : u8 {
 class WEB_API ComputedProperties final : public RefCounted<ComputedProperties> {
 public:
     static NonnullRefPtr<ComputedProperties> create();
+    [[nodiscard]] NonnullRefPtr<ComputedProperties> clone() const;
 
     static constexpr double normal_line_height_scale = 1.15;
 
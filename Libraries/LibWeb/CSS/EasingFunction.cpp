@@ -6,6 +6,8 @@
 
 #include "EasingFunction.h"
 #include <AK/Math.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
 #include <LibWeb/CSS/Enums.h>
 #include <LibWeb/CSS/StyleValues/CalculatedStyleValue.h>
 #include <LibWeb/CSS/StyleValues/EasingStyleValue.h>
@@ -373,3 +375,106 @@ String EasingFunction::to_string() const
 }
 
 }
+
+namespace IPC {
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Web::CSS::LinearEasingFunction::ControlPoint const& control_point)
+{
+    TRY(encoder.encode(control_point.input));
+    TRY(encoder.encode(control_point.output));
+    return {};
+}
+
+template<>
+ErrorOr<Web::CSS::LinearEasingFunction::ControlPoint> decode(Decoder& decoder)
+{
+    return Web::CSS::LinearEasingFunction::ControlPoint {
+        .input = TRY(decoder.decode<Optional<double>>()),
+        .output = TRY(decoder.decode<double>()),
+    };
+}
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Web::CSS::LinearEasingFunction const& function)
+{
+    TRY(encoder.encode(function.control_points));
+    TRY(encoder.encode(function.stringified));
+    return {};
+}
+
+template<>
+ErrorOr<Web::CSS::LinearEasingFunction> decode(Decoder& decoder)
+{
+    return Web::CSS::LinearEasingFunction {
+        .control_points = TRY(decoder.decode<Vector<Web::CSS::LinearEasingFunction::ControlPoint>>()),
+        .stringified = TRY(decoder.decode<String>()),
+    };
+}
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Web::CSS::CubicBezierEasingFunction const& function)
+{
+    TRY(encoder.encode(function.x1));
+    TRY(encoder.encode(function.y1));
+    TRY(encoder.encode(function.x2));
+    TRY(encoder.encode(function.y2));
+    TRY(encoder.encode(function.stringified));
+    return {};
+}
+
+template<>
+ErrorOr<Web::CSS::CubicBezierEasingFunction> decode(Decoder& decoder)
+{
+    return Web::CSS::CubicBezierEasingFunction {
+        .x1 = TRY(decoder.decode<double>()),
+        .y1 = TRY(decoder.decode<double>()),
+        .x2 = TRY(decoder.decode<double>()),
+        .y2 = TRY(decoder.decode<double>()),
+        .stringified = TRY(decoder.decode<String>()),
+    };
+}
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Web::CSS::StepsEasingFunction const& function)
+{
+    TRY(encoder.encode(function.interval_count));
+    TRY(encoder.encode(function.position));
+    TRY(encoder.encode(function.stringified));
+    return {};
+}
+
+template<>
+ErrorOr<Web::CSS::StepsEasingFunction> decode(Decoder& decoder)
+{
+    return Web::CSS::StepsEasingFunction {
+        .interval_count = TRY(decoder.decode<i32>()),
+        .position = TRY(decoder.decode<Web::CSS::StepPosition>()),
+        .stringified = TRY(decoder.decode<String>()),
+    };
+}
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Web::CSS::EasingFunction const& function)
+{
+    TRY(encoder.encode(function.index()));
+    return function.visit([&](auto const& value) {
+        return encoder.encode(value);
+    });
+}
+
+template<>
+ErrorOr<Web::CSS::EasingFunction> decode(Decoder& decoder)
+{
+    switch (TRY(decoder.decode<Web::CSS::EasingFunction::IndexType>())) {
+    case 0:
+        return Web::CSS::EasingFunction { TRY(decoder.decode<Web::CSS::LinearEasingFunction>()) };
+    case 1:
+        return Web::CSS::EasingFunction { TRY(decoder.decode<Web::CSS::CubicBezierEasingFunction>()) };
+    case 2:
+        return Web::CSS::EasingFunction { TRY(decoder.decode<Web::CSS::StepsEasingFunction>()) };
+    }
+    return Error::from_string_literal("IPC decode: Invalid easing function index");
+}
+
+}
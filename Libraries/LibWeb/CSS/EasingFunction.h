@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <LibIPC/Forward.h>
 #include <LibWeb/CSS/StyleValues/StyleValue.h>
+#include <LibWeb/Export.h>
 
 namespace Web::CSS {
 
@@ -56,3 +58,32 @@ struct EasingFunction : public Variant<LinearEasingFunction, CubicBezierEasingFu
 };
 
 }
+
+namespace IPC {
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::CSS::LinearEasingFunction::ControlPoint const&);
+template<>
+WEB_API ErrorOr<Web::CSS::LinearEasingFunction::ControlPoint> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::CSS::LinearEasingFunction const&);
+template<>
+WEB_API ErrorOr<Web::CSS::LinearEasingFunction> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::CSS::CubicBezierEasingFunction const&);
+template<>
+WEB_API ErrorOr<Web::CSS::CubicBezierEasingFunction> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::CSS::StepsEasingFunction const&);
+template<>
+WEB_API ErrorOr<Web::CSS::StepsEasingFunction> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::CSS::EasingFunction const&);
+template<>
+WEB_API ErrorOr<Web::CSS::EasingFunction> decode(Decoder&);
+
+}
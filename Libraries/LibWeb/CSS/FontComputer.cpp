@@ -17,6 +17,7 @@
 #include <LibWeb/CSS/CSSFontFeatureValuesRule.h>
 #include <LibWeb/CSS/CSSStyleSheet.h>
 #include <LibWeb/CSS/ComputedProperties.h>
+#include <LibWeb/CSS/Enums.h>
 #include <LibWeb/CSS/Fetch.h>
 #include <LibWeb/CSS/FontFace.h>
 #include <LibWeb/CSS/FontFaceSet.h>
@@ -76,12 +77,13 @@ struct Traits<Web::CSS::ComputedFontCacheKey> : public DefaultTraits<Web::CSS::C
 
 namespace Web::CSS {
 
-FontLoader::FontLoader(FontComputer& font_computer, RuleOrDeclaration rule_or_declaration, FlyString family_name, Vector<Gfx::UnicodeRange> unicode_ranges, Vector<URL> urls, GC::Ptr<GC::Function<void(RefPtr<Gfx::Typeface const>)>> on_load)
+FontLoader::FontLoader(FontComputer& font_computer, RuleOrDeclaration rule_or_declaration, FlyString family_name, Vector<Gfx::UnicodeRange> unicode_ranges, Vector<URL> urls, FontDisplay font_display, GC::Ptr<GC::Function<void(RefPtr<Gfx::Typeface const>)>> on_load)
     : m_font_computer(font_computer)
     , m_rule_or_declaration(rule_or_declaration)
     , m_family_name(move(family_name))
     , m_unicode_ranges(move(unicode_ranges))
     , m_urls(move(urls))
+    , m_font_display(font_display)
 {
     if (on_load)
         m_subscribers.append(*on_load);
@@ -115,8 +117,36 @@ bool FontLoader::is_loading() const
     return m_fetch_controller && !m_typeface;
 }
 
+// https://drafts.csswg.org/css-fonts-4/#font-display-desc
+// The time from the start of the font display timeline to the end of the swap period, or nothing if the swap period
+// is infinite.
+static Optional<AK::Duration> font_display_swap_period_end(FontDisplay font_display)
+{
+    // NB: The spec recommends 100ms for an "extremely small" block period and 3s for a "short" swap period.
+    static constexpr auto extremely_small_block_period = AK::Duration::from_milliseconds(100);
+    static constexpr auto short_swap_period = AK::Duration::from_seconds(3);
+
+    switch (font_display) {
+    case FontDisplay::Auto:
+    case FontDisplay::Block:
+    case FontDisplay::Swap:
+        return {};
+    case FontDisplay::Fallback:
+        return extremely_small_block_period + short_swap_period;
+    case FontDisplay::Optional:
+        return extremely_small_block_period;
+    }
+    VERIFY_NOT_REACHED();
+}
+
 RefPtr<Gfx::Font const> FontLoader::font_with_point_size(float point_size, Gfx::FontVariationSettings const& variations, Gfx::ShapeFeatures const& shape_features)
 {
+    // https://drafts.csswg.org/css-fonts-4/#font-display-timeline
+    // If the font face is not loaded by the end of its swap period, it's marked as a failing font face and the user
+    // agent keeps using the fallback font, so that a late font doesn't reflow text the user may already be reading.
+    if (m_missed_swap_period)
+        return nullptr;
+
     if (!m_typeface) {
         if (!m_fetch_controller)
             start_loading_next_url();
@@ -133,6 +163,12 @@ void FontLoader::start_loading_next_url()
     if (m_urls.is_empty())
         return;
 
+    // https://drafts.csswg.org/css-fonts-4/#font-display-timeline
+    // At the moment the user agent first attempts to use a given downloaded font face on a page, the font face's font
+    // display timeline is started.
+    if (!m_font_display_timeline_start.has_value())
+        m_font_display_timeline_start = MonotonicTime::now();
+
     // https://drafts.csswg.org/css-fonts-4/#fetch-a-font
     // To fetch a font given a selected <url> url for @font-face rule, fetch url, with ruleOrDeclaration being rule,
     // destination "font", CORS mode "cors", and processResponse being the following steps given response res and null,
@@ -207,7 +243,14 @@ void FontLoader::font_did_load_or_fail(RefPtr<Gfx::Typeface const> typeface)
 {
     if (typeface) {
         m_typeface = typeface.release_nonnull();
-        m_font_computer->clear_computed_font_cache(m_family_name);
+
+        // NB: The face still counts as loaded for the Font Loading API, it's only rendering that doesn't swap to it.
+        auto swap_period_end = font_display_swap_period_end(m_font_display);
+        if (swap_period_end.has_value() && m_font_display_timeline_start.has_value())
+            m_missed_swap_period = MonotonicTime::now() - *m_font_display_timeline_start > *swap_period_end;
+
+        if (!m_missed_swap_period)
+            m_font_computer->clear_computed_font_cache(m_family_name);
     }
     m_has_completed = true;
     for (auto& callback : m_subscribers)
@@ -841,7 +884,7 @@ GC::Ptr<FontLoader> FontComputer::load_font_face(ParsedFontFace const& font_face
         return it->value;
     }
 
-    auto loader = heap().allocate<FontLoader>(*this, rule_or_declaration, font_face.font_family(), font_face.unicode_ranges(), move(urls), move(on_load));
+    auto loader = heap().allocate<FontLoader>(*this, rule_or_declaration, font_face.font_family(), font_face.unicode_ranges(), move(urls), font_face.font_display(), move(on_load));
     m_loaders_by_url.set(move(key), loader);
     return loader;
 }
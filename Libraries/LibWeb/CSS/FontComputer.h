@@ -11,6 +11,7 @@
 #pragma once
 
 #include <AK/ByteString.h>
+#include <AK/Time.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGfx/FontCascadeList.h>
 #include <LibWeb/CSS/Fetch.h>
@@ -64,7 +65,7 @@ class FontLoader final : public GC::Cell {
     GC_DECLARE_ALLOCATOR(FontLoader);
 
 public:
-    FontLoader(FontComputer&, RuleOrDeclaration, FlyString family_name, Vector<Gfx::UnicodeRange> unicode_ranges, Vector<URL> urls, GC::Ptr<GC::Function<void(RefPtr<Gfx::Typeface const>)>> on_load = {});
+    FontLoader(FontComputer&, RuleOrDeclaration, FlyString family_name, Vector<Gfx::UnicodeRange> unicode_ranges, Vector<URL> urls, FontDisplay, GC::Ptr<GC::Function<void(RefPtr<Gfx::Typeface const>)>> on_load = {});
 
     virtual ~FontLoader();
 
@@ -95,6 +96,12 @@ private:
     GC::Ptr<Fetch::Infrastructure::FetchController> m_fetch_controller;
     Vector<GC::Ref<GC::Function<void(RefPtr<Gfx::Typeface const>)>>> m_subscribers;
     bool m_has_completed { false };
+
+    // https://drafts.csswg.org/css-fonts-4/#font-display-timeline
+    FontDisplay m_font_display;
+    Optional<MonotonicTime> m_font_display_timeline_start;
+    // Set if the font finished loading after its swap period, in which case text keeps using the fallback font.
+    bool m_missed_swap_period { false };
 };
 
 class WEB_API FontComputer final : public GC::Cell {
@@ -5,7 +5,9 @@
  */
 
 #include <AK/Endian.h>
+#include <AK/HashMap.h>
 #include <LibCore/EventLoop.h>
+#include <LibCrypto/Hash/SHA2.h>
 #include <LibGfx/Font/WOFF/Loader.h>
 #include <LibGfx/Font/WOFF2/Loader.h>
 #include <LibThreading/ThreadPool.h>
@@ -14,6 +16,65 @@
 namespace Web::CSS {
 
 static constexpr u32 woff2_signature = 0x774F4632;
+static constexpr size_t prepared_font_data_cache_max_bytes = 64 * MiB;
+
+using FontDataDigest = ::Crypto::Hash::Digest<::Crypto::Hash::SHA256::DigestSize * 8>;
+
+struct FontDataDigestTraits : public DefaultTraits<FontDataDigest> {
+    static unsigned hash(FontDataDigest const& digest)
+    {
+        // NB: A SHA-256 digest is already uniformly distributed, so any four of its bytes make a good hash.
+        unsigned hash;
+        __builtin_memcpy(&hash, digest.data, sizeof(hash));
+        return hash;
+    }
+};
+
+using PreparedFontDataCallback = Function<void(ErrorOr<Core::AnonymousBuffer>)>;
+
+// OPTIMIZATION: Pages of a site, and the frames within them, tend to use the very same web font files, usually from a
+//               font CDN. Decompressed font data is kept per process by the digest of the compressed file, so that
+//               each file is decompressed once and every typeface made from it maps the same anonymous buffer. A file
+//               that is already being decompressed gets its callback queued instead of a second decompression.
+// NB: This is only touched on the thread that loads fonts, the decompression itself happens on the thread pool.
+struct PreparedFontDataCache {
+    struct Entry {
+        Core::AnonymousBuffer data;
+        u64 last_used_sequence_number { 0 };
+    };
+
+    struct Waiter {
+        NonnullRefPtr<Core::WeakEventLoopReference> event_loop;
+        PreparedFontDataCallback* callback { nullptr };
+    };
+
+    void add(FontDataDigest const& digest, Core::AnonymousBuffer data)
+    {
+        byte_size += data.size();
+        entries.set(digest, { move(data), ++use_sequence_number });
+
+        while (byte_size > prepared_font_data_cache_max_bytes && entries.size() > 1) {
+            auto least_recently_used = entries.begin();
+            for (auto it = entries.begin(); it != entries.end(); ++it) {
+                if (it->value.last_used_sequence_number < least_recently_used->value.last_used_sequence_number)
+                    least_recently_used = it;
+            }
+            byte_size -= min(byte_size, least_recently_used->value.data.size());
+            entries.remove(least_recently_used);
+        }
+    }
+
+    HashMap<FontDataDigest, Entry, FontDataDigestTraits> entries;
+    HashMap<FontDataDigest, Vector<Waiter>, FontDataDigestTraits> in_flight;
+    size_t byte_size { 0 };
+    u64 use_sequence_number { 0 };
+};
+
+static PreparedFontDataCache& prepared_font_data_cache()
+{
+    static PreparedFontDataCache cache;
+    return cache;
+}
 
 bool requires_off_thread_vector_font_preparation(ByteBuffer const& data, Optional<ByteString> const& mime_type_essence)
 {
@@ -58,18 +119,50 @@ ErrorOr<NonnullRefPtr<Gfx::Typeface const>> try_load_vector_font(ByteBuffer cons
 
 void prepare_vector_font_data_off_thread(ByteBuffer data, Function<void(ErrorOr<Core::AnonymousBuffer>)>&& on_complete)
 {
+    auto& cache = prepared_font_data_cache();
+    auto digest = ::Crypto::Hash::SHA256::hash(data);
+
+    if (auto it = cache.entries.find(digest); it != cache.entries.end()) {
+        it->value.last_used_sequence_number = ++cache.use_sequence_number;
+        Core::deferred_invoke([on_complete = move(on_complete), prepared = it->value.data]() mutable {
+            on_complete(move(prepared));
+        });
+        return;
+    }
+
     // Keep the callback on the origin thread so any GC roots it captures are
     // also destroyed there.
-    auto* callback = new Function<void(ErrorOr<Core::AnonymousBuffer>)>(move(on_complete));
-    auto& origin_event_loop = Core::EventLoop::current();
+    auto* callback = new PreparedFontDataCallback(move(on_complete));
+    auto waiter = PreparedFontDataCache::Waiter { Core::EventLoop::current_weak(), callback };
+
+    if (auto it = cache.in_flight.find(digest); it != cache.in_flight.end()) {
+        it->value.append(move(waiter));
+        return;
+    }
+    cache.in_flight.set(digest, { move(waiter) });
 
+    auto& origin_event_loop = Core::EventLoop::current();
     Threading::ThreadPool::the().submit(
-        [data = move(data), callback, &origin_event_loop]() mutable {
+        [data = move(data), digest, &origin_event_loop]() mutable {
             auto result = WOFF2::convert_to_ttf(data);
 
-            origin_event_loop.deferred_invoke([callback, result = move(result)]() mutable {
-                (*callback)(move(result));
-                delete callback;
+            origin_event_loop.deferred_invoke([digest, result = move(result)]() mutable {
+                auto& cache = prepared_font_data_cache();
+                auto waiters = cache.in_flight.take(digest).release_value();
+                if (!result.is_error())
+                    cache.add(digest, result.value());
+
+                for (auto& waiter : waiters) {
+                    auto event_loop = waiter.event_loop->take();
+                    // NB: A waiter's event loop may be gone by now, and its callback can only be destroyed there.
+                    if (!event_loop)
+                        continue;
+                    auto waiter_result = result.is_error() ? ErrorOr<Core::AnonymousBuffer> { Error::copy(result.error()) } : ErrorOr<Core::AnonymousBuffer> { result.value() };
+                    event_loop->deferred_invoke([callback = waiter.callback, waiter_result = move(waiter_result)]() mutable {
+                        (*callback)(move(waiter_result));
+                        delete callback;
+                    });
+                }
             });
         });
 }
@@ -97,6 +97,16 @@ struct GridTemplateAreas {
     size_t row_count { 0 };
     size_t column_count { 0 };
 
+    // The implicitly-assigned "foo-start" and "foo-end" line names of each named area. These are built along with the
+    // computed value, so that laying out the grid again doesn't have to create them again.
+    struct ImplicitLineNames {
+        FlyString start;
+        FlyString end;
+
+        bool operator==(ImplicitLineNames const& other) const = default;
+    };
+    HashMap<String, ImplicitLineNames> implicit_line_names;
+
     bool is_empty() const { return row_count == 0; }
     bool operator==(GridTemplateAreas const& other) const = default;
 };
@@ -72,6 +72,30 @@ void invalidate_node_style(DOM::Node& node, DOM::StyleInvalidationReason reason)
     mark_ancestors_as_having_child_needing_style_update(node);
 }
 
+void invalidate_node_style_for_insertion_into_empty_parent(DOM::Node& node)
+{
+    schedule_has_invalidation_for_node(node, DOM::StyleInvalidationReason::NodeInsertBefore);
+
+    if (node.is_character_data() || node.document().needs_full_style_update())
+        return;
+
+    for (auto* ancestor = node.parent_or_shadow_host(); ancestor; ancestor = ancestor->parent_or_shadow_host()) {
+        if (ancestor->entire_subtree_needs_style_update())
+            return;
+    }
+
+    node.set_entire_subtree_needs_style_update(true);
+}
+
+void finish_style_invalidation_for_insertion_into_empty_parent(DOM::Node& parent)
+{
+    if (parent.document().needs_full_style_update())
+        return;
+
+    parent.set_child_needs_style_update(true);
+    mark_ancestors_as_having_child_needing_style_update(parent);
+}
+
 void invalidate_node_style_for_properties(DOM::Node& node, DOM::StyleInvalidationReason reason, Vector<CSS::InvalidationSet::Property> const& properties, DOM::StyleInvalidationOptions options)
 {
     if (node.is_character_data())
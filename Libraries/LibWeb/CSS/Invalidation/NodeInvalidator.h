@@ -19,6 +19,14 @@ class Node;
 namespace Web::CSS::Invalidation {
 
 void invalidate_node_style(DOM::Node&, DOM::StyleInvalidationReason);
+
+// For several nodes inserted one after another into a parent that had no children, as when innerHTML replaces an
+// element's children. No sibling outside the inserted nodes can change which structural selectors it matches, and the
+// inserted nodes have their entire subtrees invalidated anyway, so this skips the sibling walks invalidate_node_style()
+// does for each node. The ancestors are then marked once for the whole batch.
+void invalidate_node_style_for_insertion_into_empty_parent(DOM::Node&);
+void finish_style_invalidation_for_insertion_into_empty_parent(DOM::Node& parent);
+
 void invalidate_node_style_for_properties(
     DOM::Node&,
     DOM::StyleInvalidationReason,
@@ -6,6 +6,7 @@
  */
 
 #include <AK/Debug.h>
+#include <AK/MemMem.h>
 #include <AK/SourceLocation.h>
 #include <AK/StringConversions.h>
 #include <AK/Utf8View.h>
@@ -178,10 +179,16 @@ Vector<Token> Tokenizer::tokenize(StringView input, StringView encoding, Tokeniz
             return MUST(decoder->to_utf8(input));
         }();
 
-        // OPTIMIZATION: If the input doesn't contain any filterable characters, we can skip the filtering
+        // OPTIMIZATION: If the input doesn't contain any filterable characters, we can skip the filtering.
+        //               All of them can be spotted from the UTF-8 bytes without decoding: surrogates are the only
+        //               code points encoded with a 0xED lead byte followed by a byte of 0xA0 or above.
         bool const contains_filterable = [&] {
-            for (auto code_point : decoded_input.code_points()) {
-                if (code_point == '\r' || code_point == '\f' || code_point == 0x00 || is_unicode_surrogate(code_point))
+            auto bytes = decoded_input.bytes();
+            for (size_t i = 0; i < bytes.size(); ++i) {
+                auto byte = bytes[i];
+                if (byte == '\r' || byte == '\f' || byte == 0x00)
+                    return true;
+                if (byte == 0xED && i + 1 < bytes.size() && bytes[i + 1] >= 0xA0)
                     return true;
             }
             return false;
@@ -285,6 +292,38 @@ u32 Tokenizer::peek_code_point(size_t offset) const
     return *it;
 }
 
+ReadonlyBytes Tokenizer::remaining_input_bytes() const
+{
+    return { m_utf8_iterator.ptr(), m_utf8_view.byte_length() - current_byte_offset() };
+}
+
+// Consumes the next byte_count bytes of input as if by calling next_code_point() for each code point in them.
+// byte_count must end on a code point boundary.
+void Tokenizer::consume_bytes(size_t byte_count)
+{
+    auto bytes = remaining_input_bytes();
+    VERIFY(byte_count > 0 && byte_count <= bytes.size());
+    auto start_byte_offset = current_byte_offset();
+
+    size_t last_code_point_offset = 0;
+    for (size_t i = 0; i < byte_count; ++i) {
+        auto byte = bytes[i];
+        if ((byte & 0xC0) == 0x80)
+            continue;
+        last_code_point_offset = i;
+        m_prev_position = m_position;
+        if (byte == '\n') {
+            m_position.line++;
+            m_position.column = 0;
+        } else {
+            m_position.column++;
+        }
+    }
+
+    m_prev_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(start_byte_offset + last_code_point_offset);
+    m_utf8_iterator = m_utf8_view.iterator_at_byte_offset_without_validation(start_byte_offset + byte_count);
+}
+
 U32Twin Tokenizer::peek_twin() const
 {
     U32Twin values { TOKENIZER_EOF, TOKENIZER_EOF };
@@ -559,6 +598,16 @@ FlyString Tokenizer::consume_an_ident_sequence()
     // Let result initially be an empty string.
     StringBuilder result;
 
+    // OPTIMIZATION: Most ident sequences are plain ASCII, so take the leading run of ASCII name code points in one go.
+    auto bytes = remaining_input_bytes();
+    size_t ascii_name_length = 0;
+    while (ascii_name_length < bytes.size() && bytes[ascii_name_length] < 0x80 && is_ident_code_point(bytes[ascii_name_length]))
+        ++ascii_name_length;
+    if (ascii_name_length > 0) {
+        result.append(StringView { bytes.trim(ascii_name_length) });
+        consume_bytes(ascii_name_length);
+    }
+
     // Repeatedly consume the next input code point from the stream:
     for (;;) {
         auto input = next_code_point();
@@ -716,9 +765,13 @@ void Tokenizer::consume_the_remnants_of_a_bad_url()
 
 void Tokenizer::consume_as_much_whitespace_as_possible()
 {
-    while (is_whitespace(peek_code_point())) {
-        (void)next_code_point();
-    }
+    // OPTIMIZATION: Whitespace is always ASCII, so scan the bytes directly.
+    auto bytes = remaining_input_bytes();
+    size_t whitespace_length = 0;
+    while (whitespace_length < bytes.size() && is_whitespace(bytes[whitespace_length]))
+        ++whitespace_length;
+    if (whitespace_length > 0)
+        consume_bytes(whitespace_length);
 }
 
 void Tokenizer::reconsume_current_input_code_point()
@@ -960,21 +1013,22 @@ start:
     (void)next_code_point();
     (void)next_code_point();
 
-    for (;;) {
-        auto twin_inner = peek_twin();
-        if (is_eof(twin_inner.first) || is_eof(twin_inner.second)) {
-            log_parse_error();
-            return;
-        }
-
-        if (is_asterisk(twin_inner.first) && is_solidus(twin_inner.second)) {
-            (void)next_code_point();
-            (void)next_code_point();
-            goto start;
-        }
-
-        (void)next_code_point();
+    // OPTIMIZATION: Search the bytes for the end of the comment instead of walking it code point by code point.
+    auto bytes = remaining_input_bytes();
+    if (auto end = AK::memmem_optional(bytes.data(), bytes.size(), "*/", 2); end.has_value()) {
+        consume_bytes(*end + 2);
+        goto start;
     }
+
+    // An unterminated comment runs up to, but not including, the last code point of the input.
+    log_parse_error();
+    if (bytes.is_empty())
+        return;
+    auto last_code_point_offset = bytes.size() - 1;
+    while (last_code_point_offset > 0 && (bytes[last_code_point_offset] & 0xC0) == 0x80)
+        --last_code_point_offset;
+    if (last_code_point_offset > 0)
+        consume_bytes(last_code_point_offset);
 }
 
 // https://www.w3.org/TR/css-syntax-3/#consume-token
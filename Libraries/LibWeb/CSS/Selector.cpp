@@ -7,7 +7,9 @@
 
 #include "Selector.h"
 #include <AK/GenericShorthands.h>
+#include <AK/InsertionSort.h>
 #include <AK/NeverDestroyed.h>
+#include <AK/NumericLimits.h>
 #include <LibWeb/CSS/CSSStyleRule.h>
 #include <LibWeb/CSS/Parser/ErrorReporter.h>
 #include <LibWeb/CSS/Serialize.h>
@@ -142,6 +144,50 @@ Selector::Selector(Vector<CompoundSelector>&& compound_selectors)
     collect_ancestor_hashes();
 
     m_can_use_fast_matches = can_selector_use_fast_matches(*this);
+    if (m_can_use_fast_matches)
+        m_can_use_fast_matches = compute_fast_matching_orders();
+}
+
+// Lower ranks are tested first. IDs and classes are pointer comparisons that reject most elements, while
+// pseudo-classes may have to look at element state or at other elements.
+static u8 fast_matching_rank(Selector::SimpleSelector const& simple_selector)
+{
+    switch (simple_selector.type) {
+    case Selector::SimpleSelector::Type::Id:
+        return 0;
+    case Selector::SimpleSelector::Type::Class:
+        return 1;
+    case Selector::SimpleSelector::Type::TagName:
+        return 2;
+    case Selector::SimpleSelector::Type::Attribute:
+        return 3;
+    case Selector::SimpleSelector::Type::Universal:
+        return 4;
+    default:
+        return 5;
+    }
+}
+
+bool Selector::compute_fast_matching_orders()
+{
+    m_fast_matching_orders.ensure_capacity(m_compound_selectors.size());
+    for (auto const& compound_selector : m_compound_selectors) {
+        auto const& simple_selectors = compound_selector.simple_selectors;
+        if (simple_selectors.size() > NumericLimits<u8>::max()) {
+            m_fast_matching_orders.clear();
+            return false;
+        }
+
+        Vector<u8, 4> order;
+        order.ensure_capacity(simple_selectors.size());
+        for (size_t i = 0; i < simple_selectors.size(); ++i)
+            order.unchecked_append(i);
+        insertion_sort(order, [&](u8 a, u8 b) {
+            return fast_matching_rank(simple_selectors[a]) < fast_matching_rank(simple_selectors[b]);
+        });
+        m_fast_matching_orders.unchecked_append(move(order));
+    }
+    return true;
 }
 
 void Selector::collect_ancestor_hashes()
@@ -231,6 +231,9 @@ public:
     auto const& ancestor_hashes() const { return m_ancestor_hashes; }
 
     bool can_use_fast_matches() const { return m_can_use_fast_matches; }
+    // For selectors that can use fast matching, the order in which to test each compound selector's simple selectors
+    // so that the ones most likely to reject an element and cheapest to check come first.
+    ReadonlySpan<u8> fast_matching_order(size_t compound_selector_index) const { return m_fast_matching_orders[compound_selector_index]; }
     bool can_use_ancestor_filter() const { return m_can_use_ancestor_filter; }
 
     size_t sibling_invalidation_distance() const;
@@ -255,8 +258,10 @@ private:
     PseudoClassBitmap m_contained_pseudo_classes;
 
     void collect_ancestor_hashes();
+    bool compute_fast_matching_orders();
 
     Array<u32, 8> m_ancestor_hashes;
+    Vector<Vector<u8, 4>> m_fast_matching_orders;
 };
 
 bool is_legacy_single_colon_pseudo_element(PseudoElement);
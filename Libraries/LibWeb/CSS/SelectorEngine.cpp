@@ -402,6 +402,10 @@ static inline bool matches_indeterminate_pseudo_class(DOM::Element const& elemen
 template<typename Callback>
 static inline void for_each_matching_attribute(CSS::Selector::SimpleSelector::Attribute const& attribute_selector, GC::Ptr<CSS::CSSStyleSheet const> style_sheet_for_rule, DOM::Element const& element, Callback&& process_attribute)
 {
+    auto attributes = element.existing_attributes();
+    if (!attributes)
+        return;
+
     auto const& qualified_name = attribute_selector.qualified_name;
     auto const& attribute_name = qualified_name.name.name;
 
@@ -410,7 +414,7 @@ static inline void for_each_matching_attribute(CSS::Selector::SimpleSelector::At
     //  therefore attribute selectors without a namespace component apply only to attributes that have no namespace (equivalent to "|attr")"
     case CSS::Selector::SimpleSelector::QualifiedName::NamespaceType::Default:
     case CSS::Selector::SimpleSelector::QualifiedName::NamespaceType::None:
-        if (auto const* attribute = element.attributes()->get_attribute(attribute_name))
+        if (auto const* attribute = attributes->get_attribute(attribute_name))
             (void)process_attribute(*attribute);
         return;
     case CSS::Selector::SimpleSelector::QualifiedName::NamespaceType::Any: {
@@ -421,8 +425,8 @@ static inline void for_each_matching_attribute(CSS::Selector::SimpleSelector::At
         // https://html.spec.whatwg.org/multipage/semantics-other.html#case-sensitivity-of-selectors
         bool const case_insensitive = element.document().is_html_document() && element.namespace_uri() == Namespace::HTML;
 
-        for (auto i = 0u; i < element.attributes()->length(); ++i) {
-            auto const* attr = element.attributes()->item(i);
+        for (auto i = 0u; i < attributes->length(); ++i) {
+            auto const* attr = attributes->item(i);
             bool matches = case_insensitive
                 ? attr->local_name().equals_ignoring_ascii_case(attribute_name)
                 : attr->local_name() == attribute_name;
@@ -440,7 +444,7 @@ static inline void for_each_matching_attribute(CSS::Selector::SimpleSelector::At
         if (!selector_namespace.has_value())
             return;
 
-        if (auto const* attribute = element.attributes()->get_attribute_ns(selector_namespace, attribute_name))
+        if (auto const* attribute = attributes->get_attribute_ns(selector_namespace, attribute_name))
             (void)process_attribute(*attribute);
         return;
     }
@@ -1750,7 +1754,16 @@ bool fast_matches(CSS::Selector const& selector, DOM::Element const& element_to_
 
     ssize_t compound_selector_index = selector.compound_selectors().size() - 1;
 
-    if (!fast_matches_compound_selector(selector.compound_selectors().last(), *current, shadow_host, context))
+    auto matches_compound_selector_at = [&](ssize_t index, DOM::Element const& element) {
+        auto const& simple_selectors = selector.compound_selectors()[index].simple_selectors;
+        for (auto simple_selector_index : selector.fast_matching_order(index)) {
+            if (!fast_matches_simple_selector(simple_selectors[simple_selector_index], element, shadow_host, context))
+                return false;
+        }
+        return true;
+    };
+
+    if (!matches_compound_selector_at(compound_selector_index, *current))
         return false;
 
     // NOTE: If we fail after following a child combinator, we may need to backtrack
@@ -1771,20 +1784,20 @@ bool fast_matches(CSS::Selector const& selector, DOM::Element const& element_to_
             return true;
         case CSS::Selector::Combinator::Descendant:
             backtrack_state = { current->parent_element(), compound_selector_index };
-            compound_selector = &selector.compound_selectors()[--compound_selector_index];
+            --compound_selector_index;
             for (current = current->parent_element(); current; current = current->parent_element()) {
-                if (fast_matches_compound_selector(*compound_selector, *current, shadow_host, context))
+                if (matches_compound_selector_at(compound_selector_index, *current))
                     break;
             }
             if (!current)
                 return false;
             break;
         case CSS::Selector::Combinator::ImmediateChild:
-            compound_selector = &selector.compound_selectors()[--compound_selector_index];
+            --compound_selector_index;
             current = current->parent_element();
             if (!current)
                 return false;
-            if (!fast_matches_compound_selector(*compound_selector, *current, shadow_host, context)) {
+            if (!matches_compound_selector_at(compound_selector_index, *current)) {
                 if (backtrack_state.element) {
                     current = backtrack_state.element;
                     compound_selector_index = backtrack_state.compound_selector_index;
@@ -20,6 +20,8 @@
 #include <AK/NeverDestroyed.h>
 #include <AK/NonnullRawPtr.h>
 #include <AK/QuickSort.h>
+#include <AK/ScopeGuard.h>
+#include <AK/TemporaryChange.h>
 #include <AK/Utf8View.h>
 #include <LibGfx/Font/FontDatabase.h>
 #include <LibWeb/Animations/AnimationEffect.h>
@@ -161,6 +163,12 @@ void StyleComputer::visit_edges(Visitor& visitor)
 
     for (auto& rule : m_rules_to_run_scratch)
         rule.visit_edges(visitor);
+
+    for (auto& candidate : m_style_sharing_candidates) {
+        visitor.visit(candidate.element);
+        visitor.visit(candidate.inheritance_parent);
+        candidate.matching_rule_set.visit_edges(visitor);
+    }
 }
 
 Optional<String> StyleComputer::user_agent_style_sheet_source(StringView name)
@@ -774,6 +782,182 @@ static Optional<CSS::EasingFunction> resolve_keyframe_easing(CSS::StyleValue con
     return {};
 }
 
+// https://drafts.csswg.org/css-animations-1/#animation-timing-function
+// The easing on a keyframe applies to the interval from that keyframe to the next. If the keyframe doesn't specify an
+// easing, use the animation's default easing (from the animation-timing-function property).
+static Optional<CSS::EasingFunction> keyframe_easing(Animations::KeyframeEffect::KeyFrameSet::ResolvedKeyFrame const& keyframe, Animations::Animation const& animation, DOM::AbstractElement abstract_element)
+{
+    auto resolved_easing = keyframe.easing.visit(
+        [](Empty) -> Optional<CSS::EasingFunction> { return {}; },
+        [](CSS::EasingFunction const& easing) -> Optional<CSS::EasingFunction> { return easing; },
+        [&](NonnullRefPtr<CSS::StyleValue const> const& value) -> Optional<CSS::EasingFunction> {
+            return resolve_keyframe_easing(*value, abstract_element);
+        });
+    if (resolved_easing.has_value())
+        return resolved_easing;
+    if (animation.is_css_animation())
+        return static_cast<CSSAnimation const&>(animation).default_easing();
+    return {};
+}
+
+static Bindings::CompositeOperation keyframe_composite_operation(Bindings::CompositeOperationOrAuto composite_operation_or_auto, Bindings::CompositeOperation effect_composite_operation)
+{
+    switch (composite_operation_or_auto) {
+    case Bindings::CompositeOperationOrAuto::Accumulate:
+        return Bindings::CompositeOperation::Accumulate;
+    case Bindings::CompositeOperationOrAuto::Add:
+        return Bindings::CompositeOperation::Add;
+    case Bindings::CompositeOperationOrAuto::Replace:
+        return Bindings::CompositeOperation::Replace;
+    case Bindings::CompositeOperationOrAuto::Auto:
+        return effect_composite_operation;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+// FIXME: Follow https://drafts.csswg.org/web-animations-1/#ref-for-computed-keyframes in whatever the right place is.
+HashMap<PropertyID, RefPtr<StyleValue const>> StyleComputer::compute_keyframe_values(DOM::AbstractElement abstract_element, Animations::KeyframeEffect::KeyFrameSet::ResolvedKeyFrame const& keyframe_values, ComputedProperties& computed_properties) const
+{
+    HashMap<PropertyID, RefPtr<StyleValue const>> result;
+    HashMap<PropertyID, PropertyID> longhands_set_by_property_id;
+    AK::FixedBitmap<number_of_longhand_properties> property_is_set_by_use_initial(false);
+
+    auto property_is_logical_alias_including_shorthands = [&](PropertyID property_id) {
+        if (property_is_shorthand(property_id))
+            // NOTE: All expanded longhands for a logical alias shorthand are logical aliases so we only need to check the first one.
+            return property_is_logical_alias(expanded_longhands_for_shorthand(property_id)[0]);
+
+        return property_is_logical_alias(property_id);
+    };
+
+    // https://drafts.csswg.org/web-animations-1/#ref-for-computed-keyframes
+    auto is_property_preferred = [&](PropertyID a, PropertyID b) {
+        // If conflicts arise when expanding shorthand properties or replacing logical properties with physical properties, apply the following rules in order until the conflict is resolved:
+        // 1. Longhand properties override shorthand properties (e.g. border-top-color overrides border-top).
+        if (property_is_shorthand(a) != property_is_shorthand(b))
+            return !property_is_shorthand(a);
+
+        // 2. Shorthand properties with fewer longhand components override those with more longhand components (e.g. border-top overrides border-color).
+        if (property_is_shorthand(a)) {
+            auto number_of_expanded_shorthands_a = expanded_longhands_for_shorthand(a).size();
+            auto number_of_expanded_shorthands_b = expanded_longhands_for_shorthand(b).size();
+
+            if (number_of_expanded_shorthands_a != number_of_expanded_shorthands_b)
+                return number_of_expanded_shorthands_a < number_of_expanded_shorthands_b;
+        }
+
+        auto property_a_is_logical_alias = property_is_logical_alias_including_shorthands(a);
+        auto property_b_is_logical_alias = property_is_logical_alias_including_shorthands(b);
+
+        // 3. Physical properties override logical properties.
+        if (property_a_is_logical_alias != property_b_is_logical_alias)
+            return !property_a_is_logical_alias;
+
+        // 4. For shorthand properties with an equal number of longhand components, properties whose IDL name (see
+        //    the CSS property to IDL attribute algorithm [CSSOM]) appears earlier when sorted in ascending order
+        //    by the Unicode codepoints that make up each IDL name, override those who appear later.
+        return camel_case_string_from_property_id(a) < camel_case_string_from_property_id(b);
+    };
+
+    HashMap<PropertyID, RefPtr<StyleValue const>> specified_values;
+
+    for (auto const& [property_id, value] : keyframe_values.properties) {
+        bool is_use_initial = false;
+
+        auto style_value = value.visit(
+            [&](Animations::KeyframeEffect::KeyFrameSet::UseInitial) -> RefPtr<StyleValue const> {
+                if (property_is_shorthand(property_id))
+                    return {};
+                is_use_initial = true;
+                return computed_properties.property(property_id, ComputedProperties::WithAnimationsApplied::No);
+            },
+            [&](RefPtr<StyleValue const> value) -> RefPtr<StyleValue const> {
+                return value;
+            });
+
+        if (!style_value) {
+            specified_values.set(property_id, nullptr);
+            continue;
+        }
+
+        // If the style value is a PendingSubstitutionStyleValue we should skip it to avoid overwriting any value
+        // already set by resolving the relevant shorthand's value.
+        if (style_value->is_pending_substitution())
+            continue;
+
+        if (style_value->is_unresolved())
+            style_value = Parser::Parser::resolve_unresolved_style_value(Parser::ParsingParams { abstract_element.document() }, abstract_element, PropertyNameAndID::from_id(property_id), style_value->as_unresolved());
+
+        // https://drafts.csswg.org/css-values-5/#invalid-at-computed-value-time
+        // When substitution results in a guaranteed-invalid value, treat it as unset
+        // (i.e. inherit for inherited properties, initial for non-inherited properties).
+        if (style_value->is_guaranteed_invalid()) {
+            specified_values.set(property_id, nullptr);
+            continue;
+        }
+
+        for_each_property_expanding_shorthands(property_id, *style_value, [&](PropertyID longhand_id, StyleValue const& longhand_value) {
+            auto physical_longhand_id = map_logical_alias_to_physical_property(longhand_id, LogicalAliasMappingContext { computed_properties.writing_mode(), computed_properties.direction() });
+            auto physical_longhand_id_bitmap_index = to_underlying(physical_longhand_id) - to_underlying(first_longhand_property_id);
+
+            // Don't overwrite values if this is the result of a UseInitial
+            if (specified_values.contains(physical_longhand_id) && specified_values.get(physical_longhand_id) != nullptr && is_use_initial)
+                return;
+
+            // Don't overwrite unless the value was originally set by a UseInitial or this property is preferred over the one that set it originally
+            if (specified_values.contains(physical_longhand_id) && specified_values.get(physical_longhand_id) != nullptr && !property_is_set_by_use_initial.get(physical_longhand_id_bitmap_index) && !is_property_preferred(property_id, longhands_set_by_property_id.get(physical_longhand_id).value()))
+                return;
+
+            auto const& specified_value_with_css_wide_keywords_applied = [&]() -> StyleValue const& {
+                if (longhand_value.is_inherit() || (longhand_value.is_unset() && is_inherited_property(longhand_id))) {
+                    if (auto inherited_animated_value = get_animated_inherit_value(longhand_id, abstract_element); inherited_animated_value.has_value())
+                        return inherited_animated_value->value;
+
+                    return get_non_animated_inherit_value(longhand_id, abstract_element);
+                }
+
+                if (longhand_value.is_initial() || longhand_value.is_unset())
+                    return property_initial_value(longhand_id);
+
+                if (longhand_value.is_revert() || longhand_value.is_revert_layer())
+                    return computed_properties.property(longhand_id);
+
+                return longhand_value;
+            }();
+
+            longhands_set_by_property_id.set(physical_longhand_id, property_id);
+            property_is_set_by_use_initial.set(physical_longhand_id_bitmap_index, is_use_initial);
+            specified_values.set(physical_longhand_id, specified_value_with_css_wide_keywords_applied);
+        });
+    }
+
+    // NOTE: This doesn't necessarily return the specified value if we reach into computed_properties but that
+    //       doesn't matter as a computed value is always valid as a specified value.
+    Function<NonnullRefPtr<StyleValue const>(PropertyID)> get_property_specified_value = [&](PropertyID property_id) -> NonnullRefPtr<StyleValue const> {
+        if (auto keyframe_value = specified_values.get(property_id); keyframe_value.has_value() && keyframe_value.value())
+            return *keyframe_value.value();
+
+        return computed_properties.property(property_id);
+    };
+
+    for (auto const& [property_id, style_value] : specified_values) {
+        if (!style_value)
+            continue;
+
+        auto const& computation_context = get_computation_context_for_property(property_id, computed_properties, abstract_element);
+
+        computation_context.reset_viewport_metric_dependency_tracking();
+        result.set(property_id, compute_value_of_property(property_id, *style_value, get_property_specified_value, computation_context, m_document->page().client().device_pixels_per_css_pixel()));
+        if (computation_context.depends_on_viewport_metrics()) {
+            computed_properties.set_depends_on_viewport_metrics();
+            if (property_affects_font_metrics(property_id))
+                computed_properties.set_font_metrics_depend_on_viewport_metrics();
+        }
+    }
+
+    return result;
+}
+
 void StyleComputer::collect_animation_into(DOM::AbstractElement abstract_element, GC::Ref<Animations::KeyframeEffect> effect, ComputedProperties& computed_properties) const
 {
     auto animation = effect->associated_animation();
@@ -829,191 +1013,24 @@ void StyleComputer::collect_animation_into(DOM::AbstractElement abstract_element
 
     auto progress_in_keyframe = (progress - keyframe_start) / static_cast<double>(keyframe_end - keyframe_start);
 
-    // https://drafts.csswg.org/css-animations-1/#animation-timing-function
-    // Apply the per-keyframe easing to the interval progress. The easing on a keyframe applies to the
-    // interval from that keyframe to the next. If the keyframe doesn't specify an easing, use the
-    // animation's default easing (from the animation-timing-function property).
-    auto resolved_easing = keyframe_values.easing.visit(
-        [](Empty) -> Optional<CSS::EasingFunction> { return {}; },
-        [](CSS::EasingFunction const& easing) -> Optional<CSS::EasingFunction> { return easing; },
-        [&](NonnullRefPtr<CSS::StyleValue const> const& value) -> Optional<CSS::EasingFunction> {
-            return resolve_keyframe_easing(*value, abstract_element);
-        });
-    if (resolved_easing.has_value()) {
-        progress_in_keyframe = resolved_easing->evaluate_at(progress_in_keyframe, false);
-    } else if (animation->is_css_animation()) {
-        progress_in_keyframe = static_cast<CSSAnimation const&>(*animation).default_easing().evaluate_at(progress_in_keyframe, false);
-    }
+    // Apply the per-keyframe easing to the interval progress.
+    if (auto easing = keyframe_easing(keyframe_values, *animation, abstract_element); easing.has_value())
+        progress_in_keyframe = easing->evaluate_at(progress_in_keyframe, false);
 
     if constexpr (LIBWEB_CSS_ANIMATION_DEBUG) {
         auto valid_properties = keyframe_values.properties.size();
         dbgln("Animation {} contains {} properties to interpolate, progress = {}%", animation->id(), valid_properties, progress_in_keyframe * 100);
     }
 
-    // FIXME: Follow https://drafts.csswg.org/web-animations-1/#ref-for-computed-keyframes in whatever the right place is.
-    auto compute_keyframe_values = [&computed_properties, &abstract_element, this](auto const& keyframe_values) {
-        HashMap<PropertyID, RefPtr<StyleValue const>> result;
-        HashMap<PropertyID, PropertyID> longhands_set_by_property_id;
-        AK::FixedBitmap<number_of_longhand_properties> property_is_set_by_use_initial(false);
-
-        auto property_is_logical_alias_including_shorthands = [&](PropertyID property_id) {
-            if (property_is_shorthand(property_id))
-                // NOTE: All expanded longhands for a logical alias shorthand are logical aliases so we only need to check the first one.
-                return property_is_logical_alias(expanded_longhands_for_shorthand(property_id)[0]);
-
-            return property_is_logical_alias(property_id);
-        };
-
-        // https://drafts.csswg.org/web-animations-1/#ref-for-computed-keyframes
-        auto is_property_preferred = [&](PropertyID a, PropertyID b) {
-            // If conflicts arise when expanding shorthand properties or replacing logical properties with physical properties, apply the following rules in order until the conflict is resolved:
-            // 1. Longhand properties override shorthand properties (e.g. border-top-color overrides border-top).
-            if (property_is_shorthand(a) != property_is_shorthand(b))
-                return !property_is_shorthand(a);
-
-            // 2. Shorthand properties with fewer longhand components override those with more longhand components (e.g. border-top overrides border-color).
-            if (property_is_shorthand(a)) {
-                auto number_of_expanded_shorthands_a = expanded_longhands_for_shorthand(a).size();
-                auto number_of_expanded_shorthands_b = expanded_longhands_for_shorthand(b).size();
-
-                if (number_of_expanded_shorthands_a != number_of_expanded_shorthands_b)
-                    return number_of_expanded_shorthands_a < number_of_expanded_shorthands_b;
-            }
-
-            auto property_a_is_logical_alias = property_is_logical_alias_including_shorthands(a);
-            auto property_b_is_logical_alias = property_is_logical_alias_including_shorthands(b);
-
-            // 3. Physical properties override logical properties.
-            if (property_a_is_logical_alias != property_b_is_logical_alias)
-                return !property_a_is_logical_alias;
-
-            // 4. For shorthand properties with an equal number of longhand components, properties whose IDL name (see
-            //    the CSS property to IDL attribute algorithm [CSSOM]) appears earlier when sorted in ascending order
-            //    by the Unicode codepoints that make up each IDL name, override those who appear later.
-            return camel_case_string_from_property_id(a) < camel_case_string_from_property_id(b);
-        };
-
-        HashMap<PropertyID, RefPtr<StyleValue const>> specified_values;
-
-        for (auto const& [property_id, value] : keyframe_values.properties) {
-            bool is_use_initial = false;
-
-            auto style_value = value.visit(
-                [&](Animations::KeyframeEffect::KeyFrameSet::UseInitial) -> RefPtr<StyleValue const> {
-                    if (property_is_shorthand(property_id))
-                        return {};
-                    is_use_initial = true;
-                    return computed_properties.property(property_id, ComputedProperties::WithAnimationsApplied::No);
-                },
-                [&](RefPtr<StyleValue const> value) -> RefPtr<StyleValue const> {
-                    return value;
-                });
-
-            if (!style_value) {
-                specified_values.set(property_id, nullptr);
-                continue;
-            }
-
-            // If the style value is a PendingSubstitutionStyleValue we should skip it to avoid overwriting any value
-            // already set by resolving the relevant shorthand's value.
-            if (style_value->is_pending_substitution())
-                continue;
-
-            if (style_value->is_unresolved())
-                style_value = Parser::Parser::resolve_unresolved_style_value(Parser::ParsingParams { abstract_element.document() }, abstract_element, PropertyNameAndID::from_id(property_id), style_value->as_unresolved());
-
-            // https://drafts.csswg.org/css-values-5/#invalid-at-computed-value-time
-            // When substitution results in a guaranteed-invalid value, treat it as unset
-            // (i.e. inherit for inherited properties, initial for non-inherited properties).
-            if (style_value->is_guaranteed_invalid()) {
-                specified_values.set(property_id, nullptr);
-                continue;
-            }
-
-            for_each_property_expanding_shorthands(property_id, *style_value, [&](PropertyID longhand_id, StyleValue const& longhand_value) {
-                auto physical_longhand_id = map_logical_alias_to_physical_property(longhand_id, LogicalAliasMappingContext { computed_properties.writing_mode(), computed_properties.direction() });
-                auto physical_longhand_id_bitmap_index = to_underlying(physical_longhand_id) - to_underlying(first_longhand_property_id);
-
-                // Don't overwrite values if this is the result of a UseInitial
-                if (specified_values.contains(physical_longhand_id) && specified_values.get(physical_longhand_id) != nullptr && is_use_initial)
-                    return;
-
-                // Don't overwrite unless the value was originally set by a UseInitial or this property is preferred over the one that set it originally
-                if (specified_values.contains(physical_longhand_id) && specified_values.get(physical_longhand_id) != nullptr && !property_is_set_by_use_initial.get(physical_longhand_id_bitmap_index) && !is_property_preferred(property_id, longhands_set_by_property_id.get(physical_longhand_id).value()))
-                    return;
-
-                auto const& specified_value_with_css_wide_keywords_applied = [&]() -> StyleValue const& {
-                    if (longhand_value.is_inherit() || (longhand_value.is_unset() && is_inherited_property(longhand_id))) {
-                        if (auto inherited_animated_value = get_animated_inherit_value(longhand_id, abstract_element); inherited_animated_value.has_value())
-                            return inherited_animated_value->value;
-
-                        return get_non_animated_inherit_value(longhand_id, abstract_element);
-                    }
-
-                    if (longhand_value.is_initial() || longhand_value.is_unset())
-                        return property_initial_value(longhand_id);
-
-                    if (longhand_value.is_revert() || longhand_value.is_revert_layer())
-                        return computed_properties.property(longhand_id);
-
-                    return longhand_value;
-                }();
-
-                longhands_set_by_property_id.set(physical_longhand_id, property_id);
-                property_is_set_by_use_initial.set(physical_longhand_id_bitmap_index, is_use_initial);
-                specified_values.set(physical_longhand_id, specified_value_with_css_wide_keywords_applied);
-            });
-        }
-
-        // NOTE: This doesn't necessarily return the specified value if we reach into computed_properties but that
-        //       doesn't matter as a computed value is always valid as a specified value.
-        Function<NonnullRefPtr<StyleValue const>(PropertyID)> get_property_specified_value = [&](PropertyID property_id) -> NonnullRefPtr<StyleValue const> {
-            if (auto keyframe_value = specified_values.get(property_id); keyframe_value.has_value() && keyframe_value.value())
-                return *keyframe_value.value();
-
-            return computed_properties.property(property_id);
-        };
-
-        for (auto const& [property_id, style_value] : specified_values) {
-            if (!style_value)
-                continue;
-
-            auto const& computation_context = get_computation_context_for_property(property_id, computed_properties, abstract_element);
-
-            computation_context.reset_viewport_metric_dependency_tracking();
-            result.set(property_id, compute_value_of_property(property_id, *style_value, get_property_specified_value, computation_context, m_document->page().client().device_pixels_per_css_pixel()));
-            if (computation_context.depends_on_viewport_metrics()) {
-                computed_properties.set_depends_on_viewport_metrics();
-                if (property_affects_font_metrics(property_id))
-                    computed_properties.set_font_metrics_depend_on_viewport_metrics();
-            }
-        }
-
-        return result;
-    };
-
     VERIFY(computation_context_cache_is_empty());
-    HashMap<PropertyID, RefPtr<StyleValue const>> computed_start_values = compute_keyframe_values(keyframe_values);
-    HashMap<PropertyID, RefPtr<StyleValue const>> computed_end_values = compute_keyframe_values(keyframe_end_values);
+    HashMap<PropertyID, RefPtr<StyleValue const>> computed_start_values = compute_keyframe_values(abstract_element, keyframe_values, computed_properties);
+    HashMap<PropertyID, RefPtr<StyleValue const>> computed_end_values = compute_keyframe_values(abstract_element, keyframe_end_values, computed_properties);
     clear_computation_context_caches();
-    auto to_composite_operation = [&](Bindings::CompositeOperationOrAuto composite_operation_or_auto) {
-        switch (composite_operation_or_auto) {
-        case Bindings::CompositeOperationOrAuto::Accumulate:
-            return Bindings::CompositeOperation::Accumulate;
-        case Bindings::CompositeOperationOrAuto::Add:
-            return Bindings::CompositeOperation::Add;
-        case Bindings::CompositeOperationOrAuto::Replace:
-            return Bindings::CompositeOperation::Replace;
-        case Bindings::CompositeOperationOrAuto::Auto:
-            return effect->composite();
-        }
-        VERIFY_NOT_REACHED();
-    };
 
     auto is_result_of_transition = animation->is_css_transition() ? AnimatedPropertyResultOfTransition::Yes : AnimatedPropertyResultOfTransition::No;
 
-    auto start_composite_operation = to_composite_operation(keyframe_values.composite);
-    auto end_composite_operation = to_composite_operation(keyframe_end_values.composite);
+    auto start_composite_operation = keyframe_composite_operation(keyframe_values.composite, effect->composite());
+    auto end_composite_operation = keyframe_composite_operation(keyframe_end_values.composite, effect->composite());
 
     for (auto const& it : computed_start_values) {
         auto resolved_start_property = it.value;
@@ -1060,6 +1077,43 @@ void StyleComputer::collect_animation_into(DOM::AbstractElement abstract_element
     }
 }
 
+Optional<Vector<StyleComputer::ComputedKeyframe>> StyleComputer::compute_keyframes(DOM::AbstractElement abstract_element, Animations::KeyframeEffect& effect, ReadonlySpan<PropertyID> property_ids, ComputedProperties& computed_properties) const
+{
+    auto animation = effect.associated_animation();
+    if (!animation || !effect.key_frame_set())
+        return {};
+
+    auto const& keyframes = effect.key_frame_set()->keyframes_by_key;
+    if (keyframes.size() < 2)
+        return {};
+
+    Vector<ComputedKeyframe> computed_keyframes;
+    computed_keyframes.ensure_capacity(keyframes.size());
+
+    VERIFY(computation_context_cache_is_empty());
+    ScopeGuard clear_caches = [&] { clear_computation_context_caches(); };
+
+    for (auto it = keyframes.begin(); it != keyframes.end(); ++it) {
+        auto const& keyframe = *it;
+        auto values = compute_keyframe_values(abstract_element, keyframe, computed_properties);
+
+        ComputedKeyframe computed_keyframe {
+            .offset = static_cast<double>(it.key()) / (100.0 * Animations::KeyframeEffect::AnimationKeyFrameKeyScaleFactor),
+            .easing = keyframe_easing(keyframe, *animation, abstract_element),
+            .composite = keyframe_composite_operation(keyframe.composite, effect.composite()),
+            .values = {},
+        };
+        for (auto property_id : property_ids) {
+            auto const* value = values.get(property_id).value_or(nullptr);
+            if (!value)
+                return {};
+            computed_keyframe.values.set(property_id, *value);
+        }
+        computed_keyframes.unchecked_append(move(computed_keyframe));
+    }
+    return computed_keyframes;
+}
+
 void StyleComputer::process_animation_definitions(ComputedProperties const& computed_properties, CascadedProperties const& cascaded_properties, DOM::AbstractElement& abstract_element) const
 {
     auto const& animation_definitions = computed_properties.animations(abstract_element);
@@ -2558,6 +2612,25 @@ RefPtr<ComputedProperties> StyleComputer::compute_style_impl(DOM::AbstractElemen
     }
 
     auto old_custom_property_data = abstract_element.custom_property_data();
+    auto record_custom_property_changes = [&] {
+        if (!did_change_custom_properties.has_value())
+            return;
+        auto new_custom_property_data = abstract_element.custom_property_data();
+        if (old_custom_property_data.ptr() != new_custom_property_data.ptr()) {
+            static NeverDestroyed<OrderedHashMap<Utf16FlyString, StyleProperty>> empty_own_values;
+            auto const& old_own = old_custom_property_data ? old_custom_property_data->own_values() : *empty_own_values;
+            auto const& new_own = new_custom_property_data ? new_custom_property_data->own_values() : *empty_own_values;
+            if (old_own != new_own)
+                *did_change_custom_properties = true;
+        }
+    };
+
+    if (mode == ComputeStyleMode::Normal) {
+        if (auto shared_style = share_style_if_possible(abstract_element, matching_rule_set)) {
+            record_custom_property_changes();
+            return shared_style;
+        }
+    }
 
     // Resolve all the CSS custom properties ("variables") for this element:
     if (!abstract_element.pseudo_element().has_value() || pseudo_element_supports_property(*abstract_element.pseudo_element(), PropertyID::Custom)) {
@@ -2636,21 +2709,145 @@ RefPtr<ComputedProperties> StyleComputer::compute_style_impl(DOM::AbstractElemen
     }
 
     auto computed_properties = compute_properties(abstract_element, cascaded_properties);
+    record_custom_property_changes();
 
-    if (did_change_custom_properties.has_value()) {
-        auto new_custom_property_data = abstract_element.custom_property_data();
-        if (old_custom_property_data.ptr() != new_custom_property_data.ptr()) {
-            static NeverDestroyed<OrderedHashMap<Utf16FlyString, StyleProperty>> empty_own_values;
-            auto const& old_own = old_custom_property_data ? old_custom_property_data->own_values() : *empty_own_values;
-            auto const& new_own = new_custom_property_data ? new_custom_property_data->own_values() : *empty_own_values;
-            if (old_own != new_own)
-                *did_change_custom_properties = true;
-        }
-    }
+    if (mode == ComputeStyleMode::Normal)
+        remember_style_sharing_candidate(abstract_element, move(matching_rule_set), computed_properties);
 
     return computed_properties;
 }
 
+// Elements with no per-element styling inputs beyond their attributes, the rules they match and what they inherit.
+// Anything that gets its style adjusted, embeds content or has directionality that depends on its contents is left out.
+static bool element_can_share_style(DOM::Element const& element)
+{
+    if (!element.is_html_element() || element.namespace_uri() != Namespace::HTML)
+        return false;
+
+    if (!first_is_one_of(element.local_name(),
+            HTML::TagNames::a,
+            HTML::TagNames::article,
+            HTML::TagNames::b,
+            HTML::TagNames::code,
+            HTML::TagNames::dd,
+            HTML::TagNames::div,
+            HTML::TagNames::dt,
+            HTML::TagNames::em,
+            HTML::TagNames::footer,
+            HTML::TagNames::header,
+            HTML::TagNames::i,
+            HTML::TagNames::li,
+            HTML::TagNames::nav,
+            HTML::TagNames::ol,
+            HTML::TagNames::p,
+            HTML::TagNames::section,
+            HTML::TagNames::small,
+            HTML::TagNames::span,
+            HTML::TagNames::strong,
+            HTML::TagNames::td,
+            HTML::TagNames::th,
+            HTML::TagNames::tr,
+            HTML::TagNames::ul))
+        return false;
+
+    if (element.shadow_root() || element.assigned_slot_internal() || element.inline_style())
+        return false;
+    if (element.has_attribute(HTML::AttributeNames::dir))
+        return false;
+    return !element.has_css_defined_animations() && !element.has_relevant_animations();
+}
+
+static bool attributes_are_equal(DOM::Element const& a, DOM::Element const& b)
+{
+    if (a.attribute_list_size() != b.attribute_list_size())
+        return false;
+    bool equal = true;
+    a.for_each_attribute([&](DOM::Attr const& attribute) {
+        if (equal && b.get_attribute_ns(attribute.namespace_uri(), attribute.local_name()) != attribute.value())
+            equal = false;
+    });
+    return equal;
+}
+
+RefPtr<ComputedProperties> StyleComputer::share_style_if_possible(DOM::AbstractElement abstract_element, MatchingRuleSet const& matching_rule_set) const
+{
+    if (!m_style_sharing_enabled || m_style_sharing_candidates.is_empty() || abstract_element.pseudo_element().has_value())
+        return {};
+
+    auto& element = abstract_element.element();
+    if (!element_can_share_style(element))
+        return {};
+
+    auto inheritance_parent = abstract_element.element_to_inherit_style_from();
+    if (!inheritance_parent.has_value() || inheritance_parent->pseudo_element().has_value())
+        return {};
+    auto const* inheritance_parent_style = inheritance_parent->computed_properties();
+
+    for (auto const& candidate : m_style_sharing_candidates) {
+        if (candidate.element.ptr() == &element
+            || candidate.inheritance_parent.ptr() != &inheritance_parent->element()
+            || candidate.inheritance_parent_style.ptr() != inheritance_parent_style
+            || candidate.element->local_name() != element.local_name()
+            || !attributes_are_equal(candidate.element, element)
+            || candidate.matching_rule_set != matching_rule_set)
+            continue;
+
+        // Everything the cascade and value computation read is the same as for the candidate, so they would produce
+        // the same custom properties and computed values. Transitions depend on this element's previous style though.
+        abstract_element.set_custom_property_data(candidate.custom_property_data);
+        if (candidate.uses_attr_css_function)
+            element.set_style_uses_attr_css_function();
+        if (candidate.uses_var_css_function)
+            element.set_style_uses_var_css_function();
+        if (candidate.uses_if_css_function)
+            element.set_style_uses_if_css_function();
+        if (candidate.uses_inherit_css_function)
+            element.set_style_uses_inherit_css_function();
+
+        auto style = candidate.style->clone();
+        compute_transitioned_properties(style, abstract_element);
+        if (auto previous_style = abstract_element.computed_properties())
+            start_needed_transitions(*previous_style, style, abstract_element);
+
+        ++m_document->style_invalidation_counters().shared_element_styles;
+        return style;
+    }
+    return {};
+}
+
+void StyleComputer::remember_style_sharing_candidate(DOM::AbstractElement abstract_element, MatchingRuleSet matching_rule_set, ComputedProperties const& style) const
+{
+    if (!m_style_sharing_enabled || abstract_element.pseudo_element().has_value())
+        return;
+
+    // Tree-counting functions like sibling-index() compute to something different for every sibling.
+    auto& element = abstract_element.element();
+    if (!element_can_share_style(element) || element.style_uses_tree_counting_function())
+        return;
+
+    auto inheritance_parent = abstract_element.element_to_inherit_style_from();
+    if (!inheritance_parent.has_value() || inheritance_parent->pseudo_element().has_value())
+        return;
+    auto const* inheritance_parent_style = inheritance_parent->computed_properties();
+    if (!inheritance_parent_style)
+        return;
+
+    if (m_style_sharing_candidates.size() == style_sharing_candidate_limit)
+        m_style_sharing_candidates.take_last();
+    m_style_sharing_candidates.prepend(StyleSharingCandidate {
+        .element = element,
+        .inheritance_parent = inheritance_parent->element(),
+        .inheritance_parent_style = *inheritance_parent_style,
+        .matching_rule_set = move(matching_rule_set),
+        .custom_property_data = abstract_element.custom_property_data(),
+        .style = style,
+        .uses_attr_css_function = element.style_uses_attr_css_function(),
+        .uses_var_css_function = element.style_uses_var_css_function(),
+        .uses_if_css_function = element.style_uses_if_css_function(),
+        .uses_inherit_css_function = element.style_uses_inherit_css_function(),
+    });
+}
+
 static bool is_monospace(StyleValue const& value)
 {
     if (!value.is_value_list())
@@ -3002,11 +3199,27 @@ static Optional<SimplifiedSelectorForBucketing> is_roundabout_selector_bucketabl
     return {};
 }
 
+// OPTIMIZATION: Custom properties that refer to each other through var() would resolve the same references again for
+//               every property that uses them, which makes long chains of design tokens quadratic. While the custom
+//               properties of an element are being computed, the values computed so far are remembered and reused.
+//               Only values computed from scratch are remembered, since a value computed while other references are
+//               being guarded could have been cut short by a cycle that doesn't involve it.
+struct ComputedCustomPropertyValues {
+    DOM::AbstractElement element;
+    HashMap<Utf16FlyString, NonnullRefPtr<StyleValue const>> values;
+};
+static ComputedCustomPropertyValues* s_computed_custom_property_values = nullptr;
+
 NonnullRefPtr<StyleValue const> StyleComputer::compute_value_of_custom_property(DOM::AbstractElement abstract_element, Utf16FlyString const& name, Optional<Parser::GuardedSubstitutionContexts&> guarded_contexts)
 {
     // https://drafts.csswg.org/css-variables/#propdef-
     // The computed value of a custom property is its specified value with any arbitrary-substitution functions replaced.
     // FIXME: These should probably be part of ComputedProperties.
+    if (s_computed_custom_property_values && s_computed_custom_property_values->element == abstract_element) {
+        if (auto value = s_computed_custom_property_values->values.get(name); value.has_value())
+            return *value;
+    }
+
     auto& document = abstract_element.document();
 
     auto value = abstract_element.get_custom_property(name);
@@ -3064,9 +3277,13 @@ void StyleComputer::compute_custom_properties(ComputedProperties&, DOM::Abstract
     if (inherit_from.has_value())
         parent_data = inheritable_custom_property_data(*inherit_from);
 
+    ComputedCustomPropertyValues computed_values { abstract_element, {} };
+    TemporaryChange change_computed_values { s_computed_custom_property_values, &computed_values };
+
     OrderedHashMap<Utf16FlyString, StyleProperty> resolved_own;
     for (auto const& [name, style_property] : data->own_values()) {
         auto resolved_value = compute_value_of_custom_property(abstract_element, name);
+        computed_values.values.set(name, resolved_value);
         if (parent_data) {
             auto const* parent_property = parent_data->get(name);
             if (parent_property && resolved_value->equals(*parent_property->value))
@@ -3086,8 +3303,22 @@ void StyleComputer::compute_custom_properties(ComputedProperties&, DOM::Abstract
     }
 
     // FIXME: We should update in place so that non-recomputed children aren't left pointing at stale data
-    abstract_element.set_custom_property_data(
-        CustomPropertyData::create(move(resolved_own), parent_data ? move(parent_data) : data->parent()));
+    auto new_data = CustomPropertyData::create(move(resolved_own), parent_data ? move(parent_data) : data->parent());
+
+    // OPTIMIZATION: Siblings very often end up with the same custom properties, such as the items of a list that all
+    //               set the same design tokens. Sharing the previous sibling's data then saves the memory of a copy,
+    //               and lets the descendants of both find out that they inherit the same values by comparing pointers.
+    if (!abstract_element.pseudo_element().has_value()) {
+        if (auto const* sibling = abstract_element.element().previous_element_sibling()) {
+            auto sibling_data = sibling->custom_property_data({});
+            if (sibling_data && sibling_data->parent() == new_data->parent() && sibling_data->own_values() == new_data->own_values()) {
+                abstract_element.set_custom_property_data(move(sibling_data));
+                return;
+            }
+        }
+    }
+
+    abstract_element.set_custom_property_data(move(new_data));
 }
 
 static CSSPixels line_width_keyword_to_css_pixels(Keyword keyword)
@@ -3709,6 +3940,12 @@ void StyleComputer::reset_ancestor_filter()
     m_ancestor_filter->clear();
 }
 
+void StyleComputer::set_style_sharing_enabled(bool enabled)
+{
+    m_style_sharing_enabled = enabled;
+    m_style_sharing_candidates.clear();
+}
+
 void StyleComputer::reset_has_result_cache()
 {
     if (!m_has_result_cache)
@@ -3868,4 +4105,19 @@ void StyleComputer::ScopedMatchingRule::visit_edges(GC::Cell::Visitor& visitor)
     visitor.visit(scope_root);
 }
 
+void StyleComputer::MatchingRuleSet::visit_edges(GC::Cell::Visitor& visitor)
+{
+    for (auto& rule : user_agent_rules)
+        rule.visit_edges(visitor);
+    for (auto& rule : user_rules)
+        rule.visit_edges(visitor);
+    for (auto& context : author_contexts) {
+        visitor.visit(context.shadow_root);
+        for (auto& layer : context.author_rules) {
+            for (auto& rule : layer.rules)
+                rule.visit_edges(visitor);
+        }
+    }
+}
+
 }
@@ -101,6 +101,11 @@ public:
     void push_ancestor(DOM::Element const&);
     void pop_ancestor(DOM::Element const&);
 
+    // While enabled, elements whose cascade would be identical to that of a recently styled element with the same
+    // parent get a copy of its computed style instead of computing their own. Only the caller knows when the tree and
+    // the style sheets can't change between elements, so whoever enables it also has to disable it again.
+    void set_style_sharing_enabled(bool);
+
     [[nodiscard]] NonnullRefPtr<ComputedProperties> create_document_style() const;
 
     [[nodiscard]] NonnullRefPtr<ComputedProperties> compute_style(DOM::AbstractElement, Optional<bool&> did_change_custom_properties = {}) const;
@@ -115,6 +120,8 @@ public:
         size_t scope_proximity { NumericLimits<size_t>::max() };
 
         void visit_edges(GC::Cell::Visitor& visitor);
+
+        bool operator==(ScopedMatchingRule const&) const = default;
     };
 
     NonnullRefPtr<InvalidationPlan> invalidation_plan_for_properties(Vector<InvalidationSet::Property> const&, StyleScope const&) const;
@@ -129,6 +136,16 @@ public:
 
     void collect_animation_into(DOM::AbstractElement, GC::Ref<Animations::KeyframeEffect> animation, ComputedProperties&) const;
 
+    struct ComputedKeyframe {
+        double offset { 0 };
+        Optional<EasingFunction> easing;
+        Bindings::CompositeOperation composite { Bindings::CompositeOperation::Replace };
+        HashMap<PropertyID, NonnullRefPtr<StyleValue const>> values;
+    };
+    // The computed values of the given properties at every keyframe of an effect, for running the effect somewhere
+    // other than here. Returns nothing if a keyframe doesn't have a value for each of them.
+    Optional<Vector<ComputedKeyframe>> compute_keyframes(DOM::AbstractElement, Animations::KeyframeEffect&, ReadonlySpan<PropertyID>, ComputedProperties&) const;
+
     [[nodiscard]] NonnullRefPtr<ComputedProperties> compute_properties(DOM::AbstractElement, CascadedProperties&) const;
 
     void compute_property_values(ComputedProperties&, Optional<DOM::AbstractElement>) const;
@@ -167,24 +184,51 @@ private:
     struct LayerMatchingRules {
         FlyString qualified_layer_name;
         Vector<ScopedMatchingRule> rules;
+
+        bool operator==(LayerMatchingRules const&) const = default;
     };
 
     struct ContextMatchingRules {
         GC::Ptr<DOM::ShadowRoot const> shadow_root;
         Vector<LayerMatchingRules> author_rules;
+
+        bool operator==(ContextMatchingRules const&) const = default;
     };
 
     struct MatchingRuleSet {
         Vector<ScopedMatchingRule> user_agent_rules;
         Vector<ScopedMatchingRule> user_rules;
         Vector<ContextMatchingRules> author_contexts;
+
+        void visit_edges(GC::Cell::Visitor&);
+
+        bool operator==(MatchingRuleSet const&) const = default;
+    };
+
+    struct StyleSharingCandidate {
+        GC::Ref<DOM::Element const> element;
+        GC::Ref<DOM::Element const> inheritance_parent;
+        NonnullRefPtr<ComputedProperties const> inheritance_parent_style;
+        MatchingRuleSet matching_rule_set;
+        RefPtr<CustomPropertyData const> custom_property_data;
+        NonnullRefPtr<ComputedProperties const> style;
+        bool uses_attr_css_function { false };
+        bool uses_var_css_function { false };
+        bool uses_if_css_function { false };
+        bool uses_inherit_css_function { false };
     };
 
+    // Siblings and cousins that look alike tend to be styled one after the other, so a handful of candidates catches
+    // most of them without making misses expensive.
+    static constexpr size_t style_sharing_candidate_limit = 8;
+
     [[nodiscard]] MatchingRuleSet build_matching_rule_set(DOM::AbstractElement, bool& did_match_any_pseudo_element_rules, ComputeStyleMode) const;
 
     [[nodiscard]] RefPtr<ComputedProperties> compute_style_impl(DOM::AbstractElement, ComputeStyleMode, Optional<bool&> did_change_custom_properties, StyleScope const&) const;
     [[nodiscard]] NonnullRefPtr<CascadedProperties> compute_cascaded_values(DOM::AbstractElement, bool did_match_any_pseudo_element_rules, ComputeStyleMode, MatchingRuleSet const&) const;
     void compute_custom_properties(ComputedProperties&, DOM::AbstractElement) const;
+    [[nodiscard]] RefPtr<ComputedProperties> share_style_if_possible(DOM::AbstractElement, MatchingRuleSet const&) const;
+    void remember_style_sharing_candidate(DOM::AbstractElement, MatchingRuleSet, ComputedProperties const&) const;
     void start_needed_transitions(ComputedProperties const& old_style, ComputedProperties& new_style, DOM::AbstractElement) const;
     void resolve_effective_overflow_values(ComputedProperties&) const;
     void transform_box_type_if_needed(ComputedProperties&, DOM::AbstractElement) const;
@@ -227,6 +271,7 @@ private:
     mutable Optional<ComputationContext> m_cached_line_height_computation_context;
     mutable Optional<ComputationContext> m_cached_generic_computation_context;
     ComputationContext const& get_computation_context_for_property(PropertyID, ComputedProperties const&, Optional<DOM::AbstractElement>) const;
+    HashMap<PropertyID, RefPtr<StyleValue const>> compute_keyframe_values(DOM::AbstractElement, Animations::KeyframeEffect::KeyFrameSet::ResolvedKeyFrame const&, ComputedProperties&) const;
     void clear_computation_context_caches() const
     {
         const_cast<StyleComputer*>(this)->m_cached_font_computation_context = {};
@@ -243,6 +288,9 @@ private:
 
     mutable Vector<ScopedMatchingRule> m_rules_to_run_scratch;
 
+    bool m_style_sharing_enabled { false };
+    mutable Vector<StyleSharingCandidate> m_style_sharing_candidates;
+
     OwnPtr<CountingBloomFilter<u8, 14>> m_ancestor_filter;
     OwnPtr<SelectorEngine::HasResultCache> m_has_result_cache;
 };
@@ -0,0 +1,666 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Math.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibWeb/Animations/Animation.h>
+#include <LibWeb/Animations/DocumentTimeline.h>
+#include <LibWeb/Animations/KeyframeEffect.h>
+#include <LibWeb/Animations/ScrollTimeline.h>
+#include <LibWeb/CSS/Angle.h>
+#include <LibWeb/CSS/ComputedProperties.h>
+#include <LibWeb/CSS/StyleComputer.h>
+#include <LibWeb/CSS/StyleValues/NumberStyleValue.h>
+#include <LibWeb/CSS/StyleValues/OpacityValueStyleValue.h>
+#include <LibWeb/CSS/StyleValues/PercentageStyleValue.h>
+#include <LibWeb/CSS/StyleValues/TransformationStyleValue.h>
+#include <LibWeb/Compositor/AsyncAnimations.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/Element.h>
+#include <LibWeb/Page/Page.h>
+#include <LibWeb/Painting/PaintableBox.h>
+
+namespace Web::Compositor {
+
+Gfx::FloatMatrix4x4 AsyncTransformFunction::to_matrix() const
+{
+    switch (type) {
+    case Type::Translate:
+        return Gfx::translation_matrix(Vector3<float> { x, y, z });
+    case Type::Scale:
+        return Gfx::scale_matrix(Vector3<float> { x, y, z });
+    case Type::Rotate:
+        return Gfx::rotation_matrix(Vector3<float> { 0.0f, 0.0f, 1.0f }, x);
+    }
+    VERIFY_NOT_REACHED();
+}
+
+namespace {
+
+enum class Phase : u8 {
+    Before,
+    Active,
+    After,
+};
+
+struct TimingSample {
+    Phase phase;
+    Optional<double> transformed_progress;
+};
+
+}
+
+// This follows the AnimationEffect timing steps, for an effect whose local time is known to be resolved.
+// https://drafts.csswg.org/web-animations-1/#core-animation-model-calculations
+static TimingSample sample_timing(AsyncAnimationTiming const& timing, double local_time)
+{
+    // https://drafts.csswg.org/web-animations-1/#active-duration
+    auto active_duration = (timing.iteration_duration == 0 || timing.iteration_count == 0) ? 0.0 : timing.iteration_duration * timing.iteration_count;
+
+    // https://drafts.csswg.org/web-animations-1/#end-time
+    auto end_time = max(timing.start_delay + active_duration + timing.end_delay, 0.0);
+
+    // https://drafts.csswg.org/web-animations-1/#animation-effect-phases-and-states
+    auto before_active_boundary_time = max(min(timing.start_delay, end_time), 0.0);
+    auto after_active_boundary_time = max(min(timing.start_delay + active_duration, end_time), 0.0);
+    auto animation_direction_is_backwards = timing.playback_rate < 0;
+
+    Phase phase = Phase::Active;
+    if (local_time < before_active_boundary_time || (animation_direction_is_backwards && local_time == before_active_boundary_time))
+        phase = Phase::Before;
+    else if (local_time > after_active_boundary_time || (!animation_direction_is_backwards && local_time == after_active_boundary_time))
+        phase = Phase::After;
+
+    // https://drafts.csswg.org/web-animations-1/#calculating-the-active-time
+    Optional<double> active_time;
+    switch (phase) {
+    case Phase::Before:
+        if (timing.fills_backwards)
+            active_time = max(local_time - timing.start_delay, 0.0);
+        break;
+    case Phase::Active:
+        active_time = local_time - timing.start_delay;
+        break;
+    case Phase::After:
+        if (timing.fills_forwards)
+            active_time = max(min(local_time - timing.start_delay, active_duration), 0.0);
+        break;
+    }
+    if (!active_time.has_value())
+        return { phase, {} };
+
+    // https://drafts.csswg.org/web-animations-1/#overall-progress
+    double overall_progress;
+    if (timing.iteration_duration == 0)
+        overall_progress = phase == Phase::Before ? 0.0 : timing.iteration_count;
+    else
+        overall_progress = active_time.value() / timing.iteration_duration;
+    overall_progress += timing.iteration_start;
+
+    // https://drafts.csswg.org/web-animations-1/#simple-iteration-progress
+    double simple_iteration_progress = isinf(overall_progress) ? fmod(timing.iteration_start, 1.0) : fmod(overall_progress, 1.0);
+    if (simple_iteration_progress == 0.0 && phase != Phase::Before && active_time.value() == active_duration && timing.iteration_count != 0.0)
+        simple_iteration_progress = 1.0;
+
+    // https://drafts.csswg.org/web-animations-1/#current-iteration
+    double current_iteration;
+    if (phase == Phase::After && isinf(timing.iteration_count))
+        current_iteration = timing.iteration_count;
+    else if (simple_iteration_progress == 1.0)
+        current_iteration = floor(overall_progress) - 1.0;
+    else
+        current_iteration = floor(overall_progress);
+
+    // https://drafts.csswg.org/web-animations-1/#directed-progress
+    bool going_forwards = true;
+    switch (timing.direction) {
+    case AsyncAnimationDirection::Normal:
+        break;
+    case AsyncAnimationDirection::Reverse:
+        going_forwards = false;
+        break;
+    case AsyncAnimationDirection::Alternate:
+    case AsyncAnimationDirection::AlternateReverse: {
+        auto d = current_iteration;
+        if (timing.direction == AsyncAnimationDirection::AlternateReverse)
+            d += 1.0;
+        going_forwards = isinf(d) || fmod(d, 2.0) == 0.0;
+        break;
+    }
+    }
+    auto directed_progress = going_forwards ? simple_iteration_progress : 1.0 - simple_iteration_progress;
+
+    // https://drafts.csswg.org/web-animations-1/#calculating-the-transformed-progress
+    auto before_flag = (phase == Phase::Before && going_forwards) || (phase == Phase::After && !going_forwards);
+    return { phase, timing.timing_function.evaluate_at(directed_progress, before_flag) };
+}
+
+static AsyncTransformFunction identity_transform_function(AsyncTransformFunction::Type type)
+{
+    if (type == AsyncTransformFunction::Type::Scale)
+        return { type, 1, 1, 1 };
+    return { type, 0, 0, 0 };
+}
+
+static bool transform_lists_can_be_interpolated(Vector<AsyncTransformFunction> const& from, Vector<AsyncTransformFunction> const& to)
+{
+    if (from.is_empty() || to.is_empty())
+        return true;
+    if (from.size() != to.size())
+        return false;
+    for (size_t i = 0; i < from.size(); ++i) {
+        if (from[i].type != to[i].type)
+            return false;
+    }
+    return true;
+}
+
+// https://drafts.csswg.org/css-transforms-1/#interpolation-of-transforms
+// Only lists of the same shape reach the compositor, with "none" standing in for a list of identity functions.
+static Vector<AsyncTransformFunction> interpolate_transform_lists(Vector<AsyncTransformFunction> const& from, Vector<AsyncTransformFunction> const& to, float delta)
+{
+    auto const& shape = from.is_empty() ? to : from;
+    Vector<AsyncTransformFunction> result;
+    result.ensure_capacity(shape.size());
+    for (size_t i = 0; i < shape.size(); ++i) {
+        auto start = from.is_empty() ? identity_transform_function(shape[i].type) : from[i];
+        auto end = to.is_empty() ? identity_transform_function(shape[i].type) : to[i];
+        VERIFY(start.type == end.type);
+        result.unchecked_append({
+            start.type,
+            start.x + (end.x - start.x) * delta,
+            start.y + (end.y - start.y) * delta,
+            start.z + (end.z - start.z) * delta,
+        });
+    }
+    return result;
+}
+
+static AsyncAnimatedValue interpolate_keyframes(ReadonlySpan<AsyncAnimationKeyframe> keyframes, double progress)
+{
+    VERIFY(keyframes.size() >= 2);
+
+    // NB: This picks the interval the same way StyleComputer::collect_animation_into() does.
+    size_t start_index = 0;
+    if (progress > 0) {
+        while (start_index + 1 < keyframes.size() && keyframes[start_index + 1].offset <= progress)
+            ++start_index;
+        if (start_index + 1 == keyframes.size())
+            --start_index;
+    }
+    auto const& start = keyframes[start_index];
+    auto const& end = keyframes[start_index + 1];
+
+    auto progress_in_keyframe = (progress - start.offset) / (end.offset - start.offset);
+    if (start.easing.has_value())
+        progress_in_keyframe = start.easing->evaluate_at(progress_in_keyframe, false);
+    auto delta = static_cast<float>(progress_in_keyframe);
+
+    return start.value.visit(
+        [&](float start_opacity) -> AsyncAnimatedValue {
+            auto end_opacity = end.value.get<float>();
+            return clamp(start_opacity + (end_opacity - start_opacity) * delta, 0.0f, 1.0f);
+        },
+        [&](Vector<AsyncTransformFunction> const& start_functions) -> AsyncAnimatedValue {
+            return interpolate_transform_lists(start_functions, end.value.get<Vector<AsyncTransformFunction>>(), delta);
+        });
+}
+
+double AsyncAnimation::local_time_at(MonotonicTime now, Painting::ScrollStateSnapshot const& scroll_state_snapshot) const
+{
+    if (scroll_timeline.has_value()) {
+        // https://drafts.csswg.org/scroll-animations-1/#scroll-timeline-progress
+        // NB: A scroll frame's offset is the negated scroll offset of its box.
+        auto offset = scroll_state_snapshot.device_offset_for_index(scroll_timeline->scroll_frame_index);
+        auto scroll_offset = -(scroll_timeline->is_vertical ? offset.y() : offset.x());
+        auto timeline_time = static_cast<double>(scroll_offset) / scroll_timeline->max_scroll_offset * 100.0;
+        return (timeline_time - scroll_timeline->start_time) * timing.playback_rate;
+    }
+
+    auto elapsed_milliseconds = static_cast<double>(now.nanoseconds() - sampled_at_in_nanoseconds) / 1'000'000.0;
+    return local_time + elapsed_milliseconds * timing.playback_rate;
+}
+
+// https://drafts.csswg.org/web-animations-1/#play-states
+bool AsyncAnimation::has_finished_at(double local_time) const
+{
+    auto phase = sample_timing(timing, local_time).phase;
+    return (timing.playback_rate > 0 && phase == Phase::After) || (timing.playback_rate < 0 && phase == Phase::Before);
+}
+
+AsyncAnimatedValue AsyncAnimation::value_at(double local_time) const
+{
+    auto transformed_progress = sample_timing(timing, local_time).transformed_progress;
+    if (!transformed_progress.has_value())
+        return underlying_value;
+    return interpolate_keyframes(keyframes, transformed_progress.value());
+}
+
+// NB: The target nodes come from another process, so don't trust them to point at the right kind of node.
+template<typename T>
+static bool node_has(Painting::AccumulatedVisualContextTree const& visual_context_tree, Painting::VisualContextIndex index)
+{
+    return index.value() < visual_context_tree.nodes().size() && visual_context_tree.node_at(index).data.has<T>();
+}
+
+bool apply_async_animations(ReadonlySpan<AsyncAnimation> animations, Painting::AccumulatedVisualContextTree& visual_context_tree, Painting::ScrollStateSnapshot const& scroll_state_snapshot, MonotonicTime now)
+{
+    bool has_running_animations = false;
+    for (auto const& animation : animations) {
+        auto local_time = animation.local_time_at(now, scroll_state_snapshot);
+        auto value = animation.value_at(local_time);
+        switch (animation.property) {
+        case AsyncAnimatedProperty::Opacity: {
+            auto opacity = value.get<float>();
+            for (auto node : animation.target_nodes) {
+                if (node_has<Painting::EffectsData>(visual_context_tree, node))
+                    visual_context_tree.set_effects_opacity(node, opacity);
+            }
+            break;
+        }
+        case AsyncAnimatedProperty::Transform: {
+            auto matrix = animation.transform_prefix;
+            for (auto const& function : value.get<Vector<AsyncTransformFunction>>())
+                matrix = matrix * function.to_matrix();
+            matrix = Painting::scale_matrix_for_device_pixels(matrix, animation.device_pixels_per_css_pixel);
+            for (auto node : animation.target_nodes) {
+                if (node_has<Painting::TransformData>(visual_context_tree, node))
+                    visual_context_tree.set_transform_matrix(node, matrix);
+            }
+            break;
+        }
+        }
+        // NB: A scroll-driven animation only moves when something scrolls, which presents a new frame anyway.
+        if (!animation.scroll_timeline.has_value() && !animation.has_finished_at(local_time))
+            has_running_animations = true;
+    }
+    return has_running_animations;
+}
+
+static Optional<float> opacity_from_style_value(CSS::StyleValue const& value)
+{
+    if (value.is_opacity_value())
+        return static_cast<float>(value.as_opacity_value().resolved());
+    if (value.is_number())
+        return static_cast<float>(value.as_number().number());
+    if (value.is_percentage())
+        return static_cast<float>(value.as_percentage().percentage().as_fraction());
+    return {};
+}
+
+static Optional<Vector<AsyncTransformFunction>> transform_functions_from_style_value(CSS::StyleValue const& value, Painting::PaintableBox const& paintable_box)
+{
+    if (value.is_keyword() && value.to_keyword() == CSS::Keyword::None)
+        return Vector<AsyncTransformFunction> {};
+    if (!value.is_value_list())
+        return {};
+
+    Vector<AsyncTransformFunction> functions;
+    for (auto const& transformation : CSS::ComputedProperties::transformations_for_style_value(value)) {
+        switch (transformation->transform_function()) {
+        case CSS::TransformFunction::Translate:
+        case CSS::TransformFunction::Translate3d:
+        case CSS::TransformFunction::TranslateX:
+        case CSS::TransformFunction::TranslateY:
+        case CSS::TransformFunction::TranslateZ: {
+            auto matrix = transformation->to_matrix(paintable_box);
+            functions.append({ AsyncTransformFunction::Type::Translate, matrix[0, 3], matrix[1, 3], matrix[2, 3] });
+            break;
+        }
+        case CSS::TransformFunction::Scale:
+        case CSS::TransformFunction::Scale3d:
+        case CSS::TransformFunction::ScaleX:
+        case CSS::TransformFunction::ScaleY:
+        case CSS::TransformFunction::ScaleZ: {
+            auto matrix = transformation->to_matrix(paintable_box);
+            functions.append({ AsyncTransformFunction::Type::Scale, matrix[0, 0], matrix[1, 1], matrix[2, 2] });
+            break;
+        }
+        case CSS::TransformFunction::Rotate:
+        case CSS::TransformFunction::RotateZ: {
+            // NB: The angle is read directly rather than from the matrix, so that turns of 180 degrees or more survive.
+            auto angle = CSS::Angle::from_style_value(*transformation->values()[0], {}).to_radians();
+            functions.append({ AsyncTransformFunction::Type::Rotate, static_cast<float>(angle), 0, 0 });
+            break;
+        }
+        default:
+            return {};
+        }
+    }
+    return functions;
+}
+
+static AsyncAnimationDirection to_async_animation_direction(Bindings::PlaybackDirection direction)
+{
+    switch (direction) {
+    case Bindings::PlaybackDirection::Normal:
+        return AsyncAnimationDirection::Normal;
+    case Bindings::PlaybackDirection::Reverse:
+        return AsyncAnimationDirection::Reverse;
+    case Bindings::PlaybackDirection::Alternate:
+        return AsyncAnimationDirection::Alternate;
+    case Bindings::PlaybackDirection::AlternateReverse:
+        return AsyncAnimationDirection::AlternateReverse;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+static Optional<AsyncScrollTimeline> make_async_scroll_timeline(Animations::ScrollTimeline const& timeline, Animations::Animation const& animation, float device_pixels_per_css_pixel)
+{
+    auto scroll_container = timeline.scroll_container();
+    if (!scroll_container.has_value() || scroll_container->max_scroll_offset <= 0)
+        return {};
+    auto scroll_frame_index = scroll_container->paintable_box->own_scroll_frame_index();
+    if (!scroll_frame_index.value())
+        return {};
+    auto start_time = animation.start_time();
+    if (!start_time.has_value() || start_time->type != Animations::TimeValue::Type::Percentage)
+        return {};
+
+    return AsyncScrollTimeline {
+        .scroll_frame_index = scroll_frame_index,
+        .is_vertical = scroll_container->is_vertical,
+        .max_scroll_offset = static_cast<float>(scroll_container->max_scroll_offset * device_pixels_per_css_pixel),
+        .start_time = start_time->value,
+    };
+}
+
+static Optional<AsyncAnimation> make_async_animation(DOM::Element& element, Painting::PaintableBox const& paintable_box, CSS::ComputedProperties& computed_properties, Animations::Animation& animation, CSS::PropertyID property_id, MonotonicTime now)
+{
+    auto device_pixels_per_css_pixel = static_cast<float>(element.document().page().client().device_pixels_per_css_pixel());
+
+    // The compositor only knows how to advance a running animation on a monotonically increasing timeline, or on a
+    // scroll timeline whose scroll container it scrolls itself.
+    auto timeline = animation.timeline();
+    if (!timeline)
+        return {};
+    Optional<AsyncScrollTimeline> scroll_timeline;
+    auto time_type = Animations::TimeValue::Type::Milliseconds;
+    if (auto const* timeline_of_scroll = as_if<Animations::ScrollTimeline>(*timeline)) {
+        scroll_timeline = make_async_scroll_timeline(*timeline_of_scroll, animation, device_pixels_per_css_pixel);
+        if (!scroll_timeline.has_value())
+            return {};
+        time_type = Animations::TimeValue::Type::Percentage;
+    } else if (!is<Animations::DocumentTimeline>(*timeline)) {
+        return {};
+    }
+    if (animation.play_state() != Bindings::AnimationPlayState::Running || animation.pending() || animation.playback_rate() == 0)
+        return {};
+    auto current_time = animation.current_time();
+    if (!current_time.has_value() || current_time->type != time_type)
+        return {};
+
+    auto& effect = as<Animations::KeyframeEffect>(*animation.effect());
+    if (effect.iteration_duration().type != time_type || effect.start_delay().type != time_type || effect.end_delay().type != time_type)
+        return {};
+
+    // An important declaration wins over the animation, unless the animation is a transition.
+    if (computed_properties.is_property_important(property_id) && !animation.is_css_transition())
+        return {};
+
+    auto computed_keyframes = element.document().style_computer().compute_keyframes(DOM::AbstractElement { element }, effect, ReadonlySpan<CSS::PropertyID> { &property_id, 1 }, computed_properties);
+    if (!computed_keyframes.has_value())
+        return {};
+
+    auto to_animated_value = [&](CSS::StyleValue const& value) -> Optional<AsyncAnimatedValue> {
+        if (property_id == CSS::PropertyID::Opacity) {
+            if (auto opacity = opacity_from_style_value(value); opacity.has_value())
+                return AsyncAnimatedValue { opacity.release_value() };
+            return {};
+        }
+        if (auto functions = transform_functions_from_style_value(value, paintable_box); functions.has_value())
+            return AsyncAnimatedValue { functions.release_value() };
+        return {};
+    };
+
+    Vector<AsyncAnimationKeyframe> keyframes;
+    keyframes.ensure_capacity(computed_keyframes->size());
+    for (auto& computed_keyframe : *computed_keyframes) {
+        if (computed_keyframe.composite != Bindings::CompositeOperation::Replace)
+            return {};
+        auto value = to_animated_value(*computed_keyframe.values.get(property_id).value());
+        if (!value.has_value())
+            return {};
+        if (property_id == CSS::PropertyID::Transform && !keyframes.is_empty()
+            && !transform_lists_can_be_interpolated(keyframes.last().value.get<Vector<AsyncTransformFunction>>(), value->get<Vector<AsyncTransformFunction>>()))
+            return {};
+        keyframes.unchecked_append({ computed_keyframe.offset, move(computed_keyframe.easing), value.release_value() });
+    }
+
+    auto underlying_value = to_animated_value(computed_properties.property(property_id, CSS::ComputedProperties::WithAnimationsApplied::No));
+    if (!underlying_value.has_value())
+        return {};
+
+    auto fill_mode = effect.fill_mode();
+    AsyncAnimation async_animation {
+        .property = property_id == CSS::PropertyID::Opacity ? AsyncAnimatedProperty::Opacity : AsyncAnimatedProperty::Transform,
+        .target_nodes = {},
+        .timing = {
+            .start_delay = effect.start_delay().value,
+            .end_delay = effect.end_delay().value,
+            .iteration_duration = effect.iteration_duration().value,
+            .iteration_count = effect.iteration_count(),
+            .iteration_start = effect.iteration_start(),
+            .direction = to_async_animation_direction(effect.playback_direction()),
+            .fills_backwards = fill_mode == Bindings::FillMode::Backwards || fill_mode == Bindings::FillMode::Both,
+            .fills_forwards = fill_mode == Bindings::FillMode::Forwards || fill_mode == Bindings::FillMode::Both,
+            .timing_function = effect.timing_function(),
+            .playback_rate = animation.playback_rate(),
+        },
+        .keyframes = move(keyframes),
+        .underlying_value = underlying_value.release_value(),
+        .transform_prefix = Gfx::FloatMatrix4x4::identity(),
+        .device_pixels_per_css_pixel = device_pixels_per_css_pixel,
+        // NB: The animation's current time was taken at the start of this rendering update, which is close enough to
+        //     now that the compositor can carry on from here.
+        .local_time = current_time->value,
+        .sampled_at_in_nanoseconds = now.nanoseconds(),
+        .scroll_timeline = scroll_timeline,
+    };
+
+    if (async_animation.property == AsyncAnimatedProperty::Transform) {
+        auto const& computed_values = paintable_box.computed_values();
+        auto& prefix = async_animation.transform_prefix;
+        if (auto const& translate = computed_values.translate())
+            prefix = prefix * translate->to_matrix(paintable_box);
+        if (auto const& rotate = computed_values.rotate())
+            prefix = prefix * rotate->to_matrix(paintable_box);
+        if (auto const& scale = computed_values.scale())
+            prefix = prefix * scale->to_matrix(paintable_box);
+    }
+
+    return async_animation;
+}
+
+AsyncAnimationsForBox async_animations_for_box(Painting::PaintableBox& paintable_box, MonotonicTime now)
+{
+    if (paintable_box.layout_node().is_generated_for_pseudo_element())
+        return {};
+    auto* element = as_if<DOM::Element>(paintable_box.dom_node().ptr());
+    if (!element || !element->has_relevant_animations())
+        return {};
+    auto computed_properties = element->computed_properties();
+    if (!computed_properties)
+        return {};
+
+    auto animations = MUST(element->get_animations_internal(Animations::Animatable::GetAnimationsSorted::No));
+
+    // A property is only handed over if a single animation drives it, since the compositor doesn't composite effects.
+    auto only_animation_of = [&](CSS::PropertyID property_id) -> GC::Ptr<Animations::Animation> {
+        GC::Ptr<Animations::Animation> result;
+        for (auto& animation : animations) {
+            auto* effect = as_if<Animations::KeyframeEffect>(animation->effect().ptr());
+            if (!effect || !effect->target_properties().contains(property_id))
+                continue;
+            if (result || effect->pseudo_element_type().has_value())
+                return {};
+            result = animation;
+        }
+        return result;
+    };
+
+    AsyncAnimationsForBox result;
+    if (auto animation = only_animation_of(CSS::PropertyID::Opacity))
+        result.opacity = make_async_animation(*element, paintable_box, *computed_properties, *animation, CSS::PropertyID::Opacity, now);
+    if (auto animation = only_animation_of(CSS::PropertyID::Transform))
+        result.transform = make_async_animation(*element, paintable_box, *computed_properties, *animation, CSS::PropertyID::Transform, now);
+    return result;
+}
+
+}
+
+namespace IPC {
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Web::Compositor::AsyncTransformFunction const& function)
+{
+    TRY(encoder.encode(function.type));
+    TRY(encoder.encode(function.x));
+    TRY(encoder.encode(function.y));
+    TRY(encoder.encode(function.z));
+    return {};
+}
+
+template<>
+ErrorOr<Web::Compositor::AsyncTransformFunction> decode(Decoder& decoder)
+{
+    return Web::Compositor::AsyncTransformFunction {
+        .type = TRY(decoder.decode<Web::Compositor::AsyncTransformFunction::Type>()),
+        .x = TRY(decoder.decode<float>()),
+        .y = TRY(decoder.decode<float>()),
+        .z = TRY(decoder.decode<float>()),
+    };
+}
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Web::Compositor::AsyncAnimationKeyframe const& keyframe)
+{
+    TRY(encoder.encode(keyframe.offset));
+    TRY(encoder.encode(keyframe.easing));
+    TRY(encoder.encode(keyframe.value));
+    return {};
+}
+
+template<>
+ErrorOr<Web::Compositor::AsyncAnimationKeyframe> decode(Decoder& decoder)
+{
+    return Web::Compositor::AsyncAnimationKeyframe {
+        .offset = TRY(decoder.decode<double>()),
+        .easing = TRY(decoder.decode<Optional<Web::CSS::EasingFunction>>()),
+        .value = TRY(decoder.decode<Web::Compositor::AsyncAnimatedValue>()),
+    };
+}
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Web::Compositor::AsyncAnimationTiming const& timing)
+{
+    TRY(encoder.encode(timing.start_delay));
+    TRY(encoder.encode(timing.end_delay));
+    TRY(encoder.encode(timing.iteration_duration));
+    TRY(encoder.encode(timing.iteration_count));
+    TRY(encoder.encode(timing.iteration_start));
+    TRY(encoder.encode(timing.direction));
+    TRY(encoder.encode(timing.fills_backwards));
+    TRY(encoder.encode(timing.fills_forwards));
+    TRY(encoder.encode(timing.timing_function));
+    TRY(encoder.encode(timing.playback_rate));
+    return {};
+}
+
+template<>
+ErrorOr<Web::Compositor::AsyncAnimationTiming> decode(Decoder& decoder)
+{
+    return Web::Compositor::AsyncAnimationTiming {
+        .start_delay = TRY(decoder.decode<double>()),
+        .end_delay = TRY(decoder.decode<double>()),
+        .iteration_duration = TRY(decoder.decode<double>()),
+        .iteration_count = TRY(decoder.decode<double>()),
+        .iteration_start = TRY(decoder.decode<double>()),
+        .direction = TRY(decoder.decode<Web::Compositor::AsyncAnimationDirection>()),
+        .fills_backwards = TRY(decoder.decode<bool>()),
+        .fills_forwards = TRY(decoder.decode<bool>()),
+        .timing_function = TRY(decoder.decode<Web::CSS::EasingFunction>()),
+        .playback_rate = TRY(decoder.decode<double>()),
+    };
+}
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Web::Compositor::AsyncScrollTimeline const& scroll_timeline)
+{
+    TRY(encoder.encode(scroll_timeline.scroll_frame_index));
+    TRY(encoder.encode(scroll_timeline.is_vertical));
+    TRY(encoder.encode(scroll_timeline.max_scroll_offset));
+    TRY(encoder.encode(scroll_timeline.start_time));
+    return {};
+}
+
+template<>
+ErrorOr<Web::Compositor::AsyncScrollTimeline> decode(Decoder& decoder)
+{
+    auto scroll_timeline = Web::Compositor::AsyncScrollTimeline {
+        .scroll_frame_index = TRY(decoder.decode<Web::Painting::ScrollFrameIndex>()),
+        .is_vertical = TRY(decoder.decode<bool>()),
+        .max_scroll_offset = TRY(decoder.decode<float>()),
+        .start_time = TRY(decoder.decode<double>()),
+    };
+    if (!(scroll_timeline.max_scroll_offset > 0))
+        return Error::from_string_literal("IPC decode: Async scroll timeline needs a scroll range");
+    return scroll_timeline;
+}
+
+template<>
+ErrorOr<void> encode(Encoder& encoder, Web::Compositor::AsyncAnimation const& animation)
+{
+    TRY(encoder.encode(animation.property));
+    TRY(encoder.encode(animation.target_nodes));
+    TRY(encoder.encode(animation.timing));
+    TRY(encoder.encode(animation.keyframes));
+    TRY(encoder.encode(animation.underlying_value));
+    TRY(encoder.encode(animation.transform_prefix));
+    TRY(encoder.encode(animation.device_pixels_per_css_pixel));
+    TRY(encoder.encode(animation.local_time));
+    TRY(encoder.encode(animation.sampled_at_in_nanoseconds));
+    TRY(encoder.encode(animation.scroll_timeline));
+    return {};
+}
+
+template<>
+ErrorOr<Web::Compositor::AsyncAnimation> decode(Decoder& decoder)
+{
+    auto animation = Web::Compositor::AsyncAnimation {
+        .property = TRY(decoder.decode<Web::Compositor::AsyncAnimatedProperty>()),
+        .target_nodes = TRY(decoder.decode<Vector<Web::Painting::VisualContextIndex>>()),
+        .timing = TRY(decoder.decode<Web::Compositor::AsyncAnimationTiming>()),
+        .keyframes = TRY(decoder.decode<Vector<Web::Compositor::AsyncAnimationKeyframe>>()),
+        .underlying_value = TRY(decoder.decode<Web::Compositor::AsyncAnimatedValue>()),
+        .transform_prefix = TRY(decoder.decode<Gfx::FloatMatrix4x4>()),
+        .device_pixels_per_css_pixel = TRY(decoder.decode<float>()),
+        .local_time = TRY(decoder.decode<double>()),
+        .sampled_at_in_nanoseconds = TRY(decoder.decode<i64>()),
+        .scroll_timeline = TRY(decoder.decode<Optional<Web::Compositor::AsyncScrollTimeline>>()),
+    };
+
+    // The compositor indexes into the keyframes and the visual context tree with these, so check them up front.
+    if (animation.keyframes.size() < 2)
+        return Error::from_string_literal("IPC decode: Async animation needs at least two keyframes");
+    auto value_matches_property = [&](Web::Compositor::AsyncAnimatedValue const& value) {
+        return animation.property == Web::Compositor::AsyncAnimatedProperty::Opacity ? value.has<float>() : value.has<Vector<Web::Compositor::AsyncTransformFunction>>();
+    };
+    if (!value_matches_property(animation.underlying_value) || !all_of(animation.keyframes, [&](auto const& keyframe) { return value_matches_property(keyframe.value); }))
+        return Error::from_string_literal("IPC decode: Async animation value doesn't match its property");
+    if (animation.property == Web::Compositor::AsyncAnimatedProperty::Transform) {
+        for (size_t i = 1; i < animation.keyframes.size(); ++i) {
+            auto const& from = animation.keyframes[i - 1].value.get<Vector<Web::Compositor::AsyncTransformFunction>>();
+            auto const& to = animation.keyframes[i].value.get<Vector<Web::Compositor::AsyncTransformFunction>>();
+            if (!Web::Compositor::transform_lists_can_be_interpolated(from, to))
+                return Error::from_string_literal("IPC decode: Async animation transform lists can't be interpolated");
+        }
+    }
+    return animation;
+}
+
+}
@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+#include <AK/Variant.h>
+#include <AK/Vector.h>
+#include <LibGfx/Matrix4x4.h>
+#include <LibIPC/Forward.h>
+#include <LibWeb/CSS/EasingFunction.h>
+#include <LibWeb/Export.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/Painting/AccumulatedVisualContext.h>
+#include <LibWeb/Painting/ScrollState.h>
+
+namespace Web::Compositor {
+
+enum class AsyncAnimatedProperty : u8 {
+    Opacity,
+    Transform,
+};
+
+// One function of an animated transform list, with its arguments resolved against the box it transforms.
+struct AsyncTransformFunction {
+    enum class Type : u8 {
+        Translate,
+        Scale,
+        Rotate,
+    };
+
+    Type type { Type::Translate };
+    // Translate: the offset along each axis, in CSS pixels. Scale: the factor along each axis. Rotate: the angle
+    // around the z axis in radians, in x.
+    float x { 0 };
+    float y { 0 };
+    float z { 0 };
+
+    Gfx::FloatMatrix4x4 to_matrix() const;
+};
+
+using AsyncAnimatedValue = Variant<float, Vector<AsyncTransformFunction>>;
+
+struct AsyncAnimationKeyframe {
+    double offset { 0 };
+    // Applies to the interval from this keyframe to the next. No easing means linear progress.
+    Optional<CSS::EasingFunction> easing;
+    AsyncAnimatedValue value;
+};
+
+enum class AsyncAnimationDirection : u8 {
+    Normal,
+    Reverse,
+    Alternate,
+    AlternateReverse,
+};
+
+// https://drafts.csswg.org/web-animations-1/#timing-model
+// All times are in milliseconds, or for a scroll-driven animation, in percent of the scroll range.
+struct AsyncAnimationTiming {
+    double start_delay { 0 };
+    double end_delay { 0 };
+    double iteration_duration { 0 };
+    double iteration_count { 1 };
+    double iteration_start { 0 };
+    AsyncAnimationDirection direction { AsyncAnimationDirection::Normal };
+    bool fills_backwards { false };
+    bool fills_forwards { false };
+    CSS::EasingFunction timing_function { CSS::EasingFunction::linear() };
+    double playback_rate { 1 };
+};
+
+// https://drafts.csswg.org/scroll-animations-1/#scroll-timelines
+// A scroll-driven animation takes its time from the scroll position of a scroll container instead of from the clock,
+// so that it follows the compositor's own scrolling.
+struct AsyncScrollTimeline {
+    Painting::ScrollFrameIndex scroll_frame_index;
+    bool is_vertical { true };
+    // The scroll offset at 100% progress, in device pixels.
+    float max_scroll_offset { 0 };
+    // The animation's start time, in percent.
+    double start_time { 0 };
+};
+
+// An opacity or transform animation that the compositor samples on every frame by itself, so that it keeps moving
+// while the main thread is busy. The main thread still runs the same animation for computed style and events, and
+// hands over a fresh copy whenever the animation's state changes.
+struct AsyncAnimation {
+    AsyncAnimatedProperty property { AsyncAnimatedProperty::Opacity };
+    // An animated opacity drives the effects node of the box in each of its descendant visual contexts, an animated
+    // transform drives the box's transform node.
+    Vector<Painting::VisualContextIndex> target_nodes;
+    AsyncAnimationTiming timing;
+    Vector<AsyncAnimationKeyframe> keyframes;
+    // The value to use while the animation has no effect, such as during a start delay without backwards fill.
+    AsyncAnimatedValue underlying_value;
+    // The individual translate, rotate and scale properties, which apply before the animated transform.
+    Gfx::FloatMatrix4x4 transform_prefix { Gfx::FloatMatrix4x4::identity() };
+    float device_pixels_per_css_pixel { 1 };
+    // The animation's local time when the main thread handed it over, and the MonotonicTime at which that was.
+    double local_time { 0 };
+    i64 sampled_at_in_nanoseconds { 0 };
+    // Set for a scroll-driven animation, which ignores the two fields above.
+    Optional<AsyncScrollTimeline> scroll_timeline;
+
+    double local_time_at(MonotonicTime, Painting::ScrollStateSnapshot const&) const;
+    bool has_finished_at(double local_time) const;
+    AsyncAnimatedValue value_at(double local_time) const;
+};
+
+// Writes each animation's value at the given time and scroll position into the nodes it drives. Returns whether any of
+// the animations will go on changing with time alone.
+WEB_API bool apply_async_animations(ReadonlySpan<AsyncAnimation>, Painting::AccumulatedVisualContextTree&, Painting::ScrollStateSnapshot const&, MonotonicTime);
+
+// The animations of a box that can be handed to the compositor, still without target nodes. A property is only
+// handed over if it is animated by nothing but a single animation that the compositor knows how to sample.
+struct AsyncAnimationsForBox {
+    Optional<AsyncAnimation> opacity;
+    Optional<AsyncAnimation> transform;
+};
+AsyncAnimationsForBox async_animations_for_box(Painting::PaintableBox&, MonotonicTime now);
+
+}
+
+namespace IPC {
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::Compositor::AsyncTransformFunction const&);
+template<>
+WEB_API ErrorOr<Web::Compositor::AsyncTransformFunction> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::Compositor::AsyncAnimationKeyframe const&);
+template<>
+WEB_API ErrorOr<Web::Compositor::AsyncAnimationKeyframe> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::Compositor::AsyncAnimationTiming const&);
+template<>
+WEB_API ErrorOr<Web::Compositor::AsyncAnimationTiming> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::Compositor::AsyncScrollTimeline const&);
+template<>
+WEB_API ErrorOr<Web::Compositor::AsyncScrollTimeline> decode(Decoder&);
+
+template<>
+WEB_API ErrorOr<void> encode(Encoder&, Web::Compositor::AsyncAnimation const&);
+template<>
+WEB_API ErrorOr<Web::Compositor::AsyncAnimation> decode(Decoder&);
+
+}
@@ -36,6 +36,11 @@ void CompositorContextHandle::update_visual_context_tree(Painting::AccumulatedVi
     m_host.update_visual_context_tree(m_context_id, move(visual_context_tree));
 }
 
+void CompositorContextHandle::update_async_animations(Vector<AsyncAnimation> async_animations)
+{
+    m_host.update_async_animations(m_context_id, move(async_animations));
+}
+
 void CompositorContextHandle::update_video_frame(Painting::VideoFrameResourceId frame_id, NonnullRefPtr<Media::VideoFrame const> frame)
 {
     m_host.update_video_frame(m_context_id, frame_id, move(frame));
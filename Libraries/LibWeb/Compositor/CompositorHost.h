@@ -16,6 +16,7 @@
 #include <LibGfx/SharedImage.h>
 #include <LibGfx/Size.h>
 #include <LibMedia/Forward.h>
+#include <LibWeb/Compositor/AsyncAnimations.h>
 #include <LibWeb/Compositor/Types.h>
 #include <LibWeb/Export.h>
 #include <LibWeb/Forward.h>
@@ -37,6 +38,7 @@ public:
 
     void update_display_list(NonnullRefPtr<Painting::DisplayList>, Painting::AccumulatedVisualContextTree, Painting::DisplayListResourceTransaction&&, Painting::ScrollStateSnapshot&&);
     void update_visual_context_tree(Painting::AccumulatedVisualContextTree);
+    void update_async_animations(Vector<AsyncAnimation>);
     void update_video_frame(Painting::VideoFrameResourceId, NonnullRefPtr<Media::VideoFrame const>);
     void clear_video_frame(Painting::VideoFrameResourceId);
     void update_compositor_surface(Painting::CompositorSurfaceId, Gfx::SharedImage&&);
@@ -74,6 +76,7 @@ public:
 
     virtual void update_display_list(CompositorContextId, NonnullRefPtr<Painting::DisplayList>, Painting::AccumulatedVisualContextTree, Painting::DisplayListResourceTransaction&&, Painting::ScrollStateSnapshot&&) = 0;
     virtual void update_visual_context_tree(CompositorContextId, Painting::AccumulatedVisualContextTree) = 0;
+    virtual void update_async_animations(CompositorContextId, Vector<AsyncAnimation>) = 0;
     virtual void update_video_frame(CompositorContextId, Painting::VideoFrameResourceId, NonnullRefPtr<Media::VideoFrame const>) = 0;
     virtual void clear_video_frame(CompositorContextId, Painting::VideoFrameResourceId) = 0;
     virtual void update_compositor_surface(CompositorContextId, Painting::CompositorSurfaceId, Gfx::SharedImage&&) = 0;
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWeb/Compositor/FramePacer.h>
+
+namespace Web::Compositor {
+
+// Covers the time between the display list leaving WebContent and the compositor picking it up on its vsync.
+static constexpr auto rendering_update_safety_margin = AK::Duration::from_milliseconds(2);
+
+// Once the compositor hasn't presented for this many intervals, its vsync phase no longer says anything about when it
+// will present next.
+static constexpr i64 maximum_vsync_intervals_since_last_present = 4;
+
+static MonotonicTime monotonic_time_from_nanoseconds(i64 nanoseconds)
+{
+    auto now = MonotonicTime::now();
+    return now - AK::Duration::from_nanoseconds(now.nanoseconds() - nanoseconds);
+}
+
+void FramePacer::did_update_the_rendering(MonotonicTime started_at, MonotonicTime finished_at)
+{
+    m_frame_timings.enqueue(FrameTiming {
+        .rendering_update_started_at = started_at,
+        .rendering_update_finished_at = finished_at,
+        .presented_at = {},
+    });
+}
+
+void FramePacer::did_present_frame(i64 vsync_time_in_nanoseconds, double refresh_rate)
+{
+    auto vsync_time = monotonic_time_from_nanoseconds(vsync_time_in_nanoseconds);
+    m_last_vsync_time = vsync_time;
+    if (refresh_rate > 0)
+        m_refresh_rate = refresh_rate;
+
+    // The compositor presents the newest frame it has, so that's the one this vsync showed.
+    for (size_t i = m_frame_timings.size(); i > 0; --i) {
+        auto& frame_timing = m_frame_timings.at(i - 1);
+        if (frame_timing.rendering_update_finished_at > vsync_time)
+            continue;
+        if (!frame_timing.presented_at.has_value())
+            frame_timing.presented_at = vsync_time;
+        break;
+    }
+}
+
+AK::Duration FramePacer::predicted_rendering_update_duration() const
+{
+    // Go by the second longest of the recent updates, so that a single slow one (a garbage collection, say) doesn't
+    // make every following frame start early.
+    AK::Duration longest;
+    AK::Duration second_longest;
+    for (auto const& frame_timing : m_frame_timings) {
+        auto duration = frame_timing.rendering_update_finished_at - frame_timing.rendering_update_started_at;
+        if (duration > longest) {
+            second_longest = longest;
+            longest = duration;
+        } else if (duration > second_longest) {
+            second_longest = duration;
+        }
+    }
+    auto predicted_duration = m_frame_timings.size() > 1 ? second_longest : longest;
+    return predicted_duration + rendering_update_safety_margin;
+}
+
+Optional<MonotonicTime> FramePacer::next_rendering_update_time(MonotonicTime now) const
+{
+    if (!m_last_vsync_time.has_value())
+        return {};
+
+    auto vsync_interval = AK::Duration::from_nanoseconds(static_cast<i64>(1'000'000'000.0 / m_refresh_rate));
+    if (vsync_interval <= AK::Duration::zero())
+        return {};
+
+    auto since_last_vsync = now - *m_last_vsync_time;
+    if (since_last_vsync < AK::Duration::zero() || since_last_vsync.to_nanoseconds() / vsync_interval.to_nanoseconds() >= maximum_vsync_intervals_since_last_present)
+        return {};
+
+    // Aim for the first vsync that an update starting now could still make.
+    auto predicted_duration = predicted_rendering_update_duration();
+    auto intervals_until_vsync = (since_last_vsync + predicted_duration).to_nanoseconds() / vsync_interval.to_nanoseconds() + 1;
+    auto next_vsync = *m_last_vsync_time + AK::Duration::from_nanoseconds(intervals_until_vsync * vsync_interval.to_nanoseconds());
+    return next_vsync - predicted_duration;
+}
+
+Vector<FrameTiming> FramePacer::recent_frame_timings() const
+{
+    Vector<FrameTiming> frame_timings;
+    frame_timings.ensure_capacity(m_frame_timings.size());
+    for (auto const& frame_timing : m_frame_timings)
+        frame_timings.unchecked_append(frame_timing);
+    return frame_timings;
+}
+
+}
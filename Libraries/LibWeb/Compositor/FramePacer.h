@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/CircularQueue.h>
+#include <AK/Optional.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+#include <LibWeb/Export.h>
+
+namespace Web::Compositor {
+
+struct FrameTiming {
+    MonotonicTime rendering_update_started_at;
+    MonotonicTime rendering_update_finished_at;
+    // The vsync at which the compositor presented the frame. Stays empty if a newer frame replaced it first.
+    Optional<MonotonicTime> presented_at;
+};
+
+// Decides when a page should run its next rendering update, so that the display list reaches the compositor just
+// before the vsync that presents it instead of just after the previous one. It predicts how long an update takes from
+// the most recent ones, and learns the vsync phase from the compositor's presents.
+class WEB_API FramePacer {
+public:
+    void did_update_the_rendering(MonotonicTime started_at, MonotonicTime finished_at);
+    void did_present_frame(i64 vsync_time_in_nanoseconds, double refresh_rate);
+
+    // Returns nothing if the compositor hasn't presented recently, in which case the next update should run as soon
+    // as it can. This is the case for an idle page, and for a variable refresh rate display that only refreshes when
+    // a frame arrives, where there's no steady vsync to line up with.
+    Optional<MonotonicTime> next_rendering_update_time(MonotonicTime now) const;
+
+    AK::Duration predicted_rendering_update_duration() const;
+    Vector<FrameTiming> recent_frame_timings() const;
+
+private:
+    static constexpr size_t frame_timing_history_size = 16;
+
+    CircularQueue<FrameTiming, frame_timing_history_size> m_frame_timings;
+    Optional<MonotonicTime> m_last_vsync_time;
+    double m_refresh_rate { 60.0 };
+};
+
+}
@@ -5,9 +5,11 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <LibCompress/Brotli.h>
 #include <LibCompress/Deflate.h>
 #include <LibCompress/Gzip.h>
 #include <LibCompress/Zlib.h>
+#include <LibCompress/Zstd.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibJS/Runtime/Realm.h>
 #include <LibJS/Runtime/TypedArray.h>
@@ -37,6 +39,10 @@ WebIDL::ExceptionOr<GC::Ref<CompressionStream>> CompressionStream::construct_imp
             return TRY(Compress::DeflateCompressor::create(move(input_stream)));
         case Bindings::CompressionFormat::Gzip:
             return TRY(Compress::GzipCompressor::create(move(input_stream)));
+        case Bindings::CompressionFormat::Brotli:
+            return TRY(Compress::BrotliCompressor::create(move(input_stream)));
+        case Bindings::CompressionFormat::Zstd:
+            return TRY(Compress::ZstdCompressor::create(move(input_stream)));
         }
 
         VERIFY_NOT_REACHED();
@@ -14,15 +14,28 @@ use std::ffi::c_void;
 use std::panic::AssertUnwindSafe;
 use std::panic::catch_unwind;
 
+// A compiled engine starts with this magic and version, followed by flags, the length-prefixed adblock engine and the
+// generic selector index. Bump the version whenever that layout changes, including when the adblock crate is updated,
+// so that a compiled engine from another build is rejected rather than misread.
+const COMPILED_ENGINE_MAGIC: &[u8; 4] = b"LBCB";
+const COMPILED_ENGINE_VERSION: u32 = 1;
+const COMPILED_ENGINE_HAS_COSMETIC_RULES: u32 = 1 << 0;
+
 #[repr(C)]
 pub struct ContentBlockerString {
     data: *mut u8,
     length: usize,
 }
 
+#[repr(C)]
+pub struct ContentBlockerBytes {
+    data: *mut u8,
+    length: usize,
+}
+
 struct ContentBlockerEngine {
     engine: adblock::engine::Engine,
-    generic_selector_list_rules: GenericSelectorListRules,
+    generic_selector_index: GenericSelectorIndex,
 }
 
 #[derive(Default)]
@@ -32,6 +45,39 @@ struct GenericSelectorListRules {
     by_id: HashMap<String, Vec<String>>,
 }
 
+// The generic selector lists, kept in a few flat arrays rather than one allocation per selector and key, so that a
+// compiled engine stores them as contiguous blocks and loading it only has to copy those blocks back.
+#[derive(Default)]
+struct GenericSelectorIndex {
+    // The text of every selector and key, back to back.
+    strings: String,
+    selectors: Vec<StringRange>,
+    // Indices into `selectors`.
+    always_needed: Vec<u32>,
+    // Sorted by key, each naming a run of `postings`.
+    by_class: Vec<IndexEntry>,
+    by_id: Vec<IndexEntry>,
+    // Indices into `selectors`.
+    postings: Vec<u32>,
+}
+
+#[derive(Clone, Copy)]
+struct StringRange {
+    start: u32,
+    length: u32,
+}
+
+#[derive(Clone, Copy)]
+struct IndexEntry {
+    key: StringRange,
+    first_posting: u32,
+    posting_count: u32,
+}
+
+struct ByteReader<'a> {
+    bytes: &'a [u8],
+}
+
 enum SelectorKey {
     Class(String),
     Id(String),
@@ -76,6 +122,68 @@ unsafe fn engine_from_raw<'a>(engine: *const c_void) -> Option<&'a ContentBlocke
     Some(unsafe { &*engine.cast::<ContentBlockerEngine>() })
 }
 
+fn bytes_to_ffi(bytes: Vec<u8>) -> ContentBlockerBytes {
+    if bytes.is_empty() {
+        return ContentBlockerBytes {
+            data: std::ptr::null_mut(),
+            length: 0,
+        };
+    }
+
+    let bytes = Box::leak(bytes.into_boxed_slice());
+    let data = bytes.as_mut_ptr();
+    let length = bytes.len();
+
+    ContentBlockerBytes { data, length }
+}
+
+fn to_u32(value: usize) -> u32 {
+    u32::try_from(value).expect("content blocker rules are too large")
+}
+
+fn write_u32(out: &mut Vec<u8>, value: u32) {
+    out.extend_from_slice(&value.to_le_bytes());
+}
+
+fn write_string_range(out: &mut Vec<u8>, range: StringRange) {
+    write_u32(out, range.start);
+    write_u32(out, range.length);
+}
+
+impl<'a> ByteReader<'a> {
+    fn read_bytes(&mut self, length: usize) -> Option<&'a [u8]> {
+        if self.bytes.len() < length {
+            return None;
+        }
+        let (bytes, rest) = self.bytes.split_at(length);
+        self.bytes = rest;
+        Some(bytes)
+    }
+
+    fn read_u32(&mut self) -> Option<u32> {
+        Some(u32::from_le_bytes(self.read_bytes(4)?.try_into().ok()?))
+    }
+
+    fn read_u64(&mut self) -> Option<u64> {
+        Some(u64::from_le_bytes(self.read_bytes(8)?.try_into().ok()?))
+    }
+
+    fn read_string_range(&mut self) -> Option<StringRange> {
+        Some(StringRange {
+            start: self.read_u32()?,
+            length: self.read_u32()?,
+        })
+    }
+
+    fn read_array<T>(&mut self, item_size: usize, mut read_item: impl FnMut(&mut Self) -> Option<T>) -> Option<Vec<T>> {
+        let count = self.read_u32()? as usize;
+        if count > self.bytes.len() / item_size {
+            return None;
+        }
+        (0..count).map(|_| read_item(self)).collect()
+    }
+}
+
 fn string_to_ffi(string: String) -> ContentBlockerString {
     if string.is_empty() {
         return ContentBlockerString {
@@ -235,6 +343,166 @@ impl GenericSelectorListRules {
             self.by_id.entry(id).or_default().push(selector.clone());
         }
     }
+}
+
+impl GenericSelectorIndex {
+    fn from_rules(rules: GenericSelectorListRules) -> Self {
+        let mut index = Self::default();
+        let mut selector_indices = HashMap::new();
+
+        for selector in rules.always_needed {
+            let selector_index = index.add_selector(&mut selector_indices, selector);
+            index.always_needed.push(selector_index);
+        }
+        index.by_class = index.add_keyed_selectors(&mut selector_indices, rules.by_class);
+        index.by_id = index.add_keyed_selectors(&mut selector_indices, rules.by_id);
+
+        index
+    }
+
+    fn add_string(&mut self, string: &str) -> StringRange {
+        let start = to_u32(self.strings.len());
+        self.strings.push_str(string);
+        StringRange {
+            start,
+            length: to_u32(string.len()),
+        }
+    }
+
+    fn add_selector(&mut self, selector_indices: &mut HashMap<String, u32>, selector: String) -> u32 {
+        if let Some(&selector_index) = selector_indices.get(&selector) {
+            return selector_index;
+        }
+
+        let range = self.add_string(&selector);
+        let selector_index = to_u32(self.selectors.len());
+        self.selectors.push(range);
+        selector_indices.insert(selector, selector_index);
+        selector_index
+    }
+
+    fn add_keyed_selectors(
+        &mut self,
+        selector_indices: &mut HashMap<String, u32>,
+        selectors_by_key: HashMap<String, Vec<String>>,
+    ) -> Vec<IndexEntry> {
+        let mut selectors_by_key: Vec<_> = selectors_by_key.into_iter().collect();
+        selectors_by_key.sort_unstable_by(|(a, _), (b, _)| a.cmp(b));
+
+        let mut entries = Vec::with_capacity(selectors_by_key.len());
+        for (key, selectors) in selectors_by_key {
+            let key = self.add_string(&key);
+            let first_posting = to_u32(self.postings.len());
+            for selector in selectors {
+                let selector_index = self.add_selector(selector_indices, selector);
+                self.postings.push(selector_index);
+            }
+            entries.push(IndexEntry {
+                key,
+                first_posting,
+                posting_count: to_u32(self.postings.len()) - first_posting,
+            });
+        }
+        entries
+    }
+
+    fn serialize_into(&self, out: &mut Vec<u8>) {
+        write_u32(out, to_u32(self.strings.len()));
+        out.extend_from_slice(self.strings.as_bytes());
+
+        write_u32(out, to_u32(self.selectors.len()));
+        for &range in &self.selectors {
+            write_string_range(out, range);
+        }
+
+        write_u32(out, to_u32(self.always_needed.len()));
+        for &selector_index in &self.always_needed {
+            write_u32(out, selector_index);
+        }
+
+        for entries in [&self.by_class, &self.by_id] {
+            write_u32(out, to_u32(entries.len()));
+            for entry in entries {
+                write_string_range(out, entry.key);
+                write_u32(out, entry.first_posting);
+                write_u32(out, entry.posting_count);
+            }
+        }
+
+        write_u32(out, to_u32(self.postings.len()));
+        for &selector_index in &self.postings {
+            write_u32(out, selector_index);
+        }
+    }
+
+    fn deserialize(reader: &mut ByteReader) -> Option<Self> {
+        let strings_length = reader.read_u32()? as usize;
+        let strings = std::str::from_utf8(reader.read_bytes(strings_length)?)
+            .ok()?
+            .to_string();
+        let selectors = reader.read_array(8, ByteReader::read_string_range)?;
+        let always_needed = reader.read_array(4, ByteReader::read_u32)?;
+        let read_entry = |reader: &mut ByteReader| {
+            Some(IndexEntry {
+                key: reader.read_string_range()?,
+                first_posting: reader.read_u32()?,
+                posting_count: reader.read_u32()?,
+            })
+        };
+        let by_class = reader.read_array(16, read_entry)?;
+        let by_id = reader.read_array(16, read_entry)?;
+        let postings = reader.read_array(4, ByteReader::read_u32)?;
+
+        let index = Self {
+            strings,
+            selectors,
+            always_needed,
+            by_class,
+            by_id,
+            postings,
+        };
+        index.is_valid().then_some(index)
+    }
+
+    // Checks every range and index once, so that lookups can slice without failing.
+    fn is_valid(&self) -> bool {
+        let is_valid_string = |range: &StringRange| {
+            let start = range.start as usize;
+            self.strings.get(start..start + range.length as usize).is_some()
+        };
+        let is_valid_selector_index = |selector_index: &u32| (*selector_index as usize) < self.selectors.len();
+        let is_valid_entry = |entry: &IndexEntry| {
+            let first_posting = entry.first_posting as usize;
+            is_valid_string(&entry.key) && first_posting + entry.posting_count as usize <= self.postings.len()
+        };
+
+        self.selectors.iter().all(is_valid_string)
+            && self.always_needed.iter().all(is_valid_selector_index)
+            && self.by_class.iter().all(is_valid_entry)
+            && self.by_id.iter().all(is_valid_entry)
+            && self.postings.iter().all(is_valid_selector_index)
+    }
+
+    fn string(&self, range: StringRange) -> &str {
+        let start = range.start as usize;
+        &self.strings[start..start + range.length as usize]
+    }
+
+    fn selector(&self, selector_index: u32) -> &str {
+        self.string(self.selectors[selector_index as usize])
+    }
+
+    fn selectors_for_key<'a>(&'a self, entries: &[IndexEntry], key: &str) -> impl Iterator<Item = &'a str> {
+        let postings = match entries.binary_search_by(|entry| self.string(entry.key).cmp(key)) {
+            Ok(entry_index) => {
+                let entry = entries[entry_index];
+                let first_posting = entry.first_posting as usize;
+                &self.postings[first_posting..first_posting + entry.posting_count as usize]
+            }
+            Err(_) => &[],
+        };
+        postings.iter().map(|&selector_index| self.selector(selector_index))
+    }
 
     fn hidden_selectors(
         &self,
@@ -245,30 +513,25 @@ impl GenericSelectorListRules {
         let mut selectors: Vec<_> = self
             .always_needed
             .iter()
+            .map(|&selector_index| self.selector(selector_index))
             .filter(|selector| !exceptions.contains(*selector))
-            .cloned()
+            .map(str::to_string)
             .collect();
 
         for class in classes {
-            if let Some(class_selectors) = self.by_class.get(class.as_ref()) {
-                selectors.extend(
-                    class_selectors
-                        .iter()
-                        .filter(|selector| !exceptions.contains(*selector))
-                        .cloned(),
-                );
-            }
+            selectors.extend(
+                self.selectors_for_key(&self.by_class, class.as_ref())
+                    .filter(|selector| !exceptions.contains(*selector))
+                    .map(str::to_string),
+            );
         }
 
         for id in ids {
-            if let Some(id_selectors) = self.by_id.get(id.as_ref()) {
-                selectors.extend(
-                    id_selectors
-                        .iter()
-                        .filter(|selector| !exceptions.contains(*selector))
-                        .cloned(),
-                );
-            }
+            selectors.extend(
+                self.selectors_for_key(&self.by_id, id.as_ref())
+                    .filter(|selector| !exceptions.contains(*selector))
+                    .map(str::to_string),
+            );
         }
 
         selectors
@@ -281,16 +544,18 @@ impl GenericSelectorListRules {
         exceptions: &HashSet<String>,
     ) -> bool {
         for class in classes {
-            if let Some(class_selectors) = self.by_class.get(class.as_ref())
-                && class_selectors.iter().any(|selector| !exceptions.contains(selector))
+            if self
+                .selectors_for_key(&self.by_class, class.as_ref())
+                .any(|selector| !exceptions.contains(selector))
             {
                 return true;
             }
         }
 
         for id in ids {
-            if let Some(id_selectors) = self.by_id.get(id.as_ref())
-                && id_selectors.iter().any(|selector| !exceptions.contains(selector))
+            if self
+                .selectors_for_key(&self.by_id, id.as_ref())
+                .any(|selector| !exceptions.contains(selector))
             {
                 return true;
             }
@@ -300,6 +565,61 @@ impl GenericSelectorListRules {
     }
 }
 
+impl ContentBlockerEngine {
+    fn from_rules(rules: &str) -> Self {
+        let engine = adblock::engine::Engine::from_rules(rules.lines(), adblock::lists::ParseOptions::default());
+        let generic_selector_index = GenericSelectorIndex::from_rules(GenericSelectorListRules::from_rules(rules));
+        Self {
+            engine,
+            generic_selector_index,
+        }
+    }
+
+    fn compile(&self, has_cosmetic_rules: bool) -> Vec<u8> {
+        let engine = self.engine.serialize();
+        let flags = if has_cosmetic_rules {
+            COMPILED_ENGINE_HAS_COSMETIC_RULES
+        } else {
+            0
+        };
+
+        let mut compiled = Vec::with_capacity(engine.len() + self.generic_selector_index.strings.len() + 64);
+        compiled.extend_from_slice(COMPILED_ENGINE_MAGIC);
+        write_u32(&mut compiled, COMPILED_ENGINE_VERSION);
+        write_u32(&mut compiled, flags);
+        compiled.extend_from_slice(&(engine.len() as u64).to_le_bytes());
+        compiled.extend_from_slice(&engine);
+        self.generic_selector_index.serialize_into(&mut compiled);
+        compiled
+    }
+
+    fn from_compiled(compiled: &[u8]) -> Option<(Self, bool)> {
+        let mut reader = ByteReader { bytes: compiled };
+        if reader.read_bytes(COMPILED_ENGINE_MAGIC.len())? != COMPILED_ENGINE_MAGIC {
+            return None;
+        }
+        if reader.read_u32()? != COMPILED_ENGINE_VERSION {
+            return None;
+        }
+        let flags = reader.read_u32()?;
+
+        let engine_length = usize::try_from(reader.read_u64()?).ok()?;
+        let mut engine = adblock::engine::Engine::default();
+        engine.deserialize(reader.read_bytes(engine_length)?).ok()?;
+
+        let generic_selector_index = GenericSelectorIndex::deserialize(&mut reader)?;
+        if !reader.bytes.is_empty() {
+            return None;
+        }
+
+        let engine = Self {
+            engine,
+            generic_selector_index,
+        };
+        Some((engine, flags & COMPILED_ENGINE_HAS_COSMETIC_RULES != 0))
+    }
+}
+
 fn cosmetic_css_for_url(engine: &ContentBlockerEngine, url: &str, classes: &[&str], ids: &[&str]) -> String {
     let resources = engine.engine.url_cosmetic_resources(url);
     let mut selectors = resources.hide_selectors;
@@ -310,7 +630,7 @@ fn cosmetic_css_for_url(engine: &ContentBlockerEngine, url: &str, classes: &[&st
             ids.iter().copied(),
             &resources.exceptions,
         ));
-        selectors.extend(engine.generic_selector_list_rules.hidden_selectors(
+        selectors.extend(engine.generic_selector_index.hidden_selectors(
             classes.iter().copied(),
             ids.iter().copied(),
             &resources.exceptions,
@@ -363,7 +683,7 @@ fn has_generic_cosmetic_selectors_for_url(
         .engine
         .hidden_class_id_selectors(classes.iter().copied(), ids.iter().copied(), &resources.exceptions)
         .is_empty()
-        || engine.generic_selector_list_rules.has_hidden_selectors_for_class_or_id(
+        || engine.generic_selector_index.has_hidden_selectors_for_class_or_id(
             classes.iter().copied(),
             ids.iter().copied(),
             &resources.exceptions,
@@ -380,12 +700,60 @@ pub unsafe extern "C" fn rust_content_blocker_create(rules: *const u8, rules_len
             return std::ptr::null_mut();
         };
 
-        let engine = adblock::engine::Engine::from_rules(rules.lines(), adblock::lists::ParseOptions::default());
-        let generic_selector_list_rules = GenericSelectorListRules::from_rules(rules);
-        let engine = ContentBlockerEngine {
-            engine,
-            generic_selector_list_rules,
+        let engine = ContentBlockerEngine::from_rules(rules);
+        Box::into_raw(Box::new(engine)).cast()
+    })
+}
+
+/// # Safety
+/// - `rules` and `rules_len` must point to a valid UTF-8 string
+/// - The returned bytes must be freed with `rust_content_blocker_free_bytes`
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rust_content_blocker_compile(
+    rules: *const u8,
+    rules_len: usize,
+    has_cosmetic_rules: bool,
+) -> ContentBlockerBytes {
+    abort_on_panic(|| {
+        let Some(rules) = (unsafe { string_from_raw(rules, rules_len) }) else {
+            return bytes_to_ffi(Vec::new());
+        };
+
+        bytes_to_ffi(ContentBlockerEngine::from_rules(rules).compile(has_cosmetic_rules))
+    })
+}
+
+/// # Safety
+/// - `bytes` and `bytes_len` must point to a valid byte buffer
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rust_content_blocker_is_compiled(bytes: *const u8, bytes_len: usize) -> bool {
+    abort_on_panic(|| {
+        let Some(bytes) = (unsafe { bytes_from_raw(bytes, bytes_len) }) else {
+            return false;
         };
+        bytes.starts_with(COMPILED_ENGINE_MAGIC)
+    })
+}
+
+/// # Safety
+/// - `compiled` and `compiled_len` must point to a valid byte buffer
+/// - `has_cosmetic_rules` must point to a writable bool
+/// - The returned pointer must be freed with `rust_content_blocker_free`
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rust_content_blocker_create_from_compiled(
+    compiled: *const u8,
+    compiled_len: usize,
+    has_cosmetic_rules: *mut bool,
+) -> *mut c_void {
+    abort_on_panic(|| {
+        let Some(compiled) = (unsafe { bytes_from_raw(compiled, compiled_len) }) else {
+            return std::ptr::null_mut();
+        };
+        let Some((engine, engine_has_cosmetic_rules)) = ContentBlockerEngine::from_compiled(compiled) else {
+            return std::ptr::null_mut();
+        };
+
+        unsafe { *has_cosmetic_rules = engine_has_cosmetic_rules };
         Box::into_raw(Box::new(engine)).cast()
     })
 }
@@ -513,3 +881,14 @@ pub unsafe extern "C" fn rust_content_blocker_free_string(data: *mut u8, length:
         }
     });
 }
+
+/// # Safety
+/// - `data` and `length` must match bytes returned by `rust_content_blocker_compile`
+#[unsafe(no_mangle)]
+pub unsafe extern "C" fn rust_content_blocker_free_bytes(data: *mut u8, length: usize) {
+    abort_on_panic(|| {
+        if !data.is_null() {
+            drop(unsafe { Box::from_raw(std::ptr::slice_from_raw_parts_mut(data, length)) });
+        }
+    });
+}
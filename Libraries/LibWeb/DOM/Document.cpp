@@ -10,6 +10,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AllOf.h>
 #include <AK/Bitmap.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Debug.h>
@@ -22,6 +23,7 @@
 #include <AK/Time.h>
 #include <AK/Utf8View.h>
 #include <LibCore/Timer.h>
+#include <LibCore/TraceEvent.h>
 #include <LibGC/RootVector.h>
 #include <LibGC/Timer.h>
 #include <LibHTTP/Cookie/Cookie.h>
@@ -235,12 +237,13 @@ static Optional<u64> s_style_invalidation_counter_dump_interval;
 static void dump_style_invalidation_counters(Document const& document)
 {
     auto const& counters = document.style_invalidation_counters();
-    dbgln("Style invalidation counters for {}: styleInvalidations={}, fullStyleInvalidations={}, elementStyleRecomputations={}, elementStyleNoopRecomputations={}, elementInheritedStyleRecomputations={}, elementInheritedStyleNoopRecomputations={}, previousSiblingInvalidationWalkVisits={}, hasAncestorWalkInvocations={}, hasAncestorWalkVisits={}, hasAncestorSiblingElementChecks={}, hasInvalidationMetadataCandidates={}, hasMatchInvocations={}, hasResultCacheHits={}, hasResultCacheMisses={}",
+    dbgln("Style invalidation counters for {}: styleInvalidations={}, fullStyleInvalidations={}, elementStyleRecomputations={}, elementStyleNoopRecomputations={}, sharedElementStyles={}, elementInheritedStyleRecomputations={}, elementInheritedStyleNoopRecomputations={}, previousSiblingInvalidationWalkVisits={}, hasAncestorWalkInvocations={}, hasAncestorWalkVisits={}, hasAncestorSiblingElementChecks={}, hasInvalidationMetadataCandidates={}, hasMatchInvocations={}, hasResultCacheHits={}, hasResultCacheMisses={}",
         document.url_string(),
         counters.style_invalidations,
         counters.full_style_invalidations,
         counters.element_style_recomputations,
         counters.element_style_noop_recomputations,
+        counters.shared_element_styles,
         counters.element_inherited_style_recomputations,
         counters.element_inherited_style_noop_recomputations,
         counters.previous_sibling_invalidation_walk_visits,
@@ -712,6 +715,7 @@ void Document::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_first_base_element_with_target_in_tree_order);
     visitor.visit(m_parser);
     visitor.visit(m_lazy_load_intersection_observer);
+    visitor.visit(m_visibility_in_viewport_intersection_observer);
     visitor.visit(m_visual_viewport);
     visitor.visit(m_default_timeline);
     visitor.visit(m_scripts_to_execute_when_parsing_has_finished);
@@ -777,6 +781,13 @@ void Document::visit_edges(Cell::Visitor& visitor)
     visitor.visit(m_style_invalidator);
     visitor.visit(m_deferred_parser_start);
     visitor.visit(m_custom_element_registry);
+
+    if (m_element_index) {
+        for (auto const& it : m_element_index->elements_by_class_name)
+            visitor.visit(it.value);
+        for (auto const& it : m_element_index->elements_by_lowercase_local_name)
+            visitor.visit(it.value);
+    }
 }
 
 String const& Document::content_blocker_style_sheet()
@@ -1606,8 +1617,31 @@ Optional<URL::URL> Document::encoding_parse_url(StringView url) const
     // 4. Let baseURL be environment's base URL, if environment is a Document object; otherwise environment's API base URL.
     auto base_url = this->base_url();
 
+    // OPTIMIZATION: Pages resolve the same stylesheet, image and link URLs against the same base URL over and over, so
+    //               we remember the results until either the base URL or the encoding changes.
+    static constexpr size_t max_cached_url_length = 2048;
+    static constexpr size_t max_cached_url_count = 1024;
+    if (url.length() > max_cached_url_length)
+        return DOMURL::parse(url, base_url, encoding);
+
+    if (!m_url_parse_cache.has_value() || m_url_parse_cache->base_url != base_url || m_url_parse_cache->encoding != encoding)
+        m_url_parse_cache = URLParseCache { .base_url = base_url, .encoding = encoding, .results = {} };
+
+    if (auto cached_result = m_url_parse_cache->results.get(url); cached_result.has_value())
+        return cached_result.release_value();
+
     // 5. Return the result of applying the URL parser to url, with baseURL and encoding.
-    return DOMURL::parse(url, base_url, encoding);
+    auto result = DOMURL::parse(url, base_url, encoding);
+
+    // NB: Blob URLs carry the blob URL entry they resolved to at parse time, which changes as blob URLs are revoked.
+    if (result.has_value() && result->scheme() == "blob"sv)
+        return result;
+
+    if (m_url_parse_cache->results.size() >= max_cached_url_count)
+        m_url_parse_cache->results.clear();
+    if (auto key = String::from_utf8(url); !key.is_error())
+        m_url_parse_cache->results.set(key.release_value(), result);
+    return result;
 }
 
 // https://html.spec.whatwg.org/multipage/urls-and-fetching.html#encoding-parsing-and-serializing-a-url
@@ -1636,6 +1670,11 @@ void Document::mark_svg_root_as_needing_relayout(Layout::SVGSVGBox& svg_root)
     m_svg_roots_needing_relayout.set(svg_root.make_weak_ptr<Layout::SVGSVGBox>());
 }
 
+void Document::mark_relayout_boundary_as_needing_relayout(Layout::Box& boundary)
+{
+    m_relayout_boundaries_needing_relayout.set(boundary.make_weak_ptr<Layout::Box>());
+}
+
 void Document::set_needs_container_query_evaluation_after_layout(Element const& query_container)
 {
     m_query_containers_needing_container_query_evaluation_after_layout.set(const_cast<Element&>(query_container));
@@ -1680,6 +1719,50 @@ static void relayout_svg_root(Layout::SVGSVGBox& svg_root)
     });
 }
 
+static bool can_relayout_boundary_in_isolation(Layout::Box const& boundary)
+{
+    if (!boundary.paintable_box() || !boundary.root().paintable_box() || !boundary.is_relayout_boundary())
+        return false;
+
+    // Positioned descendants are laid out by their containing block's formatting context, so all of them have to be
+    // contained by the boundary.
+    bool has_escaping_descendant = false;
+    boundary.for_each_in_subtree_of_type<Layout::Box>([&](Layout::Box const& box) {
+        if (!box.is_absolutely_positioned())
+            return TraversalDecision::Continue;
+        auto const* containing_block = box.containing_block();
+        if (!containing_block || !boundary.is_inclusive_ancestor_of(*containing_block)) {
+            has_escaping_descendant = true;
+            return TraversalDecision::Break;
+        }
+        return TraversalDecision::Continue;
+    });
+    return !has_escaping_descendant;
+}
+
+static void relayout_boundary(Layout::Box& boundary)
+{
+    Layout::LayoutState layout_state(boundary);
+    layout_state.populate_from_paintable(boundary, *boundary.paintable_box());
+
+    auto& viewport = boundary.root();
+    layout_state.populate_from_paintable(viewport, *viewport.paintable_box());
+
+    auto const& boundary_state = layout_state.get(boundary);
+    auto content_width = boundary_state.content_width();
+    auto content_height = boundary_state.content_height();
+
+    Layout::BlockFormattingContext context(layout_state, Layout::LayoutMode::Normal, as<Layout::BlockContainer>(boundary), nullptr);
+    context.run(Layout::AvailableSpace(Layout::AvailableSize::make_definite(content_width), Layout::AvailableSize::make_definite(content_height)));
+    context.parent_context_did_dimension_child_root_box();
+    layout_state.commit(boundary);
+
+    boundary.for_each_in_inclusive_subtree([](auto& node) {
+        node.reset_needs_layout_update();
+        return TraversalDecision::Continue;
+    });
+}
+
 static void propagate_scrollbar_width_to_viewport(Element& root_element, Layout::Viewport& viewport)
 {
     // https://drafts.csswg.org/css-scrollbars/#scrollbar-width
@@ -1777,6 +1860,23 @@ void Document::update_layout(UpdateLayoutReason reason)
             || child_needs_style_update();
     };
 
+    auto mark_elements_depending_on_query_containers_for_style_update = [&] {
+        if (m_query_containers_needing_container_query_evaluation_after_layout.is_empty())
+            return;
+        auto query_containers = move(m_query_containers_needing_container_query_evaluation_after_layout);
+        for (auto& query_container : query_containers) {
+            if (!query_container->is_connected())
+                continue;
+
+            query_container->for_each_shadow_including_descendant([](Node& node) {
+                if (auto* element = as_if<Element>(node); element && element->style_depends_on_size_container_query())
+                    element->set_needs_style_update(true);
+
+                return TraversalDecision::Continue;
+            });
+        }
+    };
+
     constexpr size_t max_container_query_layout_passes = 8;
     for (size_t layout_pass = 0; layout_pass < max_container_query_layout_passes; ++layout_pass) {
         update_style();
@@ -1789,26 +1889,49 @@ void Document::update_layout(UpdateLayoutReason reason)
             return;
 
         auto svg_roots_to_relayout = move(m_svg_roots_needing_relayout);
+        auto relayout_boundaries_to_relayout = move(m_relayout_boundaries_needing_relayout);
 
         // NOTE: If this is a document hosting <template> contents, layout is unnecessary.
         if (m_created_for_appropriate_template_contents)
             return;
 
+        Core::TraceEventScope trace_event { "rendering"sv, "Update layout"sv };
         auto const needs_layout_tree_rebuild = !m_layout_root || needs_layout_tree_update() || child_needs_layout_tree_update() || needs_full_layout_tree_update();
 
-        // Partial SVG relayout
-        if (!needs_layout_tree_rebuild && !svg_roots_to_relayout.is_empty() && !m_layout_root->needs_layout_update()) {
+        auto can_relayout_partially = !needs_layout_tree_rebuild
+            && !m_layout_root->needs_layout_update()
+            && (!svg_roots_to_relayout.is_empty() || !relayout_boundaries_to_relayout.is_empty())
+            && all_of(relayout_boundaries_to_relayout, [](auto const& boundary) { return !boundary || can_relayout_boundary_in_isolation(*boundary); });
+
+        // Partial SVG and relayout boundary relayout
+        if (can_relayout_partially) {
             for (auto const& svg_root : svg_roots_to_relayout) {
                 if (svg_root)
                     relayout_svg_root(*svg_root);
             }
 
+            // A boundary may already have been laid out again as part of an enclosing boundary.
+            for (auto const& boundary : relayout_boundaries_to_relayout) {
+                if (boundary && boundary->needs_layout_update())
+                    relayout_boundary(*boundary);
+            }
+
             invalidate_stacking_context_tree();
             set_needs_to_record_display_list();
 
+            if (!relayout_boundaries_to_relayout.is_empty()) {
+                inform_all_viewport_clients_about_the_current_viewport_rect();
+                // NB: Called during layout update.
+                unsafe_paintable()->assign_scroll_frames();
+            }
+
             set_needs_accumulated_visual_contexts_update(true);
             update_paint_and_hit_testing_properties_if_needed();
             m_document->set_needs_repaint();
+
+            mark_elements_depending_on_query_containers_for_style_update();
+            if (needs_style_update_after_layout())
+                continue;
             return;
         }
 
@@ -1945,20 +2068,7 @@ void Document::update_layout(UpdateLayoutReason reason)
             dbgln("LAYOUT {} {} µs", to_string(reason), timer.elapsed_time().to_microseconds());
         }
 
-        if (!m_query_containers_needing_container_query_evaluation_after_layout.is_empty()) {
-            auto query_containers = move(m_query_containers_needing_container_query_evaluation_after_layout);
-            for (auto& query_container : query_containers) {
-                if (!query_container->is_connected())
-                    continue;
-
-                query_container->for_each_shadow_including_descendant([](Node& node) {
-                    if (auto* element = as_if<Element>(node); element && element->style_depends_on_size_container_query())
-                        element->set_needs_style_update(true);
-
-                    return TraversalDecision::Continue;
-                });
-            }
-        }
+        mark_elements_depending_on_query_containers_for_style_update();
 
         if (needs_style_update_after_layout())
             continue;
@@ -1998,7 +2108,8 @@ bool Document::layout_is_up_to_date() const
         && !needs_layout_tree_update()
         && !child_needs_layout_tree_update()
         && !needs_full_layout_tree_update()
-        && m_svg_roots_needing_relayout.is_empty();
+        && m_svg_roots_needing_relayout.is_empty()
+        && m_relayout_boundaries_needing_relayout.is_empty();
 }
 
 static void apply_element_style_invalidation_after_style_change(Element& element, CSS::RequiredInvalidationAfterStyleChange const& invalidation, bool invalidate_assigned_slottables, bool invalidate_descendant_slots)
@@ -2198,6 +2309,7 @@ void Document::update_style()
     if (!m_style_invalidator->has_pending_invalidations() && !needs_full_style_update() && !needs_style_update() && !child_needs_style_update())
         return;
 
+    Core::TraceEventScope trace_event { "rendering"sv, "Update style"sv };
     m_style_invalidator->invalidate(*this);
 
     build_registered_properties_cache();
@@ -2208,7 +2320,9 @@ void Document::update_style()
         style_computer().reset_has_result_cache();
         style_computer().reset_ancestor_filter();
 
+        style_computer().set_style_sharing_enabled(true);
         invalidation |= update_style_recursively(*this, style_computer(), false, false, false, false);
+        style_computer().set_style_sharing_enabled(false);
         m_needs_full_style_update = false;
 
         if (!m_style_invalidator->has_pending_invalidations() && !needs_style_update() && !child_needs_style_update())
@@ -6172,10 +6286,20 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
         bool is_implicit_root = observer->is_implicit_root();
         bool root_is_element = intersection_root_node->is_element();
 
+        // OPTIMIZATION: If nothing in this document was laid out, scrolled, transformed or repainted since a target was
+        //               last computed, its previous threshold index and isIntersecting still hold and no entry would be
+        //               queued, so it is skipped. Targets and roots in other documents depend on geometry that isn't
+        //               tracked here, so those are always computed.
+        bool root_is_in_this_document = &intersection_root_node->document() == this;
+
         // 2. For each target in observer’s internal [[ObservationTargets]] slot, processed in the same order that
         //    observe() was called on each target:
         for (auto& observed_target : observer->observation_targets()) {
             auto& target = observed_target.target;
+            bool geometry_is_tracked_by_this_document = root_is_in_this_document && &target->document() == this;
+            if (geometry_is_tracked_by_this_document && observed_target.geometry_generation == m_intersection_observation_geometry_generation)
+                continue;
+
             // 1. Let:
             // thresholdIndex be 0.
             size_t threshold_index = 0;
@@ -6271,6 +6395,9 @@ void Document::run_the_update_intersection_observations_steps(HighResolutionTime
 
             // 16. Assign isIntersecting to intersectionObserverRegistration’s previousIsIntersecting property.
             intersection_observer_registration.previous_is_intersecting = is_intersecting;
+
+            if (geometry_is_tracked_by_this_document)
+                intersection_observer_registration.geometry_generation = m_intersection_observation_geometry_generation;
         }
     }
 }
@@ -6354,6 +6481,40 @@ void Document::stop_intersection_observing_a_lazy_loading_element(Element& eleme
     m_lazy_load_intersection_observer->unobserve(element);
 }
 
+void Document::start_observing_visibility_in_viewport(HTML::HTMLImageElement& element)
+{
+    VERIFY(&element.document() == this);
+
+    if (!m_visibility_in_viewport_intersection_observer) {
+        auto& realm = this->realm();
+        auto callback = JS::NativeFunction::create(realm, Utf16FlyString {}, [](JS::VM& vm) -> JS::ThrowCompletionOr<JS::Value> {
+            auto& entries = as<JS::Array>(vm.argument(0).as_object());
+            auto entries_length = MUST(MUST(entries.get(vm.names.length)).to_length(vm));
+
+            for (size_t i = 0; i < entries_length; ++i) {
+                auto property_key = JS::PropertyKey { i };
+                auto& entry = as<IntersectionObserver::IntersectionObserverEntry>(entries.get_without_side_effects(property_key).as_object());
+                if (auto* image_element = as_if<HTML::HTMLImageElement>(*entry.target()))
+                    image_element->set_visible_in_viewport(entry.is_intersecting());
+            }
+
+            return JS::js_undefined();
+        });
+
+        auto options = Bindings::IntersectionObserverInit {};
+        auto wrapped_callback = realm.heap().allocate<WebIDL::CallbackType>(callback, realm);
+        m_visibility_in_viewport_intersection_observer = IntersectionObserver::IntersectionObserver::construct_impl(realm, wrapped_callback, options).release_value_but_fixme_should_propagate_errors();
+    }
+
+    m_visibility_in_viewport_intersection_observer->observe(element);
+}
+
+void Document::stop_observing_visibility_in_viewport(HTML::HTMLImageElement& element)
+{
+    if (m_visibility_in_viewport_intersection_observer)
+        m_visibility_in_viewport_intersection_observer->unobserve(element);
+}
+
 // https://html.spec.whatwg.org/multipage/semantics.html#shared-declarative-refresh-steps
 void Document::shared_declarative_refresh_steps(StringView input, GC::Ptr<HTML::HTMLMetaElement const> meta_element)
 {
@@ -7887,6 +8048,9 @@ GC::Ptr<HTML::HTMLElement> Document::topmost_auto_or_hint_popover()
 
 void Document::set_needs_to_refresh_scroll_state(bool b)
 {
+    if (b)
+        ++m_intersection_observation_geometry_generation;
+
     // NB: Propagating scroll state invalidation.
     if (auto paintable = this->unsafe_paintable())
         paintable->set_needs_to_refresh_scroll_state(b);
@@ -8493,6 +8657,8 @@ void Document::set_navigable(GC::Ptr<HTML::Navigable> navigable)
 
 void Document::set_needs_repaint(InvalidateDisplayList should_invalidate_display_list)
 {
+    ++m_intersection_observation_geometry_generation;
+
     auto navigable = this->navigable();
 
     if (should_invalidate_display_list == InvalidateDisplayList::Yes) {
@@ -8516,6 +8682,7 @@ void Document::set_needs_repaint(InvalidateDisplayList should_invalidate_display
 
 void Document::set_needs_to_record_display_list()
 {
+    ++m_intersection_observation_geometry_generation;
     m_hit_test_display_list = nullptr;
     if (auto navigable = this->navigable())
         navigable->set_needs_to_record_display_list();
@@ -9044,6 +9211,54 @@ ElementByIdMap& Document::element_by_id() const
     return *m_element_by_id;
 }
 
+Document::ElementIndex const* Document::ensure_element_index()
+{
+    if (m_element_index)
+        return m_element_index.ptr();
+
+    // NB: Building the index costs about as much as one query that doesn't use it. Pages that change the tree between
+    //     every query would pay that for nothing, so we only build it for the second query against an unchanged tree.
+    if (m_dom_tree_version_of_last_unindexed_query != m_dom_tree_version) {
+        m_dom_tree_version_of_last_unindexed_query = m_dom_tree_version;
+        return nullptr;
+    }
+
+    auto index = make<ElementIndex>();
+    for_each_in_subtree_of_type<Element>([&](Element& element) {
+        index->elements_by_lowercase_local_name.ensure(element.local_name().to_ascii_lowercase()).append(element);
+
+        for (auto const& class_name : element.class_names()) {
+            auto& elements = index->elements_by_class_name.ensure(class_name);
+            if (elements.is_empty() || elements.last().ptr() != &element)
+                elements.append(element);
+        }
+        return TraversalDecision::Continue;
+    });
+
+    m_element_index = move(index);
+    return m_element_index.ptr();
+}
+
+Optional<ReadonlySpan<GC::Ref<Element>>> Document::indexed_elements_with_class_name(FlyString const& class_name)
+{
+    auto const* index = ensure_element_index();
+    if (!index)
+        return {};
+    if (auto it = index->elements_by_class_name.find(class_name); it != index->elements_by_class_name.end())
+        return it->value.span();
+    return ReadonlySpan<GC::Ref<Element>> {};
+}
+
+Optional<ReadonlySpan<GC::Ref<Element>>> Document::indexed_elements_with_lowercase_local_name(FlyString const& local_name)
+{
+    auto const* index = ensure_element_index();
+    if (!index)
+        return {};
+    if (auto it = index->elements_by_lowercase_local_name.find(local_name); it != index->elements_by_lowercase_local_name.end())
+        return it->value.span();
+    return ReadonlySpan<GC::Ref<Element>> {};
+}
+
 String Document::dump_display_list()
 {
     update_layout(UpdateLayoutReason::DumpDisplayList);
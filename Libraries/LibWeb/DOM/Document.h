@@ -232,7 +232,11 @@ public:
     // AD-HOC: This number increments whenever a node is added or removed from the document, or an element attribute changes.
     //         It can be used as a crude invalidation mechanism for caches that depend on the DOM structure.
     u64 dom_tree_version() const { return m_dom_tree_version; }
-    void bump_dom_tree_version() { ++m_dom_tree_version; }
+    void bump_dom_tree_version()
+    {
+        ++m_dom_tree_version;
+        m_element_index = nullptr;
+    }
 
     // AD-HOC: This number increments whenever CharacterData is modified in the document. It is used together with
     //         dom_tree_version() to understand whether either the DOM tree structure or contents were changed.
@@ -675,6 +679,7 @@ public:
     void set_needs_full_layout_tree_update(bool b) { m_needs_full_layout_tree_update = b; }
 
     void mark_svg_root_as_needing_relayout(Layout::SVGSVGBox&);
+    void mark_relayout_boundary_as_needing_relayout(Layout::Box&);
 
     void set_needs_to_refresh_scroll_state(bool b);
 
@@ -804,6 +809,10 @@ public:
     void start_intersection_observing_a_lazy_loading_element(Element&);
     void stop_intersection_observing_a_lazy_loading_element(Element&);
 
+    // Tells an animated <img> whenever it scrolls into or out of the viewport, so it can stop decoding frames nobody sees.
+    void start_observing_visibility_in_viewport(HTML::HTMLImageElement&);
+    void stop_observing_visibility_in_viewport(HTML::HTMLImageElement&);
+
     void shared_declarative_refresh_steps(StringView input, GC::Ptr<HTML::HTMLMetaElement const> meta_element = nullptr);
 
     struct TopOfTheDocument { };
@@ -898,6 +907,7 @@ public:
         u64 style_invalidations { 0 };
         u64 element_style_recomputations { 0 };
         u64 element_style_noop_recomputations { 0 };
+        u64 shared_element_styles { 0 };
         u64 element_inherited_style_recomputations { 0 };
         u64 element_inherited_style_noop_recomputations { 0 };
         u64 previous_sibling_invalidation_walk_visits { 0 };
@@ -909,7 +919,12 @@ public:
     void record_full_style_invalidation() const;
     static void set_style_invalidation_counter_dump_interval(Optional<u64>);
 
-    void set_needs_accumulated_visual_contexts_update(bool value) { m_needs_accumulated_visual_contexts_update = value; }
+    void set_needs_accumulated_visual_contexts_update(bool value)
+    {
+        m_needs_accumulated_visual_contexts_update = value;
+        if (value)
+            ++m_intersection_observation_geometry_generation;
+    }
     bool needs_accumulated_visual_contexts_update() const { return m_needs_accumulated_visual_contexts_update; }
 
     virtual JS::Value named_item_value(FlyString const& name) const override;
@@ -1092,6 +1107,11 @@ public:
 
     ElementByIdMap& element_by_id() const;
 
+    // Returns the elements in this document's tree that have the given class name, or whose local name is the given
+    // name ignoring ASCII case, in tree order. Returns nothing if the index isn't worth building yet.
+    Optional<ReadonlySpan<GC::Ref<Element>>> indexed_elements_with_class_name(FlyString const&);
+    Optional<ReadonlySpan<GC::Ref<Element>>> indexed_elements_with_lowercase_local_name(FlyString const&);
+
     // https://fullscreen.spec.whatwg.org/#run-the-fullscreen-steps
     void run_fullscreen_steps();
     void append_pending_fullscreen_change(PendingFullscreenEvent::Type type, GC::Ref<Element> element);
@@ -1306,6 +1326,13 @@ private:
     Optional<String> m_http_content_language;
     Optional<String> m_encoding;
 
+    struct URLParseCache {
+        URL::URL base_url;
+        String encoding;
+        HashMap<String, Optional<URL::URL>> results;
+    };
+    mutable Optional<URLParseCache> m_url_parse_cache;
+
     bool m_ready_for_post_load_tasks { false };
 
     GC::Ptr<DOMImplementation> m_implementation;
@@ -1364,6 +1391,7 @@ private:
     bool m_is_running_update_layout { false };
 
     HashTable<WeakPtr<Layout::SVGSVGBox>> m_svg_roots_needing_relayout;
+    HashTable<WeakPtr<Layout::Box>> m_relayout_boundaries_needing_relayout;
 
     bool m_needs_animated_style_update { false };
 
@@ -1449,10 +1477,16 @@ private:
     // Each document has an IntersectionObserverTaskQueued flag which is initialized to false.
     bool m_intersection_observer_task_queued { false };
 
+    // Bumped whenever layout, scrolling, transforms or painting may have moved or resized something in this document.
+    // Observation targets remember the generation they were last computed at, so that unchanged ones can be skipped.
+    u64 m_intersection_observation_geometry_generation { 1 };
+
     // https://html.spec.whatwg.org/multipage/urls-and-fetching.html#lazy-load-intersection-observer
     // Each Document has a lazy load intersection observer, initially set to null but can be set to an IntersectionObserver instance.
     GC::Ptr<IntersectionObserver::IntersectionObserver> m_lazy_load_intersection_observer;
 
+    GC::Ptr<IntersectionObserver::IntersectionObserver> m_visibility_in_viewport_intersection_observer;
+
     ResizeObserver::ResizeObserver::ResizeObserversList m_resize_observers;
 
     // https://html.spec.whatwg.org/multipage/semantics.html#will-declaratively-refresh
@@ -1524,6 +1558,17 @@ private:
     u64 m_dom_tree_version { 0 };
     u64 m_character_data_version { 0 };
 
+    // OPTIMIZATION: Lists of the elements in the tree with each class name and local name, so querySelector() and
+    //               querySelectorAll() only have to look at the elements that may match a class or type selector.
+    //               They are dropped whenever the tree changes, and rebuilt once they're asked for again.
+    struct ElementIndex {
+        HashMap<FlyString, Vector<GC::Ref<Element>>> elements_by_class_name;
+        HashMap<FlyString, Vector<GC::Ref<Element>>> elements_by_lowercase_local_name;
+    };
+    ElementIndex const* ensure_element_index();
+    OwnPtr<ElementIndex> m_element_index;
+    Optional<u64> m_dom_tree_version_of_last_unindexed_query;
+
     // https://drafts.csswg.org/css-position-4/#document-top-layer
     // Documents have a top layer, an ordered set containing elements from the document.
     // Elements in the top layer do not lay out normally based on their position in the document;
@@ -155,6 +155,9 @@ public:
     GC::Ptr<NamedNodeMap const> attributes() const;
     GC::Ptr<NamedNodeMap> attributes();
 
+    // Unlike attributes(), this doesn't create a NamedNodeMap for an element that has never had any attributes.
+    GC::Ptr<NamedNodeMap const> existing_attributes() const { return m_attributes; }
+
     Vector<String> get_attribute_names() const;
 
     GC::Ptr<Attr> get_attribute_node(FlyString const& name) const;
@@ -627,6 +627,10 @@ void Node::insert_before(GC::Ref<Node> node, GC::Ptr<Node> child, bool suppress_
     else
         previous_sibling = last_child();
 
+    // OPTIMIZATION: When several nodes go into a parent that had no children, as with innerHTML, the nodes only have
+    //               each other as siblings, so their style is invalidated as one batch.
+    auto batch_style_invalidation = count > 1 && !child && !previous_sibling;
+
     // 7. For each node in nodes, in tree order:
     // FIXME: In tree order
     for (auto& node_to_insert : nodes) {
@@ -669,7 +673,10 @@ void Node::insert_before(GC::Ref<Node> node, GC::Ptr<Node> child, bool suppress_
         // 6. Run assign slottables for a tree with node’s root.
         assign_slottables_for_a_tree(node_to_insert->root());
 
-        node_to_insert->invalidate_style(StyleInvalidationReason::NodeInsertBefore);
+        if (batch_style_invalidation)
+            CSS::Invalidation::invalidate_node_style_for_insertion_into_empty_parent(*node_to_insert);
+        else
+            node_to_insert->invalidate_style(StyleInvalidationReason::NodeInsertBefore);
 
         // 7. For each shadow-including inclusive descendant inclusiveDescendant of node, in shadow-including tree order:
         node_to_insert->for_each_shadow_including_inclusive_descendant([&](Node& inclusive_descendant) {
@@ -714,6 +721,9 @@ void Node::insert_before(GC::Ref<Node> node, GC::Ptr<Node> child, bool suppress_
         });
     }
 
+    if (batch_style_invalidation)
+        CSS::Invalidation::finish_style_invalidation_for_insertion_into_empty_parent(*this);
+
     // 8. If suppressObservers is false, then queue a tree mutation record for parent with nodes, « », previousSibling,
     //    and child.
     if (!suppress_observers) {
@@ -2443,7 +2453,7 @@ Vector<FlyString> Node::get_in_scope_prefixes() const
             add_prefix(prefix);
         }
 
-        if (auto attributes = current->attributes()) {
+        if (auto attributes = current->existing_attributes()) {
             for (size_t i = 0; i < attributes->length(); ++i) {
                 auto const* attr = attributes->item(i);
                 if (attr->namespace_uri() != Web::Namespace::XMLNS)
@@ -2494,7 +2504,7 @@ Optional<String> Node::locate_a_namespace(Optional<String> const& prefix) const
         // 4. If it has an attribute whose namespace is the XMLNS namespace, namespace prefix is "xmlns", and local name is prefix,
         //    or if prefix is null and it has an attribute whose namespace is the XMLNS namespace, namespace prefix is null,
         //    and local name is "xmlns", then return its value if it is not the empty string, and null otherwise.
-        if (auto attributes = element.attributes()) {
+        if (auto attributes = element.existing_attributes()) {
             for (size_t i = 0; i < attributes->length(); ++i) {
                 auto& attr = *attributes->item(i);
                 if (attr.namespace_uri() == Web::Namespace::XMLNS) {
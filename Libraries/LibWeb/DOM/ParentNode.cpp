@@ -27,6 +27,29 @@ enum class ReturnMatches {
     First,
     All,
 };
+
+// Returns the elements the document has indexed under a class or type selector of the selector's rightmost compound
+// selector. Every element the selector matches is among them.
+static Optional<ReadonlySpan<GC::Ref<Element>>> indexed_candidates_for_selector(Document& document, CSS::Selector const& selector)
+{
+    auto const& simple_selectors = selector.compound_selectors().last().simple_selectors;
+
+    // NB: Class names match case-insensitively in quirks mode, so they can't be looked up by name.
+    if (!document.in_quirks_mode()) {
+        for (auto const& simple_selector : simple_selectors) {
+            if (simple_selector.type == CSS::Selector::SimpleSelector::Type::Class)
+                return document.indexed_elements_with_class_name(simple_selector.name());
+        }
+    }
+
+    for (auto const& simple_selector : simple_selectors) {
+        if (simple_selector.type == CSS::Selector::SimpleSelector::Type::TagName)
+            return document.indexed_elements_with_lowercase_local_name(simple_selector.qualified_name().name.lowercase_name);
+    }
+
+    return {};
+}
+
 // https://dom.spec.whatwg.org/#scope-match-a-selectors-string
 static WebIDL::ExceptionOr<Variant<GC::Ptr<Element>, GC::Ref<NodeList>>> scope_match_a_selectors_string(ParentNode& node, StringView selector_text, ReturnMatches return_matches)
 {
@@ -45,6 +68,27 @@ static WebIDL::ExceptionOr<Variant<GC::Ptr<Element>, GC::Ref<NodeList>>> scope_m
     // 3. Return the result of match a selector against a tree with s and node’s root using scoping root node.
     GC::Ptr<Element> single_result;
     Vector<GC::Root<Node>> results;
+
+    // OPTIMIZATION: When the whole document is searched with a single selector, we only have to try the elements the
+    //               document has indexed under its rightmost class or type selector. They are already in tree order.
+    //               Matching selectors doesn't change the tree, so the index stays alive while we go through it.
+    if (is<Document>(node) && selectors.size() == 1) {
+        if (auto candidates = indexed_candidates_for_selector(document, selectors.first()); candidates.has_value()) {
+            for (auto const& element : *candidates) {
+                SelectorEngine::MatchContext context;
+                if (!SelectorEngine::matches(selectors.first(), element, nullptr, context, node))
+                    continue;
+                if (return_matches == ReturnMatches::First)
+                    return { GC::Ptr<Element> { *element } };
+                results.append(*element);
+            }
+
+            if (return_matches == ReturnMatches::First)
+                return { single_result };
+            return { StaticNodeList::create(node.realm(), move(results)) };
+        }
+    }
+
     // FIXME: This should be shadow-including. https://drafts.csswg.org/selectors-4/#match-a-selector-against-a-tree
     node.for_each_in_subtree_of_type<Element>([&](auto& element) {
         for (auto const& selector : selectors) {
@@ -142,11 +142,9 @@ void FetchedDataReceiver::enqueue_into_stream(ReadonlyBytes bytes)
     HTML::TemporaryExecutionContext execution_context { realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
 
     // 1. Pull from bytes buffer into stream.
-    auto byte_buffer = MUST(ByteBuffer::copy(bytes));
-
     auto& controller = m_stream->controller()->get<GC::Ref<Streams::ReadableByteStreamController>>();
 
-    if (auto result = Streams::readable_byte_stream_controller_enqueue_native_bytes(*controller, move(byte_buffer)); result.is_error()) {
+    if (auto result = Streams::readable_byte_stream_controller_enqueue_native_bytes(*controller, bytes); result.is_error()) {
         auto throw_completion = Bindings::exception_to_throw_completion(realm.vm(), result.release_error());
         // 2. If stream is errored, then terminate fetchParams’s controller.
         Streams::readable_byte_stream_controller_error(*controller, throw_completion.value());
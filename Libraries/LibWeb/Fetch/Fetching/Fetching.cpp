@@ -74,6 +74,7 @@
 namespace Web::Fetch::Fetching {
 
 static bool g_http_memory_cache_enabled = false;
+static u64 g_http_memory_cache_maximum_size = HTTP::MemoryCache::DEFAULT_MAXIMUM_SIZE;
 
 #define TRY_OR_IGNORE(expression)                                                                    \
     ({                                                                                               \
@@ -89,9 +90,14 @@ class HTTPCache {
 public:
     HTTP::MemoryCache& get(Infrastructure::NetworkPartitionKey const& key)
     {
-        return *m_cache.ensure(key, [] {
-            return HTTP::MemoryCache::create();
+        if (auto it = m_cache.find(key); it != m_cache.end())
+            return *it->value;
+
+        auto& cache = *m_cache.ensure(key, [] {
+            return HTTP::MemoryCache::create(g_http_memory_cache_maximum_size);
         });
+        divide_maximum_size();
+        return cache;
     }
 
     HTTP::MemoryCache* get_if_exists(Infrastructure::NetworkPartitionKey const& key)
@@ -113,6 +119,42 @@ public:
         m_cache.clear();
     }
 
+    // The budget is for the whole process, so every partition gets an equal share of it
+    void divide_maximum_size()
+    {
+        if (m_cache.is_empty())
+            return;
+
+        auto maximum_size = g_http_memory_cache_maximum_size / m_cache.size();
+        for (auto& it : m_cache)
+            it.value->set_maximum_size(maximum_size);
+    }
+
+    Requests::CacheSizes estimate_cache_size_accessed_since(UnixDateTime since) const
+    {
+        Requests::CacheSizes sizes;
+        for (auto const& it : m_cache) {
+            auto partition_sizes = it.value->estimate_cache_size_accessed_since(since);
+            sizes.since_requested_time += partition_sizes.since_requested_time;
+            sizes.total += partition_sizes.total;
+        }
+        return sizes;
+    }
+
+    HTTP::MemoryCache::Statistics statistics() const
+    {
+        HTTP::MemoryCache::Statistics statistics;
+        for (auto const& it : m_cache) {
+            auto const& partition_statistics = it.value->statistics();
+            statistics.hits += partition_statistics.hits;
+            statistics.misses += partition_statistics.misses;
+            statistics.rejected_entries += partition_statistics.rejected_entries;
+            statistics.evicted_entries += partition_statistics.evicted_entries;
+            statistics.evicted_bytes += partition_statistics.evicted_bytes;
+        }
+        return statistics;
+    }
+
 private:
     HashMap<Infrastructure::NetworkPartitionKey, NonnullRefPtr<HTTP::MemoryCache>> m_cache;
 };
@@ -2639,6 +2681,22 @@ bool http_memory_cache_enabled()
     return g_http_memory_cache_enabled;
 }
 
+void set_http_memory_cache_maximum_size(u64 maximum_size)
+{
+    g_http_memory_cache_maximum_size = maximum_size;
+    HTTPCache::the().divide_maximum_size();
+}
+
+Requests::CacheSizes estimate_http_memory_cache_size_accessed_since(UnixDateTime since)
+{
+    return HTTPCache::the().estimate_cache_size_accessed_since(since);
+}
+
+HTTP::MemoryCache::Statistics http_memory_cache_statistics()
+{
+    return HTTPCache::the().statistics();
+}
+
 void clear_http_memory_cache()
 {
     HTTPCache::the().clear_cache();
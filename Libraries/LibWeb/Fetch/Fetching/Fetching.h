@@ -11,9 +11,11 @@
 #include <AK/RefPtr.h>
 #include <LibCore/ImmutableBytes.h>
 #include <LibGC/Ptr.h>
+#include <LibHTTP/Cache/MemoryCache.h>
 #include <LibHTTP/Cookie/IncludeCredentials.h>
 #include <LibHTTP/Forward.h>
 #include <LibJS/Forward.h>
+#include <LibRequests/CacheSizes.h>
 #include <LibURL/Forward.h>
 #include <LibWeb/Export.h>
 #include <LibWeb/Fetch/Infrastructure/NetworkPartitionKey.h>
@@ -62,6 +64,9 @@ void append_fetch_metadata_headers_for_request(Infrastructure::Request&);
 
 WEB_API void set_http_memory_cache_enabled(bool enabled);
 WEB_API bool http_memory_cache_enabled();
+WEB_API void set_http_memory_cache_maximum_size(u64 maximum_size);
+WEB_API Requests::CacheSizes estimate_http_memory_cache_size_accessed_since(UnixDateTime since);
+WEB_API HTTP::MemoryCache::Statistics http_memory_cache_statistics();
 WEB_API void clear_http_memory_cache();
 void update_javascript_bytecode_cache_in_http_memory_cache(Infrastructure::NetworkPartitionKey const&, URL::URL const&, ByteString const& method, HTTP::HeaderList const& request_headers, u64 vary_key, Core::ImmutableBytes);
 
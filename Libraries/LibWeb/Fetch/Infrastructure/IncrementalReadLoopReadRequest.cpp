@@ -16,34 +16,42 @@ void IncrementalReadLoopReadRequest::on_chunk(JS::Value chunk)
 {
     auto& realm = m_reader->realm();
     // 1. Let continueAlgorithm be null.
-    GC::Ptr<GC::Function<void()>> continue_algorithm;
 
     // 2. If chunk is not a Uint8Array object, then set continueAlgorithm to this step: run processBodyError given a TypeError.
     auto uint8_array = chunk.as_if<JS::Uint8Array>();
 
     if (!uint8_array) {
-        continue_algorithm = GC::create_function(realm.heap(), [&realm, process_body_error = m_process_body_error] {
+        auto continue_algorithm = GC::create_function(realm.heap(), [&realm, process_body_error = m_process_body_error] {
             process_body_error->function()(JS::TypeError::create(realm, "Chunk data is not Uint8Array"sv));
         });
+
+        // 4. Queue a fetch task given continueAlgorithm and taskDestination.
+        Fetch::Infrastructure::queue_fetch_task(m_task_destination, continue_algorithm);
+        return;
     }
+
     // 3. Otherwise:
-    else {
-        // 1. Let bytes be a copy of chunk.
-        // NOTE: Implementations are strongly encouraged to use an implementation strategy that avoids this copy where possible.
-        auto bytes = MUST(ByteBuffer::copy(uint8_array->data()));
-        // 2. Set continueAlgorithm to these steps:
-        continue_algorithm = GC::create_function(realm.heap(), [bytes = move(bytes), body = m_body, reader = m_reader, task_destination = m_task_destination, process_body_chunk = m_process_body_chunk, process_end_of_body = m_process_end_of_body, process_body_error = m_process_body_error] {
-            HTML::TemporaryExecutionContext execution_context { reader->realm(), HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
-            // 1. Run processBodyChunk given bytes.
-            process_body_chunk->function()(move(bytes));
-
-            // 2. Perform the incrementally-read loop given reader, taskDestination, processBodyChunk, processEndOfBody, and processBodyError.
-            body->incrementally_read_loop(reader, task_destination, process_body_chunk, process_end_of_body, process_body_error);
-        });
-    }
+    on_chunk_bytes(uint8_array->data());
+}
+
+void IncrementalReadLoopReadRequest::on_chunk_bytes(ReadonlyBytes chunk)
+{
+    // 3. 1. Let bytes be a copy of chunk.
+    // NOTE: Implementations are strongly encouraged to use an implementation strategy that avoids this copy where possible.
+    auto bytes = MUST(ByteBuffer::copy(chunk));
+
+    //    2. Set continueAlgorithm to these steps:
+    auto continue_algorithm = GC::create_function(m_reader->heap(), [bytes = move(bytes), body = m_body, reader = m_reader, task_destination = m_task_destination, process_body_chunk = m_process_body_chunk, process_end_of_body = m_process_end_of_body, process_body_error = m_process_body_error] {
+        HTML::TemporaryExecutionContext execution_context { reader->realm(), HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
+        // 1. Run processBodyChunk given bytes.
+        process_body_chunk->function()(move(bytes));
+
+        // 2. Perform the incrementally-read loop given reader, taskDestination, processBodyChunk, processEndOfBody, and processBodyError.
+        body->incrementally_read_loop(reader, task_destination, process_body_chunk, process_end_of_body, process_body_error);
+    });
 
     // 4. Queue a fetch task given continueAlgorithm and taskDestination.
-    Fetch::Infrastructure::queue_fetch_task(m_task_destination, *continue_algorithm);
+    Fetch::Infrastructure::queue_fetch_task(m_task_destination, continue_algorithm);
 }
 
 void IncrementalReadLoopReadRequest::on_close()
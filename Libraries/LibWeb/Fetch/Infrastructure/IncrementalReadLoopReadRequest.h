@@ -23,6 +23,9 @@ public:
     virtual void on_close() override;
     virtual void on_error(JS::Value error) override;
 
+    virtual bool wants_chunk_bytes() const override { return true; }
+    virtual void on_chunk_bytes(ReadonlyBytes) override;
+
 private:
     virtual void visit_edges(Visitor&) override;
 
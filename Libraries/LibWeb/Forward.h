@@ -1064,6 +1064,8 @@ namespace Web::Platform {
 
 class Timer;
 
+struct DecodedImage;
+
 }
 
 namespace Web::ReferrerPolicy {
@@ -224,6 +224,11 @@ WebIDL::ExceptionOr<void> CanvasRenderingContext2D::draw_image_internal(CanvasIm
 
 void CanvasRenderingContext2D::did_draw(Gfx::FloatRect const&)
 {
+    // OPTIMIZATION: Dirty content only becomes clean again when the canvas is presented during a rendering update, so
+    //               a repaint has already been requested for every draw call after the first one since then.
+    if (m_element->canvas_content_is_dirty())
+        return;
+
     // FIXME: Make use of the rect to reduce the invalidated area when possible.
     m_element->set_canvas_content_dirty();
     m_element->set_needs_repaint(InvalidateDisplayList::No);
@@ -8,6 +8,7 @@
 #include <AK/Debug.h>
 #include <AK/TemporaryChange.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/TraceEvent.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibWeb/Animations/ScrollTimeline.h>
 #include <LibWeb/Bindings/MainThreadVM.h>
@@ -148,7 +149,10 @@ void EventLoop::process()
         m_currently_running_task = oldest_task.ptr();
 
         // 6. Perform oldestTask's steps.
-        oldest_task->execute();
+        {
+            Core::TraceEventScope trace_event { "task"sv, "Run task"sv };
+            oldest_task->execute();
+        }
 
         // 7. Set the event loop's currently running task back to null.
         m_currently_running_task = nullptr;
@@ -314,6 +318,8 @@ void EventLoop::update_the_rendering()
         m_running_rendering_task = false;
     };
 
+    auto rendering_update_started_at = MonotonicTime::now();
+    Core::TraceEventScope trace_event { "rendering"sv, "Update the rendering"sv };
     process_input_events();
 
     // 1. Let frameTimestamp be eventLoop's last render opportunity time.
@@ -547,6 +553,8 @@ void EventLoop::update_the_rendering()
             auto traversable = navigable->traversable_navigable();
             traversable->process_screenshot_requests();
         }
+        if (navigable->is_top_level_traversable())
+            navigable->page().client().page_did_paint_next_frame(rendering_update_started_at);
     }
 
     // 23. For each doc of docs, process top layer removals given doc.
@@ -655,6 +663,7 @@ void EventLoop::perform_a_microtask_checkpoint()
 
     // 2. Set the event loop's performing a microtask checkpoint to true.
     m_performing_a_microtask_checkpoint = true;
+    Core::TraceEventScope trace_event { "task"sv, m_microtask_queue.is_empty() ? ""sv : "Perform a microtask checkpoint"sv };
 
     // 3. While the event loop's microtask queue is not empty:
     while (!m_microtask_queue.is_empty()) {
@@ -13,6 +13,10 @@ namespace Web::HTML {
 
 GC_DEFINE_ALLOCATOR(TaskQueue);
 
+// A queue that keeps having a runnable task passed over for more urgent ones gets to go next anyway, so e.g. timers
+// still fire while input events keep arriving. Idle tasks are meant to wait for everything else.
+static constexpr size_t max_times_passed_over = 32;
+
 TaskQueue::TaskQueue(HTML::EventLoop& event_loop)
     : m_event_loop(event_loop)
 {
@@ -24,11 +28,49 @@ void TaskQueue::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
     visitor.visit(m_event_loop);
-    visitor.visit(m_tasks);
-    visitor.visit(m_idle_tasks);
+    for (auto const& queue : m_queues) {
+        for (auto const& document_tasks : queue.documents) {
+            visitor.visit(document_tasks.document);
+            for (auto const& queued_task : document_tasks.tasks.span().slice(document_tasks.head))
+                visitor.visit(queued_task.task);
+        }
+    }
     visitor.visit(m_last_added_task);
 }
 
+TaskQueue::Priority TaskQueue::priority_for_source(Task::Source source)
+{
+    switch (source) {
+    case Task::Source::UserInteraction:
+        return Priority::Input;
+    case Task::Source::Rendering:
+        return Priority::Rendering;
+    case Task::Source::IdleTask:
+        return Priority::Idle;
+    default:
+        // NB: This includes timer tasks, whose order relative to e.g. posted messages is visible to pages.
+        return Priority::Normal;
+    }
+}
+
+GC::Ref<Task> TaskQueue::DocumentTasks::take(size_t index)
+{
+    auto task = tasks[head + index].task;
+    if (index == 0) {
+        ++head;
+        if (head == tasks.size()) {
+            tasks.clear_with_capacity();
+            head = 0;
+        } else if (head >= tasks.size() / 2) {
+            tasks.remove(0, head);
+            head = 0;
+        }
+    } else {
+        tasks.remove(head + index);
+    }
+    return task;
+}
+
 void TaskQueue::add(GC::Ref<Task> task)
 {
     // AD-HOC: Don't enqueue tasks for temporary (inert) documents used for fragment parsing.
@@ -37,27 +79,76 @@ void TaskQueue::add(GC::Ref<Task> task)
         return;
 
     m_last_added_task = task.ptr();
-    if (task->source() == Task::Source::IdleTask)
-        m_idle_tasks.append(task);
-    else
-        m_tasks.append(task);
+
+    // NB: Only documents with queued tasks have an entry, so this is short.
+    auto& queue = m_queues[to_underlying(priority_for_source(task->source()))];
+    auto index = queue.documents.find_first_index_if([&](auto const& document_tasks) { return document_tasks.document == task->document(); });
+    if (!index.has_value()) {
+        queue.documents.append({ .document = task->document() });
+        index = queue.documents.size() - 1;
+    }
+    queue.documents[*index].tasks.append({ task, m_next_sequence_number++ });
+    ++m_task_count;
+
     m_event_loop->schedule();
 }
 
-GC::Ptr<Task> TaskQueue::dequeue()
+GC::Ref<Task> TaskQueue::take(PriorityQueue& queue, size_t document_index, size_t task_index)
 {
-    auto take_task = [&](auto& tasks) -> GC::Ptr<Task> {
-        if (tasks.is_empty())
-            return {};
-        auto task = tasks.take_first();
-        if (m_last_added_task == task.ptr())
+    auto task = queue.documents[document_index].take(task_index);
+    if (queue.documents[document_index].is_empty())
+        queue.documents.remove(document_index);
+    --m_task_count;
+
+    if (m_last_added_task == task.ptr())
+        m_last_added_task = {};
+    return task;
+}
+
+bool TaskQueue::can_take_from(Priority priority) const
+{
+    // The update the rendering task may spin the event loop, which must not start another one.
+    return priority != Priority::Rendering || !m_event_loop->running_rendering_task();
+}
+
+// Tasks for different documents of the same priority still run in the order they were added.
+Optional<size_t> TaskQueue::oldest_runnable_document(PriorityQueue const& queue) const
+{
+    Optional<size_t> oldest;
+    for (size_t i = 0; i < queue.documents.size(); ++i) {
+        auto const& document_tasks = queue.documents[i];
+        if (!document_tasks.is_runnable())
+            continue;
+        if (!oldest.has_value() || document_tasks.first().sequence_number < queue.documents[*oldest].first().sequence_number)
+            oldest = i;
+    }
+    return oldest;
+}
+
+void TaskQueue::remove_permanently_unrunnable_tasks(PriorityQueue& queue)
+{
+    queue.documents.remove_all_matching([&](DocumentTasks const& document_tasks) {
+        if (!document_tasks.is_permanently_unrunnable())
+            return false;
+        m_task_count -= document_tasks.size();
+        if (m_last_added_task && m_last_added_task->document() == document_tasks.document)
             m_last_added_task = {};
-        return task;
-    };
+        return true;
+    });
+}
 
-    if (auto task = take_task(m_tasks))
-        return task;
-    return take_task(m_idle_tasks);
+GC::Ptr<Task> TaskQueue::dequeue()
+{
+    for (auto& queue : m_queues) {
+        Optional<size_t> oldest;
+        for (size_t i = 0; i < queue.documents.size(); ++i) {
+            if (!oldest.has_value() || queue.documents[i].first().sequence_number < queue.documents[*oldest].first().sequence_number)
+                oldest = i;
+        }
+        if (oldest.has_value())
+            return take(queue, *oldest);
+    }
+    return {};
 }
 
 GC::Ptr<Task> TaskQueue::take_first_runnable()
@@ -65,45 +156,41 @@ GC::Ptr<Task> TaskQueue::take_first_runnable()
     if (m_event_loop->execution_paused())
         return nullptr;
 
-    for (size_t i = 0; i < m_tasks.size();) {
-        if (m_event_loop->running_rendering_task() && m_tasks[i]->source() == Task::Source::Rendering) {
-            ++i;
-            continue;
-        }
+    struct Candidate {
+        size_t priority;
+        size_t document_index;
+    };
+    Optional<Candidate> chosen;
+    Array<bool, priority_count> has_runnable_task {};
 
-        if (m_tasks[i]->is_runnable()) {
-            if (m_last_added_task == m_tasks[i].ptr())
-                m_last_added_task = {};
-            return m_tasks.take(i);
-        }
+    for (size_t priority = 0; priority < priority_count; ++priority) {
+        auto& queue = m_queues[priority];
+        remove_permanently_unrunnable_tasks(queue);
+        if (!can_take_from(static_cast<Priority>(priority)))
+            continue;
 
-        if (m_tasks[i]->is_permanently_unrunnable()) {
-            if (m_last_added_task == m_tasks[i].ptr())
-                m_last_added_task = {};
-            m_tasks.remove(i);
+        auto document_index = oldest_runnable_document(queue);
+        if (!document_index.has_value())
             continue;
-        }
+        has_runnable_task[priority] = true;
 
-        ++i;
+        auto is_starved = static_cast<Priority>(priority) != Priority::Idle && queue.times_passed_over >= max_times_passed_over;
+        if (!chosen.has_value() || is_starved)
+            chosen = Candidate { priority, *document_index };
+        if (is_starved)
+            break;
     }
 
-    for (size_t i = 0; i < m_idle_tasks.size();) {
-        if (m_idle_tasks[i]->is_runnable()) {
-            if (m_last_added_task == m_idle_tasks[i].ptr())
-                m_last_added_task = {};
-            return m_idle_tasks.take(i);
-        }
-
-        if (m_idle_tasks[i]->is_permanently_unrunnable()) {
-            if (m_last_added_task == m_idle_tasks[i].ptr())
-                m_last_added_task = {};
-            m_idle_tasks.remove(i);
-            continue;
-        }
+    if (!chosen.has_value())
+        return nullptr;
 
-        ++i;
+    for (size_t priority = 0; priority < priority_count; ++priority) {
+        if (priority == chosen->priority)
+            m_queues[priority].times_passed_over = 0;
+        else if (has_runnable_task[priority])
+            ++m_queues[priority].times_passed_over;
     }
-    return nullptr;
+    return take(m_queues[chosen->priority], chosen->document_index);
 }
 
 bool TaskQueue::has_runnable_tasks() const
@@ -111,15 +198,10 @@ bool TaskQueue::has_runnable_tasks() const
     if (m_event_loop->execution_paused())
         return false;
 
-    for (auto& task : m_tasks) {
-        if (m_event_loop->running_rendering_task() && task->source() == Task::Source::Rendering)
+    for (size_t priority = 0; priority < priority_count; ++priority) {
+        if (!can_take_from(static_cast<Priority>(priority)))
             continue;
-        if (task->is_runnable())
-            return true;
-    }
-
-    for (auto& task : m_idle_tasks) {
-        if (task->is_runnable())
+        if (oldest_runnable_document(m_queues[priority]).has_value())
             return true;
     }
     return false;
@@ -127,55 +209,51 @@ bool TaskQueue::has_runnable_tasks() const
 
 void TaskQueue::remove_tasks_matching(Function<bool(HTML::Task const&)> filter)
 {
-    auto wrapped_filter = [&](HTML::Task const& task) {
-        if (!filter(task))
-            return false;
-        if (m_last_added_task == &task)
-            m_last_added_task = {};
-        return true;
-    };
-    m_tasks.remove_all_matching(wrapped_filter);
-    m_idle_tasks.remove_all_matching(wrapped_filter);
+    for (auto& queue : m_queues) {
+        for (auto& document_tasks : queue.documents) {
+            for (size_t i = document_tasks.head; i < document_tasks.tasks.size();) {
+                auto& task = *document_tasks.tasks[i].task;
+                if (!filter(task)) {
+                    ++i;
+                    continue;
+                }
+                if (m_last_added_task == &task)
+                    m_last_added_task = {};
+                document_tasks.tasks.remove(i);
+                --m_task_count;
+            }
+        }
+        queue.documents.remove_all_matching([](auto const& document_tasks) { return document_tasks.is_empty(); });
+    }
 }
 
 GC::Ptr<Task> TaskQueue::take_first_runnable_matching(Function<bool(HTML::Task const&)> filter)
 {
-    for (size_t i = 0; i < m_tasks.size();) {
-        auto& task = m_tasks.at(i);
-
-        if (task->is_runnable() && filter(*task)) {
-            if (m_last_added_task == task.ptr())
-                m_last_added_task = {};
-            return m_tasks.take(i);
+    for (auto& queue : m_queues) {
+        remove_permanently_unrunnable_tasks(queue);
+
+        struct Match {
+            size_t document_index;
+            size_t task_index;
+            u64 sequence_number;
+        };
+        Optional<Match> oldest;
+        for (size_t document_index = 0; document_index < queue.documents.size(); ++document_index) {
+            auto const& document_tasks = queue.documents[document_index];
+            if (!document_tasks.is_runnable())
+                continue;
+            for (size_t task_index = 0; task_index < document_tasks.size(); ++task_index) {
+                auto const& queued_task = document_tasks.tasks[document_tasks.head + task_index];
+                if (oldest.has_value() && queued_task.sequence_number > oldest->sequence_number)
+                    break;
+                if (filter(*queued_task.task)) {
+                    oldest = Match { document_index, task_index, queued_task.sequence_number };
+                    break;
+                }
+            }
         }
-
-        if (task->is_permanently_unrunnable()) {
-            if (m_last_added_task == task.ptr())
-                m_last_added_task = {};
-            m_tasks.remove(i);
-            continue;
-        }
-
-        ++i;
-    }
-
-    for (size_t i = 0; i < m_idle_tasks.size();) {
-        auto& task = m_idle_tasks.at(i);
-
-        if (task->is_runnable() && filter(*task)) {
-            if (m_last_added_task == task.ptr())
-                m_last_added_task = {};
-            return m_idle_tasks.take(i);
-        }
-
-        if (task->is_permanently_unrunnable()) {
-            if (m_last_added_task == task.ptr())
-                m_last_added_task = {};
-            m_idle_tasks.remove(i);
-            continue;
-        }
-
-        ++i;
+        if (oldest.has_value())
+            return take(queue, oldest->document_index, oldest->task_index);
     }
 
     return nullptr;
@@ -188,7 +266,7 @@ Task const* TaskQueue::last_added_task() const
 
 bool TaskQueue::has_rendering_tasks() const
 {
-    return m_tasks.contains([](auto const& task) { return task->source() == Task::Source::Rendering; });
+    return !m_queues[to_underlying(Priority::Rendering)].documents.is_empty();
 }
 
 }
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/StdLibExtras.h>
 #include <AK/Vector.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibWeb/HTML/EventLoop/Task.h>
@@ -20,7 +22,7 @@ public:
     explicit TaskQueue(HTML::EventLoop&);
     virtual ~TaskQueue() override;
 
-    bool is_empty() const { return m_tasks.is_empty() && m_idle_tasks.is_empty(); }
+    bool is_empty() const { return m_task_count == 0; }
 
     bool has_runnable_tasks() const;
     bool has_rendering_tasks() const;
@@ -37,12 +39,59 @@ public:
     Task const* last_added_task() const;
 
 private:
+    // The spec lets the event loop pick which task source to take the next task from. Sources are grouped by how
+    // urgent their tasks are, and the most urgent group with a runnable task goes first.
+    enum class Priority : u8 {
+        Input,
+        Rendering,
+        Normal,
+        Idle,
+    };
+    static constexpr size_t priority_count = to_underlying(Priority::Idle) + 1;
+    static Priority priority_for_source(Task::Source);
+
+    struct QueuedTask {
+        GC::Ref<Task> task;
+        u64 sequence_number { 0 };
+    };
+
+    // One document's tasks of one priority, in the order they were added. Whether they are runnable only depends on
+    // the document, so a whole inactive document is skipped at once. Taken from the front by advancing `head`, and
+    // compacted once most of the vector has been taken.
+    struct DocumentTasks {
+        bool is_runnable() const { return tasks[head].task->is_runnable(); }
+        bool is_permanently_unrunnable() const { return tasks[head].task->is_permanently_unrunnable(); }
+
+        QueuedTask const& first() const { return tasks[head]; }
+        size_t size() const { return tasks.size() - head; }
+        bool is_empty() const { return size() == 0; }
+
+        GC::Ref<Task> take(size_t index);
+
+        GC::Ptr<DOM::Document const> document;
+        Vector<QueuedTask> tasks;
+        size_t head { 0 };
+    };
+
+    struct PriorityQueue {
+        // Never holds an empty DocumentTasks.
+        Vector<DocumentTasks> documents;
+        // How many tasks were taken from a more urgent queue while this one had a runnable task.
+        size_t times_passed_over { 0 };
+    };
+
     virtual void visit_edges(Visitor&) override;
 
+    bool can_take_from(Priority) const;
+    Optional<size_t> oldest_runnable_document(PriorityQueue const&) const;
+    void remove_permanently_unrunnable_tasks(PriorityQueue&);
+    GC::Ref<Task> take(PriorityQueue&, size_t document_index, size_t task_index = 0);
+
     GC::Ref<HTML::EventLoop> m_event_loop;
 
-    Vector<GC::Ref<HTML::Task>> m_tasks;
-    Vector<GC::Ref<HTML::Task>> m_idle_tasks;
+    Array<PriorityQueue, priority_count> m_queues;
+    size_t m_task_count { 0 };
+    u64 m_next_sequence_number { 0 };
     GC::Ptr<HTML::Task const> m_last_added_task;
 };
 
@@ -50,6 +50,7 @@ public:
     void present();
     void republish_compositor_surface();
     void set_canvas_content_dirty();
+    bool canvas_content_is_dirty() const { return m_canvas_content_dirty; }
 
     RefPtr<Gfx::PaintingSurface> surface() const;
     void allocate_painting_surface_if_needed();
@@ -197,6 +197,11 @@ void HTMLImageElement::adopted_from(DOM::Document& old_document)
     old_document.unregister_viewport_client(*this);
     document().register_viewport_client(*this);
 
+    if (m_is_observing_visibility_in_viewport) {
+        old_document.stop_observing_visibility_in_viewport(*this);
+        document().start_observing_visibility_in_viewport(*this);
+    }
+
     m_document_observer->set_document(document());
     if (!old_document.is_fully_active() && document().is_fully_active()) {
         if (auto callback = m_document_observer->document_became_active())
@@ -347,9 +352,25 @@ Optional<Gfx::DecodedImageFrame> HTMLImageElement::current_image_frame_sized(Gfx
     return {};
 }
 
-void HTMLImageElement::set_visible_in_viewport(bool)
+void HTMLImageElement::set_visible_in_viewport(bool visible_in_viewport)
 {
-    // FIXME: Loosen grip on image data when it's not visible, e.g via volatile memory.
+    if (m_visible_in_viewport == visible_in_viewport)
+        return;
+    m_visible_in_viewport = visible_in_viewport;
+
+    // OPTIMIZATION: An animation nobody can see doesn't need its frames decoded, sent over IPC and painted. It picks up
+    //               where it left off once it scrolls back into view.
+    // FIXME: Also loosen grip on the decoded frames while not visible, e.g via volatile memory.
+    if (!visible_in_viewport) {
+        if (m_animation_timer->is_active()) {
+            m_animation_timer->stop();
+            m_animation_paused_by_visibility = true;
+        }
+        return;
+    }
+
+    if (m_animation_paused_by_visibility)
+        start_animation_timer_if_visible();
 }
 
 // https://html.spec.whatwg.org/multipage/embedded-content.html#dom-img-width
@@ -973,7 +994,7 @@ void HTMLImageElement::add_callbacks_to_image_request(GC::Ref<ImageRequest> imag
 
                 // AD-HOC: If another instance of update_the_image_data was started after the one that initiated this
                 //         request, this callback is stale. Bail out to avoid corrupting the state of the newer request.
-                if (update_the_image_data_count != m_update_the_image_data_count) {
+                if (is_stale_image_request_callback(*image_request, update_the_image_data_count)) {
                     m_load_event_delayer.clear();
                     return;
                 }
@@ -1032,7 +1053,7 @@ void HTMLImageElement::add_callbacks_to_image_request(GC::Ref<ImageRequest> imag
 
             // AD-HOC: If another instance of update_the_image_data was started after the one that initiated this
             //         request, this callback is stale. Bail out to avoid corrupting the state of the newer request.
-            if (update_the_image_data_count != m_update_the_image_data_count) {
+            if (is_stale_image_request_callback(*image_request, update_the_image_data_count)) {
                 m_load_event_delayer.clear();
                 return;
             }
@@ -1055,9 +1076,53 @@ void HTMLImageElement::add_callbacks_to_image_request(GC::Ref<ImageRequest> imag
                 dispatch_event(DOM::Event::create(realm(), HTML::EventNames::error));
 
             m_load_event_delayer.clear();
+        },
+        [this, image_request, update_the_image_data_count]() {
+            batching_dispatcher().enqueue(GC::create_function(realm().heap(), [this, image_request, update_the_image_data_count] {
+                // NB: The load event delayer is left to the finish and failure callbacks, one of which always follows.
+                if (!document().is_fully_active())
+                    return;
+                if (is_stale_image_request_callback(*image_request, update_the_image_data_count))
+                    return;
+                if (image_request->state() == ImageRequest::State::CompletelyAvailable || image_request->state() == ImageRequest::State::Broken)
+                    return;
+
+                VERIFY(image_request->shared_resource_request());
+                auto image_data = image_request->shared_resource_request()->partial_image_data();
+                if (!image_data)
+                    return;
+
+                // AD-HOC: Present what has been decoded so far. Its dimensions are known now, so a pending request takes
+                //         over from the current request the same way it does once it is completely available.
+                image_request->set_image_data(image_data);
+                if (image_request == m_pending_request) {
+                    abort_the_image_request(realm(), m_current_request);
+                    upgrade_pending_request_to_current_request();
+                    image_request->prepare_for_presentation(*this);
+                }
+                if (image_request != m_current_request)
+                    return;
+
+                image_request->set_state(ImageRequest::State::PartiallyAvailable);
+                m_partially_available_update_the_image_data_count = update_the_image_data_count;
+
+                set_needs_layout_update_or_repaint_after_image_data_change(*this, DOM::SetNeedsLayoutReason::HTMLImageElementUpdateTheImageData);
+            }));
         });
 }
 
+bool HTMLImageElement::is_stale_image_request_callback(ImageRequest const& image_request, u64 update_the_image_data_count) const
+{
+    if (update_the_image_data_count == m_update_the_image_data_count)
+        return false;
+
+    // AD-HOC: Step 15 of update_the_image_data lets a partially available current request carry on loading, so the
+    //         instance that made it partially available still gets to complete it (or break it).
+    return update_the_image_data_count != m_partially_available_update_the_image_data_count
+        || &image_request != m_current_request.ptr()
+        || image_request.state() != ImageRequest::State::PartiallyAvailable;
+}
+
 void HTMLImageElement::did_set_viewport_rect(CSSPixelRect const& viewport_rect)
 {
     if (viewport_rect.size() == m_last_seen_viewport_size)
@@ -1275,7 +1340,12 @@ void HTMLImageElement::start_animation_timer_if_visible()
         return;
     }
 
-    if (document().visibility_state_value() == VisibilityState::Hidden) {
+    if (!m_is_observing_visibility_in_viewport) {
+        m_is_observing_visibility_in_viewport = true;
+        document().start_observing_visibility_in_viewport(*this);
+    }
+
+    if (document().visibility_state_value() == VisibilityState::Hidden || !m_visible_in_viewport) {
         m_animation_timer->stop();
         m_animation_paused_by_visibility = true;
         return;
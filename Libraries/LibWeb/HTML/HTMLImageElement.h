@@ -144,6 +144,7 @@ private:
     void handle_successful_fetch(URL::URL const&, StringView mime_type, ImageRequest&, ByteBuffer, bool maybe_omit_events, URL::URL const& previous_url);
     void handle_failed_fetch();
     void add_callbacks_to_image_request(GC::Ref<ImageRequest>, bool maybe_omit_events, String const& url_string, String const& previous_url, u64 update_the_image_data_count);
+    bool is_stale_image_request_callback(ImageRequest const&, u64 update_the_image_data_count) const;
 
     bool current_request_has_running_animation() const;
     void start_animation_timer_if_visible();
@@ -153,6 +154,8 @@ private:
     size_t m_current_frame_index { 0 };
     size_t m_loops_completed { 0 };
     bool m_animation_paused_by_visibility { false };
+    bool m_visible_in_viewport { true };
+    bool m_is_observing_visibility_in_viewport { false };
 
     Optional<DOM::DocumentLoadEventDelayer> m_load_event_delayer;
 
@@ -179,6 +182,9 @@ private:
     GC::Ptr<DOM::Element const> m_dimension_attribute_source;
 
     u64 m_update_the_image_data_count { 0 };
+
+    // The update_the_image_data count of the instance whose callbacks made the current request partially available.
+    u64 m_partially_available_update_the_image_data_count { 0 };
 };
 
 }
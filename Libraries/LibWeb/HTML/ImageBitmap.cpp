@@ -6,6 +6,7 @@
 
 #include <AK/NonnullOwnPtr.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/ShareableBitmap.h>
 #include <LibJS/Runtime/ExternalMemory.h>
 #include <LibWeb/Bindings/ImageBitmap.h>
 #include <LibWeb/HTML/ImageBitmap.h>
@@ -52,6 +53,26 @@ static void serialize_bitmap(HTML::TransferDataEncoder& encoder, RefPtr<Gfx::Bit
     return TRY(create_bitmap_from_bitmap_data(realm, format, alpha_type, width, height, pitch, move(data)));
 }
 
+// Transferring hands over the bitmap's shared memory rather than its pixels, so a bitmap that is already backed by an
+// anonymous buffer reaches the other side without being copied at all.
+[[nodiscard]] static WebIDL::ExceptionOr<void> transfer_bitmap(JS::Realm& realm, HTML::TransferDataEncoder& encoder, RefPtr<Gfx::Bitmap> const& bitmap)
+{
+    if (!bitmap) {
+        encoder.encode(Gfx::ShareableBitmap {});
+        return {};
+    }
+
+    auto shared_bitmap = TRY_OR_THROW_OOM(realm.vm(), bitmap->to_bitmap_backed_by_anonymous_buffer());
+    encoder.encode(Gfx::ShareableBitmap { move(shared_bitmap), Gfx::ShareableBitmap::ConstructWithKnownGoodBitmap });
+    return {};
+}
+
+static RefPtr<Gfx::Bitmap> receive_transferred_bitmap(HTML::TransferDataDecoder& decoder)
+{
+    auto shareable_bitmap = decoder.decode<Gfx::ShareableBitmap>();
+    return shareable_bitmap.bitmap();
+}
+
 GC::Ref<ImageBitmap> ImageBitmap::create(JS::Realm& realm)
 {
     return realm.create<ImageBitmap>(realm);
@@ -109,7 +130,7 @@ WebIDL::ExceptionOr<void> ImageBitmap::transfer_steps(HTML::TransferDataEncoder&
     // FIXME: 1. If value's origin-clean flag is not set, then throw a "DataCloneError" DOMException.
 
     // 2. Set dataHolder.[[BitmapData]] to value's bitmap data.
-    serialize_bitmap(data_holder, m_bitmap);
+    TRY(transfer_bitmap(realm(), data_holder, m_bitmap));
 
     // 3. Unset value's bitmap data.
     m_bitmap = nullptr;
@@ -121,7 +142,7 @@ WebIDL::ExceptionOr<void> ImageBitmap::transfer_steps(HTML::TransferDataEncoder&
 WebIDL::ExceptionOr<void> ImageBitmap::transfer_receiving_steps(HTML::TransferDataDecoder& data_holder)
 {
     // 1. Set value's bitmap data to dataHolder.[[BitmapData]].
-    set_bitmap(TRY(deserialize_bitmap(this->realm(), data_holder)));
+    set_bitmap(receive_transferred_bitmap(data_holder));
 
     return {};
 }
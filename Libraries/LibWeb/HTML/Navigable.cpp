@@ -8,6 +8,7 @@
 
 #include <AK/NeverDestroyed.h>
 #include <LibCore/Timer.h>
+#include <LibCore/TraceEvent.h>
 #include <LibWeb/CSS/ComputedProperties.h>
 #include <LibWeb/CSS/PseudoElement.h>
 #include <LibWeb/CSS/SystemColor.h>
@@ -3568,6 +3569,7 @@ bool Navigable::record_display_list_and_scroll_state(PaintConfig paint_config)
     Painting::DisplayListResourceTransaction resource_transaction;
     Optional<Painting::AccumulatedVisualContextTree> visual_context_tree;
     if (should_record_display_list) {
+        Core::TraceEventScope trace_event { "rendering"sv, "Record display list"sv };
         display_list = document->record_display_list(paint_config, m_display_list_resource_storage);
         if (!display_list)
             return false;
@@ -3590,6 +3592,9 @@ bool Navigable::record_display_list_and_scroll_state(PaintConfig paint_config)
     if (should_record_display_list) {
         compositor_context().update_display_list(*display_list, visual_context_tree.release_value(), move(resource_transaction), move(scroll_state_snapshot));
         document_paintable->did_update_visual_context_tree_in_compositor();
+        // NB: The compositor drops its animations whenever it gets a new tree, since they point into the old one.
+        if (document_paintable->has_async_animations())
+            compositor_context().update_async_animations(document_paintable->async_animations());
         m_display_list_resource_storage.retain_only(display_list_resources);
         m_compositor_display_list_resources = move(display_list_resources);
         m_needs_to_record_display_list = false;
@@ -3598,6 +3603,8 @@ bool Navigable::record_display_list_and_scroll_state(PaintConfig paint_config)
         if (visual_context_tree_needs_compositor_update) {
             compositor_context().update_visual_context_tree(document_paintable->visual_context_tree());
             document_paintable->did_update_visual_context_tree_in_compositor();
+            if (document_paintable->has_async_animations())
+                compositor_context().update_async_animations(document_paintable->async_animations());
         }
         compositor_context().update_scroll_state(move(scroll_state_snapshot));
     }
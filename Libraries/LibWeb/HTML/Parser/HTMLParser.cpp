@@ -648,8 +648,8 @@ void HTMLParserEndState::complete()
 GC::Ref<DOM::Element> HTMLParser::create_element_for(HTMLToken const& token, Optional<FlyString> const& namespace_, DOM::Node& intended_parent)
 {
     // 1. If the active speculative HTML parser is not null, then return the result of creating a speculative mock element given namespace, token's tag name, and token's attributes.
-    // The active speculative HTML parser runs synchronously to completion, so it is null whenever the real parser
-    // invokes this algorithm. It emits speculative fetch candidates directly instead of producing mock elements.
+    // The active speculative HTML parser never runs tree construction (its preload scanner scans on the thread pool and
+    // emits speculative fetch candidates directly), so it never reaches this algorithm and we don't produce mock elements.
 
     // 2. Otherwise, optionally create a speculative mock element given namespace, token's tag name, and token's attributes.
     // We deliberately skip step 2, the active speculative parser already issues these fetches, so doing it again here
@@ -995,7 +995,7 @@ WebIDL::ExceptionOr<Vector<GC::Root<DOM::Node>>> HTMLParser::parse_html_fragment
     if (context_namespace_ffi == RustFfiHtmlNamespace::Other && context_namespace.has_value())
         context_namespace_uri = context_namespace->bytes_as_string_view();
     Vector<RustFfiHtmlParserAttribute> context_attributes;
-    if (auto attributes = context_element.attributes()) {
+    if (auto attributes = context_element.existing_attributes()) {
         context_attributes.ensure_capacity(attributes->length());
         for (size_t i = 0; i < attributes->length(); ++i) {
             auto const* attribute = attributes->item(i);
@@ -6,6 +6,7 @@
 
 #include <AK/Assertions.h>
 #include <AK/FFIHelpers.h>
+#include <LibCore/EventLoop.h>
 #include <LibJS/Runtime/Realm.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/Fetch/Fetching/Fetching.h>
@@ -17,11 +18,20 @@
 #include <LibWeb/HTML/PotentialCORSRequest.h>
 #include <LibWeb/HTML/Scripting/Environments.h>
 #include <LibWeb/HTMLTokenizerRustFFI.h>
+#include <LibThreading/ThreadPool.h>
+#include <LibWeb/Loader/ResourceLoader.h>
 
 namespace Web::HTML {
 
 GC_DEFINE_ALLOCATOR(SpeculativeHTMLParser);
 
+struct SpeculativeHTMLParser::ScannedEntry {
+    RustFfiPreloadScannerAction action;
+    RustFfiPreloadScannerDestination destination;
+    RustFfiPreloadScannerCorsSetting cors_setting;
+    ByteString url;
+};
+
 GC::Ref<SpeculativeHTMLParser> SpeculativeHTMLParser::create(JS::Realm& realm, GC::Ref<DOM::Document> document, String pending_input, URL::URL base_url)
 {
     return realm.create<SpeculativeHTMLParser>(document, move(pending_input), move(base_url));
@@ -34,7 +44,13 @@ SpeculativeHTMLParser::SpeculativeHTMLParser(GC::Ref<DOM::Document> document, St
 {
 }
 
-SpeculativeHTMLParser::~SpeculativeHTMLParser() = default;
+SpeculativeHTMLParser::~SpeculativeHTMLParser()
+{
+    if (m_scan_job) {
+        m_scan_job->parser = nullptr;
+        m_scan_job->stopped = true;
+    }
+}
 
 void SpeculativeHTMLParser::visit_edges(JS::Cell::Visitor& visitor)
 {
@@ -48,28 +64,74 @@ void SpeculativeHTMLParser::stop()
     // 3. Throw away any pending content in speculativeParser's input stream, and discard any future content
     //    that would have been added to it.
     m_stopped = true;
+    if (m_scan_job) {
+        m_scan_job->parser = nullptr;
+        m_scan_job->stopped = true;
+        m_scan_job = nullptr;
+    }
 }
 
 void SpeculativeHTMLParser::run()
 {
-    if (m_stopped)
+    if (m_stopped || m_scan_job)
         return;
 
-    auto input = m_input.bytes_as_string_view();
-    auto* bytes = reinterpret_cast<u8 const*>(input.characters_without_null_termination());
-    if (bytes == nullptr)
-        bytes = reinterpret_cast<u8 const*>("");
-
-    rust_html_preload_scanner_scan(bytes, input.length(), this, [](void* context, RustFfiPreloadScannerEntry const* entry) -> bool {
-        auto& parser = *static_cast<SpeculativeHTMLParser*>(context);
-        if (parser.m_stopped || entry == nullptr)
-            return false;
-
-        parser.process_preload_scanner_entry(*entry);
-        return !parser.m_stopped;
+    // The scan works on its own copy of the input, since the String we were given isn't safe to share across threads.
+    auto input = ByteBuffer::copy(m_input.bytes());
+    if (input.is_error())
+        return;
+    m_input = {};
+
+    auto job = adopt_ref(*new ScanJob);
+    job->parser = this;
+    job->input = input.release_value();
+    m_scan_job = job;
+
+    Threading::ThreadPool::the().submit([job, event_loop_weak = Core::EventLoop::current_weak()] {
+        Vector<ScannedEntry> entries;
+        auto bytes = job->input.bytes();
+        auto* data = bytes.data() ? bytes.data() : reinterpret_cast<u8 const*>("");
+
+        struct Context {
+            ScanJob& job;
+            Vector<ScannedEntry>& entries;
+        } context { *job, entries };
+
+        rust_html_preload_scanner_scan(data, bytes.size(), &context, [](void* context_ptr, RustFfiPreloadScannerEntry const* entry) -> bool {
+            auto& context = *static_cast<Context*>(context_ptr);
+            if (context.job.stopped || entry == nullptr)
+                return false;
+
+            auto url = ffi_string_view(entry->url_ptr, entry->url_len);
+            if (!url.is_empty())
+                context.entries.append({ entry->action, entry->destination, entry->cors_setting, url.to_byte_string() });
+            return !context.job.stopped;
+        });
+
+        if (job->stopped)
+            return;
+
+        auto event_loop = event_loop_weak->take();
+        if (!event_loop)
+            return;
+        event_loop->deferred_invoke([job, entries = move(entries)] {
+            if (!job->parser)
+                return;
+            job->parser->process_preload_scanner_entries(entries);
+        });
     });
 }
 
+void SpeculativeHTMLParser::process_preload_scanner_entries(Vector<ScannedEntry> const& entries)
+{
+    for (auto const& entry : entries) {
+        if (m_stopped)
+            return;
+        process_preload_scanner_entry(entry);
+    }
+    m_scan_job = nullptr;
+}
+
 namespace {
 
 Optional<Fetch::Infrastructure::Request::Destination> destination_from_preload_scanner(RustFfiPreloadScannerDestination destination)
@@ -120,11 +182,9 @@ void issue_speculative_fetch(JS::Realm& realm, DOM::Document& document, URL::URL
 
 }
 
-void SpeculativeHTMLParser::process_preload_scanner_entry(RustFfiPreloadScannerEntry const& entry)
+void SpeculativeHTMLParser::process_preload_scanner_entry(ScannedEntry const& entry)
 {
-    auto url_string = ffi_string_view(entry.url_ptr, entry.url_len);
-    if (url_string.is_empty())
-        return;
+    auto url_string = entry.url.view();
 
     // https://html.spec.whatwg.org/multipage/parsing.html#speculative-fetch
     switch (entry.action) {
@@ -160,6 +220,12 @@ void SpeculativeHTMLParser::process_preload_scanner_entry(RustFfiPreloadScannerE
     // 4. Otherwise, fetch url as if the element was processed normally, and add url to the list of
     //    speculative fetch URLs.
     m_document->add_speculative_fetch_url(*url);
+
+    // Subresources on other origins need a DNS lookup of their own. Start it now, so it overlaps with the fetch making
+    // its way to RequestServer. RequestServer drops repeated hints for an origin.
+    if (!url->origin().is_same_origin(m_document->origin()))
+        ResourceLoader::the().prefetch_dns(*url, m_document->url());
+
     issue_speculative_fetch(m_document->realm(), *m_document, *url, destination_from_preload_scanner(entry.destination), cors_setting_from_preload_scanner(entry.cors_setting));
 }
 
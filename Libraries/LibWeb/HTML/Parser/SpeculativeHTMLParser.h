@@ -6,17 +6,21 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteBuffer.h>
 #include <AK/String.h>
+#include <AK/Vector.h>
 #include <LibGC/Ptr.h>
 #include <LibJS/Heap/Cell.h>
 #include <LibURL/URL.h>
 #include <LibWeb/Forward.h>
 
-struct RustFfiPreloadScannerEntry;
-
 namespace Web::HTML {
 
 // https://html.spec.whatwg.org/multipage/parsing.html#speculative-html-parser
+// The preload scanner doesn't touch the DOM or the GC heap, so it scans a copy of the unparsed input on the thread pool
+// while the main thread keeps going. The fetch candidates it finds are handed back to the main thread in one batch.
 class SpeculativeHTMLParser final : public JS::Cell {
     GC_CELL(SpeculativeHTMLParser, JS::Cell);
     GC_DECLARE_ALLOCATOR(SpeculativeHTMLParser);
@@ -33,11 +37,23 @@ private:
     SpeculativeHTMLParser(GC::Ref<DOM::Document>, String pending_input, URL::URL base_url);
     virtual void visit_edges(JS::Cell::Visitor&) override;
 
-    void process_preload_scanner_entry(RustFfiPreloadScannerEntry const&);
+    struct ScannedEntry;
+
+    // Shared with the thread pool. Only the main thread touches `parser`, which is cleared once the parser is stopped
+    // or collected, so that late results are dropped.
+    struct ScanJob : public AtomicRefCounted<ScanJob> {
+        SpeculativeHTMLParser* parser { nullptr };
+        ByteBuffer input;
+        Atomic<bool> stopped { false };
+    };
+
+    void process_preload_scanner_entries(Vector<ScannedEntry> const&);
+    void process_preload_scanner_entry(ScannedEntry const&);
 
     GC::Ref<DOM::Document> m_document;
     String m_input;
     URL::URL m_base_url;
+    RefPtr<ScanJob> m_scan_job;
     bool m_stopped { false };
 };
 
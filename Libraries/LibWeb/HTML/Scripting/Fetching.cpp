@@ -337,38 +337,44 @@ static void prepare_bytecode_cache_off_thread(Core::ImmutableBytes bytecode, JS:
     });
 }
 
-// Submit parsing and top-level bytecode generation to the thread pool, then bounce back to the main thread via
-// deferred_invoke once the worker is done. Syntax errors still come back as a ParsedProgram so the main thread can
-// report them through the same Script/ModuleScript construction paths; successful programs come back as CompiledProgram
-// artifacts whose GC-backed Executable materialization must still happen on the main thread.
-// NB: The SourceCode stays on the main thread inside the heap-allocated callback. The worker thread only receives raw
-//     UTF-16 data pointers.
-static void compile_off_thread(NonnullRefPtr<JS::SourceCode const> source_code, JS::RustIntegration::ProgramType type, size_t line_number_offset, Function<void(OffThreadCompiledProgram, NonnullRefPtr<JS::SourceCode const>)> on_compiled)
+// Submit decoding, parsing and top-level bytecode generation to the thread pool, then bounce back to the main thread
+// via deferred_invoke once the worker is done. Decoding a multi-megabyte bundle to UTF-16 takes several passes over the
+// text, so it happens on the worker too rather than stalling the main thread before the parse can even start.
+// Syntax errors still come back as a ParsedProgram so the main thread can report them through the same
+// Script/ModuleScript construction paths; successful programs come back as CompiledProgram artifacts whose GC-backed
+// Executable materialization must still happen on the main thread.
+// NB: The body bytes stay alive on the main thread inside the heap-allocated callback; the worker thread only receives
+//     a raw view of them. The SourceCode is created on the worker and handed over to the main thread along with the
+//     result, so it is never referenced from both threads at once.
+static void decode_and_compile_off_thread(String filename, Core::ImmutableBytes source_bytes, TextCodec::Decoder& decoder, JS::RustIntegration::ProgramType type, size_t line_number_offset, Function<void(OffThreadCompiledProgram, NonnullRefPtr<JS::SourceCode const>)> on_compiled)
 {
-    // Extract the raw data the parser needs while still on the main thread.
-    auto const* utf16_data = source_code->utf16_data();
-    auto length = source_code->length_in_code_units();
+    auto source_bytes_view = source_bytes.bytes();
 
-    // Capture source_code in the callback so it stays alive on the main thread and is available for materialization.
-    auto* callback = new Function<void(OffThreadCompiledProgram)>(
-        [on_compiled = move(on_compiled), source_code = move(source_code)](OffThreadCompiledProgram result) mutable {
+    // Capture the body bytes in the callback so they stay alive on the main thread until the worker is done with them.
+    auto* callback = new Function<void(OffThreadCompiledProgram, NonnullRefPtr<JS::SourceCode const>)>(
+        [on_compiled = move(on_compiled), source_bytes = move(source_bytes)](OffThreadCompiledProgram result, NonnullRefPtr<JS::SourceCode const> source_code) mutable {
             on_compiled(result, move(source_code));
         });
 
     auto& main_thread_event_loop = Core::EventLoop::current();
 
-    Threading::ThreadPool::the().submit([utf16_data, length, type, line_number_offset,
+    Threading::ThreadPool::the().submit([filename = move(filename), source_bytes_view, &decoder, type, line_number_offset,
                                             callback,
-                                            &main_thread_event_loop]() {
-        auto* parsed = JS::RustIntegration::parse_program(utf16_data, length, type, line_number_offset);
+                                            &main_thread_event_loop]() mutable {
+        auto source_code = JS::SourceCode::create(
+            move(filename),
+            Utf16String::from_utf8(decode_source_text(decoder, source_bytes_view).release_value_but_fixme_should_propagate_errors()));
+
+        auto length = source_code->length_in_code_units();
+        auto* parsed = JS::RustIntegration::parse_program(source_code->utf16_data(), length, type, line_number_offset);
         OffThreadCompiledProgram result { .parsed = parsed };
         if (parsed && !JS::RustIntegration::parsed_program_has_errors(parsed)) {
             result.compiled = JS::RustIntegration::compile_parsed_program_off_thread(parsed, length);
             result.parsed = nullptr;
         }
 
-        main_thread_event_loop.deferred_invoke([result, callback]() {
-            (*callback)(result);
+        main_thread_event_loop.deferred_invoke([result, source_code = move(source_code), callback]() mutable {
+            (*callback)(result, move(source_code));
             delete callback;
             // AD-HOC: Perform a microtask checkpoint so that any microtasks queued by the callback (e.g. promise
             //         reactions from react_to_promise during module linking) are drained. Without this, module worker
@@ -729,7 +735,6 @@ void fetch_classic_script(GC::Ref<HTMLScriptElement> element, URL::URL const& ur
         auto source_byte_storage = body_bytes.template get<Core::ImmutableBytes>();
         auto source_bytes = source_byte_storage.bytes();
         auto const& bytecode = response->javascript_bytecode_cache();
-        Optional<NonnullRefPtr<JS::SourceCode const>> source_code;
         auto bytecode_cache_context = bytecode_cache_context_for_request(*request, *response, response_url);
         Optional<BytecodeCacheSourceHash> source_hash;
         if (bytecode.has_value() || bytecode_cache_context.has_value())
@@ -764,15 +769,10 @@ void fetch_classic_script(GC::Ref<HTMLScriptElement> element, URL::URL const& ur
                         source_code = {};
                     }
 
-                    if (!source_code.has_value()) {
-                        auto fallback_decoder = TextCodec::decoder_for(source_encoding);
-                        VERIFY(fallback_decoder.has_value());
-                        source_code = JS::SourceCode::create(
-                            String::from_utf8(response_url_string.view()).release_value_but_fixme_should_propagate_errors(),
-                            Utf16String::from_utf8(decode_source_text(*fallback_decoder, source_byte_storage.bytes()).release_value_but_fixme_should_propagate_errors()));
-                    }
+                    auto fallback_decoder = TextCodec::decoder_for(source_encoding);
+                    VERIFY(fallback_decoder.has_value());
 
-                    compile_off_thread(source_code.release_value(), JS::RustIntegration::ProgramType::Script, 1,
+                    decode_and_compile_off_thread(String::from_utf8(response_url_string.view()).release_value_but_fixme_should_propagate_errors(), move(source_byte_storage), *fallback_decoder, JS::RustIntegration::ProgramType::Script, 1,
                         [response_url = move(response_url), response_url_string = move(response_url_string),
                             bytecode_cache_context = move(bytecode_cache_context),
                             source_hash = move(source_hash),
@@ -802,13 +802,7 @@ void fetch_classic_script(GC::Ref<HTMLScriptElement> element, URL::URL const& ur
             return;
         }
 
-        if (!source_code.has_value()) {
-            source_code = JS::SourceCode::create(
-                String::from_utf8(response_url_string.view()).release_value_but_fixme_should_propagate_errors(),
-                Utf16String::from_utf8(decode_source_text(*fallback_decoder, source_bytes).release_value_but_fixme_should_propagate_errors()));
-        }
-
-        compile_off_thread(source_code.release_value(), JS::RustIntegration::ProgramType::Script, 1,
+        decode_and_compile_off_thread(String::from_utf8(response_url_string.view()).release_value_but_fixme_should_propagate_errors(), move(source_byte_storage), *fallback_decoder, JS::RustIntegration::ProgramType::Script, 1,
             [response_url = move(response_url), response_url_string = move(response_url_string),
                 bytecode_cache_context = move(bytecode_cache_context),
                 source_hash = move(source_hash),
@@ -1177,7 +1171,6 @@ void fetch_single_module_script(JS::Realm& realm,
                 auto source_byte_storage = body_bytes.get<Core::ImmutableBytes>();
                 auto source_bytes = source_byte_storage.bytes();
                 auto const& bytecode = internal_response->javascript_bytecode_cache();
-                Optional<NonnullRefPtr<JS::SourceCode const>> source_code;
                 auto bytecode_cache_context = bytecode_cache_context_for_request(*request, *internal_response, response_url);
                 Optional<BytecodeCacheSourceHash> source_hash;
                 if (bytecode.has_value() || bytecode_cache_context.has_value())
@@ -1209,15 +1202,10 @@ void fetch_single_module_script(JS::Realm& realm,
                                 source_code = {};
                             }
 
-                            if (!source_code.has_value()) {
-                                auto fallback_decoder = TextCodec::decoder_for("UTF-8"sv);
-                                VERIFY(fallback_decoder.has_value());
-                                source_code = JS::SourceCode::create(
-                                    String::from_utf8(url_string.view()).release_value_but_fixme_should_propagate_errors(),
-                                    Utf16String::from_utf8(decode_source_text(*fallback_decoder, source_byte_storage.bytes()).release_value_but_fixme_should_propagate_errors()));
-                            }
+                            auto fallback_decoder = TextCodec::decoder_for("UTF-8"sv);
+                            VERIFY(fallback_decoder.has_value());
 
-                            compile_off_thread(source_code.release_value(), JS::RustIntegration::ProgramType::Module, 0,
+                            decode_and_compile_off_thread(String::from_utf8(url_string.view()).release_value_but_fixme_should_propagate_errors(), move(source_byte_storage), *fallback_decoder, JS::RustIntegration::ProgramType::Module, 0,
                                 [url = move(url), url_string = move(url_string), response_url = move(response_url),
                                     module_type_string = move(module_type_string),
                                     bytecode_cache_context = move(bytecode_cache_context),
@@ -1251,13 +1239,7 @@ void fetch_single_module_script(JS::Realm& realm,
                     return;
                 }
 
-                if (!source_code.has_value()) {
-                    source_code = JS::SourceCode::create(
-                        String::from_utf8(url_string.view()).release_value_but_fixme_should_propagate_errors(),
-                        Utf16String::from_utf8(decode_source_text(*decoder, source_bytes).release_value_but_fixme_should_propagate_errors()));
-                }
-
-                compile_off_thread(source_code.release_value(), JS::RustIntegration::ProgramType::Module, 0,
+                decode_and_compile_off_thread(String::from_utf8(url_string.view()).release_value_but_fixme_should_propagate_errors(), move(source_byte_storage), *decoder, JS::RustIntegration::ProgramType::Module, 0,
                     [url = move(url), url_string = move(url_string), response_url = move(response_url),
                         module_type_string = move(module_type_string),
                         bytecode_cache_context = move(bytecode_cache_context),
@@ -62,6 +62,7 @@ void SharedResourceRequest::finalize()
     m_callbacks.clear();
     m_load_event_delayer.clear();
     m_image_data = nullptr;
+    m_partial_image_data = nullptr;
     m_fetch_controller = nullptr;
 
     if (m_document) {
@@ -82,8 +83,10 @@ void SharedResourceRequest::visit_edges(JS::Cell::Visitor& visitor)
     for (auto& callback : m_callbacks) {
         visitor.visit(callback.on_finish);
         visitor.visit(callback.on_fail);
+        visitor.visit(callback.on_partial_image);
     }
     visitor.visit(m_image_data);
+    visitor.visit(m_partial_image_data);
 }
 
 GC::Ptr<DecodedImageData> SharedResourceRequest::image_data() const
@@ -147,7 +150,23 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infr
             return;
         }
 
-        response->body()->fully_read(realm, process_body, process_body_error, GC::Ref { realm.global_object() });
+        auto extracted_mime_type = Fetch::Infrastructure::extract_mime_type(response->header_list());
+        auto mime_type = extracted_mime_type.has_value() ? extracted_mime_type.value().essence().bytes_as_string_view() : StringView {};
+        if (is_svg_image(request->url(), mime_type)) {
+            response->body()->fully_read(realm, process_body, process_body_error, GC::Ref { realm.global_object() });
+            return;
+        }
+
+        // AD-HOC: Bitmap images are decoded while their data arrives, so that what has loaded so far can be shown.
+        auto process_body_chunk = GC::create_function(self->heap(), [weak_this](ByteBuffer chunk) {
+            if (auto self = weak_this.ptr())
+                self->handle_image_data_chunk(move(chunk));
+        });
+        auto process_end_of_body = GC::create_function(self->heap(), [weak_this] {
+            if (auto self = weak_this.ptr())
+                self->handle_end_of_image_data();
+        });
+        response->body()->incrementally_read(process_body_chunk, process_end_of_body, process_body_error, GC::Ref { realm.global_object() });
     };
 
     m_state = State::Fetching;
@@ -161,7 +180,7 @@ void SharedResourceRequest::fetch_resource(JS::Realm& realm, GC::Ref<Fetch::Infr
     set_fetch_controller(fetch_controller);
 }
 
-void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail)
+void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial_image)
 {
     if (m_state == State::Finished) {
         if (on_finish)
@@ -180,8 +199,20 @@ void SharedResourceRequest::add_callbacks(Function<void()> on_finish, Function<v
         callbacks.on_finish = GC::create_function(vm().heap(), move(on_finish));
     if (on_fail)
         callbacks.on_fail = GC::create_function(vm().heap(), move(on_fail));
+    if (on_partial_image)
+        callbacks.on_partial_image = GC::create_function(vm().heap(), move(on_partial_image));
 
+    auto partial_image_callback = callbacks.on_partial_image;
     m_callbacks.append(move(callbacks));
+
+    if (m_partial_image_data && partial_image_callback)
+        partial_image_callback->function()();
+}
+
+bool SharedResourceRequest::is_svg_image(URL::URL const& url, StringView mime_type)
+{
+    return mime_type == "image/svg+xml"sv
+        || (mime_type.is_empty() && url.basename().ends_with(".svg"sv));
 }
 
 void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string, StringView mime_type, ByteBuffer data)
@@ -189,10 +220,7 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
     // AD-HOC: At this point, things gets very ad-hoc.
     // FIXME: Bring this closer to spec.
 
-    bool const is_svg_image = mime_type == "image/svg+xml"sv
-        || (mime_type.is_empty() && url_string.basename().ends_with(".svg"sv));
-
-    if (is_svg_image) {
+    if (is_svg_image(url_string, mime_type)) {
         auto result = SVG::SVGDecodedImageData::create(m_document->realm(), m_page, url_string, data);
         if (result.is_error()) {
             handle_failed_fetch();
@@ -204,37 +232,7 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
     }
 
     auto handle_successful_bitmap_decode = [strong_this = GC::Root(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
-        if (result.session_id != 0) {
-            // Streaming animated decode: create AnimatedDecodedImageData.
-            Vector<NonnullRefPtr<Gfx::Bitmap>> initial_bitmaps;
-            initial_bitmaps.ensure_capacity(result.frames.size());
-            for (auto& frame : result.frames)
-                initial_bitmaps.unchecked_append(*frame.bitmap);
-
-            auto first_bitmap = result.frames.first().bitmap;
-            auto size = first_bitmap->size();
-
-            strong_this->m_image_data = AnimatedDecodedImageData::create(
-                strong_this->m_document->realm(),
-                result.session_id,
-                result.frame_count,
-                result.loop_count,
-                size,
-                move(result.color_space),
-                move(result.all_durations),
-                move(initial_bitmaps));
-        } else {
-            // Single-shot decode: create BitmapDecodedImageData as before.
-            Vector<BitmapDecodedImageData::Frame> frames;
-            for (auto& frame : result.frames) {
-                frames.append(BitmapDecodedImageData::Frame {
-                    .frame = Gfx::DecodedImageFrame { *frame.bitmap, result.color_space },
-                    .duration = static_cast<int>(frame.duration),
-                });
-            }
-            strong_this->m_image_data = BitmapDecodedImageData::create(strong_this->m_document->realm(), move(frames), result.loop_count, result.is_animated).release_value_but_fixme_should_propagate_errors();
-        }
-        strong_this->handle_successful_resource_load();
+        strong_this->handle_successful_image_decode(result);
         return {};
     };
 
@@ -245,9 +243,112 @@ void SharedResourceRequest::handle_successful_fetch(URL::URL const& url_string,
     (void)Web::Platform::ImageCodecPlugin::the().decode_image(data.bytes(), move(handle_successful_bitmap_decode), move(handle_failed_decode));
 }
 
+void SharedResourceRequest::handle_image_data_chunk(ByteBuffer chunk)
+{
+    if (m_state != State::Fetching || chunk.is_empty())
+        return;
+
+    auto& image_codec_plugin = Web::Platform::ImageCodecPlugin::the();
+
+    // NB: The decode starts with the first chunk, so that an empty body fails without involving the decoder.
+    if (!m_incremental_decode_id.has_value()) {
+        m_incremental_decode_id = image_codec_plugin.begin_incremental_decode(
+            [strong_this = GC::Root(*this)](NonnullRefPtr<Gfx::Bitmap> bitmap) {
+                strong_this->handle_partial_image(move(bitmap));
+            },
+            [strong_this = GC::Root(*this)](Web::Platform::DecodedImage& result) -> ErrorOr<void> {
+                strong_this->m_incremental_decode_id = {};
+                strong_this->handle_successful_image_decode(result);
+                return {};
+            },
+            [strong_this = GC::Root(*this)](Error&) {
+                strong_this->m_incremental_decode_id = {};
+                strong_this->handle_failed_fetch();
+            });
+
+        if (!m_incremental_decode_id.has_value())
+            return;
+    }
+
+    image_codec_plugin.append_incremental_decode_data(*m_incremental_decode_id, chunk);
+}
+
+void SharedResourceRequest::handle_end_of_image_data()
+{
+    if (m_state != State::Fetching)
+        return;
+
+    if (!m_incremental_decode_id.has_value()) {
+        handle_failed_fetch();
+        return;
+    }
+
+    Web::Platform::ImageCodecPlugin::the().finish_incremental_decode(*m_incremental_decode_id);
+}
+
+void SharedResourceRequest::handle_partial_image(NonnullRefPtr<Gfx::Bitmap> bitmap)
+{
+    if (m_state != State::Fetching)
+        return;
+
+    // NB: Partial images aren't color managed; the finished image is.
+    Vector<BitmapDecodedImageData::Frame> frames;
+    frames.append(BitmapDecodedImageData::Frame { .frame = Gfx::DecodedImageFrame { move(bitmap) } });
+    auto image_data_or_error = BitmapDecodedImageData::create(m_document->realm(), move(frames), 0, false);
+    if (image_data_or_error.is_error())
+        return;
+    m_partial_image_data = image_data_or_error.release_value();
+
+    for (auto& callback : m_callbacks) {
+        if (callback.on_partial_image)
+            callback.on_partial_image->function()();
+    }
+}
+
+void SharedResourceRequest::handle_successful_image_decode(Web::Platform::DecodedImage& result)
+{
+    if (result.session_id != 0) {
+        // Streaming animated decode: create AnimatedDecodedImageData.
+        Vector<NonnullRefPtr<Gfx::Bitmap>> initial_bitmaps;
+        initial_bitmaps.ensure_capacity(result.frames.size());
+        for (auto& frame : result.frames)
+            initial_bitmaps.unchecked_append(*frame.bitmap);
+
+        auto first_bitmap = result.frames.first().bitmap;
+        auto size = first_bitmap->size();
+
+        m_image_data = AnimatedDecodedImageData::create(
+            m_document->realm(),
+            result.session_id,
+            result.frame_count,
+            result.loop_count,
+            size,
+            move(result.color_space),
+            move(result.all_durations),
+            move(initial_bitmaps));
+    } else {
+        // Single-shot decode: create BitmapDecodedImageData as before.
+        Vector<BitmapDecodedImageData::Frame> frames;
+        for (auto& frame : result.frames) {
+            frames.append(BitmapDecodedImageData::Frame {
+                .frame = Gfx::DecodedImageFrame { *frame.bitmap, result.color_space },
+                .duration = static_cast<int>(frame.duration),
+            });
+        }
+        m_image_data = BitmapDecodedImageData::create(m_document->realm(), move(frames), result.loop_count, result.is_animated).release_value_but_fixme_should_propagate_errors();
+    }
+    handle_successful_resource_load();
+}
+
 void SharedResourceRequest::handle_failed_fetch()
 {
+    if (auto decode_id = m_incremental_decode_id; decode_id.has_value()) {
+        m_incremental_decode_id = {};
+        Web::Platform::ImageCodecPlugin::the().cancel_incremental_decode(*decode_id);
+    }
+
     m_state = State::Failed;
+    m_partial_image_data = nullptr;
     m_load_event_delayer.clear();
     m_fetch_controller = nullptr;
     for (auto& callback : m_callbacks) {
@@ -260,6 +361,7 @@ void SharedResourceRequest::handle_failed_fetch()
 void SharedResourceRequest::handle_successful_resource_load()
 {
     m_state = State::Finished;
+    m_partial_image_data = nullptr;
     m_load_event_delayer.clear();
     m_fetch_controller = nullptr;
     for (auto& callback : m_callbacks) {
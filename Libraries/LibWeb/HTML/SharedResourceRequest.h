@@ -29,6 +29,8 @@ public:
     URL::URL const& url() const { return m_url; }
 
     [[nodiscard]] GC::Ptr<DecodedImageData> image_data() const;
+    // What has been decoded while the image is still loading, if anything. This goes away once it has loaded.
+    [[nodiscard]] GC::Ptr<DecodedImageData> partial_image_data() const { return m_partial_image_data; }
     [[nodiscard]] bool can_be_pruned_from_memory_cache() const { return m_image_data; }
     [[nodiscard]] u64 cache_touch_serial() const { return m_cache_touch_serial; }
     void touch_memory_cache_entry();
@@ -38,7 +40,7 @@ public:
 
     void fetch_resource(JS::Realm&, GC::Ref<Fetch::Infrastructure::Request>);
 
-    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail);
+    void add_callbacks(Function<void()> on_finish, Function<void()> on_fail, Function<void()> on_partial_image = {});
 
     bool is_fetching() const;
     bool needs_fetching() const;
@@ -49,7 +51,13 @@ private:
     virtual void finalize() override;
     virtual void visit_edges(JS::Cell::Visitor&) override;
 
+    static bool is_svg_image(URL::URL const&, StringView mime_type);
+
     void handle_successful_fetch(URL::URL const&, StringView mime_type, ByteBuffer data);
+    void handle_image_data_chunk(ByteBuffer);
+    void handle_end_of_image_data();
+    void handle_partial_image(NonnullRefPtr<Gfx::Bitmap>);
+    void handle_successful_image_decode(Platform::DecodedImage&);
     void handle_failed_fetch();
     void handle_successful_resource_load();
 
@@ -67,11 +75,14 @@ private:
     struct Callbacks {
         GC::Ptr<GC::Function<void()>> on_finish;
         GC::Ptr<GC::Function<void()>> on_fail;
+        GC::Ptr<GC::Function<void()>> on_partial_image;
     };
     Vector<Callbacks> m_callbacks;
 
     URL::URL m_url;
     GC::Ptr<DecodedImageData> m_image_data;
+    GC::Ptr<DecodedImageData> m_partial_image_data;
+    Optional<i64> m_incremental_decode_id;
     GC::Ptr<Fetch::Infrastructure::FetchController> m_fetch_controller;
     u64 m_cache_touch_serial { 0 };
 
@@ -252,6 +252,38 @@ void Storage::broadcast(Optional<String> const& key, Optional<String> const& old
             as<Window>(relevant_global_object(remote_storage)).dispatch_event(StorageEvent::create(realm, EventNames::storage, init));
         }));
     }
+
+    // AD-HOC: Windows in other processes see the same local storage area, so they have to get the event as well.
+    if (type() == Type::Local) {
+        auto const& storage_key = as<StorageAPI::LocalStorageBottle>(*m_storage_bottle).serialized_storage_key();
+        as<Window>(relevant_global).page().client().page_did_broadcast_local_storage_change(storage_key, key, old_value, new_value, url);
+    }
+}
+
+void Storage::deliver_local_storage_change_locally(String const& storage_key, Optional<String> const& key, Optional<String> const& old_value, Optional<String> const& new_value, String const& url)
+{
+    Window::for_each_active([&](auto& window) {
+        // NB: Only windows whose storage key matches share the changed area, as in step 3 of broadcast.
+        auto window_storage_key = StorageAPI::obtain_a_storage_key(relevant_settings_object(window));
+        if (!window_storage_key.has_value() || window_storage_key->to_string() != storage_key)
+            return IterationDecision::Continue;
+
+        auto storage = obtain_storage_for_window(window, Type::Local);
+        if (!storage)
+            return IterationDecision::Continue;
+
+        queue_global_task(Task::Source::DOMManipulation, window, GC::create_function(window.heap(), [key, old_value, new_value, url, storage = GC::Ref { *storage }] {
+            Bindings::StorageEventInit init;
+            init.key = key;
+            init.old_value = old_value;
+            init.new_value = new_value;
+            init.url = url;
+            init.storage_area = storage;
+            auto& target_window = as<Window>(relevant_global_object(storage));
+            target_window.dispatch_event(StorageEvent::create(target_window.realm(), EventNames::storage, init));
+        }));
+        return IterationDecision::Continue;
+    });
 }
 
 Vector<FlyString> Storage::supported_property_names() const
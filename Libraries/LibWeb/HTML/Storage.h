@@ -41,6 +41,9 @@ public:
 
     void dump() const;
 
+    // Fires storage events for a change that a window in another process made to a local storage area.
+    static void deliver_local_storage_change_locally(String const& storage_key, Optional<String> const& key, Optional<String> const& old_value, Optional<String> const& new_value, String const& url);
+
 private:
     Storage(JS::Realm&, Type, GC::Ref<StorageAPI::StorageBottle>);
 
@@ -10,6 +10,7 @@
 #include <AK/StdLibExtras.h>
 #include <AK/String.h>
 #include <LibCrypto/BigInt/UnsignedBigInteger.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibIPC/File.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibJS/Runtime/ArrayBuffer.h>
@@ -69,6 +70,10 @@
 
 namespace Web::HTML {
 
+// Transferred ArrayBuffers at least this large are copied into shared memory once, instead of into the message and
+// then through the IPC socket.
+static constexpr size_t transferred_array_buffer_shared_memory_threshold = 64 * KiB;
+
 enum class ValueTag : u8 {
     Empty, // Unused, for ease of catching bugs.
 
@@ -1049,15 +1054,13 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
         // 4. If transferable has an [[ArrayBufferData]] internal slot, then:
         if (array_buffer) {
             // 1. If transferable has an [[ArrayBufferMaxByteLength]] internal slot, then:
-            auto buffer_data = MUST(ByteBuffer::copy(array_buffer->bytes()));
-
             if (!array_buffer->is_fixed_length()) {
                 // 1. Set dataHolder.[[Type]] to "ResizableArrayBuffer".
                 data_holder.encode(TransferType::ResizableArrayBuffer);
 
                 // 2. Set dataHolder.[[ArrayBufferData]] to transferable.[[ArrayBufferData]].
                 // 3. Set dataHolder.[[ArrayBufferByteLength]] to transferable.[[ArrayBufferByteLength]].
-                data_holder.encode(buffer_data);
+                data_holder.encode_transferred_array_buffer_data(array_buffer->bytes());
 
                 // 4. Set dataHolder.[[ArrayBufferMaxByteLength]] to transferable.[[ArrayBufferMaxByteLength]].
                 data_holder.encode(array_buffer->max_byte_length());
@@ -1069,7 +1072,7 @@ WebIDL::ExceptionOr<SerializedTransferRecord> structured_serialize_with_transfer
 
                 // 2. Set dataHolder.[[ArrayBufferData]] to transferable.[[ArrayBufferData]].
                 // 3. Set dataHolder.[[ArrayBufferByteLength]] to transferable.[[ArrayBufferByteLength]].
-                data_holder.encode(buffer_data);
+                data_holder.encode_transferred_array_buffer_data(array_buffer->bytes());
             }
 
             // 3. Perform ? DetachArrayBuffer(transferable).
@@ -1213,8 +1216,7 @@ WebIDL::ExceptionOr<JS::Value> structured_deserialize_with_transfer_internal(Tra
     //       [[ArrayBufferData]] is instead just getting transferred into the new ArrayBuffer. This could be true, for example,
     //       when both the source and target realms are in the same process.
     if (type == TransferType::ArrayBuffer) {
-        auto buffer = TRY(decoder.decode_buffer(target_realm));
-        value = JS::ArrayBuffer::create(target_realm, move(buffer));
+        value = TRY(decoder.decode_transferred_array_buffer(target_realm));
     }
 
     // 3. Otherwise, if transferDataHolder.[[Type]] is "ResizableArrayBuffer", then set value to a new ArrayBuffer object
@@ -1223,10 +1225,8 @@ WebIDL::ExceptionOr<JS::Value> structured_deserialize_with_transfer_internal(Tra
     //     [[ArrayBufferMaxByteLength]] internal slot value is transferDataHolder.[[ArrayBufferMaxByteLength]].
     // NOTE: For the same reason as the previous step, this step is also unlikely to throw an exception.
     else if (type == TransferType::ResizableArrayBuffer) {
-        auto buffer = TRY(decoder.decode_buffer(target_realm));
+        auto data = TRY(decoder.decode_transferred_array_buffer(target_realm));
         auto max_byte_length = decoder.decode<size_t>();
-
-        auto data = JS::ArrayBuffer::create(target_realm, move(buffer));
         data->set_max_byte_length(max_byte_length);
 
         value = data;
@@ -1353,6 +1353,21 @@ WebIDL::ExceptionOr<ByteBuffer> TransferDataDecoder::decode_buffer(JS::Realm& re
     return buffer.release_value();
 }
 
+void TransferDataEncoder::encode_transferred_array_buffer_data(ReadonlyBytes bytes)
+{
+    if (bytes.size() >= transferred_array_buffer_shared_memory_threshold) {
+        if (auto buffer = Core::AnonymousBuffer::create_with_size(bytes.size()); !buffer.is_error()) {
+            bytes.copy_to({ buffer.value().data<u8>(), bytes.size() });
+            encode(true);
+            encode(buffer.value());
+            return;
+        }
+    }
+
+    encode(false);
+    encode(bytes);
+}
+
 void TransferDataEncoder::encode_unsigned_big_integer(::Crypto::UnsignedBigInteger const& value)
 {
     auto buffer = MUST(ByteBuffer::create_zeroed(value.byte_length()));
@@ -1361,6 +1376,38 @@ void TransferDataEncoder::encode_unsigned_big_integer(::Crypto::UnsignedBigInteg
     encode(buffer);
 }
 
+WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> TransferDataDecoder::decode_transferred_array_buffer(JS::Realm& realm)
+{
+    auto fail = [&] { return WebIDL::DataCloneError::create(realm, "Unable to allocate memory for transferred buffer"_utf16); };
+
+    Optional<Core::AnonymousBuffer> shared_memory;
+    size_t size = 0;
+    if (decode<bool>()) {
+        auto buffer = m_decoder.decode<Core::AnonymousBuffer>();
+        if (buffer.is_error())
+            return fail();
+        shared_memory = buffer.release_value();
+        size = shared_memory->size();
+    } else {
+        auto decoded_size = m_decoder.decode_size();
+        if (decoded_size.is_error())
+            return fail();
+        size = decoded_size.value();
+    }
+
+    // The bytes are copied straight into the new ArrayBuffer's backing store, without an intermediate ByteBuffer.
+    auto backing_store = JS::DataBlock::OwnedBackingStore::create_uninitialized(size);
+    if (backing_store.is_error())
+        return fail();
+
+    if (shared_memory.has_value())
+        shared_memory->bytes().copy_to(backing_store.value().bytes());
+    else if (m_decoder.decode_into(backing_store.value().bytes()).is_error())
+        return fail();
+
+    return JS::ArrayBuffer::create(realm, JS::DataBlock { backing_store.release_value(), JS::DataBlock::Shared::No });
+}
+
 WebIDL::ExceptionOr<::Crypto::UnsignedBigInteger> TransferDataDecoder::decode_unsigned_big_integer(JS::Realm& realm)
 {
     auto buffer = TRY(decode_buffer(realm));
@@ -37,6 +37,10 @@ public:
 
     void encode_unsigned_big_integer(::Crypto::UnsignedBigInteger const&);
 
+    // Encodes the contents of a transferred ArrayBuffer. Large buffers are handed over in shared memory, so that they
+    // travel to another process as a file descriptor rather than being copied through the IPC socket.
+    void encode_transferred_array_buffer_data(ReadonlyBytes);
+
     void append(SerializationRecord&&);
     void extend(Vector<TransferDataEncoder>);
 
@@ -63,6 +67,7 @@ public:
 
     WebIDL::ExceptionOr<ByteBuffer> decode_buffer(JS::Realm&);
     WebIDL::ExceptionOr<::Crypto::UnsignedBigInteger> decode_unsigned_big_integer(JS::Realm&);
+    WebIDL::ExceptionOr<GC::Ref<JS::ArrayBuffer>> decode_transferred_array_buffer(JS::Realm&);
 
 private:
     IPC::MessageBuffer m_buffer;
@@ -244,7 +244,7 @@ static Optional<FlyString> record_namespace_information(DOM::Element const& elem
     Optional<FlyString> default_namespace_attribute_value;
 
     // 2. Main: For each attribute attr in element's attributes, in the order they are specified in the element's attribute list:
-    for (size_t attribute_index = 0; attribute_index < element.attributes()->length(); ++attribute_index) {
+    for (size_t attribute_index = 0; attribute_index < element.attribute_list_size(); ++attribute_index) {
         auto const* attribute = element.attributes()->item(attribute_index);
         VERIFY(attribute);
 
@@ -341,7 +341,7 @@ static WebIDL::ExceptionOr<String> serialize_element_attributes(DOM::Element con
     Vector<LocalNameSetEntry> local_name_set;
 
     // 3. Loop: For each attribute attr in element's attributes, in the order they are specified in the element's attribute list:
-    for (size_t attribute_index = 0; attribute_index < element.attributes()->length(); ++attribute_index) {
+    for (size_t attribute_index = 0; attribute_index < element.attribute_list_size(); ++attribute_index) {
         auto const* attribute = element.attributes()->item(attribute_index);
         VERIFY(attribute);
 
@@ -2003,7 +2003,7 @@ GC::Ref<JS::Array> retrieve_multiple_values_from_an_object_store(JS::Realm& real
 
     // 4. For each record of records:
     for (u32 i = 0; i < records.size(); ++i) {
-        auto& record = records[i];
+        auto const& record = records[i];
 
         // 1. Let serialized be record’s value. If an error occurs while reading the value from the underlying storage, return a newly created "NotReadableError" DOMException.
         auto const& serialized = *record.value;
@@ -2027,16 +2027,19 @@ GC::Ref<JS::Array> retrieve_multiple_items_from_an_object_store(JS::Realm& realm
         count = OptionalNone();
 
     // 2. Let records an empty list.
-    GC::ConservativeVector<ObjectStoreRecord> records;
+    ReadonlySpan<ObjectStoreRecord> records;
+    bool records_are_in_reverse_order = false;
 
     // 3. If direction is "next" or "nextunique", set records to the first count of store’s list of records whose key is in range.
     if (direction == Bindings::IDBCursorDirection::Next || direction == Bindings::IDBCursorDirection::Nextunique) {
-        records.extend(store->first_n_in_range(range, count));
+        records = store->first_n_in_range(range, count);
     }
 
     // 4. If direction is "prev" or "prevunique", set records to the last count of store’s list of records whose key is in range.
+    // NOTE: last_n_in_range() returns these in ascending key order, so we walk them from the end.
     if (direction == Bindings::IDBCursorDirection::Prev || direction == Bindings::IDBCursorDirection::Prevunique) {
-        records.extend(store->last_n_in_range(range, count));
+        records = store->last_n_in_range(range, count);
+        records_are_in_reverse_order = true;
     }
 
     // 5. Let list be an empty list.
@@ -2044,7 +2047,7 @@ GC::Ref<JS::Array> retrieve_multiple_items_from_an_object_store(JS::Realm& realm
 
     // 6. For each record of records, switching on kind:
     for (u32 i = 0; i < records.size(); ++i) {
-        auto& record = records[i];
+        auto const& record = records_are_in_reverse_order ? records[records.size() - 1 - i] : records[i];
 
         switch (kind) {
         case RecordKind::Key: {
@@ -2105,7 +2108,7 @@ GC::Ref<JS::Array> retrieve_multiple_keys_from_an_object_store(JS::Realm& realm,
 
     // 4. For each record of records:
     for (u32 i = 0; i < records.size(); ++i) {
-        auto& record = records[i];
+        auto const& record = records[i];
 
         // 1. Let entry be the result of converting a key to a value with record’s key.
         auto entry = convert_a_key_to_a_value(realm, record.key);
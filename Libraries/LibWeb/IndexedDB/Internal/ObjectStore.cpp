@@ -127,7 +127,7 @@ void ObjectStore::clear_records()
 {
     auto deleted_records = move(m_records);
     if (m_mutation_log && !deleted_records.is_empty())
-        m_mutation_log->note_records_deleted(deleted_records);
+        m_mutation_log->note_records_deleted(move(deleted_records));
 }
 
 // https://w3c.github.io/IndexedDB/#generate-a-key
@@ -179,33 +179,24 @@ void ObjectStore::possibly_update_the_key_generator(GC::Ref<Key> key)
     }
 }
 
-GC::ConservativeVector<ObjectStoreRecord> ObjectStore::first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
+ReadonlySpan<ObjectStoreRecord> ObjectStore::first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
 {
-    GC::ConservativeVector<ObjectStoreRecord> records;
     auto record_range = record_range_for_key_range(m_records, range);
-    for (size_t i = record_range.start; i < record_range.end; ++i) {
-        records.append(m_records[i]);
+    auto length = record_range.end - record_range.start;
+    if (count.has_value())
+        length = min(length, static_cast<size_t>(*count));
 
-        if (count.has_value() && records.size() >= *count)
-            break;
-    }
-
-    return records;
+    return m_records.span().slice(record_range.start, length);
 }
 
-GC::ConservativeVector<ObjectStoreRecord> ObjectStore::last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
+ReadonlySpan<ObjectStoreRecord> ObjectStore::last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count)
 {
-    GC::ConservativeVector<ObjectStoreRecord> records;
     auto record_range = record_range_for_key_range(m_records, range);
-    for (size_t i = record_range.end; i > record_range.start;) {
-        --i;
-        records.append(m_records[i]);
-
-        if (count.has_value() && records.size() >= *count)
-            break;
-    }
+    auto length = record_range.end - record_range.start;
+    if (count.has_value())
+        length = min(length, static_cast<size_t>(*count));
 
-    return records;
+    return m_records.span().slice(record_range.end - length, length);
 }
 
 }
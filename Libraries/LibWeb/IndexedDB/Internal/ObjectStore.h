@@ -56,8 +56,10 @@ public:
     u64 count_records_in_range(GC::Ref<IDBKeyRange> range);
     Optional<ObjectStoreRecord&> first_in_range(GC::Ref<IDBKeyRange> range);
     void clear_records();
-    GC::ConservativeVector<ObjectStoreRecord> first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
-    GC::ConservativeVector<ObjectStoreRecord> last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
+    // These return views into the list of records, in ascending key order, and are only valid until the store is next
+    // modified. Values are deserialized straight out of them, rather than out of a copy of every record in the range.
+    ReadonlySpan<ObjectStoreRecord> first_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
+    ReadonlySpan<ObjectStoreRecord> last_n_in_range(GC::Ref<IDBKeyRange> range, Optional<WebIDL::UnsignedLong> count);
 
     // https://w3c.github.io/IndexedDB/#generate-a-key
     ErrorOr<u64> generate_a_key();
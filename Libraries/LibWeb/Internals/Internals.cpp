@@ -9,6 +9,7 @@
 #include <AK/NumericLimits.h>
 #include <LibCore/TimeZone.h>
 #include <LibGfx/Cursor.h>
+#include <LibGfx/Font/Font.h>
 #include <LibHTTP/HSTS/ParsedHSTSPolicy.h>
 #include <LibJS/Runtime/AbstractOperations.h>
 #include <LibJS/Runtime/Date.h>
@@ -46,6 +47,7 @@
 #include <LibWeb/HTML/Window.h>
 #include <LibWeb/Internals/InternalGamepad.h>
 #include <LibWeb/Internals/Internals.h>
+#include <LibWeb/Layout/LayoutState.h>
 #include <LibWeb/Loader/ContentBlocker.h>
 #include <LibWeb/Loader/ResourceLoader.h>
 #include <LibWeb/Page/EventHandler.h>
@@ -737,6 +739,7 @@ JS::Object* Internals::get_style_invalidation_counters()
     object->define_direct_property("styleInvalidations"_utf16_fly_string, JS::Value(counters.style_invalidations), JS::default_attributes);
     object->define_direct_property("elementStyleRecomputations"_utf16_fly_string, JS::Value(counters.element_style_recomputations), JS::default_attributes);
     object->define_direct_property("elementStyleNoopRecomputations"_utf16_fly_string, JS::Value(counters.element_style_noop_recomputations), JS::default_attributes);
+    object->define_direct_property("sharedElementStyles"_utf16_fly_string, JS::Value(counters.shared_element_styles), JS::default_attributes);
     object->define_direct_property("elementInheritedStyleRecomputations"_utf16_fly_string, JS::Value(counters.element_inherited_style_recomputations), JS::default_attributes);
     object->define_direct_property("elementInheritedStyleNoopRecomputations"_utf16_fly_string, JS::Value(counters.element_inherited_style_noop_recomputations), JS::default_attributes);
     object->define_direct_property("previousSiblingInvalidationWalkVisits"_utf16_fly_string, JS::Value(counters.previous_sibling_invalidation_walk_visits), JS::default_attributes);
@@ -749,6 +752,55 @@ void Internals::reset_style_invalidation_counters()
     window().associated_document().reset_style_invalidation_counters();
 }
 
+JS::Object* Internals::get_layout_allocation_counters()
+{
+    auto const& counters = Layout::LayoutState::allocation_counters();
+    auto object = JS::Object::create(realm(), nullptr);
+    object->define_direct_property("layoutStates"_utf16_fly_string, JS::Value(counters.layout_states), JS::default_attributes);
+    object->define_direct_property("usedValues"_utf16_fly_string, JS::Value(counters.used_values), JS::default_attributes);
+    object->define_direct_property("usedValuesPages"_utf16_fly_string, JS::Value(counters.used_values_pages), JS::default_attributes);
+    object->define_direct_property("rareData"_utf16_fly_string, JS::Value(counters.rare_data), JS::default_attributes);
+    return object;
+}
+
+void Internals::reset_layout_allocation_counters()
+{
+    Layout::LayoutState::allocation_counters() = {};
+}
+
+JS::Object* Internals::get_text_shaping_cache_statistics()
+{
+    auto statistics = Gfx::Font::ShapingCache::statistics();
+    auto object = JS::Object::create(realm(), nullptr);
+    object->define_direct_property("hits"_utf16_fly_string, JS::Value(statistics.hits), JS::default_attributes);
+    object->define_direct_property("misses"_utf16_fly_string, JS::Value(statistics.misses), JS::default_attributes);
+    object->define_direct_property("evictions"_utf16_fly_string, JS::Value(statistics.evictions), JS::default_attributes);
+    object->define_direct_property("entries"_utf16_fly_string, JS::Value(statistics.entries), JS::default_attributes);
+    object->define_direct_property("sizeInBytes"_utf16_fly_string, JS::Value(statistics.size_in_bytes), JS::default_attributes);
+    return object;
+}
+
+void Internals::reset_text_shaping_cache_statistics()
+{
+    Gfx::Font::ShapingCache::reset_statistics();
+}
+
+JS::Object* Internals::get_regex_cache_statistics()
+{
+    auto statistics = vm().regexp_cache().statistics();
+    auto object = JS::Object::create(realm(), nullptr);
+    object->define_direct_property("hits"_utf16_fly_string, JS::Value(statistics.hits), JS::default_attributes);
+    object->define_direct_property("misses"_utf16_fly_string, JS::Value(statistics.misses), JS::default_attributes);
+    object->define_direct_property("evictions"_utf16_fly_string, JS::Value(statistics.evictions), JS::default_attributes);
+    object->define_direct_property("entries"_utf16_fly_string, JS::Value(statistics.entries), JS::default_attributes);
+    return object;
+}
+
+void Internals::reset_regex_cache_statistics()
+{
+    vm().regexp_cache().reset_statistics();
+}
+
 void Internals::update_style()
 {
     window().associated_document().update_style();
@@ -127,6 +127,12 @@ public:
 
     JS::Object* get_style_invalidation_counters();
     void reset_style_invalidation_counters();
+    JS::Object* get_layout_allocation_counters();
+    void reset_layout_allocation_counters();
+    JS::Object* get_text_shaping_cache_statistics();
+    void reset_text_shaping_cache_statistics();
+    JS::Object* get_regex_cache_statistics();
+    void reset_regex_cache_statistics();
     void update_style();
     void set_preferred_color_scheme(StringView color_scheme);
     String canvas_color_scheme();
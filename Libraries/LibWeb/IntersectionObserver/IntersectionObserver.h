@@ -20,6 +20,10 @@ struct ObservationTarget {
     GC::Ref<DOM::Element> target;
     Optional<size_t> previous_threshold_index;
     bool previous_is_intersecting { false };
+
+    // The document's intersection observation geometry generation when previous_threshold_index and
+    // previous_is_intersecting were last computed, or 0 if they never were.
+    u64 geometry_generation { 0 };
 };
 
 // https://w3c.github.io/IntersectionObserver/#intersection-observer-interface
@@ -9,7 +9,9 @@
 #include <LibWeb/HTML/HTMLHtmlElement.h>
 #include <LibWeb/Layout/BlockContainer.h>
 #include <LibWeb/Layout/Box.h>
+#include <LibWeb/Layout/FieldSetBox.h>
 #include <LibWeb/Layout/FormattingContext.h>
+#include <LibWeb/Layout/ListItemBox.h>
 #include <LibWeb/Layout/TableWrapper.h>
 #include <LibWeb/Painting/PaintableBox.h>
 
@@ -84,4 +86,45 @@ Optional<CSSPixelFraction> Box::preferred_aspect_ratio() const
     return fraction;
 }
 
+static bool is_fixed_size(CSS::Size const& size, bool allow_auto)
+{
+    return size.is_length() || (allow_auto && size.is_auto()) || size.is_none();
+}
+
+bool Box::is_relayout_boundary() const
+{
+    // Only block formatting context roots that sit in normal block flow are considered. Anything that takes part in
+    // line layout, flex or grid layout, or table layout may have its contents affect its baseline or its sizing.
+    if (!is<BlockContainer>(*this) || is_viewport() || is_replaced_box() || is<TableWrapper>(*this) || is<ListItemBox>(*this) || is<FieldSetBox>(*this))
+        return false;
+    if (!display().is_block_outside() || !(display().is_flow_inside() || display().is_flow_root_inside()))
+        return false;
+    if (is_floating() || !FormattingContext::creates_block_formatting_context(*this))
+        return false;
+
+    // Relative and sticky offsets are applied on top of the laid out position when committing, so the position kept
+    // from the previous layout would have them applied twice.
+    auto const& values = computed_values();
+    auto position = values.position();
+    if (position == CSS::Positioning::Relative || position == CSS::Positioning::Sticky)
+        return false;
+
+    auto const* parent_box = as_if<BlockContainer>(parent());
+    if (!parent_box || parent_box->children_are_inline())
+        return false;
+    if (!parent_box->display().is_flow_inside() && !parent_box->display().is_flow_root_inside())
+        return false;
+
+    // The used size must not depend on the contents.
+    if (!is_fixed_size(values.width(), false) || !is_fixed_size(values.height(), false))
+        return false;
+    if (!is_fixed_size(values.min_width(), true) || !is_fixed_size(values.min_height(), true))
+        return false;
+    if (!is_fixed_size(values.max_width(), false) || !is_fixed_size(values.max_height(), false))
+        return false;
+
+    // Neither may the scrollable overflow of anything outside it.
+    return values.overflow_x() != CSS::Overflow::Visible && values.overflow_y() != CSS::Overflow::Visible;
+}
+
 }
@@ -67,6 +67,10 @@ public:
     }
     void reset_cached_intrinsic_sizes() const { m_cached_intrinsic_sizes.clear(); }
 
+    // Whether changes inside this box can be laid out again without laying out anything outside it, because neither
+    // the box's own size and position nor anything outside it depend on its contents.
+    bool is_relayout_boundary() const;
+
     Box(DOM::Document&, DOM::Node*, CSS::ComputedProperties const&);
     Box(DOM::Document&, DOM::Node*, NonnullOwnPtr<CSS::ComputedValues>);
 
@@ -1212,6 +1212,18 @@ void GridFormattingContext::initialize_track_sizes(GridDimension dimension)
     }
 }
 
+bool GridFormattingContext::has_intrinsically_sized_tracks(GridDimension dimension) const
+{
+    auto const& available_size = dimension == GridDimension::Column ? m_available_space->width : m_available_space->height;
+    if (available_size.is_intrinsic_sizing_constraint())
+        return true;
+
+    auto const& tracks = dimension == GridDimension::Column ? m_grid_columns : m_grid_rows;
+    return any_of(tracks, [&](GridTrack const& track) {
+        return track.min_track_sizing_function.is_intrinsic(available_size) || track.max_track_sizing_function.is_intrinsic(available_size);
+    });
+}
+
 void GridFormattingContext::resolve_intrinsic_track_sizes(GridDimension dimension)
 {
     // https://www.w3.org/TR/css-grid-2/#algo-content
@@ -1223,6 +1235,18 @@ void GridFormattingContext::resolve_intrinsic_track_sizes(GridDimension dimensio
 
     auto& tracks_and_gaps = dimension == GridDimension::Column ? m_grid_columns_and_gaps : m_grid_rows_and_gaps;
 
+    // OPTIMIZATION: Steps 2 to 4 only grow tracks with an intrinsic sizing function, and flexible tracks while the grid
+    //               is sized under a min- or max-content constraint. A grid made up only of fixed tracks and
+    //               minmax(<fixed>, <flex>) tracks has neither, so there's no need to compute the contributions of
+    //               every one of its items.
+    if (!has_intrinsically_sized_tracks(dimension)) {
+        for (auto& track : tracks_and_gaps) {
+            if (!track.growth_limit.has_value())
+                track.growth_limit = track.base_size;
+        }
+        return;
+    }
+
     // FIXME: 1. Shim baseline-aligned items so their intrinsic size contributions reflect their baseline alignment.
 
     // 2. Size tracks to fit non-spanning items:
@@ -1928,10 +1952,11 @@ void GridFormattingContext::build_grid_areas()
     // naming the row-start and column-start lines of the named grid area, and two named foo-end, naming the row-end
     // and column-end lines of the named grid area.
     for (auto const& [name, area] : grid_template_areas.areas) {
-        m_column_lines[area.column_start].append({ .name = MUST(String::formatted("{}-start", name)), .implicit = true });
-        m_column_lines[area.column_end].append({ .name = MUST(String::formatted("{}-end", name)), .implicit = true });
-        m_row_lines[area.row_start].append({ .name = MUST(String::formatted("{}-start", name)), .implicit = true });
-        m_row_lines[area.row_end].append({ .name = MUST(String::formatted("{}-end", name)), .implicit = true });
+        auto const& line_names = grid_template_areas.implicit_line_names.get(name).value();
+        m_column_lines[area.column_start].append({ .name = line_names.start, .implicit = true });
+        m_column_lines[area.column_end].append({ .name = line_names.end, .implicit = true });
+        m_row_lines[area.row_start].append({ .name = line_names.start, .implicit = true });
+        m_row_lines[area.row_end].append({ .name = line_names.end, .implicit = true });
     }
 }
 
@@ -3577,6 +3602,16 @@ CSSPixels GridFormattingContext::non_cyclic_containing_block_width_for_table_wra
     return min(containing_block_width, non_cyclic_containing_block_width);
 }
 
+template<typename Callback>
+static CSSPixels memoized_intrinsic_size(Optional<GridItem::MemoizedIntrinsicSize>& memoized_size, AvailableSpace const& available_space, Callback callback)
+{
+    if (memoized_size.has_value() && memoized_size->available_space == available_space)
+        return memoized_size->size;
+    auto size = callback();
+    memoized_size = GridItem::MemoizedIntrinsicSize { available_space, size };
+    return size;
+}
+
 CSSPixels GridFormattingContext::calculate_min_content_contribution(GridItem const& item, GridDimension dimension) const
 {
     auto should_treat_preferred_size_as_auto = should_treat_preferred_size_as_auto_for_intrinsic_contribution(item, dimension);
@@ -3594,7 +3629,9 @@ CSSPixels GridFormattingContext::calculate_min_content_contribution(GridItem con
         if (dimension == GridDimension::Column && item.box.is_scroll_container()) {
             min_content_size = 0;
         } else {
-            min_content_size = calculate_min_content_size(item, dimension);
+            min_content_size = memoized_intrinsic_size(item.memoized_min_content_size(dimension), item.available_space(), [&] {
+                return calculate_min_content_size(item, dimension);
+            });
         }
         auto result = item.add_margin_box_sizes(min_content_size, dimension);
         return min(result, maximum_size);
@@ -3621,7 +3658,9 @@ CSSPixels GridFormattingContext::calculate_max_content_contribution(GridItem con
 
     auto preferred_size = item.preferred_size(dimension);
     if (should_treat_preferred_size_as_auto || preferred_size.is_fit_content()) {
-        auto fit_content_size = dimension == GridDimension::Column ? calculate_fit_content_width(item.box, available_space_for_item) : calculate_fit_content_height(item.box, available_space_for_item);
+        auto fit_content_size = memoized_intrinsic_size(item.memoized_fit_content_size(dimension), available_space_for_item, [&] {
+            return dimension == GridDimension::Column ? calculate_fit_content_width(item.box, available_space_for_item) : calculate_fit_content_height(item.box, available_space_for_item);
+        });
         auto result = item.add_margin_box_sizes(fit_content_size, dimension);
         return min(result, maximum_size);
     }
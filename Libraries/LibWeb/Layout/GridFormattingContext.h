@@ -116,6 +116,27 @@ struct GridItem {
         auto available_height = used_values.has_definite_height() ? AvailableSize::make_definite(used_values.content_height()) : AvailableSize::make_indefinite();
         return { available_width, available_height };
     }
+
+    // NB: Track sizing asks for the intrinsic contributions of an item many times over, so the intrinsic sizes they're
+    //     built from are memoized along with the available space they were computed for.
+    struct MemoizedIntrinsicSize {
+        AvailableSpace available_space;
+        CSSPixels size;
+    };
+    mutable Optional<MemoizedIntrinsicSize> memoized_min_content_width;
+    mutable Optional<MemoizedIntrinsicSize> memoized_min_content_height;
+    mutable Optional<MemoizedIntrinsicSize> memoized_fit_content_width;
+    mutable Optional<MemoizedIntrinsicSize> memoized_fit_content_height;
+
+    Optional<MemoizedIntrinsicSize>& memoized_min_content_size(GridDimension dimension) const
+    {
+        return dimension == GridDimension::Column ? memoized_min_content_width : memoized_min_content_height;
+    }
+
+    Optional<MemoizedIntrinsicSize>& memoized_fit_content_size(GridDimension dimension) const
+    {
+        return dimension == GridDimension::Column ? memoized_fit_content_width : memoized_fit_content_height;
+    }
 };
 
 enum class FoundUnoccupiedPlace {
@@ -373,6 +394,7 @@ private:
     void distribute_extra_space_across_spanned_tracks_growth_limit(CSSPixels item_size_contribution, Vector<GridTrack&>& spanned_tracks, Match matcher);
 
     void initialize_track_sizes(GridDimension);
+    bool has_intrinsically_sized_tracks(GridDimension) const;
     void resolve_intrinsic_track_sizes(GridDimension);
     void increase_sizes_to_accommodate_spanning_items_crossing_content_sized_tracks(GridDimension, size_t span);
     void increase_sizes_to_accommodate_spanning_items_crossing_flexible_tracks(GridDimension);
@@ -307,7 +307,7 @@ void InlineFormattingContext::apply_text_overflow_ellipsis(Vector<LineBox>& line
             auto available_in_fragment = (available_width - fragment_start).to_float();
             auto max_text_width = available_in_fragment - ellipsis_width;
 
-            auto& glyphs = fragment.glyph_run()->glyphs();
+            auto& glyphs = fragment.glyph_run_for_modification().glyphs();
             size_t keep_count = 0;
             float last_kept_end = 0.f;
             float y_position = 0.f;
@@ -236,9 +236,11 @@ Optional<InlineLevelIterator::Item> InlineLevelIterator::generate_next_item()
 
         // Get the next chunk from the pre-generated array
         Optional<TextNode::Chunk> chunk_opt;
+        Optional<size_t> chunk_index;
         auto const& chunks = m_text_node_context->chunk_list->chunks;
         if (m_text_node_context->next_chunk_index < chunks.size()) {
-            chunk_opt = chunks[m_text_node_context->next_chunk_index++];
+            chunk_index = m_text_node_context->next_chunk_index++;
+            chunk_opt = chunks[*chunk_index];
         }
 
         bool is_last_chunk = (m_text_node_context->next_chunk_index >= chunks.size());
@@ -334,7 +336,11 @@ Optional<InlineLevelIterator::Item> InlineLevelIterator::generate_next_item()
             x = tab_stop_dist.to_float();
         }
 
-        auto glyph_run = Gfx::shape_text({ x, 0 }, letter_spacing.to_float(), chunk.view, chunk.font, text_type);
+        // NB: A chunk after a tab is shaped from where the tab stop put it on the line, which can change between
+        //     layout passes, so only other chunks are shaped once for all passes.
+        auto glyph_run = chunk_index.has_value() && !chunk.has_breaking_tab
+            ? text_node->shaped_chunk(*chunk_index, letter_spacing.to_float(), text_type)
+            : Gfx::shape_text({ x, 0 }, letter_spacing.to_float(), chunk.view, chunk.font, text_type);
 
         CSSPixels chunk_width = CSSPixels::nearest_value_for(glyph_run->width() + x);
 
@@ -31,6 +31,16 @@ LayoutState::LayoutState(NodeWithStyle const& subtree_root)
 
 LayoutState::~LayoutState()
 {
+    auto& counters = allocation_counters();
+    ++counters.layout_states;
+    counters.used_values += m_used_values_store.allocation_count();
+    counters.used_values_pages += m_used_values_store.page_count();
+}
+
+LayoutState::AllocationCounters& LayoutState::allocation_counters()
+{
+    static AllocationCounters counters;
+    return counters;
 }
 
 static Painting::LineBoxData line_box_data_for(LineBox const& line_box, size_t line_index)
@@ -436,9 +446,11 @@ static void build_paint_tree(Node& node, RefPtr<Painting::Paintable> parent_pain
 void LayoutState::commit(Box& root)
 {
     RefPtr<Painting::Paintable> parent_paintable;
+    RefPtr<Painting::Paintable> next_sibling_paintable;
     if (!root.is_viewport()) {
         if (auto existing = root.first_paintable(); auto* existing_box = as_if<Painting::PaintableBox>(existing.ptr())) {
             parent_paintable = existing_box->parent();
+            next_sibling_paintable = existing_box->next_sibling();
             if (parent_paintable)
                 parent_paintable->remove_child(*existing_box);
         }
@@ -694,6 +706,13 @@ void LayoutState::commit(Box& root)
 
     build_paint_tree(root, parent_paintable);
 
+    // Keep the new subtree where the old one was among its siblings, since that's the order they're painted in.
+    if (auto new_root_paintable = root.first_paintable(); new_root_paintable && next_sibling_paintable
+        && new_root_paintable->parent() == parent_paintable && next_sibling_paintable->parent() == parent_paintable) {
+        parent_paintable->remove_child(*new_root_paintable);
+        parent_paintable->insert_before(*new_root_paintable, next_sibling_paintable.ptr());
+    }
+
     resolve_relative_positions();
 
     // Measure size of paintables created for inline nodes.
@@ -843,9 +862,10 @@ LayoutState::UsedValues& LayoutState::UsedValues::operator=(UsedValues const& ot
     m_has_definite_width = other.m_has_definite_width;
     m_has_definite_height = other.m_has_definite_height;
 
-    if (other.m_rare)
+    if (other.m_rare) {
         m_rare = make<RareData>(*other.m_rare);
-    else
+        ++allocation_counters().rare_data;
+    } else
         m_rare = nullptr;
 
     return *this;
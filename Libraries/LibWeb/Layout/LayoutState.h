@@ -6,7 +6,9 @@
 
 #pragma once
 
+#include <AK/BumpAllocator.h>
 #include <AK/HashTable.h>
+#include <AK/Noncopyable.h>
 #include <AK/OwnPtr.h>
 #include <LibGfx/Path.h>
 #include <LibGfx/Point.h>
@@ -60,8 +62,14 @@ struct StaticPositionRect {
 // flat vector pre-allocated for the entire tree wastes memory, while
 // a hash map pays hashing overhead on every access. Page tables give
 // O(1) lookup without hashing, allocating pages only on first write.
+// Pages are carved out of an arena that is released all at once with the
+// store, and the arena keeps its last chunk around for the next store, so
+// the many short-lived stores of a layout pass rarely reach malloc.
 template<typename T>
 class PagedStore {
+    AK_MAKE_NONCOPYABLE(PagedStore);
+    AK_MAKE_NONMOVABLE(PagedStore);
+
     static constexpr u32 PageBits = 4;
     static constexpr u32 PageSize = 1u << PageBits;
     static constexpr u32 PageMask = PageSize - 1;
@@ -70,7 +78,14 @@ class PagedStore {
         Optional<T> entries[PageSize] {};
     };
 
+    static constexpr size_t PagesPerChunk = 8;
+
 public:
+    PagedStore() = default;
+
+    u32 page_count() const { return m_page_count; }
+    u32 allocation_count() const { return m_allocation_count; }
+
     void ensure_capacity(u32 count)
     {
         m_pages.resize((count + PageSize - 1) >> PageBits);
@@ -96,8 +111,12 @@ public:
         if (page_index >= m_pages.size())
             m_pages.resize(page_index + 1);
         auto& page = m_pages[page_index];
-        if (!page)
-            page = make<Page>();
+        if (!page) {
+            page = m_page_arena.allocate();
+            VERIFY(page);
+            ++m_page_count;
+        }
+        ++m_allocation_count;
         auto& entry = page->entries[index & PageMask];
         entry = T {};
         return entry.value();
@@ -106,7 +125,7 @@ public:
     template<typename Callback>
     void for_each(Callback callback)
     {
-        for (auto const& page : m_pages) {
+        for (auto* page : m_pages) {
             if (!page)
                 continue;
             for (auto& entry : page->entries) {
@@ -117,7 +136,10 @@ public:
     }
 
 private:
-    Vector<OwnPtr<Page>> m_pages;
+    UniformBumpAllocator<Page, false, PagesPerChunk * sizeof(Page) + 64> m_page_arena;
+    Vector<Page*> m_pages;
+    u32 m_page_count { 0 };
+    u32 m_allocation_count { 0 };
 };
 
 struct LayoutState {
@@ -365,8 +387,10 @@ struct LayoutState {
 
         RareData& ensure_rare_data()
         {
-            if (!m_rare)
+            if (!m_rare) {
                 m_rare = make<RareData>();
+                ++allocation_counters().rare_data;
+            }
             return *m_rare;
         }
 
@@ -387,6 +411,16 @@ struct LayoutState {
     explicit LayoutState(NodeWithStyle const& subtree_root);
     ~LayoutState();
 
+    // Running totals over every layout state, including the throwaway ones used for intrinsic sizing, so tests can
+    // check how much a layout pass allocates.
+    struct AllocationCounters {
+        u64 layout_states { 0 };
+        u64 used_values { 0 };
+        u64 used_values_pages { 0 };
+        u64 rare_data { 0 };
+    };
+    static AllocationCounters& allocation_counters();
+
     // Commits the used values produced by layout and builds a paintable tree.
     void commit(Box& root);
 
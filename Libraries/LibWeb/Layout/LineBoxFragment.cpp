@@ -88,8 +88,19 @@ CSS::Direction LineBoxFragment::resolve_glyph_run_direction(Gfx::GlyphRun::TextT
     }
 }
 
+Gfx::GlyphRun& LineBoxFragment::glyph_run_for_modification()
+{
+    VERIFY(m_glyph_run);
+    if (m_glyph_run->ref_count() > 1)
+        m_glyph_run = m_glyph_run->clone();
+    return *m_glyph_run;
+}
+
 void LineBoxFragment::append_glyph_run(RefPtr<Gfx::GlyphRun> const& glyph_run, CSSPixels run_width)
 {
+    // NB: Appending moves and adds glyphs in this fragment's own glyph run.
+    glyph_run_for_modification();
+
     switch (m_direction) {
     case CSS::Direction::Ltr:
         append_glyph_run_ltr(glyph_run, run_width);
@@ -57,6 +57,9 @@ public:
     bool is_atomic_inline() const;
 
     RefPtr<Gfx::GlyphRun> glyph_run() const { return m_glyph_run; }
+    // The glyph run of a text fragment, cloned first if it's shared with anything else, like the shaped chunks that
+    // text nodes keep between layout passes.
+    Gfx::GlyphRun& glyph_run_for_modification();
     CSS::WritingMode writing_mode() const { return m_writing_mode; }
     void append_glyph_run(RefPtr<Gfx::GlyphRun> const&, CSSPixels run_width);
 
@@ -1647,19 +1647,24 @@ void Node::set_needs_layout_update(DOM::SetNeedsLayoutReason reason)
             document().mark_svg_root_as_needing_relayout(*svg_box);
             break;
         }
+        if (auto* box = as_if<Box>(ancestor); box && box->is_relayout_boundary()) {
+            document().mark_relayout_boundary_as_needing_relayout(*box);
+            break;
+        }
     }
 
-    // Reset intrinsic size caches for ancestors up to abspos or SVG root boundary.
+    // Reset intrinsic size caches for ancestors up to abspos, SVG root or relayout boundary.
     // Absolutely positioned elements don't contribute to ancestor intrinsic sizes,
     // so changes inside an abspos box don't require resetting ancestor caches.
     // SVG root elements have intrinsic sizes determined solely by their own attributes
     // (width, height, viewBox), not by their children, so the same logic applies.
+    // Relayout boundaries have fixed sizes, so their contributions don't depend on their children either.
     for (auto* ancestor = parent(); ancestor; ancestor = ancestor->parent()) {
         auto* box = as_if<Box>(ancestor);
         if (!box)
             continue;
         box->reset_cached_intrinsic_sizes();
-        if (box->is_absolutely_positioned() || box->is_svg_svg_box())
+        if (box->is_absolutely_positioned() || box->is_svg_svg_box() || box->is_relayout_boundary())
             break;
     }
 }
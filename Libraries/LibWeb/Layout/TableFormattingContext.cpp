@@ -5,6 +5,7 @@
  */
 
 #include <AK/NeverDestroyed.h>
+#include <AK/QuickSort.h>
 #include <LibWeb/DOM/Node.h>
 #include <LibWeb/HTML/BrowsingContext.h>
 #include <LibWeb/HTML/HTMLTableColElement.h>
@@ -291,7 +292,31 @@ void TableFormattingContext::initialize_table_measures<TableFormattingContext::C
 }
 
 template<class RowOrColumn>
-void TableFormattingContext::compute_intrinsic_percentage(size_t max_cell_span)
+Vector<Vector<TableFormattingContext::Cell const*>> TableFormattingContext::group_spanning_cells_by_span() const
+{
+    // OPTIMIZATION: The measures based on cells of span up to N are computed span by span. Grouping the spanning cells
+    //               by span up front means we only visit them once, instead of going over every cell of the table for
+    //               every span up to the largest one. That may be as large as the number of rows in the table.
+    Vector<Cell const*> spanning_cells;
+    for (auto const& cell : m_cells) {
+        if (cell_span<RowOrColumn>(cell) > 1)
+            spanning_cells.append(&cell);
+    }
+    quick_sort(spanning_cells, [](Cell const* a, Cell const* b) {
+        return cell_span<RowOrColumn>(*a) < cell_span<RowOrColumn>(*b);
+    });
+
+    Vector<Vector<Cell const*>> spanning_cells_by_span;
+    for (auto const* cell : spanning_cells) {
+        if (spanning_cells_by_span.is_empty() || cell_span<RowOrColumn>(*spanning_cells_by_span.last().first()) != cell_span<RowOrColumn>(*cell))
+            spanning_cells_by_span.append({});
+        spanning_cells_by_span.last().append(cell);
+    }
+    return spanning_cells_by_span;
+}
+
+template<class RowOrColumn>
+void TableFormattingContext::compute_intrinsic_percentage(Vector<Vector<Cell const*>> const& spanning_cells_by_span)
 {
     auto& rows_or_columns = table_rows_or_columns<RowOrColumn>();
 
@@ -306,13 +331,11 @@ void TableFormattingContext::compute_intrinsic_percentage(size_t max_cell_span)
         intrinsic_percentage_contribution_by_index[rc_index] = rows_or_columns[rc_index].intrinsic_percentage;
     }
 
-    for (size_t current_span = 2; current_span <= max_cell_span; current_span++) {
+    for (auto const& cells : spanning_cells_by_span) {
         // https://www.w3.org/TR/css-tables-3/#intrinsic-percentage-width-of-a-column-based-on-cells-of-span-up-to-n-n--1
-        for (auto& cell : m_cells) {
+        for (auto const* cell_pointer : cells) {
+            auto const& cell = *cell_pointer;
             auto cell_span_value = cell_span<RowOrColumn>(cell);
-            if (cell_span_value != current_span) {
-                continue;
-            }
             auto cell_start_rc_index = cell_index<RowOrColumn>(cell);
             auto cell_end_rc_index = cell_start_rc_index + cell_span_value;
             // 1. Start with the percentage contribution of the cell.
@@ -377,105 +400,102 @@ void TableFormattingContext::compute_table_measures()
 
     auto& rows_or_columns = table_rows_or_columns<RowOrColumn>();
 
-    size_t max_cell_span = 1;
-    for (auto& cell : m_cells) {
-        max_cell_span = max(max_cell_span, cell_span<RowOrColumn>(cell));
-    }
+    auto spanning_cells_by_span = group_spanning_cells_by_span<RowOrColumn>();
 
     // Since the intrinsic percentage specification uses non-spanning max-content size for the iterative algorithm,
     // run it before we compute the spanning max-content size with its own iterative algorithm for span up to N.
-    compute_intrinsic_percentage<RowOrColumn>(max_cell_span);
+    compute_intrinsic_percentage<RowOrColumn>(spanning_cells_by_span);
 
-    for (size_t current_span = 2; current_span <= max_cell_span; current_span++) {
+    for (auto const& cells : spanning_cells_by_span) {
         // https://www.w3.org/TR/css-tables-3/#min-content-width-of-a-column-based-on-cells-of-span-up-to-n-n--1
-        Vector<Vector<CSSPixels>> cell_min_contributions_by_rc_index;
-        cell_min_contributions_by_rc_index.resize(rows_or_columns.size());
         // https://www.w3.org/TR/css-tables-3/#max-content-width-of-a-column-based-on-cells-of-span-up-to-n-n--1
-        Vector<Vector<CSSPixels>> cell_max_contributions_by_rc_index;
-        cell_max_contributions_by_rc_index.resize(rows_or_columns.size());
-        for (auto& cell : m_cells) {
+        struct CellContribution {
+            size_t rc_index { 0 };
+            CSSPixels min_content_contribution;
+            CSSPixels max_content_contribution;
+        };
+        Vector<CellContribution> cell_contributions;
+        for (auto const* cell_pointer : cells) {
+            auto const& cell = *cell_pointer;
             auto cell_span_value = cell_span<RowOrColumn>(cell);
-            if (cell_span_value == current_span) {
-                // Define the baseline max-content size as the sum of the max-content sizes based on cells of span up to N-1 of all columns that the cell spans.
-                auto cell_start_rc_index = cell_index<RowOrColumn>(cell);
-                auto cell_end_rc_index = cell_start_rc_index + cell_span_value;
-                CSSPixels baseline_max_content_size = 0;
-                for (auto rc_index = cell_start_rc_index; rc_index < cell_end_rc_index; rc_index++) {
-                    baseline_max_content_size += rows_or_columns[rc_index].max_size;
-                }
-                CSSPixels baseline_min_content_size = 0;
-                for (auto rc_index = cell_start_rc_index; rc_index < cell_end_rc_index; rc_index++) {
-                    baseline_min_content_size += rows_or_columns[rc_index].min_size;
+            // Define the baseline max-content size as the sum of the max-content sizes based on cells of span up to N-1 of all columns that the cell spans.
+            auto cell_start_rc_index = cell_index<RowOrColumn>(cell);
+            auto cell_end_rc_index = cell_start_rc_index + cell_span_value;
+            CSSPixels baseline_max_content_size = 0;
+            for (auto rc_index = cell_start_rc_index; rc_index < cell_end_rc_index; rc_index++) {
+                baseline_max_content_size += rows_or_columns[rc_index].max_size;
+            }
+            CSSPixels baseline_min_content_size = 0;
+            for (auto rc_index = cell_start_rc_index; rc_index < cell_end_rc_index; rc_index++) {
+                baseline_min_content_size += rows_or_columns[rc_index].min_size;
+            }
+
+            // Define the baseline border spacing as the sum of the horizontal border-spacing for any columns spanned by the cell, other than the one in which the cell originates.
+            auto baseline_border_spacing = border_spacing<RowOrColumn>() * (cell_span_value - 1);
+
+            // Add contribution from all rows / columns, since we've weighted the gap to the desired spanned size by the the
+            // ratio of the max-content size based on cells of span up to N-1 of the row / column to the baseline max-content width.
+            for (auto rc_index = cell_start_rc_index; rc_index < cell_end_rc_index; rc_index++) {
+                // The contribution of the cell is the sum of:
+                // the min-content size of the column based on cells of span up to N-1
+                auto cell_min_contribution = rows_or_columns[rc_index].min_size;
+                // the product of:
+                // - the ratio of:
+                //   - the max-content size of the row / column based on cells of span up to N-1 of the row / column minus the
+                //     min-content size of the row / column based on cells of span up to N-1 of the row / column, to
+                //   - the baseline max-content size minus the baseline min-content size
+                //   or zero if this ratio is undefined, and
+                // - the outer min-content size of the cell minus the baseline min-content size and the baseline border spacing, clamped
+                //   to be at least 0 and at most the difference between the baseline max-content size and the baseline min-content size
+                auto normalized_max_min_diff = baseline_max_content_size != baseline_min_content_size
+                    ? (rows_or_columns[rc_index].max_size - rows_or_columns[rc_index].min_size) / static_cast<double>(baseline_max_content_size - baseline_min_content_size)
+                    : 0;
+                auto clamped_diff_to_baseline_min = min(
+                    max(cell_min_size<RowOrColumn>(cell) - baseline_min_content_size - baseline_border_spacing, 0),
+                    baseline_max_content_size - baseline_min_content_size);
+                cell_min_contribution += CSSPixels::nearest_value_for(normalized_max_min_diff * clamped_diff_to_baseline_min);
+                // the product of:
+                // - the ratio of the max-content size based on cells of span up to N-1 of the column to the baseline max-content size
+                // - the outer min-content size of the cell minus the baseline max-content size and baseline border spacing, or 0 if this is negative
+                if (baseline_max_content_size != 0) {
+                    cell_min_contribution += CSSPixels::nearest_value_for(rows_or_columns[rc_index].max_size / static_cast<double>(baseline_max_content_size))
+                        * max(CSSPixels(0), cell_min_size<RowOrColumn>(cell) - baseline_max_content_size - baseline_border_spacing);
+                } else {
+                    // AD-HOC: The spec does not define behavior when baseline is zero. We distribute equally.
+                    //         This matches how undefined ratios are handled elsewhere.
+                    cell_min_contribution += max(CSSPixels(0), cell_min_size<RowOrColumn>(cell) - baseline_border_spacing) / cell_span_value;
                 }
 
-                // Define the baseline border spacing as the sum of the horizontal border-spacing for any columns spanned by the cell, other than the one in which the cell originates.
-                auto baseline_border_spacing = border_spacing<RowOrColumn>() * (cell_span_value - 1);
-
-                // Add contribution from all rows / columns, since we've weighted the gap to the desired spanned size by the the
-                // ratio of the max-content size based on cells of span up to N-1 of the row / column to the baseline max-content width.
-                for (auto rc_index = cell_start_rc_index; rc_index < cell_end_rc_index; rc_index++) {
-                    // The contribution of the cell is the sum of:
-                    // the min-content size of the column based on cells of span up to N-1
-                    auto cell_min_contribution = rows_or_columns[rc_index].min_size;
-                    // the product of:
-                    // - the ratio of:
-                    //   - the max-content size of the row / column based on cells of span up to N-1 of the row / column minus the
-                    //     min-content size of the row / column based on cells of span up to N-1 of the row / column, to
-                    //   - the baseline max-content size minus the baseline min-content size
-                    //   or zero if this ratio is undefined, and
-                    // - the outer min-content size of the cell minus the baseline min-content size and the baseline border spacing, clamped
-                    //   to be at least 0 and at most the difference between the baseline max-content size and the baseline min-content size
-                    auto normalized_max_min_diff = baseline_max_content_size != baseline_min_content_size
-                        ? (rows_or_columns[rc_index].max_size - rows_or_columns[rc_index].min_size) / static_cast<double>(baseline_max_content_size - baseline_min_content_size)
-                        : 0;
-                    auto clamped_diff_to_baseline_min = min(
-                        max(cell_min_size<RowOrColumn>(cell) - baseline_min_content_size - baseline_border_spacing, 0),
-                        baseline_max_content_size - baseline_min_content_size);
-                    cell_min_contribution += CSSPixels::nearest_value_for(normalized_max_min_diff * clamped_diff_to_baseline_min);
-                    // the product of:
-                    // - the ratio of the max-content size based on cells of span up to N-1 of the column to the baseline max-content size
-                    // - the outer min-content size of the cell minus the baseline max-content size and baseline border spacing, or 0 if this is negative
-                    if (baseline_max_content_size != 0) {
-                        cell_min_contribution += CSSPixels::nearest_value_for(rows_or_columns[rc_index].max_size / static_cast<double>(baseline_max_content_size))
-                            * max(CSSPixels(0), cell_min_size<RowOrColumn>(cell) - baseline_max_content_size - baseline_border_spacing);
-                    } else {
-                        // AD-HOC: The spec does not define behavior when baseline is zero. We distribute equally.
-                        //         This matches how undefined ratios are handled elsewhere.
-                        cell_min_contribution += max(CSSPixels(0), cell_min_size<RowOrColumn>(cell) - baseline_border_spacing) / cell_span_value;
-                    }
-
-                    // The contribution of the cell is the sum of:
-                    // the max-content size of the column based on cells of span up to N-1
-                    auto cell_max_contribution = rows_or_columns[rc_index].max_size;
-                    // and the product of:
-                    // - the ratio of the max-content size based on cells of span up to N-1 of the column to the baseline max-content size
-                    // - the outer max-content size of the cell minus the baseline max-content size and the baseline border spacing, or 0 if this is negative
-                    if (baseline_max_content_size != 0) {
-                        cell_max_contribution += CSSPixels::nearest_value_for(rows_or_columns[rc_index].max_size / static_cast<double>(baseline_max_content_size))
-                            * max(CSSPixels(0), cell_max_size<RowOrColumn>(cell) - baseline_max_content_size - baseline_border_spacing);
-                    } else {
-                        // AD-HOC: The spec does not define behavior when baseline is zero. We distribute equally,
-                        //         This matches how undefined ratios are handled elsewhere.
-                        cell_max_contribution += max(CSSPixels(0), cell_max_size<RowOrColumn>(cell) - baseline_border_spacing) / cell_span_value;
-                    }
-                    cell_min_contributions_by_rc_index[rc_index].append(cell_min_contribution);
-                    cell_max_contributions_by_rc_index[rc_index].append(cell_max_contribution);
+                // The contribution of the cell is the sum of:
+                // the max-content size of the column based on cells of span up to N-1
+                auto cell_max_contribution = rows_or_columns[rc_index].max_size;
+                // and the product of:
+                // - the ratio of the max-content size based on cells of span up to N-1 of the column to the baseline max-content size
+                // - the outer max-content size of the cell minus the baseline max-content size and the baseline border spacing, or 0 if this is negative
+                if (baseline_max_content_size != 0) {
+                    cell_max_contribution += CSSPixels::nearest_value_for(rows_or_columns[rc_index].max_size / static_cast<double>(baseline_max_content_size))
+                        * max(CSSPixels(0), cell_max_size<RowOrColumn>(cell) - baseline_max_content_size - baseline_border_spacing);
+                } else {
+                    // AD-HOC: The spec does not define behavior when baseline is zero. We distribute equally,
+                    //         This matches how undefined ratios are handled elsewhere.
+                    cell_max_contribution += max(CSSPixels(0), cell_max_size<RowOrColumn>(cell) - baseline_border_spacing) / cell_span_value;
                 }
+                cell_contributions.append({ rc_index, cell_min_contribution, cell_max_contribution });
             }
         }
 
-        for (size_t rc_index = 0; rc_index < rows_or_columns.size(); rc_index++) {
+        for (auto const& contribution : cell_contributions) {
+            auto& row_or_column = rows_or_columns[contribution.rc_index];
+
             // min-content size of a row / column based on cells of span up to N (N > 1) is
             // the largest of the min-content size of the row / column based on cells of span up to N-1 and
             // the contributions of the cells in the row / column whose rowSpan / colSpan is N
-            for (auto min_contribution : cell_min_contributions_by_rc_index[rc_index])
-                rows_or_columns[rc_index].min_size = max(rows_or_columns[rc_index].min_size, min_contribution);
+            row_or_column.min_size = max(row_or_column.min_size, contribution.min_content_contribution);
 
             // max-content size of a row / column based on cells of span up to N (N > 1) is
             // the largest of the max-content size based on cells of span up to N-1 and the contributions of
             // the cells in the row / column whose rowSpan / colSpan is N
-            for (auto max_contribution : cell_max_contributions_by_rc_index[rc_index])
-                rows_or_columns[rc_index].max_size = max(rows_or_columns[rc_index].max_size, max_contribution);
+            row_or_column.max_size = max(row_or_column.max_size, contribution.max_content_contribution);
         }
     }
 }
@@ -1209,16 +1229,17 @@ void TableFormattingContext::position_row_boxes()
 
     CSSPixels row_top_offset = table_state.offset.y() + border_spacing_vertical();
     CSSPixels row_left_offset = table_state.border_left + table_state.padding_left + border_spacing_horizontal();
+
+    CSSPixels row_width = 0;
+    for (auto& column : m_columns) {
+        row_width += column.used_width;
+    }
+    if (m_columns.size() >= 2)
+        row_width += (m_columns.size() - 1) * border_spacing_horizontal();
+
     for (size_t y = 0; y < m_rows.size(); y++) {
         auto& row = m_rows[y];
         auto& row_state = m_state.get_mutable(row.box);
-        CSSPixels row_width = 0;
-        for (auto& column : m_columns) {
-            row_width += column.used_width;
-        }
-        if (m_columns.size() >= 2)
-            row_width += (m_columns.size() - 1) * border_spacing_horizontal();
-
         row_state.set_content_height(row.final_height);
         row_state.set_content_width(row_width);
         row_state.set_content_x(row_left_offset);
@@ -1424,8 +1445,8 @@ Painting::PaintableBox::BorderDataWithElementKind const TableFormattingContext::
 
 TableFormattingContext::ConflictingEdge const& TableFormattingContext::winning_conflicting_edge(TableFormattingContext::ConflictingEdge const& a, TableFormattingContext::ConflictingEdge const& b)
 {
-    auto a_border_data = border_data_conflicting_edge(a);
-    auto b_border_data = border_data_conflicting_edge(b);
+    auto const& a_border_data = border_data_conflicting_edge(a);
+    auto const& b_border_data = border_data_conflicting_edge(b);
     // First check if step 4 of border conflict resolution applies, as described in https://www.w3.org/TR/CSS22/tables.html#border-conflict-resolution.
     if (a_border_data.line_style == b_border_data.line_style && a_border_data.width == b_border_data.width) {
         // 4. If border styles differ only in color, then a style set on a cell wins over one on a row, which wins over a
@@ -1462,7 +1483,16 @@ TableFormattingContext::ConflictingEdge const& TableFormattingContext::winning_c
 void TableFormattingContext::border_conflict_resolution()
 {
     // Implements border conflict resolution, as described in https://www.w3.org/TR/CSS22/tables.html#border-conflict-resolution.
-    BorderConflictFinder finder(this);
+    auto use_collapsing_borders_model = table_box().computed_values().border_collapse() == CSS::BorderCollapse::Collapse;
+
+    // NB: The finder walks the column groups and row groups of the whole table, so only set it up if it's needed.
+    Optional<BorderConflictFinder> finder;
+    if (use_collapsing_borders_model)
+        finder.emplace(this);
+
+    // NB: This is reused for every edge of every cell, so that resolving them doesn't allocate.
+    Vector<ConflictingEdge> conflicting_edges;
+
     for (auto& cell : m_cells) {
         auto& cell_state = m_state.get_mutable(cell.box);
         cell_state.set_table_cell_coordinates(
@@ -1471,57 +1501,34 @@ void TableFormattingContext::border_conflict_resolution()
                 .column_index = cell.column_index,
                 .row_span = cell.row_span,
                 .column_span = cell.column_span });
-        if (table_box().computed_values().border_collapse() == CSS::BorderCollapse::Separate) {
+        if (!use_collapsing_borders_model) {
             continue;
         }
-        Painting::PaintableBox::BordersDataWithElementKind override_borders_data;
-        ConflictingEdge winning_edge_left {
-            .element = &cell.box,
-            .element_kind = Painting::PaintableBox::ConflictingElementKind::Cell,
-            .side = ConflictingSide::Left,
-            .row = cell.row_index,
-            .column = cell.column_index,
+
+        auto resolve_edge = [&](ConflictingSide side) {
+            ConflictingEdge winning_edge {
+                .element = &cell.box,
+                .element_kind = Painting::PaintableBox::ConflictingElementKind::Cell,
+                .side = side,
+                .row = cell.row_index,
+                .column = cell.column_index,
+            };
+            conflicting_edges.clear_with_capacity();
+            finder->collect_conflicting_edges(conflicting_edges, cell, side);
+            for (auto const& conflicting_edge : conflicting_edges) {
+                winning_edge = winning_conflicting_edge(winning_edge, conflicting_edge);
+            }
+            return border_data_with_element_kind_from_conflicting_edge(winning_edge);
         };
-        for (auto const& conflicting_edge : finder.conflicting_edges(cell, ConflictingSide::Left)) {
-            winning_edge_left = winning_conflicting_edge(winning_edge_left, conflicting_edge);
-        }
-        override_borders_data.left = border_data_with_element_kind_from_conflicting_edge(winning_edge_left);
+
+        Painting::PaintableBox::BordersDataWithElementKind override_borders_data;
+        override_borders_data.left = resolve_edge(ConflictingSide::Left);
         cell_state.border_left = override_borders_data.left.border_data.width;
-        ConflictingEdge winning_edge_right {
-            .element = &cell.box,
-            .element_kind = Painting::PaintableBox::ConflictingElementKind::Cell,
-            .side = ConflictingSide::Right,
-            .row = cell.row_index,
-            .column = cell.column_index,
-        };
-        for (auto const& conflicting_edge : finder.conflicting_edges(cell, ConflictingSide::Right)) {
-            winning_edge_right = winning_conflicting_edge(winning_edge_right, conflicting_edge);
-        }
-        override_borders_data.right = border_data_with_element_kind_from_conflicting_edge(winning_edge_right);
+        override_borders_data.right = resolve_edge(ConflictingSide::Right);
         cell_state.border_right = override_borders_data.right.border_data.width;
-        ConflictingEdge winning_edge_top {
-            .element = &cell.box,
-            .element_kind = Painting::PaintableBox::ConflictingElementKind::Cell,
-            .side = ConflictingSide::Top,
-            .row = cell.row_index,
-            .column = cell.column_index,
-        };
-        for (auto const& conflicting_edge : finder.conflicting_edges(cell, ConflictingSide::Top)) {
-            winning_edge_top = winning_conflicting_edge(winning_edge_top, conflicting_edge);
-        }
-        override_borders_data.top = border_data_with_element_kind_from_conflicting_edge(winning_edge_top);
+        override_borders_data.top = resolve_edge(ConflictingSide::Top);
         cell_state.border_top = override_borders_data.top.border_data.width;
-        ConflictingEdge winning_edge_bottom {
-            .element = &cell.box,
-            .element_kind = Painting::PaintableBox::ConflictingElementKind::Cell,
-            .side = ConflictingSide::Bottom,
-            .row = cell.row_index,
-            .column = cell.column_index,
-        };
-        for (auto const& conflicting_edge : finder.conflicting_edges(cell, ConflictingSide::Bottom)) {
-            winning_edge_bottom = winning_conflicting_edge(winning_edge_bottom, conflicting_edge);
-        }
-        override_borders_data.bottom = border_data_with_element_kind_from_conflicting_edge(winning_edge_bottom);
+        override_borders_data.bottom = resolve_edge(ConflictingSide::Bottom);
         cell_state.border_bottom = override_borders_data.bottom.border_data.width;
         cell_state.set_override_borders_data(override_borders_data);
     }
@@ -1748,16 +1755,13 @@ void TableFormattingContext::BorderConflictFinder::collect_table_box_conflicting
     }
 }
 
-Vector<TableFormattingContext::ConflictingEdge> TableFormattingContext::BorderConflictFinder::conflicting_edges(
-    Cell const& cell, TableFormattingContext::ConflictingSide edge) const
+void TableFormattingContext::BorderConflictFinder::collect_conflicting_edges(Vector<ConflictingEdge>& result, Cell const& cell, TableFormattingContext::ConflictingSide edge) const
 {
-    Vector<ConflictingEdge> result = {};
     collect_cell_conflicting_edges(result, cell, edge);
     collect_row_conflicting_edges(result, cell, edge);
     collect_row_group_conflicting_edges(result, cell, edge);
     collect_column_group_conflicting_edges(result, cell, edge);
     collect_table_box_conflicting_edges(result, cell, edge);
-    return result;
 }
 
 void TableFormattingContext::finish_grid_initialization(TableGrid const& table_grid)
@@ -56,7 +56,7 @@ private:
     template<class RowOrColumn>
     void compute_table_measures();
     template<class RowOrColumn>
-    void compute_intrinsic_percentage(size_t max_cell_span);
+    void compute_intrinsic_percentage(Vector<Vector<TableGrid::Cell const*>> const& spanning_cells_by_span);
     void compute_table_width();
     void distribute_width_to_columns();
     void distribute_excess_width_to_columns(CSSPixels available_width);
@@ -128,6 +128,9 @@ private:
     template<class RowOrColumn>
     static bool cell_has_intrinsic_percentage(Cell const& cell);
 
+    template<class RowOrColumn>
+    Vector<Vector<Cell const*>> group_spanning_cells_by_span() const;
+
     template<class RowOrColumn>
     void initialize_intrinsic_percentages_from_rows_or_columns();
 
@@ -165,7 +168,7 @@ private:
     class BorderConflictFinder {
     public:
         BorderConflictFinder(TableFormattingContext const* context);
-        Vector<ConflictingEdge> conflicting_edges(Cell const&, ConflictingSide) const;
+        void collect_conflicting_edges(Vector<ConflictingEdge>&, Cell const&, ConflictingSide) const;
 
     private:
         void collect_conflicting_col_elements();
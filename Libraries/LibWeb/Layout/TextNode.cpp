@@ -534,10 +534,27 @@ TextNode::ChunkList const& TextNode::chunks_for_layout(bool should_wrap_lines, b
             .chunks = move(chunks),
             .should_collapse_whitespace = chunk_iterator.should_collapse_whitespace(),
         },
+        .shaped_chunks = {},
     };
     return cache.chunk_cache->chunk_list;
 }
 
+NonnullRefPtr<Gfx::GlyphRun> TextNode::shaped_chunk(size_t chunk_index, float letter_spacing, Gfx::GlyphRun::TextType text_type) const
+{
+    auto const& cache = ensure_text_dependent_cache();
+    VERIFY(cache.chunk_cache.has_value());
+    auto const& chunk_cache = *cache.chunk_cache;
+    auto const& chunk = chunk_cache.chunk_list.chunks[chunk_index];
+
+    if (chunk_cache.shaped_chunks.is_empty())
+        chunk_cache.shaped_chunks.resize(chunk_cache.chunk_list.chunks.size());
+
+    auto& shaped_chunk = chunk_cache.shaped_chunks[chunk_index];
+    if (!shaped_chunk.has_value() || shaped_chunk->letter_spacing != letter_spacing || shaped_chunk->text_type != text_type)
+        shaped_chunk = ShapedChunk { letter_spacing, text_type, Gfx::shape_text({ 0, 0 }, letter_spacing, chunk.view, chunk.font, text_type) };
+    return shaped_chunk->glyph_run;
+}
+
 static bool is_interword_space(u32 code_point)
 {
     return code_point == 0x0020 || code_point == 0x00A0;
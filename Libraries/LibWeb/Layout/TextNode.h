@@ -96,6 +96,10 @@ public:
 
     ChunkList const& chunks_for_layout(bool should_wrap_lines, bool should_respect_linebreaks) const;
 
+    // Shapes a chunk of the list last returned by chunks_for_layout(). The glyph run is shared with earlier layout
+    // passes that shaped the same chunk, so it must be cloned before it's modified.
+    NonnullRefPtr<Gfx::GlyphRun> shaped_chunk(size_t chunk_index, float letter_spacing, Gfx::GlyphRun::TextType) const;
+
     void invalidate_text_for_rendering();
 
     Unicode::Segmenter& grapheme_segmenter() const;
@@ -134,9 +138,18 @@ private:
         bool operator==(ChunkCacheKey const&) const = default;
     };
 
+    struct ShapedChunk {
+        float letter_spacing { 0 };
+        Gfx::GlyphRun::TextType text_type { Gfx::GlyphRun::TextType::Common };
+        NonnullRefPtr<Gfx::GlyphRun> glyph_run;
+    };
+
     struct ChunkCacheEntry {
         ChunkCacheKey key;
         ChunkList chunk_list;
+        // OPTIMIZATION: Relayouts at a different available width, like when the window is resized or a box is sized
+        //               for its min- and max-content, break lines at other chunks but shape every chunk the same.
+        mutable Vector<Optional<ShapedChunk>> shaped_chunks;
     };
 
     struct TextDependentCache {
@@ -151,13 +151,25 @@ ErrorOr<void> ContentBlocker::set_patterns(ReadonlySpan<String> patterns)
 
 ErrorOr<void> ContentBlocker::set_rules_from_bytes(ReadonlyBytes rules_bytes)
 {
-    auto* engine = ContentBlocking::FFI::rust_content_blocker_create(
-        rules_bytes.data(),
-        rules_bytes.size());
-    if (!engine)
-        return Error::from_string_literal("Failed to create content blocker");
+    void* engine = nullptr;
+    bool has_cosmetic_rules = false;
 
-    auto has_cosmetic_rules = rules_contain_cosmetic_rules(rules_bytes);
+    if (ContentBlocking::FFI::rust_content_blocker_is_compiled(rules_bytes.data(), rules_bytes.size())) {
+        engine = ContentBlocking::FFI::rust_content_blocker_create_from_compiled(
+            rules_bytes.data(),
+            rules_bytes.size(),
+            &has_cosmetic_rules);
+        if (!engine)
+            return Error::from_string_literal("Failed to load compiled content blocker");
+    } else {
+        engine = ContentBlocking::FFI::rust_content_blocker_create(
+            rules_bytes.data(),
+            rules_bytes.size());
+        if (!engine)
+            return Error::from_string_literal("Failed to create content blocker");
+
+        has_cosmetic_rules = rules_contain_cosmetic_rules(rules_bytes);
+    }
 
     ContentBlocking::FFI::rust_content_blocker_free(m_engine);
     m_engine = engine;
@@ -165,6 +177,21 @@ ErrorOr<void> ContentBlocker::set_rules_from_bytes(ReadonlyBytes rules_bytes)
     return {};
 }
 
+ErrorOr<ByteBuffer> ContentBlocker::compile_rules(ReadonlyBytes rules_bytes)
+{
+    auto compiled = ContentBlocking::FFI::rust_content_blocker_compile(
+        rules_bytes.data(),
+        rules_bytes.size(),
+        rules_contain_cosmetic_rules(rules_bytes));
+    if (!compiled.data)
+        return Error::from_string_literal("Failed to compile content blocker rules");
+
+    ScopeGuard free_compiled = [&] {
+        ContentBlocking::FFI::rust_content_blocker_free_bytes(compiled.data, compiled.length);
+    };
+    return ByteBuffer::copy(compiled.data, compiled.length);
+}
+
 bool ContentBlocker::is_filtered(URL::URL const& url) const
 {
     return is_filtered(url, url, ResourceType::Other);
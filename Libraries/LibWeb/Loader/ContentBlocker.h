@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <AK/ByteBuffer.h>
 #include <AK/Error.h>
 #include <AK/Noncopyable.h>
 #include <AK/String.h>
@@ -47,8 +48,13 @@ public:
     bool is_filtered(URL::URL const&, URL::URL const& source_url, ResourceType) const;
     bool is_filtered(URL::URL const&, URL::URL const& source_url, Optional<Fetch::Infrastructure::Request::Destination> const&, Optional<Fetch::Infrastructure::Request::InitiatorType> const&, Fetch::Infrastructure::Request::Mode) const;
     ErrorOr<void> set_patterns(ReadonlySpan<String>);
+    // Accepts either rule list text or an engine made by compile_rules().
     ErrorOr<void> set_rules_from_bytes(ReadonlyBytes);
 
+    // Parses rule list text once into an engine that set_rules_from_bytes() loads without parsing it again, so that the
+    // UI process can hand the same compiled engine to every WebContent process.
+    static ErrorOr<ByteBuffer> compile_rules(ReadonlyBytes);
+
     String cosmetic_style_sheet_for_url(URL::URL const&) const;
     String cosmetic_style_sheet_for_url(URL::URL const&, ReadonlySpan<String> classes, ReadonlySpan<String> ids) const;
     bool has_generic_cosmetic_selectors_for_url(URL::URL const&, ReadonlySpan<String> classes, ReadonlySpan<String> ids) const;
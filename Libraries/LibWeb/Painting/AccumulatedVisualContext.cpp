@@ -15,6 +15,7 @@
 #include <LibWeb/CSS/StyleValues/LengthStyleValue.h>
 #include <LibWeb/CSS/StyleValues/TransformationStyleValue.h>
 #include <LibWeb/CSS/VisualViewport.h>
+#include <LibWeb/Compositor/AsyncAnimations.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/HTML/HTMLHtmlElement.h>
 #include <LibWeb/Page/Page.h>
@@ -71,7 +72,7 @@ static CSSPixelRect effective_css_clip_rect(CSSPixelRect const& css_clip)
 // - Translation column (column 3, rows 0-2) is scaled up by DPR
 // - Perspective row (row 3, columns 0-2) is scaled down by DPR
 // - All other elements are unaffected (the scale factors cancel out)
-static FloatMatrix4x4 scale_matrix_for_device_pixels(FloatMatrix4x4 matrix, float scale)
+FloatMatrix4x4 scale_matrix_for_device_pixels(FloatMatrix4x4 matrix, float scale)
 {
     matrix[0, 3] *= scale;
     matrix[1, 3] *= scale;
@@ -243,6 +244,8 @@ AccumulatedVisualContextTree build_accumulated_visual_context_tree(ViewportPaint
     auto pixel_ratio = document.page().client().device_pixels_per_css_pixel();
     DevicePixelConverter converter { pixel_ratio };
     auto scale = static_cast<float>(pixel_ratio);
+    auto now = MonotonicTime::now();
+    Vector<Compositor::AsyncAnimation> async_animations;
 
     auto append_node = [&](VisualContextIndex parent_index, VisualContextData data) -> VisualContextIndex {
         return visual_context_tree.append(move(data), parent_index);
@@ -318,12 +321,25 @@ AccumulatedVisualContextTree build_accumulated_visual_context_tree(ViewportPaint
 
         auto const& computed_values = paintable_box.computed_values();
 
-        if (auto effects = make_effects_data(paintable_box); effects.has_value())
+        // NB: An animation is only handed to the compositor while the box already has the node it drives, so that the
+        //     compositor never has to change the shape of the tree, or the stacking contexts painted into it.
+        auto box_async_animations = Compositor::async_animations_for_box(paintable_box, now);
+
+        if (auto effects = make_effects_data(paintable_box); effects.has_value()) {
             append_to_own_and_positioned_descendant_contexts(effects.value());
+            if (auto& opacity_animation = box_async_animations.opacity; opacity_animation.has_value()) {
+                opacity_animation->target_nodes = { own_state, state_for_absolute_position_descendants, state_for_fixed_position_descendants };
+                async_animations.append(opacity_animation.release_value());
+            }
+        }
 
         if (auto transform_data = compute_transform(paintable_box, computed_values, pixel_ratio); transform_data.has_value()) {
             paintable_box.set_has_non_invertible_css_transform(!transform_data->matrix.is_invertible());
             own_state = append_node(own_state, *transform_data);
+            if (auto& transform_animation = box_async_animations.transform; transform_animation.has_value()) {
+                transform_animation->target_nodes = { own_state };
+                async_animations.append(transform_animation.release_value());
+            }
         } else {
             paintable_box.set_has_non_invertible_css_transform(false);
         }
@@ -427,6 +443,7 @@ AccumulatedVisualContextTree build_accumulated_visual_context_tree(ViewportPaint
         return IterationDecision::Continue;
     });
 
+    viewport_paintable.set_async_animations(move(async_animations));
     return visual_context_tree;
 }
 
@@ -461,6 +478,18 @@ void AccumulatedVisualContextTree::set_visual_viewport_transform(TransformData t
     m_nodes[VISUAL_VIEWPORT_NODE_INDEX.value()].data = move(transform);
 }
 
+void AccumulatedVisualContextTree::set_effects_opacity(VisualContextIndex index, float opacity)
+{
+    VERIFY(index.value() < m_nodes.size());
+    m_nodes[index.value()].data.get<EffectsData>().opacity = opacity;
+}
+
+void AccumulatedVisualContextTree::set_transform_matrix(VisualContextIndex index, Gfx::FloatMatrix4x4 const& matrix)
+{
+    VERIFY(index.value() < m_nodes.size());
+    m_nodes[index.value()].data.get<TransformData>().matrix = matrix;
+}
+
 VisualContextIndex AccumulatedVisualContextTree::find_common_ancestor(VisualContextIndex a, VisualContextIndex b) const
 {
     VERIFY(a.value() < m_nodes.size());
@@ -30,6 +30,8 @@ AK_TYPEDEF_DISTINCT_ORDERED_ID(size_t, VisualContextIndex);
 
 static constexpr VisualContextIndex VISUAL_VIEWPORT_NODE_INDEX { 0 };
 
+WEB_API Gfx::FloatMatrix4x4 scale_matrix_for_device_pixels(Gfx::FloatMatrix4x4 matrix, float scale);
+
 struct ScrollData {
     ScrollFrameIndex scroll_frame_index;
     bool is_sticky;
@@ -107,6 +109,11 @@ public:
     VisualContextIndex append(VisualContextData data, VisualContextIndex parent_index);
     void set_visual_viewport_transform(TransformData);
 
+    // These update a node in place for the compositor's own animations, keeping the tree compatible with the display
+    // lists recorded against it.
+    void set_effects_opacity(VisualContextIndex, float opacity);
+    void set_transform_matrix(VisualContextIndex, Gfx::FloatMatrix4x4 const&);
+
     AccumulatedVisualContextNode const& node_at(VisualContextIndex index) const { return m_nodes[index.value()]; }
     ReadonlySpan<AccumulatedVisualContextNode> nodes() const { return m_nodes.span(); }
 
@@ -297,6 +297,10 @@ void DisplayListPlayer::execute_impl(
         if (display_list_command_is_compositor_metadata(header.type))
             return;
 
+        // Only glyph runs drawn under the same visual context can be batched together.
+        if (header.type != DisplayListCommandType::DrawGlyphRun || !has_applied_context || applied_context_index != header.context_index)
+            flush_batched_commands();
+
         auto bounding_rect = header.has_bounding_rect
             ? Optional<Gfx::IntRect>(header.bounding_rect)
             : Optional<Gfx::IntRect> {};
@@ -341,6 +345,8 @@ void DisplayListPlayer::execute_impl(
         }
     });
 
+    flush_batched_commands();
+
     while (applied_depth > 0) {
         restore({});
         applied_depth--;
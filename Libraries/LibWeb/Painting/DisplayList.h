@@ -99,6 +99,10 @@ private:
     virtual void apply_transform(Gfx::FloatPoint origin, Gfx::FloatMatrix4x4 const&) = 0;
     virtual bool would_be_fully_clipped_by_painter(Gfx::IntRect) const = 0;
 
+    // Players may defer drawing of consecutive commands to issue them together. This is called before any command
+    // that can't join the current batch, and when execution finishes.
+    virtual void flush_batched_commands() { }
+
     virtual void add_clip_path(Gfx::Path const&) = 0;
 
     DisplayList const* m_active_display_list { nullptr };
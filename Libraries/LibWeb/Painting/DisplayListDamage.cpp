@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibWeb/Painting/AccumulatedVisualContext.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/DisplayListDamage.h>
+#include <LibWeb/Painting/ScrollState.h>
+
+namespace Web::Painting {
+
+// Skia antialiasing can touch the pixel just outside a command's bounds, and mapping to the viewport rounds outward.
+static constexpr int damage_rect_inflation = 2;
+
+static bool matrices_are_equal(Gfx::FloatMatrix4x4 const& a, Gfx::FloatMatrix4x4 const& b)
+{
+    for (size_t row = 0; row < 4; ++row) {
+        for (size_t column = 0; column < 4; ++column) {
+            if (a[row, column] != b[row, column])
+                return false;
+        }
+    }
+    return true;
+}
+
+static bool corner_radii_are_equal(Gfx::CornerRadii const& a, Gfx::CornerRadii const& b)
+{
+    auto corner_is_equal = [](Gfx::CornerRadius const& a, Gfx::CornerRadius const& b) {
+        return a.horizontal_radius == b.horizontal_radius && a.vertical_radius == b.vertical_radius;
+    };
+    return corner_is_equal(a.top_left, b.top_left)
+        && corner_is_equal(a.top_right, b.top_right)
+        && corner_is_equal(a.bottom_right, b.bottom_right)
+        && corner_is_equal(a.bottom_left, b.bottom_left);
+}
+
+// Whether a context maps a command's bounding rect to exactly the viewport pixels it can touch. Filters spread pixels
+// beyond their input, and perspective isn't captured by the 2D mapping in transform_rect_to_viewport().
+static bool node_has_bounded_damage(AccumulatedVisualContextNode const& node)
+{
+    return node.data.visit(
+        [](TransformData const& transform) {
+            auto const& matrix = transform.matrix;
+            return matrix[3, 0] == 0 && matrix[3, 1] == 0 && matrix[3, 3] == 1;
+        },
+        [](EffectsData const& effects) { return !effects.gfx_filter.has_value(); },
+        [](PerspectiveData const&) { return false; },
+        [](auto const&) { return true; });
+}
+
+enum class NodeComparison {
+    Equal,
+    // Same place in the tree, but painting under it may differ anywhere within the bounds of what's painted under it.
+    Changed,
+    // The difference can't be bounded by what's painted under the node.
+    Incompatible,
+};
+
+// Transforms, opacity, blending and clips only move or restrict what the commands under a node paint, so a change to
+// any of them is bounded by those commands' old and new bounds. Filters and clip paths can't be compared cheaply, so
+// nodes with filters are never matched up and nodes with clip paths are always treated as changed.
+static NodeComparison compare_nodes(AccumulatedVisualContextNode const& a, AccumulatedVisualContextNode const& b)
+{
+    if (a.parent_index != b.parent_index || a.depth != b.depth)
+        return NodeComparison::Incompatible;
+    if (a.data.index() != b.data.index())
+        return NodeComparison::Incompatible;
+
+    auto changed_if = [](bool is_different) { return is_different ? NodeComparison::Changed : NodeComparison::Equal; };
+
+    auto comparison = a.data.visit(
+        [&](ScrollData const& scroll) {
+            auto const& other = b.data.get<ScrollData>();
+            if (scroll.scroll_frame_index != other.scroll_frame_index || scroll.is_sticky != other.is_sticky)
+                return NodeComparison::Incompatible;
+            return NodeComparison::Equal;
+        },
+        [&](ClipData const& clip) {
+            auto const& other = b.data.get<ClipData>();
+            return changed_if(clip.rect != other.rect || !corner_radii_are_equal(clip.corner_radii, other.corner_radii));
+        },
+        [&](TransformData const& transform) {
+            auto const& other = b.data.get<TransformData>();
+            return changed_if(transform.origin != other.origin || !matrices_are_equal(transform.matrix, other.matrix));
+        },
+        [&](PerspectiveData const& perspective) {
+            if (!matrices_are_equal(perspective.matrix, b.data.get<PerspectiveData>().matrix))
+                return NodeComparison::Incompatible;
+            return NodeComparison::Equal;
+        },
+        [&](ClipPathData const&) {
+            return NodeComparison::Changed;
+        },
+        [&](EffectsData const& effects) {
+            auto const& other = b.data.get<EffectsData>();
+            if (effects.gfx_filter.has_value() || other.gfx_filter.has_value())
+                return NodeComparison::Incompatible;
+            return changed_if(effects.opacity != other.opacity || effects.blend_mode != other.blend_mode);
+        },
+        [&](ScrollCompensation const& compensation) {
+            if (compensation.scroll_frame_index != b.data.get<ScrollCompensation>().scroll_frame_index)
+                return NodeComparison::Incompatible;
+            return NodeComparison::Equal;
+        });
+
+    if (comparison == NodeComparison::Equal && a.has_empty_effective_clip != b.has_empty_effective_clip)
+        return NodeComparison::Changed;
+    return comparison;
+}
+
+// For every node, whether it or one of its ancestors changed, so that everything painted under it has to be treated
+// as changed too. Returns nothing if the trees can't be matched up node for node.
+static Optional<Vector<bool>> changed_visual_contexts(AccumulatedVisualContextTree const& a, AccumulatedVisualContextTree const& b)
+{
+    auto a_nodes = a.nodes();
+    auto b_nodes = b.nodes();
+    if (a_nodes.size() != b_nodes.size())
+        return {};
+
+    Vector<bool> changed;
+    changed.resize(a_nodes.size());
+    for (size_t i = 0; i < a_nodes.size(); ++i) {
+        auto comparison = compare_nodes(a_nodes[i], b_nodes[i]);
+        if (comparison == NodeComparison::Incompatible)
+            return {};
+        // Nodes are appended after their parents, so the parent's state is already known.
+        auto parent_changed = i != VISUAL_VIEWPORT_NODE_INDEX.value() && changed[a_nodes[i].parent_index.value()];
+        changed[i] = comparison == NodeComparison::Changed || parent_changed;
+    }
+    return changed;
+}
+
+// Commands whose pixels depend on what is already on the surface, or on a mask, so a change anywhere underneath
+// them can change pixels outside the changed command's own bounds.
+static bool command_reads_surface_contents(DisplayListCommandHeader const& header, ReadonlyBytes payload)
+{
+    if (header.type == DisplayListCommandType::ApplyBackdropFilter)
+        return true;
+    if (header.type == DisplayListCommandType::ApplyEffects) {
+        auto effects = read_display_list_object<ApplyEffects>(payload);
+        return effects.has_filter || effects.has_mask_kind;
+    }
+    return false;
+}
+
+static bool command_only_changes_painter_state(DisplayListCommandType type)
+{
+    switch (type) {
+    case DisplayListCommandType::Save:
+    case DisplayListCommandType::SaveLayer:
+    case DisplayListCommandType::Restore:
+    case DisplayListCommandType::Translate:
+    case DisplayListCommandType::ApplyEffects:
+        return true;
+    default:
+        return false;
+    }
+}
+
+struct RecordedCommand {
+    DisplayListCommandHeader header;
+    ReadonlyBytes payload;
+};
+
+static Vector<RecordedCommand> recorded_commands(DisplayList const& display_list)
+{
+    Vector<RecordedCommand> commands;
+    display_list.for_each_command_header([&](DisplayListCommandHeader const& header, ReadonlyBytes payload) {
+        commands.append({ header, payload });
+    });
+    return commands;
+}
+
+Optional<Gfx::IntRect> compute_display_list_damage(
+    DisplayList const& old_display_list,
+    AccumulatedVisualContextTree const& old_visual_context_tree,
+    DisplayList const& new_display_list,
+    AccumulatedVisualContextTree const& new_visual_context_tree,
+    ScrollStateSnapshot const& scroll_state)
+{
+    if (&old_display_list == &new_display_list && &old_visual_context_tree == &new_visual_context_tree)
+        return Gfx::IntRect {};
+
+    auto changed_contexts = changed_visual_contexts(old_visual_context_tree, new_visual_context_tree);
+    if (!changed_contexts.has_value())
+        return {};
+
+    auto old_commands = recorded_commands(old_display_list);
+    auto new_commands = recorded_commands(new_display_list);
+    if (old_commands.size() != new_commands.size())
+        return {};
+
+    auto damage_for_command = [&](DisplayListCommandHeader const& header, AccumulatedVisualContextTree const& tree) -> Optional<Gfx::IntRect> {
+        if (!header.has_bounding_rect)
+            return {};
+        for (auto index = header.context_index;; index = tree.node_at(index).parent_index) {
+            if (!node_has_bounded_damage(tree.node_at(index)))
+                return {};
+            if (index == VISUAL_VIEWPORT_NODE_INDEX)
+                break;
+        }
+        auto rect = tree.transform_rect_to_viewport(header.context_index, header.bounding_rect.to_type<float>(), scroll_state);
+        return Gfx::enclosing_int_rect(rect).inflated(damage_rect_inflation * 2, damage_rect_inflation * 2);
+    };
+
+    Gfx::IntRect damage;
+    bool reads_surface_contents = false;
+    for (size_t i = 0; i < new_commands.size(); ++i) {
+        auto const& old_command = old_commands[i];
+        auto const& new_command = new_commands[i];
+        if (old_command.header.type != new_command.header.type
+            || old_command.header.context_index != new_command.header.context_index
+            || old_command.header.is_clip != new_command.header.is_clip)
+            return {};
+
+        if (command_reads_surface_contents(new_command.header, new_command.payload)
+            || command_reads_surface_contents(old_command.header, old_command.payload))
+            reads_surface_contents = true;
+
+        if (display_list_command_is_compositor_metadata(new_command.header.type))
+            continue;
+
+        auto const& old_header = old_command.header;
+        auto const& new_header = new_command.header;
+        auto is_unchanged = old_header.has_bounding_rect == new_header.has_bounding_rect
+            && old_header.bounding_rect == new_header.bounding_rect
+            && old_command.payload == new_command.payload;
+        if (is_unchanged) {
+            if (!(*changed_contexts)[new_header.context_index.value()])
+                continue;
+            // Under a changed context, an unchanged command that paints nothing itself only affects the pixels of the
+            // commands it applies to, which are accounted for on their own.
+            if (command_only_changes_painter_state(new_header.type))
+                continue;
+        }
+
+        auto old_damage = damage_for_command(old_header, old_visual_context_tree);
+        auto new_damage = damage_for_command(new_header, new_visual_context_tree);
+        if (!old_damage.has_value() || !new_damage.has_value())
+            return {};
+        damage.unite(*old_damage);
+        damage.unite(*new_damage);
+    }
+
+    if (reads_surface_contents && !damage.is_empty())
+        return {};
+    return damage;
+}
+
+}
@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Optional.h>
+#include <LibGfx/Rect.h>
+#include <LibWeb/Export.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::Painting {
+
+// The viewport area in which replaying the new recording can paint different pixels than replaying the old one, both
+// under the same scroll state. The two command streams are walked in step: commands that are byte-for-byte identical
+// in identical visual contexts paint identical pixels, so only the bounding rects of the ones that differ count. When
+// a transform, opacity, blend mode or clip changed, everything painted under it counts, at both its old and new place.
+// An animated transform or opacity thus only repaints the element it applies to.
+//
+// Returns nothing when the recordings can't be matched up command for command, or when a difference could reach
+// pixels outside its own bounding rect (filters, backdrop filters, masks, perspective). The caller should then repaint
+// everything. An empty rect means nothing visible changed.
+WEB_API Optional<Gfx::IntRect> compute_display_list_damage(
+    DisplayList const& old_display_list,
+    AccumulatedVisualContextTree const& old_visual_context_tree,
+    DisplayList const& new_display_list,
+    AccumulatedVisualContextTree const& new_visual_context_tree,
+    ScrollStateSnapshot const&);
+
+}
@@ -29,6 +29,8 @@
 #include <gpu/ganesh/SkSurfaceGanesh.h>
 #include <pathops/SkPathOps.h>
 
+#include <AK/HashMap.h>
+#include <AK/SIMDExtras.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ColorSpace.h>
 #include <LibGfx/DecodedImageFrame.h>
@@ -42,6 +44,133 @@
 
 namespace Web::Painting {
 
+static constexpr size_t box_shadow_mask_cache_max_entries = 256;
+static constexpr size_t box_shadow_mask_cache_max_bytes = 16 * MiB;
+static constexpr size_t gradient_shader_cache_max_entries = 256;
+
+// Evicts the least recently used entries until should_evict() returns false.
+template<typename Map>
+static void evict_least_recently_used(Map& map, auto should_evict, auto on_evict)
+{
+    while (should_evict()) {
+        auto least_recently_used = map.end();
+        for (auto it = map.begin(); it != map.end(); ++it) {
+            if (least_recently_used == map.end() || it->value.last_used_sequence_number < least_recently_used->value.last_used_sequence_number)
+                least_recently_used = it;
+        }
+        if (least_recently_used == map.end())
+            break;
+        on_evict(least_recently_used->value);
+        map.remove(least_recently_used);
+    }
+}
+
+// OPTIMIZATION: A blurred rounded rectangle only varies around its corners and across the blur at its edges, so an
+//               outer box shadow of any size can be drawn as a nine-patch of a small blurred mask. The masks are keyed
+//               by everything that shapes them, so boxes that share a shadow style share a mask, and repainting them
+//               doesn't blur again.
+struct DisplayListPlayerSkia::BoxShadowMaskCache {
+    struct Key {
+        int blur_radius { 0 };
+        Gfx::CornerRadii corner_radii;
+    };
+
+    struct KeyTraits : public DefaultTraits<Key> {
+        static unsigned hash(Key const& key)
+        {
+            auto hash_radius = [](Gfx::CornerRadius const& radius) {
+                return pair_int_hash(radius.horizontal_radius, radius.vertical_radius);
+            };
+            auto const& radii = key.corner_radii;
+            auto hash = pair_int_hash(hash_radius(radii.top_left), hash_radius(radii.top_right));
+            hash = pair_int_hash(hash, pair_int_hash(hash_radius(radii.bottom_right), hash_radius(radii.bottom_left)));
+            return pair_int_hash(hash, key.blur_radius);
+        }
+
+        static bool equals(Key const& a, Key const& b)
+        {
+            auto radius_equals = [](Gfx::CornerRadius const& a, Gfx::CornerRadius const& b) {
+                return a.horizontal_radius == b.horizontal_radius && a.vertical_radius == b.vertical_radius;
+            };
+            return a.blur_radius == b.blur_radius
+                && radius_equals(a.corner_radii.top_left, b.corner_radii.top_left)
+                && radius_equals(a.corner_radii.top_right, b.corner_radii.top_right)
+                && radius_equals(a.corner_radii.bottom_right, b.corner_radii.bottom_right)
+                && radius_equals(a.corner_radii.bottom_left, b.corner_radii.bottom_left);
+        }
+    };
+
+    struct Mask {
+        sk_sp<SkImage> image;
+        // The single row and column that stretch to fill the shadow's straight edges.
+        SkIRect center;
+        u64 last_used_sequence_number { 0 };
+        size_t approximate_byte_size { 0 };
+    };
+
+    void prune_to_limits()
+    {
+        evict_least_recently_used(
+            masks,
+            [&] { return masks.size() > box_shadow_mask_cache_max_entries || approximate_byte_size > box_shadow_mask_cache_max_bytes; },
+            [&](Mask const& mask) { approximate_byte_size -= min(approximate_byte_size, mask.approximate_byte_size); });
+    }
+
+    HashMap<Key, Mask, KeyTraits> masks;
+    size_t approximate_byte_size { 0 };
+    u64 use_sequence_number { 0 };
+};
+
+// OPTIMIZATION: Skia prepares a gradient's stops for its interpolation color space when the shader is made. Gradients
+//               are made here once per set of stops, in a unit geometry that each command then maps onto its own box
+//               with a local matrix, so the same gradient on many boxes, in many tiles or over many frames is only
+//               prepared once.
+struct DisplayListPlayerSkia::GradientShaderCache {
+    struct Key {
+        GradientShape shape { GradientShape::Linear };
+        bool repeating { false };
+        Gfx::GradientInterpolationMethod interpolation_method;
+        Vector<Color, 4> colors;
+        Vector<float, 4> positions;
+    };
+
+    struct KeyTraits : public DefaultTraits<Key> {
+        static unsigned hash(Key const& key)
+        {
+            auto const& method = key.interpolation_method;
+            auto hash = pair_int_hash(to_underlying(key.shape) | (key.repeating << 8) | (to_underlying(method.type) << 9),
+                (to_underlying(method.rectangular_color_space) << 16) | (to_underlying(method.polar_color_space) << 8) | to_underlying(method.hue_interpolation_method));
+            for (auto color : key.colors)
+                hash = pair_int_hash(hash, color.value());
+            for (auto position : key.positions)
+                hash = pair_int_hash(hash, bit_cast<u32>(position));
+            return hash;
+        }
+
+        static bool equals(Key const& a, Key const& b)
+        {
+            auto const& a_method = a.interpolation_method;
+            auto const& b_method = b.interpolation_method;
+            return a.shape == b.shape
+                && a.repeating == b.repeating
+                && a_method.type == b_method.type
+                && a_method.rectangular_color_space == b_method.rectangular_color_space
+                && a_method.polar_color_space == b_method.polar_color_space
+                && a_method.hue_interpolation_method == b_method.hue_interpolation_method
+                && a.colors == b.colors
+                && a.positions == b.positions;
+        }
+    };
+
+    struct Entry {
+        sk_sp<SkShader> shader;
+        u64 last_used_sequence_number { 0 };
+    };
+
+    HashMap<Key, Entry, KeyTraits> shaders;
+    u64 use_sequence_number { 0 };
+};
+
 DisplayListPlayerSkia::DisplayListPlayerSkia()
     : DisplayListPlayerSkia(Gfx::SkiaBackendContext::the_main_thread_context())
 {
@@ -50,6 +179,8 @@ DisplayListPlayerSkia::DisplayListPlayerSkia()
 DisplayListPlayerSkia::DisplayListPlayerSkia(RefPtr<Gfx::SkiaBackendContext> skia_backend_context)
     : m_skia_backend_context(move(skia_backend_context))
     , m_image_cache(m_skia_backend_context)
+    , m_box_shadow_mask_cache(make<BoxShadowMaskCache>())
+    , m_gradient_shader_cache(make<GradientShaderCache>())
 {
 }
 
@@ -69,6 +200,12 @@ static SkRRect to_skia_rrect(auto const& rect, Gfx::CornerRadii const& corner_ra
     return rrect;
 }
 
+static bool is_translation_only(SkM44 const& matrix)
+{
+    return matrix.rc(0, 0) == 1 && matrix.rc(0, 1) == 0 && matrix.rc(1, 0) == 0 && matrix.rc(1, 1) == 1
+        && matrix.rc(3, 0) == 0 && matrix.rc(3, 1) == 0 && matrix.rc(3, 3) == 1;
+}
+
 static SkMatrix to_skia_matrix(Gfx::AffineTransform const& affine_transform)
 {
     SkScalar affine[6];
@@ -155,24 +292,64 @@ void DisplayListPlayerSkia::paint_scrollbar(Gfx::PaintingSurface& surface, Paint
     paint_scrollbar_into_surface(surface, command);
 }
 
-void DisplayListPlayerSkia::draw_glyph_run(DrawGlyphRun const& command)
+static void append_glyph_run(SkTextBlobBuilder& builder, Gfx::Font const& font, ReadonlySpan<DisplayListGlyph> glyphs, float scale, Gfx::FloatPoint offset)
 {
-    auto const& font = resource_storage().font(command.font_id);
-    auto glyphs = inline_objects<DisplayListGlyph>(command.glyphs);
-    if (glyphs.is_empty())
-        return;
-
-    auto sk_font = font.skia_font(command.scale);
-    SkTextBlobBuilder builder;
+    auto sk_font = font.skia_font(scale);
     auto const& run = builder.allocRunPos(sk_font, glyphs.size());
 
     auto font_ascent = font.pixel_metrics().ascent;
     for (size_t i = 0; i < glyphs.size(); ++i) {
         run.glyphs[i] = glyphs[i].glyph_id;
-        run.pos[i * 2] = glyphs[i].position.x() * command.scale;
-        run.pos[i * 2 + 1] = (glyphs[i].position.y() + font_ascent) * command.scale;
+        run.pos[i * 2] = glyphs[i].position.x() * scale + offset.x();
+        run.pos[i * 2 + 1] = (glyphs[i].position.y() + font_ascent) * scale + offset.y();
+    }
+}
+
+void DisplayListPlayerSkia::draw_glyph_run(DrawGlyphRun const& command)
+{
+    if (command.orientation != Gfx::Orientation::Horizontal) {
+        flush_batched_commands();
+        draw_glyph_run_immediately(command);
+        return;
     }
 
+    auto glyphs = inline_objects<DisplayListGlyph>(command.glyphs);
+    if (glyphs.is_empty())
+        return;
+
+    if (!m_glyph_run_batch_is_empty && m_glyph_run_batch_color != command.color)
+        flush_batched_commands();
+
+    if (!m_glyph_run_batch)
+        m_glyph_run_batch = make<SkTextBlobBuilder>();
+    append_glyph_run(*m_glyph_run_batch, resource_storage().font(command.font_id), glyphs, command.scale, command.translation);
+    m_glyph_run_batch_color = command.color;
+    m_glyph_run_batch_is_empty = false;
+}
+
+void DisplayListPlayerSkia::flush_batched_commands()
+{
+    if (m_glyph_run_batch_is_empty)
+        return;
+    m_glyph_run_batch_is_empty = true;
+
+    auto blob = m_glyph_run_batch->make();
+    if (!blob)
+        return;
+
+    SkPaint paint;
+    paint.setColor(to_skia_color(m_glyph_run_batch_color));
+    surface().canvas().drawTextBlob(blob.get(), 0, 0, paint);
+}
+
+void DisplayListPlayerSkia::draw_glyph_run_immediately(DrawGlyphRun const& command)
+{
+    auto glyphs = inline_objects<DisplayListGlyph>(command.glyphs);
+    if (glyphs.is_empty())
+        return;
+
+    SkTextBlobBuilder builder;
+    append_glyph_run(builder, resource_storage().font(command.font_id), glyphs, command.scale, {});
     auto blob = builder.make();
     if (!blob)
         return;
@@ -197,10 +374,91 @@ void DisplayListPlayerSkia::draw_glyph_run(DrawGlyphRun const& command)
     }
 }
 
+static void fill_pixel_span(u32* span, size_t length, u32 pixel)
+{
+    AK::SIMD::u32x4 pixels { pixel, pixel, pixel, pixel };
+    size_t i = 0;
+    for (; i + 4 <= length; i += 4)
+        AK::SIMD::store_unaligned(span + i, pixels);
+    for (; i < length; ++i)
+        span[i] = pixel;
+}
+
+// OPTIMIZATION: An opaque, pixel-aligned rectangle drawn on a raster surface without any transform other than an
+//               integer translation replaces the pixels it covers, so write them directly instead of going through
+//               Skia's paint pipeline. Effects and blending are applied by the layers they live in, so this is safe
+//               whatever layer is on top. Returns false if Skia needs to draw the rectangle instead.
+static bool fill_opaque_rect_directly(SkCanvas& canvas, Gfx::IntRect const& rect, Color color)
+{
+    if (color.alpha() != 255 || !canvas.isClipRect())
+        return false;
+
+    auto matrix = canvas.getLocalToDevice();
+    if (!is_translation_only(matrix))
+        return false;
+    auto translate_x = matrix.rc(0, 3);
+    auto translate_y = matrix.rc(1, 3);
+    if (translate_x != truncf(translate_x) || translate_y != truncf(translate_y))
+        return false;
+    auto device_rect = rect.translated(static_cast<int>(translate_x), static_cast<int>(translate_y));
+
+    SkImageInfo info;
+    size_t row_bytes = 0;
+    SkIPoint layer_origin;
+    auto* pixels = static_cast<u8*>(canvas.accessTopLayerPixels(&info, &row_bytes, &layer_origin));
+    if (!pixels || (info.colorType() != kBGRA_8888_SkColorType && info.colorType() != kRGBA_8888_SkColorType))
+        return false;
+    if (info.colorSpace() && !info.colorSpace()->isSRGB())
+        return false;
+
+    // NB: The device clip bounds are rounded out, so only the pixels inside their outermost ring are sure to be fully
+    //     inside the clip. Skia paints the rest of the rectangle, which gives the same result as painting all of it.
+    auto clip_bounds = canvas.getDeviceClipBounds();
+    if (clip_bounds.width() <= 2 || clip_bounds.height() <= 2)
+        return false;
+    auto clip_interior = Gfx::IntRect { clip_bounds.left() + 1, clip_bounds.top() + 1, clip_bounds.width() - 2, clip_bounds.height() - 2 };
+    auto layer_rect = Gfx::IntRect { layer_origin.x(), layer_origin.y(), info.width(), info.height() };
+    auto fill_rect = device_rect.intersected(clip_interior).intersected(layer_rect);
+    if (fill_rect.is_empty())
+        return false;
+
+    if (auto* surface = canvas.getSurface())
+        surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+
+    u32 pixel = info.colorType() == kBGRA_8888_SkColorType
+        ? color.value()
+        : (0xffu << 24) | (static_cast<u32>(color.blue()) << 16) | (static_cast<u32>(color.green()) << 8) | color.red();
+    for (int y = fill_rect.top(); y < fill_rect.bottom(); ++y) {
+        auto* row = reinterpret_cast<u32*>(pixels + static_cast<size_t>(y - layer_origin.y()) * row_bytes);
+        fill_pixel_span(row + (fill_rect.left() - layer_origin.x()), fill_rect.width(), pixel);
+    }
+
+    if (fill_rect == device_rect)
+        return true;
+
+    Gfx::IntRect const remaining_strips[] = {
+        { device_rect.left(), device_rect.top(), device_rect.width(), fill_rect.top() - device_rect.top() },
+        { device_rect.left(), fill_rect.bottom(), device_rect.width(), device_rect.bottom() - fill_rect.bottom() },
+        { device_rect.left(), fill_rect.top(), fill_rect.left() - device_rect.left(), fill_rect.height() },
+        { fill_rect.right(), fill_rect.top(), device_rect.right() - fill_rect.right(), fill_rect.height() },
+    };
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(to_skia_color(color));
+    for (auto const& strip : remaining_strips) {
+        if (!strip.is_empty())
+            canvas.drawRect(to_skia_rect(strip.translated(-device_rect.location() + rect.location())), paint);
+    }
+    return true;
+}
+
 void DisplayListPlayerSkia::fill_rect(FillRect const& command)
 {
     auto const& rect = command.rect;
     auto& canvas = surface().canvas();
+    if (fill_opaque_rect_directly(canvas, rect, command.color))
+        return;
+
     SkPaint paint;
     paint.setAntiAlias(true);
     paint.setColor(to_skia_color(command.color));
@@ -435,29 +693,87 @@ static Vector<SkColor4f> to_skia_gradient_colors(ReadonlySpan<Color> color_stop_
     return colors;
 }
 
-void DisplayListPlayerSkia::paint_linear_gradient(PaintLinearGradient const& command)
+// A gradient without any extent fills with a single color, which Skia picks for the tile mode as if we had given it the
+// zero-sized geometry itself. A local matrix can't scale the unit gradients down to that, so these are made directly.
+static sk_sp<SkShader> make_degenerate_gradient_shader(ReadonlySpan<Color> color_stop_colors, ReadonlySpan<float> color_stop_positions, SkTileMode tile_mode, Gfx::GradientInterpolationMethod interpolation_method)
 {
-    auto color_stop_colors = gradient_colors(command.color_stops);
-    auto color_stop_positions = gradient_positions(command.color_stops);
+    auto colors = to_skia_gradient_colors(color_stop_colors);
+    Array const points { SkPoint::Make(0, 0), SkPoint::Make(0, 0) };
+    return SkGradientShader::MakeLinear(points.data(), colors.data(), SkColorSpace::MakeSRGB(), color_stop_positions.data(), color_stop_positions.size(), tile_mode, to_skia_interpolation(interpolation_method), nullptr);
+}
+
+// The unit gradients go from (0, 0) to (0, -1) for linear gradients, have a radius of 1 around (0, 0) for radial
+// gradients, and start at 3 o'clock around (0, 0) for conic gradients.
+sk_sp<SkShader> DisplayListPlayerSkia::unit_gradient_shader(GradientShape shape, DisplayListGradientColorStops color_stops, Gfx::GradientInterpolationMethod interpolation_method)
+{
+    auto color_stop_colors = gradient_colors(color_stops);
+    auto color_stop_positions = gradient_positions(color_stops);
     VERIFY(!color_stop_colors.is_empty());
 
+    GradientShaderCache::Key key {
+        .shape = shape,
+        .repeating = color_stops.repeating,
+        .interpolation_method = interpolation_method,
+        .colors = {},
+        .positions = {},
+    };
+    key.colors.append(color_stop_colors.data(), color_stop_colors.size());
+    key.positions.append(color_stop_positions.data(), color_stop_positions.size());
+
+    auto& cache = *m_gradient_shader_cache;
+    if (auto it = cache.shaders.find(key); it != cache.shaders.end()) {
+        it->value.last_used_sequence_number = ++cache.use_sequence_number;
+        return it->value.shader;
+    }
+
     auto colors = to_skia_gradient_colors(color_stop_colors);
+    auto color_space = SkColorSpace::MakeSRGB();
+    auto interpolation = to_skia_interpolation(interpolation_method);
+    sk_sp<SkShader> shader;
+    switch (shape) {
+    case GradientShape::Linear: {
+        Array const points { SkPoint::Make(0, 0), SkPoint::Make(0, -1) };
+        shader = SkGradientShader::MakeLinear(points.data(), colors.data(), color_space, color_stop_positions.data(), color_stop_positions.size(), SkTileMode::kRepeat, interpolation, nullptr);
+        break;
+    }
+    case GradientShape::Radial: {
+        auto tile_mode = color_stops.repeating ? SkTileMode::kRepeat : SkTileMode::kClamp;
+        shader = SkGradientShader::MakeRadial(SkPoint::Make(0, 0), 1, colors.data(), color_space, color_stop_positions.data(), color_stop_positions.size(), tile_mode, interpolation, nullptr);
+        break;
+    }
+    case GradientShape::Conic:
+        shader = SkGradientShader::MakeSweep(0, 0, colors.data(), color_space, color_stop_positions.data(), color_stop_positions.size(), SkTileMode::kRepeat, 0, 360, interpolation, nullptr);
+        break;
+    }
 
+    cache.shaders.set(move(key), { shader, ++cache.use_sequence_number });
+    evict_least_recently_used(
+        cache.shaders,
+        [&] { return cache.shaders.size() > gradient_shader_cache_max_entries; },
+        [](auto const&) { });
+    return shader;
+}
+
+void DisplayListPlayerSkia::paint_linear_gradient(PaintLinearGradient const& command)
+{
     auto rect = command.gradient_rect.to_type<float>();
     auto length = calculate_gradient_length<float>(rect.size(), command.gradient_angle);
+    auto scale = command.repeat_length * length;
 
-    // Starting and ending points before rotation (0deg / "to top")
+    // Starting point before rotation (0deg / "to top")
     auto rect_center = rect.center();
     auto start = rect_center.translated(0, (.5f - command.first_stop_position) * length);
-    auto end = start.translated(0, command.repeat_length * -length);
-    Array const points { to_skia_point(start), to_skia_point(end) };
 
-    SkMatrix matrix;
-    matrix.setRotate(command.gradient_angle, rect_center.x(), rect_center.y());
-
-    auto color_space = SkColorSpace::MakeSRGB();
-    auto interpolation = to_skia_interpolation(command.interpolation_method);
-    auto shader = SkGradientShader::MakeLinear(points.data(), colors.data(), color_space, color_stop_positions.data(), color_stop_positions.size(), SkTileMode::kRepeat, interpolation, &matrix);
+    sk_sp<SkShader> shader;
+    if (scale == 0 || !isfinite(scale)) {
+        shader = make_degenerate_gradient_shader(gradient_colors(command.color_stops), gradient_positions(command.color_stops), SkTileMode::kRepeat, command.interpolation_method);
+    } else {
+        auto matrix = SkMatrix::RotateDeg(command.gradient_angle, to_skia_point(rect_center));
+        matrix.preTranslate(start.x(), start.y());
+        matrix.preScale(scale, scale);
+        if (auto unit_shader = unit_gradient_shader(GradientShape::Linear, command.color_stops, command.interpolation_method))
+            shader = unit_shader->makeWithLocalMatrix(matrix);
+    }
 
     SkPaint paint;
     paint.setDither(true);
@@ -465,8 +781,82 @@ void DisplayListPlayerSkia::paint_linear_gradient(PaintLinearGradient const& com
     surface().canvas().drawRect(to_skia_rect(rect), paint);
 }
 
+bool DisplayListPlayerSkia::paint_outer_box_shadow_from_cached_mask(PaintOuterBoxShadow const& command)
+{
+    // NB: The mask is blurred at device scale, so it can only be reused as is under a plain translation.
+    auto& canvas = surface().canvas();
+    if (command.blur_radius <= 0 || !is_translation_only(canvas.getLocalToDevice()))
+        return false;
+
+    // Skia's blur reaches three sigmas out, and the sigma is half the blur radius.
+    auto sigma = command.blur_radius / 2.0f;
+    auto margin = static_cast<int>(ceilf(3 * sigma)) + 1;
+
+    auto const& radii = command.shadow_corner_radii;
+    auto left = max(radii.top_left.horizontal_radius, radii.bottom_left.horizontal_radius);
+    auto right = max(radii.top_right.horizontal_radius, radii.bottom_right.horizontal_radius);
+    auto top = max(radii.top_left.vertical_radius, radii.top_right.vertical_radius);
+    auto bottom = max(radii.bottom_left.vertical_radius, radii.bottom_right.vertical_radius);
+
+    // The smallest rounded rect whose blurred edges have a row and a column that's unaffected by its corners.
+    auto mask_shape_width = left + right + 2 * margin + 1;
+    auto mask_shape_height = top + bottom + 2 * margin + 1;
+    if (command.shadow_rect.width() <= mask_shape_width || command.shadow_rect.height() <= mask_shape_height)
+        return false;
+
+    BoxShadowMaskCache::Key key { command.blur_radius, radii };
+    auto& cache = *m_box_shadow_mask_cache;
+    auto it = cache.masks.find(key);
+    if (it == cache.masks.end()) {
+        auto mask_surface = SkSurfaces::Raster(SkImageInfo::MakeA8(mask_shape_width + 2 * margin, mask_shape_height + 2 * margin));
+        if (!mask_surface)
+            return false;
+        SkPaint mask_paint;
+        mask_paint.setAntiAlias(true);
+        mask_paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, sigma));
+        mask_surface->getCanvas()->drawRRect(to_skia_rrect(Gfx::IntRect { margin, margin, mask_shape_width, mask_shape_height }, radii), mask_paint);
+
+        auto image = mask_surface->makeImageSnapshot();
+        if (auto* gr_context = m_skia_backend_context ? m_skia_backend_context->sk_context() : nullptr) {
+            if (auto texture = SkImages::TextureFromImage(gr_context, image.get(), skgpu::Mipmapped::kNo, skgpu::Budgeted::kYes))
+                image = move(texture);
+        }
+        if (!image)
+            return false;
+
+        BoxShadowMaskCache::Mask mask {
+            .image = move(image),
+            .center = SkIRect::MakeXYWH(2 * margin + left, 2 * margin + top, 1, 1),
+            .last_used_sequence_number = 0,
+            .approximate_byte_size = static_cast<size_t>(mask_surface->width()) * mask_surface->height(),
+        };
+        cache.approximate_byte_size += mask.approximate_byte_size;
+        cache.masks.set(key, move(mask));
+        it = cache.masks.find(key);
+    }
+    it->value.last_used_sequence_number = ++cache.use_sequence_number;
+    // NB: Keep our own reference, since pruning may drop the entry we just used.
+    auto image = it->value.image;
+    auto center = it->value.center;
+    cache.prune_to_limits();
+
+    auto content_rrect = to_skia_rrect(command.device_content_rect, command.content_corner_radii);
+    canvas.save();
+    canvas.clipRRect(content_rrect, SkClipOp::kDifference, true);
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(to_skia_color(command.color));
+    auto destination = command.shadow_rect.inflated(margin, margin, margin, margin);
+    canvas.drawImageNine(image.get(), center, to_skia_rect(destination), SkFilterMode::kLinear, &paint);
+    canvas.restore();
+    return true;
+}
+
 void DisplayListPlayerSkia::paint_outer_box_shadow(PaintOuterBoxShadow const& command)
 {
+    if (paint_outer_box_shadow_from_cached_mask(command))
+        return;
+
     auto content_rrect = to_skia_rrect(command.device_content_rect, command.content_corner_radii);
 
     auto& canvas = surface().canvas();
@@ -514,7 +904,7 @@ void DisplayListPlayerSkia::paint_text_shadow(PaintTextShadow const& command)
     SkPaint blur_paint;
     blur_paint.setImageFilter(blur_image_filter);
     canvas.saveLayer(SkCanvas::SaveLayerRec(nullptr, &blur_paint, nullptr, 0));
-    draw_glyph_run({ .font_id = command.font_id,
+    draw_glyph_run_immediately({ .font_id = command.font_id,
         .glyphs = command.glyphs,
         .rect = command.text_rect,
         .glyph_bounding_rect = command.shadow_bounding_rect,
@@ -792,28 +1182,25 @@ void DisplayListPlayerSkia::draw_rect(DrawRect const& command)
 
 void DisplayListPlayerSkia::paint_radial_gradient(PaintRadialGradient const& command)
 {
-    auto color_stop_colors = gradient_colors(command.color_stops);
-    auto color_stop_positions = gradient_positions(command.color_stops);
-    VERIFY(!color_stop_colors.is_empty());
-
-    auto colors = to_skia_gradient_colors(color_stop_colors);
-
     auto const& rect = command.rect;
     auto center = to_skia_point(command.center.translated(command.rect.location()));
 
     auto const size = command.size.to_type<float>();
-    SkMatrix matrix;
-    // Skia does not support specifying of horizontal and vertical radius's separately,
-    // so instead we apply scale matrix
-    auto const aspect_ratio = size.width() / size.height();
-    auto const sx = isinf(aspect_ratio) ? 1.0f : aspect_ratio;
-    matrix.setScale(sx, 1.0f, center.x(), center.y());
-
-    SkTileMode tile_mode = command.color_stops.repeating ? SkTileMode::kRepeat : SkTileMode::kClamp;
 
-    auto color_space = SkColorSpace::MakeSRGB();
-    auto interpolation = to_skia_interpolation(command.interpolation_method);
-    auto shader = SkGradientShader::MakeRadial(center, size.height(), colors.data(), color_space, color_stop_positions.data(), color_stop_positions.size(), tile_mode, interpolation, &matrix);
+    sk_sp<SkShader> shader;
+    if (size.height() == 0 || !isfinite(size.height())) {
+        auto tile_mode = command.color_stops.repeating ? SkTileMode::kRepeat : SkTileMode::kClamp;
+        shader = make_degenerate_gradient_shader(gradient_colors(command.color_stops), gradient_positions(command.color_stops), tile_mode, command.interpolation_method);
+    } else {
+        // Skia does not support specifying of horizontal and vertical radius's separately,
+        // so instead we apply scale matrix
+        auto const aspect_ratio = size.width() / size.height();
+        auto const sx = isinf(aspect_ratio) ? 1.0f : aspect_ratio;
+        auto matrix = SkMatrix::Translate(center.x(), center.y());
+        matrix.preScale(sx * size.height(), size.height());
+        if (auto unit_shader = unit_gradient_shader(GradientShape::Radial, command.color_stops, command.interpolation_method))
+            shader = unit_shader->makeWithLocalMatrix(matrix);
+    }
 
     SkPaint paint;
     paint.setDither(true);
@@ -824,25 +1211,20 @@ void DisplayListPlayerSkia::paint_radial_gradient(PaintRadialGradient const& com
 
 void DisplayListPlayerSkia::paint_conic_gradient(PaintConicGradient const& command)
 {
-    auto color_stop_colors = gradient_colors(command.color_stops);
-    auto color_stop_positions = gradient_positions(command.color_stops);
-    VERIFY(!color_stop_colors.is_empty());
-
-    auto colors = to_skia_gradient_colors(color_stop_colors);
-
     auto const& rect = command.rect;
     auto center = command.position.translated(rect.location()).to_type<float>();
 
-    SkMatrix matrix;
-    matrix.setRotate(-90 + command.start_angle, center.x(), center.y());
-    auto color_space = SkColorSpace::MakeSRGB();
-    auto interpolation = to_skia_interpolation(command.interpolation_method);
-    auto shader = SkGradientShader::MakeSweep(center.x(), center.y(), colors.data(), color_space, color_stop_positions.data(), color_stop_positions.size(), SkTileMode::kRepeat, 0, 360, interpolation, &matrix);
+    auto matrix = SkMatrix::Translate(center.x(), center.y());
+    matrix.preRotate(-90 + command.start_angle);
+
+    auto shader = unit_gradient_shader(GradientShape::Conic, command.color_stops, command.interpolation_method);
+    if (!shader)
+        return;
 
     SkPaint paint;
     paint.setDither(true);
     paint.setAntiAlias(true);
-    paint.setShader(shader);
+    paint.setShader(shader->makeWithLocalMatrix(matrix));
     surface().canvas().drawRect(to_skia_rect(rect), paint);
 }
 
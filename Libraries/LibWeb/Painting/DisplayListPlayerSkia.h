@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Function.h>
+#include <AK/OwnPtr.h>
 #include <LibGfx/DecodedImageFrameSkiaImageCache.h>
 #include <LibWeb/Painting/DisplayList.h>
 #include <LibWeb/Painting/DisplayListCommand.h>
@@ -14,6 +15,8 @@
 
 class GrDirectContext;
 class SkPaint;
+class SkShader;
+class SkTextBlobBuilder;
 
 namespace Web::Painting {
 
@@ -69,6 +72,17 @@ private:
     void add_clip_path(Gfx::Path const&) override;
 
     bool would_be_fully_clipped_by_painter(Gfx::IntRect) const override;
+    void flush_batched_commands() override;
+
+    void draw_glyph_run_immediately(DrawGlyphRun const&);
+    bool paint_outer_box_shadow_from_cached_mask(PaintOuterBoxShadow const&);
+
+    enum class GradientShape : u8 {
+        Linear,
+        Radial,
+        Conic,
+    };
+    sk_sp<SkShader> unit_gradient_shader(GradientShape, DisplayListGradientColorStops, Gfx::GradientInterpolationMethod);
 
     SkPaint paint_style_to_skia_paint(DisplayListPaintStyle const&, Gfx::FloatRect const& bounding_rect);
     Gfx::Path path_from_data(DisplayListDataSpan) const;
@@ -77,6 +91,18 @@ private:
 
     RefPtr<Gfx::SkiaBackendContext> m_skia_backend_context;
     Gfx::DecodedImageFrameSkiaImageCache m_image_cache;
+
+    struct BoxShadowMaskCache;
+    OwnPtr<BoxShadowMaskCache> m_box_shadow_mask_cache;
+
+    struct GradientShaderCache;
+    OwnPtr<GradientShaderCache> m_gradient_shader_cache;
+
+    // Consecutive horizontal glyph runs of the same color are collected into one text blob with a run per command, and
+    // drawn with a single draw call.
+    OwnPtr<SkTextBlobBuilder> m_glyph_run_batch;
+    Color m_glyph_run_batch_color;
+    bool m_glyph_run_batch_is_empty { true };
 };
 
 }
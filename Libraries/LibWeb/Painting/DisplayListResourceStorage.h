@@ -70,6 +70,12 @@ struct DisplayListResourceTransaction {
     Vector<ImageFrameResourceId> image_frame_ids_to_remove;
     Vector<VideoFrameResourceId> video_frame_ids_to_remove;
     Vector<DisplayListResourceId> display_list_ids_to_remove;
+
+    bool is_empty() const
+    {
+        return fonts.is_empty() && image_frames.is_empty() && video_frames.is_empty() && display_lists.is_empty()
+            && font_ids_to_remove.is_empty() && image_frame_ids_to_remove.is_empty() && video_frame_ids_to_remove.is_empty() && display_list_ids_to_remove.is_empty();
+    }
 };
 
 class WEB_API DisplayListResourceStorage {
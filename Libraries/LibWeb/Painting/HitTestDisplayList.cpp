@@ -16,6 +16,7 @@
 namespace Web::Painting {
 
 static constexpr double spatial_index_cell_size = 128.0;
+static constexpr double spatial_index_coarse_cell_size = 2048.0;
 static constexpr size_t max_bucketed_cells_per_item = 64;
 // Treat small block-axis gaps between caret line fragments as the same visual row.
 static constexpr CSSPixels caret_line_block_axis_range_slop = 4;
@@ -24,9 +25,9 @@ static constexpr CSSPixels caret_line_block_axis_compare_slop = 12;
 // Within the chosen line, tolerate larger block-axis differences before snapping across inline gaps.
 static constexpr CSSPixels caret_item_block_axis_compare_slop = 32;
 
-static i32 spatial_index_cell_for(CSSPixels offset)
+static i32 spatial_index_cell_for(CSSPixels offset, double cell_size = spatial_index_cell_size)
 {
-    return static_cast<i32>(floor(offset.to_double() / spatial_index_cell_size));
+    return static_cast<i32>(floor(offset.to_double() / cell_size));
 }
 
 static u64 spatial_index_cell_key(i32 x, i32 y)
@@ -282,36 +283,60 @@ HitTestDisplayList::SpatialIndex& HitTestDisplayList::spatial_index_for(VisualCo
     return *m_spatial_indexes[index];
 }
 
+static bool add_item_to_grid(HashMap<u64, Vector<size_t>>& cells, double cell_size, CSSPixelRect const& rect, size_t item_index)
+{
+    auto min_x = spatial_index_cell_for(rect.left(), cell_size);
+    auto max_x = spatial_index_cell_for(rect.right(), cell_size);
+    auto min_y = spatial_index_cell_for(rect.top(), cell_size);
+    auto max_y = spatial_index_cell_for(rect.bottom(), cell_size);
+    auto column_count = static_cast<i64>(max_x) - min_x + 1;
+    auto row_count = static_cast<i64>(max_y) - min_y + 1;
+    if (column_count <= 0 || row_count <= 0)
+        return false;
+    auto cell_count = static_cast<u64>(column_count) * static_cast<u64>(row_count);
+    if (cell_count > max_bucketed_cells_per_item)
+        return false;
+
+    for (auto y = min_y; y <= max_y; ++y) {
+        for (auto x = min_x; x <= max_x; ++x)
+            cells.ensure(spatial_index_cell_key(x, y)).append(item_index);
+    }
+    return true;
+}
+
 void HitTestDisplayList::add_item_to_spatial_index(size_t item_index)
 {
     auto const& item = m_items[item_index];
     auto& spatial_index = spatial_index_for(item.visual_context_index);
+    spatial_index.last_item_index = item_index;
 
     if (item.kind == ItemKind::ChromeWidget || item.rect.is_empty()) {
         spatial_index.unbucketed_items.append(item_index);
         return;
     }
 
-    auto min_x = spatial_index_cell_for(item.rect.left());
-    auto max_x = spatial_index_cell_for(item.rect.right());
-    auto min_y = spatial_index_cell_for(item.rect.top());
-    auto max_y = spatial_index_cell_for(item.rect.bottom());
-    auto column_count = static_cast<i64>(max_x) - min_x + 1;
-    auto row_count = static_cast<i64>(max_y) - min_y + 1;
-    if (column_count <= 0 || row_count <= 0) {
-        spatial_index.unbucketed_items.append(item_index);
+    if (add_item_to_grid(spatial_index.cells, spatial_index_cell_size, item.rect, item_index))
         return;
-    }
-    auto cell_count = static_cast<u64>(column_count) * static_cast<u64>(row_count);
-    if (cell_count > max_bucketed_cells_per_item) {
-        spatial_index.unbucketed_items.append(item_index);
+    if (add_item_to_grid(spatial_index.coarse_cells, spatial_index_coarse_cell_size, item.rect, item_index))
         return;
-    }
+    spatial_index.unbucketed_items.append(item_index);
+}
 
-    for (auto y = min_y; y <= max_y; ++y) {
-        for (auto x = min_x; x <= max_x; ++x)
-            spatial_index.cells.ensure(spatial_index_cell_key(x, y)).append(item_index);
-    }
+// NB: Each list is in paint order, and an item never appears twice in the lists for one point.
+template<typename Callback>
+void HitTestDisplayList::SpatialIndex::for_each_candidate_list(CSSPixelPoint local_point, Callback callback) const
+{
+    callback(unbucketed_items);
+
+    auto coarse_x = spatial_index_cell_for(local_point.x(), spatial_index_coarse_cell_size);
+    auto coarse_y = spatial_index_cell_for(local_point.y(), spatial_index_coarse_cell_size);
+    if (auto bucket = coarse_cells.get(spatial_index_cell_key(coarse_x, coarse_y)); bucket.has_value())
+        callback(*bucket);
+
+    auto x = spatial_index_cell_for(local_point.x());
+    auto y = spatial_index_cell_for(local_point.y());
+    if (auto bucket = cells.get(spatial_index_cell_key(x, y)); bucket.has_value())
+        callback(*bucket);
 }
 
 bool HitTestDisplayList::item_can_produce_caret_position(Item const& item) const
@@ -691,21 +716,20 @@ Optional<CaretPosition> HitTestDisplayList::caret_position_from_point(CSSPixelPo
         auto const& spatial_index = m_spatial_indexes[visual_context_index.value()];
         VERIFY(spatial_index);
 
+        if (topmost_item_index.has_value() && topmost_hit_item_index.has_value()
+            && spatial_index->last_item_index <= min(*topmost_item_index, *topmost_hit_item_index))
+            continue;
+
         auto local_point = local_point_for_visual_context(visual_context_index, point, viewport_paintable, device_pixels_per_css_pixel);
         if (!local_point.has_value())
             continue;
 
         auto previous_topmost_item_index = topmost_item_index;
         auto previous_topmost_hit_item_index = topmost_hit_item_index;
-        find_topmost_item_in_list(spatial_index->unbucketed_items, *local_point, chrome_metrics, topmost_hit_item_index);
-        find_topmost_caret_item_in_list(spatial_index->unbucketed_items, *local_point, chrome_metrics, topmost_item_index);
-
-        auto x = spatial_index_cell_for(local_point->x());
-        auto y = spatial_index_cell_for(local_point->y());
-        if (auto bucket = spatial_index->cells.get(spatial_index_cell_key(x, y)); bucket.has_value()) {
-            find_topmost_item_in_list(*bucket, *local_point, chrome_metrics, topmost_hit_item_index);
-            find_topmost_caret_item_in_list(*bucket, *local_point, chrome_metrics, topmost_item_index);
-        }
+        spatial_index->for_each_candidate_list(*local_point, [&](Vector<size_t> const& item_indices) {
+            find_topmost_item_in_list(item_indices, *local_point, chrome_metrics, topmost_hit_item_index);
+            find_topmost_caret_item_in_list(item_indices, *local_point, chrome_metrics, topmost_item_index);
+        });
 
         if (topmost_item_index != previous_topmost_item_index)
             topmost_item_local_point = local_point;
@@ -907,17 +931,18 @@ Optional<HitTestResult> HitTestDisplayList::hit_test(CSSPixelPoint point, HitTes
         auto const& spatial_index = m_spatial_indexes[visual_context_index.value()];
         VERIFY(spatial_index);
 
+        // NB: Skip mapping the point into visual contexts that can't have anything above the current hit.
+        if (topmost_item_index.has_value() && spatial_index->last_item_index <= *topmost_item_index)
+            continue;
+
         auto local_point = local_point_for_visual_context(visual_context_index, point, viewport_paintable, device_pixels_per_css_pixel);
         if (!local_point.has_value())
             continue;
 
         auto previous_topmost_item_index = topmost_item_index;
-        find_topmost_item_in_list(spatial_index->unbucketed_items, *local_point, chrome_metrics, topmost_item_index);
-
-        auto x = spatial_index_cell_for(local_point->x());
-        auto y = spatial_index_cell_for(local_point->y());
-        if (auto bucket = spatial_index->cells.get(spatial_index_cell_key(x, y)); bucket.has_value())
-            find_topmost_item_in_list(*bucket, *local_point, chrome_metrics, topmost_item_index);
+        spatial_index->for_each_candidate_list(*local_point, [&](Vector<size_t> const& item_indices) {
+            find_topmost_item_in_list(item_indices, *local_point, chrome_metrics, topmost_item_index);
+        });
 
         if (topmost_item_index != previous_topmost_item_index)
             topmost_item_local_point = local_point;
@@ -951,12 +976,9 @@ TraversalDecision HitTestDisplayList::hit_test_all(CSSPixelPoint point, Viewport
         if (!local_point.has_value())
             continue;
 
-        find_items_in_list(spatial_index->unbucketed_items, *local_point, chrome_metrics, hit_item_indices);
-
-        auto x = spatial_index_cell_for(local_point->x());
-        auto y = spatial_index_cell_for(local_point->y());
-        if (auto bucket = spatial_index->cells.get(spatial_index_cell_key(x, y)); bucket.has_value())
-            find_items_in_list(*bucket, *local_point, chrome_metrics, hit_item_indices);
+        spatial_index->for_each_candidate_list(*local_point, [&](Vector<size_t> const& item_indices) {
+            find_items_in_list(item_indices, *local_point, chrome_metrics, hit_item_indices);
+        });
     }
 
     quick_sort(hit_item_indices, [](auto a, auto b) { return a > b; });
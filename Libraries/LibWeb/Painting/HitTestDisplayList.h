@@ -68,9 +68,18 @@ private:
         BorderRadiiData border_radii;
     };
 
+    // Items are bucketed into a grid of small cells, or if they would span too many of those, into a grid of large
+    // cells. Only items that are too large even for that, or have no meaningful rect, are checked on every hit test.
     struct SpatialIndex {
         HashMap<u64, Vector<size_t>> cells;
+        HashMap<u64, Vector<size_t>> coarse_cells;
         Vector<size_t> unbucketed_items;
+        // Items are appended in paint order, so once a hit above this index has been found, nothing in this visual
+        // context can be on top of it.
+        size_t last_item_index { 0 };
+
+        template<typename Callback>
+        void for_each_candidate_list(CSSPixelPoint, Callback) const;
     };
 
     struct CaretLine {
@@ -27,6 +27,31 @@ void SVGPathPaintable::reset_for_relayout()
 {
     SVGGraphicsPaintable::reset_for_relayout();
     m_computed_path.clear();
+    m_device_path_cache.clear();
+    m_hit_test_bounds_cache.clear();
+}
+
+Gfx::Path const& SVGPathPaintable::device_path(Gfx::AffineTransform const& paint_transform, Gfx::FloatPoint offset) const
+{
+    VERIFY(computed_path().has_value());
+    if (m_device_path_cache.has_value() && m_device_path_cache->paint_transform == paint_transform && m_device_path_cache->offset == offset)
+        return m_device_path_cache->path;
+
+    auto path = computed_path()->copy_transformed(paint_transform);
+    path.offset(offset);
+    m_device_path_cache = DevicePath { paint_transform, offset, move(path) };
+    return m_device_path_cache->path;
+}
+
+CSSPixelRect SVGPathPaintable::hit_test_bounds(Gfx::AffineTransform const& svg_to_css_pixels_transform) const
+{
+    VERIFY(computed_path().has_value());
+    if (m_hit_test_bounds_cache.has_value() && m_hit_test_bounds_cache->svg_to_css_pixels_transform == svg_to_css_pixels_transform)
+        return m_hit_test_bounds_cache->bounding_box;
+
+    auto bounding_box = computed_path()->copy_transformed(svg_to_css_pixels_transform).bounding_box().to_type<CSSPixels>();
+    m_hit_test_bounds_cache = HitTestBounds { svg_to_css_pixels_transform, bounding_box };
+    return bounding_box;
 }
 
 Optional<CSSPixelRect> SVGPathPaintable::clip_path_geometry_bounds(Gfx::AffineTransform const& additional_transform) const
@@ -82,8 +107,7 @@ void SVGPathPaintable::paint(DisplayListRecordingContext& context, PaintPhase ph
     auto maybe_view_box = svg_node->dom_node().view_box();
 
     auto paint_transform = computed_transforms().svg_to_device_pixels_transform(context);
-    auto path = computed_path()->copy_transformed(paint_transform);
-    path.offset(offset);
+    auto const& path = device_path(paint_transform, offset);
 
     auto svg_viewport = [&] {
         if (maybe_view_box.has_value())
@@ -228,8 +252,7 @@ void SVGPathPaintable::record_hit_test_items(DisplayListRecordingContext& contex
     if (computed_values().visibility() != CSS::Visibility::Visible || !visible_for_hit_testing())
         return;
 
-    auto transformed_path = computed_path()->copy_transformed(computed_transforms().svg_to_css_pixels_transform());
-    auto bounding_box = transformed_path.bounding_box().to_type<CSSPixels>();
+    auto bounding_box = hit_test_bounds(computed_transforms().svg_to_css_pixels_transform());
     if (bounding_box.is_empty())
         return;
 
@@ -28,6 +28,8 @@ public:
     void set_computed_path(Gfx::Path path)
     {
         m_computed_path = move(path);
+        m_device_path_cache.clear();
+        m_hit_test_bounds_cache.clear();
     }
 
     Optional<Gfx::Path> const& computed_path() const { return m_computed_path; }
@@ -41,6 +43,25 @@ protected:
 
 private:
     virtual bool is_svg_path_paintable() const final { return true; }
+
+    Gfx::Path const& device_path(Gfx::AffineTransform const& paint_transform, Gfx::FloatPoint offset) const;
+    CSSPixelRect hit_test_bounds(Gfx::AffineTransform const& svg_to_css_pixels_transform) const;
+
+    // OPTIMIZATION: Repaints that don't relayout, such as a hover changing a fill color, would otherwise transform the
+    //               whole computed path again for every paint and for every hit test display list. The transformed
+    //               path and its bounds are kept until the computed path or its transform changes.
+    struct DevicePath {
+        Gfx::AffineTransform paint_transform;
+        Gfx::FloatPoint offset;
+        Gfx::Path path;
+    };
+    mutable Optional<DevicePath> m_device_path_cache;
+
+    struct HitTestBounds {
+        Gfx::AffineTransform svg_to_css_pixels_transform;
+        CSSPixelRect bounding_box;
+    };
+    mutable Optional<HitTestBounds> m_hit_test_bounds_cache;
 };
 
 template<>
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <core/SkCanvas.h>
+#include <core/SkPixmap.h>
+#include <core/SkSurface.h>
+
+#include <AK/Atomic.h>
+#include <AK/AtomicRefCounted.h>
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/PaintingSurface.h>
+#include <LibSync/ConditionVariable.h>
+#include <LibSync/Mutex.h>
+#include <LibThreading/ThreadPool.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/DisplayListPlayerSkia.h>
+#include <LibWeb/Painting/DisplayListResourceStorage.h>
+#include <LibWeb/Painting/TiledDisplayListRasterizer.h>
+
+namespace Web::Painting {
+
+// Below this many tiles, handing work to the pool costs more than it saves.
+static constexpr size_t minimum_tile_count = 4;
+
+// Threads from the pool that join the calling thread in rasterizing tiles.
+static constexpr size_t helper_count = 3;
+
+struct TiledDisplayListRasterizer::Worker {
+    Worker()
+        : player(RefPtr<Gfx::SkiaBackendContext> {})
+        , tile_bitmap(MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, { tile_size, tile_size })))
+        , tile_surface(Gfx::PaintingSurface::wrap_bitmap(*tile_bitmap))
+    {
+    }
+
+    DisplayListPlayerSkia player;
+    NonnullRefPtr<Gfx::Bitmap> tile_bitmap;
+    NonnullRefPtr<Gfx::PaintingSurface> tile_surface;
+};
+
+namespace {
+
+// Shared between the calling thread and the helpers it submits. A helper may only get to run after all tiles are done
+// and rasterize() has returned, so anything it touches before joining has to live here.
+struct TileWork : public AtomicRefCounted<TileWork> {
+    Vector<Gfx::IntRect> tiles;
+    Atomic<size_t> next_tile { 0 };
+
+    Sync::Mutex mutex;
+    Sync::ConditionVariable helpers_done { mutex };
+    size_t active_helper_count { 0 };
+    bool finished { false };
+
+    // Raster surfaces aren't safe to read and write from several threads at once, so copies to and from the target go
+    // through this.
+    Sync::Mutex target_mutex;
+
+    bool join()
+    {
+        Sync::MutexLocker locker(mutex);
+        if (finished)
+            return false;
+        ++active_helper_count;
+        return true;
+    }
+
+    void leave()
+    {
+        Sync::MutexLocker locker(mutex);
+        --active_helper_count;
+        helpers_done.broadcast();
+    }
+
+    void finish_and_wait_for_helpers()
+    {
+        Sync::MutexLocker locker(mutex);
+        finished = true;
+        helpers_done.wait_while([this] { return active_helper_count > 0; });
+    }
+};
+
+}
+
+static bool contains_backdrop_filter(DisplayList const& display_list, DisplayListResourceStorage const& resource_storage)
+{
+    bool found = false;
+    display_list.for_each_command_header([&](DisplayListCommandHeader const& header, ReadonlyBytes payload) {
+        if (found)
+            return;
+        if (header.type == DisplayListCommandType::ApplyBackdropFilter) {
+            found = true;
+        } else if (header.type == DisplayListCommandType::PaintNestedDisplayList) {
+            auto command = read_display_list_object<PaintNestedDisplayList>(payload);
+            found = contains_backdrop_filter(resource_storage.display_list(command.display_list_id), resource_storage);
+        }
+    });
+    return found;
+}
+
+static Vector<Gfx::IntRect> tiles_covering(Gfx::IntRect rect)
+{
+    using Rasterizer = TiledDisplayListRasterizer;
+
+    // Tiles are aligned to a fixed grid, so the same area of the surface always lands in the same tile.
+    Vector<Gfx::IntRect> tiles;
+    auto first_row = rect.top() / Rasterizer::tile_size;
+    auto first_column = rect.left() / Rasterizer::tile_size;
+    for (auto y = first_row * Rasterizer::tile_size; y < rect.bottom(); y += Rasterizer::tile_size) {
+        for (auto x = first_column * Rasterizer::tile_size; x < rect.right(); x += Rasterizer::tile_size) {
+            auto tile = Gfx::IntRect { x, y, Rasterizer::tile_size, Rasterizer::tile_size }.intersected(rect);
+            if (!tile.is_empty())
+                tiles.append(tile);
+        }
+    }
+    return tiles;
+}
+
+TiledDisplayListRasterizer::TiledDisplayListRasterizer() = default;
+TiledDisplayListRasterizer::~TiledDisplayListRasterizer() = default;
+
+bool TiledDisplayListRasterizer::can_rasterize_in_tiles(DisplayList const& display_list, DisplayListResourceStorage const& resource_storage, Gfx::PaintingSurface const& target, Gfx::IntRect rect)
+{
+    if (target.skia_backend_context())
+        return false;
+    rect.intersect(target.rect());
+    if (static_cast<size_t>(rect.width()) * rect.height() < minimum_tile_count * tile_size * tile_size)
+        return false;
+    return !contains_backdrop_filter(display_list, resource_storage);
+}
+
+void TiledDisplayListRasterizer::rasterize(
+    DisplayList const& display_list,
+    AccumulatedVisualContextTree const& visual_context_tree,
+    DisplayListResourceStorage const& resource_storage,
+    ScrollStateSnapshot const& scroll_state,
+    Gfx::PaintingSurface& target,
+    Gfx::IntRect rect,
+    TileBackground background)
+{
+    auto work = adopt_ref(*new TileWork);
+    work->tiles = tiles_covering(rect.intersected(target.rect()));
+    if (work->tiles.is_empty())
+        return;
+
+    auto thread_count = min(work->tiles.size(), helper_count + 1);
+    while (m_workers.size() < thread_count)
+        m_workers.append(make<Worker>());
+
+    auto rasterize_tile = [&](Worker& worker, Gfx::IntRect tile) {
+        auto& tile_canvas = worker.tile_surface->canvas();
+        SkPixmap tile_surface_pixels;
+        SkPixmap tile_pixels;
+        VERIFY(worker.tile_surface->sk_surface().peekPixels(&tile_surface_pixels));
+        VERIFY(tile_surface_pixels.extractSubset(&tile_pixels, SkIRect::MakeWH(tile.width(), tile.height())));
+
+        if (background == TileBackground::Target) {
+            Sync::MutexLocker locker(work->target_mutex);
+            target.sk_surface().readPixels(tile_pixels, tile.x(), tile.y());
+        } else {
+            tile_canvas.clear(SK_ColorTRANSPARENT);
+        }
+
+        auto save_count = tile_canvas.save();
+        tile_canvas.clipRect(SkRect::MakeIWH(tile.width(), tile.height()));
+        tile_canvas.translate(-tile.x(), -tile.y());
+        worker.player.execute(display_list, visual_context_tree, resource_storage, scroll_state, worker.tile_surface);
+        tile_canvas.restoreToCount(save_count);
+        worker.player.flush(*worker.tile_surface);
+
+        Sync::MutexLocker locker(work->target_mutex);
+        target.sk_surface().writePixels(tile_pixels, tile.x(), tile.y());
+    };
+
+    auto rasterize_until_done = [&](Worker& worker) {
+        while (true) {
+            auto index = work->next_tile.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            if (index >= work->tiles.size())
+                return;
+            rasterize_tile(worker, work->tiles[index]);
+        }
+    };
+
+    // Helpers join whenever the pool gets to them. The calling thread rasterizes along with them, and on its own if
+    // none of them get there in time, then waits for the ones that joined to finish their last tile.
+    for (size_t i = 1; i < thread_count; ++i) {
+        Threading::ThreadPool::the().submit(
+            [work, &worker = *m_workers[i], &rasterize_until_done] {
+                if (!work->join())
+                    return;
+                rasterize_until_done(worker);
+                work->leave();
+            },
+            Threading::ThreadPool::Priority::UserBlocking);
+    }
+
+    rasterize_until_done(*m_workers[0]);
+    work->finish_and_wait_for_helpers();
+}
+
+}
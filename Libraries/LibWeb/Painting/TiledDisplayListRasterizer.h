@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Vector.h>
+#include <LibGfx/Forward.h>
+#include <LibGfx/Rect.h>
+#include <LibWeb/Export.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::Painting {
+
+// Rasterizes a display list into a CPU surface by splitting the target area into a grid of fixed-size tiles and
+// replaying the display list once per tile, on the thread pool and the calling thread at the same time. Each thread
+// replays into its own tile-sized surface with its own player, and finished tiles are copied into the target.
+//
+// The GPU backends already rasterize in parallel on the device, so only raster surfaces are tiled.
+class WEB_API TiledDisplayListRasterizer {
+    AK_MAKE_NONCOPYABLE(TiledDisplayListRasterizer);
+    AK_MAKE_NONMOVABLE(TiledDisplayListRasterizer);
+
+public:
+    static constexpr int tile_size = 256;
+
+    enum class TileBackground {
+        // Tiles start out with what the target already holds, as if the display list was replayed onto it directly.
+        Target,
+        Transparent,
+    };
+
+    TiledDisplayListRasterizer();
+    ~TiledDisplayListRasterizer();
+
+    // Whether replaying `display_list` into `rect` of `target` is worth splitting up, and would paint the same pixels
+    // as replaying it directly. Backdrop filters read pixels outside the tile being painted, so they are never tiled.
+    static bool can_rasterize_in_tiles(DisplayList const&, DisplayListResourceStorage const&, Gfx::PaintingSurface const& target, Gfx::IntRect rect);
+
+    void rasterize(DisplayList const&, AccumulatedVisualContextTree const&, DisplayListResourceStorage const&, ScrollStateSnapshot const&, Gfx::PaintingSurface& target, Gfx::IntRect rect, TileBackground);
+
+private:
+    struct Worker;
+
+    Vector<NonnullOwnPtr<Worker>> m_workers;
+};
+
+}
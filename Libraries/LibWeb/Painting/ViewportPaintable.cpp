@@ -97,6 +97,7 @@ void ViewportPaintable::reset_for_relayout()
     m_paintable_boxes_with_auto_content_visibility.clear();
     m_visual_context_tree.clear();
     m_visual_context_tree_needs_compositor_update = false;
+    m_async_animations.clear();
 }
 
 void ViewportPaintable::build_stacking_context_tree_if_needed()
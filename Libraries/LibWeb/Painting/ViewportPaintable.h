@@ -8,6 +8,7 @@
 #pragma once
 
 #include <AK/Optional.h>
+#include <LibWeb/Compositor/AsyncAnimations.h>
 #include <LibWeb/Export.h>
 #include <LibWeb/Painting/PaintableWithLines.h>
 #include <LibWeb/Painting/ScrollState.h>
@@ -36,6 +37,11 @@ public:
     void did_update_visual_context_tree_in_compositor() { m_visual_context_tree_needs_compositor_update = false; }
     bool has_visual_context_tree() const { return m_visual_context_tree.has_value(); }
 
+    // The animations in the visual context tree that the compositor can sample by itself.
+    Vector<Compositor::AsyncAnimation> const& async_animations() const { return m_async_animations; }
+    bool has_async_animations() const { return !m_async_animations.is_empty(); }
+    void set_async_animations(Vector<Compositor::AsyncAnimation> async_animations) { m_async_animations = move(async_animations); }
+
     GC::Ptr<Selection::Selection> selection() const;
     void recompute_selection_states(DOM::Range&);
     void reset_selection_states();
@@ -76,6 +82,7 @@ private:
 
     Optional<AccumulatedVisualContextTree> m_visual_context_tree;
     bool m_visual_context_tree_needs_compositor_update { false };
+    Vector<Compositor::AsyncAnimation> m_async_animations;
 };
 
 template<>
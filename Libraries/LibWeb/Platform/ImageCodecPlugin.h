@@ -41,6 +41,14 @@ public:
 
     virtual NonnullRefPtr<Core::Promise<DecodedImage>> decode_image(ReadonlyBytes, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
 
+    // Decodes an image while its data is still arriving, calling on_partial_image with what has been decoded so far.
+    // Returns the id that the calls below take, or nothing if the decode couldn't start, after calling on_rejected.
+    virtual Optional<i64> begin_incremental_decode(ESCAPING Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image, ESCAPING Function<ErrorOr<void>(DecodedImage&)> on_resolved, ESCAPING Function<void(Error&)> on_rejected) = 0;
+    virtual void append_incremental_decode_data(i64 decode_id, ReadonlyBytes) = 0;
+    virtual void finish_incremental_decode(i64 decode_id) = 0;
+    // The callbacks passed to begin_incremental_decode() won't be called after this.
+    virtual void cancel_incremental_decode(i64 decode_id) = 0;
+
     virtual void request_animation_frames(i64 session_id, u32 start_frame_index, u32 count) = 0;
     virtual void stop_animation_decode(i64 session_id) = 0;
 
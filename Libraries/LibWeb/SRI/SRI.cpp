@@ -168,6 +168,10 @@ ErrorOr<bool> do_bytes_match_metadata_list(ByteBuffer const& bytes, StringView m
     // 3. Let metadata be the result of getting the strongest metadata from parsedMetadata.
     auto metadata = TRY(get_strongest_metadata_from_set(parsed_metadata));
 
+    // NB: Every item of the strongest metadata uses the same algorithm, so the bytes only need to be hashed once no
+    //     matter how many values the list has for it.
+    Optional<String> actual_value;
+
     // 4. For each item in metadata:
     for (auto const& item : metadata) {
         // 1. Let algorithm be the item["alg"].
@@ -177,10 +181,11 @@ ErrorOr<bool> do_bytes_match_metadata_list(ByteBuffer const& bytes, StringView m
         auto& expected_value = item.base64_value;
 
         // 3. Let actualValue be the result of applying algorithm to bytes.
-        auto actual_value = TRY(apply_algorithm_to_bytes(algorithm, bytes));
+        if (!actual_value.has_value())
+            actual_value = TRY(apply_algorithm_to_bytes(algorithm, bytes));
 
         // 4. If actualValue is a case-sensitive match for expectedValue, return true.
-        if (actual_value == expected_value)
+        if (*actual_value == expected_value)
             return true;
     }
 
@@ -5,6 +5,7 @@
  */
 
 #include <LibJS/Runtime/Array.h>
+#include <LibJS/Runtime/ArrayBuffer.h>
 #include <LibWeb/Bindings/Cache.h>
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/DOM/AbortSignal.h>
@@ -16,6 +17,7 @@
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/ServiceWorker/Cache.h>
+#include <LibWeb/ServiceWorker/CacheStorage.h>
 #include <LibWeb/ServiceWorker/ServiceWorkerGlobalScope.h>
 #include <LibWeb/Streams/ReadableStream.h>
 #include <LibWeb/Streams/ReadableStreamDefaultReader.h>
@@ -25,8 +27,10 @@ namespace Web::ServiceWorker {
 GC_DEFINE_ALLOCATOR(Cache);
 GC_DEFINE_ALLOCATOR(CacheBatchOperation);
 
-Cache::Cache(JS::Realm& realm, GC::Ref<RequestResponseList> request_response_list)
+Cache::Cache(JS::Realm& realm, GC::Ref<CacheStorage> cache_storage, String cache_name, GC::Ref<RequestResponseList> request_response_list)
     : Bindings::PlatformObject(realm)
+    , m_cache_storage(cache_storage)
+    , m_cache_name(move(cache_name))
     , m_request_response_list(request_response_list)
 {
 }
@@ -40,6 +44,7 @@ void Cache::initialize(JS::Realm& realm)
 void Cache::visit_edges(Visitor& visitor)
 {
     Base::visit_edges(visitor);
+    visitor.visit(m_cache_storage);
     visitor.visit(m_request_response_list);
 }
 
@@ -501,9 +506,16 @@ GC::Ref<WebIDL::Promise> Cache::put(Fetch::RequestInfo request, GC::Ref<Fetch::R
 
     // 18. Let realm be this’s relevant realm.
     // 19. Return the result of the fulfillment of bodyReadPromise:
-    return WebIDL::upon_fulfillment(body_read_promise, GC::create_function(realm.heap(), [this, &realm, operations](JS::Value) -> WebIDL::ExceptionOr<JS::Value> {
+    return WebIDL::upon_fulfillment(body_read_promise, GC::create_function(realm.heap(), [this, &realm, operations, cloned_response](JS::Value body_bytes) -> WebIDL::ExceptionOr<JS::Value> {
         HTML::TemporaryExecutionContext context { realm };
 
+        // NB: Keep the buffered copy of the body as the cached response's body, so that the cache can persist it
+        //     without reading the body's stream.
+        if (body_bytes.is_object()) {
+            if (auto* array_buffer = as_if<JS::ArrayBuffer>(body_bytes.as_object()))
+                cloned_response->unsafe_response()->set_body(Fetch::Infrastructure::byte_sequence_as_body(realm, array_buffer->buffer()));
+        }
+
         // 1. Let cacheJobPromise be a new promise.
         auto cache_job_promise = WebIDL::create_promise(realm);
 
@@ -828,9 +840,14 @@ WebIDL::ExceptionOr<bool> Cache::batch_cache_operations(GC::Ref<GC::HeapVector<G
         auto backup_response = request_response->response->clone(realm);
 
         auto backup_request_response = realm.heap().allocate<RequestResponse>(backup_request, backup_response);
+        backup_request_response->bottle_key = request_response->bottle_key;
         backup_cache->elements().append(backup_request_response);
     }
 
+    // NB: The cache storage persists the pairs that were added or removed once the operations have all succeeded.
+    auto previous_items = realm.heap().allocate<RequestResponseList>();
+    previous_items->elements() = cache->elements();
+
     // 3. Let addedItems be an empty list.
     auto added_items = realm.heap().allocate<RequestResponseList>();
 
@@ -922,7 +939,8 @@ WebIDL::ExceptionOr<bool> Cache::batch_cache_operations(GC::Ref<GC::HeapVector<G
         // 1. Remove all the items from the relevant request response list.
         // 2. For each requestResponse of backupCache:
         //     1. Append requestResponse to the relevant request response list.
-        m_request_response_list = backup_cache;
+        // NB: The list is shared with the name to cache map, so its items are replaced rather than the list itself.
+        cache->elements() = move(backup_cache->elements());
 
         // 3. Throw the exception.
         return result.release_error();
@@ -931,6 +949,7 @@ WebIDL::ExceptionOr<bool> Cache::batch_cache_operations(GC::Ref<GC::HeapVector<G
         //       storage during the batch operation job.
     }
 
+    m_cache_storage->persist_cache_changes(m_cache_name, previous_items->elements(), cache->elements());
     return result.release_value();
 }
 
@@ -55,7 +55,7 @@ public:
     GC::Ref<WebIDL::Promise> keys(Optional<Fetch::RequestInfo>, Bindings::CacheQueryOptions);
 
 private:
-    Cache(JS::Realm&, GC::Ref<RequestResponseList>);
+    Cache(JS::Realm&, GC::Ref<CacheStorage>, String cache_name, GC::Ref<RequestResponseList>);
 
     virtual void initialize(JS::Realm&) override;
     virtual void visit_edges(Visitor&) override;
@@ -67,6 +67,8 @@ private:
     GC::Ref<RequestResponseList> query_cache(GC::Ref<Fetch::Infrastructure::Request> request_query, Bindings::CacheQueryOptions options = {}, GC::Ptr<RequestResponseList> = {}, CloneCache = Cache::CloneCache::Yes);
     WebIDL::ExceptionOr<bool> batch_cache_operations(GC::Ref<GC::HeapVector<GC::Ref<CacheBatchOperation>>>);
 
+    GC::Ref<CacheStorage> m_cache_storage;
+    String m_cache_name;
     GC::Ref<RequestResponseList> m_request_response_list;
 };
 
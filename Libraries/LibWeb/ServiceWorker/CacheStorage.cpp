@@ -5,12 +5,19 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/QuickSort.h>
+#include <AK/Random.h>
 #include <LibJS/Runtime/Array.h>
 #include <LibWeb/Bindings/CacheStorage.h>
 #include <LibWeb/Bindings/Intrinsics.h>
+#include <LibWeb/Bindings/PrincipalHostDefined.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
 #include <LibWeb/HTML/Scripting/TemporaryExecutionContext.h>
+#include <LibWeb/Page/Page.h>
 #include <LibWeb/Platform/EventLoopPlugin.h>
 #include <LibWeb/ServiceWorker/CacheStorage.h>
+#include <LibWeb/StorageAPI/StorageKey.h>
 #include <LibWeb/WebIDL/Promise.h>
 
 namespace Web::ServiceWorker {
@@ -53,7 +60,7 @@ GC::Ref<WebIDL::Promise> CacheStorage::match(Fetch::RequestInfo request, Binding
                 // 1. Resolve promise with the result of running the algorithm specified in match(request, options)
                 //    method of Cache interface with request and options (providing cache as thisArgument to the
                 //    [[Call]] internal method of match(request, options).)
-                auto cache = realm.create<Cache>(realm, result.release_value());
+                auto cache = realm.create<Cache>(realm, *this, *options.cache_name, result.release_value());
                 auto match = cache->match(move(request), move(options));
                 WebIDL::resolve_promise(realm, promise, match->promise());
 
@@ -76,7 +83,7 @@ GC::Ref<WebIDL::Promise> CacheStorage::match(Fetch::RequestInfo request, Binding
         for (auto const& [cache_name, cache_list] : relevant_name_to_cache_map()) {
             // 1. Set promise to the result of reacting to itself with a fulfillment handler that, when called with
             //    argument response, performs the following substeps:
-            promise = WebIDL::upon_fulfillment(promise, GC::create_function(realm.heap(), [&realm, cache_list, request, options](JS::Value response) mutable -> WebIDL::ExceptionOr<JS::Value> {
+            promise = WebIDL::upon_fulfillment(promise, GC::create_function(realm.heap(), [this, &realm, cache_name, cache_list, request, options](JS::Value response) mutable -> WebIDL::ExceptionOr<JS::Value> {
                 HTML::TemporaryExecutionContext context { realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
 
                 // 1. If response is not undefined, return response.
@@ -86,7 +93,7 @@ GC::Ref<WebIDL::Promise> CacheStorage::match(Fetch::RequestInfo request, Binding
                 // 2. Return the result of running the algorithm specified in match(request, options) method of Cache
                 //    interface with request and options as the arguments (providing cache as thisArgument to the
                 //    [[Call]] internal method of match(request, options).)
-                auto cache = realm.create<Cache>(realm, cache_list);
+                auto cache = realm.create<Cache>(realm, *this, cache_name, cache_list);
                 auto match = cache->match(move(request), move(options));
                 return match->promise();
             }));
@@ -136,7 +143,7 @@ GC::Ref<WebIDL::Promise> CacheStorage::open(String const& cache_name)
         //     1. If cacheName matches key, then:
         if (auto value = relevant_name_to_cache_map.get(cache_name); value.has_value()) {
             // 1. Resolve promise with a new Cache object that represents value.
-            WebIDL::resolve_promise(realm, promise, realm.create<Cache>(realm, value.release_value()));
+            WebIDL::resolve_promise(realm, promise, realm.create<Cache>(realm, *this, cache_name, value.release_value()));
 
             // 2. Abort these steps.
             return;
@@ -149,9 +156,10 @@ GC::Ref<WebIDL::Promise> CacheStorage::open(String const& cache_name)
         //    exceeding the granted quota limit, reject promise with a QuotaExceededError and abort these steps.
         // FIXME: Handle cache quotas.
         relevant_name_to_cache_map.set(cache_name, cache);
+        persist_new_cache(cache_name);
 
         // 4. Resolve promise with a new Cache object that represents cache.
-        WebIDL::resolve_promise(realm, promise, realm.create<Cache>(realm, cache));
+        WebIDL::resolve_promise(realm, promise, realm.create<Cache>(realm, *this, cache_name, cache));
     }));
 
     // 3. Return promise.
@@ -185,7 +193,8 @@ GC::Ref<WebIDL::Promise> CacheStorage::delete_(String const& cache_name)
             HTML::TemporaryExecutionContext context { realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes };
 
             // 1. Remove the relevant name to cache map[cacheName].
-            relevant_name_to_cache_map().remove(cache_name);
+            if (auto cache = relevant_name_to_cache_map().take(cache_name); cache.has_value())
+                remove_persisted_cache(cache_name, *cache);
 
             // 2. Resolve cacheJobPromise with true.
             WebIDL::resolve_promise(realm, cache_job_promise, JS::Value { true });
@@ -233,9 +242,222 @@ NameToCacheMap& CacheStorage::relevant_name_to_cache_map()
     // The relevant name to cache map for a CacheStorage object is the name to cache map associated with the result of
     // running obtain a local storage bottle map with the object’s relevant settings object and "caches".
 
-    // FIXME: We don't yet have a way to serialize request/response pairs for storage in the UI process. For now, we
-    //        use an ephemeral name to cache map.
+    // NB: The bottle map is the browser process's storage jar, which only holds strings. So the name to cache map lives
+    //     here, and is loaded from the jar the first time it is needed. Every change to it is then written back.
+    if (!m_did_load_persisted_caches)
+        load_persisted_caches();
     return m_relevant_name_to_cache_map;
 }
 
+// NB: Every cache is stored under a marker key, holding the cache's order among the caches. Every request/response pair
+//     is stored under a key of its own, so a change to a cache only writes the pairs that changed. The random part of
+//     the key keeps pairs with the same URL apart, since they may differ by the headers their response varies on.
+static constexpr auto CACHE_BOTTLE_KEY_PREFIX = "c:"sv;
+static constexpr auto REQUEST_RESPONSE_BOTTLE_KEY_PREFIX = "e:"sv;
+static constexpr size_t REQUEST_RESPONSE_BOTTLE_KEY_ID_LENGTH = 16;
+
+static String cache_bottle_key(String const& cache_name)
+{
+    return MUST(String::formatted("{}{}", CACHE_BOTTLE_KEY_PREFIX, cache_name));
+}
+
+static String request_response_bottle_key(String const& cache_name)
+{
+    return MUST(String::formatted("{}{:016x}:{}", REQUEST_RESPONSE_BOTTLE_KEY_PREFIX, get_random<u64>(), cache_name));
+}
+
+static Optional<StringView> cache_name_from_request_response_bottle_key(StringView bottle_key)
+{
+    auto id_and_name = bottle_key.substring_view(REQUEST_RESPONSE_BOTTLE_KEY_PREFIX.length());
+    if (id_and_name.length() <= REQUEST_RESPONSE_BOTTLE_KEY_ID_LENGTH || id_and_name[REQUEST_RESPONSE_BOTTLE_KEY_ID_LENGTH] != ':')
+        return {};
+    return id_and_name.substring_view(REQUEST_RESPONSE_BOTTLE_KEY_ID_LENGTH + 1);
+}
+
+void CacheStorage::load_persisted_caches()
+{
+    m_did_load_persisted_caches = true;
+
+    auto storage_key = StorageAPI::obtain_a_storage_key(HTML::relevant_settings_object(*this));
+    if (!storage_key.has_value())
+        return;
+    m_serialized_storage_key = storage_key->to_string();
+
+    auto& realm = this->realm();
+    auto items = Bindings::principal_host_defined_page(realm).client().page_did_request_storage_area(StorageAPI::StorageEndpointType::Caches, *m_serialized_storage_key);
+
+    struct PersistedCache {
+        u64 order { 0 };
+        Vector<DeserializedRequestResponse> items;
+    };
+    HashMap<String, PersistedCache> caches;
+
+    // NB: This keeps the pairs alive until they are in the name to cache map.
+    auto loaded_request_responses = realm.heap().allocate<RequestResponseList>();
+
+    for (auto const& [bottle_key, value] : items) {
+        if (bottle_key.starts_with_bytes(CACHE_BOTTLE_KEY_PREFIX)) {
+            auto cache_name = MUST(bottle_key.substring_from_byte_offset(CACHE_BOTTLE_KEY_PREFIX.length()));
+            caches.ensure(cache_name).order = value.to_number<u64>().value_or(0);
+        }
+    }
+
+    for (auto const& [bottle_key, value] : items) {
+        if (!bottle_key.starts_with_bytes(REQUEST_RESPONSE_BOTTLE_KEY_PREFIX))
+            continue;
+
+        auto cache_name = cache_name_from_request_response_bottle_key(bottle_key);
+        if (!cache_name.has_value())
+            continue;
+
+        auto cache = caches.get(*cache_name);
+        if (!cache.has_value())
+            continue;
+
+        auto request_response = deserialize_request_response(realm, value);
+        if (request_response.is_error()) {
+            dbgln("Unable to load persisted cache entry: {}", request_response.error());
+            continue;
+        }
+
+        request_response.value().request_response->bottle_key = bottle_key;
+        loaded_request_responses->elements().append(request_response.value().request_response);
+        cache->items.append(request_response.release_value());
+        m_last_persisted_order = max(m_last_persisted_order, cache->items.last().order);
+    }
+
+    Vector<String> cache_names;
+    for (auto const& [cache_name, cache] : caches) {
+        cache_names.append(cache_name);
+        m_last_persisted_order = max(m_last_persisted_order, cache.order);
+    }
+    quick_sort(cache_names, [&](auto const& a, auto const& b) {
+        return caches.get(a)->order < caches.get(b)->order;
+    });
+
+    for (auto const& cache_name : cache_names) {
+        auto& cache = *caches.get(cache_name);
+        quick_sort(cache.items, [](auto const& a, auto const& b) { return a.order < b.order; });
+
+        auto request_response_list = realm.heap().allocate<RequestResponseList>();
+        for (auto const& item : cache.items)
+            request_response_list->elements().append(item.request_response);
+        m_relevant_name_to_cache_map.set(cache_name, request_response_list);
+    }
+}
+
+u64 CacheStorage::next_persisted_order()
+{
+    // NB: Orders are based on the current time, so that they keep increasing across the processes that share this
+    //     storage key, and never repeat within this one.
+    auto now = static_cast<u64>(UnixDateTime::now().milliseconds_since_epoch()) * 1000;
+    m_last_persisted_order = max(now, m_last_persisted_order + 1);
+    return m_last_persisted_order;
+}
+
+void CacheStorage::persist_new_cache(String const& cache_name)
+{
+    if (!m_serialized_storage_key.has_value())
+        return;
+
+    auto order = String::number(next_persisted_order());
+    Bindings::principal_host_defined_page(realm()).client().page_did_set_storage_item(StorageAPI::StorageEndpointType::Caches, *m_serialized_storage_key, cache_bottle_key(cache_name), order);
+}
+
+void CacheStorage::remove_persisted_cache(String const& cache_name, RequestResponseList& cache)
+{
+    if (!m_serialized_storage_key.has_value())
+        return;
+
+    auto& client = Bindings::principal_host_defined_page(realm()).client();
+    for (auto request_response : cache.elements()) {
+        if (auto bottle_key = exchange(request_response->bottle_key, OptionalNone {}); bottle_key.has_value())
+            client.page_did_remove_storage_item(StorageAPI::StorageEndpointType::Caches, *m_serialized_storage_key, *bottle_key);
+    }
+    client.page_did_remove_storage_item(StorageAPI::StorageEndpointType::Caches, *m_serialized_storage_key, cache_bottle_key(cache_name));
+}
+
+void CacheStorage::persist_cache_changes(String const& cache_name, ReadonlySpan<GC::Ref<RequestResponse>> previous_items, ReadonlySpan<GC::Ref<RequestResponse>> items)
+{
+    if (!m_serialized_storage_key.has_value())
+        return;
+
+    HashTable<RequestResponse const*> previous_item_set;
+    for (auto item : previous_items)
+        previous_item_set.set(item.ptr());
+
+    HashTable<RequestResponse const*> item_set;
+    for (auto item : items)
+        item_set.set(item.ptr());
+
+    auto& client = Bindings::principal_host_defined_page(realm()).client();
+    for (auto item : previous_items) {
+        if (item_set.contains(item.ptr()))
+            continue;
+        if (auto bottle_key = exchange(item->bottle_key, OptionalNone {}); bottle_key.has_value())
+            client.page_did_remove_storage_item(StorageAPI::StorageEndpointType::Caches, *m_serialized_storage_key, *bottle_key);
+    }
+
+    for (auto item : items) {
+        if (previous_item_set.contains(item.ptr()))
+            continue;
+        item->bottle_key = request_response_bottle_key(cache_name);
+        persist_request_response(item);
+    }
+}
+
+void CacheStorage::persist_request_response(GC::Ref<RequestResponse> request_response)
+{
+    auto order = next_persisted_order();
+
+    auto body = request_response->response->unsafe_response()->body();
+    if (!body) {
+        write_persisted_request_response(request_response, order, {});
+        return;
+    }
+
+    auto did_write_request_response = body->source().visit(
+        [&](ByteBuffer const& bytes) {
+            write_persisted_request_response(request_response, order, bytes.bytes());
+            return true;
+        },
+        [&](Core::ImmutableBytes const& bytes) {
+            write_persisted_request_response(request_response, order, bytes.bytes());
+            return true;
+        },
+        [](auto const&) {
+            return false;
+        });
+    if (did_write_request_response)
+        return;
+
+    // NB: Bodies that are only available as a stream, such as those of the responses stored by addAll(), are read from
+    //     a clone, which leaves the cached response's own body untouched.
+    auto& realm = this->realm();
+    auto bottle_key = *request_response->bottle_key;
+
+    auto process_body = GC::create_function(realm.heap(), [this, request_response, order, bottle_key](ByteBuffer bytes) {
+        // NB: The pair may have been removed from its cache while its body was being read.
+        if (request_response->bottle_key != bottle_key)
+            return;
+        write_persisted_request_response(request_response, order, bytes.bytes());
+    });
+    auto process_body_error = GC::create_function(realm.heap(), [request_response](JS::Value) {
+        dbgln("Unable to read the body of cached response for {}", request_response->request->url());
+    });
+
+    body->clone(realm)->fully_read(realm, process_body, process_body_error, GC::Ref { HTML::relevant_global_object(*this) });
+}
+
+void CacheStorage::write_persisted_request_response(RequestResponse const& request_response, u64 order, Optional<ReadonlyBytes> body)
+{
+    auto serialized_request_response = serialize_request_response(request_response, order, body);
+    if (serialized_request_response.is_error()) {
+        dbgln("Unable to persist cached response for {}: {}", request_response.request->url(), serialized_request_response.error());
+        return;
+    }
+
+    Bindings::principal_host_defined_page(realm()).client().page_did_set_storage_item(StorageAPI::StorageEndpointType::Caches, *m_serialized_storage_key, *request_response.bottle_key, serialized_request_response.release_value());
+}
+
 }
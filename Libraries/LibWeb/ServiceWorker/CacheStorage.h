@@ -26,6 +26,8 @@ public:
     GC::Ref<WebIDL::Promise> delete_(String const& cache_name);
     GC::Ref<WebIDL::Promise> keys();
 
+    void persist_cache_changes(String const& cache_name, ReadonlySpan<GC::Ref<RequestResponse>> previous_items, ReadonlySpan<GC::Ref<RequestResponse>> items);
+
 private:
     explicit CacheStorage(JS::Realm&);
 
@@ -34,7 +36,18 @@ private:
 
     NameToCacheMap& relevant_name_to_cache_map();
 
+    void load_persisted_caches();
+    void persist_new_cache(String const& cache_name);
+    void remove_persisted_cache(String const& cache_name, RequestResponseList&);
+    void persist_request_response(GC::Ref<RequestResponse>);
+    void write_persisted_request_response(RequestResponse const&, u64 order, Optional<ReadonlyBytes> body);
+    u64 next_persisted_order();
+
     NameToCacheMap m_relevant_name_to_cache_map;
+
+    Optional<String> m_serialized_storage_key;
+    bool m_did_load_persisted_caches { false };
+    u64 m_last_persisted_order { 0 };
 };
 
 }
@@ -4,6 +4,10 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Base64.h>
+#include <AK/MemoryStream.h>
+#include <LibURL/Parser.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Requests.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/Responses.h>
 #include <LibWeb/ServiceWorker/NameToCacheMap.h>
@@ -19,4 +23,160 @@ void RequestResponse::visit_edges(Visitor& visitor)
     visitor.visit(response);
 }
 
+// Increment this version when changing the layout of serialized request/response pairs.
+static constexpr u8 REQUEST_RESPONSE_SERIALIZATION_VERSION = 1;
+
+static ErrorOr<void> write_bytes(Stream& stream, ReadonlyBytes bytes)
+{
+    TRY(stream.write_value<LittleEndian<u32>>(bytes.size()));
+    TRY(stream.write_until_depleted(bytes));
+    return {};
+}
+
+static ErrorOr<ByteBuffer> read_bytes(FixedMemoryStream& stream)
+{
+    auto size = TRY(stream.read_value<LittleEndian<u32>>());
+    if (size > stream.remaining())
+        return Error::from_string_literal("Serialized request/response is truncated");
+
+    auto bytes = TRY(ByteBuffer::create_uninitialized(size));
+    TRY(stream.read_until_filled(bytes));
+    return bytes;
+}
+
+static ErrorOr<void> write_header_list(Stream& stream, HTTP::HeaderList const& header_list)
+{
+    TRY(stream.write_value<LittleEndian<u32>>(header_list.headers().size()));
+    for (auto const& header : header_list) {
+        TRY(write_bytes(stream, header.name.bytes()));
+        TRY(write_bytes(stream, header.value.bytes()));
+    }
+    return {};
+}
+
+static ErrorOr<NonnullRefPtr<HTTP::HeaderList>> read_header_list(FixedMemoryStream& stream)
+{
+    auto count = TRY(stream.read_value<LittleEndian<u32>>());
+    auto header_list = HTTP::HeaderList::create();
+
+    for (u32 i = 0; i < count; ++i) {
+        auto name = TRY(read_bytes(stream));
+        auto value = TRY(read_bytes(stream));
+        header_list->append({ ByteString { name.bytes() }, ByteString { value.bytes() } });
+    }
+    return header_list;
+}
+
+static ErrorOr<void> write_url(Stream& stream, URL::URL const& url)
+{
+    return write_bytes(stream, url.serialize().bytes());
+}
+
+static ErrorOr<URL::URL> read_url(FixedMemoryStream& stream)
+{
+    auto serialized_url = TRY(read_bytes(stream));
+    auto url = URL::Parser::basic_parse(StringView { serialized_url.bytes() });
+    if (!url.has_value())
+        return Error::from_string_literal("Serialized request/response contains an invalid URL");
+    return url.release_value();
+}
+
+ErrorOr<String> serialize_request_response(RequestResponse const& request_response, u64 order, Optional<ReadonlyBytes> body)
+{
+    AllocatingMemoryStream stream;
+    TRY(stream.write_value(REQUEST_RESPONSE_SERIALIZATION_VERSION));
+    TRY(stream.write_value<LittleEndian<u64>>(order));
+
+    auto const& request = *request_response.request;
+    TRY(write_url(stream, request.url()));
+    TRY(write_bytes(stream, request.method().bytes()));
+    TRY(write_header_list(stream, request.header_list()));
+
+    // NB: Filtered responses are rebuilt from their type and their internal response when they are deserialized.
+    auto response = request_response.response->unsafe_response();
+    TRY(stream.write_value(static_cast<u8>(request_response.response->type())));
+    TRY(stream.write_value<LittleEndian<u16>>(response->status()));
+    TRY(write_bytes(stream, response->status_message().bytes()));
+    TRY(write_header_list(stream, response->header_list()));
+
+    TRY(stream.write_value<LittleEndian<u32>>(response->url_list().size()));
+    for (auto const& url : response->url_list())
+        TRY(write_url(stream, url));
+
+    TRY(stream.write_value<LittleEndian<u32>>(response->cors_exposed_header_name_list().size()));
+    for (auto const& name : response->cors_exposed_header_name_list())
+        TRY(write_bytes(stream, name.bytes()));
+
+    TRY(stream.write_value<u8>(body.has_value()));
+    if (body.has_value())
+        TRY(write_bytes(stream, *body));
+
+    auto bytes = TRY(stream.read_until_eof());
+    return encode_base64(bytes);
+}
+
+ErrorOr<DeserializedRequestResponse> deserialize_request_response(JS::Realm& realm, StringView serialized_request_response)
+{
+    using Fetch::Infrastructure::Response;
+
+    auto& vm = realm.vm();
+    auto bytes = TRY(decode_base64(serialized_request_response));
+    FixedMemoryStream stream { bytes.bytes() };
+
+    if (TRY(stream.read_value<u8>()) != REQUEST_RESPONSE_SERIALIZATION_VERSION)
+        return Error::from_string_literal("Serialized request/response has an unknown version");
+    auto order = TRY(stream.read_value<LittleEndian<u64>>());
+
+    auto request = Fetch::Infrastructure::Request::create(vm);
+    request->set_url(TRY(read_url(stream)));
+    request->set_method(ByteString { TRY(read_bytes(stream)).bytes() });
+    request->set_header_list(TRY(read_header_list(stream)));
+
+    auto type = TRY(stream.read_value<u8>());
+    if (type > to_underlying(Response::Type::OpaqueRedirect))
+        return Error::from_string_literal("Serialized request/response has an unknown response type");
+
+    auto response = Response::create(vm);
+    response->set_status(TRY(stream.read_value<LittleEndian<u16>>()));
+    response->set_status_message(ByteString { TRY(read_bytes(stream)).bytes() });
+    response->set_header_list(TRY(read_header_list(stream)));
+
+    auto url_count = TRY(stream.read_value<LittleEndian<u32>>());
+    Vector<URL::URL> url_list;
+    for (u32 i = 0; i < url_count; ++i)
+        url_list.append(TRY(read_url(stream)));
+    response->set_url_list(move(url_list));
+
+    auto cors_exposed_header_name_count = TRY(stream.read_value<LittleEndian<u32>>());
+    Vector<ByteString> cors_exposed_header_name_list;
+    for (u32 i = 0; i < cors_exposed_header_name_count; ++i)
+        cors_exposed_header_name_list.append(ByteString { TRY(read_bytes(stream)).bytes() });
+    response->set_cors_exposed_header_name_list(move(cors_exposed_header_name_list));
+
+    if (TRY(stream.read_value<u8>()) != 0)
+        response->set_body(Fetch::Infrastructure::byte_sequence_as_body(realm, TRY(read_bytes(stream))));
+
+    GC::Ref<Response> filtered_response = response;
+    switch (static_cast<Response::Type>(type)) {
+    case Response::Type::Basic:
+        filtered_response = Fetch::Infrastructure::BasicFilteredResponse::create(vm, response);
+        break;
+    case Response::Type::CORS:
+        filtered_response = Fetch::Infrastructure::CORSFilteredResponse::create(vm, response);
+        break;
+    case Response::Type::Opaque:
+        filtered_response = Fetch::Infrastructure::OpaqueFilteredResponse::create(vm, response);
+        break;
+    case Response::Type::OpaqueRedirect:
+        filtered_response = Fetch::Infrastructure::OpaqueRedirectFilteredResponse::create(vm, response);
+        break;
+    case Response::Type::Default:
+    case Response::Type::Error:
+        response->set_type(static_cast<Response::Type>(type));
+        break;
+    }
+
+    return DeserializedRequestResponse { order, vm.heap().allocate<RequestResponse>(request, filtered_response) };
+}
+
 }
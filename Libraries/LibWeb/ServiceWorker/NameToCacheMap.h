@@ -6,6 +6,9 @@
 
 #pragma once
 
+#include <AK/Error.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
 #include <LibGC/Cell.h>
 #include <LibGC/CellAllocator.h>
 #include <LibGC/HeapVector.h>
@@ -28,6 +31,9 @@ struct RequestResponse : public GC::Cell {
 
     GC::Ref<Fetch::Infrastructure::Request> request;
     GC::Ref<Fetch::Infrastructure::Response> response;
+
+    // Non-standard: The key this pair is persisted under in its storage key's "caches" bottle, if it has been persisted.
+    Optional<String> bottle_key;
 };
 
 // https://w3c.github.io/ServiceWorker/#dfn-request-response-list
@@ -36,4 +42,15 @@ using RequestResponseList = GC::HeapVector<GC::Ref<RequestResponse>>;
 // https://w3c.github.io/ServiceWorker/#dfn-name-to-cache-map
 using NameToCacheMap = OrderedHashMap<String, GC::Ref<RequestResponseList>>;
 
+// Non-standard: Request/response pairs are persisted as opaque strings in the browser process's storage jar. The order
+//               is the position of the pair in its cache, which the jar doesn't keep track of. A null body is
+//               serialized separately from an empty one.
+ErrorOr<String> serialize_request_response(RequestResponse const&, u64 order, Optional<ReadonlyBytes> body);
+
+struct DeserializedRequestResponse {
+    u64 order { 0 };
+    GC::Ref<RequestResponse> request_response;
+};
+ErrorOr<DeserializedRequestResponse> deserialize_request_response(JS::Realm&, StringView);
+
 }
@@ -105,34 +105,99 @@ void LocalStorageBottle::visit_edges(GC::Cell::Visitor& visitor)
     visitor.visit(m_page);
 }
 
+// OPTIMIZATION: The storage jar lives in the browser process, and asking it for every read made each localStorage
+//               access a synchronous IPC round trip. Instead, the whole area of a storage key is loaded once and
+//               shared by every bottle in this process. Reads are served from it, and writes update it and are sent
+//               on without waiting for a reply. The browser process tells us when another process changes an area.
+struct CachedLocalStorageArea {
+    OrderedHashMap<String, String> items;
+    size_t size_in_bytes { 0 };
+};
+
+static HashMap<String, NonnullOwnPtr<CachedLocalStorageArea>>& cached_storage_areas()
+{
+    static HashMap<String, NonnullOwnPtr<CachedLocalStorageArea>> areas;
+    return areas;
+}
+
+static size_t storage_item_size_in_bytes(String const& key, String const& value)
+{
+    return key.bytes().size() + value.bytes().size();
+}
+
+CachedLocalStorageArea& LocalStorageBottle::cached_storage_area() const
+{
+    auto& areas = cached_storage_areas();
+    if (auto area = areas.get(m_serialized_storage_key); area.has_value())
+        return **area;
+
+    auto area = make<CachedLocalStorageArea>();
+    area->items = m_page->client().page_did_request_storage_area(StorageEndpointType::LocalStorage, m_serialized_storage_key);
+    for (auto const& [key, value] : area->items)
+        area->size_in_bytes += storage_item_size_in_bytes(key, value);
+
+    auto& result = *area;
+    areas.set(m_serialized_storage_key, move(area));
+    return result;
+}
+
+void LocalStorageBottle::discard_cached_storage_areas(Optional<String> const& serialized_storage_key)
+{
+    if (serialized_storage_key.has_value())
+        cached_storage_areas().remove(*serialized_storage_key);
+    else
+        cached_storage_areas().clear();
+}
+
 size_t LocalStorageBottle::size() const
 {
-    return m_page->client().page_did_request_storage_keys(Web::StorageAPI::StorageEndpointType::LocalStorage, m_storage_key.to_string()).size();
+    return cached_storage_area().items.size();
 }
 
 Vector<String> LocalStorageBottle::keys() const
 {
-    return m_page->client().page_did_request_storage_keys(Web::StorageAPI::StorageEndpointType::LocalStorage, m_storage_key.to_string());
+    return cached_storage_area().items.keys();
 }
 
 Optional<String> LocalStorageBottle::get(String const& key) const
 {
-    return m_page->client().page_did_request_storage_item(Web::StorageAPI::StorageEndpointType::LocalStorage, m_storage_key.to_string(), key);
+    if (auto value = cached_storage_area().items.get(key); value.has_value())
+        return value.value();
+    return OptionalNone {};
 }
 
 WebView::StorageSetResult LocalStorageBottle::set(String const& key, String const& value)
 {
-    return m_page->client().page_did_set_storage_item(Web::StorageAPI::StorageEndpointType::LocalStorage, m_storage_key.to_string(), key, value);
+    auto& area = cached_storage_area();
+    auto old_value = get(key);
+
+    // NB: This applies the same quota as the storage jar, which checks it again when the item arrives there.
+    auto size_in_bytes = area.size_in_bytes + storage_item_size_in_bytes(key, value);
+    if (old_value.has_value())
+        size_in_bytes -= storage_item_size_in_bytes(key, *old_value);
+    if (m_quota.has_value() && size_in_bytes > m_quota.value())
+        return WebView::StorageOperationError::QuotaExceededError;
+
+    area.items.set(key, value);
+    area.size_in_bytes = size_in_bytes;
+    m_page->client().page_did_set_storage_item(StorageEndpointType::LocalStorage, m_serialized_storage_key, key, value);
+    return old_value;
 }
 
 void LocalStorageBottle::clear()
 {
-    m_page->client().page_did_clear_storage(Web::StorageAPI::StorageEndpointType::LocalStorage, m_storage_key.to_string());
+    auto& area = cached_storage_area();
+    area.items.clear();
+    area.size_in_bytes = 0;
+    m_page->client().page_did_clear_storage(StorageEndpointType::LocalStorage, m_serialized_storage_key);
 }
 
 void LocalStorageBottle::remove(String const& key)
 {
-    m_page->client().page_did_remove_storage_item(Web::StorageAPI::StorageEndpointType::LocalStorage, m_storage_key.to_string(), key);
+    auto& area = cached_storage_area();
+    if (auto old_value = area.items.take(key); old_value.has_value())
+        area.size_in_bytes -= storage_item_size_in_bytes(key, *old_value);
+    m_page->client().page_did_remove_storage_item(StorageEndpointType::LocalStorage, m_serialized_storage_key, key);
 }
 
 size_t SessionStorageBottle::size() const
@@ -49,6 +49,8 @@ protected:
     Optional<u64> m_quota;
 };
 
+struct CachedLocalStorageArea;
+
 class LocalStorageBottle final : public StorageBottle {
     GC_CELL(LocalStorageBottle, StorageBottle);
     GC_DECLARE_ALLOCATOR(LocalStorageBottle);
@@ -68,16 +70,25 @@ public:
 
     virtual void visit_edges(GC::Cell::Visitor& visitor) override;
 
+    String const& serialized_storage_key() const { return m_serialized_storage_key; }
+
+    // Drops this process's copy of the given storage area, or of all of them, after another process changed it.
+    static void discard_cached_storage_areas(Optional<String> const& serialized_storage_key);
+
 private:
     explicit LocalStorageBottle(GC::Ref<Page> page, StorageKey key, Optional<u64> quota)
         : StorageBottle(quota)
         , m_page(move(page))
         , m_storage_key(move(key))
+        , m_serialized_storage_key(m_storage_key.to_string())
     {
     }
 
+    CachedLocalStorageArea& cached_storage_area() const;
+
     GC::Ref<Page> m_page;
     StorageKey m_storage_key;
+    String m_serialized_storage_key;
 };
 
 class SessionStorageBottle final : public StorageBottle {
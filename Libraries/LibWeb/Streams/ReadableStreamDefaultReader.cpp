@@ -87,16 +87,33 @@ void ReadLoopReadRequest::on_chunk(JS::Value chunk)
     }
 
     auto const& array = static_cast<JS::Uint8Array const&>(chunk.as_object());
+    on_chunk_bytes(array.data());
+}
 
+void ReadLoopReadRequest::on_chunk_bytes(ReadonlyBytes bytes)
+{
     // 2. Append the bytes represented by chunk to bytes.
-    m_bytes.append(array.data());
+    m_bytes.append(bytes);
 
-    // FIXME: As the spec suggests, implement this non-recursively - instead of directly. It is not too big of a deal currently
-    //        as we enqueue the entire blob buffer in one go, meaning that we only recurse a single time. Once we begin queuing
-    //        up more than one chunk at a time, we may run into stack overflow problems.
-    //
     // 3. Read-loop given reader, bytes, successSteps, and failureSteps.
-    readable_stream_default_reader_read(m_reader, *this);
+    read_next_chunk();
+}
+
+void ReadLoopReadRequest::read_next_chunk()
+{
+    // NB: Chunks that are already queued are handed to us from within the read, so reading the next one directly would
+    //     recurse once per queued chunk. As the spec suggests, the read-loop is run iteratively instead.
+    if (m_is_reading) {
+        m_has_pending_read = true;
+        return;
+    }
+
+    m_is_reading = true;
+    do {
+        m_has_pending_read = false;
+        readable_stream_default_reader_read(m_reader, *this);
+    } while (m_has_pending_read);
+    m_is_reading = false;
 }
 
 // close steps
@@ -200,7 +217,7 @@ void ReadableStreamDefaultReader::read_all_bytes(GC::Ref<ReadLoopReadRequest::Su
     auto read_request = heap().allocate<ReadLoopReadRequest>(realm, *this, success_steps, failure_steps);
 
     // 2. Perform ! ReadableStreamDefaultReaderRead(this, readRequest).
-    readable_stream_default_reader_read(*this, read_request);
+    read_request->read_next_chunk();
 }
 
 // FIXME: This function is a promise-based wrapper around "read all bytes". The spec changed this function to not use promises
@@ -35,6 +35,11 @@ public:
     virtual void on_chunk(JS::Value chunk) = 0;
     virtual void on_close() = 0;
     virtual void on_error(JS::Value error) = 0;
+
+    // Read requests that only look at the bytes of a byte stream's chunks, and never expose the chunk to script, can
+    // receive those bytes directly instead of through a Uint8Array created for each chunk.
+    virtual bool wants_chunk_bytes() const { return false; }
+    virtual void on_chunk_bytes(ReadonlyBytes) { VERIFY_NOT_REACHED(); }
 };
 
 class ReadLoopReadRequest final : public ReadRequest {
@@ -48,6 +53,8 @@ public:
     // failureSteps, which is an algorithm accepting a JavaScript value
     using FailureSteps = GC::Function<void(JS::Value error)>;
 
+    void read_next_chunk();
+
 private:
     ReadLoopReadRequest(JS::Realm&, ReadableStreamDefaultReader&, GC::Ref<SuccessSteps>, GC::Ref<FailureSteps>);
 
@@ -57,11 +64,16 @@ private:
     virtual void on_close() override;
     virtual void on_error(JS::Value error) override;
 
+    virtual bool wants_chunk_bytes() const override { return true; }
+    virtual void on_chunk_bytes(ReadonlyBytes) override;
+
     GC::Ref<JS::Realm> m_realm;
     GC::Ref<ReadableStreamDefaultReader> m_reader;
     ByteBuffer m_bytes;
     GC::Ref<SuccessSteps> m_success_steps;
     GC::Ref<FailureSteps> m_failure_steps;
+    bool m_is_reading { false };
+    bool m_has_pending_read { false };
 };
 
 // https://streams.spec.whatwg.org/#readablestreamdefaultreader
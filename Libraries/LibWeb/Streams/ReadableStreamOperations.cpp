@@ -1857,11 +1857,18 @@ static WebIDL::ExceptionOr<void> readable_byte_stream_controller_enqueue_transfe
                 readable_byte_stream_controller_shift_pending_pull_into(controller);
             }
 
-            // 3. Let transferredView be ! Construct(%Uint8Array%, « transferredBuffer, byteOffset, byteLength »).
-            auto transferred_view = MUST(JS::construct(vm, *realm.intrinsics().uint8_array_constructor(), transferred_buffer, JS::Value(byte_offset), JS::Value(byte_length)));
-
-            // 4. Perform ! ReadableStreamFulfillReadRequest(stream, transferredView, false).
-            readable_stream_fulfill_read_request(*stream, transferred_view, false);
+            // OPTIMIZATION: A read request that only wants the bytes never sees the view, so don't construct one.
+            auto& read_requests = stream->reader()->get<GC::Ref<ReadableStreamDefaultReader>>()->read_requests();
+            if (read_requests.first()->wants_chunk_bytes()) {
+                auto read_request = read_requests.take_first();
+                read_request->on_chunk_bytes(transferred_buffer->bytes().slice(byte_offset, byte_length));
+            } else {
+                // 3. Let transferredView be ! Construct(%Uint8Array%, « transferredBuffer, byteOffset, byteLength »).
+                auto transferred_view = MUST(JS::construct(vm, *realm.intrinsics().uint8_array_constructor(), transferred_buffer, JS::Value(byte_offset), JS::Value(byte_length)));
+
+                // 4. Perform ! ReadableStreamFulfillReadRequest(stream, transferredView, false).
+                readable_stream_fulfill_read_request(*stream, transferred_view, false);
+            }
         }
     }
     // 10. Otherwise, if ! ReadableStreamHasBYOBReader(stream) is true,
@@ -1931,7 +1938,7 @@ WebIDL::ExceptionOr<void> readable_byte_stream_controller_enqueue(ReadableByteSt
     return readable_byte_stream_controller_enqueue_transferred_buffer(controller, transferred_buffer, byte_offset, byte_length);
 }
 
-WebIDL::ExceptionOr<void> readable_byte_stream_controller_enqueue_native_bytes(ReadableByteStreamController& controller, ByteBuffer bytes)
+WebIDL::ExceptionOr<void> readable_byte_stream_controller_enqueue_native_bytes(ReadableByteStreamController& controller, ReadonlyBytes bytes)
 {
     auto& realm = controller.realm();
 
@@ -1939,12 +1946,39 @@ WebIDL::ExceptionOr<void> readable_byte_stream_controller_enqueue_native_bytes(R
     if (controller.close_requested() || stream->state() != ReadableStream::State::Readable)
         return {};
 
+    // OPTIMIZATION: If a BYOB reader is waiting on a buffer of its own, write the bytes straight into it and respond, as
+    //               an underlying byte source would through controller.byobRequest. Only what doesn't fit is enqueued as
+    //               a chunk.
+    while (!bytes.is_empty() && !controller.pending_pull_intos().is_empty() && controller.queue().is_empty()) {
+        auto& pull_into_descriptor = *controller.pending_pull_intos().first();
+        if (pull_into_descriptor.reader_type != ReaderType::Byob || pull_into_descriptor.buffer->is_detached())
+            break;
+
+        auto destination = pull_into_descriptor.buffer->bytes().slice(pull_into_descriptor.byte_offset + pull_into_descriptor.bytes_filled, pull_into_descriptor.byte_length - pull_into_descriptor.bytes_filled);
+        if (destination.is_empty())
+            break;
+
+        auto bytes_written = bytes.copy_trimmed_to(destination);
+        bytes = bytes.slice(bytes_written);
+
+        TRY(readable_byte_stream_controller_respond(controller, bytes_written));
+        if (stream->state() != ReadableStream::State::Readable)
+            return {};
+    }
+
+    if (bytes.is_empty())
+        return {};
+
     VERIFY(bytes.size() <= NumericLimits<u32>::max());
     auto byte_length = static_cast<u32>(bytes.size());
 
     // OPTIMIZATION: Native byte producers have no observable chunk object to detach, so enter the enqueue algorithm after
-    // the TransferArrayBuffer step with an already-owned ArrayBuffer.
-    auto transferred_buffer = JS::ArrayBuffer::create(realm, move(bytes));
+    // the TransferArrayBuffer step with an already-owned ArrayBuffer. The bytes are copied straight into its backing
+    // store, without an intermediate ByteBuffer.
+    auto backing_store = MUST(JS::DataBlock::OwnedBackingStore::create_uninitialized(byte_length));
+    bytes.copy_to(backing_store.bytes());
+
+    auto transferred_buffer = JS::ArrayBuffer::create(realm, JS::DataBlock { move(backing_store), JS::DataBlock::Shared::No });
     return readable_byte_stream_controller_enqueue_transferred_buffer(controller, transferred_buffer, 0, byte_length);
 }
 
@@ -2169,6 +2203,12 @@ void readable_byte_stream_controller_fill_read_request_from_queue(ReadableByteSt
     // 5. Perform ! ReadableByteStreamControllerHandleQueueDrain(controller).
     readable_byte_stream_controller_handle_queue_drain(controller);
 
+    // OPTIMIZATION: A read request that only wants the bytes never sees the view, so don't construct one.
+    if (read_request.wants_chunk_bytes()) {
+        read_request.on_chunk_bytes(entry.buffer->bytes().slice(entry.byte_offset, entry.byte_length));
+        return;
+    }
+
     // 6. Let view be ! Construct(%Uint8Array%, « entry’s buffer, entry’s byte offset, entry’s byte length »).
     auto view = MUST(JS::construct(vm, *realm.intrinsics().uint8_array_constructor(), entry.buffer, JS::Value(entry.byte_offset), JS::Value(entry.byte_length)));
 
@@ -30,6 +30,7 @@
 #include <LibWeb/Bindings/Intrinsics.h>
 #include <LibWeb/Bindings/Response.h>
 #include <LibWeb/ContentSecurityPolicy/BlockingAlgorithms.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
 #include <LibWeb/Fetch/Infrastructure/HTTP/MIME.h>
 #include <LibWeb/Fetch/Infrastructure/URL.h>
 #include <LibWeb/Fetch/Response.h>
@@ -49,6 +50,7 @@
 namespace Web::WebAssembly {
 
 static GC::Ref<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM&, ByteBuffer, HTML::Task::Source = HTML::Task::Source::Unspecified);
+static GC::Ref<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM&, Function<JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>>()> compile, HTML::Task::Source);
 static GC::Ref<WebIDL::Promise> instantiate_promise_of_module(JS::VM&, GC::Ref<WebIDL::Promise>, GC::Ptr<JS::Object> import_object);
 static GC::Ref<WebIDL::Promise> asynchronously_instantiate_webassembly_module(JS::VM&, GC::Ref<Module>, GC::Ptr<JS::Object> import_object);
 static GC::Ref<WebIDL::Promise> compile_potential_webassembly_response(JS::VM&, GC::Ref<WebIDL::Promise>);
@@ -442,31 +444,26 @@ JS::ThrowCompletionOr<NonnullRefPtr<Wasm::ModuleInstance>> instantiate_module(JS
     return instance_result.release_value();
 }
 
-// https://webassembly.github.io/spec/js-api/#compile-a-webassembly-module
-// https://webassembly.github.io/content-security-policy/js-api/#compile-a-webassembly-module
-JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webassembly_module(JS::VM& vm, ByteBuffer data)
+static bool can_cache_compiled_code()
 {
-    TRY(host_ensure_can_compile_wasm_bytes(vm));
-
-    Wasm::ModuleStats stats;
-    stats.input_size_bytes = data.size();
+    return ResourceLoader::is_initialized() && ResourceLoader::the().request_client();
+}
 
-    auto parse_start = MonotonicTime::now();
-    FixedMemoryStream stream { data.bytes() };
-    auto module_result = Wasm::Module::parse(stream);
-    stats.parse_time = MonotonicTime::now() - parse_start;
+// The steps of compiling a module that follow parsing it, shared by modules compiled from a buffer and modules parsed
+// while their bytes stream in. The digest of the module bytes is only needed if compiled code can be cached.
+static JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> finish_compiling_a_webassembly_module(JS::VM& vm, Wasm::ParseResult<NonnullRefPtr<Wasm::Module>> module_result, Optional<::Crypto::Hash::SHA256::DigestType> const& digest, Wasm::ModuleStats stats)
+{
     if (module_result.is_error()) {
         return vm.throw_completion<CompileError>(Wasm::parse_error_to_byte_string(module_result.error()));
     }
 
     // Content-keyed disk cache: hash the wasm bytes, slot into the HTTP side-data shelf under a synthetic wasm-cache://<hex> URL
     Optional<Wasm::CompileCacheConfig> wasm_cache_config;
-    if (ResourceLoader::is_initialized() && ResourceLoader::the().request_client()) {
-        auto digest = ::Crypto::Hash::SHA256::hash(data.data(), data.size());
-        __builtin_memcpy(stats.wasm_hash.data(), digest.bytes().data(), 32);
+    if (digest.has_value() && can_cache_compiled_code()) {
+        __builtin_memcpy(stats.wasm_hash.data(), digest->bytes().data(), 32);
 
         StringBuilder hex_builder;
-        for (auto byte : digest.bytes())
+        for (auto byte : digest->bytes())
             hex_builder.appendff("{:02x}", byte);
         auto synthetic_url = URL::Parser::basic_parse(ByteString::formatted("wasm-cache://{}", hex_builder.to_byte_string()));
         if (synthetic_url.has_value()) {
@@ -474,7 +471,7 @@ JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webass
             (void)ResourceLoader::the().request_client()->create_synthetic_cache_entry(*synthetic_url, method);
 
             Wasm::CompileCacheConfig config;
-            __builtin_memcpy(config.wasm_hash.data(), digest.bytes().data(), 32);
+            __builtin_memcpy(config.wasm_hash.data(), digest->bytes().data(), 32);
 
             auto retrieve_result = ResourceLoader::the().request_client()->retrieve_cache_associated_data(
                 *synthetic_url, method, OptionalNone {}, 0u,
@@ -519,12 +516,85 @@ JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webass
     if (wasm_cache_config.has_value())
         compiled_module->module->set_cranelift_cache_config(wasm_cache_config.release_value());
     compiled_module->module->set_compile_stats(move(stats));
-    Threading::ThreadPool::the().submit([module = NonnullRefPtr { compiled_module->module }] {
-        Wasm::start_cranelift_compilation(*module);
-    });
+    Threading::ThreadPool::the().submit(
+        [module = NonnullRefPtr { compiled_module->module }] {
+            Wasm::start_cranelift_compilation(*module);
+        },
+        Threading::ThreadPool::Priority::Background);
     return compiled_module;
 }
 
+// https://webassembly.github.io/spec/js-api/#compile-a-webassembly-module
+// https://webassembly.github.io/content-security-policy/js-api/#compile-a-webassembly-module
+JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> compile_a_webassembly_module(JS::VM& vm, ByteBuffer data)
+{
+    TRY(host_ensure_can_compile_wasm_bytes(vm));
+
+    Wasm::ModuleStats stats;
+    stats.input_size_bytes = data.size();
+
+    auto parse_start = MonotonicTime::now();
+    FixedMemoryStream stream { data.bytes() };
+    auto module_result = Wasm::Module::parse(stream);
+    stats.parse_time = MonotonicTime::now() - parse_start;
+
+    Optional<::Crypto::Hash::SHA256::DigestType> digest;
+    if (!module_result.is_error() && can_cache_compiled_code())
+        digest = ::Crypto::Hash::SHA256::hash(data.data(), data.size());
+
+    return finish_compiling_a_webassembly_module(vm, move(module_result), digest, move(stats));
+}
+
+// Compiles a module out of bytes that come in over time, parsing them as they arrive rather than once they're all in.
+class StreamingCompilation : public RefCounted<StreamingCompilation> {
+public:
+    StreamingCompilation();
+
+    void append(ReadonlyBytes);
+    JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> finish(JS::VM&);
+
+private:
+    Wasm::StreamingModuleParser m_parser;
+    OwnPtr<::Crypto::Hash::SHA256> m_hasher;
+    AK::Duration m_parse_time;
+};
+
+StreamingCompilation::StreamingCompilation()
+{
+    if (can_cache_compiled_code())
+        m_hasher = ::Crypto::Hash::SHA256::create();
+}
+
+void StreamingCompilation::append(ReadonlyBytes bytes)
+{
+    if (m_hasher)
+        m_hasher->update(bytes);
+
+    // NB: Once the module turns out to be malformed, the rest of the body is only read to be discarded. The parse error
+    //     is reported when the body is done.
+    auto parse_start = MonotonicTime::now();
+    (void)m_parser.append(bytes);
+    m_parse_time += MonotonicTime::now() - parse_start;
+}
+
+JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>> StreamingCompilation::finish(JS::VM& vm)
+{
+    TRY(host_ensure_can_compile_wasm_bytes(vm));
+
+    Wasm::ModuleStats stats;
+    stats.input_size_bytes = m_parser.received_size();
+
+    auto parse_start = MonotonicTime::now();
+    auto module_result = m_parser.finish();
+    stats.parse_time = m_parse_time + (MonotonicTime::now() - parse_start);
+
+    Optional<::Crypto::Hash::SHA256::DigestType> digest;
+    if (!module_result.is_error() && m_hasher)
+        digest = m_hasher->digest();
+
+    return finish_compiling_a_webassembly_module(vm, move(module_result), digest, move(stats));
+}
+
 // https://webassembly.github.io/spec/js-api/#HostResizeArrayBuffer
 JS::ThrowCompletionOr<JS::HandledByHost> host_resize_array_buffer(JS::VM& vm, JS::ArrayBuffer& buffer, size_t new_length)
 {
@@ -882,6 +952,16 @@ JS::ThrowCompletionOr<void> host_ensure_can_compile_wasm_bytes(JS::VM& vm)
 
 // https://webassembly.github.io/spec/js-api/#asynchronously-compile-a-webassembly-module
 GC::Ref<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM& vm, ByteBuffer bytes, HTML::Task::Source task_source)
+{
+    return asynchronously_compile_webassembly_module(vm, [&vm, bytes = move(bytes)]() mutable {
+        return Detail::compile_a_webassembly_module(vm, move(bytes));
+    },
+        task_source);
+}
+
+// NB: This is the algorithm above with the compilation step supplied by the caller, so that a module whose bytes were
+//     parsed while they streamed in can share the rest of it.
+GC::Ref<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM& vm, Function<JS::ThrowCompletionOr<NonnullRefPtr<CompiledWebAssemblyModule>>()> compile, HTML::Task::Source task_source)
 {
     auto& realm = *vm.current_realm();
 
@@ -889,10 +969,10 @@ GC::Ref<WebIDL::Promise> asynchronously_compile_webassembly_module(JS::VM& vm, B
     auto promise = WebIDL::create_promise(realm);
 
     // 2. Run the following steps in parallel:
-    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(vm.heap(), [&vm, &realm, bytes = move(bytes), promise, task_source]() mutable {
+    Platform::EventLoopPlugin::the().deferred_invoke(GC::create_function(vm.heap(), [&vm, &realm, compile = move(compile), promise, task_source]() mutable {
         HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
         // 1. Compile the WebAssembly module bytes and store the result as module.
-        auto module_or_error = Detail::compile_a_webassembly_module(vm, move(bytes));
+        auto module_or_error = compile();
 
         // 2. Queue a task to perform the following steps. If taskSource was provided, queue the task on that task source.
         HTML::queue_a_task(task_source, nullptr, nullptr, GC::create_function(vm.heap(), [&realm, promise, module_or_error = move(module_or_error)]() mutable {
@@ -1027,6 +1107,36 @@ GC::Ref<WebIDL::Promise> instantiate_promise_of_module(JS::VM& vm, GC::Ref<WebID
     return promise;
 }
 
+// Does what steps 8 to 10 of compiling a potential WebAssembly response do, but parses the body while it downloads.
+static void compile_webassembly_response_body_while_it_streams_in(JS::VM& vm, Fetch::Infrastructure::Body& body, GC::Ref<WebIDL::Promise> return_value)
+{
+    auto& realm = HTML::relevant_realm(*return_value->promise());
+    auto compilation = make_ref_counted<Detail::StreamingCompilation>();
+
+    auto process_body_chunk = GC::create_function(vm.heap(), [compilation](ByteBuffer bytes) {
+        compilation->append(bytes);
+    });
+
+    auto process_end_of_body = GC::create_function(vm.heap(), [&vm, compilation, return_value]() {
+        auto& realm = HTML::relevant_realm(*return_value->promise());
+        HTML::TemporaryExecutionContext context(realm, HTML::TemporaryExecutionContext::CallbacksEnabled::Yes);
+
+        auto result = asynchronously_compile_webassembly_module(vm, [&vm, compilation]() {
+            return compilation->finish(vm);
+        },
+            HTML::Task::Source::Networking);
+
+        // Need to manually convert WebIDL promise to an ECMAScript value here to resolve
+        WebIDL::resolve_promise(realm, return_value, result->promise());
+    });
+
+    auto process_body_error = GC::create_function(vm.heap(), [return_value](JS::Value reason) {
+        WebIDL::reject_promise(HTML::relevant_realm(*return_value->promise()), return_value, reason);
+    });
+
+    body.incrementally_read(process_body_chunk, process_end_of_body, process_body_error, GC::Ref { realm.global_object() });
+}
+
 // https://webassembly.github.io/spec/web-api/index.html#compile-a-potential-webassembly-response
 GC::Ref<WebIDL::Promise> compile_potential_webassembly_response(JS::VM& vm, GC::Ref<WebIDL::Promise> source)
 {
@@ -1076,6 +1186,14 @@ GC::Ref<WebIDL::Promise> compile_potential_webassembly_response(JS::VM& vm, GC::
             return JS::js_undefined();
         }
 
+        // NB: The note above allows compiling in a streaming manner, so instead of waiting for the whole body to be
+        //     consumed as an ArrayBuffer, feed its bytes to the parser as they come in. An unusable or null body still
+        //     goes through the steps below, so that it's rejected or compiled as an empty module just the same.
+        if (auto body = response->body(); body && !response_object->is_unusable()) {
+            compile_webassembly_response_body_while_it_streams_in(vm, *body, return_value);
+            return JS::js_undefined();
+        }
+
         // 8. Consume response’s body as an ArrayBuffer, and let bodyPromise be the result.
         auto body_promise_or_error = response_object->array_buffer();
         if (body_promise_or_error.is_error()) {
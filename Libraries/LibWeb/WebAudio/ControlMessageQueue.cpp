@@ -7,16 +7,67 @@
 #include <LibWeb/WebAudio/ControlMessageQueue.h>
 namespace Web::WebAudio {
 
+ControlMessageQueue::ControlMessageQueue()
+{
+    auto* sentinel = new Node;
+    m_tail.store(sentinel, AK::MemoryOrder::memory_order_relaxed);
+    m_head = sentinel;
+    m_first = sentinel;
+    m_tail_copy = sentinel;
+}
+
+ControlMessageQueue::~ControlMessageQueue()
+{
+    for (auto* node = m_first; node;) {
+        auto* next = node->next.load(AK::MemoryOrder::memory_order_relaxed);
+        delete node;
+        node = next;
+    }
+}
+
+ControlMessageQueue::Node* ControlMessageQueue::allocate_node()
+{
+    // Nodes from m_first up to (but not including) the rendering thread's tail have been consumed and can be reused.
+    if (m_first == m_tail_copy)
+        m_tail_copy = m_tail.load(AK::MemoryOrder::memory_order_acquire);
+
+    if (m_first != m_tail_copy) {
+        auto* node = m_first;
+        m_first = node->next.load(AK::MemoryOrder::memory_order_relaxed);
+        return node;
+    }
+
+    return new Node;
+}
+
 void ControlMessageQueue::enqueue(ControlMessage message)
 {
-    Sync::MutexLocker locker(m_mutex);
-    m_messages.append(move(message));
+    auto* node = allocate_node();
+    node->message = move(message);
+    node->next.store(nullptr, AK::MemoryOrder::memory_order_relaxed);
+
+    m_head->next.store(node, AK::MemoryOrder::memory_order_release);
+    m_head = node;
+}
+
+Optional<ControlMessage> ControlMessageQueue::dequeue()
+{
+    auto* tail = m_tail.load(AK::MemoryOrder::memory_order_relaxed);
+    auto* next = tail->next.load(AK::MemoryOrder::memory_order_acquire);
+    if (!next)
+        return {};
+
+    auto message = next->message.release_value();
+    m_tail.store(next, AK::MemoryOrder::memory_order_release);
+    return message;
 }
 
 Vector<ControlMessage> ControlMessageQueue::drain()
 {
-    Sync::MutexLocker locker(m_mutex);
-    return move(m_messages);
+    Vector<ControlMessage> messages;
+    while (auto message = dequeue())
+        messages.append(message.release_value());
+    return messages;
 }
 
 }
@@ -6,23 +6,47 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
 #include <AK/Vector.h>
-#include <LibSync/Mutex.h>
 #include <LibWeb/Export.h>
 #include <LibWeb/WebAudio/ControlMessage.h>
 
 namespace Web::WebAudio {
 
 // https://webaudio.github.io/web-audio-api/#control-message-queue
+// A lock-free single-producer, single-consumer queue. The rendering thread never blocks on the control thread and never
+// allocates: the control thread allocates nodes and recycles the ones the rendering thread has already consumed.
 class WEB_API ControlMessageQueue {
+    AK_MAKE_NONCOPYABLE(ControlMessageQueue);
+    AK_MAKE_NONMOVABLE(ControlMessageQueue);
 
 public:
-    void enqueue(ControlMessage);   // Called by the control thread.
-    Vector<ControlMessage> drain(); // Called by the rendering thread.
+    ControlMessageQueue();
+    ~ControlMessageQueue();
+
+    void enqueue(ControlMessage); // Called by the control thread.
+
+    Optional<ControlMessage> dequeue(); // Called by the rendering thread.
+    Vector<ControlMessage> drain();     // Called by the rendering thread.
 
 private:
-    mutable Sync::Mutex m_mutex;
-    Vector<ControlMessage> m_messages;
+    struct Node {
+        Atomic<Node*> next { nullptr };
+        Optional<ControlMessage> message;
+    };
+
+    Node* allocate_node();
+
+    // The node before the next message to be dequeued. Written by the rendering thread, read by the control thread to
+    // find out which nodes can be recycled.
+    Atomic<Node*> m_tail;
+
+    // Owned by the control thread.
+    Node* m_head { nullptr };
+    Node* m_first { nullptr };
+    Node* m_tail_copy { nullptr };
 };
 
 }
@@ -4,7 +4,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Base64.h>
 #include <LibGfx/Bitmap.h>
+#include <LibGfx/ImageFormats/PNGWriter.h>
 #include <LibWeb/DOM/Document.h>
 #include <LibWeb/DOM/ElementFactory.h>
 #include <LibWeb/HTML/BrowsingContext.h>
@@ -84,15 +86,17 @@ Response encode_canvas_element(HTML::HTMLCanvasElement& canvas)
         return Error::from_code(ErrorCode::UnableToCaptureScreen, "Captured screenshot is empty"sv);
 
     // 3. Let file be a serialization of the canvas element’s bitmap as a file, using "image/png" as an argument.
-    // 4. Let data url be a data: URL representing file. [RFC2397]
-    auto data_url = canvas.to_data_url("image/png"sv, JS::js_undefined());
+    auto bitmap = canvas.surface()->snapshot_bitmap();
+    auto file = Gfx::PNGWriter::encode(*bitmap, { .compression = Gfx::PNGWriter::Options::Compression::Fast });
+    if (file.is_error())
+        return Error::from_code(ErrorCode::UnableToCaptureScreen, "Failed to encode screenshot"sv);
 
+    // 4. Let data url be a data: URL representing file. [RFC2397]
     // 5. Let index be the index of "," in data url.
-    auto index = data_url.find_byte_offset(',');
-    VERIFY(index.has_value());
-
     // 6. Let encoded string be a substring of data url using (index + 1) as the start argument.
-    auto encoded_string = MUST(data_url.substring_from_byte_offset(*index + 1));
+    // NB: The encoded string is the base64 encoding of file, so we produce it directly rather than going through a
+    //     data: URL. This also keeps screenshots away from the canvas's toDataURL() bookkeeping.
+    auto encoded_string = MUST(encode_base64(file.value()));
 
     // 7. Return success with data encoded string.
     return JsonValue { move(encoded_string) };
@@ -55,6 +55,24 @@ struct OpenGLContext::Impl {
 #endif
 };
 
+#ifdef ENABLE_WEBGL
+// OPTIMIZATION: Every WebGL call makes its context current first, but pages rarely use more than one context at a
+//               time. eglMakeCurrent() takes ANGLE's global lock and revalidates the context and its surfaces even
+//               when nothing changes, so calls are skipped while the context is known to be current already.
+// NB: All contexts render into framebuffers of their own, so none of them is ever made current with a surface.
+static EGLContext s_current_egl_context = EGL_NO_CONTEXT;
+
+static void make_egl_context_current(EGLDisplay display, EGLContext context)
+{
+    if (s_current_egl_context == context)
+        return;
+    if (eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context) == EGL_TRUE)
+        s_current_egl_context = context;
+    else
+        s_current_egl_context = EGL_NO_CONTEXT;
+}
+#endif
+
 OpenGLContext::OpenGLContext(NonnullRefPtr<Gfx::SkiaBackendContext> skia_backend_context, Impl impl, WebGLVersion webgl_version, DrawingBufferOptions drawing_buffer_options)
     : m_skia_backend_context(move(skia_backend_context))
     , m_impl(make<Impl>(impl))
@@ -67,7 +85,7 @@ OpenGLContext::~OpenGLContext()
 {
 #ifdef ENABLE_WEBGL
     free_surface_resources();
-    eglMakeCurrent(m_impl->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    make_egl_context_current(m_impl->display, EGL_NO_CONTEXT);
     eglDestroyContext(m_impl->display, m_impl->context);
 #endif
 }
@@ -75,7 +93,7 @@ OpenGLContext::~OpenGLContext()
 void OpenGLContext::free_surface_resources()
 {
 #ifdef ENABLE_WEBGL
-    eglMakeCurrent(m_impl->display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_impl->context);
+    make_egl_context_current(m_impl->display, m_impl->context);
 
     if (m_impl->framebuffer) {
         glDeleteFramebuffers(1, &m_impl->framebuffer);
@@ -312,7 +330,7 @@ void OpenGLContext::allocate_iosurface_painting_surface()
     };
     m_impl->surface = eglCreatePbufferFromClientBuffer(m_impl->display, EGL_IOSURFACE_ANGLE, m_shared_image_buffer->iosurface_handle().core_foundation_pointer(), m_impl->config, surface_attributes);
 
-    eglMakeCurrent(m_impl->display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_impl->context);
+    make_egl_context_current(m_impl->display, m_impl->context);
 
     glGenTextures(1, &m_impl->color_buffer);
     glBindTexture(m_impl->texture_target == EGL_TEXTURE_RECTANGLE_ANGLE ? GL_TEXTURE_RECTANGLE_ANGLE : GL_TEXTURE_2D, m_impl->color_buffer);
@@ -378,7 +396,7 @@ void OpenGLContext::allocate_vkimage_painting_surface()
     VERIFY(m_impl->egl_image != EGL_NO_IMAGE);
 
     m_impl->surface = EGL_NO_SURFACE;
-    eglMakeCurrent(m_impl->display, m_impl->surface, m_impl->surface, m_impl->context);
+    make_egl_context_current(m_impl->display, m_impl->context);
 
     glGenTextures(1, &m_impl->color_buffer);
     glBindTexture(GL_TEXTURE_2D, m_impl->color_buffer);
@@ -443,7 +461,7 @@ void OpenGLContext::make_current()
 {
 #ifdef ENABLE_WEBGL
     allocate_painting_surface_if_needed();
-    eglMakeCurrent(m_impl->display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_impl->context);
+    make_egl_context_current(m_impl->display, m_impl->context);
 #endif
 }
 
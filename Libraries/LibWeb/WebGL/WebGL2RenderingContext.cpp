@@ -90,6 +90,10 @@ GC::Ref<HTML::HTMLCanvasElement> WebGL2RenderingContext::canvas_for_binding() co
 
 void WebGL2RenderingContext::needs_to_present()
 {
+    // NB: A repaint has already been requested since the canvas was last presented.
+    if (m_canvas_element->canvas_content_is_dirty())
+        return;
+
     m_canvas_element->set_canvas_content_dirty();
 
     m_canvas_element->set_needs_repaint();
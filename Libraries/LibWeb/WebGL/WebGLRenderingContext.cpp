@@ -107,6 +107,10 @@ GC::Ref<HTML::HTMLCanvasElement> WebGLRenderingContext::canvas_for_binding() con
 
 void WebGLRenderingContext::needs_to_present()
 {
+    // NB: A repaint has already been requested since the canvas was last presented.
+    if (m_canvas_element->canvas_content_is_dirty())
+        return;
+
     m_canvas_element->set_canvas_content_dirty();
 
     m_canvas_element->set_needs_repaint();
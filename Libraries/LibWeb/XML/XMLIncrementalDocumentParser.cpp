@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/TemporaryChange.h>
+#include <LibGC/Function.h>
+#include <LibJS/Runtime/Value.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/DocumentLoading.h>
+#include <LibWeb/Fetch/Infrastructure/HTTP/Bodies.h>
+#include <LibWeb/HTML/Parser/HTMLEncodingDetection.h>
+#include <LibWeb/XML/XMLIncrementalDocumentParser.h>
+#include <LibXML/Parser/Parser.h>
+
+namespace Web {
+
+GC_DEFINE_ALLOCATOR(XMLIncrementalDocumentParser);
+
+GC::Ref<XMLIncrementalDocumentParser> XMLIncrementalDocumentParser::create(GC::Ref<DOM::Document> document, GC::Ref<Fetch::Infrastructure::Body> body, Optional<String> content_encoding)
+{
+    return document->realm().create<XMLIncrementalDocumentParser>(document, body, move(content_encoding));
+}
+
+XMLIncrementalDocumentParser::XMLIncrementalDocumentParser(GC::Ref<DOM::Document> document, GC::Ref<Fetch::Infrastructure::Body> body, Optional<String> content_encoding)
+    : m_document(document)
+    , m_body(body)
+    , m_content_encoding(move(content_encoding))
+{
+}
+
+XMLIncrementalDocumentParser::~XMLIncrementalDocumentParser() = default;
+
+void XMLIncrementalDocumentParser::visit_edges(Cell::Visitor& visitor)
+{
+    Base::visit_edges(visitor);
+    visitor.visit(m_document);
+    visitor.visit(m_body);
+}
+
+void XMLIncrementalDocumentParser::start()
+{
+    auto parser = GC::Ref { *this };
+    m_body->wait_for_sniff_bytes(GC::create_function(heap(), [parser](ReadonlyBytes sniff_bytes) {
+        parser->initialize_parser(sniff_bytes);
+    }));
+}
+
+void XMLIncrementalDocumentParser::initialize_parser(ReadonlyBytes sniff_bytes)
+{
+    if (m_decoder)
+        return;
+
+    Optional<TextCodec::Decoder&> decoder;
+    // The actual HTTP headers and other metadata, not the headers as mutated or implied by the algorithms given in this specification,
+    // are the ones that must be used when determining the character encoding according to the rules given in the above specifications.
+    if (m_content_encoding.has_value())
+        decoder = TextCodec::decoder_for(*m_content_encoding);
+    if (!decoder.has_value()) {
+        // https://www.w3.org/TR/xml/#charencoding
+        // [...] it is a fatal error [...] for an entity which begins with neither a Byte Order Mark nor an encoding
+        // declaration to use an encoding other than UTF-8.
+        auto bom_encoding = HTML::run_bom_sniff(sniff_bytes);
+        decoder = TextCodec::decoder_for(bom_encoding.value_or("UTF-8"));
+    }
+    VERIFY(decoder.has_value());
+
+    // Well-formed XML documents contain only properly encoded characters
+    m_decoder = make<TextCodec::StreamingDecoder>(decoder.value(), TextCodec::StreamingDecoder::InvalidInput::Fail);
+
+    m_builder = make<XMLDocumentBuilder>(m_document);
+    auto parser = XML::PushParser::create(*m_builder, { .preserve_cdata = true, .preserve_comments = true, .resolve_named_html_entity = resolve_named_html_entity });
+    if (parser.is_error()) {
+        fail(Utf16String::formatted("Failed to parse XML document: {}", parser.error()));
+        return;
+    }
+    m_parser = parser.release_value();
+
+    auto incremental_parser = GC::Ref { *this };
+    m_body->incrementally_read(
+        GC::create_function(heap(), [incremental_parser](ByteBuffer bytes) mutable {
+            incremental_parser->process_body_chunk(move(bytes));
+        }),
+        GC::create_function(heap(), [incremental_parser] {
+            incremental_parser->process_end_of_body();
+        }),
+        GC::create_function(heap(), [](JS::Value) {
+            dbgln("FIXME: Load html page with an error if read of body failed.");
+        }),
+        GC::Ref { m_document->realm().global_object() });
+}
+
+void XMLIncrementalDocumentParser::process_body_chunk(ByteBuffer bytes)
+{
+    if (m_has_failed)
+        return;
+
+    append_decoded(m_decoder->to_utf8(bytes.bytes()));
+    pump();
+}
+
+void XMLIncrementalDocumentParser::process_end_of_body()
+{
+    if (m_has_failed)
+        return;
+
+    append_decoded(m_decoder->finish());
+    if (m_has_failed)
+        return;
+
+    m_reached_end_of_body = true;
+    m_document->set_source(m_source.to_string_without_validation());
+    pump();
+}
+
+void XMLIncrementalDocumentParser::append_decoded(ErrorOr<String> decoded)
+{
+    if (decoded.is_error()) {
+        fail("XML Document contains improperly-encoded characters"_utf16);
+        return;
+    }
+
+    if (decoded.value().is_empty())
+        return;
+
+    m_source.append(decoded.value());
+    m_pending_input.append(decoded.release_value());
+}
+
+void XMLIncrementalDocumentParser::register_deferred_start()
+{
+    if (m_document->has_deferred_parser_start())
+        return;
+
+    auto parser = GC::Ref { *this };
+    m_document->set_deferred_parser_start(GC::create_function(heap(), [parser] {
+        parser->pump();
+    }));
+}
+
+void XMLIncrementalDocumentParser::pump()
+{
+    // NB: Scripts spin the event loop while they are parsed, which may hand us more of the body. That input has to wait
+    //     until the parser returns, as it can't be fed to the parser while it is busy.
+    if (m_has_failed || m_is_parsing || !m_parser)
+        return;
+
+    if (!m_document->ready_to_run_scripts()) {
+        register_deferred_start();
+        return;
+    }
+
+    TemporaryChange is_parsing { m_is_parsing, true };
+
+    while (!m_pending_input.is_empty()) {
+        auto input = m_pending_input.take_first();
+        auto result = m_parser->feed(input);
+
+        // NB: The body may have turned out to be improperly encoded while a script was running.
+        if (m_has_failed) {
+            m_parser = nullptr;
+            return;
+        }
+
+        if (result.is_error()) {
+            // NB: Like a parse of the whole document, a failed parse still ends the document before it is replaced.
+            (void)m_parser->finish();
+            m_parser = nullptr;
+            fail(Utf16String::formatted("Failed to parse XML document: {}", result.error()));
+            return;
+        }
+    }
+
+    if (!m_reached_end_of_body)
+        return;
+
+    auto result = m_parser->finish();
+    m_parser = nullptr;
+    m_builder = nullptr;
+    if (result.is_error())
+        fail(Utf16String::formatted("Failed to parse XML document: {}", result.error()));
+}
+
+void XMLIncrementalDocumentParser::fail(Utf16String error_string)
+{
+    m_has_failed = true;
+    m_pending_input.clear();
+    if (!m_is_parsing)
+        m_parser = nullptr;
+
+    // FIXME: Insert error message into the document.
+    dbgln("{}", error_string);
+    convert_to_xml_error_document(m_document, move(error_string));
+}
+
+}
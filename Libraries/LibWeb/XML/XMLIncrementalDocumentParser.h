@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/OwnPtr.h>
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
+#include <LibJS/Heap/Cell.h>
+#include <LibTextCodec/Decoder.h>
+#include <LibWeb/Forward.h>
+#include <LibWeb/XML/XMLDocumentBuilder.h>
+#include <LibXML/Forward.h>
+
+namespace Web {
+
+// Builds an XML document from its response body as the bytes arrive, instead of waiting for the whole body.
+class XMLIncrementalDocumentParser final : public JS::Cell {
+    GC_CELL(XMLIncrementalDocumentParser, JS::Cell);
+    GC_DECLARE_ALLOCATOR(XMLIncrementalDocumentParser);
+
+public:
+    static GC::Ref<XMLIncrementalDocumentParser> create(GC::Ref<DOM::Document>, GC::Ref<Fetch::Infrastructure::Body>, Optional<String> content_encoding);
+    virtual ~XMLIncrementalDocumentParser() override;
+
+    void start();
+
+private:
+    XMLIncrementalDocumentParser(GC::Ref<DOM::Document>, GC::Ref<Fetch::Infrastructure::Body>, Optional<String> content_encoding);
+
+    virtual void visit_edges(Cell::Visitor&) override;
+
+    void initialize_parser(ReadonlyBytes sniff_bytes);
+    void process_body_chunk(ByteBuffer);
+    void process_end_of_body();
+
+    void append_decoded(ErrorOr<String>);
+    void pump();
+    void register_deferred_start();
+    void fail(Utf16String error_string);
+
+    GC::Ref<DOM::Document> m_document;
+    GC::Ref<Fetch::Infrastructure::Body> m_body;
+    Optional<String> m_content_encoding;
+
+    OwnPtr<TextCodec::StreamingDecoder> m_decoder;
+    OwnPtr<XMLDocumentBuilder> m_builder;
+    OwnPtr<XML::PushParser> m_parser;
+
+    StringBuilder m_source;
+    Vector<String> m_pending_input;
+    bool m_reached_end_of_body { false };
+    bool m_is_parsing { false };
+    bool m_has_failed { false };
+};
+
+}
@@ -0,0 +1,1093 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/HashTable.h>
+#include <AK/Math.h>
+#include <AK/NumericLimits.h>
+#include <AK/QuickSort.h>
+#include <AK/StringBuilder.h>
+#include <LibJS/Runtime/Value.h>
+#include <LibWeb/DOM/Attr.h>
+#include <LibWeb/DOM/CharacterData.h>
+#include <LibWeb/DOM/Document.h>
+#include <LibWeb/DOM/Element.h>
+#include <LibWeb/DOM/ElementByIdMap.h>
+#include <LibWeb/DOM/NamedNodeMap.h>
+#include <LibWeb/DOM/ProcessingInstruction.h>
+#include <LibWeb/Namespace.h>
+#include <LibWeb/XPath/Expression.h>
+#include <math.h>
+
+namespace Web::XPath {
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#NT-ExprWhitespace
+static constexpr bool is_xpath_whitespace(char16_t code_unit)
+{
+    return code_unit == ' ' || code_unit == '\t' || code_unit == '\r' || code_unit == '\n';
+}
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#function-round
+static double xpath_round(double number)
+{
+    if (isnan(number) || isinf(number))
+        return number;
+    // NB: Unlike floor(x + 0.5), this keeps the sign of numbers that round to zero.
+    if (number < 0 && number >= -0.5)
+        return -0.0;
+    return floor(number + 0.5);
+}
+
+// The root of the tree a node is in. In the XPath data model, an attribute's parent is the element it is on.
+static DOM::Node& tree_root(DOM::Node& node)
+{
+    if (auto* attribute = as_if<DOM::Attr>(node); attribute && attribute->owner_element())
+        return attribute->owner_element()->root();
+    return node.root();
+}
+
+static DOM::Node* xpath_parent(DOM::Node& node)
+{
+    if (auto* attribute = as_if<DOM::Attr>(node))
+        return attribute->owner_element();
+    return node.parent();
+}
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#dt-string-value
+Utf16String string_value(DOM::Node const& node)
+{
+    switch (node.type()) {
+    case DOM::NodeType::DOCUMENT_NODE:
+    case DOM::NodeType::DOCUMENT_FRAGMENT_NODE:
+    case DOM::NodeType::ELEMENT_NODE:
+        return node.descendant_text_content();
+    case DOM::NodeType::ATTRIBUTE_NODE:
+        return Utf16String::from_utf8(static_cast<DOM::Attr const&>(node).value());
+    case DOM::NodeType::TEXT_NODE:
+    case DOM::NodeType::CDATA_SECTION_NODE:
+    case DOM::NodeType::COMMENT_NODE:
+    case DOM::NodeType::PROCESSING_INSTRUCTION_NODE:
+        return static_cast<DOM::CharacterData const&>(node).data();
+    default:
+        return {};
+    }
+}
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#function-number
+double string_to_number(Utf16View const& string)
+{
+    auto trimmed = string.trim(u" \t\r\n"sv);
+
+    // The string has to be an optional minus sign followed by a Number, and nothing else.
+    size_t offset = 0;
+    size_t digit_count = 0;
+    if (offset < trimmed.length_in_code_units() && trimmed.code_unit_at(offset) == '-')
+        ++offset;
+    for (; offset < trimmed.length_in_code_units() && is_ascii_digit(trimmed.code_unit_at(offset)); ++offset)
+        ++digit_count;
+    if (offset < trimmed.length_in_code_units() && trimmed.code_unit_at(offset) == '.') {
+        ++offset;
+        for (; offset < trimmed.length_in_code_units() && is_ascii_digit(trimmed.code_unit_at(offset)); ++offset)
+            ++digit_count;
+    }
+    if (digit_count == 0 || offset != trimmed.length_in_code_units())
+        return AK::NaN<double>;
+
+    StringBuilder builder(trimmed.length_in_code_units());
+    for (size_t i = 0; i < trimmed.length_in_code_units(); ++i)
+        builder.append(static_cast<char>(trimmed.code_unit_at(i)));
+    return builder.string_view().to_number<double>(TrimWhitespace::No).value_or(AK::NaN<double>);
+}
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#function-string
+Utf16String number_to_string(double number)
+{
+    // NB: This is how ECMAScript turns numbers into strings, except that XPath never uses exponential notation.
+    return JS::number_to_utf16_string(number, JS::NumberToStringMode::WithoutExponent);
+}
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#function-boolean
+bool Value::to_boolean() const
+{
+    return m_value.visit(
+        [](NodeSet const& node_set) { return !node_set.is_empty(); },
+        [](bool boolean) { return boolean; },
+        [](double number) { return number != 0 && !isnan(number); },
+        [](Utf16String const& string) { return !string.is_empty(); });
+}
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#function-number
+double Value::to_number() const
+{
+    return m_value.visit(
+        [](NodeSet const& node_set) {
+            if (node_set.is_empty())
+                return AK::NaN<double>;
+            return string_to_number(string_value(*node_set.first()));
+        },
+        [](bool boolean) { return boolean ? 1.0 : 0.0; },
+        [](double number) { return number; },
+        [](Utf16String const& string) { return string_to_number(string); });
+}
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#function-string
+Utf16String Value::to_string() const
+{
+    return m_value.visit(
+        [](NodeSet const& node_set) -> Utf16String {
+            if (node_set.is_empty())
+                return {};
+            return string_value(*node_set.first());
+        },
+        [](bool boolean) { return boolean ? "true"_utf16 : "false"_utf16; },
+        [](double number) { return number_to_string(number); },
+        [](Utf16String const& string) { return string; });
+}
+
+Evaluation::Evaluation(DOM::Node& context_node)
+    : m_context_node(context_node)
+    , m_is_html_document(context_node.document().is_html_document())
+{
+    if (m_is_html_document)
+        m_default_element_namespace = Namespace::HTML;
+}
+
+void Evaluation::compute_document_order()
+{
+    // Attributes come right after the element they are on, and before its children.
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#dt-document-order
+    auto& root = tree_root(m_context_node);
+    size_t index = 0;
+    for (auto* node = &root; node; node = node->next_in_pre_order(&root)) {
+        m_document_order.set(node, index++);
+
+        auto* element = as_if<DOM::Element>(*node);
+        if (!element)
+            continue;
+        auto attributes = element->existing_attributes();
+        if (!attributes)
+            continue;
+        for (size_t i = 0; i < element->attribute_list_size(); ++i)
+            m_document_order.set(attributes->item(i), index++);
+    }
+}
+
+void Evaluation::sort_in_document_order(NodeSet& nodes)
+{
+    if (nodes.size() < 2)
+        return;
+
+    if (m_document_order.is_empty())
+        compute_document_order();
+
+    auto index_of = [&](DOM::Node const& node) {
+        return m_document_order.get(&node).value_or(NumericLimits<size_t>::max());
+    };
+    quick_sort(nodes, [&](auto const& a, auto const& b) { return index_of(a) < index_of(b); });
+
+    size_t unique_count = 1;
+    for (size_t i = 1; i < nodes.size(); ++i) {
+        if (nodes[i].ptr() != nodes[unique_count - 1].ptr())
+            nodes[unique_count++] = nodes[i];
+    }
+    nodes.shrink(unique_count);
+}
+
+// https://html.spec.whatwg.org/multipage/infrastructure.html#interactions-with-xpath-and-xslt
+static bool is_html_element_in_html_document(Evaluation const& evaluation, DOM::Element const& element)
+{
+    return evaluation.is_html_document() && element.namespace_uri() == Namespace::HTML;
+}
+
+static bool element_matches_name_test(Evaluation const& evaluation, NodeTest const& node_test, DOM::Element const& element)
+{
+    switch (node_test.type) {
+    case NodeTest::Type::AnyName:
+        return true;
+    case NodeTest::Type::AnyNameInNamespace:
+        return element.namespace_uri() == node_test.namespace_uri;
+    case NodeTest::Type::Name: {
+        // An unprefixed element name is in the default element namespace, which is the HTML namespace if the context
+        // node is from an HTML document.
+        auto const& namespace_uri = node_test.has_prefix ? node_test.namespace_uri : evaluation.default_element_namespace();
+        if (element.namespace_uri() != namespace_uri)
+            return false;
+        if (is_html_element_in_html_document(evaluation, element))
+            return element.local_name() == node_test.ascii_lowercase_local_name;
+        return element.local_name() == node_test.local_name;
+    }
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+static bool attribute_matches_name_test(Evaluation const& evaluation, NodeTest const& node_test, DOM::Attr const& attribute)
+{
+    switch (node_test.type) {
+    case NodeTest::Type::AnyName:
+        return true;
+    case NodeTest::Type::AnyNameInNamespace:
+        return attribute.namespace_uri() == node_test.namespace_uri;
+    case NodeTest::Type::Name: {
+        if (attribute.namespace_uri() != node_test.namespace_uri)
+            return false;
+        if (auto const* element = attribute.owner_element(); element && is_html_element_in_html_document(evaluation, *element))
+            return attribute.local_name() == node_test.ascii_lowercase_local_name;
+        return attribute.local_name() == node_test.local_name;
+    }
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+static bool matches_node_test(Evaluation const& evaluation, Axis axis, NodeTest const& node_test, DOM::Node const& node)
+{
+    switch (node_test.type) {
+    case NodeTest::Type::Node:
+        // NB: Document types aren't part of the XPath data model.
+        return !node.is_document_type();
+    case NodeTest::Type::Text:
+        return node.is_text();
+    case NodeTest::Type::Comment:
+        return node.is_comment();
+    case NodeTest::Type::ProcessingInstruction: {
+        auto const* processing_instruction = as_if<DOM::ProcessingInstruction>(node);
+        if (!processing_instruction)
+            return false;
+        return !node_test.target.has_value() || processing_instruction->target() == *node_test.target;
+    }
+    case NodeTest::Type::Name:
+    case NodeTest::Type::AnyName:
+    case NodeTest::Type::AnyNameInNamespace:
+        break;
+    }
+
+    // A name test only matches nodes of the principal node type of the axis.
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#dt-principal-node-type
+    if (axis == Axis::Attribute) {
+        auto const* attribute = as_if<DOM::Attr>(node);
+        return attribute && attribute_matches_name_test(evaluation, node_test, *attribute);
+    }
+    auto const* element = as_if<DOM::Element>(node);
+    return element && element_matches_name_test(evaluation, node_test, *element);
+}
+
+static void collect_attributes(Evaluation const& evaluation, NodeTest const& node_test, DOM::Node& node, NodeSet& nodes)
+{
+    auto* element = as_if<DOM::Element>(node);
+    if (!element)
+        return;
+    auto attributes = element->existing_attributes();
+    if (!attributes)
+        return;
+
+    // Namespace declarations are attributes in the DOM, but not in the XPath data model.
+    if (node_test.type == NodeTest::Type::Name || node_test.type == NodeTest::Type::AnyNameInNamespace) {
+        if (node_test.namespace_uri == Namespace::XMLNS)
+            return;
+    }
+
+    // Fast path: A name test matches at most one attribute, which the element can look up directly.
+    if (node_test.type == NodeTest::Type::Name) {
+        auto const& local_name = is_html_element_in_html_document(evaluation, *element) ? node_test.ascii_lowercase_local_name : node_test.local_name;
+        if (auto const* attribute = attributes->get_attribute_ns(node_test.namespace_uri, local_name))
+            nodes.append(const_cast<DOM::Attr&>(*attribute));
+        return;
+    }
+
+    for (size_t i = 0; i < element->attribute_list_size(); ++i) {
+        auto const& attribute = *attributes->item(i);
+        if (attribute.namespace_uri() == Namespace::XMLNS)
+            continue;
+        if (matches_node_test(evaluation, Axis::Attribute, node_test, attribute))
+            nodes.append(const_cast<DOM::Attr&>(attribute));
+    }
+}
+
+static bool is_reverse_axis(Axis axis)
+{
+    return first_is_one_of(axis, Axis::Ancestor, Axis::AncestorOrSelf, Axis::Preceding, Axis::PrecedingSibling);
+}
+
+// Appends the nodes on the axis of a step that match its node test, in the order of the axis: document order for forward
+// axes, and reverse document order for reverse axes.
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#axes
+static void collect_nodes_on_axis(Evaluation const& evaluation, Step const& step, DOM::Node& node, NodeSet& nodes)
+{
+    auto visit = [&](DOM::Node& candidate) {
+        if (matches_node_test(evaluation, step.axis, step.node_test, candidate))
+            nodes.append(candidate);
+    };
+    auto visit_subtree_in_reverse = [&](DOM::Node& root) {
+        auto* last = &root;
+        while (last->last_child())
+            last = last->last_child();
+        for (auto* descendant = last;; descendant = descendant->previous_in_pre_order()) {
+            visit(*descendant);
+            if (descendant == &root)
+                break;
+        }
+    };
+
+    auto* attribute = as_if<DOM::Attr>(node);
+
+    switch (step.axis) {
+    case Axis::AncestorOrSelf:
+        visit(node);
+        [[fallthrough]];
+    case Axis::Ancestor:
+        for (auto* ancestor = xpath_parent(node); ancestor; ancestor = ancestor->parent())
+            visit(*ancestor);
+        break;
+    case Axis::Attribute:
+        collect_attributes(evaluation, step.node_test, node, nodes);
+        break;
+    case Axis::Child:
+        for (auto* child = node.first_child(); child; child = child->next_sibling())
+            visit(*child);
+        break;
+    case Axis::DescendantOrSelf:
+        visit(node);
+        [[fallthrough]];
+    case Axis::Descendant:
+        for (auto* descendant = node.first_child(); descendant; descendant = descendant->next_in_pre_order(&node))
+            visit(*descendant);
+        break;
+    case Axis::Following: {
+        auto* start = &node;
+        if (attribute) {
+            // The descendants of the element an attribute is on follow the attribute.
+            start = attribute->owner_element();
+            if (!start)
+                break;
+            for (auto* descendant = start->first_child(); descendant; descendant = descendant->next_in_pre_order(start))
+                visit(*descendant);
+        }
+        for (auto* ancestor = start; ancestor; ancestor = ancestor->parent()) {
+            for (auto* sibling = ancestor->next_sibling(); sibling; sibling = sibling->next_sibling()) {
+                for (auto* descendant = sibling; descendant; descendant = descendant->next_in_pre_order(sibling))
+                    visit(*descendant);
+            }
+        }
+        break;
+    }
+    case Axis::FollowingSibling:
+        if (attribute)
+            break;
+        for (auto* sibling = node.next_sibling(); sibling; sibling = sibling->next_sibling())
+            visit(*sibling);
+        break;
+    case Axis::Namespace:
+        // NB: Namespace nodes aren't part of the DOM, so this axis is always empty.
+        break;
+    case Axis::Parent:
+        if (auto* parent = xpath_parent(node))
+            visit(*parent);
+        break;
+    case Axis::Preceding: {
+        // NB: The element an attribute is on is its ancestor, so it doesn't precede it.
+        auto* start = attribute ? static_cast<DOM::Node*>(attribute->owner_element()) : &node;
+        for (auto* ancestor = start; ancestor; ancestor = ancestor->parent()) {
+            for (auto* sibling = ancestor->previous_sibling(); sibling; sibling = sibling->previous_sibling())
+                visit_subtree_in_reverse(*sibling);
+        }
+        break;
+    }
+    case Axis::PrecedingSibling:
+        if (attribute)
+            break;
+        for (auto* sibling = node.previous_sibling(); sibling; sibling = sibling->previous_sibling())
+            visit(*sibling);
+        break;
+    case Axis::Self:
+        visit(node);
+        break;
+    }
+}
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#predicates
+static ErrorOr<void, EvaluationError> apply_predicates(Evaluation& evaluation, ReadonlySpan<NonnullOwnPtr<Expression>> predicates, NodeSet& nodes)
+{
+    for (auto const& predicate : predicates) {
+        if (nodes.is_empty())
+            return {};
+
+        // Fast path: `[n]` selects the n-th node, without evaluating anything for each of them.
+        if (auto position = predicate->as_number_literal(); position.has_value()) {
+            if (*position < 1 || *position > nodes.size() || trunc(*position) != *position) {
+                nodes.clear();
+                continue;
+            }
+            auto node = nodes[static_cast<size_t>(*position) - 1];
+            nodes.clear();
+            nodes.append(node);
+            continue;
+        }
+
+        NodeSet filtered_nodes;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            auto result = TRY(predicate->evaluate(evaluation, Context { nodes[i], i + 1, nodes.size() }));
+            auto is_selected = result.is_number() ? result.number() == static_cast<double>(i + 1) : result.to_boolean();
+            if (is_selected)
+                filtered_nodes.append(nodes[i]);
+        }
+        nodes = move(filtered_nodes);
+    }
+    return {};
+}
+
+static ErrorOr<NodeSet, EvaluationError> evaluate_step(Evaluation& evaluation, Step const& step, NodeSet const& context_nodes)
+{
+    NodeSet result;
+    for (auto const& context_node : context_nodes) {
+        NodeSet selected_nodes;
+        collect_nodes_on_axis(evaluation, step, *context_node, selected_nodes);
+        TRY(apply_predicates(evaluation, step.predicates, selected_nodes));
+        if (is_reverse_axis(step.axis))
+            selected_nodes.reverse();
+
+        if (result.is_empty())
+            result = move(selected_nodes);
+        else
+            result.extend(move(selected_nodes));
+    }
+
+    // The nodes selected from each context node are in document order, but those of different context nodes can
+    // interleave or be the same. The self and attribute axes are the exception, as they keep the context nodes' order.
+    if (context_nodes.size() > 1 && step.axis != Axis::Self && step.axis != Axis::Attribute)
+        evaluation.sort_in_document_order(result);
+    return result;
+}
+
+static bool compare_numbers(BinaryExpression::Operator op, double lhs, double rhs)
+{
+    switch (op) {
+    case BinaryExpression::Operator::Equal:
+        return lhs == rhs;
+    case BinaryExpression::Operator::NotEqual:
+        return lhs != rhs;
+    case BinaryExpression::Operator::LessThan:
+        return lhs < rhs;
+    case BinaryExpression::Operator::LessThanOrEqual:
+        return lhs <= rhs;
+    case BinaryExpression::Operator::GreaterThan:
+        return lhs > rhs;
+    case BinaryExpression::Operator::GreaterThanOrEqual:
+        return lhs >= rhs;
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+static bool is_equality_operator(BinaryExpression::Operator op)
+{
+    return op == BinaryExpression::Operator::Equal || op == BinaryExpression::Operator::NotEqual;
+}
+
+static bool compare_strings(BinaryExpression::Operator op, Utf16View const& lhs, Utf16View const& rhs)
+{
+    if (is_equality_operator(op))
+        return (lhs == rhs) == (op == BinaryExpression::Operator::Equal);
+    return compare_numbers(op, string_to_number(lhs), string_to_number(rhs));
+}
+
+static bool compare_non_node_sets(BinaryExpression::Operator op, Value const& lhs, Value const& rhs)
+{
+    if (!is_equality_operator(op))
+        return compare_numbers(op, lhs.to_number(), rhs.to_number());
+    if (lhs.is_boolean() || rhs.is_boolean())
+        return (lhs.to_boolean() == rhs.to_boolean()) == (op == BinaryExpression::Operator::Equal);
+    if (lhs.is_number() || rhs.is_number())
+        return compare_numbers(op, lhs.to_number(), rhs.to_number());
+    return compare_strings(op, lhs.to_string(), rhs.to_string());
+}
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#booleans
+static bool compare_values(BinaryExpression::Operator op, Value const& lhs, Value const& rhs)
+{
+    if (lhs.is_node_set() && rhs.is_node_set()) {
+        // True if some node from each set has a string-value that compares true with that of the other.
+        Vector<Utf16String> rhs_strings;
+        rhs_strings.ensure_capacity(rhs.node_set().size());
+        for (auto const& node : rhs.node_set())
+            rhs_strings.unchecked_append(string_value(*node));
+
+        for (auto const& node : lhs.node_set()) {
+            auto lhs_string = string_value(*node);
+            for (auto const& rhs_string : rhs_strings) {
+                if (compare_strings(op, lhs_string, rhs_string))
+                    return true;
+            }
+        }
+        return false;
+    }
+
+    if (!lhs.is_node_set() && !rhs.is_node_set())
+        return compare_non_node_sets(op, lhs, rhs);
+
+    auto const& node_set = lhs.is_node_set() ? lhs : rhs;
+    auto const& other = lhs.is_node_set() ? rhs : lhs;
+    auto node_set_is_lhs = lhs.is_node_set();
+
+    // A node set compares to a boolean as the boolean it converts to.
+    if (other.is_boolean()) {
+        Value node_set_as_boolean { node_set.to_boolean() };
+        return node_set_is_lhs ? compare_non_node_sets(op, node_set_as_boolean, other) : compare_non_node_sets(op, other, node_set_as_boolean);
+    }
+
+    // Otherwise, it's true if some node in the set has a string-value that compares true with the other value.
+    for (auto const& node : node_set.node_set()) {
+        Value node_value { string_value(*node) };
+        if (other.is_number())
+            node_value = Value { node_value.to_number() };
+        if (node_set_is_lhs ? compare_non_node_sets(op, node_value, other) : compare_non_node_sets(op, other, node_value))
+            return true;
+    }
+    return false;
+}
+
+EvaluationResult BinaryExpression::evaluate(Evaluation& evaluation, Context const& context) const
+{
+    switch (m_operator) {
+    case Operator::Or:
+        if (TRY(m_lhs->evaluate(evaluation, context)).to_boolean())
+            return Value { true };
+        return Value { TRY(m_rhs->evaluate(evaluation, context)).to_boolean() };
+    case Operator::And:
+        if (!TRY(m_lhs->evaluate(evaluation, context)).to_boolean())
+            return Value { false };
+        return Value { TRY(m_rhs->evaluate(evaluation, context)).to_boolean() };
+    default:
+        break;
+    }
+
+    auto lhs = TRY(m_lhs->evaluate(evaluation, context));
+    auto rhs = TRY(m_rhs->evaluate(evaluation, context));
+
+    switch (m_operator) {
+    case Operator::Equal:
+    case Operator::NotEqual:
+    case Operator::LessThan:
+    case Operator::LessThanOrEqual:
+    case Operator::GreaterThan:
+    case Operator::GreaterThanOrEqual:
+        return Value { compare_values(m_operator, lhs, rhs) };
+    case Operator::Add:
+        return Value { lhs.to_number() + rhs.to_number() };
+    case Operator::Subtract:
+        return Value { lhs.to_number() - rhs.to_number() };
+    case Operator::Multiply:
+        return Value { lhs.to_number() * rhs.to_number() };
+    case Operator::Divide:
+        return Value { lhs.to_number() / rhs.to_number() };
+    case Operator::Modulo:
+        return Value { fmod(lhs.to_number(), rhs.to_number()) };
+    case Operator::Union: {
+        if (!lhs.is_node_set() || !rhs.is_node_set())
+            return EvaluationError { "The operands of '|' must be node sets"_string };
+        auto nodes = lhs.release_node_set();
+        if (nodes.is_empty())
+            return rhs;
+        nodes.extend(rhs.release_node_set());
+        evaluation.sort_in_document_order(nodes);
+        return Value { move(nodes) };
+    }
+    default:
+        VERIFY_NOT_REACHED();
+    }
+}
+
+StaticType BinaryExpression::static_type() const
+{
+    switch (m_operator) {
+    case Operator::Add:
+    case Operator::Subtract:
+    case Operator::Multiply:
+    case Operator::Divide:
+    case Operator::Modulo:
+        return StaticType::Number;
+    case Operator::Union:
+        return StaticType::NodeSet;
+    default:
+        return StaticType::Boolean;
+    }
+}
+
+EvaluationResult NegateExpression::evaluate(Evaluation& evaluation, Context const& context) const
+{
+    return Value { -TRY(m_operand->evaluate(evaluation, context)).to_number() };
+}
+
+Optional<FunctionCall::Signature> FunctionCall::signature_for_name(StringView name)
+{
+#define __ENUMERATE_XPATH_FUNCTION(function, function_name, minimum_arguments, maximum_arguments) \
+    if (name == StringView { function_name })                                                       \
+        return Signature { Function::function, minimum_arguments, maximum_arguments };
+    ENUMERATE_XPATH_FUNCTIONS(__ENUMERATE_XPATH_FUNCTION)
+#undef __ENUMERATE_XPATH_FUNCTION
+    return {};
+}
+
+StaticType FunctionCall::static_type() const
+{
+    switch (m_function) {
+    case Function::Id:
+        return StaticType::NodeSet;
+    case Function::StartsWith:
+    case Function::Contains:
+    case Function::Boolean:
+    case Function::Not:
+    case Function::True:
+    case Function::False:
+    case Function::Lang:
+        return StaticType::Boolean;
+    case Function::Last:
+    case Function::Position:
+    case Function::Count:
+    case Function::StringLength:
+    case Function::Number:
+    case Function::Sum:
+    case Function::Floor:
+    case Function::Ceiling:
+    case Function::Round:
+        return StaticType::Number;
+    default:
+        return StaticType::String;
+    }
+}
+
+bool FunctionCall::depends_on_context_position() const
+{
+    if (m_function == Function::Last || m_function == Function::Position)
+        return true;
+    return any_of(m_arguments, [](auto const& argument) { return argument->depends_on_context_position(); });
+}
+
+ErrorOr<Utf16String, EvaluationError> FunctionCall::string_argument(Evaluation& evaluation, Context const& context, size_t index) const
+{
+    // NB: Functions whose string argument is optional use the string-value of the context node instead.
+    if (index >= m_arguments.size())
+        return string_value(*context.node);
+    return TRY(m_arguments[index]->evaluate(evaluation, context)).to_string();
+}
+
+ErrorOr<Optional<GC::Ref<DOM::Node>>, EvaluationError> FunctionCall::first_node_of_argument(Evaluation& evaluation, Context const& context) const
+{
+    if (m_arguments.is_empty())
+        return context.node;
+    auto argument = TRY(m_arguments[0]->evaluate(evaluation, context));
+    if (!argument.is_node_set())
+        return EvaluationError { "The argument must be a node set"_string };
+    if (argument.node_set().is_empty())
+        return OptionalNone {};
+    return argument.node_set().first();
+}
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#function-id
+ErrorOr<NodeSet, EvaluationError> FunctionCall::evaluate_id(Evaluation& evaluation, Context const& context) const
+{
+    HashTable<FlyString> ids;
+    auto add_ids = [&](Utf16View const& string) {
+        size_t token_start = 0;
+        for (size_t i = 0; i <= string.length_in_code_units(); ++i) {
+            if (i < string.length_in_code_units() && !is_xpath_whitespace(string.code_unit_at(i)))
+                continue;
+            if (i > token_start)
+                ids.set(MUST(string.substring_view(token_start, i - token_start).to_utf8()));
+            token_start = i + 1;
+        }
+    };
+
+    auto argument = TRY(m_arguments[0]->evaluate(evaluation, context));
+    if (argument.is_node_set()) {
+        for (auto const& node : argument.node_set())
+            add_ids(string_value(*node));
+    } else {
+        add_ids(argument.to_string());
+    }
+
+    NodeSet nodes;
+    if (ids.is_empty())
+        return nodes;
+
+    auto& root = tree_root(*context.node);
+    if (auto* document = as_if<DOM::Document>(root)) {
+        // Fast path: A document already knows which of its elements have which ID.
+        for (auto const& id : ids) {
+            document->element_by_id().for_each_element_with_id(id, *document, [&](DOM::Element& element) {
+                if (&element.root() == &root)
+                    nodes.append(element);
+            });
+        }
+    } else {
+        root.for_each_in_inclusive_subtree_of_type<DOM::Element>([&](DOM::Element& element) {
+            if (element.id().has_value() && ids.contains(*element.id()))
+                nodes.append(element);
+            return TraversalDecision::Continue;
+        });
+    }
+
+    evaluation.sort_in_document_order(nodes);
+    return nodes;
+}
+
+static Utf16String normalize_space(Utf16View const& string)
+{
+    StringBuilder builder(StringBuilder::Mode::UTF16, string.length_in_code_units());
+    bool has_pending_space = false;
+    for (size_t i = 0; i < string.length_in_code_units(); ++i) {
+        auto code_unit = string.code_unit_at(i);
+        if (is_xpath_whitespace(code_unit)) {
+            has_pending_space = !builder.is_empty();
+            continue;
+        }
+        if (has_pending_space) {
+            builder.append(' ');
+            has_pending_space = false;
+        }
+        builder.append_code_unit(code_unit);
+    }
+    return builder.to_utf16_string();
+}
+
+EvaluationResult FunctionCall::evaluate(Evaluation& evaluation, Context const& context) const
+{
+    switch (m_function) {
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-last
+    case Function::Last:
+        return Value { static_cast<double>(context.size) };
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-position
+    case Function::Position:
+        return Value { static_cast<double>(context.position) };
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-count
+    case Function::Count: {
+        auto argument = TRY(m_arguments[0]->evaluate(evaluation, context));
+        if (!argument.is_node_set())
+            return EvaluationError { "The argument of count() must be a node set"_string };
+        return Value { static_cast<double>(argument.node_set().size()) };
+    }
+
+    case Function::Id:
+        return Value { TRY(evaluate_id(evaluation, context)) };
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-local-name
+    case Function::LocalName: {
+        auto node = TRY(first_node_of_argument(evaluation, context));
+        if (!node.has_value())
+            return Value { Utf16String {} };
+        if (auto const* element = as_if<DOM::Element>(**node))
+            return Value { Utf16String::from_utf8(element->local_name()) };
+        if (auto const* attribute = as_if<DOM::Attr>(**node))
+            return Value { Utf16String::from_utf8(attribute->local_name()) };
+        if (auto const* processing_instruction = as_if<DOM::ProcessingInstruction>(**node))
+            return Value { Utf16String::from_utf8(processing_instruction->target()) };
+        return Value { Utf16String {} };
+    }
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-namespace-uri
+    case Function::NamespaceUri: {
+        auto node = TRY(first_node_of_argument(evaluation, context));
+        if (!node.has_value())
+            return Value { Utf16String {} };
+        Optional<FlyString> namespace_uri;
+        if (auto const* element = as_if<DOM::Element>(**node))
+            namespace_uri = element->namespace_uri();
+        else if (auto const* attribute = as_if<DOM::Attr>(**node))
+            namespace_uri = attribute->namespace_uri();
+        if (!namespace_uri.has_value())
+            return Value { Utf16String {} };
+        return Value { Utf16String::from_utf8(*namespace_uri) };
+    }
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-name
+    case Function::Name: {
+        auto node = TRY(first_node_of_argument(evaluation, context));
+        if (!node.has_value())
+            return Value { Utf16String {} };
+        if (auto const* element = as_if<DOM::Element>(**node))
+            return Value { Utf16String::from_utf8(element->qualified_name()) };
+        if (auto const* attribute = as_if<DOM::Attr>(**node))
+            return Value { Utf16String::from_utf8(attribute->name()) };
+        if (auto const* processing_instruction = as_if<DOM::ProcessingInstruction>(**node))
+            return Value { Utf16String::from_utf8(processing_instruction->target()) };
+        return Value { Utf16String {} };
+    }
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-string
+    case Function::String:
+        return Value { TRY(string_argument(evaluation, context, 0)) };
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-concat
+    case Function::Concat: {
+        StringBuilder builder(StringBuilder::Mode::UTF16);
+        for (size_t i = 0; i < m_arguments.size(); ++i)
+            builder.append(TRY(string_argument(evaluation, context, i)));
+        return Value { builder.to_utf16_string() };
+    }
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-starts-with
+    case Function::StartsWith: {
+        auto string = TRY(string_argument(evaluation, context, 0));
+        auto prefix = TRY(string_argument(evaluation, context, 1));
+        return Value { string.starts_with(prefix) };
+    }
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-contains
+    case Function::Contains: {
+        auto string = TRY(string_argument(evaluation, context, 0));
+        auto substring = TRY(string_argument(evaluation, context, 1));
+        return Value { string.contains(substring) };
+    }
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-substring-before
+    case Function::SubstringBefore: {
+        auto string = TRY(string_argument(evaluation, context, 0));
+        auto separator = TRY(string_argument(evaluation, context, 1));
+        auto offset = string.find_code_unit_offset(separator);
+        if (!offset.has_value())
+            return Value { Utf16String {} };
+        return Value { Utf16String::from_utf16(string.substring_view(0, *offset)) };
+    }
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-substring-after
+    case Function::SubstringAfter: {
+        auto string = TRY(string_argument(evaluation, context, 0));
+        auto separator = TRY(string_argument(evaluation, context, 1));
+        auto offset = string.find_code_unit_offset(separator);
+        if (!offset.has_value())
+            return Value { Utf16String {} };
+        return Value { Utf16String::from_utf16(string.substring_view(*offset + separator.length_in_code_units())) };
+    }
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-substring
+    case Function::Substring: {
+        auto string = TRY(string_argument(evaluation, context, 0));
+        auto start = xpath_round(TRY(m_arguments[1]->evaluate(evaluation, context)).to_number());
+        auto end = AK::Infinity<double>;
+        if (m_arguments.size() == 3)
+            end = start + xpath_round(TRY(m_arguments[2]->evaluate(evaluation, context)).to_number());
+
+        // The characters whose position p, counting from 1, satisfies start <= p < end. NaN satisfies neither.
+        StringBuilder builder(StringBuilder::Mode::UTF16);
+        for (size_t i = 0; i < string.length_in_code_units(); ++i) {
+            auto position = static_cast<double>(i + 1);
+            if (position >= start && position < end)
+                builder.append_code_unit(string.code_unit_at(i));
+        }
+        return Value { builder.to_utf16_string() };
+    }
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-string-length
+    case Function::StringLength:
+        return Value { static_cast<double>(TRY(string_argument(evaluation, context, 0)).length_in_code_units()) };
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-normalize-space
+    case Function::NormalizeSpace:
+        return Value { normalize_space(TRY(string_argument(evaluation, context, 0))) };
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-translate
+    case Function::Translate: {
+        auto string = TRY(string_argument(evaluation, context, 0));
+        auto from = TRY(string_argument(evaluation, context, 1));
+        auto to = TRY(string_argument(evaluation, context, 2));
+
+        StringBuilder builder(StringBuilder::Mode::UTF16, string.length_in_code_units());
+        for (size_t i = 0; i < string.length_in_code_units(); ++i) {
+            auto code_unit = string.code_unit_at(i);
+            auto index = from.find_code_unit_offset(code_unit);
+            if (!index.has_value())
+                builder.append_code_unit(code_unit);
+            else if (*index < to.length_in_code_units())
+                builder.append_code_unit(to.code_unit_at(*index));
+        }
+        return Value { builder.to_utf16_string() };
+    }
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-boolean
+    case Function::Boolean:
+        return Value { TRY(m_arguments[0]->evaluate(evaluation, context)).to_boolean() };
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-not
+    case Function::Not:
+        return Value { !TRY(m_arguments[0]->evaluate(evaluation, context)).to_boolean() };
+
+    case Function::True:
+        return Value { true };
+    case Function::False:
+        return Value { false };
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-lang
+    case Function::Lang: {
+        auto language = TRY(string_argument(evaluation, context, 0));
+
+        // The language is that of the nearest inclusive ancestor with an xml:lang attribute.
+        for (auto* node = context.node.ptr(); node; node = xpath_parent(*node)) {
+            auto* element = as_if<DOM::Element>(*node);
+            if (!element)
+                continue;
+            auto value = element->get_attribute_ns(Namespace::XML, "lang"_fly_string);
+            if (!value.has_value())
+                continue;
+
+            // NB: Only ASCII case is ignored. https://github.com/whatwg/dom/issues/1199
+            auto node_language = Utf16String::from_utf8(*value);
+            if (node_language.equals_ignoring_ascii_case(language))
+                return Value { true };
+            auto length = language.length_in_code_units();
+            return Value { node_language.length_in_code_units() > length
+                && node_language.code_unit_at(length) == '-'
+                && node_language.substring_view(0, length).equals_ignoring_ascii_case(language) };
+        }
+        return Value { false };
+    }
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-number
+    case Function::Number:
+        if (m_arguments.is_empty())
+            return Value { string_to_number(string_value(*context.node)) };
+        return Value { TRY(m_arguments[0]->evaluate(evaluation, context)).to_number() };
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-sum
+    case Function::Sum: {
+        auto argument = TRY(m_arguments[0]->evaluate(evaluation, context));
+        if (!argument.is_node_set())
+            return EvaluationError { "The argument of sum() must be a node set"_string };
+        double sum = 0;
+        for (auto const& node : argument.node_set())
+            sum += string_to_number(string_value(*node));
+        return Value { sum };
+    }
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-floor
+    case Function::Floor:
+        return Value { floor(TRY(m_arguments[0]->evaluate(evaluation, context)).to_number()) };
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-ceiling
+    case Function::Ceiling:
+        return Value { ceil(TRY(m_arguments[0]->evaluate(evaluation, context)).to_number()) };
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#function-round
+    case Function::Round:
+        return Value { xpath_round(TRY(m_arguments[0]->evaluate(evaluation, context)).to_number()) };
+    }
+    VERIFY_NOT_REACHED();
+}
+
+Optional<Axis> axis_from_name(StringView name)
+{
+    if (name == "ancestor"sv)
+        return Axis::Ancestor;
+    if (name == "ancestor-or-self"sv)
+        return Axis::AncestorOrSelf;
+    if (name == "attribute"sv)
+        return Axis::Attribute;
+    if (name == "child"sv)
+        return Axis::Child;
+    if (name == "descendant"sv)
+        return Axis::Descendant;
+    if (name == "descendant-or-self"sv)
+        return Axis::DescendantOrSelf;
+    if (name == "following"sv)
+        return Axis::Following;
+    if (name == "following-sibling"sv)
+        return Axis::FollowingSibling;
+    if (name == "namespace"sv)
+        return Axis::Namespace;
+    if (name == "parent"sv)
+        return Axis::Parent;
+    if (name == "preceding"sv)
+        return Axis::Preceding;
+    if (name == "preceding-sibling"sv)
+        return Axis::PrecedingSibling;
+    if (name == "self"sv)
+        return Axis::Self;
+    return {};
+}
+
+EvaluationResult FilterExpression::evaluate(Evaluation& evaluation, Context const& context) const
+{
+    auto value = TRY(m_primary->evaluate(evaluation, context));
+    if (!value.is_node_set())
+        return EvaluationError { "Only node sets can be filtered with predicates"_string };
+
+    // NB: Predicates of a filter expression see the nodes in document order, as there is no axis to order them by.
+    auto nodes = value.release_node_set();
+    TRY(apply_predicates(evaluation, m_predicates, nodes));
+    return Value { move(nodes) };
+}
+
+static bool can_select_by_position(Step const& step)
+{
+    return any_of(step.predicates, [](auto const& predicate) {
+        if (predicate->depends_on_context_position())
+            return true;
+        // A predicate that evaluates to a number selects the node at that position.
+        auto type = predicate->static_type();
+        return type == StaticType::Number || type == StaticType::Unknown;
+    });
+}
+
+PathExpression::PathExpression(Start start, OwnPtr<Expression> filter, Vector<Step> steps)
+    : m_start(start)
+    , m_filter(move(filter))
+    , m_steps(move(steps))
+{
+    VERIFY((m_start == Start::Filter) == static_cast<bool>(m_filter));
+
+    for (size_t i = 0; i < m_steps.size();) {
+        auto& step = m_steps[i];
+        auto is_node_step_without_predicates = step.node_test.type == NodeTest::Type::Node && step.predicates.is_empty();
+
+        // `.` selects the nodes it is applied to, so it can go as long as another step follows it.
+        if (step.axis == Axis::Self && is_node_step_without_predicates && i + 1 < m_steps.size()) {
+            m_steps.remove(i);
+            continue;
+        }
+
+        // `//name` abbreviates `descendant-or-self::node()/child::name`, which selects the same nodes as the much
+        // cheaper `descendant::name`, unless the predicates of the child step select nodes by their position.
+        if (step.axis == Axis::DescendantOrSelf && is_node_step_without_predicates && i + 1 < m_steps.size()) {
+            auto& next_step = m_steps[i + 1];
+            if (next_step.axis == Axis::Child && !can_select_by_position(next_step)) {
+                next_step.axis = Axis::Descendant;
+                m_steps.remove(i);
+                continue;
+            }
+        }
+        ++i;
+    }
+}
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#location-paths
+EvaluationResult PathExpression::evaluate(Evaluation& evaluation, Context const& context) const
+{
+    NodeSet nodes;
+    switch (m_start) {
+    case Start::ContextNode:
+        nodes.append(context.node);
+        break;
+    case Start::Root:
+        nodes.append(tree_root(*context.node));
+        break;
+    case Start::Filter: {
+        auto value = TRY(m_filter->evaluate(evaluation, context));
+        if (!value.is_node_set())
+            return EvaluationError { "Only node sets can be the start of a location path"_string };
+        nodes = value.release_node_set();
+        break;
+    }
+    }
+
+    for (auto const& step : m_steps) {
+        if (nodes.is_empty())
+            break;
+        nodes = TRY(evaluate_step(evaluation, step, nodes));
+    }
+    return Value { move(nodes) };
+}
+
+}
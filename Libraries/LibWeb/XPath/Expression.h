@@ -0,0 +1,367 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/FlyString.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/Utf16String.h>
+#include <AK/Variant.h>
+#include <AK/Vector.h>
+#include <LibGC/Ptr.h>
+#include <LibWeb/Forward.h>
+
+namespace Web::XPath {
+
+// NB: The nodes of a node set are kept alive by the tree they are in. Evaluating an expression never runs script, so
+//     that tree can't change until the evaluation is done.
+using NodeSet = Vector<GC::Ref<DOM::Node>>;
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#section-Introduction
+class Value {
+public:
+    Value(NodeSet node_set)
+        : m_value(move(node_set))
+    {
+    }
+    Value(bool boolean)
+        : m_value(boolean)
+    {
+    }
+    Value(double number)
+        : m_value(number)
+    {
+    }
+    Value(Utf16String string)
+        : m_value(move(string))
+    {
+    }
+
+    bool is_node_set() const { return m_value.has<NodeSet>(); }
+    bool is_boolean() const { return m_value.has<bool>(); }
+    bool is_number() const { return m_value.has<double>(); }
+    bool is_string() const { return m_value.has<Utf16String>(); }
+
+    // NB: Node sets are always kept in document order, without duplicates.
+    NodeSet const& node_set() const { return m_value.get<NodeSet>(); }
+    NodeSet release_node_set() { return move(m_value.get<NodeSet>()); }
+    double number() const { return m_value.get<double>(); }
+
+    bool to_boolean() const;
+    double to_number() const;
+    Utf16String to_string() const;
+
+private:
+    Variant<NodeSet, bool, double, Utf16String> m_value;
+};
+
+Utf16String string_value(DOM::Node const&);
+double string_to_number(Utf16View const&);
+Utf16String number_to_string(double);
+
+struct EvaluationError {
+    String message;
+};
+
+using EvaluationResult = ErrorOr<Value, EvaluationError>;
+
+// The state shared by all the subexpressions evaluated for one call to evaluate().
+class Evaluation {
+public:
+    explicit Evaluation(DOM::Node& context_node);
+
+    DOM::Node& context_node() const { return m_context_node; }
+
+    // Whether the context node is from an HTML document, which decides how element and attribute names are matched.
+    // https://html.spec.whatwg.org/multipage/infrastructure.html#interactions-with-xpath-and-xslt
+    bool is_html_document() const { return m_is_html_document; }
+    Optional<FlyString> const& default_element_namespace() const { return m_default_element_namespace; }
+
+    // Puts nodes collected from more than one context node back into document order, and drops the duplicates.
+    void sort_in_document_order(NodeSet&);
+
+private:
+    void compute_document_order();
+
+    GC::Ref<DOM::Node> m_context_node;
+    bool m_is_html_document { false };
+    Optional<FlyString> m_default_element_namespace;
+
+    // NB: Built the first time nodes need sorting, by walking the tree of the context node once.
+    HashMap<DOM::Node const*, size_t> m_document_order;
+};
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#dt-context-node
+struct Context {
+    GC::Ref<DOM::Node> node;
+    size_t position { 1 };
+    size_t size { 1 };
+};
+
+// The type an expression is known to evaluate to without evaluating it, if any.
+enum class StaticType {
+    Unknown,
+    NodeSet,
+    Boolean,
+    Number,
+    String,
+};
+
+class Expression {
+public:
+    virtual ~Expression() = default;
+
+    virtual EvaluationResult evaluate(Evaluation&, Context const&) const = 0;
+
+    virtual StaticType static_type() const { return StaticType::Unknown; }
+
+    // Whether the result depends on the context position or size, and not just on the context node.
+    virtual bool depends_on_context_position() const { return false; }
+
+    virtual Optional<double> as_number_literal() const { return {}; }
+};
+
+class BinaryExpression final : public Expression {
+public:
+    enum class Operator {
+        Or,
+        And,
+        Equal,
+        NotEqual,
+        LessThan,
+        LessThanOrEqual,
+        GreaterThan,
+        GreaterThanOrEqual,
+        Add,
+        Subtract,
+        Multiply,
+        Divide,
+        Modulo,
+        Union,
+    };
+
+    BinaryExpression(Operator op, NonnullOwnPtr<Expression> lhs, NonnullOwnPtr<Expression> rhs)
+        : m_operator(op)
+        , m_lhs(move(lhs))
+        , m_rhs(move(rhs))
+    {
+    }
+
+    virtual EvaluationResult evaluate(Evaluation&, Context const&) const override;
+    virtual StaticType static_type() const override;
+    virtual bool depends_on_context_position() const override { return m_lhs->depends_on_context_position() || m_rhs->depends_on_context_position(); }
+
+private:
+    Operator m_operator;
+    NonnullOwnPtr<Expression> m_lhs;
+    NonnullOwnPtr<Expression> m_rhs;
+};
+
+class NegateExpression final : public Expression {
+public:
+    explicit NegateExpression(NonnullOwnPtr<Expression> operand)
+        : m_operand(move(operand))
+    {
+    }
+
+    virtual EvaluationResult evaluate(Evaluation&, Context const&) const override;
+    virtual StaticType static_type() const override { return StaticType::Number; }
+    virtual bool depends_on_context_position() const override { return m_operand->depends_on_context_position(); }
+
+private:
+    NonnullOwnPtr<Expression> m_operand;
+};
+
+class StringLiteral final : public Expression {
+public:
+    explicit StringLiteral(Utf16String value)
+        : m_value(move(value))
+    {
+    }
+
+    virtual EvaluationResult evaluate(Evaluation&, Context const&) const override { return Value { m_value }; }
+    virtual StaticType static_type() const override { return StaticType::String; }
+
+private:
+    Utf16String m_value;
+};
+
+class NumberLiteral final : public Expression {
+public:
+    explicit NumberLiteral(double value)
+        : m_value(value)
+    {
+    }
+
+    virtual EvaluationResult evaluate(Evaluation&, Context const&) const override { return Value { m_value }; }
+    virtual StaticType static_type() const override { return StaticType::Number; }
+    virtual Optional<double> as_number_literal() const override { return m_value; }
+
+private:
+    double m_value;
+};
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#corelib
+class FunctionCall final : public Expression {
+public:
+#define ENUMERATE_XPATH_FUNCTIONS(X)                     \
+    X(Last, "last", 0, 0)                                \
+    X(Position, "position", 0, 0)                        \
+    X(Count, "count", 1, 1)                              \
+    X(Id, "id", 1, 1)                                    \
+    X(LocalName, "local-name", 0, 1)                     \
+    X(NamespaceUri, "namespace-uri", 0, 1)               \
+    X(Name, "name", 0, 1)                                \
+    X(String, "string", 0, 1)                            \
+    X(Concat, "concat", 2, NumericLimits<size_t>::max()) \
+    X(StartsWith, "starts-with", 2, 2)                   \
+    X(Contains, "contains", 2, 2)                        \
+    X(SubstringBefore, "substring-before", 2, 2)         \
+    X(SubstringAfter, "substring-after", 2, 2)           \
+    X(Substring, "substring", 2, 3)                      \
+    X(StringLength, "string-length", 0, 1)               \
+    X(NormalizeSpace, "normalize-space", 0, 1)           \
+    X(Translate, "translate", 3, 3)                      \
+    X(Boolean, "boolean", 1, 1)                          \
+    X(Not, "not", 1, 1)                                  \
+    X(True, "true", 0, 0)                                \
+    X(False, "false", 0, 0)                              \
+    X(Lang, "lang", 1, 1)                                \
+    X(Number, "number", 0, 1)                            \
+    X(Sum, "sum", 1, 1)                                  \
+    X(Floor, "floor", 1, 1)                              \
+    X(Ceiling, "ceiling", 1, 1)                          \
+    X(Round, "round", 1, 1)
+
+    enum class Function {
+#define __ENUMERATE_XPATH_FUNCTION(name, string, minimum_arguments, maximum_arguments) name,
+        ENUMERATE_XPATH_FUNCTIONS(__ENUMERATE_XPATH_FUNCTION)
+#undef __ENUMERATE_XPATH_FUNCTION
+    };
+
+    struct Signature {
+        Function function;
+        size_t minimum_arguments { 0 };
+        size_t maximum_arguments { 0 };
+    };
+    static Optional<Signature> signature_for_name(StringView);
+
+    FunctionCall(Function function, Vector<NonnullOwnPtr<Expression>> arguments)
+        : m_function(function)
+        , m_arguments(move(arguments))
+    {
+    }
+
+    virtual EvaluationResult evaluate(Evaluation&, Context const&) const override;
+    virtual StaticType static_type() const override;
+    virtual bool depends_on_context_position() const override;
+
+private:
+    ErrorOr<Utf16String, EvaluationError> string_argument(Evaluation&, Context const&, size_t index) const;
+    ErrorOr<Optional<GC::Ref<DOM::Node>>, EvaluationError> first_node_of_argument(Evaluation&, Context const&) const;
+    ErrorOr<NodeSet, EvaluationError> evaluate_id(Evaluation&, Context const&) const;
+
+    Function m_function;
+    Vector<NonnullOwnPtr<Expression>> m_arguments;
+};
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#axes
+enum class Axis {
+    Ancestor,
+    AncestorOrSelf,
+    Attribute,
+    Child,
+    Descendant,
+    DescendantOrSelf,
+    Following,
+    FollowingSibling,
+    Namespace,
+    Parent,
+    Preceding,
+    PrecedingSibling,
+    Self,
+};
+
+Optional<Axis> axis_from_name(StringView);
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#node-tests
+struct NodeTest {
+    enum class Type {
+        // A QName, matched against nodes of the principal node type of the axis.
+        Name,
+        // "*", which matches any node of the principal node type.
+        AnyName,
+        // "prefix:*", which matches any node of the principal node type in the namespace bound to the prefix.
+        AnyNameInNamespace,
+        Node,
+        Text,
+        Comment,
+        ProcessingInstruction,
+    };
+
+    Type type { Type::Node };
+
+    // NB: For an unprefixed name test, which namespace applies depends on the context node, so it is only known once
+    //     the expression is evaluated.
+    bool has_prefix { false };
+    Optional<FlyString> namespace_uri;
+    FlyString local_name;
+    FlyString ascii_lowercase_local_name;
+
+    // The target a processing-instruction() test is given, if any.
+    Optional<String> target;
+};
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#location-paths
+struct Step {
+    Axis axis { Axis::Child };
+    NodeTest node_test;
+    Vector<NonnullOwnPtr<Expression>> predicates;
+};
+
+// A primary expression followed by predicates, such as `(//a)[1]`.
+class FilterExpression final : public Expression {
+public:
+    FilterExpression(NonnullOwnPtr<Expression> primary, Vector<NonnullOwnPtr<Expression>> predicates)
+        : m_primary(move(primary))
+        , m_predicates(move(predicates))
+    {
+    }
+
+    virtual EvaluationResult evaluate(Evaluation&, Context const&) const override;
+    virtual StaticType static_type() const override { return StaticType::NodeSet; }
+    virtual bool depends_on_context_position() const override { return m_primary->depends_on_context_position(); }
+
+private:
+    NonnullOwnPtr<Expression> m_primary;
+    Vector<NonnullOwnPtr<Expression>> m_predicates;
+};
+
+// A location path, optionally starting from the node set of a filter expression, such as `$nodes/a` or `/a//b`.
+class PathExpression final : public Expression {
+public:
+    enum class Start {
+        ContextNode,
+        Root,
+        Filter,
+    };
+
+    PathExpression(Start, OwnPtr<Expression> filter, Vector<Step>);
+
+    virtual EvaluationResult evaluate(Evaluation&, Context const&) const override;
+    virtual StaticType static_type() const override { return StaticType::NodeSet; }
+    virtual bool depends_on_context_position() const override { return m_filter && m_filter->depends_on_context_position(); }
+
+private:
+    Start m_start;
+    OwnPtr<Expression> m_filter;
+    Vector<Step> m_steps;
+};
+
+}
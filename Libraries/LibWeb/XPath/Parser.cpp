@@ -0,0 +1,741 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/HashMap.h>
+#include <AK/Math.h>
+#include <AK/StringBuilder.h>
+#include <AK/Utf8View.h>
+#include <LibWeb/Namespace.h>
+#include <LibWeb/XPath/Parser.h>
+
+namespace Web::XPath {
+
+namespace {
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#exprlex
+enum class TokenType {
+    LeftParenthesis,
+    RightParenthesis,
+    LeftBracket,
+    RightBracket,
+    Dot,
+    DoubleDot,
+    At,
+    Comma,
+    DoubleColon,
+    NameTest,
+    NodeType,
+    Operator,
+    FunctionName,
+    AxisName,
+    Literal,
+    Number,
+    VariableReference,
+    EndOfInput,
+};
+
+struct Token {
+    TokenType type;
+    String value;
+};
+
+}
+
+static ParseError syntax_error(StringView message)
+{
+    return ParseError { ParseError::Type::Syntax, MUST(String::from_utf8(message)) };
+}
+
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#NT-ExprWhitespace
+static bool is_whitespace(u32 code_point)
+{
+    return code_point == ' ' || code_point == '\t' || code_point == '\r' || code_point == '\n';
+}
+
+// https://www.w3.org/TR/xml-names/#NT-NCName
+static bool is_ncname_start_character(u32 code_point)
+{
+    return (code_point >= 'A' && code_point <= 'Z')
+        || code_point == '_'
+        || (code_point >= 'a' && code_point <= 'z')
+        || (code_point >= 0xc0 && code_point <= 0xd6)
+        || (code_point >= 0xd8 && code_point <= 0xf6)
+        || (code_point >= 0xf8 && code_point <= 0x2ff)
+        || (code_point >= 0x370 && code_point <= 0x37d)
+        || (code_point >= 0x37f && code_point <= 0x1fff)
+        || (code_point >= 0x200c && code_point <= 0x200d)
+        || (code_point >= 0x2070 && code_point <= 0x218f)
+        || (code_point >= 0x2c00 && code_point <= 0x2fef)
+        || (code_point >= 0x3001 && code_point <= 0xd7ff)
+        || (code_point >= 0xf900 && code_point <= 0xfdcf)
+        || (code_point >= 0xfdf0 && code_point <= 0xfffd)
+        || (code_point >= 0x10000 && code_point <= 0xeffff);
+}
+
+static bool is_ncname_character(u32 code_point)
+{
+    return is_ncname_start_character(code_point)
+        || code_point == '-'
+        || code_point == '.'
+        || (code_point >= '0' && code_point <= '9')
+        || code_point == 0xb7
+        || (code_point >= 0x300 && code_point <= 0x36f)
+        || (code_point >= 0x203f && code_point <= 0x2040);
+}
+
+namespace {
+
+class Tokenizer {
+public:
+    explicit Tokenizer(StringView input)
+    {
+        for (auto code_point : Utf8View { input })
+            m_input.append(code_point);
+    }
+
+    ErrorOr<Vector<Token>, ParseError> tokenize()
+    {
+        while (true) {
+            skip_whitespace();
+            auto code_point = peek();
+            if (!code_point.has_value()) {
+                m_tokens.append({ TokenType::EndOfInput, {} });
+                return move(m_tokens);
+            }
+            TRY(tokenize_one(*code_point));
+        }
+    }
+
+private:
+    Optional<u32> peek(size_t offset = 0) const
+    {
+        if (m_position + offset >= m_input.size())
+            return {};
+        return m_input[m_position + offset];
+    }
+
+    bool next_is(u32 code_point, size_t offset = 0) const { return peek(offset) == code_point; }
+
+    void skip_whitespace()
+    {
+        while (m_position < m_input.size() && is_whitespace(m_input[m_position]))
+            ++m_position;
+    }
+
+    void append(TokenType type, size_t length, String value = {})
+    {
+        m_position += length;
+        m_tokens.append({ type, move(value) });
+    }
+
+    String substring(size_t start, size_t end) const
+    {
+        StringBuilder builder;
+        for (size_t i = start; i < end; ++i)
+            builder.append_code_point(m_input[i]);
+        return builder.to_string_without_validation();
+    }
+
+    String consume_ncname()
+    {
+        auto start = m_position;
+        while (m_position < m_input.size() && is_ncname_character(m_input[m_position]))
+            ++m_position;
+        return substring(start, m_position);
+    }
+
+    // https://www.w3.org/TR/1999/REC-xpath-19991116/#exprlex
+    // "If there is a preceding token and the preceding token is not one of @, ::, (, [, , or an Operator, then a * must
+    //  be recognized as a MultiplyOperator and an NCName must be recognized as an OperatorName."
+    bool preceding_token_is_operand() const
+    {
+        if (m_tokens.is_empty())
+            return false;
+        return !first_is_one_of(m_tokens.last().type, TokenType::At, TokenType::DoubleColon, TokenType::LeftParenthesis, TokenType::LeftBracket, TokenType::Comma, TokenType::Operator);
+    }
+
+    ErrorOr<void, ParseError> tokenize_number()
+    {
+        auto start = m_position;
+        while (m_position < m_input.size() && is_ascii_digit(m_input[m_position]))
+            ++m_position;
+        if (next_is('.')) {
+            ++m_position;
+            while (m_position < m_input.size() && is_ascii_digit(m_input[m_position]))
+                ++m_position;
+        }
+        m_tokens.append({ TokenType::Number, substring(start, m_position) });
+        return {};
+    }
+
+    ErrorOr<void, ParseError> tokenize_literal(u32 quote)
+    {
+        auto start = m_position + 1;
+        for (auto end = start; end < m_input.size(); ++end) {
+            if (m_input[end] == quote) {
+                m_tokens.append({ TokenType::Literal, substring(start, end) });
+                m_position = end + 1;
+                return {};
+            }
+        }
+        return syntax_error("Unterminated string literal"sv);
+    }
+
+    ErrorOr<String, ParseError> consume_qualified_name()
+    {
+        if (!peek().has_value() || !is_ncname_start_character(*peek()))
+            return syntax_error("Expected a name"sv);
+        auto name = consume_ncname();
+        if (next_is(':') && !next_is(':', 1) && peek(1).has_value() && is_ncname_start_character(*peek(1))) {
+            ++m_position;
+            auto local_name = consume_ncname();
+            return MUST(String::formatted("{}:{}", name, local_name));
+        }
+        return name;
+    }
+
+    ErrorOr<void, ParseError> tokenize_name()
+    {
+        auto start = m_position;
+        auto name = consume_ncname();
+
+        if (preceding_token_is_operand()) {
+            if (!name.bytes_as_string_view().is_one_of("and"sv, "or"sv, "mod"sv, "div"sv))
+                return syntax_error("Expected an operator"sv);
+            m_tokens.append({ TokenType::Operator, move(name) });
+            return {};
+        }
+
+        // NameTest ::= '*' | NCName ':' '*' | QName
+        if (next_is(':') && next_is('*', 1)) {
+            m_position += 2;
+            m_tokens.append({ TokenType::NameTest, MUST(String::formatted("{}:*", name)) });
+            return {};
+        }
+        m_position = start;
+        auto qualified_name = TRY(consume_qualified_name());
+        auto has_prefix = qualified_name.bytes_as_string_view().contains(':');
+
+        // "If the character following an NCName (possibly after intervening ExprWhitespace) is (, then the token must be
+        //  recognized as a NodeType or a FunctionName. If the two characters following an NCName (possibly after
+        //  intervening ExprWhitespace) are ::, then the token must be recognized as an AxisName."
+        auto end_of_name = m_position;
+        skip_whitespace();
+        auto is_followed_by_parenthesis = next_is('(');
+        auto is_followed_by_double_colon = next_is(':') && next_is(':', 1);
+        m_position = end_of_name;
+
+        if (is_followed_by_parenthesis) {
+            auto is_node_type = !has_prefix && qualified_name.bytes_as_string_view().is_one_of("comment"sv, "text"sv, "processing-instruction"sv, "node"sv);
+            m_tokens.append({ is_node_type ? TokenType::NodeType : TokenType::FunctionName, move(qualified_name) });
+            return {};
+        }
+        if (is_followed_by_double_colon) {
+            if (has_prefix)
+                return syntax_error("Expected an axis name"sv);
+            m_tokens.append({ TokenType::AxisName, move(qualified_name) });
+            return {};
+        }
+        m_tokens.append({ TokenType::NameTest, move(qualified_name) });
+        return {};
+    }
+
+    ErrorOr<void, ParseError> tokenize_one(u32 code_point)
+    {
+        switch (code_point) {
+        case '(':
+            append(TokenType::LeftParenthesis, 1);
+            return {};
+        case ')':
+            append(TokenType::RightParenthesis, 1);
+            return {};
+        case '[':
+            append(TokenType::LeftBracket, 1);
+            return {};
+        case ']':
+            append(TokenType::RightBracket, 1);
+            return {};
+        case '@':
+            append(TokenType::At, 1);
+            return {};
+        case ',':
+            append(TokenType::Comma, 1);
+            return {};
+        case '.':
+            if (next_is('.', 1)) {
+                append(TokenType::DoubleDot, 2);
+                return {};
+            }
+            if (peek(1).has_value() && is_ascii_digit(*peek(1)))
+                return tokenize_number();
+            append(TokenType::Dot, 1);
+            return {};
+        case ':':
+            if (!next_is(':', 1))
+                return syntax_error("Unexpected ':'"sv);
+            append(TokenType::DoubleColon, 2);
+            return {};
+        case '"':
+        case '\'':
+            return tokenize_literal(code_point);
+        case '$': {
+            ++m_position;
+            auto name = TRY(consume_qualified_name());
+            m_tokens.append({ TokenType::VariableReference, move(name) });
+            return {};
+        }
+        case '*':
+            if (preceding_token_is_operand())
+                append(TokenType::Operator, 1, "*"_string);
+            else
+                append(TokenType::NameTest, 1, "*"_string);
+            return {};
+        case '/':
+            if (next_is('/', 1))
+                append(TokenType::Operator, 2, "//"_string);
+            else
+                append(TokenType::Operator, 1, "/"_string);
+            return {};
+        case '|':
+            append(TokenType::Operator, 1, "|"_string);
+            return {};
+        case '+':
+            append(TokenType::Operator, 1, "+"_string);
+            return {};
+        case '-':
+            append(TokenType::Operator, 1, "-"_string);
+            return {};
+        case '=':
+            append(TokenType::Operator, 1, "="_string);
+            return {};
+        case '!':
+            if (!next_is('=', 1))
+                return syntax_error("Unexpected '!'"sv);
+            append(TokenType::Operator, 2, "!="_string);
+            return {};
+        case '<':
+            if (next_is('=', 1))
+                append(TokenType::Operator, 2, "<="_string);
+            else
+                append(TokenType::Operator, 1, "<"_string);
+            return {};
+        case '>':
+            if (next_is('=', 1))
+                append(TokenType::Operator, 2, ">="_string);
+            else
+                append(TokenType::Operator, 1, ">"_string);
+            return {};
+        default:
+            break;
+        }
+
+        if (is_ascii_digit(code_point))
+            return tokenize_number();
+        if (is_ncname_start_character(code_point))
+            return tokenize_name();
+        return syntax_error("Unexpected character"sv);
+    }
+
+    Vector<u32> m_input;
+    size_t m_position { 0 };
+    Vector<Token> m_tokens;
+};
+
+class Parser {
+public:
+    Parser(Vector<Token> tokens, NamespaceResolver const& namespace_resolver)
+        : m_tokens(move(tokens))
+        , m_namespace_resolver(namespace_resolver)
+    {
+    }
+
+    ErrorOr<NonnullOwnPtr<Expression>, ParseError> parse()
+    {
+        auto expression = TRY(parse_or_expression());
+        if (!next_is(TokenType::EndOfInput))
+            return syntax_error("Unexpected token after the end of the expression"sv);
+        return expression;
+    }
+
+private:
+    using ExpressionOrError = ErrorOr<NonnullOwnPtr<Expression>, ParseError>;
+
+    struct BinaryOperator {
+        StringView token;
+        BinaryExpression::Operator op;
+    };
+
+    Token const& peek() const { return m_tokens[m_position]; }
+
+    Token const& consume()
+    {
+        auto const& token = m_tokens[m_position];
+        if (token.type != TokenType::EndOfInput)
+            ++m_position;
+        return token;
+    }
+
+    bool next_is(TokenType type) const { return peek().type == type; }
+    bool next_is_operator(StringView op) const { return next_is(TokenType::Operator) && peek().value == op; }
+
+    ErrorOr<void, ParseError> expect(TokenType type, StringView message)
+    {
+        if (!next_is(type))
+            return syntax_error(message);
+        consume();
+        return {};
+    }
+
+    ExpressionOrError parse_binary_expression(ReadonlySpan<BinaryOperator> operators, ExpressionOrError (Parser::*parse_operand)())
+    {
+        auto lhs = TRY((this->*parse_operand)());
+        while (true) {
+            Optional<BinaryExpression::Operator> op;
+            for (auto const& candidate : operators) {
+                if (next_is_operator(candidate.token))
+                    op = candidate.op;
+            }
+            if (!op.has_value())
+                return lhs;
+            consume();
+            auto rhs = TRY((this->*parse_operand)());
+            lhs = make<BinaryExpression>(*op, move(lhs), move(rhs));
+        }
+    }
+
+    // OrExpr ::= AndExpr | OrExpr 'or' AndExpr
+    ExpressionOrError parse_or_expression()
+    {
+        static constexpr Array operators { BinaryOperator { "or"sv, BinaryExpression::Operator::Or } };
+        return parse_binary_expression(operators.span(), &Parser::parse_and_expression);
+    }
+
+    // AndExpr ::= EqualityExpr | AndExpr 'and' EqualityExpr
+    ExpressionOrError parse_and_expression()
+    {
+        static constexpr Array operators { BinaryOperator { "and"sv, BinaryExpression::Operator::And } };
+        return parse_binary_expression(operators.span(), &Parser::parse_equality_expression);
+    }
+
+    // EqualityExpr ::= RelationalExpr | EqualityExpr '=' RelationalExpr | EqualityExpr '!=' RelationalExpr
+    ExpressionOrError parse_equality_expression()
+    {
+        static constexpr Array operators {
+            BinaryOperator { "="sv, BinaryExpression::Operator::Equal },
+            BinaryOperator { "!="sv, BinaryExpression::Operator::NotEqual },
+        };
+        return parse_binary_expression(operators.span(), &Parser::parse_relational_expression);
+    }
+
+    // RelationalExpr ::= AdditiveExpr | RelationalExpr ('<' | '>' | '<=' | '>=') AdditiveExpr
+    ExpressionOrError parse_relational_expression()
+    {
+        static constexpr Array operators {
+            BinaryOperator { "<"sv, BinaryExpression::Operator::LessThan },
+            BinaryOperator { "<="sv, BinaryExpression::Operator::LessThanOrEqual },
+            BinaryOperator { ">"sv, BinaryExpression::Operator::GreaterThan },
+            BinaryOperator { ">="sv, BinaryExpression::Operator::GreaterThanOrEqual },
+        };
+        return parse_binary_expression(operators.span(), &Parser::parse_additive_expression);
+    }
+
+    // AdditiveExpr ::= MultiplicativeExpr | AdditiveExpr ('+' | '-') MultiplicativeExpr
+    ExpressionOrError parse_additive_expression()
+    {
+        static constexpr Array operators {
+            BinaryOperator { "+"sv, BinaryExpression::Operator::Add },
+            BinaryOperator { "-"sv, BinaryExpression::Operator::Subtract },
+        };
+        return parse_binary_expression(operators.span(), &Parser::parse_multiplicative_expression);
+    }
+
+    // MultiplicativeExpr ::= UnaryExpr | MultiplicativeExpr ('*' | 'div' | 'mod') UnaryExpr
+    ExpressionOrError parse_multiplicative_expression()
+    {
+        static constexpr Array operators {
+            BinaryOperator { "*"sv, BinaryExpression::Operator::Multiply },
+            BinaryOperator { "div"sv, BinaryExpression::Operator::Divide },
+            BinaryOperator { "mod"sv, BinaryExpression::Operator::Modulo },
+        };
+        return parse_binary_expression(operators.span(), &Parser::parse_unary_expression);
+    }
+
+    // UnaryExpr ::= UnionExpr | '-' UnaryExpr
+    ExpressionOrError parse_unary_expression()
+    {
+        if (!next_is_operator("-"sv))
+            return parse_union_expression();
+        consume();
+        return make<NegateExpression>(TRY(parse_unary_expression()));
+    }
+
+    // UnionExpr ::= PathExpr | UnionExpr '|' PathExpr
+    ExpressionOrError parse_union_expression()
+    {
+        static constexpr Array operators { BinaryOperator { "|"sv, BinaryExpression::Operator::Union } };
+        return parse_binary_expression(operators.span(), &Parser::parse_path_expression);
+    }
+
+    bool next_starts_filter_expression() const
+    {
+        return first_is_one_of(peek().type, TokenType::VariableReference, TokenType::LeftParenthesis, TokenType::Literal, TokenType::Number, TokenType::FunctionName);
+    }
+
+    bool next_starts_step() const
+    {
+        return first_is_one_of(peek().type, TokenType::NameTest, TokenType::NodeType, TokenType::AxisName, TokenType::At, TokenType::Dot, TokenType::DoubleDot);
+    }
+
+    // PathExpr ::= LocationPath | FilterExpr | FilterExpr '/' RelativeLocationPath | FilterExpr '//' RelativeLocationPath
+    ExpressionOrError parse_path_expression()
+    {
+        if (!next_starts_filter_expression())
+            return parse_location_path();
+
+        auto filter = TRY(parse_filter_expression());
+        if (!next_is_operator("/"sv) && !next_is_operator("//"sv))
+            return filter;
+
+        Vector<Step> steps;
+        if (consume().value == "//"sv)
+            steps.append(descendant_or_self_step());
+        TRY(parse_relative_location_path(steps));
+        return make<PathExpression>(PathExpression::Start::Filter, move(filter), move(steps));
+    }
+
+    // FilterExpr ::= PrimaryExpr | FilterExpr Predicate
+    ExpressionOrError parse_filter_expression()
+    {
+        auto primary = TRY(parse_primary_expression());
+        auto predicates = TRY(parse_predicates());
+        if (predicates.is_empty())
+            return primary;
+        return make<FilterExpression>(move(primary), move(predicates));
+    }
+
+    // PrimaryExpr ::= VariableReference | '(' Expr ')' | Literal | Number | FunctionCall
+    ExpressionOrError parse_primary_expression()
+    {
+        auto const& token = consume();
+        switch (token.type) {
+        case TokenType::VariableReference:
+            // NB: There is no way to bind variables through the DOM API, so any reference to one is an error.
+            return syntax_error("Variable references are not supported"sv);
+        case TokenType::LeftParenthesis: {
+            auto expression = TRY(parse_or_expression());
+            TRY(expect(TokenType::RightParenthesis, "Expected ')'"sv));
+            return expression;
+        }
+        case TokenType::Literal:
+            return make<StringLiteral>(Utf16String::from_utf8(token.value));
+        case TokenType::Number:
+            return make<NumberLiteral>(token.value.bytes_as_string_view().to_number<double>(TrimWhitespace::No).value_or(AK::NaN<double>));
+        case TokenType::FunctionName:
+            return parse_function_call(token.value);
+        default:
+            VERIFY_NOT_REACHED();
+        }
+    }
+
+    // FunctionCall ::= FunctionName '(' ( Argument ( ',' Argument )* )? ')'
+    ExpressionOrError parse_function_call(String const& name)
+    {
+        auto signature = FunctionCall::signature_for_name(name);
+        if (!signature.has_value())
+            return syntax_error("Unknown function"sv);
+
+        TRY(expect(TokenType::LeftParenthesis, "Expected '('"sv));
+        Vector<NonnullOwnPtr<Expression>> arguments;
+        if (!next_is(TokenType::RightParenthesis)) {
+            arguments.append(TRY(parse_or_expression()));
+            while (next_is(TokenType::Comma)) {
+                consume();
+                arguments.append(TRY(parse_or_expression()));
+            }
+        }
+        TRY(expect(TokenType::RightParenthesis, "Expected ')'"sv));
+
+        if (arguments.size() < signature->minimum_arguments || arguments.size() > signature->maximum_arguments)
+            return syntax_error("Wrong number of arguments"sv);
+        return make<FunctionCall>(signature->function, move(arguments));
+    }
+
+    // LocationPath ::= RelativeLocationPath | AbsoluteLocationPath
+    // AbsoluteLocationPath ::= '/' RelativeLocationPath? | '//' RelativeLocationPath
+    ExpressionOrError parse_location_path()
+    {
+        Vector<Step> steps;
+        if (next_is_operator("/"sv)) {
+            consume();
+            if (next_starts_step())
+                TRY(parse_relative_location_path(steps));
+            return make<PathExpression>(PathExpression::Start::Root, nullptr, move(steps));
+        }
+        if (next_is_operator("//"sv)) {
+            consume();
+            steps.append(descendant_or_self_step());
+            TRY(parse_relative_location_path(steps));
+            return make<PathExpression>(PathExpression::Start::Root, nullptr, move(steps));
+        }
+        TRY(parse_relative_location_path(steps));
+        return make<PathExpression>(PathExpression::Start::ContextNode, nullptr, move(steps));
+    }
+
+    // "// is short for /descendant-or-self::node()/"
+    static Step descendant_or_self_step()
+    {
+        return Step { Axis::DescendantOrSelf, NodeTest { .type = NodeTest::Type::Node }, {} };
+    }
+
+    // RelativeLocationPath ::= Step | RelativeLocationPath '/' Step | RelativeLocationPath '//' Step
+    ErrorOr<void, ParseError> parse_relative_location_path(Vector<Step>& steps)
+    {
+        steps.append(TRY(parse_step()));
+        while (true) {
+            if (next_is_operator("//"sv))
+                steps.append(descendant_or_self_step());
+            else if (!next_is_operator("/"sv))
+                return {};
+            consume();
+            steps.append(TRY(parse_step()));
+        }
+    }
+
+    // Step ::= AxisSpecifier NodeTest Predicate* | '.' | '..'
+    ErrorOr<Step, ParseError> parse_step()
+    {
+        if (next_is(TokenType::Dot)) {
+            consume();
+            return Step { Axis::Self, NodeTest { .type = NodeTest::Type::Node }, {} };
+        }
+        if (next_is(TokenType::DoubleDot)) {
+            consume();
+            return Step { Axis::Parent, NodeTest { .type = NodeTest::Type::Node }, {} };
+        }
+
+        // AxisSpecifier ::= AxisName '::' | '@'?
+        auto axis = Axis::Child;
+        if (next_is(TokenType::AxisName)) {
+            auto maybe_axis = axis_from_name(consume().value);
+            if (!maybe_axis.has_value())
+                return syntax_error("Unknown axis"sv);
+            axis = *maybe_axis;
+            TRY(expect(TokenType::DoubleColon, "Expected '::'"sv));
+        } else if (next_is(TokenType::At)) {
+            consume();
+            axis = Axis::Attribute;
+        }
+
+        auto node_test = TRY(parse_node_test());
+        auto predicates = TRY(parse_predicates());
+        return Step { axis, move(node_test), move(predicates) };
+    }
+
+    // NodeTest ::= NameTest | NodeType '(' ')' | 'processing-instruction' '(' Literal ')'
+    ErrorOr<NodeTest, ParseError> parse_node_test()
+    {
+        if (next_is(TokenType::NameTest))
+            return parse_name_test(consume().value);
+
+        if (!next_is(TokenType::NodeType))
+            return syntax_error("Expected a node test"sv);
+        auto const& node_type = consume().value;
+        TRY(expect(TokenType::LeftParenthesis, "Expected '('"sv));
+
+        NodeTest node_test;
+        if (node_type == "comment"sv) {
+            node_test.type = NodeTest::Type::Comment;
+        } else if (node_type == "text"sv) {
+            node_test.type = NodeTest::Type::Text;
+        } else if (node_type == "processing-instruction"sv) {
+            node_test.type = NodeTest::Type::ProcessingInstruction;
+            if (next_is(TokenType::Literal))
+                node_test.target = consume().value;
+        } else {
+            node_test.type = NodeTest::Type::Node;
+        }
+
+        TRY(expect(TokenType::RightParenthesis, "Expected ')'"sv));
+        return node_test;
+    }
+
+    ErrorOr<NodeTest, ParseError> parse_name_test(String const& name)
+    {
+        NodeTest node_test;
+        if (name == "*"sv) {
+            node_test.type = NodeTest::Type::AnyName;
+            return node_test;
+        }
+
+        auto name_view = name.bytes_as_string_view();
+        auto colon = name_view.find(':');
+        if (!colon.has_value()) {
+            node_test.type = NodeTest::Type::Name;
+            node_test.local_name = FlyString { name };
+            node_test.ascii_lowercase_local_name = node_test.local_name.to_ascii_lowercase();
+            return node_test;
+        }
+
+        auto prefix = MUST(FlyString::from_utf8(name_view.substring_view(0, *colon)));
+        auto local_name = name_view.substring_view(*colon + 1);
+        node_test.has_prefix = true;
+        node_test.namespace_uri = TRY(resolve_prefix(prefix));
+
+        if (local_name == "*"sv) {
+            node_test.type = NodeTest::Type::AnyNameInNamespace;
+            return node_test;
+        }
+        node_test.type = NodeTest::Type::Name;
+        node_test.local_name = MUST(FlyString::from_utf8(local_name));
+        node_test.ascii_lowercase_local_name = node_test.local_name.to_ascii_lowercase();
+        return node_test;
+    }
+
+    ErrorOr<Optional<FlyString>, ParseError> resolve_prefix(FlyString const& prefix)
+    {
+        // The xml prefix is bound to the XML namespace by definition. https://www.w3.org/TR/xml-names/#ns-decl
+        if (prefix == "xml"sv)
+            return Optional<FlyString> { Namespace::XML };
+
+        // NB: The resolver is asked about each prefix once per compilation, however often the prefix appears.
+        auto namespace_uri = m_resolved_prefixes.ensure(prefix, [&] { return m_namespace_resolver(prefix); });
+        if (!namespace_uri.has_value())
+            return ParseError { ParseError::Type::Namespace, MUST(String::formatted("The prefix '{}' is not bound to a namespace", prefix)) };
+
+        // An empty namespace means no namespace, as it does everywhere else in the DOM.
+        if (namespace_uri->is_empty())
+            return Optional<FlyString> {};
+        return namespace_uri;
+    }
+
+    // Predicate ::= '[' PredicateExpr ']'
+    ErrorOr<Vector<NonnullOwnPtr<Expression>>, ParseError> parse_predicates()
+    {
+        Vector<NonnullOwnPtr<Expression>> predicates;
+        while (next_is(TokenType::LeftBracket)) {
+            consume();
+            predicates.append(TRY(parse_or_expression()));
+            TRY(expect(TokenType::RightBracket, "Expected ']'"sv));
+        }
+        return predicates;
+    }
+
+    Vector<Token> m_tokens;
+    size_t m_position { 0 };
+    NamespaceResolver const& m_namespace_resolver;
+    HashMap<FlyString, Optional<FlyString>> m_resolved_prefixes;
+};
+
+}
+
+ErrorOr<NonnullOwnPtr<Expression>, ParseError> parse_expression(StringView expression, NamespaceResolver const& namespace_resolver)
+{
+    auto tokens = TRY(Tokenizer { expression }.tokenize());
+    return Parser { move(tokens), namespace_resolver }.parse();
+}
+
+}
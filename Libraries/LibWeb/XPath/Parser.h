@@ -0,0 +1,38 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Error.h>
+#include <AK/FlyString.h>
+#include <AK/Function.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <LibWeb/XPath/Expression.h>
+
+namespace Web::XPath {
+
+struct ParseError {
+    enum class Type {
+        // The expression doesn't match the XPath 1.0 grammar.
+        Syntax,
+        // The expression uses a namespace prefix that isn't bound to any namespace.
+        Namespace,
+    };
+
+    Type type { Type::Syntax };
+    String message;
+};
+
+// Looks up the namespace a prefix used in an expression is bound to. An empty Optional means it isn't bound to any.
+using NamespaceResolver = Function<Optional<FlyString>(FlyString const& prefix)>;
+
+// Compiles an XPath 1.0 expression, resolving the namespace prefixes it uses along the way.
+// https://www.w3.org/TR/1999/REC-xpath-19991116/#section-Expressions
+ErrorOr<NonnullOwnPtr<Expression>, ParseError> parse_expression(StringView, NamespaceResolver const&);
+
+}
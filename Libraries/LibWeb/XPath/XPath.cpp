@@ -4,206 +4,134 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/Format.h>
-#include <LibWeb/DOM/Attr.h>
-#include <LibWeb/DOM/CDATASection.h>
-#include <LibWeb/DOM/Comment.h>
-#include <LibWeb/DOM/Document.h>
-#include <LibWeb/DOM/DocumentFragment.h>
-#include <LibWeb/DOM/Element.h>
-#include <LibWeb/DOM/NamedNodeMap.h>
+#include <LibJS/Runtime/PrimitiveString.h>
+#include <LibJS/Runtime/Realm.h>
+#include <LibJS/Runtime/ValueInlines.h>
 #include <LibWeb/DOM/Node.h>
-#include <LibWeb/DOM/NodeType.h>
-#include <LibWeb/DOM/ProcessingInstruction.h>
-#include <LibWeb/DOM/Text.h>
+#include <LibWeb/HTML/Scripting/ExceptionReporter.h>
+#include <LibWeb/WebIDL/AbstractOperations.h>
+#include <LibWeb/WebIDL/CallbackType.h>
 #include <LibWeb/WebIDL/DOMException.h>
-
-#include <libxml/parser.h>
-#include <libxml/tree.h>
-#include <libxml/valid.h>
-#include <libxml/xmlstring.h>
-#include <libxml/xpath.h>
+#include <LibWeb/XPath/Expression.h>
+#include <LibWeb/XPath/Parser.h>
 
 #include "XPath.h"
 
 namespace Web::XPath {
 
-static xmlNodePtr mirror_node(xmlDocPtr doc, DOM::Node const& node)
+static Optional<FlyString> lookup_namespace_uri(GC::Ptr<XPathNSResolver> resolver, FlyString const& prefix)
 {
-    switch (node.type()) {
-    case DOM::NodeType::INVALID: {
-        return nullptr;
-    }
-    case DOM::NodeType::ELEMENT_NODE: {
-        auto const& element = static_cast<DOM::Element const&>(node);
-        ByteString name = element.local_name().bytes_as_string_view();
-        auto* xml_element = xmlNewDocNode(doc, nullptr, bit_cast<xmlChar const*>(name.characters()), nullptr);
-        xml_element->_private = bit_cast<void*>(&node);
-        for (size_t i = 0; i < element.attribute_list_size(); ++i) {
-            auto const& attribute = *element.attributes()->item(i);
-            ByteString attr_name = attribute.name().bytes_as_string_view();
-            ByteString attr_value = attribute.value().bytes_as_string_view();
-            auto* attr = xmlSetProp(xml_element, bit_cast<xmlChar const*>(attr_name.characters()), bit_cast<xmlChar const*>(attr_value.characters()));
-            attr->_private = bit_cast<void*>(&attribute);
-
-            if (attribute.name() == "id") {
-                xmlAddIDSafe(attr, bit_cast<xmlChar const*>(attr_value.characters()));
-            }
-        }
-        auto children = element.children_as_vector();
-        for (auto& child : children) {
-            xmlAddChild(xml_element, mirror_node(doc, *child));
-        }
+    if (!resolver)
+        return {};
 
-        return xml_element;
-    }
-    case DOM::NodeType::ATTRIBUTE_NODE: {
-        return nullptr; // Attributes are handled in the elements children above. If this happens, then the attribute is the top node in the document and therefore invalid
-    }
-    case DOM::NodeType::TEXT_NODE: {
-        auto const& text = static_cast<DOM::Text const&>(node);
-        auto* xml_text = xmlNewDocText(doc, bit_cast<xmlChar const*>(text.data().to_byte_string().characters()));
-        xml_text->_private = bit_cast<void*>(&node);
-        return xml_text;
-    }
-    case DOM::NodeType::CDATA_SECTION_NODE: {
-        auto const& cdata = static_cast<DOM::CDATASection const&>(node);
-        ByteString data = cdata.data().to_byte_string();
-        auto* xml_cdata = xmlNewCDataBlock(doc, bit_cast<xmlChar const*>(data.characters()), data.length());
-        xml_cdata->_private = bit_cast<void*>(&node);
-        return xml_cdata;
-    }
-    case DOM::NodeType::ENTITY_REFERENCE_NODE: // Does not seem to be used at all in ladybird
-    case DOM::NodeType::ENTITY_NODE:           // Entity nodes are unused in libxml2
-    {
-        return nullptr;
-    }
-    case DOM::NodeType::PROCESSING_INSTRUCTION_NODE: {
-        auto const& processing_instruction = static_cast<DOM::ProcessingInstruction const&>(node);
-        auto* xml_pi = xmlNewDocPI(doc, bit_cast<xmlChar const*>(processing_instruction.target().to_byte_string().characters()), bit_cast<xmlChar const*>(processing_instruction.data().to_byte_string().characters()));
-        xml_pi->_private = bit_cast<void*>(&node);
-        return xml_pi;
-    }
-    case DOM::NodeType::COMMENT_NODE: {
-        auto const& comment = static_cast<DOM::Comment const&>(node);
-        auto* xml_comment = xmlNewDocComment(doc, bit_cast<xmlChar const*>(comment.data().to_byte_string().characters()));
-        xml_comment->_private = bit_cast<void*>(&node);
-        return xml_comment;
-    }
-    case DOM::NodeType::DOCUMENT_NODE: {
-        auto const& document = static_cast<DOM::Document const&>(node);
-        return mirror_node(doc, *document.document_element());
-    }
-    case DOM::NodeType::DOCUMENT_TYPE_NODE: {
-        return nullptr; // Unused in libxml2
-    }
-    case DOM::NodeType::DOCUMENT_FRAGMENT_NODE: {
-        auto const& fragment = static_cast<DOM::DocumentFragment const&>(node);
-        auto* xml_fragment = xmlNewDocFragment(doc);
-        xml_fragment->_private = bit_cast<void*>(&node);
-        auto children = fragment.children_as_vector();
-        for (auto& child : children) {
-            xmlAddChild(xml_fragment, mirror_node(doc, *child));
-        }
-        return xml_fragment;
-    }
-    case DOM::NodeType::NOTATION_NODE: {
-        return nullptr; // Unused in libxml2
+    auto& callback = resolver->callback();
+    auto& realm = callback.callback->shape().realm();
+    auto& vm = realm.vm();
+
+    // NB: If the resolver throws, or returns something that can't be turned into a string, the exception is reported
+    //     and the prefix is treated as unbound, like browsers do.
+    auto completion = WebIDL::call_user_object_operation(callback, "lookupNamespaceURI"_utf16_fly_string, {}, { { JS::PrimitiveString::create(vm, prefix) } });
+    if (completion.is_abrupt()) {
+        HTML::report_exception(completion, realm);
+        return {};
     }
+
+    auto value = completion.value();
+    if (value.is_nullish())
+        return {};
+
+    auto namespace_uri = value.to_string(vm);
+    if (namespace_uri.is_error()) {
+        HTML::report_exception(namespace_uri, realm);
+        return {};
     }
+    return FlyString { namespace_uri.release_value() };
+}
 
-    return nullptr;
+static WebIDL::ExceptionOr<NonnullOwnPtr<Expression>> compile(JS::Realm& realm, String const& expression, GC::Ptr<XPathNSResolver> resolver)
+{
+    auto compiled_expression = parse_expression(expression, [&](FlyString const& prefix) {
+        return lookup_namespace_uri(resolver, prefix);
+    });
+    if (compiled_expression.is_error()) {
+        auto const& error = compiled_expression.error();
+        if (error.type == ParseError::Type::Namespace)
+            return WebIDL::NamespaceError::create(realm, Utf16String::from_utf8(error.message));
+        return WebIDL::SyntaxError::create(realm, Utf16String::from_utf8(MUST(String::formatted("Invalid XPath expression: {}", error.message))));
+    }
+    return compiled_expression.release_value();
 }
 
-static void convert_xpath_result(xmlXPathObjectPtr xpath_result, XPath::XPathResult* result, unsigned short type)
+static void convert_value_to_result(Value value, XPathResult& result, unsigned short type)
 {
-    if (!xpath_result) {
+    switch (type) {
+    case XPathResult::NUMBER_TYPE:
+        result.set_number(value.to_number());
         return;
-    }
-
-    switch (xpath_result->type) {
-    case XPATH_UNDEFINED:
-        break;
-    case XPATH_NODESET: {
-        Vector<GC::Ptr<DOM::Node>> node_list;
-
-        if (xpath_result->nodesetval && xpath_result->nodesetval->nodeNr > 0) {
-            node_list.ensure_capacity(xpath_result->nodesetval->nodeNr);
-            for (int i = 0; i < xpath_result->nodesetval->nodeNr; i++) {
-                auto* node = xpath_result->nodesetval->nodeTab[i];
-                auto* dom_node = static_cast<DOM::Node*>(node->_private);
-
-                node_list.unchecked_append(dom_node);
-            }
+    case XPathResult::STRING_TYPE:
+        result.set_string(value.to_string().to_utf8());
+        return;
+    case XPathResult::BOOLEAN_TYPE:
+        result.set_boolean(value.to_boolean());
+        return;
+    case XPathResult::ANY_TYPE:
+        if (value.is_number()) {
+            result.set_number(value.number());
+            return;
+        }
+        if (value.is_string()) {
+            result.set_string(value.to_string().to_utf8());
+            return;
+        }
+        if (value.is_boolean()) {
+            result.set_boolean(value.to_boolean());
+            return;
         }
-
-        result->set_node_set(move(node_list), type);
-        break;
-    }
-    case XPATH_BOOLEAN: {
-        result->set_boolean(xpath_result->boolval);
-        break;
-    }
-    case XPATH_NUMBER: {
-        result->set_number(xpath_result->floatval);
-        break;
-    }
-    case XPATH_STRING: {
-        ReadonlyBytes bytes(xpath_result->stringval, xmlStrlen(xpath_result->stringval));
-        result->set_string(String::from_utf8_without_validation(bytes));
         break;
-    }
-    case XPATH_USERS:
-    case XPATH_XSLT_TREE: /* An XSLT value tree, non modifiable */
+    default:
         break;
     }
+
+    // NB: Node sets are in document order, so they satisfy the ordered result types as well as the unordered ones.
+    auto nodes = value.release_node_set();
+    Vector<GC::Ptr<DOM::Node>> node_list;
+    node_list.ensure_capacity(nodes.size());
+    for (auto& node : nodes)
+        node_list.unchecked_append(node);
+    result.set_node_set(move(node_list), type);
 }
 
 WebIDL::ExceptionOr<GC::Ref<XPathExpression>> create_expression(JS::Realm& realm, String const& expression, GC::Ptr<XPathNSResolver> resolver)
 {
-    return realm.create<XPathExpression>(realm, expression, resolver);
+    auto compiled_expression = TRY(compile(realm, expression, resolver));
+    return realm.create<XPathExpression>(realm, move(compiled_expression));
 }
 
-WebIDL::ExceptionOr<GC::Ref<XPathResult>> evaluate(JS::Realm& realm, String const& expression, DOM::Node const& context_node, GC::Ptr<XPathNSResolver> /*resolver*/, unsigned short type, GC::Ptr<XPathResult> result)
+WebIDL::ExceptionOr<GC::Ref<XPathResult>> evaluate(JS::Realm& realm, String const& expression, DOM::Node const& context_node, GC::Ptr<XPathNSResolver> resolver, unsigned short type, GC::Ptr<XPathResult> result)
 {
-    // Parse the expression as xpath
-    ByteString bytes = expression.bytes_as_string_view();
-    auto* xpath_compiled = xmlXPathCompile(bit_cast<xmlChar const*>(bytes.characters()));
-    if (!xpath_compiled)
-        return WebIDL::SyntaxError::create(realm, "Invalid XPath expression"_utf16);
-    ScopeGuard xpath_compiled_cleanup = [&] { xmlXPathFreeCompExpr(xpath_compiled); };
-
-    auto* xml_document = xmlNewDoc(nullptr);
-    ScopeGuard xml_cleanup = [&] { xmlFreeDoc(xml_document); };
-
-    if (context_node.type() == DOM::NodeType::DOCUMENT_NODE) {
-        xml_document->_private = bit_cast<void*>(&context_node);
-    } else {
-        xml_document->_private = bit_cast<void*>(&context_node.document());
-    }
-
-    auto* xml_node = mirror_node(xml_document, context_node);
-    if (!xml_node) {
-        return WebIDL::OperationError::create(realm, "XPath evaluation failed"_utf16);
-    }
-
-    xmlDocSetRootElement(xml_document, xml_node);
+    auto compiled_expression = TRY(compile(realm, expression, resolver));
+    return evaluate(realm, *compiled_expression, context_node, type, result);
+}
 
-    auto* xpath_context = xmlXPathNewContext(xml_document);
-    xmlXPathSetContextNode(xml_node, xpath_context);
+WebIDL::ExceptionOr<GC::Ref<XPathResult>> evaluate(JS::Realm& realm, Expression const& expression, DOM::Node const& context_node, unsigned short type, GC::Ptr<XPathResult> result)
+{
+    if (type > XPathResult::FIRST_ORDERED_NODE_TYPE)
+        return WebIDL::NotSupportedError::create(realm, "Unknown XPath result type"_utf16);
 
-    auto* xpath_result = xmlXPathCompiledEval(xpath_compiled, xpath_context);
+    auto& node = const_cast<DOM::Node&>(context_node);
+    Evaluation evaluation { node };
+    auto value = expression.evaluate(evaluation, Context { node });
+    if (value.is_error())
+        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, value.error().message };
 
-    ScopeGuard xpath_result_cleanup = [&] {
-        xmlXPathFreeObject(xpath_result);
-        xmlXPathFreeContext(xpath_context);
-    };
+    auto is_node_set_type = type != XPathResult::ANY_TYPE && type > XPathResult::BOOLEAN_TYPE;
+    if (is_node_set_type && !value.value().is_node_set())
+        return WebIDL::SimpleException { WebIDL::SimpleExceptionType::TypeError, "The expression does not evaluate to a node set"sv };
 
-    if (!result) {
+    if (!result)
         result = realm.create<XPathResult>(realm);
-    }
 
-    convert_xpath_result(xpath_result, result, type);
+    convert_value_to_result(value.release_value(), *result, type);
 
     return GC::Ref<XPathResult>(*result);
 }
@@ -9,6 +9,7 @@
 #include <LibGC/Ptr.h>
 #include <LibWeb/WebIDL/ExceptionOr.h>
 
+#include "Expression.h"
 #include "XPathExpression.h"
 #include "XPathNSResolver.h"
 #include "XPathResult.h"
@@ -17,5 +18,6 @@ namespace Web::XPath {
 
 WebIDL::ExceptionOr<GC::Ref<XPathExpression>> create_expression(JS::Realm& realm, String const& expression, GC::Ptr<XPathNSResolver> resolver);
 WebIDL::ExceptionOr<GC::Ref<XPathResult>> evaluate(JS::Realm& realm, String const& expression, DOM::Node const& context_node, GC::Ptr<XPathNSResolver> resolver, unsigned short type, GC::Ptr<XPathResult> result);
+WebIDL::ExceptionOr<GC::Ref<XPathResult>> evaluate(JS::Realm& realm, Expression const& expression, DOM::Node const& context_node, unsigned short type, GC::Ptr<XPathResult> result);
 
 }
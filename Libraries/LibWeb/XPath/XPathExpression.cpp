@@ -20,10 +20,9 @@ namespace Web::XPath {
 
 GC_DEFINE_ALLOCATOR(XPathExpression);
 
-XPathExpression::XPathExpression(JS::Realm& realm, String const& expression, GC::Ptr<XPathNSResolver> resolver)
+XPathExpression::XPathExpression(JS::Realm& realm, NonnullOwnPtr<Expression> expression)
     : Web::Bindings::PlatformObject(realm)
-    , m_expression(expression)
-    , m_resolver(resolver)
+    , m_expression(move(expression))
 {
 }
 
@@ -33,18 +32,12 @@ void XPathExpression::initialize(JS::Realm& realm)
     Base::initialize(realm);
 }
 
-void XPathExpression::visit_edges(Cell::Visitor& visitor)
-{
-    Base::visit_edges(visitor);
-    visitor.visit(m_resolver);
-}
-
 XPathExpression::~XPathExpression() = default;
 
 WebIDL::ExceptionOr<GC::Ref<XPathResult>> XPathExpression::evaluate(DOM::Node const& context_node, WebIDL::UnsignedShort type, GC::Ptr<XPathResult> result)
 {
     auto& realm = this->realm();
-    return XPath::evaluate(realm, m_expression, context_node, m_resolver, type, result);
+    return XPath::evaluate(realm, *m_expression, context_node, type, result);
 }
 
 }
@@ -9,6 +9,7 @@
 #include <LibWeb/Bindings/PlatformObject.h>
 #include <LibWeb/Forward.h>
 #include <LibWeb/WebIDL/Types.h>
+#include <LibWeb/XPath/Expression.h>
 #include <LibWeb/XPath/XPathNSResolver.h>
 #include <LibWeb/XPath/XPathResult.h>
 
@@ -19,16 +20,15 @@ class XPathExpression final : public Bindings::PlatformObject {
     GC_DECLARE_ALLOCATOR(XPathExpression);
 
 public:
-    explicit XPathExpression(JS::Realm&, String const& expression, GC::Ptr<XPathNSResolver> resolver);
+    XPathExpression(JS::Realm&, NonnullOwnPtr<Expression>);
     virtual ~XPathExpression() override;
-    virtual void visit_edges(Cell::Visitor&) override;
     virtual void initialize(JS::Realm&) override;
 
     WebIDL::ExceptionOr<GC::Ref<XPathResult>> evaluate(DOM::Node const& context_node, WebIDL::UnsignedShort type = 0, GC::Ptr<XPathResult> result = nullptr);
 
 private:
-    String m_expression;
-    GC::Ptr<XPathNSResolver> m_resolver;
+    // NB: Namespace prefixes are resolved when the expression is created, so the resolver isn't needed afterwards.
+    NonnullOwnPtr<Expression> m_expression;
 };
 
 }
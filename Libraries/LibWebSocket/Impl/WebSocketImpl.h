@@ -29,6 +29,10 @@ public:
 
     virtual bool handshake_complete_when_connected() const { return false; }
 
+    // For implementations that do the opening handshake themselves, the server's response headers with the given name,
+    // combined into one comma-separated value as HTTP allows.
+    virtual Optional<ByteString> handshake_response_header(StringView) const { return {}; }
+
     Function<void()> on_connected;
     Function<void()> on_connection_error;
     Function<void()> on_ready_to_read;
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibWebSocket/PerMessageDeflate.h>
+
+namespace WebSocket {
+
+// https://datatracker.ietf.org/doc/html/rfc7692#section-7.2.1
+static constexpr Array<u8, 4> s_sync_flush_trailer { 0x00, 0x00, 0xff, 0xff };
+
+ErrorOr<Optional<PerMessageDeflate::Parameters>> PerMessageDeflate::parse_response(StringView extension)
+{
+    auto parts = extension.split_view(';');
+    if (parts.is_empty() || !parts[0].trim_whitespace().equals_ignoring_ascii_case(offer))
+        return OptionalNone {};
+
+    Parameters parameters;
+    bool has_server_max_window_bits = false;
+
+    // https://datatracker.ietf.org/doc/html/rfc7692#section-7.1
+    for (auto part : parts.span().slice(1)) {
+        auto name = part;
+        StringView value;
+        if (auto equals = part.find('='); equals.has_value()) {
+            name = part.substring_view(0, *equals);
+            value = part.substring_view(*equals + 1).trim_whitespace();
+            if (value.length() >= 2 && value.starts_with('"') && value.ends_with('"'))
+                value = value.substring_view(1, value.length() - 2);
+        }
+        name = name.trim_whitespace();
+
+        auto set_flag = [&](bool& flag) -> ErrorOr<void> {
+            if (flag || !value.is_empty())
+                return Error::from_string_literal("Invalid permessage-deflate parameter");
+            flag = true;
+            return {};
+        };
+
+        if (name.equals_ignoring_ascii_case("server_no_context_takeover"sv)) {
+            TRY(set_flag(parameters.server_no_context_takeover));
+        } else if (name.equals_ignoring_ascii_case("client_no_context_takeover"sv)) {
+            TRY(set_flag(parameters.client_no_context_takeover));
+        } else if (name.equals_ignoring_ascii_case("server_max_window_bits"sv)) {
+            // We inflate with the largest window there is, which can decode whatever the server compresses with.
+            auto bits = value.to_number<u8>();
+            if (has_server_max_window_bits || !bits.has_value() || *bits < 8 || *bits > 15)
+                return Error::from_string_literal("Invalid permessage-deflate server_max_window_bits");
+            has_server_max_window_bits = true;
+        } else {
+            // NB: This includes client_max_window_bits, which the server may only send if we offered it.
+            return Error::from_string_literal("Unexpected permessage-deflate parameter");
+        }
+    }
+
+    return parameters;
+}
+
+ErrorOr<NonnullOwnPtr<PerMessageDeflate>> PerMessageDeflate::create(Parameters parameters)
+{
+    auto extension = adopt_own(*new PerMessageDeflate(parameters));
+    TRY(extension->reset_compressor());
+    TRY(extension->reset_decompressor());
+    return extension;
+}
+
+PerMessageDeflate::PerMessageDeflate(Parameters parameters)
+    : m_parameters(parameters)
+{
+}
+
+PerMessageDeflate::~PerMessageDeflate() = default;
+
+ErrorOr<void> PerMessageDeflate::reset_compressor()
+{
+    m_compressor.clear();
+    TRY(m_compressed_output.discard(m_compressed_output.used_buffer_size()));
+    m_compressor = TRY(Compress::DeflateCompressor::create(MaybeOwned<Stream>(m_compressed_output)));
+    return {};
+}
+
+ErrorOr<void> PerMessageDeflate::reset_decompressor()
+{
+    m_decompressor.clear();
+    TRY(m_decompressor_input.discard(m_decompressor_input.used_buffer_size()));
+    m_decompressor = TRY(Compress::DeflateDecompressor::create(MaybeOwned<Stream>(m_decompressor_input)));
+    return {};
+}
+
+// https://datatracker.ietf.org/doc/html/rfc7692#section-7.2.1
+ErrorOr<ByteBuffer> PerMessageDeflate::compress_message(ReadonlyBytes payload)
+{
+    // 1. Compress all the octets of the payload of the message using DEFLATE.
+    TRY(m_compressor->write_until_depleted(payload));
+
+    // 2. If the resulting data does not end with an empty DEFLATE block with no compression (the "BTYPE" bits are set
+    //    to 00), append an empty DEFLATE block with no compression to the tail end.
+    TRY(m_compressor->flush());
+
+    // 3. Remove 4 octets (that are 0x00 0x00 0xff 0xff) from the tail end.
+    auto compressed = TRY(m_compressed_output.read_until_eof());
+    VERIFY(compressed.bytes().ends_with(s_sync_flush_trailer.span()));
+    compressed.trim(compressed.size() - s_sync_flush_trailer.size(), false);
+
+    if (m_parameters.client_no_context_takeover)
+        TRY(reset_compressor());
+
+    return compressed;
+}
+
+// https://datatracker.ietf.org/doc/html/rfc7692#section-7.2.2
+ErrorOr<ByteBuffer> PerMessageDeflate::decompress_message(ReadonlyBytes payload)
+{
+    // 1. Append 4 octets of 0x00 0x00 0xff 0xff to the tail end of the payload of the message.
+    TRY(m_decompressor_input.write_until_depleted(payload));
+    TRY(m_decompressor_input.write_until_depleted(s_sync_flush_trailer.span()));
+
+    // 2. Decompress the resulting data using DEFLATE.
+    auto message = TRY(m_decompressor->decompress_available());
+
+    if (m_parameters.server_no_context_takeover)
+        TRY(reset_decompressor());
+
+    return message;
+}
+
+}
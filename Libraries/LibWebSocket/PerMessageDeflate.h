@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/ByteBuffer.h>
+#include <AK/MemoryStream.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/StringView.h>
+#include <LibCompress/Deflate.h>
+
+namespace WebSocket {
+
+// The permessage-deflate extension, which compresses each message with raw deflate. Unless either side asks not to,
+// both directions keep one deflate stream going across messages, so later messages can refer back to earlier ones.
+// https://datatracker.ietf.org/doc/html/rfc7692
+class PerMessageDeflate {
+public:
+    // What we put in Sec-WebSocket-Extensions. We don't offer client_max_window_bits, so the server can't restrict our
+    // window, and we accept whatever window the server picks for its own messages.
+    static constexpr StringView offer = "permessage-deflate"sv;
+
+    struct Parameters {
+        bool server_no_context_takeover { false };
+        bool client_no_context_takeover { false };
+    };
+
+    // Parses one extension from the server's Sec-WebSocket-Extensions. Returns an empty Optional if it's some other
+    // extension, and an error if it's permessage-deflate with parameters it must not have in response to our offer.
+    static ErrorOr<Optional<Parameters>> parse_response(StringView extension);
+
+    static ErrorOr<NonnullOwnPtr<PerMessageDeflate>> create(Parameters);
+    ~PerMessageDeflate();
+
+    ErrorOr<ByteBuffer> compress_message(ReadonlyBytes);
+    ErrorOr<ByteBuffer> decompress_message(ReadonlyBytes);
+
+private:
+    explicit PerMessageDeflate(Parameters);
+
+    ErrorOr<void> reset_compressor();
+    ErrorOr<void> reset_decompressor();
+
+    Parameters m_parameters;
+
+    AllocatingMemoryStream m_compressed_output;
+    OwnPtr<Compress::DeflateCompressor> m_compressor;
+
+    AllocatingMemoryStream m_decompressor_input;
+    OwnPtr<Compress::DeflateDecompressor> m_decompressor;
+};
+
+}
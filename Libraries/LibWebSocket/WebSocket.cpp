@@ -17,9 +17,37 @@ namespace WebSocket {
 
 static constexpr int s_closing_handshake_timeout_ms = 30'000;
 
+// Section 5.2: The reserved bits in the first byte of a frame, which extensions may give a meaning to
+static constexpr u8 s_rsv1_bit = 0x40;
+static constexpr u8 s_rsv2_and_rsv3_bits = 0x30;
+
 // Note : The websocket protocol is defined by RFC 6455, found at https://tools.ietf.org/html/rfc6455
 // In this file, section numbers will refer to the RFC 6455
 
+// Section 5.3: XORs every byte with the matching byte of the masking key. Masking is an involution, so this both masks
+// and unmasks, and input and output may be the same buffer.
+static void apply_mask(ReadonlyBytes input, Bytes output, u8 const (&masking_key)[4])
+{
+    VERIFY(output.size() >= input.size());
+
+    // Going eight bytes at a time lets the compiler vectorize this loop, which matters for large messages.
+    u8 repeated_key[8];
+    for (size_t i = 0; i < sizeof(repeated_key); ++i)
+        repeated_key[i] = masking_key[i % 4];
+    u64 wide_key;
+    __builtin_memcpy(&wide_key, repeated_key, sizeof(wide_key));
+
+    size_t i = 0;
+    for (; i + sizeof(u64) <= input.size(); i += sizeof(u64)) {
+        u64 word;
+        __builtin_memcpy(&word, input.offset_pointer(i), sizeof(word));
+        word ^= wide_key;
+        __builtin_memcpy(output.offset_pointer(i), &word, sizeof(word));
+    }
+    for (; i < input.size(); ++i)
+        output[i] = input[i] ^ masking_key[i % 4];
+}
+
 NonnullRefPtr<WebSocket> WebSocket::create(ConnectionInfo connection, RefPtr<WebSocketImpl> impl)
 {
     return adopt_ref(*new WebSocket(move(connection), move(impl)));
@@ -38,6 +66,10 @@ void WebSocket::start()
     if (!m_impl)
         m_impl = adopt_ref(*new WebSocketImplSerenity);
 
+    // Offer compression, unless the caller asked for extensions of its own.
+    if (m_connection.extensions().is_empty())
+        m_connection.set_extensions({ PerMessageDeflate::offer });
+
     m_impl->on_connection_error = [this] {
         if (m_state == InternalState::Closing) {
             // If the connection drops while we are waiting for the server's close frame, check if we actually received
@@ -56,6 +88,12 @@ void WebSocket::start()
         if (m_state != WebSocket::InternalState::EstablishingProtocolConnection)
             return;
         if (m_impl->handshake_complete_when_connected()) {
+            if (auto extensions = m_impl->handshake_response_header("Sec-WebSocket-Extensions"sv); extensions.has_value()) {
+                if (auto result = negotiate_extensions(*extensions); result.is_error()) {
+                    fail_connection(to_underlying(CloseStatusCode::MissingExtension), WebSocket::Error::ConnectionUpgradeFailed, ByteString::formatted("Server HTTP Handshake Header |Sec-WebSocket-Extensions| is unacceptable: {}", result.error()));
+                    return;
+                }
+            }
             set_state(WebSocket::InternalState::Open);
             notify_open();
         } else {
@@ -102,10 +140,15 @@ void WebSocket::send(Message const& message)
     // Calling send on a socket that is not opened is not allowed
     VERIFY(m_state == WebSocket::InternalState::Open);
     VERIFY(m_impl);
-    if (message.is_text())
-        send_frame(WebSocket::OpCode::Text, message.data(), true);
-    else
-        send_frame(WebSocket::OpCode::Binary, message.data(), true);
+    auto op_code = message.is_text() ? WebSocket::OpCode::Text : WebSocket::OpCode::Binary;
+
+    if (m_per_message_deflate) {
+        auto compressed = m_per_message_deflate->compress_message(message.data()).release_value_but_fixme_should_propagate_errors(); // FIXME: Handle possible OOM situation.
+        send_frame(op_code, compressed, true, true);
+        return;
+    }
+
+    send_frame(op_code, message.data(), true);
 }
 
 void WebSocket::close(u16 code, ByteString const& message)
@@ -184,7 +227,11 @@ void WebSocket::drain_read()
         do {
             if (auto maybe_error = read_frame(); maybe_error.is_error())
                 break;
-        } while (!m_buffered_data.is_empty());
+        } while (m_buffered_data_offset < m_buffered_data.size());
+
+        // Drop the frames we've parsed, keeping any partial frame at the end for the next read.
+        m_buffered_data.remove(0, m_buffered_data_offset);
+        m_buffered_data_offset = 0;
     } break;
     case InternalState::Closed:
     case InternalState::Errored: {
@@ -384,19 +431,10 @@ void WebSocket::read_server_handshake()
 
         if (header_name.equals_ignoring_ascii_case("Sec-WebSocket-Extensions"sv)) {
             // 5. |Sec-WebSocket-Extensions| should not contain an extension that doesn't appear in m_connection->extensions()
-            auto server_extensions = parts[1].split(',');
-            for (auto const& extension : server_extensions) {
-                auto trimmed_extension = extension.trim_whitespace();
-                bool found_extension = false;
-                for (auto const& supported_extension : m_connection.extensions()) {
-                    if (trimmed_extension.equals_ignoring_ascii_case(supported_extension)) {
-                        found_extension = true;
-                    }
-                }
-                if (!found_extension) {
-                    fail_opening_handshake(ByteString::formatted("Server HTTP Handshake Header |Sec-WebSocket-Extensions| contains '{}', which is not supported by the client. Failing connection.", trimmed_extension));
-                    return;
-                }
+            auto server_extensions = line.substring_view(line.find(':').value() + 1);
+            if (auto result = negotiate_extensions(server_extensions); result.is_error()) {
+                fail_opening_handshake(ByteString::formatted("Server HTTP Handshake Header |Sec-WebSocket-Extensions| is unacceptable: {}. Failing connection.", result.error()), CloseStatusCode::MissingExtension);
+                return;
             }
             continue;
         }
@@ -423,13 +461,38 @@ void WebSocket::read_server_handshake()
     // If needed, we will keep reading the header on the next drain_read call
 }
 
+ErrorOr<void> WebSocket::negotiate_extensions(StringView server_extensions)
+{
+    for (auto extension : server_extensions.split_view(',')) {
+        auto trimmed_extension = extension.trim_whitespace();
+
+        auto deflate_parameters = TRY(PerMessageDeflate::parse_response(trimmed_extension));
+        if (deflate_parameters.has_value()) {
+            if (m_per_message_deflate || !m_connection.extensions().contains_slow(PerMessageDeflate::offer))
+                return AK::Error::from_string_literal("Unexpected permessage-deflate");
+            m_per_message_deflate = TRY(PerMessageDeflate::create(*deflate_parameters));
+            continue;
+        }
+
+        bool found_extension = false;
+        for (auto const& supported_extension : m_connection.extensions()) {
+            if (trimmed_extension.equals_ignoring_ascii_case(supported_extension)) {
+                found_extension = true;
+            }
+        }
+        if (!found_extension)
+            return AK::Error::from_string_literal("Contains an extension that is not supported by the client");
+    }
+    return {};
+}
+
 ErrorOr<void> WebSocket::read_frame()
 {
     VERIFY(m_impl);
     VERIFY(m_state == WebSocket::InternalState::Open || m_state == WebSocket::InternalState::Closing);
 
-    size_t cursor = 0;
-    auto get_buffered_bytes = [&](size_t count) -> ReadonlyBytes {
+    size_t cursor = m_buffered_data_offset;
+    auto get_buffered_bytes = [&](size_t count) -> Bytes {
         if (cursor + count > m_buffered_data.size())
             return {};
         auto bytes = m_buffered_data.span().slice(cursor, count);
@@ -439,6 +502,10 @@ ErrorOr<void> WebSocket::read_frame()
 
     auto head_bytes = get_buffered_bytes(2);
     if (head_bytes.is_null() || head_bytes.is_empty()) {
+        // Only part of the frame header has arrived so far.
+        if (m_buffered_data_offset < m_buffered_data.size())
+            return AK::Error::from_errno(EAGAIN);
+
         // The connection got closed.
         set_state(WebSocket::InternalState::Closed);
         notify_close(m_last_close_code, m_last_close_message, true);
@@ -448,6 +515,7 @@ ErrorOr<void> WebSocket::read_frame()
 
     auto op_code = (WebSocket::OpCode)(head_bytes[0] & 0x0f);
     bool is_final_frame = head_bytes[0] & 0x80;
+    bool is_compressed = head_bytes[0] & s_rsv1_bit;
     bool is_masked = head_bytes[1] & 0x80;
 
     // Parse the payload length.
@@ -496,30 +564,24 @@ ErrorOr<void> WebSocket::read_frame()
         masking_key[3] = masking_key_data[3];
     }
 
-    auto payload = ByteBuffer::create_uninitialized(payload_length).release_value_but_fixme_should_propagate_errors(); // FIXME: Handle possible OOM situation.
-    u64 read_length = 0;
-    while (read_length < payload_length) {
-        auto payload_part = get_buffered_bytes(payload_length - read_length);
-        if (payload_part.is_null())
-            return AK::Error::from_errno(EAGAIN);
-        // We read at most "actual_length - read" bytes, so this is safe to do.
-        payload.overwrite(read_length, payload_part.data(), payload_part.size());
-        read_length += payload_part.size();
-    }
-
-    if (cursor == m_buffered_data.size()) {
-        m_buffered_data.clear();
-    } else {
-        Vector<u8> new_buffered_data;
-        new_buffered_data.append(m_buffered_data.data() + cursor, m_buffered_data.size() - cursor);
-        m_buffered_data = move(new_buffered_data);
-    }
+    // The payload is used straight from the read buffer, which stays put until drain_read() is done with all frames.
+    auto payload = get_buffered_bytes(payload_length);
+    if (payload.is_null() && payload_length != 0)
+        return AK::Error::from_errno(EAGAIN);
+    m_buffered_data_offset = cursor;
 
     if (is_masked) {
         // Unmask the payload
-        for (size_t i = 0; i < payload.size(); ++i) {
-            payload[i] = payload[i] ^ (masking_key[i % 4]);
-        }
+        apply_mask(payload, payload, masking_key);
+    }
+
+    // Section 5.2: The reserved bits must be 0 unless an extension that was negotiated defines them. permessage-deflate
+    // uses RSV1 to mark the first frame of a compressed message.
+    // https://datatracker.ietf.org/doc/html/rfc7692#section-6
+    bool may_be_compressed = m_per_message_deflate && (op_code == WebSocket::OpCode::Text || op_code == WebSocket::OpCode::Binary);
+    if ((head_bytes[0] & s_rsv2_and_rsv3_bits) || (is_compressed && !may_be_compressed)) {
+        fail_connection(to_underlying(CloseStatusCode::ProtocolError), WebSocket::Error::ServerClosedSocket, "Received a frame with unexpected reserved bits set");
+        return AK::Error::from_errno(EPROTO);
     }
 
     if (op_code == WebSocket::OpCode::ConnectionClose) {
@@ -546,40 +608,53 @@ ErrorOr<void> WebSocket::read_frame()
         if (op_code != WebSocket::OpCode::Continuation) {
             // First fragmented message
             m_initial_fragment_opcode = op_code;
+            m_fragmented_message_is_compressed = is_compressed;
         }
         // First and next fragmented message
         m_fragmented_data_buffer.append(payload.data(), payload_length);
         return {};
     }
-    if (is_final_frame && op_code == WebSocket::OpCode::Continuation) {
+
+    ByteBuffer message_data;
+    if (op_code == WebSocket::OpCode::Continuation) {
         // Last fragmented message
         m_fragmented_data_buffer.append(payload.data(), payload_length);
         op_code = m_initial_fragment_opcode;
-        payload.clear();
-        payload.append(m_fragmented_data_buffer.data(), m_fragmented_data_buffer.size());
-        m_fragmented_data_buffer.clear();
+        is_compressed = m_fragmented_message_is_compressed;
+        message_data = move(m_fragmented_data_buffer);
+        m_fragmented_data_buffer = {};
     }
-    if (op_code == WebSocket::OpCode::Text) {
-        notify_message(Message(move(payload), true));
+    if (op_code != WebSocket::OpCode::Text && op_code != WebSocket::OpCode::Binary) {
+        dbgln("Websocket: Found unknown opcode {}", (u8)op_code);
         return {};
     }
-    if (op_code == WebSocket::OpCode::Binary) {
-        notify_message(Message(move(payload), false));
-        return {};
+
+    auto message_bytes = message_data.is_empty() ? ReadonlyBytes { payload } : message_data.bytes();
+    if (is_compressed) {
+        auto decompressed = m_per_message_deflate->decompress_message(message_bytes);
+        if (decompressed.is_error()) {
+            fail_connection(to_underlying(CloseStatusCode::InvalidPayload), WebSocket::Error::ServerClosedSocket, ByteString::formatted("Failed to decompress message: {}", decompressed.error()));
+            return decompressed.release_error();
+        }
+        message_data = decompressed.release_value();
+    } else if (message_data.is_empty()) {
+        message_data = ByteBuffer::copy(payload).release_value_but_fixme_should_propagate_errors(); // FIXME: Handle possible OOM situation.
     }
-    dbgln("Websocket: Found unknown opcode {}", (u8)op_code);
+
+    notify_message(Message(move(message_data), op_code == WebSocket::OpCode::Text));
     return {};
 }
 
-void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, bool is_final)
+void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, bool is_final, bool is_compressed)
 {
     VERIFY(m_impl);
     VERIFY(m_state == WebSocket::InternalState::Open);
 
+    // The header and the masked payload go out in a single buffer, so each frame is one write to the connection.
     ByteBuffer buf = MUST(ByteBuffer::create_uninitialized(1 + 9 + 4 + payload.size()));
     size_t offset = 0;
 
-    u8 frame_head[1] = { (u8)((is_final ? 0x80 : 0x00) | ((u8)(op_code) & 0xf)) };
+    u8 frame_head[1] = { (u8)((is_final ? 0x80 : 0x00) | (is_compressed ? s_rsv1_bit : 0x00) | ((u8)(op_code) & 0xf)) };
     buf.overwrite(offset, frame_head, 1);
     offset += 1;
     // Section 5.1 : a client MUST mask all frames that it sends to the server
@@ -644,10 +719,7 @@ void WebSocket::send_frame(WebSocket::OpCode op_code, ReadonlyBytes payload, boo
         buf.overwrite(offset, masking_key, 4);
         offset += 4;
         // Mask the payload
-        auto masked_payload = buf.span().slice(offset, payload.size());
-        for (size_t i = 0; i < payload.size(); ++i) {
-            masked_payload[i] = payload[i] ^ (masking_key[i % 4]);
-        }
+        apply_mask(payload, buf.span().slice(offset, payload.size()), masking_key);
         offset += payload.size();
     } else if (payload.size() > 0) {
         buf.overwrite(offset, payload.data(), payload.size());
@@ -7,12 +7,14 @@
 
 #pragma once
 
+#include <AK/OwnPtr.h>
 #include <AK/Span.h>
 #include <LibCore/EventReceiver.h>
 #include <LibCore/Forward.h>
 #include <LibWebSocket/ConnectionInfo.h>
 #include <LibWebSocket/Impl/WebSocketImpl.h>
 #include <LibWebSocket/Message.h>
+#include <LibWebSocket/PerMessageDeflate.h>
 
 namespace WebSocket {
 
@@ -92,7 +94,9 @@ private:
     void read_server_handshake();
 
     ErrorOr<void> read_frame();
-    void send_frame(OpCode, ReadonlyBytes, bool is_final);
+    void send_frame(OpCode, ReadonlyBytes, bool is_final, bool is_compressed = false);
+
+    ErrorOr<void> negotiate_extensions(StringView server_extensions);
 
     void notify_open();
     void notify_close(u16 code, ByteString reason, bool was_clean);
@@ -135,9 +139,15 @@ private:
     RefPtr<WebSocketImpl> m_impl;
     RefPtr<Core::Timer> m_closing_handshake_timer;
 
+    // Frames are parsed in place, so bytes before the offset have been consumed but are only dropped once per read.
     Vector<u8> m_buffered_data;
+    size_t m_buffered_data_offset { 0 };
+
     ByteBuffer m_fragmented_data_buffer;
     WebSocket::OpCode m_initial_fragment_opcode;
+    bool m_fragmented_message_is_compressed { false };
+
+    OwnPtr<PerMessageDeflate> m_per_message_deflate;
 };
 
 }
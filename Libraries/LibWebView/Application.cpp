@@ -18,11 +18,13 @@
 #include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibCore/TimeZoneWatcher.h>
+#include <LibCore/TraceEvent.h>
 #include <LibDatabase/Database.h>
 #include <LibDevTools/DevToolsServer.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibImageDecoderClient/Client.h>
 #include <LibWeb/CSS/PropertyID.h>
+#include <LibWeb/Loader/ContentBlocker.h>
 #include <LibWeb/Loader/UserAgent.h>
 #include <LibWeb/Page/InputEvent.h>
 #include <LibWebView/Application.h>
@@ -32,6 +34,7 @@
 #include <LibWebView/HeadlessWebView.h>
 #include <LibWebView/HelperProcess.h>
 #include <LibWebView/HistoryStore.h>
+#include <LibWebView/MemoryPressurePolicy.h>
 #include <LibWebView/Menu.h>
 #include <LibWebView/ProcessType.h>
 #include <LibWebView/URL.h>
@@ -189,6 +192,8 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     bool disable_site_isolation = false;
     bool enable_idl_tracing = false;
     bool disable_http_memory_cache = false;
+    Optional<u64> http_memory_cache_size_in_mib;
+    Optional<u64> web_content_memory_budget_in_mib;
     bool disable_http_disk_cache = false;
     bool disable_content_blocker = false;
     bool enable_sandbox = false;
@@ -265,7 +270,9 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
     args_parser.add_option(disable_site_isolation, "Disable site isolation", "disable-site-isolation");
     args_parser.add_option(enable_idl_tracing, "Enable IDL tracing", "enable-idl-tracing");
     args_parser.add_option(disable_http_memory_cache, "Disable HTTP memory cache", "disable-http-memory-cache");
+    args_parser.add_option(http_memory_cache_size_in_mib, "Maximum size of the HTTP memory cache of each WebContent process, in MiB", "http-memory-cache-size", 0, "MiB");
     args_parser.add_option(disable_http_disk_cache, "Disable HTTP disk cache", "disable-http-disk-cache");
+    args_parser.add_option(web_content_memory_budget_in_mib, "Discard background tabs once all WebContent processes together use more memory than this, in MiB", "web-content-memory-budget", 0, "MiB");
     args_parser.add_option(disable_content_blocker, "Disable content blocker", "disable-content-blocker");
     args_parser.add_option(enable_sandbox, "Enable helper process sandboxing", "enable-sandbox");
     args_parser.add_option(Core::ArgsParser::Option {
@@ -390,6 +397,7 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
                           : DNSSettings(DNSOverUDP(dns_server_address.release_value(), *dns_server_port, validate_dnssec_locally)) }
                 : OptionalNone()),
         .devtools_port = devtools_port,
+        .web_content_memory_budget_in_mib = web_content_memory_budget_in_mib,
         .enable_content_blocker = disable_content_blocker ? EnableContentBlocker::No : EnableContentBlocker::Yes,
         .enable_sandbox = enable_sandbox ? EnableSandbox::Yes : EnableSandbox::No,
         .content_blocker_list_paths = move(content_blocker_list_paths_as_byte_strings),
@@ -426,6 +434,7 @@ ErrorOr<void> Application::initialize(Main::Arguments const& arguments)
         .disable_site_isolation = disable_site_isolation ? DisableSiteIsolation::Yes : DisableSiteIsolation::No,
         .enable_idl_tracing = enable_idl_tracing ? EnableIDLTracing::Yes : EnableIDLTracing::No,
         .enable_http_memory_cache = disable_http_memory_cache ? EnableMemoryHTTPCache::No : EnableMemoryHTTPCache::Yes,
+        .http_memory_cache_size_in_mib = http_memory_cache_size_in_mib,
         .expose_experimental_interfaces = expose_experimental_interfaces ? ExposeExperimentalInterfaces::Yes : ExposeExperimentalInterfaces::No,
         .expose_internals_object = expose_internals_object ? ExposeInternalsObject::Yes : ExposeInternalsObject::No,
         .force_cpu_painting = force_cpu_painting ? ForceCPUPainting::Yes : ForceCPUPainting::No,
@@ -492,7 +501,13 @@ ErrorOr<void> Application::load_content_blocker_lists()
     }
     VERIFY(offset == bytes.size());
 
-    m_content_blocker_list_buffer = move(blocker_list_buffer);
+    // OPTIMIZATION: Parse the lists once here rather than in every WebContent process. They all map the same compiled
+    //               engine and load it without parsing a single rule.
+    auto compiled_rules = TRY(Web::ContentBlocker::compile_rules(bytes));
+    auto compiled_rules_buffer = TRY(Core::AnonymousBuffer::create_with_size(compiled_rules.size()));
+    compiled_rules.bytes().copy_to({ compiled_rules_buffer.data<u8>(), compiled_rules_buffer.size() });
+
+    m_content_blocker_list_buffer = move(compiled_rules_buffer);
 
     return {};
 }
@@ -528,6 +543,13 @@ ErrorOr<NonnullRefPtr<WebContentClient>> Application::create_web_content_client(
     client->async_connect_to_image_decoder(move(image_decoder_handle));
     TRY(Application::the().connect_web_content_to_compositor(*client));
 
+    // Processes launched while a trace is being recorded join it, so that e.g. a trace of a cross-site navigation
+    // includes the process the navigation ended up in.
+    if (is_tracing()) {
+        m_trace_event_buffers.append(Core::create_trace_event_buffer());
+        client->async_set_trace_event_buffer(m_trace_event_buffers.last());
+    }
+
     return client;
 }
 
@@ -664,6 +686,81 @@ void Application::notify_compositor_presented_bitmap_ready_to_paint(Web::Composi
     m_compositor_client->async_presented_bitmap_ready_to_paint(context_id, bitmap_id);
 }
 
+void Application::start_tracing()
+{
+    if (is_tracing())
+        return;
+
+    // Each process gets a buffer of its own, so that they never contend with one another over where to write.
+    auto create_trace_event_buffer = [&]() {
+        m_trace_event_buffers.append(Core::create_trace_event_buffer());
+        return m_trace_event_buffers.last();
+    };
+
+    Core::set_trace_event_buffer(create_trace_event_buffer());
+
+    WebContentClient::for_each_client([&](WebContentClient& client) {
+        client.async_set_trace_event_buffer(create_trace_event_buffer());
+        return IterationDecision::Continue;
+    });
+
+    if (m_request_server_client)
+        m_request_server_client->async_set_trace_event_buffer(create_trace_event_buffer());
+    if (can_send_compositor_process_ipc(m_compositor_client))
+        m_compositor_client->async_set_trace_event_buffer(create_trace_event_buffer());
+}
+
+JsonObject Application::stop_tracing()
+{
+    for (auto& trace_event_buffer : m_trace_event_buffers)
+        Core::disable_trace_event_buffer(trace_event_buffer);
+
+    auto trace_event_buffers = move(m_trace_event_buffers);
+    auto browser_pid = Core::System::getpid();
+
+    // https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU
+    JsonArray trace_events;
+    for (auto const& trace_event_buffer : trace_event_buffers) {
+        // A process that never got around to adopting its buffer has no events in it.
+        auto pid = Core::trace_event_buffer_pid(trace_event_buffer);
+        if (!pid.has_value())
+            continue;
+
+        auto process_name = "Browser"sv;
+        if (*pid != browser_pid) {
+            if (auto process = find_process(*pid); process.has_value())
+                process_name = process_name_from_type(process->type());
+        }
+
+        JsonObject process_name_arguments;
+        process_name_arguments.set("name"sv, MUST(String::formatted("{} ({})", process_name, *pid)));
+
+        JsonObject process_name_event;
+        process_name_event.set("name"sv, "process_name"sv);
+        process_name_event.set("ph"sv, "M"sv);
+        process_name_event.set("pid"sv, *pid);
+        process_name_event.set("args"sv, move(process_name_arguments));
+        trace_events.must_append(move(process_name_event));
+
+        Core::for_each_trace_event(trace_event_buffer, [&](Core::TraceEvent const& event) {
+            JsonObject trace_event;
+            trace_event.set("name"sv, event.name);
+            trace_event.set("cat"sv, event.category);
+            trace_event.set("ph"sv, "X"sv);
+            trace_event.set("ts"sv, static_cast<double>(event.start_time_in_nanoseconds) / 1000.0);
+            trace_event.set("dur"sv, static_cast<double>(event.duration_in_nanoseconds) / 1000.0);
+            trace_event.set("pid"sv, *pid);
+            trace_event.set("tid"sv, event.thread_id);
+            trace_events.must_append(move(trace_event));
+        });
+    }
+
+    JsonObject trace;
+    trace.set("traceEvents"sv, move(trace_events));
+    trace.set("displayTimeUnit"sv, "ms"sv);
+    return trace;
+}
+
 void Application::crash_compositor_process()
 {
     if (!can_send_compositor_process_ipc(m_compositor_client)) {
@@ -675,21 +772,29 @@ void Application::crash_compositor_process()
     m_compositor_client->async_crash();
 }
 
+// Opening a tab in the background often comes right before navigating the current one to another site, so keep
+// enough spare processes around that neither has to wait for a process to launch.
+static constexpr size_t spare_web_content_process_pool_size = 2;
+
 ErrorOr<NonnullRefPtr<WebContentClient>> Application::launch_web_content_process(ViewImplementation& view)
 {
-    if (m_spare_web_content_process) {
-        auto web_content_client = m_spare_web_content_process.release_nonnull();
-        launch_spare_web_content_process();
+    // Hand out the oldest spare process first, as it has had the most time to finish initializing.
+    while (!m_spare_web_content_processes.is_empty()) {
+        auto web_content_client = m_spare_web_content_processes.take_first();
+        if (!web_content_client->is_open())
+            continue;
+
+        launch_spare_web_content_processes();
 
         web_content_client->assign_view({}, view);
         return web_content_client;
     }
 
-    launch_spare_web_content_process();
+    launch_spare_web_content_processes();
     return create_web_content_client(view, allocate_page_id());
 }
 
-void Application::launch_spare_web_content_process()
+void Application::launch_spare_web_content_processes()
 {
     // Spare WebContent processes inherit the active WebDriver endpoint, but they are not part of the
     // session and can race browser shutdown while bootstrapping.
@@ -703,12 +808,16 @@ void Application::launch_spare_web_content_process()
     if (browser_options().profile_helper_process == ProcessType::WebContent)
         return;
 
-    if (m_has_queued_task_to_launch_spare_web_content_process)
+    if (m_spare_web_content_processes.size() >= spare_web_content_process_pool_size)
         return;
-    m_has_queued_task_to_launch_spare_web_content_process = true;
 
+    if (m_has_queued_task_to_launch_spare_web_content_processes)
+        return;
+    m_has_queued_task_to_launch_spare_web_content_processes = true;
+
+    // NB: Only one process is launched per task, so that refilling the pool never blocks the event loop for long.
     Core::deferred_invoke([this]() {
-        m_has_queued_task_to_launch_spare_web_content_process = false;
+        m_has_queued_task_to_launch_spare_web_content_processes = false;
 
         auto web_content_client = create_web_content_client({}, allocate_page_id());
         if (web_content_client.is_error()) {
@@ -716,10 +825,11 @@ void Application::launch_spare_web_content_process()
             return;
         }
 
-        m_spare_web_content_process = web_content_client.release_value();
-
-        if (auto process = find_process(m_spare_web_content_process->pid()); process.has_value())
+        if (auto process = find_process(web_content_client.value()->pid()); process.has_value())
             process->set_title("(spare)"_utf16);
+
+        m_spare_web_content_processes.append(web_content_client.release_value());
+        launch_spare_web_content_processes();
     });
 }
 
@@ -779,6 +889,11 @@ ErrorOr<void> Application::launch_services()
     if (m_browser_options.devtools_port.has_value())
         TRY(launch_devtools_server());
 
+    if (!m_browser_options.headless_mode.has_value()) {
+        auto budget = m_browser_options.web_content_memory_budget_in_mib.map([](u64 budget) { return budget * MiB; });
+        m_memory_pressure_policy = make<MemoryPressurePolicy>(budget);
+    }
+
     return {};
 }
 
@@ -1107,6 +1222,10 @@ void Application::process_did_exit(Process&& process, Optional<int> exit_status)
         break;
     case ProcessType::WebContent:
         if (auto client = process.client<WebContentClient>(); client.has_value()) {
+            m_spare_web_content_processes.remove_first_matching([&](auto const& spare_client) {
+                return spare_client.ptr() == &client.value();
+            });
+
 #if !defined(AK_OS_WINDOWS)
             if (exit_status.has_value() && WIFEXITED(*exit_status) && WEXITSTATUS(*exit_status) == 0 && !client->has_views())
                 break;
@@ -1244,6 +1363,7 @@ void Application::clear_browsing_data(ClearBrowsingDataOptions const& options)
     if (options.delete_site_data == ClearBrowsingDataOptions::Delete::Yes) {
         m_cookie_jar->expire_cookies_accessed_since(options.since);
         m_storage_jar->remove_items_accessed_since(options.since);
+        WebContentClient::notify_local_storage_area_changed({});
         m_hsts_store->remove_policies_observed_since(options.since);
     }
 
@@ -1556,6 +1676,7 @@ void Application::initialize_actions()
     m_debug_menu->add_action(Action::create("Dump Cookies"sv, ActionID::DumpCookies, [this]() { m_cookie_jar->dump_cookies(); }));
     m_debug_menu->add_action(Action::create("Dump Local Storage"sv, ActionID::DumpLocalStorage, debug_request("dump-local-storage"sv)));
     m_debug_menu->add_action(Action::create("Dump WASM Stats"sv, ActionID::DumpWasmStats, debug_request("dump-wasm-stats"sv)));
+    m_debug_menu->add_action(Action::create("Dump Frame Timings"sv, ActionID::DumpFrameTimings, debug_request("dump-frame-timings"sv)));
     m_debug_menu->add_action(Action::create("Dump GC graph"sv, ActionID::DumpGCGraph, [this]() {
         if (auto view = active_web_view(); view.has_value()) {
             auto gc_graph_path = view->dump_gc_graph();
@@ -2210,6 +2331,28 @@ void Application::stop_listening_for_console_messages(DevTools::TabDescription c
     view->on_console_message = nullptr;
 }
 
+void Application::start_js_profiler(DevTools::TabDescription const& description, u32 sampling_interval_in_microseconds) const
+{
+    if (auto view = ViewImplementation::find_view_by_id(description.id); view.has_value())
+        view->start_js_profiler(sampling_interval_in_microseconds);
+}
+
+void Application::stop_js_profiler(DevTools::TabDescription const& description, OnJSProfileReceived on_complete) const
+{
+    auto view = ViewImplementation::find_view_by_id(description.id);
+    if (!view.has_value()) {
+        on_complete(Error::from_string_literal("Unable to locate tab"));
+        return;
+    }
+
+    view->on_received_js_profile = [&view = *view, on_complete = move(on_complete)](JsonValue profile) {
+        view.on_received_js_profile = nullptr;
+        on_complete(move(profile));
+    };
+
+    view->stop_js_profiler();
+}
+
 void Application::listen_for_network_events(DevTools::TabDescription const& description, OnNetworkRequestStarted on_request_started, OnNetworkResponseHeadersReceived on_response_headers, OnNetworkResponseBodyReceived on_response_body, OnNetworkRequestFinished on_request_finished) const
 {
     auto view = ViewImplementation::find_view_by_id(description.id);
@@ -2224,8 +2367,8 @@ void Application::listen_for_network_events(DevTools::TabDescription const& desc
         on_response_headers({ request_id, status_code, reason_phrase, headers });
     };
 
-    view->on_network_response_body_received = [on_response_body = move(on_response_body)](u64 request_id, ByteBuffer data) {
-        on_response_body(request_id, move(data));
+    view->on_network_response_body_received = [on_response_body = move(on_response_body)](u64 request_id, ReadonlyBytes data) {
+        on_response_body(request_id, data);
     };
 
     view->on_network_request_finished = [on_request_finished = move(on_request_finished)](u64 request_id, u64 body_size, Requests::RequestTimingInfo const& timing_info, Optional<Requests::NetworkError> const& network_error) {
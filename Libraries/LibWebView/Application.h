@@ -108,6 +108,10 @@ public:
     bool dispatch_mouse_event_to_web_content(Web::Compositor::CompositorContextId, Web::MouseEvent const&);
     void notify_compositor_presented_bitmap_ready_to_paint(Web::Compositor::CompositorContextId, i32 bitmap_id);
 
+    bool is_tracing() const { return !m_trace_event_buffers.is_empty(); }
+    void start_tracing();
+    JsonObject stop_tracing();
+
     virtual Optional<ViewImplementation&> active_web_view() const { return {}; }
     virtual Optional<ViewImplementation&> open_blank_new_tab(Web::HTML::ActivateTab) const { return {}; }
     void open_url_in_new_tab(URL::URL const&, Web::HTML::ActivateTab) const;
@@ -245,7 +249,7 @@ protected:
 private:
     ErrorOr<NonnullRefPtr<WebContentClient>> create_web_content_client(Optional<ViewImplementation&>, u64 initial_page_id);
     ErrorOr<void> launch_services();
-    void launch_spare_web_content_process();
+    void launch_spare_web_content_processes();
     ErrorOr<void> launch_compositor_process();
     void handle_compositor_process_death();
     void recover_compositor_process();
@@ -308,6 +312,8 @@ private:
     virtual void evaluate_javascript(DevTools::TabDescription const&, String const&, OnScriptEvaluationComplete) const override;
     virtual void listen_for_console_messages(DevTools::TabDescription const&, OnConsoleMessage) const override;
     virtual void stop_listening_for_console_messages(DevTools::TabDescription const&) const override;
+    virtual void start_js_profiler(DevTools::TabDescription const&, u32 sampling_interval_in_microseconds) const override;
+    virtual void stop_js_profiler(DevTools::TabDescription const&, OnJSProfileReceived) const override;
     virtual void listen_for_network_events(DevTools::TabDescription const&, OnNetworkRequestStarted, OnNetworkResponseHeadersReceived, OnNetworkResponseBodyReceived, OnNetworkRequestFinished) const override;
     virtual void stop_listening_for_network_events(DevTools::TabDescription const&) const override;
     virtual void listen_for_navigation_events(DevTools::TabDescription const&, OnNavigationStarted, OnNavigationFinished) const override;
@@ -334,6 +340,7 @@ private:
     RefPtr<ImageDecoderClient::Client> m_image_decoder_client;
     RefPtr<CompositorClient> m_compositor_client;
     size_t m_compositor_restart_count { 0 };
+    Vector<Core::AnonymousBuffer> m_trace_event_buffers;
     enum class CompositorRecoveryState {
         Idle,
         Queued,
@@ -341,8 +348,8 @@ private:
     };
     CompositorRecoveryState m_compositor_recovery_state { CompositorRecoveryState::Idle };
 
-    RefPtr<WebContentClient> m_spare_web_content_process;
-    bool m_has_queued_task_to_launch_spare_web_content_process { false };
+    Vector<NonnullRefPtr<WebContentClient>> m_spare_web_content_processes;
+    bool m_has_queued_task_to_launch_spare_web_content_processes { false };
     u64 m_next_page_or_compositor_context_id { 1 };
 
     RefPtr<Database::Database> m_database;
@@ -355,6 +362,7 @@ private:
 
     Core::EventLoop* m_event_loop { nullptr };
     OwnPtr<ProcessManager> m_process_manager;
+    OwnPtr<MemoryPressurePolicy> m_memory_pressure_policy;
 
     RefPtr<Action> m_reload_action;
     RefPtr<Action> m_copy_selection_action;
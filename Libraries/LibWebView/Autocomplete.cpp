@@ -102,6 +102,20 @@ static Vector<AutocompleteSuggestion> make_history_suggestions(Vector<HistoryEnt
     return suggestions;
 }
 
+// The best history match is the likeliest next navigation, so have RequestServer resolve its host while the user is
+// still typing. RequestServer only acts on the first such hint per origin for a while, so this is cheap per keystroke.
+static void prefetch_dns_for_history_suggestions(Vector<AutocompleteSuggestion> const& history_suggestions)
+{
+    if (history_suggestions.is_empty())
+        return;
+
+    auto url = URL::Parser::basic_parse(history_suggestions.first().text);
+    if (!url.has_value() || !url->scheme().is_one_of("http"sv, "https"sv))
+        return;
+
+    Application::request_server_client().ensure_connection(*url, RequestServer::CacheLevel::ResolveOnly);
+}
+
 static Optional<AutocompleteSuggestion> search_for_query_suggestion(StringView query)
 {
     if (query.is_empty() || location_looks_like_url(query))
@@ -263,6 +277,7 @@ void Autocomplete::query_autocomplete_engine(String query, size_t max_suggestion
     auto search_suggestion = search_for_query_suggestion(trimmed_query);
 
     dbgln_if(WEBVIEW_HISTORY_DEBUG, "[History] History autocomplete suggestions for '{}': {}", trimmed_query, log_autocomplete_suggestions(m_history_suggestions));
+    prefetch_dns_for_history_suggestions(m_history_suggestions);
 
     auto immediate_suggestions = merge_suggestions(search_suggestion, literal_suggestion, m_history_suggestions, {}, m_max_suggestions);
 
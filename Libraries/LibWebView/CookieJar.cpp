@@ -50,6 +50,8 @@ ErrorOr<NonnullOwnPtr<CookieJar>> CookieJar::create(Database::Database& database
 
     statements.insert_cookie = TRY(database.prepare_statement("INSERT OR REPLACE INTO Cookies VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?);"sv));
     statements.expire_cookie = TRY(database.prepare_statement("DELETE FROM Cookies WHERE (expiry_time < ?);"sv));
+    statements.begin_transaction = TRY(database.prepare_statement("BEGIN TRANSACTION;"sv));
+    statements.commit_transaction = TRY(database.prepare_statement("COMMIT;"sv));
     statements.select_all_cookies = TRY(database.prepare_statement("SELECT * FROM Cookies;"sv));
 
     return adopt_own(*new CookieJar { PersistedStorage { database, statements } });
@@ -73,11 +75,20 @@ CookieJar::CookieJar(Optional<PersistedStorage> persisted_storage)
     m_persisted_storage->synchronization_timer = Core::Timer::create_repeating(
         static_cast<int>(DATABASE_SYNCHRONIZATION_TIMER.to_milliseconds()),
         [this]() {
+            auto& database = m_persisted_storage->database;
+            auto const& statements = m_persisted_storage->statements;
+
+            // Sites commonly set dozens of cookies per page. Writing them all in one transaction means one journal
+            // commit per synchronization, rather than one per cookie.
+            database.execute_statement(statements.begin_transaction, {});
+
             for (auto const& it : m_transient_storage.take_dirty_cookies())
                 m_persisted_storage->insert_cookie(it.value);
 
             auto now = m_transient_storage.purge_expired_cookies();
-            m_persisted_storage->database.execute_statement(m_persisted_storage->statements.expire_cookie, {}, now);
+            database.execute_statement(statements.expire_cookie, {}, now);
+
+            database.execute_statement(statements.commit_transaction, {});
         });
     m_persisted_storage->synchronization_timer->start();
 }
@@ -508,7 +519,7 @@ Vector<HTTP::Cookie::Cookie> CookieJar::get_matching_cookies(URL::URL const& url
     // 3. Let cookie-list be the set of cookies from the cookie store that meets all of the following requirements:
     Vector<HTTP::Cookie::Cookie> cookie_list;
 
-    m_transient_storage.for_each_cookie([&](HTTP::Cookie::Cookie& cookie) {
+    m_transient_storage.for_each_cookie_for_host(*retrieval_host_canonical, [&](HTTP::Cookie::Cookie& cookie) {
         if (!HTTP::Cookie::cookie_matches_url(cookie, url, *retrieval_host_canonical, source))
             return;
 
@@ -552,9 +563,21 @@ Vector<HTTP::Cookie::Cookie> CookieJar::get_matching_cookies(URL::URL const& url
 void CookieJar::TransientStorage::set_cookies(Cookies cookies)
 {
     m_cookies = move(cookies);
+    rebuild_indices();
     purge_expired_cookies();
 }
 
+void CookieJar::TransientStorage::rebuild_indices()
+{
+    m_keys_by_domain.clear();
+    m_next_expiry_time = UnixDateTime::latest();
+
+    for (auto const& [key, cookie] : m_cookies) {
+        m_keys_by_domain.ensure(key.domain).set(key);
+        m_next_expiry_time = min(m_next_expiry_time, cookie.expiry_time);
+    }
+}
+
 void CookieJar::TransientStorage::set_cookie(CookieStorageKey key, HTTP::Cookie::Cookie cookie)
 {
     auto now = UnixDateTime::now();
@@ -574,7 +597,10 @@ void CookieJar::TransientStorage::set_cookie(CookieStorageKey key, HTTP::Cookie:
         send_cookie_changed_notifications({ { CookieEntry { {}, cookie } } }, cookie_value_changed);
     }
 
-    m_cookies.set(key, cookie);
+    if (m_cookies.set(key, cookie) == AK::HashSetResult::InsertedNewEntry)
+        m_keys_by_domain.ensure(key.domain).set(key);
+    m_next_expiry_time = min(m_next_expiry_time, cookie.expiry_time);
+
     m_dirty_cookies.set(move(key), move(cookie));
 }
 
@@ -593,9 +619,26 @@ UnixDateTime CookieJar::TransientStorage::purge_expired_cookies(Optional<AK::Dur
             cookie.value.expiry_time -= *offset;
     }
 
+    if (now <= m_next_expiry_time)
+        return now;
+
     auto is_expired = [&](auto const&, auto const& cookie) { return cookie.expiry_time < now; };
+    auto removed_entries = m_cookies.take_all_matching(is_expired);
+
+    for (auto const& entry : removed_entries) {
+        auto keys = m_keys_by_domain.find(entry.key.domain);
+        VERIFY(keys != m_keys_by_domain.end());
+
+        keys->value.remove(entry.key);
+        if (keys->value.is_empty())
+            m_keys_by_domain.remove(keys);
+    }
+
+    m_next_expiry_time = UnixDateTime::latest();
+    for (auto const& [key, cookie] : m_cookies)
+        m_next_expiry_time = min(m_next_expiry_time, cookie.expiry_time);
 
-    if (auto removed_entries = m_cookies.take_all_matching(is_expired); !removed_entries.is_empty())
+    if (!removed_entries.is_empty())
         send_cookie_changed_notifications(removed_entries);
 
     return now;
@@ -8,6 +8,7 @@
 
 #include <AK/Function.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/Optional.h>
 #include <AK/String.h>
 #include <AK/StringView.h>
@@ -54,6 +55,8 @@ private:
         Database::StatementID insert_cookie { 0 };
         Database::StatementID expire_cookie { 0 };
         Database::StatementID select_all_cookies { 0 };
+        Database::StatementID begin_transaction { 0 };
+        Database::StatementID commit_transaction { 0 };
     };
 
     class WEBVIEW_API TransientStorage {
@@ -89,12 +92,43 @@ private:
             }
         }
 
+        // Visits only the cookies whose domain is the host or one of its parent domains, which are the only ones that
+        // can match a URL with that host.
+        template<typename Callback>
+        void for_each_cookie_for_host(StringView host, Callback callback)
+        {
+            auto domain = host;
+
+            while (true) {
+                if (auto keys = m_keys_by_domain.find(domain); keys != m_keys_by_domain.end()) {
+                    for (auto const& key : keys->value) {
+                        auto cookie = m_cookies.find(key);
+                        VERIFY(cookie != m_cookies.end());
+                        callback(cookie->value);
+                    }
+                }
+
+                auto parent_domain_start = domain.find('.');
+                if (!parent_domain_start.has_value())
+                    break;
+                domain = domain.substring_view(*parent_domain_start + 1);
+            }
+        }
+
     private:
         using CookieEntry = decltype(declval<Cookies>().take_all_matching(nullptr))::ValueType;
         static void send_cookie_changed_notifications(ReadonlySpan<CookieEntry>, bool inform_web_view_about_changed_domains = true);
 
+        void rebuild_indices();
+
         Cookies m_cookies;
         Cookies m_dirty_cookies;
+
+        // Every key in m_cookies, grouped by the cookie's domain.
+        HashMap<String, HashTable<CookieStorageKey>> m_keys_by_domain;
+
+        // No cookie expires before this time, so purging can skip looking at the cookies until then.
+        UnixDateTime m_next_expiry_time { UnixDateTime::latest() };
     };
 
     struct WEBVIEW_API PersistedStorage {
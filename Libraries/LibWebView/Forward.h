@@ -20,6 +20,7 @@ class CompositorClient;
 class CookieJar;
 class HistoryStore;
 class HSTSStore;
+class MemoryPressurePolicy;
 class Menu;
 class OutOfProcessWebView;
 class ProcessManager;
@@ -15,7 +15,6 @@
 
 namespace WebView {
 
-static constexpr auto DEFAULT_AUTOCOMPLETE_SUGGESTION_LIMIT = 8uz;
 static constexpr size_t MINIMUM_TITLE_AUTOCOMPLETE_QUERY_LENGTH = 3;
 
 static Optional<StringView> url_without_scheme(StringView url)
@@ -113,6 +112,25 @@ static void sort_matching_entries(Vector<HistoryEntry const*>& matches, StringVi
     });
 }
 
+// Whether every entry that matches the new query also matched the old one. This holds while the user keeps typing, as
+// long as typing doesn't enable a kind of match that the old query didn't have yet.
+static bool autocomplete_query_narrows(StringView old_title_query, StringView old_url_query, StringView title_query, StringView url_query)
+{
+    if (!url_query.is_empty()) {
+        if (old_url_query.is_empty() || !url_query.starts_with(old_url_query, CaseSensitivity::CaseInsensitive))
+            return false;
+        if (!autocomplete_url_contains_query(url_query).is_empty() && autocomplete_url_contains_query(old_url_query).is_empty())
+            return false;
+    }
+
+    if (!title_query.is_empty()) {
+        if (old_title_query.is_empty() || !title_query.starts_with(old_title_query, CaseSensitivity::CaseInsensitive))
+            return false;
+    }
+
+    return true;
+}
+
 [[maybe_unused]] static ByteString log_history_entries(Vector<HistoryEntry> const& entries)
 {
     Vector<String> suggestions;
@@ -174,45 +192,14 @@ ErrorOr<NonnullOwnPtr<HistoryStore>> HistoryStore::create(Database::Database& da
         FROM History
         WHERE url = ?;
     )#"sv));
-    statements.search_entries = TRY(database.prepare_statement(R"#(
-        SELECT url, title, visit_count, last_visited_time, COALESCE(favicon, '')
-        FROM (
-            SELECT
-                url,
-                title,
-                visit_count,
-                last_visited_time,
-                COALESCE(favicon, '') AS favicon,
-                CASE
-                    WHEN LOWER(CASE
-                        WHEN INSTR(url, '://') > 0 THEN SUBSTR(url, INSTR(url, '://') + 3)
-                        ELSE url
-                    END) LIKE 'www.%'
-                    THEN SUBSTR(CASE
-                        WHEN INSTR(url, '://') > 0 THEN SUBSTR(url, INSTR(url, '://') + 3)
-                        ELSE url
-                    END, 5)
-                    ELSE CASE
-                        WHEN INSTR(url, '://') > 0 THEN SUBSTR(url, INSTR(url, '://') + 3)
-                        ELSE url
-                    END
-                END AS searchable_url
-            FROM History
-        )
-        WHERE ((?1 != '' AND LOWER(searchable_url) LIKE LOWER(?1) || '%')
-            OR (?2 != '' AND INSTR(LOWER(searchable_url), LOWER(?2)) > 0)
-            OR (?3 != '' AND INSTR(LOWER(title), LOWER(?3)) > 0))
-        ORDER BY
-            CASE
-                WHEN ?1 != '' AND LOWER(searchable_url) = LOWER(?1) THEN 0
-                WHEN ?1 != '' AND LOWER(searchable_url) LIKE LOWER(?1) || '%' THEN 1
-                WHEN ?3 != '' AND LOWER(title) LIKE LOWER(?3) || '%' THEN 2
-                ELSE 3
-            END,
-            visit_count DESC,
-            last_visited_time DESC,
-            url ASC
-        LIMIT ?4;
+    statements.get_entries = TRY(database.prepare_statement(R"#(
+        SELECT url, title, visit_count, last_visited_time
+        FROM History;
+    )#"sv));
+    statements.get_favicon = TRY(database.prepare_statement(R"#(
+        SELECT COALESCE(favicon, '')
+        FROM History
+        WHERE url = ?;
     )#"sv));
     statements.clear_entries = TRY(database.prepare_statement("DELETE FROM History;"sv));
     statements.delete_entries_accessed_since = TRY(database.prepare_statement("DELETE FROM History WHERE last_visited_time >= ?;"sv));
@@ -445,10 +432,10 @@ void HistoryStore::remove_entries_accessed_since(UnixDateTime since)
     });
 }
 
-void HistoryStore::TransientStorage::record_visit(String const& url, Optional<String> const& title, UnixDateTime visited_at)
+void HistoryStore::record_visit_in(HashMap<String, HistoryEntry>& entries, String const& url, Optional<String> const& title, UnixDateTime visited_at)
 {
-    auto entry = m_entries.find(url);
-    if (entry == m_entries.end()) {
+    auto entry = entries.find(url);
+    if (entry == entries.end()) {
         auto new_entry = HistoryEntry {
             .url = url,
             .title = move(title),
@@ -456,7 +443,7 @@ void HistoryStore::TransientStorage::record_visit(String const& url, Optional<St
             .visit_count = 1,
             .last_visited_time = visited_at,
         };
-        m_entries.set(
+        entries.set(
             move(url),
             move(new_entry));
         return;
@@ -468,12 +455,54 @@ void HistoryStore::TransientStorage::record_visit(String const& url, Optional<St
         entry->value.title = move(title);
 }
 
+Vector<HistoryEntry> HistoryStore::autocomplete_entries_in(HashMap<String, HistoryEntry> const& all_entries, Optional<AutocompleteMatches>& last_matches, StringView title_query, StringView url_query, size_t limit)
+{
+    Vector<HistoryEntry const*> matches;
+
+    // OPTIMIZATION: Each keystroke usually only extends the previous query, in which case nothing but the previous
+    //               matches can still match.
+    if (last_matches.has_value() && autocomplete_query_narrows(last_matches->title_query, last_matches->url_query, title_query, url_query)) {
+        for (auto const* entry : last_matches->entries) {
+            if (matches_query(*entry, title_query, url_query))
+                matches.append(entry);
+        }
+    } else {
+        for (auto const& entry : all_entries) {
+            if (matches_query(entry.value, title_query, url_query))
+                matches.append(&entry.value);
+        }
+    }
+
+    sort_matching_entries(matches, title_query, url_query);
+
+    Vector<HistoryEntry> entries;
+    entries.ensure_capacity(min(limit, matches.size()));
+
+    for (size_t i = 0; i < matches.size() && i < limit; ++i)
+        entries.unchecked_append(*matches[i]);
+
+    last_matches = AutocompleteMatches {
+        .title_query = MUST(String::from_utf8(title_query)),
+        .url_query = MUST(String::from_utf8(url_query)),
+        .entries = move(matches),
+    };
+
+    return entries;
+}
+
+void HistoryStore::TransientStorage::record_visit(String const& url, Optional<String> const& title, UnixDateTime visited_at)
+{
+    m_last_autocomplete_matches.clear();
+    record_visit_in(m_entries, url, title, visited_at);
+}
+
 void HistoryStore::TransientStorage::update_title(String const& url, String const& title)
 {
     auto entry = m_entries.find(url);
     if (entry == m_entries.end())
         return;
 
+    m_last_autocomplete_matches.clear();
     entry->value.title = move(title);
 }
 
@@ -497,31 +526,18 @@ Optional<HistoryEntry> HistoryStore::TransientStorage::entry_for_url(String cons
 
 Vector<HistoryEntry> HistoryStore::TransientStorage::autocomplete_entries(StringView title_query, StringView url_query, size_t limit)
 {
-    Vector<HistoryEntry const*> matches;
-
-    for (auto const& entry : m_entries) {
-        if (matches_query(entry.value, title_query, url_query))
-            matches.append(&entry.value);
-    }
-
-    sort_matching_entries(matches, title_query, url_query);
-
-    Vector<HistoryEntry> entries;
-    entries.ensure_capacity(min(limit, matches.size()));
-
-    for (size_t i = 0; i < matches.size() && i < limit; ++i)
-        entries.unchecked_append(*matches[i]);
-
-    return entries;
+    return autocomplete_entries_in(m_entries, m_last_autocomplete_matches, title_query, url_query, limit);
 }
 
 void HistoryStore::TransientStorage::clear()
 {
+    m_last_autocomplete_matches.clear();
     m_entries.clear();
 }
 
 void HistoryStore::TransientStorage::remove_entries_accessed_since(UnixDateTime since)
 {
+    m_last_autocomplete_matches.clear();
     m_entries.remove_all_matching([&](auto const&, auto const& entry) {
         return entry.last_visited_time >= since;
     });
@@ -535,6 +551,34 @@ HistoryStore::PersistedStorage::PersistedStorage(Database::Database& database, S
 
 HistoryStore::PersistedStorage::~PersistedStorage() = default;
 
+HashMap<String, HistoryEntry>& HistoryStore::PersistedStorage::autocomplete_index()
+{
+    if (m_autocomplete_index.has_value())
+        return *m_autocomplete_index;
+
+    HashMap<String, HistoryEntry> entries;
+    m_database.execute_statement(
+        m_statements.get_entries,
+        [&](auto statement_id) {
+            auto url = m_database.result_column<String>(statement_id, 0);
+            auto title = m_database.result_column<String>(statement_id, 1);
+
+            entries.set(url,
+                HistoryEntry {
+                    .url = url,
+                    .title = title.is_empty() ? Optional<String> {} : Optional<String> { move(title) },
+                    .favicon_base64_png = {},
+                    .visit_count = m_database.result_column<u64>(statement_id, 2),
+                    .last_visited_time = m_database.result_column<UnixDateTime>(statement_id, 3),
+                });
+        });
+
+    dbgln_if(WEBVIEW_HISTORY_DEBUG, "[History] Loaded {} history entries into the autocomplete index", entries.size());
+
+    m_autocomplete_index = move(entries);
+    return *m_autocomplete_index;
+}
+
 void HistoryStore::PersistedStorage::record_visit(String const& url, Optional<String> const& title, UnixDateTime visited_at)
 {
     m_database.execute_statement(
@@ -543,6 +587,15 @@ void HistoryStore::PersistedStorage::record_visit(String const& url, Optional<St
         url,
         title.value_or(String {}),
         visited_at);
+
+    if (m_autocomplete_index.has_value()) {
+        m_last_autocomplete_matches.clear();
+        // NB: The database stores a missing title as an empty one, which it reads back as no title at all.
+        Optional<String> stored_title;
+        if (title.has_value() && !title->is_empty())
+            stored_title = *title;
+        record_visit_in(*m_autocomplete_index, url, stored_title, visited_at);
+    }
 }
 
 void HistoryStore::PersistedStorage::update_title(String const& url, String const& title)
@@ -552,6 +605,13 @@ void HistoryStore::PersistedStorage::update_title(String const& url, String cons
         {},
         title,
         url);
+
+    if (m_autocomplete_index.has_value()) {
+        if (auto entry = m_autocomplete_index->find(url); entry != m_autocomplete_index->end()) {
+            m_last_autocomplete_matches.clear();
+            entry->value.title = title;
+        }
+    }
 }
 
 void HistoryStore::PersistedStorage::update_favicon(String const& url, String const& favicon_base64_png)
@@ -588,30 +648,19 @@ Optional<HistoryEntry> HistoryStore::PersistedStorage::entry_for_url(String cons
 
 Vector<HistoryEntry> HistoryStore::PersistedStorage::autocomplete_entries(StringView title_query, StringView url_query, size_t limit)
 {
-    Vector<HistoryEntry> entries;
-    entries.ensure_capacity(min(limit, DEFAULT_AUTOCOMPLETE_SUGGESTION_LIMIT));
-    auto url_query_string = MUST(String::from_utf8(url_query));
-    auto title_query_string = MUST(String::from_utf8(title_query));
-    auto url_contains_query_string = MUST(String::from_utf8(autocomplete_url_contains_query(url_query)));
-
-    m_database.execute_statement(
-        m_statements.search_entries,
-        [&](auto statement_id) {
-            auto title = m_database.result_column<String>(statement_id, 1);
-            auto favicon = m_database.result_column<String>(statement_id, 4);
-
-            entries.append(HistoryEntry {
-                .url = m_database.result_column<String>(statement_id, 0),
-                .title = title.is_empty() ? Optional<String> {} : Optional<String> { move(title) },
-                .favicon_base64_png = favicon.is_empty() ? Optional<String> {} : Optional<String> { move(favicon) },
-                .visit_count = m_database.result_column<u64>(statement_id, 2),
-                .last_visited_time = m_database.result_column<UnixDateTime>(statement_id, 3),
-            });
-        },
-        url_query_string,
-        url_contains_query_string,
-        title_query_string,
-        static_cast<i64>(limit));
+    auto entries = autocomplete_entries_in(autocomplete_index(), m_last_autocomplete_matches, title_query, url_query, limit);
+
+    // NB: Favicons are large, so the index leaves them in the database until an entry is actually suggested.
+    for (auto& entry : entries) {
+        m_database.execute_statement(
+            m_statements.get_favicon,
+            [&](auto statement_id) {
+                auto favicon = m_database.result_column<String>(statement_id, 0);
+                if (!favicon.is_empty())
+                    entry.favicon_base64_png = move(favicon);
+            },
+            entry.url);
+    }
 
     return entries;
 }
@@ -619,11 +668,23 @@ Vector<HistoryEntry> HistoryStore::PersistedStorage::autocomplete_entries(String
 void HistoryStore::PersistedStorage::clear()
 {
     m_database.execute_statement(m_statements.clear_entries, {});
+
+    if (m_autocomplete_index.has_value()) {
+        m_last_autocomplete_matches.clear();
+        m_autocomplete_index->clear();
+    }
 }
 
 void HistoryStore::PersistedStorage::remove_entries_accessed_since(UnixDateTime since)
 {
     m_database.execute_statement(m_statements.delete_entries_accessed_since, {}, since);
+
+    if (m_autocomplete_index.has_value()) {
+        m_last_autocomplete_matches.clear();
+        m_autocomplete_index->remove_all_matching([&](auto const&, auto const& entry) {
+            return entry.last_visited_time >= since;
+        });
+    }
 }
 
 }
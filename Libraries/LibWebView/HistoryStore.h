@@ -67,11 +67,22 @@ private:
         Database::StatementID update_title { 0 };
         Database::StatementID update_favicon { 0 };
         Database::StatementID get_entry { 0 };
-        Database::StatementID search_entries { 0 };
+        Database::StatementID get_entries { 0 };
+        Database::StatementID get_favicon { 0 };
         Database::StatementID clear_entries { 0 };
         Database::StatementID delete_entries_accessed_since { 0 };
     };
 
+    // The entries that matched the last autocomplete query, in no particular order.
+    struct AutocompleteMatches {
+        String title_query;
+        String url_query;
+        Vector<HistoryEntry const*> entries;
+    };
+
+    static void record_visit_in(HashMap<String, HistoryEntry>&, String const& url, Optional<String> const& title, UnixDateTime visited_at);
+    static Vector<HistoryEntry> autocomplete_entries_in(HashMap<String, HistoryEntry> const&, Optional<AutocompleteMatches>& last_matches, StringView title_query, StringView url_query, size_t limit);
+
     class StorageImpl {
     public:
         virtual ~StorageImpl() = default;
@@ -107,6 +118,7 @@ private:
 
     private:
         HashMap<String, HistoryEntry> m_entries;
+        Optional<AutocompleteMatches> m_last_autocomplete_matches;
     };
 
     class PersistedStorage : public StorageImpl {
@@ -127,8 +139,16 @@ private:
         virtual void remove_entries_accessed_since(UnixDateTime since) override;
 
     private:
+        HashMap<String, HistoryEntry>& autocomplete_index();
+
         Database::Database& m_database;
         Statements m_statements;
+
+        // OPTIMIZATION: Evaluating the autocomplete query in SQL means a full table scan with string functions on every
+        //               row, on every keystroke. Once autocomplete is first used, the table is mirrored here without
+        //               favicons, kept up to date by every change, and searched in memory instead.
+        Optional<HashMap<String, HistoryEntry>> m_autocomplete_index;
+        Optional<AutocompleteMatches> m_last_autocomplete_matches;
     };
 
     explicit HistoryStore(NonnullOwnPtr<StorageImpl>&&, bool is_disabled = false);
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NonnullRawPtr.h>
+#include <AK/QuickSort.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/Platform/ProcessStatistics.h>
+#include <LibCore/Timer.h>
+#include <LibWebView/Application.h>
+#include <LibWebView/MemoryPressurePolicy.h>
+#include <LibWebView/ProcessManager.h>
+#include <LibWebView/ViewImplementation.h>
+#include <LibWebView/WebContentClient.h>
+
+namespace WebView {
+
+static constexpr auto MEMORY_USAGE_CHECK_INTERVAL = AK::Duration::from_seconds(5);
+
+// The system counts as low on memory once less than a tenth of it is available
+static constexpr u64 LOW_SYSTEM_MEMORY_DIVISOR = 10;
+
+MemoryPressurePolicy::MemoryPressurePolicy(Optional<u64> budget_in_bytes)
+    : m_budget_in_bytes(budget_in_bytes)
+{
+    m_timer = Core::Timer::create_repeating(
+        static_cast<int>(MEMORY_USAGE_CHECK_INTERVAL.to_milliseconds()),
+        [this]() { check_memory_usage(); });
+    m_timer->start();
+}
+
+MemoryPressurePolicy::~MemoryPressurePolicy() = default;
+
+void MemoryPressurePolicy::check_memory_usage()
+{
+    check_system_memory();
+
+    if (m_budget_in_bytes.has_value())
+        check_web_content_budget(*m_budget_in_bytes);
+}
+
+void MemoryPressurePolicy::check_system_memory()
+{
+    auto statistics = Core::Platform::system_memory_statistics();
+    if (statistics.is_error() || statistics.value().available_bytes >= statistics.value().total_bytes / LOW_SYSTEM_MEMORY_DIVISOR)
+        return;
+
+    // Freed memory the allocators hold on to for reuse still counts against the system, so hand it back while it's
+    // needed elsewhere. This is cheap compared to collecting garbage, so it's done in every process.
+    Application::process_manager().for_each_process([](Process& process) {
+        if (process.type() == ProcessType::Browser) {
+            kmalloc_release_free_memory();
+        } else if (process.type() == ProcessType::WebContent) {
+            if (auto client = process.client<WebContentClient>(); client.has_value())
+                client->async_release_free_memory();
+        }
+    });
+}
+
+void MemoryPressurePolicy::check_web_content_budget(u64 budget_in_bytes)
+{
+    auto& process_manager = Application::process_manager();
+    process_manager.update_all_process_statistics();
+
+    auto memory_usage = process_manager.total_memory_usage_bytes(ProcessType::WebContent);
+    if (memory_usage <= budget_in_bytes) {
+        m_did_purge_hidden_views = false;
+        return;
+    }
+
+    Vector<NonnullRawPtr<ViewImplementation>> hidden_views;
+    ViewImplementation::for_each_view([&](ViewImplementation& view) {
+        if (view.can_be_discarded())
+            hidden_views.append(view);
+        return IterationDecision::Continue;
+    });
+
+    // Collecting garbage is cheap for the user compared to reloading a page, so give it a chance to work first.
+    if (!m_did_purge_hidden_views) {
+        for (auto& view : hidden_views)
+            view->purge_memory();
+
+        m_did_purge_hidden_views = true;
+        return;
+    }
+
+    quick_sort(hidden_views, [](auto const& left, auto const& right) {
+        return left->last_visible_time() < right->last_visible_time();
+    });
+
+    for (auto& view : hidden_views) {
+        if (memory_usage <= budget_in_bytes)
+            break;
+
+        auto view_memory_usage = process_manager.memory_usage_bytes(view->client().pid()).value_or(0);
+        memory_usage -= min(memory_usage, view_memory_usage);
+
+        view->discard();
+    }
+
+    m_did_purge_hidden_views = false;
+}
+
+}
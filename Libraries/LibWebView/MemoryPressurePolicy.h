@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/RefPtr.h>
+#include <AK/Types.h>
+#include <LibCore/Forward.h>
+#include <LibWebView/Forward.h>
+
+namespace WebView {
+
+// Keeps the combined memory use of all WebContent processes within a budget, if one is set. Over budget, it first asks
+// the processes of hidden views to give back what they can. If that isn't enough, it discards hidden views, least
+// recently seen first, to be reloaded once they become visible again.
+//
+// Whether or not there is a budget, it asks the allocator of every WebContent process to hand its free memory back to
+// the system while the system is low on memory.
+class MemoryPressurePolicy {
+    AK_MAKE_NONCOPYABLE(MemoryPressurePolicy);
+
+public:
+    explicit MemoryPressurePolicy(Optional<u64> budget_in_bytes);
+    ~MemoryPressurePolicy();
+
+private:
+    void check_memory_usage();
+    void check_system_memory();
+    void check_web_content_budget(u64 budget_in_bytes);
+
+    Optional<u64> m_budget_in_bytes;
+    bool m_did_purge_hidden_views { false };
+    RefPtr<Core::Timer> m_timer;
+};
+
+}
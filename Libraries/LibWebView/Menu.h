@@ -103,6 +103,7 @@ enum class ActionID {
     DumpLocalStorage,
     DumpGCGraph,
     DumpWasmStats,
+    DumpFrameTimings,
     ShowLineBoxBorders,
     ShowCaretHitTestDebugOverlay,
     CollectGarbage,
@@ -97,6 +97,7 @@ struct BrowserOptions {
     Optional<ByteString> webdriver_endpoint {};
     Optional<DNSSettings> dns_settings {};
     Optional<u16> devtools_port;
+    Optional<u64> web_content_memory_budget_in_mib;
     EnableContentBlocker enable_content_blocker { EnableContentBlocker::Yes };
     EnableSandbox enable_sandbox { EnableSandbox::No };
     Vector<ByteString> content_blocker_list_paths {};
@@ -188,6 +189,7 @@ struct WebContentOptions {
     DisableSiteIsolation disable_site_isolation { DisableSiteIsolation::No };
     EnableIDLTracing enable_idl_tracing { EnableIDLTracing::No };
     EnableMemoryHTTPCache enable_http_memory_cache { EnableMemoryHTTPCache::No };
+    Optional<u64> http_memory_cache_size_in_mib {};
     ExposeExperimentalInterfaces expose_experimental_interfaces { ExposeExperimentalInterfaces::No };
     ExposeInternalsObject expose_internals_object { ExposeInternalsObject::No };
     ForceCPUPainting force_cpu_painting { ForceCPUPainting::No };
@@ -41,6 +41,22 @@ void ImageCodecPlugin::setup_client_callbacks()
 
 ImageCodecPlugin::~ImageCodecPlugin() = default;
 
+// FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
+static Web::Platform::DecodedImage to_platform_decoded_image(ImageDecoderClient::DecodedImage& result)
+{
+    Web::Platform::DecodedImage decoded_image;
+    decoded_image.is_animated = result.is_animated;
+    decoded_image.loop_count = result.loop_count;
+    decoded_image.frame_count = result.frame_count;
+    decoded_image.session_id = result.session_id;
+    decoded_image.all_durations = move(result.all_durations);
+    for (auto& frame : result.frames) {
+        decoded_image.frames.empend(move(frame.bitmap), frame.duration);
+    }
+    decoded_image.color_space = move(result.color_space);
+    return decoded_image;
+}
+
 NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::decode_image(ReadonlyBytes bytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
 {
     auto promise = Core::Promise<Web::Platform::DecodedImage>::construct();
@@ -57,18 +73,7 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::deco
     auto image_decoder_promise = m_client->decode_image(
         bytes,
         [promise](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
-            // FIXME: Remove this codec plugin and just use the ImageDecoderClient directly to avoid these copies
-            Web::Platform::DecodedImage decoded_image;
-            decoded_image.is_animated = result.is_animated;
-            decoded_image.loop_count = result.loop_count;
-            decoded_image.frame_count = result.frame_count;
-            decoded_image.session_id = result.session_id;
-            decoded_image.all_durations = move(result.all_durations);
-            for (auto& frame : result.frames) {
-                decoded_image.frames.empend(move(frame.bitmap), frame.duration);
-            }
-            decoded_image.color_space = move(result.color_space);
-            promise->resolve(move(decoded_image));
+            promise->resolve(to_platform_decoded_image(result));
             return {};
         },
         [promise](auto& error) {
@@ -78,6 +83,62 @@ NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> ImageCodecPlugin::deco
     return promise;
 }
 
+Optional<i64> ImageCodecPlugin::begin_incremental_decode(Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected)
+{
+    if (!m_client) {
+        auto error = Error::from_string_literal("ImageDecoderClient is disconnected");
+        if (on_rejected)
+            on_rejected(error);
+        return {};
+    }
+
+    auto decode_id = m_next_incremental_decode_id++;
+    auto request_id = m_client->begin_incremental_decode(
+        move(on_partial_image),
+        [this, decode_id, on_resolved = move(on_resolved)](ImageDecoderClient::DecodedImage& result) -> ErrorOr<void> {
+            m_incremental_decodes.remove(decode_id);
+            auto decoded_image = to_platform_decoded_image(result);
+            if (on_resolved)
+                return on_resolved(decoded_image);
+            return {};
+        },
+        [this, decode_id, on_rejected = move(on_rejected)](Error& error) {
+            m_incremental_decodes.remove(decode_id);
+            if (on_rejected)
+                on_rejected(error);
+        });
+
+    m_incremental_decodes.set(decode_id, IncrementalDecode { *m_client, request_id });
+    return decode_id;
+}
+
+ImageCodecPlugin::IncrementalDecode const* ImageCodecPlugin::find_live_incremental_decode(i64 decode_id) const
+{
+    auto it = m_incremental_decodes.find(decode_id);
+    if (it == m_incremental_decodes.end() || it->value.client.ptr() != m_client.ptr())
+        return nullptr;
+    return &it->value;
+}
+
+void ImageCodecPlugin::append_incremental_decode_data(i64 decode_id, ReadonlyBytes bytes)
+{
+    if (auto const* decode = find_live_incremental_decode(decode_id))
+        decode->client->append_incremental_decode_data(decode->request_id, bytes);
+}
+
+void ImageCodecPlugin::finish_incremental_decode(i64 decode_id)
+{
+    if (auto const* decode = find_live_incremental_decode(decode_id))
+        decode->client->finish_incremental_decode(decode->request_id);
+}
+
+void ImageCodecPlugin::cancel_incremental_decode(i64 decode_id)
+{
+    auto decode = m_incremental_decodes.take(decode_id);
+    if (decode.has_value())
+        decode->client->cancel_incremental_decode(decode->request_id);
+}
+
 void ImageCodecPlugin::request_animation_frames(i64 session_id, u32 start_frame_index, u32 count)
 {
     if (m_client)
@@ -20,6 +20,11 @@ public:
 
     virtual NonnullRefPtr<Core::Promise<Web::Platform::DecodedImage>> decode_image(ReadonlyBytes, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected) override;
 
+    virtual Optional<i64> begin_incremental_decode(Function<void(NonnullRefPtr<Gfx::Bitmap>)> on_partial_image, Function<ErrorOr<void>(Web::Platform::DecodedImage&)> on_resolved, Function<void(Error&)> on_rejected) override;
+    virtual void append_incremental_decode_data(i64 decode_id, ReadonlyBytes) override;
+    virtual void finish_incremental_decode(i64 decode_id) override;
+    virtual void cancel_incremental_decode(i64 decode_id) override;
+
     virtual void request_animation_frames(i64 session_id, u32 start_frame_index, u32 count) override;
     virtual void stop_animation_decode(i64 session_id) override;
 
@@ -29,6 +34,17 @@ private:
     void setup_client_callbacks();
 
     RefPtr<ImageDecoderClient::Client> m_client;
+
+    // NB: Request ids are only unique per client, so these remember which client each decode was started on, and
+    //     calls for decodes started on a client that has since died go nowhere.
+    struct IncrementalDecode {
+        NonnullRefPtr<ImageDecoderClient::Client> client;
+        i64 request_id { 0 };
+    };
+    HashMap<i64, IncrementalDecode> m_incremental_decodes;
+    i64 m_next_incremental_decode_id { 1 };
+
+    IncrementalDecode const* find_live_incremental_decode(i64 decode_id) const;
 };
 
 }
@@ -8,6 +8,7 @@
 
 #include <AK/Utf16String.h>
 #include <AK/WeakPtr.h>
+#include <AK/kmalloc.h>
 #include <LibCore/File.h>
 #include <LibCore/Process.h>
 #include <LibIPC/Connection.h>
@@ -17,6 +18,12 @@
 
 namespace WebView {
 
+// The usage of each of a process's allocator partitions, as it last reported them
+struct AllocatorStatistics {
+    KmallocPartitionStatistics general;
+    KmallocPartitionStatistics array_buffer;
+};
+
 struct ProcessOutputCapture {
     OwnPtr<Core::File> stdout_file;
     OwnPtr<Core::File> stderr_file;
@@ -41,6 +48,9 @@ public:
     Optional<Utf16String> const& title() const { return m_title; }
     void set_title(Optional<Utf16String> title) { m_title = move(title); }
 
+    Optional<AllocatorStatistics> const& allocator_statistics() const { return m_allocator_statistics; }
+    void set_allocator_statistics(AllocatorStatistics statistics) { m_allocator_statistics = statistics; }
+
     template<typename ConnectionFromClient>
     Optional<ConnectionFromClient&> client()
     {
@@ -73,6 +83,7 @@ private:
     Core::Process m_process;
     ProcessType m_type;
     Optional<Utf16String> m_title;
+    Optional<AllocatorStatistics> m_allocator_statistics;
     WeakPtr<IPC::ConnectionBase> m_connection;
     ProcessOutputCapture m_output_capture;
 };
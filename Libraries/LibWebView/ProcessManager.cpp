@@ -10,6 +10,7 @@
 #include <LibCore/EventLoop.h>
 #include <LibCore/System.h>
 #include <LibWebView/ProcessManager.h>
+#include <LibWebView/WebContentClient.h>
 #include <signal.h>
 
 namespace WebView {
@@ -156,6 +157,41 @@ void ProcessManager::update_all_process_statistics()
 {
     verify_event_loop();
     (void)update_process_statistics(m_statistics);
+
+    // Allocator statistics are only known inside each process, so WebContent processes report theirs asynchronously.
+    // They show up the next time statistics are serialized.
+    for (auto& [pid, process] : m_processes) {
+        if (process.type() == ProcessType::Browser) {
+            process.set_allocator_statistics({
+                .general = kmalloc_partition_statistics(HeapPartition::General),
+                .array_buffer = kmalloc_partition_statistics(HeapPartition::ArrayBuffer),
+            });
+        } else if (process.type() == ProcessType::WebContent) {
+            if (auto client = process.client<WebContentClient>(); client.has_value())
+                client->async_request_allocator_statistics();
+        }
+    }
+}
+
+Optional<u64> ProcessManager::memory_usage_bytes(pid_t pid) const
+{
+    for (auto const& process : m_statistics.processes) {
+        if (process->pid == pid)
+            return process->memory_usage_bytes;
+    }
+    return {};
+}
+
+u64 ProcessManager::total_memory_usage_bytes(ProcessType type) const
+{
+    u64 memory_usage = 0;
+
+    for (auto const& process : m_statistics.processes) {
+        if (auto process_handle = m_processes.get(process->pid); process_handle.has_value() && process_handle->type() == type)
+            memory_usage += process->memory_usage_bytes;
+    }
+
+    return memory_usage;
 }
 
 JsonValue ProcessManager::serialize_json()
@@ -178,6 +214,14 @@ JsonValue ProcessManager::serialize_json()
         object.set("pid"sv, process.pid);
         object.set("cpu"sv, process.cpu_percent);
         object.set("memory"sv, process.memory_usage_bytes);
+
+        if (auto const& allocator_statistics = process_handle.allocator_statistics(); allocator_statistics.has_value()) {
+            object.set("heap"sv, static_cast<u64>(allocator_statistics->general.bytes_in_use));
+            object.set("heapCommitted"sv, static_cast<u64>(allocator_statistics->general.bytes_committed));
+            object.set("arrayBuffers"sv, static_cast<u64>(allocator_statistics->array_buffer.bytes_in_use));
+            object.set("arrayBuffersCommitted"sv, static_cast<u64>(allocator_statistics->array_buffer.bytes_committed));
+        }
+
         serialized.must_append(move(object));
     });
 
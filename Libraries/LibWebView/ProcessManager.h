@@ -42,6 +42,8 @@ public:
 #endif
 
     void update_all_process_statistics();
+    Optional<u64> memory_usage_bytes(pid_t) const;
+    u64 total_memory_usage_bytes(ProcessType) const;
     JsonValue serialize_json();
 
     Function<void(Process&)> on_process_added; // test-web
@@ -62,6 +62,7 @@ static constexpr auto AUTOPLAY_KEY = "autoplay"sv;
 static constexpr auto BROWSING_DATA_KEY = "browsingData"sv;
 static constexpr auto DISK_CACHE_KEY = "diskCache"sv;
 static constexpr auto DISK_CACHE_MAXIMUM_SIZE_KEY = "maxSize"sv;
+static constexpr auto DISK_CACHE_COMPRESS_TEXT_BODIES_KEY = "compressTextBodies"sv;
 
 static constexpr auto GLOBAL_PRIVACY_CONTROL_KEY = "globalPrivacyControl"sv;
 
@@ -377,6 +378,7 @@ JsonValue Settings::serialize_json() const
 
     JsonObject disk_cache_settings;
     disk_cache_settings.set(DISK_CACHE_MAXIMUM_SIZE_KEY, m_browsing_data_settings.disk_cache_settings.maximum_size);
+    disk_cache_settings.set(DISK_CACHE_COMPRESS_TEXT_BODIES_KEY, m_browsing_data_settings.disk_cache_settings.compress_text_bodies);
 
     JsonObject browsing_data;
     browsing_data.set(DISK_CACHE_KEY, move(disk_cache_settings));
@@ -703,6 +705,8 @@ BrowsingDataSettings Settings::parse_browsing_data_settings(JsonValue const& set
     if (auto disk_cache_settings = settings.as_object().get_object(DISK_CACHE_KEY); disk_cache_settings.has_value()) {
         if (auto maximum_size = disk_cache_settings->get_integer<u64>(DISK_CACHE_MAXIMUM_SIZE_KEY); maximum_size.has_value())
             browsing_data_settings.disk_cache_settings.maximum_size = *maximum_size;
+        if (auto compress_text_bodies = disk_cache_settings->get_bool(DISK_CACHE_COMPRESS_TEXT_BODIES_KEY); compress_text_bodies.has_value())
+            browsing_data_settings.disk_cache_settings.compress_text_bodies = *compress_text_bodies;
     }
 
     return browsing_data_settings;
@@ -11,8 +11,15 @@
 
 namespace WebView {
 
-// Quota size is specified in https://storage.spec.whatwg.org/#registered-storage-endpoints
-static constexpr size_t LOCAL_STORAGE_QUOTA = 5 * MiB;
+// Quota sizes are specified in https://storage.spec.whatwg.org/#registered-storage-endpoints
+static Optional<u64> storage_endpoint_quota(StorageEndpointType storage_endpoint)
+{
+    for (auto const& endpoint : Web::StorageAPI::StorageEndpoint::registered_endpoints()) {
+        if (endpoint.identifier == storage_endpoint)
+            return endpoint.quota;
+    }
+    VERIFY_NOT_REACHED();
+}
 
 // Increment this version when needing to alter the WebStorage schema.
 static constexpr u32 WEB_STORAGE_VERSION = 2u;
@@ -59,8 +66,9 @@ ErrorOr<NonnullOwnPtr<StorageJar>> StorageJar::create(Database::Database& databa
     statements.delete_item = TRY(database.prepare_statement("DELETE FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ? AND bottle_key = ?;"sv));
     statements.delete_items_accessed_since = TRY(database.prepare_statement("DELETE FROM WebStorage WHERE last_access_time >= ?;"sv));
     statements.update_last_access_time = TRY(database.prepare_statement("UPDATE WebStorage SET last_access_time = ? WHERE storage_endpoint = ? AND storage_key = ? AND bottle_key = ?;"sv));
+    statements.update_last_access_time_for_storage_key = TRY(database.prepare_statement("UPDATE WebStorage SET last_access_time = ? WHERE storage_endpoint = ? AND storage_key = ?;"sv));
     statements.clear = TRY(database.prepare_statement("DELETE FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ?;"sv));
-    statements.get_keys = TRY(database.prepare_statement("SELECT bottle_key FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ?;"sv));
+    statements.get_items = TRY(database.prepare_statement("SELECT bottle_key, bottle_value FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ?;"sv));
     statements.calculate_size_excluding_key = TRY(database.prepare_statement("SELECT SUM(OCTET_LENGTH(bottle_key) + OCTET_LENGTH(bottle_value)) FROM WebStorage WHERE storage_endpoint = ? AND storage_key = ? AND bottle_key != ?;"sv));
     statements.estimate_storage_size_accessed_since = TRY(database.prepare_statement("SELECT SUM(OCTET_LENGTH(storage_key)) + SUM(OCTET_LENGTH(bottle_key)) + SUM(OCTET_LENGTH(bottle_value)) FROM WebStorage WHERE last_access_time >= ?;"sv));
 
@@ -142,11 +150,11 @@ void StorageJar::clear_storage_key(StorageEndpointType storage_endpoint, String
         m_transient_storage.clear(storage_endpoint, storage_key);
 }
 
-Vector<String> StorageJar::get_all_keys(StorageEndpointType storage_endpoint, String const& storage_key)
+OrderedHashMap<String, String> StorageJar::get_all_items(StorageEndpointType storage_endpoint, String const& storage_key)
 {
     if (m_persisted_storage.has_value())
-        return m_persisted_storage->get_keys(storage_endpoint, storage_key);
-    return m_transient_storage.get_keys(storage_endpoint, storage_key);
+        return m_persisted_storage->get_items(storage_endpoint, storage_key);
+    return m_transient_storage.get_items(storage_endpoint, storage_key);
 }
 
 Requests::CacheSizes StorageJar::estimate_storage_size_accessed_since(UnixDateTime since) const
@@ -170,18 +178,20 @@ StorageSetResult StorageJar::TransientStorage::set_item(StorageLocation const& k
 {
     auto old_value = get_item(key);
 
-    u64 current_size = 0;
+    if (auto quota = storage_endpoint_quota(key.storage_endpoint); quota.has_value()) {
+        u64 current_size = 0;
 
-    for (auto const& [existing_key, existing_entry] : m_storage_items) {
-        if (existing_key.storage_endpoint == key.storage_endpoint && existing_key.storage_key == key.storage_key && existing_key.bottle_key != key.bottle_key) {
-            current_size += existing_key.bottle_key.bytes().size();
-            current_size += existing_entry.value.bytes().size();
+        for (auto const& [existing_key, existing_entry] : m_storage_items) {
+            if (existing_key.storage_endpoint == key.storage_endpoint && existing_key.storage_key == key.storage_key && existing_key.bottle_key != key.bottle_key) {
+                current_size += existing_key.bottle_key.bytes().size();
+                current_size += existing_entry.value.bytes().size();
+            }
         }
-    }
 
-    auto new_size = key.bottle_key.bytes().size() + value.bytes().size();
-    if (current_size + new_size > LOCAL_STORAGE_QUOTA)
-        return StorageOperationError::QuotaExceededError;
+        auto new_size = key.bottle_key.bytes().size() + value.bytes().size();
+        if (current_size + new_size > *quota)
+            return StorageOperationError::QuotaExceededError;
+    }
 
     m_storage_items.set(key, { value, UnixDateTime::now() });
     return old_value;
@@ -211,16 +221,19 @@ void StorageJar::TransientStorage::clear(StorageEndpointType storage_endpoint, S
         m_storage_items.remove(key);
 }
 
-Vector<String> StorageJar::TransientStorage::get_keys(StorageEndpointType storage_endpoint, String const& storage_key)
+OrderedHashMap<String, String> StorageJar::TransientStorage::get_items(StorageEndpointType storage_endpoint, String const& storage_key)
 {
-    Vector<String> keys;
+    OrderedHashMap<String, String> items;
+    auto now = UnixDateTime::now();
 
-    for (auto const& [key, value] : m_storage_items) {
-        if (key.storage_endpoint == storage_endpoint && key.storage_key == storage_key)
-            keys.append(key.bottle_key);
+    for (auto& [key, entry] : m_storage_items) {
+        if (key.storage_endpoint == storage_endpoint && key.storage_key == storage_key) {
+            entry.last_access_time = now;
+            items.set(key.bottle_key, entry.value);
+        }
     }
 
-    return keys;
+    return items;
 }
 
 Requests::CacheSizes StorageJar::TransientStorage::estimate_storage_size_accessed_since(UnixDateTime since) const
@@ -268,19 +281,21 @@ StorageSetResult StorageJar::PersistedStorage::set_item(StorageLocation const& k
 {
     auto old_value = get_item(key);
 
-    size_t current_size = 0;
-    database.execute_statement(
-        statements.calculate_size_excluding_key,
-        [&](auto statement_id) {
-            current_size = database.result_column<int>(statement_id, 0);
-        },
-        to_underlying(key.storage_endpoint),
-        key.storage_key,
-        key.bottle_key);
+    if (auto quota = storage_endpoint_quota(key.storage_endpoint); quota.has_value()) {
+        size_t current_size = 0;
+        database.execute_statement(
+            statements.calculate_size_excluding_key,
+            [&](auto statement_id) {
+                current_size = database.result_column<int>(statement_id, 0);
+            },
+            to_underlying(key.storage_endpoint),
+            key.storage_key,
+            key.bottle_key);
 
-    auto new_size = key.bottle_key.bytes().size() + value.bytes().size();
-    if (current_size + new_size > LOCAL_STORAGE_QUOTA)
-        return StorageOperationError::QuotaExceededError;
+        auto new_size = key.bottle_key.bytes().size() + value.bytes().size();
+        if (current_size + new_size > *quota)
+            return StorageOperationError::QuotaExceededError;
+    }
 
     database.execute_statement(
         statements.set_item,
@@ -318,19 +333,29 @@ void StorageJar::PersistedStorage::clear(StorageEndpointType storage_endpoint, S
         storage_key);
 }
 
-Vector<String> StorageJar::PersistedStorage::get_keys(StorageEndpointType storage_endpoint, String const& storage_key)
+OrderedHashMap<String, String> StorageJar::PersistedStorage::get_items(StorageEndpointType storage_endpoint, String const& storage_key)
 {
-    Vector<String> keys;
+    OrderedHashMap<String, String> items;
 
     database.execute_statement(
-        statements.get_keys,
+        statements.get_items,
         [&](auto statement_id) {
-            keys.append(database.result_column<String>(statement_id, 0));
+            items.set(database.result_column<String>(statement_id, 0), database.result_column<String>(statement_id, 1));
         },
         to_underlying(storage_endpoint),
         storage_key);
 
-    return keys;
+    // NB: WebContent reads the items of a storage key from its own copy after this, so they all count as accessed now.
+    if (!items.is_empty()) {
+        database.execute_statement(
+            statements.update_last_access_time_for_storage_key,
+            {},
+            UnixDateTime::now(),
+            to_underlying(storage_endpoint),
+            storage_key);
+    }
+
+    return items;
 }
 
 Requests::CacheSizes StorageJar::PersistedStorage::estimate_storage_size_accessed_since(UnixDateTime since) const
@@ -43,7 +43,7 @@ public:
     void remove_item(StorageEndpointType storage_endpoint, String const& storage_key, String const& key);
     void remove_items_accessed_since(UnixDateTime);
     void clear_storage_key(StorageEndpointType storage_endpoint, String const& storage_key);
-    Vector<String> get_all_keys(StorageEndpointType storage_endpoint, String const& storage_key);
+    OrderedHashMap<String, String> get_all_items(StorageEndpointType storage_endpoint, String const& storage_key);
     Requests::CacheSizes estimate_storage_size_accessed_since(UnixDateTime since) const;
 
 private:
@@ -53,8 +53,9 @@ private:
         Database::StatementID delete_item { 0 };
         Database::StatementID delete_items_accessed_since { 0 };
         Database::StatementID update_last_access_time { 0 };
+        Database::StatementID update_last_access_time_for_storage_key { 0 };
         Database::StatementID clear { 0 };
-        Database::StatementID get_keys { 0 };
+        Database::StatementID get_items { 0 };
         Database::StatementID calculate_size_excluding_key { 0 };
         Database::StatementID estimate_storage_size_accessed_since { 0 };
     };
@@ -66,7 +67,7 @@ private:
         void delete_item(StorageLocation const& key);
         void delete_items_accessed_since(UnixDateTime);
         void clear(StorageEndpointType storage_endpoint, String const& storage_key);
-        Vector<String> get_keys(StorageEndpointType storage_endpoint, String const& storage_key);
+        OrderedHashMap<String, String> get_items(StorageEndpointType storage_endpoint, String const& storage_key);
         Requests::CacheSizes estimate_storage_size_accessed_since(UnixDateTime since) const;
 
     private:
@@ -84,7 +85,7 @@ private:
         void delete_item(StorageLocation const& key);
         void delete_items_accessed_since(UnixDateTime);
         void clear(StorageEndpointType storage_endpoint, String const& storage_key);
-        Vector<String> get_keys(StorageEndpointType storage_endpoint, String const& storage_key);
+        OrderedHashMap<String, String> get_items(StorageEndpointType storage_endpoint, String const& storage_key);
         Requests::CacheSizes estimate_storage_size_accessed_since(UnixDateTime since) const;
 
         Database::Database& database;
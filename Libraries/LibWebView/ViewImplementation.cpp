@@ -197,8 +197,58 @@ void ViewImplementation::set_system_visibility_state(Web::HTML::VisibilityState
     if (m_system_visibility_state == visibility_state)
         return;
 
+    if (m_system_visibility_state == Web::HTML::VisibilityState::Visible)
+        m_last_visible_time = MonotonicTime::now_coarse();
+
     m_system_visibility_state = visibility_state;
     client().async_set_system_visibility_state(m_client_state.page_index, m_system_visibility_state);
+
+    if (m_is_discarded && m_system_visibility_state == Web::HTML::VisibilityState::Visible) {
+        m_is_discarded = false;
+        load(m_url);
+    }
+}
+
+bool ViewImplementation::can_be_discarded() const
+{
+    if (m_is_discarded || m_system_visibility_state == Web::HTML::VisibilityState::Visible)
+        return false;
+
+    // Discarding the page would silently lose whatever it wanted to warn the user about.
+    if (m_needs_beforeunload_check)
+        return false;
+
+    if (m_audio_play_state == Web::HTML::AudioPlayState::Playing || m_devtools_connected)
+        return false;
+
+    // Pages opened by this page (or the other way around) share its process, and would go down with it.
+    if (client().view_count() != 1)
+        return false;
+
+    return m_url.scheme() == "http"sv || m_url.scheme() == "https"sv || m_url.scheme() == "file"sv;
+}
+
+void ViewImplementation::discard()
+{
+    VERIFY(can_be_discarded());
+
+    // FIXME: Also restore the session history and form state of the page once it is reloaded.
+    dbgln("Discarding hidden view {} to save memory: {}", m_view_id, m_url);
+
+    // NB: Every view always needs a client to talk to, so we trade the page's process for a new one without a page.
+    m_client_state.client->unregister_view(m_client_state.page_index);
+    m_is_discarded = true;
+
+    initialize_client();
+    VERIFY(m_client_state.client);
+
+    m_backup_shared_image_buffer = nullptr;
+    handle_resize();
+}
+
+void ViewImplementation::purge_memory()
+{
+    client().async_purge_memory();
 }
 
 void ViewImplementation::load(URL::URL const& url)
@@ -741,6 +791,16 @@ void ViewImplementation::js_console_input(String const& js_source)
     client().async_js_console_input(page_id(), js_source);
 }
 
+void ViewImplementation::start_js_profiler(u32 sampling_interval_in_microseconds)
+{
+    client().async_start_js_profiler(page_id(), sampling_interval_in_microseconds);
+}
+
+void ViewImplementation::stop_js_profiler()
+{
+    client().async_stop_js_profiler(page_id());
+}
+
 void ViewImplementation::exit_fullscreen()
 {
     client().async_exit_fullscreen(page_id());
@@ -1098,7 +1158,7 @@ static ErrorOr<LexicalPath> save_screenshot(Gfx::Bitmap const* bitmap)
         return Application::the().path_for_downloaded_file(file);
     }());
 
-    auto encoded = TRY(Gfx::PNGWriter::encode(*bitmap));
+    auto encoded = TRY(Gfx::PNGWriter::encode(*bitmap, { .compression = Gfx::PNGWriter::Options::Compression::Fast }));
 
     auto dump_file = TRY(Core::File::open(path.string(), Core::File::OpenMode::Write));
     TRY(dump_file->write_until_depleted(encoded));
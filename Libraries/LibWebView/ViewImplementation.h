@@ -16,6 +16,7 @@
 #include <AK/OwnPtr.h>
 #include <AK/Queue.h>
 #include <AK/String.h>
+#include <AK/Time.h>
 #include <AK/Utf16String.h>
 #include <LibCore/AnonymousBuffer.h>
 #include <LibCore/Forward.h>
@@ -81,6 +82,13 @@ public:
     void did_update_window_rect();
 
     void set_system_visibility_state(Web::HTML::VisibilityState);
+    MonotonicTime last_visible_time() const { return m_last_visible_time; }
+
+    // A discarded view has swapped its WebContent process for an empty one, and reloads its page once it is shown.
+    bool can_be_discarded() const;
+    bool is_discarded() const { return m_is_discarded; }
+    void discard();
+    void purge_memory();
 
     void load(URL::URL const&);
     void load_html(StringView);
@@ -170,6 +178,9 @@ public:
     void js_console_input(String const&);
     void exit_fullscreen();
 
+    void start_js_profiler(u32 sampling_interval_in_microseconds);
+    void stop_js_profiler();
+
     void set_is_fullscreen(Web::ViewportIsFullscreen is_fullscreen);
     Web::ViewportIsFullscreen is_fullscreen() const { return m_is_fullscreen; }
 
@@ -271,9 +282,10 @@ public:
     Function<void(Web::CSS::StyleSheetIdentifier const&, URL::URL const&, String const&)> on_received_style_sheet_source;
     Function<void(JsonValue)> on_received_js_console_result;
     Function<void(ConsoleOutput)> on_console_message;
+    Function<void(JsonValue)> on_received_js_profile;
     Function<void(u64 request_id, URL::URL const&, ByteString const&, Vector<HTTP::Header> const&, ByteBuffer, Optional<String>)> on_network_request_started;
     Function<void(u64 request_id, u32 status_code, Optional<String> const&, Vector<HTTP::Header> const&)> on_network_response_headers_received;
-    Function<void(u64 request_id, ByteBuffer)> on_network_response_body_received;
+    Function<void(u64 request_id, ReadonlyBytes)> on_network_response_body_received;
     Function<void(u64 request_id, u64 body_size, Requests::RequestTimingInfo const&, Optional<Requests::NetworkError> const&)> on_network_request_finished;
     Function<void(i32 count_waiting)> on_resource_status_change;
     Function<void()> on_restore_window;
@@ -448,6 +460,8 @@ protected:
     RefPtr<Core::Promise<String>> m_pending_info_request;
 
     Web::HTML::VisibilityState m_system_visibility_state { Web::HTML::VisibilityState::Hidden };
+    MonotonicTime m_last_visible_time { MonotonicTime::now_coarse() };
+    bool m_is_discarded { false };
 
     Web::HTML::AudioPlayState m_audio_play_state { Web::HTML::AudioPlayState::Paused };
     size_t m_number_of_elements_playing_audio { 0 };
@@ -972,6 +972,14 @@ void WebContentClient::did_output_js_console_message(u64 page_id, ConsoleOutput
     }
 }
 
+void WebContentClient::did_stop_js_profiler(u64 page_id, JsonValue profile)
+{
+    if (auto view = view_for_page_id(page_id); view.has_value()) {
+        if (view->on_received_js_profile)
+            view->on_received_js_profile(move(profile));
+    }
+}
+
 void WebContentClient::did_start_network_request(u64 page_id, u64 request_id, URL::URL url, ByteString method, Vector<HTTP::Header> request_headers, ByteBuffer request_body, Optional<String> initiator_type)
 {
     if (!check_rate_limit())
@@ -995,11 +1003,11 @@ void WebContentClient::did_receive_network_response_headers(u64 page_id, u64 req
     }
 }
 
-void WebContentClient::did_receive_network_response_body(u64 page_id, u64 request_id, ByteBuffer data)
+void WebContentClient::did_receive_network_response_body(u64 page_id, u64 request_id, ReadonlyBytes data)
 {
     if (auto view = view_for_page_id(page_id); view.has_value()) {
         if (view->on_network_response_body_received)
-            view->on_network_response_body_received(request_id, move(data));
+            view->on_network_response_body_received(request_id, data);
     }
 }
 
@@ -1231,6 +1239,16 @@ void WebContentClient::did_expire_cookies_with_time_offset(AK::Duration offset)
     Application::cookie_jar().expire_cookies_with_time_offset(offset);
 }
 
+void WebContentClient::did_report_allocator_statistics(u64 general_bytes_in_use, u64 general_bytes_committed, u64 array_buffer_bytes_in_use, u64 array_buffer_bytes_committed)
+{
+    if (auto process = WebView::Application::the().find_process(m_process_handle.pid); process.has_value()) {
+        process->set_allocator_statistics({
+            .general = { .bytes_in_use = general_bytes_in_use, .bytes_committed = general_bytes_committed },
+            .array_buffer = { .bytes_in_use = array_buffer_bytes_in_use, .bytes_committed = array_buffer_bytes_committed },
+        });
+    }
+}
+
 void WebContentClient::did_store_hsts_policy(String domain, HTTP::HSTS::ParsedHSTSPolicy policy)
 {
     Application::hsts_store().store_policy(domain, policy);
@@ -1241,29 +1259,59 @@ Messages::WebContentClient::DidIsKnownHstsHostResponse WebContentClient::did_is_
     return Application::hsts_store().is_known_hsts_host(domain);
 }
 
-Messages::WebContentClient::DidRequestStorageItemResponse WebContentClient::did_request_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key)
+// WebContent processes keep their own copy of each local storage area they use, so every change has to reach the other
+// processes that may hold that area.
+void WebContentClient::notify_local_storage_area_changed(Optional<String> const& storage_key, WebContentClient const* source)
 {
-    return Application::storage_jar().get_item(storage_endpoint, storage_key, bottle_key);
+    for_each_client([&](auto& client) {
+        if (&client != source)
+            client.async_local_storage_area_changed(storage_key);
+        return IterationDecision::Continue;
+    });
 }
 
-Messages::WebContentClient::DidSetStorageItemResponse WebContentClient::did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key, String value)
+Messages::WebContentClient::DidRequestStorageAreaResponse WebContentClient::did_request_storage_area(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key)
 {
-    return Application::storage_jar().set_item(storage_endpoint, storage_key, bottle_key, value);
+    return Application::storage_jar().get_all_items(storage_endpoint, storage_key);
 }
 
-void WebContentClient::did_remove_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key)
+void WebContentClient::did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key, String value)
 {
-    Application::storage_jar().remove_item(storage_endpoint, storage_key, bottle_key);
+    auto result = Application::storage_jar().set_item(storage_endpoint, storage_key, bottle_key, value);
+
+    // NB: WebContent checks the quota against its own copy of the area before sending the item. If another process
+    //     filled the area in the meantime, that copy is now wrong, so the source has to reload it as well.
+    if (result.has<StorageOperationError>()) {
+        if (storage_endpoint == Web::StorageAPI::StorageEndpointType::LocalStorage)
+            async_local_storage_area_changed(storage_key);
+        return;
+    }
+
+    if (storage_endpoint == Web::StorageAPI::StorageEndpointType::LocalStorage)
+        notify_local_storage_area_changed(storage_key, this);
 }
 
-Messages::WebContentClient::DidRequestStorageKeysResponse WebContentClient::did_request_storage_keys(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key)
+void WebContentClient::did_remove_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key)
 {
-    return Application::storage_jar().get_all_keys(storage_endpoint, storage_key);
+    Application::storage_jar().remove_item(storage_endpoint, storage_key, bottle_key);
+    if (storage_endpoint == Web::StorageAPI::StorageEndpointType::LocalStorage)
+        notify_local_storage_area_changed(storage_key, this);
 }
 
 void WebContentClient::did_clear_storage(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key)
 {
     Application::storage_jar().clear_storage_key(storage_endpoint, storage_key);
+    if (storage_endpoint == Web::StorageAPI::StorageEndpointType::LocalStorage)
+        notify_local_storage_area_changed(storage_key, this);
+}
+
+void WebContentClient::did_broadcast_local_storage_change(String storage_key, Optional<String> key, Optional<String> old_value, Optional<String> new_value, String url)
+{
+    for_each_client([&](auto& client) {
+        if (&client != this)
+            client.async_local_storage_changed(storage_key, key, old_value, new_value, url);
+        return IterationDecision::Continue;
+    });
 }
 
 void WebContentClient::did_post_broadcast_channel_message(u64, Web::HTML::BroadcastChannelMessage message)
@@ -55,6 +55,7 @@ public:
 
     static size_t client_count() { return clients().size(); }
     static Optional<WebContentClient&> client_for_compositor_context_id(Web::Compositor::CompositorContextId);
+    static void notify_local_storage_area_changed(Optional<String> const& storage_key, WebContentClient const* source = nullptr);
 
     WebContentClient(NonnullOwnPtr<IPC::Transport>, u64 initial_page_id);
     ~WebContentClient();
@@ -70,6 +71,7 @@ public:
     void web_ui_disconnected(Badge<WebUI>);
 
     bool has_views() const { return !m_views.is_empty(); }
+    size_t view_count() const { return m_views.size(); }
 
     void notify_all_views_of_crash();
     ErrorOr<void> reconnect_to_compositor_process(Badge<Application>);
@@ -135,9 +137,10 @@ private:
     virtual void did_get_internal_page_info(u64 page_id, PageInfoType, Optional<Core::AnonymousBuffer>) override;
     virtual void did_execute_js_console_input(u64 page_id, JsonValue) override;
     virtual void did_output_js_console_message(u64 page_id, ConsoleOutput) override;
+    virtual void did_stop_js_profiler(u64 page_id, JsonValue) override;
     virtual void did_start_network_request(u64 page_id, u64 request_id, URL::URL, ByteString method, Vector<HTTP::Header>, ByteBuffer request_body, Optional<String> initiator_type) override;
     virtual void did_receive_network_response_headers(u64 page_id, u64 request_id, u32 status_code, Optional<String> reason_phrase, Vector<HTTP::Header>) override;
-    virtual void did_receive_network_response_body(u64 page_id, u64 request_id, ByteBuffer data) override;
+    virtual void did_receive_network_response_body(u64 page_id, u64 request_id, ReadonlyBytes data) override;
     virtual void did_finish_network_request(u64 page_id, u64 request_id, u64 body_size, Requests::RequestTimingInfo, Optional<Requests::NetworkError>) override;
     virtual void did_change_favicon(u64 page_id, Gfx::ShareableBitmap) override;
     virtual void did_request_alert(u64 page_id, String) override;
@@ -158,13 +161,14 @@ private:
     virtual void did_set_cookie(URL::URL, HTTP::Cookie::ParsedCookie, HTTP::Cookie::Source) override;
     virtual void did_update_cookie(HTTP::Cookie::Cookie) override;
     virtual void did_expire_cookies_with_time_offset(AK::Duration) override;
+    virtual void did_report_allocator_statistics(u64 general_bytes_in_use, u64 general_bytes_committed, u64 array_buffer_bytes_in_use, u64 array_buffer_bytes_committed) override;
     virtual void did_store_hsts_policy(String, HTTP::HSTS::ParsedHSTSPolicy) override;
     virtual Messages::WebContentClient::DidIsKnownHstsHostResponse did_is_known_hsts_host(String) override;
-    virtual Messages::WebContentClient::DidRequestStorageItemResponse did_request_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key) override;
-    virtual Messages::WebContentClient::DidSetStorageItemResponse did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key, String value) override;
+    virtual Messages::WebContentClient::DidRequestStorageAreaResponse did_request_storage_area(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key) override;
+    virtual void did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key, String value) override;
     virtual void did_remove_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key, String bottle_key) override;
-    virtual Messages::WebContentClient::DidRequestStorageKeysResponse did_request_storage_keys(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key) override;
     virtual void did_clear_storage(Web::StorageAPI::StorageEndpointType storage_endpoint, String storage_key) override;
+    virtual void did_broadcast_local_storage_change(String storage_key, Optional<String> key, Optional<String> old_value, Optional<String> new_value, String url) override;
     virtual void did_post_broadcast_channel_message(u64 page_id, Web::HTML::BroadcastChannelMessage message) override;
     virtual Messages::WebContentClient::DidRequestNewWebViewResponse did_request_new_web_view(u64 page_id, Web::HTML::ActivateTab, Web::HTML::WebViewHints) override;
     virtual void did_request_activate_tab(u64 page_id) override;
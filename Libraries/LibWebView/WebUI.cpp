@@ -12,6 +12,7 @@
 #include <LibWebView/WebUI/ProcessesUI.h>
 #include <LibWebView/WebUI/SecurityUI.h>
 #include <LibWebView/WebUI/SettingsUI.h>
+#include <LibWebView/WebUI/TracingUI.h>
 #include <LibWebView/WebUI/VersionUI.h>
 
 namespace WebView {
@@ -42,6 +43,8 @@ ErrorOr<RefPtr<WebUI>> WebUI::create(WebContentClient& client, u64 page_id, Stri
         web_ui = TRY(create_web_ui<SecurityUI>(client, page_id, move(host)));
     else if (host == "settings"sv)
         web_ui = TRY(create_web_ui<SettingsUI>(client, page_id, move(host)));
+    else if (host == "tracing"sv)
+        web_ui = TRY(create_web_ui<TracingUI>(client, page_id, move(host)));
     else if (host == "version"sv)
         web_ui = TRY(create_web_ui<VersionUI>(client, page_id, move(host)));
 
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonObject.h>
+#include <LibWebView/Application.h>
+#include <LibWebView/WebUI/TracingUI.h>
+
+namespace WebView {
+
+void TracingUI::register_interfaces()
+{
+    register_interface("loadTracingState"sv, [this](auto const&) {
+        send_tracing_state();
+    });
+    register_interface("startTracing"sv, [this](auto const&) {
+        start_tracing();
+    });
+    register_interface("stopTracing"sv, [this](auto const&) {
+        stop_tracing();
+    });
+}
+
+void TracingUI::start_tracing()
+{
+    Application::the().start_tracing();
+    send_tracing_state();
+}
+
+void TracingUI::stop_tracing()
+{
+    if (!Application::the().is_tracing())
+        return;
+
+    auto trace = Application::the().stop_tracing();
+    async_send_message("loadTrace"sv, move(trace));
+    send_tracing_state();
+}
+
+void TracingUI::send_tracing_state()
+{
+    async_send_message("loadTracingState"sv, Application::the().is_tracing());
+}
+
+}
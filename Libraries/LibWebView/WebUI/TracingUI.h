@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <LibWebView/Forward.h>
+#include <LibWebView/WebUI.h>
+
+namespace WebView {
+
+class WEBVIEW_API TracingUI : public WebUI {
+    WEB_UI(TracingUI);
+
+private:
+    virtual void register_interfaces() override;
+
+    void start_tracing();
+    void stop_tracing();
+    void send_tracing_state();
+};
+
+}
@@ -14,6 +14,11 @@ namespace WebView {
 
 void WebWorkerClient::die()
 {
+    if (m_agent_id == 0) {
+        WorkerProcessManager::the().idle_worker_did_die(*this);
+        return;
+    }
+
     WorkerProcessManager::the().worker_did_die(m_agent_id);
 
     // Otherwise nested workers we own would outlive us, in violation of the HTML spec.
@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/ScopeGuard.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/File.h>
 #include <LibIPC/File.h>
@@ -108,15 +109,10 @@ Web::HTML::WorkerAgentId WorkerProcessManager::start_worker_agent(Owner owner, W
 
     // 11.6. Otherwise, in parallel, run a worker given worker, urlRecord, outsideSettings, outsidePort,
     //       and options.
-    // AD-HOC: For DedicatedWorker there is no shared worker manager step; we always launch a fresh
-    //         worker process here.
+    // AD-HOC: For DedicatedWorker there is no shared worker manager step; we always start the worker in a fresh
+    //         process here, taken from the idle pool when one is available.
     auto agent_id = ++m_next_agent_id;
-    auto client = MUST(launch_web_worker_process(request.agent_type, agent_id));
-
-    auto request_server_handle = MUST(connect_new_request_server_client());
-    auto image_decoder_handle = MUST(connect_new_image_decoder_client());
-    client->async_connect_to_request_server(move(request_server_handle));
-    client->async_connect_to_image_decoder(move(image_decoder_handle));
+    auto client = take_or_launch_worker_process(request.agent_type, agent_id);
 
     Vector<Owner> owners;
     owners.append(owner);
@@ -362,6 +358,71 @@ void WorkerProcessManager::worker_did_post_broadcast_channel_message(Web::HTML::
     }
 }
 
+// Pages that start one dedicated worker tend to start several, often all at once while loading. Keeping a few worker
+// processes launched ahead of time lets those skip process startup, sandboxing and VM initialization. The realm
+// itself depends on the worker's URL and outside settings, so it's still created when the worker starts.
+static constexpr size_t idle_dedicated_worker_pool_size = 2;
+
+NonnullRefPtr<WebWorkerClient> WorkerProcessManager::take_or_launch_worker_process(Web::Bindings::AgentType agent_type, Web::HTML::WorkerAgentId agent_id)
+{
+    if (agent_type != Web::Bindings::AgentType::DedicatedWorker)
+        return MUST(launch_worker_process(agent_type, agent_id));
+
+    // Only the first dedicated worker pays for launching a process on demand. Its arrival is what fills the pool.
+    ScopeGuard refill_pool = [&] { refill_idle_worker_pool(); };
+
+    while (!m_idle_dedicated_workers.is_empty()) {
+        auto client = m_idle_dedicated_workers.take_first();
+        if (!client->is_open())
+            continue;
+        client->set_agent_id(agent_id);
+        return client;
+    }
+
+    return MUST(launch_worker_process(agent_type, agent_id));
+}
+
+ErrorOr<NonnullRefPtr<WebWorkerClient>> WorkerProcessManager::launch_worker_process(Web::Bindings::AgentType agent_type, Web::HTML::WorkerAgentId agent_id)
+{
+    auto client = TRY(launch_web_worker_process(agent_type, agent_id));
+
+    auto request_server_handle = TRY(connect_new_request_server_client());
+    auto image_decoder_handle = TRY(connect_new_image_decoder_client());
+    client->async_connect_to_request_server(move(request_server_handle));
+    client->async_connect_to_image_decoder(move(image_decoder_handle));
+
+    return client;
+}
+
+void WorkerProcessManager::refill_idle_worker_pool()
+{
+    if (m_idle_worker_pool_refill_pending)
+        return;
+    m_idle_worker_pool_refill_pending = true;
+
+    // Launch the spare processes after the current burst of worker requests has been handled, so that the pool
+    // doesn't delay the worker that triggered it.
+    Core::deferred_invoke([this] {
+        m_idle_worker_pool_refill_pending = false;
+
+        while (m_idle_dedicated_workers.size() < idle_dedicated_worker_pool_size) {
+            auto client = launch_worker_process(Web::Bindings::AgentType::DedicatedWorker, 0);
+            if (client.is_error()) {
+                dbgln("Unable to launch an idle WebWorker process: {}", client.error());
+                return;
+            }
+            m_idle_dedicated_workers.append(client.release_value());
+        }
+    });
+}
+
+void WorkerProcessManager::idle_worker_did_die(WebWorkerClient& client)
+{
+    m_idle_dedicated_workers.remove_first_matching([&](auto const& idle_client) {
+        return idle_client.ptr() == &client;
+    });
+}
+
 void WorkerProcessManager::remove_agent(Web::HTML::WorkerAgentId agent_id)
 {
     auto maybe_agent = m_agents.find(agent_id);
@@ -74,6 +74,11 @@ private:
     void worker_did_request_file(Web::HTML::WorkerAgentId, ByteString path, i32 request_id);
     void worker_did_post_broadcast_channel_message(Web::HTML::WorkerAgentId, Web::HTML::BroadcastChannelMessage);
 
+    NonnullRefPtr<WebWorkerClient> take_or_launch_worker_process(Web::Bindings::AgentType, Web::HTML::WorkerAgentId);
+    ErrorOr<NonnullRefPtr<WebWorkerClient>> launch_worker_process(Web::Bindings::AgentType, Web::HTML::WorkerAgentId);
+    void refill_idle_worker_pool();
+    void idle_worker_did_die(WebWorkerClient&);
+
     void remove_agent(Web::HTML::WorkerAgentId);
     void remove_owner(Web::HTML::WorkerAgentId, Owner const& identity);
 
@@ -93,6 +98,11 @@ private:
     Web::HTML::WorkerAgentId m_next_agent_id { 0 };
     HashMap<Web::HTML::WorkerAgentId, WorkerAgent> m_agents;
     HashMap<SharedWorkerKey, Web::HTML::WorkerAgentId> m_shared_workers;
+
+    // Dedicated worker processes that have been launched and connected to the other services ahead of time, but not
+    // assigned an agent yet. Their agent id is 0 until they are taken from the pool.
+    Vector<NonnullRefPtr<WebWorkerClient>> m_idle_dedicated_workers;
+    bool m_idle_worker_pool_refill_pending { false };
 };
 
 }
@@ -9,6 +9,7 @@
 namespace XML {
 
 class Parser;
+class PushParser;
 class Document;
 struct Node;
 struct Attribute;
@@ -455,48 +455,109 @@ ErrorOr<void, ParseError> Parser::parse_with_listener(Listener& listener)
     if (source_result.is_error())
         return ParseError { {}, ByteString("Failed to set source") };
 
-    ParserContext context;
-    context.listener = &listener;
-    context.options = &m_options;
+    auto parser = TRY(PushParser::create(listener, move(m_options)));
 
-    bool resolve_html_entities = static_cast<bool>(m_options.resolve_named_html_entity);
-    auto sax_handler = create_sax_handler(m_options.preserve_comments, resolve_html_entities);
+    auto result = parser->feed(m_source);
+    auto finish_result = parser->finish();
 
-    int options = XML_PARSE_NONET | XML_PARSE_NOWARNING;
-    if (!m_options.preserve_cdata)
-        options |= XML_PARSE_NOCDATA;
+    m_parse_errors = parser->parse_error_causes();
+
+    if (result.is_error())
+        return result.release_error();
+    return finish_result;
+}
+
+PushParser::PushParser(Listener& listener, Parser::Options options)
+    : m_listener(listener)
+    , m_options(move(options))
+    , m_context(make<ParserContext>())
+{
+    m_context->listener = &m_listener;
+    m_context->options = &m_options;
+}
 
+PushParser::~PushParser()
+{
+    if (m_parser_context)
+        xmlFreeParserCtxt(static_cast<xmlParserCtxtPtr>(m_parser_context));
+}
+
+ErrorOr<NonnullOwnPtr<PushParser>, ParseError> PushParser::create(Listener& listener, Parser::Options options)
+{
+    auto parser = adopt_own(*new PushParser(listener, move(options)));
+
+    bool resolve_html_entities = static_cast<bool>(parser->m_options.resolve_named_html_entity);
+    auto sax_handler = create_sax_handler(parser->m_options.preserve_comments, resolve_html_entities);
+
+    int xml_options = XML_PARSE_NONET | XML_PARSE_NOWARNING;
+    if (!parser->m_options.preserve_cdata)
+        xml_options |= XML_PARSE_NOCDATA;
+
+    // NB: libxml2 keeps its own copy of the SAX handler, so it doesn't have to outlive this function.
     auto* parser_ctx = xmlCreatePushParserCtxt(&sax_handler, nullptr, nullptr, 0, nullptr);
     if (!parser_ctx)
         return ParseError { {}, ByteString("Failed to create parser context") };
 
-    parser_ctx->_private = &context;
-    xmlCtxtUseOptions(parser_ctx, options);
+    parser_ctx->_private = parser->m_context.ptr();
+    xmlCtxtUseOptions(parser_ctx, xml_options);
 
     xmlSwitchEncoding(parser_ctx, XML_CHAR_ENCODING_UTF8);
 
-    auto result = xmlParseChunk(parser_ctx, m_source.characters_without_null_termination(), static_cast<int>(m_source.length()), 1);
+    parser->m_parser_context = parser_ctx;
+    return parser;
+}
+
+ErrorOr<void, ParseError> PushParser::feed(StringView source)
+{
+    VERIFY(!m_finished);
+
+    auto* parser_ctx = static_cast<xmlParserCtxtPtr>(m_parser_context);
+    auto result = xmlParseChunk(parser_ctx, source.characters_without_null_termination(), static_cast<int>(source.length()), 0);
+
+    if (m_context->error.has_value() && m_options.treat_errors_as_fatal)
+        return m_context->error.value();
+
+    if (result != 0) {
+        if (!m_context->parse_errors.is_empty())
+            return m_context->parse_errors.first();
+        return ParseError { {}, ByteString("XML parsing failed") };
+    }
+
+    return {};
+}
+
+ErrorOr<void, ParseError> PushParser::finish()
+{
+    VERIFY(!m_finished);
+    m_finished = true;
+
+    auto* parser_ctx = static_cast<xmlParserCtxtPtr>(m_parser_context);
+    auto result = xmlParseChunk(parser_ctx, nullptr, 0, 1);
 
     bool well_formed = parser_ctx->wellFormed;
     xmlFreeParserCtxt(parser_ctx);
+    m_parser_context = nullptr;
 
-    m_parse_errors = move(context.parse_errors);
-
-    if (!context.document_ended)
-        listener.document_end();
+    if (!m_context->document_ended)
+        m_listener.document_end();
 
-    if (context.error.has_value() && m_options.treat_errors_as_fatal)
-        return context.error.release_value();
+    if (m_context->error.has_value() && m_options.treat_errors_as_fatal)
+        return m_context->error.value();
 
     if (result != 0 || !well_formed) {
-        if (!m_parse_errors.is_empty())
-            return m_parse_errors.first();
+        if (!m_context->parse_errors.is_empty())
+            return m_context->parse_errors.first();
         return ParseError { {}, ByteString("XML parsing failed") };
     }
 
     return {};
 }
 
+Vector<ParseError> const& PushParser::parse_error_causes() const
+{
+    return m_context->parse_errors;
+}
+
 ErrorOr<Document, ParseError> Parser::parse()
 {
     ParserContext context;
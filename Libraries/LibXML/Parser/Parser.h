@@ -11,6 +11,7 @@
 #include <AK/Function.h>
 #include <AK/GenericLexer.h>
 #include <AK/HashMap.h>
+#include <AK/Noncopyable.h>
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <AK/String.h>
@@ -22,6 +23,8 @@
 
 namespace XML {
 
+struct ParserContext;
+
 struct Expectation {
     StringView expected;
 };
@@ -78,6 +81,35 @@ private:
     Vector<ParseError> m_parse_errors;
 };
 
+// Parses a document whose source arrives in pieces, reporting everything up to the end of each piece to the listener
+// as soon as it is fed, without keeping the whole source around.
+class XML_API PushParser {
+    AK_MAKE_NONCOPYABLE(PushParser);
+    AK_MAKE_NONMOVABLE(PushParser);
+
+public:
+    static ErrorOr<NonnullOwnPtr<PushParser>, ParseError> create(Listener&, Parser::Options);
+    ~PushParser();
+
+    ErrorOr<void, ParseError> feed(StringView);
+
+    // Parses whatever is left of the source, and tells the listener that the document has ended.
+    ErrorOr<void, ParseError> finish();
+
+    Vector<ParseError> const& parse_error_causes() const;
+
+private:
+    PushParser(Listener&, Parser::Options);
+
+    Listener& m_listener;
+    Parser::Options m_options;
+    NonnullOwnPtr<ParserContext> m_context;
+
+    // NB: This is libxml2's xmlParserCtxtPtr, whose headers we don't want everyone including us to pull in.
+    void* m_parser_context { nullptr };
+    bool m_finished { false };
+};
+
 }
 
 template<>
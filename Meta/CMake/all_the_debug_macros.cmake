@@ -11,6 +11,7 @@ set(CSS_PARSER_DEBUG ON)
 set(CSS_TOKENIZER_DEBUG ON)
 set(CSS_TRANSITIONS_DEBUG ON)
 set(CURL_DEBUG ON)
+set(DATABASE_DEBUG ON)
 set(DEVTOOLS_DEBUG ON)
 set(DNS_DEBUG ON)
 set(EDITOR_DEBUG ON)
@@ -70,8 +70,10 @@ find_package(SQLite3 REQUIRED)
 find_package(Threads REQUIRED)
 find_package(ZLIB REQUIRED)
 
+pkg_check_modules(LIBBROTLI REQUIRED IMPORTED_TARGET libbrotlidec libbrotlienc)
 pkg_check_modules(LIBPSL REQUIRED IMPORTED_TARGET libpsl)
 pkg_check_modules(libtommath REQUIRED IMPORTED_TARGET libtommath)
+pkg_check_modules(LIBZSTD REQUIRED IMPORTED_TARGET libzstd)
 
 find_package(unofficial-angle CONFIG)
 if(unofficial-angle_FOUND)
@@ -62,14 +62,26 @@ SIMPLE_TYPES = {
     "WebView::PageInfoType",
 }
 
+# Types that a [Borrowed] parameter can have, and the view its handler receives in their place. The view points into the
+# received message, so it is only valid for the duration of the handler.
+BORROWED_TYPES = {
+    "ByteBuffer": "ReadonlyBytes",
+    "ByteString": "StringView",
+    "String": "StringView",
+}
+
 
 @dataclass
 class Parameter:
     attributes: List[str] = field(default_factory=list)
     type: str = ""
     type_for_encoding: str = ""
+    owned_type: str = ""
     name: str = ""
 
+    def is_borrowed(self) -> bool:
+        return bool(self.owned_type)
+
 
 @dataclass
 class Message:
@@ -186,6 +198,12 @@ def parse(contents: str) -> List[Endpoint]:
         if parameter.type.endswith(",") or parameter.type.endswith(")"):
             raise RuntimeError(f"Parameter {parameter_index} of method: {message_name} must be named")
 
+        if "Borrowed" in parameter.attributes:
+            if parameter.type not in BORROWED_TYPES:
+                raise RuntimeError(f"Parameter {parameter_index} of method: {message_name} cannot borrow a {parameter.type}")
+            parameter.owned_type = parameter.type
+            parameter.type = BORROWED_TYPES[parameter.type]
+
         if parameter.type.startswith("Vector<") and parameter.type.endswith(">"):
             parameter.type_for_encoding = "ReadonlySpan" + parameter.type[len("Vector") :]
         elif parameter.type in ("String", "ByteString"):
@@ -249,6 +267,10 @@ def parse(contents: str) -> List[Endpoint]:
             parse_parameters(message.outputs, message.name)
             assert_specific(")")
 
+            # The response is handed back to the caller after the message it was decoded from is gone.
+            if any(output.is_borrowed() for output in message.outputs):
+                raise RuntimeError(f"Response parameters of method: {message.name} cannot be borrowed")
+
         consume_whitespace()
         endpoints[-1].messages.append(message)
 
@@ -337,6 +359,10 @@ def write_message_class(
     response_type: str = "",
 ) -> None:
     pascal_name = pascal_case(name)
+    borrows_buffer = any(p.is_borrowed() for p in parameters)
+
+    # A copy would point into the buffer of the message it was copied from.
+    copy_operations = "delete" if borrows_buffer else "default"
 
     out.write(f"""
 class {pascal_name} final : public IPC::Message {{
@@ -348,9 +374,9 @@ public:""")
     out.write(f"""
     {constructor_for_message(pascal_name, parameters)}
 
-    {pascal_name}({pascal_name} const&) = default;
+    {pascal_name}({pascal_name} const&) = {copy_operations};
     {pascal_name}({pascal_name}&&) = default;
-    {pascal_name}& operator=({pascal_name} const&) = default;
+    {pascal_name}& operator=({pascal_name} const&) = {copy_operations};
 """)
 
     if len(parameters) == 1:
@@ -371,14 +397,19 @@ public:""")
     static i32 static_message_id() {{ return (int)MessageID::{pascal_name}; }}
     virtual StringView message_name() const override {{ return "{endpoint.name}::{pascal_name}"sv; }}
 
-    static ErrorOr<NonnullOwnPtr<{pascal_name}>> decode(Stream& stream, Queue<IPC::Attachment>& attachments)
+    static ErrorOr<NonnullOwnPtr<{pascal_name}>> decode(FixedMemoryStream& stream, Queue<IPC::Attachment>& attachments)
     {{
         IPC::Decoder decoder {{ stream, attachments }};""")
 
     for parameter in parameters:
-        out.write(f"\n        auto {parameter.name} = TRY((decoder.decode<{parameter.type}>()));")
+        if not parameter.is_borrowed():
+            out.write(f"\n        auto {parameter.name} = TRY((decoder.decode<{parameter.type}>()));")
+        elif parameter.type == "ReadonlyBytes":
+            out.write(f"\n        auto {parameter.name} = TRY(decoder.decode_borrowed_bytes());")
+        else:
+            out.write(f"\n        auto {parameter.name} = {parameter.type} {{ TRY(decoder.decode_borrowed_bytes()) }};")
 
-        if "UTF8" in parameter.attributes:
+        if "UTF8" in parameter.attributes or parameter.owned_type == "String":
             out.write(f"""
         if (!Utf8View({parameter.name}).validate())
             return Error::from_string_literal("Decoded {parameter.name} is invalid UTF-8");
@@ -413,6 +444,11 @@ public:""")
     }}
 """)
 
+    if borrows_buffer:
+        out.write("""
+    virtual void adopt_buffer(Vector<u8>&& buffer) override { m_buffer = move(buffer); }
+""")
+
     for parameter in parameters:
         if is_primitive_or_simple_type(parameter.type):
             out.write(f"\n    {parameter.type} {parameter.name}() const {{ return m_{parameter.name}; }}\n")
@@ -425,6 +461,8 @@ public:""")
     out.write("\nprivate:")
     for parameter in parameters:
         out.write(f"\n    {parameter.type} m_{parameter.name};")
+    if borrows_buffer:
+        out.write("\n    Vector<u8> m_buffer;")
     out.write("\n};\n")
 
 
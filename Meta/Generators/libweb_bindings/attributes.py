@@ -69,11 +69,26 @@ def attribute_setter_callback_name(attribute: Attribute) -> str:
     return f"{attribute_callback_cpp_name(attribute)}_setter"
 
 
+def attribute_fast_getter_callback_name(attribute: Attribute) -> str:
+    return f"{attribute_callback_cpp_name(attribute)}_fast_getter"
+
+
+def attribute_has_fast_getter(interface: Interface, attribute: Attribute) -> bool:
+    # A fast getter is called by cached property accesses with the this value, and without an execution context.
+    # Global interfaces resolve a nullish this value to the global object, so they keep the regular path only.
+    return (
+        "Global" not in interface.extended_attributes
+        and "LegacyUnforgeable" not in attribute.extended_attributes
+        and attribute.type.name != "Promise"
+    )
+
+
 def define_the_regular_attributes(
     out: TextIO,
     includes: GeneratedIncludes,
     interface: Interface,
     include_replaceable_setters: bool = False,
+    with_fast_getters: bool = False,
 ) -> None:
     # 1. Let attributes be the list of regular attributes that are members of definition.
     attributes = [
@@ -84,7 +99,7 @@ def define_the_regular_attributes(
     attributes = [attribute for attribute in attributes if "LegacyUnforgeable" not in attribute.extended_attributes]
 
     # 3. Define the attributes attributes of definition on target given realm.
-    define_the_attributes(out, includes, attributes, interface, include_replaceable_setters)
+    define_the_attributes(out, includes, attributes, interface, include_replaceable_setters, with_fast_getters)
 
 
 def define_the_unforgeable_attributes(
@@ -107,6 +122,7 @@ def define_the_attributes(
     attributes: list[Attribute],
     interface: Interface,
     include_replaceable_setters: bool = False,
+    with_fast_getters: bool = False,
 ) -> None:
     if not attributes:
         return
@@ -133,6 +149,13 @@ def define_the_attributes(
             definition.write(
                 f'    auto {native_getter_name} = host_defined_intrinsics(realm).ensure_web_unforgeable_function("{interface.namespaced_name}"_utf16_fly_string, {cpp_name}_id, {getter_name}, UnforgeableKey::Type::Getter);\n'
             )
+        elif with_fast_getters and attribute_has_fast_getter(interface, attribute):
+            definition.write(
+                f'    auto {native_getter_name} = JS::RawNativeFunction::create(realm, {getter_name}, 0, {cpp_name}_id, &realm, "get"sv);\n'
+            )
+            definition.write(
+                f"    {native_getter_name}->set_fast_getter({attribute_fast_getter_callback_name(attribute)});\n"
+            )
         else:
             definition.write(
                 f'    auto {native_getter_name} = JS::NativeFunction::create(realm, {getter_name}, 0, {cpp_name}_id, &realm, "get"sv);\n'
@@ -188,7 +211,8 @@ def write_attribute_getters(
     for attribute in interface.regular_attributes:
         if "FIXME" in attribute.extended_attributes:
             continue
-        write_attribute_getter(out, context, includes, interface, attribute)
+        with_fast_getter = attribute_has_fast_getter(interface, attribute)
+        write_attribute_getter(out, context, includes, interface, attribute, with_fast_getter=with_fast_getter)
 
 
 def write_attribute_getter(
@@ -198,6 +222,7 @@ def write_attribute_getter(
     interface: Interface,
     attribute: Attribute,
     receiver_class: Optional[str] = None,
+    with_fast_getter: bool = False,
 ) -> None:
     if receiver_class is None:
         receiver_class = interface.prototype_class
@@ -418,8 +443,10 @@ def write_attribute_getter(
 """
         )
         return
-    out.write(
-        f"""JS_DEFINE_NATIVE_FUNCTION({receiver_class}::{attribute_getter_callback_name(attribute)})
+    return_value = cached_return_value or to_javascript_value(attribute.type, "R", includes, context)
+    if not with_fast_getter:
+        out.write(
+            f"""JS_DEFINE_NATIVE_FUNCTION({receiver_class}::{attribute_getter_callback_name(attribute)})
 {{
     WebIDL::log_trace(vm, "{receiver_class}::{attribute_getter_callback_name(attribute)}");
     [[maybe_unused]] auto& realm = *vm.current_realm();
@@ -429,7 +456,44 @@ def write_attribute_getter(
 {getter_prelude}
     {getter_steps}
 {getter_cache_check}
-    return {cached_return_value or to_javascript_value(attribute.type, "R", includes, context)};
+    return {return_value};
+}}
+
+"""
+        )
+        return
+
+    # NB: The regular and the fast getter only differ in how they find idlObject, so they share the getter steps.
+    impl_class = fully_qualified_name_for_interface(interface)
+    getter_steps_name = f"{attribute_getter_callback_name(attribute)}_steps"
+    out.write(
+        f"""static JS::ThrowCompletionOr<JS::Value> {getter_steps_name}(JS::VM& vm, {impl_class}* idl_object)
+{{
+    [[maybe_unused]] auto& realm = *vm.current_realm();
+
+{getter_prelude}
+    {getter_steps}
+{getter_cache_check}
+    return {return_value};
+}}
+
+JS_DEFINE_NATIVE_FUNCTION({receiver_class}::{attribute_getter_callback_name(attribute)})
+{{
+    WebIDL::log_trace(vm, "{receiver_class}::{attribute_getter_callback_name(attribute)}");
+
+    auto* idl_object = TRY(impl_from(vm));
+    return {getter_steps_name}(vm, idl_object);
+}}
+
+JS::ThrowCompletionOr<Optional<JS::Value>> {receiver_class}::{attribute_fast_getter_callback_name(attribute)}(JS::VM& vm, JS::Value this_value)
+{{
+    // NB: Other this values are left to the regular getter, so that it throws with the getter on the call stack.
+    auto idl_object = this_value.as_if<{impl_class}>();
+    if (!idl_object)
+        return OptionalNone {{}};
+
+    WebIDL::log_trace(vm, "{receiver_class}::{attribute_fast_getter_callback_name(attribute)}");
+    return TRY({getter_steps_name}(vm, idl_object.ptr()));
 }}
 
 """
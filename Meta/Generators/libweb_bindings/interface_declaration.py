@@ -6,7 +6,9 @@
 from typing import TextIO
 
 from Generators.libweb_bindings import overload_resolution
+from Generators.libweb_bindings.attributes import attribute_fast_getter_callback_name
 from Generators.libweb_bindings.attributes import attribute_getter_callback_name
+from Generators.libweb_bindings.attributes import attribute_has_fast_getter
 from Generators.libweb_bindings.attributes import attribute_has_setter
 from Generators.libweb_bindings.attributes import attribute_setter_callback_name
 from Generators.libweb_bindings.callback_interfaces import write_callback_interface_declaration
@@ -121,6 +123,10 @@ private:
         if "FIXME" in attribute.extended_attributes:
             continue
         out.write(f"    JS_DECLARE_NATIVE_FUNCTION({attribute_getter_callback_name(attribute)});\n")
+        if attribute_has_fast_getter(interface, attribute):
+            out.write(
+                f"    static JS::ThrowCompletionOr<Optional<JS::Value>> {attribute_fast_getter_callback_name(attribute)}(JS::VM&, JS::Value this_value);\n"
+            )
         if attribute_has_setter(attribute):
             out.write(f"    JS_DECLARE_NATIVE_FUNCTION({attribute_setter_callback_name(attribute)});\n")
     for operations in overload_resolution.operation_overload_sets(interface).values():
@@ -226,7 +226,7 @@ void {interface.prototype_class}::initialize(JS::Realm& realm)
         named_and_indexed_properties.write_named_properties_object_implementation(out, includes, interface)
         global_mixins.write_global_mixin_implementation(out, context, includes, interface)
         return
-    attributes.define_the_regular_attributes(out, includes, interface)
+    attributes.define_the_regular_attributes(out, includes, interface, with_fast_getters=True)
     if interface.name == "CSSStyleProperties":
         includes.add("LibWeb/CSS/GeneratedCSSStyleProperties.h")
         out.write("    GeneratedCSSStyleProperties::initialize(realm, object);\n")
@@ -0,0 +1,132 @@
+#!/usr/bin/env python3
+
+# Compares two sets of benchmark results written by LibTest's --benchmark_json option, and flags the benchmarks that
+# got slower by more than the noise of the measurements.
+#
+# Example usage:
+#   ./Build/release/bin/BenchmarkContainers --bench --benchmark_repetitions 20 --benchmark_json baseline/
+#   git checkout my-change && ninja -C Build/release
+#   ./Build/release/bin/BenchmarkContainers --bench --benchmark_repetitions 20 --benchmark_json current/
+#   ./Meta/compare-benchmarks.py baseline/ current/
+
+import argparse
+import json
+import sys
+
+from pathlib import Path
+
+METRICS = {
+    "min": "min_ns",
+    "median": "median_ns",
+    "p95": "p95_ns",
+    "cycles": "cycles",
+    "instructions": "instructions",
+}
+
+
+def load_results(path):
+    path = Path(path)
+    files = sorted(path.glob("*.json")) if path.is_dir() else [path]
+
+    results = {}
+    for file in files:
+        with open(file, "r", encoding="utf-8") as f:
+            data = json.load(f)
+        for benchmark in data.get("benchmarks", []):
+            results[(data["suite"], benchmark["name"])] = benchmark
+    return results
+
+
+def relative_spread(benchmark):
+    # How far the slow iterations were from the typical one. A benchmark that is this noisy on its own can't be said
+    # to have regressed by less than that.
+    median = benchmark.get("median_ns", 0)
+    if median <= 0:
+        return 0.0
+    return (benchmark.get("p95_ns", median) - median) / median
+
+
+def format_value(value, metric):
+    if metric in ("cycles", "instructions"):
+        return f"{value:,}"
+    return f"{value / 1_000_000:.3f}ms"
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Compare two sets of LibTest benchmark results.")
+    parser.add_argument("baseline", help="JSON file, or directory of JSON files, with the baseline results")
+    parser.add_argument("current", help="JSON file, or directory of JSON files, with the results to check")
+    parser.add_argument(
+        "--threshold",
+        type=float,
+        default=0.05,
+        help="Smallest relative change that counts as a regression or an improvement (default 0.05)",
+    )
+    parser.add_argument(
+        "--metric", choices=METRICS.keys(), default="median", help="Statistic to compare (default median)"
+    )
+    parser.add_argument("--verbose", action="store_true", help="Also list the benchmarks that did not change")
+    args = parser.parse_args()
+
+    key = METRICS[args.metric]
+    baseline = load_results(args.baseline)
+    current = load_results(args.current)
+
+    regressions = []
+    improvements = []
+    unchanged = []
+    failures = []
+
+    for benchmark_id in sorted(baseline.keys() & current.keys()):
+        before = baseline[benchmark_id]
+        after = current[benchmark_id]
+
+        if after.get("result") != "Completed":
+            failures.append((benchmark_id, after.get("result")))
+            continue
+
+        if key not in before or key not in after or before[key] <= 0:
+            continue
+
+        change = (after[key] - before[key]) / before[key]
+        noise = max(args.threshold, relative_spread(before), relative_spread(after))
+        row = (benchmark_id, before[key], after[key], change, noise)
+
+        if change > noise:
+            regressions.append(row)
+        elif change < -noise:
+            improvements.append(row)
+        else:
+            unchanged.append(row)
+
+    def print_rows(title, rows):
+        if not rows:
+            return
+        print(f"{title}:")
+        for (suite, name), before, after, change, noise in rows:
+            print(
+                f"    {suite}::{name}: {format_value(before, args.metric)} -> {format_value(after, args.metric)} "
+                f"({change:+.1%}, noise {noise:.1%})"
+            )
+
+    print_rows("Regressions", regressions)
+    print_rows("Improvements", improvements)
+    if args.verbose:
+        print_rows("Unchanged", unchanged)
+
+    for (suite, name), result in failures:
+        print(f"Failed: {suite}::{name} ({result})")
+    for suite, name in sorted(baseline.keys() - current.keys()):
+        print(f"Missing from current results: {suite}::{name}")
+    for suite, name in sorted(current.keys() - baseline.keys()):
+        print(f"New benchmark: {suite}::{name}")
+
+    print(
+        f"{len(regressions)} regressed, {len(improvements)} improved, {len(unchanged)} unchanged, "
+        f"{len(failures)} failed."
+    )
+    return 1 if regressions or failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -5,6 +5,7 @@
  */
 
 #include <Compositor/BackingStoreManager.h>
+#include <Compositor/BackingStorePool.h>
 #include <LibGfx/PaintingSurface.h>
 #include <LibGfx/SharedImageBuffer.h>
 #include <LibGfx/SkiaBackendContext.h>
@@ -17,11 +18,6 @@
 
 namespace Compositor {
 
-struct BackingStorePair {
-    RefPtr<Gfx::PaintingSurface> front;
-    RefPtr<Gfx::PaintingSurface> back;
-};
-
 #ifdef USE_VULKAN
 static NonnullRefPtr<Gfx::PaintingSurface> create_gpu_painting_surface_with_bitmap_flush(Gfx::IntSize size, Gfx::SharedImageBuffer& buffer, RefPtr<Gfx::SkiaBackendContext> const& skia_backend_context)
 {
@@ -34,32 +30,21 @@ static NonnullRefPtr<Gfx::PaintingSurface> create_gpu_painting_surface_with_bitm
 }
 #endif
 
-static BackingStorePair create_shareable_bitmap_backing_stores([[maybe_unused]] Gfx::IntSize size, Gfx::SharedImageBuffer& front_buffer, Gfx::SharedImageBuffer& back_buffer, RefPtr<Gfx::SkiaBackendContext> const& skia_backend_context)
+static NonnullRefPtr<Gfx::PaintingSurface> create_shareable_bitmap_backing_store([[maybe_unused]] Gfx::IntSize size, Gfx::SharedImageBuffer& buffer, RefPtr<Gfx::SkiaBackendContext> const& skia_backend_context)
 {
 #ifdef AK_OS_MACOS
-    if (skia_backend_context) {
-        return {
-            .front = Gfx::PaintingSurface::create_from_shared_image_buffer(front_buffer, *skia_backend_context),
-            .back = Gfx::PaintingSurface::create_from_shared_image_buffer(back_buffer, *skia_backend_context),
-        };
-    }
+    if (skia_backend_context)
+        return Gfx::PaintingSurface::create_from_shared_image_buffer(buffer, *skia_backend_context);
 #else
 #    ifdef USE_VULKAN
-    if (skia_backend_context) {
-        return {
-            .front = create_gpu_painting_surface_with_bitmap_flush(size, front_buffer, skia_backend_context),
-            .back = create_gpu_painting_surface_with_bitmap_flush(size, back_buffer, skia_backend_context),
-        };
-    }
+    if (skia_backend_context)
+        return create_gpu_painting_surface_with_bitmap_flush(size, buffer, skia_backend_context);
 #    else
     (void)skia_backend_context;
 #    endif
 #endif
 
-    return {
-        .front = Gfx::PaintingSurface::wrap_bitmap(*front_buffer.bitmap()),
-        .back = Gfx::PaintingSurface::wrap_bitmap(*back_buffer.bitmap()),
-    };
+    return Gfx::PaintingSurface::wrap_bitmap(*buffer.bitmap());
 }
 
 #ifdef USE_VULKAN_DMABUF_IMAGES
@@ -88,6 +73,16 @@ static ErrorOr<DMABufBackingStorePair> create_linear_dmabuf_backing_stores(Gfx::
 }
 #endif
 
+BackingStoreManager::BackingStoreManager(BackingStorePool& pool)
+    : m_pool(pool)
+{
+}
+
+BackingStoreManager::~BackingStoreManager()
+{
+    release_backing_stores();
+}
+
 Optional<BackingStoreManager::Allocation> BackingStoreManager::resize_backing_stores_if_needed(
     Gfx::IntSize viewport_size, Web::Compositor::WindowResizingInProgress window_resize_in_progress)
 {
@@ -119,8 +114,27 @@ Optional<BackingStoreManager::Allocation> BackingStoreManager::resize_backing_st
 
 Optional<BackingStoreManager::Publication> BackingStoreManager::allocate_backing_stores(Allocation const& allocation, RefPtr<Gfx::SkiaBackendContext> const& skia_backend_context, bool should_publish)
 {
+    give_back_backing_stores();
+
+    if (!should_publish) {
+        // Nobody outside this process ever sees these stores, so any unused store of the right size will do.
+        auto take_or_create_backing_store = [&]() -> NonnullRefPtr<Gfx::PaintingSurface> {
+            if (auto surface = m_pool.take(allocation.size))
+                return surface.release_nonnull();
+            auto buffer = Gfx::SharedImageBuffer::create(allocation.size);
+            return create_shareable_bitmap_backing_store(allocation.size, buffer, skia_backend_context);
+        };
+        m_backing_stores.front_store = take_or_create_backing_store();
+        m_backing_stores.back_store = take_or_create_backing_store();
+        m_backing_stores.front_bitmap_id = allocation.front_bitmap_id;
+        m_backing_stores.back_bitmap_id = allocation.back_bitmap_id;
+        return {};
+    }
+
+    m_backing_stores.is_published = true;
+
 #ifdef USE_VULKAN_DMABUF_IMAGES
-    if (skia_backend_context && should_publish) {
+    if (skia_backend_context) {
         auto backing_stores = create_linear_dmabuf_backing_stores(allocation.size, *skia_backend_context);
         if (!backing_stores.is_error()) {
             auto backing_store_pair = backing_stores.release_value();
@@ -142,15 +156,11 @@ Optional<BackingStoreManager::Publication> BackingStoreManager::allocate_backing
     auto back_buffer = Gfx::SharedImageBuffer::create(allocation.size);
     auto front_shared_image = front_buffer.export_shared_image();
     auto back_shared_image = back_buffer.export_shared_image();
-    auto backing_store_pair = create_shareable_bitmap_backing_stores(allocation.size, front_buffer, back_buffer, skia_backend_context);
-    m_backing_stores.front_store = move(backing_store_pair.front);
-    m_backing_stores.back_store = move(backing_store_pair.back);
+    m_backing_stores.front_store = create_shareable_bitmap_backing_store(allocation.size, front_buffer, skia_backend_context);
+    m_backing_stores.back_store = create_shareable_bitmap_backing_store(allocation.size, back_buffer, skia_backend_context);
     m_backing_stores.front_bitmap_id = allocation.front_bitmap_id;
     m_backing_stores.back_bitmap_id = allocation.back_bitmap_id;
 
-    if (!should_publish)
-        return {};
-
     return Publication {
         .front_bitmap_id = allocation.front_bitmap_id,
         .front_shared_image = move(front_shared_image),
@@ -159,6 +169,23 @@ Optional<BackingStoreManager::Publication> BackingStoreManager::allocate_backing
     };
 }
 
+void BackingStoreManager::release_backing_stores()
+{
+    give_back_backing_stores();
+    m_allocated_size = {};
+}
+
+void BackingStoreManager::give_back_backing_stores()
+{
+    auto backing_stores = exchange(m_backing_stores, BackingStoreState {});
+    if (backing_stores.is_published)
+        return;
+    if (backing_stores.front_store)
+        m_pool.give_back(backing_stores.front_store.release_nonnull());
+    if (backing_stores.back_store)
+        m_pool.give_back(backing_stores.back_store.release_nonnull());
+}
+
 bool BackingStoreManager::is_valid() const
 {
     return m_backing_stores.is_valid();
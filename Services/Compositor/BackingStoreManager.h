@@ -17,6 +17,8 @@
 
 namespace Compositor {
 
+class BackingStorePool;
+
 class BackingStoreManager {
     AK_MAKE_NONCOPYABLE(BackingStoreManager);
     AK_MAKE_NONMOVABLE(BackingStoreManager);
@@ -34,12 +36,17 @@ public:
         Gfx::SharedImage back_shared_image;
     };
 
-    BackingStoreManager() = default;
+    explicit BackingStoreManager(BackingStorePool&);
+    ~BackingStoreManager();
 
     Optional<Allocation> resize_backing_stores_if_needed(
         Gfx::IntSize viewport_size, Web::Compositor::WindowResizingInProgress);
     Optional<Publication> allocate_backing_stores(Allocation const&, RefPtr<Gfx::SkiaBackendContext> const&, bool should_publish);
 
+    // Lets go of both stores, so that the next resize_backing_stores_if_needed() allocates new ones. Stores that were
+    // never published go back to the pool.
+    void release_backing_stores();
+
     bool is_valid() const;
     Gfx::PaintingSurface& front_store();
     Gfx::PaintingSurface& back_store();
@@ -52,10 +59,14 @@ private:
         RefPtr<Gfx::PaintingSurface> back_store;
         i32 front_bitmap_id { -1 };
         i32 back_bitmap_id { -1 };
+        bool is_published { false };
 
         bool is_valid() const { return front_store && back_store; }
     };
 
+    BackingStorePool& m_pool;
+    void give_back_backing_stores();
+
     int m_next_bitmap_id { 0 };
 
     // Used to track if backing stores need reallocation
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <Compositor/BackingStorePool.h>
+#include <LibCore/Timer.h>
+#include <LibGfx/PaintingSurface.h>
+
+namespace Compositor {
+
+static constexpr size_t maximum_pooled_size_in_bytes = 64 * MiB;
+static constexpr auto maximum_unused_time = AK::Duration::from_seconds(10);
+static constexpr int trim_interval_ms = 5000;
+
+static size_t size_in_bytes(Gfx::IntSize size)
+{
+    return static_cast<size_t>(size.width()) * static_cast<size_t>(size.height()) * sizeof(u32);
+}
+
+BackingStorePool::BackingStorePool()
+    : m_trim_timer(Core::Timer::create_repeating(trim_interval_ms, [this] {
+        drop_unused_surfaces();
+    }))
+{
+}
+
+BackingStorePool::~BackingStorePool()
+{
+    m_trim_timer->on_timeout = {};
+    m_trim_timer->stop();
+}
+
+RefPtr<Gfx::PaintingSurface> BackingStorePool::take(Gfx::IntSize size)
+{
+    // Prefer the most recently returned store, which is the likeliest to still be warm.
+    for (size_t i = m_surfaces.size(); i > 0; --i) {
+        if (m_surfaces[i - 1].surface->size() != size)
+            continue;
+        auto surface = m_surfaces.take(i - 1).surface;
+        m_size_in_bytes -= size_in_bytes(size);
+        if (m_surfaces.is_empty())
+            m_trim_timer->stop();
+        return surface;
+    }
+    return nullptr;
+}
+
+void BackingStorePool::give_back(NonnullRefPtr<Gfx::PaintingSurface> surface)
+{
+    auto surface_size_in_bytes = size_in_bytes(surface->size());
+    if (surface_size_in_bytes > maximum_pooled_size_in_bytes)
+        return;
+
+    while (m_size_in_bytes + surface_size_in_bytes > maximum_pooled_size_in_bytes)
+        evict_oldest();
+
+    m_surfaces.append({ move(surface), MonotonicTime::now() });
+    m_size_in_bytes += surface_size_in_bytes;
+    if (!m_trim_timer->is_active())
+        m_trim_timer->start();
+}
+
+void BackingStorePool::evict_oldest()
+{
+    VERIFY(!m_surfaces.is_empty());
+    auto pooled_surface = m_surfaces.take_first();
+    m_size_in_bytes -= size_in_bytes(pooled_surface.surface->size());
+}
+
+void BackingStorePool::drop_unused_surfaces()
+{
+    auto now = MonotonicTime::now();
+    while (!m_surfaces.is_empty() && now - m_surfaces.first().returned_at >= maximum_unused_time)
+        evict_oldest();
+    if (m_surfaces.is_empty())
+        m_trim_timer->stop();
+}
+
+}
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Noncopyable.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/RefPtr.h>
+#include <AK/Time.h>
+#include <AK/Vector.h>
+#include <LibCore/Forward.h>
+#include <LibGfx/Forward.h>
+#include <LibGfx/Size.h>
+
+namespace Compositor {
+
+// Backing stores that no context is using anymore, kept around for a little while so that the next context that needs
+// a store of the same size (an iframe being replaced by one just like it, say) doesn't have to allocate one. Only
+// stores that were never shared with the UI process end up here, since the UI may still be showing a shared one.
+class BackingStorePool {
+    AK_MAKE_NONCOPYABLE(BackingStorePool);
+    AK_MAKE_NONMOVABLE(BackingStorePool);
+
+public:
+    BackingStorePool();
+    ~BackingStorePool();
+
+    RefPtr<Gfx::PaintingSurface> take(Gfx::IntSize);
+    void give_back(NonnullRefPtr<Gfx::PaintingSurface>);
+
+    size_t size_in_bytes() const { return m_size_in_bytes; }
+
+private:
+    struct PooledSurface {
+        NonnullRefPtr<Gfx::PaintingSurface> surface;
+        MonotonicTime returned_at;
+    };
+
+    void evict_oldest();
+    void drop_unused_surfaces();
+
+    Vector<PooledSurface> m_surfaces;
+    size_t m_size_in_bytes { 0 };
+    RefPtr<Core::Timer> m_trim_timer;
+};
+
+}
@@ -9,6 +9,7 @@
 #include <Compositor/CompositorState.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Timer.h>
+#include <LibCore/TraceEvent.h>
 
 namespace Compositor {
 
@@ -70,7 +71,7 @@ void CompositorState::create_context(Web::Compositor::CompositorContextId contex
         VERIFY(context_id == Web::Compositor::compositor_context_id_for_page(*page_id));
 
     auto& context = *m_contexts.ensure(context_id, [&] {
-        return make<ContextState>(page_id, web_content_client, m_async_scrolling_enabled);
+        return make<ContextState>(page_id, web_content_client, m_backing_store_pool, m_async_scrolling_enabled);
     });
     resize_backing_stores_if_needed(context_id, context);
 }
@@ -133,6 +134,14 @@ void CompositorState::update_visual_context_tree(Web::Compositor::CompositorCont
     context->update_visual_context_tree(move(visual_context_tree));
 }
 
+void CompositorState::update_async_animations(Web::Compositor::CompositorContextId context_id, Vector<Web::Compositor::AsyncAnimation> async_animations)
+{
+    auto* context = context_if_present(context_id);
+    VERIFY(context);
+
+    context->update_async_animations(move(async_animations));
+}
+
 void CompositorState::update_scroll_state(Web::Compositor::CompositorContextId context_id, Web::Painting::ScrollStateSnapshot&& scroll_state_snapshot)
 {
     auto* context = context_if_present(context_id);
@@ -277,6 +286,8 @@ void CompositorState::present_frame(Web::Compositor::CompositorContextId context
 
 void CompositorState::present_frame(Web::Compositor::CompositorContextId context_id, ContextState& context, Gfx::IntRect viewport_rect)
 {
+    Core::TraceEventScope trace_event { "compositor"sv, "Present frame"sv };
+    ensure_backing_stores(context_id, context);
     auto prepared_frame = context.prepare_frame(*m_display_list_player, viewport_rect);
     if (!prepared_frame.has_value())
         return;
@@ -292,6 +303,13 @@ void CompositorState::present_frame(Web::Compositor::CompositorContextId context
         });
     });
     context.did_submit_prepared_frame(viewport_rect);
+    context.schedule_idle_backing_store_release([this, context_id] {
+        release_idle_backing_stores(context_id);
+    });
+
+    // Animations that run here keep presenting frames on their own, without waiting for WebContent to ask.
+    if (context.has_running_async_animations())
+        context.queue_present_frame(viewport_rect);
     schedule_gpu_completion_check();
 }
 
@@ -326,6 +344,7 @@ VSyncScheduler& CompositorState::vsync_scheduler_for_display(Optional<u64> displ
 
 void CompositorState::present_pending_frames_on_vsync(Optional<u64> display_id)
 {
+    auto vsync_time = MonotonicTime::now();
     for (auto& context_entry : m_contexts) {
         auto context_id = context_entry.key;
         auto& context = *context_entry.value;
@@ -336,6 +355,7 @@ void CompositorState::present_pending_frames_on_vsync(Optional<u64> display_id)
         if (!pending_present_frame.has_value())
             continue;
         present_frame(context_id, context, *pending_present_frame);
+        context.did_present_frame_on_vsync(vsync_time);
     }
 }
 
@@ -371,6 +391,13 @@ bool CompositorState::present_subtree_for_screenshot(Web::Compositor::Compositor
 
 void CompositorState::present_context_synchronously(ContextState& context)
 {
+    // Only contexts that publish to a parent surface are presented synchronously, and their stores are never shared
+    // with the UI process, so there's nothing to publish.
+    if (!context.has_backing_stores()) {
+        auto publication = context.resize_backing_stores_if_needed(m_skia_backend_context);
+        VERIFY(!publication.has_value());
+    }
+
     auto publish_mode = context.present_synchronously(*m_display_list_player);
     if (publish_mode.has_value())
         publish_to_parent_surface(context, *publish_mode);
@@ -409,6 +436,7 @@ void CompositorState::did_finish_async_present(PendingAsyncPresent& pending_pres
             break;
     }
     VERIFY(pending_present_iterator != m_pending_async_presents.end());
+    Core::record_trace_event("compositor"sv, "Flush to GPU"sv, pending_present.submitted_at, MonotonicTime::now());
 
     auto context_id = pending_present.context_id;
     auto viewport_rect = pending_present.viewport_rect;
@@ -526,6 +554,29 @@ void CompositorState::resize_backing_stores_if_needed(Web::Compositor::Composito
     }
 }
 
+void CompositorState::ensure_backing_stores(Web::Compositor::CompositorContextId context_id, ContextState& context)
+{
+    if (context.has_backing_stores())
+        return;
+    if (auto publication = context.resize_backing_stores_if_needed(m_skia_backend_context); publication.has_value())
+        publish_backing_stores(context_id, context, publication.release_value());
+}
+
+void CompositorState::release_idle_backing_stores(Web::Compositor::CompositorContextId context_id)
+{
+    auto* context = context_if_present(context_id);
+    if (!context)
+        return;
+
+    if (!context->can_release_backing_stores()) {
+        context->schedule_idle_backing_store_release([this, context_id] {
+            release_idle_backing_stores(context_id);
+        });
+        return;
+    }
+    context->release_backing_stores();
+}
+
 void CompositorState::schedule_backing_store_shrink(Web::Compositor::CompositorContextId context_id, ContextState& context)
 {
     context.schedule_backing_store_shrink([this, context_id] {
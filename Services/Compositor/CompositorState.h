@@ -12,6 +12,8 @@
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <AK/RefCounted.h>
+#include <AK/Time.h>
+#include <Compositor/BackingStorePool.h>
 #include <Compositor/ContextState.h>
 #include <Compositor/VSyncScheduler.h>
 #include <LibCore/Forward.h>
@@ -51,6 +53,7 @@ public:
 
     virtual void dispatch_mouse_event_to_web_content(u64 page_id, Web::MouseEvent const&) = 0;
     virtual void request_rendering_update() = 0;
+    virtual void did_present_frame(u64 page_id, MonotonicTime vsync_time, double refresh_rate) = 0;
 };
 
 class CompositorState final : public RefCounted<CompositorState> {
@@ -75,6 +78,7 @@ public:
     void stop_presenting_to_client(Web::Compositor::CompositorContextId);
     void update_display_list(Web::Compositor::CompositorContextId, NonnullRefPtr<Web::Painting::DisplayList>, Web::Painting::AccumulatedVisualContextTree, Web::Painting::DisplayListResourceTransaction&&, Web::Painting::ScrollStateSnapshot&&);
     void update_visual_context_tree(Web::Compositor::CompositorContextId, Web::Painting::AccumulatedVisualContextTree);
+    void update_async_animations(Web::Compositor::CompositorContextId, Vector<Web::Compositor::AsyncAnimation>);
     void update_scroll_state(Web::Compositor::CompositorContextId, Web::Painting::ScrollStateSnapshot&&);
     void update_video_frame(Web::Compositor::CompositorContextId, Web::Painting::VideoFrameResourceId, NonnullRefPtr<Media::VideoFrame const>);
     void clear_video_frame(Web::Compositor::CompositorContextId, Web::Painting::VideoFrameResourceId);
@@ -108,6 +112,7 @@ private:
         Gfx::IntRect viewport_rect;
         i32 bitmap_id { 0 };
         bool was_cancelled { false };
+        MonotonicTime submitted_at { MonotonicTime::now() };
     };
 
     ContextState* context_if_present(Web::Compositor::CompositorContextId);
@@ -137,7 +142,11 @@ private:
     void cancel_pending_async_presents_for_context(Web::Compositor::CompositorContextId);
     void schedule_gpu_completion_check();
     void check_gpu_completions();
+    void ensure_backing_stores(Web::Compositor::CompositorContextId, ContextState&);
+    void release_idle_backing_stores(Web::Compositor::CompositorContextId);
 
+    // Declared before the contexts, so that it outlives them and they can give their stores back when destroyed.
+    BackingStorePool m_backing_store_pool;
     HashMap<Web::Compositor::CompositorContextId, OwnPtr<ContextState>> m_contexts;
     DoublyLinkedList<PendingAsyncPresent> m_pending_async_presents;
     RefPtr<Gfx::SkiaBackendContext> m_skia_backend_context;
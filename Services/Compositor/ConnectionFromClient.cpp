@@ -9,6 +9,7 @@
 #include <Compositor/ConnectionFromWebContent.h>
 #include <LibCore/Process.h>
 #include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
 #include <LibIPC/Transport.h>
 
 namespace Compositor {
@@ -99,6 +100,11 @@ void ConnectionFromClient::presented_bitmap_ready_to_paint(Web::Compositor::Comp
     m_compositor_state->presented_bitmap_ready_to_paint(context_id, bitmap_id);
 }
 
+void ConnectionFromClient::set_trace_event_buffer(Core::AnonymousBuffer trace_event_buffer)
+{
+    Core::set_trace_event_buffer(move(trace_event_buffer));
+}
+
 void ConnectionFromClient::crash()
 {
     warnln("Crashing Compositor process by request from Browser");
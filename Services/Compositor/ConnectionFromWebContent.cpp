@@ -33,6 +33,11 @@ void ConnectionFromWebContent::request_rendering_update()
     async_request_rendering_update();
 }
 
+void ConnectionFromWebContent::did_present_frame(u64 page_id, MonotonicTime vsync_time, double refresh_rate)
+{
+    async_did_present_frame(page_id, vsync_time.nanoseconds(), refresh_rate);
+}
+
 void ConnectionFromWebContent::dispatch_mouse_event_to_web_content(u64 page_id, Web::MouseEvent const& event)
 {
     async_mouse_event(page_id, event);
@@ -77,6 +82,12 @@ void ConnectionFromWebContent::update_visual_context_tree(Web::Compositor::Compo
     m_compositor_state->update_visual_context_tree(context_id, move(visual_context_tree));
 }
 
+void ConnectionFromWebContent::update_async_animations(Web::Compositor::CompositorContextId context_id, Vector<Web::Compositor::AsyncAnimation> async_animations)
+{
+    verify_context_is_owned_by_this_connection(context_id);
+    m_compositor_state->update_async_animations(context_id, move(async_animations));
+}
+
 void ConnectionFromWebContent::update_scroll_state(Web::Compositor::CompositorContextId context_id, Web::Painting::ScrollStateSnapshot scroll_state_snapshot)
 {
     verify_context_is_owned_by_this_connection(context_id);
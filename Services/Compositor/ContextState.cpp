@@ -9,10 +9,13 @@
 #include <Compositor/CompositorState.h>
 #include <Compositor/ContextState.h>
 #include <LibCore/Timer.h>
+#include <LibCore/TraceEvent.h>
 #include <LibGfx/Color.h>
 #include <LibGfx/PainterSkia.h>
 #include <LibGfx/PaintingSurface.h>
+#include <LibGfx/Path.h>
 #include <LibWeb/Page/InputEvent.h>
+#include <LibWeb/Painting/DisplayListDamage.h>
 #include <LibWeb/Painting/DisplayListPlayerSkia.h>
 
 namespace Compositor {
@@ -31,10 +34,11 @@ static void set_or_append_pending_scroll_offset(
     pending_scroll_offsets.append(scroll_offset);
 }
 
-ContextState::ContextState(Optional<u64> page_id, CompositorStateWebContentClient& web_content_client, bool async_scrolling_enabled)
+ContextState::ContextState(Optional<u64> page_id, CompositorStateWebContentClient& web_content_client, BackingStorePool& backing_store_pool, bool async_scrolling_enabled)
     : m_web_content_client(web_content_client)
     , m_page_id(page_id)
     , m_async_scrolling_enabled(async_scrolling_enabled)
+    , m_backing_store_manager(backing_store_pool)
 {
     if (page_id.has_value())
         m_presentation_mode = Web::Compositor::PresentToClient {};
@@ -43,6 +47,7 @@ ContextState::ContextState(Optional<u64> page_id, CompositorStateWebContentClien
 ContextState::~ContextState()
 {
     stop_backing_store_shrink_timer();
+    stop_backing_store_release_timer();
 }
 
 bool ContextState::presentation_mode_presents_to_client(Web::Compositor::PresentationMode const& presentation_mode)
@@ -60,6 +65,14 @@ void ContextState::request_rendering_update()
     m_web_content_client.request_rendering_update();
 }
 
+void ContextState::did_present_frame_on_vsync(MonotonicTime vsync_time)
+{
+    // Only the page's own context is paced, since nested navigables are painted in the same rendering update.
+    if (!m_page_id.has_value())
+        return;
+    m_web_content_client.did_present_frame(*m_page_id, vsync_time, m_display_refresh_rate);
+}
+
 void ContextState::dispatch_mouse_event_to_web_content(Web::MouseEvent const& event)
 {
     VERIFY(m_page_id.has_value());
@@ -123,6 +136,8 @@ Vector<ContextState::ChildSurface> ContextState::child_contexts() const
 
 void ContextState::apply_display_list_resource_transaction(Web::Painting::DisplayListResourceTransaction&& resource_transaction)
 {
+    if (!resource_transaction.is_empty())
+        ++m_resource_generation;
     m_display_list_resource_storage.apply_transaction(move(resource_transaction));
 }
 
@@ -135,6 +150,7 @@ void ContextState::install_display_list_update(
     m_display_list = move(display_list);
     m_visual_context_tree = move(visual_context_tree);
     m_scroll_state_snapshot = move(scroll_state_snapshot);
+    update_async_animations({});
 
     if (!m_async_scrolling_enabled)
         return;
@@ -167,11 +183,18 @@ void ContextState::update_visual_context_tree(Web::Painting::AccumulatedVisualCo
     VERIFY(m_display_list);
     VERIFY(m_display_list->compatible_visual_context_tree_version() == visual_context_tree.version());
     m_visual_context_tree = move(visual_context_tree);
+    update_async_animations({});
 
     if (m_has_async_scrolling_state)
         rebuild_wheel_hit_test_targets();
 }
 
+void ContextState::update_async_animations(Vector<Web::Compositor::AsyncAnimation> async_animations)
+{
+    m_async_animations = move(async_animations);
+    m_has_running_async_animations = !m_async_animations.is_empty();
+}
+
 void ContextState::update_scroll_state(Web::Painting::ScrollStateSnapshot&& scroll_state_snapshot)
 {
     m_scroll_state_snapshot = move(scroll_state_snapshot);
@@ -190,21 +213,25 @@ void ContextState::update_scroll_state(Web::Painting::ScrollStateSnapshot&& scro
 void ContextState::update_video_frame(Web::Painting::VideoFrameResourceId frame_id, NonnullRefPtr<Media::VideoFrame const> frame)
 {
     m_display_list_resource_storage.update_video_frame(frame_id, move(frame));
+    ++m_resource_generation;
 }
 
 void ContextState::clear_video_frame(Web::Painting::VideoFrameResourceId frame_id)
 {
     m_display_list_resource_storage.clear_video_frame(frame_id);
+    ++m_resource_generation;
 }
 
 void ContextState::update_compositor_surface(Web::Painting::CompositorSurfaceId surface_id, Gfx::SharedImage&& shared_image)
 {
     m_display_list_resource_storage.update_compositor_surface(surface_id, move(shared_image));
+    ++m_resource_generation;
 }
 
 void ContextState::clear_compositor_surface(Web::Painting::CompositorSurfaceId surface_id)
 {
     m_display_list_resource_storage.clear_compositor_surface(surface_id);
+    ++m_resource_generation;
 }
 
 Gfx::SharedImage ContextState::snapshot_front_store()
@@ -406,6 +433,31 @@ void ContextState::schedule_backing_store_shrink(Function<void()> on_timeout)
     m_backing_store_shrink_timer->restart();
 }
 
+void ContextState::schedule_idle_backing_store_release(Function<void()> on_timeout)
+{
+    // A context that hasn't presented for this long is most likely a background tab or an iframe scrolled out of
+    // view. The UI process keeps showing what it was last sent, so the stores only come back for the next frame.
+    static constexpr int idle_backing_store_release_delay_ms = 30'000;
+    if (!m_backing_store_release_timer)
+        m_backing_store_release_timer = Core::Timer::create_single_shot(idle_backing_store_release_delay_ms, move(on_timeout));
+    m_backing_store_release_timer->restart();
+}
+
+bool ContextState::can_release_backing_stores() const
+{
+    return m_backing_store_manager.is_valid()
+        && !is_present_blocked()
+        && !m_pending_present_frame.has_value()
+        && m_window_resize_in_progress == Web::Compositor::WindowResizingInProgress::No;
+}
+
+void ContextState::release_backing_stores()
+{
+    VERIFY(can_release_backing_stores());
+    m_backing_store_manager.release_backing_stores();
+    m_painted_content_by_bitmap_id.clear();
+}
+
 void ContextState::finish_window_resize()
 {
     m_window_resize_in_progress = Web::Compositor::WindowResizingInProgress::No;
@@ -416,6 +468,7 @@ Optional<BackingStoreManager::Publication> ContextState::resize_backing_stores_i
     auto allocation = m_backing_store_manager.resize_backing_stores_if_needed(m_viewport_size, m_window_resize_in_progress);
     if (!allocation.has_value())
         return {};
+    m_painted_content_by_bitmap_id.clear();
     return m_backing_store_manager.allocate_backing_stores(*allocation, skia_backend_context, presents_to_client());
 }
 
@@ -489,14 +542,7 @@ Optional<ContextState::PreparedFrame> ContextState::prepare_frame(Web::Painting:
     }
 
     auto& back_store = m_backing_store_manager.back_store();
-    m_presentation_mode.visit(
-        [](Empty const&) {},
-        [](Web::Compositor::PresentToClient const&) {},
-        [&](Web::Compositor::PublishToCompositorSurface const&) {
-            Gfx::PainterSkia painter { NonnullRefPtr<Gfx::PaintingSurface> { back_store } };
-            painter.clear_rect(back_store.rect().to_type<float>(), Gfx::Color::Transparent);
-        });
-    paint_current_display_list(display_list_player, back_store);
+    paint_back_store(display_list_player);
 
     auto rendered_bitmap_id = m_backing_store_manager.back_bitmap_id();
     m_gpu_present_bitmap_id_awaiting_completion = rendered_bitmap_id;
@@ -531,11 +577,7 @@ Optional<Web::Compositor::PublishToCompositorSurface> ContextState::present_sync
         return {};
 
     auto& back_store = m_backing_store_manager.back_store();
-    {
-        Gfx::PainterSkia painter { NonnullRefPtr<Gfx::PaintingSurface> { back_store } };
-        painter.clear_rect(back_store.rect().to_type<float>(), Gfx::Color::Transparent);
-    }
-    paint_current_display_list(display_list_player, back_store);
+    paint_back_store(display_list_player);
     display_list_player.flush(back_store);
     m_backing_store_manager.swap();
     m_presented_frame = viewport_rect;
@@ -553,6 +595,7 @@ void ContextState::paint_screenshot(Web::Painting::DisplayListPlayerSkia& displa
 {
     VERIFY(can_paint_screenshot(target_bitmap));
 
+    sample_async_animations();
     auto target_surface = Gfx::PaintingSurface::wrap_bitmap(*target_bitmap.bitmap());
     paint_current_display_list(display_list_player, *target_surface);
     display_list_player.flush(*target_surface);
@@ -581,6 +624,14 @@ void ContextState::stop_backing_store_shrink_timer()
     m_backing_store_shrink_timer->stop();
 }
 
+void ContextState::stop_backing_store_release_timer()
+{
+    if (!m_backing_store_release_timer)
+        return;
+    m_backing_store_release_timer->on_timeout = {};
+    m_backing_store_release_timer->stop();
+}
+
 Web::Painting::AccumulatedVisualContextTree const& ContextState::current_visual_context_tree() const
 {
     VERIFY(m_display_list);
@@ -675,4 +726,89 @@ void ContextState::paint_current_display_list(Web::Painting::DisplayListPlayerSk
     m_viewport_scrollbar_controller.paint(surface, display_list_player, m_scroll_state_snapshot);
 }
 
+Optional<Gfx::IntRect> ContextState::damage_since_last_paint(i32 bitmap_id) const
+{
+    auto it = m_painted_content_by_bitmap_id.find(bitmap_id);
+    if (it == m_painted_content_by_bitmap_id.end())
+        return {};
+
+    auto const& painted = it->value;
+    if (painted.resource_generation != m_resource_generation
+        || painted.publishes_to_parent_surface != publishes_to_parent_surface()
+        || painted.scroll_state_snapshot.device_offsets() != m_scroll_state_snapshot.device_offsets())
+        return {};
+
+    auto damage = Web::Painting::compute_display_list_damage(
+        *painted.display_list,
+        painted.visual_context_tree,
+        *m_display_list,
+        current_visual_context_tree(),
+        m_scroll_state_snapshot);
+    if (!damage.has_value())
+        return {};
+
+    // Viewport scrollbars are drawn over the content from compositor-side hover and drag state, so their area is
+    // always repainted.
+    damage->unite(painted.viewport_scrollbar_rect);
+    damage->unite(m_viewport_scrollbar_controller.painted_rect(m_scroll_state_snapshot));
+    return damage;
+}
+
+// A back store still holds the frame from two presents ago, so only what changed since then needs repainting, with
+// everything else left as it is. A blinking caret costs a few glyphs instead of the whole viewport.
+void ContextState::paint_back_store(Web::Painting::DisplayListPlayerSkia& display_list_player)
+{
+    Core::TraceEventScope trace_event { "compositor"sv, "Rasterize display list"sv };
+    sample_async_animations();
+
+    auto& back_store = m_backing_store_manager.back_store();
+    auto bitmap_id = m_backing_store_manager.back_bitmap_id();
+    auto surface_rect = back_store.rect();
+
+    auto damage = damage_since_last_paint(bitmap_id);
+    auto repaint_rect = damage.has_value() ? damage->intersected(surface_rect) : surface_rect;
+
+    if (!repaint_rect.is_empty()) {
+        Gfx::PainterSkia painter { NonnullRefPtr<Gfx::PaintingSurface> { back_store } };
+        if (repaint_rect != surface_rect) {
+            Gfx::Path clip;
+            clip.move_to(repaint_rect.top_left().to_type<float>());
+            clip.line_to(repaint_rect.top_right().to_type<float>());
+            clip.line_to(repaint_rect.bottom_right().to_type<float>());
+            clip.line_to(repaint_rect.bottom_left().to_type<float>());
+            clip.close();
+            painter.clip(clip, Gfx::WindingRule::Nonzero);
+        }
+        if (Web::Painting::TiledDisplayListRasterizer::can_rasterize_in_tiles(*m_display_list, m_display_list_resource_storage, back_store, repaint_rect)) {
+            auto background = publishes_to_parent_surface()
+                ? Web::Painting::TiledDisplayListRasterizer::TileBackground::Transparent
+                : Web::Painting::TiledDisplayListRasterizer::TileBackground::Target;
+            m_tiled_rasterizer.rasterize(*m_display_list, current_visual_context_tree(), m_display_list_resource_storage, m_scroll_state_snapshot, back_store, repaint_rect, background);
+            m_viewport_scrollbar_controller.paint(back_store, display_list_player, m_scroll_state_snapshot);
+        } else {
+            if (publishes_to_parent_surface())
+                painter.clear_rect(repaint_rect.to_type<float>(), Gfx::Color::Transparent);
+            paint_current_display_list(display_list_player, back_store);
+        }
+        painter.reset();
+    }
+
+    m_painted_content_by_bitmap_id.set(bitmap_id,
+        PaintedContent {
+            .display_list = m_display_list,
+            .visual_context_tree = current_visual_context_tree(),
+            .scroll_state_snapshot = m_scroll_state_snapshot,
+            .resource_generation = m_resource_generation,
+            .publishes_to_parent_surface = publishes_to_parent_surface(),
+            .viewport_scrollbar_rect = m_viewport_scrollbar_controller.painted_rect(m_scroll_state_snapshot),
+        });
+}
+
+void ContextState::sample_async_animations()
+{
+    if (m_async_animations.is_empty() || !m_visual_context_tree.has_value())
+        return;
+    m_has_running_async_animations = Web::Compositor::apply_async_animations(m_async_animations, *m_visual_context_tree, m_scroll_state_snapshot, MonotonicTime::now());
+}
+
 }
@@ -12,6 +12,7 @@
 #include <AK/NonnullRefPtr.h>
 #include <AK/Optional.h>
 #include <AK/RefPtr.h>
+#include <AK/Time.h>
 #include <AK/Vector.h>
 #include <Compositor/BackingStoreManager.h>
 #include <Compositor/ViewportScrollbarController.h>
@@ -22,6 +23,7 @@
 #include <LibGfx/ShareableBitmap.h>
 #include <LibGfx/SharedImage.h>
 #include <LibGfx/Size.h>
+#include <LibWeb/Compositor/AsyncAnimations.h>
 #include <LibWeb/Compositor/AsyncScrollTree.h>
 #include <LibWeb/Compositor/AsyncScrollingState.h>
 #include <LibWeb/Compositor/Types.h>
@@ -30,6 +32,7 @@
 #include <LibWeb/Painting/DisplayList.h>
 #include <LibWeb/Painting/DisplayListResourceStorage.h>
 #include <LibWeb/Painting/ScrollState.h>
+#include <LibWeb/Painting/TiledDisplayListRasterizer.h>
 
 namespace Gfx {
 
@@ -51,6 +54,7 @@ class DisplayListPlayerSkia;
 
 namespace Compositor {
 
+class BackingStorePool;
 class CompositorStateWebContentClient;
 
 class ContextState {
@@ -84,7 +88,7 @@ public:
         i32 bitmap_id { 0 };
     };
 
-    ContextState(Optional<u64> page_id, CompositorStateWebContentClient&, bool async_scrolling_enabled);
+    ContextState(Optional<u64> page_id, CompositorStateWebContentClient&, BackingStorePool&, bool async_scrolling_enabled);
     ~ContextState();
 
     static bool presentation_mode_presents_to_client(Web::Compositor::PresentationMode const&);
@@ -92,6 +96,7 @@ public:
     bool is_owned_by(CompositorStateWebContentClient const&) const;
     void request_rendering_update();
     void dispatch_mouse_event_to_web_content(Web::MouseEvent const&);
+    void did_present_frame_on_vsync(MonotonicTime vsync_time);
 
     bool presents_to_client() const { return presentation_mode_presents_to_client(m_presentation_mode); }
     bool publishes_to_parent_surface() const { return m_presentation_mode.has<Web::Compositor::PublishToCompositorSurface>(); }
@@ -112,6 +117,8 @@ public:
         Web::Painting::AccumulatedVisualContextTree,
         Web::Painting::ScrollStateSnapshot&&);
     void update_visual_context_tree(Web::Painting::AccumulatedVisualContextTree);
+    void update_async_animations(Vector<Web::Compositor::AsyncAnimation>);
+    bool has_running_async_animations() const { return m_has_running_async_animations; }
     void update_scroll_state(Web::Painting::ScrollStateSnapshot&&);
     void update_video_frame(Web::Painting::VideoFrameResourceId, NonnullRefPtr<Media::VideoFrame const>);
     void clear_video_frame(Web::Painting::VideoFrameResourceId);
@@ -136,6 +143,10 @@ public:
     void schedule_backing_store_shrink(Function<void()>);
     void finish_window_resize();
     Optional<BackingStoreManager::Publication> resize_backing_stores_if_needed(RefPtr<Gfx::SkiaBackendContext> const&);
+    bool has_backing_stores() const { return m_backing_store_manager.is_valid(); }
+    void schedule_idle_backing_store_release(Function<void()>);
+    bool can_release_backing_stores() const;
+    void release_backing_stores();
 
     bool set_display_metadata(Optional<u64> display_id, double refresh_rate);
     Optional<u64> display_id() const { return m_display_id; }
@@ -157,7 +168,18 @@ public:
     void did_finish_gpu_present(i32 bitmap_id);
 
 private:
+    // What a backing store was last painted with, so the next paint into that store only has to redo what changed.
+    struct PaintedContent {
+        RefPtr<Web::Painting::DisplayList const> display_list;
+        Web::Painting::AccumulatedVisualContextTree visual_context_tree;
+        Web::Painting::ScrollStateSnapshot scroll_state_snapshot;
+        u64 resource_generation { 0 };
+        bool publishes_to_parent_surface { false };
+        Gfx::IntRect viewport_scrollbar_rect;
+    };
+
     void stop_backing_store_shrink_timer();
+    void stop_backing_store_release_timer();
     Web::Painting::AccumulatedVisualContextTree const& current_visual_context_tree() const;
     Optional<Gfx::FloatPoint> viewport_scroll_offset_from(Vector<Web::Compositor::AsyncScrollOffset> const&) const;
     Optional<Gfx::FloatPoint> reapply_pending_async_scroll_offsets(Vector<Web::Compositor::AsyncScrollOffset> const&);
@@ -167,6 +189,9 @@ private:
     bool is_present_blocked() const;
     bool can_render_frame() const;
     void paint_current_display_list(Web::Painting::DisplayListPlayerSkia&, Gfx::PaintingSurface&);
+    Optional<Gfx::IntRect> damage_since_last_paint(i32 bitmap_id) const;
+    void paint_back_store(Web::Painting::DisplayListPlayerSkia&);
+    void sample_async_animations();
 
     CompositorStateWebContentClient& m_web_content_client;
     Optional<u64> m_page_id;
@@ -181,6 +206,16 @@ private:
     Web::Painting::DisplayListResourceStorage m_display_list_resource_storage;
     Web::Painting::ScrollStateSnapshot m_scroll_state_snapshot;
     BackingStoreManager m_backing_store_manager;
+    HashMap<i32, PaintedContent> m_painted_content_by_bitmap_id;
+    // Bumped whenever something a display list refers to by ID changes, since that changes pixels the display list
+    // diff can't see.
+    u64 m_resource_generation { 0 };
+    Web::Painting::TiledDisplayListRasterizer m_tiled_rasterizer;
+
+    // Sampled into the visual context tree before each paint. They refer to nodes by index, so they only ever
+    // belong to the tree that WebContent sent just before them.
+    Vector<Web::Compositor::AsyncAnimation> m_async_animations;
+    bool m_has_running_async_animations { false };
 
     Web::Compositor::AsyncScrollTree m_async_scroll_tree;
     ViewportScrollbarController m_viewport_scrollbar_controller;
@@ -197,6 +232,7 @@ private:
     Gfx::IntSize m_viewport_size;
     Web::Compositor::WindowResizingInProgress m_window_resize_in_progress { Web::Compositor::WindowResizingInProgress::No };
     RefPtr<Core::Timer> m_backing_store_shrink_timer;
+    RefPtr<Core::Timer> m_backing_store_release_timer;
     Optional<u64> m_display_id;
     double m_display_refresh_rate { 60.0 };
 
@@ -7,6 +7,7 @@
 #include <AK/Assertions.h>
 #include <AK/Math.h>
 #include <AK/Platform.h>
+#include <AK/Time.h>
 #include <Compositor/VSyncScheduler.h>
 #include <LibCore/Timer.h>
 
@@ -48,12 +49,21 @@ public:
         if (m_timer->is_active())
             return;
 
-        m_timer->restart(fallback_interval_ms());
+        // Tick on the same cadence as the previous ticks instead of a full interval from now, so that a frame which
+        // arrives between ticks waits for the next one rather than for an interval of its own, and so that WebContent
+        // can predict when the next tick will happen.
+        auto delay_ms = 0;
+        if (m_last_tick_time.has_value()) {
+            auto since_last_tick_ms = (MonotonicTime::now() - *m_last_tick_time).to_milliseconds();
+            delay_ms = max(0, fallback_interval_ms() - static_cast<int>(since_last_tick_ms));
+        }
+        m_timer->restart(delay_ms);
     }
 
 private:
     void fire()
     {
+        m_last_tick_time = MonotonicTime::now();
         m_tick_callback();
     }
 
@@ -65,6 +75,7 @@ private:
 
     Function<void()> m_tick_callback;
     double m_refresh_rate { 60.0 };
+    Optional<MonotonicTime> m_last_tick_time;
     RefPtr<Core::Timer> m_timer;
 };
 
@@ -235,6 +235,18 @@ bool ViewportScrollbarController::paint(Gfx::PaintingSurface& surface, Web::Pain
     return true;
 }
 
+Gfx::IntRect ViewportScrollbarController::painted_rect(Web::Painting::ScrollStateSnapshot const& scroll_state_snapshot) const
+{
+    Gfx::IntRect rect;
+    for (auto const& scrollbar : m_scrollbars) {
+        for (auto expanded : { false, true }) {
+            rect.unite(scrollbar_gutter_rect(scrollbar, expanded));
+            rect.unite(translated_thumb_rect(scrollbar, scroll_state_snapshot, expanded));
+        }
+    }
+    return rect;
+}
+
 bool ViewportScrollbarController::is_expanded(size_t scrollbar_index) const
 {
     return m_hovered_scrollbar_index == scrollbar_index || m_captured_scrollbar_index == scrollbar_index;
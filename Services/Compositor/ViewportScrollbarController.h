@@ -10,6 +10,7 @@
 #include <AK/Vector.h>
 #include <LibGfx/Forward.h>
 #include <LibGfx/Point.h>
+#include <LibGfx/Rect.h>
 #include <LibWeb/Compositor/AsyncScrollingState.h>
 
 namespace Web::Compositor {
@@ -55,6 +56,9 @@ public:
     Optional<ScrollDelta> scroll_delta_for_drag(Web::Compositor::AsyncScrollTree const&, Web::Painting::ScrollStateSnapshot const&, Drag const&) const;
     bool paint(Gfx::PaintingSurface&, Web::Painting::DisplayListPlayerSkia&, Web::Painting::ScrollStateSnapshot const&) const;
 
+    // Everything paint() can touch for this scroll state, whether or not a scrollbar is hovered or captured.
+    Gfx::IntRect painted_rect(Web::Painting::ScrollStateSnapshot const&) const;
+
 private:
     bool is_expanded(size_t scrollbar_index) const;
 
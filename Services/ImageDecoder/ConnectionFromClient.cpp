@@ -15,6 +15,7 @@
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/ImageFormats/ImageDecoder.h>
 #include <LibGfx/ImageFormats/TIFFMetadata.h>
+#include <LibGfx/ShareableBitmap.h>
 #include <LibIPC/TransportHandle.h>
 #include <LibSync/Mutex.h>
 #include <LibThreading/ThreadPool.h>
@@ -35,6 +36,7 @@ void ConnectionFromClient::die()
     for (auto& [_, job] : m_pending_jobs)
         job->cancel();
     m_pending_jobs.clear();
+    m_incremental_decodes.clear();
 
     for (auto& [_, job] : m_pending_frame_jobs)
         job->cancel();
@@ -196,41 +198,45 @@ NonnullRefPtr<ConnectionFromClient::PendingJob> ConnectionFromClient::start_deco
             auto result = decode_image_to_details(move(encoded_buffer), ideal_size, mime_type);
 
             main_thread_event_loop.deferred_invoke([strong_this = move(strong_this), job = move(job), request_id, result = move(result)] mutable {
-                auto current_job = strong_this->m_pending_jobs.get(request_id);
-                if (!current_job.has_value() || current_job.value() != job.ptr())
-                    return;
+                strong_this->did_finish_decode_image_job(request_id, job, move(result));
+            });
+        });
 
-                if (job->is_canceled()) {
-                    strong_this->m_pending_jobs.remove(request_id);
-                    return;
-                }
+    return job;
+}
 
-                if (result.is_error()) {
-                    if (strong_this->is_open())
-                        strong_this->async_did_fail_to_decode_image(request_id, MUST(String::formatted("Decoding failed: {}", result.release_error())));
-                    strong_this->m_pending_jobs.remove(request_id);
-                    return;
-                }
+void ConnectionFromClient::did_finish_decode_image_job(i64 request_id, PendingJob const& job, ErrorOr<DecodeResult> result)
+{
+    auto current_job = m_pending_jobs.get(request_id);
+    if (!current_job.has_value() || current_job.value() != &job)
+        return;
 
-                auto result_value = result.release_value();
-                i64 session_id = 0;
-
-                if (result_value.decoder) {
-                    // This is a streaming animated decode. Create a session.
-                    session_id = strong_this->m_next_session_id++;
-                    auto session = make_ref_counted<AnimationSession>();
-                    session->encoded_data = move(result_value.encoded_data);
-                    session->decoder = move(result_value.decoder);
-                    session->frame_count = result_value.frame_count;
-                    strong_this->m_animation_sessions.set(session_id, move(session));
-                }
+    m_pending_jobs.remove(request_id);
+    m_incremental_decodes.remove(request_id);
 
-                strong_this->async_did_decode_image(request_id, result_value.is_animated, result_value.loop_count, move(result_value.bitmaps), move(result_value.durations), result_value.scale, move(result_value.color_profile), session_id);
-                strong_this->m_pending_jobs.remove(request_id);
-            });
-        });
+    if (job.is_canceled())
+        return;
 
-    return job;
+    if (result.is_error()) {
+        if (is_open())
+            async_did_fail_to_decode_image(request_id, MUST(String::formatted("Decoding failed: {}", result.release_error())));
+        return;
+    }
+
+    auto result_value = result.release_value();
+    i64 session_id = 0;
+
+    if (result_value.decoder) {
+        // This is a streaming animated decode. Create a session.
+        session_id = m_next_session_id++;
+        auto session = make_ref_counted<AnimationSession>();
+        session->encoded_data = move(result_value.encoded_data);
+        session->decoder = move(result_value.decoder);
+        session->frame_count = result_value.frame_count;
+        m_animation_sessions.set(session_id, move(session));
+    }
+
+    async_did_decode_image(request_id, result_value.is_animated, result_value.loop_count, move(result_value.bitmaps), move(result_value.durations), result_value.scale, move(result_value.color_profile), session_id);
 }
 
 void ConnectionFromClient::decode_image(Core::AnonymousBuffer encoded_buffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, i64 request_id)
@@ -289,6 +295,181 @@ void ConnectionFromClient::cancel_decoding(i64 request_id)
     if (auto job = m_pending_jobs.take(request_id); job.has_value()) {
         job.value()->cancel();
     }
+    m_incremental_decodes.remove(request_id);
+}
+
+// Partial images are whole bitmaps, so sending one for every chunk would cost more than showing them gains.
+static constexpr auto PARTIAL_IMAGE_INTERVAL = AK::Duration::from_milliseconds(250);
+
+void ConnectionFromClient::begin_incremental_decode(i64 request_id, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type)
+{
+    // Security: Rate limiting
+    if (!check_rate_limit()) {
+        async_did_fail_to_decode_image(request_id, "Rate limit exceeded"_string);
+        return;
+    }
+
+    // Security: Concurrent decode limit (DoS prevention)
+    if (!check_concurrent_decode_limit()) {
+        async_did_fail_to_decode_image(request_id, "Too many concurrent decode operations"_string);
+        return;
+    }
+
+    // Security: Dimension validation (integer overflow prevention)
+    if (!validate_dimensions(ideal_size)) {
+        async_did_fail_to_decode_image(request_id, "Invalid image dimensions"_string);
+        return;
+    }
+
+    // Security: MIME type validation
+    if (!validate_mime_type(mime_type)) {
+        async_did_fail_to_decode_image(request_id, "Invalid MIME type"_string);
+        return;
+    }
+
+    if (m_pending_jobs.contains(request_id)) {
+        m_pending_jobs.take(request_id).value()->cancel();
+        m_incremental_decodes.remove(request_id);
+        did_misbehave("Duplicate decode request id");
+        return;
+    }
+
+    auto session = make_ref_counted<IncrementalDecodeSession>();
+    session->ideal_size = ideal_size;
+    session->mime_type = move(mime_type);
+
+    m_pending_jobs.set(request_id, session->job);
+    m_incremental_decodes.set(request_id, move(session));
+}
+
+void ConnectionFromClient::append_incremental_decode_data(i64 request_id, ReadonlyBytes data)
+{
+    // NB: This isn't rate limited, as a large image arrives in many chunks. The size limit below bounds it instead.
+    auto session = m_incremental_decodes.get(request_id);
+    if (!session.has_value())
+        return;
+
+    // Security: Buffer size validation (memory exhaustion prevention)
+    session.value()->received_size += data.size();
+    if (!validate_buffer_size(session.value()->received_size)) {
+        fail_incremental_decode(request_id, "Image buffer too large"_string);
+        return;
+    }
+
+    auto chunk_or_error = ByteBuffer::copy(data);
+    if (chunk_or_error.is_error()) {
+        fail_incremental_decode(request_id, "Out of memory"_string);
+        return;
+    }
+
+    {
+        Sync::MutexLocker locker { session.value()->mutex };
+        if (session.value()->is_complete)
+            return;
+        session.value()->pending_chunks.append(chunk_or_error.release_value());
+        if (session.value()->is_being_decoded)
+            return;
+        session.value()->is_being_decoded = true;
+    }
+
+    schedule_incremental_decode_job(request_id, *session.value());
+}
+
+void ConnectionFromClient::finish_incremental_decode(i64 request_id)
+{
+    auto session = m_incremental_decodes.get(request_id);
+    if (!session.has_value())
+        return;
+
+    {
+        Sync::MutexLocker locker { session.value()->mutex };
+        if (session.value()->is_complete)
+            return;
+        session.value()->is_complete = true;
+        if (session.value()->is_being_decoded)
+            return;
+        session.value()->is_being_decoded = true;
+    }
+
+    schedule_incremental_decode_job(request_id, *session.value());
+}
+
+void ConnectionFromClient::fail_incremental_decode(i64 request_id, String error_message)
+{
+    if (auto job = m_pending_jobs.take(request_id); job.has_value())
+        job.value()->cancel();
+    m_incremental_decodes.remove(request_id);
+    async_did_fail_to_decode_image(request_id, move(error_message));
+}
+
+void ConnectionFromClient::schedule_incremental_decode_job(i64 request_id, NonnullRefPtr<IncrementalDecodeSession> session)
+{
+    auto& main_thread_event_loop = Core::EventLoop::current();
+    Threading::ThreadPool::the().submit(
+        [strong_this = NonnullRefPtr(*this), session = move(session), &main_thread_event_loop, request_id]() mutable {
+            auto& job = *session->job;
+
+            while (!job.is_canceled()) {
+                Vector<ByteBuffer> chunks;
+                bool is_complete = false;
+                {
+                    Sync::MutexLocker locker { session->mutex };
+                    chunks = move(session->pending_chunks);
+                    is_complete = session->is_complete;
+                    if (chunks.is_empty() && !is_complete) {
+                        // NB: The next chunk to arrive schedules another job.
+                        session->is_being_decoded = false;
+                        return;
+                    }
+                }
+
+                for (auto& chunk : chunks) {
+                    // NB: Once all the data is in, the whole image gets decoded rather than a partial one.
+                    if (!is_complete)
+                        session->decoder.append_data(chunk.bytes());
+                    if (auto result = session->encoded_data.try_append(chunk.bytes()); result.is_error()) {
+                        main_thread_event_loop.deferred_invoke([strong_this, session, request_id, error = result.release_error()] mutable {
+                            strong_this->did_finish_decode_image_job(request_id, session->job, move(error));
+                        });
+                        return;
+                    }
+                }
+
+                if (is_complete) {
+                    auto result = [&]() -> ErrorOr<DecodeResult> {
+                        auto encoded_buffer = TRY(Core::AnonymousBuffer::create_with_size(session->encoded_data.size()));
+                        memcpy(encoded_buffer.data<void>(), session->encoded_data.data(), session->encoded_data.size());
+                        session->encoded_data.clear();
+                        return decode_image_to_details(move(encoded_buffer), session->ideal_size, session->mime_type);
+                    }();
+
+                    main_thread_event_loop.deferred_invoke([strong_this, session, request_id, result = move(result)] mutable {
+                        strong_this->did_finish_decode_image_job(request_id, session->job, move(result));
+                    });
+                    return;
+                }
+
+                auto now = MonotonicTime::now();
+                if (session->last_partial_image_time.has_value() && now - *session->last_partial_image_time < PARTIAL_IMAGE_INTERVAL)
+                    continue;
+
+                auto partial_image_or_error = session->decoder.take_partial_frame();
+                if (partial_image_or_error.is_error() || !partial_image_or_error.value())
+                    continue;
+
+                auto partial_image = partial_image_or_error.release_value().release_nonnull();
+                partial_image->set_alpha_type_destructive(Gfx::AlphaType::Premultiplied);
+                session->last_partial_image_time = now;
+
+                main_thread_event_loop.deferred_invoke([strong_this, session, request_id, partial_image = move(partial_image)] mutable {
+                    auto current_session = strong_this->m_incremental_decodes.get(request_id);
+                    if (!current_session.has_value() || current_session.value() != session.ptr() || session->job->is_canceled())
+                        return;
+                    if (strong_this->is_open())
+                        strong_this->async_did_decode_partial_image(request_id, Gfx::ShareableBitmap { move(partial_image), Gfx::ShareableBitmap::ConstructWithKnownGoodBitmap });
+                });
+            }
+        });
 }
 
 void ConnectionFromClient::request_animation_frames(i64 session_id, u32 start_frame_index, u32 count)
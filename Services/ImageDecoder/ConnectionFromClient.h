@@ -10,6 +10,7 @@
 #include <AK/AtomicRefCounted.h>
 #include <AK/HashMap.h>
 #include <AK/SourceLocation.h>
+#include <AK/Time.h>
 #include <ImageDecoder/Forward.h>
 #include <ImageDecoder/ImageDecoderClientEndpoint.h>
 #include <ImageDecoder/ImageDecoderServerEndpoint.h>
@@ -65,10 +66,34 @@ private:
 
     using FrameDecodeResult = Vector<Gfx::ImageFrameDescriptor>;
 
+    // An image whose data arrives in chunks while it's still loading. A single job at a time works through the chunks
+    // on the thread pool, sending partial images back as it goes, and decodes the whole image once the last one is in.
+    struct IncrementalDecodeSession : public AtomicRefCounted<IncrementalDecodeSession> {
+        NonnullRefPtr<PendingJob> job { make_ref_counted<PendingJob>() };
+        Optional<Gfx::IntSize> ideal_size;
+        Optional<ByteString> mime_type;
+
+        // Only touched on the main thread.
+        size_t received_size { 0 };
+
+        Sync::Mutex mutex;
+        Vector<ByteBuffer> pending_chunks;
+        bool is_complete { false };
+        bool is_being_decoded { false };
+
+        // Only touched by the job that is decoding.
+        Gfx::IncrementalImageDecoder decoder;
+        ByteBuffer encoded_data;
+        Optional<MonotonicTime> last_partial_image_time;
+    };
+
     explicit ConnectionFromClient(NonnullOwnPtr<IPC::Transport>);
 
     virtual void decode_image(Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type, i64 request_id) override;
     virtual void cancel_decoding(i64 request_id) override;
+    virtual void begin_incremental_decode(i64 request_id, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type) override;
+    virtual void append_incremental_decode_data(i64 request_id, ReadonlyBytes data) override;
+    virtual void finish_incremental_decode(i64 request_id) override;
     virtual void request_animation_frames(i64 session_id, u32 start_frame_index, u32 count) override;
     virtual void stop_animation_decode(i64 session_id) override;
     virtual Messages::ImageDecoderServer::ConnectNewClientsResponse connect_new_clients(size_t count) override;
@@ -78,12 +103,19 @@ private:
 
     NonnullRefPtr<PendingJob> start_decode_image_job(i64 request_id, Core::AnonymousBuffer, Optional<Gfx::IntSize> ideal_size, Optional<ByteString> mime_type);
     NonnullRefPtr<PendingJob> start_frame_decode_job(i64 session_id, NonnullRefPtr<AnimationSession>, u32 start_frame_index, u32 end_index);
+    void did_finish_decode_image_job(i64 request_id, PendingJob const&, ErrorOr<DecodeResult>);
+
+    void schedule_incremental_decode_job(i64 request_id, NonnullRefPtr<IncrementalDecodeSession>);
+    void fail_incremental_decode(i64 request_id, String error_message);
 
     i64 m_next_session_id { 1 };
     HashMap<i64, NonnullRefPtr<PendingJob>> m_pending_jobs;
     HashMap<i64, NonnullRefPtr<AnimationSession>> m_animation_sessions;
     HashMap<i64, NonnullRefPtr<PendingJob>> m_pending_frame_jobs;
 
+    // Their jobs are in m_pending_jobs as well, so that cancelling and the concurrent decode limit cover them.
+    HashMap<i64, NonnullRefPtr<IncrementalDecodeSession>> m_incremental_decodes;
+
     // Security validation helpers
     [[nodiscard]] bool validate_buffer_size(size_t size, SourceLocation location = SourceLocation::current())
     {
@@ -5,24 +5,55 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
-#include <AK/Enumerate.h>
+#include <AK/Vector.h>
 #include <RequestServer/CURL.h>
 
 namespace RequestServer {
 
+CURLSH* shared_curl_handle()
+{
+    // Every curl handle in RequestServer is driven from the main thread's event loop, so the share handle does not need
+    // lock callbacks. It is never cleaned up, as easy handles may use it until the process exits.
+    static CURLSH* share_handle = [] {
+        auto* share_handle = curl_share_init();
+        VERIFY(share_handle);
+
+        auto result = curl_share_setopt(share_handle, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+        VERIFY(result == CURLSHE_OK);
+
+        return share_handle;
+    }();
+
+    return share_handle;
+}
+
 ByteString build_curl_resolve_list(DNS::LookupResult const& dns_result, StringView host, u16 port)
 {
     StringBuilder resolve_opt_builder;
     resolve_opt_builder.appendff("{}:{}:", host, port);
 
-    for (auto const& [i, addr] : enumerate(dns_result.cached_addresses())) {
-        auto formatted_address = addr.visit(
-            [&](IPv4Address const& ipv4) { return ipv4.to_byte_string(); },
-            [&](IPv6Address const& ipv6) { return MUST(ipv6.to_string()).to_byte_string(); });
+    // https://www.rfc-editor.org/rfc/rfc8305#section-4
+    // Interleave the address families, starting with IPv6. curl races a connection attempt to the first address against
+    // one to the first address of the other family (after its Happy Eyeballs timeout), so which family comes first
+    // matters, and it would otherwise just be whichever answer arrived first.
+    Vector<ByteString> ipv4_addresses;
+    Vector<ByteString> ipv6_addresses;
+    for (auto const& addr : dns_result.cached_addresses()) {
+        addr.visit(
+            [&](IPv4Address const& ipv4) { ipv4_addresses.append(ipv4.to_byte_string()); },
+            [&](IPv6Address const& ipv6) { ipv6_addresses.append(MUST(ipv6.to_string()).to_byte_string()); });
+    }
 
+    auto address_count = ipv4_addresses.size() + ipv6_addresses.size();
+    for (size_t i = 0, ipv4_index = 0, ipv6_index = 0; i < address_count; ++i) {
         if (i > 0)
             resolve_opt_builder.append(',');
-        resolve_opt_builder.append(formatted_address);
+
+        auto prefer_ipv6 = i % 2 == 0 ? ipv6_index < ipv6_addresses.size() : ipv4_index >= ipv4_addresses.size();
+        if (prefer_ipv6)
+            resolve_opt_builder.append(ipv6_addresses[ipv6_index++]);
+        else
+            resolve_opt_builder.append(ipv4_addresses[ipv4_index++]);
     }
 
     dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: Resolve list: {}", resolve_opt_builder.string_view());
@@ -26,4 +26,9 @@ namespace RequestServer {
 ByteString build_curl_resolve_list(DNS::LookupResult const& dns_result, StringView host, u16 port);
 Requests::NetworkError curl_code_to_network_error(int code);
 
+// The process-wide share handle for DNS results, so that every ConnectionFromClient's multi handle can reuse the
+// others' lookups. Connections and TLS sessions are deliberately not shared, as RequestServer does not know which
+// network partition a request belongs to and must not let one top-level site resume another's connections.
+CURLSH* shared_curl_handle();
+
 }
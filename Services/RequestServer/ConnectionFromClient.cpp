@@ -4,6 +4,7 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
 #include <AK/IDAllocator.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/WeakPtr.h>
@@ -12,6 +13,7 @@
 #include <LibCore/Socket.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
 #include <LibHTTP/Cache/DiskCache.h>
 #include <LibIPC/TransportHandle.h>
 #include <LibRequests/WebSocket.h>
@@ -25,6 +27,8 @@
 
 namespace RequestServer {
 
+extern SecurityTap* g_security_tap;
+
 static ConnectionFromClient* g_primary_connection = nullptr;
 static IDAllocator s_client_ids;
 
@@ -81,6 +85,12 @@ static auto time_curl_call(StringView label, F&& f)
 static constexpr i64 BURST_WINDOW_MS = 100;
 static constexpr u64 BURST_REPORT_THRESHOLD = 5;
 
+// Speculative DNS lookups and connections are only hints, and the parser and history can hint the same origin many
+// times over. Each origin gets this many speculative connections per window, and one speculative lookup.
+static constexpr i64 SPECULATIVE_CONNECTION_WINDOW_MS = 10'000;
+static constexpr size_t SPECULATIVE_CONNECTIONS_PER_ORIGIN = 2;
+static constexpr size_t MAXIMUM_SPECULATIVE_CONNECTION_ORIGINS = 256;
+
 ConnectionFromClient::ConnectionFromClient(NonnullOwnPtr<IPC::Transport> transport, IsPrimaryConnection is_primary_connection, ConnectionMap& connections, Optional<HTTP::DiskCache&> disk_cache)
     : IPC::ConnectionFromClient<RequestClientEndpoint, RequestServerEndpoint>(*this, move(transport), s_client_ids.allocate())
     , m_connections(connections)
@@ -210,8 +220,15 @@ ErrorOr<IPC::TransportHandle> ConnectionFromClient::create_client_socket()
 
 void ConnectionFromClient::set_disk_cache_settings(HTTP::DiskCacheSettings disk_cache_settings)
 {
-    if (m_disk_cache.has_value())
+    if (m_disk_cache.has_value()) {
         m_disk_cache->set_maximum_disk_cache_size(disk_cache_settings.maximum_size);
+        m_disk_cache->set_compress_text_bodies(disk_cache_settings.compress_text_bodies);
+    }
+}
+
+void ConnectionFromClient::set_trace_event_buffer(Core::AnonymousBuffer trace_event_buffer)
+{
+    Core::set_trace_event_buffer(move(trace_event_buffer));
 }
 
 Messages::RequestServer::IsSupportedProtocolResponse ConnectionFromClient::is_supported_protocol(ByteString protocol)
@@ -278,12 +295,23 @@ void ConnectionFromClient::start_request(u64 request_id, ByteString method, URL:
     }
 
     auto request = Request::fetch(request_id, m_disk_cache, cache_mode, *this, m_curl_multi, m_resolver, move(url), move(method), HTTP::HeaderList::create(move(request_headers)), move(request_body), include_credentials, m_alt_svc_cache_path, proxy_data);
+    request->set_security_tap(g_security_tap);
     m_active_requests.set(request_id, move(request));
 }
 
 void ConnectionFromClient::start_revalidation_request(Badge<Request>, ByteString method, URL::URL url, NonnullRefPtr<HTTP::HeaderList> request_headers, ByteBuffer request_body, HTTP::Cookie::IncludeCredentials include_credentials, Core::ProxyData proxy_data)
 {
     note_event_tick("ipc-start-revalidation"sv);
+
+    // Every request for a stale-while-revalidate response asks for a revalidation, but one in flight covers them all.
+    auto is_already_revalidating = any_of(m_active_revalidation_requests, [&](auto const& entry) {
+        return entry.value->url() == url && entry.value->method() == method;
+    });
+    if (is_already_revalidating) {
+        dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: start_revalidation_request({}): Already revalidating", url);
+        return;
+    }
+
     auto request_id = m_next_revalidation_request_id++;
 
     dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: start_revalidation_request({}, {})", request_id, url);
@@ -413,10 +441,56 @@ Messages::RequestServer::SetCertificateResponse ConnectionFromClient::set_certif
 
 void ConnectionFromClient::ensure_connection(u64 request_id, URL::URL url, ::RequestServer::CacheLevel cache_level)
 {
+    if (!take_speculative_connection_budget(url, cache_level)) {
+        dbgln_if(REQUESTSERVER_DEBUG, "RequestServer: Skipping speculative {} for {}, origin is over budget",
+            cache_level == CacheLevel::ResolveOnly ? "DNS lookup"sv : "connection"sv, url);
+        return;
+    }
+
     auto request = Request::connect(request_id, *this, m_curl_multi, m_resolver, move(url), cache_level);
     m_active_requests.set(request_id, move(request));
 }
 
+bool ConnectionFromClient::take_speculative_connection_budget(URL::URL const& url, CacheLevel cache_level)
+{
+    auto now = MonotonicTime::now();
+    auto is_expired = [&](auto const& budget) {
+        return (now - budget.window_started_at).to_milliseconds() >= SPECULATIVE_CONNECTION_WINDOW_MS;
+    };
+
+    if (m_speculative_connection_budgets.size() >= MAXIMUM_SPECULATIVE_CONNECTION_ORIGINS) {
+        m_speculative_connection_budgets.remove_all_matching([&](auto const&, auto const& budget) { return is_expired(budget); });
+
+        // Every origin is still within its window. Rather than grow without bound, start every window over.
+        if (m_speculative_connection_budgets.size() >= MAXIMUM_SPECULATIVE_CONNECTION_ORIGINS)
+            m_speculative_connection_budgets.clear();
+    }
+
+    auto& budget = m_speculative_connection_budgets.ensure(url.origin().serialize(), [&] {
+        return SpeculativeConnectionBudget { .window_started_at = now };
+    });
+
+    if (is_expired(budget))
+        budget = { .window_started_at = now };
+
+    switch (cache_level) {
+    case CacheLevel::ResolveOnly:
+        // A connection resolves the host as well, so any earlier hint covers a lookup.
+        if (budget.resolved || budget.connections != 0)
+            return false;
+        budget.resolved = true;
+        return true;
+
+    case CacheLevel::CreateConnection:
+        if (budget.connections >= SPECULATIVE_CONNECTIONS_PER_ORIGIN)
+            return false;
+        ++budget.connections;
+        return true;
+    }
+
+    VERIFY_NOT_REACHED();
+}
+
 void ConnectionFromClient::retrieved_http_cookie(int client_id, u64 request_id, RequestServer::RequestType request_type, String cookie)
 {
     note_event_tick("ipc-retrieved-cookie"sv);
@@ -510,7 +584,7 @@ void ConnectionFromClient::websocket_connect(u64 websocket_id, URL::URL url, Byt
     m_pending_websockets.set(websocket_id);
     auto weak_self = make_weak_ptr<ConnectionFromClient>();
 
-    m_resolver->dns.lookup(host, DNS::Messages::Class::IN, { DNS::Messages::ResourceType::A, DNS::Messages::ResourceType::AAAA })
+    m_resolver->dns.lookup_addresses(host)
         ->when_rejected([weak_self, websocket_id](auto const& error) {
             auto self = weak_self.strong_ref();
             if (!self)
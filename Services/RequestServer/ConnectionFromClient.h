@@ -53,6 +53,7 @@ private:
     virtual Messages::RequestServer::ConnectNewClientsResponse connect_new_clients(size_t count) override;
 
     virtual void set_disk_cache_settings(HTTP::DiskCacheSettings) override;
+    virtual void set_trace_event_buffer(Core::AnonymousBuffer) override;
 
     virtual Messages::RequestServer::IsSupportedProtocolResponse is_supported_protocol(ByteString) override;
     virtual void set_dns_server(ByteString host_or_address, u16 port, bool use_tls, bool validate_dnssec_locally) override;
@@ -83,6 +84,8 @@ private:
 
     ErrorOr<IPC::TransportHandle> create_client_socket();
 
+    bool take_speculative_connection_budget(URL::URL const&, CacheLevel);
+
     ConnectionMap& m_connections;
     Optional<HTTP::DiskCache&> m_disk_cache;
 
@@ -102,6 +105,13 @@ private:
 
     u64 m_next_revalidation_request_id { 0 };
 
+    struct SpeculativeConnectionBudget {
+        MonotonicTime window_started_at;
+        bool resolved { false };
+        size_t connections { 0 };
+    };
+    HashMap<String, SpeculativeConnectionBudget> m_speculative_connection_budgets;
+
     Optional<MonotonicTime> m_burst_window_started_at;
     u64 m_requests_in_burst_window { 0 };
 };
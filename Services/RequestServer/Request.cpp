@@ -5,11 +5,16 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/AnyOf.h>
+#include <AK/Array.h>
 #include <AK/GenericShorthands.h>
 #include <AK/HashMap.h>
+#include <AK/Hex.h>
+#include <LibCore/EventLoop.h>
 #include <LibCore/File.h>
 #include <LibCore/MimeData.h>
 #include <LibCore/Notifier.h>
+#include <LibCore/Timer.h>
 #include <LibHTTP/Cache/DiskCache.h>
 #include <LibHTTP/Cache/Utilities.h>
 #include <LibHTTP/Status.h>
@@ -17,6 +22,7 @@
 #include <RequestServer/CURL.h>
 #include <RequestServer/ConnectionFromClient.h>
 #include <RequestServer/Request.h>
+#include <RequestServer/RequestTrace.h>
 #include <RequestServer/Resolver.h>
 #include <RequestServer/ResourceSubstitutionMap.h>
 
@@ -26,6 +32,10 @@ extern OwnPtr<ResourceSubstitutionMap> g_resource_substitution_map;
 
 static long s_connect_timeout_seconds = 90L;
 
+// https://www.rfc-editor.org/rfc/rfc8305#section-8
+// The recommended Connection Attempt Delay, which is how long the first address family gets before the other one races it.
+static constexpr long s_happy_eyeballs_timeout_ms = 250L;
+
 static void log_network_activity(URL::URL const& url, ByteString const& method, void* curl_easy_handle, int curl_result_code, bool is_revalidation, RequestType type)
 {
     if constexpr (!REQUESTSERVER_WIRE_DEBUG)
@@ -356,6 +366,37 @@ static void mark_lifecycle_event(Request const* request, Optional<MonotonicTime>
     wire_stats().ensure(request).*field = MonotonicTime::now();
 }
 
+static void record_curl_trace_spans(u64 request_id, MonotonicTime curl_added_at, void* curl_easy_handle)
+{
+    auto& trace = RequestTrace::the();
+    if (!trace.is_enabled() || !curl_easy_handle)
+        return;
+
+    auto get_marker = [&](auto option) {
+        curl_off_t value = 0;
+        (void)curl_easy_getinfo(curl_easy_handle, option, &value);
+        return value;
+    };
+
+    // As in log_network_activity, the markers are cumulative and skipped phases are reported as 0. Such phases (e.g. a
+    // reused connection) get no span at all.
+    auto namelookup = get_marker(CURLINFO_NAMELOOKUP_TIME_T);
+    auto connect = get_marker(CURLINFO_CONNECT_TIME_T);
+    auto appconnect = get_marker(CURLINFO_APPCONNECT_TIME_T);
+    auto pretransfer = get_marker(CURLINFO_PRETRANSFER_TIME_T);
+    auto starttransfer = get_marker(CURLINFO_STARTTRANSFER_TIME_T);
+
+    auto record = [&](TraceSpan span, curl_off_t start, curl_off_t end) {
+        if (end <= 0 || end < start)
+            return;
+        trace.record(request_id, span, curl_added_at + AK::Duration::from_microseconds(start), curl_added_at + AK::Duration::from_microseconds(end));
+    };
+
+    record(TraceSpan::Connect, namelookup, connect);
+    record(TraceSpan::TLSHandshake, connect, appconnect);
+    record(TraceSpan::TimeToFirstByte, pretransfer, starttransfer);
+}
+
 NonnullOwnPtr<Request> Request::fetch(
     u64 request_id,
     Optional<HTTP::DiskCache&> disk_cache,
@@ -472,6 +513,12 @@ Request::~Request()
     if (!m_response_buffer.is_eof())
         dbgln("Warning: Request destroyed with buffered data (it's likely that the client disappeared or the request was cancelled)");
 
+    if (m_scan_backpressure_timer)
+        m_scan_backpressure_timer->stop();
+
+    if (m_stream_scan_id.has_value())
+        m_security_tap->abandon_stream_scan(*m_stream_scan_id);
+
     if (m_curl_easy_handle) {
         auto result = curl_multi_remove_handle(m_curl_multi_handle, m_curl_easy_handle);
         VERIFY(result == CURLM_OK);
@@ -521,6 +568,9 @@ void Request::notify_fetch_complete(Badge<ConnectionFromClient>, int result_code
         log_chunk_stats(this);
     }
 
+    if (m_curl_added_at.has_value())
+        record_curl_trace_spans(m_request_id, *m_curl_added_at, m_curl_easy_handle);
+
     if (is_revalidation_request()) {
         if (acquire_status_code() == 304) {
             if (m_type == RequestType::BackgroundRevalidation && m_disk_cache->mode() == HTTP::DiskCache::Mode::Testing)
@@ -531,6 +581,9 @@ void Request::notify_fetch_complete(Badge<ConnectionFromClient>, int result_code
             return;
         }
 
+        if (serve_stale_response_on_error(result_code))
+            return;
+
         if (revalidation_failed().is_error())
             return;
 
@@ -539,6 +592,18 @@ void Request::notify_fetch_complete(Badge<ConnectionFromClient>, int result_code
 
     m_curl_result_code = result_code;
 
+    if (m_stream_scan_aborted_transfer) {
+        transition_to_state(State::Error);
+        return;
+    }
+
+    // The tail of the body is still held back; it is passed on once Sentinel has cleared it
+    if (m_stream_scan_id.has_value()) {
+        if (!m_stream_scan_in_flight)
+            scan_streamed_body_window(true);
+        return;
+    }
+
     if (m_response_buffer.is_eof())
         transition_to_state(State::Complete);
 }
@@ -613,29 +678,32 @@ void Request::handle_initial_state()
             ? HTTP::DiskCache::OpenMode::Revalidate
             : HTTP::DiskCache::OpenMode::Read;
 
-        m_disk_cache->open_entry(*this, m_url, m_method, m_request_headers, m_cache_mode, open_mode)
-            .visit(
-                [&](Optional<HTTP::CacheEntryReader&> cache_entry_reader) {
-                    m_cache_entry_reader = cache_entry_reader;
-
-                    if (m_cache_entry_reader.has_value()) {
-                        if (m_cache_entry_reader->revalidation_type() == HTTP::CacheEntryReader::RevalidationType::StaleWhileRevalidate)
-                            m_client.start_revalidation_request({}, m_method, m_url, m_request_headers, m_request_body, m_include_credentials, m_proxy_data);
-
-                        if (is_revalidation_request())
-                            transition_to_state(State::DNSLookup);
-                        else
-                            transition_to_state(State::ReadCache);
-                    } else if (m_type == RequestType::BackgroundRevalidation) {
-                        // If we were not able to open a cache entry reader for revalidation requests, there's no point
-                        // in issuing a request over the network.
-                        transition_to_state(State::Complete);
-                    }
-                },
-                [&](HTTP::DiskCache::CacheHasOpenEntry) {
-                    // If an existing entry is open for writing, we must wait for it to complete.
-                    transition_to_state(State::WaitForCache);
-                });
+        auto cache_lookup_started_at = MonotonicTime::now();
+        auto cache_entry = m_disk_cache->open_entry(*this, m_url, m_method, m_request_headers, m_cache_mode, open_mode);
+        RequestTrace::the().record(m_request_id, TraceSpan::CacheLookup, cache_lookup_started_at, MonotonicTime::now());
+
+        cache_entry.visit(
+            [&](Optional<HTTP::CacheEntryReader&> cache_entry_reader) {
+                m_cache_entry_reader = cache_entry_reader;
+
+                if (m_cache_entry_reader.has_value()) {
+                    if (m_cache_entry_reader->revalidation_type() == HTTP::CacheEntryReader::RevalidationType::StaleWhileRevalidate)
+                        m_client.start_revalidation_request({}, m_method, m_url, m_request_headers, m_request_body, m_include_credentials, m_proxy_data);
+
+                    if (is_revalidation_request())
+                        transition_to_state(State::DNSLookup);
+                    else
+                        transition_to_state(State::ReadCache);
+                } else if (m_type == RequestType::BackgroundRevalidation) {
+                    // If we were not able to open a cache entry reader for revalidation requests, there's no point
+                    // in issuing a request over the network.
+                    transition_to_state(State::Complete);
+                }
+            },
+            [&](HTTP::DiskCache::CacheHasOpenEntry) {
+                // If an existing entry is open for writing, we must wait for it to complete.
+                transition_to_state(State::WaitForCache);
+            });
 
         if (m_state != State::Init)
             return;
@@ -676,7 +744,7 @@ void Request::handle_read_cache_state()
 
     transfer_headers_to_client_if_needed();
 
-    if (m_cache_entry_reader->body_size() < static_cast<u64>(PAGE_SIZE)) {
+    if (m_cache_entry_reader->body_size() < static_cast<u64>(PAGE_SIZE) || m_cache_entry_reader->is_body_compressed()) {
         if (inform_client_request_started().is_error())
             return;
 
@@ -804,18 +872,25 @@ void Request::handle_dns_lookup_state()
     auto const& dns_info = DNSInfo::the();
 
     mark_lifecycle_event(this, &WireStats::dns_started_at);
+    auto dns_started_at = MonotonicTime::now();
 
-    m_resolver->dns.lookup(host, DNS::Messages::Class::IN, { DNS::Messages::ResourceType::A, DNS::Messages::ResourceType::AAAA }, { .validate_dnssec_locally = dns_info.validate_dnssec_locally })
-        ->when_rejected(weak_callback(*this, [host](auto& self, auto const& error) {
+    m_resolver->dns.lookup_addresses(host, DNS::Messages::Class::IN, { .validate_dnssec_locally = dns_info.validate_dnssec_locally })
+        ->when_rejected(weak_callback(*this, [host, dns_started_at](auto& self, auto const& error) {
             mark_lifecycle_event(&self, &WireStats::dns_completed_at);
+            RequestTrace::the().record(self.m_request_id, TraceSpan::DNSLookup, dns_started_at, MonotonicTime::now());
             dbgln("Request::handle_dns_lookup_state: DNS lookup failed for '{}': {}", host, error);
+            if (self.serve_stale_response_on_error({}))
+                return;
             self.m_network_error = Requests::NetworkError::UnableToResolveHost;
             self.transition_to_state(State::Error);
         }))
-        .when_resolved(weak_callback(*this, [host](auto& self, NonnullRefPtr<DNS::LookupResult const> dns_result) {
+        .when_resolved(weak_callback(*this, [host, dns_started_at](auto& self, NonnullRefPtr<DNS::LookupResult const> dns_result) {
             mark_lifecycle_event(&self, &WireStats::dns_completed_at);
+            RequestTrace::the().record(self.m_request_id, TraceSpan::DNSLookup, dns_started_at, MonotonicTime::now());
             if (dns_result->is_empty() || !dns_result->has_cached_addresses()) {
                 dbgln("Request::handle_dns_lookup_state: DNS lookup failed for '{}'", host);
+                if (self.serve_stale_response_on_error({}))
+                    return;
                 self.m_network_error = Requests::NetworkError::UnableToResolveHost;
                 self.transition_to_state(State::Error);
             } else if (first_is_one_of(self.m_type, RequestType::Fetch, RequestType::BackgroundRevalidation)) {
@@ -862,10 +937,12 @@ void Request::handle_connect_state()
     set_option(CURLOPT_PRIVATE, this);
 
     set_option(CURLOPT_NOSIGNAL, 1L);
+    set_option(CURLOPT_SHARE, shared_curl_handle());
 
     set_option(CURLOPT_URL, m_url.to_byte_string().characters());
     set_option(CURLOPT_PORT, m_url.port_or_default());
     set_option(CURLOPT_CONNECTTIMEOUT, s_connect_timeout_seconds);
+    set_option(CURLOPT_HAPPY_EYEBALLS_TIMEOUT_MS, s_happy_eyeballs_timeout_ms);
     set_option(CURLOPT_CONNECT_ONLY, 1L);
 
     // Pre-populate the multi's hostcache so libcurl skips its threaded resolver entirely.
@@ -879,6 +956,7 @@ void Request::handle_connect_state()
     }
 
     mark_lifecycle_event(this, &WireStats::curl_added_at);
+    m_curl_added_at = MonotonicTime::now();
     auto result = curl_multi_add_handle(m_curl_multi_handle, m_curl_easy_handle);
     VERIFY(result == CURLM_OK);
 }
@@ -917,6 +995,7 @@ void Request::handle_fetch_state()
     set_option(CURLOPT_PRIVATE, this);
 
     set_option(CURLOPT_NOSIGNAL, 1L);
+    set_option(CURLOPT_SHARE, shared_curl_handle());
 
     if (auto const& path = default_certificate_path(); !path.is_empty())
         set_option(CURLOPT_CAINFO, path.characters());
@@ -925,6 +1004,7 @@ void Request::handle_fetch_state()
     set_option(CURLOPT_URL, m_url.to_byte_string().characters());
     set_option(CURLOPT_PORT, m_url.port_or_default());
     set_option(CURLOPT_CONNECTTIMEOUT, s_connect_timeout_seconds);
+    set_option(CURLOPT_HAPPY_EYEBALLS_TIMEOUT_MS, s_happy_eyeballs_timeout_ms);
     set_option(CURLOPT_PIPEWAIT, 1L);
     set_option(CURLOPT_ALTSVC, m_alt_svc_cache_path.characters());
 
@@ -1013,6 +1093,7 @@ void Request::handle_fetch_state()
     }
 
     mark_lifecycle_event(this, &WireStats::curl_added_at);
+    m_curl_added_at = MonotonicTime::now();
     auto result = curl_multi_add_handle(m_curl_multi_handle, m_curl_easy_handle);
     VERIFY(result == CURLM_OK);
 }
@@ -1030,7 +1111,9 @@ void Request::handle_complete_state()
             m_curl_result_code = CURLE_OK;
 
         if (m_curl_result_code != CURLE_OK) {
-            m_network_error = curl_code_to_network_error(*m_curl_result_code);
+            // A streaming scan verdict aborts the transfer from the write callback; keep its error.
+            if (m_network_error != Requests::NetworkError::BlockedBySecurityPolicy)
+                m_network_error = curl_code_to_network_error(*m_curl_result_code);
 
             if (m_network_error == Requests::NetworkError::Unknown) {
                 char const* curl_error_message = curl_easy_strerror(static_cast<CURLcode>(*m_curl_result_code));
@@ -1049,7 +1132,7 @@ void Request::handle_complete_state()
         // index row to already exist. If we notified first the store would race the index write and be rejected.
         Optional<HTTP::CacheEntryBodyFile> cached_body_file;
         if (m_cache_entry_writer.has_value()) {
-            if (m_cache_entry_writer->body_size() >= static_cast<u64>(PAGE_SIZE)) {
+            if (m_cache_entry_writer->body_size() >= static_cast<u64>(PAGE_SIZE) && !m_cache_entry_writer->is_body_compressed()) {
                 auto body_file = m_cache_entry_writer->flush_and_take_body_file(m_request_headers, m_response_headers);
                 if (!body_file.is_error())
                     cached_body_file = body_file.release_value();
@@ -1121,10 +1204,26 @@ size_t Request::on_data_received(void* buffer, size_t size, size_t nmemb, void*
 {
     auto& request = *static_cast<Request*>(user_data);
 
+    if (request.m_stream_scan_aborted_transfer)
+        return CURL_WRITEFUNC_ERROR;
+
+    // curl redelivers the same bytes once the transfer is unpaused, so this must happen before anything consumes them
+    if (request.m_stream_scan_in_flight) {
+        request.m_stream_scan_paused_transfer = true;
+        return CURL_WRITEFUNC_PAUSE;
+    }
+    if (request.m_stream_scan_id.has_value() && request.pause_for_scan_backpressure())
+        return CURL_WRITEFUNC_PAUSE;
+
     if (request.m_type == RequestType::Fetch || request.m_type == RequestType::BackgroundRevalidation)
         record_chunk(&request, size * nmemb);
 
     if (request.is_revalidation_request()) {
+        // An error response that the cached response may stand in for is not passed on. Abort the transfer, and serve
+        // the cached response once curl reports the transfer as complete.
+        if (request.can_serve_stale_response_on_error(CURLE_OK))
+            return CURL_WRITEFUNC_ERROR;
+
         // If we arrive here, we did not receive an HTTP 304 response code. We must remove the cache entry and inform
         // the client of the new response headers and data.
         if (request.revalidation_failed().is_error())
@@ -1146,6 +1245,14 @@ size_t Request::on_data_received(void* buffer, size_t size, size_t nmemb, void*
     auto total_size = size * nmemb;
     ReadonlyBytes bytes { static_cast<u8 const*>(buffer), total_size };
 
+    if (!exchange(request.m_checked_for_streamed_body_scan, true) && request.should_inspect_download()) {
+        request.m_stream_scan_id = request.m_security_tap->begin_stream_scan();
+        request.m_stream_body_hasher = Crypto::Hash::SHA256::create();
+    }
+
+    if (request.m_stream_scan_id.has_value())
+        return request.hold_streamed_body_chunk(bytes) ? total_size : CURL_WRITEFUNC_ERROR;
+
     auto result = [&] -> ErrorOr<void> {
         TRY(request.m_response_buffer.write_some(bytes));
         return request.write_queued_bytes_without_blocking();
@@ -1159,6 +1266,207 @@ size_t Request::on_data_received(void* buffer, size_t size, size_t nmemb, void*
     return total_size;
 }
 
+bool Request::should_inspect_download() const
+{
+    if (!m_security_tap || m_type != RequestType::Fetch)
+        return false;
+
+    if (auto disposition = m_response_headers->get("Content-Disposition"sv); disposition.has_value()) {
+        if (disposition->view().trim_whitespace().starts_with("attachment"sv, CaseSensitivity::CaseInsensitive))
+            return true;
+    }
+
+    static constexpr Array download_mime_types {
+        "application/octet-stream"sv,
+        "application/x-msdownload"sv,
+        "application/x-msdos-program"sv,
+        "application/vnd.microsoft.portable-executable"sv,
+        "application/x-executable"sv,
+        "application/x-sh"sv,
+        "application/java-archive"sv,
+        "application/zip"sv,
+        "application/x-7z-compressed"sv,
+        "application/vnd.rar"sv,
+        "application/x-rar-compressed"sv,
+    };
+
+    auto content_type = m_response_headers->get("Content-Type"sv);
+    if (!content_type.has_value())
+        return false;
+
+    auto essence = content_type->view().find_first_split_view(';').trim_whitespace();
+    return any_of(download_mime_types, [&](auto mime_type) { return essence.equals_ignoring_ascii_case(mime_type); });
+}
+
+bool Request::pause_for_scan_backpressure()
+{
+    if (!m_security_tap->is_scan_backlog_saturated())
+        return false;
+
+    dbgln_if(REQUESTSERVER_DEBUG, "Request::pause_for_scan_backpressure: Pausing download of {} until the scan backlog drains", m_url);
+    wait_for_scan_backlog_to_drain();
+    return true;
+}
+
+void Request::wait_for_scan_backlog_to_drain()
+{
+    static constexpr int SCAN_BACKPRESSURE_POLL_INTERVAL_MS = 50;
+
+    if (!m_scan_backpressure_timer) {
+        m_scan_backpressure_timer = Core::Timer::create_repeating(SCAN_BACKPRESSURE_POLL_INTERVAL_MS, [this] {
+            if (m_security_tap->is_scan_backlog_saturated())
+                return;
+            m_scan_backpressure_timer->stop();
+
+            // A window that was turned away keeps the transfer paused until its verdict arrives
+            if (auto is_end_of_stream = exchange(m_stream_scan_window_awaiting_queue, {}); is_end_of_stream.has_value()) {
+                scan_streamed_body_window(*is_end_of_stream);
+                return;
+            }
+            curl_easy_pause(m_curl_easy_handle, CURLPAUSE_CONT);
+        });
+    }
+
+    m_scan_backpressure_timer->start();
+}
+
+bool Request::hold_streamed_body_chunk(ReadonlyBytes bytes)
+{
+    // Hash the body as it arrives, so the verdict can be cached without going over the whole download again
+    if (m_stream_body_hasher)
+        m_stream_body_hasher->update(bytes);
+
+    // curl hands us small chunks; batch them into scan windows so Sentinel is not consulted per packet
+    if (auto result = m_stream_scan_window.try_append(bytes); result.is_error()) {
+        dbgln("Request::hold_streamed_body_chunk: Aborting download, unable to hold back data for scanning: {}", result.error());
+        m_security_tap->abandon_stream_scan(*m_stream_scan_id);
+        m_stream_scan_id.clear();
+        m_stream_scan_window.clear();
+        m_stream_body_hasher.clear();
+        return false;
+    }
+
+    if (m_stream_scan_window.size() >= m_security_tap->scan_size_config().chunk_size)
+        scan_streamed_body_window(false);
+    return true;
+}
+
+void Request::scan_streamed_body_window(bool is_end_of_stream)
+{
+    m_stream_scan_in_flight = true;
+
+    auto on_verdict = weak_callback(*this, [is_end_of_stream, scan_started_at = MonotonicTime::now()](auto& self, ErrorOr<SecurityTap::ScanResult> result) {
+        RequestTrace::the().record(self.m_request_id, TraceSpan::SecurityScan, scan_started_at, MonotonicTime::now());
+        self.handle_streamed_body_scan_verdict(move(result), is_end_of_stream);
+    });
+
+    // The held-back bytes stay here until the verdict arrives; the worker scans its own copy
+    auto window = ByteBuffer::copy(m_stream_scan_window.bytes());
+    if (window.is_error()) {
+        Core::deferred_invoke([on_verdict = move(on_verdict), error = window.release_error()]() mutable {
+            on_verdict(move(error));
+        });
+        return;
+    }
+
+    bool was_queued = false;
+    if (is_end_of_stream) {
+        ByteString sha256;
+        if (m_stream_body_hasher)
+            sha256 = encode_hex(m_stream_body_hasher->peek().bytes());
+        was_queued = m_security_tap->async_finish_stream_scan(*m_stream_scan_id, window.release_value(), move(sha256), move(on_verdict));
+    } else {
+        was_queued = m_security_tap->async_scan_stream_window(*m_stream_scan_id, window.release_value(), move(on_verdict));
+    }
+
+    // The scan backlog is full. The window stays held back (and the transfer paused) until there is room for it.
+    if (!was_queued) {
+        dbgln_if(REQUESTSERVER_DEBUG, "Request::scan_streamed_body_window: Scan backlog full, holding back download of {}", m_url);
+        m_stream_scan_window_awaiting_queue = is_end_of_stream;
+        wait_for_scan_backlog_to_drain();
+    }
+}
+
+void Request::handle_streamed_body_scan_verdict(ErrorOr<SecurityTap::ScanResult> result, bool was_end_of_stream)
+{
+    m_stream_scan_in_flight = false;
+
+    if (result.is_error()) {
+        // Fail-open, as with whole-file scans
+        dbgln("Request::handle_streamed_body_scan_verdict: Streaming scan failed, allowing download: {}", result.error());
+        m_security_tap->abandon_stream_scan(*m_stream_scan_id);
+        m_stream_scan_id.clear();
+        m_stream_body_hasher.clear();
+    } else if (result.value().is_threat) {
+        block_streamed_download(move(result.value().alert_json));
+        return;
+    } else if (was_end_of_stream) {
+        m_stream_scan_id.clear();
+        m_stream_body_hasher.clear();
+    }
+
+    // Everything held back so far has been cleared. Once the stream is over, this also completes the request.
+    auto forward_result = [&] -> ErrorOr<void> {
+        TRY(m_response_buffer.write_some(m_stream_scan_window.bytes()));
+        m_stream_scan_window.clear();
+        return write_queued_bytes_without_blocking();
+    }();
+
+    if (forward_result.is_error()) {
+        dbgln("Request::handle_streamed_body_scan_verdict: Aborting request because error occurred whilst writing data to the client: {}", forward_result.error());
+        if (m_stream_scan_id.has_value())
+            m_security_tap->abandon_stream_scan(*m_stream_scan_id);
+        m_stream_scan_id.clear();
+        m_stream_body_hasher.clear();
+        abort_streamed_download();
+        return;
+    }
+
+    // curl may have finished while this window was being scanned
+    if (m_stream_scan_id.has_value() && m_curl_result_code.has_value()) {
+        scan_streamed_body_window(true);
+        return;
+    }
+
+    resume_transfer_paused_for_stream_scan();
+}
+
+void Request::resume_transfer_paused_for_stream_scan()
+{
+    // Unpausing redelivers the bytes curl was holding, which may start the next window right away
+    if (exchange(m_stream_scan_paused_transfer, false))
+        curl_easy_pause(m_curl_easy_handle, CURLPAUSE_CONT);
+}
+
+void Request::abort_streamed_download()
+{
+    m_stream_scan_window.clear();
+
+    if (m_curl_result_code.has_value()) {
+        transition_to_state(State::Error);
+        return;
+    }
+
+    // The transfer can only be failed from its write callback; curl then reports it complete as usual
+    m_stream_scan_aborted_transfer = true;
+    resume_transfer_paused_for_stream_scan();
+}
+
+void Request::block_streamed_download(Optional<ByteString> alert_json)
+{
+    dbgln("Request: Aborting download of {} mid-stream, Sentinel detected a threat", m_url);
+
+    // Let Sentinel release the stream's state right away rather than waiting for the connection to close
+    if (m_stream_scan_id.has_value())
+        m_security_tap->abandon_stream_scan(*m_stream_scan_id);
+
+    m_stream_scan_id.clear();
+    m_stream_body_hasher.clear();
+    m_security_alert_json = move(alert_json);
+    m_network_error = Requests::NetworkError::BlockedBySecurityPolicy;
+    abort_streamed_download();
+}
+
 ErrorOr<void> Request::inform_client_request_started()
 {
     if (m_type == RequestType::BackgroundRevalidation)
@@ -1265,6 +1573,9 @@ ErrorOr<void> Request::write_queued_bytes_without_blocking()
         });
     }
 
+    if (m_pipe_back_pressure_started_at.has_value())
+        RequestTrace::the().record(m_request_id, TraceSpan::PipeBackPressure, *exchange(m_pipe_back_pressure_started_at, {}), MonotonicTime::now());
+
     if constexpr (REQUESTSERVER_WIRE_DEBUG) {
         auto& stats = wire_stats().ensure(this);
         if (stats.current_pressure_window_started.has_value()) {
@@ -1286,6 +1597,9 @@ ErrorOr<void> Request::write_queued_bytes_without_blocking()
             if (!first_is_one_of(result.error().code(), EAGAIN, EWOULDBLOCK))
                 return result.release_error();
 
+            if (!m_pipe_back_pressure_started_at.has_value())
+                m_pipe_back_pressure_started_at = MonotonicTime::now();
+
             if constexpr (REQUESTSERVER_WIRE_DEBUG) {
                 auto& stats = wire_stats().ensure(this);
                 if (!stats.current_pressure_window_started.has_value()) {
@@ -1315,7 +1629,9 @@ ErrorOr<void> Request::write_queued_bytes_without_blocking()
     }
 
     m_client_writer_notifier->set_enabled(false);
-    if (m_curl_result_code.has_value())
+
+    // A body that is still being scanned has bytes held back, so the request is not done yet
+    if (m_curl_result_code.has_value() && !m_stream_scan_id.has_value())
         transition_to_state(State::Complete);
 
     return {};
@@ -1346,6 +1662,30 @@ ErrorOr<void> Request::revalidation_failed()
     return {};
 }
 
+// https://httpwg.org/specs/rfc5861.html#n-the-stale-if-error-cache-control-extension
+bool Request::can_serve_stale_response_on_error(Optional<int> curl_result_code) const
+{
+    // "The stale-if-error Cache-Control extension indicates that when an error is encountered, a cached stale response
+    // MAY be used to satisfy the request, regardless of other freshness information." An error is a failure to reach the
+    // origin at all, or a 500, 502, 503 or 504 response from it.
+    if (m_type != RequestType::Fetch || !is_revalidation_request() || !m_cache_entry_reader->may_serve_stale_on_error())
+        return false;
+
+    if (curl_result_code.has_value() && *curl_result_code == CURLE_OK)
+        return first_is_one_of(acquire_status_code(), 500u, 502u, 503u, 504u);
+    return true;
+}
+
+bool Request::serve_stale_response_on_error(Optional<int> curl_result_code)
+{
+    if (!can_serve_stale_response_on_error(curl_result_code))
+        return false;
+
+    dbgln_if(REQUESTSERVER_DEBUG, "Request::serve_stale_response_on_error: Revalidation of {} failed, serving the stale response", m_url);
+    transition_to_state(State::ReadCache);
+    return true;
+}
+
 bool Request::is_cache_only_request() const
 {
     if (m_cache_mode == HTTP::CacheMode::OnlyIfCached)
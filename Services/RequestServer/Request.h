@@ -12,6 +12,7 @@
 #include <AK/Optional.h>
 #include <AK/Time.h>
 #include <LibCore/Proxy.h>
+#include <LibCrypto/Hash/SHA2.h>
 #include <LibDNS/Resolver.h>
 #include <LibHTTP/Cache/CacheMode.h>
 #include <LibHTTP/Cache/CacheRequest.h>
@@ -76,6 +77,7 @@ public:
     u64 request_id() const { return m_request_id; }
     RequestType type() const { return m_type; }
     URL::URL const& url() const { return m_url; }
+    ByteString const& method() const { return m_method; }
 
     virtual void notify_request_unblocked(Badge<HTTP::DiskCache>) override;
     void notify_retrieved_http_cookie(Badge<ConnectionFromClient>, StringView cookie);
@@ -205,12 +207,25 @@ private:
     static size_t on_header_received(void* buffer, size_t size, size_t nmemb, void* user_data);
     static size_t on_data_received(void* buffer, size_t size, size_t nmemb, void* user_data);
 
+    // Streaming Sentinel scan of the response body. Body bytes are held back until the window they belong to has
+    // been cleared, and the transfer is paused while a window is being scanned.
+    bool hold_streamed_body_chunk(ReadonlyBytes);
+    void scan_streamed_body_window(bool is_end_of_stream);
+    void handle_streamed_body_scan_verdict(ErrorOr<SecurityTap::ScanResult>, bool was_end_of_stream);
+    void resume_transfer_paused_for_stream_scan();
+    void abort_streamed_download();
+    bool pause_for_scan_backpressure();
+    void wait_for_scan_backlog_to_drain();
+    void block_streamed_download(Optional<ByteString> alert_json);
+
     ErrorOr<void> inform_client_request_started();
     void transfer_headers_to_client_if_needed();
     ErrorOr<void> write_queued_bytes_without_blocking();
 
     virtual bool is_revalidation_request() const override;
     ErrorOr<void> revalidation_failed();
+    bool can_serve_stale_response_on_error(Optional<int> curl_result_code) const;
+    bool serve_stale_response_on_error(Optional<int> curl_result_code);
 
     bool is_cache_only_request() const;
 
@@ -260,6 +275,10 @@ private:
 
     Optional<Requests::NetworkError> m_network_error;
 
+    // Span starts for RequestTrace
+    Optional<MonotonicTime> m_curl_added_at;
+    Optional<MonotonicTime> m_pipe_back_pressure_started_at;
+
     // IPFS Integration: Start
     ProtocolType m_protocol_type { ProtocolType::HTTP };
     Function<ErrorOr<bool>(ReadonlyBytes)> m_content_verification_callback;
@@ -270,6 +289,15 @@ private:
     SecurityTap* m_security_tap { nullptr };
     u64 m_page_id { 0 };
     Optional<ByteString> m_security_alert_json;  // Stored alert for quarantine (Phase 3 Day 19)
+    bool m_checked_for_streamed_body_scan { false };
+    Optional<u64> m_stream_scan_id;
+    ByteBuffer m_stream_scan_window; // Not yet passed on to the client
+    OwnPtr<Crypto::Hash::SHA256> m_stream_body_hasher;
+    bool m_stream_scan_in_flight { false };
+    bool m_stream_scan_paused_transfer { false };
+    bool m_stream_scan_aborted_transfer { false };
+    Optional<bool> m_stream_scan_window_awaiting_queue; // Set (to is_end_of_stream) while the scan backlog is full
+    RefPtr<Core::Timer> m_scan_backpressure_timer;
 };
 
 }
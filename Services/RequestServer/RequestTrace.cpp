@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
+#include <RequestServer/RequestTrace.h>
+
+namespace RequestServer {
+
+StringView trace_span_name(TraceSpan span)
+{
+    switch (span) {
+    case TraceSpan::CacheLookup:
+        return "cache-lookup"sv;
+    case TraceSpan::DNSLookup:
+        return "dns"sv;
+    case TraceSpan::Connect:
+        return "connect"sv;
+    case TraceSpan::TLSHandshake:
+        return "tls"sv;
+    case TraceSpan::TimeToFirstByte:
+        return "ttfb"sv;
+    case TraceSpan::SecurityScan:
+        return "security-scan"sv;
+    case TraceSpan::PipeBackPressure:
+        return "pipe-back-pressure"sv;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+RequestTrace& RequestTrace::the()
+{
+    static auto* trace = new RequestTrace;
+    return *trace;
+}
+
+void RequestTrace::record(u64 request_id, TraceSpan span, MonotonicTime start, MonotonicTime end)
+{
+    // Also show up in the browser-wide trace, when one is being recorded, alongside the other processes' events.
+    Core::record_trace_event("network"sv, trace_span_name(span), start, end);
+
+    if (!is_enabled())
+        return;
+
+    auto index = m_next_index.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    auto& slot = m_slots[index % CAPACITY];
+
+    slot.sequence.store(0);
+    atomic_thread_fence(AK::MemoryOrder::memory_order_release);
+
+    slot.request_id.store(request_id);
+    slot.span.store(to_underlying(span));
+    slot.start_microseconds.store(start.nanoseconds() / 1000);
+    slot.duration_microseconds.store(max<i64>((end - start).to_microseconds(), 0));
+
+    slot.sequence.store(index + 1, AK::MemoryOrder::memory_order_release);
+}
+
+String RequestTrace::to_chrome_trace_json() const
+{
+    auto pid = Core::System::getpid();
+
+    JsonArray events;
+    for (auto const& slot : m_slots) {
+        auto sequence = slot.sequence.load(AK::MemoryOrder::memory_order_acquire);
+        if (sequence == 0)
+            continue;
+
+        auto request_id = slot.request_id.load();
+        auto span = static_cast<TraceSpan>(slot.span.load());
+        auto start_microseconds = slot.start_microseconds.load();
+        auto duration_microseconds = slot.duration_microseconds.load();
+
+        atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
+        if (slot.sequence.load() != sequence)
+            continue;
+
+        // https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU ("Complete Events")
+        JsonObject event;
+        event.set("name"sv, trace_span_name(span));
+        event.set("cat"sv, "request"sv);
+        event.set("ph"sv, "X"sv);
+        event.set("ts"sv, start_microseconds);
+        event.set("dur"sv, duration_microseconds);
+        event.set("pid"sv, pid);
+        event.set("tid"sv, request_id);
+        events.must_append(move(event));
+    }
+
+    JsonObject trace;
+    trace.set("traceEvents"sv, move(events));
+    trace.set("displayTimeUnit"sv, "ms"sv);
+    return trace.serialized();
+}
+
+}
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/String.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+
+namespace RequestServer {
+
+enum class TraceSpan : u8 {
+    CacheLookup,
+    DNSLookup,
+    Connect,
+    TLSHandshake,
+    TimeToFirstByte,
+    SecurityScan,
+    PipeBackPressure,
+};
+
+StringView trace_span_name(TraceSpan);
+
+// Where each request's time went, as a fixed ring of the most recent spans. Recording is a handful of relaxed stores
+// and never blocks, so the ring can stay enabled in production; once full, the oldest spans are overwritten.
+//
+// Exported as Chrome trace-event JSON, which chrome://tracing, Perfetto and most trace tooling import directly. Each
+// request is its own track, keyed by request ID.
+class RequestTrace {
+public:
+    static constexpr size_t CAPACITY = 16 * KiB;
+
+    static RequestTrace& the();
+
+    void enable() { m_enabled.store(true); }
+    bool is_enabled() const { return m_enabled.load(); }
+
+    void record(u64 request_id, TraceSpan, MonotonicTime start, MonotonicTime end);
+
+    String to_chrome_trace_json() const;
+
+private:
+    RequestTrace() = default;
+
+    // A slot's sequence is zero while it is being written and otherwise one past the index of the span it holds, so a
+    // reader that sees the same non-zero sequence before and after copying a slot knows the copy is not torn.
+    struct Slot {
+        Atomic<u64, AK::MemoryOrder::memory_order_relaxed> sequence { 0 };
+        Atomic<u64, AK::MemoryOrder::memory_order_relaxed> request_id { 0 };
+        Atomic<u8, AK::MemoryOrder::memory_order_relaxed> span { 0 };
+        Atomic<i64, AK::MemoryOrder::memory_order_relaxed> start_microseconds { 0 };
+        Atomic<i64, AK::MemoryOrder::memory_order_relaxed> duration_microseconds { 0 };
+    };
+
+    Atomic<bool, AK::MemoryOrder::memory_order_relaxed> m_enabled { false };
+    Atomic<u64> m_next_index { 0 };
+    Array<Slot, CAPACITY> m_slots;
+};
+
+}
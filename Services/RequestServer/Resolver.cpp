@@ -56,9 +56,13 @@ NonnullRefPtr<Resolver> Resolver::default_resolver()
             if (!g_default_certificate_path.is_empty())
                 options.root_certificates_path = g_default_certificate_path;
 
+            // https://www.iana.org/assignments/tls-extensiontype-values/tls-extensiontype-values.xhtml#alpn-protocol-ids
+            options.alpn_protocols.append("dot");
+
             return DNS::Resolver::SocketResult {
                 MaybeOwned<Core::Socket>(TRY(TLS::TLSv12::connect(*dns_info.server_address, *dns_info.server_hostname, move(options)))),
                 DNS::Resolver::ConnectionMode::TCP,
+                true,
             };
         }
 
@@ -5,12 +5,18 @@
  */
 
 #include "ScanQueue.h"
-#include <AK/QuickSort.h>
+#include <sched.h>
 
 namespace RequestServer {
 
 ScanQueue::ScanQueue()
-    : m_condition_variable(make<Sync::ConditionVariable>(m_mutex))
+    : m_buckets {
+        make<BoundedMPMCRing<ScanRequest>>(BUCKET_CAPACITY),
+        make<BoundedMPMCRing<ScanRequest>>(BUCKET_CAPACITY),
+        make<BoundedMPMCRing<ScanRequest>>(BUCKET_CAPACITY),
+        make<BoundedMPMCRing<ScanRequest>>(BUCKET_CAPACITY),
+    }
+    , m_park_condition(make<Sync::ConditionVariable>(m_park_mutex))
 {
 }
 
@@ -19,75 +25,138 @@ ScanQueue::~ScanQueue()
     // ConditionVariable cleanup is automatic via RAII
 }
 
-ErrorOr<void> ScanQueue::enqueue(ScanRequest request)
+ScanQueue::SizeBucket ScanQueue::bucket_for_priority(size_t priority)
 {
-    Sync::MutexLocker locker(m_mutex);
+    // Priority is the content size in MB (see YARAScanWorkerPool::enqueue_scan)
+    if (priority < 1)
+        return SizeBucket::Small;
+    if (priority < 10)
+        return SizeBucket::Medium;
+    if (priority < 100)
+        return SizeBucket::Large;
+    return SizeBucket::Huge;
+}
 
-    // Check if queue is full
-    if (m_queue.size() >= MAX_QUEUE_SIZE) {
-        return Error::from_string_literal("Scan queue is full - rejecting request");
+ErrorOr<void> ScanQueue::enqueue(ScanRequest&& request)
+{
+    if (is_shutting_down())
+        return Error::from_string_literal("Scan queue is shutting down");
+
+    // Reserve our share of the byte budget up front; a single request larger than the whole budget is
+    // still accepted when nothing else is queued, otherwise it could never be scanned asynchronously.
+    auto content_size = request.content.size();
+    auto previous_bytes = m_queued_bytes.fetch_add(content_size);
+    if (previous_bytes != 0 && previous_bytes + content_size > MAX_QUEUED_BYTES) {
+        m_queued_bytes.fetch_sub(content_size);
+        return Error::from_string_literal("Scan queue byte budget exhausted - rejecting request");
     }
 
-    // Check if shutting down
-    if (m_shutting_down) {
-        return Error::from_string_literal("Scan queue is shutting down");
+    auto depth = m_size.fetch_add(1) + 1;
+
+    auto& bucket = *m_buckets[to_underlying(bucket_for_priority(request.priority))];
+    if (!bucket.try_push(request)) {
+        m_size.fetch_sub(1);
+        m_queued_bytes.fetch_sub(content_size);
+        return Error::from_string_literal("Scan queue is full - rejecting request");
     }
 
-    // Add to queue
-    m_queue.append(move(request));
+    record(m_queue_depth_counts, QUEUE_DEPTH_BUCKETS, depth);
 
-    // Sort by priority (lower number = higher priority)
-    // This ensures small files are scanned first
-    quick_sort(m_queue, [](ScanRequest const& a, ScanRequest const& b) {
-        return a.priority < b.priority;
-    });
+    // Signal a parked worker, if any; the common case of busy workers never touches the mutex
+    if (m_parked_workers.load() > 0) {
+        Sync::MutexLocker locker(m_park_mutex);
+        m_park_condition->signal();
+    }
 
-    // Signal waiting worker threads that work is available
-    m_condition_variable->signal();
+    return {};
+}
 
+Optional<ScanRequest> ScanQueue::try_dequeue()
+{
+    // Smallest size class first, to keep small files ahead of large ones
+    for (auto& bucket : m_buckets) {
+        auto request = bucket->try_pop();
+        if (!request.has_value())
+            continue;
+
+        m_size.fetch_sub(1);
+        m_queued_bytes.fetch_sub(request->content.size());
+
+        auto wait_time = UnixDateTime::now() - request->enqueued_time;
+        record(m_wait_time_counts, WAIT_TIME_BUCKETS_MS, static_cast<u64>(max(wait_time.to_milliseconds(), 0)));
+        return request;
+    }
     return {};
 }
 
 Optional<ScanRequest> ScanQueue::dequeue()
 {
-    Sync::MutexLocker locker(m_mutex);
+    while (true) {
+        if (auto request = try_dequeue(); request.has_value())
+            return request;
+
+        if (is_shutting_down())
+            return {};
+
+        // A producer may have reserved a slot but not published it yet; give it a moment
+        if (m_size.load() != 0) {
+            sched_yield();
+            continue;
+        }
+
+        // Park until a producer signals us or we are shutting down. Registering as parked before
+        // re-checking the size under the mutex means a concurrent enqueue cannot miss us.
+        Sync::MutexLocker locker(m_park_mutex);
+        m_parked_workers.fetch_add(1);
+        m_park_condition->wait_while([this] {
+            return m_size.load() == 0 && !is_shutting_down();
+        });
+        m_parked_workers.fetch_sub(1);
+    }
+}
 
-    // Wait until queue has items or we're shutting down
-    // This blocks efficiently using a condition variable instead of spinning
-    m_condition_variable->wait_while([this] {
-        return m_queue.is_empty() && !m_shutting_down;
-    });
+bool ScanQueue::is_saturated() const
+{
+    if (queued_bytes() >= BACKPRESSURE_THRESHOLD_BYTES)
+        return true;
 
-    // If shutting down and queue is empty, return nothing
-    if (m_shutting_down && m_queue.is_empty()) {
-        return {};
-    }
+    // Also back off when requests are piling up, before the busiest bucket can overflow
+    return size() >= BACKPRESSURE_THRESHOLD_REQUESTS;
+}
 
-    // Take the highest priority request (first in sorted queue)
-    auto request = move(m_queue.first());
-    m_queue.remove(0);
+void ScanQueue::shutdown()
+{
+    Sync::MutexLocker locker(m_park_mutex);
+    m_shutting_down.store(true, AK::MemoryOrder::memory_order_release);
+    // Wake all waiting threads so they can exit
+    m_park_condition->broadcast();
+}
 
-    return request;
+ScanQueueHistogram ScanQueue::queue_depth_histogram() const
+{
+    return snapshot(m_queue_depth_counts, QUEUE_DEPTH_BUCKETS);
 }
 
-size_t ScanQueue::size() const
+ScanQueueHistogram ScanQueue::wait_time_histogram_ms() const
 {
-    Sync::MutexLocker locker(m_mutex);
-    return m_queue.size();
+    return snapshot(m_wait_time_counts, WAIT_TIME_BUCKETS_MS);
 }
 
-void ScanQueue::shutdown()
+void ScanQueue::record(AtomicHistogramCounts& counts, Array<u64, ScanQueueHistogram::BUCKET_COUNT - 1> const& upper_bounds, u64 value)
 {
-    Sync::MutexLocker locker(m_mutex);
-    m_shutting_down = true;
-    // Wake all waiting threads so they can exit
-    m_condition_variable->broadcast();
+    size_t index = 0;
+    while (index < upper_bounds.size() && value > upper_bounds[index])
+        ++index;
+    counts[index].fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
 }
 
-bool ScanQueue::is_shutting_down() const
+ScanQueueHistogram ScanQueue::snapshot(AtomicHistogramCounts const& counts, Array<u64, ScanQueueHistogram::BUCKET_COUNT - 1> const& upper_bounds)
 {
-    Sync::MutexLocker locker(m_mutex);
-    return m_shutting_down;
+    ScanQueueHistogram histogram;
+    histogram.upper_bounds = upper_bounds;
+    for (size_t i = 0; i < counts.size(); ++i)
+        histogram.counts[i] = counts[i].load(AK::MemoryOrder::memory_order_relaxed);
+    return histogram;
 }
 
 }
@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
 #include <AK/ByteBuffer.h>
 #include <AK/Error.h>
 #include <AK/Function.h>
@@ -13,10 +15,11 @@
 #include <AK/Optional.h>
 #include <AK/String.h>
 #include <AK/Time.h>
-#include <AK/Vector.h>
+#include <LibCore/EventLoop.h>
 #include <LibSync/ConditionVariable.h>
 #include <LibSync/Mutex.h>
 #include <Services/RequestServer/SecurityTap.h>
+#include <Services/Sentinel/BoundedMPMCRing.h>
 
 namespace RequestServer {
 
@@ -24,20 +27,64 @@ namespace RequestServer {
 struct ScanRequest {
     String request_id;
     ByteBuffer content;
+    ByteString sha256; // Lowercase hex digest of content, if the caller already has it
     Function<void(ErrorOr<SecurityTap::ScanResult>)> callback;
     UnixDateTime enqueued_time;
     size_t priority; // Lower number = higher priority (small files first)
+
+    // Set for a window of a streamed body (see SecurityTap::async_scan_stream_window())
+    Optional<u64> stream_id {};
+    bool is_end_of_stream { false };
+
+    // Event loop of the thread that queued the request; the callback runs there
+    RefPtr<Core::WeakEventLoopReference> origin_event_loop {};
+};
+
+// Fixed-bucket histogram; the last bucket counts everything above the final upper bound
+struct ScanQueueHistogram {
+    static constexpr size_t BUCKET_COUNT = 9;
+
+    Array<u64, BUCKET_COUNT - 1> upper_bounds {};
+    Array<u64, BUCKET_COUNT> counts {};
+
+    u64 total() const
+    {
+        u64 sum = 0;
+        for (auto count : counts)
+            sum += count;
+        return sum;
+    }
 };
 
-// Thread-safe queue for scan requests with priority ordering
+using Sentinel::BoundedMPMCRing;
+
+// Thread-safe queue for scan requests with size-bucketed priority ordering
+//
+// Requests are sorted into one lock-free ring per size class, and workers always drain the smallest
+// class first, so small files keep their priority without sorting on every enqueue. Workers only take
+// a lock to park when every bucket is empty.
+//
+// Instead of a fixed request count, the queue is bounded by the number of content bytes it holds.
+// is_saturated() reports when producers should stop feeding it (e.g. by pausing the transfer).
 class ScanQueue {
 public:
     ScanQueue();
     ~ScanQueue();
 
-    // Enqueue a scan request (thread-safe)
-    // Returns error if queue is full
-    ErrorOr<void> enqueue(ScanRequest request);
+    // Size classes, in the order workers drain them
+    enum class SizeBucket : u8 {
+        Small,  // < 1MB
+        Medium, // < 10MB
+        Large,  // < 100MB
+        Huge,   // >= 100MB
+    };
+    static constexpr size_t SIZE_BUCKET_COUNT = 4;
+    static SizeBucket bucket_for_priority(size_t priority);
+
+    // Enqueue a scan request (thread-safe, lock-free)
+    // Returns error if the request's bucket is full or the byte budget is exhausted; the request is
+    // then left untouched, so the caller can still complete its callback
+    ErrorOr<void> enqueue(ScanRequest&& request);
 
     // Dequeue highest priority scan request (thread-safe)
     // Blocks if queue is empty and not shutting down
@@ -45,22 +92,57 @@ public:
     Optional<ScanRequest> dequeue();
 
     // Get current queue depth (thread-safe)
-    size_t size() const;
+    size_t size() const { return m_size.load(AK::MemoryOrder::memory_order_relaxed); }
+
+    // Bytes of content currently waiting to be scanned (thread-safe)
+    size_t queued_bytes() const { return m_queued_bytes.load(AK::MemoryOrder::memory_order_relaxed); }
+
+    // Whether producers should hold back new work until the workers catch up (thread-safe)
+    bool is_saturated() const;
 
     // Signal shutdown - causes dequeue() to return empty Optional
     void shutdown();
 
     // Check if queue is shutting down
-    bool is_shutting_down() const;
+    bool is_shutting_down() const { return m_shutting_down.load(AK::MemoryOrder::memory_order_acquire); }
 
-    // Maximum queue size before rejecting new requests
-    static constexpr size_t MAX_QUEUE_SIZE = 100;
+    ScanQueueHistogram queue_depth_histogram() const;
+    ScanQueueHistogram wait_time_histogram_ms() const;
+
+    // Slots per size bucket (must be a power of two)
+    static constexpr size_t BUCKET_CAPACITY = 64;
+
+    // Byte budget: enqueue fails beyond MAX_QUEUED_BYTES, producers are asked to back off from
+    // BACKPRESSURE_THRESHOLD_BYTES onwards
+    static constexpr size_t MAX_QUEUED_BYTES = 512 * 1024 * 1024;
+    static constexpr size_t BACKPRESSURE_THRESHOLD_BYTES = 256 * 1024 * 1024;
+    static constexpr size_t BACKPRESSURE_THRESHOLD_REQUESTS = (BUCKET_CAPACITY * 3) / 4;
+
+    static constexpr Array<u64, ScanQueueHistogram::BUCKET_COUNT - 1> QUEUE_DEPTH_BUCKETS { 1, 2, 4, 8, 16, 32, 64, 128 };
+    static constexpr Array<u64, ScanQueueHistogram::BUCKET_COUNT - 1> WAIT_TIME_BUCKETS_MS { 1, 5, 10, 50, 100, 500, 1000, 5000 };
 
 private:
-    mutable Sync::Mutex m_mutex;
-    NonnullOwnPtr<Sync::ConditionVariable> m_condition_variable;
-    Vector<ScanRequest> m_queue;
-    bool m_shutting_down { false };
+    using AtomicHistogramCounts = Array<Atomic<u64>, ScanQueueHistogram::BUCKET_COUNT>;
+
+    static void record(AtomicHistogramCounts&, Array<u64, ScanQueueHistogram::BUCKET_COUNT - 1> const& upper_bounds, u64 value);
+    static ScanQueueHistogram snapshot(AtomicHistogramCounts const&, Array<u64, ScanQueueHistogram::BUCKET_COUNT - 1> const& upper_bounds);
+
+    Optional<ScanRequest> try_dequeue();
+
+    Array<NonnullOwnPtr<BoundedMPMCRing<ScanRequest>>, SIZE_BUCKET_COUNT> m_buckets;
+
+    // Reserved before a push and released after a pop, so they never under-count what is queued
+    Atomic<size_t> m_size { 0 };
+    Atomic<size_t> m_queued_bytes { 0 };
+    Atomic<bool> m_shutting_down { false };
+
+    // Only used to park idle workers; producers take it only when a worker is actually parked
+    Sync::Mutex m_park_mutex;
+    NonnullOwnPtr<Sync::ConditionVariable> m_park_condition;
+    Atomic<size_t> m_parked_workers { 0 };
+
+    AtomicHistogramCounts m_queue_depth_counts {};
+    AtomicHistogramCounts m_wait_time_counts {};
 };
 
 }
@@ -117,6 +117,9 @@ struct ScanTelemetry {
     size_t peak_memory_usage { 0 };
     size_t total_scan_time_ms { 0 };
 
+    // Downloads answered from the verdict cache without contacting Sentinel
+    size_t verdict_cache_hits { 0 };
+
     // Get scan count by tier
     size_t get_tier_count(char const* tier) const
     {
@@ -142,6 +145,7 @@ struct ScanTelemetry {
         total_files_scanned = 0;
         peak_memory_usage = 0;
         total_scan_time_ms = 0;
+        verdict_cache_hits = 0;
     }
 };
 
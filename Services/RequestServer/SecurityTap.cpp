@@ -5,29 +5,41 @@
  */
 
 #include "SecurityTap.h"
+#include "VerdictCache.h"
 #include "YARAScanWorkerPool.h"
 #include <AK/Base64.h>
+#include <AK/Hex.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonParser.h>
 #include <AK/JsonValue.h>
-#include <AK/StringBuilder.h>
+#include <LibCore/AnonymousBuffer.h>
 #include <LibCore/ElapsedTimer.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Socket.h>
-#include <openssl/evp.h>
-#include <openssl/sha.h>
+#include <LibCore/StandardPaths.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibIPC/BufferedIPCReader.h>
+#include <LibIPC/BufferedIPCWriter.h>
+#include <Services/Sentinel/PolicyGraph.h>
 
 namespace RequestServer {
 
 ErrorOr<NonnullOwnPtr<SecurityTap>> SecurityTap::create()
+{
+    // Verdict cache, shared with the other RequestServer processes. This lives inside the cache
+    // directory the sandbox leaves writable.
+    return create("/tmp/sentinel.sock", ByteString::formatted("{}/Ladybird/sentinel", Core::StandardPaths::cache_directory()));
+}
+
+ErrorOr<NonnullOwnPtr<SecurityTap>> SecurityTap::create(ByteString socket_path, Optional<ByteString> verdict_cache_directory)
 {
     // Connect to Sentinel daemon
-    auto socket = TRY(Core::LocalSocket::connect("/tmp/sentinel.sock"_string.to_byte_string()));
+    auto socket = TRY(Core::LocalSocket::connect(socket_path));
 
     // Set socket timeout to 5 seconds (fail-fast if Sentinel hangs)
     // FIXME: Add timeout configuration
 
-    auto security_tap = adopt_own(*new SecurityTap(move(socket)));
+    auto security_tap = adopt_own(*new SecurityTap(move(socket), move(socket_path)));
     dbgln("SecurityTap: Connected to Sentinel daemon");
 
     // Initialize worker pool for async YARA scanning
@@ -36,11 +48,39 @@ ErrorOr<NonnullOwnPtr<SecurityTap>> SecurityTap::create()
     security_tap->m_worker_pool = move(worker_pool);
     dbgln("SecurityTap: Worker pool started with 4 threads");
 
+    // The verdict cache is optional: without it every download is scanned
+    if (!verdict_cache_directory.has_value())
+        return security_tap;
+
+    auto const& cache_directory = *verdict_cache_directory;
+    OwnPtr<Sentinel::PolicyGraph> cold_tier;
+    if (auto policy_graph = Sentinel::PolicyGraph::create(cache_directory); policy_graph.is_error())
+        dbgln("SecurityTap: Verdict cache cold tier unavailable: {}", policy_graph.error());
+    else
+        cold_tier = policy_graph.release_value();
+
+    // Cached verdicts can always be recomputed, so losing the last batch in a crash is harmless
+    if (cold_tier) {
+        if (auto result = cold_tier->set_write_durability(Sentinel::PolicyGraph::WriteDurability::GroupCommit); result.is_error())
+            dbgln("SecurityTap: Verdict cache group commit unavailable: {}", result.error());
+    }
+
+    if (auto verdict_cache = VerdictCache::create(cache_directory, move(cold_tier)); verdict_cache.is_error()) {
+        dbgln("SecurityTap: Verdict cache unavailable: {}", verdict_cache.error());
+    } else {
+        security_tap->m_verdict_cache = verdict_cache.release_value();
+        dbgln("SecurityTap: Verdict cache enabled");
+
+        Sync::MutexLocker locker(security_tap->m_socket_mutex);
+        security_tap->write_rules_version_subscription();
+    }
+
     return security_tap;
 }
 
-SecurityTap::SecurityTap(NonnullOwnPtr<Core::Socket> socket)
+SecurityTap::SecurityTap(NonnullOwnPtr<Core::LocalSocket> socket, ByteString socket_path)
     : m_sentinel_socket(move(socket))
+    , m_socket_path(move(socket_path))
     , m_connection_failed(false)
 {
 }
@@ -66,60 +106,62 @@ ErrorOr<void> SecurityTap::reconnect()
     dbgln("SecurityTap: Attempting to reconnect to Sentinel...");
 
     // Try to connect to Sentinel daemon
-    auto socket_result = Core::LocalSocket::connect("/tmp/sentinel.sock"_string.to_byte_string());
+    auto socket_result = Core::LocalSocket::connect(m_socket_path);
     if (socket_result.is_error()) {
         dbgln("SecurityTap: Reconnection failed: {}", socket_result.error());
         return socket_result.release_error();
     }
 
+    // Responses to requests sent on the old connection will never arrive, so wake up whoever is waiting for them.
+    // Nobody can be reading the old socket once it's replaced below.
+    {
+        Sync::MutexLocker locker(m_response_mutex);
+        m_response_condition.wait_while([this] { return m_response_reader_active; });
+        ++m_connection_generation;
+        m_unclaimed_responses.clear();
+        m_response_condition.broadcast();
+    }
+
     m_sentinel_socket = socket_result.release_value();
     m_connection_failed = false;
 
+    // Rules may have changed while we were disconnected; the subscription reply carries the current version
+    if (m_verdict_cache)
+        write_rules_version_subscription();
+
     dbgln("SecurityTap: Successfully reconnected to Sentinel");
     return {};
 }
 
 ErrorOr<ByteString> SecurityTap::compute_sha256(ReadonlyBytes data)
 {
-    unsigned char hash[SHA256_DIGEST_LENGTH];
-
-    EVP_MD_CTX* context = EVP_MD_CTX_new();
-    if (!context)
-        return Error::from_string_literal("Failed to create EVP context");
-
-    if (EVP_DigestInit_ex(context, EVP_sha256(), nullptr) != 1) {
-        EVP_MD_CTX_free(context);
-        return Error::from_string_literal("Failed to initialize SHA256");
-    }
-
-    if (EVP_DigestUpdate(context, data.data(), data.size()) != 1) {
-        EVP_MD_CTX_free(context);
-        return Error::from_string_literal("Failed to update SHA256");
-    }
-
-    if (EVP_DigestFinal_ex(context, hash, nullptr) != 1) {
-        EVP_MD_CTX_free(context);
-        return Error::from_string_literal("Failed to finalize SHA256");
-    }
-
-    EVP_MD_CTX_free(context);
-
-    StringBuilder hex_builder;
-    for (size_t i = 0; i < SHA256_DIGEST_LENGTH; i++)
-        hex_builder.appendff("{:02x}", hash[i]);
-
-    return hex_builder.to_byte_string();
+    auto digest = Crypto::Hash::SHA256::hash(data.data(), data.size());
+    return encode_hex(digest.bytes());
 }
 
 ErrorOr<SecurityTap::ScanResult> SecurityTap::inspect_download(
     DownloadMetadata const& metadata,
     ReadonlyBytes content)
 {
+    // Repeat downloads of the same content (JS bundles, installers fetched from several tabs)
+    // are answered from the verdict cache without a round trip to Sentinel
+    ByteString sha256 = metadata.sha256;
+    if (m_verdict_cache && sha256.is_empty())
+        sha256 = TRY(compute_sha256(content));
+
+    if (auto cached = cached_scan_result(sha256); cached.has_value()) {
+        dbgln("SecurityTap: Verdict cache hit for {} ({})", metadata.filename, cached->is_threat ? "threat"sv : "clean"sv);
+        return cached.release_value();
+    }
+
     // Use size-based scanning strategy
     auto start_time = Core::ElapsedTimer::start_new();
     auto result = TRY(scan_with_size_limits(metadata, content));
     auto elapsed_ms = start_time.elapsed_milliseconds();
 
+    if (m_verdict_cache && result.rules_version.has_value())
+        m_verdict_cache->store(sha256, { .is_threat = result.is_threat, .alert_json = result.alert_json }, *result.rules_version);
+
     // Update telemetry
     if (m_scan_size_config.enable_telemetry) {
         m_telemetry.total_files_scanned++;
@@ -176,6 +218,15 @@ ErrorOr<SecurityTap::ScanResult> SecurityTap::scan_with_size_limits(
     return ScanResult { .is_threat = false, .alert_json = {} };
 }
 
+// Sentinel reports the YARA rule-set version with every verdict it reaches
+static Optional<u64> rules_version_from_response(JsonObject const& response)
+{
+    auto version = response.get_string("rules_version"sv);
+    if (!version.has_value())
+        return {};
+    return version->to_number<u64>();
+}
+
 ErrorOr<SecurityTap::ScanResult> SecurityTap::scan_small_file(
     DownloadMetadata const& metadata,
     ReadonlyBytes content)
@@ -242,7 +293,7 @@ ErrorOr<SecurityTap::ScanResult> SecurityTap::scan_small_file(
     // If result is "clean", no threat detected
     if (result.value() == "clean"sv) {
         dbgln("SecurityTap: File clean: {}", metadata.filename);
-        return ScanResult { .is_threat = false, .alert_json = {} };
+        return ScanResult { .is_threat = false, .alert_json = {}, .rules_version = rules_version_from_response(obj) };
     }
 
     // Otherwise, result contains threat detection JSON
@@ -250,7 +301,8 @@ ErrorOr<SecurityTap::ScanResult> SecurityTap::scan_small_file(
 
     return ScanResult {
         .is_threat = true,
-        .alert_json = ByteString(result.value())
+        .alert_json = ByteString(result.value()),
+        .rules_version = rules_version_from_response(obj)
     };
 }
 
@@ -258,61 +310,443 @@ ErrorOr<ByteString> SecurityTap::send_scan_request(
     DownloadMetadata const& metadata,
     ReadonlyBytes content)
 {
-    // Check if connection is alive, attempt reconnect if needed
-    if (m_connection_failed) {
-        auto reconnect_result = reconnect();
-        if (reconnect_result.is_error()) {
-            return Error::from_string_literal("Sentinel connection lost and reconnection failed");
+    {
+        Sync::MutexLocker locker(m_socket_mutex);
+
+        // Check if connection is alive, attempt reconnect if needed
+        if (m_connection_failed) {
+            auto reconnect_result = reconnect();
+            if (reconnect_result.is_error()) {
+                return Error::from_string_literal("Sentinel connection lost and reconnection failed");
+            }
         }
     }
 
-    // Build JSON request for Sentinel
-    JsonObject request;
-    request.set("action"sv, JsonValue("scan_content"sv));
-    request.set("request_id"sv, JsonValue(MUST(String::formatted("download_{}", metadata.sha256))));
+    // Prefer the zero-copy shared buffer protocol; the JSON protocol is only used when anonymous
+    // buffers are unavailable, since it cannot carry more than ~7.5MB in a single framed message.
+    if (content.size() <= Sentinel::ScanProtocol::MAX_SHARED_BUFFER_SCAN_SIZE) {
+        auto result = send_shared_buffer_scan_request(content);
+        if (!result.is_error() || m_connection_failed)
+            return result;
+        dbgln("SecurityTap: Shared buffer scan unavailable ({}), falling back to JSON", result.error());
+    }
 
-    // Base64 encode content for JSON transport
-    auto content_base64 = TRY(encode_base64(content));
-    request.set("content"sv, JsonValue(content_base64));
+    return send_json_scan_request(metadata, content);
+}
 
-    // Serialize and send
-    auto request_json = request.serialized();
-    auto request_bytes = request_json.bytes();
+void SecurityTap::dispatch_message(ByteString message)
+{
+    auto json = JsonValue::from_string(message);
+    if (json.is_error() || !json.value().is_object()) {
+        dbgln("SecurityTap: Dropping malformed Sentinel message");
+        return;
+    }
 
-    auto write_result = m_sentinel_socket->write_until_depleted(request_bytes);
-    if (write_result.is_error()) {
-        m_connection_failed = true;
-        dbgln("SecurityTap: Failed to write to Sentinel socket: {}", write_result.error());
-        return write_result.release_error();
+    auto const& object = json.value().as_object();
+    auto request_id = object.get_string("request_id"sv);
+    auto event = object.get_string("event"sv);
+
+    // Rules version changes pushed by Sentinel, and the reply to the subscription asking for them
+    bool is_rules_version_message = (event.has_value() && *event == "rules_version_changed"sv)
+        || (request_id.has_value() && *request_id == RULES_VERSION_SUBSCRIPTION_REQUEST_ID);
+    if (is_rules_version_message) {
+        if (auto version = rules_version_from_response(object); version.has_value() && m_verdict_cache)
+            m_verdict_cache->set_rule_set_version(*version);
+        return;
     }
 
-    // Add newline delimiter (Sentinel expects JSON Lines format)
-    u8 newline = '\n';
-    auto newline_result = m_sentinel_socket->write_until_depleted({ &newline, 1 });
-    if (newline_result.is_error()) {
-        m_connection_failed = true;
-        dbgln("SecurityTap: Failed to write newline to Sentinel socket: {}", newline_result.error());
-        return newline_result.release_error();
+    if (!request_id.has_value()) {
+        dbgln("SecurityTap: Dropping Sentinel response without a request_id");
+        return;
+    }
+    m_unclaimed_responses.set(request_id->to_byte_string(), move(message));
+}
+
+void SecurityTap::read_pushed_messages()
+{
+    Sync::MutexLocker locker(m_response_mutex);
+
+    // A thread waiting for a response reads pushed messages as soon as they arrive
+    if (m_response_reader_active || m_connection_failed)
+        return;
+
+    m_response_reader_active = true;
+    locker.unlock();
+
+    Vector<ByteString> messages;
+    Optional<Error> read_error;
+    while (true) {
+        auto can_read = m_sentinel_socket->can_read_without_blocking(0);
+        if (can_read.is_error() || !can_read.value())
+            break;
+
+        IPC::BufferedIPCReader reader;
+        auto message = reader.read_complete_message(*m_sentinel_socket, AK::Duration::from_seconds(30));
+        if (message.is_error()) {
+            read_error = message.release_error();
+            break;
+        }
+        messages.append(ByteString { message.value().bytes() });
     }
 
-    // Read response (blocking with timeout)
-    auto response_buffer = TRY(ByteBuffer::create_uninitialized(4096));
-    auto bytes_read_result = m_sentinel_socket->read_some(response_buffer);
+    locker.lock();
+    m_response_reader_active = false;
+    for (auto& message : messages)
+        dispatch_message(move(message));
 
-    if (bytes_read_result.is_error()) {
+    if (read_error.has_value()) {
         m_connection_failed = true;
-        dbgln("SecurityTap: Failed to read from Sentinel socket: {}", bytes_read_result.error());
-        return bytes_read_result.release_error();
+        ++m_connection_generation;
+        dbgln("SecurityTap: Failed to read Sentinel message: {}", *read_error);
     }
+    m_response_condition.broadcast();
+}
 
-    auto bytes_read = bytes_read_result.release_value();
+void SecurityTap::write_rules_version_subscription()
+{
+    JsonObject request;
+    request.set("action"sv, "subscribe_rules_version"sv);
+    request.set("request_id"sv, RULES_VERSION_SUBSCRIPTION_REQUEST_ID);
+    auto request_json = request.serialized();
 
-    if (bytes_read.is_empty()) {
-        m_connection_failed = true;
-        return Error::from_string_literal("Sentinel socket closed");
+    // The reply is handled by whichever thread reads it, like the pushes that follow
+    IPC::BufferedIPCWriter writer;
+    if (auto result = writer.write_message(*m_sentinel_socket, request_json.bytes_as_string_view()); result.is_error())
+        dbgln("SecurityTap: Failed to subscribe to rules version changes: {}", result.error());
+}
+
+Optional<SecurityTap::ScanResult> SecurityTap::cached_scan_result(StringView sha256)
+{
+    if (!m_verdict_cache || sha256.is_empty())
+        return {};
+
+    // Apply any rules version change Sentinel has pushed, so no verdict reached with the old rules is served
+    read_pushed_messages();
+
+    auto cached = m_verdict_cache->lookup(sha256);
+    if (!cached.has_value())
+        return {};
+
+    if (m_scan_size_config.enable_telemetry)
+        m_telemetry.verdict_cache_hits++;
+    return ScanResult { .is_threat = cached->is_threat, .alert_json = move(cached->alert_json) };
+}
+
+ErrorOr<ByteString> SecurityTap::wait_for_response(ByteString const& request_id, u64 connection_generation)
+{
+    Sync::MutexLocker locker(m_response_mutex);
+    while (true) {
+        if (auto response = m_unclaimed_responses.take(request_id); response.has_value())
+            return response.release_value();
+        if (m_connection_generation != connection_generation)
+            return Error::from_string_literal("Sentinel connection lost while waiting for a response");
+        if (m_response_reader_active) {
+            m_response_condition.wait();
+            continue;
+        }
+
+        // Nobody is reading, so read the next response, whoever it's for
+        m_response_reader_active = true;
+        locker.unlock();
+        IPC::BufferedIPCReader reader;
+        auto message = reader.read_complete_message(*m_sentinel_socket, AK::Duration::from_seconds(30));
+        locker.lock();
+        m_response_reader_active = false;
+        m_response_condition.broadcast();
+
+        if (message.is_error()) {
+            m_connection_failed = true;
+            ++m_connection_generation;
+            dbgln("SecurityTap: Failed to read Sentinel response: {}", message.error());
+            return message.release_error();
+        }
+
+        dispatch_message(ByteString { message.value().bytes() });
+    }
+}
+
+ErrorOr<ByteString> SecurityTap::send_shared_buffer_scan_request(ReadonlyBytes content)
+{
+    // This is the only copy of the content made on the way to Sentinel
+    auto buffer = TRY(Core::AnonymousBuffer::create_with_size(content.size()));
+    memcpy(buffer.data<void>(), content.data(), content.size());
+
+    auto request_id = m_next_scan_request_id.fetch_add(1);
+    auto header = Sentinel::ScanProtocol::make_shared_buffer_scan_header(content.size(), request_id);
+
+    u64 connection_generation = 0;
+    {
+        Sync::MutexLocker locker(m_socket_mutex);
+        connection_generation = m_connection_generation;
+
+        IPC::BufferedIPCWriter writer;
+        if (auto result = writer.write_message(*m_sentinel_socket, Sentinel::ScanProtocol::header_bytes(header)); result.is_error()) {
+            m_connection_failed = true;
+            dbgln("SecurityTap: Failed to write scan header to Sentinel socket: {}", result.error());
+            return result.release_error();
+        }
+
+        if (auto result = m_sentinel_socket->send_fd(buffer.fd()); result.is_error()) {
+            m_connection_failed = true;
+            dbgln("SecurityTap: Failed to pass shared buffer to Sentinel: {}", result.error());
+            return result.release_error();
+        }
+    }
+
+    // Sentinel replies with a regular framed JSON message once the scan has finished
+    return wait_for_response(ByteString::formatted("download_{}", request_id), connection_generation);
+}
+
+ErrorOr<ByteString> SecurityTap::send_stream_message(u64 stream_id, Sentinel::ScanProtocol::ScanFlags flags, ReadonlyBytes chunk)
+{
+    // Stream chunks travel inline after the header: they are small and sent once, so a shared
+    // buffer per chunk would cost more than the copy it saves
+    auto header = Sentinel::ScanProtocol::make_shared_buffer_scan_header(chunk.size(), stream_id, flags);
+    auto message = TRY(ByteBuffer::create_uninitialized(sizeof(header) + chunk.size()));
+    message.overwrite(0, &header, sizeof(header));
+    if (!chunk.is_empty())
+        message.overwrite(sizeof(header), chunk.data(), chunk.size());
+
+    u64 connection_generation = 0;
+    {
+        Sync::MutexLocker locker(m_socket_mutex);
+
+        if (m_connection_failed)
+            TRY(reconnect());
+        connection_generation = m_connection_generation;
+
+        IPC::BufferedIPCWriter writer;
+        if (auto result = writer.write_message(*m_sentinel_socket, message.bytes()); result.is_error()) {
+            m_connection_failed = true;
+            dbgln("SecurityTap: Failed to write stream chunk to Sentinel socket: {}", result.error());
+            return result.release_error();
+        }
+    }
+
+    // Each stream only has one chunk in flight at a time, so the stream ID identifies the response
+    return wait_for_response(ByteString::formatted("stream_{}", stream_id), connection_generation);
+}
+
+static ErrorOr<SecurityTap::ScanResult> stream_scan_result_from_response(ByteString const& response_json)
+{
+    auto json = TRY(JsonValue::from_string(response_json));
+    if (!json.is_object())
+        return Error::from_string_literal("Sentinel response is not a JSON object");
+
+    auto const& obj = json.as_object();
+    auto status = obj.get_string("status"sv);
+    if (!status.has_value() || status.value() != "success"sv)
+        return Error::from_string_literal("Sentinel stream scan failed");
+
+    auto result = obj.get_string("result"sv);
+    if (!result.has_value())
+        return Error::from_string_literal("Missing 'result' field in Sentinel response");
+
+    if (result.value() == "clean"sv)
+        return SecurityTap::ScanResult { .is_threat = false, .alert_json = {}, .rules_version = rules_version_from_response(obj) };
+
+    return SecurityTap::ScanResult {
+        .is_threat = true,
+        .alert_json = ByteString(result.value()),
+        .rules_version = rules_version_from_response(obj)
+    };
+}
+
+ErrorOr<SecurityTap::ScanResult> SecurityTap::scan_stream_chunk(u64 stream_id, ReadonlyBytes chunk)
+{
+    if (chunk.is_empty())
+        return ScanResult { .is_threat = false, .alert_json = {} };
+
+    auto response = TRY(send_stream_message(stream_id, Sentinel::ScanProtocol::ScanFlags::StreamChunk, chunk));
+    auto result = TRY(stream_scan_result_from_response(response));
+
+    if (m_scan_size_config.enable_telemetry) {
+        m_telemetry.total_bytes_scanned += chunk.size();
+        if (chunk.size() > m_telemetry.peak_memory_usage)
+            m_telemetry.peak_memory_usage = chunk.size();
+    }
+
+    return result;
+}
+
+u64 SecurityTap::begin_stream_scan()
+{
+    auto stream_id = m_next_scan_request_id.fetch_add(1);
+    Sync::MutexLocker locker(m_stream_scans_mutex);
+    m_stream_scans.set(stream_id, {});
+    return stream_id;
+}
+
+bool SecurityTap::enqueue_stream_window(u64 stream_id, ByteBuffer window, bool is_end_of_stream, ByteString sha256, ScanCallback& callback)
+{
+    {
+        Sync::MutexLocker locker(m_stream_scans_mutex);
+        m_stream_scans.ensure(stream_id).window_in_flight = true;
+    }
+
+    ErrorOr<void> result = Error::from_string_literal("Worker pool unavailable");
+    if (m_worker_pool)
+        result = m_worker_pool->enqueue_stream_window(stream_id, move(window), is_end_of_stream, move(sha256), callback);
+    if (!result.is_error())
+        return true;
+
+    {
+        Sync::MutexLocker locker(m_stream_scans_mutex);
+        m_stream_scans.ensure(stream_id).window_in_flight = false;
+    }
+
+    // While the pool is running, the queue only turns requests away when it is over capacity, which always counts
+    // as saturated. Failing the window open then would pass unscanned bytes through exactly when Sentinel is busiest.
+    // Everything else (e.g. shutdown) fails open, as with whole-file scans.
+    if (m_worker_pool && m_worker_pool->is_running() && m_worker_pool->is_saturated())
+        return false;
+
+    Core::EventLoop::current().deferred_invoke([callback = move(callback), error = result.release_error()]() mutable {
+        callback(move(error));
+    });
+    return true;
+}
+
+bool SecurityTap::async_scan_stream_window(u64 stream_id, ByteBuffer window, ScanCallback callback)
+{
+    return enqueue_stream_window(stream_id, move(window), false, {}, callback);
+}
+
+bool SecurityTap::async_finish_stream_scan(u64 stream_id, ByteBuffer last_window, ByteString sha256, ScanCallback callback)
+{
+    return enqueue_stream_window(stream_id, move(last_window), true, move(sha256), callback);
+}
+
+void SecurityTap::abandon_stream_scan(u64 stream_id)
+{
+    {
+        Sync::MutexLocker locker(m_stream_scans_mutex);
+        auto state = m_stream_scans.find(stream_id);
+        if (state == m_stream_scans.end())
+            return;
+
+        // The worker scanning the window in flight ends the stream once it is done
+        if (state->value.window_in_flight) {
+            state->value.abandoned = true;
+            return;
+        }
+
+        auto reached_sentinel = state->value.reached_sentinel;
+        m_stream_scans.remove(state);
+        if (!reached_sentinel)
+            return;
+    }
+
+    // Best-effort: if this fails, Sentinel still releases the stream when the connection closes
+    ScanCallback no_callback;
+    if (m_worker_pool)
+        (void)m_worker_pool->enqueue_stream_window(stream_id, {}, true, {}, no_callback);
+}
+
+ErrorOr<SecurityTap::ScanResult> SecurityTap::scan_queued_stream_window(u64 stream_id, ReadonlyBytes window, bool is_end_of_stream, StringView sha256)
+{
+    bool reached_sentinel = false;
+    {
+        Sync::MutexLocker locker(m_stream_scans_mutex);
+        if (auto state = m_stream_scans.find(stream_id); state != m_stream_scans.end()) {
+            reached_sentinel = state->value.reached_sentinel;
+            state->value.reached_sentinel |= !window.is_empty();
+        }
+    }
+
+    // Once the stream ends the whole body is known. If it was scanned before, the last window and the whole-stream
+    // classification can be skipped; a body that fit in one window never reaches Sentinel at all.
+    if (is_end_of_stream) {
+        if (auto cached = cached_scan_result(sha256); cached.has_value()) {
+            dbgln("SecurityTap: Verdict cache hit for stream {} ({})", stream_id, cached->is_threat ? "threat"sv : "clean"sv);
+            {
+                Sync::MutexLocker locker(m_stream_scans_mutex);
+                m_stream_scans.remove(stream_id);
+            }
+            if (reached_sentinel)
+                (void)finish_stream_scan(stream_id);
+            return cached.release_value();
+        }
+    }
+
+    auto result = scan_stream_chunk(stream_id, window);
+
+    bool should_end_stream = is_end_of_stream;
+    {
+        Sync::MutexLocker locker(m_stream_scans_mutex);
+        auto state = m_stream_scans.find(stream_id);
+        if (state != m_stream_scans.end()) {
+            state->value.window_in_flight = false;
+            if (state->value.abandoned)
+                should_end_stream = true;
+            if (should_end_stream)
+                m_stream_scans.remove(state);
+        }
+    }
+
+    if (!should_end_stream)
+        return result;
+
+    // A threat in the last window is the verdict; the stream still has to be ended so Sentinel releases it
+    if (result.is_error() || result.value().is_threat) {
+        (void)finish_stream_scan(stream_id);
+        return result;
+    }
+    return finish_stream_scan(stream_id, sha256);
+}
+
+ErrorOr<SecurityTap::ScanResult> SecurityTap::finish_stream_scan(u64 stream_id, StringView sha256)
+{
+    auto response = TRY(send_stream_message(stream_id, Sentinel::ScanProtocol::ScanFlags::StreamEnd, {}));
+    auto result = TRY(stream_scan_result_from_response(response));
+
+    // The caller hashed the body while it streamed in, so a later whole-buffer inspection of the same bytes is a
+    // cache hit instead of another hash and scan
+    if (m_verdict_cache && !sha256.is_empty() && result.rules_version.has_value())
+        m_verdict_cache->store(sha256, { .is_threat = result.is_threat, .alert_json = result.alert_json }, *result.rules_version);
+
+    if (m_scan_size_config.enable_telemetry) {
+        m_telemetry.scans_medium++;
+        m_telemetry.total_files_scanned++;
+    }
+
+    return result;
+}
+
+ErrorOr<ByteString> SecurityTap::send_json_scan_request(
+    DownloadMetadata const&,
+    ReadonlyBytes content)
+{
+    // Responses are matched to requests by request_id, so it has to be unique even if the same content is being
+    // scanned twice at once
+    auto request_id = ByteString::formatted("download_{}", m_next_scan_request_id.fetch_add(1));
+
+    // Build JSON request for Sentinel
+    JsonObject request;
+    request.set("action"sv, JsonValue("scan_content"sv));
+    request.set("request_id"sv, JsonValue(request_id));
+
+    // Base64 encode content for JSON transport
+    auto content_base64 = TRY(encode_base64(content));
+    request.set("content"sv, JsonValue(content_base64));
+
+    // Serialize and send, framed like every other message Sentinel reads
+    auto request_json = request.serialized();
+
+    u64 connection_generation = 0;
+    {
+        Sync::MutexLocker locker(m_socket_mutex);
+        connection_generation = m_connection_generation;
+
+        IPC::BufferedIPCWriter writer;
+        if (auto result = writer.write_message(*m_sentinel_socket, request_json.bytes_as_string_view()); result.is_error()) {
+            m_connection_failed = true;
+            dbgln("SecurityTap: Failed to write to Sentinel socket: {}", result.error());
+            return result.release_error();
+        }
     }
 
-    return ByteString(bytes_read);
+    return wait_for_response(request_id, connection_generation);
 }
 
 ErrorOr<SecurityTap::ScanResult> SecurityTap::scan_medium_file_streaming(
@@ -378,7 +812,8 @@ ErrorOr<SecurityTap::ScanResult> SecurityTap::scan_medium_file_streaming(
             }
             return ScanResult {
                 .is_threat = true,
-                .alert_json = ByteString(result.value())
+                .alert_json = ByteString(result.value()),
+                .rules_version = rules_version_from_response(obj)
             };
         }
 
@@ -437,7 +872,8 @@ ErrorOr<SecurityTap::ScanResult> SecurityTap::scan_large_file_partial(
                 m_telemetry.total_bytes_scanned += first_portion_size;
             return ScanResult {
                 .is_threat = true,
-                .alert_json = ByteString(result.value())
+                .alert_json = ByteString(result.value()),
+                .rules_version = rules_version_from_response(obj)
             };
         }
     }
@@ -466,7 +902,8 @@ ErrorOr<SecurityTap::ScanResult> SecurityTap::scan_large_file_partial(
                     m_telemetry.total_bytes_scanned += (first_portion_size + last_portion_size);
                 return ScanResult {
                     .is_threat = true,
-                    .alert_json = ByteString(result.value())
+                    .alert_json = ByteString(result.value()),
+                    .rules_version = rules_version_from_response(obj)
                 };
             }
         }
@@ -512,9 +949,9 @@ void SecurityTap::async_inspect_download(
         }
 
         // Enqueue scan request to worker pool
-        auto enqueue_result = m_worker_pool->enqueue_scan(metadata, content_buffer_result.release_value(), move(callback));
+        auto enqueue_result = m_worker_pool->enqueue_scan(metadata, content_buffer_result.release_value(), callback);
         if (enqueue_result.is_error()) {
-            // Queue is full or worker pool error - fail-open with warning
+            // Byte budget exhausted or worker pool error - fail-open with warning
             dbgln("SecurityTap: Failed to enqueue scan ({}), allowing download", enqueue_result.error());
             Core::EventLoop::current().deferred_invoke([callback = move(callback)]() mutable {
                 callback(ScanResult { .is_threat = false, .alert_json = {} });
@@ -552,9 +989,16 @@ Optional<SecurityTap::WorkerPoolTelemetry> SecurityTap::get_worker_pool_telemetr
         .total_scans_completed = telemetry.total_scans_completed,
         .total_scans_failed = telemetry.total_scans_failed,
         .current_queue_depth = telemetry.current_queue_depth,
+        .current_queued_bytes = telemetry.current_queued_bytes,
         .active_workers = telemetry.active_workers,
         .avg_scan_time_ms = avg_scan_time_ms,
+        .backpressure_active = telemetry.backpressure_active,
     };
 }
 
+bool SecurityTap::is_scan_backlog_saturated() const
+{
+    return m_worker_pool && m_worker_pool->is_saturated();
+}
+
 }
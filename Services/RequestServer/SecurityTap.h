@@ -7,19 +7,27 @@
 #pragma once
 
 #include "ScanSizeConfig.h"
+#include <AK/Atomic.h>
 #include <AK/Error.h>
+#include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
 #include <LibCore/Socket.h>
+#include <LibSync/ConditionVariable.h>
+#include <LibSync/Mutex.h>
+#include <Services/Sentinel/ScanProtocol.h>
 
 namespace RequestServer {
 
-// Forward declaration
+// Forward declarations
+class VerdictCache;
 class YARAScanWorkerPool;
 
 class SecurityTap {
 public:
     static ErrorOr<NonnullOwnPtr<SecurityTap>> create();
+    // Without a verdict_cache_directory, verdicts are not cached
+    static ErrorOr<NonnullOwnPtr<SecurityTap>> create(ByteString socket_path, Optional<ByteString> verdict_cache_directory);
     ~SecurityTap();
 
     struct DownloadMetadata {
@@ -33,6 +41,10 @@ public:
     struct ScanResult {
         bool is_threat { false };
         Optional<ByteString> alert_json;
+
+        // Set only when Sentinel actually reached this verdict (never for fail-open results), so
+        // only these are cached
+        Optional<u64> rules_version {};
     };
 
     using ScanCallback = Function<void(ErrorOr<ScanResult>)>;
@@ -50,9 +62,33 @@ public:
         ScanCallback callback
     );
 
+    // Streaming inspection - body chunks are forwarded to Sentinel as they arrive and scanned
+    // incrementally, so a verdict is available before the download completes and peak memory
+    // depends on the chunk size rather than the file size. A threat result from any chunk is final.
+    //
+    // Windows are scanned on the worker pool and the callback runs on the calling thread's event loop.
+    // A stream has at most one window in flight; the caller waits for its verdict before sending more.
+    // If the scan backlog is full, the window is turned away (returning false, without calling the
+    // callback): the caller keeps holding it back and tries again once is_scan_backlog_saturated() clears.
+    u64 begin_stream_scan();
+    [[nodiscard]] bool async_scan_stream_window(u64 stream_id, ByteBuffer window, ScanCallback callback);
+    // Scans the last (possibly empty) window and ends the stream. sha256 is the digest of everything
+    // streamed, if the caller kept one; the final verdict is cached under it.
+    [[nodiscard]] bool async_finish_stream_scan(u64 stream_id, ByteBuffer last_window, ByteString sha256, ScanCallback callback);
+    // Ends a stream whose verdict is no longer wanted; Sentinel releases it once any window in flight is done
+    void abandon_stream_scan(u64 stream_id);
+
+    // Blocking halves of the above, run on worker pool threads
+    ErrorOr<ScanResult> scan_stream_chunk(u64 stream_id, ReadonlyBytes chunk);
+    ErrorOr<ScanResult> finish_stream_scan(u64 stream_id, StringView sha256 = {});
+    ErrorOr<ScanResult> scan_queued_stream_window(u64 stream_id, ReadonlyBytes window, bool is_end_of_stream, StringView sha256);
+
     // Compute SHA256 hash of content
     static ErrorOr<ByteString> compute_sha256(ReadonlyBytes data);
 
+    // Verdicts shared with the other RequestServer processes, keyed by content hash (may be null)
+    VerdictCache* verdict_cache() { return m_verdict_cache.ptr(); }
+
     // Check if connection to Sentinel is still alive
     bool is_connected() const;
 
@@ -72,19 +108,59 @@ public:
         size_t total_scans_completed;
         size_t total_scans_failed;
         size_t current_queue_depth;
+        size_t current_queued_bytes;
         size_t active_workers;
         double avg_scan_time_ms;
+        bool backpressure_active;
     };
     Optional<WorkerPoolTelemetry> get_worker_pool_telemetry() const;
 
+    // True while the async scan backlog is over budget; downloads should pause until it drains
+    bool is_scan_backlog_saturated() const;
+
 private:
-    SecurityTap(NonnullOwnPtr<Core::Socket> socket);
+    SecurityTap(NonnullOwnPtr<Core::LocalSocket> socket, ByteString socket_path);
+
+    // Queues a stream window; false if the backlog is full
+    bool enqueue_stream_window(u64 stream_id, ByteBuffer window, bool is_end_of_stream, ByteString sha256, ScanCallback&);
 
     ErrorOr<ByteString> send_scan_request(
         DownloadMetadata const& metadata,
         ReadonlyBytes content
     );
 
+    // Binary protocol: copies the content once into an anonymous shared buffer and passes its
+    // file descriptor to Sentinel, which scans the mapped pages in place (see ScanProtocol.h).
+    ErrorOr<ByteString> send_shared_buffer_scan_request(ReadonlyBytes content);
+
+    ErrorOr<ByteString> send_stream_message(u64 stream_id, Sentinel::ScanProtocol::ScanFlags, ReadonlyBytes chunk);
+
+    // Sentinel answers requests as they finish, not in the order they were sent, so any number of requests may be
+    // waiting on the socket at once. Whichever waiting thread finds nobody reading reads the next response and hands
+    // it to the thread waiting for its request_id.
+    // connection_generation is m_connection_generation when the request was written.
+    ErrorOr<ByteString> wait_for_response(ByteString const& request_id, u64 connection_generation);
+
+    // Files a message read from Sentinel for the thread waiting for it, or applies it if it was pushed.
+    // Caller holds m_response_mutex.
+    void dispatch_message(ByteString message);
+
+    // Sentinel pushes a message whenever its rules version changes, so cached verdicts stop matching right away.
+    // Pushes are read along with responses; this reads any that arrived while nobody was waiting for one.
+    void read_pushed_messages();
+    // Caller holds m_socket_mutex
+    void write_rules_version_subscription();
+    static constexpr StringView RULES_VERSION_SUBSCRIPTION_REQUEST_ID = "rules_version_subscription"sv;
+
+    // Verdict cache lookup, up to date with any rules version change Sentinel has announced
+    Optional<ScanResult> cached_scan_result(StringView sha256);
+
+    // Legacy JSON protocol: base64-encodes the content inside a "scan_content" request.
+    ErrorOr<ByteString> send_json_scan_request(
+        DownloadMetadata const& metadata,
+        ReadonlyBytes content
+    );
+
     // Size-based scanning methods
     ErrorOr<ScanResult> scan_with_size_limits(
         DownloadMetadata const& metadata,
@@ -106,11 +182,34 @@ private:
         ReadonlyBytes content
     );
 
-    NonnullOwnPtr<Core::Socket> m_sentinel_socket;
-    bool m_connection_failed { false };
+    NonnullOwnPtr<Core::LocalSocket> m_sentinel_socket;
+    ByteString m_socket_path;
+    Atomic<bool> m_connection_failed { false };
+
+    // Serializes writing requests to the Sentinel socket; worker pool threads scan concurrently
+    Sync::Mutex m_socket_mutex;
+
+    // Responses read for requests whose threads haven't picked them up yet
+    Sync::Mutex m_response_mutex;
+    Sync::ConditionVariable m_response_condition { m_response_mutex };
+    HashMap<ByteString, ByteString> m_unclaimed_responses;
+    bool m_response_reader_active { false };
+    // Bumped whenever the connection is lost, so requests waiting on the old connection give up
+    Atomic<u64> m_connection_generation { 0 };
+    Atomic<u64> m_next_scan_request_id { 1 };
     ScanSizeConfig m_scan_size_config { ScanSizeConfig::create_default() };
     ScanTelemetry m_telemetry;
+
+    struct StreamScanState {
+        bool window_in_flight { false };
+        bool abandoned { false };
+        bool reached_sentinel { false };
+    };
+    Sync::Mutex m_stream_scans_mutex;
+    HashMap<u64, StreamScanState> m_stream_scans;
+
     OwnPtr<YARAScanWorkerPool> m_worker_pool;
+    OwnPtr<VerdictCache> m_verdict_cache;
 };
 
 }
@@ -4,6 +4,7 @@
  */
 
 #include "TrafficMonitor.h"
+#include <AK/Math.h>
 #include <AK/Time.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
@@ -325,12 +326,11 @@ static void test_clear_old_patterns()
 static void test_max_patterns_limit()
 {
     dbgln("\n=== Test: Max Patterns Limit (LRU Eviction) ===");
-    dbgln("Testing with 510 domains (MAX_PATTERNS = 500)...");
+    dbgln("Testing with 2000 domains on a monitor capped at 256 patterns...");
 
-    auto monitor = MUST(TrafficMonitor::create());
+    auto monitor = MUST(TrafficMonitor::create(256));
 
-    // Record 510 different domains (exceeds MAX_PATTERNS=500)
-    for (int i = 0; i < 510; i++) {
+    for (int i = 0; i < 2000; i++) {
         auto domain = MUST(String::formatted("domain{}.com", i));
         auto result = monitor->record_request(domain.bytes_as_string_view(), 1000, 1000);
         if (result.is_error()) {
@@ -339,8 +339,42 @@ static void test_max_patterns_limit()
         }
     }
 
-    dbgln("✓ PASS: Successfully handled 510 domains with LRU eviction");
-    dbgln("  (Oldest 10 patterns should have been evicted)");
+    if (monitor->pattern_count() > monitor->max_patterns()) {
+        dbgln("✗ FAIL: Tracking {} patterns, more than the limit of {}", monitor->pattern_count(), monitor->max_patterns());
+        return;
+    }
+
+    dbgln("✓ PASS: Successfully handled 2000 domains with LRU eviction");
+    dbgln("  Tracking {} of at most {} patterns", monitor->pattern_count(), monitor->max_patterns());
+}
+
+static void test_incremental_interval_statistics()
+{
+    dbgln("\n=== Test: Incremental Interval Statistics ===");
+
+    // A window that has wrapped many times must agree with statistics computed from scratch
+    Sentinel::IntervalWindow window;
+    Vector<float> recent;
+    for (int i = 0; i < 1000; i++) {
+        float interval = 30.0f + static_cast<float>((i * 7919) % 13) - 6.0f;
+        window.add(interval);
+        recent.append(interval);
+        if (recent.size() > Sentinel::IntervalWindow::CAPACITY)
+            recent.remove(0);
+    }
+
+    auto detector = MUST(Sentinel::C2Detector::create());
+    auto windowed = MUST(detector->analyze_beaconing(window));
+    auto batch = MUST(detector->analyze_beaconing(recent));
+
+    dbgln("Windowed CV: {:.6f}, batch CV: {:.6f}", windowed.interval_regularity, batch.interval_regularity);
+    if (window.size() == Sentinel::IntervalWindow::CAPACITY
+        && AK::fabs(windowed.interval_regularity - batch.interval_regularity) < 1e-4f
+        && windowed.is_beaconing == batch.is_beaconing) {
+        dbgln("✓ PASS: Running statistics match a full recomputation");
+    } else {
+        dbgln("✗ FAIL: Running statistics drifted from the interval history");
+    }
 }
 
 static void test_analysis_interval_throttling()
@@ -503,6 +537,7 @@ ErrorOr<int> ladybird_main(Main::Arguments)
     // Memory management tests
     test_clear_old_patterns();
     test_max_patterns_limit();
+    test_incremental_interval_statistics();
     test_max_alerts_limit();
 
     // Advanced tests
@@ -5,7 +5,7 @@
  */
 
 #include <AK/Debug.h>
-#include <AK/QuickSort.h>
+#include <AK/HashFunctions.h>
 #include <AK/Time.h>
 #include <Services/RequestServer/TrafficMonitor.h>
 #include <Services/Sentinel/C2Detector.h>
@@ -13,19 +13,41 @@
 
 namespace RequestServer {
 
-TrafficMonitor::TrafficMonitor()
+TrafficMonitor::TrafficMonitor(size_t max_patterns)
 {
+    auto shard_capacity = max<size_t>(1, ceil_div(max_patterns, SHARD_COUNT));
+    for (size_t i = 0; i < SHARD_COUNT; ++i)
+        m_pattern_shards.unchecked_append(PatternShard(shard_capacity));
+    m_max_patterns = shard_capacity * SHARD_COUNT;
 }
 
 TrafficMonitor::~TrafficMonitor() = default;
 
-ErrorOr<NonnullOwnPtr<TrafficMonitor>> TrafficMonitor::create()
+ErrorOr<NonnullOwnPtr<TrafficMonitor>> TrafficMonitor::create(size_t max_patterns)
 {
-    auto monitor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) TrafficMonitor()));
+    auto monitor = TRY(adopt_nonnull_own_or_enomem(new (nothrow) TrafficMonitor(max_patterns)));
     TRY(monitor->initialize_detectors());
     return monitor;
 }
 
+// Calculate DGA score from analysis results
+// High entropy + unusual n-grams + high consonant ratio = higher score
+static float calculate_dga_score(Sentinel::DNSAnalyzer const& analyzer, StringView domain)
+{
+    // The batch overload skips the explanation, which is never shown here
+    Sentinel::DNSAnalyzer::DGAAnalysis dga_analysis;
+    analyzer.analyze_dga({ &domain, 1 }, { &dga_analysis, 1 });
+
+    if (dga_analysis.is_dga)
+        return dga_analysis.confidence;
+
+    // Calculate score from components even if not flagged as DGA
+    float entropy_factor = min(dga_analysis.entropy / 5.0f, 1.0f); // Normalize entropy
+    float ngram_factor = dga_analysis.ngram_score;
+    float consonant_factor = dga_analysis.consonant_ratio > 0.65f ? 1.0f : 0.0f;
+    return entropy_factor * 0.5f + ngram_factor * 0.3f + consonant_factor * 0.2f;
+}
+
 ErrorOr<void> TrafficMonitor::initialize_detectors()
 {
     // Attempt to create detectors - graceful degradation if they fail
@@ -52,36 +74,41 @@ ErrorOr<void> TrafficMonitor::initialize_detectors()
     return {};
 }
 
+TrafficMonitor::PatternShard& TrafficMonitor::shard_for(String const& domain)
+{
+    // Rehash so shard selection does not correlate with bucket selection inside the shard
+    return m_pattern_shards[u32_hash(domain.hash()) % SHARD_COUNT];
+}
+
 ErrorOr<void> TrafficMonitor::record_request(StringView domain, u64 bytes_sent, u64 bytes_received)
 {
     // Validate input
     if (domain.is_empty())
         return Error::from_string_literal("Domain cannot be empty");
 
-    // Get or create pattern for this domain
+    // Get or create pattern for this domain. At capacity, the shard reuses the pattern of its least
+    // recently requested domain.
     String domain_string = TRY(String::from_utf8(domain));
-
-    // Enforce MAX_PATTERNS limit using LRU eviction
-    if (!m_patterns.contains(domain_string) && m_patterns.size() >= MAX_PATTERNS) {
-        evict_oldest_pattern();
-    }
-
-    // Get or create pattern
-    auto& pattern = m_patterns.ensure(domain_string, [&]() {
-        ConnectionPattern p;
-        p.domain = domain_string;
-        return p;
-    });
+    auto& pattern = *TRY(shard_for(domain_string).ensure(domain_string));
+    if (pattern.request_count == 0)
+        pattern.domain = domain_string;
 
     // Update pattern metrics
     pattern.request_count++;
     pattern.bytes_sent += bytes_sent;
     pattern.bytes_received += bytes_received;
 
-    // Record timestamp (Unix epoch in seconds as double)
+    // Record the request time (Unix epoch in seconds as double)
     auto now = UnixDateTime::now();
     double timestamp = static_cast<double>(now.seconds_since_epoch());
-    TRY(pattern.request_timestamps.try_append(timestamp));
+    pattern.beacon.record(timestamp);
+
+    // A flow whose intervals have just turned regular is analyzed on the next call, rather than
+    // once the rest of ANALYSIS_INTERVAL has passed
+    bool was_regular = pattern.has_regular_intervals;
+    pattern.has_regular_intervals = Sentinel::C2Detector::has_regular_intervals(pattern.beacon.intervals());
+    if (pattern.has_regular_intervals && !was_regular)
+        pattern.last_analyzed = 0.0;
 
     return {};
 }
@@ -92,13 +119,13 @@ ErrorOr<Optional<TrafficAlert>> TrafficMonitor::analyze_pattern(StringView domai
     if (domain.is_empty())
         return Optional<TrafficAlert> {};
 
-    // Find pattern
+    // Find pattern, leaving its place in the request order alone
     String domain_string = TRY(String::from_utf8(domain));
-    auto it = m_patterns.find(domain_string);
-    if (it == m_patterns.end())
+    auto* pattern_pointer = shard_for(domain_string).peek(domain_string);
+    if (!pattern_pointer)
         return Optional<TrafficAlert> {}; // No pattern for this domain
 
-    auto& pattern = it->value;
+    auto& pattern = *pattern_pointer;
 
     // Check if analysis is needed
     auto now = UnixDateTime::now();
@@ -112,88 +139,14 @@ ErrorOr<Optional<TrafficAlert>> TrafficMonitor::analyze_pattern(StringView domai
     if (pattern.request_count < MIN_REQUESTS_FOR_ANALYSIS)
         return Optional<TrafficAlert> {};
 
-    // Initialize scores
-    float dga_score = 0.0f;
-    float beaconing_score = 0.0f;
-    float exfiltration_score = 0.0f;
-
-    // Run DNSAnalyzer if available
-    if (m_dns_analyzer) {
-        auto dga_result = m_dns_analyzer->analyze_dga(domain);
-        if (!dga_result.is_error()) {
-            auto dga_analysis = dga_result.release_value();
-            // Calculate DGA score from analysis results
-            // High entropy + unusual n-grams + high consonant ratio = higher score
-            if (dga_analysis.is_dga) {
-                dga_score = dga_analysis.confidence;
-            } else {
-                // Calculate score from components even if not flagged as DGA
-                float entropy_factor = min(dga_analysis.entropy / 5.0f, 1.0f);      // Normalize entropy
-                float ngram_factor = dga_analysis.ngram_score;
-                float consonant_factor = dga_analysis.consonant_ratio > 0.65f ? 1.0f : 0.0f;
-                dga_score = (entropy_factor * 0.5f + ngram_factor * 0.3f + consonant_factor * 0.2f);
-            }
-        }
-    }
-
-    // Run C2Detector if available (beaconing analysis)
-    if (m_c2_detector && pattern.request_timestamps.size() >= 2) {
-        // Calculate request intervals for beaconing detection (convert double to float)
-        Vector<float> intervals;
-        for (size_t i = 1; i < pattern.request_timestamps.size(); i++) {
-            float interval = static_cast<float>(pattern.request_timestamps[i] - pattern.request_timestamps[i - 1]);
-            if (auto result = intervals.try_append(interval); result.is_error()) {
-                dbgln("TrafficMonitor: Failed to append interval: {}", result.error());
-            }
-        }
-
-        if (!intervals.is_empty()) {
-            auto beaconing_result = m_c2_detector->analyze_beaconing(intervals);
-            if (!beaconing_result.is_error()) {
-                auto beaconing_analysis = beaconing_result.release_value();
-                // Calculate beaconing score from analysis
-                if (beaconing_analysis.is_beaconing) {
-                    beaconing_score = beaconing_analysis.confidence;
-                } else {
-                    // Lower score for less regular patterns
-                    // CV < 0.2 = very regular, CV > 0.4 = irregular
-                    float cv = beaconing_analysis.interval_regularity;
-                    if (cv < 0.4f) {
-                        beaconing_score = (0.4f - cv) / 0.4f; // Scale 0-1
-                    }
-                }
-            }
-        }
-
-        // Exfiltration analysis
-        auto exfil_result = m_c2_detector->analyze_exfiltration(
-            pattern.bytes_sent,
-            pattern.bytes_received,
-            domain);
-
-        if (!exfil_result.is_error()) {
-            auto exfil_analysis = exfil_result.release_value();
-            // Calculate exfiltration score
-            if (exfil_analysis.is_exfiltration) {
-                exfiltration_score = exfil_analysis.confidence;
-            } else {
-                // Partial score based on upload ratio
-                if (exfil_analysis.upload_ratio > 0.7f) {
-                    exfiltration_score = (exfil_analysis.upload_ratio - 0.7f) / 0.3f; // Scale 0-1
-                }
-            }
-        }
-    }
+    auto scores = calculate_scores(domain, pattern);
 
     // Update last_analyzed timestamp
     pattern.last_analyzed = current_time;
 
-    // Calculate composite score
-    auto composite_score = TRY(calculate_composite_score(domain, pattern));
-
     // Generate alert if score exceeds threshold
-    if (composite_score >= ALERT_THRESHOLD) {
-        auto alert = TRY(generate_alert(domain, pattern, dga_score, beaconing_score, exfiltration_score));
+    if (calculate_composite_score(scores) >= ALERT_THRESHOLD) {
+        auto alert = TRY(generate_alert(domain, pattern, scores.dga, scores.beaconing, scores.exfiltration));
 
         // Add to alerts list (enforce MAX_ALERTS limit)
         if (m_alerts.size() >= MAX_ALERTS) {
@@ -229,109 +182,82 @@ void TrafficMonitor::clear_old_patterns(double max_age_seconds)
     auto now = UnixDateTime::now();
     double current_time = static_cast<double>(now.seconds_since_epoch());
 
-    // Find patterns older than max_age_seconds
-    Vector<String> domains_to_remove;
-    for (auto const& [domain, pattern] : m_patterns) {
-        if (pattern.request_timestamps.is_empty())
-            continue;
-
-        // Get last request timestamp
-        double last_request_time = pattern.request_timestamps.last();
-        double age = current_time - last_request_time;
-
-        if (age > max_age_seconds) {
-            if (auto result = domains_to_remove.try_append(domain); result.is_error()) {
-                dbgln("TrafficMonitor: Failed to append domain for removal: {}", result.error());
-            }
-        }
+    // Each shard is ordered by last request, so expired patterns are exactly the ones at its tail
+    size_t removed = 0;
+    for (auto& shard : m_pattern_shards) {
+        removed += shard.remove_least_recent_while([&](String const&, ConnectionPattern const& pattern) {
+            return current_time - pattern.beacon.last_request() > max_age_seconds;
+        });
     }
 
-    // Remove old patterns
-    for (auto const& domain : domains_to_remove) {
-        m_patterns.remove(domain);
+    if (removed > 0) {
+        dbgln("TrafficMonitor: Cleared {} old patterns (age > {}s)", removed, max_age_seconds);
     }
+}
 
-    if (!domains_to_remove.is_empty()) {
-        dbgln("TrafficMonitor: Cleared {} old patterns (age > {}s)", domains_to_remove.size(), max_age_seconds);
-    }
+size_t TrafficMonitor::pattern_count() const
+{
+    size_t count = 0;
+    for (auto const& shard : m_pattern_shards)
+        count += shard.size();
+    return count;
 }
 
-ErrorOr<float> TrafficMonitor::calculate_composite_score(StringView domain, ConnectionPattern const& pattern)
+TrafficMonitor::ThreatScores TrafficMonitor::calculate_scores(StringView domain, ConnectionPattern const& pattern)
 {
-    float composite = 0.0f;
-    float dga_score = 0.0f;
-    float beaconing_score = 0.0f;
-    float exfiltration_score = 0.0f;
-    float dns_tunneling_score = 0.0f;
+    ThreatScores scores;
 
     // DGA detection
-    if (m_dns_analyzer) {
-        auto dga_result = m_dns_analyzer->analyze_dga(domain);
-        if (!dga_result.is_error()) {
-            auto dga_analysis = dga_result.value();
-            if (dga_analysis.is_dga) {
-                dga_score = dga_analysis.confidence;
+    if (m_dns_analyzer)
+        scores.dga = calculate_dga_score(*m_dns_analyzer, domain);
+
+    // Beaconing and exfiltration detection (requires at least 2 requests)
+    if (m_c2_detector && pattern.request_count >= 2) {
+        // The interval statistics are kept up to date by record_request(); only the periodicity
+        // check looks back over the most recent requests
+        auto beaconing_result = m_c2_detector->analyze_beaconing(pattern.beacon);
+        if (!beaconing_result.is_error()) {
+            auto beaconing_analysis = beaconing_result.release_value();
+            if (beaconing_analysis.is_beaconing) {
+                scores.beaconing = beaconing_analysis.confidence;
             } else {
-                // Calculate partial score from components
-                float entropy_factor = min(dga_analysis.entropy / 5.0f, 1.0f);
-                float ngram_factor = dga_analysis.ngram_score;
-                float consonant_factor = dga_analysis.consonant_ratio > 0.65f ? 1.0f : 0.0f;
-                dga_score = (entropy_factor * 0.5f + ngram_factor * 0.3f + consonant_factor * 0.2f);
-            }
-        }
-    }
-
-    // Beaconing detection (requires at least 2 requests)
-    if (m_c2_detector && pattern.request_timestamps.size() >= 2) {
-        // Calculate intervals
-        Vector<float> intervals;
-        for (size_t i = 1; i < pattern.request_timestamps.size(); i++) {
-            float interval = static_cast<float>(pattern.request_timestamps[i] - pattern.request_timestamps[i - 1]);
-            if (auto result = intervals.try_append(interval); result.is_error()) {
-                dbgln("TrafficMonitor: Failed to append interval: {}", result.error());
-            }
-        }
-
-        if (!intervals.is_empty()) {
-            auto beaconing_result = m_c2_detector->analyze_beaconing(intervals);
-            if (!beaconing_result.is_error()) {
-                auto beaconing_analysis = beaconing_result.value();
-                if (beaconing_analysis.is_beaconing) {
-                    beaconing_score = beaconing_analysis.confidence;
-                } else {
-                    float cv = beaconing_analysis.interval_regularity;
-                    if (cv < 0.4f) {
-                        beaconing_score = (0.4f - cv) / 0.4f;
-                    }
+                // Lower score for less regular patterns
+                // CV < 0.2 = very regular, CV > 0.4 = irregular
+                float cv = beaconing_analysis.interval_regularity;
+                if (cv < 0.4f) {
+                    scores.beaconing = (0.4f - cv) / 0.4f; // Scale 0-1
                 }
             }
         }
 
-        // Exfiltration detection
         auto exfil_result = m_c2_detector->analyze_exfiltration(
             pattern.bytes_sent,
             pattern.bytes_received,
             domain);
 
         if (!exfil_result.is_error()) {
-            auto exfil_analysis = exfil_result.value();
+            auto exfil_analysis = exfil_result.release_value();
             if (exfil_analysis.is_exfiltration) {
-                exfiltration_score = exfil_analysis.confidence;
+                scores.exfiltration = exfil_analysis.confidence;
             } else {
+                // Partial score based on upload ratio
                 if (exfil_analysis.upload_ratio > 0.7f) {
-                    exfiltration_score = (exfil_analysis.upload_ratio - 0.7f) / 0.3f;
+                    scores.exfiltration = (exfil_analysis.upload_ratio - 0.7f) / 0.3f; // Scale 0-1
                 }
             }
         }
     }
 
-    // Calculate weighted composite score
-    composite = (DGA_WEIGHT * dga_score) +
-        (BEACONING_WEIGHT * beaconing_score) +
-        (EXFILTRATION_WEIGHT * exfiltration_score) +
-        (DNS_TUNNELING_WEIGHT * dns_tunneling_score);
+    return scores;
+}
 
-    return composite;
+float TrafficMonitor::calculate_composite_score(ThreatScores const& scores)
+{
+    // Calculate weighted composite score
+    return (DGA_WEIGHT * scores.dga) +
+        (BEACONING_WEIGHT * scores.beaconing) +
+        (EXFILTRATION_WEIGHT * scores.exfiltration) +
+        (DNS_TUNNELING_WEIGHT * scores.dns_tunneling);
 }
 
 ErrorOr<TrafficAlert> TrafficMonitor::generate_alert(StringView domain, ConnectionPattern const& pattern,
@@ -402,26 +328,4 @@ TrafficAlert::Type TrafficMonitor::determine_alert_type(float dga_score, float b
     return TrafficAlert::Type::Combined;
 }
 
-void TrafficMonitor::evict_oldest_pattern()
-{
-    if (m_patterns.is_empty())
-        return;
-
-    // Find pattern with oldest last_analyzed timestamp
-    String oldest_domain;
-    double oldest_time = __builtin_huge_val(); // Positive infinity
-
-    for (auto const& [domain, pattern] : m_patterns) {
-        if (pattern.last_analyzed < oldest_time) {
-            oldest_time = pattern.last_analyzed;
-            oldest_domain = domain;
-        }
-    }
-
-    if (!oldest_domain.is_empty()) {
-        m_patterns.remove(oldest_domain);
-        dbgln("TrafficMonitor: Evicted oldest pattern: {}", oldest_domain);
-    }
-}
-
 }
@@ -7,29 +7,30 @@
 #pragma once
 
 #include <AK/Error.h>
-#include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
 #include <AK/OwnPtr.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
+#include <Services/Sentinel/C2Detector.h>
+#include <Services/Sentinel/ShardedLRUCache.h>
 
 // Forward declarations for parallel implementations
 namespace Sentinel {
 class DNSAnalyzer;
-class C2Detector;
 }
 
 namespace RequestServer {
 
 // Connection pattern - aggregates traffic per domain
 struct ConnectionPattern {
-    String domain;                      // Domain name
-    u32 request_count { 0 };           // Total requests
-    u64 bytes_sent { 0 };              // Total bytes uploaded
-    u64 bytes_received { 0 };          // Total bytes downloaded
-    Vector<double> request_timestamps; // Request times (Unix epoch seconds)
-    double last_analyzed { 0.0 };      // Last analysis timestamp (Unix epoch seconds)
+    String domain;                                // Domain name
+    u32 request_count { 0 };                      // Total requests
+    u64 bytes_sent { 0 };                         // Total bytes uploaded
+    u64 bytes_received { 0 };                     // Total bytes downloaded
+    Sentinel::BeaconTracker beacon;               // Request timing (Unix epoch seconds)
+    bool has_regular_intervals { false };         // Whether the recent intervals look like beaconing
+    double last_analyzed { 0.0 };                 // Last analysis timestamp (Unix epoch seconds)
 };
 
 // Traffic alert - generated when suspicious patterns detected
@@ -52,9 +53,15 @@ struct TrafficAlert {
 // TrafficMonitor - central orchestrator for network behavioral analysis
 // Aggregates traffic patterns per domain and coordinates DNSAnalyzer + C2Detector
 // for threat detection
+//
+// Patterns are kept in shards of slab-backed LRU lists ordered by last request, so recording a
+// request, evicting the least recently seen domain at capacity and expiring idle domains are all
+// O(1) per pattern touched.
 class TrafficMonitor {
 public:
-    static ErrorOr<NonnullOwnPtr<TrafficMonitor>> create();
+    static constexpr size_t DEFAULT_MAX_PATTERNS = 16384;
+
+    static ErrorOr<NonnullOwnPtr<TrafficMonitor>> create(size_t max_patterns = DEFAULT_MAX_PATTERNS);
     ~TrafficMonitor();
 
     // Record a network request event
@@ -69,11 +76,27 @@ public:
     // Clear old patterns (default: 1 hour)
     void clear_old_patterns(double max_age_seconds = 3600.0);
 
+    size_t pattern_count() const;
+    size_t max_patterns() const { return m_max_patterns; }
+
 private:
-    TrafficMonitor();
+    static constexpr size_t SHARD_COUNT = 16;
+    using PatternShard = Sentinel::SlabLRUCache<String, ConnectionPattern>;
+
+    struct ThreatScores {
+        float dga { 0.0f };
+        float beaconing { 0.0f };
+        float exfiltration { 0.0f };
+        float dns_tunneling { 0.0f };
+    };
+
+    explicit TrafficMonitor(size_t max_patterns);
 
     ErrorOr<void> initialize_detectors();
-    ErrorOr<float> calculate_composite_score(StringView domain, ConnectionPattern const& pattern);
+    PatternShard& shard_for(String const& domain);
+
+    ThreatScores calculate_scores(StringView domain, ConnectionPattern const& pattern);
+    static float calculate_composite_score(ThreatScores const&);
 
     // Generate alert from detection results
     ErrorOr<TrafficAlert> generate_alert(StringView domain, ConnectionPattern const& pattern,
@@ -82,16 +105,13 @@ private:
     // Determine alert type from scores
     TrafficAlert::Type determine_alert_type(float dga_score, float beaconing_score, float exfiltration_score) const;
 
-    // LRU eviction - remove oldest pattern when at capacity
-    void evict_oldest_pattern();
-
-    HashMap<String, ConnectionPattern> m_patterns;           // Per-domain patterns
+    Vector<PatternShard, SHARD_COUNT> m_pattern_shards;      // Per-domain patterns, sharded by domain hash
+    size_t m_max_patterns { 0 };
     Vector<TrafficAlert> m_alerts;                           // Recent alerts (FIFO)
     OwnPtr<Sentinel::DNSAnalyzer> m_dns_analyzer;
     OwnPtr<Sentinel::C2Detector> m_c2_detector;
 
     // Resource limits
-    static constexpr size_t MAX_PATTERNS = 500;              // Maximum domains to track
     static constexpr size_t MAX_ALERTS = 100;                // Maximum alerts to store
     static constexpr double ANALYSIS_INTERVAL = 300.0;       // 5 minutes (seconds)
     static constexpr size_t MIN_REQUESTS_FOR_ANALYSIS = 5;   // Minimum requests before analysis
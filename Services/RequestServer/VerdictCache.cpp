@@ -0,0 +1,309 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "VerdictCache.h"
+#include <AK/Hex.h>
+#include <AK/ScopeGuard.h>
+#include <LibCore/Directory.h>
+#include <LibCore/System.h>
+#include <Services/Sentinel/PolicyGraph.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+
+namespace RequestServer {
+
+// Layout of the shared mapping. The mapping starts out zero-filled, which is a valid empty table.
+struct VerdictCache::SharedSlot {
+    // Odd while a writer owns the slot
+    Atomic<u64> sequence;
+    Atomic<u64> digest[4];
+    Atomic<u64> rule_set_version;
+    Atomic<i64> expires_at_ms;
+    Atomic<u64> verdict;
+};
+
+struct VerdictCache::SharedTable {
+    Atomic<u64> rule_set_version;
+    u8 padding[56];
+    SharedSlot slots[SLOT_COUNT];
+};
+
+ErrorOr<NonnullOwnPtr<VerdictCache>> VerdictCache::create(ByteString const& directory, OwnPtr<Sentinel::PolicyGraph> cold_tier)
+{
+    static_assert(sizeof(SharedSlot) == 64, "Slots should fill exactly one cache line");
+    static_assert(is_power_of_two(SLOT_COUNT));
+
+    TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes));
+
+    auto path = ByteString::formatted("{}/{}", directory, TABLE_FILE_NAME);
+    auto fd = TRY(Core::System::open(path, O_RDWR | O_CREAT | O_CLOEXEC, 0600));
+    ScopeGuard close_fd = [&] { (void)Core::System::close(fd); };
+
+    // Growing the file zero-fills it; any other RequestServer doing the same concurrently is harmless
+    auto stat = TRY(Core::System::fstat(fd));
+    if (static_cast<size_t>(stat.st_size) != sizeof(SharedTable))
+        TRY(Core::System::ftruncate(fd, sizeof(SharedTable)));
+
+    auto* mapping = TRY(Core::System::mmap(nullptr, sizeof(SharedTable), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0));
+    return adopt_own(*new VerdictCache(static_cast<SharedTable*>(mapping), move(cold_tier)));
+}
+
+VerdictCache::VerdictCache(SharedTable* table, OwnPtr<Sentinel::PolicyGraph> cold_tier)
+    : m_table(table)
+    , m_cold_tier(move(cold_tier))
+{
+}
+
+VerdictCache::~VerdictCache()
+{
+    (void)Core::System::munmap(m_table, sizeof(SharedTable));
+}
+
+u64 VerdictCache::rule_set_version() const
+{
+    return m_table->rule_set_version.load(AK::MemoryOrder::memory_order_acquire);
+}
+
+void VerdictCache::set_rule_set_version(u64 version)
+{
+    // Stale entries are not cleared: they stop matching and get overwritten as new verdicts come in
+    if (m_table->rule_set_version.exchange(version, AK::MemoryOrder::memory_order_acq_rel) != version)
+        dbgln("VerdictCache: YARA rule set is now version {:016x}", version);
+}
+
+VerdictCache::Statistics VerdictCache::statistics() const
+{
+    return {
+        .hot_hits = m_hot_hits.load(AK::MemoryOrder::memory_order_relaxed),
+        .cold_hits = m_cold_hits.load(AK::MemoryOrder::memory_order_relaxed),
+        .misses = m_misses.load(AK::MemoryOrder::memory_order_relaxed),
+        .stores = m_stores.load(AK::MemoryOrder::memory_order_relaxed),
+    };
+}
+
+Optional<VerdictCache::Digest> VerdictCache::digest_from_hex(StringView sha256)
+{
+    if (sha256.length() != 64)
+        return {};
+
+    auto bytes = decode_hex(sha256);
+    if (bytes.is_error())
+        return {};
+
+    Digest digest;
+    __builtin_memcpy(digest.data(), bytes.value().data(), sizeof(digest));
+    return digest;
+}
+
+static ByteString synthesized_alert_json(StringView sha256)
+{
+    return ByteString::formatted("{{\"threat_detected\":true,\"cached_verdict\":true,\"sha256\":\"{}\"}}", sha256);
+}
+
+Optional<VerdictCache::Verdict> VerdictCache::lookup(StringView sha256)
+{
+    auto digest = digest_from_hex(sha256);
+    auto current_version = rule_set_version();
+    if (!digest.has_value() || current_version == 0) {
+        m_misses.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        return {};
+    }
+
+    if (auto verdict = lookup_hot_tier(*digest, current_version); verdict.has_value()) {
+        m_hot_hits.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        if (*verdict == SlotVerdict::Clean)
+            return Verdict { .is_threat = false, .alert_json = {} };
+
+        // The hot tier only knows that this is a threat; the alert details live in the cold tier
+        UnixDateTime expires_at;
+        auto cold_verdict = lookup_cold_tier(sha256, current_version, expires_at);
+        if (cold_verdict.has_value() && cold_verdict->is_threat)
+            return cold_verdict.release_value();
+        return Verdict { .is_threat = true, .alert_json = synthesized_alert_json(sha256) };
+    }
+
+    UnixDateTime expires_at;
+    if (auto verdict = lookup_cold_tier(sha256, current_version, expires_at); verdict.has_value()) {
+        m_cold_hits.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        store_hot_tier(*digest, verdict->is_threat ? SlotVerdict::Threat : SlotVerdict::Clean, current_version, expires_at);
+        return verdict;
+    }
+
+    m_misses.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    return {};
+}
+
+void VerdictCache::store(StringView sha256, Verdict const& verdict, u64 rule_set_version)
+{
+    auto digest = digest_from_hex(sha256);
+    if (!digest.has_value() || rule_set_version == 0)
+        return;
+
+    set_rule_set_version(rule_set_version);
+
+    auto expires_at = UnixDateTime::now() + (verdict.is_threat ? m_threat_time_to_live : m_clean_time_to_live);
+    store_hot_tier(*digest, verdict.is_threat ? SlotVerdict::Threat : SlotVerdict::Clean, rule_set_version, expires_at);
+    store_cold_tier(sha256, verdict, rule_set_version, expires_at);
+    m_stores.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+}
+
+Optional<VerdictCache::SlotSnapshot> VerdictCache::read_slot(SharedSlot const& slot)
+{
+    auto sequence_before = slot.sequence.load(AK::MemoryOrder::memory_order_acquire);
+    if (sequence_before & 1)
+        return {};
+
+    SlotSnapshot snapshot;
+    for (size_t i = 0; i < snapshot.digest.size(); ++i)
+        snapshot.digest[i] = slot.digest[i].load(AK::MemoryOrder::memory_order_relaxed);
+    snapshot.rule_set_version = slot.rule_set_version.load(AK::MemoryOrder::memory_order_relaxed);
+    snapshot.expires_at_ms = slot.expires_at_ms.load(AK::MemoryOrder::memory_order_relaxed);
+    snapshot.verdict = static_cast<SlotVerdict>(slot.verdict.load(AK::MemoryOrder::memory_order_relaxed));
+
+    // A writer that started after our first load has bumped the sequence; discard the torn copy
+    AK::atomic_thread_fence(AK::MemoryOrder::memory_order_acquire);
+    if (slot.sequence.load(AK::MemoryOrder::memory_order_relaxed) != sequence_before)
+        return {};
+    return snapshot;
+}
+
+Optional<VerdictCache::SlotVerdict> VerdictCache::lookup_hot_tier(Digest const& digest, u64 rule_set_version) const
+{
+    auto now_ms = UnixDateTime::now().milliseconds_since_epoch();
+    auto home = digest[0] & (SLOT_COUNT - 1);
+
+    for (size_t distance = 0; distance < MAX_PROBE_DISTANCE; ++distance) {
+        auto snapshot = read_slot(m_table->slots[(home + distance) & (SLOT_COUNT - 1)]);
+        if (!snapshot.has_value())
+            continue;
+
+        // Slots are never emptied once written, so an empty slot ends the probe sequence
+        if (snapshot->verdict == SlotVerdict::Empty)
+            return {};
+        if (snapshot->digest != digest)
+            continue;
+        if (snapshot->rule_set_version != rule_set_version || snapshot->expires_at_ms <= now_ms)
+            return {};
+        return snapshot->verdict;
+    }
+    return {};
+}
+
+void VerdictCache::store_hot_tier(Digest const& digest, SlotVerdict verdict, u64 rule_set_version, UnixDateTime expires_at)
+{
+    auto now_ms = UnixDateTime::now().milliseconds_since_epoch();
+    auto home = digest[0] & (SLOT_COUNT - 1);
+
+    // Prefer the slot already holding this digest, then an empty one, then a stale one; if the whole
+    // probe window is live, evict the home slot (the cold tier still has the evicted verdict)
+    Optional<size_t> target;
+    for (size_t distance = 0; distance < MAX_PROBE_DISTANCE; ++distance) {
+        auto index = (home + distance) & (SLOT_COUNT - 1);
+        auto snapshot = read_slot(m_table->slots[index]);
+        if (!snapshot.has_value())
+            continue;
+        if (snapshot->verdict == SlotVerdict::Empty || snapshot->digest == digest) {
+            target = index;
+            break;
+        }
+        bool is_stale = snapshot->rule_set_version != rule_set_version || snapshot->expires_at_ms <= now_ms;
+        if (is_stale && !target.has_value())
+            target = index;
+    }
+
+    auto& slot = m_table->slots[target.value_or(home)];
+
+    // Caching is best-effort: if another writer (possibly in another process) owns the slot, skip it
+    auto sequence = slot.sequence.load(AK::MemoryOrder::memory_order_relaxed);
+    if ((sequence & 1) || !slot.sequence.compare_exchange_strong(sequence, sequence + 1, AK::MemoryOrder::memory_order_acquire))
+        return;
+    AK::atomic_thread_fence(AK::MemoryOrder::memory_order_release);
+
+    for (size_t i = 0; i < digest.size(); ++i)
+        slot.digest[i].store(digest[i], AK::MemoryOrder::memory_order_relaxed);
+    slot.rule_set_version.store(rule_set_version, AK::MemoryOrder::memory_order_relaxed);
+    slot.expires_at_ms.store(expires_at.milliseconds_since_epoch(), AK::MemoryOrder::memory_order_relaxed);
+    slot.verdict.store(to_underlying(verdict), AK::MemoryOrder::memory_order_relaxed);
+
+    slot.sequence.store(sequence + 2, AK::MemoryOrder::memory_order_release);
+}
+
+Optional<VerdictCache::Verdict> VerdictCache::lookup_cold_tier(StringView sha256, u64 rule_set_version, UnixDateTime& expires_at)
+{
+    if (!m_cold_tier)
+        return {};
+
+    auto file_hash = String::from_utf8(sha256);
+    if (file_hash.is_error())
+        return {};
+
+    Sync::MutexLocker locker(m_cold_tier_mutex);
+    auto result = m_cold_tier->lookup_sandbox_verdict(file_hash.value());
+    if (result.is_error()) {
+        dbgln("VerdictCache: Cold tier lookup failed: {}", result.error());
+        return {};
+    }
+
+    // Verdicts from the sandbox orchestrator carry no rule-set version and never match here
+    auto const& verdict = result.value();
+    if (!verdict.has_value() || verdict->rules_version != rule_set_version)
+        return {};
+
+    expires_at = verdict->expires_at;
+    if (verdict->threat_level == 0)
+        return Verdict { .is_threat = false, .alert_json = {} };
+
+    auto alert_json = verdict->verdict_explanation.is_empty()
+        ? synthesized_alert_json(sha256)
+        : verdict->verdict_explanation.to_byte_string();
+    return Verdict { .is_threat = true, .alert_json = move(alert_json) };
+}
+
+void VerdictCache::store_cold_tier(StringView sha256, Verdict const& verdict, u64 rule_set_version, UnixDateTime expires_at)
+{
+    if (!m_cold_tier)
+        return;
+
+    auto file_hash = String::from_utf8(sha256);
+    if (file_hash.is_error())
+        return;
+
+    Sync::MutexLocker locker(m_cold_tier_mutex);
+
+    // Don't replace a (richer) sandbox orchestrator verdict for the same file
+    auto existing = m_cold_tier->lookup_sandbox_verdict(file_hash.value());
+    if (!existing.is_error() && existing.value().has_value() && existing.value()->rules_version == 0)
+        return;
+
+    // PolicyGraph caps explanations at 1024 bytes; longer alerts are re-synthesized on lookup
+    String explanation;
+    if (verdict.is_threat && verdict.alert_json.has_value() && verdict.alert_json->length() <= 1024) {
+        if (auto alert = String::from_byte_string(*verdict.alert_json); !alert.is_error())
+            explanation = alert.release_value();
+    }
+
+    i32 score = verdict.is_threat ? 1000 : 0;
+    Sentinel::PolicyGraph::SandboxVerdict sandbox_verdict {
+        .file_hash = file_hash.release_value(),
+        .threat_level = verdict.is_threat ? 2 : 0,
+        .confidence = 1000,
+        .composite_score = score,
+        .verdict_explanation = move(explanation),
+        .yara_score = score,
+        .ml_score = 0,
+        .behavioral_score = 0,
+        .triggered_rules = {},
+        .detected_behaviors = {},
+        .analyzed_at = UnixDateTime::now(),
+        .expires_at = expires_at,
+        .rules_version = rule_set_version,
+    };
+
+    if (auto result = m_cold_tier->store_sandbox_verdict(sandbox_verdict); result.is_error())
+        dbgln("VerdictCache: Cold tier store failed: {}", result.error());
+}
+
+}
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/OwnPtr.h>
+#include <AK/Time.h>
+#include <LibSync/Mutex.h>
+
+namespace Sentinel {
+class PolicyGraph;
+}
+
+namespace RequestServer {
+
+// SHA256-keyed cache of Sentinel verdicts, shared by all RequestServer processes
+//
+// Hot tier: a fixed-size open-addressing table in a MAP_SHARED file mapping, so a verdict reached by
+// one RequestServer is visible to all others without any IPC. Each slot is guarded by a sequence
+// counter (seqlock): readers never block, and treat a slot that is being written as a miss.
+//
+// Cold tier: PolicyGraph's sandbox_verdicts table. It keeps verdicts that were evicted from the hot
+// tier and holds the alert JSON for threats. Cold-tier hits are promoted back into the hot tier.
+//
+// Entries expire after a TTL, and are ignored once Sentinel reports a different YARA rule-set version.
+class VerdictCache {
+public:
+    struct Verdict {
+        bool is_threat { false };
+        Optional<ByteString> alert_json;
+    };
+
+    struct Statistics {
+        u64 hot_hits { 0 };
+        u64 cold_hits { 0 };
+        u64 misses { 0 };
+        u64 stores { 0 };
+    };
+
+    // The hot tier lives in TABLE_FILE_NAME inside directory; the cold tier is optional
+    static ErrorOr<NonnullOwnPtr<VerdictCache>> create(ByteString const& directory, OwnPtr<Sentinel::PolicyGraph> cold_tier = nullptr);
+    ~VerdictCache();
+
+    // sha256 is the lowercase hex digest, as produced by SecurityTap::compute_sha256()
+    Optional<Verdict> lookup(StringView sha256);
+    void store(StringView sha256, Verdict const&, u64 rule_set_version);
+
+    // Version of the rule set Sentinel is currently scanning with (0 = unknown, every lookup misses).
+    // Shared between processes, so the first RequestServer to see new rules invalidates all caches.
+    u64 rule_set_version() const;
+    void set_rule_set_version(u64);
+
+    void set_time_to_live(AK::Duration clean, AK::Duration threat)
+    {
+        m_clean_time_to_live = clean;
+        m_threat_time_to_live = threat;
+    }
+
+    Statistics statistics() const;
+
+    // Must be a power of two
+    static constexpr size_t SLOT_COUNT = 16384;
+    static constexpr size_t MAX_PROBE_DISTANCE = 8;
+
+    // The layout version is part of the name, so a layout change never reads an old table
+    static constexpr StringView TABLE_FILE_NAME = "verdict-cache-v1.bin"sv;
+
+    struct SharedSlot;
+    struct SharedTable;
+
+private:
+    VerdictCache(SharedTable*, OwnPtr<Sentinel::PolicyGraph> cold_tier);
+
+    enum class SlotVerdict : u64 {
+        Empty = 0,
+        Clean = 1,
+        Threat = 2,
+    };
+
+    using Digest = Array<u64, 4>;
+    struct SlotSnapshot {
+        Digest digest;
+        u64 rule_set_version { 0 };
+        i64 expires_at_ms { 0 };
+        SlotVerdict verdict { SlotVerdict::Empty };
+    };
+
+    static Optional<Digest> digest_from_hex(StringView sha256);
+    static Optional<SlotSnapshot> read_slot(SharedSlot const&);
+
+    Optional<SlotVerdict> lookup_hot_tier(Digest const&, u64 rule_set_version) const;
+    void store_hot_tier(Digest const&, SlotVerdict, u64 rule_set_version, UnixDateTime expires_at);
+
+    Optional<Verdict> lookup_cold_tier(StringView sha256, u64 rule_set_version, UnixDateTime& expires_at);
+    void store_cold_tier(StringView sha256, Verdict const&, u64 rule_set_version, UnixDateTime expires_at);
+
+    SharedTable* m_table { nullptr };
+
+    // PolicyGraph is not thread-safe, and worker pool threads look up verdicts concurrently
+    OwnPtr<Sentinel::PolicyGraph> m_cold_tier;
+    Sync::Mutex m_cold_tier_mutex;
+
+    AK::Duration m_clean_time_to_live { AK::Duration::from_seconds(24 * 60 * 60) };
+    AK::Duration m_threat_time_to_live { AK::Duration::from_seconds(7 * 24 * 60 * 60) };
+
+    Atomic<u64> m_hot_hits { 0 };
+    Atomic<u64> m_cold_hits { 0 };
+    Atomic<u64> m_misses { 0 };
+    Atomic<u64> m_stores { 0 };
+};
+
+}
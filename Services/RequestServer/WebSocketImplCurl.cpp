@@ -9,6 +9,8 @@
 #include <RequestServer/ConnectionFromClient.h>
 #include <RequestServer/WebSocketImplCurl.h>
 
+#include <string.h>
+
 namespace RequestServer {
 
 static constexpr long s_connect_timeout_seconds = 90L;
@@ -133,6 +135,21 @@ ErrorOr<ByteString> WebSocketImplCurl::read_line(size_t)
 
 bool WebSocketImplCurl::send(ReadonlyBytes bytes)
 {
+    // Nothing is queued ahead of these bytes, so hand them to curl directly and only copy whatever it can't take yet.
+    if (m_pending_write_buffer.is_empty()) {
+        size_t sent = 0;
+        auto const result = curl_easy_send(m_easy_handle, bytes.data(), bytes.size(), &sent);
+        if (result != CURLE_OK && result != CURLE_AGAIN) {
+            dbgln("Failed to send to WebSocket: {}", curl_easy_strerror(result));
+            on_connection_error();
+            return false;
+        }
+
+        bytes = bytes.slice(sent);
+        if (bytes.is_empty())
+            return true;
+    }
+
     if (auto const error = m_pending_write_buffer.try_append(bytes); error.is_error()) {
         dbgln("Failed to queue WebSocket write: {}", error.error());
         on_connection_error();
@@ -146,6 +163,27 @@ bool WebSocketImplCurl::send(ReadonlyBytes bytes)
     return false;
 }
 
+Optional<ByteString> WebSocketImplCurl::handshake_response_header(StringView name) const
+{
+    auto name_string = ByteString(name);
+
+    curl_header* header = nullptr;
+    if (curl_easy_header(m_easy_handle, name_string.characters(), 0, CURLH_HEADER, -1, &header) != CURLHE_OK)
+        return {};
+
+    StringBuilder builder;
+    builder.append(StringView { header->value, strlen(header->value) });
+
+    for (size_t index = 1; index < header->amount; ++index) {
+        if (curl_easy_header(m_easy_handle, name_string.characters(), index, CURLH_HEADER, -1, &header) != CURLHE_OK)
+            break;
+        builder.append(',');
+        builder.append(StringView { header->value, strlen(header->value) });
+    }
+
+    return builder.to_byte_string();
+}
+
 bool WebSocketImplCurl::eof()
 {
     return m_read_buffer.is_eof();
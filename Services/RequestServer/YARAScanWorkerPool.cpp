@@ -100,12 +100,8 @@ ErrorOr<void> YARAScanWorkerPool::stop()
 ErrorOr<void> YARAScanWorkerPool::enqueue_scan(
     SecurityTap::DownloadMetadata const& metadata,
     ByteBuffer content,
-    SecurityTap::ScanCallback callback)
+    SecurityTap::ScanCallback& callback)
 {
-    if (!m_running) {
-        return Error::from_string_literal("Worker pool not running");
-    }
-
     // Calculate priority based on content size (smaller files = higher priority)
     // Priority 0-9: 0-1MB (immediate)
     // Priority 10-99: 1-10MB (high)
@@ -119,21 +115,56 @@ ErrorOr<void> YARAScanWorkerPool::enqueue_scan(
     ScanRequest request {
         .request_id = MUST(String::formatted("scan_{}", metadata.sha256)),
         .content = move(content),
-        .callback = move(callback),
+        .sha256 = metadata.sha256,
+        .callback = nullptr,
         .enqueued_time = UnixDateTime::now(),
         .priority = priority,
     };
+    return enqueue(move(request), callback);
+}
+
+ErrorOr<void> YARAScanWorkerPool::enqueue_stream_window(
+    u64 stream_id,
+    ByteBuffer window,
+    bool is_end_of_stream,
+    ByteString sha256,
+    SecurityTap::ScanCallback& callback)
+{
+    // A paused transfer is waiting on every stream window, so they go ahead of whole-file scans
+    ScanRequest request {
+        .request_id = MUST(String::formatted("stream_{}", stream_id)),
+        .content = move(window),
+        .sha256 = move(sha256),
+        .callback = nullptr,
+        .enqueued_time = UnixDateTime::now(),
+        .priority = 0,
+        .stream_id = stream_id,
+        .is_end_of_stream = is_end_of_stream,
+    };
+    return enqueue(move(request), callback);
+}
 
-    // Enqueue the request
-    TRY(m_queue.enqueue(move(request)));
+ErrorOr<void> YARAScanWorkerPool::enqueue(ScanRequest request, SecurityTap::ScanCallback& callback)
+{
+    if (!m_running) {
+        return Error::from_string_literal("Worker pool not running");
+    }
+
+    request.callback = move(callback);
+    request.origin_event_loop = Core::EventLoop::current_weak();
+
+    // Enqueue the request; a rejected request is left untouched, so hand its callback back to the caller
+    if (auto result = m_queue.enqueue(move(request)); result.is_error()) {
+        callback = move(request.callback);
+        return result.release_error();
+    }
 
     // Update telemetry
+    auto queue_depth = m_queue.size();
     {
         Sync::MutexLocker locker(m_telemetry_mutex);
-        m_telemetry.current_queue_depth = m_queue.size();
-        if (m_telemetry.current_queue_depth > m_telemetry.max_queue_depth_seen) {
-            m_telemetry.max_queue_depth_seen = m_telemetry.current_queue_depth;
-        }
+        if (queue_depth > m_telemetry.max_queue_depth_seen)
+            m_telemetry.max_queue_depth_seen = queue_depth;
     }
 
     return {};
@@ -169,12 +200,6 @@ void YARAScanWorkerPool::worker_thread()
 
         // Execute the scan
         execute_scan(request);
-
-        // Update telemetry
-        {
-            Sync::MutexLocker locker(m_telemetry_mutex);
-            m_telemetry.current_queue_depth = m_queue.size();
-        }
     }
 
     // Update active worker count
@@ -192,7 +217,10 @@ void YARAScanWorkerPool::execute_scan(ScanRequest& request)
 
     // Check if request has been waiting too long (timeout in queue)
     auto wait_time = start_time - request.enqueued_time;
-    if (wait_time > MAX_SCAN_TIMEOUT) {
+
+    // A stream window's transfer stays paused until its verdict arrives, so it is scanned however long it waited:
+    // failing it here would only let the held-back bytes through unscanned
+    if (wait_time > MAX_SCAN_TIMEOUT && !request.stream_id.has_value()) {
         dbgln("YARAScanWorkerPool: Request {} timed out in queue (waited {}s)",
             request.request_id, wait_time.to_seconds());
 
@@ -204,22 +232,26 @@ void YARAScanWorkerPool::execute_scan(ScanRequest& request)
 
         // Schedule callback with timeout error
         schedule_callback(
-            move(request.callback),
+            request,
             Error::from_string_literal("Scan timed out in queue"));
         return;
     }
 
     // Perform the actual YARA scan using SecurityTap
     // This is the blocking operation that runs in the worker thread
-    SecurityTap::DownloadMetadata metadata {
-        .url = "async-scan"_string.to_byte_string(),
-        .filename = request.request_id.to_byte_string(),
-        .mime_type = "application/octet-stream"_string.to_byte_string(),
-        .sha256 = request.request_id.to_byte_string(),
-        .size_bytes = request.content.size(),
-    };
-
-    auto scan_result = m_security_tap->inspect_download(metadata, request.content.bytes());
+    auto scan_result = [&] {
+        if (request.stream_id.has_value())
+            return m_security_tap->scan_queued_stream_window(*request.stream_id, request.content.bytes(), request.is_end_of_stream, request.sha256);
+
+        SecurityTap::DownloadMetadata metadata {
+            .url = "async-scan"_string.to_byte_string(),
+            .filename = request.request_id.to_byte_string(),
+            .mime_type = "application/octet-stream"_string.to_byte_string(),
+            .sha256 = move(request.sha256),
+            .size_bytes = request.content.size(),
+        };
+        return m_security_tap->inspect_download(metadata, request.content.bytes());
+    }();
 
     auto end_time = UnixDateTime::now();
     auto scan_duration = end_time - start_time;
@@ -249,24 +281,42 @@ void YARAScanWorkerPool::execute_scan(ScanRequest& request)
         wait_time.to_milliseconds());
 
     // Schedule callback execution on main event loop
-    schedule_callback(move(request.callback), move(scan_result));
+    schedule_callback(request, move(scan_result));
 }
 
 void YARAScanWorkerPool::schedule_callback(
-    SecurityTap::ScanCallback callback,
+    ScanRequest& request,
     ErrorOr<SecurityTap::ScanResult> result)
 {
-    // Schedule callback execution on the main event loop thread
-    // This ensures callbacks are executed on the IPC thread, not worker threads
-    Core::EventLoop::current().deferred_invoke([callback = move(callback), result = move(result)]() mutable {
+    // Releasing a stream that nobody waits for anymore has no callback
+    if (!request.callback)
+        return;
+
+    // Worker threads have no event loop of their own; the callback belongs to the IPC thread that queued the
+    // request. If that loop is gone, so is everybody who could be waiting for the result.
+    auto origin = request.origin_event_loop->take();
+    if (!origin)
+        return;
+
+    origin->deferred_invoke([callback = move(request.callback), result = move(result)]() mutable {
         callback(move(result));
     });
 }
 
 WorkerPoolTelemetry YARAScanWorkerPool::get_telemetry() const
 {
-    Sync::MutexLocker locker(m_telemetry_mutex);
-    return m_telemetry;
+    WorkerPoolTelemetry telemetry;
+    {
+        Sync::MutexLocker locker(m_telemetry_mutex);
+        telemetry = m_telemetry;
+    }
+
+    telemetry.current_queue_depth = m_queue.size();
+    telemetry.current_queued_bytes = m_queue.queued_bytes();
+    telemetry.backpressure_active = m_queue.is_saturated();
+    telemetry.queue_depth_histogram = m_queue.queue_depth_histogram();
+    telemetry.wait_time_histogram_ms = m_queue.wait_time_histogram_ms();
+    return telemetry;
 }
 
 }
@@ -30,6 +30,12 @@ struct WorkerPoolTelemetry {
     size_t current_queue_depth { 0 };
     size_t max_queue_depth_seen { 0 };
     size_t active_workers { 0 };
+
+    // Queue state, sampled from the lock-free ScanQueue when telemetry is requested
+    size_t current_queued_bytes { 0 };
+    bool backpressure_active { false };
+    ScanQueueHistogram queue_depth_histogram;
+    ScanQueueHistogram wait_time_histogram_ms;
 };
 
 // Thread pool for asynchronous YARA scanning
@@ -41,11 +47,20 @@ public:
 
     ~YARAScanWorkerPool();
 
-    // Enqueue a scan request for async processing
+    // Enqueue a scan request for async processing. The callback is only taken if this succeeds.
     ErrorOr<void> enqueue_scan(
         SecurityTap::DownloadMetadata const& metadata,
         ByteBuffer content,
-        SecurityTap::ScanCallback callback);
+        SecurityTap::ScanCallback& callback);
+
+    // Enqueue one window of a streamed body; the last window (which may be empty) ends the stream.
+    // The callback is only taken if this succeeds.
+    ErrorOr<void> enqueue_stream_window(
+        u64 stream_id,
+        ByteBuffer window,
+        bool is_end_of_stream,
+        ByteString sha256,
+        SecurityTap::ScanCallback& callback);
 
     // Start the worker threads
     ErrorOr<void> start();
@@ -56,12 +71,19 @@ public:
     // Get current telemetry data
     WorkerPoolTelemetry get_telemetry() const;
 
+    bool is_running() const { return m_running; }
+
+    // Whether the scan backlog is large enough that producers should pause their transfers
+    bool is_saturated() const { return m_queue.is_saturated(); }
+
     // Maximum time allowed per scan before timeout
     static constexpr Duration MAX_SCAN_TIMEOUT = Duration::from_seconds(60);
 
 private:
     YARAScanWorkerPool(SecurityTap* security_tap, size_t num_threads);
 
+    ErrorOr<void> enqueue(ScanRequest, SecurityTap::ScanCallback& callback);
+
     // Worker thread entry point
     static void* worker_thread_entry(void* arg);
     void worker_thread();
@@ -69,9 +91,9 @@ private:
     // Execute a single scan request
     void execute_scan(ScanRequest& request);
 
-    // Schedule callback execution on main event loop
+    // Schedule callback execution on the event loop that queued the request
     void schedule_callback(
-        SecurityTap::ScanCallback callback,
+        ScanRequest& request,
         ErrorOr<SecurityTap::ScanResult> result);
 
     SecurityTap* m_security_tap { nullptr };
@@ -12,13 +12,16 @@
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
 #include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
 #include <LibCore/Process.h>
+#include <LibCore/Timer.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibHTTP/Cache/DiskCache.h>
 #include <LibIPC/SingleServer.h>
 #include <LibMain/Main.h>
 #include <RequestServer/ConnectionFromClient.h>
+#include <RequestServer/RequestTrace.h>
 #include <RequestServer/Resolver.h>
 #include <RequestServer/ResourceSubstitutionMap.h>
 #include <RequestServer/Sandbox.h>
@@ -31,6 +34,9 @@ SecurityTap* g_security_tap { nullptr };
 
 }
 
+// The disk cache index batches its writes; this bounds how many are lost if RequestServer is killed.
+static constexpr int DISK_CACHE_INDEX_FLUSH_INTERVAL_MS = 5'000;
+
 #ifndef AK_OS_WINDOWS
 static void handle_signal(int signal)
 {
@@ -47,6 +53,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     StringView mach_server_name;
     StringView http_disk_cache_mode;
     StringView resource_map_path;
+    StringView request_trace_path;
     bool wait_for_debugger = false;
     bool enable_sandbox = false;
 
@@ -55,6 +62,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
     args_parser.add_option(http_disk_cache_mode, "HTTP disk cache mode", "http-disk-cache-mode", 0, "mode");
     args_parser.add_option(resource_map_path, "Path to JSON file mapping URLs to local files", "resource-map", 0, "path");
+    args_parser.add_option(request_trace_path, "Path to write a Chrome trace-event JSON file of request timings to on exit", "request-trace", 0, "path");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
     args_parser.add_option(enable_sandbox, "Enable process sandboxing", "enable-sandbox");
     args_parser.parse(arguments);
@@ -104,6 +112,14 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
             disk_cache = cache.release_value();
     }
 
+    RefPtr<Core::Timer> disk_cache_flush_timer;
+    if (disk_cache.has_value()) {
+        disk_cache_flush_timer = Core::Timer::create_repeating(DISK_CACHE_INDEX_FLUSH_INTERVAL_MS, [&disk_cache] {
+            disk_cache->flush_index();
+        });
+        disk_cache_flush_timer->start();
+    }
+
     // Initialize SecurityTap for Sentinel integration
     auto security_tap = RequestServer::SecurityTap::create();
     if (security_tap.is_error()) {
@@ -115,6 +131,17 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
         dbgln("RequestServer: SecurityTap initialized successfully");
     }
 
+    // The trace file is opened up front, as the sandbox may not let us create it later.
+    OwnPtr<Core::File> request_trace_file;
+    if (!request_trace_path.is_empty()) {
+        if (auto file = Core::File::open(request_trace_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate); file.is_error()) {
+            warnln("Unable to open request trace file '{}': {}", request_trace_path, file.error());
+        } else {
+            request_trace_file = file.release_value();
+            RequestServer::RequestTrace::the().enable();
+        }
+    }
+
     if (enable_sandbox)
         TRY(RequestServer::apply_sandbox(certificates));
 
@@ -126,5 +153,13 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
         mach_server_name,
         RequestServer::ConnectionFromClient::IsPrimaryConnection::Yes, connections, disk_cache));
 
-    return event_loop.exec();
+    auto exit_code = event_loop.exec();
+
+    if (request_trace_file) {
+        auto trace = RequestServer::RequestTrace::the().to_chrome_trace_json();
+        if (auto result = request_trace_file->write_until_depleted(trace.bytes()); result.is_error())
+            warnln("Unable to write request trace: {}", result.error());
+    }
+
+    return exit_code;
 }
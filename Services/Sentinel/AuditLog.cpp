@@ -8,9 +8,13 @@
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/Directory.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
+#include <LibThreading/Thread.h>
 
 namespace Sentinel {
 
@@ -67,6 +71,9 @@ AuditLogger::AuditLogger(String log_path, NonnullOwnPtr<Core::File> log_file)
 
 AuditLogger::~AuditLogger()
 {
+    // The writer thread writes out the queue one last time before it exits
+    stop_writer_thread();
+
     // Flush any remaining buffered events on destruction
     auto flush_result = flush();
     if (flush_result.is_error()) {
@@ -74,11 +81,8 @@ AuditLogger::~AuditLogger()
     }
 }
 
-ErrorOr<void> AuditLogger::log_event(AuditEvent const& event)
+JsonObject AuditLogger::to_json(AuditEvent const& event)
 {
-    Sync::MutexLocker locker(m_mutex);
-
-    // Build JSON object for this event (JSON Lines format)
     JsonObject json;
     json.set("timestamp"sv, JsonValue(event.timestamp.seconds_since_epoch()));
     json.set("type"sv, JsonValue(event_type_to_string(event.type)));
@@ -95,20 +99,46 @@ ErrorOr<void> AuditLogger::log_event(AuditEvent const& event)
     }
     json.set("metadata"sv, move(metadata_json));
 
-    // Serialize to JSON string (single line)
-    auto json_string = json.serialized();
+    return json;
+}
+
+ErrorOr<void> AuditLogger::log_event(AuditEvent const& event)
+{
+    if (m_event_queue) {
+        auto queued_event = event;
+        enqueue_event(queued_event);
+        return {};
+    }
 
-    // Write to log file (JSON Lines: one JSON object per line)
-    TRY(m_log_file->write_until_depleted(json_string.bytes()));
-    TRY(m_log_file->write_until_depleted("\n"sv.bytes()));
+    Sync::MutexLocker locker(m_mutex);
+    return write_json_line(event);
+}
 
-    // Add to buffer for potential flush
-    m_buffer.append(event);
+ErrorOr<void> AuditLogger::log_event(AuditEvent&& event)
+{
+    if (m_event_queue) {
+        enqueue_event(event);
+        return {};
+    }
+
+    Sync::MutexLocker locker(m_mutex);
+    return write_json_line(event);
+}
+
+ErrorOr<void> AuditLogger::write_json_line(AuditEvent const& event)
+{
+    // Write to log file (JSON Lines: one JSON object per line), with its newline in the same write
+    StringBuilder line;
+    line.append(to_json(event).serialized());
+    line.append('\n');
+    TRY(m_log_file->write_until_depleted(line.string_view().bytes()));
+
+    m_buffered_events++;
     m_total_events_logged++;
 
     // Auto-flush if buffer reaches threshold
-    if (m_buffer.size() >= m_buffer_size) {
-        TRY(flush());
+    if (m_buffered_events >= m_buffer_size) {
+        TRY(flush_buffer());
     }
 
     // Check if log rotation is needed (every 1000 events to avoid excessive checks)
@@ -121,22 +151,33 @@ ErrorOr<void> AuditLogger::log_event(AuditEvent const& event)
 
 ErrorOr<void> AuditLogger::flush()
 {
-    // Note: Caller must hold mutex
+    Sync::MutexLocker locker(m_mutex);
 
-    if (m_buffer.is_empty()) {
+    if (m_segment_writer)
+        TRY(write_queued_events());
+    return flush_buffer();
+}
+
+ErrorOr<void> AuditLogger::flush_buffer()
+{
+    if (m_buffered_events == 0) {
         return {};  // Nothing to flush
     }
 
     // Sync file to disk
-    if (fsync(m_log_file->fd()) < 0) {
+    ErrorOr<void> result {};
+    if (m_segment_writer)
+        result = m_segment_writer->sync();
+    else if (fsync(m_log_file->fd()) < 0)
+        result = Error::from_syscall("fsync"sv, -errno);
+
+    if (result.is_error()) {
         m_flush_errors++;
-        auto error = Error::from_syscall("fsync"sv, -errno);
-        dbgln("AuditLogger: Failed to sync log file: {}", error);
-        return error;
+        dbgln("AuditLogger: Failed to sync log file: {}", result.error());
+        return result.release_error();
     }
 
-    // Clear buffer after successful flush
-    m_buffer.clear();
+    m_buffered_events = 0;
     m_total_flushes++;
     m_last_flush_time = UnixDateTime::now();
 
@@ -183,7 +224,7 @@ ErrorOr<void> AuditLogger::log_scan(
         .metadata = move(metadata)
     };
 
-    return log_event(event);
+    return log_event(move(event));
 }
 
 ErrorOr<void> AuditLogger::log_quarantine(
@@ -206,7 +247,7 @@ ErrorOr<void> AuditLogger::log_quarantine(
         .metadata = move(enriched_metadata)
     };
 
-    return log_event(event);
+    return log_event(move(event));
 }
 
 ErrorOr<void> AuditLogger::log_restore(
@@ -230,7 +271,7 @@ ErrorOr<void> AuditLogger::log_restore(
         .metadata = move(metadata)
     };
 
-    return log_event(event);
+    return log_event(move(event));
 }
 
 ErrorOr<void> AuditLogger::log_delete(
@@ -250,7 +291,7 @@ ErrorOr<void> AuditLogger::log_delete(
         .metadata = {}
     };
 
-    return log_event(event);
+    return log_event(move(event));
 }
 
 ErrorOr<void> AuditLogger::log_policy_change(
@@ -280,7 +321,7 @@ ErrorOr<void> AuditLogger::log_policy_change(
         .metadata = {}
     };
 
-    return log_event(event);
+    return log_event(move(event));
 }
 
 ErrorOr<void> AuditLogger::log_config_change(
@@ -304,7 +345,7 @@ ErrorOr<void> AuditLogger::log_config_change(
         .metadata = move(metadata)
     };
 
-    return log_event(event);
+    return log_event(move(event));
 }
 
 ErrorOr<void> AuditLogger::log_access_denied(
@@ -323,7 +364,7 @@ ErrorOr<void> AuditLogger::log_access_denied(
         .metadata = metadata
     };
 
-    return log_event(event);
+    return log_event(move(event));
 }
 
 AuditLogger::Statistics AuditLogger::get_statistics() const
@@ -332,15 +373,23 @@ AuditLogger::Statistics AuditLogger::get_statistics() const
 
     return Statistics {
         .total_events_logged = m_total_events_logged,
-        .events_in_buffer = m_buffer.size(),
+        .events_in_buffer = m_buffered_events + m_queued_events.load(AK::MemoryOrder::memory_order_relaxed),
         .total_flushes = m_total_flushes,
         .flush_errors = m_flush_errors,
+        .queue_full_waits = m_queue_full_waits.load(AK::MemoryOrder::memory_order_relaxed),
         .last_flush_time = m_last_flush_time
     };
 }
 
 ErrorOr<void> AuditLogger::check_and_rotate_log()
 {
+    // Segments know their own size, so only the JSON log needs a stat
+    if (m_segment_writer) {
+        if (m_segment_writer->size() >= m_max_file_size)
+            return rotate_segment();
+        return {};
+    }
+
     // Check current log file size
     auto stat_result = Core::System::fstat(m_log_file->fd());
     if (stat_result.is_error()) {
@@ -363,10 +412,8 @@ ErrorOr<void> AuditLogger::check_and_rotate_log()
 
 ErrorOr<void> AuditLogger::rotate_log()
 {
-    Sync::MutexLocker locker(m_mutex);
-
     // Flush any pending events first
-    TRY(flush());
+    TRY(flush_buffer());
 
     // Note: We keep the log file open during rotation. It will be closed automatically
     // when we reassign m_log_file at the end.
@@ -412,4 +459,213 @@ ErrorOr<void> AuditLogger::rotate_log()
     return {};
 }
 
+// Asynchronous mode
+
+ErrorOr<void> AuditLogger::set_write_mode(WriteMode mode, AsyncOptions options)
+{
+    if (options.max_batch_size == 0)
+        return Error::from_string_literal("Audit log batch size must be at least 1");
+    if (options.queue_capacity < 2 || !is_power_of_two(options.queue_capacity))
+        return Error::from_string_literal("Audit log queue capacity must be a power of two");
+
+    stop_writer_thread();
+    {
+        Sync::MutexLocker locker(m_mutex);
+        if (m_segment_writer) {
+            TRY(write_queued_events());
+            TRY(flush_buffer());
+            m_segment_writer = nullptr;
+        }
+        m_event_queue = nullptr;
+    }
+
+    if (mode == WriteMode::Synchronous)
+        return {};
+
+    auto queue = TRY(try_make<BoundedMPMCRing<AuditEvent>>(options.queue_capacity));
+    auto writer = TRY(Threading::Thread::try_create("AuditLogger/Writer"sv, [this]() -> intptr_t {
+        return writer_thread_func();
+    }));
+
+    ByteString first_segment;
+    {
+        Sync::MutexLocker locker(m_mutex);
+
+        // Events already in the JSON log reach the disk before any go to a segment
+        TRY(flush_buffer());
+
+        // A batch can never outgrow the queue, or the writer would wait for one that cannot fill
+        m_async_options = options;
+        m_async_options.max_batch_size = min(options.max_batch_size, options.queue_capacity);
+        m_segment_indices = TRY(find_segment_indices());
+        TRY(open_next_segment());
+        first_segment = m_segment_writer->path();
+        m_event_queue = move(queue);
+    }
+
+    {
+        Sync::MutexLocker locker(m_writer_mutex);
+        m_writer_stopping = false;
+        m_writer_thread = writer;
+    }
+    writer->start();
+
+    dbgln("AuditLogger: Writing segments asynchronously to {} (every {}ms or {} events)",
+        first_segment, options.flush_interval.to_milliseconds(), m_async_options.max_batch_size);
+    return {};
+}
+
+void AuditLogger::enqueue_event(AuditEvent& event)
+{
+    // Counted before it is pushed, so the writer can never pop more events than are counted
+    auto queued = m_queued_events.fetch_add(1, AK::MemoryOrder::memory_order_acq_rel) + 1;
+
+    while (!m_event_queue->try_push(event)) {
+        // The writer is behind. Wait for it rather than lose the event; the timeout covers a wakeup
+        // missed between the failed push and taking the lock.
+        m_queue_full_waits.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        Sync::MutexLocker locker(m_writer_mutex);
+        m_waiting_producers.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+        m_writer_condition.signal();
+        (void)m_queue_space_condition.wait_for(m_async_options.flush_interval);
+        m_waiting_producers.fetch_sub(1, AK::MemoryOrder::memory_order_relaxed);
+    }
+
+    // Wake the writer for the first event of a batch, and again once the batch is full
+    if (queued == 1 || queued == m_async_options.max_batch_size) {
+        Sync::MutexLocker locker(m_writer_mutex);
+        m_writer_condition.signal();
+    }
+}
+
+ErrorOr<void> AuditLogger::write_queued_events()
+{
+    if (!m_segment_writer || !m_event_queue)
+        return {};
+
+    size_t written = 0;
+    while (true) {
+        auto event = m_event_queue->try_pop();
+        if (!event.has_value())
+            break;
+        m_queued_events.fetch_sub(1, AK::MemoryOrder::memory_order_acq_rel);
+
+        TRY(m_segment_writer->append(*event));
+        written++;
+        if (m_segment_writer->pending_event_count() >= m_async_options.max_batch_size)
+            TRY(m_segment_writer->write_block());
+    }
+    TRY(m_segment_writer->write_block());
+
+    if (written == 0)
+        return {};
+
+    m_total_events_logged += written;
+    m_buffered_events += written;
+
+    // Every round is synced, so a crash only loses what was still queued
+    TRY(flush_buffer());
+    return check_and_rotate_log();
+}
+
+ByteString AuditLogger::segment_path(u64 index) const
+{
+    return ByteString::formatted("{}.{:06}.seg", m_log_path, index);
+}
+
+ErrorOr<Vector<u64>> AuditLogger::find_segment_indices() const
+{
+    LexicalPath log_path { m_log_path.to_byte_string() };
+    auto prefix = ByteString::formatted("{}.", log_path.basename());
+
+    Vector<u64> indices;
+    TRY(Core::Directory::for_each_entry(log_path.dirname(), Core::DirIterator::SkipParentAndBaseDir, [&](auto const& entry, auto const&) -> ErrorOr<IterationDecision> {
+        StringView name = entry.name;
+        if (name.length() > prefix.length() + 4 && name.starts_with(prefix) && name.ends_with(".seg"sv)) {
+            auto index = name.substring_view(prefix.length(), name.length() - prefix.length() - 4).to_number<u64>();
+            if (index.has_value())
+                TRY(indices.try_append(*index));
+        }
+        return IterationDecision::Continue;
+    }));
+
+    quick_sort(indices);
+    return indices;
+}
+
+ErrorOr<void> AuditLogger::open_next_segment()
+{
+    u64 index = m_segment_indices.is_empty() ? 1 : m_segment_indices.last() + 1;
+    m_segment_writer = TRY(AuditSegmentWriter::create(segment_path(index), m_async_options.compression));
+    TRY(m_segment_indices.try_append(index));
+
+    // Keep the segment being written and up to m_max_rotated_files before it
+    while (m_segment_indices.size() > m_max_rotated_files + 1) {
+        auto oldest = segment_path(m_segment_indices.take_first());
+        if (auto result = FileSystem::remove(oldest, FileSystem::RecursionMode::Disallowed); result.is_error())
+            dbgln("AuditLogger: Failed to delete old segment {}: {}", oldest, result.error());
+    }
+
+    return {};
+}
+
+ErrorOr<void> AuditLogger::rotate_segment()
+{
+    TRY(m_segment_writer->write_block());
+    TRY(m_segment_writer->sync());
+
+    dbgln("AuditLogger: Segment {} reached {} bytes, starting the next one", m_segment_writer->path(), m_segment_writer->size());
+    return open_next_segment();
+}
+
+intptr_t AuditLogger::writer_thread_func()
+{
+    while (true) {
+        bool stopping = false;
+        {
+            Sync::MutexLocker locker(m_writer_mutex);
+            m_writer_condition.wait_while([this] {
+                return m_queued_events.load(AK::MemoryOrder::memory_order_acquire) == 0 && !m_writer_stopping;
+            });
+
+            // Give the batch one flush interval to fill up, unless it already has
+            if (!m_writer_stopping && m_queued_events.load(AK::MemoryOrder::memory_order_acquire) < m_async_options.max_batch_size)
+                (void)m_writer_condition.wait_for(m_async_options.flush_interval);
+            stopping = m_writer_stopping;
+        }
+
+        {
+            Sync::MutexLocker locker(m_mutex);
+            if (auto result = write_queued_events(); result.is_error())
+                dbgln("AuditLogger: Failed to write queued events: {}", result.error());
+        }
+
+        if (m_waiting_producers.load(AK::MemoryOrder::memory_order_relaxed) > 0) {
+            Sync::MutexLocker locker(m_writer_mutex);
+            m_queue_space_condition.broadcast();
+        }
+
+        if (stopping)
+            return 0;
+    }
+}
+
+void AuditLogger::stop_writer_thread()
+{
+    RefPtr<Threading::Thread> writer;
+    {
+        Sync::MutexLocker locker(m_writer_mutex);
+        if (!m_writer_thread)
+            return;
+        m_writer_stopping = true;
+        m_writer_condition.broadcast();
+        writer = m_writer_thread;
+    }
+
+    (void)writer->join();
+
+    Sync::MutexLocker locker(m_writer_mutex);
+    m_writer_thread = nullptr;
+}
+
 }
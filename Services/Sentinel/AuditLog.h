@@ -6,16 +6,23 @@
 
 #pragma once
 
+#include <AK/Atomic.h>
 #include <AK/Error.h>
 #include <AK/HashMap.h>
+#include <AK/JsonObject.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Optional.h>
+#include <AK/OwnPtr.h>
+#include <AK/RefPtr.h>
 #include <AK/String.h>
 #include <AK/Time.h>
 #include <AK/Vector.h>
 #include <LibCore/File.h>
-#include <LibCore/MappedFile.h>
+#include <LibSync/ConditionVariable.h>
 #include <LibSync/Mutex.h>
+#include <LibThreading/Forward.h>
+#include "AuditSegment.h"
+#include "BoundedMPMCRing.h"
 
 namespace Sentinel {
 
@@ -51,13 +58,39 @@ struct AuditEvent {
 // Audit logger for structured security event logging
 class AuditLogger {
 public:
+    enum class WriteMode {
+        Synchronous,  // Each event is appended to the JSON Lines log before log_event() returns
+        Asynchronous, // Events are queued and a writer thread appends them to binary segments in batches
+    };
+
+    struct AsyncOptions {
+        size_t queue_capacity { 4096 }; // Events; a power of two
+        AK::Duration flush_interval { AK::Duration::from_milliseconds(100) };
+        size_t max_batch_size { 256 }; // Events per segment block
+        AuditSegmentCompression compression { AuditSegmentCompression::Deflate };
+    };
+
     // Create audit logger with specified log file path
     static ErrorOr<NonnullOwnPtr<AuditLogger>> create(String log_path);
 
     ~AuditLogger();
 
+    // Asynchronous mode: log_event() only copies the event into a lock-free queue, and a writer
+    // thread encodes the queued events into blocks of the current segment, {log_path}.{index}.seg,
+    // after flush_interval or once max_batch_size are queued. A full queue makes callers wait for
+    // the writer rather than drop events. Segments rotate by size like the JSON log does; convert
+    // them back to JSON Lines with `sentinel-cli audit-replay`.
+    //
+    // Switch modes before other threads start logging.
+    ErrorOr<void> set_write_mode(WriteMode, AsyncOptions = {});
+    WriteMode write_mode() const { return m_event_queue ? WriteMode::Asynchronous : WriteMode::Synchronous; }
+
     // Log a complete audit event
     ErrorOr<void> log_event(AuditEvent const& event);
+    ErrorOr<void> log_event(AuditEvent&& event);
+
+    // The JSON Lines representation of an event, as the synchronous log stores it
+    static JsonObject to_json(AuditEvent const& event);
 
     // Convenience methods for common audit events
 
@@ -106,15 +139,16 @@ public:
         StringView reason,
         HashMap<String, String> const& metadata = {});
 
-    // Force flush buffered events to disk
+    // Force flush buffered events to disk; in asynchronous mode, this writes out the queue first
     ErrorOr<void> flush();
 
     // Get statistics
     struct Statistics {
         size_t total_events_logged { 0 };
-        size_t events_in_buffer { 0 };
+        size_t events_in_buffer { 0 };  // Not yet synced to disk, including queued events
         size_t total_flushes { 0 };
         size_t flush_errors { 0 };
+        size_t queue_full_waits { 0 };  // Times a caller waited for the writer thread
         UnixDateTime last_flush_time;
     };
     Statistics get_statistics() const;
@@ -123,33 +157,67 @@ public:
     void set_buffer_size(size_t size) { m_buffer_size = size; }
     size_t buffer_size() const { return m_buffer_size; }
 
+    // Rotation limits, which apply to the JSON log and to segments alike
+    void set_max_file_size(size_t size) { m_max_file_size = size; }
+    void set_max_rotated_files(size_t count) { m_max_rotated_files = count; }
+
 private:
     AuditLogger(String log_path, NonnullOwnPtr<Core::File> log_file);
 
     // Convert event type to string
     static StringView event_type_to_string(AuditEventType type);
 
-    // Check if log rotation is needed and perform it
+    // The following expect the caller to hold m_mutex
+
+    ErrorOr<void> write_json_line(AuditEvent const& event);
+    ErrorOr<void> flush_buffer();
+
+    // Check if log (or, in asynchronous mode, segment) rotation is needed and perform it
     ErrorOr<void> check_and_rotate_log();
 
     // Perform log rotation
     ErrorOr<void> rotate_log();
 
+    // Asynchronous mode
+    void enqueue_event(AuditEvent& event);
+    ErrorOr<void> write_queued_events();
+    ErrorOr<void> open_next_segment();
+    ErrorOr<void> rotate_segment();
+    ErrorOr<Vector<u64>> find_segment_indices() const;
+    ByteString segment_path(u64 index) const;
+    intptr_t writer_thread_func();
+    void stop_writer_thread();
+
     String m_log_path;
     NonnullOwnPtr<Core::File> m_log_file;
-    Vector<AuditEvent> m_buffer;
+    size_t m_buffered_events { 0 };  // Written but not yet synced
     size_t m_buffer_size { 100 };  // Flush after 100 events
 
-    // Thread safety
+    // Thread safety; guards everything but the queue and the writer thread state
     mutable Sync::Mutex m_mutex;
 
+    // Asynchronous mode. Producers only take m_writer_mutex to wake the writer for the first event
+    // of a batch, when a batch fills up, or when the queue is full.
+    OwnPtr<BoundedMPMCRing<AuditEvent>> m_event_queue;
+    Atomic<size_t> m_queued_events { 0 };
+    AsyncOptions m_async_options;
+    OwnPtr<AuditSegmentWriter> m_segment_writer;
+    Vector<u64> m_segment_indices; // Oldest first; the last one is being written
+    mutable Sync::Mutex m_writer_mutex;
+    Sync::ConditionVariable m_writer_condition { m_writer_mutex };
+    Sync::ConditionVariable m_queue_space_condition { m_writer_mutex };
+    RefPtr<Threading::Thread> m_writer_thread;
+    bool m_writer_stopping { false };
+    Atomic<size_t> m_waiting_producers { 0 };
+    Atomic<size_t> m_queue_full_waits { 0 };
+
     // Statistics
     mutable size_t m_total_events_logged { 0 };
     mutable size_t m_total_flushes { 0 };
     mutable size_t m_flush_errors { 0 };
     mutable UnixDateTime m_last_flush_time;
 
-    // Log rotation settings
+    // Log rotation settings, which also apply to segments
     size_t m_max_file_size { 100 * 1024 * 1024 };  // 100MB default
     size_t m_max_rotated_files { 10 };             // Keep 10 old logs
 };
@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "AuditSegment.h"
+#include "AuditLog.h"
+#include <AK/Endian.h>
+#include <AK/MemoryStream.h>
+#include <LibCompress/Deflate.h>
+#include <unistd.h>
+
+namespace Sentinel {
+
+static constexpr size_t SEGMENT_HEADER_SIZE = AuditSegmentWriter::MAGIC.length() + 1;
+static constexpr size_t BLOCK_HEADER_SIZE = 3 * sizeof(u32) + sizeof(u8) + sizeof(u64);
+
+// Blocks only ever hold one writer batch, so anything claiming more is damage rather than data
+static constexpr u32 MAX_BLOCK_SIZE = 256 * 1024 * 1024;
+
+static u64 block_checksum(ReadonlyBytes bytes)
+{
+    // FNV-1a
+    u64 hash = 0xcbf29ce484222325ULL;
+    for (auto byte : bytes) {
+        hash ^= byte;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+template<typename T>
+static ErrorOr<void> append_integer(ByteBuffer& buffer, T value)
+{
+    LittleEndian<T> little_endian = value;
+    return buffer.try_append(&little_endian, sizeof(little_endian));
+}
+
+static ErrorOr<void> append_string(ByteBuffer& buffer, StringView string)
+{
+    TRY(append_integer<u32>(buffer, string.length()));
+    return buffer.try_append(string.bytes());
+}
+
+template<typename T>
+static ErrorOr<T> read_integer(FixedMemoryStream& stream)
+{
+    return static_cast<T>(TRY(stream.read_value<LittleEndian<T>>()));
+}
+
+static ErrorOr<String> read_string(FixedMemoryStream& stream)
+{
+    auto length = TRY(read_integer<u32>(stream));
+    auto bytes = TRY(stream.read_in_place<u8 const>(length));
+    return String::from_utf8(StringView { bytes });
+}
+
+static ErrorOr<void> encode_event(ByteBuffer& buffer, AuditEvent const& event)
+{
+    TRY(append_integer<u8>(buffer, to_underlying(event.type)));
+    TRY(append_integer<i64>(buffer, event.timestamp.milliseconds_since_epoch()));
+    TRY(append_string(buffer, event.user));
+    TRY(append_string(buffer, event.resource));
+    TRY(append_string(buffer, event.action));
+    TRY(append_string(buffer, event.result));
+    TRY(append_string(buffer, event.reason));
+
+    TRY(append_integer<u32>(buffer, event.metadata.size()));
+    for (auto const& [key, value] : event.metadata) {
+        TRY(append_string(buffer, key));
+        TRY(append_string(buffer, value));
+    }
+    return {};
+}
+
+static ErrorOr<AuditEvent> decode_event(ReadonlyBytes record)
+{
+    FixedMemoryStream stream { record };
+
+    auto type = TRY(read_integer<u8>(stream));
+    if (type > to_underlying(AuditEventType::CacheInvalidated))
+        return Error::from_string_literal("Audit segment record has an unknown event type");
+
+    AuditEvent event;
+    event.type = static_cast<AuditEventType>(type);
+    event.timestamp = UnixDateTime::from_milliseconds_since_epoch(TRY(read_integer<i64>(stream)));
+    event.user = TRY(read_string(stream));
+    event.resource = TRY(read_string(stream));
+    event.action = TRY(read_string(stream));
+    event.result = TRY(read_string(stream));
+    event.reason = TRY(read_string(stream));
+
+    auto metadata_count = TRY(read_integer<u32>(stream));
+    for (u32 i = 0; i < metadata_count; ++i) {
+        auto key = TRY(read_string(stream));
+        auto value = TRY(read_string(stream));
+        TRY(event.metadata.try_set(move(key), move(value)));
+    }
+
+    if (!stream.is_eof())
+        return Error::from_string_literal("Audit segment record has trailing bytes");
+    return event;
+}
+
+ErrorOr<NonnullOwnPtr<AuditSegmentWriter>> AuditSegmentWriter::create(ByteString const& path, AuditSegmentCompression compression)
+{
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::MustBeNew));
+
+    TRY(file->write_until_depleted(MAGIC.bytes()));
+    TRY(file->write_value(VERSION));
+
+    auto writer = adopt_own(*new AuditSegmentWriter(path, move(file), compression));
+    writer->m_size = SEGMENT_HEADER_SIZE;
+    return writer;
+}
+
+AuditSegmentWriter::AuditSegmentWriter(ByteString path, NonnullOwnPtr<Core::File> file, AuditSegmentCompression compression)
+    : m_path(move(path))
+    , m_file(move(file))
+    , m_compression(compression)
+{
+}
+
+ErrorOr<void> AuditSegmentWriter::append(AuditEvent const& event)
+{
+    // The length goes in front once the record is encoded; a failed record leaves the block as it was
+    auto record_start = m_block.size();
+    auto result = [&]() -> ErrorOr<void> {
+        TRY(append_integer<u32>(m_block, 0));
+        TRY(encode_event(m_block, event));
+        return {};
+    }();
+    if (!result.is_error() && m_block.size() > MAX_BLOCK_SIZE)
+        result = Error::from_string_literal("Audit segment block is too large");
+    if (result.is_error()) {
+        m_block.resize(record_start);
+        return result.release_error();
+    }
+
+    LittleEndian<u32> record_length = m_block.size() - record_start - sizeof(u32);
+    __builtin_memcpy(m_block.data() + record_start, &record_length, sizeof(record_length));
+    m_pending_records++;
+    return {};
+}
+
+ErrorOr<void> AuditSegmentWriter::write_block()
+{
+    if (m_pending_records == 0)
+        return {};
+
+    ByteBuffer compressed;
+    ReadonlyBytes stored = m_block.bytes();
+    if (m_compression == AuditSegmentCompression::Deflate) {
+        compressed = TRY(Compress::DeflateCompressor::compress_all(m_block.bytes(), Compress::GenericZlibCompressionLevel::Fastest));
+        stored = compressed.bytes();
+    }
+
+    // Header and payload go out in one write, so a block is only ever torn at the end of the file
+    ByteBuffer block;
+    TRY(block.try_ensure_capacity(BLOCK_HEADER_SIZE + stored.size()));
+    TRY(append_integer<u32>(block, m_pending_records));
+    TRY(append_integer<u32>(block, m_block.size()));
+    TRY(append_integer<u32>(block, stored.size()));
+    TRY(append_integer<u8>(block, to_underlying(m_compression)));
+    TRY(append_integer<u64>(block, block_checksum(stored)));
+    TRY(block.try_append(stored));
+
+    TRY(m_file->write_until_depleted(block.bytes()));
+    m_size += block.size();
+
+    m_block.clear();
+    m_pending_records = 0;
+    return {};
+}
+
+ErrorOr<void> AuditSegmentWriter::sync()
+{
+    if (fsync(m_file->fd()) < 0)
+        return Error::from_syscall("fsync"sv, -errno);
+    return {};
+}
+
+ErrorOr<NonnullOwnPtr<AuditSegmentReader>> AuditSegmentReader::open(StringView path)
+{
+    auto file = TRY(Core::MappedFile::map(path));
+
+    auto bytes = file->bytes();
+    if (bytes.size() < SEGMENT_HEADER_SIZE || StringView { bytes.trim(AuditSegmentWriter::MAGIC.length()) } != AuditSegmentWriter::MAGIC)
+        return Error::from_string_literal("Not an audit log segment");
+    if (bytes[AuditSegmentWriter::MAGIC.length()] != AuditSegmentWriter::VERSION)
+        return Error::from_string_literal("Unsupported audit log segment version");
+
+    auto reader = adopt_own(*new AuditSegmentReader(move(file)));
+    reader->m_file_offset = SEGMENT_HEADER_SIZE;
+    return reader;
+}
+
+AuditSegmentReader::AuditSegmentReader(NonnullOwnPtr<Core::MappedFile> file)
+    : m_file(move(file))
+{
+}
+
+ErrorOr<bool> AuditSegmentReader::load_next_block()
+{
+    auto remaining = m_file->bytes().slice(m_file_offset);
+    if (remaining.size() < BLOCK_HEADER_SIZE)
+        return false;
+
+    FixedMemoryStream header { remaining.trim(BLOCK_HEADER_SIZE) };
+    auto record_count = TRY(read_integer<u32>(header));
+    auto encoded_size = TRY(read_integer<u32>(header));
+    auto stored_size = TRY(read_integer<u32>(header));
+    auto compression = TRY(read_integer<u8>(header));
+    auto checksum = TRY(read_integer<u64>(header));
+
+    if (encoded_size > MAX_BLOCK_SIZE || stored_size > MAX_BLOCK_SIZE)
+        return Error::from_string_literal("Audit segment block is too large");
+    if (remaining.size() - BLOCK_HEADER_SIZE < stored_size)
+        return false;
+
+    auto stored = remaining.slice(BLOCK_HEADER_SIZE, stored_size);
+    if (block_checksum(stored) != checksum)
+        return Error::from_string_literal("Audit segment block is corrupt");
+
+    switch (static_cast<AuditSegmentCompression>(compression)) {
+    case AuditSegmentCompression::None:
+        m_block = stored;
+        break;
+    case AuditSegmentCompression::Deflate:
+        m_decompressed_block = TRY(Compress::DeflateDecompressor::decompress_all(stored));
+        m_block = m_decompressed_block.bytes();
+        break;
+    default:
+        return Error::from_string_literal("Audit segment block has an unknown compression");
+    }
+
+    if (m_block.size() != encoded_size)
+        return Error::from_string_literal("Audit segment block has the wrong size");
+
+    m_file_offset += BLOCK_HEADER_SIZE + stored_size;
+    m_block_offset = 0;
+    m_records_left = record_count;
+    return true;
+}
+
+ErrorOr<Optional<AuditEvent>> AuditSegmentReader::next_event()
+{
+    while (m_records_left == 0) {
+        if (m_block_offset != m_block.size())
+            return Error::from_string_literal("Audit segment block has trailing bytes");
+        if (!TRY(load_next_block()))
+            return Optional<AuditEvent> {};
+    }
+
+    FixedMemoryStream stream { m_block.slice(m_block_offset) };
+    auto length = TRY(read_integer<u32>(stream));
+    auto record = TRY(stream.read_in_place<u8 const>(length));
+
+    m_block_offset += sizeof(u32) + length;
+    m_records_left--;
+    return Optional<AuditEvent> { TRY(decode_event(record)) };
+}
+
+}
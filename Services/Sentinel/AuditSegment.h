@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+#include <AK/Types.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
+
+namespace Sentinel {
+
+struct AuditEvent;
+
+enum class AuditSegmentCompression : u8 {
+    None = 0,
+    Deflate = 1,
+};
+
+// Binary audit log segments, written by AuditLogger in asynchronous mode.
+//
+// A segment is the magic "LBAUDSEG", a version byte, and then blocks of events. Each block is one
+// batch from the writer thread, stored on its own so a crash can only cut off the block being written:
+//
+//   u32 record_count, u32 encoded_size, u32 stored_size, u8 compression, u64 checksum, stored bytes
+//
+// The stored bytes are the encoded records, deflated if the block says so; the checksum is FNV-1a of
+// the stored bytes. Each record is a u32 length followed by the event: u8 type, i64 timestamp in
+// milliseconds, the user, resource, action, result and reason strings, then a u32 metadata count
+// and that many key/value string pairs. Strings are a u32 length and UTF-8. Integers are little-endian.
+class AuditSegmentWriter {
+public:
+    static constexpr StringView MAGIC = "LBAUDSEG"sv;
+    static constexpr u8 VERSION = 1;
+
+    // Creates the segment, failing if the file already exists
+    static ErrorOr<NonnullOwnPtr<AuditSegmentWriter>> create(ByteString const& path, AuditSegmentCompression);
+
+    // Adds an event to the block being built; nothing reaches the file until write_block()
+    ErrorOr<void> append(AuditEvent const&);
+
+    // Writes the pending events as one block, if there are any
+    ErrorOr<void> write_block();
+
+    ErrorOr<void> sync();
+
+    ByteString const& path() const { return m_path; }
+    size_t size() const { return m_size; } // Bytes written so far
+    size_t pending_event_count() const { return m_pending_records; }
+
+private:
+    AuditSegmentWriter(ByteString path, NonnullOwnPtr<Core::File>, AuditSegmentCompression);
+
+    ByteString m_path;
+    NonnullOwnPtr<Core::File> m_file;
+    AuditSegmentCompression m_compression { AuditSegmentCompression::None };
+    ByteBuffer m_block;
+    u32 m_pending_records { 0 };
+    size_t m_size { 0 };
+};
+
+// Reads the events back out of a segment, in the order they were written.
+class AuditSegmentReader {
+public:
+    static ErrorOr<NonnullOwnPtr<AuditSegmentReader>> open(StringView path);
+
+    // The next event, or nothing at the end of the segment. A block cut short at the end of the
+    // file (the writer died mid-block) also ends the segment; any other damage is an error.
+    ErrorOr<Optional<AuditEvent>> next_event();
+
+private:
+    explicit AuditSegmentReader(NonnullOwnPtr<Core::MappedFile>);
+
+    ErrorOr<bool> load_next_block();
+
+    NonnullOwnPtr<Core::MappedFile> m_file;
+    size_t m_file_offset { 0 };
+    ByteBuffer m_decompressed_block;
+    ReadonlyBytes m_block;
+    size_t m_block_offset { 0 };
+    u32 m_records_left { 0 };
+};
+
+}
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "MalwareML.h"
+#include <LibCore/ElapsedTimer.h>
+#include <LibMain/Main.h>
+
+using namespace Sentinel;
+
+// ============================================================================
+// Benchmark Helper Functions
+// ============================================================================
+
+static Vector<MalwareMLDetector::Features> create_feature_set(size_t count)
+{
+    Vector<MalwareMLDetector::Features> features;
+    features.ensure_capacity(count);
+
+    // Spread of benign-looking and malware-looking inputs, so every model branch is exercised
+    for (size_t i = 0; i < count; i++) {
+        MalwareMLDetector::Features sample;
+        sample.file_size = 4096 + (i * 7919) % (64 * 1024 * 1024);
+        sample.entropy = static_cast<float>(i % 80) / 10.0f;
+        sample.pe_header_anomalies = static_cast<u32>((i * 13) % 100);
+        sample.suspicious_strings = static_cast<u32>((i * 31) % 1000);
+        sample.code_section_ratio = static_cast<float>(i % 10) / 10.0f;
+        sample.import_table_size = static_cast<u32>((i * 17) % 500);
+        features.unchecked_append(sample);
+    }
+
+    return features;
+}
+
+static double predictions_per_second(size_t predictions, i64 elapsed_ns)
+{
+    if (elapsed_ns <= 0)
+        return 0.0;
+    return static_cast<double>(predictions) * 1'000'000'000.0 / static_cast<double>(elapsed_ns);
+}
+
+// ============================================================================
+// Benchmark 1: One Prediction per Call
+// ============================================================================
+
+static double benchmark_single_predictions(MalwareMLDetector& detector, Vector<MalwareMLDetector::Features> const& features)
+{
+    dbgln("\n=== Benchmark 1: Single Predictions ===");
+
+    // Warmup
+    for (size_t i = 0; i < 100; i++)
+        (void)MUST(detector.predict(features[i % features.size()]));
+
+    Core::ElapsedTimer timer;
+    timer.start();
+
+    for (auto const& sample : features)
+        (void)MUST(detector.predict(sample));
+
+    auto elapsed_ns = timer.elapsed_time().to_nanoseconds();
+    auto throughput = predictions_per_second(features.size(), elapsed_ns);
+
+    dbgln("Predictions: {}", features.size());
+    dbgln("Total Time: {:.2f} ms", static_cast<double>(elapsed_ns) / 1'000'000.0);
+    dbgln("Average Time: {} ns per prediction", elapsed_ns / static_cast<i64>(features.size()));
+    dbgln("Throughput: {:.0f} predictions/s", throughput);
+    return throughput;
+}
+
+// ============================================================================
+// Benchmark 2: Batched Predictions
+// ============================================================================
+
+static void benchmark_batched_predictions(MalwareMLDetector& detector, Vector<MalwareMLDetector::Features> const& features, double single_throughput)
+{
+    dbgln("\n=== Benchmark 2: Batched Predictions ===");
+
+    for (size_t batch_size : { 1, 8, 32, 128, 512 }) {
+        // Warmup, which also grows the tensors to the batch size
+        (void)MUST(detector.predict(features.span().slice(0, batch_size)));
+
+        Core::ElapsedTimer timer;
+        timer.start();
+
+        size_t predicted = 0;
+        for (size_t offset = 0; offset + batch_size <= features.size(); offset += batch_size) {
+            auto predictions = MUST(detector.predict(features.span().slice(offset, batch_size)));
+            predicted += predictions.size();
+        }
+
+        auto elapsed_ns = timer.elapsed_time().to_nanoseconds();
+        auto throughput = predictions_per_second(predicted, elapsed_ns);
+        dbgln("Batch {:>4}: {:.0f} predictions/s ({:.2f}x single)", batch_size, throughput,
+            single_throughput > 0 ? throughput / single_throughput : 0.0);
+    }
+}
+
+// ============================================================================
+// Main Entry Point
+// ============================================================================
+
+ErrorOr<int> ladybird_main(Main::Arguments)
+{
+    dbgln("========================================");
+    dbgln("  MalwareMLDetector Inference Benchmarks");
+    dbgln("========================================");
+
+    auto detector = TRY(MalwareMLDetector::create("/tmp/dummy_model.tflite"));
+    dbgln("Model: {}", detector->model_version());
+
+    auto features = create_feature_set(64 * 1024);
+
+    auto single_throughput = benchmark_single_predictions(*detector, features);
+    benchmark_batched_predictions(*detector, features, single_throughput);
+
+    auto stats = detector->get_statistics();
+    dbgln("\nTotal predictions: {} (average {:.4f} ms each)", stats.total_predictions, stats.average_inference_time_ms);
+
+    dbgln("\n========================================");
+    dbgln("  Benchmarks Complete");
+    dbgln("========================================");
+
+    return 0;
+}
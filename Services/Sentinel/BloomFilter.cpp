@@ -5,12 +5,48 @@
  */
 
 #include "BloomFilter.h"
+#include <AK/Atomic.h>
+#include <AK/BuiltinWrappers.h>
 #include <AK/Math.h>
+#include <AK/NumericLimits.h>
 #include <AK/Random.h>
+#include <AK/SIMD.h>
 #include <LibCrypto/Hash/SHA2.h>
 
 namespace Sentinel {
 
+using AK::SIMD::u64x4;
+
+// Distinguishes blocked filters from the original format, whose first field is the bit count
+static constexpr u64 BLOCKED_FORMAT_MAGIC = 0x4642425349544e53; // "SNTISBBF"
+// Version 1 stored the bits right after a 20 byte header. Version 2 pads the header to a whole block, so the bits of a
+// mapped file start on a cache line boundary.
+static constexpr u32 BLOCKED_FORMAT_VERSION = 2;
+static constexpr size_t BLOCKED_FORMAT_V1_HEADER_SIZE = sizeof(u64) + sizeof(u32) + sizeof(u64);
+
+// Format of differences: [magic:8][block_count:8][changed_block_count:8], then [block_index:4][block:64] per block
+static constexpr u64 DIFFERENCE_FORMAT_MAGIC = 0x4642445349544e53; // "SNTISDBF"
+static constexpr size_t DIFFERENCE_HEADER_SIZE = 3 * sizeof(u64);
+static constexpr size_t DIFFERENCE_ENTRY_SIZE = sizeof(u32) + BloomFilter::BLOCK_SIZE_BYTES;
+
+// Odd multipliers that spread a key into one bit position per 64-bit word of a block
+static constexpr u64x4 BLOCK_SALTS_LOW = { 0x9e3779b97f4a7c15ULL, 0xbf58476d1ce4e5b9ULL, 0x94d049bb133111ebULL, 0xd6e8feb86659fd93ULL };
+static constexpr u64x4 BLOCK_SALTS_HIGH = { 0xa0761d6478bd642fULL, 0xe7037ed1a0b428dbULL, 0x8ebc6af09c88c6e3ULL, 0x589965cc75374cc3ULL };
+
+static constexpr u64x4 splat(u64 value)
+{
+    return u64x4 { value, value, value, value };
+}
+
+// The single bit each word of the block must have set for key
+static void block_masks(u64 key, u64x4& low, u64x4& high)
+{
+    auto key_vector = splat(key);
+    auto one = splat(1);
+    low = one << ((key_vector * BLOCK_SALTS_LOW) >> 58);
+    high = one << ((key_vector * BLOCK_SALTS_HIGH) >> 58);
+}
+
 ErrorOr<NonnullOwnPtr<BloomFilter>> BloomFilter::create(size_t size_bits, size_t num_hashes)
 {
     if (size_bits == 0 || num_hashes == 0)
@@ -30,10 +66,83 @@ ErrorOr<NonnullOwnPtr<BloomFilter>> BloomFilter::create(size_t size_bits, size_t
     return filter;
 }
 
-BloomFilter::BloomFilter(size_t size_bits, size_t num_hashes)
+ErrorOr<NonnullOwnPtr<BloomFilter>> BloomFilter::create_blocked(size_t size_bits)
+{
+    if (size_bits == 0)
+        return Error::from_string_literal("BloomFilter: Invalid parameters");
+
+    auto block_count = ceil_div(size_bits, BLOCK_SIZE_BITS);
+    if (block_count > NumericLimits<u32>::max())
+        return Error::from_string_literal("BloomFilter: Too many blocks");
+
+    auto filter = adopt_own(*new BloomFilter(block_count * BLOCK_SIZE_BITS, BLOCKED_NUM_HASHES, Layout::Blocked));
+
+    // Over-allocate so the blocks can start on a cache line boundary
+    auto size_bytes = block_count * BLOCK_SIZE_BYTES;
+    filter->m_bits = TRY(ByteBuffer::create_zeroed(size_bytes + BLOCK_SIZE_BYTES - 1));
+    auto address = reinterpret_cast<FlatPtr>(filter->m_bits.data());
+    filter->m_bits_offset = align_up_to(address, BLOCK_SIZE_BYTES) - address;
+
+    dbgln("BloomFilter: Created blocked filter with {} blocks ({} MB)",
+        block_count, size_bytes / 1024 / 1024);
+
+    return filter;
+}
+
+BloomFilter::BloomFilter(size_t size_bits, size_t num_hashes, Layout layout)
     : m_size_bits(size_bits)
     , m_num_hashes(num_hashes)
+    , m_layout(layout)
+{
+}
+
+u8 const* BloomFilter::bits_data() const
 {
+    if (is_read_only())
+        return static_cast<u8 const*>(m_mapped_file->data()) + BLOCK_SIZE_BYTES;
+    return m_bits.data() + m_bits_offset;
+}
+
+Bytes BloomFilter::bit_bytes()
+{
+    VERIFY(!is_read_only());
+    return m_bits.bytes().slice(m_bits_offset, (m_size_bits + 7) / 8);
+}
+
+ReadonlyBytes BloomFilter::bit_bytes() const
+{
+    return { bits_data(), (m_size_bits + 7) / 8 };
+}
+
+u64* BloomFilter::block_words(size_t block_index)
+{
+    VERIFY(!is_read_only());
+    return reinterpret_cast<u64*>(m_bits.data() + m_bits_offset + block_index * BLOCK_SIZE_BYTES);
+}
+
+u64 const* BloomFilter::block_words(size_t block_index) const
+{
+    return reinterpret_cast<u64 const*>(bits_data() + block_index * BLOCK_SIZE_BYTES);
+}
+
+BloomFilter::BlockProbe BloomFilter::block_probe(ReadonlyBytes data) const
+{
+    // One digest gives both the block and the in-block key
+    auto sha256 = Crypto::Hash::SHA256::create();
+    sha256->update(data);
+    auto digest = sha256->digest();
+    auto digest_bytes = digest.bytes();
+
+    u64 block_hash = 0;
+    u64 key = 0;
+    for (size_t i = 0; i < 8; ++i) {
+        block_hash = (block_hash << 8) | digest_bytes[i];
+        key = (key << 8) | digest_bytes[8 + i];
+    }
+
+    // Map the top 32 bits onto [0, block_count) without a division
+    auto block_count = m_size_bits / BLOCK_SIZE_BITS;
+    return { .block_index = static_cast<size_t>(((block_hash >> 32) * block_count) >> 32), .key = key };
 }
 
 void BloomFilter::add(String const& item)
@@ -43,6 +152,20 @@ void BloomFilter::add(String const& item)
 
 void BloomFilter::add(ReadonlyBytes data)
 {
+    if (m_layout == Layout::Blocked) {
+        auto probe = block_probe(data);
+        u64x4 low;
+        u64x4 high;
+        block_masks(probe.key, low, high);
+
+        auto* words = block_words(probe.block_index);
+        for (size_t i = 0; i < 4; ++i) {
+            AK::atomic_fetch_or(&words[i], low[i], AK::memory_order_relaxed);
+            AK::atomic_fetch_or(&words[4 + i], high[i], AK::memory_order_relaxed);
+        }
+        return;
+    }
+
     auto hashes = hash_item(data);
 
     for (auto hash : hashes) {
@@ -58,6 +181,25 @@ bool BloomFilter::contains(String const& item) const
 
 bool BloomFilter::contains(ReadonlyBytes data) const
 {
+    if (m_layout == Layout::Blocked) {
+        auto probe = block_probe(data);
+        u64x4 low;
+        u64x4 high;
+        block_masks(probe.key, low, high);
+
+        // Relaxed loads, since add() may be setting bits in this block concurrently
+        auto const* words = block_words(probe.block_index);
+        u64x4 block_low;
+        u64x4 block_high;
+        for (size_t i = 0; i < 4; ++i) {
+            block_low[i] = AK::atomic_load(const_cast<u64*>(&words[i]), AK::memory_order_relaxed);
+            block_high[i] = AK::atomic_load(const_cast<u64*>(&words[4 + i]), AK::memory_order_relaxed);
+        }
+
+        auto missing = (low & ~block_low) | (high & ~block_high);
+        return (missing[0] | missing[1] | missing[2] | missing[3]) == 0;
+    }
+
     auto hashes = hash_item(data);
 
     for (auto hash : hashes) {
@@ -71,22 +213,15 @@ bool BloomFilter::contains(ReadonlyBytes data) const
 
 void BloomFilter::clear()
 {
+    VERIFY(!is_read_only());
     m_bits.zero_fill();
 }
 
 size_t BloomFilter::bits_set() const
 {
     size_t count = 0;
-
-    for (size_t byte_idx = 0; byte_idx < m_bits.size(); ++byte_idx) {
-        u8 byte = m_bits[byte_idx];
-        // Count set bits using Brian Kernighan's algorithm
-        while (byte) {
-            byte &= byte - 1;
-            count++;
-        }
-    }
-
+    for (auto byte : bit_bytes())
+        count += popcount(byte);
     return count;
 }
 
@@ -190,9 +325,23 @@ void BloomFilter::set_bit(size_t position)
 
 ErrorOr<ByteBuffer> BloomFilter::serialize() const
 {
+    auto bits = bit_bytes();
+
+    if (m_layout == Layout::Blocked) {
+        // Format: [magic:8][version:4][block_count:8][zero padding up to one block][bits:variable]
+        auto buffer = TRY(ByteBuffer::create_zeroed(BLOCK_SIZE_BYTES + bits.size()));
+
+        u64 block_count = m_size_bits / BLOCK_SIZE_BITS;
+        memcpy(buffer.data(), &BLOCKED_FORMAT_MAGIC, sizeof(u64));
+        memcpy(buffer.data() + sizeof(u64), &BLOCKED_FORMAT_VERSION, sizeof(u32));
+        memcpy(buffer.data() + sizeof(u64) + sizeof(u32), &block_count, sizeof(u64));
+        memcpy(buffer.data() + BLOCK_SIZE_BYTES, bits.data(), bits.size());
+        return buffer;
+    }
+
     // Format: [size_bits:8][num_hashes:4][bits:variable]
     size_t header_size = sizeof(u64) + sizeof(u32);
-    size_t total_size = header_size + m_bits.size();
+    size_t total_size = header_size + bits.size();
 
     auto buffer = TRY(ByteBuffer::create_uninitialized(total_size));
 
@@ -201,13 +350,73 @@ ErrorOr<ByteBuffer> BloomFilter::serialize() const
     *reinterpret_cast<u32*>(buffer.data() + sizeof(u64)) = m_num_hashes;
 
     // Write bits
-    memcpy(buffer.data() + header_size, m_bits.data(), m_bits.size());
+    memcpy(buffer.data() + header_size, bits.data(), bits.size());
 
     return buffer;
 }
 
+static bool is_serialized_blocked_filter(ReadonlyBytes data)
+{
+    if (data.size() < sizeof(u64))
+        return false;
+    u64 magic = 0;
+    memcpy(&magic, data.data(), sizeof(u64));
+    return magic == BLOCKED_FORMAT_MAGIC;
+}
+
+struct BlockedFilterHeader {
+    size_t header_size { 0 };
+    u64 block_count { 0 };
+};
+
+static ErrorOr<BlockedFilterHeader> parse_blocked_filter_header(ReadonlyBytes data)
+{
+    if (data.size() < BLOCKED_FORMAT_V1_HEADER_SIZE)
+        return Error::from_string_literal("BloomFilter: Invalid serialized data");
+
+    u32 version = 0;
+    BlockedFilterHeader header;
+    memcpy(&version, data.data() + sizeof(u64), sizeof(u32));
+    memcpy(&header.block_count, data.data() + sizeof(u64) + sizeof(u32), sizeof(u64));
+    if (version == 1)
+        header.header_size = BLOCKED_FORMAT_V1_HEADER_SIZE;
+    else if (version == BLOCKED_FORMAT_VERSION)
+        header.header_size = BloomFilter::BLOCK_SIZE_BYTES;
+    else
+        return Error::from_string_literal("BloomFilter: Unsupported blocked filter version");
+
+    if (header.block_count == 0 || header.block_count > NumericLimits<u32>::max()
+        || data.size() < header.header_size || data.size() - header.header_size != header.block_count * BloomFilter::BLOCK_SIZE_BYTES)
+        return Error::from_string_literal("BloomFilter: Size mismatch in serialized data");
+    return header;
+}
+
+ErrorOr<NonnullOwnPtr<BloomFilter>> BloomFilter::map_blocked(StringView path)
+{
+    auto mapped_file = TRY(Core::MappedFile::map(path));
+    if (!is_serialized_blocked_filter(mapped_file->bytes()))
+        return Error::from_string_literal("BloomFilter: Not a blocked filter");
+
+    auto header = TRY(parse_blocked_filter_header(mapped_file->bytes()));
+    if (header.header_size != BLOCK_SIZE_BYTES)
+        return Error::from_string_literal("BloomFilter: Only filters saved in the current format can be mapped");
+
+    auto filter = adopt_own(*new BloomFilter(header.block_count * BLOCK_SIZE_BITS, BLOCKED_NUM_HASHES, Layout::Blocked));
+    filter->m_mapped_file = move(mapped_file);
+
+    dbgln("BloomFilter: Mapped blocked filter with {} blocks from {}", header.block_count, path);
+    return filter;
+}
+
 ErrorOr<NonnullOwnPtr<BloomFilter>> BloomFilter::deserialize(ReadonlyBytes data)
 {
+    if (is_serialized_blocked_filter(data)) {
+        auto header = TRY(parse_blocked_filter_header(data));
+        auto filter = TRY(create_blocked(header.block_count * BLOCK_SIZE_BITS));
+        memcpy(filter->bit_bytes().data(), data.data() + header.header_size, header.block_count * BLOCK_SIZE_BYTES);
+        return filter;
+    }
+
     size_t header_size = sizeof(u64) + sizeof(u32);
     if (data.size() < header_size)
         return Error::from_string_literal("BloomFilter: Invalid serialized data");
@@ -216,14 +425,14 @@ ErrorOr<NonnullOwnPtr<BloomFilter>> BloomFilter::deserialize(ReadonlyBytes data)
     u64 size_bits = *reinterpret_cast<u64 const*>(data.data());
     u32 num_hashes = *reinterpret_cast<u32 const*>(data.data() + sizeof(u64));
 
-    // Create filter
-    auto filter = TRY(create(size_bits, num_hashes));
-
     // Read bits
     size_t expected_bytes = (size_bits + 7) / 8;
     if (data.size() != header_size + expected_bytes)
         return Error::from_string_literal("BloomFilter: Size mismatch in serialized data");
 
+    // Create filter
+    auto filter = TRY(create(size_bits, num_hashes));
+
     memcpy(filter->m_bits.data(), data.data() + header_size, expected_bytes);
 
     return filter;
@@ -231,15 +440,94 @@ ErrorOr<NonnullOwnPtr<BloomFilter>> BloomFilter::deserialize(ReadonlyBytes data)
 
 ErrorOr<void> BloomFilter::merge(BloomFilter const& other)
 {
-    if (m_size_bits != other.m_size_bits || m_num_hashes != other.m_num_hashes)
+    if (m_layout != other.m_layout || m_size_bits != other.m_size_bits || m_num_hashes != other.m_num_hashes)
         return Error::from_string_literal("BloomFilter: Cannot merge filters with different parameters");
 
-    // Bitwise OR of the two filters
-    for (size_t i = 0; i < m_bits.size(); ++i) {
-        m_bits[i] |= other.m_bits[i];
+    // Bitwise OR of the two filters, a vector at a time where possible
+    auto bits = bit_bytes();
+    auto other_bits = other.bit_bytes();
+    size_t i = 0;
+    for (; i + sizeof(u64x4) <= bits.size(); i += sizeof(u64x4)) {
+        u64x4 ours;
+        u64x4 theirs;
+        memcpy(&ours, bits.data() + i, sizeof(u64x4));
+        memcpy(&theirs, other_bits.data() + i, sizeof(u64x4));
+        ours |= theirs;
+        memcpy(bits.data() + i, &ours, sizeof(u64x4));
+    }
+    for (; i < bits.size(); ++i)
+        bits[i] |= other_bits[i];
+
+    return {};
+}
+
+ErrorOr<ByteBuffer> BloomFilter::serialize_difference_from(BloomFilter const& older) const
+{
+    if (m_layout != Layout::Blocked || older.m_layout != Layout::Blocked || m_size_bits != older.m_size_bits)
+        return Error::from_string_literal("BloomFilter: Differences need blocked filters of the same size");
+
+    u64 block_count = m_size_bits / BLOCK_SIZE_BITS;
+    Vector<u32> changed_blocks;
+    for (size_t i = 0; i < block_count; ++i) {
+        if (memcmp(block_words(i), older.block_words(i), BLOCK_SIZE_BYTES) != 0)
+            TRY(changed_blocks.try_append(static_cast<u32>(i)));
+    }
+
+    auto buffer = TRY(ByteBuffer::create_uninitialized(DIFFERENCE_HEADER_SIZE + changed_blocks.size() * DIFFERENCE_ENTRY_SIZE));
+    u64 changed_block_count = changed_blocks.size();
+    memcpy(buffer.data(), &DIFFERENCE_FORMAT_MAGIC, sizeof(u64));
+    memcpy(buffer.data() + sizeof(u64), &block_count, sizeof(u64));
+    memcpy(buffer.data() + 2 * sizeof(u64), &changed_block_count, sizeof(u64));
+
+    auto* entry = buffer.data() + DIFFERENCE_HEADER_SIZE;
+    for (auto block_index : changed_blocks) {
+        memcpy(entry, &block_index, sizeof(u32));
+        memcpy(entry + sizeof(u32), block_words(block_index), BLOCK_SIZE_BYTES);
+        entry += DIFFERENCE_ENTRY_SIZE;
+    }
+    return buffer;
+}
+
+ErrorOr<void> BloomFilter::apply_difference(ReadonlyBytes data)
+{
+    if (m_layout != Layout::Blocked)
+        return Error::from_string_literal("BloomFilter: Differences need blocked filters of the same size");
+    if (data.size() < DIFFERENCE_HEADER_SIZE)
+        return Error::from_string_literal("BloomFilter: Invalid difference data");
+
+    u64 magic = 0;
+    u64 block_count = 0;
+    u64 changed_block_count = 0;
+    memcpy(&magic, data.data(), sizeof(u64));
+    memcpy(&block_count, data.data() + sizeof(u64), sizeof(u64));
+    memcpy(&changed_block_count, data.data() + 2 * sizeof(u64), sizeof(u64));
+    if (magic != DIFFERENCE_FORMAT_MAGIC)
+        return Error::from_string_literal("BloomFilter: Invalid difference data");
+    if (block_count != m_size_bits / BLOCK_SIZE_BITS)
+        return Error::from_string_literal("BloomFilter: Differences need blocked filters of the same size");
+    if (changed_block_count > block_count || data.size() - DIFFERENCE_HEADER_SIZE != changed_block_count * DIFFERENCE_ENTRY_SIZE)
+        return Error::from_string_literal("BloomFilter: Size mismatch in difference data");
+
+    // Validate every entry before touching the filter, so a corrupt difference leaves it as it was
+    auto entries = data.slice(DIFFERENCE_HEADER_SIZE);
+    for (size_t offset = 0; offset < entries.size(); offset += DIFFERENCE_ENTRY_SIZE) {
+        u32 block_index = 0;
+        memcpy(&block_index, entries.data() + offset, sizeof(u32));
+        if (block_index >= block_count)
+            return Error::from_string_literal("BloomFilter: Invalid block in difference data");
     }
 
+    for (size_t offset = 0; offset < entries.size(); offset += DIFFERENCE_ENTRY_SIZE) {
+        u32 block_index = 0;
+        memcpy(&block_index, entries.data() + offset, sizeof(u32));
+        auto* words = block_words(block_index);
+        for (size_t i = 0; i < BLOCK_SIZE_BYTES / sizeof(u64); ++i) {
+            u64 word = 0;
+            memcpy(&word, entries.data() + offset + sizeof(u32) + i * sizeof(u64), sizeof(u64));
+            AK::atomic_fetch_or(&words[i], word, AK::memory_order_relaxed);
+        }
+    }
     return {};
 }
 
-}
\ No newline at end of file
+}
@@ -12,6 +12,7 @@
 #include <AK/String.h>
 #include <AK/Types.h>
 #include <AK/Vector.h>
+#include <LibCore/MappedFile.h>
 #include <LibCrypto/Hash/HashFunction.h>
 #include <LibCrypto/Hash/SHA2.h>
 
@@ -25,11 +26,37 @@ public:
     static constexpr size_t DEFAULT_SIZE_BITS = 1'200'000'000; // ~150MB
     static constexpr size_t DEFAULT_NUM_HASHES = 10; // Optimal for p=0.001
 
+    enum class Layout : u8 {
+        // num_hashes bits anywhere in the array
+        Standard,
+        // Split-block: BLOCKED_NUM_HASHES bits, one in each 64-bit word of a single 64-byte block
+        Blocked,
+    };
+
+    static constexpr size_t BLOCK_SIZE_BYTES = 64;
+    static constexpr size_t BLOCK_SIZE_BITS = BLOCK_SIZE_BYTES * 8;
+    static constexpr size_t BLOCKED_NUM_HASHES = BLOCK_SIZE_BYTES / sizeof(u64);
+
     static ErrorOr<NonnullOwnPtr<BloomFilter>> create(
         size_t size_bits = DEFAULT_SIZE_BITS,
         size_t num_hashes = DEFAULT_NUM_HASHES);
 
+    // A lookup in a blocked filter touches one cache line rather than up to num_hashes of them,
+    // at the cost of a slightly higher false positive rate for the same size. size_bits is
+    // rounded up to whole blocks. add() is atomic, so several threads may add (and look up) at once.
+    static ErrorOr<NonnullOwnPtr<BloomFilter>> create_blocked(size_t size_bits = DEFAULT_SIZE_BITS);
+
+    // Map a blocked filter saved by serialize() straight from a file instead of copying it into memory. Every
+    // process that maps the same file shares one copy of it in the page cache. Mapped filters are read-only, so
+    // writers should replace the file rather than write into it, e.g. by renaming a new file over it.
+    static ErrorOr<NonnullOwnPtr<BloomFilter>> map_blocked(StringView path);
+
+    Layout layout() const { return m_layout; }
+    bool is_read_only() const { return m_mapped_file.ptr() != nullptr; }
+
     // Add an item to the filter
+    // Thread-safe for Layout::Blocked; Layout::Standard filters need external synchronization
+    // Must not be called on a read-only filter
     void add(String const& item);
     void add(ReadonlyBytes data);
 
@@ -52,14 +79,37 @@ public:
     size_t estimated_item_count() const;
 
     // Serialize/deserialize for persistence
+    // Standard filters keep the original format; deserialize() accepts either layout
     ErrorOr<ByteBuffer> serialize() const;
     static ErrorOr<NonnullOwnPtr<BloomFilter>> deserialize(ReadonlyBytes data);
 
-    // Merge another bloom filter into this one (must have same parameters)
+    // Merge another bloom filter into this one (must have same layout and parameters, and this one must be writable)
     ErrorOr<void> merge(BloomFilter const& other);
 
+    // The blocks of a blocked filter that differ from an older copy of it, for peers that already have that copy.
+    // Filters only ever gain bits, so applying a difference is a merge of the blocks in it: applying one twice, or
+    // after a newer one, is harmless, and an interrupted sync can simply be retried.
+    ErrorOr<ByteBuffer> serialize_difference_from(BloomFilter const& older) const;
+    ErrorOr<void> apply_difference(ReadonlyBytes data);
+
 private:
-    BloomFilter(size_t size_bits, size_t num_hashes);
+    BloomFilter(size_t size_bits, size_t num_hashes, Layout = Layout::Standard);
+
+    // Blocked layout: which block a key lands in, and the key its bit positions are derived from
+    struct BlockProbe {
+        size_t block_index { 0 };
+        u64 key { 0 };
+    };
+    BlockProbe block_probe(ReadonlyBytes data) const;
+    u64* block_words(size_t block_index);
+    u64 const* block_words(size_t block_index) const;
+
+    // Start of the bit array, wherever it lives
+    u8 const* bits_data() const;
+
+    // The bit array, without the alignment padding blocked filters allocate
+    Bytes bit_bytes();
+    ReadonlyBytes bit_bytes() const;
 
     // Generate hash values for an item using double hashing
     // Uses SHA256 to generate two base hashes, then combines them
@@ -71,7 +121,14 @@ private:
 
     size_t m_size_bits { 0 };
     size_t m_num_hashes { 0 };
+    Layout m_layout { Layout::Standard };
     ByteBuffer m_bits;
+
+    // Blocked filters start their bits at the first 64-byte boundary inside m_bits
+    size_t m_bits_offset { 0 };
+
+    // Set for filters from map_blocked(), whose bits live in the mapping rather than in m_bits
+    OwnPtr<Core::MappedFile> m_mapped_file;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/FixedArray.h>
+#include <AK/Noncopyable.h>
+#include <AK/Optional.h>
+#include <AK/StdLibExtras.h>
+
+namespace Sentinel {
+
+// Bounded lock-free multi-producer/multi-consumer ring buffer (Vyukov's sequence-numbered slots).
+// Each slot's sequence number tells producers and consumers whose turn it is, so a push or pop only
+// ever contends on a single compare-exchange of the shared position counter.
+template<typename T>
+class BoundedMPMCRing {
+    AK_MAKE_NONCOPYABLE(BoundedMPMCRing);
+    AK_MAKE_NONMOVABLE(BoundedMPMCRing);
+
+public:
+    // Capacity must be a power of two
+    explicit BoundedMPMCRing(size_t capacity)
+        : m_slots(MUST(FixedArray<Slot>::create(capacity)))
+        , m_mask(capacity - 1)
+    {
+        VERIFY(capacity >= 2 && is_power_of_two(capacity));
+        for (size_t i = 0; i < capacity; ++i)
+            m_slots[i].sequence.store(i, AK::MemoryOrder::memory_order_relaxed);
+    }
+
+    // Returns false (leaving value untouched) if the ring is full
+    bool try_push(T& value)
+    {
+        auto position = m_enqueue_position.load(AK::MemoryOrder::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true) {
+            slot = &m_slots[position & m_mask];
+            auto sequence = slot->sequence.load(AK::MemoryOrder::memory_order_acquire);
+            auto difference = static_cast<ssize_t>(sequence) - static_cast<ssize_t>(position);
+            if (difference == 0) {
+                if (m_enqueue_position.compare_exchange_strong(position, position + 1, AK::MemoryOrder::memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                return false;
+            } else {
+                position = m_enqueue_position.load(AK::MemoryOrder::memory_order_relaxed);
+            }
+        }
+
+        slot->value = move(value);
+        slot->sequence.store(position + 1, AK::MemoryOrder::memory_order_release);
+        return true;
+    }
+
+    // Returns an empty Optional if the ring is empty
+    Optional<T> try_pop()
+    {
+        auto position = m_dequeue_position.load(AK::MemoryOrder::memory_order_relaxed);
+        Slot* slot = nullptr;
+        while (true) {
+            slot = &m_slots[position & m_mask];
+            auto sequence = slot->sequence.load(AK::MemoryOrder::memory_order_acquire);
+            auto difference = static_cast<ssize_t>(sequence) - static_cast<ssize_t>(position + 1);
+            if (difference == 0) {
+                if (m_dequeue_position.compare_exchange_strong(position, position + 1, AK::MemoryOrder::memory_order_relaxed))
+                    break;
+            } else if (difference < 0) {
+                return {};
+            } else {
+                position = m_dequeue_position.load(AK::MemoryOrder::memory_order_relaxed);
+            }
+        }
+
+        auto value = slot->value.release_value();
+        slot->sequence.store(position + m_mask + 1, AK::MemoryOrder::memory_order_release);
+        return value;
+    }
+
+    size_t capacity() const { return m_mask + 1; }
+
+private:
+    struct Slot {
+        Atomic<size_t> sequence { 0 };
+        Optional<T> value;
+    };
+
+    FixedArray<Slot> m_slots;
+    size_t m_mask { 0 };
+
+    // Producers and consumers each hammer their own counter; keep them on separate cache lines
+    alignas(64) Atomic<size_t> m_enqueue_position { 0 };
+    alignas(64) Atomic<size_t> m_dequeue_position { 0 };
+};
+
+}
@@ -33,6 +33,57 @@ ErrorOr<C2Detector::BeaconingAnalysis> C2Detector::analyze_beaconing(Vector<floa
     // Low CV indicates regular intervals (potential beaconing)
     analysis.interval_regularity = calculate_coefficient_of_variation(request_intervals);
 
+    TRY(classify_beaconing(analysis, calculate_mean(request_intervals)));
+    return analysis;
+}
+
+ErrorOr<C2Detector::BeaconingAnalysis> C2Detector::analyze_beaconing(IntervalWindow const& request_intervals)
+{
+    BeaconingAnalysis analysis;
+
+    if (request_intervals.size() < MinBeaconingRequests) {
+        return Error::from_string_literal("Need at least 5 requests for beaconing analysis");
+    }
+
+    analysis.request_count = static_cast<u32>(request_intervals.size());
+    analysis.interval_regularity = request_intervals.coefficient_of_variation();
+
+    TRY(classify_beaconing(analysis, request_intervals.mean()));
+    return analysis;
+}
+
+ErrorOr<C2Detector::BeaconingAnalysis> C2Detector::analyze_beaconing(BeaconTracker const& tracker)
+{
+    auto analysis = TRY(analyze_beaconing(tracker.intervals()));
+
+    auto periodicity = tracker.detect_periodicity();
+    if (!periodicity.has_value())
+        return analysis;
+
+    analysis.period_seconds = static_cast<float>(periodicity->period_seconds);
+    analysis.periodicity = periodicity->coherence;
+
+    // Random phases have a mean vector of length around 1/sqrt(n), so short histories need a much
+    // stronger showing before a flow counts as periodic
+    auto required_coherence = max(PeriodicCoherence, AK::sqrt(PeriodicFalseAlarmScale / static_cast<float>(periodicity->request_count)));
+    if (!analysis.is_beaconing && periodicity->coherence >= required_coherence) {
+        analysis.is_beaconing = true;
+        analysis.confidence = 0.70f;
+        analysis.explanation = TRY(String::formatted("Periodic requests every ~{:.0f}s (coherence {:.2f}) despite irregular intervals (CV={:.4f})",
+            periodicity->period_seconds, periodicity->coherence, analysis.interval_regularity));
+    }
+
+    return analysis;
+}
+
+bool C2Detector::has_regular_intervals(IntervalWindow const& request_intervals)
+{
+    return request_intervals.size() >= MinBeaconingRequests
+        && request_intervals.coefficient_of_variation() < RegularCV;
+}
+
+ErrorOr<void> C2Detector::classify_beaconing(BeaconingAnalysis& analysis, float mean_interval)
+{
     // Determine if beaconing based on CV thresholds
     if (analysis.interval_regularity < HighlyCertainCV) {
         // CV < 0.2: Highly regular intervals (strong beaconing signal)
@@ -48,9 +99,6 @@ ErrorOr<C2Detector::BeaconingAnalysis> C2Detector::analyze_beaconing(Vector<floa
         analysis.confidence = 0.85f;
     }
 
-    // Calculate mean interval for explanation
-    float mean_interval = calculate_mean(request_intervals);
-
     // Generate human-readable explanation
     StringBuilder builder;
     if (analysis.is_beaconing) {
@@ -69,7 +117,7 @@ ErrorOr<C2Detector::BeaconingAnalysis> C2Detector::analyze_beaconing(Vector<floa
     }
     analysis.explanation = TRY(builder.to_string());
 
-    return analysis;
+    return {};
 }
 
 ErrorOr<C2Detector::ExfiltrationAnalysis> C2Detector::analyze_exfiltration(
@@ -187,6 +235,142 @@ float C2Detector::calculate_coefficient_of_variation(Vector<float> const& interv
     return std_dev / mean;
 }
 
+void IntervalWindow::add(float interval)
+{
+    if (m_size == CAPACITY) {
+        // Replace the oldest interval, taking it out of the running statistics first
+        double removed = m_intervals[m_oldest];
+        double mean_without = (m_mean * static_cast<double>(m_size) - removed) / static_cast<double>(m_size - 1);
+        m_sum_of_squared_deviations -= (removed - m_mean) * (removed - mean_without);
+        m_mean = mean_without;
+        m_size--;
+
+        m_intervals[m_oldest] = interval;
+        m_oldest = (m_oldest + 1) % CAPACITY;
+    } else {
+        m_intervals[(m_oldest + m_size) % CAPACITY] = interval;
+    }
+
+    m_size++;
+    double delta = interval - m_mean;
+    m_mean += delta / static_cast<double>(m_size);
+    m_sum_of_squared_deviations += delta * (static_cast<double>(interval) - m_mean);
+
+    // Removals let rounding error accumulate, so start over from the stored intervals once per lap
+    if (m_size == CAPACITY && m_oldest == 0)
+        recompute_statistics();
+}
+
+void IntervalWindow::recompute_statistics()
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < m_size; ++i)
+        sum += m_intervals[(m_oldest + i) % CAPACITY];
+    m_mean = sum / static_cast<double>(m_size);
+
+    m_sum_of_squared_deviations = 0.0;
+    for (size_t i = 0; i < m_size; ++i) {
+        double deviation = m_intervals[(m_oldest + i) % CAPACITY] - m_mean;
+        m_sum_of_squared_deviations += deviation * deviation;
+    }
+}
+
+float IntervalWindow::standard_deviation() const
+{
+    if (m_size <= 1)
+        return 0.0f;
+    return static_cast<float>(AK::sqrt(max(m_sum_of_squared_deviations, 0.0) / static_cast<double>(m_size)));
+}
+
+float IntervalWindow::coefficient_of_variation() const
+{
+    // Zero mean shouldn't happen with time intervals
+    if (m_size == 0 || m_mean == 0.0)
+        return 0.0f;
+    return standard_deviation() / mean();
+}
+
+void BeaconTracker::record(double timestamp)
+{
+    if (m_request_count == 0)
+        m_first_request = timestamp;
+    else
+        m_intervals.add(static_cast<float>(timestamp - m_last_request));
+
+    // Offsets from the first request keep sub-second precision in a float for weeks
+    auto offset = static_cast<float>(timestamp - m_first_request);
+    if (m_recent_request_count < HISTORY_SIZE) {
+        m_recent_requests[(m_oldest_request + m_recent_request_count) % HISTORY_SIZE] = offset;
+        m_recent_request_count++;
+    } else {
+        m_recent_requests[m_oldest_request] = offset;
+        m_oldest_request = (m_oldest_request + 1) % HISTORY_SIZE;
+    }
+
+    m_last_request = timestamp;
+    m_request_count++;
+}
+
+Optional<BeaconTracker::Periodicity> BeaconTracker::detect_periodicity() const
+{
+    auto const count = m_recent_request_count;
+    if (count < MIN_PERIODICITY_REQUESTS)
+        return {};
+
+    // Oldest first, relative to the newest request so the phases below stay small
+    Array<double, HISTORY_SIZE> times;
+    auto newest = static_cast<double>(m_recent_requests[(m_oldest_request + count - 1) % HISTORY_SIZE]);
+    for (size_t i = 0; i < count; ++i)
+        times[i] = static_cast<double>(m_recent_requests[(m_oldest_request + i) % HISTORY_SIZE]) - newest;
+
+    auto const interval_count = count - 1;
+    Array<double, HISTORY_SIZE - 1> intervals;
+    for (size_t i = 0; i < interval_count; ++i)
+        intervals[i] = times[i + 1] - times[i];
+
+    Optional<Periodicity> best;
+    for (size_t candidate = 0; candidate < interval_count; ++candidate) {
+        auto guess = intervals[candidate];
+        if (guess < MIN_PERIOD_SECONDS)
+            continue;
+
+        // Fit the period to every interval that looks like a whole number of beats of it
+        double weighted_intervals = 0.0;
+        double squared_beats = 0.0;
+        size_t matched = 0;
+        for (size_t i = 0; i < interval_count; ++i) {
+            auto beats = AK::floor(intervals[i] / guess + 0.5);
+            if (beats < 1.0 || beats > MAX_SKIPPED_BEATS + 1)
+                continue;
+            if (AK::fabs(intervals[i] - beats * guess) >= PERIOD_TOLERANCE * guess)
+                continue;
+            weighted_intervals += intervals[i] * beats;
+            squared_beats += beats * beats;
+            matched++;
+        }
+
+        // Too few intervals fit for this to be the flow's period. The candidate always fits itself.
+        if (2 * matched < interval_count)
+            continue;
+        auto period = weighted_intervals / squared_beats;
+
+        double cosines = 0.0;
+        double sines = 0.0;
+        for (size_t i = 0; i < count; ++i) {
+            double sine, cosine;
+            AK::sincos(2.0 * AK::Pi<double> * times[i] / period, sine, cosine);
+            sines += sine;
+            cosines += cosine;
+        }
+
+        auto coherence = static_cast<float>(AK::hypot(cosines, sines) / static_cast<double>(count));
+        if (!best.has_value() || coherence > best->coherence)
+            best = Periodicity { period, coherence, count };
+    }
+
+    return best;
+}
+
 // Check if domain is a known upload service (whitelist)
 // This reduces false positives for legitimate file upload scenarios
 bool C2Detector::is_known_upload_service(StringView domain)
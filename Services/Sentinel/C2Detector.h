@@ -6,13 +6,88 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Error.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 
 namespace Sentinel {
 
+// The most recent inter-request intervals of one connection, with their mean and variance kept up
+// to date as intervals arrive and age out (Welford's method), so beaconing can be re-checked after
+// every request without another pass over the history.
+class IntervalWindow {
+public:
+    static constexpr size_t CAPACITY = 32;
+
+    void add(float interval);
+
+    size_t size() const { return m_size; }
+    bool is_empty() const { return m_size == 0; }
+
+    float mean() const { return static_cast<float>(m_mean); }
+    float standard_deviation() const; // Population standard deviation, like C2Detector's
+    float coefficient_of_variation() const;
+
+private:
+    void recompute_statistics();
+
+    Array<float, CAPACITY> m_intervals {};
+    size_t m_oldest { 0 };
+    size_t m_size { 0 };
+    double m_mean { 0.0 };
+    double m_sum_of_squared_deviations { 0.0 };
+};
+
+// Beaconing state of one flow, updated in O(1) per request.
+//
+// Besides the interval window, the tracker keeps the times of the most recent requests, from which
+// detect_periodicity() recovers a period even when the intervals look irregular, such as for a
+// beacon that skips beats or shares the flow with user traffic.
+class BeaconTracker {
+public:
+    static constexpr size_t HISTORY_SIZE = IntervalWindow::CAPACITY + 1;
+
+    struct Periodicity {
+        double period_seconds { 0.0 };
+        float coherence { 0.0f }; // How well the requests line up on that period, up to 1.0
+        size_t request_count { 0 }; // Requests the coherence was measured over
+    };
+
+    void record(double timestamp);
+
+    u64 request_count() const { return m_request_count; }
+    double last_request() const { return m_last_request; }
+    IntervalWindow const& intervals() const { return m_intervals; }
+
+    // Period on which the recent requests line up best, if there are enough of them.
+    //
+    // Each recent interval is a candidate period. A candidate is refined by least squares over the
+    // intervals that are close to one to MAX_SKIPPED_BEATS + 1 times it, and dropped unless they make
+    // up half the intervals. Requests are then placed on a circle by their phase within the period;
+    // the length of their mean vector is the coherence, which is near 1.0 for a beacon and near
+    // 1/sqrt(n) for random traffic.
+    //
+    // Costs O(HISTORY_SIZE^2), so this runs on analysis rather than on every request.
+    Optional<Periodicity> detect_periodicity() const;
+
+private:
+    static constexpr size_t MIN_PERIODICITY_REQUESTS = 8;
+    static constexpr double MIN_PERIOD_SECONDS = 10.0; // Timestamps are too coarse for shorter periods
+    static constexpr u32 MAX_SKIPPED_BEATS = 3;
+    static constexpr double PERIOD_TOLERANCE = 0.25; // Of the period, per interval
+
+    IntervalWindow m_intervals;
+    Array<float, HISTORY_SIZE> m_recent_requests {}; // Seconds after m_first_request, as a ring
+    size_t m_oldest_request { 0 };
+    size_t m_recent_request_count { 0 };
+    double m_first_request { 0.0 };
+    double m_last_request { 0.0 };
+    u64 m_request_count { 0 };
+};
+
 // Command & Control (C2) communication and data exfiltration detection
 // Milestone 0.4 Phase 6: Network Behavioral Analysis
 class C2Detector {
@@ -22,6 +97,8 @@ public:
         float interval_regularity { 0.0f };  // Coefficient of Variation (CV): σ/μ
         u32 request_count { 0 };             // Number of requests analyzed
         Vector<float> intervals;             // Inter-request intervals (seconds)
+        float period_seconds { 0.0f };       // Dominant period, if periodicity was checked and found
+        float periodicity { 0.0f };          // Coherence of the requests at that period
         bool is_beaconing { false };         // True if beaconing detected
         float confidence { 0.0f };           // Detection confidence (0.0-1.0)
         String explanation;                  // Human-readable explanation
@@ -44,6 +121,16 @@ public:
     // Requires at least 5 requests for statistical significance
     ErrorOr<BeaconingAnalysis> analyze_beaconing(Vector<float> const& request_intervals);
 
+    // Same analysis from running statistics; the result carries no copy of the intervals
+    ErrorOr<BeaconingAnalysis> analyze_beaconing(IntervalWindow const& request_intervals);
+
+    // Interval analysis of a tracked flow, which also flags strongly periodic flows whose
+    // intervals are irregular
+    ErrorOr<BeaconingAnalysis> analyze_beaconing(BeaconTracker const& tracker);
+
+    // O(1) check for enough regular intervals to suspect beaconing, cheap enough for every request
+    static bool has_regular_intervals(IntervalWindow const& request_intervals);
+
     // Analyze upload/download ratio for data exfiltration
     // Known upload services (e.g., Google Drive, S3) are whitelisted
     ErrorOr<ExfiltrationAnalysis> analyze_exfiltration(u64 bytes_sent, u64 bytes_received, StringView domain);
@@ -51,6 +138,9 @@ public:
 private:
     C2Detector() = default;
 
+    // Classify a coefficient of variation and explain it
+    static ErrorOr<void> classify_beaconing(BeaconingAnalysis&, float mean_interval);
+
     // Statistical analysis helpers
     static float calculate_coefficient_of_variation(Vector<float> const& intervals);
     static float calculate_mean(Vector<float> const& values);
@@ -63,6 +153,8 @@ private:
     static constexpr size_t MinBeaconingRequests = 5;      // Minimum for statistical significance
     static constexpr float HighlyCertainCV = 0.2f;         // CV < 0.2 = highly regular (beaconing)
     static constexpr float RegularCV = 0.4f;               // CV < 0.4 = somewhat regular
+    static constexpr float PeriodicCoherence = 0.6f;       // Periodic despite irregular intervals
+    static constexpr float PeriodicFalseAlarmScale = 8.0f; // Few requests need coherence above sqrt(8/n)
     static constexpr float SuspiciousUploadRatio = 0.7f;   // 70% uploads
     static constexpr float HighlySuspiciousUploadRatio = 0.9f; // 90% uploads
     static constexpr u64 MinExfiltrationBytes = 10 * 1024 * 1024; // 10 MB
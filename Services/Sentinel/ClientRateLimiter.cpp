@@ -5,6 +5,7 @@
  */
 
 #include "ClientRateLimiter.h"
+#include <AK/HashFunctions.h>
 
 namespace Sentinel {
 
@@ -13,47 +14,52 @@ ClientRateLimiter::ClientRateLimiter(ClientLimits limits)
 {
 }
 
-Core::TokenBucketRateLimiter& ClientRateLimiter::get_scan_limiter(int client_id)
+ClientRateLimiter::Client::Client(ClientLimits const& limits)
+    : scan_limiter(limits.scan_burst_capacity, limits.scan_requests_per_second)
+    , policy_limiter(limits.policy_burst_capacity, limits.policy_queries_per_second)
 {
-    // Must be called with mutex held
-    auto it = m_scan_limiters.find(client_id);
-    if (it == m_scan_limiters.end()) {
-        // Create new rate limiter for this client
-        auto limiter = adopt_own(*new Core::TokenBucketRateLimiter(
-            m_limits.scan_burst_capacity,
-            m_limits.scan_requests_per_second));
-        m_scan_limiters.set(client_id, move(limiter));
-        return *m_scan_limiters.find(client_id)->value;
-    }
-    return *it->value;
 }
 
-Core::TokenBucketRateLimiter& ClientRateLimiter::get_policy_limiter(int client_id)
+ClientRateLimiter::Shard& ClientRateLimiter::shard_for(int client_id) const
 {
-    // Must be called with mutex held
-    auto it = m_policy_limiters.find(client_id);
-    if (it == m_policy_limiters.end()) {
-        // Create new rate limiter for this client
-        auto limiter = adopt_own(*new Core::TokenBucketRateLimiter(
-            m_limits.policy_burst_capacity,
-            m_limits.policy_queries_per_second));
-        m_policy_limiters.set(client_id, move(limiter));
-        return *m_policy_limiters.find(client_id)->value;
-    }
-    return *it->value;
+    return m_shards[u32_hash(static_cast<u32>(client_id)) % shard_count];
 }
 
-ErrorOr<void> ClientRateLimiter::check_scan_request(int client_id)
+ClientRateLimiter::Client& ClientRateLimiter::get_client(int client_id)
 {
-    Sync::MutexLocker locker(m_mutex);
+    auto& shard = shard_for(client_id);
+    Sync::MutexLocker locker(shard.mutex);
 
-    auto& limiter = get_scan_limiter(client_id);
+    return *shard.clients.ensure(client_id, [&] {
+        // Create new rate limiters for this client
+        return make<Client>(m_limits);
+    });
+}
 
-    if (!limiter.try_consume(1)) {
-        // Rate limit exceeded
-        m_rejected_counts.ensure(client_id) += 1;
-        m_total_rejected++;
+ClientRateLimiter::Client* ClientRateLimiter::find_client(int client_id) const
+{
+    auto& shard = shard_for(client_id);
+    Sync::MutexLocker locker(shard.mutex);
+
+    auto it = shard.clients.find(client_id);
+    if (it == shard.clients.end())
+        return nullptr;
+    return it->value.ptr();
+}
+
+void ClientRateLimiter::record_rejection(Client& client)
+{
+    client.rejected_count.fetch_add(1, AK::memory_order_relaxed);
+    m_total_rejected.fetch_add(1, AK::memory_order_relaxed);
+}
+
+ErrorOr<void> ClientRateLimiter::check_scan_request(int client_id)
+{
+    auto& client = get_client(client_id);
 
+    if (!client.scan_limiter.try_consume(1)) {
+        // Rate limit exceeded
+        record_rejection(client);
         return Error::from_string_literal("Rate limit exceeded for scan requests");
     }
 
@@ -62,15 +68,11 @@ ErrorOr<void> ClientRateLimiter::check_scan_request(int client_id)
 
 ErrorOr<void> ClientRateLimiter::check_policy_query(int client_id)
 {
-    Sync::MutexLocker locker(m_mutex);
-
-    auto& limiter = get_policy_limiter(client_id);
+    auto& client = get_client(client_id);
 
-    if (!limiter.try_consume(1)) {
+    if (!client.policy_limiter.try_consume(1)) {
         // Rate limit exceeded
-        m_rejected_counts.ensure(client_id) += 1;
-        m_total_rejected++;
-
+        record_rejection(client);
         return Error::from_string_literal("Rate limit exceeded for policy queries");
     }
 
@@ -79,79 +81,87 @@ ErrorOr<void> ClientRateLimiter::check_policy_query(int client_id)
 
 ErrorOr<void> ClientRateLimiter::check_concurrent_scans(int client_id)
 {
-    Sync::MutexLocker locker(m_mutex);
-
-    auto current_scans = m_concurrent_scans.get(client_id).value_or(0);
-
-    if (current_scans >= m_limits.max_concurrent_scans) {
-        // Concurrent scan limit exceeded
-        m_rejected_counts.ensure(client_id) += 1;
-        m_total_rejected++;
-
-        return Error::from_string_literal("Concurrent scan limit exceeded");
-    }
+    auto& client = get_client(client_id);
+
+    // Increment concurrent scan counter, unless the limit has been reached
+    auto current_scans = client.concurrent_scans.load(AK::memory_order_relaxed);
+    do {
+        if (current_scans >= m_limits.max_concurrent_scans) {
+            // Concurrent scan limit exceeded
+            record_rejection(client);
+            return Error::from_string_literal("Concurrent scan limit exceeded");
+        }
+    } while (!client.concurrent_scans.compare_exchange_strong(current_scans, current_scans + 1, AK::memory_order_acq_rel));
 
-    // Increment concurrent scan counter
-    m_concurrent_scans.set(client_id, current_scans + 1);
     return {};
 }
 
 void ClientRateLimiter::release_scan_slot(int client_id)
 {
-    Sync::MutexLocker locker(m_mutex);
+    auto* client = find_client(client_id);
+    if (!client)
+        return;
 
-    auto it = m_concurrent_scans.find(client_id);
-    if (it != m_concurrent_scans.end() && it->value > 0) {
-        it->value--;
-    }
+    auto current_scans = client->concurrent_scans.load(AK::memory_order_relaxed);
+    while (current_scans > 0 && !client->concurrent_scans.compare_exchange_strong(current_scans, current_scans - 1, AK::memory_order_acq_rel)) { }
 }
 
 size_t ClientRateLimiter::get_total_rejected() const
 {
-    Sync::MutexLocker locker(m_mutex);
-    return m_total_rejected;
+    return m_total_rejected.load(AK::memory_order_relaxed);
 }
 
 HashMap<int, size_t> ClientRateLimiter::get_per_client_rejected() const
 {
-    Sync::MutexLocker locker(m_mutex);
-    return m_rejected_counts;
+    HashMap<int, size_t> rejected_counts;
+    for (auto& shard : m_shards) {
+        Sync::MutexLocker locker(shard.mutex);
+        for (auto const& [client_id, client] : shard.clients) {
+            if (auto rejected_count = client->rejected_count.load(AK::memory_order_relaxed); rejected_count > 0)
+                rejected_counts.set(client_id, rejected_count);
+        }
+    }
+    return rejected_counts;
 }
 
 HashMap<int, size_t> ClientRateLimiter::get_concurrent_scans() const
 {
-    Sync::MutexLocker locker(m_mutex);
-    return m_concurrent_scans;
+    HashMap<int, size_t> concurrent_scans;
+    for (auto& shard : m_shards) {
+        Sync::MutexLocker locker(shard.mutex);
+        for (auto const& [client_id, client] : shard.clients) {
+            if (auto scans = client->concurrent_scans.load(AK::memory_order_relaxed); scans > 0)
+                concurrent_scans.set(client_id, scans);
+        }
+    }
+    return concurrent_scans;
 }
 
 void ClientRateLimiter::reset_telemetry()
 {
-    Sync::MutexLocker locker(m_mutex);
-    m_rejected_counts.clear();
-    m_total_rejected = 0;
+    for (auto& shard : m_shards) {
+        Sync::MutexLocker locker(shard.mutex);
+        for (auto& [client_id, client] : shard.clients)
+            client->rejected_count.store(0, AK::memory_order_relaxed);
+    }
+    m_total_rejected.store(0, AK::memory_order_relaxed);
 }
 
 void ClientRateLimiter::reset_client(int client_id)
 {
-    Sync::MutexLocker locker(m_mutex);
+    auto* client = find_client(client_id);
+    if (!client)
+        return;
 
-    // Reset scan rate limiter
-    auto scan_it = m_scan_limiters.find(client_id);
-    if (scan_it != m_scan_limiters.end()) {
-        scan_it->value->reset();
-    }
-
-    // Reset policy rate limiter
-    auto policy_it = m_policy_limiters.find(client_id);
-    if (policy_it != m_policy_limiters.end()) {
-        policy_it->value->reset();
-    }
+    // Reset rate limiters
+    client->scan_limiter.reset();
+    client->policy_limiter.reset();
 
     // Reset concurrent scans
-    m_concurrent_scans.remove(client_id);
+    client->concurrent_scans.store(0, AK::memory_order_relaxed);
 
     // Reset telemetry for this client
-    m_rejected_counts.remove(client_id);
+    client->rejected_count.store(0, AK::memory_order_relaxed);
 }
 
 }
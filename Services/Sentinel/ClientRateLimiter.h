@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
 #include <AK/Error.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
@@ -32,7 +34,8 @@ struct ClientLimits {
 
 // Per-client rate limiter using token bucket algorithm
 // Isolates rate limits between clients to prevent one client from starving others
-// Thread-safe for concurrent access
+// Thread-safe for concurrent access: clients are spread across shards with their own lock, which is only held to look
+// up a client, and the limits themselves are checked without taking any lock.
 class ClientRateLimiter {
 public:
     explicit ClientRateLimiter(ClientLimits limits = {});
@@ -73,27 +76,43 @@ public:
     void reset_client(int client_id);
 
 private:
-    // Get or create scan rate limiter for client
-    Core::TokenBucketRateLimiter& get_scan_limiter(int client_id);
+    struct Client {
+        explicit Client(ClientLimits const&);
 
-    // Get or create policy rate limiter for client
-    Core::TokenBucketRateLimiter& get_policy_limiter(int client_id);
+        Core::TokenBucketRateLimiter scan_limiter;
+        Core::TokenBucketRateLimiter policy_limiter;
 
-    ClientLimits m_limits;
+        // Concurrent scan tracking
+        Atomic<size_t> concurrent_scans { 0 };
+
+        // Telemetry: Rejected requests
+        Atomic<size_t> rejected_count { 0 };
+    };
+
+    struct Shard {
+        // NB: Clients are never removed, so a client stays valid after the lock is released.
+        HashMap<int, NonnullOwnPtr<Client>> clients;
+        mutable Sync::Mutex mutex;
+    };
+
+    static constexpr size_t shard_count = 16;
 
-    // Per-client rate limiters
-    HashMap<int, NonnullOwnPtr<Core::TokenBucketRateLimiter>> m_scan_limiters;
-    HashMap<int, NonnullOwnPtr<Core::TokenBucketRateLimiter>> m_policy_limiters;
+    Shard& shard_for(int client_id) const;
 
-    // Per-client concurrent scan tracking
-    HashMap<int, size_t> m_concurrent_scans;
+    // Get or create the state of a client
+    Client& get_client(int client_id);
+
+    // Get the state of a client, if it has made any requests
+    Client* find_client(int client_id) const;
+
+    void record_rejection(Client&);
+
+    ClientLimits m_limits;
 
-    // Telemetry: Total rejected requests per client
-    HashMap<int, size_t> m_rejected_counts;
-    size_t m_total_rejected { 0 };
+    mutable Array<Shard, shard_count> m_shards;
 
-    // Mutex for thread safety
-    mutable Sync::Mutex m_mutex;
+    // Telemetry: Total rejected requests
+    Atomic<size_t> m_total_rejected { 0 };
 };
 
 }
@@ -4,6 +4,7 @@
  */
 
 #include "DNSAnalyzer.h"
+#include <AK/Array.h>
 #include <AK/CharacterTypes.h>
 #include <AK/Math.h>
 #include <AK/StringBuilder.h>
@@ -53,43 +54,83 @@ Vector<StringView> const& DNSAnalyzer::popular_domain_list()
     return domains;
 }
 
+struct WeightedNGram {
+    StringView text;
+    float weight { 0.0f };
+};
+
 // Common English bigrams (two-character sequences) with normalized frequencies
 // Higher frequency = more common in legitimate domains
-HashMap<String, float> const& DNSAnalyzer::common_bigrams()
+static constexpr Array COMMON_BIGRAMS = {
+    WeightedNGram { "th"sv, 1.0f }, WeightedNGram { "he"sv, 0.98f }, WeightedNGram { "in"sv, 0.96f },
+    WeightedNGram { "er"sv, 0.94f }, WeightedNGram { "an"sv, 0.92f }, WeightedNGram { "re"sv, 0.90f },
+    WeightedNGram { "on"sv, 0.88f }, WeightedNGram { "at"sv, 0.86f }, WeightedNGram { "en"sv, 0.84f },
+    WeightedNGram { "nd"sv, 0.82f }, WeightedNGram { "ti"sv, 0.80f }, WeightedNGram { "es"sv, 0.78f },
+    WeightedNGram { "or"sv, 0.76f }, WeightedNGram { "te"sv, 0.74f }, WeightedNGram { "of"sv, 0.72f },
+    WeightedNGram { "ed"sv, 0.70f }, WeightedNGram { "is"sv, 0.68f }, WeightedNGram { "it"sv, 0.66f },
+    WeightedNGram { "al"sv, 0.64f }, WeightedNGram { "ar"sv, 0.62f }, WeightedNGram { "st"sv, 0.60f },
+    WeightedNGram { "to"sv, 0.58f }, WeightedNGram { "nt"sv, 0.56f }, WeightedNGram { "ng"sv, 0.54f },
+    WeightedNGram { "se"sv, 0.52f }, WeightedNGram { "ha"sv, 0.50f }, WeightedNGram { "as"sv, 0.48f },
+    WeightedNGram { "ou"sv, 0.46f }, WeightedNGram { "io"sv, 0.44f }, WeightedNGram { "le"sv, 0.42f },
+};
+
+// Common English trigrams (three-character sequences)
+static constexpr Array COMMON_TRIGRAMS = {
+    WeightedNGram { "the"sv, 1.0f }, WeightedNGram { "and"sv, 0.95f }, WeightedNGram { "ing"sv, 0.90f },
+    WeightedNGram { "ion"sv, 0.85f }, WeightedNGram { "tio"sv, 0.80f }, WeightedNGram { "ent"sv, 0.75f },
+    WeightedNGram { "ati"sv, 0.70f }, WeightedNGram { "for"sv, 0.65f }, WeightedNGram { "her"sv, 0.60f },
+    WeightedNGram { "ter"sv, 0.55f }, WeightedNGram { "hat"sv, 0.50f }, WeightedNGram { "tha"sv, 0.48f },
+    WeightedNGram { "ere"sv, 0.46f }, WeightedNGram { "ate"sv, 0.44f }, WeightedNGram { "his"sv, 0.42f },
+    WeightedNGram { "con"sv, 0.40f }, WeightedNGram { "res"sv, 0.38f }, WeightedNGram { "ver"sv, 0.36f },
+    WeightedNGram { "all"sv, 0.34f }, WeightedNGram { "ons"sv, 0.32f }, WeightedNGram { "nce"sv, 0.30f },
+    WeightedNGram { "men"sv, 0.28f }, WeightedNGram { "ith"sv, 0.26f }, WeightedNGram { "ted"sv, 0.24f },
+    WeightedNGram { "ers"sv, 0.22f }, WeightedNGram { "pro"sv, 0.20f }, WeightedNGram { "thi"sv, 0.18f },
+    WeightedNGram { "wit"sv, 0.16f }, WeightedNGram { "are"sv, 0.14f }, WeightedNGram { "ess"sv, 0.12f },
+};
+
+static constexpr size_t ALPHABET_SIZE = 26;
+
+static constexpr size_t ngram_code_count(size_t length)
 {
-    static HashMap<String, float> bigrams = {
-        { "th"_string, 1.0f }, { "he"_string, 0.98f }, { "in"_string, 0.96f },
-        { "er"_string, 0.94f }, { "an"_string, 0.92f }, { "re"_string, 0.90f },
-        { "on"_string, 0.88f }, { "at"_string, 0.86f }, { "en"_string, 0.84f },
-        { "nd"_string, 0.82f }, { "ti"_string, 0.80f }, { "es"_string, 0.78f },
-        { "or"_string, 0.76f }, { "te"_string, 0.74f }, { "of"_string, 0.72f },
-        { "ed"_string, 0.70f }, { "is"_string, 0.68f }, { "it"_string, 0.66f },
-        { "al"_string, 0.64f }, { "ar"_string, 0.62f }, { "st"_string, 0.60f },
-        { "to"_string, 0.58f }, { "nt"_string, 0.56f }, { "ng"_string, 0.54f },
-        { "se"_string, 0.52f }, { "ha"_string, 0.50f }, { "as"_string, 0.48f },
-        { "ou"_string, 0.46f }, { "io"_string, 0.44f }, { "le"_string, 0.42f },
-    };
-    return bigrams;
+    size_t count = 1;
+    for (size_t i = 0; i < length; ++i)
+        count *= ALPHABET_SIZE;
+    return count;
 }
 
-// Common English trigrams (three-character sequences)
-HashMap<String, float> const& DNSAnalyzer::common_trigrams()
+// Dense lookup over every lowercase n-gram, so scoring is an array index instead of a hash lookup.
+// Slots hold a small index into the weights, with 0 (weight 0.0) for n-grams that are not listed,
+// which keeps the trigram table to 17.5 KiB.
+template<size_t Length, size_t Count>
+struct NGramTable {
+    Array<u8, ngram_code_count(Length)> slots {};
+    Array<float, Count + 1> weights {};
+
+    constexpr float weight(size_t code) const { return weights[slots[code]]; }
+};
+
+template<size_t Length, size_t Count>
+static constexpr NGramTable<Length, Count> build_ngram_table(Array<WeightedNGram, Count> const& ngrams)
 {
-    static HashMap<String, float> trigrams = {
-        { "the"_string, 1.0f }, { "and"_string, 0.95f }, { "ing"_string, 0.90f },
-        { "ion"_string, 0.85f }, { "tio"_string, 0.80f }, { "ent"_string, 0.75f },
-        { "ati"_string, 0.70f }, { "for"_string, 0.65f }, { "her"_string, 0.60f },
-        { "ter"_string, 0.55f }, { "hat"_string, 0.50f }, { "tha"_string, 0.48f },
-        { "ere"_string, 0.46f }, { "ate"_string, 0.44f }, { "his"_string, 0.42f },
-        { "con"_string, 0.40f }, { "res"_string, 0.38f }, { "ver"_string, 0.36f },
-        { "all"_string, 0.34f }, { "ons"_string, 0.32f }, { "nce"_string, 0.30f },
-        { "men"_string, 0.28f }, { "ith"_string, 0.26f }, { "ted"_string, 0.24f },
-        { "ers"_string, 0.22f }, { "pro"_string, 0.20f }, { "thi"_string, 0.18f },
-        { "wit"_string, 0.16f }, { "are"_string, 0.14f }, { "ess"_string, 0.12f },
-    };
-    return trigrams;
+    static_assert(Count < 255);
+
+    NGramTable<Length, Count> table;
+    for (size_t i = 0; i < Count; ++i) {
+        VERIFY(ngrams[i].text.length() == Length);
+        size_t code = 0;
+        for (size_t j = 0; j < Length; ++j) {
+            VERIFY(is_ascii_lower_alpha(ngrams[i].text[j]));
+            code = code * ALPHABET_SIZE + static_cast<size_t>(ngrams[i].text[j] - 'a');
+        }
+        table.slots[code] = static_cast<u8>(i + 1);
+        table.weights[i + 1] = ngrams[i].weight;
+    }
+    return table;
 }
 
+static constexpr auto BIGRAM_TABLE = build_ngram_table<2>(COMMON_BIGRAMS);
+static constexpr auto TRIGRAM_TABLE = build_ngram_table<3>(COMMON_TRIGRAMS);
+
 ErrorOr<NonnullOwnPtr<DNSAnalyzer>> DNSAnalyzer::create()
 {
     return adopt_own(*new DNSAnalyzer());
@@ -158,45 +199,32 @@ float DNSAnalyzer::calculate_ngram_score(StringView domain)
     if (domain.length() < 2)
         return 0.0f;
 
-    // Extract alphabetic characters only (ignore dots, numbers)
-    StringBuilder alpha_only;
-    for (auto ch : domain.bytes()) {
-        if (is_ascii_alpha(ch))
-            alpha_only.append(to_ascii_lowercase(ch));
-    }
-
-    auto alpha_domain = MUST(alpha_only.to_string());
-    if (alpha_domain.bytes_as_string_view().length() < 2)
-        return 0.0f;
-
-    auto const& bigrams = common_bigrams();
-    auto const& trigrams = common_trigrams();
-
     float bigram_score = 0.0f;
-    u32 bigram_count = 0;
-
     float trigram_score = 0.0f;
-    u32 trigram_count = 0;
 
-    // Analyze bigrams
-    for (size_t i = 0; i < alpha_domain.bytes_as_string_view().length() - 1; i++) {
-        auto bigram = MUST(String::from_utf8(alpha_domain.bytes_as_string_view().substring_view(i, 2)));
+    // Only alphabetic characters count (dots and numbers are skipped), so n-grams are formed over
+    // the letters as if the rest had been removed. The last two letters are kept as a rolling code.
+    size_t letter_count = 0;
+    size_t previous_letters = 0;
+    for (auto ch : domain.bytes()) {
+        if (!is_ascii_alpha(ch))
+            continue;
 
-        if (bigrams.contains(bigram)) {
-            bigram_score += bigrams.get(bigram).value();
-        }
-        bigram_count++;
+        auto letter = static_cast<size_t>(to_ascii_lowercase(ch) - 'a');
+        if (letter_count >= 1)
+            bigram_score += BIGRAM_TABLE.weight((previous_letters % ALPHABET_SIZE) * ALPHABET_SIZE + letter);
+        if (letter_count >= 2)
+            trigram_score += TRIGRAM_TABLE.weight(previous_letters * ALPHABET_SIZE + letter);
+
+        previous_letters = (previous_letters % ALPHABET_SIZE) * ALPHABET_SIZE + letter;
+        letter_count++;
     }
 
-    // Analyze trigrams
-    for (size_t i = 0; i < alpha_domain.bytes_as_string_view().length() - 2; i++) {
-        auto trigram = MUST(String::from_utf8(alpha_domain.bytes_as_string_view().substring_view(i, 3)));
+    if (letter_count < 2)
+        return 0.0f;
 
-        if (trigrams.contains(trigram)) {
-            trigram_score += trigrams.get(trigram).value();
-        }
-        trigram_count++;
-    }
+    auto bigram_count = static_cast<u32>(letter_count - 1);
+    auto trigram_count = static_cast<u32>(letter_count - 2);
 
     // Calculate average n-gram frequency
     float avg_frequency = 0.0f;
@@ -290,22 +318,12 @@ u32 DNSAnalyzer::calculate_subdomain_depth(StringView domain)
     return depth > 0 ? depth : 0;
 }
 
-// Main DGA analysis method
-ErrorOr<DNSAnalyzer::DGAAnalysis> DNSAnalyzer::analyze_dga(StringView full_domain)
+// Score a domain that is neither empty nor whitelisted. Indicator descriptions are only formatted
+// when asked for, so batches stay off the heap.
+DNSAnalyzer::DGAAnalysis DNSAnalyzer::score_dga(StringView full_domain, Vector<String>* indicators)
 {
     DGAAnalysis result;
 
-    if (full_domain.is_empty()) {
-        result.explanation = "Empty domain"_string;
-        return result;
-    }
-
-    // Quick check: whitelist popular domains
-    if (is_popular_domain(full_domain)) {
-        result.explanation = "Whitelisted popular domain"_string;
-        return result;
-    }
-
     // Extract domain name without TLD (e.g., "example.com" -> "example")
     auto last_dot = full_domain.find_last('.');
     StringView domain_name = last_dot.has_value()
@@ -324,44 +342,49 @@ ErrorOr<DNSAnalyzer::DGAAnalysis> DNSAnalyzer::analyze_dga(StringView full_domai
     result.consonant_ratio = calculate_consonant_ratio(domain_name);
     result.ngram_score = calculate_ngram_score(domain_name);
 
-    Vector<String> indicators;
-
     // Scoring system: accumulate evidence
     float dga_score = 0.0f;
 
     // High entropy (weight: 35%)
     if (result.entropy > VERY_HIGH_ENTROPY_THRESHOLD) {
         dga_score += 0.35f;
-        indicators.append(MUST(String::formatted("Very high entropy ({:.2f})", result.entropy)));
+        if (indicators)
+            indicators->append(MUST(String::formatted("Very high entropy ({:.2f})", result.entropy)));
     } else if (result.entropy > HIGH_ENTROPY_THRESHOLD) {
         dga_score += 0.20f;
-        indicators.append(MUST(String::formatted("High entropy ({:.2f})", result.entropy)));
+        if (indicators)
+            indicators->append(MUST(String::formatted("High entropy ({:.2f})", result.entropy)));
     }
 
     // Abnormal consonant ratio (weight: 25%)
     if (result.consonant_ratio > HIGH_CONSONANT_RATIO_THRESHOLD) {
         dga_score += 0.25f;
-        indicators.append(MUST(String::formatted("Excessive consonants ({:.0f}%)",
-            result.consonant_ratio * 100.0f)));
+        if (indicators)
+            indicators->append(MUST(String::formatted("Excessive consonants ({:.0f}%)",
+                result.consonant_ratio * 100.0f)));
     } else if (result.consonant_ratio < NORMAL_CONSONANT_RATIO_MIN) {
         dga_score += 0.15f;
-        indicators.append(MUST(String::formatted("Too many vowels ({:.0f}% consonants)",
-            result.consonant_ratio * 100.0f)));
+        if (indicators)
+            indicators->append(MUST(String::formatted("Too many vowels ({:.0f}% consonants)",
+                result.consonant_ratio * 100.0f)));
     }
 
     // Unusual n-gram patterns (weight: 30%)
     if (result.ngram_score > 0.7f) {
         dga_score += 0.30f;
-        indicators.append("Unusual character patterns"_string);
+        if (indicators)
+            indicators->append("Unusual character patterns"_string);
     } else if (result.ngram_score > 0.5f) {
         dga_score += 0.15f;
-        indicators.append("Uncommon character patterns"_string);
+        if (indicators)
+            indicators->append("Uncommon character patterns"_string);
     }
 
     // Domain length analysis (weight: 10%)
     if (domain_name.length() > 20) {
         dga_score += 0.10f;
-        indicators.append(MUST(String::formatted("Unusually long domain ({} chars)", domain_name.length())));
+        if (indicators)
+            indicators->append(MUST(String::formatted("Unusually long domain ({} chars)", domain_name.length())));
     }
 
     // Cap score at 1.0
@@ -373,6 +396,28 @@ ErrorOr<DNSAnalyzer::DGAAnalysis> DNSAnalyzer::analyze_dga(StringView full_domai
     // Confidence based on strength of indicators
     result.confidence = AK::min(dga_score * 1.2f, 1.0f);
 
+    return result;
+}
+
+// Main DGA analysis method
+ErrorOr<DNSAnalyzer::DGAAnalysis> DNSAnalyzer::analyze_dga(StringView full_domain)
+{
+    DGAAnalysis result;
+
+    if (full_domain.is_empty()) {
+        result.explanation = "Empty domain"_string;
+        return result;
+    }
+
+    // Quick check: whitelist popular domains
+    if (is_popular_domain(full_domain)) {
+        result.explanation = "Whitelisted popular domain"_string;
+        return result;
+    }
+
+    Vector<String> indicators;
+    result = score_dga(full_domain, &indicators);
+
     // Generate explanation
     if (indicators.is_empty()) {
         result.explanation = "No DGA indicators detected - appears legitimate"_string;
@@ -396,6 +441,19 @@ ErrorOr<DNSAnalyzer::DGAAnalysis> DNSAnalyzer::analyze_dga(StringView full_domai
     return result;
 }
 
+// Batch DGA analysis: same scores as analyze_dga(), without the explanation
+void DNSAnalyzer::analyze_dga(ReadonlySpan<StringView> domains, Span<DGAAnalysis> results) const
+{
+    VERIFY(results.size() == domains.size());
+
+    for (size_t i = 0; i < domains.size(); i++) {
+        if (domains[i].is_empty() || is_popular_domain(domains[i]))
+            results[i] = {};
+        else
+            results[i] = score_dga(domains[i], nullptr);
+    }
+}
+
 // DNS tunneling analysis
 ErrorOr<DNSAnalyzer::DNSTunnelingAnalysis> DNSAnalyzer::analyze_tunneling(
     StringView domain, u32 query_count_per_minute)
@@ -6,8 +6,8 @@
 #pragma once
 
 #include <AK/Error.h>
-#include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Span.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 
@@ -43,6 +43,11 @@ public:
     // Analyze a domain for DGA characteristics
     ErrorOr<DGAAnalysis> analyze_dga(StringView domain);
 
+    // Analyze a burst of domains at once, writing one result per domain. Results carry every score
+    // but no explanation, which keeps the batch allocation-free; explain a flagged domain with the
+    // single-domain overload.
+    void analyze_dga(ReadonlySpan<StringView> domains, Span<DGAAnalysis> results) const;
+
     // Analyze for DNS tunneling (requires query frequency)
     ErrorOr<DNSTunnelingAnalysis> analyze_tunneling(StringView domain, u32 query_count_per_minute);
 
@@ -57,9 +62,8 @@ public:
 private:
     DNSAnalyzer() = default;
 
-    // Common English bigrams and trigrams for n-gram analysis
-    static HashMap<String, float> const& common_bigrams();
-    static HashMap<String, float> const& common_trigrams();
+    // DGA scoring shared by both analyze_dga() overloads; indicators may be null
+    static DGAAnalysis score_dga(StringView full_domain, Vector<String>* indicators);
 
     // Popular domains whitelist (top 100 domains to reduce false positives)
     static Vector<StringView> const& popular_domain_list();
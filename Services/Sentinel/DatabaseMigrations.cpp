@@ -457,6 +457,21 @@ ErrorOr<void> DatabaseMigrations::migrate_v7_to_v8(Database::Database& db)
     return {};
 }
 
+ErrorOr<void> DatabaseMigrations::migrate_v8_to_v9(Database::Database& db)
+{
+    dbgln("DatabaseMigrations: Migrating from v8 to v9 (adding verdict rule-set version)");
+
+    // RequestServer's verdict cache keeps its entries in sandbox_verdicts as a cold tier; the YARA
+    // rule-set version lets it ignore verdicts reached before the rules changed
+    auto add_rules_version = TRY(db.prepare_statement(
+        "ALTER TABLE sandbox_verdicts ADD COLUMN rules_version INTEGER DEFAULT 0;"_string));
+    db.execute_statement(add_rules_version, {});
+    dbgln("DatabaseMigrations: Added rules_version column");
+
+    dbgln("DatabaseMigrations: v8 to v9 migration complete - added verdict rule-set version");
+    return {};
+}
+
 ErrorOr<void> DatabaseMigrations::migrate(Database::Database& db)
 {
     auto current_version = TRY(get_schema_version(db));
@@ -513,6 +528,11 @@ ErrorOr<void> DatabaseMigrations::migrate(Database::Database& db)
         TRY(set_schema_version(db, 8));
     }
 
+    if (current_version < 9) {
+        TRY(migrate_v8_to_v9(db));
+        TRY(set_schema_version(db, 9));
+    }
+
     dbgln("DatabaseMigrations: Migration complete");
     return {};
 }
@@ -15,9 +15,17 @@ ErrorOr<NonnullOwnPtr<FingerprintingDetector>> FingerprintingDetector::create()
     return adopt_own(*new FingerprintingDetector());
 }
 
-void FingerprintingDetector::record_api_call(FingerprintingTechnique technique, StringView api_name, bool had_user_interaction)
+void FingerprintingDetector::record_api_call(FingerprintingTechnique technique, StringView, bool had_user_interaction)
 {
-    auto now = UnixDateTime::now();
+    auto now = MonotonicTime::now_coarse();
+
+    // Decay the recent call count by the time since the previous call, so a burst shows up without keeping timestamps
+    if (m_last_call_time.has_value()) {
+        auto elapsed_seconds = static_cast<double>((now - m_last_call_time.value()).to_microseconds()) / 1'000'000.0;
+        m_recent_calls *= static_cast<float>(AK::exp(-elapsed_seconds / BurstWindowSeconds));
+    }
+    m_recent_calls += 1.0f;
+    m_peak_recent_calls = AK::max(m_peak_recent_calls, m_recent_calls);
 
     // Track first and last call times
     if (!m_first_call_time.has_value())
@@ -28,18 +36,8 @@ void FingerprintingDetector::record_api_call(FingerprintingTechnique technique,
     if (had_user_interaction)
         m_has_user_interaction = true;
 
-    // Record the API call
-    APICallEvent event;
-    event.technique = technique;
-    event.api_name = MUST(String::from_utf8(api_name));
-    event.timestamp = now;
-    event.had_user_interaction = had_user_interaction;
-
-    // Add to technique-specific tracking
-    if (!m_api_calls.contains(technique))
-        m_api_calls.set(technique, Vector<APICallEvent>());
-
-    m_api_calls.get(technique).value().append(move(event));
+    ++m_call_counts[to_underlying(technique)];
+    ++m_total_calls;
 }
 
 FingerprintingDetector::FingerprintingScore FingerprintingDetector::calculate_score() const
@@ -48,9 +46,7 @@ FingerprintingDetector::FingerprintingScore FingerprintingDetector::calculate_sc
 
     // Count techniques and calls
     score.techniques_used = count_unique_techniques();
-    score.total_api_calls = 0;
-    for (auto const& [technique, calls] : m_api_calls)
-        score.total_api_calls += calls.size();
+    score.total_api_calls = m_total_calls;
 
     if (score.total_api_calls == 0) {
         score.explanation = "No fingerprinting activity detected"_string;
@@ -76,44 +72,12 @@ FingerprintingDetector::FingerprintingScore FingerprintingDetector::calculate_sc
     score.screen_calls = count_calls_for_technique(FingerprintingTechnique::ScreenProperties);
 
     // Rapid fire detection (multiple API calls in short time)
-    score.rapid_fire_detected = (score.total_api_calls >= RapidFireThreshold && score.time_window_seconds < 1.0);
+    score.rapid_fire_detected = is_rapid_fire();
 
     // No user interaction detection
     score.no_user_interaction = !m_has_user_interaction;
 
-    // Calculate individual technique scores (0.0-1.0 each)
-    float canvas_score = calculate_canvas_score();
-    float webgl_score = calculate_webgl_score();
-    float audio_score = calculate_audio_score();
-    float navigator_score = calculate_navigator_score();
-    float font_score = calculate_font_score();
-    float screen_score = calculate_screen_score();
-
-    // Weighted scoring system
-    // Base score: Average of active techniques
-    float base_score = 0.0f;
-    if (score.techniques_used > 0) {
-        base_score = (canvas_score + webgl_score + audio_score + navigator_score + font_score + screen_score)
-            / static_cast<float>(score.techniques_used);
-    }
-
-    // Multipliers for suspicious patterns
-    float multiplier = 1.0f;
-
-    // Using 3+ different techniques is highly suspicious (1.5x multiplier)
-    if (score.techniques_used >= 3)
-        multiplier *= 1.5f;
-
-    // Rapid fire calls suggest automated fingerprinting (1.3x multiplier)
-    if (score.rapid_fire_detected)
-        multiplier *= 1.3f;
-
-    // No user interaction before fingerprinting (1.2x multiplier)
-    if (score.no_user_interaction && score.total_api_calls > 5)
-        multiplier *= 1.2f;
-
-    // Calculate final aggressiveness score
-    score.aggressiveness_score = AK::min(base_score * multiplier, 1.0f);
+    score.aggressiveness_score = calculate_aggressiveness_score();
 
     // Confidence based on number of data points
     score.confidence = AK::min(static_cast<float>(score.total_api_calls) / 20.0f, 1.0f);
@@ -131,7 +95,7 @@ FingerprintingDetector::FingerprintingScore FingerprintingDetector::calculate_sc
     if (score.uses_fonts && score.font_calls >= FontThreshold)
         reasons.append(MUST(String::formatted("Font enumeration ({} fonts)", score.font_calls)));
     if (score.rapid_fire_detected)
-        reasons.append(MUST(String::formatted("Rapid-fire API calls ({} in {:.2f}s)", score.total_api_calls, score.time_window_seconds)));
+        reasons.append(MUST(String::formatted("Rapid-fire API calls ({:.0f} within {:.0f}s)", m_peak_recent_calls, BurstWindowSeconds)));
     if (score.no_user_interaction)
         reasons.append("No user interaction before fingerprinting"_string);
 
@@ -152,7 +116,10 @@ FingerprintingDetector::FingerprintingScore FingerprintingDetector::calculate_sc
 
 void FingerprintingDetector::reset()
 {
-    m_api_calls.clear();
+    m_call_counts.fill(0);
+    m_total_calls = 0;
+    m_recent_calls = 0.0f;
+    m_peak_recent_calls = 0.0f;
     m_first_call_time = {};
     m_last_call_time = {};
     m_has_user_interaction = false;
@@ -160,10 +127,46 @@ void FingerprintingDetector::reset()
 
 bool FingerprintingDetector::is_aggressive_fingerprinting() const
 {
-    auto score = calculate_score();
     // Threshold of 0.75 to avoid false positives on single canvas calls
     // Single call = 0.7, so this requires multiple calls or other indicators
-    return score.aggressiveness_score > 0.75f;
+    return calculate_aggressiveness_score() > 0.75f;
+}
+
+float FingerprintingDetector::calculate_aggressiveness_score() const
+{
+    auto techniques_used = count_unique_techniques();
+    if (techniques_used == 0)
+        return 0.0f;
+
+    // Calculate individual technique scores (0.0-1.0 each)
+    float canvas_score = calculate_canvas_score();
+    float webgl_score = calculate_webgl_score();
+    float audio_score = calculate_audio_score();
+    float navigator_score = calculate_navigator_score();
+    float font_score = calculate_font_score();
+    float screen_score = calculate_screen_score();
+
+    // Weighted scoring system
+    // Base score: Average of active techniques
+    float base_score = (canvas_score + webgl_score + audio_score + navigator_score + font_score + screen_score)
+        / static_cast<float>(techniques_used);
+
+    // Multipliers for suspicious patterns
+    float multiplier = 1.0f;
+
+    // Using 3+ different techniques is highly suspicious (1.5x multiplier)
+    if (techniques_used >= 3)
+        multiplier *= 1.5f;
+
+    // Rapid fire calls suggest automated fingerprinting (1.3x multiplier)
+    if (is_rapid_fire())
+        multiplier *= 1.3f;
+
+    // No user interaction before fingerprinting (1.2x multiplier)
+    if (!m_has_user_interaction && m_total_calls > 5)
+        multiplier *= 1.2f;
+
+    return AK::min(base_score * multiplier, 1.0f);
 }
 
 float FingerprintingDetector::calculate_canvas_score() const
@@ -246,23 +249,11 @@ float FingerprintingDetector::calculate_screen_score() const
     return AK::min(static_cast<float>(calls) * 0.1f, 0.3f);
 }
 
-size_t FingerprintingDetector::count_calls_for_technique(FingerprintingTechnique technique) const
-{
-    if (!m_api_calls.contains(technique))
-        return 0;
-    return m_api_calls.get(technique).value().size();
-}
-
-bool FingerprintingDetector::has_technique(FingerprintingTechnique technique) const
-{
-    return m_api_calls.contains(technique) && !m_api_calls.get(technique).value().is_empty();
-}
-
 size_t FingerprintingDetector::count_unique_techniques() const
 {
     size_t count = 0;
-    for (auto const& [technique, calls] : m_api_calls) {
-        if (!calls.is_empty())
+    for (auto calls : m_call_counts) {
+        if (calls > 0)
             count++;
     }
     return count;
@@ -273,8 +264,8 @@ double FingerprintingDetector::get_time_window_seconds() const
     if (!m_first_call_time.has_value() || !m_last_call_time.has_value())
         return 0.0;
 
-    auto duration = m_last_call_time.value().seconds_since_epoch() - m_first_call_time.value().seconds_since_epoch();
-    return static_cast<double>(duration);
+    auto duration = m_last_call_time.value() - m_first_call_time.value();
+    return static_cast<double>(duration.to_microseconds()) / 1'000'000.0;
 }
 
 }
@@ -6,8 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
 #include <AK/Error.h>
-#include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/String.h>
 #include <AK/Time.h>
@@ -26,14 +26,7 @@ public:
         FontEnumeration,  // Font list probing
         ScreenProperties  // Screen resolution, color depth
     };
-
-    struct APICallEvent {
-        FingerprintingTechnique technique;
-        String api_name;
-        UnixDateTime timestamp;
-        bool had_user_interaction { false };
-        size_t call_count { 1 };
-    };
+    static constexpr size_t technique_count = 6;
 
     struct FingerprintingScore {
         float aggressiveness_score { 0.0f }; // 0.0-1.0 (0 = benign, 1 = aggressive fingerprinting)
@@ -69,6 +62,8 @@ public:
     ~FingerprintingDetector() = default;
 
     // Record an API call that may be part of fingerprinting
+    // OPTIMIZATION: This sits in hot canvas and WebGL paths, so it only bumps fixed-size counters: no per-call
+    //               history is kept and nothing is allocated, so api_name is not stored.
     void record_api_call(FingerprintingTechnique technique, StringView api_name, bool had_user_interaction = false);
 
     // Calculate fingerprinting score based on recorded calls
@@ -77,18 +72,24 @@ public:
     // Reset tracking (e.g., on navigation)
     void reset();
 
-    // Quick check - returns true if aggressiveness score > 0.6
+    // Quick check - returns true if aggressiveness score > 0.75
+    // Cheap enough to call after every recorded call; unlike calculate_score(), it builds no explanation
     bool is_aggressive_fingerprinting() const;
 
 private:
     FingerprintingDetector() = default;
 
-    // Track API calls per technique
-    HashMap<FingerprintingTechnique, Vector<APICallEvent>> m_api_calls;
+    // Calls recorded per technique, indexed by FingerprintingTechnique
+    Array<u32, technique_count> m_call_counts {};
+    u32 m_total_calls { 0 };
+
+    // Calls in roughly the last BurstWindowSeconds, decayed exponentially on every call, and the most seen at once
+    float m_recent_calls { 0.0f };
+    float m_peak_recent_calls { 0.0f };
 
     // Timestamps for timing analysis
-    Optional<UnixDateTime> m_first_call_time;
-    Optional<UnixDateTime> m_last_call_time;
+    Optional<MonotonicTime> m_first_call_time;
+    Optional<MonotonicTime> m_last_call_time;
 
     // User interaction tracking
     bool m_has_user_interaction { false };
@@ -97,7 +98,7 @@ private:
     static constexpr size_t RapidFireThreshold = 5;      // 5+ API calls in 1 second
     static constexpr size_t NavigatorThreshold = 10;     // 10+ navigator accesses
     static constexpr size_t FontThreshold = 20;          // 20+ font checks
-    static constexpr double TimeWindowSeconds = 5.0;     // Consider calls within 5 seconds
+    static constexpr double BurstWindowSeconds = 1.0;    // Time constant of the recent call decay
 
     // Calculate individual technique scores
     float calculate_canvas_score() const;
@@ -107,10 +108,13 @@ private:
     float calculate_font_score() const;
     float calculate_screen_score() const;
 
+    float calculate_aggressiveness_score() const;
+
     // Helper methods
-    size_t count_calls_for_technique(FingerprintingTechnique technique) const;
-    bool has_technique(FingerprintingTechnique technique) const;
+    size_t count_calls_for_technique(FingerprintingTechnique technique) const { return m_call_counts[to_underlying(technique)]; }
+    bool has_technique(FingerprintingTechnique technique) const { return count_calls_for_technique(technique) > 0; }
     size_t count_unique_techniques() const;
+    bool is_rapid_fire() const { return m_peak_recent_calls >= static_cast<float>(RapidFireThreshold); }
     double get_time_window_seconds() const;
 };
 
@@ -10,11 +10,74 @@
 
 namespace Sentinel {
 
+// Packed into one word per service so a query is a single load. The record bit tells a healthy service that has a
+// record (and so a fallback strategy) apart from one that was never reported on.
+static constexpr u32 service_record_bit = 1u << 8;
+static constexpr u32 service_state_shift = 4;
+static constexpr u32 fallback_strategy_mask = 0xf;
+
+static u32 encode_service_status(GracefulDegradation::ServiceState state, GracefulDegradation::FallbackStrategy strategy)
+{
+    return service_record_bit | (static_cast<u32>(state) << service_state_shift) | static_cast<u32>(strategy);
+}
+
+static GracefulDegradation::ServiceState decode_service_state(u32 status)
+{
+    if (!(status & service_record_bit))
+        return GracefulDegradation::ServiceState::Healthy;
+    return static_cast<GracefulDegradation::ServiceState>((status >> service_state_shift) & 0xf);
+}
+
 GracefulDegradation::GracefulDegradation()
 {
+    Sync::MutexLocker locker(m_mutex);
+    for (auto name : { Services::PolicyGraph, Services::YARAScanner, Services::IPCServer, Services::Database,
+             Services::Quarantine, Services::SecurityTap, Services::NetworkLayer })
+        intern_service_locked(name);
+    VERIFY(m_service_count.load() == ServiceIDs::NetworkLayer + 1u);
+
     dbgln("GracefulDegradation: Initialized");
 }
 
+GracefulDegradation::ServiceID GracefulDegradation::intern_service(StringView service_name)
+{
+    if (auto id = find_service(service_name); id.has_value())
+        return *id;
+
+    Sync::MutexLocker locker(m_mutex);
+    return intern_service_locked(service_name);
+}
+
+GracefulDegradation::ServiceID GracefulDegradation::intern_service_locked(StringView service_name)
+{
+    if (auto id = find_service(service_name); id.has_value())
+        return *id;
+
+    // Services are a small fixed set in practice, so running out of IDs is a bug in the caller.
+    auto count = m_service_count.load(AK::MemoryOrder::memory_order_relaxed);
+    VERIFY(count < max_services);
+    m_service_names[count] = MUST(String::from_utf8(service_name));
+    m_service_count.store(count + 1, AK::MemoryOrder::memory_order_release);
+    return static_cast<ServiceID>(count);
+}
+
+Optional<GracefulDegradation::ServiceID> GracefulDegradation::find_service(StringView service_name) const
+{
+    auto count = m_service_count.load(AK::MemoryOrder::memory_order_acquire);
+    for (size_t id = 0; id < count; ++id) {
+        if (m_service_names[id] == service_name)
+            return static_cast<ServiceID>(id);
+    }
+    return {};
+}
+
+u64 GracefulDegradation::publish_service_state(ServiceID id, ServiceState state, FallbackStrategy strategy)
+{
+    // Note: Caller must hold mutex
+    m_service_status[id].store(encode_service_status(state, strategy), AK::MemoryOrder::memory_order_release);
+    return m_state_epoch.fetch_add(1, AK::MemoryOrder::memory_order_release) + 1;
+}
+
 void GracefulDegradation::set_service_state(
     String service_name,
     ServiceState state,
@@ -23,6 +86,7 @@ void GracefulDegradation::set_service_state(
 {
     Sync::MutexLocker locker(m_mutex);
 
+    auto id = intern_service_locked(service_name);
     auto now = UnixDateTime::now();
     auto old_state = ServiceState::Healthy;
 
@@ -92,6 +156,9 @@ void GracefulDegradation::set_service_state(
     // Update metrics
     update_metrics(old_state, state);
 
+    auto epoch = publish_service_state(id, state, fallback);
+    locker.unlock();
+
     // Notify callbacks if state changed
     if (old_state != state) {
         DegradationEvent event {
@@ -99,7 +166,8 @@ void GracefulDegradation::set_service_state(
             .old_state = old_state,
             .new_state = state,
             .reason = reason,
-            .timestamp = now
+            .timestamp = now,
+            .epoch = epoch
         };
         notify_degradation_event(event);
     }
@@ -107,18 +175,19 @@ void GracefulDegradation::set_service_state(
 
 GracefulDegradation::ServiceState GracefulDegradation::get_service_state(String const& service_name) const
 {
-    Sync::MutexLocker locker(m_mutex);
-
-    auto it = m_service_failures.find(service_name);
-    if (it == m_service_failures.end())
+    auto id = find_service(service_name);
+    if (!id.has_value())
         return ServiceState::Healthy;
+    return get_service_state(*id);
+}
 
-    return it->value.state;
+GracefulDegradation::ServiceState GracefulDegradation::get_service_state(ServiceID id) const
+{
+    return fallback_decision(id).state;
 }
 
 GracefulDegradation::DegradationLevel GracefulDegradation::get_system_degradation_level() const
 {
-    Sync::MutexLocker locker(m_mutex);
     return calculate_system_level();
 }
 
@@ -163,25 +232,45 @@ Vector<GracefulDegradation::ServiceFailure> GracefulDegradation::get_all_service
 
 bool GracefulDegradation::should_use_fallback(String const& service_name) const
 {
-    Sync::MutexLocker locker(m_mutex);
-
-    auto it = m_service_failures.find(service_name);
-    if (it == m_service_failures.end())
-        return false;
+    return fallback_decision(service_name).use_fallback;
+}
 
-    // Use fallback if service is degraded, failed, or critical
-    return it->value.state != ServiceState::Healthy;
+bool GracefulDegradation::should_use_fallback(ServiceID id) const
+{
+    return fallback_decision(id).use_fallback;
 }
 
 Optional<GracefulDegradation::FallbackStrategy> GracefulDegradation::get_fallback_strategy(String const& service_name) const
 {
-    Sync::MutexLocker locker(m_mutex);
+    return fallback_decision(service_name).strategy;
+}
 
-    auto it = m_service_failures.find(service_name);
-    if (it == m_service_failures.end())
+Optional<GracefulDegradation::FallbackStrategy> GracefulDegradation::get_fallback_strategy(ServiceID id) const
+{
+    return fallback_decision(id).strategy;
+}
+
+GracefulDegradation::FallbackDecision GracefulDegradation::fallback_decision(StringView service_name) const
+{
+    auto id = find_service(service_name);
+    if (!id.has_value())
+        return {};
+    return fallback_decision(*id);
+}
+
+GracefulDegradation::FallbackDecision GracefulDegradation::fallback_decision(ServiceID id) const
+{
+    auto status = m_service_status[id].load(AK::MemoryOrder::memory_order_acquire);
+    if (!(status & service_record_bit))
         return {};
 
-    return it->value.fallback_strategy;
+    auto state = decode_service_state(status);
+    return FallbackDecision {
+        .state = state,
+        // Use fallback if service is degraded, failed, or critical
+        .use_fallback = state != ServiceState::Healthy,
+        .strategy = static_cast<FallbackStrategy>(status & fallback_strategy_mask),
+    };
 }
 
 Optional<String> GracefulDegradation::get_fallback_reason(String const& service_name) const
@@ -227,6 +316,7 @@ void GracefulDegradation::attempt_recovery(String const& service_name)
         dbgln("GracefulDegradation: Service '{}' exceeded recovery attempt limit, marking as critical",
             service_name);
         failure.state = ServiceState::Critical;
+        publish_service_state(intern_service_locked(service_name), failure.state, failure.fallback_strategy);
     }
 }
 
@@ -267,6 +357,7 @@ void GracefulDegradation::enable_auto_recovery(String service_name, bool enabled
             .auto_recovery_enabled = enabled
         };
         m_service_failures.set(service_name, failure);
+        publish_service_state(intern_service_locked(service_name), failure.state, failure.fallback_strategy);
     }
 }
 
@@ -283,14 +374,14 @@ bool GracefulDegradation::is_auto_recovery_enabled(String const& service_name) c
 
 void GracefulDegradation::register_degradation_callback(DegradationCallback callback)
 {
-    Sync::MutexLocker locker(m_mutex);
+    Sync::MutexLocker locker(m_callback_mutex);
     m_callbacks.append(move(callback));
     dbgln("GracefulDegradation: Registered degradation callback (total: {})", m_callbacks.size());
 }
 
 void GracefulDegradation::clear_degradation_callbacks()
 {
-    Sync::MutexLocker locker(m_mutex);
+    Sync::MutexLocker locker(m_callback_mutex);
     m_callbacks.clear();
     dbgln("GracefulDegradation: Cleared all degradation callbacks");
 }
@@ -382,7 +473,8 @@ GracefulDegradation::HealthStatus GracefulDegradation::get_health_status() const
 
 void GracefulDegradation::notify_degradation_event(DegradationEvent const& event)
 {
-    // Note: Caller must hold mutex
+    // Note: Caller must not hold mutex, so callbacks can query state
+    Sync::MutexLocker locker(m_callback_mutex);
     dbgln("GracefulDegradation: Notifying {} callbacks about service '{}' state change",
         m_callbacks.size(), event.service_name);
 
@@ -393,14 +485,13 @@ void GracefulDegradation::notify_degradation_event(DegradationEvent const& event
 
 GracefulDegradation::DegradationLevel GracefulDegradation::calculate_system_level() const
 {
-    // Note: Caller must hold mutex
-
     bool has_critical = false;
     bool has_failed = false;
     bool has_degraded = false;
 
-    for (auto const& [_, failure] : m_service_failures) {
-        switch (failure.state) {
+    auto count = m_service_count.load(AK::MemoryOrder::memory_order_acquire);
+    for (size_t id = 0; id < count; ++id) {
+        switch (decode_service_state(m_service_status[id].load(AK::MemoryOrder::memory_order_acquire))) {
         case ServiceState::Critical:
             has_critical = true;
             break;
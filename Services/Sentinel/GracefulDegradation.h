@@ -6,6 +6,8 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
 #include <AK/Error.h>
 #include <AK/HashMap.h>
 #include <AK/Optional.h>
@@ -21,6 +23,10 @@ using AK::Duration;
 // Graceful degradation manager for Sentinel service failures
 // Handles fallback behavior when critical services become unavailable
 // Thread-safe for concurrent access from multiple components
+//
+// Service state is written rarely but read on every scan, so each service is interned to a small ID whose state and
+// fallback strategy live in one atomic. Queries by ID are a single acquire load and never take the mutex; queries by
+// name only add a lock-free scan of the interned names.
 class GracefulDegradation {
 public:
     // Service degradation levels
@@ -68,6 +74,20 @@ public:
         ServiceState new_state;
         String reason;
         UnixDateTime timestamp;
+        // state_epoch() right after this change. Callbacks run after the state lock is released, so events from
+        // concurrent changes can arrive out of order; one older than the last epoch handled can be dropped.
+        u64 epoch { 0 };
+    };
+
+    // Interned service handle. IDs are never reused, and the predefined services below always get the same ones.
+    using ServiceID = u8;
+    static constexpr size_t max_services = 256;
+
+    // Everything the scan paths need to know about a service, read in one atomic load
+    struct FallbackDecision {
+        ServiceState state { ServiceState::Healthy };
+        bool use_fallback { false };
+        Optional<FallbackStrategy> strategy;
     };
 
     // Callback for degradation events
@@ -84,7 +104,12 @@ public:
         FallbackStrategy fallback = FallbackStrategy::None
     );
 
+    // Service interning
+    ServiceID intern_service(StringView service_name);
+    Optional<ServiceID> find_service(StringView service_name) const;
+
     ServiceState get_service_state(String const& service_name) const;
+    ServiceState get_service_state(ServiceID) const;
     DegradationLevel get_system_degradation_level() const;
 
     // Query degraded services
@@ -94,7 +119,11 @@ public:
 
     // Fallback behavior
     bool should_use_fallback(String const& service_name) const;
+    bool should_use_fallback(ServiceID) const;
     Optional<FallbackStrategy> get_fallback_strategy(String const& service_name) const;
+    Optional<FallbackStrategy> get_fallback_strategy(ServiceID) const;
+    FallbackDecision fallback_decision(StringView service_name) const;
+    FallbackDecision fallback_decision(ServiceID) const;
     Optional<String> get_fallback_reason(String const& service_name) const;
 
     // Recovery detection
@@ -107,9 +136,13 @@ public:
     bool is_auto_recovery_enabled(String const& service_name) const;
 
     // Event notifications
+    // NB: Callbacks may query state, but must not register or clear callbacks.
     void register_degradation_callback(DegradationCallback callback);
     void clear_degradation_callbacks();
 
+    // Bumped on every state change, so callers can cache decisions and re-query only when it moves
+    u64 state_epoch() const { return m_state_epoch.load(AK::MemoryOrder::memory_order_acquire); }
+
     // Statistics and metrics
     struct DegradationMetrics {
         size_t total_services;
@@ -149,11 +182,24 @@ private:
     DegradationLevel calculate_system_level() const;
     void update_metrics(ServiceState old_state, ServiceState new_state);
 
-    // Service failure tracking
+    // Caller must hold m_mutex
+    ServiceID intern_service_locked(StringView service_name);
+    u64 publish_service_state(ServiceID, ServiceState, FallbackStrategy);
+
+    // Service failure tracking; the cold details behind m_service_status
     HashMap<String, ServiceFailure> m_service_failures;
 
-    // Event callbacks
+    // Interned names, append-only: slots below m_service_count are never written again
+    Array<String, max_services> m_service_names;
+    Atomic<size_t> m_service_count { 0 };
+
+    // Per-service state and fallback strategy, packed into one word and indexed by ServiceID (0 = no record)
+    Array<Atomic<u32>, max_services> m_service_status {};
+    Atomic<u64> m_state_epoch { 0 };
+
+    // Event callbacks, invoked without holding m_mutex
     Vector<DegradationCallback> m_callbacks;
+    Sync::Mutex m_callback_mutex;
 
     // Metrics
     size_t m_total_failures { 0 };
@@ -180,6 +226,17 @@ namespace Services {
     constexpr StringView NetworkLayer = "NetworkLayer"sv;
 }
 
+// IDs of the predefined services, interned in this order by every GracefulDegradation
+namespace ServiceIDs {
+    constexpr GracefulDegradation::ServiceID PolicyGraph = 0;
+    constexpr GracefulDegradation::ServiceID YARAScanner = 1;
+    constexpr GracefulDegradation::ServiceID IPCServer = 2;
+    constexpr GracefulDegradation::ServiceID Database = 3;
+    constexpr GracefulDegradation::ServiceID Quarantine = 4;
+    constexpr GracefulDegradation::ServiceID SecurityTap = 5;
+    constexpr GracefulDegradation::ServiceID NetworkLayer = 6;
+}
+
 // Helper function to convert enums to strings for logging
 String degradation_level_to_string(GracefulDegradation::DegradationLevel level);
 String service_state_to_string(GracefulDegradation::ServiceState state);
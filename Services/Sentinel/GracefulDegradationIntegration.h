@@ -32,11 +32,10 @@ public:
     )
     {
         // Check if service should use fallback
-        if (m_degradation.should_use_fallback(service_name)) {
-            auto strategy = m_degradation.get_fallback_strategy(service_name);
+        if (auto decision = m_degradation.fallback_decision(service_name); decision.use_fallback) {
             dbgln("GracefulDegradationIntegration: Using fallback for service '{}' (strategy: {})",
                 service_name,
-                strategy.has_value() ? fallback_strategy_to_string(strategy.value()) : "Unknown"_string);
+                decision.strategy.has_value() ? fallback_strategy_to_string(decision.strategy.value()) : "Unknown"_string);
 
             return fallback();
         }
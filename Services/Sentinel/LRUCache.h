@@ -13,25 +13,28 @@
 
 namespace Sentinel {
 
+// Metrics shared by LRUCache and the slab-backed caches in ShardedLRUCache.h
+struct LRUCacheMetrics {
+    size_t hits { 0 };
+    size_t misses { 0 };
+    size_t evictions { 0 };
+    size_t invalidations { 0 };
+    size_t current_size { 0 };
+    size_t max_size { 0 };
+
+    double hit_rate() const
+    {
+        auto total = hits + misses;
+        return total > 0 ? (hits * 100.0) / total : 0.0;
+    }
+};
+
 // Generic O(1) LRU Cache implementation using doubly-linked list + HashMap
 // All operations (get, put, evict) are O(1) time complexity
 template<typename Key, typename Value>
 class LRUCache {
 public:
-    struct CacheMetrics {
-        size_t hits { 0 };
-        size_t misses { 0 };
-        size_t evictions { 0 };
-        size_t invalidations { 0 };
-        size_t current_size { 0 };
-        size_t max_size { 0 };
-
-        double hit_rate() const
-        {
-            auto total = hits + misses;
-            return total > 0 ? (hits * 100.0) / total : 0.0;
-        }
-    };
+    using CacheMetrics = LRUCacheMetrics;
 
     explicit LRUCache(size_t capacity = 1000)
         : m_head(nullptr)
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/Math.h>
+#include <AK/StdLibExtras.h>
+#include <AK/Time.h>
+#include <AK/Types.h>
+
+namespace Sentinel {
+
+// A log-linear latency histogram in the style of HdrHistogram, counting microseconds.
+//
+// Values below 2^SUB_BUCKET_BITS get a bucket each. Above that, every power of two is split into
+// 2^(SUB_BUCKET_BITS - 1) equal buckets, so a bucket is never wider than 1/16 of the values in it
+// and percentiles are within 6.25% of the true value, however long the tail.
+class LatencyHistogram {
+public:
+    static constexpr size_t SUB_BUCKET_BITS = 5;
+    static constexpr size_t LINEAR_BUCKETS = 1u << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKETS_PER_MAGNITUDE = LINEAR_BUCKETS / 2;
+
+    // Anything from 2^MAX_MAGNITUDE microseconds (about 19 hours) up lands in the last bucket
+    static constexpr size_t MAX_MAGNITUDE = 36;
+    static constexpr size_t BUCKET_COUNT = LINEAR_BUCKETS + (MAX_MAGNITUDE - SUB_BUCKET_BITS) * BUCKETS_PER_MAGNITUDE;
+
+    static constexpr size_t bucket_index(u64 microseconds)
+    {
+        if (microseconds < LINEAR_BUCKETS)
+            return microseconds;
+
+        auto magnitude = static_cast<size_t>(63 - count_leading_zeroes(microseconds));
+        if (magnitude >= MAX_MAGNITUDE)
+            return BUCKET_COUNT - 1;
+
+        auto shift = magnitude - (SUB_BUCKET_BITS - 1);
+        auto sub_bucket = (microseconds >> shift) - BUCKETS_PER_MAGNITUDE;
+        return LINEAR_BUCKETS + (magnitude - SUB_BUCKET_BITS) * BUCKETS_PER_MAGNITUDE + sub_bucket;
+    }
+
+    // The largest value that lands in the bucket
+    static constexpr u64 bucket_upper_bound(size_t index)
+    {
+        if (index < LINEAR_BUCKETS)
+            return index;
+
+        auto magnitude = (index - LINEAR_BUCKETS) / BUCKETS_PER_MAGNITUDE + SUB_BUCKET_BITS;
+        auto sub_bucket = (index - LINEAR_BUCKETS) % BUCKETS_PER_MAGNITUDE + BUCKETS_PER_MAGNITUDE;
+        auto shift = magnitude - (SUB_BUCKET_BITS - 1);
+        return (static_cast<u64>(sub_bucket + 1) << shift) - 1;
+    }
+
+    static u64 to_microseconds(Duration duration)
+    {
+        return static_cast<u64>(max<i64>(duration.to_microseconds(), 0));
+    }
+
+    void record(Duration duration) { add_to_bucket(bucket_index(to_microseconds(duration)), 1); }
+
+    void add_to_bucket(size_t index, u64 count)
+    {
+        m_buckets[index] += count;
+        m_count += count;
+    }
+
+    void merge(LatencyHistogram const& other)
+    {
+        for (size_t i = 0; i < BUCKET_COUNT; ++i)
+            m_buckets[i] += other.m_buckets[i];
+        m_count += other.m_count;
+    }
+
+    u64 count() const { return m_count; }
+
+    // The upper bound of the bucket holding the given percentile (0-100), or zero if nothing was recorded
+    Duration percentile(double percent) const
+    {
+        if (m_count == 0)
+            return Duration::zero();
+
+        auto rank = static_cast<u64>(AK::ceil(clamp(percent, 0.0, 100.0) / 100.0 * static_cast<double>(m_count)));
+        rank = max<u64>(rank, 1);
+
+        u64 seen = 0;
+        for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+            seen += m_buckets[i];
+            if (seen >= rank)
+                return Duration::from_microseconds(static_cast<i64>(bucket_upper_bound(i)));
+        }
+        VERIFY_NOT_REACHED();
+    }
+
+private:
+    Array<u64, BUCKET_COUNT> m_buckets {};
+    u64 m_count { 0 };
+};
+
+// The same buckets as relaxed atomics, for recording from many threads at once. Nothing orders
+// the buckets against each other, so a copy taken while recording is going on can be a few
+// samples behind, but never loses any.
+class AtomicLatencyHistogram {
+public:
+    void record(Duration duration)
+    {
+        m_buckets[LatencyHistogram::bucket_index(LatencyHistogram::to_microseconds(duration))].fetch_add(1);
+    }
+
+    void add_to(LatencyHistogram& histogram) const
+    {
+        for (size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+            if (auto count = m_buckets[i].load(); count != 0)
+                histogram.add_to_bucket(i, count);
+        }
+    }
+
+    void reset()
+    {
+        for (auto& bucket : m_buckets)
+            bucket.store(0);
+    }
+
+private:
+    Array<Atomic<u64, AK::MemoryOrder::memory_order_relaxed>, LatencyHistogram::BUCKET_COUNT> m_buckets;
+};
+
+}
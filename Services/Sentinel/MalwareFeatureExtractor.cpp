@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "MalwareFeatureExtractor.h"
+#include <AK/BitCast.h>
+#include <AK/BuiltinWrappers.h>
+#include <AK/CharacterTypes.h>
+#include <AK/Math.h>
+#include <AK/NumericLimits.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+namespace Sentinel {
+
+using AK::SIMD::u64x2;
+using AK::SIMD::u8x16;
+
+static constexpr size_t BLOCK_SIZE = sizeof(u8x16);
+
+// Strings whose presence anywhere in the file counts towards the features
+enum Indicator : u16 {
+    UrlScheme = 1 << 0,
+    ExecutableName = 1 << 1,
+    InjectionApi = 1 << 2,
+    Kernel32Import = 1 << 3,
+    User32Import = 1 << 4,
+    Advapi32Import = 1 << 5,
+    NtdllImport = 1 << 6,
+    Ws2_32Import = 1 << 7,
+    WininetImport = 1 << 8,
+};
+
+static constexpr u16 ALL_INDICATORS = (1 << 9) - 1;
+static constexpr u16 IMPORT_INDICATORS = Kernel32Import | User32Import | Advapi32Import | NtdllImport | Ws2_32Import | WininetImport;
+
+struct IndicatorPattern {
+    StringView text;
+    Indicator indicator;
+};
+
+static constexpr IndicatorPattern INDICATOR_PATTERNS[] = {
+    { "http://"sv, UrlScheme },
+    { "https://"sv, UrlScheme },
+    { "ftp://"sv, UrlScheme },
+    { ".exe"sv, ExecutableName },
+    { ".dll"sv, ExecutableName },
+    { ".bat"sv, ExecutableName },
+    { "VirtualAlloc"sv, InjectionApi },
+    { "CreateRemoteThread"sv, InjectionApi },
+    { "WriteProcessMemory"sv, InjectionApi },
+    { "kernel32.dll"sv, Kernel32Import },
+    { "user32.dll"sv, User32Import },
+    { "advapi32.dll"sv, Advapi32Import },
+    { "ntdll.dll"sv, NtdllImport },
+    { "ws2_32.dll"sv, Ws2_32Import },
+    { "wininet.dll"sv, WininetImport },
+};
+
+// Aho-Corasick DFA over INDICATOR_PATTERNS, built once. Each state carries the indicators of every
+// pattern ending there, including through its failure chain, so scanning is one lookup per byte.
+struct IndicatorAutomaton {
+    Array<u8, 256> symbol_for_byte {};
+    size_t alphabet_size { 0 };
+
+    // Indexed by state * alphabet_size + symbol
+    Vector<u16> transitions;
+    Vector<u16> state_indicators;
+};
+
+static IndicatorAutomaton build_indicator_automaton()
+{
+    static constexpr u16 NO_STATE = NumericLimits<u16>::max();
+
+    IndicatorAutomaton automaton;
+
+    // Symbol 0 is every byte that appears in no pattern
+    automaton.alphabet_size = 1;
+    for (auto const& pattern : INDICATOR_PATTERNS) {
+        for (auto byte : pattern.text.bytes()) {
+            if (automaton.symbol_for_byte[byte] == 0)
+                automaton.symbol_for_byte[byte] = static_cast<u8>(automaton.alphabet_size++);
+        }
+    }
+    auto alphabet_size = automaton.alphabet_size;
+
+    auto& transitions = automaton.transitions;
+    auto& state_indicators = automaton.state_indicators;
+    transitions.resize(alphabet_size);
+    transitions.fill(NO_STATE);
+    state_indicators.append(0);
+
+    for (auto const& pattern : INDICATOR_PATTERNS) {
+        u16 state = 0;
+        for (auto byte : pattern.text.bytes()) {
+            auto slot = state * alphabet_size + automaton.symbol_for_byte[byte];
+            if (transitions[slot] == NO_STATE) {
+                transitions[slot] = static_cast<u16>(state_indicators.size());
+                state_indicators.append(0);
+                transitions.resize(transitions.size() + alphabet_size);
+                for (size_t i = transitions.size() - alphabet_size; i < transitions.size(); ++i)
+                    transitions[i] = NO_STATE;
+            }
+            state = transitions[slot];
+        }
+        state_indicators[state] |= pattern.indicator;
+    }
+
+    // Fill missing transitions from each state's failure state, breadth-first so that every failure
+    // state is complete before it is used
+    Vector<u16> failure_states;
+    Vector<u16> queue;
+    failure_states.resize(state_indicators.size());
+    queue.ensure_capacity(state_indicators.size());
+
+    for (size_t symbol = 0; symbol < alphabet_size; ++symbol) {
+        auto& next = transitions[symbol];
+        if (next == NO_STATE) {
+            next = 0;
+            continue;
+        }
+        failure_states[next] = 0;
+        queue.unchecked_append(next);
+    }
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        auto state = queue[head];
+        auto failure_state = failure_states[state];
+        for (size_t symbol = 0; symbol < alphabet_size; ++symbol) {
+            auto fallback = transitions[failure_state * alphabet_size + symbol];
+            auto& next = transitions[state * alphabet_size + symbol];
+            if (next == NO_STATE) {
+                next = fallback;
+                continue;
+            }
+            failure_states[next] = fallback;
+            state_indicators[next] |= state_indicators[fallback];
+            queue.unchecked_append(next);
+        }
+    }
+
+    VERIFY(state_indicators.size() < NO_STATE);
+    return automaton;
+}
+
+static IndicatorAutomaton const& indicator_automaton()
+{
+    static IndicatorAutomaton const automaton = build_indicator_automaton();
+    return automaton;
+}
+
+static constexpr u8x16 splat(u8 value)
+{
+    return u8x16 { value, value, value, value, value, value, value, value, value, value, value, value, value, value, value, value };
+}
+
+static bool contains_byte(u8x16 block, u8 value)
+{
+    auto matches = bit_cast<u64x2>(block == splat(value));
+    return (matches[0] | matches[1]) != 0;
+}
+
+// Heuristic: x86/x64 opcodes tend to cluster in a few ranges, while 0x00 and 0xFF are padding
+static constexpr bool is_likely_code_byte(u8 byte)
+{
+    return (byte >= 0x40 && byte <= 0x5F) // REX prefix, PUSH/POP
+        || (byte >= 0x80 && byte <= 0x8F) // Conditional jumps
+        || byte == 0xE8 || byte == 0xE9;  // CALL, JMP
+}
+
+void MalwareFeatureExtractor::update(ReadonlyBytes chunk)
+{
+    if (chunk.is_empty())
+        return;
+
+    capture_headers(chunk);
+    sample_code_bytes(chunk);
+    scan(chunk);
+    m_bytes_processed += chunk.size();
+}
+
+void MalwareFeatureExtractor::capture_headers(ReadonlyBytes chunk)
+{
+    auto chunk_start = m_bytes_processed;
+    auto chunk_end = chunk_start + chunk.size();
+
+    if (chunk_start < DOS_HEADER_SIZE) {
+        auto count = min<u64>(DOS_HEADER_SIZE, chunk_end) - chunk_start;
+        chunk.slice(0, count).copy_to(m_dos_header.span().slice(chunk_start));
+    }
+
+    // The signature offset is only known once the whole DOS header has been seen
+    if (chunk_end < DOS_HEADER_SIZE || m_pe_signature_captured == (1 << PE_SIGNATURE_SIZE) - 1)
+        return;
+
+    u64 signature_start = pe_offset();
+    for (size_t i = 0; i < PE_SIGNATURE_SIZE; ++i) {
+        auto position = signature_start + i;
+        if (position < DOS_HEADER_SIZE)
+            m_pe_signature[i] = m_dos_header[position];
+        else if (position >= chunk_start && position < chunk_end)
+            m_pe_signature[i] = chunk[position - chunk_start];
+        else
+            continue;
+        m_pe_signature_captured |= 1 << i;
+    }
+}
+
+void MalwareFeatureExtractor::sample_code_bytes(ReadonlyBytes chunk)
+{
+    auto chunk_start = m_bytes_processed;
+    auto sample_start = max<u64>(chunk_start, CODE_SAMPLE_START);
+    auto sample_end = min<u64>(chunk_start + chunk.size(), CODE_SAMPLE_END);
+
+    for (auto position = sample_start; position < sample_end; ++position) {
+        if (is_likely_code_byte(chunk[position - chunk_start]))
+            ++m_code_bytes;
+    }
+}
+
+void MalwareFeatureExtractor::scan(ReadonlyBytes chunk)
+{
+    auto const& automaton = indicator_automaton();
+    auto alphabet_size = automaton.alphabet_size;
+    auto state = m_automaton_state;
+
+    auto step_automaton = [&](u8 byte) {
+        state = automaton.transitions[state * alphabet_size + automaton.symbol_for_byte[byte]];
+        m_indicators |= automaton.state_indicators[state];
+    };
+
+    auto step_numbers = [&](u8 byte, u64 position) {
+        if (byte == '.')
+            found_dot(position);
+        m_digit_history = (m_digit_history << 1) | (is_ascii_digit(byte) ? 1 : 0);
+    };
+
+    size_t offset = 0;
+    for (; offset + BLOCK_SIZE <= chunk.size(); offset += BLOCK_SIZE) {
+        auto block = AK::SIMD::load_unaligned<u8x16>(chunk.data() + offset);
+        auto position = m_bytes_processed + offset;
+
+        for (size_t lane = 0; lane < BLOCK_SIZE; ++lane)
+            ++m_histograms[lane % m_histograms.size()][block[lane]];
+
+        // Indicators never unset, so once all have been seen the automaton has nothing left to find
+        if (m_indicators != ALL_INDICATORS) {
+            for (size_t lane = 0; lane < BLOCK_SIZE; ++lane)
+                step_automaton(block[lane]);
+        }
+
+        // Most blocks have no dot, in which case only the digits at the end of the block matter
+        if (contains_byte(block, '.')) {
+            for (size_t lane = 0; lane < BLOCK_SIZE; ++lane)
+                step_numbers(block[lane], position + lane);
+        } else {
+            for (size_t lane = BLOCK_SIZE - 8; lane < BLOCK_SIZE; ++lane)
+                m_digit_history = (m_digit_history << 1) | (is_ascii_digit(block[lane]) ? 1 : 0);
+        }
+    }
+
+    for (; offset < chunk.size(); ++offset) {
+        auto byte = chunk[offset];
+        ++m_histograms[offset % m_histograms.size()][byte];
+        step_automaton(byte);
+        step_numbers(byte, m_bytes_processed + offset);
+    }
+
+    m_automaton_state = state;
+}
+
+void MalwareFeatureExtractor::found_dot(u64 position)
+{
+    // A number starts at a digit followed by a dot within its next 6 bytes; the scan resumes 8 bytes
+    // after the start. So the dot at `position` ends a match at the earliest digit among the 6 bytes
+    // before it that does not precede m_next_number_start.
+    if (position <= m_next_number_start)
+        return;
+
+    u32 candidates = m_digit_history & 0x3F;
+    if (auto reachable = position - m_next_number_start; reachable < 6)
+        candidates &= (1u << reachable) - 1;
+    if (candidates == 0)
+        return;
+
+    auto start = position - static_cast<u64>(32 - count_leading_zeroes(candidates));
+
+    // The previous match started at least 8 bytes before this one, so it is known to fit
+    if (m_pending_number_start.has_value())
+        ++m_dotted_numbers;
+    m_pending_number_start = start;
+    m_next_number_start = start + 8;
+}
+
+bool MalwareFeatureExtractor::is_pe_file() const
+{
+    // Check for DOS header "MZ"
+    return m_bytes_processed >= DOS_HEADER_SIZE && m_dos_header[0] == 'M' && m_dos_header[1] == 'Z';
+}
+
+u32 MalwareFeatureExtractor::pe_offset() const
+{
+    return static_cast<u32>(m_dos_header[PE_OFFSET_FIELD])
+        | (static_cast<u32>(m_dos_header[PE_OFFSET_FIELD + 1]) << 8)
+        | (static_cast<u32>(m_dos_header[PE_OFFSET_FIELD + 2]) << 16)
+        | (static_cast<u32>(m_dos_header[PE_OFFSET_FIELD + 3]) << 24);
+}
+
+float MalwareFeatureExtractor::entropy() const
+{
+    if (m_bytes_processed == 0)
+        return 0.0f;
+
+    float entropy = 0.0f;
+    float data_size = static_cast<float>(m_bytes_processed);
+
+    for (size_t i = 0; i < 256; i++) {
+        u64 frequency = 0;
+        for (auto const& histogram : m_histograms)
+            frequency += histogram[i];
+        if (frequency == 0)
+            continue;
+
+        float probability = static_cast<float>(frequency) / data_size;
+        entropy -= probability * AK::log2(probability);
+    }
+
+    return entropy;
+}
+
+u32 MalwareFeatureExtractor::suspicious_string_score() const
+{
+    u64 dotted_numbers = m_dotted_numbers;
+    if (m_pending_number_start.has_value() && *m_pending_number_start + 8 <= m_bytes_processed)
+        ++dotted_numbers;
+
+    u64 score = dotted_numbers * 5;
+    if (m_indicators & UrlScheme)
+        score += 10;
+    if (m_indicators & ExecutableName)
+        score += 3;
+    if (m_indicators & InjectionApi)
+        score += 15; // High weight for suspicious APIs
+
+    return static_cast<u32>(min<u64>(score, 1000));
+}
+
+MalwareMLDetector::Features MalwareFeatureExtractor::finish() const
+{
+    MalwareMLDetector::Features features;
+    features.file_size = m_bytes_processed;
+    features.entropy = entropy();
+    features.suspicious_strings = suspicious_string_score();
+
+    if (!is_pe_file())
+        return features;
+
+    // PE structure: the signature "PE\0\0" must be at the offset the DOS header points to
+    u64 signature_start = pe_offset();
+    if (signature_start > m_bytes_processed - PE_SIGNATURE_SIZE) {
+        features.pe_header_anomalies = 50; // Invalid PE offset
+    } else {
+        VERIFY(m_pe_signature_captured == (1 << PE_SIGNATURE_SIZE) - 1);
+        if (!(m_pe_signature[0] == 'P' && m_pe_signature[1] == 'E' && m_pe_signature[2] == 0 && m_pe_signature[3] == 0))
+            features.pe_header_anomalies = 20; // Invalid PE signature
+    }
+
+    // Code to data ratio over the sample after the DOS header
+    if (m_bytes_processed < 1024) {
+        features.code_section_ratio = 0.5f; // Default for small files
+    } else {
+        auto sample_size = min<u64>(m_bytes_processed, CODE_SAMPLE_END) - CODE_SAMPLE_START;
+        features.code_section_ratio = static_cast<float>(m_code_bytes) / static_cast<float>(sample_size);
+    }
+
+    // Estimate ~10 imports per well-known DLL referenced
+    features.import_table_size = min(popcount(static_cast<u32>(m_indicators & IMPORT_INDICATORS)) * 10u, 500u);
+
+    return features;
+}
+
+}
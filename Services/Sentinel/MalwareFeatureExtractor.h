@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "MalwareML.h"
+#include <AK/Array.h>
+#include <AK/Optional.h>
+#include <AK/Span.h>
+#include <AK/Types.h>
+
+namespace Sentinel {
+
+// Computes MalwareMLDetector::Features in a single pass over the file, fed one chunk at a time.
+//
+// Every feature is accumulated from the same read of each byte: the byte histogram (for entropy),
+// a fixed multi-pattern automaton for the suspicious and import strings, the dotted-number scan,
+// and the code/data sample. PE headers are picked out of the stream as their offsets go by, so
+// nothing but a few dozen bytes of header is retained and the file never has to be buffered.
+// Chunk boundaries do not affect the result: feeding a file in pieces of any size produces the
+// same features as feeding it whole.
+//
+// Usage:
+//   MalwareFeatureExtractor extractor;
+//   extractor.update(chunk); // repeatedly
+//   auto features = extractor.finish();
+class MalwareFeatureExtractor {
+public:
+    MalwareFeatureExtractor() = default;
+
+    void update(ReadonlyBytes chunk);
+
+    // Features of everything passed to update() so far. Does not reset the extractor.
+    MalwareMLDetector::Features finish() const;
+
+    u64 bytes_processed() const { return m_bytes_processed; }
+
+private:
+    static constexpr size_t DOS_HEADER_SIZE = 64;
+    static constexpr size_t PE_OFFSET_FIELD = 0x3C;
+    static constexpr size_t PE_SIGNATURE_SIZE = 4;
+
+    // Bytes [CODE_SAMPLE_START, CODE_SAMPLE_END) are sampled for the code/data ratio
+    static constexpr u64 CODE_SAMPLE_START = DOS_HEADER_SIZE;
+    static constexpr u64 CODE_SAMPLE_END = 10240;
+
+    void capture_headers(ReadonlyBytes chunk);
+    void sample_code_bytes(ReadonlyBytes chunk);
+    void scan(ReadonlyBytes chunk);
+    void found_dot(u64 position);
+
+    bool is_pe_file() const;
+    u32 pe_offset() const;
+    float entropy() const;
+    u32 suspicious_string_score() const;
+
+    u64 m_bytes_processed { 0 };
+
+    // Four interleaved histograms, so consecutive equal bytes do not serialize on one counter
+    Array<Array<u64, 256>, 4> m_histograms {};
+
+    // Automaton state and the string indicators seen so far (a bit set of Indicator)
+    u16 m_automaton_state { 0 };
+    u16 m_indicators { 0 };
+
+    // Dotted-number scan: digit-ness of the previous bytes (bit 0 is the byte just before the
+    // current one), the first position a new match may start at, and the most recent match, which
+    // only counts once the file is known to extend 8 bytes past its start
+    u8 m_digit_history { 0 };
+    u64 m_next_number_start { 0 };
+    Optional<u64> m_pending_number_start;
+    u64 m_dotted_numbers { 0 };
+
+    Array<u8, DOS_HEADER_SIZE> m_dos_header {};
+    Array<u8, PE_SIGNATURE_SIZE> m_pe_signature {};
+    u8 m_pe_signature_captured { 0 }; // Bit per signature byte
+
+    u32 m_code_bytes { 0 };
+};
+
+}
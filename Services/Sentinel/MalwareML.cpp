@@ -4,8 +4,12 @@
  */
 
 #include "MalwareML.h"
+#include "MalwareFeatureExtractor.h"
+#include <AK/BitCast.h>
 #include <AK/Checked.h>
 #include <AK/Math.h>
+#include <AK/SIMD.h>
+#include <AK/SIMDExtras.h>
 #include <AK/Time.h>
 
 // TensorFlow Lite headers when available
@@ -18,6 +22,11 @@
 namespace Sentinel {
 
 #ifdef USE_ML_STUB
+using AK::SIMD::expand4;
+using AK::SIMD::f32x4;
+using AK::SIMD::i32x4;
+using AK::SIMD::load_unaligned;
+
 // Implementation of MalwareMLStub methods
 MalwareMLStub::MalwareMLStub() {
     // Initialize with pseudo-random weights that simulate a trained model
@@ -36,9 +45,9 @@ void MalwareMLStub::initialize_weights() {
                 weights_input_hidden[i][j] = 0.0f;
             }
         }
-        for (size_t i = 0; i < HIDDEN_SIZE; i++) {
-            for (size_t j = 0; j < OUTPUT_SIZE; j++) {
-                weights_hidden_output[i][j] = 0.0f;
+        for (size_t i = 0; i < OUTPUT_SIZE; i++) {
+            for (size_t j = 0; j < HIDDEN_SIZE; j++) {
+                weights_output_hidden[i][j] = 0.0f;
             }
         }
         for (size_t i = 0; i < HIDDEN_SIZE; i++) {
@@ -79,8 +88,8 @@ void MalwareMLStub::initialize_weights() {
 
         // Hidden to output weights (adjusted for better discrimination)
         for (size_t i = 0; i < HIDDEN_SIZE; i++) {
-            weights_hidden_output[i][0] = -0.06f - (i % 4) * 0.01f;  // Benign: -0.06 to -0.09
-            weights_hidden_output[i][1] = 0.06f + (i % 4) * 0.01f;   // Malware: 0.06 to 0.09
+            weights_output_hidden[0][i] = -0.06f - (i % 4) * 0.01f;  // Benign: -0.06 to -0.09
+            weights_output_hidden[1][i] = 0.06f + (i % 4) * 0.01f;   // Malware: 0.06 to 0.09
         }
 
         // Output bias (reduced to let features dominate)
@@ -88,27 +97,40 @@ void MalwareMLStub::initialize_weights() {
         bias_output[1] = -0.05f;   // Malware - reduced bias
 }
 
-// Forward pass through the network
-Vector<float> MalwareMLStub::forward(Vector<float> const& input) {
-        VERIFY(input.size() == INPUT_SIZE);
-
-        // Hidden layer computation
-        float hidden[HIDDEN_SIZE];
-        for (size_t j = 0; j < HIDDEN_SIZE; j++) {
-            hidden[j] = bias_hidden[j];
-            for (size_t i = 0; i < INPUT_SIZE; i++) {
-                hidden[j] += input[i] * weights_input_hidden[i][j];
-            }
-            hidden[j] = relu(hidden[j]);
+// Forward pass through the network, one sample at a time with the hidden layer in SIMD lanes
+void MalwareMLStub::forward(ReadonlySpan<float> inputs, Span<float> outputs) const
+{
+    static constexpr size_t LANES = 4;
+    static constexpr size_t HIDDEN_VECTORS = HIDDEN_SIZE / LANES;
+    static_assert(HIDDEN_SIZE % LANES == 0);
+    static_assert(OUTPUT_SIZE == 2);
+
+    VERIFY(inputs.size() % INPUT_SIZE == 0);
+    auto batch_size = inputs.size() / INPUT_SIZE;
+    VERIFY(outputs.size() == batch_size * OUTPUT_SIZE);
+
+    for (size_t sample = 0; sample < batch_size; ++sample) {
+        auto const* input = inputs.data() + sample * INPUT_SIZE;
+
+        // Hidden layer: relu(bias + sum(input[i] * weights[i]))
+        f32x4 hidden[HIDDEN_VECTORS];
+        for (size_t v = 0; v < HIDDEN_VECTORS; ++v)
+            hidden[v] = load_unaligned<f32x4>(&bias_hidden[v * LANES]);
+        for (size_t i = 0; i < INPUT_SIZE; ++i) {
+            auto x = expand4(input[i]);
+            for (size_t v = 0; v < HIDDEN_VECTORS; ++v)
+                hidden[v] += x * load_unaligned<f32x4>(&weights_input_hidden[i][v * LANES]);
         }
+        for (size_t v = 0; v < HIDDEN_VECTORS; ++v)
+            hidden[v] = bit_cast<f32x4>(bit_cast<i32x4>(hidden[v]) & (hidden[v] > expand4(0.0f)));
 
-        // Output layer computation
+        // Output layer: a dot product of the hidden layer with each output's weights
         float output_raw[OUTPUT_SIZE];
         for (size_t j = 0; j < OUTPUT_SIZE; j++) {
-            output_raw[j] = bias_output[j];
-            for (size_t i = 0; i < HIDDEN_SIZE; i++) {
-                output_raw[j] += hidden[i] * weights_hidden_output[i][j];
-            }
+            f32x4 sum = expand4(0.0f);
+            for (size_t v = 0; v < HIDDEN_VECTORS; ++v)
+                sum += hidden[v] * load_unaligned<f32x4>(&weights_output_hidden[j][v * LANES]);
+            output_raw[j] = bias_output[j] + (sum[0] + sum[1]) + (sum[2] + sum[3]);
         }
 
         // Apply softmax for probability distribution
@@ -119,13 +141,10 @@ Vector<float> MalwareMLStub::forward(Vector<float> const& input) {
             exp_sum += output_raw[i];
         }
 
-        Vector<float> output;
-        output.ensure_capacity(OUTPUT_SIZE);
-        for (size_t i = 0; i < OUTPUT_SIZE; i++) {
-            output.append(output_raw[i] / exp_sum);
-        }
-
-        return output;
+        auto* output = outputs.data() + sample * OUTPUT_SIZE;
+        for (size_t i = 0; i < OUTPUT_SIZE; i++)
+            output[i] = output_raw[i] / exp_sum;
+    }
 }
 #endif
 
@@ -133,25 +152,30 @@ Vector<float> MalwareMLStub::forward(Vector<float> const& input) {
 Vector<float> MalwareMLDetector::Features::to_vector() const
 {
     Vector<float> vec;
-    vec.ensure_capacity(6); // 6 features total
+    vec.resize(FEATURE_COUNT);
+    write_to(vec.span());
+    return vec;
+}
 
-    // Normalize features to 0.0-1.0 range for neural network
-    vec.append(static_cast<float>(file_size) / 100'000'000.0f); // Normalize by 100MB
-    vec.append(entropy / 8.0f);                                  // Entropy is 0-8
-    vec.append(static_cast<float>(pe_header_anomalies) / 100.0f); // Max ~100 anomalies
-    vec.append(static_cast<float>(suspicious_strings) / 1000.0f); // Max ~1000 strings
-    vec.append(code_section_ratio);                              // Already 0-1
-    vec.append(static_cast<float>(import_table_size) / 500.0f);  // Max ~500 imports
+void MalwareMLDetector::Features::write_to(Span<float> output) const
+{
+    VERIFY(output.size() == FEATURE_COUNT);
 
-    return vec;
+    // Normalize features to 0.0-1.0 range for neural network
+    output[0] = static_cast<float>(file_size) / 100'000'000.0f; // Normalize by 100MB
+    output[1] = entropy / 8.0f;                                  // Entropy is 0-8
+    output[2] = static_cast<float>(pe_header_anomalies) / 100.0f; // Max ~100 anomalies
+    output[3] = static_cast<float>(suspicious_strings) / 1000.0f; // Max ~1000 strings
+    output[4] = code_section_ratio;                              // Already 0-1
+    output[5] = static_cast<float>(import_table_size) / 500.0f;  // Max ~500 imports
 }
 
 // Constructor
 MalwareMLDetector::MalwareMLDetector(ByteString const& model_path)
     : m_model_path(model_path)
 {
-    m_input_tensor.resize(6);   // 6-dimensional input
-    m_output_tensor.resize(2);  // Binary classification output [benign, malware]
+    m_input_tensor.resize(FEATURE_COUNT);  // 6-dimensional input
+    m_output_tensor.resize(CLASS_COUNT);   // Binary classification output [benign, malware]
 
     // Explicitly zero-initialize statistics
     m_stats.total_predictions = 0;
@@ -232,284 +256,157 @@ ErrorOr<void> MalwareMLDetector::initialize_interpreter()
     return {};
 }
 
-// Shannon entropy calculation (information theory)
-float MalwareMLDetector::calculate_shannon_entropy(ByteBuffer const& data)
+// Extract features from file
+ErrorOr<MalwareMLDetector::Features> MalwareMLDetector::extract_features(ReadonlyBytes file_data)
 {
-    if (data.is_empty())
-        return 0.0f;
-
-    // Count byte frequency
-    u32 frequency[256] = { 0 };
-    for (auto byte : data.bytes())
-        frequency[byte]++;
-
-    // Calculate entropy
-    float entropy = 0.0f;
-    float data_size = static_cast<float>(data.size());
-
-    for (size_t i = 0; i < 256; i++) {
-        if (frequency[i] == 0)
-            continue;
-
-        float probability = static_cast<float>(frequency[i]) / data_size;
-        entropy -= probability * AK::log2(probability);
-    }
-
-    return entropy;
+    MalwareFeatureExtractor extractor;
+    extractor.update(file_data);
+    return extractor.finish();
 }
 
-// Count suspicious strings (URLs, IPs, high-entropy strings)
-u32 MalwareMLDetector::count_suspicious_strings(ByteBuffer const& data)
+#if !defined(ENABLE_TFLITE) && !defined(USE_ML_STUB)
+// Heuristic-based scoring fallback
+static float heuristic_malware_score(MalwareMLDetector::Features const& features)
 {
-    u32 count = 0;
-    auto view = StringView(data.bytes());
-
-    // Look for URL patterns (http://, https://, ftp://)
-    if (view.contains("http://"sv) || view.contains("https://"sv) || view.contains("ftp://"sv))
-        count += 10;
-
-    // Look for IP address patterns (simplified)
-    // In real implementation, use regex: \d{1,3}\.\d{1,3}\.\d{1,3}\.\d{1,3}
-    if (view.length() >= 7) {
-        for (size_t i = 0; i < view.length() - 7; i++) {
-            if (view[i] >= '0' && view[i] <= '9') {
-                // Simple heuristic: count sequences like "192.168."
-                auto substr = view.substring_view(i, min(view.length() - i, 7ul));
-                if (substr.contains('.')) {
-                    count += 5;
-                    i += 7; // Skip ahead
-                }
-            }
-        }
-    }
+    float score = 0.0f;
 
-    // Look for executable patterns
-    if (view.contains(".exe"sv) || view.contains(".dll"sv) || view.contains(".bat"sv))
-        count += 3;
+    // High entropy suggests encryption/packing (common in malware)
+    if (features.entropy > 7.0f) score += 0.3f;
+    else if (features.entropy > 6.0f) score += 0.15f;
 
-    // Look for suspicious API calls (Windows)
-    if (view.contains("VirtualAlloc"sv) || view.contains("CreateRemoteThread"sv) ||
-        view.contains("WriteProcessMemory"sv))
-        count += 15; // High weight for suspicious APIs
+    // PE anomalies
+    if (features.pe_header_anomalies > 20) score += 0.25f;
+    else if (features.pe_header_anomalies > 5) score += 0.1f;
 
-    return min(count, 1000u); // Cap at 1000
-}
+    // Suspicious strings
+    if (features.suspicious_strings > 50) score += 0.3f;
+    else if (features.suspicious_strings > 20) score += 0.15f;
 
-// Check if file is a PE (Portable Executable) - Windows format
-bool MalwareMLDetector::is_pe_file(ByteBuffer const& data)
-{
-    if (data.size() < 64)
-        return false;
+    // Unusual code ratio (too high or too low)
+    if (features.code_section_ratio < 0.2f || features.code_section_ratio > 0.9f)
+        score += 0.15f;
 
-    // Check for DOS header "MZ"
-    return data.bytes()[0] == 'M' && data.bytes()[1] == 'Z';
+    return min(score, 1.0f);
 }
+#endif
 
-// Analyze PE structure for anomalies
-u32 MalwareMLDetector::analyze_pe_structure(ByteBuffer const& data)
+// Run prediction
+ErrorOr<MalwareMLDetector::Prediction> MalwareMLDetector::predict(Features const& features)
 {
-    if (!is_pe_file(data))
-        return 0;
-
-    u32 anomalies = 0;
-
-    // Check DOS header
-    if (data.size() < 64)
-        return 100; // Truncated PE = highly suspicious
-
-    // Read PE offset from DOS header (at offset 0x3C)
-    u32 pe_offset = static_cast<u32>(data.bytes()[0x3C]) |
-                    (static_cast<u32>(data.bytes()[0x3D]) << 8) |
-                    (static_cast<u32>(data.bytes()[0x3E]) << 16) |
-                    (static_cast<u32>(data.bytes()[0x3F]) << 24);
-
-    // Check for valid PE offset
-    if (pe_offset > data.size() - 4)
-        return 50; // Invalid PE offset
-
-    // Check for PE signature "PE\0\0"
-    if (pe_offset + 4 <= data.size()) {
-        if (!(data.bytes()[pe_offset] == 'P' && data.bytes()[pe_offset + 1] == 'E' &&
-              data.bytes()[pe_offset + 2] == 0 && data.bytes()[pe_offset + 3] == 0))
-            anomalies += 20; // Invalid PE signature
-    }
-
-    // In a full implementation, we'd check:
-    // - Section count (unusual if >10)
-    // - Entry point location (should be in .text section)
-    // - Import table validity
-    // - Export table validity
-    // - Resource section size
-    // - Code signing presence
-
-    return min(anomalies, 100u);
+    auto predictions = TRY(predict(ReadonlySpan<Features> { &features, 1 }));
+    return predictions.take_first();
 }
 
-// Calculate code to data ratio
-float MalwareMLDetector::calculate_code_ratio(ByteBuffer const& data)
+ErrorOr<Vector<MalwareMLDetector::Prediction>> MalwareMLDetector::predict(ReadonlySpan<Features> batch)
 {
-    if (!is_pe_file(data) || data.size() < 1024)
-        return 0.5f; // Default for non-PE or small files
-
-    // Simplified heuristic: count executable bytes vs. null/data bytes
-    u32 code_bytes = 0;
-    u32 data_bytes = 0;
-
-    for (size_t i = 64; i < min(data.size(), 10240ul); i++) { // Sample first ~10KB after header
-        u8 byte = data.bytes()[i];
-
-        // Heuristic: 0x00, 0xFF are likely data/padding
-        if (byte == 0x00 || byte == 0xFF)
-            data_bytes++;
-        // x86/x64 instruction opcodes are typically in certain ranges
-        else if ((byte >= 0x40 && byte <= 0x5F) || // REX prefix, PUSH/POP
-                 (byte >= 0x80 && byte <= 0x8F) || // Conditional jumps
-                 (byte == 0xE8 || byte == 0xE9))   // CALL, JMP
-            code_bytes++;
-        else
-            data_bytes++;
-    }
-
-    if (code_bytes + data_bytes == 0)
-        return 0.5f;
+    if (!m_model_loaded)
+        return Error::from_string_literal("ML model not loaded");
 
-    return static_cast<float>(code_bytes) / static_cast<float>(code_bytes + data_bytes);
-}
+    Vector<Prediction> predictions;
+    if (batch.is_empty())
+        return predictions;
 
-// Extract import table size (Windows PE)
-u32 MalwareMLDetector::extract_import_table_size(ByteBuffer const& data)
-{
-    if (!is_pe_file(data))
-        return 0;
-
-    // Simplified: count likely import names
-    // Real implementation would parse PE import directory
-    u32 import_count = 0;
-
-    // Common Windows DLLs and API names
-    Vector<StringView> common_dlls = {
-        "kernel32.dll"sv, "user32.dll"sv, "advapi32.dll"sv,
-        "ntdll.dll"sv, "ws2_32.dll"sv, "wininet.dll"sv
-    };
-
-    auto view = StringView(data.bytes());
-    for (auto dll : common_dlls) {
-        if (view.contains(dll))
-            import_count += 10; // Estimate ~10 imports per DLL
-    }
-
-    return min(import_count, 500u);
-}
+    auto start_time = MonotonicTime::now();
 
-// Extract features from file
-ErrorOr<MalwareMLDetector::Features> MalwareMLDetector::extract_features(ByteBuffer const& file_data)
-{
-    Features features;
+    // Convert features to input tensor
+    TRY(m_input_tensor.try_resize(batch.size() * FEATURE_COUNT));
+    TRY(m_output_tensor.try_resize(batch.size() * CLASS_COUNT));
+    for (size_t i = 0; i < batch.size(); ++i)
+        batch[i].write_to(m_input_tensor.span().slice(i * FEATURE_COUNT, FEATURE_COUNT));
 
-    features.file_size = file_data.size();
-    features.entropy = calculate_shannon_entropy(file_data);
-    features.suspicious_strings = count_suspicious_strings(file_data);
+    TRY(run_inference(batch));
 
-    if (is_pe_file(file_data)) {
-        features.pe_header_anomalies = analyze_pe_structure(file_data);
-        features.code_section_ratio = calculate_code_ratio(file_data);
-        features.import_table_size = extract_import_table_size(file_data);
-    }
+    TRY(predictions.try_ensure_capacity(batch.size()));
+    for (size_t i = 0; i < batch.size(); ++i)
+        predictions.unchecked_append(make_prediction(batch[i], m_output_tensor[i * CLASS_COUNT], m_output_tensor[i * CLASS_COUNT + 1]));
 
-    return features;
+    record_predictions(predictions, MonotonicTime::now() - start_time);
+    return predictions;
 }
 
-// Run prediction
-ErrorOr<MalwareMLDetector::Prediction> MalwareMLDetector::predict(Features const& features)
+ErrorOr<void> MalwareMLDetector::run_inference([[maybe_unused]] ReadonlySpan<Features> batch)
 {
-    if (!m_model_loaded)
-        return Error::from_string_literal("ML model not loaded");
-
-    auto start_time = MonotonicTime::now();
-
-    Prediction prediction;
-    prediction.features_used = features;
-
-    // Convert features to input tensor
-    m_input_tensor = features.to_vector();
-
 #ifdef ENABLE_TFLITE
     // Real TensorFlow Lite inference
     auto* interpreter = static_cast<tflite::Interpreter*>(m_interpreter);
 
+    // Run the whole batch in one Invoke(). The input only ever grows, and a smaller batch leaves
+    // the rows past it zeroed, so alternating batch sizes do not reallocate the tensors.
+    if (batch.size() > m_interpreter_batch_capacity) {
+        if (interpreter->ResizeInputTensor(interpreter->inputs()[0], { static_cast<int>(batch.size()), static_cast<int>(FEATURE_COUNT) }) != kTfLiteOk)
+            return Error::from_string_literal("Failed to resize input tensor");
+        if (interpreter->AllocateTensors() != kTfLiteOk)
+            return Error::from_string_literal("Failed to allocate tensors");
+        m_interpreter_batch_capacity = batch.size();
+    }
+
     // Copy input data to interpreter
     float* input = interpreter->typed_input_tensor<float>(0);
     memcpy(input, m_input_tensor.data(), m_input_tensor.size() * sizeof(float));
+    memset(input + m_input_tensor.size(), 0, (m_interpreter_batch_capacity - batch.size()) * FEATURE_COUNT * sizeof(float));
 
     // Run inference
     if (interpreter->Invoke() != kTfLiteOk) {
         return Error::from_string_literal("Inference failed");
     }
 
-    // Get output
+    // Get output: [benign, malware] probabilities per sample
     float* output = interpreter->typed_output_tensor<float>(0);
-    m_output_tensor[0] = output[0];  // Benign probability
-    m_output_tensor[1] = output[1];  // Malware probability
-
-    prediction.malware_probability = m_output_tensor[1];
-    prediction.confidence = AK::max(m_output_tensor[0], m_output_tensor[1]);
+    memcpy(m_output_tensor.data(), output, m_output_tensor.size() * sizeof(float));
 
 #elif defined(USE_ML_STUB)
     // ML stub inference - simulated neural network
-    auto output = m_ml_stub->forward(m_input_tensor);
-    VERIFY(output.size() == 2);
-
-    m_output_tensor = output;
-    prediction.malware_probability = output[1];  // Malware class probability
-    prediction.confidence = AK::max(output[0], output[1]);
+    m_ml_stub->forward(m_input_tensor, m_output_tensor);
 
 #else
-    // Heuristic-based scoring fallback
-    float score = 0.0f;
-
-    // High entropy suggests encryption/packing (common in malware)
-    if (features.entropy > 7.0f) score += 0.3f;
-    else if (features.entropy > 6.0f) score += 0.15f;
-
-    // PE anomalies
-    if (features.pe_header_anomalies > 20) score += 0.25f;
-    else if (features.pe_header_anomalies > 5) score += 0.1f;
-
-    // Suspicious strings
-    if (features.suspicious_strings > 50) score += 0.3f;
-    else if (features.suspicious_strings > 20) score += 0.15f;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        auto score = heuristic_malware_score(batch[i]);
+        m_output_tensor[i * CLASS_COUNT] = 1.0f - score;
+        m_output_tensor[i * CLASS_COUNT + 1] = score;
+    }
+#endif
 
-    // Unusual code ratio (too high or too low)
-    if (features.code_section_ratio < 0.2f || features.code_section_ratio > 0.9f)
-        score += 0.15f;
+    return {};
+}
 
-    prediction.malware_probability = min(score, 1.0f);
+MalwareMLDetector::Prediction MalwareMLDetector::make_prediction(Features const& features, [[maybe_unused]] float benign_probability, float malware_probability) const
+{
+    Prediction prediction;
+    prediction.features_used = features;
+    prediction.malware_probability = malware_probability; // Malware class probability
+#if defined(ENABLE_TFLITE) || defined(USE_ML_STUB)
+    prediction.confidence = AK::max(benign_probability, malware_probability);
+#else
     prediction.confidence = 0.85f; // Heuristic confidence
 #endif
-
     prediction.explanation = generate_explanation(features, prediction.malware_probability);
+    return prediction;
+}
 
-    // Update statistics
-    auto elapsed = MonotonicTime::now() - start_time;
-    m_stats.total_predictions++;
-    if (prediction.malware_probability > 0.5f)
-        m_stats.malware_detected++;
-    else
-        m_stats.benign_classified++;
+void MalwareMLDetector::record_predictions(ReadonlySpan<Prediction> predictions, AK::Duration elapsed)
+{
+    // A batch costs one inference, so each of its predictions is charged an equal share
+    auto inference_time_ms = static_cast<float>(elapsed.to_nanoseconds()) / 1'000'000.0f / static_cast<float>(predictions.size());
 
-    m_stats.average_inference_time_ms =
-        (m_stats.average_inference_time_ms * (m_stats.total_predictions - 1) +
-         static_cast<float>(elapsed.to_milliseconds())) / m_stats.total_predictions;
+    for (auto const& prediction : predictions) {
+        m_stats.total_predictions++;
+        if (prediction.malware_probability > 0.5f)
+            m_stats.malware_detected++;
+        else
+            m_stats.benign_classified++;
 
-    m_stats.average_confidence =
-        (m_stats.average_confidence * (m_stats.total_predictions - 1) +
-         prediction.confidence) / m_stats.total_predictions;
+        m_stats.average_inference_time_ms =
+            (m_stats.average_inference_time_ms * (m_stats.total_predictions - 1) +
+             inference_time_ms) / m_stats.total_predictions;
 
-    return prediction;
+        m_stats.average_confidence =
+            (m_stats.average_confidence * (m_stats.total_predictions - 1) +
+             prediction.confidence) / m_stats.total_predictions;
+    }
 }
 
 // Convenience method
-ErrorOr<MalwareMLDetector::Prediction> MalwareMLDetector::analyze_file(ByteBuffer const& file_data)
+ErrorOr<MalwareMLDetector::Prediction> MalwareMLDetector::analyze_file(ReadonlyBytes file_data)
 {
     auto features = TRY(extract_features(file_data));
     return predict(features);
@@ -10,7 +10,9 @@
 #include <AK/Math.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/OwnPtr.h>
+#include <AK/Span.h>
 #include <AK/String.h>
+#include <AK/Time.h>
 #include <AK/Vector.h>
 
 namespace Sentinel {
@@ -27,24 +29,30 @@ struct MalwareMLStub {
     static constexpr size_t OUTPUT_SIZE = 2;
 
     // Simulated weights (in real implementation, loaded from model file)
-    float weights_input_hidden[INPUT_SIZE][HIDDEN_SIZE];
-    float bias_hidden[HIDDEN_SIZE];
-    float weights_hidden_output[HIDDEN_SIZE][OUTPUT_SIZE];
+    // Both layers are stored so the forward pass reads them contiguously, four hidden units at a
+    // time: the input layer by input, and the output layer transposed, by output.
+    alignas(16) float weights_input_hidden[INPUT_SIZE][HIDDEN_SIZE];
+    alignas(16) float bias_hidden[HIDDEN_SIZE];
+    alignas(16) float weights_output_hidden[OUTPUT_SIZE][HIDDEN_SIZE];
     float bias_output[OUTPUT_SIZE];
 
     MalwareMLStub();
     ~MalwareMLStub();
     void initialize_weights();
-    static float relu(float x) { return x > 0 ? x : 0; }
-    static float sigmoid(float x) { return 1.0f / (1.0f + AK::exp(-x)); }
-    Vector<float> forward(Vector<float> const& input);
+
+    // Forward pass over inputs.size() / INPUT_SIZE samples, writing OUTPUT_SIZE softmax
+    // probabilities per sample to outputs. Never allocates.
+    void forward(ReadonlySpan<float> inputs, Span<float> outputs) const;
 };
-#endif
+#endif#endif
 
 // Machine Learning-based malware detection using TensorFlow Lite
 // Milestone 0.4 Phase 1: ML Infrastructure
 class MalwareMLDetector {
 public:
+    static constexpr size_t FEATURE_COUNT = 6;
+    static constexpr size_t CLASS_COUNT = 2; // [benign, malware]
+
     // Feature vector extracted from file for ML model
     struct Features {
         u64 file_size { 0 };
@@ -56,6 +64,9 @@ public:
 
         // Convert to float vector for model input
         Vector<float> to_vector() const;
+
+        // Write the normalized model input to a FEATURE_COUNT-sized span
+        void write_to(Span<float>) const;
     };
 
     // Prediction result from ML model
@@ -81,14 +92,18 @@ public:
 
     ~MalwareMLDetector();
 
-    // Extract features from file data
-    ErrorOr<Features> extract_features(ByteBuffer const& file_data);
+    // Extract features from file data in a single pass; see MalwareFeatureExtractor for chunked input
+    ErrorOr<Features> extract_features(ReadonlyBytes file_data);
 
     // Run prediction on extracted features
     ErrorOr<Prediction> predict(Features const& features);
 
+    // Run prediction on many files at once. The model is invoked once for the whole batch, and the
+    // input and output tensors are reused between batches.
+    ErrorOr<Vector<Prediction>> predict(ReadonlySpan<Features> batch);
+
     // Convenience: extract features and predict in one call
-    ErrorOr<Prediction> analyze_file(ByteBuffer const& file_data);
+    ErrorOr<Prediction> analyze_file(ReadonlyBytes file_data);
 
     // Get detector statistics
     Statistics get_statistics() const;
@@ -104,13 +119,10 @@ private:
     ErrorOr<void> load_model();
     ErrorOr<void> initialize_interpreter();
 
-    // Feature extraction helpers
-    static float calculate_shannon_entropy(ByteBuffer const& data);
-    static u32 count_suspicious_strings(ByteBuffer const& data);
-    static bool is_pe_file(ByteBuffer const& data);
-    static u32 analyze_pe_structure(ByteBuffer const& data);
-    static float calculate_code_ratio(ByteBuffer const& data);
-    static u32 extract_import_table_size(ByteBuffer const& data);
+    // Run the model over m_input_tensor, leaving CLASS_COUNT probabilities per sample in m_output_tensor
+    ErrorOr<void> run_inference(ReadonlySpan<Features> batch);
+    Prediction make_prediction(Features const&, float benign_probability, float malware_probability) const;
+    void record_predictions(ReadonlySpan<Prediction>, AK::Duration elapsed);
 
     // Generate human-readable explanation from features
     static String generate_explanation(Features const& features, float probability);
@@ -124,6 +136,7 @@ private:
 #ifdef ENABLE_TFLITE
     void* m_model { nullptr };       // tflite::FlatBufferModel*
     void* m_interpreter { nullptr }; // tflite::Interpreter*
+    size_t m_interpreter_batch_capacity { 1 };
 #elif defined(USE_ML_STUB)
     // Simplified ML stub for demonstrating ML infrastructure
     OwnPtr<MalwareMLStub> m_ml_stub;
@@ -132,7 +145,7 @@ private:
     [[maybe_unused]] void* m_interpreter { nullptr };
 #endif
 
-    // Model I/O tensors
+    // Model I/O tensors, batch-sized; they keep their capacity between batches
     Vector<float> m_input_tensor;
     Vector<float> m_output_tensor;
 
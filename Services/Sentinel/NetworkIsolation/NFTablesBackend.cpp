@@ -6,6 +6,7 @@
 
 #include "NFTablesBackend.h"
 #include <AK/Debug.h>
+#include <AK/StringBuilder.h>
 #include <LibCore/File.h>
 #include <LibCore/System.h>
 
@@ -48,6 +49,42 @@ ErrorOr<bool> NFTablesBackend::is_available()
     return true;
 }
 
+ErrorOr<Vector<String>> NFTablesBackend::generate_base_rules()
+{
+    Vector<String> commands;
+
+    // Adding and then deleting the table makes the batch replace whatever an earlier run left behind, instead of failing
+    // or duplicating its rules
+    TRY(commands.try_append(TRY(String::formatted("add table inet {}", SENTINEL_TABLE_NAME))));
+    TRY(commands.try_append(TRY(String::formatted("delete table inet {}", SENTINEL_TABLE_NAME))));
+    TRY(commands.try_append(TRY(String::formatted("add table inet {}", SENTINEL_TABLE_NAME))));
+    TRY(commands.try_append(TRY(String::formatted(
+        "add chain inet {} {} {{ type filter hook output priority 0 ; }}",
+        SENTINEL_TABLE_NAME, SENTINEL_CHAIN_NAME))));
+
+    // Isolated processes are matched by the UID they run as, through a set, so isolating a process only adds an element
+    TRY(commands.try_append(TRY(String::formatted(
+        "add set inet {} {} {{ type uid ; }}",
+        SENTINEL_TABLE_NAME, SENTINEL_SET_NAME))));
+
+    // Rule 1: Allow loopback traffic
+    TRY(commands.try_append(TRY(String::formatted(
+        "add rule inet {} {} meta skuid @{} ip daddr 127.0.0.0/8 accept comment \"Sentinel: Allow loopback for isolated processes\"",
+        SENTINEL_TABLE_NAME, SENTINEL_CHAIN_NAME, SENTINEL_SET_NAME))));
+
+    // Rule 2: Log blocked attempts
+    TRY(commands.try_append(TRY(String::formatted(
+        "add rule inet {} {} meta skuid @{} log prefix \"SENTINEL_BLOCK: \" comment \"Sentinel: Log blocked traffic\"",
+        SENTINEL_TABLE_NAME, SENTINEL_CHAIN_NAME, SENTINEL_SET_NAME))));
+
+    // Rule 3: Drop all other traffic
+    TRY(commands.try_append(TRY(String::formatted(
+        "add rule inet {} {} meta skuid @{} drop comment \"Sentinel: Block network for isolated processes\"",
+        SENTINEL_TABLE_NAME, SENTINEL_CHAIN_NAME, SENTINEL_SET_NAME))));
+
+    return commands;
+}
+
 ErrorOr<void> NFTablesBackend::ensure_sentinel_table_exists()
 {
     if (m_table_created)
@@ -55,27 +92,8 @@ ErrorOr<void> NFTablesBackend::ensure_sentinel_table_exists()
 
     dbgln_if(false, "NFTablesBackend: Creating Sentinel isolation table");
 
-    // Create table: nft add table inet sentinel_isolation
-    Vector<String> create_table_args;
-    TRY(create_table_args.try_append("add"_string));
-    TRY(create_table_args.try_append("table"_string));
-    TRY(create_table_args.try_append("inet"_string));
-    TRY(create_table_args.try_append(TRY(String::from_utf8(SENTINEL_TABLE_NAME))));
-
-    // Ignore error if table already exists
-    (void)execute_nft_command(create_table_args);
-
-    // Create output chain: nft add chain inet sentinel_isolation output { type filter hook output priority 0 \; }
-    Vector<String> create_chain_args;
-    TRY(create_chain_args.try_append("add"_string));
-    TRY(create_chain_args.try_append("chain"_string));
-    TRY(create_chain_args.try_append("inet"_string));
-    TRY(create_chain_args.try_append(TRY(String::from_utf8(SENTINEL_TABLE_NAME))));
-    TRY(create_chain_args.try_append(TRY(String::from_utf8(SENTINEL_CHAIN_NAME))));
-    TRY(create_chain_args.try_append("{ type filter hook output priority 0 \\; }"_string));
-
-    // Ignore error if chain already exists
-    (void)execute_nft_command(create_chain_args);
+    // The table, set and rules are created in a single transaction, so there is never a partial ruleset
+    TRY(execute_nft_batch(TRY(generate_base_rules())));
 
     m_table_created = true;
     dbgln_if(false, "NFTablesBackend: Sentinel table created/verified");
@@ -104,10 +122,30 @@ ErrorOr<String> NFTablesBackend::execute_nft_command(Vector<String> const& args)
     return String {};
 }
 
-ErrorOr<Vector<String>> NFTablesBackend::generate_isolation_rules(pid_t pid)
+ErrorOr<void> NFTablesBackend::execute_nft_batch(Vector<String> const& commands)
 {
-    Vector<String> rules;
+    // nft applies everything it reads from one file as a single atomic transaction, so the whole batch costs one
+    // process instead of one per command
+    StringBuilder script_builder;
+    for (auto const& command : commands) {
+        script_builder.append(command);
+        script_builder.append('\n');
+    }
+    auto script = TRY(script_builder.to_string());
 
+    if (m_dry_run) {
+        dbgln("NFTablesBackend: [DRY-RUN] Would execute as one transaction: nft -f -\n{}", script);
+        return {};
+    }
+
+    // Note: Core::command is not available in Ladybird
+    // This would need to be implemented using LibCore::System::spawn, writing the script to nft's stdin
+    dbgln("NFTablesBackend: Would execute nft batch (not implemented)");
+    return {};
+}
+
+ErrorOr<uid_t> NFTablesBackend::uid_of_process(pid_t pid)
+{
     // nftables uses 'meta skuid' to match process owner
     // We need to get the UID of the process
     auto stat_path = TRY(String::formatted("/proc/{}/status", pid));
@@ -117,76 +155,19 @@ ErrorOr<Vector<String>> NFTablesBackend::generate_isolation_rules(pid_t pid)
 
     // Parse UID from status file
     auto lines = TRY(stat_content.split('\n'));
-    uid_t uid = 0;
     for (auto const& line : lines) {
         if (line.starts_with_bytes("Uid:"sv)) {
             auto parts = TRY(line.split('\t'));
             if (parts.size() >= 2) {
                 auto uid_str = TRY(parts[1].trim(" \t"sv));
                 auto uid_opt = uid_str.to_number<uid_t>();
-                if (uid_opt.has_value()) {
-                    uid = uid_opt.value();
-                    break;
-                }
+                if (uid_opt.has_value())
+                    return uid_opt.value();
             }
         }
     }
 
-    // Rule 1: Allow loopback traffic
-    auto loopback_rule = TRY(String::formatted(
-        "add rule inet {} {} meta skuid {} ip daddr 127.0.0.0/8 accept comment \"Sentinel: Allow loopback for UID {} (PID {})\"",
-        SENTINEL_TABLE_NAME, SENTINEL_CHAIN_NAME, uid, uid, pid));
-    TRY(rules.try_append(loopback_rule));
-
-    // Rule 2: Log blocked attempts
-    auto log_rule = TRY(String::formatted(
-        "add rule inet {} {} meta skuid {} log prefix \"SENTINEL_BLOCK_UID_{}_PID_{}: \" comment \"Sentinel: Log blocked traffic for PID {}\"",
-        SENTINEL_TABLE_NAME, SENTINEL_CHAIN_NAME, uid, uid, pid, pid));
-    TRY(rules.try_append(log_rule));
-
-    // Rule 3: Drop all other traffic
-    auto drop_rule = TRY(String::formatted(
-        "add rule inet {} {} meta skuid {} drop comment \"Sentinel: Block network for PID {}\"",
-        SENTINEL_TABLE_NAME, SENTINEL_CHAIN_NAME, uid, pid));
-    TRY(rules.try_append(drop_rule));
-
-    return rules;
-}
-
-ErrorOr<void> NFTablesBackend::apply_rule(String const& rule)
-{
-    // Parse rule into arguments
-    auto parts = TRY(rule.split(' '));
-    Vector<String> args;
-
-    for (auto const& part : parts) {
-        if (!part.is_empty()) {
-            TRY(args.try_append(part));
-        }
-    }
-
-    TRY(execute_nft_command(args));
-    return {};
-}
-
-ErrorOr<void> NFTablesBackend::remove_rule(String const& rule)
-{
-    // For nftables, we need to find and delete the rule by handle
-    // This is complex, so we'll use a simpler approach: flush rules matching our pattern
-
-    // Extract PID from rule comment
-    auto comment_start = rule.find_byte_offset("PID "sv);
-    if (!comment_start.has_value())
-        return {};
-
-    // We'll reconstruct the command to delete this specific rule
-    // This is a simplified approach - in production, we'd track rule handles
-
-    // We'll reconstruct the command to delete this specific rule
-    // This is a simplified approach - in production, we'd track rule handles
-    dbgln_if(false, "NFTablesBackend: Rule removal for nftables is handled via cleanup_all_rules()");
-
-    return {};
+    return Error::from_string_literal("Unable to find the UID of the process");
 }
 
 ErrorOr<Vector<String>> NFTablesBackend::apply_isolation(pid_t pid)
@@ -195,26 +176,55 @@ ErrorOr<Vector<String>> NFTablesBackend::apply_isolation(pid_t pid)
 
     TRY(ensure_sentinel_table_exists());
 
-    auto rules = TRY(generate_isolation_rules(pid));
+    if (m_isolated_process_uids.contains(pid))
+        return Vector<String> {};
 
-    // Apply rules in order
-    for (auto const& rule : rules) {
-        TRY(apply_rule(rule));
+    auto uid = TRY(uid_of_process(pid));
+
+    Vector<String> commands;
+    auto& count = m_isolated_uid_counts.ensure(uid, [] { return 0uz; });
+    if (count == 0) {
+        TRY(commands.try_append(TRY(String::formatted(
+            "add element inet {} {} {{ {} }}",
+            SENTINEL_TABLE_NAME, SENTINEL_SET_NAME, uid))));
+
+        auto result = execute_nft_batch(commands);
+        if (result.is_error()) {
+            m_isolated_uid_counts.remove(uid);
+            return result.release_error();
+        }
     }
 
-    dbgln_if(false, "NFTablesBackend: Applied {} rules for PID {}", rules.size(), pid);
-    return rules;
+    ++count;
+    m_isolated_process_uids.set(pid, uid);
+
+    dbgln_if(false, "NFTablesBackend: Applied {} rules for PID {}", commands.size(), pid);
+    return commands;
 }
 
 ErrorOr<void> NFTablesBackend::remove_isolation(pid_t pid, Vector<String> const& /* rules */)
 {
     dbgln_if(false, "NFTablesBackend: Removing isolation rules for PID {}", pid);
 
-    // For nftables, we'll rely on cleanup_all_rules() since individual rule deletion
-    // by handle is complex. Rules will be removed when process exits and
-    // cleanup_all_rules() is called periodically.
+    auto uid = m_isolated_process_uids.take(pid);
+    if (!uid.has_value())
+        return {};
+
+    // Other isolated processes may still be running as the same user
+    auto count = m_isolated_uid_counts.get(*uid).value_or(1);
+    if (count > 1) {
+        m_isolated_uid_counts.set(*uid, count - 1);
+        return {};
+    }
+    m_isolated_uid_counts.remove(*uid);
+
+    Vector<String> commands;
+    TRY(commands.try_append(TRY(String::formatted(
+        "delete element inet {} {} {{ {} }}",
+        SENTINEL_TABLE_NAME, SENTINEL_SET_NAME, *uid))));
+    TRY(execute_nft_batch(commands));
 
-    dbgln_if(false, "NFTablesBackend: Rule removal scheduled for PID {}", pid);
+    dbgln_if(false, "NFTablesBackend: Removed isolation for PID {}", pid);
     return {};
 }
 
@@ -252,6 +262,8 @@ ErrorOr<void> NFTablesBackend::cleanup_all_rules()
     }
 
     m_table_created = false;
+    m_isolated_process_uids.clear();
+    m_isolated_uid_counts.clear();
     dbgln("NFTablesBackend: Cleaned up Sentinel table");
     return {};
 }
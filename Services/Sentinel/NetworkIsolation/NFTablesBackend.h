@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Error.h>
+#include <AK/HashMap.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 
@@ -22,6 +23,7 @@ public:
     static ErrorOr<bool> is_available();
 
     // Apply isolation rules for a process
+    // Returns the commands that were applied for this process, which only add its UID to the isolated set
     ErrorOr<Vector<String>> apply_isolation(pid_t pid);
 
     // Remove isolation rules for a process
@@ -30,19 +32,27 @@ public:
     // Remove all Sentinel-created rules
     ErrorOr<void> cleanup_all_rules();
 
+    // The commands that create the Sentinel table, the set of isolated UIDs, and the rules matching against that set
+    static ErrorOr<Vector<String>> generate_base_rules();
+
 private:
     explicit NFTablesBackend(bool dry_run);
 
     ErrorOr<void> ensure_sentinel_table_exists();
     ErrorOr<String> execute_nft_command(Vector<String> const& args);
-    ErrorOr<Vector<String>> generate_isolation_rules(pid_t pid);
-    ErrorOr<void> apply_rule(String const& rule);
-    ErrorOr<void> remove_rule(String const& rule);
+    ErrorOr<void> execute_nft_batch(Vector<String> const& commands);
+    static ErrorOr<uid_t> uid_of_process(pid_t pid);
 
     bool m_dry_run;
     bool m_table_created;
+
+    // Several isolated processes may run as the same user, and their UID must stay in the set until the last one is gone
+    HashMap<pid_t, uid_t> m_isolated_process_uids;
+    HashMap<uid_t, size_t> m_isolated_uid_counts;
+
     static constexpr auto SENTINEL_TABLE_NAME = "sentinel_isolation"sv;
     static constexpr auto SENTINEL_CHAIN_NAME = "output"sv;
+    static constexpr auto SENTINEL_SET_NAME = "isolated_uids"sv;
 };
 
 }
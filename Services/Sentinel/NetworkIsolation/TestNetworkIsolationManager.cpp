@@ -85,21 +85,20 @@ TEST_CASE(nftables_rule_generation)
 
     auto backend = backend_result.release_value();
 
-    // Use our own PID for testing
-    pid_t test_pid = getpid();
-    auto rules = backend->apply_isolation(test_pid);
+    // The shared rules match against the set of isolated UIDs
+    auto base_rules = MUST(NFTablesBackend::generate_base_rules());
 
-    EXPECT(!rules.is_error());
-
-    auto rule_list = rules.release_value();
-    EXPECT(rule_list.size() == 3);
-
-    // Check that rules contain expected patterns
+    bool has_set = false;
     bool has_loopback = false;
     bool has_log = false;
     bool has_drop = false;
 
-    for (auto const& rule : rule_list) {
+    for (auto const& rule : base_rules) {
+        if (rule.starts_with_bytes("add set"sv))
+            has_set = true;
+        if (!rule.starts_with_bytes("add rule"sv))
+            continue;
+        EXPECT(rule.contains("@isolated_uids"sv));
         if (rule.contains("127.0.0"sv))
             has_loopback = true;
         if (rule.contains("log"sv))
@@ -108,9 +107,26 @@ TEST_CASE(nftables_rule_generation)
             has_drop = true;
     }
 
+    EXPECT(has_set);
     EXPECT(has_loopback);
     EXPECT(has_log);
     EXPECT(has_drop);
+
+    // Isolating a process only adds its UID to the set
+    pid_t test_pid = getpid();
+    auto rules = backend->apply_isolation(test_pid);
+
+    EXPECT(!rules.is_error());
+
+    auto rule_list = rules.release_value();
+    EXPECT_EQ(rule_list.size(), 1u);
+    EXPECT(rule_list[0].starts_with_bytes("add element"sv));
+    EXPECT(rule_list[0].contains(MUST(String::number(getuid()))));
+
+    // Isolating it again doesn't change anything
+    EXPECT(MUST(backend->apply_isolation(test_pid)).is_empty());
+
+    EXPECT(!backend->remove_isolation(test_pid, rule_list).is_error());
 }
 
 TEST_CASE(process_monitoring)
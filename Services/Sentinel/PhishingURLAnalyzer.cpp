@@ -53,7 +53,33 @@ Vector<ByteString> const& PhishingURLAnalyzer::suspicious_tlds()
 
 ErrorOr<NonnullOwnPtr<PhishingURLAnalyzer>> PhishingURLAnalyzer::create()
 {
-    return adopt_own(*new PhishingURLAnalyzer());
+    auto analyzer = adopt_own(*new PhishingURLAnalyzer());
+    TRY(analyzer->build_popular_domain_index());
+    return analyzer;
+}
+
+ErrorOr<void> PhishingURLAnalyzer::build_popular_domain_index()
+{
+    auto const& domains = popular_domains();
+
+    Vector<String> skeletons;
+    TRY(skeletons.try_ensure_capacity(domains.size()));
+    for (auto const& domain : domains)
+        skeletons.unchecked_append(TRY(normalize_to_skeleton(name_without_tld(domain))));
+
+    Vector<StringView> keys;
+    TRY(keys.try_ensure_capacity(skeletons.size()));
+    for (auto const& skeleton : skeletons)
+        keys.unchecked_append(skeleton.bytes_as_string_view());
+
+    m_popular_domain_index = TRY(TyposquatIndex::create(keys, MAX_TYPOSQUAT_DISTANCE));
+    return {};
+}
+
+StringView PhishingURLAnalyzer::name_without_tld(StringView domain)
+{
+    auto dot_pos = domain.find_last('.');
+    return dot_pos.has_value() ? domain.substring_view(0, dot_pos.value()) : domain;
 }
 
 // Extract domain from URL (e.g., "https://example.com/path" -> "example.com")
@@ -102,22 +128,33 @@ ErrorOr<bool> PhishingURLAnalyzer::detect_homograph(StringView domain)
     return result > 0;
 }
 
+// Opening a spoofchecker loads ICU's confusables data, so skeletons share one process-wide checker.
+// ICU allows a configured checker to be used from several threads at once.
+static USpoofChecker const* skeleton_checker()
+{
+    static USpoofChecker const* const checker = []() -> USpoofChecker const* {
+        UErrorCode status = U_ZERO_ERROR;
+        USpoofChecker* checker = uspoof_open(&status);
+        if (U_FAILURE(status))
+            return nullptr;
+        return checker;
+    }();
+    return checker;
+}
+
 // Normalize domain to skeleton (confusables -> ASCII equivalents)
 ErrorOr<String> PhishingURLAnalyzer::normalize_to_skeleton(StringView domain)
 {
-    UErrorCode status = U_ZERO_ERROR;
-
-    USpoofChecker* checker = uspoof_open(&status);
-    if (U_FAILURE(status))
+    auto const* checker = skeleton_checker();
+    if (!checker)
         return Error::from_string_literal("Failed to create ICU spoofchecker");
 
+    UErrorCode status = U_ZERO_ERROR;
     char skeleton[256];
     int32_t skeleton_len = uspoof_getSkeletonUTF8(checker, 0,
         reinterpret_cast<char const*>(domain.characters_without_null_termination()),
         domain.length(), skeleton, sizeof(skeleton), &status);
 
-    uspoof_close(checker);
-
     if (U_FAILURE(status) || skeleton_len < 0)
         return Error::from_string_literal("Failed to generate skeleton");
 
@@ -154,33 +191,17 @@ int PhishingURLAnalyzer::levenshtein_distance(StringView a, StringView b)
     return distance[m][n];
 }
 
-// Find closest popular domain by Levenshtein distance
-ErrorOr<ByteString> PhishingURLAnalyzer::find_closest_popular_domain(StringView domain, int& out_distance)
+// Find closest popular domain by edit distance between skeletons, so that lookalike characters
+// ("paypa1", "rnicrosoft") count the same as typos
+ErrorOr<Optional<PhishingURLAnalyzer::DomainMatch>> PhishingURLAnalyzer::find_closest_popular_domain(StringView domain_name) const
 {
-    auto const& domains = popular_domains();
-
-    int min_distance = INT_MAX;
-    ByteString closest_domain;
-
-    for (auto const& popular_domain : domains) {
-        // Extract domain name from popular domain (e.g., "paypal.com" -> "paypal")
-        auto popular_domain_sv = StringView(popular_domain);
-        auto dot_pos = popular_domain_sv.find_last('.');
-        StringView popular_domain_name = dot_pos.has_value()
-            ? popular_domain_sv.substring_view(0, dot_pos.value())
-            : popular_domain_sv;
+    auto skeleton = TRY(normalize_to_skeleton(domain_name));
 
-        // Compare domain names without TLDs
-        auto distance = levenshtein_distance(domain, popular_domain_name);
-
-        if (distance < min_distance) {
-            min_distance = distance;
-            closest_domain = popular_domain;
-        }
-    }
+    auto match = m_popular_domain_index.find_closest(skeleton);
+    if (!match.has_value())
+        return Optional<DomainMatch> {};
 
-    out_distance = min_distance;
-    return closest_domain;
+    return Optional<DomainMatch> { DomainMatch { popular_domains()[match->index], match->distance } };
 }
 
 // Check if TLD is suspicious
@@ -257,17 +278,21 @@ ErrorOr<PhishingURLAnalyzer::AnalysisResult> PhishingURLAnalyzer::analyze_url(St
     }
 
     // 2. Typosquatting detection (25% weight)
-    int edit_distance = 0;
-    auto closest_result = find_closest_popular_domain(domain_name, edit_distance);
-    if (!closest_result.is_error()) {
-        result.closest_legitimate_domain = MUST(String::from_utf8(StringView(closest_result.value())));
+    auto closest_result = find_closest_popular_domain(domain_name);
+    if (!closest_result.is_error() && closest_result.value().has_value()) {
+        auto const& closest = closest_result.value().value();
+        result.closest_legitimate_domain = MUST(String::from_utf8(closest.domain.view()));
 
-        // Consider it typosquatting if edit distance is 1-3
-        if (edit_distance > 0 && edit_distance <= 3) {
+        // Within MAX_TYPOSQUAT_DISTANCE of a popular domain, but not that domain itself
+        if (domain_name != name_without_tld(closest.domain)) {
             result.is_typosquatting = true;
             result.phishing_score += 0.25f;
-            reasons.append(MUST(String::formatted("Similar to legitimate domain '{}' (edit distance: {})",
-                closest_result.value(), edit_distance)));
+            if (closest.distance == 0) {
+                reasons.append(MUST(String::formatted("Visually identical to legitimate domain '{}'", closest.domain)));
+            } else {
+                reasons.append(MUST(String::formatted("Similar to legitimate domain '{}' (edit distance: {})",
+                    closest.domain, closest.distance)));
+            }
         }
     }
 
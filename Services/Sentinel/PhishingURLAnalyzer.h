@@ -5,8 +5,10 @@
 
 #pragma once
 
+#include "TyposquatIndex.h"
 #include <AK/ByteString.h>
 #include <AK/Error.h>
+#include <AK/Optional.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
 
@@ -27,6 +29,14 @@ public:
         String closest_legitimate_domain;   // If typosquatting detected
     };
 
+    // Popular domains whose skeleton is at most this many edits from a domain's skeleton count as lookalikes
+    static constexpr int MAX_TYPOSQUAT_DISTANCE = 3;
+
+    struct DomainMatch {
+        ByteString domain; // Popular domain, including its TLD
+        int distance { 0 }; // Edit distance between the skeletons of the two names
+    };
+
     static ErrorOr<NonnullOwnPtr<PhishingURLAnalyzer>> create();
     ~PhishingURLAnalyzer() = default;
 
@@ -37,13 +47,16 @@ public:
     static ErrorOr<bool> detect_homograph(StringView domain);
     static ErrorOr<String> normalize_to_skeleton(StringView domain);
     static int levenshtein_distance(StringView a, StringView b);
-    static ErrorOr<ByteString> find_closest_popular_domain(StringView domain, int& out_distance);
+    // Closest popular domain to a domain name (without its TLD), compared by skeleton
+    ErrorOr<Optional<DomainMatch>> find_closest_popular_domain(StringView domain_name) const;
     static bool is_suspicious_tld(StringView tld);
     static float calculate_domain_entropy(StringView domain);
 
 private:
     PhishingURLAnalyzer() = default;
 
+    ErrorOr<void> build_popular_domain_index();
+
     // Popular domains to check against for typosquatting
     static Vector<ByteString> const& popular_domains();
 
@@ -52,6 +65,12 @@ private:
 
     // Extract domain from full URL
     static ErrorOr<String> extract_domain(StringView url);
+
+    // Strip the TLD (e.g., "paypal.com" -> "paypal")
+    static StringView name_without_tld(StringView domain);
+
+    // Skeletons of popular_domains() names, in the same order, built once in create()
+    TyposquatIndex m_popular_domain_index;
 };
 
 }
@@ -8,17 +8,20 @@
 #include "DatabaseMigrations.h"
 #include "InputValidator.h"
 #include "PolicyTemplates.h"
+#include "SentinelMetrics.h"
 #include "Quarantine/QuarantineManager.h"
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/ScopeGuard.h>
 #include <AK/StringBuilder.h>
 #include <LibCore/RetryPolicy.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibCrypto/ConstantTimeComparison.h>
 #include <LibFileSystem/FileSystem.h>
+#include <LibThreading/Thread.h>
 
 namespace Sentinel {
 
@@ -186,7 +189,7 @@ ErrorOr<NonnullOwnPtr<PolicyGraph>> PolicyGraph::create(ByteString const& db_dir
 
     // Create/open database
     // FIXME: Re-add retry logic once RetryPolicy template is fixed
-    auto database = TRY(Database::Database::create(db_directory, "policy_graph"sv));
+    auto database = TRY(Database::Database::create(db_directory, "policy_graph"sv, Database::Profile::Telemetry));
 
     // Create policies table
     auto create_policies_table = TRY(database->prepare_statement(R"#(
@@ -555,8 +558,8 @@ ErrorOr<NonnullOwnPtr<PolicyGraph>> PolicyGraph::create(ByteString const& db_dir
         INSERT INTO sandbox_verdicts
             (file_hash, threat_level, confidence, composite_score, verdict_explanation,
              yara_score, ml_score, behavioral_score, triggered_rules, detected_behaviors,
-             analyzed_at, expires_at)
-        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+             analyzed_at, expires_at, rules_version)
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
         ON CONFLICT(file_hash) DO UPDATE SET
             threat_level = excluded.threat_level,
             confidence = excluded.confidence,
@@ -568,11 +571,15 @@ ErrorOr<NonnullOwnPtr<PolicyGraph>> PolicyGraph::create(ByteString const& db_dir
             triggered_rules = excluded.triggered_rules,
             detected_behaviors = excluded.detected_behaviors,
             analyzed_at = excluded.analyzed_at,
-            expires_at = excluded.expires_at;
+            expires_at = excluded.expires_at,
+            rules_version = excluded.rules_version;
     )#"sv));
 
     statements.lookup_sandbox_verdict = TRY(database->prepare_statement(
-        "SELECT * FROM sandbox_verdicts WHERE file_hash = ? AND expires_at > ?;"sv));
+        "SELECT file_hash, threat_level, confidence, composite_score, verdict_explanation, "
+        "yara_score, ml_score, behavioral_score, triggered_rules, detected_behaviors, "
+        "analyzed_at, expires_at, rules_version "
+        "FROM sandbox_verdicts WHERE file_hash = ? AND expires_at > ?;"sv));
 
     statements.invalidate_verdict = TRY(database->prepare_statement(
         "DELETE FROM sandbox_verdicts WHERE file_hash = ?;"sv));
@@ -630,6 +637,8 @@ ErrorOr<NonnullOwnPtr<PolicyGraph>> PolicyGraph::create(ByteString const& db_dir
     if (seed_result.is_error())
         dbgln("PolicyGraph: Warning - failed to seed builtin templates: {}", seed_result.error());
 
+    TRY(policy_graph->rebuild_policy_index());
+
     return policy_graph;
 }
 
@@ -643,6 +652,8 @@ PolicyGraph::PolicyGraph(NonnullRefPtr<Database::Database> database, Statements
 
 ErrorOr<i64> PolicyGraph::create_policy(Policy const& policy)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     // SECURITY: Validate all policy inputs before database insertion
     TRY(validate_policy_inputs(policy));
 
@@ -721,11 +732,19 @@ ErrorOr<i64> PolicyGraph::create_policy(Policy const& policy)
 
     // Invalidate cache since policies changed
     m_cache.invalidate();
+    TRY(index_policy(TRY(load_policy(last_id))));
 
     return last_id;
 }
 
 ErrorOr<PolicyGraph::Policy> PolicyGraph::get_policy(i64 policy_id)
+{
+    Sync::MutexLocker locker(m_database_mutex);
+    TRY(flush_pending_writes());
+    return load_policy(policy_id);
+}
+
+ErrorOr<PolicyGraph::Policy> PolicyGraph::load_policy(i64 policy_id)
 {
     Optional<Policy> result;
 
@@ -783,6 +802,9 @@ ErrorOr<PolicyGraph::Policy> PolicyGraph::get_policy(i64 policy_id)
 
 ErrorOr<Vector<PolicyGraph::Policy>> PolicyGraph::list_policies()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+    TRY(flush_pending_writes());
+
     Vector<Policy> policies;
 
     m_database->execute_statement(
@@ -835,6 +857,8 @@ ErrorOr<Vector<PolicyGraph::Policy>> PolicyGraph::list_policies()
 
 ErrorOr<void> PolicyGraph::update_policy(i64 policy_id, Policy const& policy)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     // SECURITY: Validate all policy inputs before database update
     TRY(validate_policy_inputs(policy));
 
@@ -861,16 +885,22 @@ ErrorOr<void> PolicyGraph::update_policy(i64 policy_id, Policy const& policy)
 
     // Invalidate cache since policies changed
     m_cache.invalidate();
+    unindex_policy(policy_id);
+    if (auto updated_policy = load_policy(policy_id); !updated_policy.is_error())
+        TRY(index_policy(updated_policy.release_value()));
 
     return {};
 }
 
 ErrorOr<void> PolicyGraph::delete_policy(i64 policy_id)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     m_database->execute_statement(m_statements.delete_policy, {}, policy_id);
 
     // Invalidate cache since policies changed
     m_cache.invalidate();
+    unindex_policy(policy_id);
 
     return {};
 }
@@ -897,8 +927,96 @@ ErrorOr<String> PolicyGraph::compute_cache_key(ThreatMetadata const& threat) con
     return TRY(String::formatted("{:x}", hash_value));
 }
 
+ErrorOr<void> PolicyGraph::rebuild_policy_index()
+{
+    Sync::MutexLocker locker(m_database_mutex);
+
+    auto policies = TRY(list_policies());
+    m_policy_matcher.clear();
+    m_indexed_policies.clear();
+    for (auto& policy : policies)
+        TRY(add_policy_to_index(move(policy)));
+
+    // NB: Compiling rebuilds the whole URL automaton, so only do it once the batch is complete.
+    compile_policy_index();
+    return {};
+}
+
+ErrorOr<void> PolicyGraph::index_policy(Policy policy)
+{
+    TRY(add_policy_to_index(move(policy)));
+    compile_policy_index();
+    return {};
+}
+
+ErrorOr<void> PolicyGraph::add_policy_to_index(Policy policy)
+{
+    TRY(m_policy_matcher.add({
+        .policy_id = policy.id,
+        .rule_name = policy.rule_name,
+        .url_pattern = policy.url_pattern,
+        .file_hash = policy.file_hash,
+        .expires_at_ms = policy.expires_at.has_value() ? policy.expires_at->milliseconds_since_epoch() : -1,
+    }));
+    TRY(m_indexed_policies.try_set(policy.id, move(policy)));
+    return {};
+}
+
+void PolicyGraph::compile_policy_index()
+{
+    // Compile now so matching never has to; if this fails, matching falls back to checking every URL pattern
+    auto compile_result = m_policy_matcher.compile();
+    if (compile_result.is_error())
+        dbgln("PolicyGraph: Failed to compile URL pattern index: {}", compile_result.error());
+}
+
+void PolicyGraph::unindex_policy(i64 policy_id)
+{
+    m_policy_matcher.remove(policy_id);
+    m_indexed_policies.remove(policy_id);
+}
+
 ErrorOr<Optional<PolicyGraph::Policy>> PolicyGraph::match_policy(ThreatMetadata const& threat)
 {
+    // The index answers without touching the database, so every query counts as a cache hit
+    auto query_start = MonotonicTime::now();
+    ScopeGuard record_query = [&] {
+        MetricsCollector::the().record_policy_query(MonotonicTime::now() - query_start, true);
+    };
+
+    Sync::MutexLocker locker(m_database_mutex);
+
+    auto now = UnixDateTime::now().milliseconds_since_epoch();
+    auto policy_id = m_policy_matcher.match(threat.file_hash, threat.url, threat.rule_name, now);
+    if (!policy_id.has_value())
+        return Optional<Policy> {};
+
+    auto it = m_indexed_policies.find(*policy_id);
+    VERIFY(it != m_indexed_policies.end());
+
+    // Like the SQL path, return the policy as it was before this hit is counted
+    Optional<Policy> match = it->value;
+
+    // Update hit statistics, keeping the indexed copy in step with the database
+    it->value.hit_count++;
+    it->value.last_hit = UnixDateTime::from_milliseconds_since_epoch(now);
+    submit_write([this, now, id = *policy_id] {
+        m_database->execute_statement(m_statements.increment_hit_count, {}, now, id);
+    });
+
+    return match;
+}
+
+ErrorOr<Optional<PolicyGraph::Policy>> PolicyGraph::match_policy_using_database(ThreatMetadata const& threat)
+{
+    auto query_start = MonotonicTime::now();
+    bool answered_from_cache = false;
+    ScopeGuard record_query = [&] {
+        MetricsCollector::the().record_policy_query(MonotonicTime::now() - query_start, answered_from_cache);
+    };
+
+    Sync::MutexLocker locker(m_database_mutex);
+
     // Try to generate cache key - if it fails, we skip caching but continue
     Optional<String> cache_key;
     auto cache_key_result = compute_cache_key(threat);
@@ -917,11 +1035,13 @@ ErrorOr<Optional<PolicyGraph::Policy>> PolicyGraph::match_policy(ThreatMetadata
             auto policy_id = cached_result.value();
             if (!policy_id.has_value()) {
                 // Cached "no match"
+                answered_from_cache = true;
                 return Optional<Policy> {};
             }
 
             // Cached policy ID - fetch and return policy
-            auto policy_result = get_policy(policy_id.value());
+            // NB: Skip the flush get_policy() does; queued hit counts do not affect matching
+            auto policy_result = load_policy(policy_id.value());
             if (policy_result.is_error()) {
                 // Policy was deleted or invalid, invalidate cache entry
                 m_cache.cache_policy(cache_key.value(), {});
@@ -929,7 +1049,10 @@ ErrorOr<Optional<PolicyGraph::Policy>> PolicyGraph::match_policy(ThreatMetadata
             } else {
                 // Update hit statistics
                 auto now = UnixDateTime::now().milliseconds_since_epoch();
-                m_database->execute_statement(m_statements.increment_hit_count, {}, now, policy_id.value());
+                submit_write([this, now, id = policy_id.value()] {
+                    m_database->execute_statement(m_statements.increment_hit_count, {}, now, id);
+                });
+                answered_from_cache = true;
                 return policy_result.value();
             }
         }
@@ -985,7 +1108,9 @@ ErrorOr<Optional<PolicyGraph::Policy>> PolicyGraph::match_policy(ThreatMetadata
 
         if (match.has_value()) {
             // Update hit statistics
-            m_database->execute_statement(m_statements.increment_hit_count, {}, now, match->id);
+            submit_write([this, now, id = match->id] {
+                m_database->execute_statement(m_statements.increment_hit_count, {}, now, id);
+            });
             // Cache the match (only if cache key is available)
             if (cache_key.has_value())
                 m_cache.cache_policy(cache_key.value(), match->id);
@@ -1039,7 +1164,9 @@ ErrorOr<Optional<PolicyGraph::Policy>> PolicyGraph::match_policy(ThreatMetadata
         );
 
         if (match.has_value()) {
-            m_database->execute_statement(m_statements.increment_hit_count, {}, now, match->id);
+            submit_write([this, now, id = match->id] {
+                m_database->execute_statement(m_statements.increment_hit_count, {}, now, id);
+            });
             // Cache the match (only if cache key is available)
             if (cache_key.has_value())
                 m_cache.cache_policy(cache_key.value(), match->id);
@@ -1093,7 +1220,9 @@ ErrorOr<Optional<PolicyGraph::Policy>> PolicyGraph::match_policy(ThreatMetadata
         );
 
         if (match.has_value()) {
-            m_database->execute_statement(m_statements.increment_hit_count, {}, now, match->id);
+            submit_write([this, now, id = match->id] {
+                m_database->execute_statement(m_statements.increment_hit_count, {}, now, id);
+            });
             // Cache the match (only if cache key is available)
             if (cache_key.has_value())
                 m_cache.cache_policy(cache_key.value(), match->id);
@@ -1114,27 +1243,33 @@ ErrorOr<void> PolicyGraph::record_threat(ThreatMetadata const& threat,
                                         Optional<i64> policy_id,
                                         String alert_json)
 {
-    m_database->execute_statement(
-        m_statements.record_threat,
-        {},
-        UnixDateTime::now().milliseconds_since_epoch(),
-        threat.url,
-        threat.filename,
-        threat.file_hash,
-        threat.mime_type,
-        threat.file_size,
-        threat.rule_name,
-        threat.severity,
-        action_taken,
-        policy_id.has_value() ? policy_id.value() : -1,
-        alert_json
-    );
+    // The detection time is taken now, not when the write is flushed
+    submit_write([this, detected_at = UnixDateTime::now().milliseconds_since_epoch(), threat, action_taken = move(action_taken), policy_id, alert_json = move(alert_json)] {
+        m_database->execute_statement(
+            m_statements.record_threat,
+            {},
+            detected_at,
+            threat.url,
+            threat.filename,
+            threat.file_hash,
+            threat.mime_type,
+            threat.file_size,
+            threat.rule_name,
+            threat.severity,
+            action_taken,
+            policy_id.has_value() ? policy_id.value() : -1,
+            alert_json
+        );
+    });
 
     return {};
 }
 
 ErrorOr<Vector<PolicyGraph::ThreatRecord>> PolicyGraph::get_threat_history(Optional<UnixDateTime> since)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+    TRY(flush_pending_writes());
+
     Vector<ThreatRecord> threats;
 
     if (since.has_value()) {
@@ -1197,6 +1332,9 @@ ErrorOr<Vector<PolicyGraph::ThreatRecord>> PolicyGraph::get_threat_history(Optio
 
 ErrorOr<Vector<PolicyGraph::ThreatRecord>> PolicyGraph::get_threats_by_rule(String const& rule_name)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+    TRY(flush_pending_writes());
+
     Vector<ThreatRecord> threats;
 
     m_database->execute_statement(
@@ -1233,17 +1371,30 @@ ErrorOr<Vector<PolicyGraph::ThreatRecord>> PolicyGraph::get_threats_by_rule(Stri
 
 ErrorOr<void> PolicyGraph::cleanup_expired_policies()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     auto now = UnixDateTime::now().milliseconds_since_epoch();
     m_database->execute_statement(m_statements.delete_expired_policies, {}, now);
 
     // Invalidate cache since policies changed
     m_cache.invalidate();
 
+    Vector<i64> expired_policy_ids;
+    for (auto const& [policy_id, policy] : m_indexed_policies) {
+        if (policy.expires_at.has_value() && policy.expires_at->milliseconds_since_epoch() <= now)
+            TRY(expired_policy_ids.try_append(policy_id));
+    }
+    for (auto policy_id : expired_policy_ids)
+        unindex_policy(policy_id);
+    TRY(m_policy_matcher.compile());
+
     return {};
 }
 
 ErrorOr<u64> PolicyGraph::get_policy_count()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     u64 count = 0;
     m_database->execute_statement(
         m_statements.count_policies,
@@ -1256,6 +1407,9 @@ ErrorOr<u64> PolicyGraph::get_policy_count()
 
 ErrorOr<u64> PolicyGraph::get_threat_count()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+    TRY(flush_pending_writes());
+
     u64 count = 0;
     m_database->execute_statement(
         m_statements.count_threats,
@@ -1334,6 +1488,9 @@ String PolicyGraph::match_type_to_string(PolicyMatchType type)
 
 ErrorOr<void> PolicyGraph::cleanup_old_threats(u64 days_to_keep)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+    TRY(flush_pending_writes());
+
     // Calculate cutoff timestamp
     auto now = UnixDateTime::now();
     auto cutoff_timestamp = now.seconds_since_epoch() - (days_to_keep * 24 * 60 * 60);
@@ -1349,6 +1506,9 @@ ErrorOr<void> PolicyGraph::cleanup_old_threats(u64 days_to_keep)
 
 ErrorOr<void> PolicyGraph::vacuum_database()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+    TRY(flush_pending_writes());
+
     dbgln("PolicyGraph: Vacuuming database to reclaim space");
 
     // VACUUM command compacts the SQLite database
@@ -1362,6 +1522,8 @@ ErrorOr<void> PolicyGraph::vacuum_database()
 
 ErrorOr<void> PolicyGraph::verify_database_integrity()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     dbgln("PolicyGraph: Verifying database integrity");
 
     // Use SQLite's PRAGMA integrity_check
@@ -1392,6 +1554,8 @@ ErrorOr<void> PolicyGraph::verify_database_integrity()
 
 bool PolicyGraph::is_database_healthy()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     // Quick health check without full integrity verification
     if (!m_database_healthy) {
         return false;
@@ -1412,22 +1576,28 @@ bool PolicyGraph::is_database_healthy()
 
 ErrorOr<void> PolicyGraph::begin_transaction()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     dbgln("PolicyGraph: Beginning transaction");
 
     // Execute BEGIN TRANSACTION
     // Note: execute_statement uses SQL_MUST which crashes on error
     // We rely on SQLite's transaction semantics for safety
     m_database->execute_statement(m_statements.begin_transaction, {});
+    m_in_explicit_transaction = true;
 
     return {};
 }
 
 ErrorOr<void> PolicyGraph::commit_transaction()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     dbgln("PolicyGraph: Committing transaction");
 
     // Execute COMMIT TRANSACTION
     m_database->execute_statement(m_statements.commit_transaction, {});
+    m_in_explicit_transaction = false;
 
     // Invalidate cache since database state changed
     m_cache.invalidate();
@@ -1437,21 +1607,175 @@ ErrorOr<void> PolicyGraph::commit_transaction()
 
 ErrorOr<void> PolicyGraph::rollback_transaction()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     dbgln("PolicyGraph: Rolling back transaction");
 
     // Execute ROLLBACK TRANSACTION
+    // NB: Queued writes flushed while the transaction was open are rolled back along with it
     m_database->execute_statement(m_statements.rollback_transaction, {});
+    m_in_explicit_transaction = false;
 
     // Invalidate cache since we're reverting changes
     m_cache.invalidate();
 
+    // Policy changes made during the transaction were indexed as they happened
+    return rebuild_policy_index();
+}
+
+// Group commit implementations
+
+void PolicyGraph::submit_write(Function<void()> write, Function<void()> on_queued)
+{
+    {
+        Sync::MutexLocker locker(m_pending_mutex);
+        if (m_group_commit_writer) {
+            m_pending_writes.append(move(write));
+            if (on_queued)
+                on_queued();
+
+            // Wake the writer for the first write of a batch, and again once the batch is full
+            if (m_pending_writes.size() == 1 || m_pending_writes.size() >= m_group_commit_options.max_batch_size)
+                m_pending_condition.signal();
+            return;
+        }
+    }
+
+    Sync::MutexLocker locker(m_database_mutex);
+    write();
+}
+
+ErrorOr<void> PolicyGraph::flush_pending_writes()
+{
+    Sync::MutexLocker database_locker(m_database_mutex);
+
+    Vector<Function<void()>> batch;
+    {
+        Sync::MutexLocker locker(m_pending_mutex);
+        batch = move(m_pending_writes);
+        // Readers take m_database_mutex, so they see these verdicts in the database from here on
+        m_pending_verdicts.clear();
+    }
+
+    if (batch.is_empty())
+        return {};
+
+    // Inside a caller's explicit transaction the batch simply becomes part of it
+    bool own_transaction = !m_in_explicit_transaction;
+    if (own_transaction)
+        m_database->execute_statement(m_statements.begin_transaction, {});
+
+    for (auto& write : batch)
+        write();
+
+    if (own_transaction)
+        m_database->execute_statement(m_statements.commit_transaction, {});
+
+    m_group_commit_statistics.batches_committed++;
+    m_group_commit_statistics.writes_committed += batch.size();
+    m_group_commit_statistics.largest_batch = max(m_group_commit_statistics.largest_batch, batch.size());
+    return {};
+}
+
+ErrorOr<void> PolicyGraph::set_write_durability(WriteDurability durability, GroupCommitOptions options)
+{
+    if (options.max_batch_size == 0)
+        return Error::from_string_literal("Group commit batch size must be at least 1");
+
+    stop_group_commit_writer();
+    TRY(flush_pending_writes());
+
+    m_group_commit_options = options;
+    if (durability == WriteDurability::Immediate)
+        return {};
+
+    auto writer = TRY(Threading::Thread::try_create("PolicyGraph/GroupCommit"sv, [this]() -> intptr_t {
+        return group_commit_thread_func();
+    }));
+
+    {
+        Sync::MutexLocker locker(m_pending_mutex);
+        m_group_commit_stopping = false;
+        m_group_commit_writer = writer;
+    }
+    writer->start();
+
+    dbgln("PolicyGraph: Group commit enabled (every {}ms or {} writes)", options.flush_interval.to_milliseconds(), options.max_batch_size);
     return {};
 }
 
+PolicyGraph::WriteDurability PolicyGraph::write_durability() const
+{
+    Sync::MutexLocker locker(m_pending_mutex);
+    return m_group_commit_writer ? WriteDurability::GroupCommit : WriteDurability::Immediate;
+}
+
+size_t PolicyGraph::pending_write_count() const
+{
+    Sync::MutexLocker locker(m_pending_mutex);
+    return m_pending_writes.size();
+}
+
+PolicyGraph::GroupCommitStatistics PolicyGraph::group_commit_statistics() const
+{
+    Sync::MutexLocker locker(m_database_mutex);
+    return m_group_commit_statistics;
+}
+
+intptr_t PolicyGraph::group_commit_thread_func()
+{
+    while (true) {
+        bool stopping = false;
+        {
+            Sync::MutexLocker locker(m_pending_mutex);
+            m_pending_condition.wait_while([this] { return m_pending_writes.is_empty() && !m_group_commit_stopping; });
+
+            // Give the batch one flush interval to fill up, unless it already has
+            if (!m_group_commit_stopping && m_pending_writes.size() < m_group_commit_options.max_batch_size)
+                (void)m_pending_condition.wait_for(m_group_commit_options.flush_interval);
+            stopping = m_group_commit_stopping;
+        }
+
+        if (auto result = flush_pending_writes(); result.is_error())
+            dbgln("PolicyGraph: Group commit failed: {}", result.error());
+
+        if (stopping)
+            return 0;
+    }
+}
+
+void PolicyGraph::stop_group_commit_writer()
+{
+    RefPtr<Threading::Thread> writer;
+    {
+        Sync::MutexLocker locker(m_pending_mutex);
+        if (!m_group_commit_writer)
+            return;
+        m_group_commit_stopping = true;
+        m_pending_condition.broadcast();
+        writer = m_group_commit_writer;
+    }
+
+    // The writer flushes one last time before it exits
+    (void)writer->join();
+
+    Sync::MutexLocker locker(m_pending_mutex);
+    m_group_commit_writer = nullptr;
+}
+
+PolicyGraph::~PolicyGraph()
+{
+    stop_group_commit_writer();
+    if (auto result = flush_pending_writes(); result.is_error())
+        dbgln("PolicyGraph: Failed to flush pending writes: {}", result.error());
+}
+
 // Milestone 0.3: Credential Relationship Management
 
 ErrorOr<i64> PolicyGraph::create_relationship(CredentialRelationship const& relationship)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     m_database->execute_statement(
         m_statements.create_relationship,
         {},
@@ -1478,6 +1802,8 @@ ErrorOr<i64> PolicyGraph::create_relationship(CredentialRelationship const& rela
 
 ErrorOr<PolicyGraph::CredentialRelationship> PolicyGraph::get_relationship(String const& form_origin, String const& action_origin, String const& type)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     CredentialRelationship relationship;
     bool found = false;
 
@@ -1518,6 +1844,8 @@ ErrorOr<PolicyGraph::CredentialRelationship> PolicyGraph::get_relationship(Strin
 
 ErrorOr<Vector<PolicyGraph::CredentialRelationship>> PolicyGraph::list_relationships(Optional<String> type_filter)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     Vector<CredentialRelationship> relationships;
 
     if (type_filter.has_value()) {
@@ -1584,6 +1912,8 @@ ErrorOr<Vector<PolicyGraph::CredentialRelationship>> PolicyGraph::list_relations
 
 ErrorOr<void> PolicyGraph::update_relationship_usage(i64 relationship_id)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     auto now = UnixDateTime::now();
 
     m_database->execute_statement(
@@ -1598,6 +1928,8 @@ ErrorOr<void> PolicyGraph::update_relationship_usage(i64 relationship_id)
 
 ErrorOr<void> PolicyGraph::delete_relationship(i64 relationship_id)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     m_database->execute_statement(
         m_statements.delete_relationship,
         {},
@@ -1610,6 +1942,8 @@ ErrorOr<void> PolicyGraph::delete_relationship(i64 relationship_id)
 
 ErrorOr<bool> PolicyGraph::has_relationship(String const& form_origin, String const& action_origin, String const& type)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     bool exists = false;
 
     m_database->execute_statement(
@@ -1629,6 +1963,8 @@ ErrorOr<bool> PolicyGraph::has_relationship(String const& form_origin, String co
 
 ErrorOr<i64> PolicyGraph::record_credential_alert(CredentialAlert const& alert)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     m_database->execute_statement(
         m_statements.record_credential_alert,
         {},
@@ -1662,6 +1998,8 @@ ErrorOr<i64> PolicyGraph::record_credential_alert(CredentialAlert const& alert)
 
 ErrorOr<Vector<PolicyGraph::CredentialAlert>> PolicyGraph::get_credential_alerts(Optional<UnixDateTime> since)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     Vector<CredentialAlert> alerts;
 
     auto statement_id = since.has_value()
@@ -1704,6 +2042,8 @@ ErrorOr<Vector<PolicyGraph::CredentialAlert>> PolicyGraph::get_credential_alerts
 
 ErrorOr<Vector<PolicyGraph::CredentialAlert>> PolicyGraph::get_alerts_by_origin(String const& origin)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     Vector<CredentialAlert> alerts;
 
     m_database->execute_statement(
@@ -1742,6 +2082,8 @@ ErrorOr<Vector<PolicyGraph::CredentialAlert>> PolicyGraph::get_alerts_by_origin(
 
 ErrorOr<void> PolicyGraph::update_alert_action(i64 alert_id, String const& user_action)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     m_database->execute_statement(
         m_statements.update_alert_action,
         {},
@@ -1756,6 +2098,8 @@ ErrorOr<void> PolicyGraph::update_alert_action(i64 alert_id, String const& user_
 
 ErrorOr<i64> PolicyGraph::create_template(PolicyTemplate const& tmpl)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     m_database->execute_statement(
         m_statements.create_template,
         {},
@@ -1781,6 +2125,8 @@ ErrorOr<i64> PolicyGraph::create_template(PolicyTemplate const& tmpl)
 
 ErrorOr<PolicyGraph::PolicyTemplate> PolicyGraph::get_template(i64 template_id)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     PolicyTemplate tmpl;
     bool found = false;
 
@@ -1812,6 +2158,8 @@ ErrorOr<PolicyGraph::PolicyTemplate> PolicyGraph::get_template(i64 template_id)
 
 ErrorOr<PolicyGraph::PolicyTemplate> PolicyGraph::get_template_by_name(String const& name)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     PolicyTemplate tmpl;
     bool found = false;
 
@@ -1843,6 +2191,8 @@ ErrorOr<PolicyGraph::PolicyTemplate> PolicyGraph::get_template_by_name(String co
 
 ErrorOr<Vector<PolicyGraph::PolicyTemplate>> PolicyGraph::list_templates(Optional<String> category_filter)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     Vector<PolicyTemplate> templates;
 
     // Execute appropriate query based on whether filter is provided
@@ -1898,6 +2248,8 @@ ErrorOr<Vector<PolicyGraph::PolicyTemplate>> PolicyGraph::list_templates(Optiona
 
 ErrorOr<void> PolicyGraph::update_template(i64 template_id, PolicyTemplate const& tmpl)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     auto now = UnixDateTime::now();
 
     m_database->execute_statement(
@@ -1917,6 +2269,8 @@ ErrorOr<void> PolicyGraph::update_template(i64 template_id, PolicyTemplate const
 
 ErrorOr<void> PolicyGraph::delete_template(i64 template_id)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     m_database->execute_statement(
         m_statements.delete_template,
         {},
@@ -1929,6 +2283,8 @@ ErrorOr<void> PolicyGraph::delete_template(i64 template_id)
 
 ErrorOr<PolicyGraph::Policy> PolicyGraph::instantiate_template(i64 template_id, HashMap<String, String> const& variables)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     auto tmpl = TRY(get_template(template_id));
 
     auto template_json = tmpl.template_json;
@@ -1970,6 +2326,8 @@ ErrorOr<PolicyGraph::Policy> PolicyGraph::instantiate_template(i64 template_id,
 
 ErrorOr<void> PolicyGraph::seed_builtin_templates()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     auto builtin_templates = PolicyTemplates::get_builtin_templates();
 
     for (auto const& template_def : builtin_templates) {
@@ -2000,6 +2358,8 @@ ErrorOr<void> PolicyGraph::seed_builtin_templates()
 
 ErrorOr<String> PolicyGraph::export_relationships_json()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     auto relationships = TRY(list_relationships({}));
 
     JsonArray json_array;
@@ -2029,6 +2389,8 @@ ErrorOr<String> PolicyGraph::export_relationships_json()
 
 ErrorOr<void> PolicyGraph::import_relationships_json(String const& json)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     auto parsed = TRY(JsonValue::from_string(json));
     if (!parsed.is_array())
         return Error::from_string_literal("Invalid JSON: expected array");
@@ -2068,6 +2430,8 @@ ErrorOr<void> PolicyGraph::import_relationships_json(String const& json)
 
 ErrorOr<String> PolicyGraph::export_templates_json()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     auto templates = TRY(list_templates({}));
 
     JsonArray json_array;
@@ -2091,6 +2455,8 @@ ErrorOr<String> PolicyGraph::export_templates_json()
 
 ErrorOr<void> PolicyGraph::import_templates_json(String const& json)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     auto parsed = TRY(JsonValue::from_string(json));
     if (!parsed.is_array())
         return Error::from_string_literal("Invalid JSON: expected array");
@@ -2126,6 +2492,8 @@ ErrorOr<void> PolicyGraph::import_templates_json(String const& json)
 
 ErrorOr<i64> PolicyGraph::create_network_behavior_policy(String const& domain, String const& policy, String const& threat_type, i32 confidence, String const& notes)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     // Validate inputs
     if (domain.is_empty())
         return Error::from_string_literal("Domain cannot be empty");
@@ -2178,6 +2546,8 @@ ErrorOr<i64> PolicyGraph::create_network_behavior_policy(String const& domain, S
 
 ErrorOr<Optional<PolicyGraph::NetworkBehaviorPolicy>> PolicyGraph::get_network_behavior_policy(String const& domain, String const& threat_type)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     Optional<NetworkBehaviorPolicy> result;
 
     m_database->execute_statement(
@@ -2205,6 +2575,8 @@ ErrorOr<Optional<PolicyGraph::NetworkBehaviorPolicy>> PolicyGraph::get_network_b
 
 ErrorOr<Vector<PolicyGraph::NetworkBehaviorPolicy>> PolicyGraph::get_all_network_behavior_policies()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     Vector<NetworkBehaviorPolicy> policies;
 
     m_database->execute_statement(
@@ -2230,6 +2602,8 @@ ErrorOr<Vector<PolicyGraph::NetworkBehaviorPolicy>> PolicyGraph::get_all_network
 
 ErrorOr<void> PolicyGraph::update_network_behavior_policy(i64 policy_id, String const& new_policy, String const& notes)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     // Validate policy value
     if (new_policy != "allow"sv && new_policy != "block"sv && new_policy != "monitor"sv)
         return Error::from_string_literal("Policy must be 'allow', 'block', or 'monitor'");
@@ -2251,6 +2625,8 @@ ErrorOr<void> PolicyGraph::update_network_behavior_policy(i64 policy_id, String
 
 ErrorOr<void> PolicyGraph::delete_network_behavior_policy(i64 policy_id)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     m_database->execute_statement(
         m_statements.delete_network_behavior_policy,
         {},
@@ -2286,22 +2662,30 @@ ErrorOr<void> PolicyGraph::store_sandbox_verdict(SandboxVerdict const& verdict)
         behaviors_array.must_append(behavior);
     auto behaviors_json = JsonValue(behaviors_array).serialized();
 
-    m_database->execute_statement(
-        m_statements.store_sandbox_verdict,
-        {},
-        verdict.file_hash,
-        verdict.threat_level,
-        verdict.confidence,
-        verdict.composite_score,
-        verdict.verdict_explanation,
-        verdict.yara_score,
-        verdict.ml_score,
-        verdict.behavioral_score,
-        rules_json,
-        behaviors_json,
-        verdict.analyzed_at.milliseconds_since_epoch(),
-        verdict.expires_at.milliseconds_since_epoch()
-    );
+    auto write = [this, verdict, rules_json = move(rules_json), behaviors_json = move(behaviors_json)] {
+        m_database->execute_statement(
+            m_statements.store_sandbox_verdict,
+            {},
+            verdict.file_hash,
+            verdict.threat_level,
+            verdict.confidence,
+            verdict.composite_score,
+            verdict.verdict_explanation,
+            verdict.yara_score,
+            verdict.ml_score,
+            verdict.behavioral_score,
+            rules_json,
+            behaviors_json,
+            verdict.analyzed_at.milliseconds_since_epoch(),
+            verdict.expires_at.milliseconds_since_epoch(),
+            static_cast<i64>(verdict.rules_version)
+        );
+    };
+
+    // Queued verdicts are served from m_pending_verdicts until they are committed
+    submit_write(move(write), [this, &verdict] {
+        m_pending_verdicts.set(verdict.file_hash, verdict);
+    });
 
     dbgln_if(false, "PolicyGraph: Stored sandbox verdict for hash {} (threat_level: {}, confidence: {}, rules: {}, behaviors: {})",
         verdict.file_hash, verdict.threat_level, verdict.confidence, verdict.triggered_rules.size(), verdict.detected_behaviors.size());
@@ -2310,6 +2694,8 @@ ErrorOr<void> PolicyGraph::store_sandbox_verdict(SandboxVerdict const& verdict)
 
 ErrorOr<Optional<PolicyGraph::SandboxVerdict>> PolicyGraph::lookup_sandbox_verdict(String const& file_hash)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     // Validate file_hash (SHA256 = 64 hex chars)
     auto hash_result = InputValidator::validate_sha256(file_hash);
     if (!hash_result.is_valid)
@@ -2318,6 +2704,12 @@ ErrorOr<Optional<PolicyGraph::SandboxVerdict>> PolicyGraph::lookup_sandbox_verdi
     auto now = UnixDateTime::now();
     Optional<SandboxVerdict> verdict;
 
+    {
+        Sync::MutexLocker pending_locker(m_pending_mutex);
+        if (auto pending = m_pending_verdicts.get(file_hash); pending.has_value())
+            return pending->expires_at > now ? Optional<SandboxVerdict> { pending.release_value() } : Optional<SandboxVerdict> {};
+    }
+
     m_database->execute_statement(
         m_statements.lookup_sandbox_verdict,
         [&](auto stmt_id) {
@@ -2356,6 +2748,7 @@ ErrorOr<Optional<PolicyGraph::SandboxVerdict>> PolicyGraph::lookup_sandbox_verdi
 
             v.analyzed_at = UnixDateTime::from_milliseconds_since_epoch(m_database->result_column<i64>(stmt_id, col++));
             v.expires_at = UnixDateTime::from_milliseconds_since_epoch(m_database->result_column<i64>(stmt_id, col++));
+            v.rules_version = static_cast<u64>(m_database->result_column<i64>(stmt_id, col++));
             verdict = move(v);
         },
         file_hash,
@@ -2374,6 +2767,9 @@ ErrorOr<Optional<PolicyGraph::SandboxVerdict>> PolicyGraph::lookup_sandbox_verdi
 
 ErrorOr<void> PolicyGraph::cleanup_expired_verdicts()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+    TRY(flush_pending_writes());
+
     auto now = UnixDateTime::now();
 
     m_database->execute_statement(
@@ -2388,6 +2784,9 @@ ErrorOr<void> PolicyGraph::cleanup_expired_verdicts()
 
 ErrorOr<void> PolicyGraph::invalidate_verdict(String const& file_hash)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+    TRY(flush_pending_writes());
+
     // Validate file_hash (SHA256 = 64 hex chars)
     auto hash_result = InputValidator::validate_sha256(file_hash);
     if (!hash_result.is_valid)
@@ -2405,6 +2804,9 @@ ErrorOr<void> PolicyGraph::invalidate_verdict(String const& file_hash)
 
 ErrorOr<void> PolicyGraph::clear_verdict_cache()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+    TRY(flush_pending_writes());
+
     m_database->execute_statement(
         m_statements.clear_verdict_cache,
         {}
@@ -2443,6 +2845,8 @@ AK::Duration PolicyGraph::calculate_verdict_ttl(i32 threat_level)
 
 ErrorOr<i64> PolicyGraph::store_ioc(IOC const& ioc)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     // Serialize tags to JSON array
     StringBuilder tags_json;
     tags_json.append("["sv);
@@ -2478,6 +2882,8 @@ ErrorOr<i64> PolicyGraph::store_ioc(IOC const& ioc)
 
 ErrorOr<Optional<PolicyGraph::IOC>> PolicyGraph::get_ioc(String const& indicator)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     Optional<IOC> result;
 
     m_database->execute_statement(m_statements.get_ioc, [&](auto stmt_id) {
@@ -2514,6 +2920,8 @@ ErrorOr<Optional<PolicyGraph::IOC>> PolicyGraph::get_ioc(String const& indicator
 
 ErrorOr<Vector<PolicyGraph::IOC>> PolicyGraph::search_iocs(Optional<IOC::Type> type_filter, Optional<String> source_filter)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     Vector<IOC> results;
 
     Database::StatementID statement_id;
@@ -2637,6 +3045,8 @@ ErrorOr<Vector<PolicyGraph::IOC>> PolicyGraph::search_iocs(Optional<IOC::Type> t
 
 ErrorOr<void> PolicyGraph::delete_ioc(i64 ioc_id)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     m_database->execute_statement(m_statements.delete_ioc, {}, ioc_id);
     dbgln("PolicyGraph: Deleted IOC {}", ioc_id);
     return {};
@@ -2644,6 +3054,8 @@ ErrorOr<void> PolicyGraph::delete_ioc(i64 ioc_id)
 
 ErrorOr<u64> PolicyGraph::get_ioc_count()
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     u64 count = 0;
     m_database->execute_statement(m_statements.count_iocs, [&](auto stmt_id) {
         count = static_cast<u64>(m_database->result_column<i64>(stmt_id, 0));
@@ -2684,6 +3096,8 @@ String PolicyGraph::ioc_type_to_string(IOC::Type type)
 
 ErrorOr<i64> PolicyGraph::insert_quarantine_record(Quarantine::QuarantineRecord const& record)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     auto sql = "INSERT INTO quarantine "
                "(original_path, quarantine_path, quarantine_reason, threat_score, threat_level, "
                "quarantined_at, file_size, sha256_hash) "
@@ -2715,6 +3129,8 @@ ErrorOr<i64> PolicyGraph::insert_quarantine_record(Quarantine::QuarantineRecord
 
 ErrorOr<void> PolicyGraph::delete_quarantine_record(i64 quarantine_id)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     auto sql = MUST(String::formatted("DELETE FROM quarantine WHERE id = {}", quarantine_id));
     auto statement = TRY(m_database->prepare_statement(sql));
     m_database->execute_statement(statement, {});
@@ -2725,6 +3141,8 @@ ErrorOr<void> PolicyGraph::delete_quarantine_record(i64 quarantine_id)
 
 ErrorOr<Vector<Quarantine::QuarantineRecord>> PolicyGraph::query_quarantine_records(String const& where_clause)
 {
+    Sync::MutexLocker locker(m_database_mutex);
+
     auto sql = MUST(String::formatted(
         "SELECT id, original_path, quarantine_path, quarantine_reason, threat_score, threat_level, "
         "quarantined_at, file_size, sha256_hash FROM quarantine {} ORDER BY quarantined_at DESC",
@@ -7,6 +7,7 @@
 #pragma once
 
 #include <AK/Error.h>
+#include <AK/Function.h>
 #include <AK/HashMap.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/NonnullRefPtr.h>
@@ -16,7 +17,11 @@
 #include <AK/Vector.h>
 #include <LibCore/CircuitBreaker.h>
 #include <LibDatabase/Database.h>
-#include "LRUCache.h"
+#include <LibSync/ConditionVariable.h>
+#include <LibSync/Mutex.h>
+#include <LibThreading/Forward.h>
+#include "PolicyMatcher.h"
+#include "ShardedLRUCache.h"
 
 namespace Sentinel {
 
@@ -30,9 +35,10 @@ namespace Quarantine {
 namespace Sentinel {
 
 // Policy cache wrapper using O(1) LRU cache
+// Slab-backed, since it is invalidated on every policy change and must not churn the allocator
 class PolicyGraphCache {
 public:
-    using CacheMetrics = LRUCache<String, Optional<int>>::CacheMetrics;
+    using CacheMetrics = SlabLRUCache<String, Optional<int>>::CacheMetrics;
 
     PolicyGraphCache(size_t max_size = 1000)
         : m_lru_cache(max_size)
@@ -47,7 +53,7 @@ public:
     void reset_metrics();
 
 private:
-    LRUCache<String, Optional<int>> m_lru_cache;
+    SlabLRUCache<String, Optional<int>> m_lru_cache;
 };
 
 class PolicyGraph {
@@ -179,9 +185,37 @@ public:
         Vector<String> detected_behaviors;   // Behavioral indicators detected
         UnixDateTime analyzed_at;     // When analysis was performed
         UnixDateTime expires_at;      // When cache entry expires
+        u64 rules_version { 0 };      // YARA rule-set version the verdict was reached with (0 = not tied to one)
+    };
+
+    // Durability of writes that do not return a row ID (threat records, sandbox verdicts, policy hit counts)
+    enum class WriteDurability {
+        Immediate,   // Every write is committed before it returns
+        GroupCommit, // Writes are queued and committed in batches; a crash loses at most one batch
+    };
+
+    struct GroupCommitOptions {
+        AK::Duration flush_interval { AK::Duration::from_milliseconds(50) };
+        size_t max_batch_size { 256 };
+    };
+
+    struct GroupCommitStatistics {
+        u64 batches_committed { 0 };
+        u64 writes_committed { 0 };
+        size_t largest_batch { 0 };
     };
 
     static ErrorOr<NonnullOwnPtr<PolicyGraph>> create(ByteString const& db_directory);
+    ~PolicyGraph();
+
+    // Group commit: queued writes are committed by a writer thread in one transaction every
+    // flush_interval, or as soon as max_batch_size writes are queued. Reads of queued data stay
+    // consistent: threat and policy reads flush first, and sandbox verdicts are served from the queue.
+    ErrorOr<void> set_write_durability(WriteDurability, GroupCommitOptions = {});
+    WriteDurability write_durability() const;
+    ErrorOr<void> flush_pending_writes();
+    size_t pending_write_count() const;
+    GroupCommitStatistics group_commit_statistics() const;
 
     // Policy CRUD operations
     ErrorOr<i64> create_policy(Policy const& policy);
@@ -191,8 +225,12 @@ public:
     ErrorOr<void> delete_policy(i64 policy_id);
 
     // Policy matching (priority: hash > URL pattern > rule name)
+    // Matches against an in-memory index of the policies, so it never waits on SQLite
     ErrorOr<Optional<Policy>> match_policy(ThreatMetadata const& threat);
 
+    // The same match through the LRU cache and SQL queries; kept to benchmark the index against
+    ErrorOr<Optional<Policy>> match_policy_using_database(ThreatMetadata const& threat);
+
     // Threat history
     ErrorOr<void> record_threat(ThreatMetadata const& threat,
                                 String action_taken,
@@ -404,11 +442,45 @@ private:
 
     ErrorOr<String> compute_cache_key(ThreatMetadata const& threat) const;
 
+    // get_policy() without flushing queued writes first
+    ErrorOr<Policy> load_policy(i64 policy_id);
+
+    // Keep m_policy_matcher in step with the policies table
+    ErrorOr<void> rebuild_policy_index();
+    ErrorOr<void> index_policy(Policy);
+    ErrorOr<void> add_policy_to_index(Policy);
+    void compile_policy_index();
+    void unindex_policy(i64 policy_id);
+
+    // Execute a write now, or queue it for the group-commit writer; on_queued runs while the queue is locked
+    void submit_write(Function<void()> write, Function<void()> on_queued = nullptr);
+    intptr_t group_commit_thread_func();
+    void stop_group_commit_writer();
+
     NonnullRefPtr<Database::Database> m_database;
     Statements m_statements;
     PolicyGraphCache m_cache;
     bool m_database_healthy { true };
 
+    // Every policy, indexed for match_policy(); guarded by m_database_mutex
+    PolicyMatcher m_policy_matcher;
+    HashMap<i64, Policy> m_indexed_policies;
+
+    // Serializes database access between callers and the group-commit writer. Recursive, since
+    // public methods call each other.
+    mutable Sync::RecursiveMutex m_database_mutex;
+    bool m_in_explicit_transaction { false };
+
+    // Group commit state, guarded by m_pending_mutex (taken after m_database_mutex, never before)
+    mutable Sync::Mutex m_pending_mutex;
+    Sync::ConditionVariable m_pending_condition { m_pending_mutex };
+    Vector<Function<void()>> m_pending_writes;
+    HashMap<String, SandboxVerdict> m_pending_verdicts;
+    RefPtr<Threading::Thread> m_group_commit_writer;
+    bool m_group_commit_stopping { false };
+    GroupCommitOptions m_group_commit_options;
+    GroupCommitStatistics m_group_commit_statistics;
+
     // Circuit breaker for database operations
     // Prevents cascade failures when database is unavailable
     mutable Core::CircuitBreaker m_circuit_breaker { Core::CircuitBreakerPresets::database("PolicyGraph::Database"sv) };
@@ -0,0 +1,382 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "PolicyMatcher.h"
+#include <AK/BinarySearch.h>
+#include <AK/CharacterTypes.h>
+
+namespace Sentinel {
+
+// The longest run of characters a LIKE pattern matches literally. Every text the pattern matches
+// contains it (ignoring ASCII case), which makes it a sound prefilter.
+static StringView longest_literal_run(StringView pattern)
+{
+    StringView longest;
+    size_t run_start = 0;
+    for (size_t i = 0; i <= pattern.length(); ++i) {
+        if (i < pattern.length() && pattern[i] != '%' && pattern[i] != '_' && pattern[i] != '\\')
+            continue;
+        if (i - run_start > longest.length())
+            longest = pattern.substring_view(run_start, i - run_start);
+        // Skip the escaped character rather than treating it as part of a run
+        if (i < pattern.length() && pattern[i] == '\\')
+            ++i;
+        run_start = i + 1;
+    }
+    return longest;
+}
+
+static bool ascii_case_insensitive_equals(char a, char b)
+{
+    return to_ascii_lowercase(a) == to_ascii_lowercase(b);
+}
+
+static bool is_utf8_continuation_byte(char c)
+{
+    return (static_cast<u8>(c) & 0xC0) == 0x80;
+}
+
+bool PolicyMatcher::matches_like_pattern(StringView text, StringView pattern)
+{
+    size_t text_index = 0;
+    size_t pattern_index = 0;
+
+    // Where to resume after the most recent %, which is the only backtracking a LIKE pattern needs
+    Optional<size_t> resume_pattern_index;
+    size_t resume_text_index = 0;
+
+    while (text_index < text.length()) {
+        if (pattern_index < pattern.length()) {
+            auto pattern_char = pattern[pattern_index];
+            if (pattern_char == '%') {
+                resume_pattern_index = ++pattern_index;
+                resume_text_index = text_index;
+                continue;
+            }
+            if (pattern_char == '_') {
+                // _ matches one character, not one byte
+                ++pattern_index;
+                ++text_index;
+                while (text_index < text.length() && is_utf8_continuation_byte(text[text_index]))
+                    ++text_index;
+                continue;
+            }
+            size_t literal_length = 1;
+            if (pattern_char == '\\' && pattern_index + 1 < pattern.length()) {
+                pattern_char = pattern[pattern_index + 1];
+                literal_length = 2;
+            }
+            if (ascii_case_insensitive_equals(text[text_index], pattern_char)) {
+                pattern_index += literal_length;
+                ++text_index;
+                continue;
+            }
+        }
+
+        if (!resume_pattern_index.has_value())
+            return false;
+        pattern_index = *resume_pattern_index;
+        text_index = ++resume_text_index;
+    }
+
+    while (pattern_index < pattern.length() && pattern[pattern_index] == '%')
+        ++pattern_index;
+    return pattern_index == pattern.length();
+}
+
+void PolicyMatcher::insert_sorted(Vector<i64>& policy_ids, i64 policy_id)
+{
+    size_t insertion_index = 0;
+    if (binary_search(policy_ids, policy_id, &insertion_index))
+        return;
+    if (insertion_index < policy_ids.size() && policy_ids[insertion_index] < policy_id)
+        ++insertion_index;
+    policy_ids.insert(insertion_index, policy_id);
+}
+
+void PolicyMatcher::remove_sorted(Vector<i64>& policy_ids, i64 policy_id)
+{
+    size_t index = 0;
+    if (binary_search(policy_ids, policy_id, &index))
+        policy_ids.remove(index);
+}
+
+ErrorOr<void> PolicyMatcher::add(Entry entry)
+{
+    remove(entry.policy_id);
+
+    auto policy_id = entry.policy_id;
+    bool has_file_hash = entry.file_hash.has_value() && !entry.file_hash->is_empty();
+    bool has_url_pattern = entry.url_pattern.has_value() && !entry.url_pattern->is_empty();
+
+    if (has_file_hash) {
+        auto it = m_policies_by_file_hash.find(*entry.file_hash);
+        if (it == m_policies_by_file_hash.end()) {
+            TRY(m_policies_by_file_hash.try_set(*entry.file_hash, {}));
+            it = m_policies_by_file_hash.find(*entry.file_hash);
+        }
+        TRY(it->value.try_ensure_capacity(it->value.size() + 1));
+        insert_sorted(it->value, policy_id);
+    }
+
+    if (has_url_pattern) {
+        TRY(m_url_pattern_policies.try_ensure_capacity(m_url_pattern_policies.size() + 1));
+        insert_sorted(m_url_pattern_policies, policy_id);
+        m_url_automaton_dirty = true;
+    }
+
+    // Like the SQL path, a rule name only matches on its own when the policy has no hash or URL pattern
+    if (!has_file_hash && !has_url_pattern) {
+        auto rule_name_id = TRY(m_rule_name_ids.try_ensure(entry.rule_name, [&] { return static_cast<u32>(m_rule_only_policies.size()); }));
+        if (rule_name_id == m_rule_only_policies.size())
+            TRY(m_rule_only_policies.try_append({}));
+        auto& policy_ids = m_rule_only_policies[rule_name_id];
+        TRY(policy_ids.try_ensure_capacity(policy_ids.size() + 1));
+        insert_sorted(policy_ids, policy_id);
+    }
+
+    TRY(m_entries.try_set(policy_id, move(entry)));
+    return {};
+}
+
+void PolicyMatcher::remove(i64 policy_id)
+{
+    auto it = m_entries.find(policy_id);
+    if (it == m_entries.end())
+        return;
+    auto const& entry = it->value;
+
+    if (entry.file_hash.has_value()) {
+        if (auto hash_it = m_policies_by_file_hash.find(*entry.file_hash); hash_it != m_policies_by_file_hash.end()) {
+            remove_sorted(hash_it->value, policy_id);
+            if (hash_it->value.is_empty())
+                m_policies_by_file_hash.remove(hash_it);
+        }
+    }
+
+    if (entry.url_pattern.has_value() && !entry.url_pattern->is_empty()) {
+        remove_sorted(m_url_pattern_policies, policy_id);
+        m_url_automaton_dirty = true;
+    }
+
+    // Interned rule name IDs stay valid once assigned, so only the policy list shrinks
+    if (auto rule_it = m_rule_name_ids.find(entry.rule_name); rule_it != m_rule_name_ids.end())
+        remove_sorted(m_rule_only_policies[rule_it->value], policy_id);
+
+    m_entries.remove(it);
+}
+
+void PolicyMatcher::clear()
+{
+    m_entries.clear();
+    m_policies_by_file_hash.clear();
+    m_rule_name_ids.clear();
+    m_rule_only_policies.clear();
+    m_url_pattern_policies.clear();
+
+    m_compiled_url_policies.clear();
+    m_transitions.clear();
+    m_output_links.clear();
+    m_state_outputs.clear();
+    m_unanchored_patterns.clear();
+    m_alphabet_size = 0;
+    m_url_automaton_state_count = 0;
+    m_url_automaton_dirty = false;
+}
+
+ErrorOr<void> PolicyMatcher::compile()
+{
+    if (!m_url_automaton_dirty)
+        return {};
+
+    Vector<i64> compiled_url_policies;
+    Vector<StringView> anchors;
+    TRY(compiled_url_policies.try_ensure_capacity(m_url_pattern_policies.size()));
+    TRY(anchors.try_ensure_capacity(m_url_pattern_policies.size()));
+    for (auto policy_id : m_url_pattern_policies) {
+        compiled_url_policies.unchecked_append(policy_id);
+        anchors.unchecked_append(longest_literal_run(*m_entries.find(policy_id)->value.url_pattern));
+    }
+
+    // Case-fold the alphabet down to the bytes the anchors actually use; symbol 0 is every other byte
+    Array<u8, 256> symbol_for_byte {};
+    size_t alphabet_size = 1;
+    for (auto anchor : anchors) {
+        for (auto byte : anchor.bytes()) {
+            auto lowercase = static_cast<u8>(to_ascii_lowercase(byte));
+            if (symbol_for_byte[lowercase] != 0)
+                continue;
+            symbol_for_byte[lowercase] = static_cast<u8>(alphabet_size);
+            symbol_for_byte[static_cast<u8>(to_ascii_uppercase(lowercase))] = static_cast<u8>(alphabet_size);
+            ++alphabet_size;
+        }
+    }
+
+    // Build the trie of anchors
+    Vector<u32> transitions;
+    Vector<Vector<u32>> state_outputs;
+    Vector<u32> unanchored_patterns;
+    TRY(transitions.try_resize(alphabet_size));
+    transitions.fill(NO_STATE);
+    TRY(state_outputs.try_resize(1));
+
+    for (u32 pattern_index = 0; pattern_index < anchors.size(); ++pattern_index) {
+        auto anchor = anchors[pattern_index];
+        if (anchor.is_empty()) {
+            TRY(unanchored_patterns.try_append(pattern_index));
+            continue;
+        }
+
+        u32 state = 0;
+        for (auto byte : anchor.bytes()) {
+            auto slot = state * alphabet_size + symbol_for_byte[byte];
+            if (transitions[slot] == NO_STATE) {
+                transitions[slot] = state_outputs.size();
+                TRY(state_outputs.try_append({}));
+                TRY(transitions.try_resize(transitions.size() + alphabet_size));
+                for (size_t i = transitions.size() - alphabet_size; i < transitions.size(); ++i)
+                    transitions[i] = NO_STATE;
+            }
+            state = transitions[slot];
+        }
+        TRY(state_outputs[state].try_append(pattern_index));
+    }
+
+    // Turn the trie into a DFA: fill missing transitions from each state's failure state, visiting
+    // states breadth-first so that every failure state is complete before it is used
+    auto state_count = state_outputs.size();
+    Vector<u32> failure_states;
+    Vector<u32> output_links;
+    Vector<u32> queue;
+    TRY(failure_states.try_resize(state_count));
+    TRY(output_links.try_resize(state_count));
+    TRY(queue.try_ensure_capacity(state_count));
+    output_links.fill(NO_STATE);
+
+    for (size_t symbol = 0; symbol < alphabet_size; ++symbol) {
+        auto& next = transitions[symbol];
+        if (next == NO_STATE) {
+            next = 0;
+            continue;
+        }
+        failure_states[next] = 0;
+        queue.unchecked_append(next);
+    }
+
+    for (size_t head = 0; head < queue.size(); ++head) {
+        auto state = queue[head];
+        auto failure_state = failure_states[state];
+        for (size_t symbol = 0; symbol < alphabet_size; ++symbol) {
+            auto fallback = transitions[failure_state * alphabet_size + symbol];
+            auto& next = transitions[state * alphabet_size + symbol];
+            if (next == NO_STATE) {
+                next = fallback;
+                continue;
+            }
+            failure_states[next] = fallback;
+            output_links[next] = state_outputs[fallback].is_empty() ? output_links[fallback] : fallback;
+            queue.unchecked_append(next);
+        }
+    }
+
+    m_compiled_url_policies = move(compiled_url_policies);
+    m_symbol_for_byte = symbol_for_byte;
+    m_alphabet_size = alphabet_size;
+    m_url_automaton_state_count = state_count;
+    m_transitions = move(transitions);
+    m_output_links = move(output_links);
+    m_state_outputs = move(state_outputs);
+    m_unanchored_patterns = move(unanchored_patterns);
+    m_url_automaton_dirty = false;
+    return {};
+}
+
+bool PolicyMatcher::is_live(i64 policy_id, i64 now_ms) const
+{
+    auto it = m_entries.find(policy_id);
+    if (it == m_entries.end())
+        return false;
+    return it->value.expires_at_ms == -1 || it->value.expires_at_ms > now_ms;
+}
+
+void PolicyMatcher::consider_url_pattern(u32 pattern_index, StringView url, i64 now_ms, Optional<u32>& best) const
+{
+    if (best.has_value() && pattern_index >= *best)
+        return;
+
+    auto policy_id = m_compiled_url_policies[pattern_index];
+    auto it = m_entries.find(policy_id);
+    if (it == m_entries.end())
+        return;
+    if (it->value.expires_at_ms != -1 && it->value.expires_at_ms <= now_ms)
+        return;
+    if (matches_like_pattern(url, *it->value.url_pattern))
+        best = pattern_index;
+}
+
+Optional<i64> PolicyMatcher::match_url(StringView url, i64 now_ms) const
+{
+    // Until the automaton catches up with the latest changes, check every pattern in ID order
+    if (m_url_automaton_dirty) {
+        for (auto policy_id : m_url_pattern_policies) {
+            if (is_live(policy_id, now_ms) && matches_like_pattern(url, *m_entries.find(policy_id)->value.url_pattern))
+                return policy_id;
+        }
+        return {};
+    }
+
+    if (m_compiled_url_policies.is_empty())
+        return {};
+
+    Optional<u32> best;
+    for (auto pattern_index : m_unanchored_patterns)
+        consider_url_pattern(pattern_index, url, now_ms, best);
+
+    u32 state = 0;
+    for (auto byte : url.bytes()) {
+        state = m_transitions[state * m_alphabet_size + m_symbol_for_byte[byte]];
+        for (auto output_state = state; output_state != NO_STATE; output_state = m_output_links[output_state]) {
+            for (auto pattern_index : m_state_outputs[output_state])
+                consider_url_pattern(pattern_index, url, now_ms, best);
+        }
+        // Nothing can beat the oldest URL policy
+        if (best.has_value() && *best == 0)
+            break;
+    }
+
+    if (!best.has_value())
+        return {};
+    return m_compiled_url_policies[*best];
+}
+
+Optional<i64> PolicyMatcher::match(StringView file_hash, StringView url, StringView rule_name, i64 now_ms) const
+{
+    // Priority 1: file hash (most specific)
+    if (!file_hash.is_empty()) {
+        if (auto it = m_policies_by_file_hash.find(file_hash); it != m_policies_by_file_hash.end()) {
+            for (auto policy_id : it->value) {
+                if (is_live(policy_id, now_ms))
+                    return policy_id;
+            }
+        }
+    }
+
+    // Priority 2: URL pattern
+    if (auto policy_id = match_url(url, now_ms); policy_id.has_value())
+        return policy_id;
+
+    // Priority 3: rule name (least specific)
+    if (auto it = m_rule_name_ids.find(rule_name); it != m_rule_name_ids.end()) {
+        for (auto policy_id : m_rule_only_policies[it->value]) {
+            if (is_live(policy_id, now_ms))
+                return policy_id;
+        }
+    }
+
+    return {};
+}
+
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Array.h>
+#include <AK/Error.h>
+#include <AK/HashMap.h>
+#include <AK/NumericLimits.h>
+#include <AK/Optional.h>
+#include <AK/String.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+
+namespace Sentinel {
+
+// In-memory index of the policies PolicyGraph matches threats against.
+//
+// Matching follows the SQL path's semantics (priority: hash > URL pattern > rule name, oldest policy
+// first within each), but never touches SQLite and never allocates:
+//   - file hashes are looked up in a hash table,
+//   - URL patterns are prefiltered by an Aho-Corasick automaton over the longest literal run of each
+//     LIKE pattern, and only candidates whose literal occurs in the URL are fully matched,
+//   - rule names map to an interned ID, which indexes the rule-only policies.
+//
+// Entries are added and removed incrementally as policies change; only the URL automaton is
+// rebuilt, and only when the set of URL patterns changed. Not thread-safe; PolicyGraph serializes
+// access under its database mutex.
+class PolicyMatcher {
+public:
+    struct Entry {
+        i64 policy_id { -1 };
+        String rule_name;
+        Optional<String> url_pattern;
+        Optional<String> file_hash;
+
+        // Milliseconds since the epoch, or -1 for policies that never expire
+        i64 expires_at_ms { -1 };
+    };
+
+    ErrorOr<void> add(Entry);
+    void remove(i64 policy_id);
+    void clear();
+
+    bool contains(i64 policy_id) const { return m_entries.contains(policy_id); }
+    size_t size() const { return m_entries.size(); }
+
+    // Rebuild the URL automaton if URL patterns changed since the last compile. Until then, match()
+    // checks every URL pattern, so a failed compile only costs speed.
+    ErrorOr<void> compile();
+    bool needs_compile() const { return m_url_automaton_dirty; }
+
+    // Returns the ID of the matching policy, if any
+    Optional<i64> match(StringView file_hash, StringView url, StringView rule_name, i64 now_ms) const;
+
+    // SQLite's `text LIKE pattern ESCAPE '\'`: % matches any run of characters, _ any single
+    // character, \ escapes the next character, and ASCII letters compare case-insensitively
+    static bool matches_like_pattern(StringView text, StringView pattern);
+
+    size_t url_automaton_state_count() const { return m_url_automaton_state_count; }
+
+private:
+    static constexpr u32 NO_STATE = NumericLimits<u32>::max();
+
+    Optional<i64> match_url(StringView url, i64 now_ms) const;
+    void consider_url_pattern(u32 pattern_index, StringView url, i64 now_ms, Optional<u32>& best) const;
+    bool is_live(i64 policy_id, i64 now_ms) const;
+
+    static void insert_sorted(Vector<i64>&, i64 policy_id);
+    static void remove_sorted(Vector<i64>&, i64 policy_id);
+
+    HashMap<i64, Entry> m_entries;
+
+    HashMap<String, Vector<i64>> m_policies_by_file_hash;
+
+    // Rule-only policies (no hash and no URL pattern), by interned rule name
+    HashMap<String, u32> m_rule_name_ids;
+    Vector<Vector<i64>> m_rule_only_policies;
+
+    // Policies with a URL pattern, in ID order
+    Vector<i64> m_url_pattern_policies;
+    bool m_url_automaton_dirty { false };
+
+    // Compiled URL automaton. Pattern indices refer to m_compiled_url_policies, which is in ID order,
+    // so a lower pattern index always means a higher-priority policy.
+    Vector<i64> m_compiled_url_policies;
+    Array<u8, 256> m_symbol_for_byte {};
+    size_t m_alphabet_size { 0 };
+    size_t m_url_automaton_state_count { 0 };
+
+    // Indexed by state * m_alphabet_size + symbol
+    Vector<u32> m_transitions;
+
+    // Nearest state on each state's failure chain that has outputs, or NO_STATE
+    Vector<u32> m_output_links;
+
+    // Patterns whose anchor ends at each state
+    Vector<Vector<u32>> m_state_outputs;
+
+    // Patterns without a literal run (e.g. "%"), which every URL is checked against
+    Vector<u32> m_unanchored_patterns;
+};
+
+}
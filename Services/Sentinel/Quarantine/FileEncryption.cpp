@@ -4,9 +4,13 @@
  */
 
 #include "FileEncryption.h"
+#include <AK/Array.h>
+#include <AK/NumericLimits.h>
 #include <AK/Random.h>
 #include <LibCore/File.h>
+#include <LibCore/System.h>
 #include <LibCrypto/Cipher/AES.h>
+#include <LibCrypto/Hash/SHA2.h>
 
 namespace Sentinel::Quarantine {
 
@@ -76,36 +80,151 @@ ErrorOr<ByteBuffer> FileEncryption::decrypt_data(ReadonlyBytes encrypted_data, B
     return plaintext;
 }
 
-ErrorOr<void> FileEncryption::encrypt_file(String const& input_path, String const& output_path, ByteBuffer const& key)
+static constexpr auto CHUNKED_FORMAT_MAGIC = "SNTLQGCM"sv;
+
+struct FileEncryption::ChunkedHeader {
+    Array<u8, CHUNKED_HEADER_SIZE> bytes;
+    u32 chunk_size { 0 };
+    u64 plaintext_size { 0 };
+
+    u64 chunk_count() const { return ceil_div(plaintext_size, static_cast<u64>(chunk_size)); }
+
+    size_t plaintext_size_of_chunk(u64 chunk_index) const
+    {
+        return min<u64>(chunk_size, plaintext_size - chunk_index * chunk_size);
+    }
+
+    Array<u8, 12> nonce_for_chunk(u64 chunk_index) const
+    {
+        Array<u8, 12> nonce;
+        memcpy(nonce.data(), bytes.data() + CHUNKED_HEADER_SIZE - NONCE_PREFIX_SIZE, NONCE_PREFIX_SIZE);
+        auto index = static_cast<u32>(chunk_index);
+        for (size_t i = 0; i < sizeof(u32); ++i)
+            nonce[NONCE_PREFIX_SIZE + i] = static_cast<u8>(index >> (8 * (sizeof(u32) - 1 - i)));
+        return nonce;
+    }
+};
+
+ErrorOr<FileEncryption::ChunkedHeader> FileEncryption::read_chunked_header(Core::File& file)
 {
-    // Read input file
-    auto input_file = TRY(Core::File::open(input_path, Core::File::OpenMode::Read));
-    auto file_data = TRY(input_file->read_until_eof());
+    ChunkedHeader header;
+    TRY(file.read_until_filled(header.bytes));
+    if (ReadonlyBytes { header.bytes.data(), CHUNKED_FORMAT_MAGIC.length() } != CHUNKED_FORMAT_MAGIC.bytes())
+        return Error::from_string_literal("Not a chunked quarantine file");
+
+    memcpy(&header.chunk_size, header.bytes.data() + 8, sizeof(u32));
+    memcpy(&header.plaintext_size, header.bytes.data() + 8 + sizeof(u32), sizeof(u64));
+    if (header.chunk_size == 0 || header.chunk_count() > NumericLimits<u32>::max())
+        return Error::from_string_literal("Invalid chunked quarantine file header");
+    return header;
+}
 
-    // Encrypt data
-    auto encrypted_data = TRY(encrypt_data(file_data, key));
+ErrorOr<ByteBuffer> FileEncryption::decrypt_chunk(Core::File& file, ChunkedHeader const& header, u64 chunk_index, ByteBuffer const& key)
+{
+    auto plaintext_size = header.plaintext_size_of_chunk(chunk_index);
+    auto chunk_offset = CHUNKED_HEADER_SIZE + chunk_index * (header.chunk_size + TAG_SIZE);
+    TRY(file.seek(static_cast<i64>(chunk_offset), SeekMode::SetPosition));
 
-    // Write encrypted data to output file
-    auto output_file = TRY(Core::File::open(output_path, Core::File::OpenMode::Write));
-    TRY(output_file->write_until_depleted(encrypted_data));
+    auto ciphertext = TRY(ByteBuffer::create_uninitialized(plaintext_size));
+    Array<u8, TAG_SIZE> tag;
+    TRY(file.read_until_filled(ciphertext));
+    TRY(file.read_until_filled(tag));
 
-    return {};
+    Crypto::Cipher::AESGCMCipher cipher(key.bytes());
+    return cipher.decrypt(ciphertext, header.nonce_for_chunk(chunk_index), header.bytes, tag);
 }
 
-ErrorOr<void> FileEncryption::decrypt_file(String const& input_path, String const& output_path, ByteBuffer const& key)
+ErrorOr<FileEncryption::EncryptedFileInfo> FileEncryption::encrypt_file(String const& input_path, String const& output_path, ByteBuffer const& key)
 {
-    // Read encrypted file
-    auto input_file = TRY(Core::File::open(input_path, Core::File::OpenMode::Read));
-    auto encrypted_data = TRY(input_file->read_until_eof());
+    if (key.size() != KEY_SIZE)
+        return Error::from_string_literal("Invalid key size (expected 32 bytes for AES-256)");
 
-    // Decrypt data
-    auto plaintext = TRY(decrypt_data(encrypted_data, key));
+    auto input_file = TRY(Core::File::open(input_path, Core::File::OpenMode::Read));
+    auto plaintext_size = static_cast<u64>(TRY(Core::System::fstat(input_file->fd())).st_size);
+
+    ChunkedHeader header;
+    header.chunk_size = CHUNK_SIZE;
+    header.plaintext_size = plaintext_size;
+    memcpy(header.bytes.data(), CHUNKED_FORMAT_MAGIC.characters_without_null_termination(), CHUNKED_FORMAT_MAGIC.length());
+    memcpy(header.bytes.data() + 8, &header.chunk_size, sizeof(u32));
+    memcpy(header.bytes.data() + 8 + sizeof(u32), &header.plaintext_size, sizeof(u64));
+    AK::fill_with_random(header.bytes.span().slice(CHUNKED_HEADER_SIZE - NONCE_PREFIX_SIZE));
+    if (header.chunk_count() > NumericLimits<u32>::max())
+        return Error::from_string_literal("File too large to quarantine");
+
+    auto output_file = TRY(Core::File::open(output_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    TRY(output_file->write_until_depleted(header.bytes));
+
+    Crypto::Cipher::AESGCMCipher cipher(key.bytes());
+    auto sha256 = Crypto::Hash::SHA256::create();
+    auto chunk = TRY(ByteBuffer::create_uninitialized(CHUNK_SIZE));
+    for (u64 chunk_index = 0; chunk_index < header.chunk_count(); ++chunk_index) {
+        auto plaintext = chunk.bytes().trim(header.plaintext_size_of_chunk(chunk_index));
+        TRY(input_file->read_until_filled(plaintext));
+        sha256->update(plaintext);
+
+        auto encrypted = TRY(cipher.encrypt(plaintext, header.nonce_for_chunk(chunk_index), header.bytes, TAG_SIZE));
+        TRY(output_file->write_until_depleted(encrypted.ciphertext));
+        TRY(output_file->write_until_depleted(encrypted.tag));
+    }
+
+    return EncryptedFileInfo {
+        .plaintext_size = plaintext_size,
+        .plaintext_sha256 = TRY(ByteBuffer::copy(sha256->digest().bytes())),
+    };
+}
 
-    // Write plaintext to output file
-    auto output_file = TRY(Core::File::open(output_path, Core::File::OpenMode::Write));
-    TRY(output_file->write_until_depleted(plaintext));
+ErrorOr<void> FileEncryption::decrypt_file(String const& input_path, String const& output_path, ByteBuffer const& key)
+{
+    if (key.size() != KEY_SIZE)
+        return Error::from_string_literal("Invalid key size (expected 32 bytes for AES-256)");
 
+    auto input_file = TRY(Core::File::open(input_path, Core::File::OpenMode::Read));
+    auto header = read_chunked_header(*input_file);
+    if (header.is_error()) {
+        // Quarantined before the chunked format: [IV][AES-256-CBC ciphertext] of the whole file
+        TRY(input_file->seek(0, SeekMode::SetPosition));
+        auto encrypted_data = TRY(input_file->read_until_eof());
+        auto plaintext = TRY(decrypt_data(encrypted_data, key));
+
+        auto output_file = TRY(Core::File::open(output_path, Core::File::OpenMode::Write));
+        TRY(output_file->write_until_depleted(plaintext));
+        return {};
+    }
+
+    auto output_file = TRY(Core::File::open(output_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+    for (u64 chunk_index = 0; chunk_index < header.value().chunk_count(); ++chunk_index) {
+        auto plaintext = TRY(decrypt_chunk(*input_file, header.value(), chunk_index, key));
+        TRY(output_file->write_until_depleted(plaintext));
+    }
+
+    // Anything after the last chunk means the file isn't what was written
+    if (!TRY(input_file->read_until_eof()).is_empty())
+        return Error::from_string_literal("Unexpected data after the last chunk");
     return {};
 }
 
+ErrorOr<ByteBuffer> FileEncryption::decrypt_file_range(String const& input_path, u64 offset, size_t length, ByteBuffer const& key)
+{
+    if (key.size() != KEY_SIZE)
+        return Error::from_string_literal("Invalid key size (expected 32 bytes for AES-256)");
+
+    auto input_file = TRY(Core::File::open(input_path, Core::File::OpenMode::Read));
+    auto header = TRY(read_chunked_header(*input_file));
+    if (offset >= header.plaintext_size)
+        return ByteBuffer {};
+
+    auto end = offset + min<u64>(length, header.plaintext_size - offset);
+    ByteBuffer result;
+    TRY(result.try_ensure_capacity(end - offset));
+    for (u64 chunk_index = offset / header.chunk_size; chunk_index * header.chunk_size < end; ++chunk_index) {
+        auto plaintext = TRY(decrypt_chunk(*input_file, header, chunk_index, key));
+        auto chunk_start = chunk_index * header.chunk_size;
+        auto from = max(offset, chunk_start) - chunk_start;
+        auto to = min<u64>(end, chunk_start + plaintext.size()) - chunk_start;
+        TRY(result.try_append(plaintext.bytes().slice(from, to - from)));
+    }
+    return result;
+}
+
 }
@@ -8,35 +8,54 @@
 #include <AK/ByteBuffer.h>
 #include <AK/Error.h>
 #include <AK/String.h>
+#include <LibCore/Forward.h>
 
 namespace Sentinel::Quarantine {
 
-// File encryption utilities using AES-256-CBC
+// File encryption utilities
 // Used to encrypt quarantined files to prevent accidental execution
-// Uses LibCrypto's AESCBCCipher with automatic PKCS#7 padding
+//
+// Files are encrypted in fixed-size chunks with AES-256-GCM, so encrypting, decrypting or previewing a file only
+// ever holds one chunk in memory, however large the file is. Each chunk has its own nonce (a random per-file prefix
+// followed by the chunk index) and tag, and the header is authenticated along with every chunk, so chunks can't be
+// reordered, truncated or moved between files without decryption failing.
+// Format: [magic:8][chunk_size:4][plaintext_size:8][nonce_prefix:8], then [ciphertext][16-byte tag] per chunk
+//
+// In-memory data and files quarantined before the chunked format use AES-256-CBC with automatic PKCS#7 padding.
 class FileEncryption {
 public:
+    static constexpr size_t CHUNK_SIZE = 1 * MiB;
+
     // Generate a cryptographically secure 256-bit encryption key
     // Key should be stored securely (e.g., in system keyring or encrypted config)
     static ErrorOr<ByteBuffer> generate_encryption_key();
 
-    // Encrypt a file using AES-256-CBC
-    // Input: plaintext file path
-    // Output: encrypted file path with IV prepended to ciphertext
-    // Format: [16-byte IV][encrypted data with PKCS#7 padding]
-    static ErrorOr<void> encrypt_file(
+    struct EncryptedFileInfo {
+        u64 plaintext_size { 0 };
+        ByteBuffer plaintext_sha256;
+    };
+
+    // Encrypt a file in the chunked AES-256-GCM format
+    // The plaintext is hashed as it is encrypted, so callers don't need to read the file a second time
+    static ErrorOr<EncryptedFileInfo> encrypt_file(
         String const& input_path,
         String const& output_path,
         ByteBuffer const& key);
 
-    // Decrypt a file using AES-256-CBC
-    // Input: encrypted file path (with IV prepended)
-    // Output: plaintext file path
+    // Decrypt a file in either the chunked format or the older whole-file AES-256-CBC format
     static ErrorOr<void> decrypt_file(
         String const& input_path,
         String const& output_path,
         ByteBuffer const& key);
 
+    // Decrypt up to `length` bytes of plaintext starting at `offset`, reading only the chunks that cover them
+    // Only files in the chunked format support random access
+    static ErrorOr<ByteBuffer> decrypt_file_range(
+        String const& input_path,
+        u64 offset,
+        size_t length,
+        ByteBuffer const& key);
+
     // Encrypt data in memory (for smaller files)
     // Returns: [16-byte IV][encrypted data with PKCS#7 padding]
     static ErrorOr<ByteBuffer> encrypt_data(
@@ -55,6 +74,14 @@ private:
     static constexpr size_t KEY_SIZE = 32;
     static constexpr size_t IV_SIZE = 16;
 
+    static constexpr size_t NONCE_PREFIX_SIZE = 8;
+    static constexpr size_t TAG_SIZE = 16;
+    static constexpr size_t CHUNKED_HEADER_SIZE = 8 + sizeof(u32) + sizeof(u64) + NONCE_PREFIX_SIZE;
+
+    struct ChunkedHeader;
+    static ErrorOr<ChunkedHeader> read_chunked_header(Core::File&);
+    static ErrorOr<ByteBuffer> decrypt_chunk(Core::File&, ChunkedHeader const&, u64 chunk_index, ByteBuffer const& key);
+
     // Generate random IV for CBC mode
     static ErrorOr<ByteBuffer> generate_iv();
 };
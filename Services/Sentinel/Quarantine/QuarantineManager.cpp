@@ -99,24 +99,28 @@ ErrorOr<void> QuarantineManager::initialize_quarantine_directory()
     return {};
 }
 
+static ErrorOr<String> hex_digest(ReadonlyBytes digest)
+{
+    StringBuilder hash_string;
+    for (auto byte : digest)
+        hash_string.appendff("{:02x}", byte);
+    return hash_string.to_string();
+}
+
 ErrorOr<String> QuarantineManager::calculate_file_hash(String const& file_path)
 {
-    // Read file contents
+    // Hash the file a chunk at a time, so large files aren't read into memory whole
     auto file = TRY(Core::File::open(file_path, Core::File::OpenMode::Read));
-    auto file_data = TRY(file->read_until_eof());
-
-    // Calculate SHA256 hash
     auto sha256 = Crypto::Hash::SHA256::create();
-    sha256->update(file_data);
-    auto hash_bytes = sha256->digest();
-
-    // Convert to hex string
-    StringBuilder hash_string;
-    for (auto byte : hash_bytes.bytes()) {
-        hash_string.appendff("{:02x}", byte);
+    auto buffer = TRY(ByteBuffer::create_uninitialized(FileEncryption::CHUNK_SIZE));
+    while (true) {
+        auto chunk = TRY(file->read_some(buffer));
+        if (chunk.is_empty())
+            break;
+        sha256->update(chunk);
     }
 
-    return TRY(hash_string.to_string());
+    return hex_digest(sha256->digest().bytes());
 }
 
 String QuarantineManager::generate_quarantine_filename(String const& original_filename, String const& sha256_hash)
@@ -141,25 +145,28 @@ ErrorOr<QuarantineRecord> QuarantineManager::quarantine_file(
         return Error::from_string_literal("File not found");
     }
 
-    // Calculate file hash
-    auto sha256_hash = TRY(calculate_file_hash(file_path));
+    // Encrypt file into the quarantine directory, hashing it in the same pass
+    // The final name includes the hash, so the file is renamed once it's known
+    auto pending_path = MUST(String::formatted("{}/.pending_{}.quar", m_quarantine_dir, Core::System::getpid()));
+    auto encrypted = FileEncryption::encrypt_file(file_path, pending_path, m_encryption_key);
+    if (encrypted.is_error()) {
+        (void)FileSystem::remove(pending_path, FileSystem::RecursionMode::Disallowed);
+        return encrypted.release_error();
+    }
+    auto sha256_hash = TRY(hex_digest(encrypted.value().plaintext_sha256));
+    auto file_size = encrypted.value().plaintext_size;
 
     // Check if already quarantined (avoid duplicates)
     if (TRY(is_file_quarantined(sha256_hash))) {
         dbgln("QuarantineManager: File already quarantined (hash: {})", sha256_hash);
+        (void)FileSystem::remove(pending_path, FileSystem::RecursionMode::Disallowed);
         return Error::from_string_literal("File already quarantined");
     }
 
-    // Get file size
-    auto stat_result = TRY(Core::System::stat(file_path));
-    auto file_size = stat_result.st_size;
-
     // Generate quarantine filename
     auto quarantine_filename = generate_quarantine_filename(file_path, sha256_hash);
     auto quarantine_path = MUST(String::formatted("{}/{}", m_quarantine_dir, quarantine_filename));
-
-    // Encrypt file to quarantine location
-    TRY(FileEncryption::encrypt_file(file_path, quarantine_path, m_encryption_key));
+    TRY(Core::System::rename(pending_path, quarantine_path));
 
     // Delete original file (it's now safely encrypted in quarantine)
     TRY(FileSystem::remove(file_path, FileSystem::RecursionMode::Disallowed));
@@ -181,7 +188,7 @@ ErrorOr<QuarantineRecord> QuarantineManager::quarantine_file(
         .threat_score = threat_analysis.composite_score,
         .threat_level = threat_analysis.threat_level,
         .quarantined_at = UnixDateTime::now(),
-        .file_size = static_cast<u64>(file_size),
+        .file_size = file_size,
         .sha256_hash = sha256_hash
     };
 
@@ -3,7 +3,9 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/Array.h>
 #include <AK/Debug.h>
+#include <AK/EnumBits.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Random.h>
 #include <AK/ScopeGuard.h>
@@ -91,6 +93,11 @@ ErrorOr<void> BehavioralAnalyzer::initialize_sandbox()
     // Create temporary sandbox directory using mkdtemp
     m_sandbox_dir = TRY(create_temp_sandbox_directory());
 
+    // Resolved once, rather than probing the search paths for every sample. If it isn't there yet, each analysis
+    // looks for it again and fails on its own.
+    if (auto config_path = locate_nsjail_config_file(); !config_path.is_error())
+        m_nsjail_config_path = config_path.release_value();
+
     TRY(setup_seccomp_filter());
     dbgln_if(false, "BehavioralAnalyzer: nsjail sandbox initialized");
 
@@ -259,7 +266,7 @@ ErrorOr<Vector<String>> BehavioralAnalyzer::build_nsjail_command(
     TRY(command.try_append(TRY(String::from_utf8("-C"sv))));
 
     // Locate config file
-    auto config_path = TRY(locate_nsjail_config_file());
+    auto config_path = m_nsjail_config_path.is_empty() ? TRY(locate_nsjail_config_file()) : m_nsjail_config_path;
     TRY(command.try_append(config_path));
 
     // 3. Override time limit from SandboxConfig
@@ -375,6 +382,21 @@ ErrorOr<BehavioralMetrics> BehavioralAnalyzer::analyze_mock(ByteBuffer const& fi
     return metrics;
 }
 
+// The name of the syscall in an event line, without allocating anything
+static Optional<StringView> syscall_name_from_event_line(StringView line)
+{
+    constexpr auto SYSCALL_MARKER = "[SYSCALL]"sv;
+    if (!line.starts_with(SYSCALL_MARKER))
+        return {};
+
+    auto content = line.substring_view(SYSCALL_MARKER.length()).trim_whitespace();
+    auto paren_pos = content.find('(');
+    auto name = paren_pos.has_value() ? content.substring_view(0, paren_pos.value()).trim_whitespace() : content;
+    if (name.is_empty())
+        return {};
+    return name;
+}
+
 ErrorOr<BehavioralMetrics> BehavioralAnalyzer::analyze_nsjail(ByteBuffer const& file_data, String const& filename)
 {
     // Real nsjail implementation with syscall monitoring
@@ -388,6 +410,13 @@ ErrorOr<BehavioralMetrics> BehavioralAnalyzer::analyze_nsjail(ByteBuffer const&
     auto file_path = TRY(write_file_to_sandbox(m_sandbox_dir, file_data, filename));
     dbgln_if(false, "BehavioralAnalyzer: Wrote file to sandbox: {}", file_path);
 
+    // The sandbox directory is reused for every sample, so only the sample itself is removed afterwards. This also
+    // saves spawning a shell to remove the whole directory for each one.
+    ScopeGuard sample_cleanup = [&file_path] {
+        if (auto result = Core::System::unlink(file_path.bytes_as_string_view()); result.is_error())
+            dbgln("BehavioralAnalyzer: Warning - Failed to remove sample {}: {}", file_path, result.error());
+    };
+
     // Step 2: Make executable
     TRY(make_executable(file_path));
 
@@ -427,20 +456,16 @@ ErrorOr<BehavioralMetrics> BehavioralAnalyzer::analyze_nsjail(ByteBuffer const&
 
         auto lines = lines_result.release_value();
 
-        // Parse each line for syscall events
+        // Parse each line for syscall events. Only the name feeds into the metrics, so the arguments aren't parsed.
         for (auto const& line : lines) {
-            auto event_result = TRY(parse_syscall_event(line.bytes_as_string_view()));
-
-            if (event_result.has_value()) {
-                auto const& event = event_result.value();
+            auto syscall_name = syscall_name_from_event_line(line.bytes_as_string_view());
+            if (!syscall_name.has_value())
+                continue;
 
-                // Update metrics based on syscall name
-                update_metrics_from_syscall(event.name.bytes_as_string_view(), metrics);
+            update_metrics_from_syscall(*syscall_name, metrics);
 
-                syscall_count++;
-                dbgln_if(false, "BehavioralAnalyzer: Syscall #{}: {} (args: {})",
-                    syscall_count, event.name, event.args.size());
-            }
+            syscall_count++;
+            dbgln_if(false, "BehavioralAnalyzer: Syscall #{}: {}", syscall_count, *syscall_name);
         }
 
         // Check if process has exited
@@ -472,9 +497,6 @@ ErrorOr<BehavioralMetrics> BehavioralAnalyzer::analyze_nsjail(ByteBuffer const&
         dbgln_if(false, "BehavioralAnalyzer: Sandbox exited normally with code {}", exit_code);
     }
 
-    // Step 9: Cleanup temp file
-    TRY(cleanup_temp_directory(m_sandbox_dir));
-
     return metrics;
 }
 
@@ -1808,243 +1830,137 @@ ErrorOr<Optional<SyscallEvent>> BehavioralAnalyzer::parse_syscall_event(StringVi
 // Syscall-to-Metrics Mapping (Week 2)
 // ============================================================================
 
-void BehavioralAnalyzer::update_metrics_from_syscall(StringView syscall_name, BehavioralMetrics& metrics)
+// Which BehavioralMetrics counters a syscall counts towards
+enum class SyscallMetrics : u8 {
+    None = 0,
+    FileOperation = 1 << 0,
+    ProcessOperation = 1 << 1,
+    CodeInjectionAttempt = 1 << 2,
+    NetworkOperation = 1 << 3,
+    OutboundConnection = 1 << 4,
+    MemoryOperation = 1 << 5,
+    PrivilegeEscalationAttempt = 1 << 6,
+};
+AK_ENUM_BITWISE_OPERATORS(SyscallMetrics);
+
+// This is called for every monitored syscall, so the mapping is a single hash lookup rather than a comparison against
+// each known name in turn.
+static HashMap<StringView, SyscallMetrics> const& syscall_metrics_table()
 {
-    // Map Linux syscalls to BehavioralMetrics fields
-    // This is called for every monitored syscall, so performance is critical
-    // Using if/else chain for speed (faster than HashMap lookup)
-    //
-    // Categories:
-    // 1. File System Operations (open, write, unlink, etc.)
-    // 2. Process Operations (fork, exec, ptrace, etc.)
-    // 3. Network Operations (socket, connect, send, etc.)
-    // 4. Memory Operations (mmap, mprotect, etc.)
-    // 5. System/Privilege Operations (setuid, mount, etc.)
-
-    // ===== Category 1: File System Operations =====
-
-    // File I/O operations - basic read/write
-    if (syscall_name == "open"sv || syscall_name == "openat"sv || syscall_name == "openat2"sv || syscall_name == "creat"sv) {
-        metrics.file_operations++;
-        // Note: Would need to inspect arguments to detect temp/hidden files
-        // For now, increment general counter
-    } else if (syscall_name == "write"sv || syscall_name == "pwrite64"sv || syscall_name == "writev"sv || syscall_name == "pwritev"sv || syscall_name == "pwritev2"sv) {
-        metrics.file_operations++;
-        // Heuristic: Rapid writes may indicate ransomware
-        // Consider tracking write rate (writes per second)
-    } else if (syscall_name == "read"sv || syscall_name == "pread64"sv || syscall_name == "readv"sv || syscall_name == "preadv"sv || syscall_name == "preadv2"sv) {
-        metrics.file_operations++;
-    }
+    static auto const table = [] {
+        HashMap<StringView, SyscallMetrics> table;
+        auto map = [&](SyscallMetrics metrics, auto const& names) {
+            for (auto name : names)
+                table.set(name, metrics);
+        };
 
-    // File deletion operations
-    else if (syscall_name == "unlink"sv || syscall_name == "unlinkat"sv || syscall_name == "rmdir"sv) {
-        metrics.file_operations++;
-        // Heuristic: Rapid deletions may indicate ransomware cleanup
-    }
+        // ===== Category 1: File System Operations =====
+        // Rapid writes, deletions and renames may indicate ransomware; chmod +x may indicate an executable drop.
+        // Detecting temp/hidden files or specific modes would need argument inspection.
+        static constexpr Array file_syscalls = {
+            "open"sv, "openat"sv, "openat2"sv, "creat"sv,
+            "write"sv, "pwrite64"sv, "writev"sv, "pwritev"sv, "pwritev2"sv,
+            "read"sv, "pread64"sv, "readv"sv, "preadv"sv, "preadv2"sv,
+            "unlink"sv, "unlinkat"sv, "rmdir"sv,
+            "rename"sv, "renameat"sv, "renameat2"sv,
+            "mkdir"sv, "mkdirat"sv,
+            "chmod"sv, "fchmod"sv, "fchmodat"sv, "chown"sv, "fchown"sv, "fchownat"sv, "lchown"sv,
+            "truncate"sv, "ftruncate"sv,
+        };
+        map(SyscallMetrics::FileOperation, file_syscalls);
 
-    // File renaming operations
-    else if (syscall_name == "rename"sv || syscall_name == "renameat"sv || syscall_name == "renameat2"sv) {
-        metrics.file_operations++;
-        // Heuristic: Rapid renames may indicate ransomware encryption
-    }
+        // ===== Category 2: Process Operations =====
+        // Excessive forking may indicate a fork bomb or process spawning malware.
+        static constexpr Array process_syscalls = {
+            "fork"sv, "vfork"sv, "clone"sv, "clone3"sv,
+            "execve"sv, "execveat"sv,
+        };
+        map(SyscallMetrics::ProcessOperation, process_syscalls);
+
+        // ptrace and direct reads/writes of another process's memory are the injection vectors on Linux
+        map(SyscallMetrics::CodeInjectionAttempt, Array { "ptrace"sv, "process_vm_readv"sv, "process_vm_writev"sv });
+
+        // ===== Category 3: Network Operations =====
+        // bind/listen may indicate a backdoor server.
+        static constexpr Array network_syscalls = {
+            "socket"sv,
+            "bind"sv, "listen"sv, "accept"sv, "accept4"sv,
+            "send"sv, "sendto"sv, "sendmsg"sv, "sendmmsg"sv,
+            "recv"sv, "recvfrom"sv, "recvmsg"sv, "recvmmsg"sv,
+            "setsockopt"sv, "getsockopt"sv,
+        };
+        map(SyscallMetrics::NetworkOperation, network_syscalls);
+        // TODO: Extract the remote IP from the sockaddr argument, to count unique outbound connections
+        map(SyscallMetrics::NetworkOperation | SyscallMetrics::OutboundConnection, Array { "connect"sv });
+
+        // ===== Category 4: Memory Operations =====
+        map(SyscallMetrics::MemoryOperation, Array { "mmap"sv, "mmap2"sv, "mremap"sv, "munmap"sv, "brk"sv });
+
+        // Legitimate programs rarely change memory protection, so any mprotect call counts as suspicious.
+        // Parsing the protection flags would allow only counting RWX pages ((arg2 & 7) == 7).
+        map(SyscallMetrics::MemoryOperation | SyscallMetrics::CodeInjectionAttempt, Array { "mprotect"sv });
+
+        // ===== Category 5: System & Privilege Operations =====
+        // These should be blocked by seccomp, but attempts are tracked.
+        static constexpr Array privilege_syscalls = {
+            "setuid"sv, "setuid32"sv, "setgid"sv, "setgid32"sv, "setreuid"sv, "setregid"sv,
+            "setresuid"sv, "setresgid"sv, "setfsuid"sv, "setfsgid"sv,
+            "capset"sv, "capget"sv,
+            "mount"sv, "umount"sv, "umount2"sv, "pivot_root"sv,
+            "unshare"sv, "setns"sv,
+            "chroot"sv,
+            "init_module"sv, "delete_module"sv, "finit_module"sv,
+            "reboot"sv, "kexec_load"sv, "kexec_file_load"sv,
+            "ioperm"sv, "iopl"sv,
+            "syslog"sv,
+            "quotactl"sv,
+        };
+        map(SyscallMetrics::PrivilegeEscalationAttempt, privilege_syscalls);
 
-    // Directory operations
-    else if (syscall_name == "mkdir"sv || syscall_name == "mkdirat"sv) {
-        metrics.file_operations++;
-        // TODO: Inspect path argument to detect temp directories (/tmp, %TEMP%)
-        // For now, assume potential temp directory creation
-        // This would require argument parsing in real implementation
-    }
+        // ===== Notes on Unmapped Syscalls =====
+        //
+        // The following syscalls are allowed by our seccomp policy but not mapped to metrics
+        // because they are benign and would create noise:
+        //
+        // - stat, fstat, lstat, newfstatat, statx (file metadata reading)
+        // - lseek, _llseek (file seeking)
+        // - dup, dup2, dup3, fcntl (file descriptor operations)
+        // - ioctl (device I/O - complex, context-dependent)
+        // - getpid, getppid, gettid, getuid, etc. (process info queries)
+        // - rt_sigaction, rt_sigprocmask, etc. (signal handling)
+        // - getcwd, chdir (directory navigation)
+        // - clock_gettime, gettimeofday, time (time queries)
+        // - select, poll, epoll_* (I/O multiplexing)
+        // - access, readlink (metadata queries)
+        // - set_thread_area, arch_prctl (thread-local storage)
+        // - getrlimit, prlimit64 (resource queries)
+        // - futex (fast user-space mutexes)
+        //
+        // These are essential for program operation and don't indicate malicious behavior.
+        return table;
+    }();
+    return table;
+}
 
-    // File metadata modifications
-    else if (syscall_name == "chmod"sv || syscall_name == "fchmod"sv || syscall_name == "fchmodat"sv || syscall_name == "chown"sv || syscall_name == "fchown"sv || syscall_name == "fchownat"sv || syscall_name == "lchown"sv) {
-        metrics.file_operations++;
-        // Heuristic: chmod +x may indicate executable drop
-        // Would require argument inspection to detect 0755, 0700, etc.
-    }
+void BehavioralAnalyzer::update_metrics_from_syscall(StringView syscall_name, BehavioralMetrics& metrics)
+{
+    auto syscall_metrics = syscall_metrics_table().get(syscall_name).value_or(SyscallMetrics::None);
+    if (syscall_metrics == SyscallMetrics::None)
+        return;
 
-    // File truncation (potential data destruction)
-    else if (syscall_name == "truncate"sv || syscall_name == "ftruncate"sv) {
+    if (has_flag(syscall_metrics, SyscallMetrics::FileOperation))
         metrics.file_operations++;
-    }
-
-    // ===== Category 2: Process Operations =====
-
-    // Process creation
-    else if (syscall_name == "fork"sv || syscall_name == "vfork"sv || syscall_name == "clone"sv || syscall_name == "clone3"sv) {
+    if (has_flag(syscall_metrics, SyscallMetrics::ProcessOperation))
         metrics.process_operations++;
-        // Heuristic: Excessive forking may indicate fork bomb or process spawning malware
-    }
-
-    // Process execution
-    else if (syscall_name == "execve"sv || syscall_name == "execveat"sv) {
-        metrics.process_operations++;
-        // TODO: Inspect executable path argument to detect suspicious executables
-        // e.g., /tmp/*, hidden files, script interpreters with inline code
-    }
-
-    // Process debugging/injection
-    else if (syscall_name == "ptrace"sv) {
-        metrics.code_injection_attempts++;
-        // ptrace is the primary mechanism for process injection on Linux
-        // Also used by debuggers, but suspicious in sandboxed context
-    }
-
-    // Process memory reading/writing (alternative injection vector)
-    else if (syscall_name == "process_vm_readv"sv || syscall_name == "process_vm_writev"sv) {
+    if (has_flag(syscall_metrics, SyscallMetrics::CodeInjectionAttempt))
         metrics.code_injection_attempts++;
-        // Direct memory read/write to another process - highly suspicious
-    }
-
-    // ===== Category 3: Network Operations =====
-
-    // Socket creation
-    else if (syscall_name == "socket"sv) {
-        metrics.network_operations++;
-        // TODO: Inspect socket type (AF_INET, AF_INET6, AF_UNIX)
-        // For now, count all socket creations
-    }
-
-    // Outbound connections
-    else if (syscall_name == "connect"sv) {
+    if (has_flag(syscall_metrics, SyscallMetrics::NetworkOperation))
         metrics.network_operations++;
+    if (has_flag(syscall_metrics, SyscallMetrics::OutboundConnection))
         metrics.outbound_connections++;
-        // TODO: Extract remote IP from sockaddr argument
-        // Track unique IPs for accurate outbound_connections count
-    }
-
-    // Network server operations (suspicious in most malware)
-    else if (syscall_name == "bind"sv || syscall_name == "listen"sv || syscall_name == "accept"sv || syscall_name == "accept4"sv) {
-        metrics.network_operations++;
-        // Heuristic: bind/listen may indicate backdoor server
-    }
-
-    // Network data transfer
-    else if (syscall_name == "send"sv || syscall_name == "sendto"sv || syscall_name == "sendmsg"sv || syscall_name == "sendmmsg"sv) {
-        metrics.network_operations++;
-        // TODO: Track data volume sent
-    } else if (syscall_name == "recv"sv || syscall_name == "recvfrom"sv || syscall_name == "recvmsg"sv || syscall_name == "recvmmsg"sv) {
-        metrics.network_operations++;
-        // TODO: Track data volume received
-    }
-
-    // Socket options (used for advanced network manipulation)
-    else if (syscall_name == "setsockopt"sv || syscall_name == "getsockopt"sv) {
-        metrics.network_operations++;
-    }
-
-    // ===== Category 4: Memory Operations =====
-
-    // Memory allocation/mapping
-    else if (syscall_name == "mmap"sv || syscall_name == "mmap2"sv || syscall_name == "mremap"sv) {
-        metrics.memory_operations++;
-        // TODO: Track total memory allocated (potential heap spray detection)
-    }
-
-    // Memory protection changes
-    else if (syscall_name == "mprotect"sv) {
+    if (has_flag(syscall_metrics, SyscallMetrics::MemoryOperation))
         metrics.memory_operations++;
-        // TODO: Inspect protection flags from arguments
-        // CRITICAL: Detect RWX pages (PROT_READ | PROT_WRITE | PROT_EXEC)
-        // RWX memory is strong indicator of code injection/shellcode execution
-        //
-        // Heuristic detection without argument parsing:
-        // - Any mprotect call is suspicious in sandboxed malware
-        // - Legitimate programs rarely change memory protection
-        // - JIT compilers use mprotect, but unlikely in our threat model
-        //
-        // For comprehensive detection, would parse arguments:
-        //   arg2 = protection flags (PROT_READ=1, PROT_WRITE=2, PROT_EXEC=4)
-        //   if ((arg2 & 7) == 7) -> RWX detected
-        metrics.code_injection_attempts++;
-    }
-
-    // Memory unmapping
-    else if (syscall_name == "munmap"sv) {
-        metrics.memory_operations++;
-    }
-
-    // Heap operations
-    else if (syscall_name == "brk"sv) {
-        metrics.memory_operations++;
-    }
-
-    // ===== Category 5: System & Privilege Operations =====
-
-    // Privilege escalation attempts
-    else if (syscall_name == "setuid"sv || syscall_name == "setuid32"sv || syscall_name == "setgid"sv || syscall_name == "setgid32"sv || syscall_name == "setreuid"sv || syscall_name == "setregid"sv || syscall_name == "setresuid"sv || syscall_name == "setresgid"sv || syscall_name == "setfsuid"sv || syscall_name == "setfsgid"sv) {
-        metrics.privilege_escalation_attempts++;
-        // These should be blocked by seccomp, but track attempts
-    }
-
-    // Capability manipulation
-    else if (syscall_name == "capset"sv || syscall_name == "capget"sv) {
+    if (has_flag(syscall_metrics, SyscallMetrics::PrivilegeEscalationAttempt))
         metrics.privilege_escalation_attempts++;
-        // Linux capabilities - alternative privilege escalation vector
-    }
-
-    // Filesystem mounting (should be blocked, but track attempts)
-    else if (syscall_name == "mount"sv || syscall_name == "umount"sv || syscall_name == "umount2"sv || syscall_name == "pivot_root"sv) {
-        metrics.privilege_escalation_attempts++;
-    }
-
-    // Namespace manipulation (container escape attempts)
-    else if (syscall_name == "unshare"sv || syscall_name == "setns"sv) {
-        metrics.privilege_escalation_attempts++;
-    }
-
-    // Chroot (privilege escalation via chroot escape)
-    else if (syscall_name == "chroot"sv) {
-        metrics.privilege_escalation_attempts++;
-    }
-
-    // Kernel module operations (should be blocked, critical if successful)
-    else if (syscall_name == "init_module"sv || syscall_name == "delete_module"sv || syscall_name == "finit_module"sv) {
-        metrics.privilege_escalation_attempts++;
-    }
-
-    // ===== Additional Suspicious Operations =====
-
-    // Reboot/system control (should be blocked)
-    else if (syscall_name == "reboot"sv || syscall_name == "kexec_load"sv || syscall_name == "kexec_file_load"sv) {
-        // Extremely suspicious - potential ransomware trigger
-        metrics.privilege_escalation_attempts++;
-    }
-
-    // I/O port access (hardware manipulation)
-    else if (syscall_name == "ioperm"sv || syscall_name == "iopl"sv) {
-        metrics.privilege_escalation_attempts++;
-    }
-
-    // System logging (may be used to detect security tools)
-    else if (syscall_name == "syslog"sv) {
-        metrics.privilege_escalation_attempts++;
-    }
-
-    // Quota management (filesystem manipulation)
-    else if (syscall_name == "quotactl"sv) {
-        metrics.privilege_escalation_attempts++;
-    }
-
-    // ===== Notes on Unmapped Syscalls =====
-    //
-    // The following syscalls are allowed by our seccomp policy but not mapped to metrics
-    // because they are benign and would create noise:
-    //
-    // - stat, fstat, lstat, newfstatat, statx (file metadata reading)
-    // - lseek, _llseek (file seeking)
-    // - dup, dup2, dup3, fcntl (file descriptor operations)
-    // - ioctl (device I/O - complex, context-dependent)
-    // - getpid, getppid, gettid, getuid, etc. (process info queries)
-    // - rt_sigaction, rt_sigprocmask, etc. (signal handling)
-    // - getcwd, chdir (directory navigation)
-    // - clock_gettime, gettimeofday, time (time queries)
-    // - select, poll, epoll_* (I/O multiplexing)
-    // - access, readlink (metadata queries)
-    // - set_thread_area, arch_prctl (thread-local storage)
-    // - getrlimit, prlimit64 (resource queries)
-    // - futex (fast user-space mutexes)
-    //
-    // These are essential for program operation and don't indicate malicious behavior.
 }
 }
@@ -293,7 +293,8 @@ private:
 
     // Native sandbox state
     bool m_use_mock { true };                     // True if nsjail not available
-    String m_sandbox_dir;                         // Temporary directory for sandbox
+    String m_sandbox_dir;                         // Temporary directory for sandbox, reused for every sample
+    String m_nsjail_config_path;                  // Located once when the sandbox is initialized
 
     // Syscall tracing state (real implementation)
     HashMap<int, u32> m_syscall_counts;           // syscall_number -> count
@@ -5,9 +5,11 @@
 
 #include <AK/Debug.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/ScopeGuard.h>
 #include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
+#include <LibThreading/Thread.h>
 #include <openssl/evp.h>
 #include <openssl/sha.h>
 
@@ -107,6 +109,10 @@ ErrorOr<void> Orchestrator::initialize_components()
         } else {
             m_policy_graph = policy_graph_result.release_value();
             dbgln_if(false, "Orchestrator: PolicyGraph initialized (verdict caching enabled)");
+
+            // Verdicts are a cache, so batching their writes trades nothing but recomputation after a crash
+            if (auto result = m_policy_graph->set_write_durability(PolicyGraph::WriteDurability::GroupCommit); result.is_error())
+                dbgln("Orchestrator: Warning - group commit unavailable: {}", result.error());
         }
     }
 
@@ -213,7 +219,23 @@ ErrorOr<SandboxResult> Orchestrator::analyze_file(ByteBuffer const& file_data, S
     SandboxResult result;
     result.verdict_explanation = TRY(String::formatted("Analyzing '{}'...", filename));
 
-    // Stage 1: Tier 1 WASM sandbox (fast pre-analysis)
+    // Stage 1: The cheap engines. The VirusTotal lookup is a network round trip, so it runs on its
+    // own thread alongside the Tier 1 WASM pre-analysis instead of after everything else.
+    Optional<ErrorOr<ThreatIntelligence::VirusTotalResult>> vt_result;
+    RefPtr<Threading::Thread> vt_thread;
+    ScopeGuard join_vt_thread = [&] {
+        if (vt_thread)
+            (void)vt_thread->join();
+    };
+    if (m_vt_client && !file_hash.is_empty()) {
+        vt_thread = TRY(Threading::Thread::try_create("VirusTotalLookup"sv, [this, &vt_result, &file_hash]() -> intptr_t {
+            vt_result = m_vt_client->lookup_file_hash(file_hash);
+            return 0;
+        }));
+        vt_thread->start();
+    }
+
+    bool tier1_succeeded = false;
     if (m_config.enable_tier1_wasm && m_wasm_executor) {
         auto tier1_result = execute_tier1_wasm(file_data, filename);
         if (tier1_result.is_error()) {
@@ -222,55 +244,20 @@ ErrorOr<SandboxResult> Orchestrator::analyze_file(ByteBuffer const& file_data, S
         } else {
             result = tier1_result.release_value();
             m_stats.tier1_executions++;
-
-            // If Tier 1 verdict is conclusive (very clean or very malicious), skip Tier 2
-            if (result.confidence > 0.9f) {
-                dbgln_if(false, "Orchestrator: Tier 1 verdict conclusive (confidence: {}), skipping Tier 2", result.confidence);
-                TRY(generate_verdict(result));
-                result.execution_time = MonotonicTime::now() - start_time;
-                return result;
-            }
+            tier1_succeeded = true;
         }
     }
 
-    // Stage 2: Tier 2 native sandbox (deep behavioral analysis)
-    if (m_config.enable_tier2_native && m_behavioral_analyzer) {
-        // Only run Tier 2 if file is suspicious
-        if (result.composite_score > 0.3f || !m_config.enable_tier1_wasm) {
-            auto tier2_result = execute_tier2_native(file_data, filename);
-            if (tier2_result.is_error()) {
-                dbgln("Orchestrator: Tier 2 native execution failed: {}", tier2_result.error());
-                // Use Tier 1 result if available
-                if (result.composite_score == 0.0f) {
-                    return Error::from_string_literal("Both sandbox tiers failed");
-                }
-            } else {
-                // Merge Tier 2 results into existing result
-                auto tier2 = tier2_result.release_value();
-                result.behavioral_score = tier2.behavioral_score;
-                result.file_operations = tier2.file_operations;
-                result.process_operations = tier2.process_operations;
-                result.network_operations = tier2.network_operations;
-                result.registry_operations = tier2.registry_operations;
-                result.memory_operations = tier2.memory_operations;
-
-                // Append behavioral detections
-                for (auto const& behavior : tier2.detected_behaviors)
-                    TRY(result.detected_behaviors.try_append(behavior));
-
-                m_stats.tier2_executions++;
-            }
-        }
+    if (vt_thread) {
+        (void)vt_thread->join();
+        vt_thread = nullptr;
     }
-
-    // Stage 3: VirusTotal lookup (if enabled and file hash available)
-    if (m_vt_client && !file_hash.is_empty()) {
-        auto vt_result = m_vt_client->lookup_file_hash(file_hash);
-        if (vt_result.is_error()) {
-            dbgln("Orchestrator: VirusTotal lookup failed: {}", vt_result.error());
+    if (vt_result.has_value()) {
+        if (vt_result->is_error()) {
+            dbgln("Orchestrator: VirusTotal lookup failed: {}", vt_result->error());
             // Continue without VT score - graceful degradation
         } else {
-            auto vt = vt_result.release_value();
+            auto const& vt = vt_result->value();
             result.vt_score = vt.threat_score;
             result.vt_malicious_count = vt.malicious_count;
             result.vt_total_engines = vt.total_engines;
@@ -287,8 +274,51 @@ ErrorOr<SandboxResult> Orchestrator::analyze_file(ByteBuffer const& file_data, S
         }
     }
 
-    // Stage 4: Generate final verdict
-    TRY(generate_verdict(result));
+    // Stage 2: Tier 2 native sandbox (deep behavioral analysis), only if its score could still
+    // change the threat level. Without a Tier 1 result it is all the evidence there is, so it always runs.
+    bool tier2_available = m_config.enable_tier2_native && m_behavioral_analyzer;
+    Optional<Verdict> settled_verdict;
+    if (tier1_succeeded || !tier2_available) {
+        settled_verdict = TRY(m_verdict_engine->calculate_settled_verdict({
+            .yara = result.yara_score,
+            .ml = result.ml_score,
+            .behavioral = tier2_available ? Optional<float> {} : Optional<float> { 0.0f },
+            .vt = result.vt_score,
+        }));
+    }
+
+    if (settled_verdict.has_value()) {
+        if (tier2_available) {
+            dbgln_if(false, "Orchestrator: Verdict settled before Tier 2, skipping native sandbox");
+            m_stats.tier2_skipped++;
+        }
+        apply_verdict(result, settled_verdict.release_value());
+    } else {
+        auto tier2_result = execute_tier2_native(file_data, filename);
+        if (tier2_result.is_error()) {
+            dbgln("Orchestrator: Tier 2 native execution failed: {}", tier2_result.error());
+            if (!tier1_succeeded)
+                return Error::from_string_literal("Both sandbox tiers failed");
+        } else {
+            // Merge Tier 2 results into existing result
+            auto tier2 = tier2_result.release_value();
+            result.behavioral_score = tier2.behavioral_score;
+            result.file_operations = tier2.file_operations;
+            result.process_operations = tier2.process_operations;
+            result.network_operations = tier2.network_operations;
+            result.registry_operations = tier2.registry_operations;
+            result.memory_operations = tier2.memory_operations;
+
+            // Append behavioral detections
+            for (auto const& behavior : tier2.detected_behaviors)
+                TRY(result.detected_behaviors.try_append(behavior));
+
+            m_stats.tier2_executions++;
+        }
+
+        // Stage 3: Generate final verdict
+        TRY(generate_verdict(result));
+    }
 
     result.execution_time = MonotonicTime::now() - start_time;
 
@@ -425,6 +455,12 @@ ErrorOr<void> Orchestrator::generate_verdict(SandboxResult& result)
         result.behavioral_score,
         result.vt_score));
 
+    apply_verdict(result, move(verdict));
+    return {};
+}
+
+void Orchestrator::apply_verdict(SandboxResult& result, Verdict verdict)
+{
     result.composite_score = verdict.composite_score;
     result.confidence = verdict.confidence;
     result.threat_level = verdict.threat_level;
@@ -432,8 +468,6 @@ ErrorOr<void> Orchestrator::generate_verdict(SandboxResult& result)
 
     dbgln_if(false, "Orchestrator: Verdict - Composite: {:.2f}, Confidence: {:.2f}, Level: {}",
         result.composite_score, result.confidence, static_cast<int>(result.threat_level));
-
-    return {};
 }
 
 void Orchestrator::reset_statistics()
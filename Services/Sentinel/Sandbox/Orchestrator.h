@@ -34,6 +34,7 @@ class WasmExecutor;
 class BehavioralAnalyzer;
 class VerdictEngine;
 class Reporter;
+struct Verdict;
 
 // Sandbox execution result with comprehensive analysis
 struct SandboxResult {
@@ -84,6 +85,7 @@ struct SandboxConfig {
     u64 max_memory_bytes { 128 * 1024 * 1024 };      // 128 MB memory limit
     bool use_mock_for_testing { false };              // TESTING ONLY: Skip nsjail requirement
     bool enable_network_isolation { false };          // Isolate suspicious processes from network
+    size_t wasm_warm_instances { 2 };                 // Tier 1 WASM instances kept ready ahead of use
 };
 
 // Orchestrator - coordinates sandbox execution and analysis
@@ -97,10 +99,9 @@ public:
     ~Orchestrator();
 
     // Main entry point: sandbox a file and return threat assessment
-    // 1. Extract features (YARA + ML)
-    // 2. If suspicious: Run Tier 1 WASM sandbox
-    // 3. If still suspicious: Run Tier 2 native sandbox
-    // 4. Generate verdict with confidence score
+    // 1. Run Tier 1 WASM pre-analysis (YARA + ML) with the VirusTotal lookup in parallel
+    // 2. If Tier 2 could still change the threat level: Run Tier 2 native sandbox
+    // 3. Generate verdict with confidence score
     ErrorOr<SandboxResult> analyze_file(ByteBuffer const& file_data, String const& filename);
 
     // Analyze with pre-computed ML features (optimization)
@@ -114,6 +115,7 @@ public:
         u64 total_files_analyzed { 0 };
         u64 tier1_executions { 0 };                   // WASM sandbox runs
         u64 tier2_executions { 0 };                   // Native sandbox runs
+        u64 tier2_skipped { 0 };                      // Verdict settled before the native sandbox was needed
         u64 malicious_detected { 0 };
         u64 timeouts { 0 };
         Duration average_tier1_time;
@@ -137,6 +139,7 @@ private:
     ErrorOr<SandboxResult> execute_tier1_wasm(ByteBuffer const& file_data, String const& filename);
     ErrorOr<SandboxResult> execute_tier2_native(ByteBuffer const& file_data, String const& filename);
     ErrorOr<void> generate_verdict(SandboxResult& result);
+    void apply_verdict(SandboxResult& result, Verdict verdict);
 
     // Component lifecycle
     ErrorOr<void> setup_sandbox_environment();
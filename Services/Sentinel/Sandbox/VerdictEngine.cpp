@@ -86,6 +86,40 @@ ErrorOr<Verdict> VerdictEngine::calculate_verdict(
     return verdict;
 }
 
+ErrorOr<Optional<Verdict>> VerdictEngine::calculate_settled_verdict(PartialScores const& scores) const
+{
+    if (!is_settled(scores))
+        return Optional<Verdict> {};
+
+    return TRY(calculate_verdict(
+        scores.yara.value_or(0.0f),
+        scores.ml.value_or(0.0f),
+        scores.behavioral.value_or(0.0f),
+        scores.vt.value_or(0.0f)));
+}
+
+CompositeRange VerdictEngine::composite_range(PartialScores const& scores) const
+{
+    // The composite is linear in each score, so its extremes are at every missing score being 0.0 or 1.0
+    auto minimum = calculate_composite_score(
+        scores.yara.value_or(0.0f),
+        scores.ml.value_or(0.0f),
+        scores.behavioral.value_or(0.0f),
+        scores.vt.value_or(0.0f));
+    auto maximum = calculate_composite_score(
+        scores.yara.value_or(1.0f),
+        scores.ml.value_or(1.0f),
+        scores.behavioral.value_or(1.0f),
+        scores.vt.value_or(1.0f));
+    return { minimum, maximum };
+}
+
+bool VerdictEngine::is_settled(PartialScores const& scores) const
+{
+    auto range = composite_range(scores);
+    return determine_threat_level(range.minimum) == determine_threat_level(range.maximum);
+}
+
 float VerdictEngine::calculate_composite_score(float yara, float ml, float behavioral, float vt) const
 {
     // Weighted average: YARA (30%) + ML (25%) + Behavioral (20%) + VirusTotal (25%)
@@ -8,6 +8,7 @@
 #include "Orchestrator.h"
 #include <AK/Error.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
 #include <AK/String.h>
 
 namespace Sentinel::Sandbox {
@@ -34,6 +35,21 @@ struct ScoringThresholds {
                                                    // >= 0.8 = Critical
 };
 
+// Scores from the engines that have reported so far. An engine that has not reported yet
+// could still score anywhere from 0.0 to 1.0; one that will not run at all should be 0.0.
+struct PartialScores {
+    Optional<float> yara;
+    Optional<float> ml;
+    Optional<float> behavioral;
+    Optional<float> vt;
+};
+
+// The lowest and highest composite score the engines that are still to report can produce
+struct CompositeRange {
+    float minimum { 0.0f };
+    float maximum { 0.0f };
+};
+
 // VerdictEngine - Multi-layer threat scoring and verdict generation
 // Milestone 0.5 Phase 1: Real-time Sandboxing
 //
@@ -53,6 +69,13 @@ public:
         float behavioral_score,
         float vt_score = 0.0f) const;
 
+    // The verdict, if the engines still to report can no longer move the composite score across a
+    // threshold; nothing otherwise. The missing scores count as 0.0, which stays within the range.
+    ErrorOr<Optional<Verdict>> calculate_settled_verdict(PartialScores const&) const;
+
+    CompositeRange composite_range(PartialScores const&) const;
+    bool is_settled(PartialScores const&) const;
+
     // Update scoring thresholds (for tuning)
     void update_thresholds(ScoringThresholds const& thresholds);
     ScoringThresholds const& thresholds() const { return m_thresholds; }
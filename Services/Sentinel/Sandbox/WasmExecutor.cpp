@@ -7,8 +7,16 @@
 #include <AK/JsonObject.h>
 #include <AK/JsonValue.h>
 #include <AK/Math.h>
+#include <AK/Hex.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/ScopeGuard.h>
 #include <LibCore/File.h>
+#include <LibCore/StandardPaths.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibThreading/Thread.h>
+#include <unistd.h>
 
 #ifdef ENABLE_WASMTIME
 #    include <wasmtime.h>
@@ -21,6 +29,17 @@
 
 namespace Sentinel::Sandbox {
 
+struct WasmExecutor::WarmInstance {
+#ifdef ENABLE_WASMTIME
+    ~WarmInstance()
+    {
+        // Dropping the store frees the instance's pool slot
+        if (store)
+            wasmtime_store_delete(store);
+    }
+
+    wasmtime_store_t* store { nullptr };
+
 ErrorOr<NonnullOwnPtr<WasmExecutor>> WasmExecutor::create(SandboxConfig const& config)
 {
     auto executor = adopt_own(*new WasmExecutor(config));
@@ -63,14 +82,19 @@ WasmExecutor::WasmExecutor(SandboxConfig const& config)
 
 WasmExecutor::~WasmExecutor()
 {
+    stop_refill_thread();
+
+    // The instances hold on to the engine, so they go first
+    m_warm_instances.clear();
+
 #ifdef ENABLE_WASMTIME
     if (m_wasm_module) {
-        wasm_module_delete(static_cast<wasm_module_t*>(m_wasm_module));
+        wasmtime_module_delete(static_cast<wasmtime_module_t*>(m_wasm_module));
         m_wasm_module = nullptr;
     }
-    if (m_wasmtime_store) {
-        wasmtime_store_delete(static_cast<wasmtime_store_t*>(m_wasmtime_store));
-        m_wasmtime_store = nullptr;
+    if (m_wasmtime_linker) {
+        wasmtime_linker_delete(static_cast<wasmtime_linker_t*>(m_wasmtime_linker));
+        m_wasmtime_linker = nullptr;
     }
     if (m_wasmtime_engine) {
         wasm_engine_delete(static_cast<wasm_engine_t*>(m_wasmtime_engine));
@@ -79,6 +103,64 @@ WasmExecutor::~WasmExecutor()
 #endif
 }
 
+#ifdef ENABLE_WASMTIME
+static void log_wasmtime_error(StringView what, wasmtime_error_t* error)
+{
+    wasm_name_t error_msg;
+    wasmtime_error_message(error, &error_msg);
+    dbgln("WasmExecutor: {}: {}", what, StringView { error_msg.data, error_msg.size });
+    wasm_name_delete(&error_msg);
+    wasmtime_error_delete(error);
+}
+
+// Host import: log(level: u32, ptr: i32, len: i32)
+static wasm_trap_t* log_callback(void*, wasmtime_caller_t* caller, wasmtime_val_t const* args, size_t nargs, wasmtime_val_t*, size_t)
+{
+    if (nargs != 3) {
+        return wasm_trap_new(nullptr, 0);
+    }
+
+    i32 level = args[0].of.i32;
+    i32 ptr = args[1].of.i32;
+    i32 len = args[2].of.i32;
+
+    // Get memory to read log message
+    wasmtime_context_t* ctx = wasmtime_caller_context(caller);
+    wasmtime_extern_t memory_extern;
+    if (!wasmtime_caller_export_get(caller, "memory", 6, &memory_extern) || memory_extern.kind != WASMTIME_EXTERN_MEMORY) {
+        return wasm_trap_new(nullptr, 0);
+    }
+
+    wasmtime_memory_t memory = memory_extern.of.memory;
+    u8* memory_data = wasmtime_memory_data(ctx, &memory);
+    size_t memory_size = wasmtime_memory_data_size(ctx, &memory);
+
+    if (ptr < 0 || len < 0 || static_cast<size_t>(ptr) + static_cast<size_t>(len) > memory_size) {
+        return wasm_trap_new(nullptr, 0);
+    }
+
+    // Read and log message
+    StringView message { reinterpret_cast<char const*>(memory_data + ptr), static_cast<size_t>(len) };
+    dbgln_if(false, "WASM[{}]: {}", level, message);
+
+    return nullptr;
+}
+
+// Host import: current_time_ms() -> u64
+static wasm_trap_t* time_callback(void*, wasmtime_caller_t*, wasmtime_val_t const*, size_t, wasmtime_val_t* results, size_t nresults)
+{
+    if (nresults != 1)
+        return nullptr;
+
+    // Return current time in milliseconds
+    auto now = MonotonicTime::now();
+    results[0].kind = WASMTIME_I64;
+    results[0].of.i64 = now.milliseconds();
+
+    return nullptr;
+}
+#endif
+
 ErrorOr<void> WasmExecutor::initialize_wasmtime()
 {
 #ifdef ENABLE_WASMTIME
@@ -93,6 +175,23 @@ ErrorOr<void> WasmExecutor::initialize_wasmtime()
     // Enable epoch interruption for timeout enforcement
     wasmtime_config_epoch_interruption_set(config, true);
 
+    // Linear memories start as a copy-on-write mapping of the module's data segments instead of
+    // being copied in on every instantiation
+    wasmtime_config_memory_init_cow_set(config, true);
+
+#    ifdef WASMTIME_FEATURE_POOLING_ALLOCATOR
+    // Preallocate instance slots for the warm instances, the one executing, and the one being
+    // refilled, so instantiating is a slot handout and freeing one just resets its memory
+    auto* pooling = wasmtime_pooling_allocation_config_new();
+    auto slots = static_cast<u32>(m_config.wasm_warm_instances + 2);
+    wasmtime_pooling_allocation_config_total_core_instances_set(pooling, slots);
+    wasmtime_pooling_allocation_config_total_memories_set(pooling, slots);
+    wasmtime_pooling_allocation_config_total_tables_set(pooling, slots * 10);
+    wasmtime_pooling_allocation_config_max_memory_size_set(pooling, m_config.max_memory_bytes);
+    wasmtime_config_pooling_allocation_strategy_set(config, pooling);
+    wasmtime_pooling_allocation_config_delete(pooling);
+#    endif
+
     // Create Wasmtime engine with configuration
     wasm_engine_t* engine = wasm_engine_new_with_config(config);
     if (!engine)
@@ -100,18 +199,47 @@ ErrorOr<void> WasmExecutor::initialize_wasmtime()
 
     m_wasmtime_engine = engine;
 
-    // Create Wasmtime store
-    wasmtime_store_t* store = wasmtime_store_new(engine, nullptr, nullptr);
-    if (!store) {
-        wasm_engine_delete(engine);
-        m_wasmtime_engine = nullptr;
-        return Error::from_string_literal("Failed to create Wasmtime store");
+    // The host imports do not belong to any store, so one linker instantiates the module in all of them
+    wasmtime_linker_t* linker = wasmtime_linker_new(engine);
+    if (!linker)
+        return Error::from_string_literal("Failed to create Wasmtime linker");
+    m_wasmtime_linker = linker;
+
+    // Signature: (i32, i32, i32) -> ()
+    wasm_valtype_t* log_params[3] = {
+        wasm_valtype_new_i32(),
+        wasm_valtype_new_i32(),
+        wasm_valtype_new_i32()
+    };
+    wasm_valtype_vec_t log_params_vec;
+    wasm_valtype_vec_new(&log_params_vec, 3, log_params);
+
+    wasm_valtype_vec_t log_results_vec;
+    wasm_valtype_vec_new_empty(&log_results_vec);
+
+    wasm_functype_t* log_functype = wasm_functype_new(&log_params_vec, &log_results_vec);
+    wasmtime_error_t* error = wasmtime_linker_define_func(linker, "", 0, "log", 3, log_functype, log_callback, nullptr, nullptr);
+    wasm_functype_delete(log_functype);
+    if (error) {
+        log_wasmtime_error("Failed to define 'log' import"sv, error);
+        return Error::from_string_literal("Failed to define log host function");
     }
 
-    m_wasmtime_store = store;
+    // Signature: () -> i64
+    wasm_valtype_vec_t time_params_vec;
+    wasm_valtype_vec_new_empty(&time_params_vec);
+
+    wasm_valtype_t* time_results[1] = { wasm_valtype_new_i64() };
+    wasm_valtype_vec_t time_results_vec;
+    wasm_valtype_vec_new(&time_results_vec, 1, time_results);
 
-    // Configure resource limits
-    TRY(setup_wasm_limits());
+    wasm_functype_t* time_functype = wasm_functype_new(&time_params_vec, &time_results_vec);
+    error = wasmtime_linker_define_func(linker, "", 0, "current_time_ms", 15, time_functype, time_callback, nullptr, nullptr);
+    wasm_functype_delete(time_functype);
+    if (error) {
+        log_wasmtime_error("Failed to define 'current_time_ms' import"sv, error);
+        return Error::from_string_literal("Failed to define current_time_ms host function");
+    }
 
     dbgln_if(false, "WasmExecutor: Wasmtime initialized successfully");
     return {};
@@ -120,12 +248,12 @@ ErrorOr<void> WasmExecutor::initialize_wasmtime()
 #endif
 }
 
-ErrorOr<void> WasmExecutor::setup_wasm_limits()
+ErrorOr<void> WasmExecutor::setup_wasm_limits(void* opaque_store)
 {
 #ifdef ENABLE_WASMTIME
-    VERIFY(m_wasmtime_store);
+    VERIFY(opaque_store);
 
-    auto* store = static_cast<wasmtime_store_t*>(m_wasmtime_store);
+    auto* store = static_cast<wasmtime_store_t*>(opaque_store);
     auto* context = wasmtime_store_context(store);
 
     // Set memory and table limits using store limiter
@@ -158,10 +286,80 @@ ErrorOr<void> WasmExecutor::setup_wasm_limits()
 
     return {};
 #else
+    (void)opaque_store;
     return {};
 #endif
 }
 
+#ifdef ENABLE_WASMTIME
+// Compiled modules are cached as <cache>/ladybird/sentinel/wasm/<sha256 of the WASM bytes>.cwasm.
+// Wasmtime refuses serialized code from a different Wasmtime version or engine configuration, in
+// which case the module is compiled again and the cache entry replaced.
+static ErrorOr<ByteString> compiled_module_cache_path(ReadonlyBytes wasm_bytes)
+{
+    auto sha256 = Crypto::Hash::SHA256::create();
+    sha256->update(wasm_bytes);
+    auto digest = sha256->digest();
+
+    auto directory = ByteString::formatted("{}/ladybird/sentinel/wasm", Core::StandardPaths::cache_directory());
+    TRY(FileSystem::create_directories(directory));
+    return ByteString::formatted("{}/{}.cwasm", directory, encode_hex(digest.bytes()));
+}
+
+static ErrorOr<void> write_compiled_module(wasmtime_module_t* module, ByteString const& path)
+{
+    wasm_byte_vec_t serialized;
+    if (auto* error = wasmtime_module_serialize(module, &serialized); error) {
+        log_wasmtime_error("Failed to serialize module"sv, error);
+        return Error::from_string_literal("Failed to serialize WASM module");
+    }
+
+    // Written next to the final name and renamed, so a reader never maps a half-written file
+    auto temporary_path = ByteString::formatted("{}.{}.tmp", path, getpid());
+    auto result = [&]() -> ErrorOr<void> {
+        auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted({ serialized.data, serialized.size }));
+        TRY(Core::System::rename(temporary_path, path));
+        return {};
+    }();
+    wasm_byte_vec_delete(&serialized);
+
+    if (result.is_error())
+        (void)Core::System::unlink(temporary_path);
+    return result;
+}
+
+static ErrorOr<wasmtime_module_t*> load_or_compile_module(wasm_engine_t* engine, ReadonlyBytes wasm_bytes)
+{
+    wasmtime_module_t* module = nullptr;
+
+    auto cache_path = compiled_module_cache_path(wasm_bytes);
+    if (cache_path.is_error())
+        dbgln("WasmExecutor: Compiled module cache unavailable: {}", cache_path.error());
+
+    if (!cache_path.is_error() && FileSystem::exists(cache_path.value())) {
+        auto* error = wasmtime_module_deserialize_file(engine, cache_path.value().characters(), &module);
+        if (!error) {
+            dbgln_if(false, "WasmExecutor: Loaded compiled module from {}", cache_path.value());
+            return module;
+        }
+        log_wasmtime_error("Cached compiled module is unusable, recompiling"sv, error);
+        module = nullptr;
+    }
+
+    if (auto* error = wasmtime_module_new(engine, wasm_bytes.data(), wasm_bytes.size(), &module); error) {
+        log_wasmtime_error("Failed to load WASM module"sv, error);
+        return Error::from_string_literal("Failed to create WASM module");
+    }
+
+    if (!cache_path.is_error()) {
+        if (auto result = write_compiled_module(module, cache_path.value()); result.is_error())
+            dbgln("WasmExecutor: Failed to cache compiled module: {}", result.error());
+    }
+    return module;
+}
+#endif
+
 ErrorOr<void> WasmExecutor::load_module(String const& module_path)
 {
 #ifdef ENABLE_WASMTIME
@@ -185,42 +383,206 @@ ErrorOr<void> WasmExecutor::load_module(String const& module_path)
 
     dbgln_if(false, "WasmExecutor: Read {} bytes from WASM module", module_data.size());
 
-    // Create WASM module from bytecode
-    wasmtime_error_t* error = nullptr;
+    auto* module = TRY(load_or_compile_module(static_cast<wasm_engine_t*>(m_wasmtime_engine), module_data.bytes()));
+    TRY(use_module(module));
+
+    dbgln_if(false, "WasmExecutor: WASM module loaded successfully");
+    return {};
+#else
+    (void)module_path;
+    return Error::from_string_literal("Wasmtime support not compiled in");
+#endif
+}
+
+    wasmtime_instance_t instance;
+    wasmtime_func_t allocate_func;
+    wasmtime_func_t analyze_func;
+    wasmtime_func_t deallocate_func;
+    wasmtime_memory_t memory;
+#endif
+    u64 module_generation { 0 };
+};
+
+ErrorOr<void> WasmExecutor::use_module(void* module)
+{
+#ifdef ENABLE_WASMTIME
+    {
+        Sync::MutexLocker locker(m_pool_mutex);
+        if (m_wasm_module)
+            wasmtime_module_delete(static_cast<wasmtime_module_t*>(m_wasm_module));
+        m_wasm_module = module;
+        m_module_generation++;
+
+        // Instances of the old module would still run the old code
+        m_warm_instances.clear();
+        m_pool_condition.broadcast();
+    }
+
+    if (m_config.wasm_warm_instances > 0)
+        TRY(start_refill_thread());
+    return {};
+#else
+    (void)module;
+    return Error::from_string_literal("Wasmtime support not compiled in");
+#endif
+}
+
+ErrorOr<NonnullOwnPtr<WasmExecutor::WarmInstance>> WasmExecutor::create_warm_instance()
+{
+#ifdef ENABLE_WASMTIME
+    VERIFY(m_wasmtime_engine);
+    VERIFY(m_wasmtime_linker);
+
+    // Hold a reference of our own, so use_module() can swap the module while we instantiate
     wasmtime_module_t* module = nullptr;
+    auto instance = make<WarmInstance>();
+    {
+        Sync::MutexLocker locker(m_pool_mutex);
+        if (!m_wasm_module)
+            return Error::from_string_literal("No WASM module loaded");
+        module = wasmtime_module_clone(static_cast<wasmtime_module_t*>(m_wasm_module));
+        instance->module_generation = m_module_generation;
+    }
+    ScopeGuard release_module = [&] { wasmtime_module_delete(module); };
 
-    auto* engine = static_cast<wasm_engine_t*>(m_wasmtime_engine);
-    error = wasmtime_module_new(engine, module_data.data(), module_data.size(), &module);
+    instance->store = wasmtime_store_new(static_cast<wasm_engine_t*>(m_wasmtime_engine), nullptr, nullptr);
+    if (!instance->store)
+        return Error::from_string_literal("Failed to create Wasmtime store");
+    TRY(setup_wasm_limits(instance->store));
 
+    auto* context = wasmtime_store_context(instance->store);
+    wasm_trap_t* trap = nullptr;
+    auto* error = wasmtime_linker_instantiate(static_cast<wasmtime_linker_t*>(m_wasmtime_linker), context, module, &instance->instance, &trap);
     if (error) {
-        // Get error message
-        wasm_name_t error_msg;
-        wasmtime_error_message(error, &error_msg);
+        log_wasmtime_error("Failed to instantiate module"sv, error);
+        return Error::from_string_literal("Failed to instantiate WASM module");
+    }
 
-        dbgln("WasmExecutor: Failed to load WASM module: {}",
-            StringView { error_msg.data, error_msg.size });
+    if (trap) {
+        wasm_message_t trap_msg;
+        wasm_trap_message(trap, &trap_msg);
+        dbgln("WasmExecutor: Trap during module instantiation: {}", StringView { trap_msg.data, trap_msg.size });
+        wasm_byte_vec_delete(&trap_msg);
+        wasm_trap_delete(trap);
+        return Error::from_string_literal("Trap during WASM module instantiation");
+    }
 
-        wasm_name_delete(&error_msg);
-        wasmtime_error_delete(error);
+    // Get exported functions
+    wasmtime_extern_t allocate_extern, analyze_extern, deallocate_extern, memory_extern;
 
-        return Error::from_string_literal("Failed to create WASM module");
+    if (!wasmtime_instance_export_get(context, &instance->instance, "allocate", 8, &allocate_extern)) {
+        dbgln("WasmExecutor: Failed to get 'allocate' export");
+        return Error::from_string_literal("WASM module missing 'allocate' export");
     }
 
-    // Store module (delete old one if exists)
-    if (m_wasm_module) {
-        wasmtime_module_delete(static_cast<wasmtime_module_t*>(m_wasm_module));
+    if (!wasmtime_instance_export_get(context, &instance->instance, "analyze_file", 12, &analyze_extern)) {
+        dbgln("WasmExecutor: Failed to get 'analyze_file' export");
+        return Error::from_string_literal("WASM module missing 'analyze_file' export");
     }
 
-    m_wasm_module = module;
+    if (!wasmtime_instance_export_get(context, &instance->instance, "deallocate", 10, &deallocate_extern)) {
+        dbgln("WasmExecutor: Failed to get 'deallocate' export");
+        return Error::from_string_literal("WASM module missing 'deallocate' export");
+    }
 
-    dbgln_if(false, "WasmExecutor: WASM module loaded successfully");
-    return {};
+    if (!wasmtime_instance_export_get(context, &instance->instance, "memory", 6, &memory_extern)) {
+        dbgln("WasmExecutor: Failed to get 'memory' export");
+        return Error::from_string_literal("WASM module missing 'memory' export");
+    }
+
+    // Verify exports are of correct type
+    if (allocate_extern.kind != WASMTIME_EXTERN_FUNC || analyze_extern.kind != WASMTIME_EXTERN_FUNC || deallocate_extern.kind != WASMTIME_EXTERN_FUNC) {
+        dbgln("WasmExecutor: Exported items are not functions");
+        return Error::from_string_literal("WASM exports have incorrect types");
+    }
+
+    if (memory_extern.kind != WASMTIME_EXTERN_MEMORY) {
+        dbgln("WasmExecutor: Memory export is not a memory");
+        return Error::from_string_literal("WASM memory export has incorrect type");
+    }
+
+    instance->allocate_func = allocate_extern.of.func;
+    instance->analyze_func = analyze_extern.of.func;
+    instance->deallocate_func = deallocate_extern.of.func;
+    instance->memory = memory_extern.of.memory;
+    return instance;
 #else
-    (void)module_path;
     return Error::from_string_literal("Wasmtime support not compiled in");
 #endif
 }
 
+OwnPtr<WasmExecutor::WarmInstance> WasmExecutor::take_warm_instance()
+{
+    Sync::MutexLocker locker(m_pool_mutex);
+    if (m_warm_instances.is_empty())
+        return {};
+
+    auto instance = m_warm_instances.take_last();
+    m_pool_condition.signal();
+    return instance;
+}
+
+ErrorOr<void> WasmExecutor::start_refill_thread()
+{
+    Sync::MutexLocker locker(m_pool_mutex);
+    if (m_refill_thread)
+        return {};
+
+    m_refill_stopping = false;
+    m_refill_thread = TRY(Threading::Thread::try_create("WasmExecutor/Refill"sv, [this]() -> intptr_t {
+        return refill_thread_func();
+    }));
+    m_refill_thread->start();
+    return {};
+}
+
+void WasmExecutor::stop_refill_thread()
+{
+    RefPtr<Threading::Thread> refill_thread;
+    {
+        Sync::MutexLocker locker(m_pool_mutex);
+        if (!m_refill_thread)
+            return;
+        m_refill_stopping = true;
+        m_pool_condition.broadcast();
+        refill_thread = m_refill_thread;
+    }
+
+    (void)refill_thread->join();
+
+    Sync::MutexLocker locker(m_pool_mutex);
+    m_refill_thread = nullptr;
+}
+
+intptr_t WasmExecutor::refill_thread_func()
+{
+    while (true) {
+        {
+            Sync::MutexLocker locker(m_pool_mutex);
+            m_pool_condition.wait_while([&] {
+                return !m_refill_stopping && m_warm_instances.size() >= m_config.wasm_warm_instances;
+            });
+            if (m_refill_stopping)
+                return 0;
+        }
+
+        auto instance = create_warm_instance();
+
+        Sync::MutexLocker locker(m_pool_mutex);
+        if (instance.is_error()) {
+            dbgln("WasmExecutor: Failed to prepare a warm instance: {}", instance.error());
+
+            // Executions instantiate for themselves meanwhile; try again later rather than spin
+            (void)m_pool_condition.wait_for(Duration::from_seconds(1));
+            continue;
+        }
+
+        // The module may have been replaced while this one was being set up
+        if (instance.value()->module_generation == m_module_generation)
+            m_warm_instances.append(instance.release_value());
+    }
+}
+
 ErrorOr<WasmExecutionResult> WasmExecutor::execute(
     ByteBuffer const& file_data,
     String const& filename,
@@ -305,205 +667,33 @@ ErrorOr<WasmExecutionResult> WasmExecutor::execute_stub(ByteBuffer const& file_d
 ErrorOr<WasmExecutionResult> WasmExecutor::execute_wasmtime(ByteBuffer const& file_data, [[maybe_unused]] String const& filename)
 {
 #ifdef ENABLE_WASMTIME
-    VERIFY(m_wasmtime_store);
     VERIFY(m_wasmtime_engine);
-    VERIFY(m_wasm_module);
 
     dbgln_if(false, "WasmExecutor: Executing analysis with WASM module ({} bytes)", file_data.size());
 
     WasmExecutionResult result;
-    auto* store = static_cast<wasmtime_store_t*>(m_wasmtime_store);
-    auto* engine = static_cast<wasm_engine_t*>(m_wasmtime_engine);
-    auto* module = static_cast<wasmtime_module_t*>(m_wasm_module);
-    auto* context = wasmtime_store_context(store);
-
-    // Step 1: Create linker and define host imports
-    wasmtime_linker_t* linker = wasmtime_linker_new(engine);
-    if (!linker)
-        return Error::from_string_literal("Failed to create Wasmtime linker");
 
-    // Define host import: log(level: u32, ptr: i32, len: i32)
-    // Signature: (i32, i32, i32) -> ()
-    wasm_valtype_t* log_params[3] = {
-        wasm_valtype_new_i32(),
-        wasm_valtype_new_i32(),
-        wasm_valtype_new_i32()
-    };
-    wasm_valtype_vec_t log_params_vec;
-    wasm_valtype_vec_new(&log_params_vec, 3, log_params);
-
-    wasm_valtype_vec_t log_results_vec;
-    wasm_valtype_vec_new_empty(&log_results_vec);
-
-    wasm_functype_t* log_functype = wasm_functype_new(&log_params_vec, &log_results_vec);
-
-    // Create host function callback
-    auto log_callback = +[](void* env, wasmtime_caller_t* caller, wasmtime_val_t const* args, size_t nargs, wasmtime_val_t* results, size_t nresults) -> wasm_trap_t* {
-        (void)env;
-        (void)results;
-        (void)nresults;
-
-        if (nargs != 3) {
-            return wasm_trap_new(nullptr, 0);
-        }
-
-        i32 level = args[0].of.i32;
-        i32 ptr = args[1].of.i32;
-        i32 len = args[2].of.i32;
-
-        // Get memory to read log message
-        wasmtime_context_t* ctx = wasmtime_caller_context(caller);
-        wasmtime_extern_t memory_extern;
-        if (!wasmtime_caller_export_get(caller, "memory", 6, &memory_extern) || memory_extern.kind != WASMTIME_EXTERN_MEMORY) {
-            return wasm_trap_new(nullptr, 0);
-        }
-
-        wasmtime_memory_t memory = memory_extern.of.memory;
-        u8* memory_data = wasmtime_memory_data(ctx, &memory);
-        size_t memory_size = wasmtime_memory_data_size(ctx, &memory);
-
-        if (ptr < 0 || len < 0 || static_cast<size_t>(ptr) + static_cast<size_t>(len) > memory_size) {
-            return wasm_trap_new(nullptr, 0);
-        }
-
-        // Read and log message
-        StringView message { reinterpret_cast<char const*>(memory_data + ptr), static_cast<size_t>(len) };
-        dbgln_if(false, "WASM[{}]: {}", level, message);
-
-        return nullptr;
-    };
-
-    wasmtime_func_t log_func;
-    wasmtime_func_new(context, log_functype, log_callback, nullptr, nullptr, &log_func);
-    wasm_functype_delete(log_functype);
-
-    wasmtime_extern_t log_extern;
-    log_extern.kind = WASMTIME_EXTERN_FUNC;
-    log_extern.of.func = log_func;
-
-    wasmtime_error_t* error = wasmtime_linker_define(linker, context, "", 0, "log", 3, &log_extern);
-    if (error) {
-        wasm_name_t error_msg;
-        wasmtime_error_message(error, &error_msg);
-        dbgln("WasmExecutor: Failed to define 'log' import: {}", StringView { error_msg.data, error_msg.size });
-        wasm_name_delete(&error_msg);
-        wasmtime_error_delete(error);
-        wasmtime_linker_delete(linker);
-        return Error::from_string_literal("Failed to define log host function");
+    // Steps 1-3: Take a sandbox that is already instantiated, or set one up if the pool ran dry.
+    // Each instance runs once and is then dropped, so nothing a file leaves behind in the sandbox
+    // reaches the next one.
+    auto instance = take_warm_instance();
+    if (instance) {
+        m_stats.warm_starts++;
+    } else {
+        m_stats.cold_starts++;
+        instance = TRY(create_warm_instance());
     }
 
-    // Define host import: current_time_ms() -> u64
-    // Signature: () -> i64
-    wasm_valtype_vec_t time_params_vec;
-    wasm_valtype_vec_new_empty(&time_params_vec);
-
-    wasm_valtype_t* time_results[1] = { wasm_valtype_new_i64() };
-    wasm_valtype_vec_t time_results_vec;
-    wasm_valtype_vec_new(&time_results_vec, 1, time_results);
-
-    wasm_functype_t* time_functype = wasm_functype_new(&time_params_vec, &time_results_vec);
-
-    auto time_callback = +[](void* env, wasmtime_caller_t* caller, wasmtime_val_t const* args, size_t nargs, wasmtime_val_t* results, size_t nresults) -> wasm_trap_t* {
-        (void)env;
-        (void)caller;
-        (void)args;
-        (void)nargs;
-
-        if (nresults != 1)
-            return nullptr;
-
-        // Return current time in milliseconds
-        auto now = MonotonicTime::now();
-        results[0].kind = WASMTIME_I64;
-        results[0].of.i64 = now.milliseconds();
-
-        return nullptr;
-    };
-
-    wasmtime_func_t time_func;
-    wasmtime_func_new(context, time_functype, time_callback, nullptr, nullptr, &time_func);
-    wasm_functype_delete(time_functype);
-
-    wasmtime_extern_t time_extern;
-    time_extern.kind = WASMTIME_EXTERN_FUNC;
-    time_extern.of.func = time_func;
-
-    error = wasmtime_linker_define(linker, context, "", 0, "current_time_ms", 16, &time_extern);
-    if (error) {
-        wasm_name_t error_msg;
-        wasmtime_error_message(error, &error_msg);
-        dbgln("WasmExecutor: Failed to define 'current_time_ms' import: {}", StringView { error_msg.data, error_msg.size });
-        wasm_name_delete(&error_msg);
-        wasmtime_error_delete(error);
-        wasmtime_linker_delete(linker);
-        return Error::from_string_literal("Failed to define current_time_ms host function");
-    }
+    // Every run gets the full fuel budget and a fresh epoch deadline
+    TRY(setup_wasm_limits(instance->store));
 
-    // Step 2: Instantiate module with host imports
-    wasmtime_instance_t instance;
+    auto* context = wasmtime_store_context(instance->store);
+    wasmtime_func_t allocate_func = instance->allocate_func;
+    wasmtime_func_t analyze_func = instance->analyze_func;
+    wasmtime_func_t deallocate_func = instance->deallocate_func;
+    wasmtime_memory_t memory = instance->memory;
     wasm_trap_t* trap = nullptr;
-    error = wasmtime_linker_instantiate(linker, context, module, &instance, &trap);
-
-    if (error) {
-        wasm_name_t error_msg;
-        wasmtime_error_message(error, &error_msg);
-        dbgln("WasmExecutor: Failed to instantiate module: {}", StringView { error_msg.data, error_msg.size });
-        wasm_name_delete(&error_msg);
-        wasmtime_error_delete(error);
-        wasmtime_linker_delete(linker);
-        return Error::from_string_literal("Failed to instantiate WASM module");
-    }
-
-    if (trap) {
-        wasm_message_t trap_msg;
-        wasm_trap_message(trap, &trap_msg);
-        dbgln("WasmExecutor: Trap during module instantiation: {}", StringView { trap_msg.data, trap_msg.size });
-        wasm_byte_vec_delete(&trap_msg);
-        wasm_trap_delete(trap);
-        wasmtime_linker_delete(linker);
-        return Error::from_string_literal("Trap during WASM module instantiation");
-    }
-
-    wasmtime_linker_delete(linker);
-
-    // Step 3: Get exported functions
-    wasmtime_extern_t allocate_extern, analyze_extern, deallocate_extern, memory_extern;
-
-    if (!wasmtime_instance_export_get(context, &instance, "allocate", 8, &allocate_extern)) {
-        dbgln("WasmExecutor: Failed to get 'allocate' export");
-        return Error::from_string_literal("WASM module missing 'allocate' export");
-    }
-
-    if (!wasmtime_instance_export_get(context, &instance, "analyze_file", 12, &analyze_extern)) {
-        dbgln("WasmExecutor: Failed to get 'analyze_file' export");
-        return Error::from_string_literal("WASM module missing 'analyze_file' export");
-    }
-
-    if (!wasmtime_instance_export_get(context, &instance, "deallocate", 10, &deallocate_extern)) {
-        dbgln("WasmExecutor: Failed to get 'deallocate' export");
-        return Error::from_string_literal("WASM module missing 'deallocate' export");
-    }
-
-    if (!wasmtime_instance_export_get(context, &instance, "memory", 6, &memory_extern)) {
-        dbgln("WasmExecutor: Failed to get 'memory' export");
-        return Error::from_string_literal("WASM module missing 'memory' export");
-    }
-
-    // Verify exports are of correct type
-    if (allocate_extern.kind != WASMTIME_EXTERN_FUNC || analyze_extern.kind != WASMTIME_EXTERN_FUNC || deallocate_extern.kind != WASMTIME_EXTERN_FUNC) {
-        dbgln("WasmExecutor: Exported items are not functions");
-        return Error::from_string_literal("WASM exports have incorrect types");
-    }
-
-    if (memory_extern.kind != WASMTIME_EXTERN_MEMORY) {
-        dbgln("WasmExecutor: Memory export is not a memory");
-        return Error::from_string_literal("WASM memory export has incorrect type");
-    }
-
-    wasmtime_func_t allocate_func = allocate_extern.of.func;
-    wasmtime_func_t analyze_func = analyze_extern.of.func;
-    wasmtime_func_t deallocate_func = deallocate_extern.of.func;
-    wasmtime_memory_t memory = memory_extern.of.memory;
+    wasmtime_error_t* error = nullptr;
 
     // Step 4: Allocate buffer in WASM memory using allocate(size) -> ptr
     wasmtime_val_t alloc_args[1];
@@ -893,12 +1083,20 @@ ErrorOr<Vector<String>> WasmExecutor::detect_suspicious_patterns(ByteBuffer cons
 
 ErrorOr<void> WasmExecutor::precompile_module(ByteBuffer const& wasm_module)
 {
-    // TODO: Precompile WASM module for faster execution
-    // This is an optimization for repeatedly executing the same module
+#ifdef ENABLE_WASMTIME
+    if (!m_wasmtime_engine)
+        return Error::from_string_literal("Wasmtime is not initialized");
 
     dbgln_if(false, "WasmExecutor: Precompiling module ({} bytes)", wasm_module.size());
 
+    auto* module = TRY(load_or_compile_module(static_cast<wasm_engine_t*>(m_wasmtime_engine), wasm_module.bytes()));
+    TRY(use_module(module));
+    m_use_stub = false;
     return {};
+#else
+    (void)wasm_module;
+    return Error::from_string_literal("Wasmtime support not compiled in");
+#endif
 }
 
 void WasmExecutor::reset_statistics()
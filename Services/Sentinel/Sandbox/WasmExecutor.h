@@ -9,9 +9,14 @@
 #include <AK/ByteBuffer.h>
 #include <AK/Error.h>
 #include <AK/NonnullOwnPtr.h>
+#include <AK/OwnPtr.h>
+#include <AK/RefPtr.h>
 #include <AK/String.h>
 #include <AK/Time.h>
 #include <AK/Vector.h>
+#include <LibSync/ConditionVariable.h>
+#include <LibSync/Mutex.h>
+#include <LibThreading/Forward.h>
 
 namespace Sentinel::Sandbox {
 
@@ -37,6 +42,12 @@ struct WasmExecutionResult {
 //
 // The stub allows development and testing of the sandbox infrastructure
 // without requiring Wasmtime installation, similar to the ML stub approach.
+//
+// With Wasmtime, the compiled module is cached on disk and loaded back without recompiling, and a
+// background thread keeps SandboxConfig::wasm_warm_instances instances of it ready in their own
+// stores. Each execution takes one and throws it away afterwards, so no state carries over from
+// one file to the next; the pooling allocator resets the instance's memory to the module's
+// copy-on-write image rather than building a new one.
 class WasmExecutor {
 public:
     static ErrorOr<NonnullOwnPtr<WasmExecutor>> create(SandboxConfig const& config);
@@ -53,7 +64,7 @@ public:
         String const& filename,
         Duration timeout);
 
-    // Precompile WASM module for faster execution (optional optimization)
+    // Compile a WASM module, make it the one executions use, and cache the compiled code on disk
     ErrorOr<void> precompile_module(ByteBuffer const& wasm_module);
 
     // Statistics
@@ -61,6 +72,8 @@ public:
         u64 total_executions { 0 };
         u64 timeouts { 0 };
         u64 errors { 0 };
+        u64 warm_starts { 0 };                    // Executions that found an instance ready
+        u64 cold_starts { 0 };                    // Executions that had to instantiate the module themselves
         Duration average_execution_time;
         Duration max_execution_time;
     };
@@ -72,7 +85,16 @@ private:
     explicit WasmExecutor(SandboxConfig const& config);
 
     ErrorOr<void> initialize_wasmtime();
-    ErrorOr<void> setup_wasm_limits();
+    ErrorOr<void> setup_wasm_limits(void* store);  // wasmtime_store_t*
+
+    // Compiled modules and the warm instance pool
+    struct WarmInstance;
+    ErrorOr<void> use_module(void* module);        // wasmtime_module_t*, ownership is taken
+    ErrorOr<NonnullOwnPtr<WarmInstance>> create_warm_instance();
+    OwnPtr<WarmInstance> take_warm_instance();
+    ErrorOr<void> start_refill_thread();
+    void stop_refill_thread();
+    intptr_t refill_thread_func();
 
     // Execution helpers
     ErrorOr<WasmExecutionResult> execute_stub(ByteBuffer const& file_data, String const& filename);
@@ -89,14 +111,21 @@ private:
     // Wasmtime runtime (opaque pointer, null if using stub)
 #ifdef ENABLE_WASMTIME
     void* m_wasmtime_engine { nullptr };      // wasm_engine_t*
-    void* m_wasmtime_store { nullptr };       // wasmtime_store_t*
-    void* m_wasm_module { nullptr };          // wasm_module_t*
+    void* m_wasmtime_linker { nullptr };      // wasmtime_linker_t*, host imports only, so shared by every store
+    void* m_wasm_module { nullptr };          // wasmtime_module_t*, guarded by m_pool_mutex
 #else
     [[maybe_unused]] void* m_wasmtime_engine { nullptr };
-    [[maybe_unused]] void* m_wasmtime_store { nullptr };
+    [[maybe_unused]] void* m_wasmtime_linker { nullptr };
     [[maybe_unused]] void* m_wasm_module { nullptr };
 #endif
 
+    Sync::Mutex m_pool_mutex;
+    Sync::ConditionVariable m_pool_condition { m_pool_mutex };
+    Vector<NonnullOwnPtr<WarmInstance>> m_warm_instances;
+    u64 m_module_generation { 0 };            // Bumped by use_module(), so instances of an old module are not pooled
+    RefPtr<Threading::Thread> m_refill_thread;
+    bool m_refill_stopping { false };
+
     bool m_use_stub { true };                 // True if Wasmtime not available
 
     // Timeout enforcement helper
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Endian.h>
+#include <AK/EnumBits.h>
+#include <AK/Error.h>
+#include <AK/Optional.h>
+#include <AK/Span.h>
+#include <AK/Types.h>
+
+namespace Sentinel::ScanProtocol {
+
+// Binary scan protocol for handing downloads to Sentinel without copying them over the socket.
+//
+// The JSON protocol ("scan_content") base64-encodes the whole download inside a JSON object,
+// which inflates it by a third and copies it several times on both sides. The binary protocol
+// instead sends a small fixed-size header as a regular length-prefixed message, immediately
+// followed by the file descriptor of a Core::AnonymousBuffer holding the content (SCM_RIGHTS).
+// Sentinel maps the pages read-only and scans them in place.
+//
+// Wire format (after the usual 4-byte BufferedIPCReader length prefix):
+// [magic: u32][version: u16][flags: u16][content_size: u64][request_id: u64]
+// All fields are in network byte order. The file descriptor follows as a separate 1-byte
+// message carrying the descriptor, as produced by Core::LocalSocket::send_fd().
+//
+// The response is a regular JSON message, identical to the one sent for "scan_content".
+//
+// Streaming scans reuse the same header with the StreamChunk or StreamEnd flag set. The request_id
+// then identifies the stream, and chunk bytes are carried inline after the header in the same framed
+// message instead of through a file descriptor. Sentinel keeps only an overlap window between chunks,
+// so its memory use is bounded by the chunk size rather than the size of the download, and it answers
+// every chunk with the verdict so far, allowing the transfer to be aborted as soon as a rule matches.
+
+static constexpr u32 SHARED_BUFFER_SCAN_MAGIC = 0x534E5442; // "SNTB"
+static constexpr u16 SHARED_BUFFER_SCAN_VERSION = 1;
+
+// Same ceiling as scan_file(): larger downloads are handled by the partial scan path in SecurityTap.
+static constexpr u64 MAX_SHARED_BUFFER_SCAN_SIZE = 200 * 1024 * 1024;
+
+// Inline stream chunks must fit in a single BufferedIPCReader message alongside the header.
+static constexpr u64 MAX_STREAM_CHUNK_SIZE = 8 * 1024 * 1024;
+
+// How long to wait for the descriptor that follows a shared buffer scan header
+static constexpr int SHARED_BUFFER_FD_TIMEOUT_MS = 5000;
+
+// Bytes of the previous chunk that are rescanned with the next one, so that patterns spanning a chunk
+// boundary are still matched. Matches ScanSizeConfig::chunk_overlap_size.
+static constexpr size_t STREAM_OVERLAP_SIZE = 4096;
+
+enum class ScanFlags : u16 {
+    None = 0,
+    StreamChunk = 1 << 0,
+    StreamEnd = 1 << 1,
+};
+AK_ENUM_BITWISE_OPERATORS(ScanFlags);
+
+struct [[gnu::packed]] SharedBufferScanHeader {
+    NetworkOrdered<u32> magic;
+    NetworkOrdered<u16> version;
+    NetworkOrdered<u16> flags;
+    NetworkOrdered<u64> content_size;
+    NetworkOrdered<u64> request_id;
+};
+static_assert(sizeof(SharedBufferScanHeader) == 24);
+
+inline SharedBufferScanHeader make_shared_buffer_scan_header(u64 content_size, u64 request_id, ScanFlags flags = ScanFlags::None)
+{
+    SharedBufferScanHeader header;
+    header.magic = SHARED_BUFFER_SCAN_MAGIC;
+    header.version = SHARED_BUFFER_SCAN_VERSION;
+    header.flags = to_underlying(flags);
+    header.content_size = content_size;
+    header.request_id = request_id;
+    return header;
+}
+
+inline ReadonlyBytes header_bytes(SharedBufferScanHeader const& header)
+{
+    return { reinterpret_cast<u8 const*>(&header), sizeof(header) };
+}
+
+inline ScanFlags flags_of(SharedBufferScanHeader const& header)
+{
+    return static_cast<ScanFlags>(static_cast<u16>(header.flags));
+}
+
+inline bool is_stream_message(SharedBufferScanHeader const& header)
+{
+    return has_any_flag(flags_of(header), ScanFlags::StreamChunk | ScanFlags::StreamEnd);
+}
+
+// Returns the header if the message is a binary scan request, or an empty Optional if it should be
+// handled as a JSON message. JSON messages always start with '{' so they can never match the magic.
+// Any inline stream chunk follows the header; see inline_payload().
+inline Optional<SharedBufferScanHeader> parse_shared_buffer_scan_header(ReadonlyBytes message)
+{
+    if (message.size() < sizeof(SharedBufferScanHeader))
+        return {};
+
+    SharedBufferScanHeader header;
+    __builtin_memcpy(&header, message.data(), sizeof(header));
+    if (header.magic != SHARED_BUFFER_SCAN_MAGIC)
+        return {};
+    return header;
+}
+
+inline ReadonlyBytes inline_payload(ReadonlyBytes message)
+{
+    return message.slice(sizeof(SharedBufferScanHeader));
+}
+
+inline ErrorOr<void> validate_stream_message(SharedBufferScanHeader const& header, ReadonlyBytes payload)
+{
+    if (header.version != SHARED_BUFFER_SCAN_VERSION)
+        return Error::from_string_literal("Unsupported shared buffer scan protocol version");
+    if (payload.size() != header.content_size)
+        return Error::from_string_literal("Stream chunk size does not match its header");
+    if (has_flag(flags_of(header), ScanFlags::StreamChunk) && payload.is_empty())
+        return Error::from_string_literal("Stream chunk has no content");
+    if (payload.size() > MAX_STREAM_CHUNK_SIZE)
+        return Error::from_string_literal("Stream chunk too large (max 8MB)");
+    return {};
+}
+
+inline ErrorOr<void> validate_shared_buffer_scan_header(SharedBufferScanHeader const& header)
+{
+    if (header.version != SHARED_BUFFER_SCAN_VERSION)
+        return Error::from_string_literal("Unsupported shared buffer scan protocol version");
+    if (is_stream_message(header))
+        return Error::from_string_literal("Stream messages carry their content inline");
+    if (header.content_size == 0)
+        return Error::from_string_literal("Shared buffer scan request has no content");
+    if (header.content_size > MAX_SHARED_BUFFER_SCAN_SIZE)
+        return Error::from_string_literal("Content too large for scanning (max 200MB)");
+    return {};
+}
+
+}
@@ -39,12 +39,21 @@ String SentinelMetrics::to_json() const
     json.set("average_query_time_ms"sv, average_query_time().to_milliseconds());
     json.set("scan_count"sv, scan_count);
     json.set("query_count"sv, query_count);
+    json.set("scan_time_p50_ms"sv, scan_latency.percentile(50).to_milliseconds());
+    json.set("scan_time_p99_ms"sv, scan_latency.percentile(99).to_milliseconds());
+    json.set("query_time_p50_us"sv, query_latency.percentile(50).to_microseconds());
+    json.set("query_time_p99_us"sv, query_latency.percentile(99).to_microseconds());
 
     // Storage statistics
     json.set("database_size_bytes"sv, database_size_bytes);
     json.set("quarantine_size_bytes"sv, quarantine_size_bytes);
     json.set("quarantine_file_count"sv, quarantine_file_count);
 
+    // Startup
+    json.set("startup_time_ms"sv, startup_time.to_milliseconds());
+    json.set("rules_load_time_ms"sv, rules_load_time.to_milliseconds());
+    json.set("rules_loaded_from_cache"sv, rules_loaded_from_cache);
+
     // System health
     json.set("started_at"sv, started_at.seconds_since_epoch());
     json.set("uptime_seconds"sv, uptime().to_seconds());
@@ -86,7 +95,9 @@ ErrorOr<String> SentinelMetrics::to_human_readable() const
     // Performance metrics
     builder.append("Performance:\n"sv);
     builder.appendff("  Avg scan time:       {} ms\n", average_scan_time().to_milliseconds());
+    builder.appendff("  Scan time p50/p99:   {} / {} ms\n", scan_latency.percentile(50).to_milliseconds(), scan_latency.percentile(99).to_milliseconds());
     builder.appendff("  Avg query time:      {} ms\n", average_query_time().to_milliseconds());
+    builder.appendff("  Query time p50/p99:  {} / {} us\n", query_latency.percentile(50).to_microseconds(), query_latency.percentile(99).to_microseconds());
     builder.append("\n"sv);
 
     // Storage statistics
@@ -96,6 +107,12 @@ ErrorOr<String> SentinelMetrics::to_human_readable() const
     builder.appendff("  Quarantined files:   {}\n", quarantine_file_count);
     builder.append("\n"sv);
 
+    // Startup
+    builder.append("Startup:\n"sv);
+    builder.appendff("  Startup time:        {} ms\n", startup_time.to_milliseconds());
+    builder.appendff("  YARA rules load:     {} ms ({})\n", rules_load_time.to_milliseconds(), rules_loaded_from_cache ? "precompiled" : "compiled");
+    builder.append("\n"sv);
+
     // System health
     builder.append("System Health:\n"sv);
     builder.appendff("  Uptime:              {} seconds\n", uptime().to_seconds());
@@ -112,81 +129,215 @@ ErrorOr<String> SentinelMetrics::to_human_readable() const
     return TRY(builder.to_string());
 }
 
+static double to_seconds(Duration duration)
+{
+    return static_cast<double>(duration.to_nanoseconds()) / 1e9;
+}
+
+static void append_prometheus_metric(StringBuilder& builder, StringView name, StringView type, StringView help, u64 value)
+{
+    builder.appendff("# HELP {} {}\n", name, help);
+    builder.appendff("# TYPE {} {}\n", name, type);
+    builder.appendff("{} {}\n", name, value);
+}
+
+static void append_prometheus_summary(StringBuilder& builder, StringView name, StringView help, LatencyHistogram const& histogram, Duration total)
+{
+    builder.appendff("# HELP {} {}\n", name, help);
+    builder.appendff("# TYPE {} summary\n", name);
+    struct Quantile {
+        StringView label;
+        double percent;
+    };
+    for (auto quantile : { Quantile { "0.5"sv, 50 }, Quantile { "0.9"sv, 90 }, Quantile { "0.99"sv, 99 }, Quantile { "0.999"sv, 99.9 } })
+        builder.appendff("{}{{quantile=\"{}\"}} {:.6f}\n", name, quantile.label, to_seconds(histogram.percentile(quantile.percent)));
+    builder.appendff("{}_sum {:.6f}\n", name, to_seconds(total));
+    builder.appendff("{}_count {}\n", name, histogram.count());
+}
+
+ErrorOr<String> SentinelMetrics::to_prometheus() const
+{
+    StringBuilder builder;
+
+    append_prometheus_metric(builder, "sentinel_downloads_scanned_total"sv, "counter"sv, "Downloads scanned"sv, total_downloads_scanned);
+
+    builder.append("# HELP sentinel_threats_total Threats detected, by the action taken\n"sv);
+    builder.append("# TYPE sentinel_threats_total counter\n"sv);
+    builder.appendff("sentinel_threats_total{{action=\"block\"}} {}\n", threats_blocked);
+    builder.appendff("sentinel_threats_total{{action=\"quarantine\"}} {}\n", threats_quarantined);
+    builder.appendff("sentinel_threats_total{{action=\"allow\"}} {}\n", threats_allowed);
+    builder.appendff("sentinel_threats_total{{action=\"other\"}} {}\n", threats_detected - min(threats_detected, threats_blocked + threats_quarantined + threats_allowed));
+
+    append_prometheus_metric(builder, "sentinel_policies_enforced_total"sv, "counter"sv, "Policies enforced"sv, policies_enforced);
+    append_prometheus_metric(builder, "sentinel_policies_created_total"sv, "counter"sv, "Policies created"sv, policies_created);
+    append_prometheus_metric(builder, "sentinel_policies"sv, "gauge"sv, "Policies in the policy database"sv, total_policies);
+
+    builder.append("# HELP sentinel_policy_cache_lookups_total Policy queries, by whether they were answered without the database\n"sv);
+    builder.append("# TYPE sentinel_policy_cache_lookups_total counter\n"sv);
+    builder.appendff("sentinel_policy_cache_lookups_total{{result=\"hit\"}} {}\n", cache_hits);
+    builder.appendff("sentinel_policy_cache_lookups_total{{result=\"miss\"}} {}\n", cache_misses);
+
+    append_prometheus_summary(builder, "sentinel_scan_duration_seconds"sv, "Time taken to scan a download"sv, scan_latency, total_scan_time);
+    append_prometheus_summary(builder, "sentinel_policy_query_duration_seconds"sv, "Time taken to match a threat against the policies"sv, query_latency, total_query_time);
+
+    append_prometheus_metric(builder, "sentinel_database_size_bytes"sv, "gauge"sv, "Size of the policy database"sv, database_size_bytes);
+    append_prometheus_metric(builder, "sentinel_quarantine_size_bytes"sv, "gauge"sv, "Size of the quarantined files"sv, quarantine_size_bytes);
+    append_prometheus_metric(builder, "sentinel_quarantine_files"sv, "gauge"sv, "Files in quarantine"sv, quarantine_file_count);
+
+    builder.append("# HELP sentinel_startup_seconds Time until Sentinel accepted connections\n"sv);
+    builder.append("# TYPE sentinel_startup_seconds gauge\n"sv);
+    builder.appendff("sentinel_startup_seconds {:.6f}\n", to_seconds(startup_time));
+    builder.append("# HELP sentinel_rules_load_seconds Time spent loading YARA rules at startup\n"sv);
+    builder.append("# TYPE sentinel_rules_load_seconds gauge\n"sv);
+    builder.appendff("sentinel_rules_load_seconds {:.6f}\n", to_seconds(rules_load_time));
+
+    append_prometheus_metric(builder, "sentinel_last_scan_timestamp_seconds"sv, "gauge"sv, "When the last download was scanned"sv, last_scan.seconds_since_epoch());
+    append_prometheus_metric(builder, "sentinel_last_threat_timestamp_seconds"sv, "gauge"sv, "When the last threat was detected"sv, last_threat.seconds_since_epoch());
+
+    return builder.to_string();
+}
+
 MetricsCollector& MetricsCollector::the()
 {
     static MetricsCollector instance;
     return instance;
 }
 
+MetricsCollector::Shard& MetricsCollector::current_shard()
+{
+    // Threads take shards round-robin the first time they record anything
+    static Atomic<size_t, AK::MemoryOrder::memory_order_relaxed> next_shard { 0 };
+    thread_local size_t const shard_index = next_shard.fetch_add(1) % SHARD_COUNT;
+    return m_shards[shard_index];
+}
+
+u64 MetricsCollector::sum(Counter counter) const
+{
+    u64 total = 0;
+    for (auto const& shard : m_shards)
+        total += shard.get(counter);
+    return total;
+}
+
+void MetricsCollector::reset_shards(std::initializer_list<Counter> counters)
+{
+    for (auto& shard : m_shards) {
+        for (auto counter : counters)
+            shard.reset(counter);
+    }
+}
+
 void MetricsCollector::record_download_scan(Duration scan_time)
 {
-    m_metrics.total_downloads_scanned++;
-    m_metrics.total_scan_time = m_metrics.total_scan_time + scan_time;
-    m_metrics.scan_count++;
-    m_metrics.last_scan = UnixDateTime::now();
+    auto& shard = current_shard();
+    shard.add(Counter::DownloadsScanned, 1);
+    shard.add(Counter::ScanCount, 1);
+    shard.add(Counter::ScanTimeNanoseconds, static_cast<u64>(max<i64>(scan_time.to_nanoseconds(), 0)));
+    shard.scan_latency.record(scan_time);
+    shard.last_scan_ms.store(UnixDateTime::now().milliseconds_since_epoch());
 }
 
 void MetricsCollector::record_threat_detected(String const& action)
 {
-    m_metrics.threats_detected++;
-    m_metrics.last_threat = UnixDateTime::now();
+    auto& shard = current_shard();
+    shard.add(Counter::ThreatsDetected, 1);
+    shard.last_threat_ms.store(UnixDateTime::now().milliseconds_since_epoch());
 
     if (action == "block"sv) {
-        m_metrics.threats_blocked++;
+        shard.add(Counter::ThreatsBlocked, 1);
     } else if (action == "quarantine"sv) {
-        m_metrics.threats_quarantined++;
+        shard.add(Counter::ThreatsQuarantined, 1);
     } else if (action == "allow"sv) {
-        m_metrics.threats_allowed++;
+        shard.add(Counter::ThreatsAllowed, 1);
     }
 }
 
 void MetricsCollector::record_policy_query(Duration query_time, bool cache_hit)
 {
-    m_metrics.total_query_time = m_metrics.total_query_time + query_time;
-    m_metrics.query_count++;
-
-    if (cache_hit) {
-        m_metrics.cache_hits++;
-    } else {
-        m_metrics.cache_misses++;
-    }
+    auto& shard = current_shard();
+    shard.add(Counter::QueryCount, 1);
+    shard.add(Counter::QueryTimeNanoseconds, static_cast<u64>(max<i64>(query_time.to_nanoseconds(), 0)));
+    shard.add(cache_hit ? Counter::CacheHits : Counter::CacheMisses, 1);
+    shard.query_latency.record(query_time);
 }
 
 void MetricsCollector::record_policy_created()
 {
-    m_metrics.policies_created++;
+    current_shard().add(Counter::PoliciesCreated, 1);
 }
 
 void MetricsCollector::record_policy_enforced()
 {
-    m_metrics.policies_enforced++;
+    current_shard().add(Counter::PoliciesEnforced, 1);
+}
+
+void MetricsCollector::record_startup(Duration startup_time, Duration rules_load_time, bool rules_loaded_from_cache)
+{
+    Sync::MutexLocker locker(m_mutex);
+    m_base.startup_time = startup_time;
+    m_base.rules_load_time = rules_load_time;
+    m_base.rules_loaded_from_cache = rules_loaded_from_cache;
 }
 
 void MetricsCollector::update_database_size(size_t bytes)
 {
-    m_metrics.database_size_bytes = bytes;
+    Sync::MutexLocker locker(m_mutex);
+    m_base.database_size_bytes = bytes;
 }
 
 void MetricsCollector::update_quarantine_stats(size_t bytes, size_t file_count)
 {
-    m_metrics.quarantine_size_bytes = bytes;
-    m_metrics.quarantine_file_count = file_count;
+    Sync::MutexLocker locker(m_mutex);
+    m_base.quarantine_size_bytes = bytes;
+    m_base.quarantine_file_count = file_count;
 }
 
 void MetricsCollector::update_total_policies(size_t count)
 {
-    m_metrics.total_policies = count;
+    Sync::MutexLocker locker(m_mutex);
+    m_base.total_policies = count;
 }
 
 SentinelMetrics MetricsCollector::snapshot() const
 {
-    return m_metrics;
+    SentinelMetrics metrics;
+    {
+        Sync::MutexLocker locker(m_mutex);
+        metrics = m_base;
+    }
+
+    metrics.total_downloads_scanned += sum(Counter::DownloadsScanned);
+    metrics.threats_detected += sum(Counter::ThreatsDetected);
+    metrics.threats_blocked += sum(Counter::ThreatsBlocked);
+    metrics.threats_quarantined += sum(Counter::ThreatsQuarantined);
+    metrics.threats_allowed += sum(Counter::ThreatsAllowed);
+    metrics.policies_enforced += sum(Counter::PoliciesEnforced);
+    metrics.policies_created += sum(Counter::PoliciesCreated);
+    metrics.cache_hits += sum(Counter::CacheHits);
+    metrics.cache_misses += sum(Counter::CacheMisses);
+    metrics.scan_count += sum(Counter::ScanCount);
+    metrics.query_count += sum(Counter::QueryCount);
+    metrics.total_scan_time = metrics.total_scan_time + Duration::from_nanoseconds(static_cast<i64>(sum(Counter::ScanTimeNanoseconds)));
+    metrics.total_query_time = metrics.total_query_time + Duration::from_nanoseconds(static_cast<i64>(sum(Counter::QueryTimeNanoseconds)));
+
+    i64 last_scan_ms = metrics.last_scan.milliseconds_since_epoch();
+    i64 last_threat_ms = metrics.last_threat.milliseconds_since_epoch();
+    for (auto const& shard : m_shards) {
+        last_scan_ms = max(last_scan_ms, shard.last_scan_ms.load());
+        last_threat_ms = max(last_threat_ms, shard.last_threat_ms.load());
+        shard.scan_latency.add_to(metrics.scan_latency);
+        shard.query_latency.add_to(metrics.query_latency);
+    }
+    metrics.last_scan = UnixDateTime::from_milliseconds_since_epoch(last_scan_ms);
+    metrics.last_threat = UnixDateTime::from_milliseconds_since_epoch(last_threat_ms);
+
+    return metrics;
 }
 
 ErrorOr<void> MetricsCollector::save_to_file(String const& path)
 {
     auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write));
-    auto json = m_metrics.to_json();
+    auto json = snapshot().to_json();
     TRY(file->write_until_depleted(json.bytes()));
     return {};
 }
@@ -202,46 +353,84 @@ ErrorOr<void> MetricsCollector::load_from_file(String const& path)
 
     auto const& obj = json.as_object();
 
+    // The loaded totals become the base the shards count on from; the shards start over so nothing is counted twice
+    reset_shards({
+        Counter::DownloadsScanned,
+        Counter::ThreatsDetected,
+        Counter::ThreatsBlocked,
+        Counter::ThreatsQuarantined,
+        Counter::ThreatsAllowed,
+        Counter::PoliciesEnforced,
+        Counter::PoliciesCreated,
+        Counter::CacheHits,
+        Counter::CacheMisses,
+        Counter::ScanCount,
+        Counter::QueryCount,
+    });
+
+    Sync::MutexLocker locker(m_mutex);
+
     // Load scan statistics
-    m_metrics.total_downloads_scanned = obj.get_u64("total_downloads_scanned"sv).value_or(0);
-    m_metrics.threats_detected = obj.get_u64("threats_detected"sv).value_or(0);
-    m_metrics.threats_blocked = obj.get_u64("threats_blocked"sv).value_or(0);
-    m_metrics.threats_quarantined = obj.get_u64("threats_quarantined"sv).value_or(0);
-    m_metrics.threats_allowed = obj.get_u64("threats_allowed"sv).value_or(0);
+    m_base.total_downloads_scanned = obj.get_u64("total_downloads_scanned"sv).value_or(0);
+    m_base.threats_detected = obj.get_u64("threats_detected"sv).value_or(0);
+    m_base.threats_blocked = obj.get_u64("threats_blocked"sv).value_or(0);
+    m_base.threats_quarantined = obj.get_u64("threats_quarantined"sv).value_or(0);
+    m_base.threats_allowed = obj.get_u64("threats_allowed"sv).value_or(0);
 
     // Load policy statistics
-    m_metrics.policies_enforced = obj.get_u64("policies_enforced"sv).value_or(0);
-    m_metrics.policies_created = obj.get_u64("policies_created"sv).value_or(0);
-    m_metrics.total_policies = obj.get_u64("total_policies"sv).value_or(0);
+    m_base.policies_enforced = obj.get_u64("policies_enforced"sv).value_or(0);
+    m_base.policies_created = obj.get_u64("policies_created"sv).value_or(0);
+    m_base.total_policies = obj.get_u64("total_policies"sv).value_or(0);
 
     // Load cache statistics
-    m_metrics.cache_hits = obj.get_u64("cache_hits"sv).value_or(0);
-    m_metrics.cache_misses = obj.get_u64("cache_misses"sv).value_or(0);
+    m_base.cache_hits = obj.get_u64("cache_hits"sv).value_or(0);
+    m_base.cache_misses = obj.get_u64("cache_misses"sv).value_or(0);
 
     // Load performance metrics
-    m_metrics.scan_count = obj.get_u64("scan_count"sv).value_or(0);
-    m_metrics.query_count = obj.get_u64("query_count"sv).value_or(0);
+    m_base.scan_count = obj.get_u64("scan_count"sv).value_or(0);
+    m_base.query_count = obj.get_u64("query_count"sv).value_or(0);
 
     // Load storage statistics
-    m_metrics.database_size_bytes = obj.get_u64("database_size_bytes"sv).value_or(0);
-    m_metrics.quarantine_size_bytes = obj.get_u64("quarantine_size_bytes"sv).value_or(0);
-    m_metrics.quarantine_file_count = obj.get_u64("quarantine_file_count"sv).value_or(0);
+    m_base.database_size_bytes = obj.get_u64("database_size_bytes"sv).value_or(0);
+    m_base.quarantine_size_bytes = obj.get_u64("quarantine_size_bytes"sv).value_or(0);
+    m_base.quarantine_file_count = obj.get_u64("quarantine_file_count"sv).value_or(0);
 
     return {};
 }
 
+// Resetting while other threads record can drop the samples that race with it, which is fine for
+// statistics that are being thrown away anyway.
 void MetricsCollector::reset_session_metrics()
 {
-    m_metrics.total_scan_time = Duration::zero();
-    m_metrics.total_query_time = Duration::zero();
-    m_metrics.scan_count = 0;
-    m_metrics.query_count = 0;
-    m_metrics.started_at = UnixDateTime::now();
+    reset_shards({ Counter::ScanCount, Counter::QueryCount, Counter::ScanTimeNanoseconds, Counter::QueryTimeNanoseconds });
+    for (auto& shard : m_shards) {
+        shard.scan_latency.reset();
+        shard.query_latency.reset();
+    }
+
+    Sync::MutexLocker locker(m_mutex);
+    m_base.total_scan_time = Duration::zero();
+    m_base.total_query_time = Duration::zero();
+    m_base.scan_count = 0;
+    m_base.query_count = 0;
+    m_base.scan_latency = {};
+    m_base.query_latency = {};
+    m_base.started_at = UnixDateTime::now();
 }
 
 void MetricsCollector::reset_all_metrics()
 {
-    m_metrics = SentinelMetrics {};
+    for (auto& shard : m_shards) {
+        for (auto& counter : shard.counters)
+            counter.store(0);
+        shard.last_scan_ms.store(0);
+        shard.last_threat_ms.store(0);
+        shard.scan_latency.reset();
+        shard.query_latency.reset();
+    }
+
+    Sync::MutexLocker locker(m_mutex);
+    m_base = SentinelMetrics {};
 }
 
 }
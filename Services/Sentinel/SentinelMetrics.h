@@ -6,10 +6,15 @@
 
 #pragma once
 
+#include <AK/Array.h>
+#include <AK/Atomic.h>
 #include <AK/Error.h>
 #include <AK/String.h>
 #include <AK/Time.h>
 #include <LibCore/File.h>
+#include <LibSync/Mutex.h>
+#include <Services/Sentinel/LatencyHistogram.h>
+#include <initializer_list>
 
 using AK::Duration;
 
@@ -37,12 +42,19 @@ struct SentinelMetrics {
     Duration total_query_time { Duration::zero() };
     size_t scan_count { 0 };
     size_t query_count { 0 };
+    LatencyHistogram scan_latency;
+    LatencyHistogram query_latency;
 
     // Storage statistics
     size_t database_size_bytes { 0 };
     size_t quarantine_size_bytes { 0 };
     size_t quarantine_file_count { 0 };
 
+    // Startup: time until Sentinel accepted connections, and how much of it went into loading YARA rules
+    Duration startup_time { Duration::zero() };
+    Duration rules_load_time { Duration::zero() };
+    bool rules_loaded_from_cache { false };
+
     // System health
     UnixDateTime started_at { UnixDateTime::now() };
     UnixDateTime last_scan { UnixDateTime::epoch() };
@@ -73,8 +85,16 @@ struct SentinelMetrics {
     // Serialization
     [[nodiscard]] String to_json() const;
     [[nodiscard]] ErrorOr<String> to_human_readable() const;
+
+    // Prometheus text exposition format, with scan and query latency as summaries
+    [[nodiscard]] ErrorOr<String> to_prometheus() const;
 };
 
+// Counters and latency histograms are sharded per thread and only merged on snapshot(), so
+// recording a scan or query is a handful of relaxed atomic adds on a cache line no other
+// thread is writing. Gauges and the counters loaded from disk are rarely written and sit
+// behind a mutex that the recording paths never take.
+
 class MetricsCollector {
 public:
     static MetricsCollector& the();
@@ -85,6 +105,7 @@ public:
     void record_policy_query(Duration query_time, bool cache_hit);
     void record_policy_created();
     void record_policy_enforced();
+    void record_startup(Duration startup_time, Duration rules_load_time, bool rules_loaded_from_cache);
 
     // Storage updates
     void update_database_size(size_t bytes);
@@ -105,7 +126,48 @@ public:
 private:
     MetricsCollector() = default;
 
-    mutable SentinelMetrics m_metrics;
+    enum class Counter : u8 {
+        DownloadsScanned,
+        ThreatsDetected,
+        ThreatsBlocked,
+        ThreatsQuarantined,
+        ThreatsAllowed,
+        PoliciesEnforced,
+        PoliciesCreated,
+        CacheHits,
+        CacheMisses,
+        ScanCount,
+        QueryCount,
+        ScanTimeNanoseconds,
+        QueryTimeNanoseconds,
+        __Count,
+    };
+
+    using RelaxedCounter = Atomic<u64, AK::MemoryOrder::memory_order_relaxed>;
+
+    struct alignas(64) Shard {
+        void add(Counter counter, u64 value) { counters[to_underlying(counter)].fetch_add(value); }
+        u64 get(Counter counter) const { return counters[to_underlying(counter)].load(); }
+        void reset(Counter counter) { counters[to_underlying(counter)].store(0); }
+
+        Array<RelaxedCounter, to_underlying(Counter::__Count)> counters;
+        Atomic<i64, AK::MemoryOrder::memory_order_relaxed> last_scan_ms { 0 };
+        Atomic<i64, AK::MemoryOrder::memory_order_relaxed> last_threat_ms { 0 };
+        AtomicLatencyHistogram scan_latency;
+        AtomicLatencyHistogram query_latency;
+    };
+
+    // Threads beyond this many share shards, which is still correct, just no longer contention-free
+    static constexpr size_t SHARD_COUNT = 16;
+
+    Shard& current_shard();
+    u64 sum(Counter) const;
+    void reset_shards(std::initializer_list<Counter>);
+
+    Array<Shard, SHARD_COUNT> m_shards;
+
+    mutable Sync::Mutex m_mutex;
+    SentinelMetrics m_base;
 };
 
 }
@@ -8,96 +8,52 @@
 #include "InputValidator.h"
 #include "MalwareML.h"
 #include "PolicyGraph.h"
+#include "SentinelMetrics.h"
 #include "ThreatFeed.h"
 #include <AK/Base64.h>
 #include <AK/JsonArray.h>
 #include <AK/JsonObject.h>
 #include <AK/JsonParser.h>
 #include <AK/JsonValue.h>
+#include <AK/ScopeGuard.h>
+#include <AK/StringBuilder.h>
 #include <LibCore/File.h>
+#include <LibCore/StandardPaths.h>
 #include <LibCore/System.h>
 #include <LibFileSystem/FileSystem.h>
 #include <LibIPC/BufferedIPCReader.h>
 #include <LibIPC/BufferedIPCWriter.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
-#include <yara.h>
-
-// Undefine YARA macros that conflict with AK classes
-#ifdef get_string
-#    undef get_string
-#endif
-#ifdef set
-#    undef set
-#endif
+#include <unistd.h>
 
 namespace Sentinel {
 
-static YR_RULES* s_yara_rules = nullptr;
-
-static ErrorOr<void> initialize_yara()
-{
-    dbgln("Sentinel: Initializing YARA");
-
-    int result = yr_initialize();
-    if (result != ERROR_SUCCESS)
-        return Error::from_string_literal("Failed to initialize YARA");
-
-    YR_COMPILER* compiler = nullptr;
-    result = yr_compiler_create(&compiler);
-    if (result != ERROR_SUCCESS) {
-        yr_finalize();
-        return Error::from_string_literal("Failed to create YARA compiler");
-    }
-
-    // Load default rules from Services/Sentinel/rules/default.yar
-    ByteString rules_path = "/home/rbsmith4/ladybird/Services/Sentinel/rules/default.yar"sv;
-    auto rules_file = Core::File::open(rules_path, Core::File::OpenMode::Read);
-
-    if (rules_file.is_error()) {
-        dbgln("Sentinel: Failed to open YARA rules at {}: {}", rules_path, rules_file.error());
-        yr_compiler_destroy(compiler);
-        yr_finalize();
-        return Error::from_string_literal("Failed to open YARA rules file");
-    }
-
-    auto rules_content = rules_file.value()->read_until_eof();
-    if (rules_content.is_error()) {
-        dbgln("Sentinel: Failed to read YARA rules: {}", rules_content.error());
-        yr_compiler_destroy(compiler);
-        yr_finalize();
-        return Error::from_string_literal("Failed to read YARA rules file");
-    }
-
-    // Add rules to compiler
-    result = yr_compiler_add_string(compiler,
-        reinterpret_cast<char const*>(rules_content.value().data()),
-        nullptr);
-
-    if (result != 0) {
-        dbgln("Sentinel: Failed to compile YARA rules");
-        yr_compiler_destroy(compiler);
-        yr_finalize();
-        return Error::from_string_literal("Failed to compile YARA rules");
-    }
-
-    // Get compiled rules
-    result = yr_compiler_get_rules(compiler, &s_yara_rules);
-    if (result != ERROR_SUCCESS) {
-        yr_compiler_destroy(compiler);
-        yr_finalize();
-        return Error::from_string_literal("Failed to get compiled YARA rules");
-    }
-
-    yr_compiler_destroy(compiler);
-
-    dbgln("Sentinel: YARA initialized successfully");
-    return {};
-}
+// Rule files compiled into the active rule set; rules written by ThreatIntelligence::YARAGenerator
+// are added with SentinelServer::add_rule_file()
+static constexpr auto DEFAULT_RULES_PATH = "/home/rbsmith4/ladybird/Services/Sentinel/rules/default.yar"sv;
 
 ErrorOr<NonnullOwnPtr<SentinelServer>> SentinelServer::create()
 {
-    // Initialize YARA rules
-    TRY(initialize_yara());
+    auto startup_start = MonotonicTime::now();
+
+    // Compile the YARA rules once; every scan worker shares the same immutable rule set.
+    // Compiled rules are cached on disk, so unchanged rules load without recompiling.
+    auto yara_engine = TRY(YARAScanEngine::create());
+    yara_engine->set_compiled_rules_cache_directory(ByteString::formatted("{}/ladybird/sentinel/compiled-rules", Core::StandardPaths::cache_directory()));
+
+    Vector<ByteString> rule_files { DEFAULT_RULES_PATH };
+    auto rules_load_start = MonotonicTime::now();
+    if (auto result = yara_engine->load_rules_from_files(rule_files); result.is_error()) {
+        dbgln("Sentinel: Failed to load YARA rules from {}: {}", DEFAULT_RULES_PATH, result.error());
+        return result.release_error();
+    }
+    auto rules_load_time = MonotonicTime::now() - rules_load_start;
+    bool rules_loaded_from_cache = yara_engine->rules()->was_loaded_from_cache();
+    dbgln("Sentinel: YARA initialized successfully in {}ms (rules version {:016x}, {})",
+        rules_load_time.to_milliseconds(), yara_engine->rules_version(), rules_loaded_from_cache ? "precompiled" : "compiled");
 
     // Remove stale socket file if it exists (from previous unclean shutdown)
     auto socket_path = "/tmp/sentinel.sock"sv;
@@ -117,6 +73,8 @@ ErrorOr<NonnullOwnPtr<SentinelServer>> SentinelServer::create()
         return Error::from_string_literal("Failed to listen on /tmp/sentinel.sock");
 
     auto sentinel_server = adopt_own(*new SentinelServer(move(server)));
+    sentinel_server->m_yara_engine = move(yara_engine);
+    sentinel_server->m_rule_files = move(rule_files);
 
     // Initialize ML-based malware detection (Milestone 0.4)
     // For now, use a dummy model path - will be replaced with actual model later
@@ -153,13 +111,15 @@ ErrorOr<NonnullOwnPtr<SentinelServer>> SentinelServer::create()
             stats.total_threats, stats.false_positive_rate * 100);
     }
 
+    MetricsCollector::the().record_startup(MonotonicTime::now() - startup_start, rules_load_time, rules_loaded_from_cache);
+
     return sentinel_server;
 }
 
 SentinelServer::SentinelServer(NonnullRefPtr<Core::LocalServer> server)
     : m_server(move(server))
 {
-    m_server->on_accept = [this](NonnullOwnPtr<Core::Socket> client_socket) {
+    m_server->on_accept = [this](NonnullOwnPtr<Core::LocalSocket> client_socket) {
         handle_client(move(client_socket));
     };
 }
@@ -177,13 +137,51 @@ int SentinelServer::get_client_id(Core::Socket const* socket)
     return client_id;
 }
 
-void SentinelServer::handle_client(NonnullOwnPtr<Core::Socket> socket)
+Optional<int> SentinelServer::find_client_id(Core::Socket const* socket) const
+{
+    return m_socket_to_client_id.get(socket);
+}
+
+bool SentinelServer::is_client_connected(Core::Socket* socket, int client_id) const
+{
+    return m_client_readers.contains(socket) && find_client_id(socket) == client_id;
+}
+
+bool SentinelServer::is_privileged_peer(Core::LocalSocket const& socket)
+{
+    auto peer_uid = socket.peer_uid();
+    if (peer_uid.is_error()) {
+        dbgln("Sentinel: Failed to get peer credentials: {}", peer_uid.error());
+        return false;
+    }
+    return peer_uid.value() == 0 || peer_uid.value() == geteuid();
+}
+
+void SentinelServer::disconnect_client(Core::Socket* socket)
+{
+    drop_stream_sessions(socket);
+    m_client_readers.remove(socket);
+    m_rules_version_subscribers.remove(socket);
+    if (auto client_id = m_socket_to_client_id.take(socket); client_id.has_value())
+        m_privileged_client_ids.remove(*client_id);
+
+    // NB: This runs from the socket's own read notification, so only destroy it once that has returned.
+    Core::deferred_invoke([this, socket] {
+        m_clients.remove_first_matching([&](auto const& client) { return client.ptr() == socket; });
+    });
+}
+
+void SentinelServer::handle_client(NonnullOwnPtr<Core::LocalSocket> socket)
 {
     dbgln("Sentinel: Client connected");
 
     // Create a buffered reader for this client
     auto* socket_ptr = socket.ptr();
-    m_client_readers.set(socket_ptr, IPC::BufferedIPCReader {});
+    m_client_readers.set(socket_ptr, ClientReader {});
+
+    auto client_id = get_client_id(socket_ptr);
+    if (is_privileged_peer(*socket))
+        m_privileged_client_ids.set(client_id);
 
     socket->on_ready_to_read = [this, sock = socket_ptr]() {
         // Get the buffered reader for this client
@@ -193,20 +191,37 @@ void SentinelServer::handle_client(NonnullOwnPtr<Core::Socket> socket)
             return;
         }
 
-        auto& reader = reader_it->value;
+        auto& client_reader = reader_it->value;
+
+        if (client_reader.header_awaiting_fd.has_value()) {
+            receive_shared_buffer_scan_fd(*sock, client_reader);
+            return;
+        }
 
         // Try to read a complete message (handles partial reads internally)
-        auto message_result = reader.read_complete_message(*sock);
+        auto message_result = client_reader.reader.read_complete_message(*sock);
 
         if (message_result.is_error()) {
             dbgln("Sentinel: Read error: {}", message_result.error());
-            // Clean up reader on error
-            m_client_readers.remove(sock);
+            // Clean up reader and any unfinished streams on error
+            disconnect_client(sock);
             return;
         }
 
         auto message_buffer = message_result.release_value();
 
+        // Binary shared-buffer scan requests carry no JSON; the content arrives as a file descriptor
+        if (auto header = ScanProtocol::parse_shared_buffer_scan_header(message_buffer.bytes()); header.has_value()) {
+            if (!ScanProtocol::is_stream_message(header.value())) {
+                client_reader.header_awaiting_fd = header.release_value();
+                receive_shared_buffer_scan_fd(*sock, client_reader);
+                return;
+            }
+            if (auto scan_result = process_stream_scan_message(*sock, header.value(), ScanProtocol::inline_payload(message_buffer.bytes())); scan_result.is_error())
+                dbgln("Sentinel: Failed to process shared buffer scan: {}", scan_result.error());
+            return;
+        }
+
         // Convert message to String with UTF-8 validation
         auto message_string_result = String::from_utf8(StringView(
             reinterpret_cast<char const*>(message_buffer.data()),
@@ -303,9 +318,12 @@ ErrorOr<void> SentinelServer::process_message(Core::Socket& socket, String const
     }
 
     if (action.value() == "metrics"sv) {
-        auto metrics_str = m_health_check.get_metrics_prometheus_format();
+        // Health check metrics followed by the scan and policy query counters and latency summaries
+        StringBuilder metrics_builder;
+        metrics_builder.append(m_health_check.get_metrics_prometheus_format());
+        metrics_builder.append(TRY(MetricsCollector::the().snapshot().to_prometheus()));
         response.set("status"sv, "success"sv);
-        response.set("metrics"sv, metrics_str);
+        response.set("metrics"sv, TRY(metrics_builder.to_string()));
 
         auto response_str = response.serialized();
         IPC::BufferedIPCWriter writer;
@@ -351,23 +369,15 @@ ErrorOr<void> SentinelServer::process_message(Core::Socket& socket, String const
                 response.set("status"sv, "error"sv);
                 response.set("error"sv, validation_result.error_message);
             } else {
-                // Convert String to ByteString for scan_file
-                auto result = scan_file(ByteString(file_path.value().bytes_as_string_view()));
-                m_rate_limiter.release_scan_slot(client_id); // Release slot after scan completes
-
-                if (result.is_error()) {
+                auto content = read_file_to_scan(ByteString(file_path.value().bytes_as_string_view()));
+                if (content.is_error()) {
+                    m_rate_limiter.release_scan_slot(client_id); // Release slot on early exit
                     response.set("status"sv, "error"sv);
-                    response.set("error"sv, result.error().string_literal());
+                    response.set("error"sv, content.error().string_literal());
                 } else {
-                    // Convert scan result to UTF-8 string - handle errors gracefully
-                    auto result_string = String::from_utf8(StringView(result.value()));
-                    if (result_string.is_error()) {
-                        response.set("status"sv, "error"sv);
-                        response.set("error"sv, "Scan result contains invalid UTF-8"sv);
-                    } else {
-                        response.set("status"sv, "success"sv);
-                        response.set("result"sv, result_string.release_value());
-                    }
+                    // The response is sent once the scan completes; the slot is released then
+                    scan_content_async(socket, client_id, move(response), content.release_value());
+                    return {};
                 }
             }
         }
@@ -415,26 +425,37 @@ ErrorOr<void> SentinelServer::process_message(Core::Socket& socket, String const
                     response.set("status"sv, "error"sv);
                     response.set("error"sv, "Failed to decode base64 content"sv);
                 } else {
-                    auto result = scan_content(decoded_result.value().bytes());
-                    m_rate_limiter.release_scan_slot(client_id); // Release slot after scan completes
-
-                    if (result.is_error()) {
-                        response.set("status"sv, "error"sv);
-                        response.set("error"sv, result.error().string_literal());
-                    } else {
-                        // Convert scan result to UTF-8 string - handle errors gracefully
-                        auto result_string = String::from_utf8(StringView(result.value()));
-                        if (result_string.is_error()) {
-                            response.set("status"sv, "error"sv);
-                            response.set("error"sv, "Scan result contains invalid UTF-8"sv);
-                        } else {
-                            response.set("status"sv, "success"sv);
-                            response.set("result"sv, result_string.release_value());
-                        }
-                    }
+                    // The response is sent once the scan completes; the slot is released then
+                    scan_content_async(socket, client_id, move(response), make<ByteBuffer>(decoded_result.release_value()));
+                    return {};
                 }
             }
         }
+    } else if (action.value() == "subscribe_rules_version"sv) {
+        // Sent by RequestServers on connect: they cache verdicts per rules version, and must stop serving cached
+        // verdicts as soon as the rules change rather than when they next happen to see a new version
+        m_rules_version_subscribers.set(&socket);
+        response.set("status"sv, "success"sv);
+        response.set("rules_version"sv, String::number(m_yara_engine->rules_version()));
+    } else if (action.value() == "reload_rules"sv) {
+        // SECURITY: Reloading affects every client, so only privileged peers may do it
+        if (!m_privileged_client_ids.contains(client_id)) {
+            dbgln("Sentinel: Rejected reload_rules from unprivileged client {}", client_id);
+            response.set("status"sv, "error"sv);
+            response.set("error"sv, "Permission denied"sv);
+        } else if (m_rate_limiter.check_scan_request(client_id).is_error()) {
+            // Recompiling is expensive, so a reload counts against the scan rate limit
+            dbgln("Sentinel: Rate limit exceeded for client {} (reload_rules)", client_id);
+            response.set("status"sv, "error"sv);
+            response.set("error"sv, "Rate limit exceeded. Too many scan requests. Please try again later."sv);
+        } else if (auto result = reload_yara_rules(); result.is_error()) {
+            dbgln("Sentinel: Failed to reload YARA rules: {}", result.error());
+            response.set("status"sv, "error"sv);
+            response.set("error"sv, "Failed to compile YARA rules; previous rules remain active"sv);
+        } else {
+            response.set("status"sv, "success"sv);
+            response.set("rules_version"sv, String::number(m_yara_engine->rules_version()));
+        }
     } else {
         response.set("status"sv, "error"sv);
         response.set("error"sv, "Unknown action"sv);
@@ -449,6 +470,267 @@ ErrorOr<void> SentinelServer::process_message(Core::Socket& socket, String const
     return {};
 }
 
+// A client's shared buffer, mapped for the duration of one asynchronous scan
+class SharedBufferMapping {
+public:
+    SharedBufferMapping(void* address, size_t size, Function<void()> on_release)
+        : m_address(address)
+        , m_size(size)
+        , m_on_release(move(on_release))
+    {
+    }
+
+    ~SharedBufferMapping()
+    {
+        (void)Core::System::munmap(m_address, m_size);
+        m_on_release();
+    }
+
+    ReadonlyBytes bytes() const { return { static_cast<u8 const*>(m_address), m_size }; }
+
+private:
+    void* m_address { nullptr };
+    size_t m_size { 0 };
+    Function<void()> m_on_release;
+};
+
+void SentinelServer::receive_shared_buffer_scan_fd(Core::LocalSocket& socket, ClientReader& client_reader)
+{
+    VERIFY(client_reader.header_awaiting_fd.has_value());
+
+    // NB: Client sockets are non-blocking, and the descriptor may not have arrived yet when the header has been read.
+    //     Waiting for it here would stall every other client, so pick up again once the socket is readable.
+    auto fd = socket.receive_fd(O_CLOEXEC);
+    if (fd.is_error() && fd.error().is_errno() && (fd.error().code() == EAGAIN || fd.error().code() == EWOULDBLOCK)) {
+        if (!client_reader.fd_timeout_timer) {
+            client_reader.fd_timeout_timer = Core::Timer::create_single_shot(ScanProtocol::SHARED_BUFFER_FD_TIMEOUT_MS, [this, socket = &socket, client_id = get_client_id(&socket)] {
+                // NB: Disconnecting destroys this timer, so only do so once its callback has returned.
+                Core::deferred_invoke([this, socket, client_id] {
+                    if (!is_client_connected(socket, client_id) || !m_client_readers.get(socket)->header_awaiting_fd.has_value())
+                        return;
+                    dbgln("Sentinel: Timed out waiting for shared buffer descriptor");
+                    disconnect_client(socket);
+                });
+            });
+            client_reader.fd_timeout_timer->start();
+        }
+        return;
+    }
+
+    auto header = client_reader.header_awaiting_fd.release_value();
+    client_reader.fd_timeout_timer = nullptr;
+
+    // Without its descriptor the next message can't be told apart from the one it should have carried
+    if (fd.is_error()) {
+        dbgln("Sentinel: Failed to receive shared buffer descriptor: {}", fd.error());
+        disconnect_client(&socket);
+        return;
+    }
+
+    if (auto result = process_shared_buffer_scan(socket, header, fd.release_value()); result.is_error())
+        dbgln("Sentinel: Failed to process shared buffer scan: {}", result.error());
+}
+
+ErrorOr<void> SentinelServer::process_shared_buffer_scan(Core::LocalSocket& socket, ScanProtocol::SharedBufferScanHeader const& header, int fd)
+{
+    int client_id = get_client_id(&socket);
+    ScopeGuard close_fd = [&] { (void)Core::System::close(fd); };
+
+    JsonObject response;
+    response.set("request_id"sv, MUST(String::formatted("download_{}", static_cast<u64>(header.request_id))));
+
+    auto send_response = [&]() -> ErrorOr<void> {
+        auto response_str = response.serialized();
+        IPC::BufferedIPCWriter writer;
+        TRY(writer.write_message(socket, response_str.bytes_as_string_view()));
+        return {};
+    };
+
+    auto send_error = [&](StringView error) -> ErrorOr<void> {
+        response.set("status"sv, "error"sv);
+        response.set("error"sv, error);
+        return send_response();
+    };
+
+    if (auto validation = ScanProtocol::validate_shared_buffer_scan_header(header); validation.is_error())
+        return send_error(validation.error().string_literal());
+
+    // SECURITY: Rate limiting check for scan requests
+    if (m_rate_limiter.check_scan_request(client_id).is_error()) {
+        dbgln("Sentinel: Rate limit exceeded for client {} (shared buffer scan)", client_id);
+        return send_error("Rate limit exceeded. Too many scan requests. Please try again later."sv);
+    }
+
+    // SECURITY: Check concurrent scan limit
+    if (m_rate_limiter.check_concurrent_scans(client_id).is_error()) {
+        dbgln("Sentinel: Concurrent scan limit exceeded for client {}", client_id);
+        return send_error("Concurrent scan limit exceeded. Please wait for ongoing scans to complete."sv);
+    }
+    ScopeGuard release_slot = [&] { m_rate_limiter.release_scan_slot(client_id); };
+
+    // SECURITY: Never map past the end of the object, or a truncated buffer would SIGBUS us mid-scan
+    size_t content_size = header.content_size;
+    auto stat_result = Core::System::fstat(fd);
+    if (stat_result.is_error() || static_cast<u64>(stat_result.value().st_size) < content_size)
+        return send_error("Shared buffer is smaller than the declared content size"sv);
+
+    // Map the client's pages read-only and scan them in place
+    auto mapping_result = Core::System::mmap(nullptr, content_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping_result.is_error())
+        return send_error("Failed to map shared buffer"sv);
+
+    // The YARA pass runs on a scan worker so this event loop keeps serving other clients; the
+    // mapping and the concurrent scan slot stay held until the scan completes.
+    release_slot.disarm();
+    auto mapping = adopt_own(*new SharedBufferMapping(mapping_result.release_value(), content_size, [this, client_id] {
+        m_rate_limiter.release_scan_slot(client_id);
+    }));
+    auto content = mapping->bytes();
+
+    auto scan_start = MonotonicTime::now();
+    m_yara_engine->scan_async(content, [this, socket = &socket, client_id, response = move(response), mapping = move(mapping), scan_start](ErrorOr<YARAScanResult> yara_result) mutable {
+        // The client may have disconnected while its scan was running
+        if (!is_client_connected(socket, client_id))
+            return;
+
+        if (yara_result.is_error()) {
+            response.set("status"sv, "error"sv);
+            response.set("error"sv, yara_result.error().string_literal());
+        } else {
+            auto verdict = build_scan_verdict(mapping->bytes(), yara_result.value());
+            MetricsCollector::the().record_download_scan(MonotonicTime::now() - scan_start);
+            auto result_string = String::from_utf8(verdict.view());
+            if (result_string.is_error()) {
+                response.set("status"sv, "error"sv);
+                response.set("error"sv, "Scan result contains invalid UTF-8"sv);
+            } else {
+                response.set("status"sv, "success"sv);
+                response.set("result"sv, result_string.release_value());
+                response.set("rules_version"sv, String::number(yara_result.value().rules_version));
+            }
+        }
+
+        auto response_str = response.serialized();
+        IPC::BufferedIPCWriter writer;
+        if (auto result = writer.write_message(*socket, response_str.bytes_as_string_view()); result.is_error())
+            dbgln("Sentinel: Failed to send shared buffer scan result: {}", result.error());
+    },
+        client_id);
+    return {};
+}
+
+ErrorOr<void> SentinelServer::process_stream_scan_message(Core::LocalSocket& socket, ScanProtocol::SharedBufferScanHeader const& header, ReadonlyBytes payload)
+{
+    int client_id = get_client_id(&socket);
+    u64 stream_id = header.request_id;
+
+    JsonObject response;
+    response.set("request_id"sv, MUST(String::formatted("stream_{}", stream_id)));
+
+    auto send_response = [&]() -> ErrorOr<void> {
+        auto response_str = response.serialized();
+        IPC::BufferedIPCWriter writer;
+        TRY(writer.write_message(socket, response_str.bytes_as_string_view()));
+        return {};
+    };
+
+    auto send_error = [&](StringView error) -> ErrorOr<void> {
+        response.set("status"sv, "error"sv);
+        response.set("error"sv, error);
+        return send_response();
+    };
+
+    auto send_verdict = [&](Optional<ByteString> const& verdict, Optional<u64> rules_version = {}) -> ErrorOr<void> {
+        response.set("status"sv, "success"sv);
+        if (rules_version.has_value())
+            response.set("rules_version"sv, String::number(*rules_version));
+        if (!verdict.has_value()) {
+            response.set("result"sv, "clean"sv);
+            return send_response();
+        }
+        auto result_string = String::from_utf8(verdict->view());
+        if (result_string.is_error())
+            return send_error("Scan result contains invalid UTF-8"sv);
+        response.set("result"sv, result_string.release_value());
+        return send_response();
+    };
+
+    if (auto validation = ScanProtocol::validate_stream_message(header, payload); validation.is_error())
+        return send_error(validation.error().string_literal());
+
+    auto& client_streams = m_stream_sessions.ensure(&socket);
+    auto session_it = client_streams.find(stream_id);
+
+    if (has_flag(ScanProtocol::flags_of(header), ScanProtocol::ScanFlags::StreamEnd)) {
+        if (session_it == client_streams.end())
+            return send_verdict({});
+
+        auto session = client_streams.take(stream_id).release_value();
+        m_rate_limiter.release_scan_slot(client_id);
+
+        dbgln("Sentinel: Stream {} finished after {} chunks ({}KB, peak window {}KB)",
+            stream_id, session->chunks_scanned(), session->bytes_received() / 1024, session->peak_window_size() / 1024);
+
+        // Only the final verdict covers the whole body, so only it carries the version clients cache it under
+        if (!session->has_threat())
+            return send_verdict(classify_finished_stream(*session), session->rules_version());
+        return send_verdict(session->verdict(), session->rules_version());
+    }
+
+    if (session_it == client_streams.end()) {
+        // A new stream counts as one scan request and holds one concurrent scan slot until it ends
+        if (client_streams.size() >= MAX_STREAMS_PER_CLIENT)
+            return send_error("Too many concurrent streaming scans"sv);
+
+        if (m_rate_limiter.check_scan_request(client_id).is_error()) {
+            dbgln("Sentinel: Rate limit exceeded for client {} (stream scan)", client_id);
+            return send_error("Rate limit exceeded. Too many scan requests. Please try again later."sv);
+        }
+
+        if (m_rate_limiter.check_concurrent_scans(client_id).is_error()) {
+            dbgln("Sentinel: Concurrent scan limit exceeded for client {}", client_id);
+            return send_error("Concurrent scan limit exceeded. Please wait for ongoing scans to complete."sv);
+        }
+
+        client_streams.set(stream_id, make<StreamingScanSession>());
+        session_it = client_streams.find(stream_id);
+    }
+
+    auto& session = *session_it->value;
+
+    // Early verdict: once a chunk matched, the client is expected to abort; do not keep scanning
+    if (session.has_threat())
+        return send_verdict(session.verdict());
+
+    auto window = session.prepare_window(payload);
+    if (window.is_error())
+        return send_error("Failed to allocate stream scan window"sv);
+
+    auto verdict = scan_stream_window(session, window.value());
+    session.advance();
+    if (verdict.is_error())
+        return send_error(verdict.error().string_literal());
+
+    if (verdict.value().has_value()) {
+        dbgln("Sentinel: Stream {} matched after {}KB", stream_id, session.bytes_received() / 1024);
+        session.set_verdict(verdict.release_value().release_value());
+    }
+
+    return send_verdict(session.verdict());
+}
+
+void SentinelServer::drop_stream_sessions(Core::Socket* socket)
+{
+    auto it = m_stream_sessions.find(socket);
+    if (it == m_stream_sessions.end())
+        return;
+
+    auto client_id = get_client_id(socket);
+    for (size_t i = 0; i < it->value.size(); ++i)
+        m_rate_limiter.release_scan_slot(client_id);
+    m_stream_sessions.remove(it);
+}
+
 static ErrorOr<ByteString> validate_scan_path(StringView file_path)
 {
     // Resolve canonical path to prevent directory traversal
@@ -488,7 +770,7 @@ static ErrorOr<ByteString> validate_scan_path(StringView file_path)
     return canonical;
 }
 
-ErrorOr<ByteString> SentinelServer::scan_file(ByteString const& file_path)
+ErrorOr<NonnullOwnPtr<ByteBuffer>> SentinelServer::read_file_to_scan(ByteString const& file_path)
 {
     // Validate and canonicalize the file path for security
     auto validated_path = TRY(validate_scan_path(file_path));
@@ -501,66 +783,49 @@ ErrorOr<ByteString> SentinelServer::scan_file(ByteString const& file_path)
 
     // Read file content using validated path
     auto file = TRY(Core::File::open(validated_path, Core::File::OpenMode::Read));
-    auto content = TRY(file->read_until_eof());
-
-    return scan_content(content.bytes());
+    // Heap-allocated, so the bytes being scanned stay put while the buffer is moved into the scan's callback
+    return make<ByteBuffer>(TRY(file->read_until_eof()));
 }
 
-struct YaraMatchData {
-    Vector<ByteString> rule_names;
-    Vector<JsonObject> rule_details;
-};
-
-static int yara_callback([[maybe_unused]] YR_SCAN_CONTEXT* context, int message, void* message_data, void* user_data)
+void SentinelServer::scan_content_async(Core::Socket& socket, int client_id, JsonObject response, NonnullOwnPtr<ByteBuffer> content)
 {
-    if (message == CALLBACK_MSG_RULE_MATCHING) {
-        auto* rule = static_cast<YR_RULE*>(message_data);
-        auto* match_data = static_cast<YaraMatchData*>(user_data);
-
-        match_data->rule_names.append(ByteString(rule->identifier));
-
-        // Extract rule metadata
-        JsonObject rule_obj;
-        rule_obj.set("rule_name"sv, JsonValue(StringView { rule->identifier, strlen(rule->identifier) }));
-
-        // Get metadata with safety limit to prevent infinite loops
-        YR_META* meta = rule->metas;
-        constexpr int MAX_METADATA_ENTRIES = 100; // Safety limit
-        int meta_count = 0;
-
-        while (!META_IS_LAST_IN_RULE(meta) && meta_count < MAX_METADATA_ENTRIES) {
-            if (meta->type == META_TYPE_STRING) {
-                if (strcmp(meta->identifier, "description") == 0)
-                    rule_obj.set("description"sv, JsonValue(StringView { meta->string, strlen(meta->string) }));
-                else if (strcmp(meta->identifier, "severity") == 0)
-                    rule_obj.set("severity"sv, JsonValue(StringView { meta->string, strlen(meta->string) }));
-                else if (strcmp(meta->identifier, "author") == 0)
-                    rule_obj.set("author"sv, JsonValue(StringView { meta->string, strlen(meta->string) }));
-            }
-            meta++;
-            meta_count++;
-        }
+    auto bytes = content->bytes();
+    auto scan_start = MonotonicTime::now();
+    m_yara_engine->scan_async(bytes, [this, socket = &socket, client_id, response = move(response), content = move(content), scan_start](ErrorOr<YARAScanResult> yara_result) mutable {
+        m_rate_limiter.release_scan_slot(client_id);
+
+        // The client may have disconnected while its scan was running
+        if (!is_client_connected(socket, client_id))
+            return;
 
-        // Handle the last metadata entry (only if we didn't hit the safety limit)
-        if (meta_count < MAX_METADATA_ENTRIES && meta->type == META_TYPE_STRING) {
-            if (strcmp(meta->identifier, "description") == 0)
-                rule_obj.set("description"sv, JsonValue(StringView { meta->string, strlen(meta->string) }));
-            else if (strcmp(meta->identifier, "severity") == 0)
-                rule_obj.set("severity"sv, JsonValue(StringView { meta->string, strlen(meta->string) }));
-            else if (strcmp(meta->identifier, "author") == 0)
-                rule_obj.set("author"sv, JsonValue(StringView { meta->string, strlen(meta->string) }));
+        if (yara_result.is_error()) {
+            response.set("status"sv, "error"sv);
+            response.set("error"sv, yara_result.error().string_literal());
+        } else {
+            auto verdict = build_scan_verdict(content->bytes(), yara_result.value());
+            MetricsCollector::the().record_download_scan(MonotonicTime::now() - scan_start);
+            // Convert scan result to UTF-8 string - handle errors gracefully
+            auto result_string = String::from_utf8(verdict.view());
+            if (result_string.is_error()) {
+                response.set("status"sv, "error"sv);
+                response.set("error"sv, "Scan result contains invalid UTF-8"sv);
+            } else {
+                response.set("status"sv, "success"sv);
+                response.set("result"sv, result_string.release_value());
+                response.set("rules_version"sv, String::number(yara_result.value().rules_version));
+            }
         }
 
-        match_data->rule_details.append(move(rule_obj));
-    }
-    return CALLBACK_CONTINUE;
+        auto response_str = response.serialized();
+        IPC::BufferedIPCWriter writer;
+        if (auto result = writer.write_message(*socket, response_str.bytes_as_string_view()); result.is_error())
+            dbgln("Sentinel: Failed to send scan result: {}", result.error());
+    },
+        client_id);
 }
 
-ErrorOr<ByteString> SentinelServer::scan_content(ReadonlyBytes content)
+ByteString SentinelServer::build_scan_verdict(ReadonlyBytes content, YARAScanResult const& yara_result)
 {
-    if (!s_yara_rules)
-        return Error::from_string_literal("YARA rules not initialized");
-
     // Check bloom filter first for quick threat detection (Milestone 0.4 Phase 3)
     bool bloom_filter_hit = false;
     if (m_threat_feed) {
@@ -570,136 +835,19 @@ ErrorOr<ByteString> SentinelServer::scan_content(ReadonlyBytes content)
         }
     }
 
-    // For large files (> 10MB), use streaming scan to reduce memory pressure
-    constexpr size_t STREAMING_THRESHOLD = 10 * 1024 * 1024; // 10MB
-    constexpr size_t CHUNK_SIZE = 1 * 1024 * 1024; // 1MB chunks
-
-    if (content.size() > STREAMING_THRESHOLD) {
-        dbgln("SentinelServer: Using streaming scan for large file ({}MB)", content.size() / (1024 * 1024));
-
-        // Scan in chunks with overlap to catch patterns spanning chunk boundaries
-        constexpr size_t OVERLAP_SIZE = 4096; // 4KB overlap
-        YaraMatchData match_data;
-
-        size_t offset = 0;
-        while (offset < content.size()) {
-            size_t chunk_size = min(CHUNK_SIZE, content.size() - offset);
-            auto chunk = content.slice(offset, chunk_size);
+    bool yara_threat = yara_result.has_matches();
 
-            int result = yr_rules_scan_mem(
-                s_yara_rules,
-                reinterpret_cast<uint8_t const*>(chunk.data()),
-                chunk.size(),
-                0,
-                yara_callback,
-                &match_data,
-                0);
-
-            if (result != ERROR_SUCCESS)
-                return Error::from_string_literal("YARA scan failed");
-
-            // If we found matches, we can stop early
-            if (!match_data.rule_names.is_empty())
-                break;
-
-            // Move to next chunk with overlap
-            if (offset + chunk_size >= content.size())
-                break;
-
-            offset += chunk_size - OVERLAP_SIZE;
-        }
-
-        bool yara_threat = !match_data.rule_names.is_empty();
-
-        // Run ML-based malware detection on full content (Milestone 0.4)
-        // For large files, we analyze the full content for ML to avoid false negatives
-        bool ml_threat = false;
-        Optional<MalwareMLDetector::Prediction> ml_prediction;
-
-        if (m_ml_detector) {
-            ByteBuffer content_buffer;
-            auto buffer_result = content_buffer.try_append(content);
-            if (!buffer_result.is_error()) {
-                auto prediction_result = m_ml_detector->analyze_file(content_buffer);
-                if (!prediction_result.is_error()) {
-                    ml_prediction = prediction_result.release_value();
-                    ml_threat = ml_prediction->malware_probability > 0.5f;
-                } else {
-                    dbgln("Sentinel: ML analysis failed (streaming): {}", prediction_result.error());
-                }
-            }
-        }
-
-        bool threat_detected = yara_threat || ml_threat || bloom_filter_hit;
-
-        if (!threat_detected)
-            return ByteString("clean"sv);
-
-        // Format matches as detailed JSON response
-        JsonObject result_obj;
-        result_obj.set("threat_detected"sv, true);
-
-        // YARA results
-        if (yara_threat) {
-            JsonArray matched_rules_array;
-            for (auto const& rule_detail : match_data.rule_details) {
-                matched_rules_array.must_append(rule_detail);
-            }
-            result_obj.set("matched_rules"sv, move(matched_rules_array));
-            result_obj.set("match_count"sv, static_cast<i64>(match_data.rule_names.size()));
-        }
-
-        // ML results
-        if (ml_prediction.has_value()) {
-            JsonObject ml_obj;
-            ml_obj.set("malware_probability"sv, static_cast<double>(ml_prediction->malware_probability));
-            ml_obj.set("confidence"sv, static_cast<double>(ml_prediction->confidence));
-            ml_obj.set("explanation"sv, ml_prediction->explanation.bytes_as_string_view());
-            result_obj.set("ml_prediction"sv, move(ml_obj));
-        }
-
-        // Bloom filter results
-        if (bloom_filter_hit) {
-            result_obj.set("bloom_filter_hit"sv, true);
-            result_obj.set("known_threat"sv, "File hash matches federated threat database"sv);
-        }
-
-        auto json_string = result_obj.serialized();
-        return ByteString(json_string.bytes_as_string_view());
-    }
-
-    // For smaller files, scan entire content at once (original behavior)
-    YaraMatchData match_data;
-    int result = yr_rules_scan_mem(
-        s_yara_rules,
-        reinterpret_cast<uint8_t const*>(content.data()),
-        content.size(),
-        0,
-        yara_callback,
-        &match_data,
-        0);
-
-    if (result != ERROR_SUCCESS)
-        return Error::from_string_literal("YARA scan failed");
-
-    bool yara_threat = !match_data.rule_names.is_empty();
-
-    // Run ML-based malware detection (Milestone 0.4)
+    // Run ML-based malware detection on the full content (Milestone 0.4)
     bool ml_threat = false;
     Optional<MalwareMLDetector::Prediction> ml_prediction;
 
     if (m_ml_detector) {
-        ByteBuffer content_buffer;
-        // Try to create ByteBuffer from content - if it fails, skip ML analysis
-        auto buffer_result = content_buffer.try_append(content);
-        if (!buffer_result.is_error()) {
-            auto prediction_result = m_ml_detector->analyze_file(content_buffer);
-            if (!prediction_result.is_error()) {
-                ml_prediction = prediction_result.release_value();
-                ml_threat = ml_prediction->malware_probability > 0.5f;
-            } else {
-                dbgln("Sentinel: ML analysis failed: {}", prediction_result.error());
-            }
+        auto prediction_result = m_ml_detector->analyze_file(content);
+        if (!prediction_result.is_error()) {
+            ml_prediction = prediction_result.release_value();
+            ml_threat = ml_prediction->malware_probability > 0.5f;
+        } else {
+            dbgln("Sentinel: ML analysis failed: {}", prediction_result.error());
         }
     }
 
@@ -716,11 +864,11 @@ ErrorOr<ByteString> SentinelServer::scan_content(ReadonlyBytes content)
     // YARA results
     if (yara_threat) {
         JsonArray matched_rules_array;
-        for (auto const& rule_detail : match_data.rule_details) {
+        for (auto const& rule_detail : yara_result.rule_details) {
             matched_rules_array.must_append(rule_detail);
         }
         result_obj.set("matched_rules"sv, move(matched_rules_array));
-        result_obj.set("match_count"sv, static_cast<i64>(match_data.rule_names.size()));
+        result_obj.set("match_count"sv, static_cast<i64>(yara_result.rule_names.size()));
     }
 
     // ML results
@@ -742,6 +890,101 @@ ErrorOr<ByteString> SentinelServer::scan_content(ReadonlyBytes content)
     return ByteString(json_string.bytes_as_string_view());
 }
 
+ErrorOr<Optional<ByteString>> SentinelServer::scan_stream_window(StreamingScanSession& session, ReadonlyBytes window)
+{
+    auto yara_result = TRY(m_yara_engine->scan(window));
+    session.record_rules_version(yara_result.rules_version);
+    if (!yara_result.has_matches())
+        return Optional<ByteString> {};
+
+    // NB: Per-chunk verdicts are YARA-only. ML runs once the stream ends, on features accumulated
+    //     from every chunk, and the bloom filter check needs the whole file.
+    JsonObject result_obj;
+    result_obj.set("threat_detected"sv, true);
+    result_obj.set("streamed"sv, true);
+
+    JsonArray matched_rules_array;
+    for (auto const& rule_detail : yara_result.rule_details)
+        matched_rules_array.must_append(rule_detail);
+    result_obj.set("matched_rules"sv, move(matched_rules_array));
+    result_obj.set("match_count"sv, static_cast<i64>(yara_result.rule_names.size()));
+
+    auto json_string = result_obj.serialized();
+    return Optional<ByteString> { ByteString(json_string.bytes_as_string_view()) };
+}
+
+Optional<ByteString> SentinelServer::classify_finished_stream(StreamingScanSession const& session)
+{
+    if (!m_ml_detector)
+        return {};
+
+    auto prediction = m_ml_detector->predict(session.features());
+    if (prediction.is_error()) {
+        dbgln("Sentinel: ML analysis of stream failed: {}", prediction.error());
+        return {};
+    }
+    if (prediction.value().malware_probability <= 0.5f)
+        return {};
+
+    JsonObject result_obj;
+    result_obj.set("threat_detected"sv, true);
+    result_obj.set("streamed"sv, true);
+
+    JsonObject ml_obj;
+    ml_obj.set("malware_probability"sv, static_cast<double>(prediction.value().malware_probability));
+    ml_obj.set("confidence"sv, static_cast<double>(prediction.value().confidence));
+    ml_obj.set("explanation"sv, prediction.value().explanation.bytes_as_string_view());
+    result_obj.set("ml_prediction"sv, move(ml_obj));
+
+    auto json_string = result_obj.serialized();
+    return ByteString(json_string.bytes_as_string_view());
+}
+
+ErrorOr<void> SentinelServer::reload_yara_rules()
+{
+    // Compile first: a broken rule file leaves the active rules untouched
+    TRY(m_yara_engine->load_rules_from_files(m_rule_files));
+    dbgln("Sentinel: Reloaded YARA rules from {} files (rules version {:016x})", m_rule_files.size(), m_yara_engine->rules_version());
+    notify_rules_version_changed();
+    return {};
+}
+
+ErrorOr<void> SentinelServer::add_rule_file(ByteString path)
+{
+    if (m_rule_files.contains_slow(path))
+        return reload_yara_rules();
+
+    m_rule_files.append(move(path));
+    if (auto result = reload_yara_rules(); result.is_error()) {
+        m_rule_files.take_last();
+        return result.release_error();
+    }
+    return {};
+}
+
+ErrorOr<void> SentinelServer::update_rule_fragments(Vector<ByteString> const& paths)
+{
+    TRY(m_yara_engine->update_rule_fragments(paths));
+    dbgln("Sentinel: Updated YARA rule fragments (rules version {:016x})", m_yara_engine->rules_version());
+    notify_rules_version_changed();
+    return {};
+}
+
+void SentinelServer::notify_rules_version_changed()
+{
+    // NB: This is not a response to anything, so it has no request_id; clients recognize it by its "event".
+    JsonObject event;
+    event.set("event"sv, "rules_version_changed"sv);
+    event.set("rules_version"sv, String::number(m_yara_engine->rules_version()));
+    auto event_json = event.serialized();
+
+    for (auto* subscriber : m_rules_version_subscribers) {
+        IPC::BufferedIPCWriter writer;
+        if (auto result = writer.write_message(*subscriber, event_json.bytes_as_string_view()); result.is_error())
+            dbgln("Sentinel: Failed to notify client of new rules version: {}", result.error());
+    }
+}
+
 void SentinelServer::initialize_health_checks(PolicyGraph* policy_graph)
 {
     dbgln("Sentinel: Initializing health check system");
@@ -9,15 +9,20 @@
 #include "ClientRateLimiter.h"
 #include "HealthCheck.h"
 #include "MalwareML.h"
+#include "ScanProtocol.h"
+#include "StreamingScanSession.h"
 #include "ThreatFeed.h"
+#include "YARAScanEngine.h"
 #include <AK/Error.h>
 #include <AK/HashMap.h>
+#include <AK/HashTable.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/Vector.h>
 #include <LibCore/CircuitBreaker.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/LocalServer.h>
 #include <LibCore/Socket.h>
+#include <LibCore/Timer.h>
 #include <LibIPC/BufferedIPCReader.h>
 
 namespace Sentinel {
@@ -43,26 +48,81 @@ public:
     // Get number of active connections
     size_t active_connection_count() const { return m_clients.size(); }
 
+    // Recompile the active rule files and hot-swap them in; scans already running keep the old rules
+    ErrorOr<void> reload_yara_rules();
+
+    // Add a rule file (e.g. one written by ThreatIntelligence::YARAGenerator) to the active rule set
+    ErrorOr<void> add_rule_file(ByteString path);
+
+    // Swap in the rule fragments written by ThreatIntelligence::YARAGenerator::generate_rule_fragments(); only
+    // fragments that changed since the last update are recompiled
+    ErrorOr<void> update_rule_fragments(Vector<ByteString> const& paths);
+
     // Circuit breaker metrics
     Core::CircuitBreaker::Metrics get_yara_circuit_breaker_metrics() const { return m_yara_circuit_breaker.get_metrics(); }
 
 private:
     SentinelServer(NonnullRefPtr<Core::LocalServer>);
 
-    void handle_client(NonnullOwnPtr<Core::Socket>);
+    // Per-client state for reading messages off the socket
+    struct ClientReader {
+        IPC::BufferedIPCReader reader;
+
+        // A shared buffer scan header whose descriptor hasn't arrived yet. Nothing else is read from the socket until
+        // it has, as the descriptor is sent right after the header.
+        Optional<ScanProtocol::SharedBufferScanHeader> header_awaiting_fd;
+        RefPtr<Core::Timer> fd_timeout_timer;
+    };
+
+    void handle_client(NonnullOwnPtr<Core::LocalSocket>);
     ErrorOr<void> process_message(Core::Socket&, String const& message);
 
-    ErrorOr<ByteString> scan_file(ByteString const& file_path);
-    ErrorOr<ByteString> scan_content(ReadonlyBytes content);
+    // Receive the descriptor for the header awaiting one and start its scan, or leave it waiting for the socket to
+    // become readable again. Only the client that has yet to send its descriptor is held up.
+    void receive_shared_buffer_scan_fd(Core::LocalSocket&, ClientReader&);
+    ErrorOr<void> process_shared_buffer_scan(Core::LocalSocket&, ScanProtocol::SharedBufferScanHeader const&, int fd);
+    ErrorOr<void> process_stream_scan_message(Core::LocalSocket&, ScanProtocol::SharedBufferScanHeader const&, ReadonlyBytes payload);
+    void drop_stream_sessions(Core::Socket*);
+    void disconnect_client(Core::Socket*);
+
+    // Whether the client the socket was connected to when a request came in is still connected. Socket addresses may
+    // be reused by later connections, but client IDs never are.
+    bool is_client_connected(Core::Socket*, int client_id) const;
+
+    // Only the user Sentinel runs as, or root, may manage Sentinel itself, e.g. by reloading its rules
+    static bool is_privileged_peer(Core::LocalSocket const&);
+
+    // Read a file a client asked to scan, once it's been checked to be one clients may have scanned
+    ErrorOr<NonnullOwnPtr<ByteBuffer>> read_file_to_scan(ByteString const& file_path);
+
+    // Scan on a scan worker and send `response` with the verdict once done, holding the client's concurrent scan
+    // slot until then. The connection keeps being served in the meantime, so responses go out as their requests
+    // finish and clients match them up by request_id.
+    void scan_content_async(Core::Socket&, int client_id, JsonObject response, NonnullOwnPtr<ByteBuffer> content);
+
+    // Combine a YARA result with the bloom filter and ML checks into the verdict sent to clients
+    ByteString build_scan_verdict(ReadonlyBytes content, YARAScanResult const&);
+
+    // YARA-only scan of one streaming window; returns the match JSON, or an empty Optional if clean
+    ErrorOr<Optional<ByteString>> scan_stream_window(StreamingScanSession&, ReadonlyBytes window);
+
+    // Tell subscribed clients (RequestServers with a verdict cache) that cached verdicts no longer apply
+    void notify_rules_version_changed();
+    Optional<ByteString> classify_finished_stream(StreamingScanSession const&);
 
     // Get client ID for rate limiting
     int get_client_id(Core::Socket const* socket);
+    Optional<int> find_client_id(Core::Socket const* socket) const;
 
     NonnullRefPtr<Core::LocalServer> m_server;
-    Vector<NonnullOwnPtr<Core::Socket>> m_clients;
+    Vector<NonnullOwnPtr<Core::LocalSocket>> m_clients;
 
     // Per-client buffered readers for handling partial IPC messages
-    HashMap<Core::Socket*, IPC::BufferedIPCReader> m_client_readers;
+    HashMap<Core::Socket*, ClientReader> m_client_readers;
+
+    // Per-client streaming scans, keyed by the stream ID chosen by the client
+    HashMap<Core::Socket*, HashMap<u64, NonnullOwnPtr<StreamingScanSession>>> m_stream_sessions;
+    static constexpr size_t MAX_STREAMS_PER_CLIENT = 16;
 
     // Per-client rate limiter (DoS protection)
     ClientRateLimiter m_rate_limiter;
@@ -71,9 +131,19 @@ private:
     HashMap<Core::Socket const*, int> m_socket_to_client_id;
     int m_next_client_id { 1 };
 
+    // Clients connected from privileged peers
+    HashTable<int> m_privileged_client_ids;
+
+    // Clients that asked to be told whenever the rules version changes
+    HashTable<Core::Socket*> m_rules_version_subscribers;
+
     // Health check system
     HealthCheck m_health_check;
 
+    // YARA rules and scan workers, and the rule files compiled into the active rule set
+    OwnPtr<YARAScanEngine> m_yara_engine;
+    Vector<ByteString> m_rule_files;
+
     // Circuit breaker for YARA scanning operations
     // Prevents cascade failures when YARA scanner crashes or hangs
     mutable Core::CircuitBreaker m_yara_circuit_breaker { Core::CircuitBreakerPresets::yara_scanner("SentinelServer::YARA"sv) };
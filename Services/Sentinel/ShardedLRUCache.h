@@ -0,0 +1,422 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/Atomic.h>
+#include <AK/Error.h>
+#include <AK/HashFunctions.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NumericLimits.h>
+#include <AK/Optional.h>
+#include <AK/Vector.h>
+#include <LibSync/Mutex.h>
+#include "LRUCache.h"
+
+namespace Sentinel {
+
+// LRU cache with the same API as LRUCache, backed by a slab of nodes allocated up front.
+//
+// Nodes live in one contiguous Vector and link to each other by index, and the key index is sized
+// for the full capacity at construction, so steady-state get()/put() never allocate, and recency
+// updates touch a dense array rather than chasing heap pointers. Evicted and removed nodes are
+// reused through a free list.
+//
+// Key and Value must be default-constructible; idle nodes hold default values. Not thread-safe;
+// see ShardedLRUCache for concurrent use.
+template<typename Key, typename Value>
+class SlabLRUCache {
+public:
+    using CacheMetrics = LRUCacheMetrics;
+
+    explicit SlabLRUCache(size_t capacity = 1000);
+
+    SlabLRUCache(SlabLRUCache const&) = delete;
+    SlabLRUCache& operator=(SlabLRUCache const&) = delete;
+    SlabLRUCache(SlabLRUCache&&) = default;
+    SlabLRUCache& operator=(SlabLRUCache&&) = default;
+
+    // Get value from cache, returns empty Optional on miss
+    // On hit, moves entry to front (most recently used)
+    Optional<Value> get(Key const& key);
+
+    // Put key-value pair into cache
+    // If cache is full, the least recently used entry's node is reused
+    ErrorOr<void> put(Key const& key, Value const& value);
+
+    // Value stored for key, created default-constructed when missing (reusing the least recently
+    // used node if the cache is full). Moves the entry to the front either way.
+    // The pointer is invalidated by the next call that inserts or removes entries.
+    ErrorOr<Value*> ensure(Key const& key);
+
+    // Value stored for key without counting a hit or miss or changing its recency, or null
+    Value* peek(Key const& key);
+
+    // Drop a single entry; returns whether it was present
+    bool remove(Key const& key);
+
+    // Drop entries from the least recently used end for as long as predicate(key, value) holds,
+    // returning how many were dropped
+    template<typename Predicate>
+    size_t remove_least_recent_while(Predicate predicate);
+
+    // Clear all entries, keeping the slab and the key index allocated
+    void clear();
+
+    void invalidate()
+    {
+        clear();
+        m_cache_invalidations++;
+    }
+
+    CacheMetrics get_metrics() const
+    {
+        return CacheMetrics {
+            .hits = m_cache_hits,
+            .misses = m_cache_misses,
+            .evictions = m_cache_evictions,
+            .invalidations = m_cache_invalidations,
+            .current_size = m_size,
+            .max_size = m_capacity
+        };
+    }
+
+    void reset_metrics()
+    {
+        m_cache_hits = 0;
+        m_cache_misses = 0;
+        m_cache_evictions = 0;
+        m_cache_invalidations = 0;
+    }
+
+    size_t size() const { return m_size; }
+    size_t capacity() const { return m_capacity; }
+    bool is_empty() const { return m_size == 0; }
+    bool is_full() const { return m_size >= m_capacity; }
+
+private:
+    static constexpr u32 NO_NODE = NumericLimits<u32>::max();
+
+    struct Node {
+        Key key {};
+        Value value {};
+        u32 prev { NO_NODE };
+        u32 next { NO_NODE };
+    };
+
+    void unlink(u32 index);
+    void link_front(u32 index);
+
+    // Return a node to the free list, dropping its key and value
+    void release(u32 index);
+
+    Vector<Node> m_nodes;
+    HashMap<Key, u32> m_index;
+    u32 m_head { NO_NODE }; // Most recently used
+    u32 m_tail { NO_NODE }; // Least recently used
+    u32 m_free_head { NO_NODE };
+    size_t m_capacity { 0 };
+    size_t m_size { 0 };
+
+    // Metrics
+    size_t m_cache_hits { 0 };
+    size_t m_cache_misses { 0 };
+    size_t m_cache_evictions { 0 };
+    size_t m_cache_invalidations { 0 };
+};
+
+// SlabLRUCache split into independently locked shards for concurrent access.
+//
+// Keys are spread across shards by hash, and each shard is its own LRU of capacity / ShardCount
+// entries, so threads touching different keys rarely contend. Recency is tracked per shard, which
+// approximates a global LRU closely once the cache holds more than a few entries per shard.
+template<typename Key, typename Value, size_t ShardCount = 16>
+class ShardedLRUCache {
+    static_assert(ShardCount > 0);
+
+public:
+    using CacheMetrics = LRUCacheMetrics;
+
+    explicit ShardedLRUCache(size_t capacity = 1000)
+        : m_capacity(capacity)
+    {
+        auto shard_capacity = max<size_t>(1, ceil_div(capacity, ShardCount));
+        m_shards.ensure_capacity(ShardCount);
+        for (size_t i = 0; i < ShardCount; ++i)
+            m_shards.unchecked_append(make<Shard>(shard_capacity));
+    }
+
+    Optional<Value> get(Key const& key)
+    {
+        auto& shard = shard_for(key);
+        Sync::MutexLocker locker(shard.mutex);
+        return shard.cache.get(key);
+    }
+
+    ErrorOr<void> put(Key const& key, Value const& value)
+    {
+        auto& shard = shard_for(key);
+        Sync::MutexLocker locker(shard.mutex);
+        return shard.cache.put(key, value);
+    }
+
+    bool remove(Key const& key)
+    {
+        auto& shard = shard_for(key);
+        Sync::MutexLocker locker(shard.mutex);
+        return shard.cache.remove(key);
+    }
+
+    void clear()
+    {
+        for (auto& shard : m_shards) {
+            Sync::MutexLocker locker(shard->mutex);
+            shard->cache.clear();
+        }
+    }
+
+    void invalidate()
+    {
+        clear();
+        m_cache_invalidations.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+    }
+
+    CacheMetrics get_metrics() const
+    {
+        CacheMetrics metrics;
+        for (auto const& shard : m_shards) {
+            Sync::MutexLocker locker(shard->mutex);
+            auto shard_metrics = shard->cache.get_metrics();
+            metrics.hits += shard_metrics.hits;
+            metrics.misses += shard_metrics.misses;
+            metrics.evictions += shard_metrics.evictions;
+            metrics.current_size += shard_metrics.current_size;
+        }
+        metrics.invalidations = m_cache_invalidations.load(AK::MemoryOrder::memory_order_relaxed);
+        metrics.max_size = m_capacity;
+        return metrics;
+    }
+
+    void reset_metrics()
+    {
+        for (auto& shard : m_shards) {
+            Sync::MutexLocker locker(shard->mutex);
+            shard->cache.reset_metrics();
+        }
+        m_cache_invalidations.store(0, AK::MemoryOrder::memory_order_relaxed);
+    }
+
+    size_t size() const { return get_metrics().current_size; }
+    size_t capacity() const { return m_capacity; }
+    bool is_empty() const { return size() == 0; }
+
+    static constexpr size_t shard_count() { return ShardCount; }
+
+private:
+    struct Shard {
+        explicit Shard(size_t capacity)
+            : cache(capacity)
+        {
+        }
+
+        mutable Sync::Mutex mutex;
+        SlabLRUCache<Key, Value> cache;
+    };
+
+    Shard& shard_for(Key const& key)
+    {
+        // Rehash so shard selection does not correlate with bucket selection inside the shard
+        return *m_shards[u32_hash(Traits<Key>::hash(key)) % ShardCount];
+    }
+
+    Vector<NonnullOwnPtr<Shard>, ShardCount> m_shards;
+    size_t m_capacity { 0 };
+    Atomic<size_t> m_cache_invalidations { 0 };
+};
+
+// Implementation
+
+template<typename Key, typename Value>
+SlabLRUCache<Key, Value>::SlabLRUCache(size_t capacity)
+    : m_capacity(max<size_t>(capacity, 1))
+{
+    VERIFY(m_capacity < NO_NODE);
+
+    m_nodes.resize(m_capacity);
+    m_index.ensure_capacity(m_capacity);
+
+    // Thread every node onto the free list
+    for (u32 i = 0; i < m_capacity; ++i)
+        m_nodes[i].next = i + 1 < m_capacity ? i + 1 : NO_NODE;
+    m_free_head = 0;
+}
+
+template<typename Key, typename Value>
+Optional<Value> SlabLRUCache<Key, Value>::get(Key const& key)
+{
+    auto it = m_index.find(key);
+    if (it == m_index.end()) {
+        m_cache_misses++;
+        return {};
+    }
+
+    m_cache_hits++;
+
+    auto index = it->value;
+    if (index != m_head) {
+        unlink(index);
+        link_front(index);
+    }
+    return m_nodes[index].value;
+}
+
+template<typename Key, typename Value>
+ErrorOr<void> SlabLRUCache<Key, Value>::put(Key const& key, Value const& value)
+{
+    *TRY(ensure(key)) = value;
+    return {};
+}
+
+template<typename Key, typename Value>
+ErrorOr<Value*> SlabLRUCache<Key, Value>::ensure(Key const& key)
+{
+    if (auto it = m_index.find(key); it != m_index.end()) {
+        auto index = it->value;
+        if (index != m_head) {
+            unlink(index);
+            link_front(index);
+        }
+        return &m_nodes[index].value;
+    }
+
+    u32 index = m_free_head;
+    if (index != NO_NODE) {
+        m_free_head = m_nodes[index].next;
+    } else {
+        // Reuse the least recently used node
+        index = m_tail;
+        m_index.remove(m_nodes[index].key);
+        unlink(index);
+        m_nodes[index].value = Value {};
+        m_size--;
+        m_cache_evictions++;
+    }
+
+    // The index was sized for the full capacity, so this only fails if that reservation did
+    if (auto result = m_index.try_set(key, index); result.is_error()) {
+        release(index);
+        return result.release_error();
+    }
+
+    auto& node = m_nodes[index];
+    node.key = key;
+    link_front(index);
+    m_size++;
+    return &node.value;
+}
+
+template<typename Key, typename Value>
+Value* SlabLRUCache<Key, Value>::peek(Key const& key)
+{
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+        return nullptr;
+    return &m_nodes[it->value].value;
+}
+
+template<typename Key, typename Value>
+bool SlabLRUCache<Key, Value>::remove(Key const& key)
+{
+    auto it = m_index.find(key);
+    if (it == m_index.end())
+        return false;
+
+    auto index = it->value;
+    m_index.remove(it);
+    unlink(index);
+    release(index);
+    m_size--;
+    return true;
+}
+
+template<typename Key, typename Value>
+template<typename Predicate>
+size_t SlabLRUCache<Key, Value>::remove_least_recent_while(Predicate predicate)
+{
+    size_t removed = 0;
+    while (m_tail != NO_NODE && predicate(m_nodes[m_tail].key, m_nodes[m_tail].value)) {
+        auto index = m_tail;
+        m_index.remove(m_nodes[index].key);
+        unlink(index);
+        release(index);
+        m_size--;
+        removed++;
+    }
+    return removed;
+}
+
+template<typename Key, typename Value>
+void SlabLRUCache<Key, Value>::clear()
+{
+    for (auto index = m_head; index != NO_NODE;) {
+        auto next = m_nodes[index].next;
+        release(index);
+        index = next;
+    }
+
+    m_index.clear_with_capacity();
+    m_head = NO_NODE;
+    m_tail = NO_NODE;
+    m_size = 0;
+}
+
+template<typename Key, typename Value>
+void SlabLRUCache<Key, Value>::unlink(u32 index)
+{
+    auto& node = m_nodes[index];
+
+    if (node.prev != NO_NODE)
+        m_nodes[node.prev].next = node.next;
+    else
+        m_head = node.next;
+
+    if (node.next != NO_NODE)
+        m_nodes[node.next].prev = node.prev;
+    else
+        m_tail = node.prev;
+
+    node.prev = NO_NODE;
+    node.next = NO_NODE;
+}
+
+template<typename Key, typename Value>
+void SlabLRUCache<Key, Value>::link_front(u32 index)
+{
+    auto& node = m_nodes[index];
+    node.prev = NO_NODE;
+    node.next = m_head;
+
+    if (m_head != NO_NODE)
+        m_nodes[m_head].prev = index;
+    m_head = index;
+
+    if (m_tail == NO_NODE)
+        m_tail = index;
+}
+
+template<typename Key, typename Value>
+void SlabLRUCache<Key, Value>::release(u32 index)
+{
+    auto& node = m_nodes[index];
+    node.key = Key {};
+    node.value = Value {};
+    node.prev = NO_NODE;
+    node.next = m_free_head;
+    m_free_head = index;
+}
+
+}
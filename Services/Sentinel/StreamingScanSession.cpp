@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "StreamingScanSession.h"
+
+namespace Sentinel {
+
+StreamingScanSession::StreamingScanSession(size_t overlap_size)
+    : m_overlap_size(overlap_size)
+{
+}
+
+ErrorOr<ReadonlyBytes> StreamingScanSession::prepare_window(ReadonlyBytes chunk)
+{
+    // The buffer keeps its capacity across chunks, so steady-state streaming does not allocate
+    TRY(m_window.try_append(chunk));
+
+    // Only the new bytes: the overlap was already counted with the previous chunk
+    m_feature_extractor.update(chunk);
+
+    m_bytes_received += chunk.size();
+    ++m_chunks_scanned;
+    if (m_window.size() > m_peak_window_size)
+        m_peak_window_size = m_window.size();
+
+    return m_window.bytes();
+}
+
+void StreamingScanSession::advance()
+{
+    if (m_window.size() <= m_overlap_size)
+        return;
+
+    auto tail_offset = m_window.size() - m_overlap_size;
+    memmove(m_window.data(), m_window.data() + tail_offset, m_overlap_size);
+    m_window.trim(m_overlap_size, false);
+}
+
+}
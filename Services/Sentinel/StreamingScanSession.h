@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include "MalwareFeatureExtractor.h"
+#include "ScanProtocol.h"
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <AK/Optional.h>
+
+namespace Sentinel {
+
+// Per-stream state for incremental scanning of a download whose body arrives in chunks.
+//
+// Only the tail of the previous chunk is retained between calls, so memory use is bounded by
+// (chunk size + overlap) regardless of how large the download is. Each chunk is scanned together
+// with that tail so that a pattern straddling a chunk boundary is still matched, as long as it is
+// no longer than the overlap. ML features are accumulated from each chunk as it arrives, so they
+// cover the whole download once the stream ends.
+//
+// Usage:
+//   auto window = TRY(session.prepare_window(chunk));
+//   auto verdict = scan(window);
+//   session.advance();
+class StreamingScanSession {
+public:
+    explicit StreamingScanSession(size_t overlap_size = ScanProtocol::STREAM_OVERLAP_SIZE);
+
+    // Returns the bytes to scan for this chunk: the retained overlap followed by the chunk.
+    // The returned span stays valid until the next call to prepare_window() or advance().
+    ErrorOr<ReadonlyBytes> prepare_window(ReadonlyBytes chunk);
+
+    // Keeps the last overlap_size bytes of the current window for the next chunk.
+    void advance();
+
+    // Once a chunk matches, the verdict is sticky: later chunks are not scanned again.
+    void set_verdict(ByteString verdict) { m_verdict = move(verdict); }
+    Optional<ByteString> const& verdict() const { return m_verdict; }
+    bool has_threat() const { return m_verdict.has_value(); }
+
+    // Version of the YARA rules every chunk was scanned with; empty if the rules changed mid-stream, since a verdict
+    // mixing two rule sets must not be cached under either
+    void record_rules_version(u64 version)
+    {
+        if (!m_rules_version.has_value())
+            m_rules_version = version;
+        else if (*m_rules_version != version)
+            m_rules_changed = true;
+    }
+    Optional<u64> rules_version() const { return m_rules_changed ? Optional<u64> {} : m_rules_version; }
+
+    // Features of every chunk received so far
+    MalwareMLDetector::Features features() const { return m_feature_extractor.finish(); }
+
+    u64 bytes_received() const { return m_bytes_received; }
+    size_t chunks_scanned() const { return m_chunks_scanned; }
+    size_t peak_window_size() const { return m_peak_window_size; }
+
+private:
+    size_t m_overlap_size { 0 };
+    ByteBuffer m_window;
+    MalwareFeatureExtractor m_feature_extractor;
+    Optional<ByteString> m_verdict;
+    Optional<u64> m_rules_version;
+    bool m_rules_changed { false };
+    u64 m_bytes_received { 0 };
+    size_t m_chunks_scanned { 0 };
+    size_t m_peak_window_size { 0 };
+};
+
+}
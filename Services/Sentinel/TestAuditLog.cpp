@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "AuditLog.h"
+#include "AuditSegment.h"
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
+#include <LibCore/Directory.h>
+#include <LibCore/System.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+#include <unistd.h>
+
+using namespace Sentinel;
+
+static ByteString fresh_directory(StringView name)
+{
+    auto directory = ByteString::formatted("/tmp/audit_log_{}_{}", name, getpid());
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+    MUST(Core::System::mkdir(directory, 0700));
+    return directory;
+}
+
+static AuditEvent make_event(size_t producer, size_t sequence)
+{
+    AuditEvent event {
+        .type = AuditEventType::AccessDenied,
+        .timestamp = UnixDateTime::from_milliseconds_since_epoch(1'700'000'000'000 + static_cast<i64>(sequence)),
+        .user = "sentinel"_string,
+        .resource = MUST(String::formatted("https://example.com/{}/{}", producer, sequence)),
+        .action = "access"_string,
+        .result = "denied"_string,
+        .reason = "Blocked by policy"_string,
+        .metadata = {},
+    };
+    event.metadata.set("producer"_string, MUST(String::number(producer)));
+    event.metadata.set("sequence"_string, MUST(String::number(sequence)));
+    return event;
+}
+
+static Vector<AuditEvent> read_segment(ByteString const& path)
+{
+    Vector<AuditEvent> events;
+    auto reader = MUST(AuditSegmentReader::open(path));
+    while (auto event = MUST(reader->next_event()); event.has_value())
+        events.append(event.release_value());
+    return events;
+}
+
+static Vector<ByteString> segment_paths(ByteString const& directory)
+{
+    Vector<ByteString> paths;
+    MUST(Core::Directory::for_each_entry(directory, Core::DirIterator::SkipParentAndBaseDir, [&](auto const& entry, auto const&) -> ErrorOr<IterationDecision> {
+        if (entry.name.ends_with(".seg"sv))
+            paths.append(LexicalPath::join(directory, entry.name).string());
+        return IterationDecision::Continue;
+    }));
+
+    // Indices are zero-padded, so names sort in the order the segments were written
+    quick_sort(paths);
+    return paths;
+}
+
+static void expect_same_event(AuditEvent const& actual, AuditEvent const& expected)
+{
+    EXPECT_EQ(actual.type, expected.type);
+    EXPECT_EQ(actual.timestamp.milliseconds_since_epoch(), expected.timestamp.milliseconds_since_epoch());
+    EXPECT_EQ(actual.user, expected.user);
+    EXPECT_EQ(actual.resource, expected.resource);
+    EXPECT_EQ(actual.action, expected.action);
+    EXPECT_EQ(actual.result, expected.result);
+    EXPECT_EQ(actual.reason, expected.reason);
+    EXPECT_EQ(actual.metadata.size(), expected.metadata.size());
+    for (auto const& [key, value] : expected.metadata)
+        EXPECT_EQ(actual.metadata.get(key), value);
+}
+
+TEST_CASE(segments_round_trip)
+{
+    auto directory = fresh_directory("round_trip"sv);
+
+    for (auto compression : { AuditSegmentCompression::None, AuditSegmentCompression::Deflate }) {
+        auto path = ByteString::formatted("{}/audit.{}.seg", directory, to_underlying(compression));
+        auto writer = MUST(AuditSegmentWriter::create(path, compression));
+
+        for (size_t i = 0; i < 100; ++i) {
+            MUST(writer->append(make_event(0, i)));
+            if (i % 30 == 29)
+                MUST(writer->write_block());
+        }
+        MUST(writer->write_block());
+        MUST(writer->sync());
+
+        auto events = read_segment(path);
+        EXPECT_EQ(events.size(), 100u);
+        for (size_t i = 0; i < events.size(); ++i)
+            expect_same_event(events[i], make_event(0, i));
+
+        // Segments are never appended to after the fact
+        EXPECT(AuditSegmentWriter::create(path, compression).is_error());
+    }
+
+    MUST(FileSystem::remove(directory, FileSystem::RecursionMode::Allowed));
+}
+
+TEST_CASE(torn_block_ends_the_segment)
+{
+    auto directory = fresh_directory("torn"sv);
+    auto path = ByteString::formatted("{}/audit.seg", directory);
+
+    size_t first_block_end = 0;
+    {
+        auto writer = MUST(AuditSegmentWriter::create(path, AuditSegmentCompression::Deflate));
+        for (size_t i = 0; i < 10; ++i)
+            MUST(writer->append(make_event(0, i)));
+        MUST(writer->write_block());
+        first_block_end = writer->size();
+
+        for (size_t i = 10; i < 20; ++i)
+            MUST(writer->append(make_event(0, i)));
+        MUST(writer->write_block());
+    }
+
+    // As if the writer died in the middle of the second block
+    auto file = MUST(Core::File::open(path, Core::File::OpenMode::ReadWrite));
+    MUST(Core::System::ftruncate(file->fd(), static_cast<off_t>(first_block_end + 7)));
+    EXPECT_EQ(read_segment(path).size(), 10u);
+
+    MUST(FileSystem::remove(directory, FileSystem::RecursionMode::Allowed));
+}
+
+TEST_CASE(async_logger_writes_every_event)
+{
+    static constexpr size_t PRODUCER_COUNT = 4;
+    static constexpr size_t EVENTS_PER_PRODUCER = 500;
+
+    auto directory = fresh_directory("async"sv);
+    auto log_path = MUST(String::formatted("{}/audit.log", directory));
+
+    size_t queue_full_waits = 0;
+    {
+        auto logger = MUST(AuditLogger::create(log_path));
+
+        // A tiny queue makes producers outrun the writer
+        MUST(logger->set_write_mode(AuditLogger::WriteMode::Asynchronous, {
+            .queue_capacity = 8,
+            .flush_interval = AK::Duration::from_milliseconds(5),
+            .max_batch_size = 4,
+        }));
+        EXPECT_EQ(logger->write_mode(), AuditLogger::WriteMode::Asynchronous);
+
+        Vector<NonnullRefPtr<Threading::Thread>> producers;
+        for (size_t producer = 0; producer < PRODUCER_COUNT; ++producer) {
+            producers.append(MUST(Threading::Thread::try_create("AuditProducer"sv, [&logger, producer]() -> intptr_t {
+                for (size_t i = 0; i < EVENTS_PER_PRODUCER; ++i)
+                    MUST(logger->log_event(make_event(producer, i)));
+                return 0;
+            })));
+            producers.last()->start();
+        }
+        for (auto& producer : producers)
+            (void)producer->join();
+
+        MUST(logger->flush());
+        auto statistics = logger->get_statistics();
+        EXPECT_EQ(statistics.total_events_logged, PRODUCER_COUNT * EVENTS_PER_PRODUCER);
+        EXPECT_EQ(statistics.events_in_buffer, 0u);
+        queue_full_waits = statistics.queue_full_waits;
+    }
+    dbgln("Producers waited for the writer {} times", queue_full_waits);
+
+    // Every event is in the one segment, and each producer's events kept their order
+    auto paths = segment_paths(directory);
+    EXPECT_EQ(paths.size(), 1u);
+
+    Array<size_t, PRODUCER_COUNT> next_sequence {};
+    size_t total = 0;
+    for (auto const& path : paths) {
+        for (auto const& event : read_segment(path)) {
+            auto producer = event.metadata.get("producer"_string)->to_number<size_t>().value();
+            auto sequence = event.metadata.get("sequence"_string)->to_number<size_t>().value();
+            EXPECT_EQ(sequence, next_sequence[producer]);
+            next_sequence[producer] = sequence + 1;
+            total++;
+        }
+    }
+    EXPECT_EQ(total, PRODUCER_COUNT * EVENTS_PER_PRODUCER);
+
+    MUST(FileSystem::remove(directory, FileSystem::RecursionMode::Allowed));
+}
+
+TEST_CASE(segments_rotate_and_expire)
+{
+    auto directory = fresh_directory("rotate"sv);
+    auto log_path = MUST(String::formatted("{}/audit.log", directory));
+
+    {
+        auto logger = MUST(AuditLogger::create(log_path));
+        logger->set_max_file_size(2048);
+        logger->set_max_rotated_files(2);
+        MUST(logger->set_write_mode(AuditLogger::WriteMode::Asynchronous, {
+            .max_batch_size = 8,
+            .compression = AuditSegmentCompression::None,
+        }));
+
+        for (size_t i = 0; i < 400; ++i) {
+            MUST(logger->log_event(make_event(0, i)));
+            if (i % 8 == 7)
+                MUST(logger->flush());
+        }
+    }
+
+    // The segment being written plus the two before it
+    auto paths = segment_paths(directory);
+    EXPECT_EQ(paths.size(), 3u);
+    EXPECT(!paths.first().ends_with(".000001.seg"sv));
+
+    // The newest events are all there
+    auto newest = read_segment(paths.last());
+    VERIFY(!newest.is_empty());
+    EXPECT_EQ(newest.last().resource, make_event(0, 399).resource);
+
+    // A new logger carries on numbering where the old one stopped
+    {
+        auto logger = MUST(AuditLogger::create(log_path));
+        MUST(logger->set_write_mode(AuditLogger::WriteMode::Asynchronous));
+        MUST(logger->log_event(make_event(1, 0)));
+    }
+    auto reopened = segment_paths(directory);
+    EXPECT(reopened.last() > paths.last());
+
+    MUST(FileSystem::remove(directory, FileSystem::RecursionMode::Allowed));
+}
@@ -10,8 +10,10 @@
 #include "ThreatFeed.h"
 #include <AK/Random.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/File.h>
 #include <LibCore/System.h>
 #include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
 
 using namespace Sentinel;
 
@@ -160,6 +162,145 @@ TEST_CASE(bloom_filter_merge)
     EXPECT(bad_merge.is_error());
 }
 
+TEST_CASE(blocked_bloom_filter_operations)
+{
+    auto filter = MUST(BloomFilter::create_blocked(100000));
+    EXPECT(filter->layout() == BloomFilter::Layout::Blocked);
+    EXPECT_EQ(filter->size_bits() % BloomFilter::BLOCK_SIZE_BITS, 0u);
+    EXPECT_EQ(filter->num_hashes(), BloomFilter::BLOCKED_NUM_HASHES);
+
+    for (size_t i = 0; i < 1000; ++i)
+        filter->add(MUST(String::formatted("added_{}", i)));
+    for (size_t i = 0; i < 1000; ++i)
+        EXPECT(filter->contains(MUST(String::formatted("added_{}", i))));
+
+    size_t false_positives = 0;
+    for (size_t i = 0; i < 10000; ++i) {
+        if (filter->contains(MUST(String::formatted("not_added_{}", i))))
+            false_positives++;
+    }
+    EXPECT(false_positives < 100); // Less than 1%
+
+    // Every key sets BLOCKED_NUM_HASHES bits at most
+    EXPECT(filter->bits_set() <= 1000 * BloomFilter::BLOCKED_NUM_HASHES);
+
+    filter->clear();
+    EXPECT_EQ(filter->bits_set(), 0u);
+}
+
+TEST_CASE(blocked_bloom_filter_serialization_and_merge)
+{
+    auto filter1 = MUST(BloomFilter::create_blocked(50000));
+    auto filter2 = MUST(BloomFilter::create_blocked(50000));
+    for (size_t i = 0; i < 100; ++i) {
+        filter1->add(MUST(String::formatted("filter1_{}", i)));
+        filter2->add(MUST(String::formatted("filter2_{}", i)));
+    }
+
+    auto restored = MUST(BloomFilter::deserialize(MUST(filter1->serialize())));
+    EXPECT(restored->layout() == BloomFilter::Layout::Blocked);
+    EXPECT_EQ(restored->size_bits(), filter1->size_bits());
+    EXPECT_EQ(restored->bits_set(), filter1->bits_set());
+
+    MUST(restored->merge(*filter2));
+    for (size_t i = 0; i < 100; ++i) {
+        EXPECT(restored->contains(MUST(String::formatted("filter1_{}", i))));
+        EXPECT(restored->contains(MUST(String::formatted("filter2_{}", i))));
+    }
+
+    // Filters of different layouts cannot be merged, even at the same size
+    auto standard = MUST(BloomFilter::create(filter1->size_bits(), filter1->num_hashes()));
+    EXPECT(filter1->merge(*standard).is_error());
+
+    // Truncated data is rejected
+    auto serialized = MUST(filter1->serialize());
+    EXPECT(BloomFilter::deserialize(serialized.bytes().trim(serialized.size() - 1)).is_error());
+}
+
+TEST_CASE(blocked_bloom_filter_mapped_from_file)
+{
+    auto filter = MUST(BloomFilter::create_blocked(50000));
+    for (size_t i = 0; i < 100; ++i)
+        filter->add(MUST(String::formatted("mapped_{}", i)));
+
+    auto path = ByteString::formatted("/tmp/sentinel_test_mapped_filter_{}.bloom", getpid());
+    {
+        auto file = MUST(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        MUST(file->write_until_depleted(MUST(filter->serialize())));
+    }
+
+    auto mapped = MUST(BloomFilter::map_blocked(path));
+    MUST(Core::System::unlink(path));
+
+    EXPECT(mapped->is_read_only());
+    EXPECT_EQ(mapped->size_bits(), filter->size_bits());
+    EXPECT_EQ(mapped->bits_set(), filter->bits_set());
+    for (size_t i = 0; i < 100; ++i)
+        EXPECT(mapped->contains(MUST(String::formatted("mapped_{}", i))));
+
+    // A writable copy can be made by merging the mapping into a fresh filter
+    auto copy = MUST(BloomFilter::create_blocked(mapped->size_bits()));
+    MUST(copy->merge(*mapped));
+    EXPECT_EQ(copy->bits_set(), filter->bits_set());
+}
+
+TEST_CASE(blocked_bloom_filter_differences)
+{
+    auto older = MUST(BloomFilter::create_blocked(1000000));
+    for (size_t i = 0; i < 1000; ++i)
+        older->add(MUST(String::formatted("old_{}", i)));
+
+    auto newer = MUST(BloomFilter::deserialize(MUST(older->serialize())));
+    for (size_t i = 0; i < 10; ++i)
+        newer->add(MUST(String::formatted("new_{}", i)));
+
+    // Only the blocks the new items landed in are sent
+    auto difference = MUST(newer->serialize_difference_from(*older));
+    EXPECT(difference.size() < MUST(newer->serialize()).size() / 100);
+
+    auto peer = MUST(BloomFilter::deserialize(MUST(older->serialize())));
+    MUST(peer->apply_difference(difference));
+    EXPECT_EQ(peer->bits_set(), newer->bits_set());
+    for (size_t i = 0; i < 10; ++i)
+        EXPECT(peer->contains(MUST(String::formatted("new_{}", i))));
+
+    // Applying the same difference again changes nothing
+    MUST(peer->apply_difference(difference));
+    EXPECT_EQ(peer->bits_set(), newer->bits_set());
+
+    // Truncated or mismatched differences are rejected
+    EXPECT(peer->apply_difference(difference.bytes().trim(difference.size() - 1)).is_error());
+    auto smaller = MUST(BloomFilter::create_blocked(50000));
+    EXPECT(smaller->apply_difference(difference).is_error());
+    EXPECT(newer->serialize_difference_from(*smaller).is_error());
+}
+
+TEST_CASE(blocked_bloom_filter_concurrent_add)
+{
+    static constexpr size_t THREAD_COUNT = 4;
+    static constexpr size_t ITEMS_PER_THREAD = 2000;
+    auto filter = MUST(BloomFilter::create_blocked(1000000));
+
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t t = 0; t < THREAD_COUNT; ++t) {
+        threads.append(Threading::Thread::construct("BloomFilterTest"sv, [&filter, t] {
+            for (size_t i = 0; i < ITEMS_PER_THREAD; ++i)
+                filter->add(MUST(String::formatted("thread{}_{}", t, i)));
+            return static_cast<intptr_t>(0);
+        }));
+    }
+    for (auto& thread : threads)
+        thread->start();
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    // No add may be lost to a racing add into the same block
+    for (size_t t = 0; t < THREAD_COUNT; ++t) {
+        for (size_t i = 0; i < ITEMS_PER_THREAD; ++i)
+            EXPECT(filter->contains(MUST(String::formatted("thread{}_{}", t, i))));
+    }
+}
+
 TEST_CASE(threat_feed_basic_operations)
 {
     // Create threat feed
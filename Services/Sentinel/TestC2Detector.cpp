@@ -244,6 +244,53 @@ static void test_statistical_accuracy()
     }
 }
 
+static void test_periodic_beacon_with_skipped_beats()
+{
+    dbgln("\n=== Test: Periodic Beacon With Skipped Beats ===");
+
+    auto detector = MUST(Sentinel::C2Detector::create());
+
+    // A 60 second beacon that misses two beats in every four, so its intervals alternate between
+    // 60s and 180s and look irregular on their own
+    Sentinel::BeaconTracker beacon;
+    for (int beat = 0; beat < 80; beat++) {
+        if (beat % 4 >= 2)
+            continue;
+        double jitter = static_cast<double>(beat % 3) - 1.0;
+        beacon.record(1'000'000.0 + beat * 60.0 + jitter);
+    }
+
+    auto analysis = MUST(detector->analyze_beaconing(beacon));
+    dbgln("CV: {:.4f}, period: {:.1f}s, coherence: {:.2f}", analysis.interval_regularity, analysis.period_seconds, analysis.periodicity);
+    dbgln("Explanation: {}", analysis.explanation);
+
+    if (analysis.interval_regularity >= 0.4f && analysis.is_beaconing
+        && analysis.period_seconds > 59.0f && analysis.period_seconds < 61.0f) {
+        dbgln("✓ PASS: Beacon found from its period despite irregular intervals");
+    } else {
+        dbgln("✗ FAIL: Expected a periodic beacon at ~60s");
+    }
+
+    // Pseudo-random gaps of 5 to 94 seconds share no period
+    Sentinel::BeaconTracker browsing;
+    u32 seed = 12345;
+    double timestamp = 1'000'000.0;
+    for (int i = 0; i < 40; i++) {
+        seed = seed * 1103515245 + 12345;
+        timestamp += 5.0 + static_cast<double>((seed >> 16) % 90);
+        browsing.record(timestamp);
+    }
+
+    analysis = MUST(detector->analyze_beaconing(browsing));
+    dbgln("Random traffic CV: {:.4f}, coherence: {:.2f}", analysis.interval_regularity, analysis.periodicity);
+
+    if (!analysis.is_beaconing) {
+        dbgln("✓ PASS: Random traffic not flagged as periodic");
+    } else {
+        dbgln("✗ FAIL: Random traffic flagged as beaconing");
+    }
+}
+
 ErrorOr<int> ladybird_main(Main::Arguments)
 {
     dbgln("========================================");
@@ -259,6 +306,7 @@ ErrorOr<int> ladybird_main(Main::Arguments)
     test_exfiltration_known_upload_service();
     test_exfiltration_small_volume();
     test_statistical_accuracy();
+    test_periodic_beacon_with_skipped_beats();
 
     dbgln("\n========================================");
     dbgln("  Tests Complete");
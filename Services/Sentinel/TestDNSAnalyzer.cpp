@@ -4,6 +4,7 @@
  */
 
 #include "DNSAnalyzer.h"
+#include <AK/Array.h>
 #include <LibCore/System.h>
 #include <LibMain/Main.h>
 
@@ -135,6 +136,37 @@ static ErrorOr<void> test_dga_analysis()
     return {};
 }
 
+static ErrorOr<void> test_batch_dga_analysis()
+{
+    auto analyzer = TRY(DNSAnalyzer::create());
+
+    outln("=== Testing batch DGA analysis ===");
+    Array domains = {
+        "google.com"sv, "xk3j9f2lm8n.com"sv, ""sv, "www.thequickbrownfox.net"sv,
+        "qzxwvtnmlkjhgfdsapoiuytrewqzx.org"sv, "Mail.Example.COM"sv,
+    };
+    Array<DNSAnalyzer::DGAAnalysis, domains.size()> results;
+    analyzer->analyze_dga(domains, results);
+
+    // The batch must score exactly like the single-domain overload
+    for (size_t i = 0; i < domains.size(); i++) {
+        auto expected = TRY(analyzer->analyze_dga(domains[i]));
+        outln("'{}': is_dga={}, confidence={:.2f}", domains[i], results[i].is_dga, results[i].confidence);
+        if (results[i].entropy != expected.entropy || results[i].consonant_ratio != expected.consonant_ratio
+            || results[i].ngram_score != expected.ngram_score || results[i].is_dga != expected.is_dga
+            || results[i].confidence != expected.confidence)
+            return Error::from_string_literal("Batch DGA analysis differs from single-domain analysis");
+    }
+
+    // Letters are scored as one run with digits and dots skipped, and case does not matter
+    if (DNSAnalyzer::calculate_ngram_score("the"sv) != DNSAnalyzer::calculate_ngram_score("T1.h-E"sv))
+        return Error::from_string_literal("N-gram score depends on non-letters or case");
+    outln("N-gram score 'the': {:.2f} (expected: 0.00)", DNSAnalyzer::calculate_ngram_score("the"sv));
+    outln("");
+
+    return {};
+}
+
 static ErrorOr<void> test_dns_tunneling_analysis()
 {
     auto analyzer = TRY(DNSAnalyzer::create());
@@ -178,6 +210,7 @@ ErrorOr<int> ladybird_main(Main::Arguments)
 
     outln("--- DGA Detection Tests ---");
     TRY(test_dga_analysis());
+    TRY(test_batch_dga_analysis());
 
     outln("--- DNS Tunneling Detection Tests ---");
     TRY(test_dns_tunneling_analysis());
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "MalwareFeatureExtractor.h"
+#include "StreamingScanSession.h"
+#include <LibTest/TestCase.h>
+
+using namespace Sentinel;
+
+static MalwareMLDetector::Features extract(ReadonlyBytes data, size_t chunk_size)
+{
+    MalwareFeatureExtractor extractor;
+    for (size_t offset = 0; offset < data.size(); offset += chunk_size)
+        extractor.update(data.slice(offset, min(chunk_size, data.size() - offset)));
+    return extractor.finish();
+}
+
+static MalwareMLDetector::Features extract(StringView text)
+{
+    return extract(text.bytes(), text.length());
+}
+
+static void expect_same_features(MalwareMLDetector::Features const& a, MalwareMLDetector::Features const& b)
+{
+    EXPECT_EQ(a.file_size, b.file_size);
+    EXPECT_EQ(a.entropy, b.entropy);
+    EXPECT_EQ(a.pe_header_anomalies, b.pe_header_anomalies);
+    EXPECT_EQ(a.suspicious_strings, b.suspicious_strings);
+    EXPECT_EQ(a.code_section_ratio, b.code_section_ratio);
+    EXPECT_EQ(a.import_table_size, b.import_table_size);
+}
+
+// DOS header pointing at a PE signature, with everything else zeroed
+static ByteBuffer make_pe_file(size_t size, u32 pe_offset = 0x80, StringView signature = "PE\0\0"sv)
+{
+    auto data = MUST(ByteBuffer::create_zeroed(size));
+    data[0] = 'M';
+    data[1] = 'Z';
+    data[0x3C] = pe_offset & 0xFF;
+    data[0x3D] = (pe_offset >> 8) & 0xFF;
+    data[0x3E] = (pe_offset >> 16) & 0xFF;
+    data[0x3F] = (pe_offset >> 24) & 0xFF;
+    if (pe_offset + signature.length() <= size)
+        signature.bytes().copy_to(data.bytes().slice(pe_offset));
+    return data;
+}
+
+TEST_CASE(string_indicators)
+{
+    EXPECT_EQ(extract("plain text without anything of note"sv).suspicious_strings, 0u);
+    EXPECT_EQ(extract("fetch http://example"sv).suspicious_strings, 10u);
+    EXPECT_EQ(extract("run setup.exe"sv).suspicious_strings, 3u);
+    EXPECT_EQ(extract("VirtualAlloc then CreateRemoteThread"sv).suspicious_strings, 15u);
+    EXPECT_EQ(extract("https:// and ftp:// and .bat and WriteProcessMemory"sv).suspicious_strings, 28u);
+
+    // Matching is case-sensitive
+    EXPECT_EQ(extract("HTTP://EXAMPLE virtualalloc"sv).suspicious_strings, 0u);
+}
+
+TEST_CASE(dotted_numbers)
+{
+    // The match at "1.100" runs off the end of the file, so only the first counts
+    EXPECT_EQ(extract("192.168.1.100\n"sv).suspicious_strings, 5u);
+    EXPECT_EQ(extract("192.168.1.100 is a host\n"sv).suspicious_strings, 10u);
+
+    // The dot has to be within 6 bytes of the digit
+    EXPECT_EQ(extract("1abcdef.xxxxxxxxx"sv).suspicious_strings, 0u);
+    EXPECT_EQ(extract("1abcde.xxxxxxxxxx"sv).suspicious_strings, 5u);
+    EXPECT_EQ(extract("version 2.0 and 3.1 for x"sv).suspicious_strings, 10u);
+
+    // Files shorter than 8 bytes have no room for a match
+    EXPECT_EQ(extract("1.2.3.4"sv).suspicious_strings, 0u);
+}
+
+static MalwareMLDetector::Features extract_pe_file(size_t size, u32 pe_offset = 0x80, StringView signature = "PE\0\0"sv)
+{
+    auto data = make_pe_file(size, pe_offset, signature);
+    return extract(data, data.size());
+}
+
+TEST_CASE(pe_structure)
+{
+    auto valid = extract_pe_file(2048);
+    EXPECT_EQ(valid.pe_header_anomalies, 0u);
+
+    // Only the "PE" of the signature looks like code in the sample
+    EXPECT_EQ(valid.code_section_ratio, 2.0f / (2048.0f - 64.0f));
+
+    EXPECT_EQ(extract_pe_file(2048, 0x80, "NE\0\0"sv).pe_header_anomalies, 20u);
+    EXPECT_EQ(extract_pe_file(2048, 0x10000).pe_header_anomalies, 50u);
+
+    // Signatures inside the DOS header are read from it
+    EXPECT_EQ(extract_pe_file(2048, 0x20).pe_header_anomalies, 0u);
+
+    // Small PE files get the default ratio
+    EXPECT_EQ(extract_pe_file(512).code_section_ratio, 0.5f);
+
+    // Files that are not PE have no PE features at all
+    auto not_pe = MUST(ByteBuffer::create_zeroed(2048));
+    auto features = extract(not_pe, 2048);
+    EXPECT_EQ(features.pe_header_anomalies, 0u);
+    EXPECT_EQ(features.code_section_ratio, 0.0f);
+    EXPECT_EQ(features.import_table_size, 0u);
+}
+
+TEST_CASE(code_ratio_and_imports)
+{
+    auto data = make_pe_file(20000);
+
+    // A quarter of the sampled range [64, 10240) looks like code; bytes past it are ignored
+    for (size_t i = 64; i < 64 + 2544; ++i)
+        data[i] = 0xE8;
+    for (size_t i = 10240; i < 20000; ++i)
+        data[i] = 0x50;
+    "kernel32.dll ntdll.dll kernel32.dll"sv.bytes().copy_to(data.bytes().slice(12000));
+
+    auto features = extract(data, data.size());
+    EXPECT_EQ(features.code_section_ratio, 2544.0f / 10176.0f);
+    EXPECT_EQ(features.import_table_size, 20u);
+}
+
+TEST_CASE(entropy)
+{
+    EXPECT_EQ(extract(""sv).entropy, 0.0f);
+    EXPECT_EQ(extract("aaaaaaaa"sv).entropy, 0.0f);
+    EXPECT_APPROXIMATE(extract("abababab"sv).entropy, 1.0f);
+
+    ByteBuffer uniform;
+    for (size_t i = 0; i < 256 * 4; ++i)
+        uniform.append(static_cast<u8>(i));
+    EXPECT_APPROXIMATE(extract(uniform, uniform.size()).entropy, 8.0f);
+}
+
+TEST_CASE(chunking_does_not_change_features)
+{
+    auto data = make_pe_file(64 * 1024);
+    u32 seed = 0x12345678;
+    for (size_t i = 0x84; i < data.size(); ++i) {
+        seed = seed * 1103515245 + 12345;
+        data[i] = static_cast<u8>(seed >> 24);
+    }
+
+    // Indicators and dotted numbers placed to straddle chunk boundaries
+    "CreateRemoteThread"sv.bytes().copy_to(data.bytes().slice(4090));
+    "http://10.0.0.1/a.exe"sv.bytes().copy_to(data.bytes().slice(8185));
+    "user32.dll"sv.bytes().copy_to(data.bytes().slice(16380));
+
+    auto whole = extract(data, data.size());
+    EXPECT(whole.suspicious_strings >= 28u);
+    EXPECT_EQ(whole.import_table_size, 10u);
+
+    for (size_t chunk_size : { 1, 3, 7, 16, 17, 63, 1000, 4096 })
+        expect_same_features(extract(data, chunk_size), whole);
+}
+
+TEST_CASE(streaming_session_accumulates_features)
+{
+    auto data = make_pe_file(32 * 1024);
+    "http://192.168.0.1/payload.exe VirtualAlloc"sv.bytes().copy_to(data.bytes().slice(8000));
+
+    // The overlap is rescanned by YARA but must not be counted twice
+    StreamingScanSession session(64);
+    for (size_t offset = 0; offset < data.size(); offset += 1000) {
+        MUST(session.prepare_window(data.bytes().slice(offset, min<size_t>(1000, data.size() - offset))));
+        session.advance();
+    }
+
+    expect_same_features(session.features(), extract(data, data.size()));
+}
@@ -274,6 +274,57 @@ static void test_statistics()
     }
 }
 
+// Test 7: Batch prediction
+static void test_batch_prediction()
+{
+    print_section("Test 7: Batch Prediction"sv);
+
+    auto detector = MalwareMLDetector::create("/tmp/dummy_model.tflite");
+    if (detector.is_error()) {
+        log_fail("Batch prediction"sv, "Failed to create detector"sv);
+        return;
+    }
+
+    Vector<MalwareMLDetector::Features> batch;
+    for (u32 i = 0; i < 37; i++) {
+        MalwareMLDetector::Features features;
+        features.file_size = 1024 * (i + 1);
+        features.entropy = static_cast<float>(i % 9);
+        features.pe_header_anomalies = (i * 7) % 100;
+        features.suspicious_strings = (i * 31) % 1000;
+        features.code_section_ratio = static_cast<float>(i % 10) / 10.0f;
+        features.import_table_size = (i * 13) % 500;
+        batch.append(features);
+    }
+
+    auto predictions = detector.value()->predict(batch.span());
+    if (predictions.is_error() || predictions.value().size() != batch.size()) {
+        log_fail("Batch prediction"sv, "Failed to predict batch"sv);
+        return;
+    }
+
+    // Every batched prediction must agree with predicting that file on its own
+    for (size_t i = 0; i < batch.size(); i++) {
+        auto single = detector.value()->predict(batch[i]);
+        if (single.is_error()) {
+            log_fail("Batch prediction"sv, "Failed to predict single file"sv);
+            return;
+        }
+        auto const& batched = predictions.value()[i];
+        if (AK::fabs(single.value().malware_probability - batched.malware_probability) > 1e-6f
+            || AK::fabs(single.value().confidence - batched.confidence) > 1e-6f) {
+            log_fail("Batch prediction"sv, "Batched prediction differs from single prediction"sv);
+            return;
+        }
+    }
+
+    if (detector.value()->get_statistics().total_predictions == 2 * batch.size()) {
+        log_pass("Batch predictions match single predictions"sv);
+    } else {
+        log_fail("Batch prediction"sv, "Prediction count mismatch"sv);
+    }
+}
+
 ErrorOr<int> ladybird_main(Main::Arguments)
 {
     printf("====================================\n");
@@ -289,6 +340,7 @@ ErrorOr<int> ladybird_main(Main::Arguments)
     test_prediction_benign();
     test_prediction_malware();
     test_statistics();
+    test_batch_prediction();
 
     printf("\n====================================\n");
     printf("  Test Summary\n");
@@ -222,6 +222,50 @@ static ErrorOr<void> test_yara_generator()
     return {};
 }
 
+static ErrorOr<void> test_yara_rule_fragments()
+{
+    dbgln("TEST: YARA Rule Fragments");
+
+    auto output_directory = TRY(String::formatted("/tmp/sentinel_yara_fragments_{}", Core::System::getpid()));
+    (void)FileSystem::remove(output_directory, FileSystem::RecursionMode::Allowed);
+
+    auto make_ioc = [](String indicator) {
+        PolicyGraph::IOC ioc;
+        ioc.type = PolicyGraph::IOC::Type::FileHash;
+        ioc.indicator = move(indicator);
+        ioc.created_at = UnixDateTime::from_seconds_since_epoch(1700000000);
+        ioc.source = "test"_string;
+        return ioc;
+    };
+
+    Vector<PolicyGraph::IOC> iocs;
+    iocs.append(make_ioc("ed01ebfbc9eb5bbea545af4d01bf5f1071661840480439c6e5babe8e080e41aa"_string));
+    iocs.append(make_ioc("0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"_string));
+    // The same indicator reported twice only gets one rule
+    iocs.append(make_ioc("0123456789abcdef0123456789abcdef0123456789abcdef0123456789abcdef"_string));
+
+    auto update = TRY(YARAGenerator::generate_rule_fragments(iocs, output_directory));
+    VERIFY(update.fragment_paths.size() == 2);
+    VERIFY(update.changed_fragment_count == 2);
+
+    // Regenerating the same IOCs in a different order changes nothing
+    swap(iocs.first(), iocs.last());
+    update = TRY(YARAGenerator::generate_rule_fragments(iocs, output_directory));
+    VERIFY(update.fragment_paths.size() == 2);
+    VERIFY(update.changed_fragment_count == 0);
+
+    // A new indicator only changes the fragment it lands in
+    iocs.append(make_ioc("e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"_string));
+    update = TRY(YARAGenerator::generate_rule_fragments(iocs, output_directory));
+    VERIFY(update.fragment_paths.size() == 2);
+    VERIFY(update.changed_fragment_count == 1);
+
+    (void)FileSystem::remove(output_directory, FileSystem::RecursionMode::Allowed);
+
+    dbgln("TEST: YARA Rule Fragments - PASSED");
+    return {};
+}
+
 ErrorOr<int> ladybird_main(Main::Arguments)
 {
     dbgln("=== OTX Feed Client Test Suite ===\n");
@@ -232,6 +276,7 @@ ErrorOr<int> ladybird_main(Main::Arguments)
     TRY(test_yara_rule_generation());
     TRY(test_update_scheduler());
     TRY(test_yara_generator());
+    TRY(test_yara_rule_fragments());
 
     dbgln("\n=== All tests PASSED ===");
     return 0;
@@ -281,6 +281,39 @@ static void test_levenshtein_distance()
         log_fail("Levenshtein distance", "Incorrect distance calculations");
 }
 
+// Test 8: Lookalike characters count like typos
+static void test_skeleton_typosquatting()
+{
+    print_section("Test 8: Skeleton Typosquatting");
+
+    auto analyzer = PhishingURLAnalyzer::create();
+    if (analyzer.is_error()) {
+        log_fail("Skeleton typosquatting", "Failed to create analyzer");
+        return;
+    }
+
+    // "1" and "rn" look like "l" and "m", so these compare as (near) copies of the real names
+    auto lookalike = analyzer.value()->analyze_url("https://paypa1.com"sv);
+    auto letter_pair = analyzer.value()->analyze_url("https://arnazon.com"sv);
+    auto genuine = analyzer.value()->analyze_url("https://paypal.com"sv);
+    if (lookalike.is_error() || letter_pair.is_error() || genuine.is_error()) {
+        log_fail("Skeleton typosquatting", "Analysis failed");
+        return;
+    }
+
+    printf("  paypa1.com: typosquat=%d, closest='%s'\n", lookalike.value().is_typosquatting,
+        lookalike.value().closest_legitimate_domain.bytes_as_string_view().characters_without_null_termination());
+    printf("  arnazon.com: typosquat=%d, closest='%s'\n", letter_pair.value().is_typosquatting,
+        letter_pair.value().closest_legitimate_domain.bytes_as_string_view().characters_without_null_termination());
+
+    if (lookalike.value().is_typosquatting && lookalike.value().closest_legitimate_domain == "paypal.com"sv
+        && letter_pair.value().is_typosquatting && letter_pair.value().closest_legitimate_domain == "amazon.com"sv
+        && !genuine.value().is_typosquatting)
+        log_pass("Skeleton typosquatting detection");
+    else
+        log_fail("Skeleton typosquatting", "Lookalike domains were not matched to the real ones");
+}
+
 ErrorOr<int> ladybird_main(Main::Arguments)
 {
     printf("====================================\n");
@@ -297,6 +330,7 @@ ErrorOr<int> ladybird_main(Main::Arguments)
     test_high_entropy_domains();
     test_combined_indicators();
     test_levenshtein_distance();
+    test_skeleton_typosquatting();
 
     printf("\n====================================\n");
     printf("  Test Summary\n");
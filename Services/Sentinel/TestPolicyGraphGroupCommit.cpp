@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "PolicyGraph.h"
+#include <LibFileSystem/FileSystem.h>
+#include <LibTest/TestCase.h>
+#include <unistd.h>
+
+using namespace Sentinel;
+
+static constexpr auto VERDICT_HASH = "275a021bbfb6489e54d471899f7db9d1663fc695ec2fe2a2c4538aabf651fd0f"sv;
+
+static ByteString fresh_database_directory(StringView name)
+{
+    auto directory = ByteString::formatted("/tmp/policy_graph_group_commit_{}_{}", name, getpid());
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+    return directory;
+}
+
+static PolicyGraph::ThreatMetadata make_threat(size_t index)
+{
+    return {
+        .url = MUST(String::formatted("https://example.com/download/{}", index)),
+        .filename = "payload.exe"_string,
+        .file_hash = MUST(String::formatted("{:064x}", index)),
+        .mime_type = "application/octet-stream"_string,
+        .file_size = 4096,
+        .rule_name = "Test_Rule"_string,
+        .severity = "high"_string,
+    };
+}
+
+static PolicyGraph::SandboxVerdict make_verdict()
+{
+    auto now = UnixDateTime::now();
+    return {
+        .file_hash = MUST(String::from_utf8(VERDICT_HASH)),
+        .threat_level = 2,
+        .confidence = 900,
+        .composite_score = 850,
+        .verdict_explanation = "Test verdict"_string,
+        .yara_score = 1000,
+        .ml_score = 700,
+        .behavioral_score = 0,
+        .triggered_rules = {},
+        .detected_behaviors = {},
+        .analyzed_at = now,
+        .expires_at = now + AK::Duration::from_seconds(3600),
+        .rules_version = 1,
+    };
+}
+
+TEST_CASE(queued_threats_are_visible_to_reads)
+{
+    auto directory = fresh_database_directory("threats"sv);
+    OwnPtr<PolicyGraph> graph = MUST(PolicyGraph::create(directory));
+
+    // A long interval and a large batch keep the writer from flushing on its own
+    MUST(graph->set_write_durability(PolicyGraph::WriteDurability::GroupCommit, { .flush_interval = AK::Duration::from_seconds(60), .max_batch_size = 1000 }));
+    auto threats_before = MUST(graph->get_threat_count());
+
+    for (size_t i = 0; i < 10; ++i)
+        MUST(graph->record_threat(make_threat(i), "block"_string, {}, "{}"_string));
+    EXPECT_EQ(graph->pending_write_count(), 10u);
+
+    // Reads flush the queue first
+    EXPECT_EQ(MUST(graph->get_threat_count()), threats_before + 10);
+    EXPECT_EQ(graph->pending_write_count(), 0u);
+    EXPECT_EQ(graph->group_commit_statistics().batches_committed, 1u);
+    EXPECT_EQ(graph->group_commit_statistics().writes_committed, 10u);
+
+    graph = nullptr;
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
+
+TEST_CASE(queued_verdicts_are_served_before_they_are_committed)
+{
+    auto directory = fresh_database_directory("verdicts"sv);
+    OwnPtr<PolicyGraph> graph = MUST(PolicyGraph::create(directory));
+    MUST(graph->set_write_durability(PolicyGraph::WriteDurability::GroupCommit, { .flush_interval = AK::Duration::from_seconds(60), .max_batch_size = 1000 }));
+
+    MUST(graph->store_sandbox_verdict(make_verdict()));
+    EXPECT_EQ(graph->pending_write_count(), 1u);
+
+    auto verdict = MUST(graph->lookup_sandbox_verdict(MUST(String::from_utf8(VERDICT_HASH))));
+    EXPECT(verdict.has_value());
+    EXPECT_EQ(verdict->threat_level, 2);
+    EXPECT_EQ(graph->pending_write_count(), 1u);
+
+    // Invalidation must not be undone by the queued store
+    MUST(graph->invalidate_verdict(MUST(String::from_utf8(VERDICT_HASH))));
+    EXPECT(!MUST(graph->lookup_sandbox_verdict(MUST(String::from_utf8(VERDICT_HASH)))).has_value());
+
+    graph = nullptr;
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
+
+TEST_CASE(full_batches_are_committed_by_the_writer)
+{
+    auto directory = fresh_database_directory("batch"sv);
+    OwnPtr<PolicyGraph> graph = MUST(PolicyGraph::create(directory));
+    MUST(graph->set_write_durability(PolicyGraph::WriteDurability::GroupCommit, { .flush_interval = AK::Duration::from_seconds(60), .max_batch_size = 8 }));
+
+    for (size_t i = 0; i < 8; ++i)
+        MUST(graph->record_threat(make_threat(i), "block"_string, {}, "{}"_string));
+
+    // The writer wakes as soon as the batch is full rather than after the flush interval
+    for (size_t attempt = 0; attempt < 100 && graph->pending_write_count() > 0; ++attempt)
+        usleep(10'000);
+    EXPECT_EQ(graph->pending_write_count(), 0u);
+    EXPECT(graph->group_commit_statistics().writes_committed >= 8u);
+
+    graph = nullptr;
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
+
+TEST_CASE(queued_writes_survive_switching_back_to_immediate)
+{
+    auto directory = fresh_database_directory("durability"sv);
+    OwnPtr<PolicyGraph> graph = MUST(PolicyGraph::create(directory));
+    MUST(graph->set_write_durability(PolicyGraph::WriteDurability::GroupCommit, { .flush_interval = AK::Duration::from_seconds(60), .max_batch_size = 1000 }));
+    auto threats_before = MUST(graph->get_threat_count());
+
+    MUST(graph->record_threat(make_threat(0), "block"_string, {}, "{}"_string));
+    MUST(graph->set_write_durability(PolicyGraph::WriteDurability::Immediate));
+    EXPECT(graph->write_durability() == PolicyGraph::WriteDurability::Immediate);
+    EXPECT_EQ(graph->pending_write_count(), 0u);
+
+    // Immediate writes never queue
+    MUST(graph->record_threat(make_threat(1), "block"_string, {}, "{}"_string));
+    EXPECT_EQ(graph->pending_write_count(), 0u);
+    EXPECT_EQ(MUST(graph->get_threat_count()), threats_before + 2);
+
+    graph = nullptr;
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
+
+TEST_CASE(zero_batch_size_is_rejected)
+{
+    auto directory = fresh_database_directory("invalid"sv);
+    OwnPtr<PolicyGraph> graph = MUST(PolicyGraph::create(directory));
+    EXPECT(graph->set_write_durability(PolicyGraph::WriteDurability::GroupCommit, { .flush_interval = AK::Duration::from_milliseconds(10), .max_batch_size = 0 }).is_error());
+    EXPECT(graph->write_durability() == PolicyGraph::WriteDurability::Immediate);
+
+    graph = nullptr;
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "PolicyGraph.h"
+#include "PolicyMatcher.h"
+#include <LibFileSystem/FileSystem.h>
+#include <LibTest/TestCase.h>
+#include <unistd.h>
+
+using namespace Sentinel;
+
+static constexpr auto FILE_HASH = "275a021bbfb6489e54d471899f7db9d1663fc695ec2fe2a2c4538aabf651fd0f"sv;
+static constexpr i64 NOW_MS = 1'000'000;
+
+static PolicyMatcher::Entry url_entry(i64 policy_id, StringView pattern, i64 expires_at_ms = -1)
+{
+    return {
+        .policy_id = policy_id,
+        .rule_name = "Test_Rule"_string,
+        .url_pattern = MUST(String::from_utf8(pattern)),
+        .file_hash = {},
+        .expires_at_ms = expires_at_ms,
+    };
+}
+
+TEST_CASE(like_patterns_follow_sqlite_semantics)
+{
+    EXPECT(PolicyMatcher::matches_like_pattern("https://example.com/file.exe"sv, "https://example.com/%"sv));
+    EXPECT(PolicyMatcher::matches_like_pattern("HTTPS://EXAMPLE.COM/a"sv, "https://example.com/_"sv));
+    EXPECT(PolicyMatcher::matches_like_pattern("https://a.com/x/y/z.exe"sv, "%.com/%/%.exe"sv));
+    EXPECT(PolicyMatcher::matches_like_pattern(""sv, "%"sv));
+    EXPECT(PolicyMatcher::matches_like_pattern("100%"sv, "100\\%"sv));
+    EXPECT(PolicyMatcher::matches_like_pattern("caf\xc3\xa9"sv, "caf_"sv));
+
+    EXPECT(!PolicyMatcher::matches_like_pattern("https://example.com/"sv, "https://example.com/_"sv));
+    EXPECT(!PolicyMatcher::matches_like_pattern("https://example.org/"sv, "https://example.com/%"sv));
+    EXPECT(!PolicyMatcher::matches_like_pattern("1000"sv, "100\\%"sv));
+
+    // * is not a wildcard in LIKE
+    EXPECT(!PolicyMatcher::matches_like_pattern("https://example.com/file"sv, "https://example.com/*"sv));
+}
+
+TEST_CASE(match_priority_is_hash_then_url_then_rule_name)
+{
+    PolicyMatcher matcher;
+    MUST(matcher.add({ .policy_id = 1, .rule_name = "Test_Rule"_string, .url_pattern = {}, .file_hash = {}, .expires_at_ms = -1 }));
+    MUST(matcher.add(url_entry(2, "%evil.com/%"sv)));
+    MUST(matcher.add({ .policy_id = 3, .rule_name = "Other_Rule"_string, .url_pattern = {}, .file_hash = MUST(String::from_utf8(FILE_HASH)), .expires_at_ms = -1 }));
+    MUST(matcher.compile());
+
+    EXPECT_EQ(matcher.match(FILE_HASH, "https://evil.com/a"sv, "Test_Rule"sv, NOW_MS), 3);
+    EXPECT_EQ(matcher.match(""sv, "https://evil.com/a"sv, "Test_Rule"sv, NOW_MS), 2);
+    EXPECT_EQ(matcher.match(""sv, "https://good.com/a"sv, "Test_Rule"sv, NOW_MS), 1);
+    EXPECT(!matcher.match(""sv, "https://good.com/a"sv, "Unknown_Rule"sv, NOW_MS).has_value());
+
+    // Other_Rule has a hash, so its name alone does not match
+    EXPECT(!matcher.match(""sv, "https://good.com/a"sv, "Other_Rule"sv, NOW_MS).has_value());
+}
+
+TEST_CASE(oldest_live_url_policy_wins)
+{
+    PolicyMatcher matcher;
+    MUST(matcher.add(url_entry(5, "https://downloads.example.com/%"sv)));
+    MUST(matcher.add(url_entry(7, "%.exe"sv)));
+    MUST(matcher.add(url_entry(3, "%example.com/%.exe"sv, NOW_MS)));
+    MUST(matcher.add(url_entry(9, "%"sv)));
+    MUST(matcher.compile());
+
+    // Policy 3 matches but has expired
+    EXPECT_EQ(matcher.match(""sv, "https://downloads.example.com/setup.exe"sv, ""sv, NOW_MS), 5);
+    EXPECT_EQ(matcher.match(""sv, "https://downloads.example.com/setup.exe"sv, ""sv, NOW_MS - 1), 3);
+    EXPECT_EQ(matcher.match(""sv, "https://other.net/setup.exe"sv, ""sv, NOW_MS), 7);
+    EXPECT_EQ(matcher.match(""sv, "https://other.net/readme.txt"sv, ""sv, NOW_MS), 9);
+}
+
+TEST_CASE(index_is_updated_incrementally)
+{
+    PolicyMatcher matcher;
+    MUST(matcher.add(url_entry(1, "%tracker.net%"sv)));
+    MUST(matcher.compile());
+    EXPECT(matcher.match(""sv, "https://tracker.net/"sv, ""sv, NOW_MS).has_value());
+
+    // Uncompiled changes are still matched, just without the automaton
+    MUST(matcher.add(url_entry(2, "%malware.org%"sv)));
+    EXPECT(matcher.needs_compile());
+    EXPECT_EQ(matcher.match(""sv, "https://malware.org/"sv, ""sv, NOW_MS), 2);
+
+    matcher.remove(1);
+    MUST(matcher.compile());
+    EXPECT(!matcher.match(""sv, "https://tracker.net/"sv, ""sv, NOW_MS).has_value());
+    EXPECT_EQ(matcher.match(""sv, "https://MALWARE.org/"sv, ""sv, NOW_MS), 2);
+
+    // Replacing an entry moves it between indices
+    MUST(matcher.add({ .policy_id = 2, .rule_name = "Test_Rule"_string, .url_pattern = {}, .file_hash = {}, .expires_at_ms = -1 }));
+    MUST(matcher.compile());
+    EXPECT_EQ(matcher.size(), 1u);
+    EXPECT(!matcher.match(""sv, "https://malware.org/"sv, ""sv, NOW_MS).has_value());
+    EXPECT_EQ(matcher.match(""sv, ""sv, "Test_Rule"sv, NOW_MS), 2);
+}
+
+TEST_CASE(compiled_index_agrees_with_database)
+{
+    auto directory = ByteString::formatted("/tmp/policy_matcher_test_{}", getpid());
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+    OwnPtr<PolicyGraph> graph = MUST(PolicyGraph::create(directory));
+
+    auto make_policy = [](StringView rule_name, Optional<StringView> url_pattern, Optional<StringView> file_hash) {
+        PolicyGraph::Policy policy {};
+        policy.rule_name = MUST(String::from_utf8(rule_name));
+        if (url_pattern.has_value())
+            policy.url_pattern = MUST(String::from_utf8(*url_pattern));
+        if (file_hash.has_value())
+            policy.file_hash = MUST(String::from_utf8(*file_hash));
+        policy.action = PolicyGraph::PolicyAction::Block;
+        policy.created_at = UnixDateTime::now();
+        policy.created_by = "test"_string;
+        return policy;
+    };
+
+    auto hash_policy = MUST(graph->create_policy(make_policy("Hash_Rule"sv, {}, FILE_HASH)));
+    auto url_policy = MUST(graph->create_policy(make_policy("Url_Rule"sv, "https://evil.example/%"sv, {})));
+    auto rule_policy = MUST(graph->create_policy(make_policy("Name_Rule"sv, {}, {})));
+
+    auto threat = [](StringView url, StringView file_hash, StringView rule_name) {
+        return PolicyGraph::ThreatMetadata {
+            .url = MUST(String::from_utf8(url)),
+            .filename = "payload.exe"_string,
+            .file_hash = MUST(String::from_utf8(file_hash)),
+            .mime_type = "application/octet-stream"_string,
+            .file_size = 4096,
+            .rule_name = MUST(String::from_utf8(rule_name)),
+            .severity = "high"_string,
+        };
+    };
+
+    struct Case {
+        PolicyGraph::ThreatMetadata threat;
+        Optional<i64> expected_policy;
+    };
+    Vector<Case> cases;
+    cases.append({ threat("https://evil.example/a"sv, FILE_HASH, "Name_Rule"sv), hash_policy });
+    cases.append({ threat("https://evil.example/a"sv, ""sv, "Name_Rule"sv), url_policy });
+    cases.append({ threat("https://fine.example/a"sv, ""sv, "Name_Rule"sv), rule_policy });
+    cases.append({ threat("https://fine.example/a"sv, ""sv, "Url_Rule"sv), {} });
+
+    for (auto const& test_case : cases) {
+        auto compiled = MUST(graph->match_policy(test_case.threat));
+        auto database = MUST(graph->match_policy_using_database(test_case.threat));
+        EXPECT_EQ(compiled.has_value(), test_case.expected_policy.has_value());
+        EXPECT_EQ(database.has_value(), test_case.expected_policy.has_value());
+        if (compiled.has_value() && database.has_value()) {
+            EXPECT_EQ(compiled->id, *test_case.expected_policy);
+            EXPECT_EQ(database->id, *test_case.expected_policy);
+        }
+    }
+
+    // Mutations reach the index
+    MUST(graph->delete_policy(url_policy));
+    EXPECT_EQ(MUST(graph->match_policy(threat("https://evil.example/a"sv, ""sv, "Name_Rule"sv)))->id, rule_policy);
+
+    auto renamed = MUST(graph->get_policy(rule_policy));
+    renamed.rule_name = "Renamed_Rule"_string;
+    MUST(graph->update_policy(rule_policy, renamed));
+    EXPECT(!MUST(graph->match_policy(threat("https://fine.example/a"sv, ""sv, "Name_Rule"sv))).has_value());
+    EXPECT_EQ(MUST(graph->match_policy(threat("https://fine.example/a"sv, ""sv, "Renamed_Rule"sv)))->id, rule_policy);
+
+    // Hits are still counted in the database
+    EXPECT(MUST(graph->get_policy(rule_policy)).hit_count >= 1);
+
+    graph = nullptr;
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
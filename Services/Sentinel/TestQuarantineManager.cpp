@@ -5,6 +5,7 @@
 
 #include <AK/ByteBuffer.h>
 #include <AK/String.h>
+#include <AK/StringBuilder.h>
 #include <LibCore/Directory.h>
 #include <LibCore/File.h>
 #include <LibCrypto/Hash/SHA2.h>
@@ -85,7 +86,9 @@ TEST_CASE(test_file_encryption_decryption)
 
     // Encrypt file
     auto encrypted_file = "/tmp/quarantine_test/test_encrypt.txt.encrypted"_string;
-    MUST(FileEncryption::encrypt_file(test_file, encrypted_file, key));
+    auto info = MUST(FileEncryption::encrypt_file(test_file, encrypted_file, key));
+    EXPECT_EQ(info.plaintext_size, test_content.bytes().size());
+    EXPECT_EQ(info.plaintext_sha256.size(), 32u);
 
     EXPECT(FileSystem::exists(encrypted_file));
 
@@ -93,8 +96,8 @@ TEST_CASE(test_file_encryption_decryption)
     auto encrypted_data = MUST(Core::File::open(encrypted_file, Core::File::OpenMode::Read));
     auto encrypted_bytes = MUST(encrypted_data->read_until_eof());
 
-    // Encrypted data should have IV (16 bytes) + ciphertext
-    EXPECT(encrypted_bytes.size() > 16);
+    // Encrypted data should have the header + ciphertext + one 16-byte tag
+    EXPECT_EQ(encrypted_bytes.size(), 28u + test_content.bytes().size() + 16u);
     EXPECT(encrypted_bytes.size() != test_content.bytes().size());
 
     // Decrypt file
@@ -111,6 +114,50 @@ TEST_CASE(test_file_encryption_decryption)
     cleanup_test_environment();
 }
 
+TEST_CASE(test_file_encryption_in_chunks)
+{
+    // Files larger than one chunk round-trip, and ranges can be decrypted without decrypting the whole file
+
+    auto key = MUST(FileEncryption::generate_encryption_key());
+
+    auto content_size = FileEncryption::CHUNK_SIZE * 2 + 1234;
+    StringBuilder builder;
+    for (size_t i = 0; i < content_size; ++i)
+        builder.append(static_cast<char>('a' + (i * 7) % 26));
+    auto test_content = builder.to_byte_string();
+    auto test_file = MUST(create_test_file("test_chunks.bin"_string, test_content));
+
+    auto encrypted_file = "/tmp/quarantine_test/test_chunks.bin.encrypted"_string;
+    auto info = MUST(FileEncryption::encrypt_file(test_file, encrypted_file, key));
+    EXPECT_EQ(info.plaintext_size, content_size);
+
+    auto decrypted_file = "/tmp/quarantine_test/test_chunks.bin.decrypted"_string;
+    MUST(FileEncryption::decrypt_file(encrypted_file, decrypted_file, key));
+    auto decrypted_data = MUST(Core::File::open(decrypted_file, Core::File::OpenMode::Read));
+    auto decrypted_bytes = MUST(decrypted_data->read_until_eof());
+    EXPECT_EQ(StringView { decrypted_bytes }, test_content.view());
+
+    // A range that straddles the boundary between the first and second chunk
+    auto offset = FileEncryption::CHUNK_SIZE - 100;
+    auto range = MUST(FileEncryption::decrypt_file_range(encrypted_file, offset, 200, key));
+    EXPECT_EQ(StringView { range }, test_content.view().substring_view(offset, 200));
+
+    // Ranges are clamped to the end of the file
+    auto tail = MUST(FileEncryption::decrypt_file_range(encrypted_file, content_size - 10, 100, key));
+    EXPECT_EQ(StringView { tail }, test_content.view().substring_view(content_size - 10));
+
+    // Corrupting any chunk makes decryption fail
+    {
+        auto file = MUST(Core::File::open(encrypted_file, Core::File::OpenMode::ReadWrite));
+        MUST(file->seek(static_cast<i64>(FileEncryption::CHUNK_SIZE + 500), SeekMode::SetPosition));
+        u8 byte = 0xff;
+        MUST(file->write_until_depleted({ &byte, 1 }));
+    }
+    EXPECT(FileEncryption::decrypt_file(encrypted_file, decrypted_file, key).is_error());
+
+    cleanup_test_environment();
+}
+
 TEST_CASE(test_quarantine_file)
 {
     // Test quarantining a malicious file
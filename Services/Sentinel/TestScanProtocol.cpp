@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ScanProtocol.h"
+#include "StreamingScanSession.h"
+#include <AK/StringView.h>
+#include <LibTest/TestCase.h>
+
+using namespace Sentinel;
+
+TEST_CASE(shared_buffer_scan_header_round_trip)
+{
+    auto header = ScanProtocol::make_shared_buffer_scan_header(4096, 42);
+    auto parsed = ScanProtocol::parse_shared_buffer_scan_header(ScanProtocol::header_bytes(header));
+    EXPECT(parsed.has_value());
+    EXPECT_EQ(static_cast<u64>(parsed->content_size), 4096u);
+    EXPECT_EQ(static_cast<u64>(parsed->request_id), 42u);
+    EXPECT(!ScanProtocol::validate_shared_buffer_scan_header(parsed.value()).is_error());
+}
+
+TEST_CASE(shared_buffer_scan_header_is_big_endian_on_the_wire)
+{
+    auto header = ScanProtocol::make_shared_buffer_scan_header(1, 1);
+    auto bytes = ScanProtocol::header_bytes(header);
+    EXPECT_EQ(bytes[0], 'S');
+    EXPECT_EQ(bytes[1], 'N');
+    EXPECT_EQ(bytes[2], 'T');
+    EXPECT_EQ(bytes[3], 'B');
+}
+
+TEST_CASE(json_messages_are_not_mistaken_for_binary_headers)
+{
+    auto json = R"({"action":"scan_content","request_id":"x"})"sv;
+    EXPECT(!ScanProtocol::parse_shared_buffer_scan_header(json.bytes()).has_value());
+
+    // Same size as a header, but without the magic
+    auto padded = "{\"action\":\"health\"}     "sv;
+    EXPECT_EQ(padded.length(), sizeof(ScanProtocol::SharedBufferScanHeader));
+    EXPECT(!ScanProtocol::parse_shared_buffer_scan_header(padded.bytes()).has_value());
+}
+
+TEST_CASE(shared_buffer_scan_header_validation)
+{
+    EXPECT(ScanProtocol::validate_shared_buffer_scan_header(ScanProtocol::make_shared_buffer_scan_header(0, 1)).is_error());
+    EXPECT(ScanProtocol::validate_shared_buffer_scan_header(ScanProtocol::make_shared_buffer_scan_header(ScanProtocol::MAX_SHARED_BUFFER_SCAN_SIZE + 1, 1)).is_error());
+
+    auto header = ScanProtocol::make_shared_buffer_scan_header(16, 1);
+    header.version = 2;
+    EXPECT(ScanProtocol::validate_shared_buffer_scan_header(header).is_error());
+}
+
+TEST_CASE(stream_messages_carry_content_inline)
+{
+    auto chunk = "chunk payload"sv.bytes();
+    auto header = ScanProtocol::make_shared_buffer_scan_header(chunk.size(), 7, ScanProtocol::ScanFlags::StreamChunk);
+    EXPECT(ScanProtocol::is_stream_message(header));
+    EXPECT(!ScanProtocol::validate_stream_message(header, chunk).is_error());
+    EXPECT(ScanProtocol::validate_stream_message(header, chunk.trim(4)).is_error());
+
+    // Stream messages must never be mistaken for shared buffer scans, which expect a file descriptor
+    EXPECT(ScanProtocol::validate_shared_buffer_scan_header(header).is_error());
+
+    auto end = ScanProtocol::make_shared_buffer_scan_header(0, 7, ScanProtocol::ScanFlags::StreamEnd);
+    EXPECT(!ScanProtocol::validate_stream_message(end, {}).is_error());
+}
+
+TEST_CASE(streaming_session_keeps_only_the_overlap_between_chunks)
+{
+    StreamingScanSession session(4);
+
+    auto window = MUST(session.prepare_window("abcdefgh"sv.bytes()));
+    EXPECT_EQ(StringView { window }, "abcdefgh"sv);
+    session.advance();
+
+    // The tail of the previous chunk is rescanned with the next one
+    window = MUST(session.prepare_window("ijkl"sv.bytes()));
+    EXPECT_EQ(StringView { window }, "efghijkl"sv);
+    session.advance();
+
+    window = MUST(session.prepare_window("mn"sv.bytes()));
+    EXPECT_EQ(StringView { window }, "ijklmn"sv);
+
+    EXPECT_EQ(session.bytes_received(), 14u);
+    EXPECT_EQ(session.chunks_scanned(), 3u);
+    EXPECT_EQ(session.peak_window_size(), 8u);
+}
+
+TEST_CASE(streaming_session_verdict_is_sticky)
+{
+    StreamingScanSession session;
+    EXPECT(!session.has_threat());
+    session.set_verdict("{\"threat_detected\":true}"sv);
+    EXPECT(session.has_threat());
+    EXPECT_EQ(session.verdict().value(), "{\"threat_detected\":true}"sv);
+}
+
+TEST_CASE(streaming_session_has_no_rules_version_if_the_rules_changed_mid_stream)
+{
+    StreamingScanSession session;
+    EXPECT(!session.rules_version().has_value());
+
+    session.record_rules_version(7);
+    session.record_rules_version(7);
+    EXPECT_EQ(session.rules_version().value(), 7u);
+
+    session.record_rules_version(8);
+    EXPECT(!session.rules_version().has_value());
+}
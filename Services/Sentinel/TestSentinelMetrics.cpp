@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "LatencyHistogram.h"
+#include "SentinelMetrics.h"
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+
+using namespace Sentinel;
+
+TEST_CASE(bucket_bounds_round_trip)
+{
+    for (size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i) {
+        auto upper = LatencyHistogram::bucket_upper_bound(i);
+        EXPECT_EQ(LatencyHistogram::bucket_index(upper), i);
+        if (i + 1 < LatencyHistogram::BUCKET_COUNT)
+            EXPECT_EQ(LatencyHistogram::bucket_index(upper + 1), i + 1);
+    }
+
+    EXPECT_EQ(LatencyHistogram::bucket_index(NumericLimits<u64>::max()), LatencyHistogram::BUCKET_COUNT - 1);
+}
+
+TEST_CASE(percentiles_are_within_bucket_precision)
+{
+    LatencyHistogram histogram;
+    EXPECT_EQ(histogram.percentile(50), Duration::zero());
+
+    // 1us to 100ms, evenly spread
+    for (i64 microseconds = 1; microseconds <= 100'000; ++microseconds)
+        histogram.record(Duration::from_microseconds(microseconds));
+    EXPECT_EQ(histogram.count(), 100'000u);
+
+    for (auto percent : { 1.0, 50.0, 90.0, 99.0, 99.9 }) {
+        auto expected = percent * 1'000;
+        auto actual = static_cast<double>(histogram.percentile(percent).to_microseconds());
+        EXPECT(actual >= expected);
+        EXPECT(actual <= expected * (1 + 1.0 / LatencyHistogram::BUCKETS_PER_MAGNITUDE));
+    }
+    EXPECT_EQ(histogram.percentile(100).to_microseconds(), static_cast<i64>(LatencyHistogram::bucket_upper_bound(LatencyHistogram::bucket_index(100'000))));
+
+    // A slow tail shows up in p99 but not p50
+    LatencyHistogram tail;
+    for (size_t i = 0; i < 98; ++i)
+        tail.record(Duration::from_microseconds(200));
+    tail.record(Duration::from_seconds(2));
+    tail.record(Duration::from_seconds(3));
+    EXPECT(tail.percentile(50).to_microseconds() < 220);
+    EXPECT(tail.percentile(99).to_milliseconds() >= 2000);
+}
+
+TEST_CASE(merged_histograms_match_a_single_histogram)
+{
+    LatencyHistogram single;
+    LatencyHistogram first;
+    LatencyHistogram second;
+    AtomicLatencyHistogram atomic;
+    for (i64 i = 0; i < 5'000; ++i) {
+        auto duration = Duration::from_microseconds((i * 7919) % 250'000);
+        single.record(duration);
+        (i % 2 ? first : second).record(duration);
+        atomic.record(duration);
+    }
+
+    first.merge(second);
+    LatencyHistogram from_atomic;
+    atomic.add_to(from_atomic);
+
+    EXPECT_EQ(first.count(), single.count());
+    EXPECT_EQ(from_atomic.count(), single.count());
+    for (auto percent : { 50.0, 90.0, 99.0 }) {
+        EXPECT_EQ(first.percentile(percent), single.percentile(percent));
+        EXPECT_EQ(from_atomic.percentile(percent), single.percentile(percent));
+    }
+}
+
+TEST_CASE(collector_counts_every_thread)
+{
+    static constexpr size_t THREAD_COUNT = 24;
+    static constexpr size_t SCANS_PER_THREAD = 2'000;
+
+    auto& collector = MetricsCollector::the();
+    collector.reset_all_metrics();
+
+    // More threads than shards, so some threads share one
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t thread = 0; thread < THREAD_COUNT; ++thread) {
+        threads.append(MUST(Threading::Thread::try_create("MetricsRecorder"sv, [&collector]() -> intptr_t {
+            for (size_t i = 0; i < SCANS_PER_THREAD; ++i) {
+                collector.record_download_scan(Duration::from_milliseconds(i % 2 ? 10 : 100));
+                collector.record_policy_query(Duration::from_microseconds(50), i % 4 != 0);
+            }
+            collector.record_threat_detected("block"_string);
+            return 0;
+        })));
+        threads.last()->start();
+    }
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    auto metrics = collector.snapshot();
+    EXPECT_EQ(metrics.total_downloads_scanned, THREAD_COUNT * SCANS_PER_THREAD);
+    EXPECT_EQ(metrics.scan_count, THREAD_COUNT * SCANS_PER_THREAD);
+    EXPECT_EQ(metrics.scan_latency.count(), THREAD_COUNT * SCANS_PER_THREAD);
+    EXPECT_EQ(metrics.total_scan_time.to_milliseconds(), static_cast<i64>(THREAD_COUNT * SCANS_PER_THREAD / 2 * 110));
+    EXPECT_EQ(metrics.query_count, THREAD_COUNT * SCANS_PER_THREAD);
+    EXPECT_EQ(metrics.cache_hits, THREAD_COUNT * SCANS_PER_THREAD / 4 * 3);
+    EXPECT_EQ(metrics.cache_misses, THREAD_COUNT * SCANS_PER_THREAD / 4);
+    EXPECT_EQ(metrics.threats_detected, THREAD_COUNT);
+    EXPECT_EQ(metrics.threats_blocked, THREAD_COUNT);
+
+    // Half the scans took 10ms and half 100ms
+    EXPECT(metrics.scan_latency.percentile(25).to_milliseconds() >= 10);
+    EXPECT(metrics.scan_latency.percentile(25).to_milliseconds() < 11);
+    EXPECT(metrics.scan_latency.percentile(99).to_milliseconds() >= 100);
+    EXPECT(metrics.scan_latency.percentile(99).to_milliseconds() < 107);
+
+    auto prometheus = MUST(metrics.to_prometheus());
+    EXPECT(prometheus.contains(MUST(String::formatted("sentinel_downloads_scanned_total {}\n", THREAD_COUNT * SCANS_PER_THREAD)).bytes_as_string_view()));
+    EXPECT(prometheus.contains("# TYPE sentinel_scan_duration_seconds summary\n"sv));
+    EXPECT(prometheus.contains("sentinel_scan_duration_seconds{quantile=\"0.99\"} 0.10"sv));
+    EXPECT(prometheus.contains(MUST(String::formatted("sentinel_policy_query_duration_seconds_count {}\n", THREAD_COUNT * SCANS_PER_THREAD)).bytes_as_string_view()));
+
+    // Session metrics start over, lifetime totals do not
+    collector.reset_session_metrics();
+    metrics = collector.snapshot();
+    EXPECT_EQ(metrics.scan_count, 0u);
+    EXPECT_EQ(metrics.scan_latency.count(), 0u);
+    EXPECT_EQ(metrics.total_downloads_scanned, THREAD_COUNT * SCANS_PER_THREAD);
+
+    collector.reset_all_metrics();
+    EXPECT_EQ(collector.snapshot().total_downloads_scanned, 0u);
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "PhishingURLAnalyzer.h"
+#include "TyposquatIndex.h"
+#include <AK/Array.h>
+#include <AK/StringBuilder.h>
+#include <LibTest/TestCase.h>
+
+using namespace Sentinel;
+
+static constexpr Array KEYS = {
+    "paypal"sv, "google"sv, "gmail"sv, "apple"sv, "amazon"sv, "ebay"sv, "etsy"sv, "ups"sv,
+    "github"sv, "gitlab"sv, "chase"sv, "yahoo"sv, "bankofamerica"sv, "instagram"sv,
+};
+
+TEST_CASE(bounded_distance_matches_full_distance)
+{
+    EXPECT_EQ(TyposquatIndex::bounded_levenshtein_distance("kitten"sv, "sitting"sv, 3), 3);
+    EXPECT(!TyposquatIndex::bounded_levenshtein_distance("kitten"sv, "sitting"sv, 2).has_value());
+    EXPECT_EQ(TyposquatIndex::bounded_levenshtein_distance(""sv, "abc"sv, 3), 3);
+    EXPECT_EQ(TyposquatIndex::bounded_levenshtein_distance("abc"sv, "abc"sv, 0), 0);
+    EXPECT(!TyposquatIndex::bounded_levenshtein_distance("abc"sv, "abd"sv, 0).has_value());
+
+    // Length difference alone rules these out
+    EXPECT(!TyposquatIndex::bounded_levenshtein_distance("a"sv, "abcde"sv, 3).has_value());
+
+    u32 seed = 0x2545F491;
+    auto random_word = [&] {
+        seed = seed * 1103515245 + 12345;
+        StringBuilder builder;
+        for (size_t i = 0, length = (seed >> 16) % 10; i < length; ++i) {
+            seed = seed * 1103515245 + 12345;
+            builder.append(static_cast<char>('a' + (seed >> 16) % 3));
+        }
+        return builder.to_byte_string();
+    };
+
+    for (int i = 0; i < 2000; ++i) {
+        auto a = random_word();
+        auto b = random_word();
+        auto distance = PhishingURLAnalyzer::levenshtein_distance(a, b);
+        for (int bound = 0; bound <= 4; ++bound) {
+            auto bounded = TyposquatIndex::bounded_levenshtein_distance(a, b, bound);
+            if (distance <= bound)
+                EXPECT_EQ(bounded, distance);
+            else
+                EXPECT(!bounded.has_value());
+        }
+    }
+}
+
+TEST_CASE(finds_closest_key)
+{
+    auto index = MUST(TyposquatIndex::create(KEYS));
+    EXPECT_EQ(index.key_count(), KEYS.size());
+
+    auto match = index.find_closest("paypai"sv);
+    VERIFY(match.has_value());
+    EXPECT_EQ(KEYS[match->index], "paypal"sv);
+    EXPECT_EQ(match->distance, 1);
+
+    match = index.find_closest("bankofamerca"sv);
+    VERIFY(match.has_value());
+    EXPECT_EQ(KEYS[match->index], "bankofamerica"sv);
+    EXPECT_EQ(match->distance, 1);
+
+    match = index.find_closest("google"sv);
+    VERIFY(match.has_value());
+    EXPECT_EQ(match->distance, 0);
+
+    EXPECT(!index.find_closest("wikipedia"sv).has_value());
+    EXPECT(!index.find_closest("averyveryverylongdomainnamethatmatchesnothing"sv).has_value());
+}
+
+TEST_CASE(ties_go_to_the_first_key)
+{
+    // "gitlub" is one edit from both "github" and "gitlab"
+    auto index = MUST(TyposquatIndex::create(KEYS));
+    auto match = index.find_closest("gitlub"sv);
+    VERIFY(match.has_value());
+    EXPECT_EQ(KEYS[match->index], "github"sv);
+}
+
+TEST_CASE(agrees_with_linear_scan)
+{
+    auto index = MUST(TyposquatIndex::create(KEYS));
+
+    Array queries = {
+        "paypal"sv, "paypa1"sv, "pyapal"sv, "gooogle"sv, "gogle"sv, "amazom"sv, "amaz"sv, "ebya"sv,
+        "etsyy"sv, "up"sv, "u"sv, ""sv, "githubb"sv, "qwerty"sv, "instagran"sv, "yahooo"sv,
+        "chaser"sv, "applle"sv, "gmial"sv, "bankofamerika"sv, "xyzzy"sv,
+    };
+
+    for (auto query : queries) {
+        Optional<TyposquatIndex::Match> expected;
+        for (size_t i = 0; i < KEYS.size(); ++i) {
+            auto distance = PhishingURLAnalyzer::levenshtein_distance(query, KEYS[i]);
+            if (distance <= index.max_distance() && (!expected.has_value() || distance < expected->distance))
+                expected = TyposquatIndex::Match { i, distance };
+        }
+
+        auto match = index.find_closest(query);
+        EXPECT_EQ(match.has_value(), expected.has_value());
+        if (match.has_value() && expected.has_value()) {
+            EXPECT_EQ(match->index, expected->index);
+            EXPECT_EQ(match->distance, expected->distance);
+        }
+    }
+}
+
+TEST_CASE(rejects_unsupported_configurations)
+{
+    EXPECT(TyposquatIndex::create(KEYS, TyposquatIndex::MAX_DISTANCE + 1).is_error());
+
+    Array const too_long = { "abcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyzabcdefghijklmnopqrstuvwxyz"sv };
+    EXPECT(TyposquatIndex::create(too_long).is_error());
+
+    // An empty index matches nothing
+    TyposquatIndex empty;
+    EXPECT(!empty.find_closest("paypal"sv).has_value());
+}
@@ -344,3 +344,52 @@ TEST_CASE(test_real_world_scenario_false_positive)
     EXPECT(verdict.confidence < 0.7f); // Lower confidence due to disagreement
 }
 
+
+TEST_CASE(test_composite_range_of_missing_scores)
+{
+    auto verdict_engine = MUST(VerdictEngine::create());
+
+    auto unknown = verdict_engine->composite_range({});
+    EXPECT_APPROXIMATE(unknown.minimum, 0.0f);
+    EXPECT_APPROXIMATE(unknown.maximum, 1.0f);
+
+    // Only the behavioral score is missing: (0.5 * 0.30) + (0.5 * 0.25) + (0.0 * 0.25) = 0.275, plus up to 0.20
+    auto range = verdict_engine->composite_range({ .yara = 0.5f, .ml = 0.5f, .vt = 0.0f });
+    EXPECT_APPROXIMATE(range.minimum, 0.275f);
+    EXPECT_APPROXIMATE(range.maximum, 0.475f);
+}
+
+TEST_CASE(test_settled_verdict_without_behavioral_score)
+{
+    auto verdict_engine = MUST(VerdictEngine::create());
+
+    // The behavioral score alone can add at most 0.20, which keeps a clean file below 0.3
+    auto clean = MUST(verdict_engine->calculate_settled_verdict({ .yara = 0.0f, .ml = 0.05f, .vt = 0.0f }));
+    EXPECT(clean.has_value());
+    EXPECT(clean->threat_level == SandboxResult::ThreatLevel::Clean);
+
+    // Nor can it pull a file that is already over 0.8 back below it
+    auto critical = MUST(verdict_engine->calculate_settled_verdict({ .yara = 1.0f, .ml = 1.0f, .vt = 1.0f }));
+    EXPECT(critical.has_value());
+    EXPECT(critical->threat_level == SandboxResult::ThreatLevel::Critical);
+
+    EXPECT_EQ(verdict_engine->get_statistics().total_verdicts, 2u);
+}
+
+TEST_CASE(test_unsettled_verdict_needs_behavioral_score)
+{
+    auto verdict_engine = MUST(VerdictEngine::create());
+
+    // 0.275 to 0.475 straddles the suspicious threshold
+    PartialScores scores { .yara = 0.5f, .ml = 0.5f, .vt = 0.0f };
+    EXPECT(!verdict_engine->is_settled(scores));
+    EXPECT(!MUST(verdict_engine->calculate_settled_verdict(scores)).has_value());
+    EXPECT_EQ(verdict_engine->get_statistics().total_verdicts, 0u);
+
+    // Once the behavioral score is in, the verdict is always settled
+    scores.behavioral = 0.9f;
+    auto verdict = MUST(verdict_engine->calculate_settled_verdict(scores));
+    EXPECT(verdict.has_value());
+    EXPECT_APPROXIMATE(verdict->composite_score, 0.455f);
+    EXPECT(verdict->threat_level == SandboxResult::ThreatLevel::Suspicious);
+}
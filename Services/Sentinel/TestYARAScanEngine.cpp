@@ -0,0 +1,253 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "YARAScanEngine.h"
+#include <AK/StringView.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/Directory.h>
+#include <LibCore/EventLoop.h>
+#include <LibCore/File.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibTest/TestCase.h>
+#include <unistd.h>
+
+using namespace Sentinel;
+
+static constexpr auto MARKER_RULE = R"(
+rule Test_Marker {
+    meta:
+        description = "Test marker string"
+        severity = "high"
+    strings:
+        $marker = "SENTINEL-TEST-MARKER"
+    condition:
+        $marker
+}
+)"sv;
+
+static constexpr auto OTHER_RULE = R"(
+rule Test_Other_Marker {
+    strings:
+        $marker = "SENTINEL-OTHER-MARKER"
+    condition:
+        $marker
+}
+)"sv;
+
+static NonnullRefPtr<CompiledRuleSet> compile_rules(StringView source)
+{
+    Vector<ByteBuffer> sources;
+    sources.append(MUST(ByteBuffer::copy(source.bytes())));
+    return MUST(CompiledRuleSet::compile(sources));
+}
+
+TEST_CASE(scan_reports_matches_and_metadata)
+{
+    auto engine = MUST(YARAScanEngine::create(1));
+    engine->swap_rules(compile_rules(MARKER_RULE));
+
+    auto clean = MUST(engine->scan("nothing to see here"sv.bytes()));
+    EXPECT(!clean.has_matches());
+
+    auto infected = MUST(engine->scan("prefix SENTINEL-TEST-MARKER suffix"sv.bytes()));
+    EXPECT(infected.has_matches());
+    EXPECT_EQ(infected.rule_names.first(), "Test_Marker"sv);
+    EXPECT_EQ(infected.rule_details.first().get_string("severity"sv).value(), "high"sv);
+    EXPECT_EQ(infected.rules_version, engine->rules_version());
+}
+
+TEST_CASE(invalid_rules_are_rejected)
+{
+    // The engine keeps libyara initialized
+    auto engine = MUST(YARAScanEngine::create(1));
+
+    Vector<ByteBuffer> sources;
+    sources.append(MUST(ByteBuffer::copy("rule broken { condition: }"sv.bytes())));
+    EXPECT(CompiledRuleSet::compile(sources).is_error());
+    EXPECT(CompiledRuleSet::compile({}).is_error());
+}
+
+TEST_CASE(scan_without_rules_fails)
+{
+    auto engine = MUST(YARAScanEngine::create(1));
+    EXPECT(engine->scan("content"sv.bytes()).is_error());
+    EXPECT_EQ(engine->rules_version(), 0u);
+}
+
+TEST_CASE(windowed_scan_finds_match_across_window_boundary)
+{
+    auto engine = MUST(YARAScanEngine::create(1));
+    engine->swap_rules(compile_rules(MARKER_RULE));
+
+    auto content = MUST(ByteBuffer::create_zeroed(YARAScanEngine::WINDOWED_SCAN_THRESHOLD + 1));
+    auto marker = "SENTINEL-TEST-MARKER"sv;
+    auto offset = YARAScanEngine::SCAN_WINDOW_SIZE - marker.length() / 2;
+    content.overwrite(offset, marker.characters_without_null_termination(), marker.length());
+
+    auto result = MUST(engine->scan(content.bytes()));
+    EXPECT(result.has_matches());
+}
+
+TEST_CASE(swapping_rules_changes_version_and_matches)
+{
+    auto engine = MUST(YARAScanEngine::create(1));
+    engine->swap_rules(compile_rules(MARKER_RULE));
+    auto first_version = engine->rules_version();
+
+    engine->swap_rules(compile_rules(OTHER_RULE));
+    EXPECT_NE(engine->rules_version(), first_version);
+
+    EXPECT(!MUST(engine->scan("SENTINEL-TEST-MARKER"sv.bytes())).has_matches());
+    EXPECT(MUST(engine->scan("SENTINEL-OTHER-MARKER"sv.bytes())).has_matches());
+}
+
+TEST_CASE(async_scans_complete_on_the_submitting_event_loop)
+{
+    Core::EventLoop loop;
+    auto engine = MUST(YARAScanEngine::create(4));
+    engine->swap_rules(compile_rules(MARKER_RULE));
+
+    static constexpr size_t SCAN_COUNT = 32;
+    size_t completed = 0;
+    size_t matched = 0;
+    for (size_t i = 0; i < SCAN_COUNT; ++i) {
+        auto content = (i % 2 == 0) ? "SENTINEL-TEST-MARKER"sv : "clean content"sv;
+        engine->scan_async(content.bytes(), [&](ErrorOr<YARAScanResult> result) {
+            EXPECT(!result.is_error());
+            if (result.value().has_matches())
+                ++matched;
+            if (++completed == SCAN_COUNT)
+                loop.quit(0);
+        });
+    }
+
+    loop.exec();
+    EXPECT_EQ(completed, SCAN_COUNT);
+    EXPECT_EQ(matched, SCAN_COUNT / 2);
+}
+
+TEST_CASE(compiled_rules_are_reused_from_the_cache)
+{
+    auto directory = ByteString::formatted("/tmp/yara_rules_cache_test_{}", getpid());
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+
+    // The engine keeps libyara initialized
+    auto engine = MUST(YARAScanEngine::create(1));
+
+    Vector<ByteBuffer> sources;
+    sources.append(MUST(ByteBuffer::copy(MARKER_RULE.bytes())));
+
+    auto compiled = MUST(CompiledRuleSet::load_or_compile(sources, directory));
+    EXPECT(!compiled->was_loaded_from_cache());
+
+    auto cached = MUST(CompiledRuleSet::load_or_compile(sources, directory));
+    EXPECT(cached->was_loaded_from_cache());
+    EXPECT_EQ(cached->version(), compiled->version());
+    EXPECT(MUST(cached->scan("SENTINEL-TEST-MARKER"sv.bytes())).has_matches());
+
+    // Changed sources miss the cache and replace the stale entry
+    sources.append(MUST(ByteBuffer::copy(OTHER_RULE.bytes())));
+    auto recompiled = MUST(CompiledRuleSet::load_or_compile(sources, directory));
+    EXPECT(!recompiled->was_loaded_from_cache());
+    EXPECT_NE(recompiled->version(), compiled->version());
+
+    size_t cache_files = 0;
+    Core::DirIterator iterator(directory, Core::DirIterator::SkipDots);
+    while (iterator.has_next()) {
+        (void)iterator.next_path();
+        ++cache_files;
+    }
+    EXPECT_EQ(cache_files, 1u);
+
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
+
+TEST_CASE(rule_fragments_are_scanned_alongside_the_active_rules)
+{
+    auto directory = ByteString::formatted("/tmp/yara_rule_fragments_test_{}", getpid());
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+    MUST(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes));
+
+    auto write_fragment = [&](StringView name, StringView source) {
+        auto path = ByteString::formatted("{}/{}", directory, name);
+        auto file = MUST(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        MUST(file->write_until_depleted(source.bytes()));
+        return path;
+    };
+
+    auto engine = MUST(YARAScanEngine::create(1));
+    engine->swap_rules(compile_rules(MARKER_RULE));
+    auto base_version = engine->rules_version();
+
+    auto first = write_fragment("first.yar"sv, OTHER_RULE);
+    auto second = write_fragment("second.yar"sv, "rule Fragment_Marker { strings: $m = \"SENTINEL-FRAGMENT-MARKER\" condition: $m }"sv);
+    MUST(engine->update_rule_fragments({ first, second }));
+    EXPECT_EQ(engine->rule_fragment_count(), 2u);
+    EXPECT_NE(engine->rules_version(), base_version);
+
+    auto result = MUST(engine->scan("SENTINEL-TEST-MARKER SENTINEL-OTHER-MARKER SENTINEL-FRAGMENT-MARKER"sv.bytes()));
+    EXPECT_EQ(result.rule_names.size(), 3u);
+    EXPECT_EQ(result.rules_version, engine->rules_version());
+
+    // Changing one fragment only changes what that fragment matches
+    second = write_fragment("second.yar"sv, "rule Fragment_Marker { strings: $m = \"SENTINEL-CHANGED-MARKER\" condition: $m }"sv);
+    auto version_before_change = engine->rules_version();
+    MUST(engine->update_rule_fragments({ first, second }));
+    EXPECT_NE(engine->rules_version(), version_before_change);
+    EXPECT(!MUST(engine->scan("SENTINEL-FRAGMENT-MARKER"sv.bytes())).has_matches());
+    EXPECT(MUST(engine->scan("SENTINEL-CHANGED-MARKER"sv.bytes())).has_matches());
+    EXPECT(MUST(engine->scan("SENTINEL-OTHER-MARKER"sv.bytes())).has_matches());
+
+    // A broken fragment leaves the active fragments untouched
+    auto broken = write_fragment("broken.yar"sv, "rule broken { condition: }"sv);
+    auto version_before_broken = engine->rules_version();
+    EXPECT(engine->update_rule_fragments({ first, second, broken }).is_error());
+    EXPECT_EQ(engine->rules_version(), version_before_broken);
+    EXPECT_EQ(engine->rule_fragment_count(), 2u);
+
+    // Fragments that are no longer listed are dropped
+    MUST(engine->update_rule_fragments({ second }));
+    EXPECT_EQ(engine->rule_fragment_count(), 1u);
+    EXPECT(!MUST(engine->scan("SENTINEL-OTHER-MARKER"sv.bytes())).has_matches());
+
+    MUST(engine->update_rule_fragments({}));
+    EXPECT_EQ(engine->rules_version(), base_version);
+
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
+
+TEST_CASE(async_scans_are_shared_fairly_between_clients)
+{
+    Core::EventLoop loop;
+    auto engine = MUST(YARAScanEngine::create(1));
+    engine->swap_rules(compile_rules(MARKER_RULE));
+
+    // Large enough that the worker can't get through the first client's backlog before the second client's scan
+    // is queued
+    auto content = MUST(ByteBuffer::create_zeroed(4 * MiB));
+
+    static constexpr size_t BACKLOG_SIZE = 16;
+    Vector<int> completion_order;
+    for (size_t i = 0; i < BACKLOG_SIZE; ++i) {
+        engine->scan_async(content.bytes(), [&](ErrorOr<YARAScanResult>) {
+            completion_order.append(1);
+            if (completion_order.size() == BACKLOG_SIZE + 1)
+                loop.quit(0);
+        },
+            1);
+    }
+    engine->scan_async(content.bytes(), [&](ErrorOr<YARAScanResult>) {
+        completion_order.append(2);
+        if (completion_order.size() == BACKLOG_SIZE + 1)
+            loop.quit(0);
+    },
+        2);
+
+    loop.exec();
+    auto second_client_position = completion_order.find_first_index(2);
+    EXPECT(second_client_position.has_value());
+    EXPECT(second_client_position.value() < BACKLOG_SIZE / 2);
+}
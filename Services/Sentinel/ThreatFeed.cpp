@@ -19,8 +19,8 @@ ErrorOr<NonnullOwnPtr<ThreatFeed>> ThreatFeed::create()
 {
     auto feed = adopt_own(*new ThreatFeed());
 
-    // Initialize bloom filter
-    feed->m_filter = TRY(BloomFilter::create(FILTER_SIZE_BITS, FILTER_NUM_HASHES));
+    // Initialize bloom filter; blocked, so each lookup touches a single cache line of the 150MB array
+    feed->m_filter = TRY(BloomFilter::create_blocked(FILTER_SIZE_BITS));
 
     // Initialize IPFS sync (may fail if IPFS not available)
     auto ipfs_result = IPFSThreatSync::create();
@@ -53,7 +53,7 @@ ErrorOr<NonnullOwnPtr<ThreatFeed>> ThreatFeed::create()
     }
 
     dbgln("ThreatFeed: Created with {} MB bloom filter, {} hash functions",
-        FILTER_SIZE_BITS / 8 / 1024 / 1024, FILTER_NUM_HASHES);
+        feed->m_filter->size_bits() / 8 / 1024 / 1024, feed->m_filter->num_hashes());
 
     return feed;
 }
@@ -63,6 +63,17 @@ ThreatFeed::ThreatFeed()
 {
 }
 
+ErrorOr<void> ThreatFeed::ensure_filter_is_writable()
+{
+    if (!m_filter->is_read_only())
+        return {};
+
+    auto filter = TRY(BloomFilter::create_blocked(m_filter->size_bits()));
+    TRY(filter->merge(*m_filter));
+    m_filter = move(filter);
+    return {};
+}
+
 ErrorOr<void> ThreatFeed::add_threat_hash(String const& sha256_hash,
     ThreatCategory category, u32 severity)
 {
@@ -72,6 +83,7 @@ ErrorOr<void> ThreatFeed::add_threat_hash(String const& sha256_hash,
     }
 
     // Add to bloom filter
+    TRY(ensure_filter_is_writable());
     m_filter->add(sha256_hash);
 
     // Update category counter
@@ -324,10 +336,16 @@ ThreatFeed::Statistics ThreatFeed::get_statistics() const
 ErrorOr<void> ThreatFeed::save_to_disk(String const& path) const
 {
     // Save bloom filter
+    // Other processes may have the filter mapped, so the new one is written next to it and renamed over it. Mappings
+    // of the old file stay valid, and nobody can see a half-written filter.
     auto filter_data = TRY(m_filter->serialize());
     auto filter_path = String::formatted("{}.bloom", path).release_value_but_fixme_should_propagate_errors();
-    auto filter_file = TRY(Core::File::open(filter_path, Core::File::OpenMode::Write));
-    TRY(filter_file->write_until_depleted(filter_data));
+    auto temporary_filter_path = String::formatted("{}.tmp", filter_path).release_value_but_fixme_should_propagate_errors();
+    {
+        auto filter_file = TRY(Core::File::open(temporary_filter_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(filter_file->write_until_depleted(filter_data));
+    }
+    TRY(Core::System::rename(temporary_filter_path, filter_path));
 
     // Save metadata and cache
     JsonObject metadata;
@@ -356,10 +374,16 @@ ErrorOr<void> ThreatFeed::save_to_disk(String const& path) const
 ErrorOr<void> ThreatFeed::load_from_disk(String const& path)
 {
     // Load bloom filter
+    // Blocked filters are mapped rather than read, so they only take up memory once no matter how many processes load
+    // them. The mapping is replaced with a private copy the first time a threat is added.
     auto filter_path = String::formatted("{}.bloom", path).release_value_but_fixme_should_propagate_errors();
-    auto filter_file = TRY(Core::File::open(filter_path, Core::File::OpenMode::Read));
-    auto filter_data = TRY(filter_file->read_until_eof());
-    m_filter = TRY(BloomFilter::deserialize(filter_data));
+    if (auto mapped_filter = BloomFilter::map_blocked(filter_path); !mapped_filter.is_error()) {
+        m_filter = mapped_filter.release_value();
+    } else {
+        auto filter_file = TRY(Core::File::open(filter_path, Core::File::OpenMode::Read));
+        auto filter_data = TRY(filter_file->read_until_eof());
+        m_filter = TRY(BloomFilter::deserialize(filter_data));
+    }
 
     // Load metadata
     auto meta_path = String::formatted("{}.meta", path).release_value_but_fixme_should_propagate_errors();
@@ -24,9 +24,8 @@ class IPFSThreatSync;
 
 class ThreatFeed {
 public:
-    // Bloom filter for 100M hashes, 0.1% false positive rate
+    // Blocked bloom filter for 100M hashes
     static constexpr size_t FILTER_SIZE_BITS = 1'200'000'000; // ~150MB
-    static constexpr size_t FILTER_NUM_HASHES = 10;
 
     // Threat categories
     enum class ThreatCategory {
@@ -101,6 +100,9 @@ public:
 private:
     ThreatFeed();
 
+    // Replace a filter mapped by load_from_disk() with a copy that can be added to
+    ErrorOr<void> ensure_filter_is_writable();
+
     // Calculate SHA256 hash of file content
     String calculate_sha256(ReadonlyBytes content) const;
 
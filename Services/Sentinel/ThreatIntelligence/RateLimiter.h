@@ -7,13 +7,14 @@
 
 #include <AK/Error.h>
 #include <AK/Time.h>
+#include <LibCore/RateLimiter.h>
 
 namespace Sentinel::ThreatIntelligence {
 
 using AK::Duration;
 
 // Token bucket rate limiter for API calls
-// Implements configurable rate limiting with token refill
+// Implements configurable rate limiting on top of Core::TokenBucketRateLimiter
 class RateLimiter {
 public:
     // Create rate limiter with max_requests per time_window
@@ -41,10 +42,9 @@ public:
         u64 allowed_requests { 0 };
         u64 denied_requests { 0 };
         u32 current_tokens { 0 };
-        UnixDateTime last_refill;
     };
 
-    Statistics get_statistics() const { return m_stats; }
+    Statistics get_statistics() const;
     void reset_statistics();
 
     // Configuration access
@@ -54,13 +54,10 @@ public:
 private:
     RateLimiter(u32 max_requests, Duration time_window);
 
-    void refill_tokens();
-
     u32 m_max_requests;
     Duration m_time_window;
-    u32 m_current_tokens;
-    UnixDateTime m_last_refill;
-    mutable Statistics m_stats;
+    Core::TokenBucketRateLimiter m_bucket;
+    u64 m_allowed_requests { 0 };
 };
 
 }
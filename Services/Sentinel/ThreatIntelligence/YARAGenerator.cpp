@@ -5,8 +5,13 @@
  */
 
 #include "YARAGenerator.h"
+#include <AK/Array.h>
+#include <AK/CharacterTypes.h>
+#include <AK/QuickSort.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/Directory.h>
 #include <LibCore/File.h>
+#include <LibFileSystem/FileSystem.h>
 
 namespace Sentinel::ThreatIntelligence {
 
@@ -143,6 +148,83 @@ ErrorOr<void> YARAGenerator::generate_rules_file(Vector<PolicyGraph::IOC> const&
     return {};
 }
 
+// Hash IOCs are split up by their first hex digit; anything else lands in the last fragment
+static constexpr size_t FRAGMENT_COUNT = 17;
+
+static size_t fragment_index_for_indicator(StringView indicator)
+{
+    if (indicator.is_empty() || !is_ascii_hex_digit(indicator[0]))
+        return FRAGMENT_COUNT - 1;
+    return parse_ascii_hex_digit(indicator[0]);
+}
+
+ErrorOr<YARAGenerator::FragmentUpdate> YARAGenerator::generate_rule_fragments(Vector<PolicyGraph::IOC> const& iocs,
+    String const& output_directory)
+{
+    Array<Vector<PolicyGraph::IOC const*>, FRAGMENT_COUNT> fragment_iocs;
+    for (auto const& ioc : iocs) {
+        if (ioc.type != PolicyGraph::IOC::Type::FileHash)
+            continue; // Only generate rules for file hashes
+        TRY(fragment_iocs[fragment_index_for_indicator(ioc.indicator)].try_append(&ioc));
+    }
+
+    TRY(Core::Directory::create(output_directory.to_byte_string(), Core::Directory::CreateDirectories::Yes));
+
+    FragmentUpdate update;
+    for (size_t index = 0; index < FRAGMENT_COUNT; ++index) {
+        auto& entries = fragment_iocs[index];
+        auto path = index == FRAGMENT_COUNT - 1
+            ? ByteString::formatted("{}/ioc-hashes-other.yar", output_directory)
+            : ByteString::formatted("{}/ioc-hashes-{:x}.yar", output_directory, index);
+
+        if (entries.is_empty()) {
+            if (FileSystem::exists(path)) {
+                TRY(FileSystem::remove(path, FileSystem::RecursionMode::Disallowed));
+                ++update.changed_fragment_count;
+            }
+            continue;
+        }
+
+        // Feeds return indicators in any order and may repeat them, so sort and deduplicate to keep contents stable
+        quick_sort(entries, [](auto const* a, auto const* b) { return a->indicator.bytes_as_string_view() < b->indicator.bytes_as_string_view(); });
+
+        StringBuilder content;
+        content.append("// Auto-generated YARA rules from IOCs\n\n"sv);
+        Optional<StringView> previous_indicator;
+        for (auto const* ioc : entries) {
+            if (previous_indicator == ioc->indicator.bytes_as_string_view())
+                continue;
+            previous_indicator = ioc->indicator.bytes_as_string_view();
+
+            auto rule_result = generate_hash_rule(*ioc);
+            if (rule_result.is_error()) {
+                dbgln("YARAGenerator: Warning - failed to generate rule for {}: {}",
+                    ioc->indicator, rule_result.error());
+                continue;
+            }
+
+            content.append(rule_result.value());
+            content.append("\n"sv);
+        }
+
+        auto new_content = content.string_view();
+        TRY(update.fragment_paths.try_append(path));
+        if (FileSystem::exists(path)) {
+            auto existing_file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+            if (TRY(existing_file->read_until_eof()).bytes() == new_content.bytes())
+                continue;
+        }
+
+        auto file = TRY(Core::File::open(path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted(new_content.bytes()));
+        ++update.changed_fragment_count;
+    }
+
+    dbgln("YARAGenerator: Generated {} rule fragments in {}, {} of them changed",
+        update.fragment_paths.size(), output_directory, update.changed_fragment_count);
+    return update;
+}
+
 ErrorOr<bool> YARAGenerator::validate_rule_syntax(String const& rule_content)
 {
     // Basic syntax validation
@@ -6,6 +6,7 @@
 
 #pragma once
 
+#include <AK/ByteString.h>
 #include <AK/Error.h>
 #include <AK/String.h>
 #include <AK/Vector.h>
@@ -29,6 +30,18 @@ public:
     static ErrorOr<void> generate_rules_file(Vector<PolicyGraph::IOC> const& iocs,
         String const& output_path);
 
+    struct FragmentUpdate {
+        // Every fragment that holds rules, to pass to YARAScanEngine::update_rule_fragments()
+        Vector<ByteString> fragment_paths;
+        size_t changed_fragment_count { 0 };
+    };
+
+    // Generate rules for file hash IOCs as fragment files in output_directory, one per leading hash digit
+    // Fragment contents only depend on the IOCs in them, and files are only rewritten when their rules changed,
+    // so new indicators only cause the fragments they land in to be recompiled
+    static ErrorOr<FragmentUpdate> generate_rule_fragments(Vector<PolicyGraph::IOC> const& iocs,
+        String const& output_directory);
+
     // Validate YARA rule syntax (basic check)
     static ErrorOr<bool> validate_rule_syntax(String const& rule_content);
 
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "TyposquatIndex.h"
+#include <AK/Array.h>
+#include <AK/BinarySearch.h>
+#include <AK/QuickSort.h>
+#include <AK/StringHash.h>
+
+namespace Sentinel {
+
+static u32 hash_deletion(StringView deletion)
+{
+    return string_hash(deletion.characters_without_null_termination(), deletion.length());
+}
+
+// Calls back with the word itself and every string left after deleting up to deletions_left of its
+// characters at or past first_position. Each set of deleted positions is visited once, but repeated
+// letters can still produce the same string more than once.
+template<typename Callback>
+void TyposquatIndex::for_each_deletion(StringView word, size_t first_position, int deletions_left, Callback& callback)
+{
+    callback(word);
+    if (deletions_left == 0 || word.is_empty())
+        return;
+
+    Array<char, MAX_KEY_LENGTH + MAX_DISTANCE> buffer;
+    auto const* characters = word.characters_without_null_termination();
+    for (size_t position = first_position; position < word.length(); ++position) {
+        __builtin_memcpy(buffer.data(), characters, position);
+        __builtin_memcpy(buffer.data() + position, characters + position + 1, word.length() - position - 1);
+
+        // Later deletions start at the same position, which now holds the character after this one
+        for_each_deletion(StringView(buffer.data(), word.length() - 1), position, deletions_left - 1, callback);
+    }
+}
+
+ErrorOr<TyposquatIndex> TyposquatIndex::create(ReadonlySpan<StringView> keys, int max_distance)
+{
+    if (max_distance < 0 || max_distance > MAX_DISTANCE)
+        return Error::from_string_literal("Typosquat index distance out of range");
+
+    TyposquatIndex index;
+    index.m_max_distance = max_distance;
+    TRY(index.m_keys.try_ensure_capacity(keys.size()));
+
+    Vector<u32> key_hashes;
+    for (size_t key_index = 0; key_index < keys.size(); ++key_index) {
+        auto key = keys[key_index];
+        if (key.length() > MAX_KEY_LENGTH)
+            return Error::from_string_literal("Typosquat index key is too long");
+
+        index.m_keys.unchecked_append(key);
+        index.m_longest_key = max(index.m_longest_key, key.length());
+
+        key_hashes.clear_with_capacity();
+        auto collect = [&](StringView deletion) { key_hashes.append(hash_deletion(deletion)); };
+        for_each_deletion(key, 0, max_distance, collect);
+
+        // Store each distinct deletion of a key once, however many ways it can be reached
+        quick_sort(key_hashes);
+        TRY(index.m_postings.try_ensure_capacity(index.m_postings.size() + key_hashes.size()));
+        for (size_t i = 0; i < key_hashes.size(); ++i) {
+            if (i > 0 && key_hashes[i] == key_hashes[i - 1])
+                continue;
+            index.m_postings.unchecked_append({ key_hashes[i], static_cast<u32>(key_index) });
+        }
+    }
+
+    quick_sort(index.m_postings, [](Posting const& a, Posting const& b) {
+        if (a.deletion_hash != b.deletion_hash)
+            return a.deletion_hash < b.deletion_hash;
+        return a.key_index < b.key_index;
+    });
+
+    return index;
+}
+
+Optional<TyposquatIndex::Match> TyposquatIndex::find_closest(StringView query) const
+{
+    // Nothing can be within max_distance of a query this much longer than every key
+    if (m_keys.is_empty() || query.length() > m_longest_key + m_max_distance)
+        return {};
+
+    Vector<u32, 64> candidates;
+    auto look_up = [&](StringView deletion) {
+        auto hash = hash_deletion(deletion);
+        auto position = lower_bound_index(m_postings, hash, [](Posting const& posting, u32 needle) {
+            if (posting.deletion_hash == needle)
+                return 0;
+            return posting.deletion_hash < needle ? -1 : 1;
+        });
+        for (; position < m_postings.size() && m_postings[position].deletion_hash == hash; ++position)
+            candidates.append(m_postings[position].key_index);
+    };
+    for_each_deletion(query, 0, m_max_distance, look_up);
+
+    if (candidates.is_empty())
+        return {};
+
+    // Verify candidates in key order, only accepting strictly closer ones so ties keep the first key.
+    // Hash collisions merely add candidates; the verification rejects them.
+    quick_sort(candidates);
+    Optional<Match> best;
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        if (i > 0 && candidates[i] == candidates[i - 1])
+            continue;
+
+        auto bound = best.has_value() ? best->distance - 1 : m_max_distance;
+        if (bound < 0)
+            break;
+
+        if (auto distance = bounded_levenshtein_distance(query, m_keys[candidates[i]], bound); distance.has_value())
+            best = Match { candidates[i], *distance };
+    }
+
+    return best;
+}
+
+Optional<int> TyposquatIndex::bounded_levenshtein_distance(StringView a, StringView b, int max_distance)
+{
+    if (max_distance < 0)
+        return {};
+
+    size_t const m = a.length();
+    size_t const n = b.length();
+    size_t const band = static_cast<size_t>(max_distance);
+    if ((m > n ? m - n : n - m) > band)
+        return {};
+
+    // Cells outside the band hold max_distance + 1, which is as good as infinity here
+    int const out_of_band = max_distance + 1;
+
+    // Two rows, swapped after each one; inline capacity covers any domain-sized string
+    Vector<int, 2 * (MAX_KEY_LENGTH + MAX_DISTANCE + 1)> rows;
+    rows.resize(2 * (n + 1));
+    int* previous = rows.data();
+    int* current = previous + n + 1;
+    for (size_t j = 0; j <= n; ++j)
+        previous[j] = j <= band ? static_cast<int>(j) : out_of_band;
+
+    for (size_t i = 1; i <= m; ++i) {
+        size_t const first = i > band ? i - band : 1;
+        size_t const last = min(n, i + band);
+
+        current[0] = i <= band ? static_cast<int>(i) : out_of_band;
+        current[first - 1] = first > 1 ? out_of_band : current[0];
+        int row_minimum = current[first - 1];
+
+        for (size_t j = first; j <= last; ++j) {
+            int cost = a[i - 1] == b[j - 1] ? 0 : 1;
+            int value = min(previous[j - 1] + cost, min(previous[j], current[j - 1]) + 1);
+            current[j] = min(value, out_of_band);
+            row_minimum = min(row_minimum, current[j]);
+        }
+        if (last < n)
+            current[last + 1] = out_of_band;
+
+        // Distances never shrink from one row to the next, so this row decides the outcome
+        if (row_minimum > max_distance)
+            return {};
+
+        swap(previous, current);
+    }
+
+    if (previous[n] > max_distance)
+        return {};
+    return previous[n];
+}
+
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <AK/Optional.h>
+#include <AK/Span.h>
+#include <AK/Types.h>
+#include <AK/Vector.h>
+
+namespace Sentinel {
+
+// Finds the key closest to a query by edit distance, without comparing the query against every key.
+//
+// This is a symmetric deletion index: every string reachable from a key by deleting up to
+// max_distance characters is hashed and stored once at build time. Two strings within edit distance
+// k always share such a deletion (a substitution is a deletion on both sides, an insertion is a
+// deletion on the other), so a query only has to look up its own deletions to find every key that
+// could be close to it. Those candidates are then verified with a banded Levenshtein that gives up
+// as soon as the distance is known to exceed the bound.
+//
+// Usage:
+//   auto index = TRY(TyposquatIndex::create(keys));
+//   if (auto match = index.find_closest("paypai"sv); match.has_value())
+//       dbgln("{} at distance {}", keys[match->index], match->distance);
+class TyposquatIndex {
+public:
+    static constexpr size_t MAX_KEY_LENGTH = 64;
+    static constexpr int MAX_DISTANCE = 4;
+
+    struct Match {
+        size_t index { 0 }; // Position of the key in the list passed to create()
+        int distance { 0 };
+    };
+
+    TyposquatIndex() = default;
+
+    static ErrorOr<TyposquatIndex> create(ReadonlySpan<StringView> keys, int max_distance = 3);
+
+    // Key with the smallest edit distance to the query, if any is within max_distance.
+    // Ties go to the key that came first.
+    Optional<Match> find_closest(StringView query) const;
+
+    size_t key_count() const { return m_keys.size(); }
+    int max_distance() const { return m_max_distance; }
+
+    // Levenshtein distance between a and b, or nothing once it is known to exceed max_distance.
+    // Only the diagonal band of width 2 * max_distance + 1 is computed.
+    static Optional<int> bounded_levenshtein_distance(StringView a, StringView b, int max_distance);
+
+private:
+    struct Posting {
+        u32 deletion_hash { 0 };
+        u32 key_index { 0 };
+    };
+
+    template<typename Callback>
+    static void for_each_deletion(StringView word, size_t first_position, int deletions_left, Callback& callback);
+
+    Vector<ByteString> m_keys;
+    Vector<Posting> m_postings; // Sorted by hash, then key
+    size_t m_longest_key { 0 };
+    int m_max_distance { 0 };
+};
+
+}
@@ -0,0 +1,617 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "YARAScanEngine.h"
+#include <AK/Atomic.h>
+#include <AK/LexicalPath.h>
+#include <AK/ScopeGuard.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/System.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibThreading/ThreadPool.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <yara.h>
+
+// Undefine YARA macros that conflict with AK classes
+#ifdef get_string
+#    undef get_string
+#endif
+#ifdef set
+#    undef set
+#endif
+
+namespace Sentinel {
+
+static u64 compute_rules_version(Vector<ByteBuffer> const& sources)
+{
+    // FNV-1a; 0 is reserved for "unknown"
+    u64 hash = 0xcbf29ce484222325ULL;
+    for (auto const& source : sources) {
+        for (auto byte : source.bytes()) {
+            hash ^= byte;
+            hash *= 0x100000001b3ULL;
+        }
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+static u64 compute_cache_key(u64 rules_version)
+{
+    // Compiled rules are only loadable by the libyara version that saved them
+    u64 hash = rules_version;
+    for (auto byte : StringView { YR_VERSION, strlen(YR_VERSION) }.bytes()) {
+        hash ^= byte;
+        hash *= 0x100000001b3ULL;
+    }
+    hash ^= sizeof(void*);
+    hash *= 0x100000001b3ULL;
+    return hash;
+}
+
+static int yara_callback([[maybe_unused]] YR_SCAN_CONTEXT* context, int message, void* message_data, void* user_data)
+{
+    if (message == CALLBACK_MSG_RULE_MATCHING) {
+        auto* rule = static_cast<YR_RULE*>(message_data);
+        auto* result = static_cast<YARAScanResult*>(user_data);
+
+        result->rule_names.append(ByteString(rule->identifier));
+
+        // Extract rule metadata
+        JsonObject rule_obj;
+        rule_obj.set("rule_name"sv, JsonValue(StringView { rule->identifier, strlen(rule->identifier) }));
+
+        auto add_metadata = [&](YR_META const* meta) {
+            if (meta->type != META_TYPE_STRING)
+                return;
+            if (strcmp(meta->identifier, "description") == 0)
+                rule_obj.set("description"sv, JsonValue(StringView { meta->string, strlen(meta->string) }));
+            else if (strcmp(meta->identifier, "severity") == 0)
+                rule_obj.set("severity"sv, JsonValue(StringView { meta->string, strlen(meta->string) }));
+            else if (strcmp(meta->identifier, "author") == 0)
+                rule_obj.set("author"sv, JsonValue(StringView { meta->string, strlen(meta->string) }));
+        };
+
+        // Get metadata with safety limit to prevent infinite loops
+        YR_META* meta = rule->metas;
+        constexpr int MAX_METADATA_ENTRIES = 100; // Safety limit
+        int meta_count = 0;
+
+        while (!META_IS_LAST_IN_RULE(meta) && meta_count < MAX_METADATA_ENTRIES) {
+            add_metadata(meta);
+            meta++;
+            meta_count++;
+        }
+
+        // Handle the last metadata entry (only if we didn't hit the safety limit)
+        if (meta_count < MAX_METADATA_ENTRIES)
+            add_metadata(meta);
+
+        result->rule_details.append(move(rule_obj));
+    }
+    return CALLBACK_CONTINUE;
+}
+
+ErrorOr<NonnullRefPtr<CompiledRuleSet>> CompiledRuleSet::compile(Vector<ByteBuffer> const& sources, StringView rule_namespace)
+{
+    if (sources.is_empty())
+        return Error::from_string_literal("No YARA rule sources to compile");
+
+    YR_COMPILER* compiler = nullptr;
+    if (yr_compiler_create(&compiler) != ERROR_SUCCESS)
+        return Error::from_string_literal("Failed to create YARA compiler");
+    ScopeGuard destroy_compiler = [&] { yr_compiler_destroy(compiler); };
+
+    ByteString namespace_string { rule_namespace };
+    for (auto const& source : sources) {
+        // yr_compiler_add_string() wants a null-terminated string
+        ByteString source_string { source.bytes() };
+        if (yr_compiler_add_string(compiler, source_string.characters(), rule_namespace.is_empty() ? nullptr : namespace_string.characters()) != 0)
+            return Error::from_string_literal("Failed to compile YARA rules");
+    }
+
+    YR_RULES* rules = nullptr;
+    if (yr_compiler_get_rules(compiler, &rules) != ERROR_SUCCESS)
+        return Error::from_string_literal("Failed to get compiled YARA rules");
+
+    return adopt_ref(*new CompiledRuleSet(rules, compute_rules_version(sources)));
+}
+
+ErrorOr<NonnullRefPtr<CompiledRuleSet>> CompiledRuleSet::load_or_compile(Vector<ByteBuffer> const& sources, ByteString const& cache_directory)
+{
+    auto version = compute_rules_version(sources);
+    auto path = ByteString::formatted("{}/{}{:016x}{}", cache_directory, CACHE_FILE_PREFIX, compute_cache_key(version), CACHE_FILE_EXTENSION);
+
+    if (FileSystem::exists(path)) {
+        auto cached = load_from_cache(path, version);
+        if (!cached.is_error())
+            return cached.release_value();
+
+        dbgln("CompiledRuleSet: Discarding unusable compiled rules {}: {}", path, cached.error());
+        (void)FileSystem::remove(path, FileSystem::RecursionMode::Disallowed);
+    }
+
+    auto rule_set = TRY(compile(sources));
+    rule_set->save_to_cache(cache_directory, path);
+    return rule_set;
+}
+
+ErrorOr<NonnullRefPtr<CompiledRuleSet>> CompiledRuleSet::load_from_cache(ByteString const& path, u64 version)
+{
+    // SECURITY: libyara trusts compiled rule files completely, so only load ones that nobody but us could have written
+    auto stat = TRY(Core::System::lstat(path));
+    if (!S_ISREG(stat.st_mode) || stat.st_uid != geteuid() || (stat.st_mode & (S_IWGRP | S_IWOTH)) != 0)
+        return Error::from_string_literal("Compiled rules file has unsafe ownership or permissions");
+
+    YR_RULES* rules = nullptr;
+    if (yr_rules_load(path.characters(), &rules) != ERROR_SUCCESS)
+        return Error::from_string_literal("Failed to load compiled YARA rules");
+
+    return adopt_ref(*new CompiledRuleSet(rules, version, true));
+}
+
+void CompiledRuleSet::save_to_cache(ByteString const& cache_directory, ByteString const& path) const
+{
+    // The cache only speeds up startup, so failing to write it is not an error
+    if (auto result = Core::Directory::create(cache_directory, Core::Directory::CreateDirectories::Yes, 0700); result.is_error()) {
+        dbgln("CompiledRuleSet: Failed to create cache directory {}: {}", cache_directory, result.error());
+        return;
+    }
+
+    // Write to a temporary file first, so a concurrent or interrupted save never leaves a torn file behind
+    auto temporary_path = ByteString::formatted("{}.{}.tmp", path, getpid());
+    if (yr_rules_save(m_rules, temporary_path.characters()) != ERROR_SUCCESS) {
+        dbgln("CompiledRuleSet: Failed to save compiled rules to {}", temporary_path);
+        (void)FileSystem::remove(temporary_path, FileSystem::RecursionMode::Disallowed);
+        return;
+    }
+    (void)Core::System::chmod(temporary_path, 0600);
+
+    if (auto result = Core::System::rename(temporary_path, path); result.is_error()) {
+        dbgln("CompiledRuleSet: Failed to move compiled rules into place: {}", result.error());
+        (void)FileSystem::remove(temporary_path, FileSystem::RecursionMode::Disallowed);
+        return;
+    }
+
+    // Only the current rule set is worth keeping
+    Core::DirIterator iterator(cache_directory, Core::DirIterator::SkipDots);
+    while (iterator.has_next()) {
+        auto entry_path = iterator.next_full_path();
+        auto name = LexicalPath::basename(entry_path);
+        if (entry_path == path || !name.starts_with(CACHE_FILE_PREFIX) || !name.ends_with(CACHE_FILE_EXTENSION))
+            continue;
+        (void)FileSystem::remove(entry_path, FileSystem::RecursionMode::Disallowed);
+    }
+}
+
+CompiledRuleSet::CompiledRuleSet(YR_RULES* rules, u64 version, bool loaded_from_cache)
+    : m_rules(rules)
+    , m_version(version)
+    , m_loaded_from_cache(loaded_from_cache)
+{
+}
+
+CompiledRuleSet::~CompiledRuleSet()
+{
+    // Every scan holds a reference, so all scanners are idle by now
+    for (auto* scanner : m_idle_scanners)
+        yr_scanner_destroy(scanner);
+    yr_rules_destroy(m_rules);
+}
+
+ErrorOr<YR_SCAN_CONTEXT*> CompiledRuleSet::take_scanner() const
+{
+    {
+        Sync::MutexLocker locker(m_scanner_mutex);
+        if (!m_idle_scanners.is_empty())
+            return m_idle_scanners.take_last();
+    }
+
+    YR_SCANNER* scanner = nullptr;
+    if (yr_scanner_create(m_rules, &scanner) != ERROR_SUCCESS)
+        return Error::from_string_literal("Failed to create YARA scanner");
+    return scanner;
+}
+
+void CompiledRuleSet::return_scanner(YR_SCAN_CONTEXT* scanner) const
+{
+    Sync::MutexLocker locker(m_scanner_mutex);
+    m_idle_scanners.append(scanner);
+}
+
+ErrorOr<YARAScanResult> CompiledRuleSet::scan(ReadonlyBytes content) const
+{
+    auto* scanner = TRY(take_scanner());
+    ScopeGuard return_to_pool = [&] { return_scanner(scanner); };
+
+    YARAScanResult result;
+    result.rules_version = m_version;
+    yr_scanner_set_callback(scanner, yara_callback, &result);
+    yr_scanner_set_flags(scanner, 0);
+
+    auto scan_window = [&](ReadonlyBytes window) -> ErrorOr<void> {
+        if (yr_scanner_scan_mem(scanner, window.data(), window.size()) != ERROR_SUCCESS)
+            return Error::from_string_literal("YARA scan failed");
+        return {};
+    };
+
+    if (content.size() <= YARAScanEngine::WINDOWED_SCAN_THRESHOLD) {
+        TRY(scan_window(content));
+        return result;
+    }
+
+    // Scan large inputs window by window, stopping at the first window with a match
+    size_t offset = 0;
+    while (offset < content.size()) {
+        auto window_size = min(YARAScanEngine::SCAN_WINDOW_SIZE, content.size() - offset);
+        TRY(scan_window(content.slice(offset, window_size)));
+
+        if (result.has_matches() || offset + window_size >= content.size())
+            break;
+        offset += window_size - YARAScanEngine::SCAN_WINDOW_OVERLAP;
+    }
+    return result;
+}
+
+struct YARAScanEngine::RuleFragments : public AtomicRefCounted<RuleFragments> {
+    struct Fragment {
+        ByteString path;
+        NonnullRefPtr<CompiledRuleSet> rules;
+    };
+
+    Vector<Fragment> fragments;
+    u64 version { 0 };
+};
+
+namespace {
+
+// Shared between the thread updating fragments and the pool threads helping it compile them. A helper may only get to
+// run after every fragment is compiled and update_rule_fragments() has returned, so everything it touches lives here.
+struct FragmentCompileWork : public AtomicRefCounted<FragmentCompileWork> {
+    struct Item {
+        ByteString rule_namespace;
+        Vector<ByteBuffer> sources;
+        RefPtr<CompiledRuleSet> rules;
+        Optional<Error> error;
+    };
+
+    Vector<Item> items;
+    Atomic<size_t> next_item { 0 };
+
+    Sync::Mutex mutex;
+    Sync::ConditionVariable helpers_done { mutex };
+    size_t active_helper_count { 0 };
+    bool finished { false };
+
+    void compile_until_done()
+    {
+        while (true) {
+            auto index = next_item.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+            if (index >= items.size())
+                return;
+            auto& item = items[index];
+            auto rules = CompiledRuleSet::compile(item.sources, item.rule_namespace);
+            if (rules.is_error())
+                item.error = rules.release_error();
+            else
+                item.rules = rules.release_value();
+        }
+    }
+
+    bool join()
+    {
+        Sync::MutexLocker locker(mutex);
+        if (finished)
+            return false;
+        ++active_helper_count;
+        return true;
+    }
+
+    void leave()
+    {
+        Sync::MutexLocker locker(mutex);
+        --active_helper_count;
+        helpers_done.broadcast();
+    }
+
+    void finish_and_wait_for_helpers()
+    {
+        Sync::MutexLocker locker(mutex);
+        finished = true;
+        helpers_done.wait_while([this] { return active_helper_count > 0; });
+    }
+};
+
+}
+
+YARAScanEngine::YARAScanEngine() = default;
+
+ErrorOr<NonnullOwnPtr<YARAScanEngine>> YARAScanEngine::create(size_t worker_count)
+{
+    if (yr_initialize() != ERROR_SUCCESS)
+        return Error::from_string_literal("Failed to initialize YARA");
+
+    if (worker_count == 0)
+        worker_count = Core::System::hardware_concurrency();
+    worker_count = clamp(worker_count, 1uz, MAX_WORKER_COUNT);
+
+    auto engine = adopt_own(*new YARAScanEngine);
+    for (size_t i = 0; i < worker_count; ++i) {
+        auto worker = TRY(Threading::Thread::try_create(ByteString::formatted("YARAScan/{}", i), [engine = engine.ptr()]() -> intptr_t {
+            return engine->worker_thread_func();
+        }));
+        worker->start();
+        engine->m_workers.append(move(worker));
+    }
+
+    dbgln("YARAScanEngine: Started {} scan workers", worker_count);
+    return engine;
+}
+
+YARAScanEngine::~YARAScanEngine()
+{
+    // Take the jobs no worker has started on, so they can be failed rather than silently dropped
+    Vector<Job> pending_jobs;
+    {
+        Sync::MutexLocker locker(m_queue_mutex);
+        m_shutting_down = true;
+        while (!m_clients_with_jobs.is_empty()) {
+            auto client_id = m_clients_with_jobs.dequeue();
+            auto queue = m_client_queues.take(client_id);
+            if (!queue.has_value())
+                continue;
+            while (!(*queue)->is_empty())
+                pending_jobs.append((*queue)->dequeue());
+        }
+        m_client_queues.clear();
+        m_queue_condition.broadcast();
+    }
+
+    for (auto& worker : m_workers)
+        (void)worker->join();
+
+    // NB: Complete every job here rather than on a worker, so their callbacks run on, and their captures are destroyed
+    //     on, the event loop that queued them before the engine goes away.
+    for (auto& finished_job : m_jobs_finished_during_shutdown)
+        complete_job(move(finished_job.job), move(finished_job.result));
+    m_jobs_finished_during_shutdown.clear();
+    for (auto& job : pending_jobs)
+        complete_job(move(job), Error::from_string_literal("YARA scan engine is shutting down"));
+
+    // Release the rules before tearing libyara down
+    m_rules = nullptr;
+    m_rule_fragments = nullptr;
+    yr_finalize();
+}
+
+ErrorOr<void> YARAScanEngine::load_rules_from_files(Vector<ByteString> const& paths)
+{
+    Vector<ByteBuffer> sources;
+    for (auto const& path : paths) {
+        auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+        TRY(sources.try_append(TRY(file->read_until_eof())));
+    }
+
+    if (m_compiled_rules_cache_directory.has_value())
+        swap_rules(TRY(CompiledRuleSet::load_or_compile(sources, *m_compiled_rules_cache_directory)));
+    else
+        swap_rules(TRY(CompiledRuleSet::compile(sources)));
+    return {};
+}
+
+void YARAScanEngine::swap_rules(NonnullRefPtr<CompiledRuleSet> rules)
+{
+    auto version = rules->version();
+    RefPtr<CompiledRuleSet> previous_rules;
+    {
+        Sync::MutexLocker locker(m_rules_mutex);
+        previous_rules = exchange(m_rules, move(rules));
+    }
+
+    // The previous rule set is destroyed once the last scan using it finishes, possibly right here
+    dbgln("YARAScanEngine: Activated rule set {:016x}", version);
+}
+
+ErrorOr<void> YARAScanEngine::update_rule_fragments(Vector<ByteString> const& paths)
+{
+    RefPtr<RuleFragments const> previous_fragments;
+    {
+        Sync::MutexLocker locker(m_rules_mutex);
+        previous_fragments = m_rule_fragments;
+    }
+
+    struct PendingFragment {
+        ByteString path;
+        RefPtr<CompiledRuleSet> rules;
+        Optional<size_t> work_item_index;
+    };
+    Vector<PendingFragment> pending_fragments;
+    auto work = adopt_ref(*new FragmentCompileWork);
+
+    for (auto const& path : paths) {
+        auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+        Vector<ByteBuffer> sources;
+        TRY(sources.try_append(TRY(file->read_until_eof())));
+
+        // Unchanged fragments keep the rule set they were compiled into last time
+        if (previous_fragments) {
+            auto version = compute_rules_version(sources);
+            auto previous = previous_fragments->fragments.find_if([&](auto const& fragment) {
+                return fragment.path == path && fragment.rules->version() == version;
+            });
+            if (!previous.is_end()) {
+                pending_fragments.append({ path, previous->rules, {} });
+                continue;
+            }
+        }
+
+        pending_fragments.append({ path, nullptr, work->items.size() });
+        work->items.append({ .rule_namespace = LexicalPath::title(path), .sources = move(sources), .rules = {}, .error = {} });
+    }
+
+    // Compilation is the slow part, so changed fragments are compiled on the thread pool and this thread at once
+    auto thread_count = min(work->items.size(), static_cast<size_t>(Core::System::hardware_concurrency()));
+    for (size_t i = 1; i < thread_count; ++i) {
+        Threading::ThreadPool::the().submit(
+            [work] {
+                if (!work->join())
+                    return;
+                work->compile_until_done();
+                work->leave();
+            },
+            Threading::ThreadPool::Priority::UserVisible);
+    }
+    work->compile_until_done();
+    work->finish_and_wait_for_helpers();
+
+    auto fragments = adopt_ref(*new RuleFragments);
+    for (auto& pending : pending_fragments) {
+        if (pending.work_item_index.has_value()) {
+            auto& item = work->items[*pending.work_item_index];
+            if (item.error.has_value()) {
+                dbgln("YARAScanEngine: Failed to compile rule fragment {}: {}", pending.path, *item.error);
+                return item.error.release_value();
+            }
+            pending.rules = move(item.rules);
+        }
+        TRY(fragments->fragments.try_append({ move(pending.path), pending.rules.release_nonnull() }));
+    }
+
+    // Without fragments, the version is just the active rule set's
+    if (!fragments->fragments.is_empty()) {
+        u64 version = 0xcbf29ce484222325ULL;
+        for (auto const& fragment : fragments->fragments) {
+            version ^= fragment.rules->version();
+            version *= 0x100000001b3ULL;
+        }
+        fragments->version = version == 0 ? 1 : version;
+    }
+
+    {
+        Sync::MutexLocker locker(m_rules_mutex);
+        m_rule_fragments = move(fragments);
+    }
+
+    dbgln("YARAScanEngine: Activated {} rule fragments, {} of them recompiled", paths.size(), work->items.size());
+    return {};
+}
+
+size_t YARAScanEngine::rule_fragment_count() const
+{
+    Sync::MutexLocker locker(m_rules_mutex);
+    return m_rule_fragments ? m_rule_fragments->fragments.size() : 0;
+}
+
+RefPtr<CompiledRuleSet> YARAScanEngine::rules() const
+{
+    Sync::MutexLocker locker(m_rules_mutex);
+    return m_rules;
+}
+
+static u64 combined_rules_version(u64 rules_version, u64 fragments_version)
+{
+    if (fragments_version == 0)
+        return rules_version;
+    auto version = (rules_version ^ fragments_version) * 0x100000001b3ULL;
+    return version == 0 ? 1 : version;
+}
+
+u64 YARAScanEngine::rules_version() const
+{
+    Sync::MutexLocker locker(m_rules_mutex);
+    if (!m_rules)
+        return 0;
+    return combined_rules_version(m_rules->version(), m_rule_fragments ? m_rule_fragments->version : 0);
+}
+
+ErrorOr<YARAScanResult> YARAScanEngine::scan(ReadonlyBytes content) const
+{
+    RefPtr<CompiledRuleSet> current_rules;
+    RefPtr<RuleFragments const> current_fragments;
+    {
+        Sync::MutexLocker locker(m_rules_mutex);
+        current_rules = m_rules;
+        current_fragments = m_rule_fragments;
+    }
+    if (!current_rules)
+        return Error::from_string_literal("YARA rules not initialized");
+
+    auto result = TRY(current_rules->scan(content));
+    if (!current_fragments)
+        return result;
+
+    for (auto const& fragment : current_fragments->fragments) {
+        auto fragment_result = TRY(fragment.rules->scan(content));
+        result.rule_names.extend(move(fragment_result.rule_names));
+        result.rule_details.extend(move(fragment_result.rule_details));
+    }
+    result.rules_version = combined_rules_version(result.rules_version, current_fragments->version);
+    return result;
+}
+
+void YARAScanEngine::scan_async(ReadonlyBytes content, ScanCallback on_complete, int client_id)
+{
+    Sync::MutexLocker locker(m_queue_mutex);
+    auto& queue = m_client_queues.ensure(client_id, [] { return make<Queue<Job>>(); });
+    if (queue->is_empty())
+        m_clients_with_jobs.enqueue(client_id);
+    queue->enqueue(Job { .content = content, .on_complete = move(on_complete), .origin = Core::EventLoop::current_weak() });
+    m_queue_condition.signal();
+}
+
+intptr_t YARAScanEngine::worker_thread_func()
+{
+    while (true) {
+        Optional<Job> job;
+        {
+            Sync::MutexLocker locker(m_queue_mutex);
+            m_queue_condition.wait_while([this] { return m_clients_with_jobs.is_empty() && !m_shutting_down; });
+            if (m_shutting_down)
+                return 0;
+
+            // Take the next client's oldest job, and send the client to the back of the line if it has more
+            auto client_id = m_clients_with_jobs.dequeue();
+            auto* queue = m_client_queues.get(client_id).value();
+            job = queue->dequeue();
+            if (queue->is_empty())
+                m_client_queues.remove(client_id);
+            else
+                m_clients_with_jobs.enqueue(client_id);
+        }
+
+        auto result = scan(job->content);
+
+        {
+            Sync::MutexLocker locker(m_queue_mutex);
+            if (m_shutting_down) {
+                m_jobs_finished_during_shutdown.append({ .job = job.release_value(), .result = move(result) });
+                return 0;
+            }
+        }
+
+        complete_job(job.release_value(), move(result));
+    }
+}
+
+void YARAScanEngine::complete_job(Job job, ErrorOr<YARAScanResult> result)
+{
+    auto origin = job.origin->take();
+    if (!origin)
+        return;
+
+    if (Core::EventLoop::is_running() && *origin == &Core::EventLoop::current()) {
+        job.on_complete(move(result));
+        return;
+    }
+
+    origin->deferred_invoke([on_complete = move(job.on_complete), result = move(result)]() mutable {
+        on_complete(move(result));
+    });
+}
+
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/AtomicRefCounted.h>
+#include <AK/ByteBuffer.h>
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <AK/Function.h>
+#include <AK/HashMap.h>
+#include <AK/JsonObject.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/NonnullRefPtr.h>
+#include <AK/Optional.h>
+#include <AK/Queue.h>
+#include <AK/RefPtr.h>
+#include <AK/StringView.h>
+#include <AK/Vector.h>
+#include <LibCore/EventLoop.h>
+#include <LibSync/ConditionVariable.h>
+#include <LibSync/Mutex.h>
+#include <LibThreading/Thread.h>
+
+// libyara types; yara.h itself stays private to sentinelservice
+struct YR_RULES;
+struct YR_SCAN_CONTEXT;
+
+namespace Sentinel {
+
+struct YARAScanResult {
+    Vector<ByteString> rule_names;
+    Vector<JsonObject> rule_details;
+
+    // Version of the rule set that produced this result (see CompiledRuleSet::version())
+    u64 rules_version { 0 };
+
+    bool has_matches() const { return !rule_names.is_empty(); }
+};
+
+// One compiled, immutable YARA rule set.
+//
+// YR_RULES may be scanned from any number of threads at once, but a YR_SCANNER may only be used by one
+// thread at a time, so each rule set keeps a pool of idle scanners that scans check out and return.
+// Scans hold a reference to the rule set they started with, so swapping in new rules never pulls
+// the rules out from under a running scan.
+class CompiledRuleSet : public AtomicRefCounted<CompiledRuleSet> {
+public:
+    // Rules are compiled into rule_namespace if one is given, so their names can't clash with other rule sets'
+    static ErrorOr<NonnullRefPtr<CompiledRuleSet>> compile(Vector<ByteBuffer> const& sources, StringView rule_namespace = {});
+
+    // Load the rules compiled by an earlier run from cache_directory, or compile them and save the
+    // result there. Cache files are keyed on the rule sources and the libyara version.
+    static ErrorOr<NonnullRefPtr<CompiledRuleSet>> load_or_compile(Vector<ByteBuffer> const& sources, ByteString const& cache_directory);
+
+    ~CompiledRuleSet();
+
+    // Hash of the rule sources; never 0, which clients use for "unknown"
+    u64 version() const { return m_version; }
+
+    bool was_loaded_from_cache() const { return m_loaded_from_cache; }
+
+    static constexpr StringView CACHE_FILE_PREFIX = "compiled-rules-"sv;
+    static constexpr StringView CACHE_FILE_EXTENSION = ".yarc"sv;
+
+    ErrorOr<YARAScanResult> scan(ReadonlyBytes content) const;
+
+private:
+    CompiledRuleSet(YR_RULES*, u64 version, bool loaded_from_cache = false);
+
+    static ErrorOr<NonnullRefPtr<CompiledRuleSet>> load_from_cache(ByteString const& path, u64 version);
+    void save_to_cache(ByteString const& cache_directory, ByteString const& path) const;
+
+    ErrorOr<YR_SCAN_CONTEXT*> take_scanner() const;
+    void return_scanner(YR_SCAN_CONTEXT*) const;
+
+    YR_RULES* m_rules { nullptr };
+    u64 m_version { 0 };
+    bool m_loaded_from_cache { false };
+
+    mutable Sync::Mutex m_scanner_mutex;
+    mutable Vector<YR_SCAN_CONTEXT*> m_idle_scanners;
+};
+
+// Multi-threaded YARA scan engine.
+//
+// Scans submitted with scan_async() run on a pool of worker threads and complete on the event loop
+// that submitted them, so scan throughput scales with the number of cores rather than being bound
+// to Sentinel's event loop. The active rule set can be hot-swapped at any time (e.g. after
+// ThreatIntelligence::YARAGenerator has written new rules); scans already running finish with the
+// rules they started with.
+class YARAScanEngine {
+public:
+    using ScanCallback = Function<void(ErrorOr<YARAScanResult>)>;
+
+    // worker_count of 0 means one worker per core
+    static ErrorOr<NonnullOwnPtr<YARAScanEngine>> create(size_t worker_count = 0);
+    ~YARAScanEngine();
+
+    // Compile the given rule files into one rule set and make it active
+    ErrorOr<void> load_rules_from_files(Vector<ByteString> const& paths);
+
+    // Keep compiled rule sets in this directory, so later runs can skip compiling unchanged rules
+    void set_compiled_rules_cache_directory(ByteString directory) { m_compiled_rules_cache_directory = move(directory); }
+    void swap_rules(NonnullRefPtr<CompiledRuleSet>);
+
+    // Scan with rule fragment files (e.g. the ones ThreatIntelligence::YARAGenerator writes) on top of the active
+    // rule set. Each fragment is compiled into its own rule set and namespace, so an update only recompiles the
+    // fragments whose source changed, in parallel, and swaps them in without touching the rest. Fragments missing
+    // from `paths` are dropped; if any fragment fails to compile, the active fragments are left untouched.
+    ErrorOr<void> update_rule_fragments(Vector<ByteString> const& paths);
+    size_t rule_fragment_count() const;
+
+    RefPtr<CompiledRuleSet> rules() const;
+
+    // Combines the versions of the active rule set and fragments
+    u64 rules_version() const;
+
+    // Scan on the calling thread
+    ErrorOr<YARAScanResult> scan(ReadonlyBytes content) const;
+
+    // Scan on a worker thread; on_complete is invoked on the calling thread's event loop.
+    // content must stay valid until on_complete has been invoked. Destroying the engine fails the scans that haven't
+    // finished yet, so every on_complete is invoked, unless its event loop is gone.
+    // Scans are queued per client_id and workers take one from each client in turn, so a client with many scans
+    // queued doesn't hold up the others.
+    void scan_async(ReadonlyBytes content, ScanCallback on_complete, int client_id = 0);
+
+    size_t worker_count() const { return m_workers.size(); }
+
+    // Large inputs are scanned in windows of this size, overlapping so that matches spanning a
+    // window boundary are still found, and the scan stops at the first window with a match
+    static constexpr size_t WINDOWED_SCAN_THRESHOLD = 10 * 1024 * 1024;
+    static constexpr size_t SCAN_WINDOW_SIZE = 1 * 1024 * 1024;
+    static constexpr size_t SCAN_WINDOW_OVERLAP = 4096;
+
+    // libyara caps the number of threads that may scan concurrently
+    static constexpr size_t MAX_WORKER_COUNT = 16;
+
+private:
+    YARAScanEngine();
+
+    struct Job {
+        ReadonlyBytes content;
+        ScanCallback on_complete;
+        NonnullRefPtr<Core::WeakEventLoopReference> origin;
+    };
+
+    // An immutable snapshot of the active fragments, so scans can hold on to them without copying
+    struct RuleFragments;
+
+    struct FinishedJob {
+        Job job;
+        ErrorOr<YARAScanResult> result;
+    };
+
+    intptr_t worker_thread_func();
+    static void complete_job(Job, ErrorOr<YARAScanResult>);
+
+    mutable Sync::Mutex m_rules_mutex;
+    RefPtr<CompiledRuleSet> m_rules;
+    RefPtr<RuleFragments const> m_rule_fragments;
+    Optional<ByteString> m_compiled_rules_cache_directory;
+
+    Sync::Mutex m_queue_mutex;
+    Sync::ConditionVariable m_queue_condition { m_queue_mutex };
+    HashMap<int, NonnullOwnPtr<Queue<Job>>> m_client_queues;
+    // Clients with queued jobs, in the order workers should serve them
+    Queue<int> m_clients_with_jobs;
+    bool m_shutting_down { false };
+    // Jobs the workers finished after shutdown began, which the destructor completes once they have been joined
+    Vector<FinishedJob> m_jobs_finished_during_shutdown;
+
+    Vector<NonnullRefPtr<Threading::Thread>> m_workers;
+};
+
+}
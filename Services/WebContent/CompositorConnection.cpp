@@ -7,6 +7,7 @@
 #include <WebContent/CompositorConnection.h>
 
 #include <LibCore/EventLoop.h>
+#include <LibCore/TraceEvent.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/PaintingSurface.h>
 #include <LibWeb/HTML/EventLoop/EventLoop.h>
@@ -43,6 +44,7 @@ void CompositorConnection::update_display_list(Web::Compositor::CompositorContex
     if (!can_send_message_to_compositor())
         return;
 
+    Core::TraceEventScope trace_event { "rendering"sv, "Send display list"sv };
     auto encoded_message = MUST(Messages::CompositorWebContentServer::UpdateDisplayList::static_encode(context_id, display_list, visual_context_tree, resource_transaction, scroll_state_snapshot));
     if (post_message(encoded_message).is_error())
         did_lose_compositor();
@@ -55,6 +57,13 @@ void CompositorConnection::update_visual_context_tree(Web::Compositor::Composito
     async_update_visual_context_tree(context_id, visual_context_tree);
 }
 
+void CompositorConnection::update_async_animations(Web::Compositor::CompositorContextId context_id, Vector<Web::Compositor::AsyncAnimation> const& async_animations)
+{
+    if (!can_send_message_to_compositor())
+        return;
+    async_update_async_animations(context_id, async_animations);
+}
+
 void CompositorConnection::update_scroll_state(Web::Compositor::CompositorContextId context_id, Web::Painting::ScrollStateSnapshot const& scroll_state_snapshot)
 {
     if (!can_send_message_to_compositor())
@@ -179,6 +188,12 @@ void CompositorConnection::request_rendering_update()
     Web::HTML::main_thread_event_loop().queue_task_to_update_the_rendering();
 }
 
+void CompositorConnection::did_present_frame(u64 page_id, i64 vsync_time_in_nanoseconds, double refresh_rate)
+{
+    if (on_present_frame)
+        on_present_frame(page_id, vsync_time_in_nanoseconds, refresh_rate);
+}
+
 void CompositorConnection::did_complete_screenshot(Web::Compositor::ScreenshotRequestId request_id)
 {
     auto pending_screenshot = take_screenshot(request_id);
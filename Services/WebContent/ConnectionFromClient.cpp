@@ -16,6 +16,7 @@
 #include <AK/QuickSort.h>
 #include <LibCore/Process.h>
 #include <LibCore/System.h>
+#include <LibCore/TraceEvent.h>
 #include <LibGC/Heap.h>
 #include <LibGfx/Bitmap.h>
 #include <LibGfx/Color.h>
@@ -24,6 +25,7 @@
 #include <LibIPC/Limits.h>
 #include <LibJS/Runtime/ConsoleObject.h>
 #include <LibJS/Runtime/Date.h>
+#include <LibJS/Runtime/SamplingProfiler.h>
 #include <LibRequests/RequestClient.h>
 #include <LibURL/Parser.h>
 #include <LibUnicode/TimeZone.h>
@@ -192,6 +194,10 @@ void ConnectionFromClient::connect_to_compositor_process(IPC::TransportHandle ha
     m_compositor_connection->on_mouse_event = [this](u64 page_id, Web::MouseEvent event) {
         mouse_event(page_id, move(event));
     };
+    m_compositor_connection->on_present_frame = [this](u64 page_id, i64 vsync_time_in_nanoseconds, double refresh_rate) {
+        if (auto page = m_page_host->page(page_id); page.has_value())
+            page->frame_pacer().did_present_frame(vsync_time_in_nanoseconds, refresh_rate);
+    };
 }
 
 void ConnectionFromClient::compositor_process_reconnected()
@@ -222,6 +228,47 @@ void ConnectionFromClient::update_screen_rects(u64 page_id, Vector<Web::DevicePi
         page->set_screen_rects(rects, main_screen);
 }
 
+static void load_url_verdict_warning(PageClient& page, URL::URL const& url, URLVerdict const& verdict)
+{
+    dbgln("WebContent::load_url: URLVerdict {} ({}) for {}", (u8)verdict.level, verdict.score, url);
+    auto warning_html = MUST(String::formatted(
+        R"html(<!DOCTYPE html>
+<html>
+<head><meta charset="utf-8"><title>Security Warning</title>
+<style>
+  body {{ font-family: -apple-system, sans-serif; max-width: 600px; margin: 80px auto; padding: 0 20px; }}
+  .box {{ border: 2px solid #e53e3e; border-radius: 8px; padding: 24px; }}
+  h1 {{ color: #e53e3e; margin-top: 0; }}
+  .score {{ color: #888; font-size: 14px; }}
+  .proceed {{ margin-top: 16px; }}
+  a.btn {{ display: inline-block; padding: 8px 16px; border-radius: 4px; text-decoration: none; }}
+  a.back {{ background: #2b6cb0; color: white; margin-right: 8px; }}
+  a.proceed {{ background: #e53e3e; color: white; }}
+</style>
+</head>
+<body>
+<div class="box">
+  <h1>⚠ Security Warning</h1>
+  <p>This URL has been flagged by Sentinel's phishing heuristics:</p>
+  <p><strong>{}</strong></p>
+  <p class="score">Threat level: {} &nbsp;|&nbsp; Score: {:.2f} &nbsp;|&nbsp; {}</p>
+  <div class="proceed">
+    <a class="btn back" href="javascript:history.back()">Go Back (Safe)</a>
+    <a class="btn proceed" href="sentinel://approve?url={}">Proceed Anyway</a>
+  </div>
+</div>
+</body>
+</html>)html",
+        url.serialize(),
+        verdict.level == URLThreatLevel::Suspicious      ? "Suspicious"sv
+            : verdict.level == URLThreatLevel::Malicious ? "Malicious"sv
+                                                         : "Critical"sv,
+        verdict.score,
+        verdict.explanation,
+        URL::percent_encode(url.serialize())));
+    page.page().load_html(warning_html.to_byte_string());
+}
+
 void ConnectionFromClient::load_url(u64 page_id, URL::URL url)
 {
     dbgln("WebContent::load_url: page_id={}, url={}", page_id, url);
@@ -273,47 +320,20 @@ void ConnectionFromClient::load_url(u64 page_id, URL::URL url)
     if (verdict_enabled) {
         auto scheme = url.scheme();
         if (scheme == "http" || scheme == "https") {
-            auto verdict = URLVerdictService::the().check(url);
-            if (verdict.level >= URLThreatLevel::Suspicious) {
-                dbgln("WebContent::load_url: URLVerdict {} ({}) for {}", (u8)verdict.level, verdict.score, url);
-                auto warning_html = MUST(String::formatted(
-                    R"html(<!DOCTYPE html>
-<html>
-<head><meta charset="utf-8"><title>Security Warning</title>
-<style>
-  body {{ font-family: -apple-system, sans-serif; max-width: 600px; margin: 80px auto; padding: 0 20px; }}
-  .box {{ border: 2px solid #e53e3e; border-radius: 8px; padding: 24px; }}
-  h1 {{ color: #e53e3e; margin-top: 0; }}
-  .score {{ color: #888; font-size: 14px; }}
-  .proceed {{ margin-top: 16px; }}
-  a.btn {{ display: inline-block; padding: 8px 16px; border-radius: 4px; text-decoration: none; }}
-  a.back {{ background: #2b6cb0; color: white; margin-right: 8px; }}
-  a.proceed {{ background: #e53e3e; color: white; }}
-</style>
-</head>
-<body>
-<div class="box">
-  <h1>⚠ Security Warning</h1>
-  <p>This URL has been flagged by Sentinel's phishing heuristics:</p>
-  <p><strong>{}</strong></p>
-  <p class="score">Threat level: {} &nbsp;|&nbsp; Score: {:.2f} &nbsp;|&nbsp; {}</p>
-  <div class="proceed">
-    <a class="btn back" href="javascript:history.back()">Go Back (Safe)</a>
-    <a class="btn proceed" href="sentinel://approve?url={}">Proceed Anyway</a>
-  </div>
-</div>
-</body>
-</html>)html",
-                    url.serialize(),
-                    verdict.level == URLThreatLevel::Suspicious      ? "Suspicious"sv
-                        : verdict.level == URLThreatLevel::Malicious ? "Malicious"sv
-                                                                     : "Critical"sv,
-                    verdict.score,
-                    verdict.explanation,
-                    URL::percent_encode(url.serialize())));
-                page->page().load_html(warning_html.to_byte_string());
-                return;
-            }
+            // Navigation goes ahead while the analyzer runs. If the verdict is bad and no other URL has been loaded in
+            // the meantime, the warning page replaces whatever the navigation got to, whether it committed or not.
+            auto navigation_id = ++m_url_verdict_navigation_ids.ensure(page_id, [] { return 0; });
+            page->page().load(url);
+
+            URLVerdictService::the().check_async(url, [weak_self = make_weak_ptr<ConnectionFromClient>(), page_id, navigation_id, url](URLVerdict verdict) {
+                if (verdict.level < URLThreatLevel::Suspicious || !weak_self)
+                    return;
+                if (weak_self->m_url_verdict_navigation_ids.get(page_id) != navigation_id)
+                    return;
+                if (auto page = weak_self->page(page_id); page.has_value())
+                    load_url_verdict_warning(*page, url, verdict);
+            });
+            return;
         }
     }
 
@@ -542,10 +562,16 @@ void ConnectionFromClient::debug_request(u64 page_id, ByteString request, ByteSt
         return;
     }
 
+    if (request == "dump-frame-timings") {
+        page->dump_frame_timings();
+        return;
+    }
+
     if (request == "collect-garbage") {
         // NOTE: We use deferred_invoke here to ensure that GC runs with as little on the stack as possible.
         Core::deferred_invoke([] {
             Web::Bindings::main_thread_vm().heap().collect_garbage(GC::Heap::CollectionType::CollectGarbage, true);
+            kmalloc_release_free_memory();
         });
         return;
     }
@@ -1987,6 +2013,36 @@ void ConnectionFromClient::run_javascript(u64 page_id, String js_source)
         page->run_javascript(js_source);
 }
 
+// The profiler also records the call stack of one allocation per this many allocated bytes.
+static constexpr size_t js_profiler_allocation_sampling_interval_in_bytes = 128 * KiB;
+
+void ConnectionFromClient::start_js_profiler(u64, u32 sampling_interval_in_microseconds)
+{
+    // NB: All pages of this process share one VM, so the first page to start profiling profiles all of them.
+    auto& vm = Web::Bindings::main_thread_vm();
+    if (vm.is_sampling_profiler_active())
+        return;
+
+    auto sampling_interval = AK::Duration::from_microseconds(max(sampling_interval_in_microseconds, 100u));
+    if (auto result = vm.start_sampling_profiler(sampling_interval, js_profiler_allocation_sampling_interval_in_bytes); result.is_error())
+        dbgln("Unable to start the JavaScript profiler: {}", result.error());
+}
+
+void ConnectionFromClient::stop_js_profiler(u64 page_id)
+{
+    auto profiler = Web::Bindings::main_thread_vm().stop_sampling_profiler();
+    if (!profiler) {
+        async_did_stop_js_profiler(page_id, JsonValue {});
+        return;
+    }
+
+    JsonObject profile;
+    profile.set("startTime"sv, profiler->start_time().milliseconds_since_epoch());
+    profile.set("interval"sv, static_cast<double>(profiler->sampling_interval().to_microseconds()) / 1000.0);
+    profile.set("thread"sv, profiler->to_gecko_profile_thread("WebContent"sv, Core::System::getpid()));
+    async_did_stop_js_profiler(page_id, move(profile));
+}
+
 void ConnectionFromClient::alert_closed(u64 page_id)
 {
     if (auto page = this->page(page_id); page.has_value())
@@ -2077,6 +2133,34 @@ void ConnectionFromClient::system_time_zone_changed()
     Unicode::clear_system_time_zone_cache();
 }
 
+void ConnectionFromClient::purge_memory()
+{
+    Web::Fetch::Fetching::clear_http_memory_cache();
+
+    // NOTE: We use deferred_invoke here to ensure that GC runs with as little on the stack as possible.
+    Core::deferred_invoke([] {
+        Web::Bindings::main_thread_vm().heap().collect_garbage(GC::Heap::CollectionType::CollectGarbage, true);
+        kmalloc_release_free_memory();
+    });
+}
+
+void ConnectionFromClient::release_free_memory()
+{
+    kmalloc_release_free_memory();
+}
+
+void ConnectionFromClient::request_allocator_statistics()
+{
+    auto general = kmalloc_partition_statistics(HeapPartition::General);
+    auto array_buffer = kmalloc_partition_statistics(HeapPartition::ArrayBuffer);
+    async_did_report_allocator_statistics(general.bytes_in_use, general.bytes_committed, array_buffer.bytes_in_use, array_buffer.bytes_committed);
+}
+
+void ConnectionFromClient::set_trace_event_buffer(Core::AnonymousBuffer trace_event_buffer)
+{
+    Core::set_trace_event_buffer(move(trace_event_buffer));
+}
+
 void ConnectionFromClient::set_document_cookie_version_buffer(u64 page_id, Core::AnonymousBuffer document_cookie_version_buffer)
 {
     if (auto page = this->page(page_id); page.has_value())
@@ -2105,6 +2189,16 @@ void ConnectionFromClient::broadcast_channel_message(Web::HTML::BroadcastChannel
     Web::HTML::BroadcastChannel::deliver_message_locally(message);
 }
 
+void ConnectionFromClient::local_storage_area_changed(Optional<String> storage_key)
+{
+    Web::StorageAPI::LocalStorageBottle::discard_cached_storage_areas(storage_key);
+}
+
+void ConnectionFromClient::local_storage_changed(String storage_key, Optional<String> key, Optional<String> old_value, Optional<String> new_value, String url)
+{
+    Web::HTML::Storage::deliver_local_storage_change_locally(storage_key, key, old_value, new_value, url);
+}
+
 void ConnectionFromClient::did_worker_agent_finish_loading_script(Web::HTML::WorkerAgentOwnerToken owner_token)
 {
     Web::HTML::WorkerAgentParent::did_finish_loading_worker_script(owner_token);
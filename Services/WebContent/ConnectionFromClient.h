@@ -149,6 +149,9 @@ private:
     virtual void js_console_input(u64 page_id, String) override;
     virtual void run_javascript(u64 page_id, String) override;
 
+    virtual void start_js_profiler(u64 page_id, u32 sampling_interval_in_microseconds) override;
+    virtual void stop_js_profiler(u64 page_id) override;
+
     virtual void alert_closed(u64 page_id) override;
     virtual void confirm_closed(u64 page_id, bool accepted) override;
     virtual void prompt_closed(u64 page_id, Optional<String> response) override;
@@ -203,11 +206,17 @@ private:
     void update_input_method_caret_rect(u64 page_id);
 
     virtual void system_time_zone_changed() override;
+    virtual void purge_memory() override;
+    virtual void release_free_memory() override;
+    virtual void request_allocator_statistics() override;
+    virtual void set_trace_event_buffer(Core::AnonymousBuffer) override;
 
     virtual void set_document_cookie_version_buffer(u64 page_id, Core::AnonymousBuffer document_cookie_version_buffer) override;
     virtual void set_document_cookie_version_index(u64 page_id, i64 document_id, Core::SharedVersionIndex document_index) override;
     virtual void cookies_changed(u64 page_id, Vector<HTTP::Cookie::Cookie>) override;
     virtual void broadcast_channel_message(Web::HTML::BroadcastChannelMessage message) override;
+    virtual void local_storage_area_changed(Optional<String> storage_key) override;
+    virtual void local_storage_changed(String storage_key, Optional<String> key, Optional<String> old_value, Optional<String> new_value, String url) override;
     virtual void did_worker_agent_finish_loading_script(Web::HTML::WorkerAgentOwnerToken owner_token) override;
     virtual void did_worker_agent_fail_loading_script(Web::HTML::WorkerAgentOwnerToken owner_token) override;
     virtual void did_worker_agent_report_exception(Web::HTML::WorkerAgentOwnerToken owner_token, String message, String filename, u32 lineno, u32 colno) override;
@@ -225,6 +234,9 @@ private:
     NonnullOwnPtr<PageHost> m_page_host;
 
     HashMap<int, Web::FileRequest> m_requested_files {};
+
+    // Bumped by every load_url() on a page, so a late URL verdict can tell if the user has moved on.
+    HashMap<u64, u64> m_url_verdict_navigation_ids;
     int last_id { 0 };
 
     void enqueue_input_event(Web::QueuedInputEvent);
@@ -14,10 +14,23 @@
 
 namespace WebContent {
 
+ErrorOr<NonnullRefPtr<SharedPolicyGraph>> SharedPolicyGraph::get_or_create(ByteString const& db_directory)
+{
+    static HashMap<ByteString, WeakPtr<SharedPolicyGraph>> s_shared_policy_graphs;
+    if (auto it = s_shared_policy_graphs.find(db_directory); it != s_shared_policy_graphs.end()) {
+        if (auto shared_policy_graph = it->value.strong_ref())
+            return shared_policy_graph.release_nonnull();
+    }
+
+    auto shared_policy_graph = adopt_ref(*new SharedPolicyGraph(TRY(Sentinel::PolicyGraph::create(db_directory))));
+    s_shared_policy_graphs.set(db_directory, shared_policy_graph->make_weak_ptr());
+    return shared_policy_graph;
+}
+
 ErrorOr<NonnullOwnPtr<FormMonitor>> FormMonitor::create_with_policy_graph(ByteString const& db_directory)
 {
     auto monitor = make<FormMonitor>();
-    monitor->m_policy_graph = TRY(Sentinel::PolicyGraph::create(db_directory));
+    monitor->m_policy_graph = TRY(SharedPolicyGraph::get_or_create(db_directory));
     TRY(monitor->load_relationships_from_database());
     return monitor;
 }
@@ -28,7 +41,7 @@ ErrorOr<void> FormMonitor::load_relationships_from_database()
         return {};
 
     // Load all credential relationships from database
-    auto relationships = TRY(m_policy_graph->list_relationships({}));
+    auto relationships = TRY(m_policy_graph->policy_graph().list_relationships({}));
 
     dbgln("FormMonitor: Loading {} credential relationships from database", relationships.size());
 
@@ -115,7 +128,7 @@ void FormMonitor::on_form_submit(FormSubmitEvent const& event)
         }
         db_alert.anomaly_indicators = JsonValue(indicators_array).serialized();
 
-        auto result = m_policy_graph->record_credential_alert(db_alert);
+        auto result = m_policy_graph->policy_graph().record_credential_alert(db_alert);
         if (result.is_error()) {
             dbgln("FormMonitor: Failed to record alert in database: {}", result.error());
         } else {
@@ -300,7 +313,7 @@ void FormMonitor::learn_trusted_relationship(String const& form_origin, String c
         relationship.created_by = "user_decision"_string;
         relationship.notes = "User clicked Trust in security alert"_string;
 
-        auto result = m_policy_graph->create_relationship(relationship);
+        auto result = m_policy_graph->policy_graph().create_relationship(relationship);
         if (result.is_error()) {
             dbgln("FormMonitor: Failed to persist trusted relationship: {}", result.error());
         } else {
@@ -321,7 +334,7 @@ bool FormMonitor::is_trusted_relationship(String const& form_origin, String cons
 
     // Check database if PolicyGraph is available
     if (m_policy_graph) {
-        auto result = m_policy_graph->has_relationship(form_origin, action_origin, "trusted"_string);
+        auto result = m_policy_graph->policy_graph().has_relationship(form_origin, action_origin, "trusted"_string);
         if (!result.is_error() && result.value()) {
             dbgln("FormMonitor: Found trusted relationship in database but not in cache");
             return true;
@@ -354,7 +367,7 @@ void FormMonitor::block_submission(String const& form_origin, String const& acti
         relationship.created_by = "user_decision"_string;
         relationship.notes = "User clicked Block in security alert"_string;
 
-        auto result = m_policy_graph->create_relationship(relationship);
+        auto result = m_policy_graph->policy_graph().create_relationship(relationship);
         if (result.is_error()) {
             dbgln("FormMonitor: Failed to persist blocked relationship: {}", result.error());
         } else {
@@ -375,7 +388,7 @@ bool FormMonitor::is_blocked_submission(String const& form_origin, String const&
 
     // Check database if PolicyGraph is available
     if (m_policy_graph) {
-        auto result = m_policy_graph->has_relationship(form_origin, action_origin, "blocked"_string);
+        auto result = m_policy_graph->policy_graph().has_relationship(form_origin, action_origin, "blocked"_string);
         if (!result.is_error() && result.value()) {
             dbgln("FormMonitor: Found blocked relationship in database but not in cache");
             return true;
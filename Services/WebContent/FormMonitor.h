@@ -10,14 +10,36 @@
 #include <AK/HashTable.h>
 #include <AK/NonnullOwnPtr.h>
 #include <AK/OwnPtr.h>
+#include <AK/RefCounted.h>
 #include <AK/String.h>
 #include <AK/Time.h>
 #include <AK/Vector.h>
+#include <AK/Weakable.h>
 #include <LibURL/URL.h>
 #include <Services/Sentinel/PolicyGraph.h>
 
 namespace WebContent {
 
+// A PolicyGraph shared by every FormMonitor in this WebContent process that uses the same database, rather than each
+// page opening its own SQLite connection and relationship cache over the same file. It closes along with the last
+// FormMonitor using it.
+class SharedPolicyGraph
+    : public RefCounted<SharedPolicyGraph>
+    , public Weakable<SharedPolicyGraph> {
+public:
+    static ErrorOr<NonnullRefPtr<SharedPolicyGraph>> get_or_create(ByteString const& db_directory);
+
+    Sentinel::PolicyGraph& policy_graph() { return *m_policy_graph; }
+
+private:
+    explicit SharedPolicyGraph(NonnullOwnPtr<Sentinel::PolicyGraph> policy_graph)
+        : m_policy_graph(move(policy_graph))
+    {
+    }
+
+    NonnullOwnPtr<Sentinel::PolicyGraph> m_policy_graph;
+};
+
 // FormMonitor tracks form submissions and detects potential credential exfiltration
 class FormMonitor {
 public:
@@ -131,8 +153,8 @@ private:
     // Cleared after first use to prevent persistent bypass of security checks
     HashMap<String, HashTable<String>> m_autofill_overrides;
 
-    // PolicyGraph for persistent credential relationship storage
-    OwnPtr<Sentinel::PolicyGraph> m_policy_graph;
+    // PolicyGraph for persistent credential relationship storage, shared with the other pages in this process
+    RefPtr<SharedPolicyGraph> m_policy_graph;
 
     // Milestone 0.3 Phase 6: Submission frequency tracking for anomaly detection
     // Maps form_origin to timestamps of recent submissions
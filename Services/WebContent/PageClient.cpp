@@ -341,9 +341,48 @@ void PageClient::request_frame()
         delay = max(0.0, *m_last_frame_dispatch_time + minimum_frame_interval - now);
     }
 
+    // Start the update late enough that it finishes just before the compositor's next vsync, so that the frame
+    // doesn't sit in the compositor for most of an interval (or miss the vsync entirely) before it's presented.
+    auto now = MonotonicTime::now();
+    if (auto next_rendering_update_time = m_frame_pacer.next_rendering_update_time(now); next_rendering_update_time.has_value()) {
+        auto delay_until_vsync_aligned_update = static_cast<double>((*next_rendering_update_time - now).to_microseconds()) / 1000.0;
+        delay = max(delay, delay_until_vsync_aligned_update);
+    }
+
     m_frame_timer->restart(static_cast<int>(AK::ceil(delay)));
 }
 
+void PageClient::page_did_paint_next_frame(MonotonicTime rendering_update_started_at)
+{
+    m_frame_pacer.did_update_the_rendering(rendering_update_started_at, MonotonicTime::now());
+}
+
+void PageClient::dump_frame_timings() const
+{
+    auto frame_timings = m_frame_pacer.recent_frame_timings();
+    if (frame_timings.is_empty()) {
+        dbgln("No frames painted yet");
+        return;
+    }
+
+    auto milliseconds_between = [](MonotonicTime from, MonotonicTime to) {
+        return static_cast<double>((to - from).to_microseconds()) / 1000.0;
+    };
+
+    auto const& first_frame = frame_timings.first();
+    dbgln("Predicted rendering update duration: {:.2}ms", static_cast<double>(m_frame_pacer.predicted_rendering_update_duration().to_microseconds()) / 1000.0);
+    for (auto const& frame_timing : frame_timings) {
+        auto begin = milliseconds_between(first_frame.rendering_update_started_at, frame_timing.rendering_update_started_at);
+        auto paint = milliseconds_between(frame_timing.rendering_update_started_at, frame_timing.rendering_update_finished_at);
+        if (frame_timing.presented_at.has_value()) {
+            auto present = milliseconds_between(frame_timing.rendering_update_finished_at, *frame_timing.presented_at);
+            dbgln("  begin {:.2}ms, painted in {:.2}ms, presented {:.2}ms later", begin, paint, present);
+        } else {
+            dbgln("  begin {:.2}ms, painted in {:.2}ms, not presented", begin, paint);
+        }
+    }
+}
+
 void PageClient::set_maximum_frames_per_second(double maximum_frames_per_second)
 {
     m_maximum_frames_per_second = maximum_frames_per_second;
@@ -990,52 +1029,34 @@ bool PageClient::page_did_is_known_hsts_host(String const& domain)
     return response->result();
 }
 
-Optional<String> PageClient::page_did_request_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, String const& bottle_key)
+OrderedHashMap<String, String> PageClient::page_did_request_storage_area(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key)
 {
-    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidRequestStorageItem>(storage_endpoint, storage_key, bottle_key);
+    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidRequestStorageArea>(storage_endpoint, storage_key);
     if (!response) {
-        dbgln("WebContent client disconnected during DidRequestStorageItem. Exiting peacefully.");
+        dbgln("WebContent client disconnected during DidRequestStorageArea. Exiting peacefully.");
         Core::Process::terminate_immediately(0);
     }
-    return response->take_value();
+    return response->take_items();
 }
 
-WebView::StorageSetResult PageClient::page_did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, String const& bottle_key, String const& value)
+void PageClient::page_did_set_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, String const& bottle_key, String const& value)
 {
-    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidSetStorageItem>(storage_endpoint, storage_key, bottle_key, value);
-    if (!response) {
-        dbgln("WebContent client disconnected during DidSetStorageItem. Exiting peacefully.");
-        Core::Process::terminate_immediately(0);
-    }
-    return response->result();
+    client().async_did_set_storage_item(storage_endpoint, storage_key, bottle_key, value);
 }
 
 void PageClient::page_did_remove_storage_item(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key, String const& bottle_key)
 {
-    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidRemoveStorageItem>(storage_endpoint, storage_key, bottle_key);
-    if (!response) {
-        dbgln("WebContent client disconnected during DidRemoveStorageItem. Exiting peacefully.");
-        Core::Process::terminate_immediately(0);
-    }
+    client().async_did_remove_storage_item(storage_endpoint, storage_key, bottle_key);
 }
 
-Vector<String> PageClient::page_did_request_storage_keys(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key)
+void PageClient::page_did_clear_storage(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key)
 {
-    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidRequestStorageKeys>(storage_endpoint, storage_key);
-    if (!response) {
-        dbgln("WebContent client disconnected during DidRequestStorageKeys. Exiting peacefully.");
-        Core::Process::terminate_immediately(0);
-    }
-    return response->take_keys();
+    client().async_did_clear_storage(storage_endpoint, storage_key);
 }
 
-void PageClient::page_did_clear_storage(Web::StorageAPI::StorageEndpointType storage_endpoint, String const& storage_key)
+void PageClient::page_did_broadcast_local_storage_change(String const& storage_key, Optional<String> const& key, Optional<String> const& old_value, Optional<String> const& new_value, String const& url)
 {
-    auto response = client().send_sync_but_allow_failure<Messages::WebContentClient::DidClearStorage>(storage_endpoint, storage_key);
-    if (!response) {
-        dbgln("WebContent client disconnected during DidClearStorage. Exiting peacefully.");
-        Core::Process::terminate_immediately(0);
-    }
+    client().async_did_broadcast_local_storage_change(storage_key, key, old_value, new_value, url);
 }
 
 void PageClient::page_did_post_broadcast_channel_message(Web::HTML::BroadcastChannelMessage const& message)
@@ -6,6 +6,8 @@
 #include "URLVerdictService.h"
 #include <AK/Debug.h>
 #include <AK/StringBuilder.h>
+#include <LibCore/EventLoop.h>
+#include <LibThreading/ThreadPool.h>
 #include <Sentinel/PhishingURLAnalyzer.h>
 #include <ctime>
 
@@ -30,28 +32,27 @@ URLVerdictService::URLVerdictService()
     }
 }
 
-URLVerdict URLVerdictService::check(URL::URL const& url)
+Optional<URLVerdict> URLVerdictService::verdict_without_analysis(URL::URL const& url, ByteString const& domain)
 {
     // Fail-open: disabled or no analyzer → Clean.
     if (!m_enabled || !s_analyzer) {
-        return {};
+        return URLVerdict {};
     }
 
     // Only check http/https — skip file://, about:, data:, blob:, etc.
     auto scheme = url.scheme();
     if (scheme != "http" && scheme != "https") {
-        return {};
+        return URLVerdict {};
     }
 
-    auto domain = extract_domain(url);
     if (domain.is_empty()) {
-        return {};
+        return URLVerdict {};
     }
 
     // User-approved domains skip re-analysis for the session.
     if (m_approved_domains.contains(domain)) {
         dbgln_if(URL_VERDICT_DEBUG, "URLVerdictService: user-approved domain {}", domain);
-        return {};
+        return URLVerdict {};
     }
 
     // Cache hit?
@@ -60,8 +61,12 @@ URLVerdict URLVerdictService::check(URL::URL const& url)
         return cached.value();
     }
 
-    // Analyze.
-    auto result = s_analyzer->analyze_url(url.serialize());
+    return {};
+}
+
+URLVerdict URLVerdictService::analyze(StringView url, StringView domain)
+{
+    auto result = s_analyzer->analyze_url(url);
     if (result.is_error()) {
         dbgln("URLVerdictService: analyzer error for {}: {}", domain, result.error());
         // Fail-open.
@@ -81,16 +86,50 @@ URLVerdict URLVerdictService::check(URL::URL const& url)
     else
         level = URLThreatLevel::Clean;
 
-    URLVerdict verdict {
+    return URLVerdict {
         .level = level,
         .score = analysis.phishing_score,
-        .explanation = analysis.reason.is_empty() ? ByteString("Phishing heuristics triggered") : analysis.reason,
+        .explanation = analysis.explanation.is_empty() ? ByteString("Phishing heuristics triggered") : analysis.explanation.to_byte_string(),
     };
+}
+
+URLVerdict URLVerdictService::check(URL::URL const& url)
+{
+    auto domain = extract_domain(url);
+    if (auto verdict = verdict_without_analysis(url, domain); verdict.has_value())
+        return verdict.release_value();
 
+    auto verdict = analyze(url.serialize(), domain);
     cache_store(domain, verdict, TTL_SECONDS);
     return verdict;
 }
 
+void URLVerdictService::check_async(URL::URL const& url, Function<void(URLVerdict)> on_verdict)
+{
+    auto domain = extract_domain(url);
+    if (auto verdict = verdict_without_analysis(url, domain); verdict.has_value()) {
+        on_verdict(verdict.release_value());
+        return;
+    }
+
+    // NB: The analyzer only reads the index it built on creation, so it is safe to run on the pool. Strings aren't
+    //     atomically ref-counted, so the task only works on strings nothing else holds, and the cache is updated back
+    //     on the calling thread.
+    Threading::ThreadPool::the().submit(
+        [this, serialized_url = url.serialize(), domain = move(domain), on_verdict = move(on_verdict), event_loop_weak = Core::EventLoop::current_weak()] mutable {
+            auto verdict = analyze(serialized_url, domain);
+
+            auto event_loop = event_loop_weak->take();
+            if (!event_loop)
+                return;
+            event_loop->deferred_invoke([this, domain = move(domain), verdict = move(verdict), on_verdict = move(on_verdict)] mutable {
+                cache_store(domain, verdict, TTL_SECONDS);
+                on_verdict(move(verdict));
+            });
+        },
+        Threading::ThreadPool::Priority::UserVisible);
+}
+
 void URLVerdictService::approve_domain(ByteString const& domain)
 {
     if (domain.is_empty())
@@ -113,37 +152,27 @@ ByteString URLVerdictService::extract_domain(URL::URL const& url)
 
 Optional<URLVerdict> URLVerdictService::cache_get(ByteString const& domain)
 {
-    auto it = m_cache.find(domain);
-    if (it == m_cache.end())
+    auto entry = m_cache.get(domain);
+    if (!entry.has_value())
         return {};
     u64 now = static_cast<u64>(time(nullptr));
-    if (now - it->value.stored_at_s > TTL_SECONDS) {
+    if (now - entry->stored_at_s > entry->ttl_s) {
         m_cache.remove(domain);
         return {};
     }
-    return it->value.verdict;
+    return entry->verdict;
 }
 
 void URLVerdictService::cache_store(ByteString const& domain, URLVerdict const& verdict, u64 ttl)
 {
-    (void)ttl; // TTL stored but eviction uses default TTL_SECONDS; approved entries use HashTable
-    // Simple eviction: drop oldest half when full.
-    if (m_cache.size() >= CACHE_MAX_ENTRIES) {
-        u32 to_remove = CACHE_MAX_ENTRIES / 2;
-        Vector<ByteString> keys_to_remove;
-        keys_to_remove.ensure_capacity(to_remove);
-        for (auto const& entry : m_cache) {
-            keys_to_remove.append(entry.key);
-            if (keys_to_remove.size() >= to_remove)
-                break;
-        }
-        for (auto const& key : keys_to_remove)
-            m_cache.remove(key);
-    }
-    m_cache.set(domain, CacheEntry {
-                            .verdict = verdict,
-                            .stored_at_s = static_cast<u64>(time(nullptr)),
-                        });
+    // The cache evicts the least recently used domain once full
+    auto result = m_cache.put(domain, CacheEntry {
+                                          .verdict = verdict,
+                                          .stored_at_s = static_cast<u64>(time(nullptr)),
+                                          .ttl_s = ttl,
+                                      });
+    if (result.is_error())
+        dbgln("URLVerdictService: failed to cache verdict for {}: {}", domain, result.error());
 }
 
 } // namespace WebContent
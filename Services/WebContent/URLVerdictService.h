@@ -12,6 +12,7 @@
 #include <AK/Optional.h>
 #include <AK/String.h>
 #include <LibURL/URL.h>
+#include <Sentinel/ShardedLRUCache.h>
 
 namespace WebContent {
 
@@ -30,13 +31,15 @@ struct URLVerdict {
     ByteString explanation;
 };
 
-// URLVerdictService — synchronous, in-process URL phishing check via
+// URLVerdictService — in-process URL phishing check via
 // Sentinel::PhishingURLAnalyzer (already linked as sentinelservice).
 //
 // Usage:
 //   auto verdict = URLVerdictService::the().check(url);
 //   if (verdict.level >= URLThreatLevel::Suspicious) { ... }
 //
+//   URLVerdictService::the().check_async(url, [](URLVerdict verdict) { ... });
+//
 // Fail-open: any error from the analyzer returns Clean to avoid blocking
 // navigation when Sentinel subsystems are unavailable.
 class URLVerdictService {
@@ -47,6 +50,12 @@ public:
     // Always returns a valid verdict (never propagates analyzer errors).
     URLVerdict check(URL::URL const& url);
 
+    // Asynchronous verdict, so callers don't have to hold up navigation while the analyzer runs.
+    // Verdicts that need no analysis (cache hits, approved domains, skipped schemes) are delivered
+    // before this returns; otherwise the analyzer runs on the thread pool and the callback is
+    // invoked later on the calling thread's event loop.
+    void check_async(URL::URL const& url, Function<void(URLVerdict)> on_verdict);
+
     // Mark a domain as user-approved — stores a Clean verdict with max TTL.
     // Called when the user clicks "Proceed Anyway" on a warning page.
     void approve_domain(ByteString const& domain);
@@ -70,13 +79,19 @@ private:
 
     struct CacheEntry {
         URLVerdict verdict;
-        u64 stored_at_s; // time(nullptr) at store time
+        u64 stored_at_s { 0 }; // time(nullptr) at store time
+        u64 ttl_s { TTL_SECONDS };
     };
 
+    // The verdict for a URL when it can be determined without running the analyzer.
+    Optional<URLVerdict> verdict_without_analysis(URL::URL const& url, ByteString const& domain);
+    static URLVerdict analyze(StringView url, StringView domain);
+
     Optional<URLVerdict> cache_get(ByteString const& domain);
     void cache_store(ByteString const& domain, URLVerdict const&, u64 ttl = TTL_SECONDS);
 
-    HashMap<ByteString, CacheEntry> m_cache;
+    // Sharded, so navigations checked from different threads do not serialize on one lock
+    Sentinel::ShardedLRUCache<ByteString, CacheEntry> m_cache { CACHE_MAX_ENTRIES };
     HashTable<ByteString> m_approved_domains; // Persists for session lifetime
     bool m_enabled { true };
 };
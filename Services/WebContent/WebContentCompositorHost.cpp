@@ -47,6 +47,12 @@ private:
             connection->update_visual_context_tree(context_id, visual_context_tree);
     }
 
+    virtual void update_async_animations(Web::Compositor::CompositorContextId context_id, Vector<Web::Compositor::AsyncAnimation> async_animations) override
+    {
+        if (auto* connection = compositor_connection())
+            connection->update_async_animations(context_id, async_animations);
+    }
+
     virtual void update_video_frame(Web::Compositor::CompositorContextId context_id, Web::Painting::VideoFrameResourceId frame_id, NonnullRefPtr<Media::VideoFrame const> frame) override
     {
         if (auto* connection = compositor_connection())
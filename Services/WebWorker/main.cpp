@@ -55,6 +55,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     Vector<ByteString> certificates;
     bool expose_experimental_interfaces = false;
     bool enable_http_memory_cache = false;
+    Optional<u64> http_memory_cache_size_in_mib;
     bool wait_for_debugger = false;
     bool file_origins_are_tuple_origins = false;
     bool enable_sandbox = false;
@@ -64,6 +65,7 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
     args_parser.add_option(certificates, "Path to a certificate file", "certificate", 'C', "certificate");
     args_parser.add_option(expose_experimental_interfaces, "Expose experimental IDL interfaces", "expose-experimental-interfaces");
     args_parser.add_option(enable_http_memory_cache, "Enable HTTP cache", "enable-http-memory-cache");
+    args_parser.add_option(http_memory_cache_size_in_mib, "Maximum HTTP cache size in MiB", "http-memory-cache-size", 0, "MiB");
     args_parser.add_option(wait_for_debugger, "Wait for debugger", "wait-for-debugger");
     args_parser.add_option(worker_type_string, "Type of WebWorker to start (dedicated, shared, or service)", "type", 't', "type");
     args_parser.add_option(mach_server_name, "Mach server name", "mach-server-name", 0, "mach_server_name");
@@ -86,6 +88,8 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
 
     if (enable_http_memory_cache)
         Web::Fetch::Fetching::set_http_memory_cache_enabled(true);
+    if (http_memory_cache_size_in_mib.has_value())
+        Web::Fetch::Fetching::set_http_memory_cache_maximum_size(http_memory_cache_size_in_mib.value() * MiB);
 
     OPENSSL_TRY(OSSL_set_max_threads(nullptr, Core::System::hardware_concurrency()));
 
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/BinaryHeap.h>
+#include <AK/HashMap.h>
+#include <AK/QuickSort.h>
+#include <AK/String.h>
+#include <AK/StringBuilder.h>
+#include <AK/Vector.h>
+
+static constexpr int element_count = 100'000;
+
+// A cheap, deterministic shuffle, so that every run sees the same sequence of keys.
+static u32 scrambled(u32 value)
+{
+    value ^= value >> 16;
+    value *= 0x7feb352d;
+    value ^= value >> 15;
+    value *= 0x846ca68b;
+    value ^= value >> 16;
+    return value;
+}
+
+BENCHMARK_CASE(vector_append)
+{
+    Vector<int> vector;
+    for (int i = 0; i < element_count; ++i)
+        vector.append(i);
+    EXPECT_EQ(vector.size(), static_cast<size_t>(element_count));
+}
+
+BENCHMARK_CASE(vector_sort)
+{
+    Vector<u32> vector;
+    vector.ensure_capacity(element_count);
+    for (int i = 0; i < element_count; ++i)
+        vector.unchecked_append(scrambled(i));
+    quick_sort(vector);
+    EXPECT(vector.first() <= vector.last());
+}
+
+BENCHMARK_CASE(hash_map_insert_and_lookup)
+{
+    HashMap<u32, u32> map;
+    for (int i = 0; i < element_count; ++i)
+        map.set(scrambled(i), i);
+
+    size_t hits = 0;
+    for (int i = 0; i < element_count * 2; ++i) {
+        if (map.contains(scrambled(i)))
+            ++hits;
+    }
+    EXPECT_EQ(hits, static_cast<size_t>(element_count));
+}
+
+BENCHMARK_CASE(hash_map_string_keys)
+{
+    Vector<String> keys;
+    keys.ensure_capacity(element_count / 10);
+    for (int i = 0; i < element_count / 10; ++i)
+        keys.unchecked_append(MUST(String::formatted("key-{}", scrambled(i))));
+
+    HashMap<String, int> map;
+    for (size_t i = 0; i < keys.size(); ++i)
+        map.set(keys[i], static_cast<int>(i));
+
+    size_t hits = 0;
+    for (auto const& key : keys) {
+        if (map.get(key).has_value())
+            ++hits;
+    }
+    EXPECT_EQ(hits, keys.size());
+}
+
+BENCHMARK_CASE(binary_heap_push_and_pop)
+{
+    BinaryHeap<u32, u32, 0> heap;
+    for (int i = 0; i < element_count; ++i)
+        heap.insert(scrambled(i), i);
+
+    u32 previous_key = 0;
+    bool is_ordered = true;
+    while (!heap.is_empty()) {
+        auto key = heap.peek_min_key();
+        is_ordered &= key >= previous_key;
+        previous_key = key;
+        heap.pop_min();
+    }
+    EXPECT(is_ordered);
+}
+
+BENCHMARK_CASE(string_builder_append)
+{
+    StringBuilder builder;
+    for (int i = 0; i < element_count; ++i) {
+        builder.append("item"sv);
+        builder.append_code_point('0' + (i % 10));
+    }
+    auto string = builder.to_string_without_validation();
+    EXPECT_EQ(string.bytes().size(), static_cast<size_t>(element_count) * 5);
+}
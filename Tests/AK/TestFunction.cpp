@@ -75,3 +75,28 @@ TEST_CASE(move_assignment_destroys_old_inline_wrapper)
 
     EXPECT_EQ(instance_count, 0);
 }
+
+template<typename FunctionType>
+static bool stores_callable_inline(FunctionType const& function)
+{
+    auto const* callable = function.raw_capture_range().data();
+    auto const* function_storage = reinterpret_cast<u8 const*>(&function);
+    return callable >= function_storage && callable < function_storage + sizeof(function);
+}
+
+TEST_CASE(inline_capacity_can_be_raised)
+{
+    u64 a = 1, b = 2, c = 3, d = 4, e = 5;
+
+    Function<u64()> default_function = [a, b, c, d, e] { return a + b + c + d + e; };
+    EXPECT(!stores_callable_inline(default_function));
+    EXPECT_EQ(default_function(), 15u);
+
+    Function<u64(), 64> larger_function = [a, b, c, d, e] { return a + b + c + d + e; };
+    EXPECT(stores_callable_inline(larger_function));
+    EXPECT_EQ(larger_function(), 15u);
+
+    auto moved_function = move(larger_function);
+    EXPECT(stores_callable_inline(moved_function));
+    EXPECT_EQ(moved_function(), 15u);
+}
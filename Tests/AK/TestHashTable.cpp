@@ -206,6 +206,22 @@ TEST_CASE(many_collisions)
     EXPECT(strings.find("foo") != strings.end());
 }
 
+TEST_CASE(lookups_after_collisions_and_removals)
+{
+    struct IntCollisionTraits : public DefaultTraits<int> {
+        static unsigned hash(int value) { return static_cast<unsigned>(value) % 7; }
+    };
+
+    HashTable<int, IntCollisionTraits> table;
+    for (int i = 0; i < 200; ++i)
+        table.set(i);
+    for (int i = 0; i < 200; i += 3)
+        EXPECT(table.remove(i));
+
+    for (int i = 0; i < 400; ++i)
+        EXPECT_EQ(table.contains(i), i < 200 && i % 3 != 0);
+}
+
 TEST_CASE(space_reuse)
 {
     struct StringCollisionTraits : public DefaultTraits<ByteString> {
@@ -741,3 +757,17 @@ BENCHMARK_CASE(high_collision_non_trivial)
             table.set(NonTrivialValue(i));
     }
 }
+
+BENCHMARK_CASE(lookup_missing_int)
+{
+    HashTable<int> table;
+    for (int i = 0; i < 1'000; ++i)
+        table.set(i * 2);
+
+    size_t found = 0;
+    for (int iter = 0; iter < ITERATION_COUNT; ++iter) {
+        for (int i = 0; i < 1'000; ++i)
+            found += table.contains(i * 2 + 1);
+    }
+    EXPECT_EQ(found, 0u);
+}
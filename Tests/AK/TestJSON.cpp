@@ -692,3 +692,15 @@ TEST_CASE(invalid_utf8)
     EXPECT(JsonValue::from_string("{\"key\": \"value\xff\xff\"}"sv).is_error());
     EXPECT(JsonValue::from_string("{\"key\xff\xff\": \"value\"}"sv).is_error());
 }
+
+TEST_CASE(json_strings_with_and_without_escapes)
+{
+    auto json = JsonValue::from_string(R"({"plain": "value", "escaped": "a\"b\\c\nd", "tab": "x\ty"})"sv).value();
+    auto const& object = json.as_object();
+    EXPECT_EQ(object.get_string("plain"sv).value(), "value"sv);
+    EXPECT_EQ(object.get_string("escaped"sv).value(), "a\"b\\c\nd"sv);
+    EXPECT_EQ(object.get_string("tab"sv).value(), "x\ty"sv);
+
+    EXPECT(JsonValue::from_string("\"unterminated"sv).is_error());
+    EXPECT(JsonValue::from_string("\"control\x01\""sv).is_error());
+}
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+
+#include <AK/QuickSort.h>
+#include <AK/RadixSort.h>
+#include <AK/Random.h>
+#include <AK/Vector.h>
+
+template<typename T>
+static void expect_sorts_like_quick_sort(Vector<T> keys)
+{
+    auto expected = keys;
+    quick_sort(expected);
+
+    Vector<T> scratch;
+    scratch.resize(keys.size());
+    radix_sort(keys.span(), scratch.span());
+    EXPECT_EQ(keys, expected);
+}
+
+TEST_CASE(sorts_short_inputs)
+{
+    expect_sorts_like_quick_sort<u32>({});
+    expect_sorts_like_quick_sort<u32>({ 1 });
+    expect_sorts_like_quick_sort<u32>({ 3, 1, 2 });
+}
+
+TEST_CASE(sorts_random_keys)
+{
+    for (size_t size : { 64uz, 100uz, 1000uz, 10000uz }) {
+        Vector<u64> keys;
+        for (size_t i = 0; i < size; ++i)
+            keys.append(get_random<u64>());
+        expect_sorts_like_quick_sort(move(keys));
+    }
+}
+
+TEST_CASE(sorts_keys_with_constant_bytes)
+{
+    Vector<u32> low_bits;
+    Vector<u32> high_bits;
+    for (u32 i = 0; i < 1000; ++i) {
+        low_bits.append(get_random<u32>() & 0xffff);
+        high_bits.append((get_random<u32>() & 0xff) << 24);
+    }
+    // Skipping an odd number of passes leaves the result in the scratch buffer until the final copy.
+    Vector<u32> one_varying_byte;
+    for (u32 i = 0; i < 1000; ++i)
+        one_varying_byte.append(0x12340000 | ((get_random<u32>() & 0xff) << 8));
+    expect_sorts_like_quick_sort(move(low_bits));
+    expect_sorts_like_quick_sort(move(high_bits));
+    expect_sorts_like_quick_sort(move(one_varying_byte));
+}
+
+TEST_CASE(sorts_equal_keys)
+{
+    Vector<u16> keys;
+    keys.resize(500);
+    keys.fill(42);
+    expect_sorts_like_quick_sort(move(keys));
+}
@@ -821,6 +821,16 @@ TEST_CASE(equals_ignoring_case)
         EXPECT(!string4.equals_ignoring_case(string5));
         EXPECT(!string4.equals_ignoring_case(string6));
     }
+    {
+        auto string1 = "\u212A"_string; // KELVIN SIGN
+        auto string2 = "K"_string;
+        auto string3 = "k"_string;
+
+        EXPECT(string1.equals_ignoring_case(string2));
+        EXPECT(string1.equals_ignoring_case(string3));
+        EXPECT(string2.equals_ignoring_case(string1));
+        EXPECT(string3.equals_ignoring_case(string1));
+    }
     {
 
         auto string1 = "Ab\u00DFCd\u00DFeF"_string;
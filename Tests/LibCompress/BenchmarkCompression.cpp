@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/StringBuilder.h>
+#include <LibCompress/Deflate.h>
+#include <LibCompress/Gzip.h>
+#include <LibCompress/Zlib.h>
+#include <LibTest/TestCase.h>
+
+// About a megabyte of markup-like text, which is what most of what we decompress (HTTP bodies, WOFF2 tables) resembles.
+static ByteBuffer const& text_input()
+{
+    static ByteBuffer const input = [] {
+        StringBuilder builder;
+        for (int i = 0; i < 20'000; ++i)
+            builder.appendff("<li class=\"item item-{}\"><a href=\"/items/{}\">Item number {}</a></li>\n", i % 17, i, i * 7919 % 10007);
+        return MUST(builder.to_byte_buffer());
+    }();
+    return input;
+}
+
+BENCHMARK_CASE(deflate_compress)
+{
+    auto compressed = MUST(Compress::DeflateCompressor::compress_all(text_input()));
+    EXPECT(compressed.size() < text_input().size());
+}
+
+BENCHMARK_CASE(deflate_decompress)
+{
+    static auto const compressed = MUST(Compress::DeflateCompressor::compress_all(text_input()));
+    auto decompressed = MUST(Compress::DeflateDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.size(), text_input().size());
+}
+
+BENCHMARK_CASE(zlib_round_trip)
+{
+    auto compressed = MUST(Compress::ZlibCompressor::compress_all(text_input(), Compress::GenericZlibCompressionLevel::Fastest));
+    auto decompressed = MUST(Compress::ZlibDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.size(), text_input().size());
+}
+
+BENCHMARK_CASE(gzip_decompress)
+{
+    static auto const compressed = MUST(Compress::GzipCompressor::compress_all(text_input(), Compress::GenericZlibCompressionLevel::Best));
+    auto decompressed = MUST(Compress::GzipDecompressor::decompress_all(compressed));
+    EXPECT_EQ(decompressed.size(), text_input().size());
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/MemoryStream.h>
+#include <AK/Random.h>
+#include <LibCompress/Brotli.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(brotli_decompress_simple)
+{
+    Array<u8, 31> const compressed {
+        0x1B, 0x1E, 0x00, 0xF8, 0x8D, 0xD4, 0x5E, 0x33, 0xF1, 0xA1, 0x59, 0xE5,
+        0x9B, 0xDC, 0x1D, 0xEC, 0x80, 0xAD, 0xDB, 0xB8, 0xCC, 0x07, 0xA1, 0x54,
+        0x0C, 0x60, 0xEB, 0x22, 0x1D, 0xEB, 0x06
+    };
+
+    u8 const uncompressed[] = "word1 abc word2 word1 abc word2";
+
+    auto const decompressed = TRY_OR_FAIL(Compress::BrotliDecompressor::decompress_all(compressed));
+    EXPECT(decompressed.bytes() == (ReadonlyBytes { uncompressed, sizeof(uncompressed) - 1 }));
+}
+
+TEST_CASE(brotli_decompress_stream)
+{
+    Array<u8, 31> const compressed {
+        0x1B, 0x1E, 0x00, 0xF8, 0x8D, 0xD4, 0x5E, 0x33, 0xF1, 0xA1, 0x59, 0xE5,
+        0x9B, 0xDC, 0x1D, 0xEC, 0x80, 0xAD, 0xDB, 0xB8, 0xCC, 0x07, 0xA1, 0x54,
+        0x0C, 0x60, 0xEB, 0x22, 0x1D, 0xEB, 0x06
+    };
+
+    u8 const uncompressed[] = "word1 abc word2 word1 abc word2";
+
+    auto stream = make<AllocatingMemoryStream>();
+    auto decompressor = TRY_OR_FAIL(Compress::BrotliDecompressor::create(MaybeOwned<Stream> { *stream }));
+    TRY_OR_FAIL(stream->write_until_depleted(compressed));
+    auto decompressed = TRY_OR_FAIL(decompressor->read_until_eof());
+    EXPECT(decompressed.bytes() == (ReadonlyBytes { uncompressed, sizeof(uncompressed) - 1 }));
+}
+
+TEST_CASE(brotli_decompress_truncated)
+{
+    Array<u8, 20> const compressed {
+        0x1B, 0x1E, 0x00, 0xF8, 0x8D, 0xD4, 0x5E, 0x33, 0xF1, 0xA1, 0x59, 0xE5,
+        0x9B, 0xDC, 0x1D, 0xEC, 0x80, 0xAD, 0xDB, 0xB8
+    };
+
+    EXPECT(Compress::BrotliDecompressor::decompress_all(compressed).is_error());
+}
+
+TEST_CASE(brotli_round_trip)
+{
+    auto original = TRY_OR_FAIL(ByteBuffer::create_zeroed(256 * KiB));
+    fill_with_random(original.bytes().trim(64 * KiB));
+
+    auto compressed = TRY_OR_FAIL(Compress::BrotliCompressor::compress_all(original, Compress::GenericZlibCompressionLevel::Fastest));
+    auto uncompressed = TRY_OR_FAIL(Compress::BrotliDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
+TEST_CASE(brotli_round_trip_stream)
+{
+    auto original = TRY_OR_FAIL(ByteBuffer::create_zeroed(256 * KiB));
+    fill_with_random(original.bytes().trim(64 * KiB));
+
+    auto output_stream = make<AllocatingMemoryStream>();
+    auto compressor = TRY_OR_FAIL(Compress::BrotliCompressor::create(MaybeOwned<Stream> { *output_stream }));
+    for (size_t offset = 0; offset < original.size(); offset += 10 * KiB)
+        TRY_OR_FAIL(compressor->write_until_depleted(original.bytes().slice(offset, min(10 * KiB, original.size() - offset))));
+    TRY_OR_FAIL(compressor->finish());
+
+    auto compressed = TRY_OR_FAIL(output_stream->read_until_eof());
+    auto uncompressed = TRY_OR_FAIL(Compress::BrotliDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
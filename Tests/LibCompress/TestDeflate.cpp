@@ -155,3 +155,43 @@ TEST_CASE(deflate_compress_literals)
     Array<u8, 0x13> test { 0, 0, 0, 0, 0x72, 0, 0, 0xee, 0, 0, 0, 0x26, 0, 0, 0, 0x28, 0, 0, 0x72 };
     auto compressed = TRY_OR_FAIL(Compress::DeflateCompressor::compress_all(test));
 }
+
+TEST_CASE(deflate_flush_keeps_stream_going)
+{
+    AllocatingMemoryStream compressed;
+    auto compressor = TRY_OR_FAIL(Compress::DeflateCompressor::create(MaybeOwned<Stream>(compressed)));
+
+    AllocatingMemoryStream input;
+    auto decompressor = TRY_OR_FAIL(Compress::DeflateDecompressor::create(MaybeOwned<Stream>(input)));
+
+    // Each flush has to make everything written so far decodable, and later messages may refer back to earlier ones.
+    for (auto message : { "Hello"sv, "Hello"sv, "Hello, world"sv }) {
+        TRY_OR_FAIL(compressor->write_until_depleted(message.bytes()));
+        TRY_OR_FAIL(compressor->flush());
+
+        auto chunk = TRY_OR_FAIL(compressed.read_until_eof());
+        EXPECT(chunk.bytes().ends_with(Array<u8, 4> { 0x00, 0x00, 0xff, 0xff }.span()));
+
+        TRY_OR_FAIL(input.write_until_depleted(chunk));
+        auto decompressed = TRY_OR_FAIL(decompressor->decompress_available());
+        EXPECT_EQ(StringView { decompressed.bytes() }, message);
+    }
+}
+
+TEST_CASE(deflate_decompress_available_across_messages)
+{
+    // https://datatracker.ietf.org/doc/html/rfc7692#section-7.2.3.2
+    Array<u8, 11> const first_message { 0xf2, 0x48, 0xcd, 0xc9, 0xc9, 0x07, 0x00, 0x00, 0x00, 0xff, 0xff };
+    Array<u8, 9> const second_message { 0xf2, 0x00, 0x11, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff };
+
+    AllocatingMemoryStream input;
+    auto decompressor = TRY_OR_FAIL(Compress::DeflateDecompressor::create(MaybeOwned<Stream>(input)));
+
+    TRY_OR_FAIL(input.write_until_depleted(first_message));
+    auto first = TRY_OR_FAIL(decompressor->decompress_available());
+    EXPECT_EQ(StringView { first.bytes() }, "Hello"sv);
+
+    TRY_OR_FAIL(input.write_until_depleted(second_message));
+    auto second = TRY_OR_FAIL(decompressor->decompress_available());
+    EXPECT_EQ(StringView { second.bytes() }, "Hello"sv);
+}
@@ -4,6 +4,8 @@
  * SPDX-License-Identifier: BSD-2-Clause
  */
 
+#include <AK/MemoryStream.h>
+#include <AK/Random.h>
 #include <LibCompress/Gzip.h>
 #include <LibTest/TestCase.h>
 
@@ -91,6 +93,25 @@ TEST_CASE(gzip_round_trip)
     EXPECT(uncompressed == original);
 }
 
+TEST_CASE(gzip_round_trip_parallel)
+{
+    // Big enough to be compressed as several blocks in parallel, and repetitive enough for matches to cross blocks.
+    auto original = TRY_OR_FAIL(ByteBuffer::create_uninitialized(3 * MiB + 123));
+    fill_with_random(original.bytes().trim(64 * KiB));
+    for (size_t i = 64 * KiB; i < original.size(); ++i)
+        original[i] = original[i % (64 * KiB + 7)];
+
+    auto compressed = TRY_OR_FAIL(Compress::GzipCompressor::compress_all(original, Compress::GenericZlibCompressionLevel::Fastest));
+    EXPECT(compressed.size() < original.size());
+
+    auto uncompressed = TRY_OR_FAIL(Compress::GzipDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+
+    auto decompressor = TRY_OR_FAIL(Compress::GzipDecompressor::create(MaybeOwned<Stream>(make<FixedMemoryStream>(compressed.bytes()))));
+    auto streamed = TRY_OR_FAIL(decompressor->read_until_eof());
+    EXPECT(streamed == original);
+}
+
 TEST_CASE(gzip_truncated_uncompressed_block)
 {
     Array<u8, 38> const compressed {
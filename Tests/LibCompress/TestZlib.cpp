@@ -77,6 +77,20 @@ TEST_CASE(zlib_round_trip_simple_fastest)
     EXPECT(decompressed.bytes() == (ReadonlyBytes { uncompressed, sizeof(uncompressed) - 1 }));
 }
 
+TEST_CASE(zlib_round_trip_parallel)
+{
+    // Big enough to be compressed as several blocks in parallel, which still have to make up a single zlib stream.
+    auto original = TRY_OR_FAIL(ByteBuffer::create_uninitialized(2 * MiB + 5));
+    for (size_t i = 0; i < original.size(); ++i)
+        original[i] = static_cast<u8>((i * 7) ^ (i >> 9));
+
+    auto const freshly_pressed = TRY_OR_FAIL(Compress::ZlibCompressor::compress_all(original, Compress::GenericZlibCompressionLevel::Best));
+    EXPECT(freshly_pressed.span().slice(0, 2) == ReadonlyBytes { { 0x78, 0xDA } });
+
+    auto const decompressed = TRY_OR_FAIL(Compress::ZlibDecompressor::decompress_all(freshly_pressed));
+    EXPECT(decompressed == original);
+}
+
 TEST_CASE(zlib_decompress_with_missing_end_bits)
 {
     // This test case has been extracted from compressed PNG data of `/res/icons/16x16/app-masterword.png`.
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/ByteBuffer.h>
+#include <AK/MemoryStream.h>
+#include <AK/Random.h>
+#include <LibCompress/Zstd.h>
+#include <LibTest/TestCase.h>
+
+TEST_CASE(zstd_decompress_simple)
+{
+    Array<u8, 28> const compressed {
+        0x28, 0xB5, 0x2F, 0xFD, 0x04, 0x58, 0x79, 0x00, 0x00, 0x77, 0x6F, 0x72,
+        0x64, 0x31, 0x20, 0x61, 0x62, 0x63, 0x20, 0x77, 0x6F, 0x72, 0x64, 0x32,
+        0x21, 0x35, 0xEF, 0x99
+    };
+
+    u8 const uncompressed[] = "word1 abc word2";
+
+    auto const decompressed = TRY_OR_FAIL(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT(decompressed.bytes() == (ReadonlyBytes { uncompressed, sizeof(uncompressed) - 1 }));
+}
+
+TEST_CASE(zstd_decompress_multiple_frames)
+{
+    Array<u8, 50> const compressed {
+        0x28, 0xB5, 0x2F, 0xFD, 0x04, 0x58, 0x61, 0x00, 0x00, 0x61, 0x62, 0x63,
+        0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x7F, 0x07, 0x79,
+        0x96, 0x28, 0xB5, 0x2F, 0xFD, 0x04, 0x58, 0x61, 0x00, 0x00, 0x61, 0x62,
+        0x63, 0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x61, 0x62, 0x63, 0x7F, 0x07,
+        0x79, 0x96
+    };
+
+    u8 const uncompressed[] = "abcabcabcabcabcabcabcabc";
+
+    auto const decompressed = TRY_OR_FAIL(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT(decompressed.bytes() == (ReadonlyBytes { uncompressed, sizeof(uncompressed) - 1 }));
+}
+
+TEST_CASE(zstd_decompress_truncated)
+{
+    Array<u8, 20> const compressed {
+        0x28, 0xB5, 0x2F, 0xFD, 0x04, 0x58, 0x79, 0x00, 0x00, 0x77, 0x6F, 0x72,
+        0x64, 0x31, 0x20, 0x61, 0x62, 0x63, 0x20, 0x77
+    };
+
+    EXPECT(Compress::ZstdDecompressor::decompress_all(compressed).is_error());
+}
+
+TEST_CASE(zstd_round_trip)
+{
+    auto original = TRY_OR_FAIL(ByteBuffer::create_zeroed(256 * KiB));
+    fill_with_random(original.bytes().trim(64 * KiB));
+
+    auto compressed = TRY_OR_FAIL(Compress::ZstdCompressor::compress_all(original));
+    auto uncompressed = TRY_OR_FAIL(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
+
+TEST_CASE(zstd_round_trip_stream)
+{
+    auto original = TRY_OR_FAIL(ByteBuffer::create_zeroed(256 * KiB));
+    fill_with_random(original.bytes().trim(64 * KiB));
+
+    auto output_stream = make<AllocatingMemoryStream>();
+    auto compressor = TRY_OR_FAIL(Compress::ZstdCompressor::create(MaybeOwned<Stream> { *output_stream }, Compress::GenericZlibCompressionLevel::Fastest));
+    for (size_t offset = 0; offset < original.size(); offset += 10 * KiB)
+        TRY_OR_FAIL(compressor->write_until_depleted(original.bytes().slice(offset, min(10 * KiB, original.size() - offset))));
+    TRY_OR_FAIL(compressor->finish());
+
+    auto compressed = TRY_OR_FAIL(output_stream->read_until_eof());
+    auto uncompressed = TRY_OR_FAIL(Compress::ZstdDecompressor::decompress_all(compressed));
+    EXPECT(uncompressed == original);
+}
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibCore/TraceEvent.h>
+#include <LibTest/TestCase.h>
+
+static Vector<ByteString> recorded_event_names(Core::AnonymousBuffer const& buffer)
+{
+    Vector<ByteString> names;
+    Core::for_each_trace_event(buffer, [&](Core::TraceEvent const& event) {
+        names.append(event.name);
+    });
+    return names;
+}
+
+TEST_CASE(records_events_until_disabled)
+{
+    auto buffer = Core::create_trace_event_buffer();
+    Core::set_trace_event_buffer(buffer);
+    EXPECT(Core::is_tracing_enabled());
+
+    {
+        Core::TraceEventScope outer { "test"sv, "Outer"sv };
+        Core::TraceEventScope inner { "test"sv, "Inner"sv };
+    }
+
+    Core::disable_trace_event_buffer(buffer);
+    EXPECT(!Core::is_tracing_enabled());
+    {
+        Core::TraceEventScope ignored { "test"sv, "Ignored"sv };
+    }
+
+    EXPECT_EQ(recorded_event_names(buffer), (Vector<ByteString> { "Inner", "Outer" }));
+    EXPECT(Core::trace_event_buffer_pid(buffer).has_value());
+}
+
+TEST_CASE(long_names_are_truncated)
+{
+    auto buffer = Core::create_trace_event_buffer();
+    Core::set_trace_event_buffer(buffer);
+
+    auto long_name = ByteString::repeated('a', 200);
+    auto now = MonotonicTime::now();
+    Core::record_trace_event("category-that-is-too-long"sv, long_name, now, now + AK::Duration::from_milliseconds(3));
+
+    size_t event_count = 0;
+    Core::for_each_trace_event(buffer, [&](Core::TraceEvent const& event) {
+        ++event_count;
+        EXPECT_EQ(event.category, "category-that-i"sv);
+        EXPECT(long_name.starts_with(event.name));
+        EXPECT(event.name.length() < long_name.length());
+        EXPECT_EQ(event.start_time_in_nanoseconds, now.nanoseconds());
+        EXPECT_EQ(event.duration_in_nanoseconds, AK::Duration::from_milliseconds(3).to_nanoseconds());
+    });
+    EXPECT_EQ(event_count, 1u);
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Time.h>
+#include <LibCore/RateLimiter.h>
+#include <LibTest/TestCase.h>
+
+using AK::Duration;
+
+TEST_CASE(rate_limiter_allows_burst_up_to_capacity)
+{
+    Core::TokenBucketRateLimiter limiter(5, Duration::from_seconds(10));
+    EXPECT_EQ(limiter.available_tokens(), 5u);
+
+    for (int i = 0; i < 5; i++)
+        EXPECT(limiter.try_consume());
+
+    EXPECT(!limiter.would_allow());
+    EXPECT(!limiter.try_consume());
+    EXPECT_EQ(limiter.available_tokens(), 0u);
+    EXPECT_EQ(limiter.rejected_count(), 1u);
+}
+
+TEST_CASE(rate_limiter_consumes_multiple_tokens)
+{
+    Core::TokenBucketRateLimiter limiter(5, Duration::from_seconds(10));
+
+    EXPECT(limiter.try_consume(3));
+    EXPECT(!limiter.try_consume(3));
+    EXPECT(limiter.try_consume(2));
+    EXPECT_EQ(limiter.rejected_count(), 1u);
+}
+
+TEST_CASE(rate_limiter_reset_refills_bucket)
+{
+    Core::TokenBucketRateLimiter limiter(2, Duration::from_seconds(10));
+    EXPECT(limiter.try_consume(2));
+    EXPECT(!limiter.try_consume());
+
+    limiter.reset();
+    EXPECT_EQ(limiter.available_tokens(), 2u);
+    EXPECT(limiter.try_consume(2));
+
+    limiter.reset_rejected_count();
+    EXPECT_EQ(limiter.rejected_count(), 0u);
+}
+
+TEST_CASE(rate_limiter_time_until_available)
+{
+    Core::TokenBucketRateLimiter limiter(2, Duration::from_seconds(10));
+    EXPECT_EQ(limiter.time_until_available(), Duration::zero());
+    EXPECT_EQ(limiter.time_until_available(3), Duration::max());
+
+    EXPECT(limiter.try_consume(2));
+    auto wait = limiter.time_until_available();
+    EXPECT(wait > Duration::zero());
+    EXPECT(wait <= Duration::from_seconds(10));
+}
+
+TEST_CASE(rate_limiter_refill_rate)
+{
+    Core::TokenBucketRateLimiter limiter(100, 50);
+    EXPECT_EQ(limiter.capacity(), 100u);
+    EXPECT_EQ(limiter.refill_rate(), 50u);
+    EXPECT_EQ(limiter.refill_interval(), Duration::from_milliseconds(20));
+}
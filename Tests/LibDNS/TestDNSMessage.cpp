@@ -41,3 +41,31 @@ TEST_CASE(parsing_a_reserved_label_length_fails)
     auto result = DNS::Messages::Message::from_raw(stream);
     EXPECT(result.is_error());
 }
+
+// Queries sent over encrypted transports are padded to a multiple of 128 octets (RFC 8467, 4.1), so that their size
+// doesn't reveal the name being looked up. The padding must also survive a round trip through the parser.
+TEST_CASE(padding_a_query_to_a_block_size)
+{
+    for (auto name : { "a.example"sv, "a-much-longer-name-that-is-being-looked-up.example.com"sv }) {
+        DNS::Messages::Message query;
+        query.header.id = 1234;
+        query.header.question_count = 1;
+        query.header.options.set_recursion_desired(true);
+        query.questions.append({ .name = DNS::Messages::DomainName::from_string(name), .type = DNS::Messages::ResourceType::AAAA, .class_ = DNS::Messages::Class::IN });
+
+        TRY_OR_FAIL(query.pad_to_block_size(128));
+        EXPECT_EQ(query.additional_records.size(), 1u);
+
+        ByteBuffer encoded;
+        auto size = TRY_OR_FAIL(query.to_raw(encoded));
+        EXPECT_EQ(size % 128, 0u);
+
+        FixedMemoryStream stream { encoded.bytes() };
+        auto parsed = TRY_OR_FAIL(DNS::Messages::Message::from_raw(stream));
+        EXPECT_EQ(parsed.additional_records.size(), 1u);
+
+        auto const& opt = parsed.additional_records.first().record.get<DNS::Messages::Records::OPT>();
+        EXPECT_EQ(opt.options.size(), 1u);
+        EXPECT_EQ(opt.options.first().code, DNS::Messages::Records::OPT::OptionCodePadding);
+    }
+}
@@ -57,3 +57,28 @@ TEST_CASE(string_can_contain_null_bytes)
     remove_item("my_key"_string);
     EXPECT_EQ(get_item("my_key"_string), Optional<String> {});
 }
+
+TEST_CASE(profiles_apply_their_pragmas)
+{
+    auto pragma_value = [](Database::Database& database, StringView pragma) {
+        i64 value = 0;
+        database.execute_statement(
+            MUST(database.prepare_statement(pragma)),
+            [&](auto statement_id) {
+                value = database.result_column<i64>(statement_id, 0);
+            });
+        return value;
+    };
+
+    auto user_data_database = TRY_OR_FAIL(Database::Database::create_memory_backed(Database::Profile::UserData));
+    EXPECT_EQ(pragma_value(*user_data_database, "PRAGMA cache_size;"sv), -4096);
+    EXPECT_EQ(pragma_value(*user_data_database, "PRAGMA synchronous;"sv), 1);
+    EXPECT_EQ(pragma_value(*user_data_database, "PRAGMA temp_store;"sv), 2);
+
+    auto cache_database = TRY_OR_FAIL(Database::Database::create_memory_backed(Database::Profile::Cache));
+    EXPECT_EQ(pragma_value(*cache_database, "PRAGMA cache_size;"sv), -8192);
+    EXPECT_EQ(pragma_value(*cache_database, "PRAGMA synchronous;"sv), 0);
+
+    auto telemetry_database = TRY_OR_FAIL(Database::Database::create_memory_backed(Database::Profile::Telemetry));
+    EXPECT_EQ(pragma_value(*telemetry_database, "PRAGMA cache_size;"sv), -512);
+}
@@ -887,7 +887,7 @@ public:
 
         ByteBuffer response_body;
         response_body.append("{\"ok\":true}", 11);
-        on_network_response_body_received(100, move(response_body));
+        on_network_response_body_received(100, response_body.bytes());
 
         Requests::RequestTimingInfo timing_info;
         timing_info.request_start_microseconds = 1000;
@@ -944,7 +944,7 @@ public:
     mutable Function<void(WebView::ConsoleOutput)> on_console_message;
     mutable Function<void(DevToolsDelegate::NetworkRequestData)> on_network_request_started;
     mutable Function<void(DevToolsDelegate::NetworkResponseData)> on_network_response_headers_received;
-    mutable Function<void(u64, ByteBuffer)> on_network_response_body_received;
+    mutable Function<void(u64, ReadonlyBytes)> on_network_response_body_received;
     mutable Function<void(DevToolsDelegate::NetworkRequestCompleteData)> on_network_request_finished;
     mutable Function<void(DevToolsDelegate::NodePickerEvent)> on_node_picker_event;
 
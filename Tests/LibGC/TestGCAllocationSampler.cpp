@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/NeverDestroyed.h>
+#include <LibGC/Cell.h>
+#include <LibGC/CellAllocator.h>
+#include <LibGC/DeferGC.h>
+#include <LibGC/Heap.h>
+#include <LibTest/TestCase.h>
+
+class TestCell : public GC::Cell {
+    GC_CELL(TestCell, GC::Cell);
+    GC_DECLARE_ALLOCATOR(TestCell);
+
+    // Padding to satisfy minimum cell size (must be >= sizeof(FreelistEntry)).
+    u8 m_padding[16] {};
+};
+
+GC_DEFINE_ALLOCATOR(TestCell);
+
+static GC::Heap& test_heap()
+{
+    static AK::NeverDestroyed<GC::Heap> heap([](auto&) { });
+    return *heap;
+}
+
+TEST_SETUP
+{
+    GC::Heap::set_default_heap_for_testing(test_heap());
+}
+
+TEST_CASE(samples_average_out_to_the_interval)
+{
+    auto& heap = test_heap();
+    GC::DeferGC defer_gc(heap);
+
+    size_t sample_count = 0;
+    bool saw_wrong_size = false;
+    heap.set_allocation_sampler(sizeof(TestCell) * 10, [&](GC::Cell&, size_t size_in_bytes) {
+        ++sample_count;
+        if (size_in_bytes != sizeof(TestCell))
+            saw_wrong_size = true;
+    });
+
+    for (size_t i = 0; i < 10'000; ++i)
+        (void)heap.allocate<TestCell>();
+
+    heap.clear_allocation_sampler();
+    EXPECT(!saw_wrong_size);
+    EXPECT(sample_count > 800);
+    EXPECT(sample_count < 1200);
+}
+
+TEST_CASE(clearing_the_sampler_stops_the_samples)
+{
+    auto& heap = test_heap();
+    GC::DeferGC defer_gc(heap);
+
+    size_t sample_count = 0;
+    heap.set_allocation_sampler(sizeof(TestCell), [&](GC::Cell&, size_t) { ++sample_count; });
+    (void)heap.allocate<TestCell>();
+    (void)heap.allocate<TestCell>();
+    heap.clear_allocation_sampler();
+
+    auto sample_count_before_clearing = sample_count;
+    for (size_t i = 0; i < 100; ++i)
+        (void)heap.allocate<TestCell>();
+    EXPECT_EQ(sample_count, sample_count_before_clearing);
+}
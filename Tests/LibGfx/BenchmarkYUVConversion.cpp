@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/YUVData.h>
+#include <LibTest/TestCase.h>
+
+static constexpr Gfx::IntSize frame_size { 1920, 1080 };
+
+static NonnullOwnPtr<Gfx::YUVData> create_frame(u8 bit_depth, Media::Subsampling subsampling, Media::MatrixCoefficients matrix_coefficients)
+{
+    auto const cicp = Media::CodingIndependentCodePoints {
+        Media::ColorPrimaries::BT709,
+        Media::TransferCharacteristics::BT709,
+        matrix_coefficients,
+        Media::VideoFullRangeFlag::Studio,
+    };
+    auto yuv_data = MUST(Gfx::YUVData::create(frame_size, bit_depth, subsampling, cicp));
+
+    // A gradient keeps the converter from seeing a constant plane.
+    auto fill = [&](Bytes plane) {
+        if (bit_depth <= 8) {
+            for (size_t i = 0; i < plane.size(); i++)
+                plane[i] = static_cast<u8>(16 + (i % 220));
+            return;
+        }
+        auto* samples = reinterpret_cast<u16*>(plane.data());
+        auto max_sample = (1u << bit_depth) - 1;
+        for (size_t i = 0; i < plane.size() / 2; i++)
+            samples[i] = static_cast<u16>(i % max_sample);
+    };
+    fill(yuv_data->y_data());
+    fill(yuv_data->u_data());
+    fill(yuv_data->v_data());
+    return yuv_data;
+}
+
+static void convert(u8 bit_depth, Media::Subsampling subsampling, Media::MatrixCoefficients matrix_coefficients = Media::MatrixCoefficients::BT709)
+{
+    auto frame = create_frame(bit_depth, subsampling, matrix_coefficients);
+    for (size_t i = 0; i < 10; i++)
+        (void)MUST(frame->to_bitmap());
+}
+
+BENCHMARK_CASE(yuv420_8_bit)
+{
+    convert(8, { true, true });
+}
+
+BENCHMARK_CASE(yuv422_8_bit)
+{
+    convert(8, { true, false });
+}
+
+BENCHMARK_CASE(yuv444_8_bit)
+{
+    convert(8, { false, false });
+}
+
+BENCHMARK_CASE(yuv420_10_bit)
+{
+    convert(10, { true, true });
+}
+
+BENCHMARK_CASE(yuv420_12_bit)
+{
+    convert(12, { true, true });
+}
+
+BENCHMARK_CASE(yuv444_12_bit)
+{
+    convert(12, { false, false });
+}
+
+BENCHMARK_CASE(gbr_8_bit)
+{
+    convert(8, { false, false }, Media::MatrixCoefficients::Identity);
+}
@@ -306,6 +306,20 @@ TEST_CASE(test_jpeg_sof0_several_scans)
     TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 592, 800 }));
 }
 
+TEST_CASE(test_jpeg_ideal_size_scales_while_decoding)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/several_scans.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+
+    // 592x800 at 2/8 is 148x200, the smallest scale that covers 140x190.
+    auto frame = TRY_OR_FAIL(plugin_decoder->frame(0, Gfx::IntSize { 140, 190 }));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(148, 200));
+    EXPECT_EQ(plugin_decoder->size(), Gfx::IntSize(592, 800));
+
+    frame = TRY_OR_FAIL(plugin_decoder->frame(0));
+    EXPECT_EQ(frame.image->size(), Gfx::IntSize(592, 800));
+}
+
 TEST_CASE(test_odd_mcu_restart_interval)
 {
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/odd-restart.jpg"sv)));
@@ -1222,3 +1236,97 @@ TEST_CASE(test_avif_missing_pixi_property)
     auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("avif/missing-pixi-property.avif"sv)));
     EXPECT(Gfx::AVIFImageDecoderPlugin::sniff(file->bytes()));
 }
+
+static Vector<NonnullRefPtr<Gfx::Bitmap>> decode_incrementally(ReadonlyBytes data, size_t chunk_size)
+{
+    Gfx::IncrementalImageDecoder decoder;
+    Vector<NonnullRefPtr<Gfx::Bitmap>> partial_frames;
+    for (size_t offset = 0; offset < data.size(); offset += chunk_size) {
+        decoder.append_data(data.slice(offset, min(chunk_size, data.size() - offset)));
+        if (auto partial_frame = MUST(decoder.take_partial_frame()))
+            partial_frames.append(partial_frame.release_nonnull());
+    }
+    EXPECT(decoder.can_decode_partially());
+    EXPECT(!MUST(decoder.take_partial_frame()));
+    return partial_frames;
+}
+
+static void expect_same_pixels(Gfx::Bitmap const& bitmap, Gfx::Bitmap const& expected)
+{
+    EXPECT_EQ(bitmap.size(), expected.size());
+    for (int y = 0; y < expected.height(); ++y) {
+        for (int x = 0; x < expected.width(); ++x) {
+            if (bitmap.get_pixel(x, y) != expected.get_pixel(x, y)) {
+                FAIL(ByteString::formatted("Pixel ({}, {}) differs", x, y));
+                return;
+            }
+        }
+    }
+}
+
+TEST_CASE(test_png_incremental)
+{
+    Array test_inputs = {
+        TEST_INPUT("png/buggie.png"sv),
+        TEST_INPUT("png/buggie-interlaced.png"sv)
+    };
+
+    for (auto test_input : test_inputs) {
+        auto file = TRY_OR_FAIL(Core::MappedFile::map(test_input));
+        auto plugin_decoder = TRY_OR_FAIL(Gfx::PNGImageDecoderPlugin::create(file->bytes()));
+        auto frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 64, 138 }));
+
+        auto partial_frames = decode_incrementally(file->bytes(), 512);
+        EXPECT(partial_frames.size() > 1);
+        EXPECT(partial_frames.first()->anonymous_buffer().is_valid());
+        EXPECT_EQ(partial_frames.first()->get_pixel(0, 137), Gfx::Color::NamedColor::Transparent);
+        expect_same_pixels(partial_frames.last(), frame.image);
+    }
+}
+
+TEST_CASE(test_jpeg_incremental)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/rgb24.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+    auto frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 127, 64 }));
+
+    // Data arriving a byte at a time makes the decoder suspend everywhere, including in the middle of skipped markers.
+    auto partial_frames = decode_incrementally(file->bytes(), 1);
+    EXPECT(partial_frames.size() > 1);
+    EXPECT_EQ(partial_frames.first()->get_pixel(0, 63), Gfx::Color::NamedColor::Transparent);
+    expect_same_pixels(partial_frames.last(), frame.image);
+}
+
+TEST_CASE(test_jpeg_incremental_progressive)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/successive_approximation.jpg"sv)));
+    auto plugin_decoder = TRY_OR_FAIL(Gfx::JPEGImageDecoderPlugin::create(file->bytes()));
+    auto frame = TRY_OR_FAIL(expect_single_frame_of_size(*plugin_decoder, { 600, 800 }));
+
+    // Every scan redraws the whole image, so the bottom row shows up long before the data is complete.
+    auto partial_frames = decode_incrementally(file->bytes(), 1024);
+    EXPECT(partial_frames.size() > 1);
+    auto first_full_pass = partial_frames.find_first_index_if([](auto& partial_frame) { return partial_frame->get_pixel(0, 799).alpha() == 255; });
+    EXPECT(first_full_pass.has_value());
+    EXPECT(*first_full_pass < partial_frames.size() - 1);
+    expect_same_pixels(partial_frames.last(), frame.image);
+}
+
+TEST_CASE(test_incremental_unsupported_format)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("gif/minimal-1x1.gif"sv)));
+
+    Gfx::IncrementalImageDecoder decoder;
+    decoder.append_data(file->bytes());
+    EXPECT(!decoder.can_decode_partially());
+    EXPECT(!MUST(decoder.take_partial_frame()));
+}
+
+TEST_CASE(test_incremental_cmyk_jpeg)
+{
+    auto file = TRY_OR_FAIL(Core::MappedFile::map(TEST_INPUT("jpg/buggie-cmyk.jpg"sv)));
+
+    Gfx::IncrementalImageDecoder decoder;
+    decoder.append_data(file->bytes());
+    EXPECT(!decoder.can_decode_partially());
+}
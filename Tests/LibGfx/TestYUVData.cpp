@@ -83,3 +83,30 @@ TEST_CASE(high_bit_depth_pixmaps_expand_without_mutating_native_samples)
             EXPECT_EQ(bitmap_after->get_pixel(x, y), bitmap_before->get_pixel(x, y));
     }
 }
+
+TEST_CASE(planes_are_shared_through_the_anonymous_buffer)
+{
+    auto const cicp = Media::CodingIndependentCodePoints {
+        Media::ColorPrimaries::BT709,
+        Media::TransferCharacteristics::BT709,
+        Media::MatrixCoefficients::BT709,
+        Media::VideoFullRangeFlag::Studio,
+    };
+    auto subsampling = Media::Subsampling { true, true };
+    auto yuv_data = TRY_OR_FAIL(Gfx::YUVData::create({ 4, 2 }, 8, subsampling, cicp));
+
+    auto sizes = TRY_OR_FAIL(Gfx::YUVData::plane_sizes({ 4, 2 }, 8, subsampling));
+    EXPECT_EQ(yuv_data->anonymous_buffer().size(), sizes.total);
+
+    yuv_data->y_data().fill(16);
+    yuv_data->u_data().fill(128);
+    yuv_data->v_data().fill(240);
+
+    auto shared = TRY_OR_FAIL(Gfx::YUVData::create_with_anonymous_buffer({ 4, 2 }, 8, subsampling, cicp, yuv_data->anonymous_buffer()));
+    EXPECT_EQ(shared->y_data().data(), yuv_data->y_data().data());
+    EXPECT_EQ(shared->u_data()[0], 128);
+    EXPECT_EQ(shared->v_data()[sizes.v - 1], 240);
+
+    auto too_small = TRY_OR_FAIL(Core::AnonymousBuffer::create_with_size(sizes.total - 1));
+    EXPECT(Gfx::YUVData::create_with_anonymous_buffer({ 4, 2 }, 8, subsampling, cicp, move(too_small)).is_error());
+}
@@ -100,6 +100,7 @@ TEST_CASE(remove_entries_exceeding_cache_limit_tolerates_replaced_unloaded_entri
 
     for (u64 cache_key = 1; cache_key <= 8; ++cache_key)
         TRY_OR_FAIL(state.index.create_entry(cache_key, vary_key, "https://example.com"_string, request_headers, response_headers, 10, now, now));
+    state.index.flush_pending_writes();
 
     auto reloaded_index = MUST(HTTP::CacheIndex::create(*state.database, cache_directory()));
     TRY_OR_FAIL(reloaded_index.create_entry(1, vary_key, "https://example.com"_string, request_headers, response_headers, 10, now, now));
@@ -113,6 +114,61 @@ TEST_CASE(remove_entries_exceeding_cache_limit_tolerates_replaced_unloaded_entri
     EXPECT_EQ(reloaded_index.estimate_cache_size_accessed_since(UnixDateTime::earliest()).total, 80u);
 }
 
+TEST_CASE(pending_writes_are_coalesced_until_flushed)
+{
+    auto state = create_cache_index();
+
+    auto request_headers = HTTP::HeaderList::create();
+    auto response_headers = HTTP::HeaderList::create();
+    auto vary_key = HTTP::create_vary_key(*request_headers, *response_headers);
+    auto now = UnixDateTime::now();
+
+    TRY_OR_FAIL(state.index.create_entry(1, vary_key, "https://example.com"_string, request_headers, response_headers, 10, now, now));
+    for (size_t i = 0; i < 10; ++i)
+        state.index.update_last_access_time(1, vary_key);
+    state.index.update_associated_data_size(1, vary_key, 5);
+    EXPECT_EQ(state.index.pending_write_count(), 1u);
+
+    // Nothing has reached the database yet.
+    {
+        auto reloaded_index = MUST(HTTP::CacheIndex::create(*state.database, cache_directory()));
+        EXPECT(!reloaded_index.find_entry(1, *request_headers).has_value());
+    }
+
+    state.index.flush_pending_writes();
+    EXPECT_EQ(state.index.pending_write_count(), 0u);
+
+    auto reloaded_index = MUST(HTTP::CacheIndex::create(*state.database, cache_directory()));
+    auto entry = reloaded_index.find_entry(1, *request_headers);
+    VERIFY(entry.has_value());
+    EXPECT_EQ(entry->data_size, 10u);
+    EXPECT_EQ(entry->associated_data_size, 5u);
+    EXPECT_EQ(reloaded_index.estimate_cache_size_accessed_since(UnixDateTime::earliest()).total, 15u);
+}
+
+TEST_CASE(pending_writes_are_flushed_when_batch_is_full)
+{
+    auto state = create_cache_index();
+
+    auto request_headers = HTTP::HeaderList::create();
+    auto response_headers = HTTP::HeaderList::create();
+    auto vary_key = HTTP::create_vary_key(*request_headers, *response_headers);
+    auto now = UnixDateTime::now();
+
+    for (u64 cache_key = 1; cache_key <= HTTP::CacheIndex::MAXIMUM_PENDING_WRITES; ++cache_key)
+        TRY_OR_FAIL(state.index.create_entry(cache_key, vary_key, "https://example.com"_string, request_headers, response_headers, 10, now, now));
+    EXPECT_EQ(state.index.pending_write_count(), 0u);
+
+    state.index.remove_entry(1, vary_key);
+    EXPECT_EQ(state.index.pending_write_count(), 1u);
+    state.index.flush_pending_writes();
+
+    auto reloaded_index = MUST(HTTP::CacheIndex::create(*state.database, cache_directory()));
+    EXPECT(!reloaded_index.has_entry(1, vary_key));
+    EXPECT(reloaded_index.has_entry(2, vary_key));
+    EXPECT_EQ(reloaded_index.estimate_cache_size_accessed_since(UnixDateTime::earliest()).total, (HTTP::CacheIndex::MAXIMUM_PENDING_WRITES - 1) * 10);
+}
+
 TEST_CASE(associated_data_counts_toward_cache_size)
 {
     auto state = create_cache_index();
@@ -43,3 +43,22 @@ TEST_CASE(is_cacheable_must_understand_accepts_304_status)
     auto headers = HTTP::HeaderList::create({ { "Cache-Control", "must-understand, no-store, max-age=3600" } });
     EXPECT(HTTP::is_cacheable(304, *headers));
 }
+
+TEST_CASE(stale_if_error_keeps_stale_response_for_revalidation)
+{
+    auto request_headers = HTTP::HeaderList::create();
+    auto response_headers = HTTP::HeaderList::create({ { "Cache-Control", "max-age=60, stale-if-error=600" }, { "ETag", "\"abc\"" } });
+    auto freshness_lifetime = AK::Duration::from_seconds(60);
+
+    EXPECT_EQ(HTTP::calculate_stale_if_error_lifetime(*request_headers, *response_headers, freshness_lifetime), AK::Duration::from_seconds(660));
+    EXPECT_EQ(HTTP::cache_lifetime_status(*request_headers, *response_headers, freshness_lifetime, AK::Duration::from_seconds(120)), HTTP::CacheLifetimeStatus::MustRevalidate);
+    EXPECT_EQ(HTTP::cache_lifetime_status(*request_headers, *response_headers, freshness_lifetime, AK::Duration::from_seconds(700)), HTTP::CacheLifetimeStatus::Expired);
+}
+
+TEST_CASE(stale_if_error_does_not_override_must_revalidate)
+{
+    auto request_headers = HTTP::HeaderList::create({ { "Cache-Control", "stale-if-error=600" } });
+    auto response_headers = HTTP::HeaderList::create({ { "Cache-Control", "max-age=60, must-revalidate" }, { "ETag", "\"abc\"" } });
+
+    EXPECT_EQ(HTTP::calculate_stale_if_error_lifetime(*request_headers, *response_headers, AK::Duration::from_seconds(60)), AK::Duration::zero());
+}
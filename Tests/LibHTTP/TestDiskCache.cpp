@@ -5,7 +5,11 @@
  */
 
 #include <AK/ByteBuffer.h>
+#include <AK/ScopeGuard.h>
+#include <AK/StringBuilder.h>
+#include <LibCore/EventLoop.h>
 #include <LibCore/ImmutableBytes.h>
+#include <LibCore/System.h>
 #include <LibHTTP/Cache/CacheRequest.h>
 #include <LibHTTP/Cache/DiskCache.h>
 #include <LibHTTP/Cache/Utilities.h>
@@ -135,6 +139,68 @@ TEST_CASE(flush_returns_mappable_body_file)
     EXPECT_EQ(body.bytes(), "console.log('hello');"sv.bytes());
 }
 
+TEST_CASE(compressed_text_body_is_streamed_back_decompressed)
+{
+    Core::EventLoop event_loop;
+
+    auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing));
+    disk_cache.set_compress_text_bodies(true);
+    TestCacheRequest request;
+
+    auto url = parse_url("https://example.com/script.js"sv);
+    auto request_headers = create_cacheable_request_headers();
+    auto response_headers = HTTP::HeaderList::create({
+        { "Cache-Control"sv, "max-age=60"sv },
+        { "Content-Type"sv, "text/javascript; charset=utf-8"sv },
+    });
+
+    StringBuilder builder;
+    for (size_t i = 0; i < 1000; ++i)
+        builder.appendff("console.log('line {}');\n", i);
+    auto body = builder.to_byte_string();
+
+    auto& writer = create_cache_entry(disk_cache, request, url, *request_headers);
+    TRY_OR_FAIL(writer.write_status_and_reason(200, "OK"_string, *request_headers, *response_headers));
+    EXPECT(writer.is_body_compressed());
+    TRY_OR_FAIL(writer.write_data(body.bytes().slice(0, body.length() / 2)));
+    TRY_OR_FAIL(writer.write_data(body.bytes().slice(body.length() / 2)));
+
+    // The entry is still flushed, but its body cannot be handed out for mapping
+    EXPECT(writer.flush_and_take_body_file(request_headers, response_headers).is_error());
+
+    Optional<HTTP::CacheEntryReader&> reader;
+    disk_cache.open_entry(request, url, "GET"sv, *request_headers, HTTP::CacheMode::Default, HTTP::DiskCache::OpenMode::Read)
+        .visit(
+            [&](Optional<HTTP::CacheEntryReader&> cache_entry_reader) {
+                reader = cache_entry_reader;
+            },
+            [](HTTP::DiskCache::CacheHasOpenEntry) {
+                FAIL("Cache entry was unexpectedly open");
+            });
+
+    VERIFY(reader.has_value());
+    EXPECT(reader->is_body_compressed());
+    EXPECT(reader->body_size() < body.length() / 2);
+
+    int socket_fds[2] {};
+    TRY_OR_FAIL(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, socket_fds));
+    ScopeGuard close_sockets = [&] {
+        (void)Core::System::close(socket_fds[0]);
+        (void)Core::System::close(socket_fds[1]);
+    };
+
+    // The body fits in the socket buffer, so it is sent without waiting on the event loop
+    Optional<u64> bytes_sent;
+    reader->send_to(socket_fds[0], [&](auto sent) { bytes_sent = sent; }, [](auto) { FAIL("Unable to send cache entry"); });
+    EXPECT_EQ(bytes_sent, body.length());
+
+    auto received = TRY_OR_FAIL(ByteBuffer::create_uninitialized(body.length()));
+    size_t received_size = 0;
+    while (received_size < received.size())
+        received_size += TRY_OR_FAIL(Core::System::read(socket_fds[1], received.bytes().slice(received_size)));
+    EXPECT_EQ(received.bytes(), body.bytes());
+}
+
 TEST_CASE(replacing_cache_entry_keeps_existing_body_mapping_stable)
 {
     auto disk_cache = MUST(HTTP::DiskCache::create(HTTP::DiskCache::Mode::Testing));
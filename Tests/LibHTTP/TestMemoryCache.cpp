@@ -117,3 +117,66 @@ TEST_CASE(javascript_bytecode_cache_can_be_added_after_memory_cache_entry_is_com
     EXPECT_EQ(entry->javascript_bytecode_cache->bytes(), bytecode.bytes());
     EXPECT_EQ(entry->javascript_bytecode_cache_vary_key, Optional<u64> { 0 });
 }
+
+static void store_response(HTTP::MemoryCache& cache, StringView url, size_t body_size)
+{
+    auto request_headers = create_cacheable_request_headers();
+    auto response_headers = create_cacheable_response_headers();
+    auto body = MUST(ByteBuffer::create_zeroed(body_size));
+
+    cache.create_entry(parse_url(url), "GET"sv, *request_headers, UnixDateTime::now(), 200, "OK"sv, *response_headers);
+    cache.finalize_entry(parse_url(url), "GET"sv, *request_headers, 200, *response_headers, MUST(Core::ImmutableBytes::copy(body.bytes())));
+}
+
+static bool is_cached(HTTP::MemoryCache& cache, StringView url)
+{
+    auto request_headers = create_cacheable_request_headers();
+    return cache.open_entry(parse_url(url), "GET"sv, *request_headers, HTTP::CacheMode::Default).has_value();
+}
+
+TEST_CASE(memory_cache_stays_within_its_maximum_size)
+{
+    auto cache = HTTP::MemoryCache::create(100 * KiB);
+
+    for (size_t i = 0; i < 50; ++i) {
+        store_response(*cache, ByteString::formatted("https://example.com/{}.js", i), 10 * KiB);
+        EXPECT(cache->size() <= cache->maximum_size());
+    }
+
+    EXPECT(cache->size() > 50 * KiB);
+    EXPECT(cache->statistics().evicted_entries + cache->statistics().rejected_entries >= 40u);
+
+    cache->set_maximum_size(30 * KiB);
+    EXPECT(cache->size() <= 30 * KiB);
+    EXPECT_EQ(cache->estimate_cache_size_accessed_since(UnixDateTime::earliest()).total, cache->size());
+}
+
+TEST_CASE(memory_cache_keeps_popular_responses_through_a_scan)
+{
+    auto cache = HTTP::MemoryCache::create(200 * KiB);
+
+    store_response(*cache, "https://example.com/popular.js"sv, 10 * KiB);
+    for (size_t i = 0; i < 10; ++i)
+        EXPECT(is_cached(*cache, "https://example.com/popular.js"sv));
+
+    // A stream of responses that are each requested once must not flush the popular one out
+    for (size_t i = 0; i < 100; ++i)
+        store_response(*cache, ByteString::formatted("https://example.com/once/{}.js", i), 10 * KiB);
+
+    EXPECT(is_cached(*cache, "https://example.com/popular.js"sv));
+    EXPECT(cache->statistics().rejected_entries > 0);
+    EXPECT_EQ(cache->statistics().hits, 11u);
+}
+
+TEST_CASE(memory_cache_does_not_store_responses_larger_than_its_budget)
+{
+    auto cache = HTTP::MemoryCache::create(64 * KiB);
+
+    store_response(*cache, "https://example.com/small.js"sv, 1 * KiB);
+    store_response(*cache, "https://example.com/huge.js"sv, 128 * KiB);
+
+    EXPECT(is_cached(*cache, "https://example.com/small.js"sv));
+    EXPECT(!is_cached(*cache, "https://example.com/huge.js"sv));
+    EXPECT_EQ(cache->statistics().rejected_entries, 1u);
+    EXPECT_EQ(cache->statistics().misses, 1u);
+}
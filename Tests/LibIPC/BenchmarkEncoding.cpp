@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/MemoryStream.h>
+#include <AK/Queue.h>
+#include <AK/String.h>
+#include <AK/Vector.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
+#include <LibIPC/Message.h>
+#include <LibTest/TestCase.h>
+#include <LibURL/Parser.h>
+
+static constexpr size_t round_trip_count = 1000;
+
+template<typename T>
+static void round_trip(T const& value)
+{
+    for (size_t i = 0; i < round_trip_count; ++i) {
+        IPC::MessageBuffer buffer;
+        IPC::Encoder encoder { buffer };
+        MUST(encoder.encode(value));
+
+        FixedMemoryStream stream { buffer.data().span() };
+        Queue<IPC::Attachment> attachments;
+        IPC::Decoder decoder { stream, attachments };
+        auto decoded = MUST(decoder.decode<T>());
+        EXPECT_EQ(decoded.size(), value.size());
+    }
+}
+
+BENCHMARK_CASE(round_trip_integers)
+{
+    Vector<u32> values;
+    for (u32 i = 0; i < 4096; ++i)
+        values.append(i * 2654435761u);
+    round_trip(values);
+}
+
+BENCHMARK_CASE(round_trip_strings)
+{
+    Vector<String> values;
+    for (int i = 0; i < 256; ++i)
+        values.append(MUST(String::formatted("https://example.com/resources/{}/style.css?v={}", i, i * 31)));
+    round_trip(values);
+}
+
+BENCHMARK_CASE(round_trip_byte_buffer)
+{
+    auto buffer = MUST(ByteBuffer::create_zeroed(256 * KiB));
+    round_trip(buffer);
+}
+
+BENCHMARK_CASE(round_trip_urls)
+{
+    Vector<URL::URL> urls;
+    for (int i = 0; i < 64; ++i)
+        urls.append(*URL::Parser::basic_parse(ByteString::formatted("https://user@www.example.com:8080/path/to/{}/index.html?query={}#fragment", i, i)));
+    round_trip(urls);
+}
@@ -5,12 +5,15 @@
  */
 
 #include <AK/ByteString.h>
+#include <AK/MemoryStream.h>
 #include <AK/Queue.h>
 #include <AK/RefPtr.h>
 #include <LibCore/EventLoop.h>
 #include <LibCore/Socket.h>
 #include <LibCore/System.h>
 #include <LibIPC/Connection.h>
+#include <LibIPC/Decoder.h>
+#include <LibIPC/Encoder.h>
 #include <LibIPC/Message.h>
 #include <LibIPC/Stub.h>
 #include <LibIPC/TransportSocket.h>
@@ -21,6 +24,7 @@ namespace {
 constexpr u32 TEST_MAGIC = 0xCAFEF00D;
 constexpr int TARGET_MESSAGE_ID = 1;
 constexpr int OTHER_MESSAGE_ID = 2;
+constexpr int BORROWING_MESSAGE_ID = 3;
 
 class TestMessage final : public IPC::Message {
 public:
@@ -42,6 +46,45 @@ private:
     int m_id { 0 };
 };
 
+// Decodes like a generated message with a [Borrowed] ByteBuffer parameter
+class BorrowingMessage final : public IPC::Message {
+public:
+    explicit BorrowingMessage(ReadonlyBytes data)
+        : m_data(data)
+    {
+    }
+
+    static ErrorOr<NonnullOwnPtr<BorrowingMessage>> decode(FixedMemoryStream& stream, Queue<IPC::Attachment>& attachments)
+    {
+        IPC::Decoder decoder { stream, attachments };
+        auto data = TRY(decoder.decode_borrowed_bytes());
+        return make<BorrowingMessage>(data);
+    }
+
+    u32 endpoint_magic() const override { return TEST_MAGIC; }
+    int message_id() const override { return BORROWING_MESSAGE_ID; }
+    StringView message_name() const override { return "BorrowingMessage"sv; }
+
+    ErrorOr<IPC::MessageBuffer> encode() const override
+    {
+        IPC::MessageBuffer buffer;
+        IPC::Encoder encoder(buffer);
+        TRY(encoder.encode(TEST_MAGIC));
+        TRY(encoder.encode(BORROWING_MESSAGE_ID));
+        TRY(encoder.encode(m_data));
+        return buffer;
+    }
+
+    virtual void adopt_buffer(Vector<u8>&& buffer) override { m_buffer = move(buffer); }
+
+    ReadonlyBytes data() const { return m_data; }
+    bool has_adopted_buffer() const { return !m_buffer.is_empty(); }
+
+private:
+    ReadonlyBytes m_data;
+    Vector<u8> m_buffer;
+};
+
 class CountingStub final : public IPC::Stub {
 public:
     u32 magic() const override { return TEST_MAGIC; }
@@ -74,9 +117,18 @@ public:
     }
 
 protected:
-    OwnPtr<IPC::Message> try_parse_message(ReadonlyBytes, Queue<IPC::Attachment>&) override
+    OwnPtr<IPC::Message> try_parse_message(ReadonlyBytes bytes, Queue<IPC::Attachment>& attachments) override
     {
-        return nullptr;
+        FixedMemoryStream stream { bytes };
+        auto magic = stream.read_value<u32>();
+        auto message_id = stream.read_value<i32>();
+        if (magic.is_error() || magic.value() != TEST_MAGIC || message_id.is_error() || message_id.value() != BORROWING_MESSAGE_ID)
+            return nullptr;
+
+        auto message = BorrowingMessage::decode(stream, attachments);
+        if (message.is_error())
+            return nullptr;
+        return message.release_value();
     }
 
 private:
@@ -120,3 +172,34 @@ TEST_CASE(sync_wait_failure_does_not_dispatch_queued_messages)
     EXPECT(!response);
     EXPECT_EQ(stub.handle_count(), 0u);
 }
+
+TEST_CASE(borrowed_parameters_remain_valid_after_the_message_is_received)
+{
+    Core::EventLoop loop;
+
+    int fds[2] = {};
+    MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+
+    auto local_socket = TRY_OR_FAIL(Core::LocalSocket::adopt_fd(fds[0]));
+    auto peer_socket = TRY_OR_FAIL(Core::LocalSocket::adopt_fd(fds[1]));
+
+    MUST(local_socket->set_blocking(false));
+    MUST(peer_socket->set_blocking(false));
+
+    CountingStub stub;
+    auto connection = TestConnection::construct(stub, make<IPC::TransportSocket>(move(local_socket)));
+
+    IPC::TransportSocket peer_transport(move(peer_socket));
+    auto payload = "borrowed straight out of the message"sv;
+    auto message_buffer = TRY_OR_FAIL(BorrowingMessage { payload.bytes() }.encode());
+    TRY_OR_FAIL(message_buffer.transfer_message(peer_transport));
+
+    auto message = connection->call_wait_for_specific_endpoint_message_impl(TEST_MAGIC, BORROWING_MESSAGE_ID);
+    VERIFY(message);
+
+    // The transport has let go of the received bytes by now, so the view is only valid if the message adopted them
+    auto& borrowing_message = static_cast<BorrowingMessage&>(*message);
+    EXPECT(borrowing_message.has_adopted_buffer());
+    EXPECT_NE(borrowing_message.data().data(), payload.bytes().data());
+    EXPECT_EQ(StringView { borrowing_message.data() }, payload);
+}
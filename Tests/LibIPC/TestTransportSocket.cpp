@@ -93,3 +93,54 @@ TEST_CASE(read_hook_is_notified_when_io_thread_exits_on_close)
 
     EXPECT(observed_shutdown.load(AK::MemoryOrder::memory_order_relaxed));
 }
+
+TEST_CASE(large_payloads_arrive_intact_and_in_order)
+{
+    Core::EventLoop loop;
+
+    int fds[2] = {};
+    MUST(Core::System::socketpair(AF_LOCAL, SOCK_STREAM, 0, fds));
+
+    auto sender_socket = TRY_OR_FAIL(Core::LocalSocket::adopt_fd(fds[0]));
+    auto receiver_socket = TRY_OR_FAIL(Core::LocalSocket::adopt_fd(fds[1]));
+
+    MUST(sender_socket->set_blocking(false));
+    MUST(receiver_socket->set_blocking(false));
+
+    IPC::TransportSocket sender(move(sender_socket));
+    IPC::TransportSocket receiver(move(receiver_socket));
+
+    auto make_payload = [](size_t size, u8 seed) {
+        Vector<u8> payload;
+        payload.resize(size);
+        for (size_t i = 0; i < size; ++i)
+            payload[i] = static_cast<u8>(seed + i);
+        return payload;
+    };
+
+    Vector<Vector<u8>> sent_payloads;
+    sent_payloads.append(make_payload(16, 1));
+    sent_payloads.append(make_payload(1 * MiB, 2));
+    sent_payloads.append(make_payload(32, 3));
+    sent_payloads.append(make_payload(256 * KiB, 4));
+
+    for (auto const& payload : sent_payloads) {
+        Vector<IPC::Attachment> attachments;
+        sender.post_message(payload, attachments);
+    }
+
+    Vector<Vector<u8>> received_payloads;
+    receiver.set_up_read_hook([&] {
+        (void)receiver.read_as_many_messages_as_possible_without_blocking([&](auto&& message) {
+            EXPECT(message.attachments.is_empty());
+            received_payloads.append(move(message.bytes));
+        });
+    });
+
+    spin_until(loop, [&] {
+        return received_payloads.size() == sent_payloads.size();
+    });
+
+    for (size_t i = 0; i < sent_payloads.size(); ++i)
+        EXPECT(received_payloads[i] == sent_payloads[i]);
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibJS/Runtime/GlobalObject.h>
+#include <LibJS/Runtime/VM.h>
+#include <LibJS/Script.h>
+#include <LibTest/TestCase.h>
+
+// NB: Each benchmark runs in a VM of its own, so that one's garbage never has to be collected during another.
+static void run_script(StringView source, i32 expected_result)
+{
+    auto vm = JS::VM::create();
+    auto root_execution_context = JS::create_simple_execution_context<JS::GlobalObject>(*vm);
+    auto& realm = *root_execution_context->realm;
+
+    auto script_or_error = JS::Script::parse(source, realm, "benchmark.js"sv);
+    VERIFY(!script_or_error.is_error());
+
+    auto result = vm->run(script_or_error.release_value());
+    VERIFY(!result.is_throw_completion());
+    EXPECT_EQ(result.value().as_i32(), expected_result);
+}
+
+BENCHMARK_CASE(arithmetic_loop)
+{
+    run_script(R"~~~(
+        let sum = 0;
+        for (let i = 0; i < 1000000; ++i)
+            sum = (sum + i * 3) % 65536;
+        sum;
+    )~~~"sv,
+        46240);
+}
+
+BENCHMARK_CASE(property_access)
+{
+    run_script(R"~~~(
+        const point = { x: 1, y: 2, z: 3 };
+        let sum = 0;
+        for (let i = 0; i < 500000; ++i) {
+            point.x = point.y + point.z;
+            sum = (sum + point.x) | 0;
+        }
+        sum % 1000;
+    )~~~"sv,
+        0);
+}
+
+BENCHMARK_CASE(function_calls)
+{
+    run_script(R"~~~(
+        function add(a, b) { return a + b; }
+        let sum = 0;
+        for (let i = 0; i < 500000; ++i)
+            sum = add(sum, 1);
+        sum;
+    )~~~"sv,
+        500000);
+}
+
+BENCHMARK_CASE(closures_and_allocation)
+{
+    run_script(R"~~~(
+        function make_counter() {
+            let count = 0;
+            return () => ++count;
+        }
+        let total = 0;
+        for (let i = 0; i < 100000; ++i) {
+            const counter = make_counter();
+            counter();
+            total += counter();
+        }
+        total;
+    )~~~"sv,
+        200000);
+}
+
+BENCHMARK_CASE(array_push_and_iterate)
+{
+    run_script(R"~~~(
+        const array = [];
+        for (let i = 0; i < 200000; ++i)
+            array.push(i & 255);
+        let sum = 0;
+        for (const value of array)
+            sum += value;
+        sum % 1000;
+    )~~~"sv,
+        856);
+}
+
+BENCHMARK_CASE(string_concatenation)
+{
+    run_script(R"~~~(
+        let string = "";
+        for (let i = 0; i < 100000; ++i)
+            string += String.fromCharCode(97 + (i % 26));
+        string.length;
+    )~~~"sv,
+        100000);
+}
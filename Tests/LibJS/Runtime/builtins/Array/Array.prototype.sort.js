@@ -172,4 +172,57 @@ describe("Array.prototype.sort", () => {
         );
         Array.prototype.sort.call(obj);
     });
+
+    test("that the default order matches comparing as strings", () => {
+        const compareAsStrings = (a, b) => {
+            const x = String(a);
+            const y = String(b);
+            return x < y ? -1 : x > y ? 1 : 0;
+        };
+
+        const ints = [];
+        for (let i = 0; i < 1000; ++i) ints.push(((i * 7919) % 2001) - 1000);
+        ints.push(2147483647, -2147483648, 0, 10, 9, 100, -1, -10);
+        expect([...ints].sort()).toEqual([...ints].sort(compareAsStrings));
+
+        const numbers = ints.map(i => i / 8);
+        numbers.push(NaN, Infinity, -Infinity, 1e21, 1e-7, -1e-7, 0.1, -0, 0);
+        expect([...numbers].sort()).toEqual([...numbers].sort(compareAsStrings));
+
+        const strings = ints.map(i => "item" + i);
+        strings.push("", "Z", "\u00e9", "\ud83d\ude00", "\uffff", "item");
+        expect([...strings].sort()).toEqual([...strings].sort(compareAsStrings));
+
+        const withUndefined = [3, undefined, 1, , 2, undefined];
+        expect(withUndefined.sort()).toEqual([1, 2, 3, undefined, undefined, ,]);
+    });
+
+    test("that the default order is stable for numbers with the same string", () => {
+        const arr = [0, -0, 1, 0, -0];
+        arr.sort();
+        expect(Object.is(arr[0], 0)).toBeTrue();
+        expect(Object.is(arr[1], -0)).toBeTrue();
+        expect(Object.is(arr[2], 0)).toBeTrue();
+        expect(Object.is(arr[3], -0)).toBeTrue();
+        expect(arr[4]).toBe(1);
+    });
+
+    test("that it is stable for long inputs", () => {
+        const arr = [];
+        for (let i = 0; i < 2000; ++i) arr.push({ key: (i * 31) % 17, index: i });
+        arr.sort((a, b) => a.key - b.key);
+        for (let i = 1; i < arr.length; ++i) {
+            expect(arr[i - 1].key <= arr[i].key).toBeTrue();
+            if (arr[i - 1].key === arr[i].key) expect(arr[i - 1].index < arr[i].index).toBeTrue();
+        }
+
+        const sorted = [];
+        for (let i = 0; i < 2000; ++i) sorted.push(i);
+        let calls = 0;
+        sorted.sort((a, b) => {
+            ++calls;
+            return a - b;
+        });
+        expect(calls).toBe(sorted.length - 1);
+    });
 });
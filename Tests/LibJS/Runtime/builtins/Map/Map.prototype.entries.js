@@ -17,3 +17,34 @@ test("basic functionality", () => {
     expect(it.next()).toEqual({ value: undefined, done: true });
     expect(it.next()).toEqual({ value: undefined, done: true });
 });
+
+test("entries removed and added while iterating", () => {
+    const map = new Map();
+    for (let i = 0; i < 100; ++i) map.set(i, i);
+
+    const it = map.keys();
+    expect(it.next().value).toBe(0);
+
+    // Removing most of the entries compacts the map, and the iterator has to find its place again.
+    for (let i = 0; i < 90; ++i) map.delete(i);
+    expect(it.next().value).toBe(90);
+
+    map.delete(91);
+    map.set(0, 0);
+    const seen = [];
+    for (let result = it.next(); !result.done; result = it.next()) seen.push(result.value);
+    expect(seen).toEqual([92, 93, 94, 95, 96, 97, 98, 99, 0]);
+});
+
+test("iterating after clear", () => {
+    const map = new Map([
+        ["a", 0],
+        ["b", 1],
+    ]);
+    const it = map.keys();
+    expect(it.next().value).toBe("a");
+    map.clear();
+    map.set("c", 2);
+    expect(it.next()).toEqual({ value: "c", done: false });
+    expect(it.next()).toEqual({ value: undefined, done: true });
+});
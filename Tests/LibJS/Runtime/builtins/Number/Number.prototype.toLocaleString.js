@@ -13,6 +13,22 @@ describe("correct behavior", () => {
     test("length", () => {
         expect(Number.prototype.toLocaleString).toHaveLength(0);
     });
+
+    test("repeated calls with different locales and options", () => {
+        for (let i = 0; i < 3; ++i) {
+            expect((1234.5).toLocaleString()).toBe("1,234.5");
+            expect((1234.5).toLocaleString("en")).toBe("1,234.5");
+            expect((1234.5).toLocaleString("de")).toBe("1.234,5");
+            expect((1234.5).toLocaleString("de", { useGrouping: false })).toBe("1234,5");
+            expect((12).toLocaleString("ar-u-nu-arab")).toBe("\u0661\u0662");
+            expect(() => (1).toLocaleString("+")).toThrowWithMessage(RangeError, "+ is not a structurally valid language tag");
+        }
+
+        const locales = ["en", "de", "fr", "es", "it", "ja", "ko", "zh", "ru", "pt", "nl", "sv", "pl", "tr", "da", "fi", "nb"];
+        const formatted = locales.map(locale => (0.5).toLocaleString(locale));
+        expect(locales.map(locale => (0.5).toLocaleString(locale))).toEqual(formatted);
+        expect((1234.5).toLocaleString("en")).toBe("1,234.5");
+    });
 });
 
 describe("special values", () => {
@@ -76,3 +76,16 @@ test("basic functionality", () => {
         expect(typedArray[2]).toBe(0n);
     });
 });
+
+test("value is converted to the element type", () => {
+    expect(Array.from(new Uint8Array(2).fill(257.9))).toEqual([1, 1]);
+    expect(Array.from(new Int8Array(2).fill(-129))).toEqual([127, 127]);
+    expect(Array.from(new Uint8ClampedArray(2).fill(2.5))).toEqual([2, 2]);
+    expect(Array.from(new Uint8ClampedArray(2).fill(3.5))).toEqual([4, 4]);
+    expect(Array.from(new Uint8ClampedArray(2).fill(-1))).toEqual([0, 0]);
+    expect(Array.from(new Uint16Array(2).fill(NaN))).toEqual([0, 0]);
+    expect(Array.from(new Uint32Array(2).fill(-1))).toEqual([4294967295, 4294967295]);
+    expect(Array.from(new Float32Array(2).fill(0.1))).toEqual([Math.fround(0.1), Math.fround(0.1)]);
+    expect(Array.from(new Float64Array(3).fill(0.1, 1))).toEqual([0, 0.1, 0.1]);
+    expect(Array.from(new BigInt64Array(2).fill(2n ** 63n))).toEqual([-(2n ** 63n), -(2n ** 63n)]);
+});
@@ -63,3 +63,38 @@ test("basic functionality", () => {
         expect(typedArray.includes(2n, -2)).toBe(true);
     });
 });
+
+test("NaN, fractions and out of range values", () => {
+    expect(new Float64Array([1, NaN]).includes(NaN)).toBe(true);
+    expect(new Float32Array([1, NaN]).includes(NaN)).toBe(true);
+    expect(new Float32Array([1, 2]).includes(NaN)).toBe(false);
+    expect(new Float32Array([0.5]).includes(0.5)).toBe(true);
+    expect(new Float32Array([0.1]).includes(0.1)).toBe(false);
+    expect(new Float64Array([-0]).includes(0)).toBe(true);
+
+    expect(new Int8Array([1, 2]).includes(1.5)).toBe(false);
+    expect(new Int8Array([-1]).includes(255)).toBe(false);
+    expect(new Uint8Array([255]).includes(-1)).toBe(false);
+    expect(new Uint8Array([0]).includes(-0)).toBe(true);
+    expect(new Uint32Array([4294967295]).includes(4294967295)).toBe(true);
+});
+
+test("buffer shrunk while converting fromIndex", () => {
+    TYPED_ARRAYS.forEach(T => {
+        let arrayBuffer = new ArrayBuffer(T.BYTES_PER_ELEMENT * 4, {
+            maxByteLength: T.BYTES_PER_ELEMENT * 4,
+        });
+        let typedArray = new T(arrayBuffer);
+        typedArray.fill(1);
+
+        const fromIndex = {
+            valueOf() {
+                arrayBuffer.resize(0);
+                return 0;
+            },
+        };
+
+        expect(typedArray.includes(1, fromIndex)).toBe(false);
+        expect(typedArray.includes(undefined, 0)).toBe(false);
+    });
+});
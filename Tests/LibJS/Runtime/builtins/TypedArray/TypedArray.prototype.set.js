@@ -162,3 +162,41 @@ test("very large targetOffset", () => {
         }).toThrowWithMessage(RangeError, "Overflow or out of bounds in target offset");
     });
 });
+
+test("elements are converted between types", () => {
+    const float64 = new Float64Array([1.5, -1, 256, NaN, 2.5, 1e20, -0]);
+
+    const uint8 = new Uint8Array(7);
+    uint8.set(float64);
+    expect(Array.from(uint8)).toEqual([1, 255, 0, 0, 2, 0, 0]);
+
+    const clamped = new Uint8ClampedArray(7);
+    clamped.set(float64);
+    expect(Array.from(clamped)).toEqual([2, 0, 255, 0, 2, 255, 0]);
+
+    const int16 = new Int16Array([-32768, -1, 0, 32767]);
+    const float32 = new Float32Array(4);
+    float32.set(int16);
+    expect(Array.from(float32)).toEqual([-32768, -1, 0, 32767]);
+
+    const uint32 = new Uint32Array(4);
+    uint32.set(int16);
+    expect(Array.from(uint32)).toEqual([4294934528, 4294967295, 0, 32767]);
+
+    const int8 = new Int8Array(3);
+    int8.set(new Uint8ClampedArray([128, 255, 127]));
+    expect(Array.from(int8)).toEqual([-128, -1, 127]);
+
+    const bigUint64 = new BigUint64Array(1);
+    bigUint64.set(new BigInt64Array([-1n]));
+    expect(bigUint64[0]).toBe(2n ** 64n - 1n);
+});
+
+test("overlapping source and target of different types", () => {
+    const buffer = new ArrayBuffer(8);
+    const uint8 = new Uint8Array(buffer);
+    uint8.set([1, 2, 3, 4]);
+    const uint16 = new Uint16Array(buffer);
+    uint16.set(uint8.subarray(0, 4));
+    expect(Array.from(uint16)).toEqual([1, 2, 3, 4]);
+});
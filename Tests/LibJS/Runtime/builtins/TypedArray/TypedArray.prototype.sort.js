@@ -90,3 +90,38 @@ test("detached buffer", () => {
         expect(typedArray[2]).toBeUndefined();
     });
 });
+
+test("default order of special values", () => {
+    [Float16Array, Float32Array, Float64Array].forEach(T => {
+        const typedArray = new T([NaN, 1, -0, -Infinity, 0, -1, Infinity, NaN, 0.5]);
+        typedArray.sort();
+        expect(typedArray[0]).toBe(-Infinity);
+        expect(typedArray[1]).toBe(-1);
+        expect(Object.is(typedArray[2], -0)).toBeTrue();
+        expect(Object.is(typedArray[3], 0)).toBeTrue();
+        expect(typedArray[4]).toBe(0.5);
+        expect(typedArray[5]).toBe(1);
+        expect(typedArray[6]).toBe(Infinity);
+        expect(typedArray[7]).toBeNaN();
+        expect(typedArray[8]).toBeNaN();
+    });
+
+    [Int8Array, Int16Array, Int32Array].forEach(T => {
+        const typedArray = new T([5, -128, 0, 127, -1, 3]);
+        typedArray.sort();
+        expect(Array.from(typedArray)).toEqual([-128, -1, 0, 3, 5, 127]);
+    });
+
+    const bigInts = new BigInt64Array([5n, -(2n ** 63n), 0n, 2n ** 63n - 1n, -1n]);
+    bigInts.sort();
+    expect(Array.from(bigInts)).toEqual([-(2n ** 63n), -1n, 0n, 5n, 2n ** 63n - 1n]);
+});
+
+test("default order of long arrays", () => {
+    TYPED_ARRAYS.forEach(T => {
+        const typedArray = new T(1000);
+        for (let i = 0; i < typedArray.length; ++i) typedArray[i] = (i * 7919) % 251;
+        const expected = Array.from(typedArray).sort((a, b) => a - b);
+        expect(Array.from(typedArray.sort())).toEqual(expected);
+    });
+});
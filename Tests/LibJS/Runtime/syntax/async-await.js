@@ -757,3 +757,66 @@ describe("await observably looks up constructor of Promise objects", () => {
     runQueuedPromiseJobs();
     expect(calls).toBe(4);
 });
+
+describe("await on pending promises", () => {
+    test("await reaction runs in order with other reactions", () => {
+        const order = [];
+        let resolve;
+        const p = new Promise(r => {
+            resolve = r;
+        });
+        p.then(() => order.push("then 1"));
+        (async () => {
+            await p;
+            order.push("async");
+        })();
+        p.then(() => order.push("then 2"));
+        resolve();
+        runQueuedPromiseJobs();
+        expect(order).toEqual(["then 1", "async", "then 2"]);
+    });
+
+    test("several async functions awaiting the same promise", () => {
+        const results = [];
+        let reject;
+        const p = new Promise((_, r) => {
+            reject = r;
+        });
+        async function f(name) {
+            try {
+                await p;
+            } catch (e) {
+                results.push(`${name}: ${e}`);
+            }
+        }
+        f("a");
+        f("b");
+        reject("error");
+        runQueuedPromiseJobs();
+        expect(results).toEqual(["a: error", "b: error"]);
+    });
+
+    test("many awaits on promises that settle later", () => {
+        let result;
+        async function f() {
+            let fulfilled = 0;
+            let rejected = 0;
+            for (let i = 0; i < 1000; ++i) {
+                const settlesLater = new Promise((resolve, reject) => {
+                    Promise.resolve().then(() => (i % 3 === 0 ? reject(i) : resolve(i)));
+                });
+                try {
+                    fulfilled += await settlesLater;
+                } catch (e) {
+                    rejected += e;
+                }
+            }
+            return [fulfilled, rejected];
+        }
+        f().then(value => {
+            result = value;
+        });
+        runQueuedPromiseJobs();
+        expect(result).toEqual([332667, 166833]);
+    });
+});
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibCore/EventLoop.h>
+#include <LibGfx/YUVData.h>
+#include <LibMedia/MediaTimeProvider.h>
+#include <LibMedia/Producers/VideoProducer.h>
+#include <LibMedia/Sinks/DisplayingVideoSink.h>
+#include <LibMedia/VideoFrame.h>
+#include <LibTest/TestCase.h>
+
+namespace {
+
+class ManualTimeProvider final : public Media::MediaTimeProvider {
+public:
+    virtual AK::Duration current_time() const override { return m_time; }
+    virtual void resume() override { }
+    virtual void pause() override { }
+    virtual void seek(AK::Duration time) override { m_time = time; }
+    virtual void set_playback_rate(float) override { }
+
+    void set_time(AK::Duration time) { m_time = time; }
+
+private:
+    AK::Duration m_time;
+};
+
+class FrameListProducer final : public Media::VideoProducer {
+public:
+    explicit FrameListProducer(Vector<NonnullRefPtr<Media::VideoFrame>> frames)
+        : m_frames(move(frames))
+    {
+    }
+
+    virtual void start() override { }
+    virtual Media::PipelineStatus status() const override
+    {
+        return m_next_frame < m_frames.size() ? Media::PipelineStatus::HaveData : Media::PipelineStatus::EndOfStream;
+    }
+    virtual void pull(RefPtr<Media::VideoFrame>& into) override
+    {
+        if (m_next_frame < m_frames.size())
+            into = m_frames[m_next_frame++];
+    }
+    virtual void set_wake_handler(Media::PipelineWakeHandler) override { }
+    virtual void seek(AK::Duration) override { }
+
+private:
+    Vector<NonnullRefPtr<Media::VideoFrame>> m_frames;
+    size_t m_next_frame { 0 };
+};
+
+}
+
+static constexpr auto frame_duration = AK::Duration::from_milliseconds(40);
+
+static AK::Duration frame_start(i64 index)
+{
+    return AK::Duration::from_milliseconds(40 * index);
+}
+
+static NonnullRefPtr<Media::VideoFrame> create_frame(size_t index)
+{
+    auto cicp = Media::CodingIndependentCodePoints {
+        Media::ColorPrimaries::BT709,
+        Media::TransferCharacteristics::BT709,
+        Media::MatrixCoefficients::BT709,
+        Media::VideoFullRangeFlag::Studio,
+    };
+    auto yuv_data = MUST(Gfx::YUVData::create({ 2, 2 }, 8, Media::Subsampling { true, true }, cicp));
+    return adopt_ref(*new Media::VideoFrame(frame_start(static_cast<i64>(index)), frame_duration, { 2, 2 }, 8, {}, move(yuv_data)));
+}
+
+TEST_CASE(frames_skipped_within_one_update_are_counted_as_dropped)
+{
+    Core::EventLoop loop;
+
+    Vector<NonnullRefPtr<Media::VideoFrame>> frames;
+    for (size_t i = 0; i < 10; i++)
+        frames.append(create_frame(i));
+
+    auto time_provider = adopt_ref(*new ManualTimeProvider);
+    auto producer = adopt_ref(*new FrameListProducer(move(frames)));
+    auto sink = MUST(Media::DisplayingVideoSink::try_create(time_provider, nullptr));
+    MUST(sink->connect_input(producer));
+
+    // Frame 0 is due right away.
+    EXPECT(sink->update() == Media::DisplayingVideoSinkUpdateResult::NewFrameAvailable);
+    EXPECT_EQ(sink->frame_counters().presented_frames, 1u);
+    EXPECT_EQ(sink->frame_counters().dropped_frames, 0u);
+    EXPECT_EQ(sink->frame_counters().late_frames, 0u);
+
+    // Frame 1 is presented on time.
+    time_provider->set_time(frame_start(1) + AK::Duration::from_milliseconds(5));
+    EXPECT(sink->update() == Media::DisplayingVideoSinkUpdateResult::NewFrameAvailable);
+    EXPECT_EQ(sink->current_frame()->timestamp(), frame_start(1));
+    EXPECT_EQ(sink->frame_counters().presented_frames, 2u);
+    EXPECT_EQ(sink->frame_counters().dropped_frames, 0u);
+
+    // Nothing new is due yet.
+    EXPECT(sink->update() == Media::DisplayingVideoSinkUpdateResult::NoChange);
+    EXPECT_EQ(sink->frame_counters().presented_frames, 2u);
+
+    // Frames 2 through 4 become due at once, so 2 and 3 are never shown.
+    time_provider->set_time(frame_start(4) + AK::Duration::from_milliseconds(5));
+    EXPECT(sink->update() == Media::DisplayingVideoSinkUpdateResult::NewFrameAvailable);
+    EXPECT_EQ(sink->current_frame()->timestamp(), frame_start(4));
+    EXPECT_EQ(sink->frame_counters().presented_frames, 3u);
+    EXPECT_EQ(sink->frame_counters().dropped_frames, 2u);
+    EXPECT_EQ(sink->frame_counters().late_frames, 0u);
+
+    sink->disconnect_input(producer);
+}
+
+TEST_CASE(frames_presented_after_their_interval_are_counted_as_late)
+{
+    Core::EventLoop loop;
+
+    Vector<NonnullRefPtr<Media::VideoFrame>> frames;
+    frames.append(create_frame(0));
+
+    auto time_provider = adopt_ref(*new ManualTimeProvider);
+    auto producer = adopt_ref(*new FrameListProducer(move(frames)));
+    auto sink = MUST(Media::DisplayingVideoSink::try_create(time_provider, nullptr));
+    MUST(sink->connect_input(producer));
+
+    time_provider->set_time(frame_start(2));
+    EXPECT(sink->update() == Media::DisplayingVideoSinkUpdateResult::NewFrameAvailable);
+    EXPECT_EQ(sink->frame_counters().presented_frames, 1u);
+    EXPECT_EQ(sink->frame_counters().late_frames, 1u);
+
+    sink->disconnect_input(producer);
+}
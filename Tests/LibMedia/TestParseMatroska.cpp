@@ -684,3 +684,44 @@ TEST_CASE(buffered_time_ranges_evicted_start_appended_end)
     time_ranges = reader.buffered_time_ranges(cursor, byte_ranges);
     EXPECT_EQ(time_ranges.size(), 0u);
 }
+
+TEST_CASE(seeking_backwards_after_reading_to_the_end)
+{
+    auto test_files = {
+        "./test-matroska-seeking-without-cues.mkv"sv,
+        "./vfr.mkv"sv,
+    };
+
+    for (auto test_file : test_files) {
+        auto file = MUST(Core::File::open(test_file, Core::File::OpenMode::Read));
+        auto stream = Media::IncrementallyPopulatedStream::create_from_buffer(MUST(file->read_until_eof()));
+        auto matroska_reader = MUST(Media::Matroska::Reader::from_stream(stream->create_cursor()));
+        u64 video_track = 0;
+        MUST(matroska_reader.for_each_track_of_type(Media::Matroska::TrackEntry::TrackType::Video, [&](Media::Matroska::TrackEntry const& track_entry) -> Media::DecoderErrorOr<IterationDecision> {
+            video_track = track_entry.track_number();
+            return IterationDecision::Break;
+        }));
+
+        auto iterator = MUST(matroska_reader.create_sample_iterator(stream->create_cursor(), video_track));
+        Vector<AK::Duration> keyframe_timestamps;
+        while (true) {
+            auto block = iterator.next_block();
+            if (block.is_error()) {
+                EXPECT_EQ(block.error().category(), Media::DecoderErrorCategory::EndOfStream);
+                break;
+            }
+            if (block.value().only_keyframes())
+                keyframe_timestamps.append(block.value().timestamp().value());
+        }
+        EXPECT(!keyframe_timestamps.is_empty());
+
+        // Each seek goes backwards from where the last one left the iterator, and must land on the keyframe before it.
+        for (size_t i = keyframe_timestamps.size(); i-- > 0;) {
+            auto target = keyframe_timestamps[i] + AK::Duration::from_milliseconds(1);
+            iterator = MUST(matroska_reader.seek_to_random_access_point(iterator, target));
+            auto block = MUST(iterator.next_block());
+            EXPECT_EQ(block.timestamp().value(), keyframe_timestamps[i]);
+            EXPECT(block.only_keyframes());
+        }
+    }
+}
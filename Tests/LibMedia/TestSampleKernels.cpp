@@ -0,0 +1,45 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Vector.h>
+#include <LibMedia/Audio/SampleKernels.h>
+#include <LibTest/TestCase.h>
+
+// NB: The odd lengths make sure the samples past the last full vector are handled as well.
+static constexpr size_t lengths[] = { 0, 1, 3, 4, 7, 16, 19, 35 };
+
+TEST_CASE(add_samples)
+{
+    for (auto length : lengths) {
+        Vector<float> destination;
+        Vector<float> source;
+        for (size_t i = 0; i < length; i++) {
+            destination.append(static_cast<float>(i));
+            source.append(static_cast<float>(i) * 0.5f);
+        }
+
+        Audio::add_samples(destination, source);
+
+        for (size_t i = 0; i < length; i++)
+            EXPECT_EQ(destination[i], static_cast<float>(i) * 1.5f);
+    }
+}
+
+TEST_CASE(dot_product)
+{
+    for (auto length : lengths) {
+        Vector<float> a;
+        Vector<float> b;
+        float expected = 0;
+        for (size_t i = 0; i < length; i++) {
+            a.append(static_cast<float>(i % 5));
+            b.append(static_cast<float>(i % 3) - 1);
+            expected += a[i] * b[i];
+        }
+
+        EXPECT_EQ(Audio::dot_product(a, b), expected);
+    }
+}
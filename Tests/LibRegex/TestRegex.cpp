@@ -342,6 +342,50 @@ TEST_CASE(required_literal_prefilter_compiles_long_literal_alternations)
     EXPECT_EQ(regex.test(Utf16String::from_utf8(missing_subject), 0), regex::MatchResult::NoMatch);
 }
 
+TEST_CASE(lazy_dfa_rules_out_inputs_without_backtracking)
+{
+    auto regex = compile_regex("(a+)+[bc]"sv);
+    auto subject = MUST(String::repeated('a', 40));
+
+    EXPECT_EQ(regex.test(Utf16String::from_utf8(subject), 0), regex::MatchResult::NoMatch);
+
+    auto matching_subject = Utf16String::from_utf8(MUST(String::formatted("{}c", subject)));
+    EXPECT_EQ(regex.exec(matching_subject, 0), regex::MatchResult::Match);
+    expect_capture_eq(regex, matching_subject, 1, subject.bytes_as_string_view());
+}
+
+TEST_CASE(lazy_dfa_preserves_match_positions_and_captures)
+{
+    auto regex = compile_regex("(\\d+)\\.(\\d+) refused"sv);
+    auto filler = MUST(String::repeated("connection 10.0 accepted\n"_string, 8));
+
+    auto matching_subject = Utf16String::from_utf8(MUST(String::formatted("{}connection 10.42 refused", filler)));
+    EXPECT_EQ(regex.exec(matching_subject, 0), regex::MatchResult::Match);
+    EXPECT_EQ(regex.capture_slot(0), static_cast<int>(filler.bytes().size() + 11));
+    expect_capture_eq(regex, matching_subject, 1, "10"sv);
+    expect_capture_eq(regex, matching_subject, 2, "42"sv);
+
+    EXPECT_EQ(regex.test(Utf16String::from_utf8(filler), 0), regex::MatchResult::NoMatch);
+}
+
+TEST_CASE(lazy_dfa_find_all_honors_assertions)
+{
+    {
+        auto regex = compile_regex("\\b[A-Z]{3}\\d\\b"sv, { .global = true });
+        auto subject = Utf16String::from_utf8("padding to make the input long: ABC1 xABC2 ABC3y ABC4"sv);
+        EXPECT_EQ(regex.find_all(subject, 0), 2);
+        EXPECT_EQ(regex.find_all_match(0).start, 32);
+        EXPECT_EQ(regex.find_all_match(1).start, 49);
+    }
+    {
+        auto regex = compile_regex("^(WARN|ERROR) "sv, { .global = true, .multiline = true });
+        auto subject = Utf16String::from_utf8("INFO started\nWARN disk almost full\n INFO ERROR skipped\nERROR disk full"sv);
+        EXPECT_EQ(regex.find_all(subject, 0), 2);
+        EXPECT_EQ(regex.find_all_match(0).start, 13);
+        EXPECT_EQ(regex.find_all_match(1).start, 55);
+    }
+}
+
 TEST_CASE(restored_ecmascript_parse_coverage)
 {
     struct Test {
@@ -61,3 +61,39 @@ TEST_CASE(test_TLS_hello_handshake)
 
     EXPECT_EQ(loop.exec(), 0);
 }
+
+TEST_CASE(test_TLS_session_resumption)
+{
+    Core::EventLoop loop;
+
+    auto first_connection = TRY_OR_FAIL(TLS::TLSv12::connect(DEFAULT_SERVER, port));
+    EXPECT(!first_connection->is_session_reused());
+
+    auto first = TRY_OR_FAIL(Core::BufferedSocket<TLS::TLSv12>::create(move(first_connection)));
+
+    TRY_OR_FAIL(first->write_until_depleted("GET /generate_204 HTTP/1.1\r\nHost: "_b));
+    TRY_OR_FAIL(first->write_until_depleted(DEFAULT_SERVER.bytes()));
+    TRY_OR_FAIL(first->write_until_depleted("\r\nConnection: close\r\n\r\n"_b));
+
+    // TLS 1.3 servers send their session tickets after the handshake, so read the response to make sure we got one.
+    first->on_ready_to_read = [&] {
+        auto read_buffer = ByteBuffer::create_uninitialized(4096).release_value();
+        auto can_read = first->can_read_up_to_delimiter("\r\n"sv.bytes());
+        if (can_read.is_error() || !can_read.value())
+            return;
+
+        (void)TRY_OR_FAIL(first->read_until_any_of(read_buffer, Array { "\r\n"sv }));
+        loop.quit(0);
+    };
+    first->set_notifications_enabled(true);
+
+    auto timeout = Core::Timer::create_single_shot(10'000, [&loop] {
+        loop.quit(1);
+    });
+    timeout->start();
+
+    EXPECT_EQ(loop.exec(), 0);
+
+    auto second = TRY_OR_FAIL(TLS::TLSv12::connect(DEFAULT_SERVER, port));
+    EXPECT(second->is_session_reused());
+}
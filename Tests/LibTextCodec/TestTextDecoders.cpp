@@ -259,3 +259,14 @@ TEST_CASE(test_utf16le_process_code_points)
     EXPECT_EQ(process_code_points(decoder, StringView(bytes({ 'A', 0x00, 0xff }))), (Vector<u32> { 0x41, 0xfffd }));
     EXPECT_EQ(MUST(decoder.to_utf8(StringView(bytes({ 'A', 0x00, 0xff })))), "A\xef\xbf\xbd"sv);
 }
+
+TEST_CASE(test_windows_1252_decode)
+{
+    auto& decoder = decoder_for("windows-1252"sv);
+    EXPECT_EQ(MUST(decoder.to_utf8("plain ascii"sv)), "plain ascii"sv);
+
+    auto mixed_bytes = Vector<u8> { 'a', 0x80, 'b', 0xe9, 0x81 };
+    auto mixed = StringView(bytes(mixed_bytes));
+    EXPECT_EQ(MUST(decoder.to_utf8(mixed)), "a\xe2\x82\xac" "b\xc3\xa9\xc2\x81"sv);
+    EXPECT_EQ(process_code_points(decoder, mixed), (Vector<u32> { 'a', 0x20ac, 'b', 0xe9, 0x81 }));
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/PaintingSurface.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/AccumulatedVisualContext.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/DisplayListPlayerSkia.h>
+#include <LibWeb/Painting/DisplayListResourceStorage.h>
+#include <LibWeb/Painting/ScrollState.h>
+#include <LibWeb/Painting/TiledDisplayListRasterizer.h>
+
+using namespace Web::Painting;
+
+static constexpr Gfx::IntSize surface_size { 1280, 2048 };
+
+static NonnullRefPtr<Gfx::PaintingSurface> create_surface()
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, surface_size));
+    return Gfx::PaintingSurface::wrap_bitmap(*bitmap);
+}
+
+// Roughly what a long page of boxes with borders looks like: a background, then a grid of filled boxes with an
+// outline drawn around each.
+static NonnullRefPtr<DisplayList> record_page(AccumulatedVisualContextTree const& tree)
+{
+    auto display_list = DisplayList::create(tree);
+    display_list->append(FillRect { .rect = { {}, surface_size }, .color = Color::White }, tree, VISUAL_VIEWPORT_NODE_INDEX);
+
+    for (int y = 0; y < surface_size.height(); y += 40) {
+        for (int x = 0; x < surface_size.width(); x += 80) {
+            auto color = Color::from_rgbx(0x203040 + ((x * 7 + y * 13) & 0xffff));
+            display_list->append(FillRect { .rect = { x + 4, y + 4, 72, 32 }, .color = color }, tree, VISUAL_VIEWPORT_NODE_INDEX);
+            display_list->append(DrawLine { .color = Color::Black, .from = { x + 4, y + 36 }, .to = { x + 76, y + 36 }, .thickness = 1, .style = Gfx::LineStyle::Solid, .alternate_color = Color::Transparent }, tree, VISUAL_VIEWPORT_NODE_INDEX);
+        }
+    }
+    return display_list;
+}
+
+BENCHMARK_CASE(replay_page)
+{
+    auto tree = AccumulatedVisualContextTree::create();
+    auto display_list = record_page(tree);
+    DisplayListResourceStorage resource_storage;
+    ScrollStateSnapshot scroll_state;
+
+    auto surface = create_surface();
+    DisplayListPlayerSkia player { RefPtr<Gfx::SkiaBackendContext> {} };
+    for (int frame = 0; frame < 10; ++frame) {
+        player.execute(*display_list, tree, resource_storage, scroll_state, surface);
+        player.flush(*surface);
+    }
+}
+
+BENCHMARK_CASE(rasterize_page_in_tiles)
+{
+    auto tree = AccumulatedVisualContextTree::create();
+    auto display_list = record_page(tree);
+    DisplayListResourceStorage resource_storage;
+    ScrollStateSnapshot scroll_state;
+
+    auto surface = create_surface();
+    EXPECT(TiledDisplayListRasterizer::can_rasterize_in_tiles(*display_list, resource_storage, *surface, surface->rect()));
+
+    TiledDisplayListRasterizer rasterizer;
+    for (int frame = 0; frame < 10; ++frame)
+        rasterizer.rasterize(*display_list, tree, resource_storage, scroll_state, *surface, surface->rect(), TiledDisplayListRasterizer::TileBackground::Transparent);
+}
+
+BENCHMARK_CASE(record_page_display_list)
+{
+    auto tree = AccumulatedVisualContextTree::create();
+    for (int frame = 0; frame < 10; ++frame) {
+        auto display_list = record_page(tree);
+        EXPECT(display_list->command_byte_size() > 0);
+    }
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWeb/Compositor/AsyncAnimations.h>
+#include <LibWeb/Painting/AccumulatedVisualContext.h>
+
+using namespace Web::Compositor;
+
+static AsyncAnimation opacity_animation(float from, float to, MonotonicTime sampled_at)
+{
+    return AsyncAnimation {
+        .property = AsyncAnimatedProperty::Opacity,
+        .target_nodes = {},
+        .timing = { .iteration_duration = 1000 },
+        .keyframes = {
+            { .offset = 0, .easing = {}, .value = from },
+            { .offset = 1, .easing = {}, .value = to },
+        },
+        .underlying_value = 1.0f,
+        .local_time = 0,
+        .sampled_at_in_nanoseconds = sampled_at.nanoseconds(),
+    };
+}
+
+static float opacity_at(AsyncAnimation const& animation, MonotonicTime time, Web::Painting::ScrollStateSnapshot const& scroll_state_snapshot = {})
+{
+    return animation.value_at(animation.local_time_at(time, scroll_state_snapshot)).get<float>();
+}
+
+static bool has_finished_at(AsyncAnimation const& animation, MonotonicTime time)
+{
+    return animation.has_finished_at(animation.local_time_at(time, {}));
+}
+
+TEST_CASE(opacity_advances_with_the_clock)
+{
+    auto start = MonotonicTime::now();
+    auto animation = opacity_animation(0, 1, start);
+
+    EXPECT_APPROXIMATE(opacity_at(animation, start), 0.0f);
+    EXPECT_APPROXIMATE(opacity_at(animation, start + AK::Duration::from_milliseconds(250)), 0.25f);
+    EXPECT_APPROXIMATE(opacity_at(animation, start + AK::Duration::from_milliseconds(750)), 0.75f);
+    EXPECT(!has_finished_at(animation, start + AK::Duration::from_milliseconds(750)));
+}
+
+TEST_CASE(local_time_carries_on_from_hand_over)
+{
+    auto start = MonotonicTime::now();
+    auto animation = opacity_animation(0, 1, start);
+    animation.local_time = 500;
+    animation.timing.playback_rate = 2;
+
+    EXPECT_APPROXIMATE(opacity_at(animation, start), 0.5f);
+    EXPECT_APPROXIMATE(opacity_at(animation, start + AK::Duration::from_milliseconds(100)), 0.7f);
+}
+
+TEST_CASE(fill_mode_decides_the_value_outside_the_active_interval)
+{
+    auto start = MonotonicTime::now();
+    auto animation = opacity_animation(0.2f, 0.6f, start);
+    animation.timing.start_delay = 100;
+
+    EXPECT_APPROXIMATE(opacity_at(animation, start), 1.0f);
+    EXPECT_APPROXIMATE(opacity_at(animation, start + AK::Duration::from_milliseconds(2000)), 1.0f);
+    EXPECT(has_finished_at(animation, start + AK::Duration::from_milliseconds(2000)));
+
+    animation.timing.fills_backwards = true;
+    animation.timing.fills_forwards = true;
+    EXPECT_APPROXIMATE(opacity_at(animation, start), 0.2f);
+    EXPECT_APPROXIMATE(opacity_at(animation, start + AK::Duration::from_milliseconds(2000)), 0.6f);
+}
+
+TEST_CASE(alternate_iterations_run_backwards)
+{
+    auto start = MonotonicTime::now();
+    auto animation = opacity_animation(0, 1, start);
+    animation.timing.iteration_count = 2;
+    animation.timing.direction = AsyncAnimationDirection::Alternate;
+    animation.timing.fills_forwards = true;
+
+    EXPECT_APPROXIMATE(opacity_at(animation, start + AK::Duration::from_milliseconds(1250)), 0.75f);
+    EXPECT_APPROXIMATE(opacity_at(animation, start + AK::Duration::from_milliseconds(3000)), 0.0f);
+}
+
+TEST_CASE(infinite_animations_never_finish)
+{
+    auto start = MonotonicTime::now();
+    auto animation = opacity_animation(0, 1, start);
+    animation.timing.iteration_count = AK::Infinity<double>;
+
+    EXPECT_APPROXIMATE(opacity_at(animation, start + AK::Duration::from_milliseconds(12'250)), 0.25f);
+    EXPECT(!has_finished_at(animation, start + AK::Duration::from_seconds(3600)));
+}
+
+TEST_CASE(scroll_timelines_follow_the_scroll_offset)
+{
+    auto start = MonotonicTime::now();
+    auto animation = opacity_animation(0, 1, start);
+    animation.timing.iteration_duration = 100;
+    animation.timing.fills_forwards = true;
+    animation.scroll_timeline = AsyncScrollTimeline {
+        .scroll_frame_index = Web::Painting::ScrollFrameIndex { 1 },
+        .is_vertical = true,
+        .max_scroll_offset = 400,
+        .start_time = 0,
+    };
+
+    auto scrolled_by = [](float y) {
+        return Web::Painting::ScrollStateSnapshot::create_from_device_offsets({ {}, { 0, -y } });
+    };
+    EXPECT_APPROXIMATE(opacity_at(animation, start, scrolled_by(0)), 0.0f);
+    EXPECT_APPROXIMATE(opacity_at(animation, start, scrolled_by(100)), 0.25f);
+    // The clock doesn't move a scroll-driven animation.
+    EXPECT_APPROXIMATE(opacity_at(animation, start + AK::Duration::from_seconds(10), scrolled_by(100)), 0.25f);
+    EXPECT_APPROXIMATE(opacity_at(animation, start, scrolled_by(400)), 1.0f);
+
+    auto tree = Web::Painting::AccumulatedVisualContextTree::create();
+    EXPECT(!apply_async_animations({ &animation, 1 }, tree, scrolled_by(100), start));
+}
+
+TEST_CASE(keyframe_easing_applies_to_its_interval)
+{
+    auto start = MonotonicTime::now();
+    auto animation = opacity_animation(0, 1, start);
+    animation.keyframes = {
+        { .offset = 0, .easing = {}, .value = 0.0f },
+        { .offset = 0.5, .easing = Web::CSS::StepsEasingFunction { 1, Web::CSS::StepPosition::JumpEnd, "steps(1)"_string }, .value = 0.5f },
+        { .offset = 1, .easing = {}, .value = 1.0f },
+    };
+
+    EXPECT_APPROXIMATE(opacity_at(animation, start + AK::Duration::from_milliseconds(250)), 0.25f);
+    EXPECT_APPROXIMATE(opacity_at(animation, start + AK::Duration::from_milliseconds(750)), 0.5f);
+}
+
+TEST_CASE(transforms_interpolate_per_function_and_write_the_node)
+{
+    auto start = MonotonicTime::now();
+    auto tree = Web::Painting::AccumulatedVisualContextTree::create();
+    auto node = tree.append(Web::Painting::TransformData { Gfx::FloatMatrix4x4::identity(), { 5, 5 } }, Web::Painting::VISUAL_VIEWPORT_NODE_INDEX);
+
+    Vector<AsyncTransformFunction> to {
+        { .type = AsyncTransformFunction::Type::Translate, .x = 100, .y = 0, .z = 0 },
+        { .type = AsyncTransformFunction::Type::Scale, .x = 3, .y = 3, .z = 1 },
+    };
+    AsyncAnimation animation {
+        .property = AsyncAnimatedProperty::Transform,
+        .target_nodes = { node },
+        .timing = { .iteration_duration = 1000 },
+        .keyframes = {
+            { .offset = 0, .easing = {}, .value = Vector<AsyncTransformFunction> {} },
+            { .offset = 1, .easing = {}, .value = move(to) },
+        },
+        .underlying_value = Vector<AsyncTransformFunction> {},
+        .device_pixels_per_css_pixel = 2,
+        .sampled_at_in_nanoseconds = start.nanoseconds(),
+    };
+
+    EXPECT(apply_async_animations({ &animation, 1 }, tree, {}, start + AK::Duration::from_milliseconds(500)));
+
+    auto const& transform = tree.node_at(node).data.get<Web::Painting::TransformData>();
+    EXPECT_APPROXIMATE((transform.matrix[0, 0]), 2.0f);
+    EXPECT_APPROXIMATE((transform.matrix[1, 1]), 2.0f);
+    // Translation is in device pixels.
+    EXPECT_APPROXIMATE((transform.matrix[0, 3]), 100.0f);
+    EXPECT_EQ(transform.origin, Gfx::FloatPoint(5, 5));
+}
+
+TEST_CASE(nodes_of_the_wrong_kind_are_left_alone)
+{
+    auto start = MonotonicTime::now();
+    auto tree = Web::Painting::AccumulatedVisualContextTree::create();
+    auto animation = opacity_animation(0, 1, start);
+    animation.target_nodes = { Web::Painting::VISUAL_VIEWPORT_NODE_INDEX, Web::Painting::VisualContextIndex { 42 } };
+
+    EXPECT(apply_async_animations({ &animation, 1 }, tree, {}, start));
+    EXPECT(tree.node_at(Web::Painting::VISUAL_VIEWPORT_NODE_INDEX).data.has<Web::Painting::TransformData>());
+}
@@ -107,4 +107,36 @@ TEST_CASE(tokenizer_filters_decoded_surrogate_code_points_as_single_replacements
     expect_first_token_is_ident_for_both_tokenizers("foo\xed\xa0\x80"sv, "utf-8"sv, "foo�"sv, "foo�"sv, TokenizerInput::DecodedText);
 }
 
+static void expect_both_tokenizers_agree(StringView input)
+{
+    auto tokens = Tokenizer::tokenize(input, "utf-8"sv);
+    auto rust_tokens = RustTokenizer::tokenize(input, "utf-8"sv, TokenizerInput::DecodedText);
+    EXPECT_EQ(tokens.size(), rust_tokens.size());
+    for (size_t i = 0; i < min(tokens.size(), rust_tokens.size()); ++i) {
+        EXPECT_EQ(tokens[i].to_debug_string(), rust_tokens[i].to_debug_string());
+        EXPECT_EQ(tokens[i].start_position().line, rust_tokens[i].start_position().line);
+        EXPECT_EQ(tokens[i].start_position().column, rust_tokens[i].start_position().column);
+        EXPECT_EQ(tokens[i].end_position().line, rust_tokens[i].end_position().line);
+        EXPECT_EQ(tokens[i].end_position().column, rust_tokens[i].end_position().column);
+        EXPECT_EQ(tokens[i].original_source_text(), rust_tokens[i].original_source_text());
+    }
+}
+
+TEST_CASE(tokenizer_tracks_positions_across_whitespace_and_comments)
+{
+    expect_both_tokenizers_agree("a {\n\t color : red ;\n}\n\n/* first\n comment é */ b/**/c { }"sv);
+}
+
+TEST_CASE(tokenizer_matches_for_mixed_ascii_and_non_ascii_idents)
+{
+    expect_both_tokenizers_agree("foo-bar_1é-baz \\66 oo --custom-é: 1px"sv);
+}
+
+TEST_CASE(tokenizer_matches_for_unterminated_comments)
+{
+    expect_both_tokenizers_agree("a /* never closed *"sv);
+    expect_both_tokenizers_agree("a /* never closed é"sv);
+    expect_both_tokenizers_agree("a /*"sv);
+}
+
 }
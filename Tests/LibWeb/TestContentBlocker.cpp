@@ -293,4 +293,27 @@ TEST_CASE(cosmetic_rule_detection)
     EXPECT(blocker_with_cosmetics.has_cosmetic_rules());
 }
 
+TEST_CASE(compiled_rules)
+{
+    auto rules = "||ads.example.com^\nexample.com##.ad-banner\n##.first-ad-class, .second-ad-class\n"sv;
+    auto compiled = MUST(ContentBlocker::compile_rules(rules.bytes()));
+
+    auto& blocker = make_blocker({});
+    MUST(blocker.set_rules_from_bytes(compiled));
+    EXPECT(blocker.has_cosmetic_rules());
+
+    auto source_url = url("https://example.com/"sv);
+    EXPECT(blocker.is_filtered(url("https://ads.example.com/script.js"sv), source_url, ContentBlocker::ResourceType::Script));
+    EXPECT(!blocker.is_filtered(url("https://example.com/page.html"sv), source_url, ContentBlocker::ResourceType::Document));
+
+    Vector<String> classes = { "second-ad-class"_string };
+    auto style_sheet = blocker.cosmetic_style_sheet_for_url(url("https://example.com/"sv), classes, {});
+    EXPECT(style_sheet.contains(".ad-banner { display: none !important; }"sv));
+    EXPECT(style_sheet.contains(".first-ad-class, .second-ad-class { display: none !important; }"sv));
+
+    auto truncated = compiled.bytes().trim(compiled.size() - 1);
+    EXPECT(blocker.set_rules_from_bytes(truncated).is_error());
+    EXPECT(blocker.is_filtered(url("https://ads.example.com/script.js"sv), source_url, ContentBlocker::ResourceType::Script));
+}
+
 }
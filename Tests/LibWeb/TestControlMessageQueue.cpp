@@ -5,6 +5,7 @@
  */
 
 #include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
 #include <LibWeb/WebAudio/ControlMessage.h>
 #include <LibWeb/WebAudio/ControlMessageQueue.h>
 
@@ -45,3 +46,57 @@ TEST_CASE(drain_preserves_first_in_first_out)
     EXPECT_EQ(batch[2].get<Web::WebAudio::StartSource>().when, 3.0);
     EXPECT_EQ(batch[2].get<Web::WebAudio::StartSource>().node_id, Web::WebAudio::NodeID { 2 });
 }
+
+TEST_CASE(dequeue_returns_nothing_when_empty)
+{
+    Web::WebAudio::ControlMessageQueue queue;
+    EXPECT(!queue.dequeue().has_value());
+
+    queue.enqueue(Web::WebAudio::StartSource { .node_id = Web::WebAudio::NodeID { 0 }, .when = 1.0 });
+    EXPECT(queue.dequeue().has_value());
+    EXPECT(!queue.dequeue().has_value());
+}
+
+TEST_CASE(consumed_nodes_are_reused_in_order)
+{
+    Web::WebAudio::ControlMessageQueue queue;
+
+    for (size_t round = 0; round < 10; ++round) {
+        for (size_t i = 0; i < 5; ++i)
+            queue.enqueue(Web::WebAudio::StartSource { .node_id = Web::WebAudio::NodeID { round * 5 + i }, .when = 0.0 });
+        for (size_t i = 0; i < 5; ++i) {
+            auto message = queue.dequeue();
+            EXPECT(message.has_value());
+            EXPECT_EQ(message->get<Web::WebAudio::StartSource>().node_id, Web::WebAudio::NodeID { round * 5 + i });
+        }
+    }
+    EXPECT(!queue.dequeue().has_value());
+}
+
+TEST_CASE(messages_cross_threads_in_order)
+{
+    static constexpr u64 message_count = 100'000;
+    IGNORE_USE_IN_ESCAPING_LAMBDA Web::WebAudio::ControlMessageQueue queue;
+
+    auto producer = Threading::Thread::construct("TestProducer"sv, [&queue]() -> intptr_t {
+        for (u64 i = 0; i < message_count; ++i)
+            queue.enqueue(Web::WebAudio::StopSource { .node_id = Web::WebAudio::NodeID { i }, .when = 0.0 });
+        return 0;
+    });
+    producer->start();
+
+    u64 expected_id = 0;
+    bool in_order = true;
+    while (expected_id < message_count) {
+        auto message = queue.dequeue();
+        if (!message.has_value())
+            continue;
+        if (message->get<Web::WebAudio::StopSource>().node_id != Web::WebAudio::NodeID { expected_id })
+            in_order = false;
+        ++expected_id;
+    }
+    MUST(producer->join());
+
+    EXPECT(in_order);
+    EXPECT(!queue.dequeue().has_value());
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/AccumulatedVisualContext.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/DisplayListDamage.h>
+#include <LibWeb/Painting/ScrollState.h>
+
+using namespace Web::Painting;
+
+static NonnullRefPtr<DisplayList> record(AccumulatedVisualContextTree const& tree, Vector<FillRect> const& commands)
+{
+    auto display_list = DisplayList::create(tree);
+    for (auto const& command : commands)
+        display_list->append(command, tree, VISUAL_VIEWPORT_NODE_INDEX);
+    return display_list;
+}
+
+TEST_CASE(identical_recordings_have_no_damage)
+{
+    auto old_tree = AccumulatedVisualContextTree::create();
+    auto new_tree = AccumulatedVisualContextTree::create();
+    auto old_list = record(old_tree, { { .rect = { 0, 0, 100, 100 }, .color = Color::White }, { .rect = { 10, 10, 20, 20 }, .color = Color::Black } });
+    auto new_list = record(new_tree, { { .rect = { 0, 0, 100, 100 }, .color = Color::White }, { .rect = { 10, 10, 20, 20 }, .color = Color::Black } });
+
+    auto damage = compute_display_list_damage(*old_list, old_tree, *new_list, new_tree, {});
+    EXPECT(damage.has_value());
+    EXPECT(damage->is_empty());
+}
+
+TEST_CASE(changed_command_damages_its_bounds)
+{
+    auto old_tree = AccumulatedVisualContextTree::create();
+    auto new_tree = AccumulatedVisualContextTree::create();
+    auto old_list = record(old_tree, { { .rect = { 0, 0, 100, 100 }, .color = Color::White }, { .rect = { 10, 10, 20, 20 }, .color = Color::Black } });
+    auto new_list = record(new_tree, { { .rect = { 0, 0, 100, 100 }, .color = Color::White }, { .rect = { 10, 10, 20, 20 }, .color = Color::White } });
+
+    auto damage = compute_display_list_damage(*old_list, old_tree, *new_list, new_tree, {});
+    EXPECT(damage.has_value());
+    EXPECT_EQ(*damage, Gfx::IntRect(8, 8, 24, 24));
+}
+
+TEST_CASE(moved_command_damages_old_and_new_bounds)
+{
+    auto old_tree = AccumulatedVisualContextTree::create();
+    auto new_tree = AccumulatedVisualContextTree::create();
+    auto old_list = record(old_tree, { { .rect = { 10, 10, 10, 10 }, .color = Color::Black } });
+    auto new_list = record(new_tree, { { .rect = { 40, 10, 10, 10 }, .color = Color::Black } });
+
+    auto damage = compute_display_list_damage(*old_list, old_tree, *new_list, new_tree, {});
+    EXPECT(damage.has_value());
+    EXPECT_EQ(*damage, Gfx::IntRect(8, 8, 44, 14));
+}
+
+TEST_CASE(mismatched_recordings_need_a_full_repaint)
+{
+    auto old_tree = AccumulatedVisualContextTree::create();
+    auto new_tree = AccumulatedVisualContextTree::create();
+    auto old_list = record(old_tree, { { .rect = { 0, 0, 100, 100 }, .color = Color::White } });
+    auto new_list = record(new_tree, { { .rect = { 0, 0, 100, 100 }, .color = Color::White }, { .rect = { 10, 10, 20, 20 }, .color = Color::Black } });
+
+    EXPECT(!compute_display_list_damage(*old_list, old_tree, *new_list, new_tree, {}).has_value());
+}
+
+TEST_CASE(changed_transform_damages_what_is_painted_under_it)
+{
+    auto old_tree = AccumulatedVisualContextTree::create();
+    auto new_tree = AccumulatedVisualContextTree::create();
+    auto old_transform = old_tree.append(TransformData { Gfx::FloatMatrix4x4::identity(), {} }, VISUAL_VIEWPORT_NODE_INDEX);
+    auto new_transform = new_tree.append(TransformData { Gfx::translation_matrix(Vector3<float>(50, 0, 0)), {} }, VISUAL_VIEWPORT_NODE_INDEX);
+
+    auto old_list = DisplayList::create(old_tree);
+    old_list->append(FillRect { .rect = { 0, 0, 100, 100 }, .color = Color::White }, old_tree, VISUAL_VIEWPORT_NODE_INDEX);
+    old_list->append(FillRect { .rect = { 10, 10, 10, 10 }, .color = Color::Black }, old_tree, old_transform);
+    auto new_list = DisplayList::create(new_tree);
+    new_list->append(FillRect { .rect = { 0, 0, 100, 100 }, .color = Color::White }, new_tree, VISUAL_VIEWPORT_NODE_INDEX);
+    new_list->append(FillRect { .rect = { 10, 10, 10, 10 }, .color = Color::Black }, new_tree, new_transform);
+
+    auto damage = compute_display_list_damage(*old_list, old_tree, *new_list, new_tree, {});
+    EXPECT(damage.has_value());
+    EXPECT_EQ(*damage, Gfx::IntRect(8, 8, 64, 14));
+}
+
+TEST_CASE(changed_opacity_damages_what_is_painted_under_it)
+{
+    auto old_tree = AccumulatedVisualContextTree::create();
+    auto new_tree = AccumulatedVisualContextTree::create();
+    auto old_effects = old_tree.append(EffectsData { .opacity = 1.0f }, VISUAL_VIEWPORT_NODE_INDEX);
+    auto new_effects = new_tree.append(EffectsData { .opacity = 0.5f }, VISUAL_VIEWPORT_NODE_INDEX);
+
+    auto old_list = DisplayList::create(old_tree);
+    old_list->append(FillRect { .rect = { 0, 0, 100, 100 }, .color = Color::White }, old_tree, VISUAL_VIEWPORT_NODE_INDEX);
+    old_list->append(FillRect { .rect = { 40, 40, 10, 10 }, .color = Color::Black }, old_tree, old_effects);
+    auto new_list = DisplayList::create(new_tree);
+    new_list->append(FillRect { .rect = { 0, 0, 100, 100 }, .color = Color::White }, new_tree, VISUAL_VIEWPORT_NODE_INDEX);
+    new_list->append(FillRect { .rect = { 40, 40, 10, 10 }, .color = Color::Black }, new_tree, new_effects);
+
+    auto damage = compute_display_list_damage(*old_list, old_tree, *new_list, new_tree, {});
+    EXPECT(damage.has_value());
+    EXPECT_EQ(*damage, Gfx::IntRect(38, 38, 14, 14));
+}
+
+TEST_CASE(mismatched_visual_contexts_need_a_full_repaint)
+{
+    auto old_tree = AccumulatedVisualContextTree::create();
+    auto new_tree = AccumulatedVisualContextTree::create();
+    new_tree.append(EffectsData { .opacity = 0.5f }, VISUAL_VIEWPORT_NODE_INDEX);
+    auto old_list = record(old_tree, { { .rect = { 0, 0, 100, 100 }, .color = Color::White } });
+    auto new_list = record(new_tree, { { .rect = { 0, 0, 100, 100 }, .color = Color::White } });
+
+    EXPECT(!compute_display_list_damage(*old_list, old_tree, *new_list, new_tree, {}).has_value());
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibWeb/Compositor/FramePacer.h>
+
+using namespace Web::Compositor;
+
+static AK::Duration vsync_intervals(i64 count)
+{
+    return AK::Duration::from_nanoseconds(count * 16'666'666);
+}
+
+static void paint_frame(FramePacer& pacer, MonotonicTime started_at, i64 duration_in_milliseconds)
+{
+    pacer.did_update_the_rendering(started_at, started_at + AK::Duration::from_milliseconds(duration_in_milliseconds));
+}
+
+TEST_CASE(updates_run_immediately_without_a_recent_vsync)
+{
+    auto now = MonotonicTime::now();
+    FramePacer pacer;
+    EXPECT(!pacer.next_rendering_update_time(now).has_value());
+
+    pacer.did_present_frame(now.nanoseconds(), 60);
+    EXPECT(pacer.next_rendering_update_time(now).has_value());
+    EXPECT(!pacer.next_rendering_update_time(now + vsync_intervals(5)).has_value());
+}
+
+TEST_CASE(updates_finish_just_before_the_next_vsync)
+{
+    auto vsync = MonotonicTime::now();
+    FramePacer pacer;
+    paint_frame(pacer, vsync - AK::Duration::from_milliseconds(40), 4);
+    paint_frame(pacer, vsync - AK::Duration::from_milliseconds(20), 4);
+    pacer.did_present_frame(vsync.nanoseconds(), 60);
+
+    EXPECT_EQ(pacer.predicted_rendering_update_duration(), AK::Duration::from_milliseconds(6));
+
+    auto next_update = pacer.next_rendering_update_time(vsync + AK::Duration::from_milliseconds(1));
+    EXPECT(next_update.has_value());
+    EXPECT_EQ(*next_update, vsync + vsync_intervals(1) - AK::Duration::from_milliseconds(6));
+
+    // Too late for this vsync, so aim for the one after.
+    next_update = pacer.next_rendering_update_time(vsync + AK::Duration::from_milliseconds(14));
+    EXPECT(next_update.has_value());
+    EXPECT_EQ(*next_update, vsync + vsync_intervals(2) - AK::Duration::from_milliseconds(6));
+}
+
+TEST_CASE(a_single_slow_update_does_not_move_the_prediction)
+{
+    auto start = MonotonicTime::now();
+    FramePacer pacer;
+    paint_frame(pacer, start, 3);
+    paint_frame(pacer, start + vsync_intervals(1), 30);
+    paint_frame(pacer, start + vsync_intervals(3), 5);
+
+    EXPECT_EQ(pacer.predicted_rendering_update_duration(), AK::Duration::from_milliseconds(7));
+}
+
+TEST_CASE(presents_are_attributed_to_the_newest_finished_frame)
+{
+    auto start = MonotonicTime::now();
+    FramePacer pacer;
+    paint_frame(pacer, start, 2);
+    paint_frame(pacer, start + AK::Duration::from_milliseconds(5), 2);
+    paint_frame(pacer, start + AK::Duration::from_milliseconds(15), 4);
+    pacer.did_present_frame((start + AK::Duration::from_milliseconds(16)).nanoseconds(), 60);
+
+    auto frame_timings = pacer.recent_frame_timings();
+    EXPECT_EQ(frame_timings.size(), 3u);
+    EXPECT(!frame_timings[0].presented_at.has_value());
+    EXPECT(frame_timings[1].presented_at.has_value());
+    EXPECT_EQ(*frame_timings[1].presented_at, start + AK::Duration::from_milliseconds(16));
+    EXPECT(!frame_timings[2].presented_at.has_value());
+}
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibGfx/Bitmap.h>
+#include <LibGfx/PaintingSurface.h>
+#include <LibTest/TestCase.h>
+#include <LibWeb/Painting/AccumulatedVisualContext.h>
+#include <LibWeb/Painting/DisplayList.h>
+#include <LibWeb/Painting/DisplayListPlayerSkia.h>
+#include <LibWeb/Painting/DisplayListResourceStorage.h>
+#include <LibWeb/Painting/ScrollState.h>
+#include <LibWeb/Painting/TiledDisplayListRasterizer.h>
+
+using namespace Web::Painting;
+
+static constexpr Gfx::IntSize surface_size { 700, 600 };
+
+static NonnullRefPtr<Gfx::Bitmap> create_bitmap(Color color = Color::Transparent)
+{
+    auto bitmap = MUST(Gfx::Bitmap::create(Gfx::BitmapFormat::BGRA8888, Gfx::AlphaType::Premultiplied, surface_size));
+    for (auto y = 0; y < bitmap->height(); ++y) {
+        for (auto x = 0; x < bitmap->width(); ++x)
+            bitmap->set_pixel(x, y, color);
+    }
+    return bitmap;
+}
+
+static NonnullRefPtr<DisplayList> record(AccumulatedVisualContextTree const& tree)
+{
+    auto display_list = DisplayList::create(tree);
+    display_list->append(FillRect { .rect = { 0, 0, 700, 600 }, .color = Color::White }, tree, VISUAL_VIEWPORT_NODE_INDEX);
+    // Straddles tile boundaries in both directions.
+    display_list->append(FillRect { .rect = { 200, 230, 300, 60 }, .color = Color::Red }, tree, VISUAL_VIEWPORT_NODE_INDEX);
+    display_list->append(FillRect { .rect = { 250, 100, 20, 450 }, .color = Color::Blue }, tree, VISUAL_VIEWPORT_NODE_INDEX);
+    return display_list;
+}
+
+static bool bitmaps_are_equal(Gfx::Bitmap const& a, Gfx::Bitmap const& b, Gfx::IntRect rect)
+{
+    for (auto y = rect.top(); y < rect.bottom(); ++y) {
+        for (auto x = rect.left(); x < rect.right(); ++x) {
+            if (a.get_pixel(x, y) != b.get_pixel(x, y))
+                return false;
+        }
+    }
+    return true;
+}
+
+TEST_CASE(tiled_rasterization_matches_direct_replay)
+{
+    auto tree = AccumulatedVisualContextTree::create();
+    auto display_list = record(tree);
+    DisplayListResourceStorage resource_storage;
+    ScrollStateSnapshot scroll_state;
+
+    auto direct_bitmap = create_bitmap();
+    auto direct_surface = Gfx::PaintingSurface::wrap_bitmap(*direct_bitmap);
+    DisplayListPlayerSkia player { RefPtr<Gfx::SkiaBackendContext> {} };
+    player.execute(*display_list, tree, resource_storage, scroll_state, direct_surface);
+    player.flush(*direct_surface);
+
+    auto tiled_bitmap = create_bitmap();
+    auto tiled_surface = Gfx::PaintingSurface::wrap_bitmap(*tiled_bitmap);
+    EXPECT(TiledDisplayListRasterizer::can_rasterize_in_tiles(*display_list, resource_storage, *tiled_surface, tiled_surface->rect()));
+
+    TiledDisplayListRasterizer rasterizer;
+    rasterizer.rasterize(*display_list, tree, resource_storage, scroll_state, *tiled_surface, tiled_surface->rect(), TiledDisplayListRasterizer::TileBackground::Transparent);
+    tiled_surface->flush();
+
+    EXPECT(bitmaps_are_equal(*direct_bitmap, *tiled_bitmap, tiled_bitmap->rect()));
+}
+
+TEST_CASE(tiled_rasterization_leaves_pixels_outside_the_rect_alone)
+{
+    auto tree = AccumulatedVisualContextTree::create();
+    auto display_list = record(tree);
+    DisplayListResourceStorage resource_storage;
+    ScrollStateSnapshot scroll_state;
+
+    auto bitmap = create_bitmap(Color::Green);
+    auto surface = Gfx::PaintingSurface::wrap_bitmap(*bitmap);
+
+    Gfx::IntRect rect { 100, 50, 550, 500 };
+    TiledDisplayListRasterizer rasterizer;
+    rasterizer.rasterize(*display_list, tree, resource_storage, scroll_state, *surface, rect, TiledDisplayListRasterizer::TileBackground::Target);
+    surface->flush();
+
+    EXPECT_EQ(bitmap->get_pixel(99, 300), Color::Green);
+    EXPECT_EQ(bitmap->get_pixel(650, 300), Color::Green);
+    EXPECT_EQ(bitmap->get_pixel(300, 49), Color::Green);
+    EXPECT_EQ(bitmap->get_pixel(100, 50), Color::White);
+    EXPECT_EQ(bitmap->get_pixel(260, 300), Color::Blue);
+    EXPECT_EQ(bitmap->get_pixel(400, 250), Color::Red);
+}
+
+TEST_CASE(small_areas_are_not_tiled)
+{
+    auto tree = AccumulatedVisualContextTree::create();
+    auto display_list = record(tree);
+    DisplayListResourceStorage resource_storage;
+
+    auto bitmap = create_bitmap();
+    auto surface = Gfx::PaintingSurface::wrap_bitmap(*bitmap);
+    EXPECT(!TiledDisplayListRasterizer::can_rasterize_in_tiles(*display_list, resource_storage, *surface, { 0, 0, 300, 300 }));
+}
@@ -35,6 +35,7 @@ void Application::create_platform_arguments(Core::ArgsParser& args_parser)
 {
     args_parser.add_option(test_root_path, "Path containing the tests to run", "test-path", 0, "path");
     args_parser.add_option(results_directory, "Directory to store test results", "results-dir", 'R', "path");
+    args_parser.add_option(result_cache_directory, "Directory to remember passing tests in, to skip them on later runs while nothing they depend on changes", "result-cache", 0, "path");
     args_parser.add_option(test_concurrency, "Maximum number of tests to run at once", "test-concurrency", 'j', "jobs");
     args_parser.add_option(test_globs, "Only run tests matching the given glob", "filter", 'f', "glob");
     args_parser.add_option(python_executable_path, "Path to python3", "python-executable", 'P', "path");
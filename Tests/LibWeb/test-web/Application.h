@@ -34,6 +34,7 @@ public:
 
     ByteString test_root_path;
     ByteString results_directory { "test-dumps/results"sv };
+    ByteString result_cache_directory;
     size_t test_concurrency { 1 };
     Vector<ByteString> test_globs;
 
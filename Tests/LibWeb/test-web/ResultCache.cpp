@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include "ResultCache.h"
+#include "TestWeb.h"
+
+#include <AK/Hex.h>
+#include <AK/LexicalPath.h>
+#include <AK/QuickSort.h>
+#include <LibCore/DirIterator.h>
+#include <LibCore/Directory.h>
+#include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
+#include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA2.h>
+#include <LibFileSystem/FileSystem.h>
+#include <LibWebView/Utilities.h>
+
+namespace TestWeb {
+
+static constexpr Array helper_process_names { "Compositor"sv, "ImageDecoder"sv, "RequestServer"sv, "WebContent"sv, "WebWorker"sv };
+
+// Tests may load files from these directories next to them or next to any of their parent directories.
+static constexpr Array support_directory_names { "common"sv, "images"sv, "resources"sv, "support"sv };
+
+static void update_hash(Crypto::Hash::SHA256& hasher, ReadonlyBytes bytes)
+{
+    // Prefix every input with its length, so that moving bytes from one input to the next changes the hash.
+    u64 length = bytes.size();
+    hasher.update(reinterpret_cast<u8 const*>(&length), sizeof(length));
+    hasher.update(bytes);
+}
+
+static ErrorOr<void> update_hash_with_file(Crypto::Hash::SHA256& hasher, StringView path)
+{
+    auto file = TRY(Core::MappedFile::map(path));
+    update_hash(hasher, file->bytes());
+    return {};
+}
+
+static ErrorOr<ByteString> compute_build_fingerprint()
+{
+    auto paths = TRY(Core::System::loaded_library_paths());
+    paths.prepend(TRY(Core::System::current_executable_path()));
+
+    for (auto process_name : helper_process_names) {
+        for (auto& candidate : TRY(WebView::get_paths_for_helper_process(process_name))) {
+            if (FileSystem::exists(candidate)) {
+                paths.append(move(candidate));
+                break;
+            }
+        }
+    }
+
+    auto hasher = Crypto::Hash::SHA256::create();
+    for (auto const& path : paths) {
+        // NB: Not every loaded image is a file, the vDSO for one.
+        (void)update_hash_with_file(*hasher, path);
+    }
+    return encode_hex(hasher->digest().bytes());
+}
+
+ErrorOr<NonnullOwnPtr<ResultCache>> ResultCache::create(ByteString directory, ByteString test_root_path)
+{
+    TRY(Core::Directory::create(directory, Core::Directory::CreateDirectories::Yes));
+    auto build_fingerprint = TRY(compute_build_fingerprint());
+    return adopt_own(*new ResultCache(move(directory), move(test_root_path), move(build_fingerprint)));
+}
+
+ResultCache::ResultCache(ByteString directory, ByteString test_root_path, ByteString build_fingerprint)
+    : m_directory(move(directory))
+    , m_test_root_path(move(test_root_path))
+    , m_build_fingerprint(move(build_fingerprint))
+{
+}
+
+bool ResultCache::is_cacheable(Test const& test)
+{
+    // NB: Ref and screenshot tests only learn what they compare against once they run, so there is nothing to key them
+    //     on beforehand. Neither is there for a test without an expectation, whose output is meant to be looked at.
+    switch (test.mode) {
+    case TestMode::Layout:
+    case TestMode::Text:
+        return !test.expectation_path.is_empty();
+    case TestMode::Crash:
+        return true;
+    case TestMode::Ref:
+    case TestMode::Screenshot:
+        return false;
+    }
+    VERIFY_NOT_REACHED();
+}
+
+bool ResultCache::has_passed(Test const& test)
+{
+    auto entry_path = entry_path_for(test);
+    if (entry_path.is_error())
+        return false;
+    return FileSystem::exists(entry_path.value());
+}
+
+void ResultCache::record_pass(Test const& test)
+{
+    auto record = [&]() -> ErrorOr<void> {
+        auto entry_path = TRY(entry_path_for(test));
+
+        // Other test runs may share the cache, so only ever move complete entries into place.
+        auto temporary_path = ByteString::formatted("{}.{}.tmp", entry_path, Core::System::getpid());
+        {
+            auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+            TRY(file->write_until_depleted(test.relative_path.bytes()));
+        }
+        TRY(Core::System::rename(temporary_path, entry_path));
+        return {};
+    };
+
+    if (auto result = record(); result.is_error())
+        warnln("Could not cache the result of {}: {}", test.relative_path, result.error());
+}
+
+ErrorOr<ByteString> ResultCache::entry_path_for(Test const& test)
+{
+    auto hasher = Crypto::Hash::SHA256::create();
+    update_hash(*hasher, m_build_fingerprint.bytes());
+    update_hash(*hasher, test_mode_to_string(test.mode).bytes());
+    update_hash(*hasher, test.relative_path.bytes());
+    update_hash(*hasher, test.variant.has_value() ? test.variant->bytes() : ReadonlyBytes {});
+
+    TRY(update_hash_with_file(*hasher, test.input_path));
+    if (!test.expectation_path.is_empty())
+        TRY(update_hash_with_file(*hasher, test.expectation_path));
+
+    // Walk up from the test to the root of the tests, taking in the files along the way and any support directories.
+    auto test_root = LexicalPath(m_test_root_path);
+    auto directory = LexicalPath(test.input_path).parent();
+    while (true) {
+        update_hash(*hasher, TRY(hash_of_directory(directory.string(), false)).bytes());
+
+        for (auto support_directory_name : support_directory_names) {
+            auto support_directory = directory.append(support_directory_name);
+            if (FileSystem::is_directory(support_directory.string()))
+                update_hash(*hasher, TRY(hash_of_directory(support_directory.string(), true)).bytes());
+        }
+
+        if (directory.string() == test_root.string() || !directory.is_child_of(test_root))
+            break;
+        directory = directory.parent();
+    }
+
+    return ByteString::formatted("{}/{}.pass", m_directory, encode_hex(hasher->digest().bytes()));
+}
+
+ErrorOr<ByteString> ResultCache::hash_of_directory(ByteString const& path, bool recursive)
+{
+    auto cache_key = ByteString::formatted("{}:{}", recursive ? "recursive"sv : "flat"sv, path);
+    if (auto hash = m_directory_hashes.get(cache_key); hash.has_value())
+        return *hash;
+
+    Vector<ByteString> files;
+    Vector<ByteString> directories;
+
+    Core::DirIterator iterator(path, Core::DirIterator::Flags::SkipDots);
+    while (iterator.has_next()) {
+        auto entry_path = iterator.next_full_path();
+        if (FileSystem::is_directory(entry_path))
+            directories.append(move(entry_path));
+        else
+            files.append(move(entry_path));
+    }
+
+    // NB: The order of a directory's entries is up to the file system, so sort them for a stable hash.
+    quick_sort(files);
+    quick_sort(directories);
+
+    auto hasher = Crypto::Hash::SHA256::create();
+    for (auto const& file : files) {
+        update_hash(*hasher, LexicalPath::basename(file).bytes());
+        TRY(update_hash_with_file(*hasher, file));
+    }
+    if (recursive) {
+        for (auto const& directory : directories) {
+            update_hash(*hasher, LexicalPath::basename(directory).bytes());
+            update_hash(*hasher, TRY(hash_of_directory(directory, true)).bytes());
+        }
+    }
+
+    auto hash = encode_hex(hasher->digest().bytes());
+    m_directory_hashes.set(move(cache_key), hash);
+    return hash;
+}
+
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#pragma once
+
+#include <AK/ByteString.h>
+#include <AK/Error.h>
+#include <AK/HashMap.h>
+#include <AK/NonnullOwnPtr.h>
+#include <AK/Optional.h>
+
+namespace TestWeb {
+
+struct Test;
+
+// Remembers which tests passed, keyed by a hash of everything that the result of a test could depend on: the test,
+// its expectation, the files around it that it may load, and the binaries and libraries that run it. A test whose key
+// is unchanged since it last passed does not have to run again.
+class ResultCache {
+public:
+    static ErrorOr<NonnullOwnPtr<ResultCache>> create(ByteString directory, ByteString test_root_path);
+
+    static bool is_cacheable(Test const&);
+
+    bool has_passed(Test const&);
+    void record_pass(Test const&);
+
+    ResultCache(ResultCache const&) = delete;
+    ResultCache& operator=(ResultCache const&) = delete;
+
+private:
+    ResultCache(ByteString directory, ByteString test_root_path, ByteString build_fingerprint);
+
+    ErrorOr<ByteString> entry_path_for(Test const&);
+    ErrorOr<ByteString> hash_of_directory(ByteString const& path, bool recursive);
+
+    ByteString m_directory;
+    ByteString m_test_root_path;
+    ByteString m_build_fingerprint;
+    HashMap<ByteString, ByteString> m_directory_hashes;
+};
+
+}
@@ -97,6 +97,7 @@ struct Test {
     bool did_finish_test { false };
     bool did_finish_loading { false };
     bool did_inject_js { false };
+    bool result_was_cached { false };
 
     RefTestExpectationType ref_test_expectation_type {};
     Optional<URL::URL> ref_test_expectation_url {};
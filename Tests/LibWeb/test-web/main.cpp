@@ -12,6 +12,7 @@
 #include "Collection.h"
 #include "Debug.h"
 #include "Display.h"
+#include "ResultCache.h"
 #include "TestRunCapture.h"
 #include "TestWeb.h"
 #include "TestWebView.h"
@@ -22,6 +23,7 @@
 #include <AK/Function.h>
 #include <AK/LexicalPath.h>
 #include <AK/NumberFormat.h>
+#include <AK/OwnPtr.h>
 #include <AK/Platform.h>
 #include <AK/Random.h>
 #include <AK/ScopeGuard.h>
@@ -1081,6 +1083,20 @@ static ErrorOr<int> run_tests(Core::AnonymousBuffer const& theme, Web::DevicePix
             }
         }
     }
+    // NB: A rebaseline has to run every test to rewrite its expectation.
+    OwnPtr<ResultCache> result_cache;
+    if (!app.result_cache_directory.is_empty() && !app.rebaseline) {
+        if (auto cache = ResultCache::create(app.result_cache_directory, app.test_root_path); cache.is_error())
+            warnln("Not using the result cache in {}: {}", app.result_cache_directory, cache.error());
+        else
+            result_cache = cache.release_value();
+    }
+
+    auto can_use_result_cache = [&](Test const& test) {
+        return result_cache && test.total_runs == 1 && ResultCache::is_cacheable(test) && !s_loaded_from_http_server.contains_slow(test.input_path);
+    };
+    size_t cached_test_count = 0;
+
     size_t total_tests = tests.size();
     auto concurrency = min(app.test_concurrency, total_tests);
     size_t loaded_web_views = 0;
@@ -1185,10 +1201,12 @@ static ErrorOr<int> run_tests(Core::AnonymousBuffer const& theme, Web::DevicePix
 
             // Reset promise and attach completion callback
             view->reset_test_promise();
-            view->test_promise().when_resolved([&tests, &tests_remaining, &non_passing_tests, &app, view, cleanup_test, view_id, &test_run_capture, &fail_fast_triggered](auto result) {
+            view->test_promise().when_resolved([&tests, &tests_remaining, &non_passing_tests, &app, view, cleanup_test, view_id, &test_run_capture, &fail_fast_triggered, &result_cache, &can_use_result_cache](auto result) {
                 cleanup_test(result.test_index, result.result);
 
                 auto& test = tests[result.test_index];
+                if (result.result == TestResult::Pass && !test.result_was_cached && can_use_result_cache(test))
+                    result_cache->record_pass(test);
 
                 // Clear screenshots to free memory
                 test.actual_screenshot.clear();
@@ -1243,10 +1261,15 @@ static ErrorOr<int> run_tests(Core::AnonymousBuffer const& theme, Web::DevicePix
             });
 
             Core::deferred_invoke([&, index]() mutable {
-                if (s_skipped_tests.contains_slow(tests[index].input_path))
+                if (s_skipped_tests.contains_slow(tests[index].input_path)) {
                     view->on_test_complete({ index, TestResult::Skipped });
-                else
+                } else if (can_use_result_cache(tests[index]) && result_cache->has_passed(tests[index])) {
+                    tests[index].result_was_cached = true;
+                    ++cached_test_count;
+                    view->on_test_complete({ index, TestResult::Pass });
+                } else {
                     run_test(*view, context, index, app, test_run_capture);
+                }
             });
         };
 
@@ -1276,6 +1299,8 @@ static ErrorOr<int> run_tests(Core::AnonymousBuffer const& theme, Web::DevicePix
     }
 
     display.print_run_complete(tests, non_passing_tests, tests_remaining);
+    if (cached_test_count > 0)
+        outln("{} tests passed before and did not change, so they were not run again", cached_test_count);
 
     if (app.dump_gc_graph) {
         for (auto& view : views) {
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <LibTest/TestCase.h>
+#include <LibWebSocket/PerMessageDeflate.h>
+
+TEST_CASE(parse_response)
+{
+    auto parameters = TRY_OR_FAIL(WebSocket::PerMessageDeflate::parse_response("permessage-deflate"sv));
+    EXPECT(parameters.has_value());
+    EXPECT(!parameters->server_no_context_takeover);
+    EXPECT(!parameters->client_no_context_takeover);
+
+    parameters = TRY_OR_FAIL(WebSocket::PerMessageDeflate::parse_response("Permessage-Deflate; server_no_context_takeover ; client_no_context_takeover; server_max_window_bits=\"10\""sv));
+    EXPECT(parameters.has_value());
+    EXPECT(parameters->server_no_context_takeover);
+    EXPECT(parameters->client_no_context_takeover);
+
+    parameters = TRY_OR_FAIL(WebSocket::PerMessageDeflate::parse_response("x-webkit-deflate-frame"sv));
+    EXPECT(!parameters.has_value());
+}
+
+TEST_CASE(parse_invalid_response)
+{
+    // We never offer client_max_window_bits, so the server mustn't answer with it.
+    EXPECT(WebSocket::PerMessageDeflate::parse_response("permessage-deflate; client_max_window_bits=10"sv).is_error());
+    EXPECT(WebSocket::PerMessageDeflate::parse_response("permessage-deflate; server_max_window_bits=7"sv).is_error());
+    EXPECT(WebSocket::PerMessageDeflate::parse_response("permessage-deflate; server_max_window_bits"sv).is_error());
+    EXPECT(WebSocket::PerMessageDeflate::parse_response("permessage-deflate; server_no_context_takeover; server_no_context_takeover"sv).is_error());
+    EXPECT(WebSocket::PerMessageDeflate::parse_response("permessage-deflate; unknown_parameter"sv).is_error());
+}
+
+TEST_CASE(decompress_with_context_takeover)
+{
+    // https://datatracker.ietf.org/doc/html/rfc7692#section-7.2.3.2
+    Array<u8, 7> const first_message { 0xf2, 0x48, 0xcd, 0xc9, 0xc9, 0x07, 0x00 };
+    Array<u8, 5> const second_message { 0xf2, 0x00, 0x11, 0x00, 0x00 };
+
+    auto extension = TRY_OR_FAIL(WebSocket::PerMessageDeflate::create({}));
+
+    auto first = TRY_OR_FAIL(extension->decompress_message(first_message));
+    EXPECT_EQ(StringView { first.bytes() }, "Hello"sv);
+
+    auto second = TRY_OR_FAIL(extension->decompress_message(second_message));
+    EXPECT_EQ(StringView { second.bytes() }, "Hello"sv);
+}
+
+TEST_CASE(round_trip)
+{
+    for (auto no_context_takeover : { false, true }) {
+        auto sender = TRY_OR_FAIL(WebSocket::PerMessageDeflate::create({ .server_no_context_takeover = no_context_takeover, .client_no_context_takeover = no_context_takeover }));
+        auto receiver = TRY_OR_FAIL(WebSocket::PerMessageDeflate::create({ .server_no_context_takeover = no_context_takeover, .client_no_context_takeover = no_context_takeover }));
+
+        for (auto message : { "{\"price\":100.25,\"symbol\":\"ABC\"}"sv, "{\"price\":100.50,\"symbol\":\"ABC\"}"sv, ""sv }) {
+            auto compressed = TRY_OR_FAIL(sender->compress_message(message.bytes()));
+
+            auto decompressed = TRY_OR_FAIL(receiver->decompress_message(compressed));
+            EXPECT_EQ(StringView { decompressed.bytes() }, message);
+        }
+    }
+}
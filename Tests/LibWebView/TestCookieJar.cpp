@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibHTTP/Cookie/ParsedCookie.h>
+#include <LibTest/TestCase.h>
+#include <LibURL/Parser.h>
+#include <LibWebView/CookieJar.h>
+
+static URL::URL parse_url(StringView url)
+{
+    auto parsed_url = URL::Parser::basic_parse(url);
+    VERIFY(parsed_url.has_value());
+    return parsed_url.release_value();
+}
+
+static void set_cookie(WebView::CookieJar& jar, StringView url, StringView cookie_string)
+{
+    auto parsed_url = parse_url(url);
+
+    auto parsed_cookie = HTTP::Cookie::parse_cookie(parsed_url, cookie_string);
+    VERIFY(parsed_cookie.has_value());
+
+    jar.set_cookie(parsed_url, *parsed_cookie, HTTP::Cookie::Source::Http);
+}
+
+TEST_CASE(cookies_are_only_sent_to_their_domain_and_its_subdomains)
+{
+    auto jar = WebView::CookieJar::create();
+    set_cookie(*jar, "https://example.com/"sv, "site=1; Domain=example.com"sv);
+    set_cookie(*jar, "https://www.example.com/"sv, "host=2; Path=/page"sv);
+    set_cookie(*jar, "https://other.com/"sv, "other=3"sv);
+
+    EXPECT_EQ(jar->get_cookie(parse_url("https://example.com/"sv), HTTP::Cookie::Source::Http), "site=1"sv);
+    EXPECT_EQ(jar->get_cookie(parse_url("https://www.example.com/page"sv), HTTP::Cookie::Source::Http), "host=2; site=1"sv);
+    EXPECT_EQ(jar->get_cookie(parse_url("https://a.b.example.com/"sv), HTTP::Cookie::Source::Http), "site=1"sv);
+    EXPECT_EQ(jar->get_cookie(parse_url("https://notexample.com/"sv), HTTP::Cookie::Source::Http), ""sv);
+    EXPECT_EQ(jar->get_cookie(parse_url("https://other.com/"sv), HTTP::Cookie::Source::Http), "other=3"sv);
+}
+
+TEST_CASE(cookies_are_ordered_by_path_length)
+{
+    auto jar = WebView::CookieJar::create();
+    set_cookie(*jar, "https://example.com/"sv, "short=1; Path=/"sv);
+    set_cookie(*jar, "https://example.com/"sv, "long=2; Path=/a/b"sv);
+    set_cookie(*jar, "https://example.com/"sv, "elsewhere=3; Path=/c"sv);
+
+    EXPECT_EQ(jar->get_cookie(parse_url("https://example.com/a/b/c"sv), HTTP::Cookie::Source::Http), "long=2; short=1"sv);
+}
+
+TEST_CASE(expired_cookies_are_purged_from_the_index)
+{
+    auto jar = WebView::CookieJar::create();
+    set_cookie(*jar, "https://example.com/"sv, "short=1; Max-Age=60"sv);
+    set_cookie(*jar, "https://example.com/"sv, "long=2; Max-Age=3600"sv);
+    EXPECT_EQ(jar->get_all_cookies().size(), 2u);
+
+    jar->expire_cookies_with_time_offset(AK::Duration::from_seconds(120));
+    EXPECT_EQ(jar->get_all_cookies().size(), 1u);
+    EXPECT_EQ(jar->get_cookie(parse_url("https://example.com/"sv), HTTP::Cookie::Source::Http), "long=2"sv);
+
+    // Setting the cookie again after it was purged must index it again.
+    set_cookie(*jar, "https://example.com/"sv, "short=3"sv);
+    EXPECT_EQ(jar->get_cookie(parse_url("https://example.com/"sv), HTTP::Cookie::Source::Http), "long=2; short=3"sv);
+}
@@ -87,6 +87,32 @@ static void expect_history_autocomplete_entries_include_metadata(WebView::Histor
     EXPECT_EQ(entries[0].last_visited_time, UnixDateTime::from_seconds_since_epoch(20));
 }
 
+static void expect_history_autocomplete_follows_typing_and_changes(WebView::HistoryStore& store)
+{
+    store.record_visit(parse_url("https://example.com/"sv), "Example"_string, UnixDateTime::from_seconds_since_epoch(10));
+    store.record_visit(parse_url("https://exact.org/"sv), "Exact"_string, UnixDateTime::from_seconds_since_epoch(20));
+
+    EXPECT_EQ(store.autocomplete_entries("e"sv, 8).size(), 2u);
+    EXPECT_EQ(store.autocomplete_entries("ex"sv, 8).size(), 2u);
+
+    auto entries = store.autocomplete_entries("exam"sv, 8);
+    VERIFY(entries.size() == 1);
+    EXPECT_EQ(entries[0].url, "https://example.com/"_string);
+
+    // Visits and title changes in between keystrokes must show up in the next suggestions.
+    store.record_visit(parse_url("https://news.example.net/"sv), {}, UnixDateTime::from_seconds_since_epoch(30));
+    EXPECT_EQ(store.autocomplete_entries("examp"sv, 8).size(), 2u);
+    EXPECT_EQ(store.autocomplete_entries("example"sv, 8).size(), 2u);
+
+    store.update_title(parse_url("https://exact.org/"sv), "Example title"_string);
+    entries = store.autocomplete_entries("example t"sv, 8);
+    VERIFY(entries.size() == 1);
+    EXPECT_EQ(entries[0].url, "https://exact.org/"_string);
+
+    store.clear();
+    EXPECT(store.autocomplete_entries("example"sv, 8).is_empty());
+}
+
 TEST_CASE(record_and_lookup_history_entries)
 {
     auto store = WebView::HistoryStore::create();
@@ -457,3 +483,28 @@ TEST_CASE(persisted_history_autocomplete_entries_include_metadata)
 
     expect_history_autocomplete_entries_include_metadata(*store);
 }
+
+TEST_CASE(history_autocomplete_follows_typing_and_changes)
+{
+    auto store = WebView::HistoryStore::create();
+
+    expect_history_autocomplete_follows_typing_and_changes(*store);
+}
+
+TEST_CASE(persisted_history_autocomplete_follows_typing_and_changes)
+{
+    auto database_directory = ByteString::formatted(
+        "{}/ladybird-history-store-typing-autocomplete-test-{}",
+        Core::StandardPaths::tempfile_directory(),
+        generate_random_uuid());
+    TRY_OR_FAIL(Core::Directory::create(database_directory, Core::Directory::CreateDirectories::Yes));
+
+    auto cleanup = ScopeGuard([&] {
+        MUST(FileSystem::remove(database_directory, FileSystem::RecursionMode::Allowed));
+    });
+
+    auto database = TRY_OR_FAIL(Database::Database::create(database_directory, "HistoryStore"sv));
+    auto store = TRY_OR_FAIL(WebView::HistoryStore::create(*database));
+
+    expect_history_autocomplete_follows_typing_and_changes(*store);
+}
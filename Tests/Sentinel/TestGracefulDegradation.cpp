@@ -390,3 +390,41 @@ TEST_CASE(test_predefined_service_names)
     EXPECT_EQ(Services::SecurityTap, "SecurityTap"sv);
     EXPECT_EQ(Services::NetworkLayer, "NetworkLayer"sv);
 }
+
+TEST_CASE(test_interned_service_ids)
+{
+    GracefulDegradation degradation;
+
+    // Predefined services have fixed IDs, and interning is idempotent
+    EXPECT_EQ(degradation.find_service(Services::YARAScanner), ServiceIDs::YARAScanner);
+    auto id = degradation.intern_service("InternedService"sv);
+    EXPECT_EQ(degradation.intern_service("InternedService"sv), id);
+    EXPECT(!degradation.should_use_fallback(id));
+    EXPECT(!degradation.get_fallback_strategy(id).has_value());
+
+    u64 callback_epoch = 0;
+    degradation.register_degradation_callback([&](GracefulDegradation::DegradationEvent const& event) {
+        // Callbacks run without the state lock held, so they can query state
+        EXPECT_EQ(degradation.get_service_state(id), event.new_state);
+        callback_epoch = event.epoch;
+    });
+
+    auto epoch_before = degradation.state_epoch();
+    degradation.set_service_state(
+        "InternedService"_string,
+        GracefulDegradation::ServiceState::Failed,
+        "Test"_string,
+        GracefulDegradation::FallbackStrategy::SkipWithLog
+    );
+
+    auto decision = degradation.fallback_decision(id);
+    EXPECT(decision.use_fallback);
+    EXPECT_EQ(decision.state, GracefulDegradation::ServiceState::Failed);
+    EXPECT_EQ(decision.strategy, GracefulDegradation::FallbackStrategy::SkipWithLog);
+    EXPECT(degradation.state_epoch() > epoch_before);
+    EXPECT_EQ(callback_epoch, degradation.state_epoch());
+
+    degradation.mark_service_recovered("InternedService"_string);
+    EXPECT(!degradation.should_use_fallback(id));
+    EXPECT_EQ(degradation.get_fallback_strategy(id), GracefulDegradation::FallbackStrategy::None);
+}
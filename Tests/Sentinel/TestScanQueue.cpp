@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <RequestServer/ScanQueue.h>
+
+using namespace RequestServer;
+
+static ScanRequest make_request(StringView id, size_t content_size)
+{
+    return ScanRequest {
+        .request_id = MUST(String::from_utf8(id)),
+        .content = MUST(ByteBuffer::create_zeroed(content_size)),
+        .callback = [](auto) { },
+        .enqueued_time = UnixDateTime::now(),
+        .priority = content_size / (1024 * 1024),
+    };
+}
+
+TEST_CASE(bounded_ring_is_fifo_and_bounded)
+{
+    BoundedMPMCRing<int> ring(4);
+    for (int i = 0; i < 4; ++i) {
+        int value = i;
+        EXPECT(ring.try_push(value));
+    }
+
+    int overflow = 4;
+    EXPECT(!ring.try_push(overflow));
+
+    for (int i = 0; i < 4; ++i)
+        EXPECT_EQ(ring.try_pop().value(), i);
+    EXPECT(!ring.try_pop().has_value());
+
+    // Positions wrap around the slots correctly
+    int value = 42;
+    EXPECT(ring.try_push(value));
+    EXPECT_EQ(ring.try_pop().value(), 42);
+}
+
+TEST_CASE(small_files_are_dequeued_first)
+{
+    ScanQueue queue;
+    MUST(queue.enqueue(make_request("large"sv, 20 * 1024 * 1024)));
+    MUST(queue.enqueue(make_request("medium"sv, 2 * 1024 * 1024)));
+    MUST(queue.enqueue(make_request("small"sv, 1024)));
+
+    EXPECT_EQ(queue.size(), 3u);
+    EXPECT_EQ(queue.dequeue()->request_id, "small"sv);
+    EXPECT_EQ(queue.dequeue()->request_id, "medium"sv);
+    EXPECT_EQ(queue.dequeue()->request_id, "large"sv);
+    EXPECT_EQ(queue.size(), 0u);
+    EXPECT_EQ(queue.queued_bytes(), 0u);
+}
+
+TEST_CASE(bucket_capacity_rejects_overflow)
+{
+    ScanQueue queue;
+    for (size_t i = 0; i < ScanQueue::BUCKET_CAPACITY; ++i)
+        MUST(queue.enqueue(make_request("small"sv, 16)));
+    EXPECT(queue.enqueue(make_request("small"sv, 16)).is_error());
+
+    // Other size classes are unaffected
+    EXPECT(!queue.enqueue(make_request("medium"sv, 2 * 1024 * 1024)).is_error());
+}
+
+TEST_CASE(saturation_and_histograms)
+{
+    ScanQueue queue;
+    EXPECT(!queue.is_saturated());
+
+    for (size_t i = 0; i < ScanQueue::BACKPRESSURE_THRESHOLD_REQUESTS; ++i)
+        MUST(queue.enqueue(make_request("small"sv, 16)));
+    EXPECT(queue.is_saturated());
+
+    while (queue.size() > 0)
+        (void)queue.dequeue();
+    EXPECT(!queue.is_saturated());
+
+    EXPECT_EQ(queue.queue_depth_histogram().total(), ScanQueue::BACKPRESSURE_THRESHOLD_REQUESTS);
+    EXPECT_EQ(queue.wait_time_histogram_ms().total(), ScanQueue::BACKPRESSURE_THRESHOLD_REQUESTS);
+}
+
+TEST_CASE(shutdown_wakes_dequeue)
+{
+    ScanQueue queue;
+    queue.shutdown();
+    EXPECT(!queue.dequeue().has_value());
+    EXPECT(queue.enqueue(make_request("late"sv, 16)).is_error());
+}
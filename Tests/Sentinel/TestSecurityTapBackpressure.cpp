@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibCore/EventLoop.h>
+#include <LibCore/SocketAddress.h>
+#include <LibCore/System.h>
+#include <LibTest/TestCase.h>
+#include <RequestServer/ScanQueue.h>
+#include <RequestServer/SecurityTap.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace RequestServer;
+
+// A Sentinel that accepts connections but never reads from them, so every scan stalls
+class StalledSentinel {
+public:
+    StalledSentinel()
+        : m_path(ByteString::formatted("/tmp/sentinel-backpressure-test-{}.sock", getpid()))
+    {
+        (void)Core::System::unlink(m_path);
+
+        auto address = Core::SocketAddress::local(m_path).to_sockaddr_un();
+        m_listener = MUST(Core::System::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+        MUST(Core::System::bind(m_listener, reinterpret_cast<sockaddr const*>(&address.value()), sizeof(sockaddr_un)));
+        MUST(Core::System::listen(m_listener, 1));
+    }
+
+    ~StalledSentinel() { disconnect(); }
+
+    // Fails the stalled scans (and any reconnection attempt), so the worker pool can shut down
+    void disconnect()
+    {
+        if (m_listener < 0)
+            return;
+        if (auto peer = Core::System::accept(m_listener, nullptr, nullptr); !peer.is_error())
+            (void)Core::System::close(peer.value());
+        (void)Core::System::close(exchange(m_listener, -1));
+        (void)Core::System::unlink(m_path);
+    }
+
+    ByteString const& path() const { return m_path; }
+
+private:
+    ByteString m_path;
+    int m_listener { -1 };
+};
+
+TEST_CASE(stream_windows_apply_backpressure_instead_of_failing_open)
+{
+    Core::EventLoop event_loop;
+    StalledSentinel sentinel;
+
+    auto security_tap = MUST(SecurityTap::create(sentinel.path(), {}));
+    EXPECT(!security_tap->is_scan_backlog_saturated());
+
+    size_t verdicts = 0;
+    size_t queued = 0;
+    Optional<size_t> queued_when_saturated;
+    bool was_turned_away = false;
+
+    // Each stream is a separate download with its first window in flight, as Request sends them
+    auto window_size = security_tap->scan_size_config().chunk_size;
+    for (size_t i = 0; i < ScanQueue::BUCKET_CAPACITY * 2 && !was_turned_away; ++i) {
+        auto stream_id = security_tap->begin_stream_scan();
+        auto window = MUST(ByteBuffer::create_zeroed(window_size));
+        if (!security_tap->async_scan_stream_window(stream_id, move(window), [&](auto) { ++verdicts; })) {
+            was_turned_away = true;
+            break;
+        }
+
+        ++queued;
+        if (!queued_when_saturated.has_value() && security_tap->is_scan_backlog_saturated())
+            queued_when_saturated = queued;
+    }
+
+    // Up to one window per worker thread has left the queue, the rest are still waiting in it
+    EXPECT(queued_when_saturated.has_value());
+    EXPECT(*queued_when_saturated >= ScanQueue::BACKPRESSURE_THRESHOLD_REQUESTS);
+    EXPECT(*queued_when_saturated <= ScanQueue::BACKPRESSURE_THRESHOLD_REQUESTS + 4);
+    EXPECT(security_tap->get_worker_pool_telemetry()->backpressure_active);
+
+    // Past the high-water mark the queue fills up; its windows are turned away for the caller to retry
+    // rather than being cleared without a scan
+    EXPECT(was_turned_away);
+    EXPECT(queued >= ScanQueue::BUCKET_CAPACITY);
+
+    event_loop.pump(Core::EventLoop::WaitMode::PollForEvents);
+    EXPECT_EQ(verdicts, 0u);
+
+    sentinel.disconnect();
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibTest/TestCase.h>
+#include <LibThreading/Thread.h>
+#include <Services/Sentinel/ShardedLRUCache.h>
+
+using namespace Sentinel;
+
+TEST_CASE(slab_cache_evicts_least_recently_used)
+{
+    SlabLRUCache<String, int> cache(3);
+
+    MUST(cache.put("key1"_string, 100));
+    MUST(cache.put("key2"_string, 200));
+    MUST(cache.put("key3"_string, 300));
+
+    // Touch key1 so key2 becomes the least recently used
+    EXPECT_EQ(cache.get("key1"_string), 100);
+
+    MUST(cache.put("key4"_string, 400));
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT(!cache.get("key2"_string).has_value());
+    EXPECT_EQ(cache.get("key1"_string), 100);
+    EXPECT_EQ(cache.get("key3"_string), 300);
+    EXPECT_EQ(cache.get("key4"_string), 400);
+
+    auto metrics = cache.get_metrics();
+    EXPECT_EQ(metrics.evictions, 1u);
+    EXPECT_EQ(metrics.hits, 4u);
+    EXPECT_EQ(metrics.misses, 1u);
+    EXPECT_EQ(metrics.max_size, 3u);
+}
+
+TEST_CASE(slab_cache_updates_existing_keys_in_place)
+{
+    SlabLRUCache<String, int> cache(2);
+
+    MUST(cache.put("key1"_string, 100));
+    MUST(cache.put("key2"_string, 200));
+    MUST(cache.put("key1"_string, 150));
+    EXPECT_EQ(cache.size(), 2u);
+
+    // key1 was refreshed by the update, so key2 goes first
+    MUST(cache.put("key3"_string, 300));
+    EXPECT_EQ(cache.get("key1"_string), 150);
+    EXPECT(!cache.get("key2"_string).has_value());
+}
+
+TEST_CASE(slab_cache_reuses_nodes_after_remove_and_invalidate)
+{
+    SlabLRUCache<String, int> cache(2);
+
+    MUST(cache.put("key1"_string, 100));
+    MUST(cache.put("key2"_string, 200));
+    EXPECT(cache.remove("key1"_string));
+    EXPECT(!cache.remove("key1"_string));
+    EXPECT_EQ(cache.size(), 1u);
+
+    // The freed node is used before anything is evicted
+    MUST(cache.put("key3"_string, 300));
+    EXPECT_EQ(cache.get_metrics().evictions, 0u);
+    EXPECT_EQ(cache.get("key2"_string), 200);
+
+    cache.invalidate();
+    EXPECT(cache.is_empty());
+    EXPECT_EQ(cache.get_metrics().invalidations, 1u);
+
+    for (int i = 0; i < 10; ++i)
+        MUST(cache.put(MUST(String::formatted("key{}", i)), i));
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_EQ(cache.get("key9"_string), 9);
+    EXPECT_EQ(cache.get("key8"_string), 8);
+}
+
+TEST_CASE(slab_cache_ensure_peek_and_expire)
+{
+    SlabLRUCache<String, int> cache(3);
+
+    // ensure() creates default values in place and hands back the stored ones afterwards
+    *MUST(cache.ensure("key1"_string)) += 1;
+    *MUST(cache.ensure("key2"_string)) += 2;
+    *MUST(cache.ensure("key1"_string)) += 10;
+    EXPECT_EQ(*cache.peek("key1"_string), 11);
+    EXPECT_EQ(cache.peek("missing"_string), nullptr);
+
+    // peek() leaves recency alone, so key2 is still the least recently used
+    MUST(cache.put("key3"_string, 3));
+    EXPECT_EQ(*cache.peek("key2"_string), 2);
+    EXPECT_EQ(*MUST(cache.ensure("key4"_string)), 0);
+    EXPECT_EQ(cache.peek("key2"_string), nullptr);
+    EXPECT_EQ(cache.get_metrics().evictions, 1u);
+
+    // Order is now key1, key3, key4 from least recently used
+    auto removed = cache.remove_least_recent_while([](String const&, int value) { return value < 5; });
+    EXPECT_EQ(removed, 0u);
+    removed = cache.remove_least_recent_while([](String const& key, int) { return key != "key4"_string; });
+    EXPECT_EQ(removed, 2u);
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT(cache.peek("key4"_string));
+}
+
+TEST_CASE(sharded_cache_aggregates_metrics)
+{
+    ShardedLRUCache<String, int, 4> cache(64);
+    EXPECT_EQ(cache.capacity(), 64u);
+
+    for (int i = 0; i < 32; ++i)
+        MUST(cache.put(MUST(String::formatted("key{}", i)), i));
+    for (int i = 0; i < 32; ++i)
+        EXPECT_EQ(cache.get(MUST(String::formatted("key{}", i))), i);
+    EXPECT(!cache.get("missing"_string).has_value());
+
+    auto metrics = cache.get_metrics();
+    EXPECT_EQ(metrics.hits, 32u);
+    EXPECT_EQ(metrics.misses, 1u);
+    EXPECT_EQ(metrics.current_size, 32u);
+
+    cache.invalidate();
+    EXPECT(cache.is_empty());
+    EXPECT_EQ(cache.get_metrics().invalidations, 1u);
+}
+
+TEST_CASE(sharded_cache_handles_concurrent_access)
+{
+    static constexpr size_t THREAD_COUNT = 4;
+    static constexpr int OPERATIONS_PER_THREAD = 5000;
+    ShardedLRUCache<int, int> cache(256);
+
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (size_t t = 0; t < THREAD_COUNT; ++t) {
+        threads.append(Threading::Thread::construct("LRUCacheTest"sv, [&cache, t] {
+            for (int i = 0; i < OPERATIONS_PER_THREAD; ++i) {
+                auto key = static_cast<int>(t) * OPERATIONS_PER_THREAD + i % 512;
+                MUST(cache.put(key, key));
+                if (auto value = cache.get(key); value.has_value())
+                    VERIFY(*value == key);
+            }
+            return static_cast<intptr_t>(0);
+        }));
+    }
+    for (auto& thread : threads)
+        thread->start();
+    for (auto& thread : threads)
+        (void)thread->join();
+
+    EXPECT(cache.size() <= 256u + ShardedLRUCache<int, int>::shard_count());
+    EXPECT(cache.get_metrics().evictions > 0u);
+}
@@ -113,6 +113,26 @@ TEST_CASE(approve_domain_empty_is_noop)
     URLVerdictService::the().approve_domain(""_byte_string);
 }
 
+// ── check_async() ───────────────────────────────────────────────────────────
+
+TEST_CASE(check_async_delivers_verdicts_that_need_no_analysis_immediately)
+{
+    auto& svc = URLVerdictService::the();
+    svc.set_enabled(true);
+
+    // Skipped schemes and approved domains never reach the thread pool, so no event loop is needed.
+    Optional<URLVerdict> file_verdict;
+    svc.check_async(parse_url("file:///etc/passwd"sv), [&](URLVerdict verdict) { file_verdict = move(verdict); });
+    EXPECT(file_verdict.has_value());
+    EXPECT_EQ(file_verdict->level, URLThreatLevel::Clean);
+
+    svc.approve_domain("approved-before-async-check.example.com");
+    Optional<URLVerdict> approved_verdict;
+    svc.check_async(parse_url("https://approved-before-async-check.example.com/"sv), [&](URLVerdict verdict) { approved_verdict = move(verdict); });
+    EXPECT(approved_verdict.has_value());
+    EXPECT_EQ(approved_verdict->level, URLThreatLevel::Clean);
+}
+
 // ── URLVerdict defaults ─────────────────────────────────────────────────────
 
 TEST_CASE(url_verdict_default_is_clean)
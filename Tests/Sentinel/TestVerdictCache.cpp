@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2025, Ladybird contributors
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <LibFileSystem/FileSystem.h>
+#include <LibTest/TestCase.h>
+#include <RequestServer/VerdictCache.h>
+#include <unistd.h>
+
+using namespace RequestServer;
+
+static constexpr auto CLEAN_HASH = "275a021bbfb6489e54d471899f7db9d1663fc695ec2fe2a2c4538aabf651fd0f"sv;
+static constexpr auto THREAT_HASH = "131f95c51cc819465fa1797f6ccacf9d494aaaff46fa3eac73ae63ffbdfd8267"sv;
+
+static ByteString fresh_cache_directory(StringView name)
+{
+    auto directory = ByteString::formatted("/tmp/verdict_cache_test_{}_{}", name, getpid());
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+    return directory;
+}
+
+TEST_CASE(lookup_misses_until_the_rule_set_is_known)
+{
+    auto directory = fresh_cache_directory("unknown_rules"sv);
+    auto cache = MUST(VerdictCache::create(directory));
+
+    EXPECT(!cache->lookup(CLEAN_HASH).has_value());
+    EXPECT_EQ(cache->rule_set_version(), 0u);
+
+    cache->store(CLEAN_HASH, { .is_threat = false, .alert_json = {} }, 7);
+    EXPECT_EQ(cache->rule_set_version(), 7u);
+
+    auto verdict = cache->lookup(CLEAN_HASH);
+    EXPECT(verdict.has_value());
+    EXPECT(!verdict->is_threat);
+    EXPECT_EQ(cache->statistics().hot_hits, 1u);
+
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
+
+TEST_CASE(threats_without_a_cold_tier_get_a_synthesized_alert)
+{
+    auto directory = fresh_cache_directory("threat"sv);
+    auto cache = MUST(VerdictCache::create(directory));
+
+    cache->store(THREAT_HASH, { .is_threat = true, .alert_json = ByteString("{\"threat_detected\":true}"sv) }, 1);
+
+    auto verdict = cache->lookup(THREAT_HASH);
+    EXPECT(verdict.has_value());
+    EXPECT(verdict->is_threat);
+    EXPECT(verdict->alert_json.has_value());
+    EXPECT(verdict->alert_json->contains(THREAT_HASH));
+
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
+
+TEST_CASE(rule_set_change_invalidates_entries)
+{
+    auto directory = fresh_cache_directory("rule_change"sv);
+    auto cache = MUST(VerdictCache::create(directory));
+
+    cache->store(CLEAN_HASH, { .is_threat = false, .alert_json = {} }, 1);
+    EXPECT(cache->lookup(CLEAN_HASH).has_value());
+
+    cache->set_rule_set_version(2);
+    EXPECT(!cache->lookup(CLEAN_HASH).has_value());
+
+    // The stale slot is reused for the fresh verdict
+    cache->store(CLEAN_HASH, { .is_threat = false, .alert_json = {} }, 2);
+    EXPECT(cache->lookup(CLEAN_HASH).has_value());
+
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
+
+TEST_CASE(expired_entries_miss)
+{
+    auto directory = fresh_cache_directory("ttl"sv);
+    auto cache = MUST(VerdictCache::create(directory));
+    cache->set_time_to_live(AK::Duration::from_seconds(-1), AK::Duration::from_seconds(-1));
+
+    cache->store(CLEAN_HASH, { .is_threat = false, .alert_json = {} }, 1);
+    EXPECT(!cache->lookup(CLEAN_HASH).has_value());
+    EXPECT_EQ(cache->statistics().misses, 1u);
+
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
+
+TEST_CASE(malformed_hashes_are_never_cached)
+{
+    auto directory = fresh_cache_directory("malformed"sv);
+    auto cache = MUST(VerdictCache::create(directory));
+
+    cache->store("not-a-hash"sv, { .is_threat = false, .alert_json = {} }, 1);
+    EXPECT_EQ(cache->statistics().stores, 0u);
+    EXPECT(!cache->lookup("not-a-hash"sv).has_value());
+
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
+
+TEST_CASE(verdicts_are_shared_between_mappings)
+{
+    // Two caches over the same table behave like two RequestServer processes
+    auto directory = fresh_cache_directory("shared"sv);
+    auto first = MUST(VerdictCache::create(directory));
+    auto second = MUST(VerdictCache::create(directory));
+
+    first->store(CLEAN_HASH, { .is_threat = false, .alert_json = {} }, 3);
+    EXPECT_EQ(second->rule_set_version(), 3u);
+
+    auto verdict = second->lookup(CLEAN_HASH);
+    EXPECT(verdict.has_value());
+    EXPECT(!verdict->is_threat);
+
+    // A rule set change seen by one process invalidates the other's view too
+    second->set_rule_set_version(4);
+    EXPECT(!first->lookup(CLEAN_HASH).has_value());
+
+    (void)FileSystem::remove(directory, FileSystem::RecursionMode::Allowed);
+}
@@ -97,11 +97,24 @@ static ErrorOr<void> populate_test_data(PolicyGraph& graph, size_t num_policies,
     return {};
 }
 
+enum class MatchPath {
+    CompiledIndex,
+    Database,
+};
+
+static ErrorOr<Optional<PolicyGraph::Policy>> match_policy(PolicyGraph& graph, PolicyGraph::ThreatMetadata const& threat, MatchPath path)
+{
+    if (path == MatchPath::Database)
+        return graph.match_policy_using_database(threat);
+    return graph.match_policy(threat);
+}
+
 static ErrorOr<BenchmarkResult> benchmark_policy_match(
     PolicyGraph& graph,
     size_t iterations,
     String const& test_name,
-    Duration target_time)
+    Duration target_time,
+    MatchPath path)
 {
     outln("Running benchmark: {} (iterations={})", test_name, iterations);
 
@@ -124,7 +137,7 @@ static ErrorOr<BenchmarkResult> benchmark_policy_match(
             .rule_name = "test_rule_0"_string,
             .severity = "high"_string
         };
-        (void)graph.match_policy(threat);
+        (void)match_policy(graph, threat, path);
     }
 
     // Benchmark runs
@@ -141,7 +154,7 @@ static ErrorOr<BenchmarkResult> benchmark_policy_match(
         };
 
         auto start_time = MonotonicTime::now();
-        auto result = TRY(graph.match_policy(threat));
+        auto result = TRY(match_policy(graph, threat, path));
         auto end_time = MonotonicTime::now();
 
         if (result.has_value())
@@ -162,7 +175,7 @@ static ErrorOr<BenchmarkResult> benchmark_policy_match(
     auto avg_time = total_time / iterations;
     bool target_met = avg_time <= target_time;
 
-    outln("  Cache performance: {} hits, {} misses ({:.1f}% hit rate)",
+    outln("  Policy matches: {} hits, {} misses ({:.1f}% hit rate)",
         hits, misses, (hits * 100.0) / iterations);
 
     return BenchmarkResult {
@@ -406,9 +419,15 @@ ErrorOr<int> serenity_main(Main::Arguments arguments)
     // Run benchmarks with targets from Day 31 plan
     outln("=== Running Database Benchmarks ===\n");
 
-    // Policy matching (target: < 5ms)
-    results.append(TRY(benchmark_policy_match(
-        graph, 1000, "Policy Match Query"_string, Duration::from_milliseconds(5))));
+    // Policy matching (target: < 5ms through SQLite, < 0.05ms through the compiled index)
+    auto database_match = TRY(benchmark_policy_match(
+        graph, 1000, "Policy Match Query (SQL)"_string, Duration::from_milliseconds(5), MatchPath::Database));
+    auto compiled_match = TRY(benchmark_policy_match(
+        graph, 1000, "Policy Match Query (compiled index)"_string, Duration::from_microseconds(50), MatchPath::CompiledIndex));
+    if (compiled_match.avg_time > Duration::zero())
+        outln("  Compiled index speedup: {:.1f}x\n", database_match.avg_time.to_nanoseconds() / static_cast<double>(compiled_match.avg_time.to_nanoseconds()));
+    results.append(move(database_match));
+    results.append(move(compiled_match));
 
     // Policy creation (target: < 10ms)
     results.append(TRY(benchmark_policy_creation(
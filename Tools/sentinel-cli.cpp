@@ -21,6 +21,8 @@
 #include <LibFileSystem/FileSystem.h>
 #include <LibMain/Main.h>
 #include <Services/RequestServer/Quarantine.h>
+#include <Services/Sentinel/AuditLog.h>
+#include <Services/Sentinel/AuditSegment.h>
 #include <Services/Sentinel/PolicyGraph.h>
 #include <sys/stat.h>
 
@@ -347,6 +349,22 @@ static ErrorOr<void> command_backup()
     return {};
 }
 
+static ErrorOr<void> command_audit_replay(ReadonlySpan<StringView> segment_paths)
+{
+    // JSON Lines on stdout, exactly as the synchronous audit log would have written them
+    size_t event_count = 0;
+    for (auto path : segment_paths) {
+        auto reader = TRY(AuditSegmentReader::open(path));
+        while (auto event = TRY(reader->next_event()); event.has_value()) {
+            outln("{}", AuditLogger::to_json(*event).serialized());
+            event_count++;
+        }
+    }
+
+    warnln("Replayed {} audit events from {} segment(s)", event_count, segment_paths.size());
+    return {};
+}
+
 static void print_usage()
 {
     outln("Usage: sentinel-cli <command> [arguments]\n");
@@ -359,6 +377,7 @@ static void print_usage()
     outln("  vacuum                      Vacuum database (reclaim space)");
     outln("  verify                      Verify database integrity");
     outln("  backup                      Create database backup");
+    outln("  audit-replay <segment>...   Convert audit log segments to JSON Lines");
     outln();
 }
 
@@ -398,6 +417,12 @@ ErrorOr<int> ladybird_main(Main::Arguments arguments)
         TRY(command_verify());
     } else if (command == "backup"sv) {
         TRY(command_backup());
+    } else if (command == "audit-replay"sv) {
+        if (arguments.argc < 3) {
+            warnln("Error: Missing audit log segment path");
+            return 1;
+        }
+        TRY(command_audit_replay(arguments.strings.slice(2)));
     } else {
         warnln("Error: Unknown command '{}'", command);
         print_usage();
@@ -0,0 +1,386 @@
+/*
+ * Copyright (c) 2026-present, the Ladybird developers.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause
+ */
+
+#include <AK/Array.h>
+#include <AK/Atomic.h>
+#include <AK/ByteBuffer.h>
+#include <AK/HashMap.h>
+#include <AK/JsonArray.h>
+#include <AK/JsonObject.h>
+#include <AK/JsonValue.h>
+#include <AK/Random.h>
+#include <AK/Time.h>
+#include <LibCore/ArgsParser.h>
+#include <LibCore/File.h>
+#include <LibMain/Main.h>
+#include <LibThreading/Thread.h>
+#include <LibURL/Parser.h>
+#include <Services/RequestServer/SecurityTap.h>
+#include <Services/RequestServer/URLSecurityAnalyzer.h>
+#include <Services/Sentinel/LatencyHistogram.h>
+#include <Services/Sentinel/PolicyGraph.h>
+
+// Replays a recorded mix of browsing actions against a running Sentinel at a fixed concurrency, and reports throughput
+// and tail latency per action.
+//
+// Downloads go through SecurityTap over the Sentinel socket, exactly as RequestServer sends them. URL checks and form
+// submissions never cross that socket: RequestServer and WebContent run them in-process against Sentinel's analyzers
+// and policy database, so they are replayed the same way here.
+
+enum class Action : u8 {
+    Download,
+    URLCheck,
+    FormSubmit,
+};
+
+static constexpr size_t action_count = 3;
+static constexpr Array<StringView, action_count> action_names { "download"sv, "url_check"sv, "form_submit"sv };
+
+static Optional<Action> action_from_name(StringView name)
+{
+    for (size_t i = 0; i < action_count; ++i) {
+        if (action_names[i] == name)
+            return static_cast<Action>(i);
+    }
+    return {};
+}
+
+struct TraceEvent {
+    Action action;
+
+    // Download
+    size_t size { 0 };
+    // Downloads normally get unique contents so they reach the scanner; cached ones repeat and hit the verdict cache
+    bool cached { false };
+
+    // Download and URL check
+    ByteString url;
+    Optional<URL::URL> parsed_url;
+
+    // Form submission
+    String form_origin;
+    String action_origin;
+};
+
+// A browsing session's worth of actions for when no trace was recorded: mostly navigations, a few logins, and the
+// occasional download.
+static constexpr StringView default_trace = R"([
+    { "action": "url_check", "url": "https://example.com/" },
+    { "action": "url_check", "url": "https://news.example.org/article/1234" },
+    { "action": "url_check", "url": "https://paypa1-secure.example.net/login" },
+    { "action": "form_submit", "form_origin": "https://example.com", "action_origin": "https://example.com" },
+    { "action": "url_check", "url": "https://cdn.example.com/app.js" },
+    { "action": "download", "url": "https://example.com/report.pdf", "size": 102400 },
+    { "action": "url_check", "url": "https://xn--80ak6aa92e.com/" },
+    { "action": "form_submit", "form_origin": "https://shop.example.com", "action_origin": "https://payments.example.net" },
+    { "action": "url_check", "url": "https://example.com/search?q=ladybird" },
+    { "action": "download", "url": "https://example.com/installer.bin", "size": 2097152 },
+    { "action": "download", "url": "https://example.com/logo.png", "size": 16384, "cached": true },
+    { "action": "url_check", "url": "https://login.examp1e.com/" }
+])"sv;
+
+static ErrorOr<Vector<TraceEvent>> parse_trace(StringView json)
+{
+    auto value = TRY(JsonValue::from_string(json));
+    if (!value.is_array())
+        return Error::from_string_literal("Trace must be a JSON array of actions");
+
+    Vector<TraceEvent> trace;
+    for (auto const& entry : value.as_array().values()) {
+        if (!entry.is_object())
+            return Error::from_string_literal("Trace entries must be objects");
+        auto const& object = entry.as_object();
+
+        auto action_name = object.get_string("action"sv);
+        if (!action_name.has_value())
+            return Error::from_string_literal("Trace entry is missing 'action'");
+        auto action = action_from_name(*action_name);
+        if (!action.has_value())
+            return Error::from_string_literal("Trace entry has an unknown 'action'");
+
+        TraceEvent event { .action = *action };
+        switch (*action) {
+        case Action::Download:
+            event.size = object.get_u64("size"sv).value_or(0);
+            if (event.size == 0)
+                return Error::from_string_literal("Download entries need a non-zero 'size'");
+            event.cached = object.get_bool("cached"sv).value_or(false);
+            event.url = object.get_string("url"sv).value_or("https://example.com/download.bin"_string).to_byte_string();
+            break;
+        case Action::URLCheck:
+            event.url = object.get_string("url"sv).value_or(String {}).to_byte_string();
+            event.parsed_url = URL::Parser::basic_parse(event.url);
+            if (!event.parsed_url.has_value())
+                return Error::from_string_literal("URL check entry has an invalid 'url'");
+            break;
+        case Action::FormSubmit:
+            event.form_origin = object.get_string("form_origin"sv).value_or(String {});
+            event.action_origin = object.get_string("action_origin"sv).value_or(String {});
+            if (event.form_origin.is_empty() || event.action_origin.is_empty())
+                return Error::from_string_literal("Form entries need 'form_origin' and 'action_origin'");
+            break;
+        }
+        trace.append(move(event));
+    }
+
+    if (trace.is_empty())
+        return Error::from_string_literal("Trace is empty");
+    return trace;
+}
+
+static ErrorOr<ByteString> read_file(StringView path)
+{
+    auto file = TRY(Core::File::open(path, Core::File::OpenMode::Read));
+    auto contents = TRY(file->read_until_eof());
+    return ByteString { contents.bytes() };
+}
+
+// Each worker is one client: its own Sentinel connection, analyzer and database connection, like one RequestServer
+// or WebContent process.
+struct Worker {
+    NonnullOwnPtr<RequestServer::SecurityTap> tap;
+    NonnullOwnPtr<RequestServer::URLSecurityAnalyzer> url_analyzer;
+    NonnullOwnPtr<Sentinel::PolicyGraph> policy_graph;
+
+    // Download contents by size, reused between requests. Stamps start at a per-worker offset, since the verdict cache
+    // is shared between all clients.
+    HashMap<size_t, ByteBuffer> contents;
+    u64 next_content_stamp { 0 };
+
+    Array<Sentinel::LatencyHistogram, action_count> latencies {};
+    Array<size_t, action_count> errors {};
+};
+
+static ErrorOr<void> run_event(Worker& worker, TraceEvent const& event)
+{
+    switch (event.action) {
+    case Action::Download: {
+        auto& content = worker.contents.ensure(event.size, [&] {
+            auto buffer = MUST(ByteBuffer::create_uninitialized(event.size));
+            fill_with_random(buffer.bytes());
+            return buffer;
+        });
+        // Stamp the contents so the verdict cache can't answer in place of the scanner
+        if (!event.cached) {
+            auto stamp = worker.next_content_stamp++;
+            content.overwrite(0, &stamp, min(sizeof(stamp), content.size()));
+        }
+
+        // Hashing is part of RequestServer's download path, so it is part of the measured latency too
+        RequestServer::SecurityTap::DownloadMetadata metadata {
+            .url = event.url,
+            .filename = "download.bin"sv,
+            .mime_type = "application/octet-stream"sv,
+            .sha256 = TRY(RequestServer::SecurityTap::compute_sha256(content.bytes())),
+            .size_bytes = content.size(),
+        };
+        (void)TRY(worker.tap->inspect_download(metadata, content.bytes()));
+        return {};
+    }
+    case Action::URLCheck:
+        (void)TRY(worker.url_analyzer->analyze_url(*event.parsed_url));
+        return {};
+    case Action::FormSubmit:
+        // The lookups FormMonitor makes for every submission
+        (void)TRY(worker.policy_graph->has_relationship(event.form_origin, event.action_origin, "trusted"_string));
+        (void)TRY(worker.policy_graph->has_relationship(event.form_origin, event.action_origin, "blocked"_string));
+        return {};
+    }
+    VERIFY_NOT_REACHED();
+}
+
+struct ActionResult {
+    u64 count { 0 };
+    size_t errors { 0 };
+    double throughput { 0 };
+    Duration p50;
+    Duration p99;
+    Duration p999;
+};
+
+static JsonObject results_to_json(Array<ActionResult, action_count> const& results)
+{
+    JsonObject actions;
+    for (size_t i = 0; i < action_count; ++i) {
+        auto const& result = results[i];
+        if (result.count == 0)
+            continue;
+        JsonObject action;
+        action.set("throughput"sv, result.throughput);
+        action.set("p50_us"sv, result.p50.to_microseconds());
+        action.set("p99_us"sv, result.p99.to_microseconds());
+        action.set("p999_us"sv, result.p999.to_microseconds());
+        actions.set(action_names[i], move(action));
+    }
+    JsonObject root;
+    root.set("actions"sv, move(actions));
+    return root;
+}
+
+// Returns the number of regressions: throughput or tail latency more than `tolerance` percent worse than the baseline
+static ErrorOr<size_t> compare_with_baseline(Array<ActionResult, action_count> const& results, StringView baseline_path, double tolerance)
+{
+    auto baseline = TRY(JsonValue::from_string(TRY(read_file(baseline_path))));
+    if (!baseline.is_object() || !baseline.as_object().has_object("actions"sv))
+        return Error::from_string_literal("Baseline must be a JSON object with an 'actions' object");
+    auto const& baseline_actions = baseline.as_object().get_object("actions"sv).value();
+
+    outln("\nComparison with baseline {} (tolerance {:.0f}%):", baseline_path, tolerance);
+
+    size_t regressions = 0;
+    auto slack = tolerance / 100.0;
+    for (size_t i = 0; i < action_count; ++i) {
+        auto const& result = results[i];
+        auto expected = baseline_actions.get_object(action_names[i]);
+        if (result.count == 0 || !expected.has_value())
+            continue;
+
+        auto check = [&](StringView metric, double measured, Optional<double> baseline_value, bool higher_is_better) {
+            if (!baseline_value.has_value() || *baseline_value <= 0)
+                return;
+            auto ratio = measured / *baseline_value;
+            auto regressed = higher_is_better ? ratio < 1.0 - slack : ratio > 1.0 + slack;
+            if (regressed)
+                ++regressions;
+            outln("  {:<12} {:<10} {:>12.1f} vs {:>12.1f} ({:+.1f}%) {}",
+                action_names[i], metric, measured, *baseline_value, (ratio - 1.0) * 100.0, regressed ? "REGRESSED"sv : "ok"sv);
+        };
+
+        check("req/s"sv, result.throughput, expected->get_double_with_precision_loss("throughput"sv), true);
+        check("p50 us"sv, static_cast<double>(result.p50.to_microseconds()), expected->get_double_with_precision_loss("p50_us"sv), false);
+        check("p99 us"sv, static_cast<double>(result.p99.to_microseconds()), expected->get_double_with_precision_loss("p99_us"sv), false);
+        check("p999 us"sv, static_cast<double>(result.p999.to_microseconds()), expected->get_double_with_precision_loss("p999_us"sv), false);
+    }
+    return regressions;
+}
+
+ErrorOr<int> ladybird_main(Main::Arguments arguments)
+{
+    StringView trace_path;
+    StringView baseline_path;
+    StringView write_baseline_path;
+    ByteString policy_db_directory = "/tmp/sentinel_load_generator_db";
+    size_t concurrency = 8;
+    size_t request_count = 2000;
+    double tolerance = 10.0;
+
+    Core::ArgsParser args_parser;
+    args_parser.set_general_help("Replay a mix of downloads, URL checks and form submissions against a running Sentinel.");
+    args_parser.add_option(trace_path, "Recorded trace to replay (JSON array of actions)", "trace", 't', "path");
+    args_parser.add_option(concurrency, "Number of concurrent clients", "concurrency", 'c', "count");
+    args_parser.add_option(request_count, "Total number of actions to replay", "requests", 'n', "count");
+    args_parser.add_option(policy_db_directory, "Policy database directory for form submissions", "policy-db", 0, "path");
+    args_parser.add_option(baseline_path, "Baseline results to compare against", "baseline", 'b', "path");
+    args_parser.add_option(write_baseline_path, "Write the results as a new baseline", "write-baseline", 'w', "path");
+    args_parser.add_option(tolerance, "Allowed regression against the baseline, in percent", "tolerance", 0, "percent");
+    args_parser.parse(arguments);
+
+    if (concurrency == 0 || request_count == 0) {
+        warnln("Concurrency and request count must be at least 1");
+        return 1;
+    }
+
+    ByteString recorded_trace;
+    if (!trace_path.is_empty())
+        recorded_trace = TRY(read_file(trace_path));
+    auto trace = TRY(parse_trace(trace_path.is_empty() ? default_trace : recorded_trace.view()));
+
+    // Connections are set up before the clock starts, so the run measures steady-state traffic only
+    Vector<NonnullOwnPtr<Worker>> workers;
+    for (size_t i = 0; i < concurrency; ++i) {
+        auto tap = RequestServer::SecurityTap::create();
+        if (tap.is_error()) {
+            warnln("Could not connect to Sentinel: {}", tap.error());
+            warnln("Make sure Sentinel is running at /tmp/sentinel.sock");
+            return 1;
+        }
+        workers.append(make<Worker>(Worker {
+            .tap = tap.release_value(),
+            .url_analyzer = TRY(RequestServer::URLSecurityAnalyzer::create()),
+            .policy_graph = TRY(Sentinel::PolicyGraph::create(policy_db_directory)),
+            .next_content_stamp = static_cast<u64>(i) << 48,
+        }));
+    }
+
+    outln("Replaying {} actions from a {}-entry trace with {} clients", request_count, trace.size(), concurrency);
+
+    // Workers take the next trace entry in turn, so the recorded order and mix are preserved across all of them
+    Atomic<size_t> next_event { 0 };
+    Vector<NonnullRefPtr<Threading::Thread>> threads;
+    for (auto& worker : workers) {
+        threads.append(Threading::Thread::construct("LoadGenerator"sv, [&trace, &next_event, &worker = *worker, request_count] {
+            while (true) {
+                auto index = next_event.fetch_add(1, AK::MemoryOrder::memory_order_relaxed);
+                if (index >= request_count)
+                    break;
+                auto const& event = trace[index % trace.size()];
+                auto action = to_underlying(event.action);
+
+                auto start = MonotonicTime::now();
+                auto result = run_event(worker, event);
+                auto elapsed = MonotonicTime::now() - start;
+
+                if (result.is_error())
+                    ++worker.errors[action];
+                else
+                    worker.latencies[action].record(elapsed);
+            }
+            return static_cast<intptr_t>(0);
+        }));
+    }
+
+    auto run_start = MonotonicTime::now();
+    for (auto& thread : threads)
+        thread->start();
+    for (auto& thread : threads)
+        (void)thread->join();
+    auto run_seconds = static_cast<double>((MonotonicTime::now() - run_start).to_microseconds()) / 1'000'000.0;
+
+    Array<ActionResult, action_count> results {};
+    u64 total_count = 0;
+    for (size_t i = 0; i < action_count; ++i) {
+        Sentinel::LatencyHistogram latencies;
+        auto& result = results[i];
+        for (auto const& worker : workers) {
+            latencies.merge(worker->latencies[i]);
+            result.errors += worker->errors[i];
+        }
+        result.count = latencies.count();
+        result.throughput = static_cast<double>(result.count) / run_seconds;
+        result.p50 = latencies.percentile(50);
+        result.p99 = latencies.percentile(99);
+        result.p999 = latencies.percentile(99.9);
+        total_count += result.count;
+    }
+
+    outln("\n{:<12} | {:>8} | {:>6} | {:>10} | {:>10} | {:>10} | {:>10}", "Action", "Count", "Errors", "Req/s", "p50 (ms)", "p99 (ms)", "p999 (ms)");
+    outln("{:-<12}-+-{:-<8}-+-{:-<6}-+-{:-<10}-+-{:-<10}-+-{:-<10}-+-{:-<10}", "", "", "", "", "", "", "");
+    for (size_t i = 0; i < action_count; ++i) {
+        auto const& result = results[i];
+        if (result.count == 0 && result.errors == 0)
+            continue;
+        auto to_ms = [](Duration duration) { return static_cast<double>(duration.to_microseconds()) / 1000.0; };
+        outln("{:<12} | {:>8} | {:>6} | {:>10.1f} | {:>10.2f} | {:>10.2f} | {:>10.2f}",
+            action_names[i], result.count, result.errors, result.throughput, to_ms(result.p50), to_ms(result.p99), to_ms(result.p999));
+    }
+    outln("\nTotal: {} actions in {:.2f}s ({:.1f} req/s)", total_count, run_seconds, static_cast<double>(total_count) / run_seconds);
+
+    if (!write_baseline_path.is_empty()) {
+        auto file = TRY(Core::File::open(write_baseline_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+        TRY(file->write_until_depleted(results_to_json(results).serialized().bytes()));
+        outln("Wrote baseline to {}", write_baseline_path);
+    }
+
+    if (!baseline_path.is_empty()) {
+        auto regressions = TRY(compare_with_baseline(results, baseline_path, tolerance));
+        if (regressions > 0) {
+            warnln("\n{} metric(s) regressed beyond {:.0f}%", regressions, tolerance);
+            return 1;
+        }
+    }
+
+    return 0;
+}
@@ -38,6 +38,7 @@ set(ABOUT_PAGES
     processes.html
     security.html
     settings.html
+    tracing.html
     version.html
     webui.css
 )
@@ -8,13 +8,17 @@
 #include <AK/ByteString.h>
 #include <AK/Error.h>
 #include <AK/Format.h>
+#include <AK/Hex.h>
 #include <AK/JsonObject.h>
 #include <AK/ScopeGuard.h>
 #include <AK/Vector.h>
 #include <LibCore/ArgsParser.h>
+#include <LibCore/Directory.h>
 #include <LibCore/ElapsedTimer.h>
 #include <LibCore/File.h>
+#include <LibCore/MappedFile.h>
 #include <LibCore/System.h>
+#include <LibCrypto/Hash/SHA2.h>
 #include <LibJS/Contrib/Test262/GlobalObject.h>
 #include <LibJS/Runtime/VM.h>
 #include <LibJS/Runtime/ValueInlines.h>
@@ -29,6 +33,8 @@ static ByteString s_current_test = "";
 static bool s_parse_only = false;
 static ByteString s_harness_file_directory;
 static bool s_automatic_harness_detection_mode = false;
+static ByteString s_result_cache_directory;
+static ByteString s_build_fingerprint;
 
 enum class NegativePhase {
     ParseOrEarly,
@@ -533,6 +539,84 @@ static bool extract_harness_directory(ByteString const& test_file_path)
     return true;
 }
 
+static void update_hash(Crypto::Hash::SHA256& hasher, ReadonlyBytes bytes)
+{
+    // Prefix every input with its length, so that moving bytes from one input to the next changes the hash.
+    u64 length = bytes.size();
+    hasher.update(reinterpret_cast<u8 const*>(&length), sizeof(length));
+    hasher.update(bytes);
+}
+
+// A test's result can only change along with the test, the harness files it includes, or the code running it. The
+// latter is this runner and every library it has loaded, so a rebuild that leaves all of them unchanged keeps the
+// cached results valid.
+static ErrorOr<ByteString> compute_build_fingerprint()
+{
+    auto paths = TRY(Core::System::loaded_library_paths());
+    paths.prepend(TRY(Core::System::current_executable_path()));
+
+    auto hasher = Crypto::Hash::SHA256::create();
+    for (auto const& path : paths) {
+        // NB: Not every loaded image is a file, the vDSO for one.
+        auto file = Core::MappedFile::map(path);
+        if (file.is_error())
+            continue;
+        update_hash(*hasher, file.value()->bytes());
+    }
+    return encode_hex(hasher->digest().bytes());
+}
+
+static Optional<ByteString> result_cache_path(StringView test_path, StringView source, TestMetadata const& metadata)
+{
+    auto hasher = Crypto::Hash::SHA256::create();
+    update_hash(*hasher, s_build_fingerprint.bytes());
+    update_hash(*hasher, s_parse_only ? "parse-only"sv.bytes() : "run"sv.bytes());
+    update_hash(*hasher, test_path.bytes());
+    update_hash(*hasher, source.bytes());
+
+    for (auto harness_file : metadata.harness_files) {
+        auto harness_contents = read_harness_file(harness_file);
+        if (harness_contents.is_error())
+            return {};
+        update_hash(*hasher, harness_file.bytes());
+        update_hash(*hasher, harness_contents.value().bytes());
+    }
+
+    return ByteString::formatted("{}/{}.json", s_result_cache_directory, encode_hex(hasher->digest().bytes()));
+}
+
+static Optional<JsonObject> read_cached_result(ByteString const& cache_path)
+{
+    auto file = Core::File::open(cache_path, Core::File::OpenMode::Read);
+    if (file.is_error())
+        return {};
+    auto contents = file.value()->read_until_eof();
+    if (contents.is_error())
+        return {};
+    auto result = JsonValue::from_string(contents.value());
+    if (result.is_error() || !result.value().is_object())
+        return {};
+    return move(result.value().as_object());
+}
+
+static void write_cached_result(ByteString const& cache_path, JsonObject const& result_object)
+{
+    // Other runners may share the cache, so only ever move complete results into place.
+    auto temporary_path = ByteString::formatted("{}.{}.tmp", cache_path, getpid());
+    auto write = [&]() -> ErrorOr<void> {
+        {
+            auto file = TRY(Core::File::open(temporary_path, Core::File::OpenMode::Write | Core::File::OpenMode::Truncate));
+            TRY(file->write_until_depleted(result_object.serialized().bytes()));
+        }
+        TRY(Core::System::rename(temporary_path, cache_path));
+        return {};
+    };
+    if (auto result = write(); result.is_error()) {
+        warnln("Could not write cached result {}: {}", cache_path, result.error());
+        (void)Core::System::unlink(temporary_path);
+    }
+}
+
 static FILE* saved_stdout_fd;
 static bool g_in_assert = false;
 
@@ -602,6 +686,7 @@ int main(int argc, char** argv)
     args_parser.add_option(timeout, "Seconds before test should timeout", "timeout", 't', "seconds");
     args_parser.add_option(enable_debug_printing, "Enable debug printing", "debug", 'd');
     args_parser.add_option(disable_core_dumping, "Disable core dumping", "disable-core-dump");
+    args_parser.add_option(s_result_cache_directory, "Directory to cache the results of passing tests in, and to skip them from on later runs", "result-cache", 'c', "path");
     args_parser.parse(arguments);
 
 #ifdef AK_OS_GNU_HURD
@@ -630,6 +715,18 @@ int main(int argc, char** argv)
 
     AK::set_debug_enabled(enable_debug_printing);
 
+    if (!s_result_cache_directory.is_empty()) {
+        auto prepare_result_cache = [&]() -> ErrorOr<void> {
+            TRY(Core::Directory::create(s_result_cache_directory, Core::Directory::CreateDirectories::Yes));
+            s_build_fingerprint = TRY(compute_build_fingerprint());
+            return {};
+        };
+        if (auto result = prepare_result_cache(); result.is_error()) {
+            warnln("Not caching results in {}: {}", s_result_cache_directory, result.error());
+            s_result_cache_directory = {};
+        }
+    }
+
     // The piping stuff is based on https://stackoverflow.com/a/956269.
     constexpr auto BUFFER_SIZE = 1 * KiB;
     char buffer[BUFFER_SIZE] = {};
@@ -771,6 +868,17 @@ int main(int argc, char** argv)
             continue;
         }
 
+        Optional<ByteString> cache_path;
+        if (!s_result_cache_directory.is_empty())
+            cache_path = result_cache_path(path, original_contents, metadata);
+        if (cache_path.has_value()) {
+            if (auto cached_result = read_cached_result(*cache_path); cached_result.has_value()) {
+                result_object = cached_result.release_value();
+                result_object.set("cached"sv, true);
+                continue;
+            }
+        }
+
         bool passed = true;
 
         auto run_test_with_strict_mode = [&](bool strict_mode) {
@@ -816,6 +924,10 @@ int main(int argc, char** argv)
 
         if (!result_object.has("result"sv))
             result_object.set("result"sv, passed ? "passed"sv : "failed"sv);
+
+        // NB: Only passing results are cached, since a failure is what someone will want to see the test run again for.
+        if (auto result = result_object.get_string("result"sv); cache_path.has_value() && result.has_value() && *result == "passed"sv)
+            write_cached_result(*cache_path, result_object);
     }
 
     s_current_test = "";